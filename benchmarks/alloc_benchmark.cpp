@@ -0,0 +1,213 @@
+/**
+ * @file alloc_benchmark.cpp
+ * @brief Heap allocations per reading and per transaction on the SDK hot paths
+ *
+ * Replaces the global operator new for the whole benchmark binary with a
+ * counting wrapper; every benchmark here reports allocations per item as the
+ * allocs_per_item counter, so regressions show up in compare_results.py.
+ *
+ * @author Cardano IoT SDK Team
+ * @version 1.0.0
+ */
+
+#include <benchmark/benchmark.h>
+#include "cardano_iot/cardano_iot.h"
+#include "cardano_iot/utils/logger.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+
+namespace
+{
+    std::atomic<uint64_t> g_allocations{0};
+} // namespace
+
+void *operator new(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *ptr = std::malloc(size ? size : 1))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+using namespace cardano_iot;
+
+namespace
+{
+    std::unique_ptr<CardanoIoTSDK> make_sdk(const std::string &device_id)
+    {
+        CardanoIoTSDK::Config config;
+        config.network_type = "testnet";
+        config.enable_logging = false;
+        auto sdk = std::make_unique<CardanoIoTSDK>(config);
+        sdk->initialize();
+        utils::Logger::instance().set_level(utils::LogLevel::ERROR);
+
+        CardanoIoTSDK::DeviceInfo device;
+        device.device_id = device_id;
+        device.device_type = "sensor";
+        device.manufacturer = "Bench Corp";
+        device.firmware_version = "v1.0.0";
+        device.capabilities = {"sensor_data"};
+        device.public_key = std::string(64, 'a');
+        sdk->register_device(device);
+        return sdk;
+    }
+
+    CardanoIoTSDK::IoTData reading(const std::string &device_id, uint64_t timestamp)
+    {
+        CardanoIoTSDK::IoTData data;
+        data.device_id = device_id;
+        data.data_type = "temperature";
+        data.payload = R"({"temperature": 23.5, "humidity": 65.0, "unit": "celsius"})";
+        data.timestamp = timestamp;
+        data.hash = std::string(64, 'f');
+        data.metadata["unit"] = "celsius";
+        data.metadata["room"] = "lab-2";
+        return data;
+    }
+
+    /**
+     * @brief Counts allocations made inside the timed region only
+     */
+    class AllocationCounter
+    {
+    public:
+        void resume() { start_ = g_allocations.load(std::memory_order_relaxed); }
+        void pause() { total_ += g_allocations.load(std::memory_order_relaxed) - start_; }
+
+        void report(benchmark::State &state, uint64_t items) const
+        {
+            state.counters["allocs_per_item"] =
+                benchmark::Counter(items ? static_cast<double>(total_) / static_cast<double>(items) : 0.0);
+        }
+
+    private:
+        uint64_t start_ = 0;
+        uint64_t total_ = 0;
+    };
+} // namespace
+
+static void BM_AllocsSubmitDataCopy(benchmark::State &state)
+{
+    auto sdk = make_sdk("alloc_copy");
+    const auto data = reading("alloc_copy", 1700000000);
+    AllocationCounter counter;
+    for (auto _ : state)
+    {
+        counter.resume();
+        benchmark::DoNotOptimize(sdk->submit_data(data));
+        counter.pause();
+    }
+    counter.report(state, state.iterations());
+    state.SetItemsProcessed(state.iterations());
+    sdk->shutdown();
+}
+
+static void BM_AllocsSubmitDataMove(benchmark::State &state)
+{
+    auto sdk = make_sdk("alloc_move");
+    uint64_t timestamp = 1700000000;
+    AllocationCounter counter;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto data = reading("alloc_move", timestamp++);
+        state.ResumeTiming();
+        counter.resume();
+        benchmark::DoNotOptimize(sdk->submit_data(std::move(data)));
+        counter.pause();
+    }
+    counter.report(state, state.iterations());
+    state.SetItemsProcessed(state.iterations());
+    sdk->shutdown();
+}
+
+static void BM_AllocsSubmitDataBatch(benchmark::State &state)
+{
+    auto sdk = make_sdk("alloc_batch");
+    uint64_t timestamp = 1700000000;
+    AllocationCounter counter;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        std::vector<CardanoIoTSDK::IoTData> batch;
+        batch.reserve(state.range(0));
+        for (int64_t i = 0; i < state.range(0); ++i)
+        {
+            batch.push_back(reading("alloc_batch", timestamp++));
+        }
+        state.ResumeTiming();
+        counter.resume();
+        benchmark::DoNotOptimize(sdk->submit_data_batch(std::move(batch)));
+        counter.pause();
+    }
+    counter.report(state, state.iterations() * state.range(0));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    sdk->shutdown();
+}
+
+static void BM_AllocsQueryData(benchmark::State &state)
+{
+    auto sdk = make_sdk("alloc_query");
+    for (uint64_t i = 0; i < 1000; ++i)
+    {
+        sdk->submit_data(reading("alloc_query", 1700000000 + i));
+    }
+    AllocationCounter counter;
+    for (auto _ : state)
+    {
+        counter.resume();
+        auto result = sdk->query_data("alloc_query", 1700000100, 1700000199);
+        counter.pause();
+        benchmark::DoNotOptimize(result);
+    }
+    counter.report(state, state.iterations() * 100);
+    state.SetItemsProcessed(state.iterations() * 100);
+    sdk->shutdown();
+}
+
+static void BM_AllocsCreatePaymentTransaction(benchmark::State &state)
+{
+    utils::Logger::instance().set_level(utils::LogLevel::ERROR);
+    core::TransactionManager manager;
+    manager.initialize("testnet");
+    const std::string from = "addr_test1qbench_from";
+    const std::string to = "addr_test1qbench_to";
+    AllocationCounter counter;
+    for (auto _ : state)
+    {
+        counter.resume();
+        auto transaction = manager.create_payment_transaction(from, to, 1000000, "alloc_device");
+        counter.pause();
+        state.PauseTiming();
+        if (transaction)
+        {
+            manager.cancel_transaction(transaction->tx_id); // Return the reserved inputs
+        }
+        state.ResumeTiming();
+    }
+    counter.report(state, state.iterations());
+    state.SetItemsProcessed(state.iterations());
+    manager.shutdown();
+}
+
+BENCHMARK(BM_AllocsSubmitDataCopy);
+BENCHMARK(BM_AllocsSubmitDataMove);
+BENCHMARK(BM_AllocsSubmitDataBatch)->Arg(64)->Arg(1024);
+BENCHMARK(BM_AllocsQueryData);
+BENCHMARK(BM_AllocsCreatePaymentTransaction);
@@ -0,0 +1,64 @@
+#!/usr/bin/env python3
+"""Compare two Google Benchmark JSON files and flag regressions.
+
+Usage: compare_results.py BASELINE.json CURRENT.json [--threshold PERCENT]
+
+Benchmarks are matched by name (the median aggregate when repetitions were
+used). A benchmark regresses when its real time per iteration grew by more
+than the threshold. Exits with status 1 if any benchmark regressed.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path) as f:
+        document = json.load(f)
+    results = {}
+    for bench in document.get("benchmarks", []):
+        if bench.get("run_type") == "aggregate":
+            if bench.get("aggregate_name") != "median":
+                continue
+            name = bench["run_name"]
+        else:
+            name = bench["name"]
+        if "error_occurred" in bench:
+            continue
+        results[name] = bench["real_time"] * UNITS[bench.get("time_unit", "ns")]
+    return results
+
+
+UNITS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline")
+    parser.add_argument("current")
+    parser.add_argument("--threshold", type=float, default=10.0,
+                        help="allowed slowdown in percent (default 10)")
+    args = parser.parse_args()
+
+    baseline = load(args.baseline)
+    current = load(args.current)
+    regressions = 0
+    print(f"{'benchmark':<60} {'baseline':>12} {'current':>12} {'change':>8}")
+    for name in sorted(baseline.keys() & current.keys()):
+        before, after = baseline[name], current[name]
+        change = (after - before) / before * 100.0 if before > 0 else 0.0
+        flag = ""
+        if change > args.threshold:
+            flag = "  REGRESSION"
+            regressions += 1
+        print(f"{name:<60} {before:>10.0f}ns {after:>10.0f}ns {change:>+7.1f}%{flag}")
+    for name in sorted(baseline.keys() - current.keys()):
+        print(f"{name:<60} missing from current run")
+
+    print(f"\n{regressions} regression(s) above {args.threshold:.0f}%")
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,80 @@
+/**
+ * @file crypto_benchmark.cpp
+ * @brief sign_message / verify_signature scaling across threads
+ *
+ * @author Cardano IoT SDK Team
+ * @version 1.0.0
+ */
+
+#include <benchmark/benchmark.h>
+#include "cardano_iot/core/crypto_manager.h"
+#include "cardano_iot/utils/logger.h"
+
+#include <algorithm>
+#include <thread>
+
+using namespace cardano_iot::core;
+
+namespace
+{
+    // One manager and key shared by every benchmark thread, as devices share an SDK instance
+    struct SigningContext
+    {
+        CryptoManager crypto;
+        std::unique_ptr<KeyPair> keys;
+        std::unique_ptr<DigitalSignature> signature;
+        const std::string message = R"({"device_id":"bench","temperature":23.5,"timestamp":1700000000})";
+
+        SigningContext()
+        {
+            cardano_iot::utils::Logger::instance().set_level(cardano_iot::utils::LogLevel::ERROR);
+            crypto.initialize();
+            keys = crypto.generate_key_pair(CryptoAlgorithm::ED25519);
+            signature = crypto.sign_message(message, keys->private_key, CryptoAlgorithm::ED25519);
+        }
+    };
+
+    SigningContext &context()
+    {
+        static SigningContext shared;
+        return shared;
+    }
+
+    const int MAX_THREADS = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+} // namespace
+
+static void BM_SignMessage(benchmark::State &state)
+{
+    auto &ctx = context();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(ctx.crypto.sign_message(ctx.message, ctx.keys->private_key, CryptoAlgorithm::ED25519));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_VerifySignature(benchmark::State &state)
+{
+    auto &ctx = context();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(ctx.crypto.verify_signature(*ctx.signature, ctx.message));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_VerifyBatch(benchmark::State &state)
+{
+    auto &ctx = context();
+    const std::vector<DigitalSignature> signatures(state.range(0), *ctx.signature);
+    const std::vector<std::string> messages(state.range(0), ctx.message);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(ctx.crypto.verify_batch(signatures, messages));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_SignMessage)->ThreadRange(1, MAX_THREADS)->UseRealTime();
+BENCHMARK(BM_VerifySignature)->ThreadRange(1, MAX_THREADS)->UseRealTime();
+BENCHMARK(BM_VerifyBatch)->Arg(16)->Arg(256)->UseRealTime();
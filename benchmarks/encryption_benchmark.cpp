@@ -0,0 +1,74 @@
+/**
+ * @file encryption_benchmark.cpp
+ * @brief Encryption::encrypt / decrypt throughput by payload size
+ *
+ * @author Cardano IoT SDK Team
+ * @version 1.0.0
+ */
+
+#include <benchmark/benchmark.h>
+#include "cardano_iot/security/encryption.h"
+#include "cardano_iot/utils/logger.h"
+
+using namespace cardano_iot::security;
+
+namespace
+{
+    struct EncryptionContext
+    {
+        Encryption encryption;
+        std::string gcm_key;
+        std::string chacha_key;
+
+        EncryptionContext()
+        {
+            cardano_iot::utils::Logger::instance().set_level(cardano_iot::utils::LogLevel::ERROR);
+            encryption.initialize();
+            gcm_key = encryption.generate_key(EncryptionAlgorithm::AES_256_GCM);
+            chacha_key = encryption.generate_key(EncryptionAlgorithm::CHACHA20_POLY1305);
+        }
+    };
+
+    EncryptionContext &context()
+    {
+        static EncryptionContext shared;
+        return shared;
+    }
+
+    void encrypt_payload(benchmark::State &state, const std::string &key_id)
+    {
+        auto &ctx = context();
+        const std::vector<uint8_t> plaintext(state.range(0), 0x5a);
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(ctx.encryption.encrypt(plaintext, key_id));
+        }
+        state.SetBytesProcessed(state.iterations() * state.range(0));
+    }
+} // namespace
+
+static void BM_EncryptAesGcm(benchmark::State &state)
+{
+    encrypt_payload(state, context().gcm_key);
+}
+
+static void BM_EncryptChaCha20(benchmark::State &state)
+{
+    encrypt_payload(state, context().chacha_key);
+}
+
+static void BM_DecryptAesGcm(benchmark::State &state)
+{
+    auto &ctx = context();
+    const auto encrypted = ctx.encryption.encrypt(std::vector<uint8_t>(state.range(0), 0x5a), ctx.gcm_key);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(ctx.encryption.decrypt(encrypted));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+// Sensor reading, typical message, firmware chunk
+BENCHMARK(BM_EncryptAesGcm)->Arg(64)->Arg(1024)->Arg(16 * 1024)->Arg(256 * 1024);
+BENCHMARK(BM_EncryptChaCha20)->Arg(64)->Arg(1024)->Arg(16 * 1024)->Arg(256 * 1024);
+BENCHMARK(BM_DecryptAesGcm)->Arg(64)->Arg(1024)->Arg(16 * 1024)->Arg(256 * 1024);
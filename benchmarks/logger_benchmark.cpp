@@ -0,0 +1,80 @@
+/**
+ * @file logger_benchmark.cpp
+ * @brief Logger::log cost for filtered, synchronous and asynchronous records
+ *
+ * @author Cardano IoT SDK Team
+ * @version 1.0.0
+ */
+
+#include <benchmark/benchmark.h>
+#include "cardano_iot/utils/logger.h"
+
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+
+using namespace cardano_iot::utils;
+
+namespace
+{
+    std::string log_path()
+    {
+        return "/tmp/cardano_iot_logger_bench_" + std::to_string(::getpid()) + ".log";
+    }
+
+    void use_file_sink()
+    {
+        Logger &logger = Logger::instance();
+        logger.enable_console(false);
+        logger.set_file_path(log_path());
+        logger.set_level(LogLevel::INFO);
+    }
+} // namespace
+
+static void BM_LogFilteredLevel(benchmark::State &state)
+{
+    use_file_sink();
+    for (auto _ : state)
+    {
+        CARDANO_IOT_LOG(LogLevel::DEBUG, "Bench", "reading " << 42 << " from sensor");
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_LogSync(benchmark::State &state)
+{
+    use_file_sink();
+    Logger::instance().enable_async(false);
+    const std::string message = "Data submitted for device sensor_0042 (tx 3f5a...)";
+    for (auto _ : state)
+    {
+        Logger::instance().log(LogLevel::INFO, "Bench", message);
+    }
+    state.SetItemsProcessed(state.iterations());
+    std::remove(log_path().c_str());
+}
+
+static void BM_LogAsync(benchmark::State &state)
+{
+    if (state.thread_index() == 0)
+    {
+        use_file_sink();
+        Logger::instance().enable_async(true, 1 << 16, LogOverflowPolicy::BLOCK);
+    }
+    const std::string message = "Data submitted for device sensor_0042 (tx 3f5a...)";
+    for (auto _ : state)
+    {
+        Logger::instance().log(LogLevel::INFO, "Bench", message);
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0)
+    {
+        Logger::instance().enable_async(false); // Drains, so the writer's cost is not left behind
+        std::remove(log_path().c_str());
+    }
+}
+
+BENCHMARK(BM_LogFilteredLevel);
+BENCHMARK(BM_LogSync);
+BENCHMARK(BM_LogAsync)->Threads(1)->Threads(4)->UseRealTime();
@@ -0,0 +1,168 @@
+/**
+ * @file sdk_benchmark.cpp
+ * @brief submit_data and query_data throughput through the public SDK
+ *
+ * @author Cardano IoT SDK Team
+ * @version 1.0.0
+ */
+
+#include <benchmark/benchmark.h>
+#include "cardano_iot/cardano_iot.h"
+#include "cardano_iot/utils/logger.h"
+
+#include <memory>
+
+using namespace cardano_iot;
+
+namespace
+{
+    std::unique_ptr<CardanoIoTSDK> make_sdk(const std::string &device_id, CardanoIoTSDK::Config config = {})
+    {
+        config.network_type = "testnet";
+        config.enable_logging = false;
+        auto sdk = std::make_unique<CardanoIoTSDK>(config);
+        sdk->initialize();
+        utils::Logger::instance().set_level(utils::LogLevel::ERROR); // Per-call INFO lines would dominate
+
+        CardanoIoTSDK::DeviceInfo device;
+        device.device_id = device_id;
+        device.device_type = "sensor";
+        device.manufacturer = "Bench Corp";
+        device.firmware_version = "v1.0.0";
+        device.capabilities = {"sensor_data"};
+        device.public_key = std::string(64, 'a');
+        sdk->register_device(device);
+        return sdk;
+    }
+
+    CardanoIoTSDK::IoTData reading(const std::string &device_id, uint64_t timestamp)
+    {
+        CardanoIoTSDK::IoTData data;
+        data.device_id = device_id;
+        data.data_type = "temperature";
+        data.payload = R"({"temperature": 23.5, "humidity": 65.0, "unit": "celsius"})";
+        data.timestamp = timestamp;
+        data.metadata["unit"] = "celsius";
+        return data;
+    }
+
+    // Slowly changing reading, as a sensor sampling once a second would send
+    CardanoIoTSDK::IoTData varying_reading(const std::string &device_id, uint64_t timestamp)
+    {
+        auto data = reading(device_id, timestamp);
+        data.payload = R"({"temperature": )" + std::to_string(20 + timestamp % 5) + "." +
+                       std::to_string(timestamp % 10) + R"(, "humidity": 65.0, "unit": "celsius"})";
+        return data;
+    }
+} // namespace
+
+static void BM_SubmitData(benchmark::State &state)
+{
+    auto sdk = make_sdk("bench_submit");
+    const auto data = reading("bench_submit", 1700000000);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(sdk->submit_data(data));
+    }
+    state.SetItemsProcessed(state.iterations());
+    sdk->shutdown();
+}
+
+static void BM_SubmitDataBatch(benchmark::State &state)
+{
+    auto sdk = make_sdk("bench_batch");
+    uint64_t timestamp = 1700000000;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        std::vector<CardanoIoTSDK::IoTData> batch;
+        batch.reserve(state.range(0));
+        for (int64_t i = 0; i < state.range(0); ++i)
+        {
+            batch.push_back(reading("bench_batch", timestamp++));
+        }
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(sdk->submit_data_batch(std::move(batch)));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    sdk->shutdown();
+}
+
+// Range query over a device holding range(0) readings, one per second; returns the middle tenth
+static void BM_QueryData(benchmark::State &state)
+{
+    auto sdk = make_sdk("bench_query");
+    const uint64_t start = 1700000000;
+    const auto readings = static_cast<uint64_t>(state.range(0));
+    for (uint64_t i = 0; i < readings; ++i)
+    {
+        sdk->submit_data(reading("bench_query", start + i));
+    }
+    const uint64_t from = start + readings * 45 / 100;
+    const uint64_t to = start + readings * 55 / 100;
+    size_t returned = 0;
+    for (auto _ : state)
+    {
+        auto result = sdk->query_data("bench_query", from, to);
+        returned = result.size();
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * returned);
+    state.counters["returned"] = static_cast<double>(returned);
+    sdk->shutdown();
+}
+
+static void BM_QueryDataView(benchmark::State &state)
+{
+    auto sdk = make_sdk("bench_view");
+    const uint64_t start = 1700000000;
+    const auto readings = static_cast<uint64_t>(state.range(0));
+    for (uint64_t i = 0; i < readings; ++i)
+    {
+        sdk->submit_data(reading("bench_view", start + i));
+    }
+    const uint64_t from = start + readings * 45 / 100;
+    const uint64_t to = start + readings * 55 / 100;
+    size_t returned = 0;
+    for (auto _ : state)
+    {
+        auto view = sdk->query_data_view("bench_view", from, to);
+        returned = view.size();
+        benchmark::DoNotOptimize(view);
+    }
+    state.SetItemsProcessed(state.iterations() * returned);
+    sdk->shutdown();
+}
+
+// Stored bytes per reading with payload encoding: 0 none, 1 dedup, 2 numeric delta, 3 zstd
+static void BM_SubmitDataEncoded(benchmark::State &state)
+{
+    CardanoIoTSDK::Config config;
+    config.payload_dedup = state.range(0) == 1;
+    config.payload_numeric_delta = state.range(0) == 2;
+    config.payload_compression = state.range(0) == 3;
+    auto sdk = make_sdk("bench_encoded", config);
+    uint64_t timestamp = 1700000000;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(sdk->submit_data(varying_reading("bench_encoded", timestamp++)));
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    auto status = sdk->get_network_status();
+    const double raw = status.count("payload_raw_bytes") ? std::stod(status["payload_raw_bytes"]) : 0;
+    const double stored = status.count("payload_stored_bytes") ? std::stod(status["payload_stored_bytes"]) : raw;
+    const auto items = static_cast<double>(state.iterations());
+    if (raw > 0)
+    {
+        state.counters["raw_bytes_per_item"] = raw / items;
+        state.counters["stored_bytes_per_item"] = stored / items;
+    }
+    sdk->shutdown();
+}
+
+BENCHMARK(BM_SubmitData);
+BENCHMARK(BM_SubmitDataEncoded)->DenseRange(0, 3);
+BENCHMARK(BM_SubmitDataBatch)->Arg(64)->Arg(512);
+BENCHMARK(BM_QueryData)->Arg(1000)->Arg(100000);
+BENCHMARK(BM_QueryDataView)->Arg(1000)->Arg(100000);
@@ -0,0 +1,81 @@
+/**
+ * @file wire_benchmark.cpp
+ * @brief P2P message encode / decode through the binary wire format
+ *
+ * @author Cardano IoT SDK Team
+ * @version 1.0.0
+ */
+
+#include <benchmark/benchmark.h>
+#include "cardano_iot/network/wire_format.h"
+
+using namespace cardano_iot::network;
+
+namespace
+{
+    NetworkMessage sample_message(size_t payload_size)
+    {
+        NetworkMessage message;
+        message.message_id = "3f5a9c0e1b2d4c6f";
+        message.type = MessageType::DATA_SYNC;
+        message.sender_id = "gateway_0001";
+        message.recipient_id = "sensor_0042";
+        message.payload.assign(payload_size, 0x5a);
+        message.timestamp = 1700000000;
+        message.encrypted = false;
+        message.signature = std::string(128, 'f');
+        return message;
+    }
+} // namespace
+
+static void BM_WireEncode(benchmark::State &state)
+{
+    const auto message = sample_message(state.range(0));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(wire::encode(message));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+// Encoding into a pooled buffer, as P2PNetwork sends do
+static void BM_WireEncodePooled(benchmark::State &state)
+{
+    const auto message = sample_message(state.range(0));
+    wire::BufferPool pool;
+    for (auto _ : state)
+    {
+        auto buffer = pool.acquire();
+        wire::encode(message, buffer);
+        benchmark::DoNotOptimize(buffer.data());
+        pool.release(std::move(buffer));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_WireDecodeView(benchmark::State &state)
+{
+    const auto frame = wire::encode(sample_message(state.range(0)));
+    wire::MessageView view;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(wire::decode(frame.data(), frame.size(), view));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_WireDecodeMessage(benchmark::State &state)
+{
+    const auto frame = wire::encode(sample_message(state.range(0)));
+    for (auto _ : state)
+    {
+        NetworkMessage message;
+        benchmark::DoNotOptimize(wire::decode(frame.data(), frame.size(), message));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_WireEncode)->Arg(64)->Arg(1024)->Arg(16 * 1024);
+BENCHMARK(BM_WireEncodePooled)->Arg(64)->Arg(1024)->Arg(16 * 1024);
+BENCHMARK(BM_WireDecodeView)->Arg(64)->Arg(1024)->Arg(16 * 1024);
+BENCHMARK(BM_WireDecodeMessage)->Arg(64)->Arg(1024)->Arg(16 * 1024);
@@ -20,6 +20,11 @@
 #include <cstdint>
 #include <chrono>
 
+namespace cardano_iot
+{
+    class CardanoIoTSDK;
+}
+
 namespace cardano_iot::analytics
 {
 
@@ -144,6 +149,21 @@ namespace cardano_iot::analytics
      * - Pattern recognition and classification
      * - Business intelligence and insights
      * - Performance monitoring and optimization
+     *
+     * Ingestion is streaming. Every (device, metric) series keeps a ring
+     * buffer of its latest points plus running statistics: Welford mean and
+     * variance, min/max, an EWMA of the value and its variance, and P²
+     * estimates of the quartiles and the 95th percentile. Each point costs
+     * O(1) to score and fold in. Anomalies are detected inline against the
+     * statistics as they stood before the point. Series are spread over
+     * sharded locks, and a batch takes each shard's lock once.
+     *
+     * Configuration keys (initialize / update_configuration):
+     * window_size (1024 points per series, for new series), min_samples (30),
+     * ewma_alpha (0.1), anomaly_z_threshold (3.0), temporal_gap_factor (10),
+     * max_anomaly_history (10000), active_window_seconds (300),
+     * metrics_interval_ms (1000), and threshold.<metric>.min / .max.
+     * Timestamps are Unix seconds.
      */
     class IoTAnalytics
     {
@@ -189,12 +209,31 @@ namespace cardano_iot::analytics
          */
         uint32_t ingest_data_batch(const std::vector<DataPoint> &data_points);
 
+        /**
+         * @brief Add the numeric readings of an SDK data payload
+         *
+         * A JSON object yields one point per numeric top-level field, named
+         * after the field. A bare number yields one point named data_type.
+         * @return Number of points ingested
+         */
+        uint32_t ingest_payload(const std::string &device_id, const std::string &data_type,
+                                const std::string &payload, uint64_t timestamp);
+
+        /**
+         * @brief Feed every data submission of the SDK into this engine
+         *
+         * Replaces the SDK's data event callback. The engine must outlive the
+         * SDK or be disconnected first.
+         */
+        void connect_to_sdk(CardanoIoTSDK &sdk);
+
         // Anomaly Detection
         /**
          * @brief Configure anomaly detection
          * @param device_id Device to monitor (empty for all devices)
          * @param metric_name Metric to monitor (empty for all metrics)
-         * @param sensitivity Sensitivity level (0.0 - 1.0, higher = more sensitive)
+         * @param sensitivity Sensitivity level (0.0 - 1.0, higher = more sensitive);
+         *        flags deviations beyond 2 + 4 * (1 - sensitivity) standard deviations
          * @return true if configuration successful
          */
         bool configure_anomaly_detection(const std::string &device_id = "",
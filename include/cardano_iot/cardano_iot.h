@@ -39,6 +39,10 @@
 // Utility modules
 #include "utils/logger.h"
 #include "utils/config.h"
+#include "utils/codec.h"
+#include "utils/executor.h"
+#include "utils/flat_map.h"
+#include "utils/task.h"
 
 // Energy management
 #include "energy/power_manager.h"
@@ -46,6 +50,7 @@
 // Network modules
 #include "network/cardano_client.h"
 #include "network/p2p_network.h"
+#include "network/cluster.h"
 
 // Security modules
 #include "security/authentication.h"
@@ -53,6 +58,8 @@
 
 // Data modules
 #include "data/data_provenance.h"
+#include "data/time_series_store.h"
+#include "data/payload_codec.h"
 
 namespace cardano_iot
 {
@@ -79,6 +86,36 @@ namespace cardano_iot
             bool enable_power_management = true;
             uint32_t max_devices = 1000;
             uint32_t transaction_timeout_ms = 30000;
+
+            // Ingestion pipeline (submit_data_batch / enqueue_data)
+            uint32_t ingestion_batch_size = 512;        // Max readings committed per pipeline pass
+            uint32_t ingestion_queue_capacity = 65536;  // Queued readings before enqueue_data rejects
+            uint32_t ingestion_flush_interval_ms = 20;  // Max time a queued reading waits for commit
+
+            // Power-aware outbox (queue_data / queue_ada_transfer)
+            uint32_t outbox_poll_interval_ms = 1000; // How often deadlines and power budgets are re-checked
+            uint32_t outbox_max_batch = 64;          // Queued operations per device before a forced send
+
+            // Shared background executor (get_executor)
+            uint32_t executor_threads = 0;     // 0 = hardware_concurrency
+            bool executor_pin_threads = false; // Pin each worker to one CPU
+            std::vector<int> executor_cpus;    // CPUs to pin to, in worker order (empty = 0..threads-1)
+
+            // Stored payload encoding (see data::PayloadCodec); query_data decodes transparently
+            bool payload_dedup = false;                // Repeated payloads are stored once
+            bool payload_numeric_delta = false;        // Numbers are delta-encoded per device
+            bool payload_compression = false;          // zstd with per data type dictionaries, if built in
+            uint32_t payload_keyframe_interval = 256;  // Readings between numeric keyframes
+            int payload_compression_level = 3;
+
+            // Gateway cluster (see network::GatewayCluster); devices are sharded over the nodes by id
+            bool cluster_enabled = false;
+            std::string cluster_listen_address = "0.0.0.0";
+            uint16_t cluster_port = 0;                      // 0 picks a free port
+            std::vector<std::string> cluster_seeds;         // "host:port" of nodes already in the cluster
+            uint32_t cluster_virtual_nodes = 128;           // Ring points per node
+            uint32_t cluster_membership_interval_ms = 1000; // How often membership is re-read
+            uint32_t cluster_request_timeout_ms = 5000;     // Per call to another node
         };
 
         /**
@@ -106,7 +143,7 @@ namespace cardano_iot
             uint64_t timestamp;
             std::string signature;
             std::string hash;
-            std::map<std::string, std::string> metadata;
+            utils::MetadataMap metadata;
         };
 
         /**
@@ -122,6 +159,9 @@ namespace cardano_iot
 
         /**
          * @brief Initialize the SDK
+         *
+         * Independent subsystems start in parallel on the executor. The power-aware
+         * outbox and the ingestion worker start on first use.
          * @return true if initialization successful, false otherwise
          */
         bool initialize();
@@ -140,6 +180,8 @@ namespace cardano_iot
         // Device Management
         /**
          * @brief Register a new IoT device
+         *
+         * In a cluster the device is registered on the node owning its id.
          * @param device_info Device information
          * @return true if registration successful
          */
@@ -158,6 +200,8 @@ namespace cardano_iot
 
         /**
          * @brief Get list of registered devices
+         *
+         * In a cluster the list covers every reachable node and is sorted.
          * @return Vector of device IDs
          */
         std::vector<std::string> get_registered_devices() const;
@@ -165,13 +209,111 @@ namespace cardano_iot
         // Data Management
         /**
          * @brief Submit IoT data to the blockchain
+         *
+         * In a cluster, readings of devices owned by another node are committed
+         * there; batches send one request per owning node.
          * @param data IoT data to submit
          * @return Transaction ID if successful, empty string otherwise
          */
         std::string submit_data(const IoTData &data);
 
+        /**
+         * @brief Submit IoT data, moving its hash, signature and metadata into storage
+         *
+         * The allocation-free path for callers that build a reading per call: with
+         * no data event callback set, only the returned ID is allocated (storage
+         * growth is amortised over segments).
+         * @param data IoT data to submit (consumed)
+         * @return Transaction ID if successful, empty string otherwise
+         */
+        std::string submit_data(IoTData &&data);
+
+        /**
+         * @brief Submit a batch of IoT data in a single pipeline pass
+         *
+         * Validation, the registration check (once per distinct device), the storage
+         * lock, logging and callback dispatch are amortized across the whole batch.
+         * @param batch IoT data entries (consumed)
+         * @return Transaction ID per entry, in input order; empty string for rejected entries
+         */
+        std::vector<std::string> submit_data_batch(std::vector<IoTData> &&batch);
+
+        /**
+         * @brief Queue IoT data for asynchronous submission
+         *
+         * Entries are validated on the caller thread, then hashed and committed in
+         * batches by the ingestion worker. Results are reported through the data
+         * batch and transaction event callbacks.
+         * @param data IoT data to submit (consumed)
+         * @return true if queued, false if invalid or the queue is full
+         */
+        bool enqueue_data(IoTData &&data);
+
+        /**
+         * @brief Wait until all queued data has been committed
+         * @param timeout_ms Maximum time to wait
+         * @return true if the queue drained within the timeout
+         */
+        bool flush_data_queue(uint32_t timeout_ms = 5000);
+
+        /**
+         * @brief Change Config::ingestion_batch_size while the pipeline runs
+         */
+        void set_ingestion_batch_size(uint32_t batch_size);
+        uint32_t get_ingestion_batch_size() const;
+
+        /**
+         * @brief The SDK-wide executor for background work (nullptr before initialize())
+         *
+         * Hand it to standalone components (CardanoClient::set_executor,
+         * CryptoManager::set_executor) so the whole process shares one pool.
+         */
+        std::shared_ptr<utils::Executor> get_executor() const;
+
+        /**
+         * @brief Get number of readings waiting in the ingestion queue
+         * @return Queue depth
+         */
+        size_t get_pending_data_count() const;
+
+        /**
+         * @brief Hold IoT data until its device can transmit cheaply
+         *
+         * With power management on, a battery device's operations are queued
+         * and sent together when it charges, harvests a surplus, fills a batch,
+         * or reaches max_delay_ms (default: its heartbeat interval). Results
+         * are reported through the data and transaction event callbacks.
+         * @param data IoT data to submit (consumed)
+         * @param max_delay_ms Latest send time from now; 0 = the device default
+         * @return true if accepted
+         */
+        bool queue_data(IoTData &&data, uint32_t max_delay_ms = 0);
+
+        /**
+         * @brief Hold an ADA transfer in the same outbox as queue_data
+         * @param device_id Target device
+         * @param amount Amount in lovelace
+         * @param max_delay_ms Latest send time from now; 0 = the device default
+         * @return true if accepted
+         */
+        bool queue_ada_transfer(const std::string &device_id, uint64_t amount, uint32_t max_delay_ms = 0);
+
+        /**
+         * @brief Send everything held in the outbox now
+         * @return Number of operations sent
+         */
+        size_t flush_outbox();
+
+        /**
+         * @brief Get number of operations held in the outbox
+         * @return Outbox depth
+         */
+        size_t get_outbox_pending_count() const;
+
         /**
          * @brief Query IoT data from the blockchain
+         *
+         * In a cluster the query is answered by the node owning the device.
          * @param device_id Device identifier
          * @param start_time Start timestamp
          * @param end_time End timestamp
@@ -181,6 +323,28 @@ namespace cardano_iot
                                         uint64_t start_time = 0,
                                         uint64_t end_time = 0) const;
 
+        /**
+         * @brief Query IoT data without materializing IoTData copies
+         *
+         * The returned view shares the store's sealed segments and stays valid
+         * while new data is submitted. With payload encoding enabled, record
+         * payloads are in stored form; decode_payload() restores them.
+         * @param device_id Device identifier
+         * @param start_time Start timestamp (0 = unbounded)
+         * @param end_time End timestamp (0 = unbounded)
+         * @return Time-sorted view over the matching entries
+         */
+        data::TimeSeriesView query_data_view(const std::string &device_id,
+                                             uint64_t start_time = 0,
+                                             uint64_t end_time = 0) const;
+
+        /**
+         * @brief Restore a payload as submitted from its stored form
+         * @param stored Payload of a record from query_data_view()
+         * @return Submitted payload; empty if the stored form is corrupt
+         */
+        std::string decode_payload(std::string_view stored) const;
+
         /**
          * @brief Verify data integrity
          * @param data IoT data to verify
@@ -225,6 +389,61 @@ namespace cardano_iot
          */
         uint64_t get_device_balance(const std::string &device_id) const;
 
+        // Asynchronous API
+        /**
+         * @brief Completion callback for the *_async calls: the result the
+         * synchronous call would have returned (empty string on failure)
+         */
+        using AsyncResultCallback = std::function<void(const std::string &)>;
+
+        /**
+         * @brief Asynchronous submit_data
+         *
+         * The reading is validated here, then travels the ingestion pipeline and
+         * is committed with its batch, so thousands of submissions can be in flight
+         * without a thread each. The future completes on the ingestion worker.
+         * @param data IoT data to submit (consumed)
+         * @return Future transaction ID; empty if the reading is rejected or the queue is full
+         */
+        utils::Future<std::string> submit_data_async(IoTData data);
+
+        /**
+         * @brief Asynchronous deploy_contract, run on the shared executor
+         * @return Future contract address; empty if the SDK is not initialized
+         */
+        utils::Future<std::string> deploy_contract_async(const std::string &contract_code,
+                                                         const std::map<std::string, std::string> &parameters);
+
+        /**
+         * @brief Asynchronous execute_contract, run on the shared executor
+         * @return Future execution result; empty if the SDK is not initialized
+         */
+        utils::Future<std::string> execute_contract_async(const std::string &contract_address,
+                                                          const std::string &function_name,
+                                                          const std::map<std::string, std::string> &parameters);
+
+        /**
+         * @brief Asynchronous send_ada, run on the shared executor
+         * @return Future transaction ID; empty if the SDK is not initialized
+         */
+        utils::Future<std::string> send_ada_async(const std::string &device_id, uint64_t amount);
+
+        /**
+         * @brief Callback variants of the calls above
+         *
+         * The callback runs exactly once, on an executor worker, or inline when
+         * the SDK is not running.
+         */
+        void submit_data_async(IoTData data, AsyncResultCallback callback);
+        void deploy_contract_async(const std::string &contract_code,
+                                   const std::map<std::string, std::string> &parameters,
+                                   AsyncResultCallback callback);
+        void execute_contract_async(const std::string &contract_address,
+                                    const std::string &function_name,
+                                    const std::map<std::string, std::string> &parameters,
+                                    AsyncResultCallback callback);
+        void send_ada_async(const std::string &device_id, uint64_t amount, AsyncResultCallback callback);
+
         // Energy Management
         /**
          * @brief Set device power mode
@@ -240,6 +459,16 @@ namespace cardano_iot
          */
         std::map<std::string, double> get_power_stats(const std::string &device_id) const;
 
+        /**
+         * @brief Apply a batch of device heartbeats, battery and power readings
+         *
+         * Updates the device and power managers in one pass each instead of
+         * four calls per device.
+         * @param records Telemetry records
+         * @return Number of records matching a registered device
+         */
+        size_t apply_telemetry_batch(const std::vector<core::DeviceTelemetry> &records);
+
         // Event Handling
         /**
          * @brief Event callback types
@@ -247,6 +476,8 @@ namespace cardano_iot
         using DeviceEventCallback = std::function<void(const std::string &, const std::string &)>;
         using DataEventCallback = std::function<void(const IoTData &)>;
         using TransactionEventCallback = std::function<void(const std::string &, bool)>;
+        using DataBatchEventCallback = std::function<void(const std::vector<IoTData> &,
+                                                          const std::vector<std::string> &)>;
 
         /**
          * @brief Set device event callback
@@ -266,6 +497,16 @@ namespace cardano_iot
          */
         void set_transaction_event_callback(TransactionEventCallback callback);
 
+        /**
+         * @brief Set data batch event callback
+         *
+         * When set, batch submissions invoke this once per committed batch (with the
+         * accepted entries and their transaction IDs) instead of invoking the per-item
+         * data and transaction callbacks.
+         * @param callback Function to call on committed batches
+         */
+        void set_data_batch_event_callback(DataBatchEventCallback callback);
+
         // Utility Functions
         /**
          * @brief Get SDK version
@@ -275,6 +516,11 @@ namespace cardano_iot
 
         /**
          * @brief Get network status
+         *
+         * Includes startup_<subsystem>_us entries with each subsystem's startup time.
+         * The same values are exported as the cardano_iot_sdk_startup_microseconds gauge.
+         * With the cluster enabled, cluster_endpoint is the address other nodes
+         * can use in Config::cluster_seeds.
          * @return Network information
          */
         std::map<std::string, std::string> get_network_status() const;
@@ -302,6 +548,41 @@ namespace cardano_iot
      */
     void shutdown_sdk();
 
+#ifdef CARDANO_IOT_HAS_COROUTINES
+    /**
+     * @brief Awaitable forms of the SDK's asynchronous API (C++20 builds)
+     *
+     * Each coroutine resumes its awaiter on the SDK executor, e.g.
+     * `std::string tx = co_await coro::submit_data(sdk, reading);`
+     */
+    namespace coro
+    {
+        inline utils::Task<std::string> submit_data(CardanoIoTSDK &sdk, CardanoIoTSDK::IoTData data)
+        {
+            co_return co_await utils::resume_on(sdk.get_executor(), sdk.submit_data_async(std::move(data)));
+        }
+
+        inline utils::Task<std::string> deploy_contract(CardanoIoTSDK &sdk, std::string contract_code,
+                                                        std::map<std::string, std::string> parameters)
+        {
+            co_return co_await utils::resume_on(sdk.get_executor(), sdk.deploy_contract_async(contract_code, parameters));
+        }
+
+        inline utils::Task<std::string> execute_contract(CardanoIoTSDK &sdk, std::string contract_address,
+                                                         std::string function_name,
+                                                         std::map<std::string, std::string> parameters)
+        {
+            co_return co_await utils::resume_on(sdk.get_executor(),
+                                                sdk.execute_contract_async(contract_address, function_name, parameters));
+        }
+
+        inline utils::Task<std::string> send_ada(CardanoIoTSDK &sdk, std::string device_id, uint64_t amount)
+        {
+            co_return co_await utils::resume_on(sdk.get_executor(), sdk.send_ada_async(device_id, amount));
+        }
+    } // namespace coro
+#endif
+
 } // namespace cardano_iot
 
 #endif // CARDANO_IOT_H
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "cardano_iot/core/transaction_manager.h"
+
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <functional>
+#include <cstdint>
+
+namespace cardano_iot
+{
+    namespace core
+    {
+        /**
+         * @brief Pre-sorted view of a wallet's UTXOs for repeated coin selection
+         *
+         * Built once per UTXO snapshot (one sort), then shared by every selection
+         * against that snapshot.
+         */
+        class CoinSelectionIndex
+        {
+        public:
+            explicit CoinSelectionIndex(std::vector<UTXO> utxos);
+
+            size_t size() const { return utxos_.size(); }
+            const UTXO &utxo(uint32_t position) const { return utxos_[position]; }
+            const std::vector<UTXO> &utxos() const { return utxos_; }
+            uint64_t total_lovelace() const { return total_lovelace_; }
+
+            /**
+             * @brief UTXO positions ordered by lovelace amount, largest first
+             */
+            const std::vector<uint32_t> &by_amount_desc() const { return by_amount_desc_; }
+
+            /**
+             * @brief UTXO positions holding a token, largest holding first (nullptr if none)
+             */
+            const std::vector<uint32_t> *holders(const std::string &token) const;
+
+        private:
+            std::vector<UTXO> utxos_;
+            std::vector<uint32_t> by_amount_desc_;
+            std::unordered_map<std::string, std::vector<uint32_t>> token_holders_;
+            uint64_t total_lovelace_ = 0;
+        };
+
+        /**
+         * @brief Tuning knobs for coin selection
+         */
+        struct CoinSelectionParams
+        {
+            uint64_t cost_of_change = 0;  // excess accepted as fee instead of creating change
+            uint64_t cost_per_input = 0;  // marginal fee of spending one more input
+            size_t max_inputs = 0;        // 0 = unlimited
+            size_t bnb_max_tries = 100000;
+            uint64_t seed = 0;            // 0 = random seed
+
+            // Optional filter for outputs that are reserved or spent since the index was built
+            std::function<bool(const UTXO &)> is_available;
+        };
+
+        /**
+         * @brief Outcome of a coin selection
+         */
+        struct CoinSelectionResult
+        {
+            bool success = false;
+            std::vector<UTXO> selected;
+            uint64_t total_lovelace = 0;
+            std::map<std::string, uint64_t> total_tokens;
+            uint64_t change_lovelace = 0;
+            bool changeless = false;     // branch-and-bound found a match within cost_of_change
+            size_t inputs_evaluated = 0; // candidate UTXOs examined
+            std::string algorithm;
+        };
+
+        /**
+         * @brief Coin selection over a CoinSelectionIndex
+         *
+         * Token requirements are covered first from the largest holders, then the
+         * remaining lovelace according to the strategy. OPTIMAL_FEE tries
+         * branch-and-bound for a change-less match and falls back to CIP-2
+         * Random-Improve.
+         */
+        class CoinSelector
+        {
+        public:
+            static CoinSelectionResult select(const CoinSelectionIndex &index,
+                                              uint64_t target_lovelace,
+                                              const std::map<std::string, uint64_t> &required_tokens,
+                                              TransactionManager::UTXOSelectionStrategy strategy,
+                                              const CoinSelectionParams &params = {});
+        };
+
+    } // namespace core
+} // namespace cardano_iot
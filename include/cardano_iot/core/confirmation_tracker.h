@@ -0,0 +1,107 @@
+#pragma once
+
+#include "cardano_iot/core/transaction_manager.h"
+#include "cardano_iot/network/cardano_client.h"
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <future>
+#include <chrono>
+#include <functional>
+#include <cstdint>
+
+namespace cardano_iot
+{
+    namespace core
+    {
+        /**
+         * @brief Tracks many submitted transactions from a single thread
+         *
+         * The tracker polls the chain tip and, whenever a new block appears, checks
+         * every pending transaction through one batched status query per
+         * batch_size ids. Timeouts live in a hashed timer wheel, so a tick only
+         * touches the transactions whose deadline falls in that tick. Results are
+         * delivered through futures returned by track() and through the
+         * confirmation callback.
+         */
+        class ConfirmationTracker
+        {
+        public:
+            // Current tip; a change in height or hash triggers a batch check, an empty hash means unknown
+            using TipProvider = std::function<network::ChainTip()>;
+
+            // Status of each id, in order; CONFIRMED, FAILED and CANCELLED resolve, anything else stays pending
+            using StatusQuery = std::function<std::vector<TransactionStatus>(const std::vector<std::string> &tx_ids)>;
+
+            struct Config
+            {
+                std::chrono::milliseconds tick{100};                // timer wheel resolution
+                size_t wheel_slots = 512;
+                std::chrono::milliseconds tip_poll_interval{1000};  // how often the tip is fetched
+                std::chrono::milliseconds max_check_interval{20000}; // check even if the tip has not moved
+                size_t batch_size = 1000;                           // ids per status query
+            };
+
+            /**
+             * @param status_query Batched status lookup (required)
+             * @param tip_provider Chain tip source; without one every tip poll runs a check
+             */
+            ConfirmationTracker(StatusQuery status_query, TipProvider tip_provider = nullptr);
+            ConfirmationTracker(StatusQuery status_query, TipProvider tip_provider, const Config &config);
+            ~ConfirmationTracker();
+
+            ConfirmationTracker(const ConfirmationTracker &) = delete;
+            ConfirmationTracker &operator=(const ConfirmationTracker &) = delete;
+
+            /**
+             * @brief Tip provider backed by a CardanoClient (empty tip while disconnected)
+             */
+            static TipProvider client_tip_provider(std::shared_ptr<network::CardanoClient> client);
+
+            bool start();
+            void stop();
+            bool is_running() const;
+
+            /**
+             * @brief Start (or join) tracking a transaction
+             * @return Future set to true on confirmation, false on failure, timeout or stop
+             */
+            std::future<bool> track(const std::string &tx_id, std::chrono::milliseconds timeout);
+
+            /**
+             * @brief Stop tracking without resolving as confirmed (futures get false)
+             */
+            bool untrack(const std::string &tx_id);
+
+            /**
+             * @brief Called once per resolved transaction, on the tracker thread
+             */
+            void set_callback(ConfirmationCallback callback);
+
+            /**
+             * @brief Run a batch check on the next loop iteration regardless of the tip
+             */
+            void request_check();
+
+            size_t pending_count() const;
+
+            struct TrackerStats
+            {
+                uint64_t tracked;
+                uint64_t confirmed;
+                uint64_t failed;
+                uint64_t timed_out;
+                uint64_t batch_queries;
+                uint64_t tip_changes;
+            };
+
+            TrackerStats get_statistics() const;
+
+        private:
+            class Impl;
+            std::unique_ptr<Impl> pimpl_;
+        };
+
+    } // namespace core
+} // namespace cardano_iot
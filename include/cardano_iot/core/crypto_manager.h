@@ -7,6 +7,11 @@
 
 namespace cardano_iot
 {
+    namespace utils
+    {
+        class Executor;
+    }
+
     namespace core
     {
         // Cryptographic algorithm types
@@ -16,7 +21,8 @@ namespace cardano_iot
             ECDSA_SECP256K1,  // Elliptic Curve Digital Signature Algorithm
             BLS12_381,        // Boneh-Lynn-Shacham signature scheme
             AES_256_GCM,      // Advanced Encryption Standard with Galois/Counter Mode
-            CHACHA20_POLY1305 // ChaCha20-Poly1305 authenticated encryption
+            CHACHA20_POLY1305, // ChaCha20-Poly1305 authenticated encryption
+            DEMO_DIGEST        // Keyed SHA-256 stand-in for non-raw demo keys; only the message hash is checked
         };
 
         // Key pair structure
@@ -82,6 +88,19 @@ namespace cardano_iot
                 CryptoAlgorithm algorithm);
             bool verify_signature(const DigitalSignature &signature, const std::string &message);
 
+            // Batch signatures (large batches are spread across cores)
+            std::vector<std::unique_ptr<DigitalSignature>> sign_batch(
+                const std::vector<std::string> &messages,
+                const std::string &private_key,
+                CryptoAlgorithm algorithm);
+            std::vector<bool> verify_batch(const std::vector<DigitalSignature> &signatures,
+                                           const std::vector<std::string> &messages);
+
+            /**
+             * @brief Spread large batches over a shared executor instead of per-call threads
+             */
+            void set_executor(std::shared_ptr<utils::Executor> executor);
+
             // Symmetric encryption
             std::unique_ptr<EncryptionResult> encrypt_data(
                 const std::vector<uint8_t> &data,
@@ -93,6 +112,17 @@ namespace cardano_iot
 
             // Hash functions
             std::string compute_hash(const std::string &data, const std::string &algorithm = "SHA256");
+
+            /**
+             * @brief Hex digest of a buffer without copying it; SHA256, SHA512, BLAKE2b or BLAKE2s
+             */
+            std::string compute_hash(const uint8_t *data, size_t size, const std::string &algorithm = "SHA256");
+
+            /**
+             * @brief Hex digests of many small inputs at once, in input order (see utils::hash_many)
+             */
+            std::vector<std::string> compute_hashes(const std::vector<std::string> &inputs,
+                                                    const std::string &algorithm = "SHA256");
             std::string compute_hmac(const std::string &data, const std::string &key);
 
             // Cardano-specific operations
@@ -128,6 +158,8 @@ namespace cardano_iot
                 double avg_verify_time_ms;
                 double avg_encrypt_time_ms;
                 double avg_decrypt_time_ms;
+                double p95_sign_time_ms;
+                double p95_verify_time_ms;
             };
 
             CryptoStats get_statistics() const;
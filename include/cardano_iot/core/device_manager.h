@@ -18,6 +18,8 @@
 #include <memory>
 #include <functional>
 
+#include "cardano_iot/core/device_telemetry.h"
+
 namespace cardano_iot::core
 {
 
@@ -147,6 +149,9 @@ namespace cardano_iot::core
 
         /**
          * @brief Generate authentication challenge for device
+         *
+         * Replaces any earlier challenge for the device; an unanswered challenge
+         * expires after five minutes.
          * @param device_id Device identifier
          * @return Challenge string, empty if device not found
          */
@@ -245,6 +250,16 @@ namespace cardano_iot::core
          */
         bool update_battery_level(const std::string &device_id, double battery_level);
 
+        /**
+         * @brief Apply many heartbeats and battery readings at once
+         *
+         * Locks each registry shard once for the whole batch. BATTERY_LOW
+         * events fire after every lock is released, at most one per device.
+         * @param records Telemetry records; unknown devices are skipped
+         * @return Number of records applied
+         */
+        size_t apply_telemetry_batch(const std::vector<DeviceTelemetry> &records);
+
         /**
          * @brief Get device statistics
          * @return Statistics map
@@ -253,6 +268,9 @@ namespace cardano_iot::core
 
         /**
          * @brief Export device registry to file
+         *
+         * Writes a binary snapshot (see DeviceSnapshot) atomically, then journals
+         * later changes to file_path + ".wal" so the next import can replay them.
          * @param file_path Output file path
          * @return true if export successful
          */
@@ -260,6 +278,8 @@ namespace cardano_iot::core
 
         /**
          * @brief Import device registry from file
+         *
+         * Replaces the registered devices with the snapshot plus its journal.
          * @param file_path Input file path
          * @return true if import successful
          */
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "cardano_iot/core/device_manager.h"
+#include "cardano_iot/core/device_telemetry.h"
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace cardano_iot
+{
+    namespace core
+    {
+        /**
+         * @brief Device map split into independently locked shards, with secondary indexes
+         *
+         * Every shard indexes its devices by status, by capability bit and by
+         * last heartbeat. A query therefore visits only the matching devices plus
+         * one lock per shard. get_stale returns its results in O(stale), not
+         * O(all). A heartbeat only locks its own shard, and it takes that lock
+         * exclusively only when the second has changed. Re-ordering uses
+         * multimap node extraction, which allocates nothing.
+         *
+         * status and last_seen of a registered device must be changed through
+         * this class, or the indexes go stale. Capabilities are indexed at
+         * insertion and are fixed from then on.
+         */
+        class DeviceRegistry
+        {
+        public:
+            static constexpr size_t STATUS_COUNT = static_cast<size_t>(DeviceStatus::UPDATING) + 1;
+            static constexpr size_t CAPABILITY_BITS = 32;
+
+            explicit DeviceRegistry(size_t shard_count = 16);
+
+            /**
+             * @return false if a device with the same id is already registered
+             */
+            bool insert(std::shared_ptr<Device> device);
+            std::shared_ptr<Device> erase(const std::string &device_id);
+            std::shared_ptr<Device> find(const std::string &device_id) const;
+
+            /**
+             * @param old_status Set to the status before the change
+             */
+            bool set_status(const std::string &device_id, DeviceStatus status, DeviceStatus *old_status = nullptr);
+            bool touch(const std::string &device_id, uint64_t now);
+
+            /**
+             * @brief Apply heartbeats and battery readings, taking each shard's lock once
+             *
+             * Records are grouped by shard first, so a batch of n records costs
+             * one exclusive lock per touched shard instead of n.
+             * @param applied Resized to records.size(); 1 where the device is registered
+             * @return Number of records applied
+             */
+            size_t apply_telemetry(const std::vector<DeviceTelemetry> &records, uint64_t now,
+                                   std::vector<uint8_t> &applied);
+
+            std::vector<std::string> ids() const;
+            std::vector<std::string> by_status(DeviceStatus status) const;
+
+            /**
+             * @brief Devices with any of the bits in mask
+             */
+            std::vector<std::string> by_capability(uint32_t mask) const;
+
+            /**
+             * @brief Devices whose last heartbeat is at or before cutoff
+             */
+            std::vector<std::string> stale(uint64_t cutoff) const;
+
+            size_t size() const;
+            std::array<size_t, STATUS_COUNT> status_counts() const;
+
+            /**
+             * @brief Visit every device, one shard at a time under its shared lock
+             */
+            void for_each(const std::function<void(const Device &)> &visitor) const;
+            void clear();
+
+        private:
+            using HeartbeatIndex = std::multimap<uint64_t, const Device *>;
+
+            struct Entry
+            {
+                std::shared_ptr<Device> device;
+                HeartbeatIndex::iterator heartbeat;
+            };
+
+            struct alignas(64) Shard
+            {
+                mutable std::shared_mutex mutex;
+                std::unordered_map<std::string, Entry> devices;
+                std::array<std::unordered_set<const Device *>, STATUS_COUNT> by_status;
+                std::array<std::unordered_set<const Device *>, CAPABILITY_BITS> by_capability;
+                HeartbeatIndex by_heartbeat;
+            };
+
+            std::vector<Shard> shards_;
+
+            size_t shard_index(const std::string &device_id) const;
+            Shard &shard_for(const std::string &device_id);
+            const Shard &shard_for(const std::string &device_id) const;
+        };
+
+    } // namespace core
+} // namespace cardano_iot
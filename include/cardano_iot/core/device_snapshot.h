@@ -0,0 +1,99 @@
+#pragma once
+
+#include "cardano_iot/core/device_registry.h"
+
+#include <cstdint>
+#include <string>
+
+namespace cardano_iot
+{
+    namespace core
+    {
+        /**
+         * @brief Versioned binary snapshot of a DeviceRegistry
+         *
+         * Layout (integers little endian):
+         *   header: "CIOTDREG" | version u32 | reserved u32 | generation u64 |
+         *           device_count u64 | string_count u32 | record_bytes u32 |
+         *           records_offset u64 | blob_offset u64 | total_bytes u64 |
+         *           tree_hash[32] of everything after the header
+         *   string table: string_count varint-length strings
+         *   records: device_count fixed-width records, 8-byte aligned
+         *   blob: the per-device strings (id, keys, address, metadata values)
+         *
+         * Values that repeat across a fleet (type, manufacturer, model, firmware,
+         * hardware revision, location, metadata keys) are stored once in the
+         * string table, and records refer to them by index. Writing goes to
+         * path.tmp, which is synced and renamed over path. Loading maps the file
+         * and decodes records on several threads straight into the registry.
+         */
+        class DeviceSnapshot
+        {
+        public:
+            static constexpr uint32_t FORMAT_VERSION = 1;
+
+            struct Options
+            {
+                unsigned threads = 0; // 0 = hardware concurrency
+            };
+
+            /**
+             * @param generation Stored in the header; pairs the snapshot with its journal
+             */
+            static bool write(const std::string &path, const DeviceRegistry &registry, uint64_t generation);
+
+            /**
+             * @brief Insert every device in the snapshot into registry
+             * @return false for a missing, corrupt or unsupported file; the registry may then hold part of it
+             */
+            static bool load(const std::string &path, DeviceRegistry &registry, uint64_t &generation,
+                             const Options &options, size_t *loaded = nullptr);
+        };
+
+        /**
+         * @brief Write-ahead journal of registry changes made since the last snapshot
+         *
+         * Starts with "CIOTDWAL" | version u32 | reserved u32 | generation u64.
+         * Each entry is then framed as length u32 | crc32 u32 | kind u8 | body,
+         * and is either a whole device (upsert) or a device id (remove). A journal
+         * applies only on top of the snapshot with the same generation. A journal
+         * left over from an older snapshot is ignored, because its changes are
+         * already in the newer snapshot. Replay cuts off a torn tail. Not
+         * thread-safe; the owner serialises calls.
+         */
+        class DeviceJournal
+        {
+        public:
+            DeviceJournal() = default;
+            ~DeviceJournal();
+
+            DeviceJournal(const DeviceJournal &) = delete;
+            DeviceJournal &operator=(const DeviceJournal &) = delete;
+
+            /**
+             * @brief Append to the journal at path, starting it over unless it is of this generation
+             */
+            bool open(const std::string &path, uint64_t generation, bool truncate);
+            void close();
+            bool is_open() const { return fd_ >= 0; }
+
+            bool record_upsert(const Device &device);
+            bool record_remove(const std::string &device_id);
+            uint64_t size() const { return size_; }
+
+            /**
+             * @brief Apply the journal at path to registry; a missing or older journal applies nothing
+             */
+            static bool replay(const std::string &path, uint64_t generation, DeviceRegistry &registry,
+                               size_t *applied = nullptr);
+
+        private:
+            int fd_ = -1;
+            uint64_t size_ = 0;
+            std::string scratch_;
+
+            bool append(uint8_t kind, const std::string &body);
+        };
+
+    } // namespace core
+} // namespace cardano_iot
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace cardano_iot
+{
+    namespace core
+    {
+        /**
+         * @brief One device's periodic report, as applied by the apply_telemetry_batch calls
+         *
+         * Any field can be left out, so a report may be a bare heartbeat or
+         * carry readings only. A negative battery_level or power_mw means "not
+         * reported".
+         */
+        struct DeviceTelemetry
+        {
+            static constexpr double NOT_REPORTED = -1.0;
+
+            std::string device_id;
+            bool heartbeat = true;
+            double battery_level = NOT_REPORTED; // 0.0 - 1.0
+            double power_mw = NOT_REPORTED;
+
+            bool has_battery() const { return battery_level >= 0.0; }
+            bool has_power() const { return power_mw >= 0.0; }
+        };
+
+    } // namespace core
+} // namespace cardano_iot
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "cardano_iot/core/smart_contract_interface.h"
+
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace cardano_iot
+{
+    namespace core
+    {
+        /**
+         * @brief Arena-backed Plutus Data trees with a direct CBOR codec
+         *
+         * Nodes are fixed-size records in one vector. Children are index ranges
+         * into a second vector, and byte strings are ranges of a shared byte
+         * pool, so a whole datum is three contiguous allocations. clear() keeps
+         * the capacity. Once an arena has held a datum of some shape, building,
+         * encoding or decoding another one of that size allocates nothing.
+         *
+         * Build values bottom-up: add_* creates a leaf, and begin_* ... end()
+         * wraps every value added in between as its children. Map children
+         * alternate key, value. Top-level values are independent roots.
+         *
+         * The CBOR is the ledger's Plutus Data encoding. Constructors use tags
+         * 121-127 / 1280-1400 / 102, and non-empty lists and byte strings
+         * longer than 64 bytes are indefinite-length. Booleans encode as
+         * Constr 1 [] / Constr 0 [] and unit as Constr 0 [], so they decode back
+         * as constructors. Integers are 64-bit.
+         */
+        class PlutusDataArena
+        {
+        public:
+            using NodeId = uint32_t;
+
+            struct Node
+            {
+                PlutusDataType type = PlutusDataType::UNIT;
+                uint32_t offset = 0; // into children (list, map, constructor) or the byte pool
+                uint32_t length = 0; // children (map: 2 per entry) or bytes
+                int64_t value = 0;   // integer, boolean or constructor tag
+            };
+
+            void clear();
+            void reserve(size_t nodes, size_t bytes);
+
+            // Leaves
+            NodeId add_integer(int64_t value);
+            NodeId add_bytes(const uint8_t *data, size_t length);
+            NodeId add_text(std::string_view text) { return add_bytes(reinterpret_cast<const uint8_t *>(text.data()), text.size()); }
+            NodeId add_bool(bool value);
+            NodeId add_unit();
+
+            // Containers; end() closes the innermost one and returns it
+            void begin_list();
+            void begin_map();
+            void begin_constructor(uint64_t tag);
+            NodeId end();
+
+            /**
+             * @brief Copy a PlutusData tree into the arena
+             */
+            NodeId import(const PlutusData &data);
+
+            /**
+             * @brief Build a PlutusData tree from a node (map keys as their bytes)
+             */
+            PlutusData to_plutus_data(NodeId id) const;
+
+            const Node &node(NodeId id) const { return nodes_[id]; }
+            PlutusDataType type(NodeId id) const { return nodes_[id].type; }
+            int64_t integer(NodeId id) const { return nodes_[id].value; }
+            uint64_t constructor_tag(NodeId id) const { return static_cast<uint64_t>(nodes_[id].value); }
+            std::string_view bytes(NodeId id) const;
+            size_t child_count(NodeId id) const { return nodes_[id].length; }
+            NodeId child(NodeId id, size_t index) const { return children_[nodes_[id].offset + index]; }
+            size_t node_count() const { return nodes_.size(); }
+
+            /**
+             * @brief Append the CBOR encoding of a node to out
+             */
+            void encode(NodeId id, std::vector<uint8_t> &out) const;
+
+            /**
+             * @brief Decode one CBOR Plutus Data item into the arena
+             * @return false on malformed input; the arena then holds partial nodes
+             */
+            bool decode(const uint8_t *data, size_t length, NodeId &root);
+
+        private:
+            struct Open
+            {
+                PlutusDataType type;
+                int64_t tag;
+                size_t first_pending;
+            };
+
+            std::vector<Node> nodes_;
+            std::vector<NodeId> children_;
+            std::vector<uint8_t> bytes_;
+            std::vector<NodeId> pending_; // children of open containers
+            std::vector<Open> open_;
+
+            NodeId push(const Node &node);
+            bool decode_item(const uint8_t *&pos, const uint8_t *end, unsigned depth);
+        };
+
+    } // namespace core
+} // namespace cardano_iot
@@ -0,0 +1,183 @@
+#pragma once
+
+#include "cardano_iot/core/smart_contract_interface.h"
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace cardano_iot
+{
+    namespace core
+    {
+        namespace uplc
+        {
+            /**
+             * @brief Untyped Plutus Core builtins, numbered as in the Flat encoding
+             */
+            enum class Builtin : uint8_t
+            {
+                ADD_INTEGER = 0,
+                SUBTRACT_INTEGER,
+                MULTIPLY_INTEGER,
+                DIVIDE_INTEGER,
+                QUOTIENT_INTEGER,
+                REMAINDER_INTEGER,
+                MOD_INTEGER,
+                EQUALS_INTEGER,
+                LESS_THAN_INTEGER,
+                LESS_THAN_EQUALS_INTEGER,
+                APPEND_BYTESTRING,
+                CONS_BYTESTRING,
+                SLICE_BYTESTRING,
+                LENGTH_OF_BYTESTRING,
+                INDEX_BYTESTRING,
+                EQUALS_BYTESTRING,
+                LESS_THAN_BYTESTRING,
+                LESS_THAN_EQUALS_BYTESTRING,
+                SHA2_256,
+                SHA3_256,
+                BLAKE2B_256,
+                VERIFY_ED25519_SIGNATURE,
+                APPEND_STRING,
+                EQUALS_STRING,
+                ENCODE_UTF8,
+                DECODE_UTF8,
+                IF_THEN_ELSE,
+                CHOOSE_UNIT,
+                TRACE,
+                FST_PAIR,
+                SND_PAIR,
+                CHOOSE_LIST,
+                MK_CONS,
+                HEAD_LIST,
+                TAIL_LIST,
+                NULL_LIST,
+                CHOOSE_DATA,
+                CONSTR_DATA,
+                MAP_DATA,
+                LIST_DATA,
+                I_DATA,
+                B_DATA,
+                UN_CONSTR_DATA,
+                UN_MAP_DATA,
+                UN_LIST_DATA,
+                UN_I_DATA,
+                UN_B_DATA,
+                EQUALS_DATA,
+                MK_PAIR_DATA,
+                MK_NIL_DATA,
+                MK_NIL_PAIR_DATA,
+                SERIALISE_DATA,
+                BUILTIN_COUNT
+            };
+
+            /**
+             * @brief CPU and memory units, as budgeted by the ledger
+             */
+            struct ExBudget
+            {
+                uint64_t cpu = 0;
+                uint64_t memory = 0;
+            };
+
+            /**
+             * @brief A decoded, scope-checked UPLC program
+             *
+             * Terms live in one arena and refer to their children by index, so a
+             * program is parsed once and then evaluated any number of times, from
+             * any number of threads. The builder calls below are mainly for tests
+             * and tooling; each returns the new term's index, and set_root() picks
+             * the program body.
+             */
+            class Program
+            {
+            public:
+                Program();
+                ~Program();
+
+                Program(Program &&other) noexcept;
+                Program &operator=(Program &&other) noexcept;
+                Program(const Program &) = delete;
+                Program &operator=(const Program &) = delete;
+
+                // Term builders; var indices are de Bruijn, 1 = innermost binder
+                uint32_t var(uint32_t index);
+                uint32_t lambda(uint32_t body);
+                uint32_t apply(uint32_t function, uint32_t argument);
+                uint32_t delay(uint32_t term);
+                uint32_t force(uint32_t term);
+                uint32_t error();
+                uint32_t builtin(Builtin function);
+                uint32_t integer(int64_t value);
+                uint32_t bytestring(const std::vector<uint8_t> &value);
+                uint32_t boolean(bool value);
+                uint32_t unit();
+                uint32_t data(const PlutusData &value);
+                uint32_t constr(uint64_t tag, const std::vector<uint32_t> &fields);
+                uint32_t case_of(uint32_t scrutinee, const std::vector<uint32_t> &branches);
+
+                void set_root(uint32_t term);
+                void set_version(uint32_t major, uint32_t minor, uint32_t patch);
+
+                size_t term_count() const;
+
+                /**
+                 * @brief Every variable bound, every builtin known, constr/case only from 1.1.0
+                 */
+                bool validate(std::string *error = nullptr) const;
+
+                struct Impl;
+                const Impl &impl() const { return *pimpl_; }
+
+            private:
+                friend bool decode_script(const uint8_t *data, size_t length, Program &program, std::string *error);
+
+                std::unique_ptr<Impl> pimpl_;
+            };
+
+            /**
+             * @brief Decode script bytes as found on chain: Flat, wrapped in one or two CBOR byte strings
+             * @return false if the bytes are not a well-formed, valid program
+             */
+            bool decode_script(const uint8_t *data, size_t length, Program &program, std::string *error = nullptr);
+
+            /**
+             * @brief Flat-encode a program and wrap it in one CBOR byte string
+             */
+            std::vector<uint8_t> encode_script(const Program &program);
+
+            /**
+             * @brief CBOR encoding of a value as Plutus Data, as passed to evaluate()
+             */
+            std::vector<uint8_t> serialise_data(const PlutusData &value);
+
+            struct EvalResult
+            {
+                bool success = false;
+                PlutusData value;        // The result, if it is a constant or a constructor of constants
+                ExBudget consumed;
+                std::vector<std::string> logs; // trace messages
+                std::string error_message;
+            };
+
+            /**
+             * @brief Apply the program to arguments and run it on a CEK machine
+             *
+             * Arguments are passed as Data, like datums and redeemers: integers
+             * become I, byte strings B, booleans Constr 0/1, unit Constr 0 and maps
+             * are keyed by their UTF-8 key bytes. Costs are charged per machine
+             * step and per saturated builtin. The figures come from the Plutus V2
+             * default cost model, with each builtin's linear term taken over the
+             * summed argument sizes. Integers are 64-bit, so overflow is an
+             * evaluation error. SHA3, BLAKE2b and signature verification are not
+             * available and fail the evaluation.
+             */
+            EvalResult evaluate(const Program &program, const std::vector<PlutusData> &arguments,
+                                const ExBudget &limit);
+
+        } // namespace uplc
+    } // namespace core
+} // namespace cardano_iot
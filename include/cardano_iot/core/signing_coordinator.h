@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace cardano_iot
+{
+    namespace network
+    {
+        class P2PNetwork;
+    }
+
+    namespace core
+    {
+        struct Transaction;
+        class TransactionManager;
+
+        /**
+         * @brief Multisig signing sessions over P2PNetwork
+         *
+         * collect() sends the transaction body hash to every co-signer at once.
+         * Witnesses are verified in batches as they arrive, meaning everything
+         * received since the last wake-up goes through one verify_witnesses()
+         * call. The session ends as soon as the threshold is met, so its latency
+         * is that of the slowest signer it needs rather than the sum over all
+         * signers. It also ends early once too many signers have refused for the
+         * threshold to be reachable. The accepted witnesses then go into the
+         * transaction's CBOR witness set with a single re-encode.
+         *
+         * The signer side is serve(), which answers requests with an Ed25519
+         * witness made with the device's key. Both sides may run on one network,
+         * and any number of sessions may run at once.
+         */
+        class SigningCoordinator
+        {
+        public:
+            struct Signer
+            {
+                std::string peer_id;
+                std::string verification_key; // Hex vkey the witness must carry; required
+            };
+
+            struct Result
+            {
+                bool complete = false;              // Threshold met
+                std::vector<std::string> signed_by; // Peers whose witness was accepted, in arrival order
+                std::vector<std::string> rejected;  // Peers that refused, were unreachable or sent a bad witness
+                uint64_t elapsed_ms = 0;
+            };
+
+            struct Stats
+            {
+                uint64_t sessions = 0;
+                uint64_t completed = 0;
+                uint64_t witnesses_accepted = 0;
+                uint64_t witnesses_rejected = 0;
+                uint64_t requests_served = 0; // Signer side
+            };
+
+            /**
+             * @brief Decide whether to sign a body hash; runs on a transport thread
+             */
+            using Approver = std::function<bool(const std::string &tx_id, const std::string &body_hash,
+                                                const std::string &coordinator)>;
+
+            SigningCoordinator(network::P2PNetwork &network, TransactionManager &transactions);
+            ~SigningCoordinator();
+
+            SigningCoordinator(const SigningCoordinator &) = delete;
+            SigningCoordinator &operator=(const SigningCoordinator &) = delete;
+
+            /**
+             * @brief Gather threshold witnesses for a transaction from its signers
+             * @param transaction Receives the accepted witnesses (also on timeout, and complete stays false)
+             * @param signers Co-signers; each may contribute one witness for its own key. A signer
+             *        without a verification key fails the session before any request is sent
+             * @param threshold Witnesses needed
+             * @param timeout_ms Upper bound on the whole session
+             */
+            Result collect(Transaction &transaction, const std::vector<Signer> &signers, uint32_t threshold,
+                           uint32_t timeout_ms = 30000);
+
+            /**
+             * @brief Answer signing requests from other peers
+             * @param signing_key Raw 32-byte Ed25519 seed in hex
+             * @param approver Optional check before signing; without one every request is signed
+             */
+            void serve(const std::string &signing_key, Approver approver = nullptr);
+
+            Stats stats() const;
+
+        private:
+            struct Impl;
+            std::shared_ptr<Impl> pimpl_; // Shared with the network handlers, which may outlive a call
+        };
+
+    } // namespace core
+} // namespace cardano_iot
@@ -6,11 +6,19 @@
 #include <map>
 #include <functional>
 #include <variant>
+#include <cstdint>
 
 namespace cardano_iot
 {
+    namespace network
+    {
+        class CardanoClient;
+    }
+
     namespace core
     {
+        class PlutusDataArena;
+
         // Plutus data types
         enum class PlutusDataType
         {
@@ -109,6 +117,36 @@ namespace cardano_iot
             std::string transaction_hash;
         };
 
+        // One call of a batch with the contract state it touches
+        struct BatchCall
+        {
+            std::string contract_address;
+            std::string function_name;
+            std::vector<PlutusData> parameters;
+            uint64_t amount_lovelace = 0;
+            std::vector<std::string> reads;  // State variables read; empty with writes = the whole contract
+            std::vector<std::string> writes; // State variables written
+        };
+
+        // Outcome of a batch, one log per call in submission order
+        struct BatchExecutionResult
+        {
+            std::string batch_id;
+            std::vector<ExecutionLog> logs;
+            std::vector<std::string> transaction_hashes; // Distinct transactions the calls were packed into
+        };
+
+        // Result of a read-only call evaluated by the local UPLC evaluator
+        struct ReadonlyCallResult
+        {
+            ExecutionResult result = ExecutionResult::SCRIPT_ERROR;
+            PlutusData value;
+            uint64_t cpu_units = 0;
+            uint64_t memory_units = 0;
+            bool from_cache = false; // answered from the memo of the current chain tip
+            std::string error_message;
+        };
+
         // Contract event
         struct ContractEvent
         {
@@ -180,11 +218,31 @@ namespace cardano_iot
                 uint64_t amount_lovelace = 0,
                 const std::string &device_id = "");
 
+            /**
+             * @brief Read-only call; returns the encoded result, or "" if evaluation failed
+             *
+             * Contracts deployed with a UPLC script are evaluated locally (see
+             * evaluate_readonly_function); other contracts get the simulated result.
+             */
             std::string call_readonly_function(
                 const std::string &contract_address,
                 const std::string &function_name,
                 const std::vector<PlutusData> &parameters) const;
 
+            /**
+             * @brief Evaluate a read-only call on the contract's cached script
+             *
+             * The script is applied to the function name (as a byte string), the
+             * contract's state variables (as a map), then the parameters, all as
+             * Plutus Data. Results are memoized per chain tip and state version,
+             * so repeated identical queries between blocks cost one lookup.
+             * Nothing is submitted and no execution log is written.
+             */
+            ReadonlyCallResult evaluate_readonly_function(
+                const std::string &contract_address,
+                const std::string &function_name,
+                const std::vector<PlutusData> &parameters) const;
+
             // State querying
             std::shared_ptr<ContractState> get_contract_state(const std::string &contract_address) const;
             PlutusData query_state_variable(
@@ -206,6 +264,15 @@ namespace cardano_iot
                 const std::string &contract_address,
                 const std::string &event_name);
 
+            /**
+             * @brief Watch subscribed contract addresses on chain through a node client
+             *
+             * Every contract address with an event subscription is added to the
+             * client's block stream; each transaction touching one is emitted as a
+             * "Transaction" event (to subscribers of that name or of "*").
+             */
+            void set_chain_client(std::shared_ptr<network::CardanoClient> client);
+
             std::vector<ContractEvent> get_events(
                 const std::string &contract_address,
                 const std::string &event_name = "",
@@ -227,15 +294,34 @@ namespace cardano_iot
                 const std::string &function_name,
                 const std::vector<PlutusData> &parameters) const;
 
+            /**
+             * @brief CPU units of a local evaluation for UPLC scripts, a size-based guess otherwise
+             */
             uint64_t estimate_execution_units(
                 const std::string &script_cbor,
                 const ExecutionContext &context,
                 const std::vector<PlutusData> &parameters) const;
 
             // Plutus data utilities
+
+            /**
+             * @brief Plutus Data CBOR (as the ledger encodes datums), hex encoded
+             */
             std::string encode_plutus_data(const PlutusData &data) const;
+            std::string encode_plutus_data(const PlutusDataArena &arena, uint32_t root) const;
+
+            /**
+             * @brief Decode hex CBOR Plutus Data; unit for malformed input
+             *
+             * Booleans and unit were encoded as constructors and come back as such.
+             */
             PlutusData decode_plutus_data(const std::string &cbor_hex) const;
 
+            /**
+             * @brief Decode hex CBOR Plutus Data into an arena without building PlutusData nodes
+             */
+            bool decode_plutus_data(const std::string &cbor_hex, PlutusDataArena &arena, uint32_t &root) const;
+
             PlutusData create_integer(int64_t value);
             PlutusData create_bytestring(const std::vector<uint8_t> &bytes);
             PlutusData create_list(const std::vector<PlutusData> &items);
@@ -243,6 +329,10 @@ namespace cardano_iot
             PlutusData create_constructor(uint64_t tag, const std::vector<PlutusData> &fields);
 
             // Validation and verification
+
+            /**
+             * @brief True if the hex is a well-formed UPLC program; decoded programs are cached by script hash
+             */
             bool validate_script(const std::string &script_cbor) const;
             bool verify_execution(
                 const std::string &script_cbor,
@@ -250,6 +340,26 @@ namespace cardano_iot
                 const std::vector<PlutusData> &parameters) const;
 
             // Multi-contract operations
+
+            /**
+             * @brief Run calls concurrently where their state does not overlap
+             *
+             * Two calls conflict when they target the same contract and one
+             * writes a variable the other reads or writes. A call with no read
+             * or write set conflicts with every call on its contract. Conflicting
+             * calls run in submission order, the rest run on up to
+             * max_concurrent_executions threads. Calls on one contract share a
+             * transaction until their summed gas would exceed default_gas_limit.
+             */
+            BatchExecutionResult execute_batch(
+                const std::vector<BatchCall> &calls,
+                const std::string &caller_address,
+                const std::string &device_id = "");
+
+            /**
+             * @brief execute_batch() with whole-contract read/write sets
+             * @return Batch id
+             */
             std::string execute_batch_calls(
                 const std::vector<std::tuple<std::string, std::string, std::vector<PlutusData>>> &calls,
                 const std::string &caller_address,
@@ -306,6 +416,9 @@ namespace cardano_iot
                 double avg_execution_time_ms;
                 uint64_t events_emitted;
                 uint64_t active_subscriptions;
+                uint64_t cached_scripts;
+                uint64_t readonly_calls;
+                uint64_t readonly_cache_hits;
             };
 
             ContractStats get_statistics() const;
@@ -320,6 +433,9 @@ namespace cardano_iot
                 bool enable_state_caching = true;
                 uint32_t max_concurrent_executions = 10;
                 std::string preferred_language_version = "PlutusV2";
+                uint64_t readonly_cpu_budget = 10000000000; // per local read-only evaluation
+                uint64_t readonly_memory_budget = 14000000;
+                size_t readonly_memo_entries = 4096; // memoized read-only results per chain tip; 0 disables
             };
 
             void update_config(const ContractConfig &config);
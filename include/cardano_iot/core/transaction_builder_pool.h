@@ -0,0 +1,112 @@
+#pragma once
+
+#include "cardano_iot/core/transaction_manager.h"
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <map>
+#include <future>
+#include <cstdint>
+
+namespace cardano_iot
+{
+    namespace core
+    {
+        /**
+         * @brief One transaction to build on behalf of a device
+         */
+        struct TransactionBuildRequest
+        {
+            TransactionType type = TransactionType::PAYMENT; // PAYMENT, TOKEN_TRANSFER or METADATA
+            std::string from_address;
+            std::string to_address;
+            uint64_t amount_lovelace = 0;
+            std::map<std::string, uint64_t> tokens;
+            TransactionMetadata metadata;
+            std::string device_id;
+
+            std::string signing_key; // sign after building when non-empty
+            bool submit = false;     // submit after building; its change can then fund later builds
+        };
+
+        /**
+         * @brief Outcome of a build request
+         */
+        struct TransactionBuildResult
+        {
+            bool success = false;
+            std::unique_ptr<Transaction> transaction;
+            std::string submitted_tx_id; // set when the request asked for submission and it succeeded
+            std::string error_message;
+        };
+
+        /**
+         * @brief Worker pool that builds transactions for many devices concurrently
+         *
+         * Requests are queued and built by a fixed set of workers against one
+         * TransactionManager. Inputs are reserved in the manager's UTXO set as they
+         * are selected, so concurrent builds from the same wallet never share
+         * inputs. Requests that submit make their change available as unconfirmed
+         * outputs, which later builds from the same wallet can chain off.
+         */
+        class TransactionBuilderPool
+        {
+        public:
+            /**
+             * @param manager Initialized manager; must outlive the pool
+             * @param workers Worker threads (0 = hardware concurrency)
+             * @param queue_capacity Maximum queued requests before submit() rejects
+             */
+            explicit TransactionBuilderPool(TransactionManager &manager, size_t workers = 0,
+                                            size_t queue_capacity = 4096);
+            ~TransactionBuilderPool();
+
+            TransactionBuilderPool(const TransactionBuilderPool &) = delete;
+            TransactionBuilderPool &operator=(const TransactionBuilderPool &) = delete;
+
+            /**
+             * @brief Queue a build request
+             * @return Future for the result; already failed if the pool is stopped or full
+             */
+            std::future<TransactionBuildResult> submit(TransactionBuildRequest request);
+
+            /**
+             * @brief Queue several requests under one lock acquisition
+             */
+            std::vector<std::future<TransactionBuildResult>> submit_batch(std::vector<TransactionBuildRequest> requests);
+
+            /**
+             * @brief Stop accepting requests and join the workers
+             * @param drain Build everything still queued first; otherwise fail it
+             */
+            void shutdown(bool drain = true);
+
+            /**
+             * @brief Grow or shrink the worker set; retired workers finish their current build first
+             * @return The new worker count (at least 1; unchanged once shut down)
+             */
+            size_t resize(size_t workers);
+
+            size_t worker_count() const;
+            size_t queue_depth() const;
+
+            struct PoolStats
+            {
+                uint64_t requests_queued;
+                uint64_t requests_rejected;
+                uint64_t transactions_built;
+                uint64_t transactions_submitted;
+                uint64_t builds_failed;
+                double avg_build_time_ms;
+            };
+
+            PoolStats get_statistics() const;
+
+        private:
+            class Impl;
+            std::unique_ptr<Impl> pimpl_;
+        };
+
+    } // namespace core
+} // namespace cardano_iot
@@ -0,0 +1,146 @@
+#pragma once
+
+#include "cardano_iot/core/transaction_manager.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace cardano_iot
+{
+    namespace core
+    {
+        namespace cbor
+        {
+            /**
+             * @brief Streaming CBOR (RFC 8949) writer over a reusable byte buffer
+             *
+             * Only definite-length items are emitted. Constructed without a buffer the
+             * writer just counts bytes, which gives exact serialized sizes for free.
+             */
+            class CborWriter
+            {
+            public:
+                /**
+                 * @brief Constructor
+                 * @param out Buffer to append to, or nullptr to only count bytes
+                 */
+                explicit CborWriter(std::vector<uint8_t> *out = nullptr) : out_(out) {}
+
+                void write_uint(uint64_t value) { write_head(0, value); }
+                void write_bytes(const uint8_t *data, size_t length);
+                void write_text(std::string_view text);
+                void write_array(size_t count) { write_head(4, count); }
+                void write_map(size_t count) { write_head(5, count); }
+                void write_bool(bool value) { write_simple(value ? 0xf5 : 0xf4); }
+                void write_null() { write_simple(0xf6); }
+
+                /**
+                 * @brief Write a hex string as a byte string (decoded in place)
+                 * @param hex Even-length hex; callers check with is_hex_id()
+                 */
+                void write_hex_bytes(std::string_view hex);
+
+                /**
+                 * @brief Number of bytes written (or counted) so far
+                 */
+                size_t size() const { return size_; }
+
+                /**
+                 * @brief Encoded size of a head (major type + argument)
+                 */
+                static size_t head_size(uint64_t value);
+
+            private:
+                void write_head(uint8_t major, uint64_t value);
+                void write_simple(uint8_t byte);
+
+                std::vector<uint8_t> *out_;
+                size_t size_ = 0;
+            };
+
+            /**
+             * @brief Bounds-checked CBOR reader; every accessor returns false on malformed input
+             */
+            class CborReader
+            {
+            public:
+                CborReader(const uint8_t *data, size_t length) : pos_(data), end_(data + length) {}
+
+                bool read_uint(uint64_t &value);
+                bool read_array(size_t &count);
+                bool read_map(size_t &count);
+                bool read_bytes(std::string_view &bytes);
+                bool read_text(std::string_view &text);
+                bool read_bool(bool &value);
+
+                /**
+                 * @brief Consume a null if it is next
+                 */
+                bool try_read_null();
+
+                /**
+                 * @brief Major type of the next item, or -1 at end of input
+                 */
+                int peek_major() const;
+
+                /**
+                 * @brief Skip one complete item (including nested items)
+                 */
+                bool skip();
+
+                bool at_end() const { return pos_ == end_; }
+                const uint8_t *position() const { return pos_; }
+
+            private:
+                bool read_head(uint8_t &major, uint64_t &value);
+                bool skip_depth(int depth);
+
+                const uint8_t *pos_;
+                const uint8_t *end_;
+            };
+
+            /**
+             * @brief True when the identifier is even-length hex and is encoded as raw bytes
+             *
+             * Hashes, policy ids and hex addresses are stored as byte strings; anything
+             * else (bech32 addresses, demo ids) is stored as text and round-trips as-is.
+             */
+            bool is_hex_id(std::string_view id);
+
+            /**
+             * @brief Encode a transaction as [body, witness_set, is_valid, auxiliary_data]
+             * @param transaction Transaction to encode
+             * @param writer Destination writer
+             */
+            void encode_transaction(const Transaction &transaction, CborWriter &writer);
+
+            /**
+             * @brief Encode only the transaction body (the part that is signed)
+             */
+            void encode_transaction_body(const Transaction &transaction, CborWriter &writer);
+
+            /**
+             * @brief Exact size of encode_transaction() output, without writing anything
+             */
+            size_t encoded_size(const Transaction &transaction);
+
+            /**
+             * @brief Size a witness set with the given number of Ed25519 vkey witnesses would take
+             */
+            size_t vkey_witness_set_size(size_t witness_count);
+
+            /**
+             * @brief Decode a transaction produced by encode_transaction()
+             * @param data Encoded bytes
+             * @param length Number of bytes
+             * @param transaction Output transaction (body, witnesses and metadata fields)
+             * @return true if the input was well-formed
+             */
+            bool decode_transaction(const uint8_t *data, size_t length, Transaction &transaction);
+
+        } // namespace cbor
+    } // namespace core
+} // namespace cardano_iot
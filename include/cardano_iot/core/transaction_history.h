@@ -0,0 +1,144 @@
+#pragma once
+
+#include "cardano_iot/core/transaction_manager.h"
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cardano_iot
+{
+    namespace core
+    {
+        /**
+         * @brief Append-only file of transactions that left the in-memory history
+         *
+         * Starts with "CIOTTXAR" | version u32 | reserved u32. Each record is then
+         * framed as length u32 | crc32 u32 | body. The body holds the summary
+         * fields as varints and length-prefixed strings, then the error message
+         * and the transaction CBOR. Opening cuts off a torn tail left by a crash.
+         * Lookups scan the file, so the archive costs no memory per record. Not
+         * thread-safe; the owner serialises calls.
+         */
+        class TransactionArchive
+        {
+        public:
+            static constexpr uint32_t FORMAT_VERSION = 1;
+
+            using Visitor = std::function<bool(const Transaction &transaction)>; // false stops the scan
+
+            TransactionArchive() = default;
+            ~TransactionArchive();
+
+            TransactionArchive(const TransactionArchive &) = delete;
+            TransactionArchive &operator=(const TransactionArchive &) = delete;
+
+            bool open(const std::string &path);
+            void close();
+            bool is_open() const { return fd_ >= 0; }
+
+            bool append(const Transaction &transaction);
+            bool sync();
+
+            /**
+             * @brief Visit records in append order
+             */
+            bool scan(const Visitor &visitor) const;
+            std::unique_ptr<Transaction> find(const std::string &tx_id) const;
+
+            uint64_t record_count() const { return record_count_; }
+            uint64_t size() const { return size_; }
+
+            static void encode(const Transaction &transaction, std::string &out);
+            static bool decode(const uint8_t *data, size_t size, Transaction &transaction);
+
+        private:
+            int fd_ = -1;
+            uint64_t size_ = 0;
+            uint64_t record_count_ = 0;
+            std::string scratch_;
+        };
+
+        /**
+         * @brief In-memory transaction store indexed by id, device and status
+         *
+         * Every record gets an increasing sequence number, which orders the indexes
+         * and serves as the paging cursor. Records are shared immutable snapshots:
+         * snapshot() hands out a reference, and update() copies a record only while
+         * someone still holds a snapshot of it. Not thread-safe; TransactionManager
+         * calls it under its transactions mutex.
+         */
+        class TransactionHistory
+        {
+        public:
+            static constexpr size_t MAX_PAGE = 1000;
+
+            /**
+             * @brief Add or replace a record
+             * @return Snapshot of the stored record
+             */
+            std::shared_ptr<const Transaction> put(Transaction transaction);
+
+            /**
+             * @brief Change a record in place, keeping the status index in step
+             * @return false if tx_id is not in memory
+             */
+            bool update(const std::string &tx_id, const std::function<void(Transaction &)> &change);
+
+            const Transaction *find(const std::string &tx_id) const;
+            std::shared_ptr<const Transaction> snapshot(const std::string &tx_id) const;
+
+            TransactionPage page_by_device(const std::string &device_id, uint64_t cursor, size_t limit) const;
+            TransactionPage page_by_status(TransactionStatus status, uint64_t cursor, size_t limit) const;
+
+            /**
+             * @brief Records with the given status, oldest first
+             */
+            std::vector<std::shared_ptr<const Transaction>> with_status(TransactionStatus status) const;
+            std::vector<std::shared_ptr<const Transaction>> for_device(const std::string &device_id) const;
+            size_t count(TransactionStatus status) const;
+
+            /**
+             * @brief Move finished records older than the retention window out of memory
+             *
+             * Confirmed records age from their confirmation, failed and cancelled ones
+             * from submission (or creation). They are appended to archive when it is
+             * open and dropped otherwise.
+             * @param now Current time in seconds since the epoch
+             * @return Number of records removed from memory
+             */
+            size_t prune(uint64_t now, uint64_t retention_seconds, TransactionArchive *archive);
+
+            size_t size() const { return records_.size(); }
+            void clear();
+
+            static TransactionSummary summarize(const Transaction &transaction);
+
+        private:
+            static constexpr size_t STATUS_COUNT = 5;
+
+            struct Record
+            {
+                uint64_t sequence = 0;
+                std::shared_ptr<Transaction> transaction;
+            };
+
+            std::unordered_map<std::string, Record> records_;
+            std::map<uint64_t, const std::string *> by_sequence_; // points at the records_ key
+            std::unordered_map<std::string, std::set<uint64_t>> by_device_;
+            std::array<std::set<uint64_t>, STATUS_COUNT> by_status_;
+            uint64_t next_sequence_ = 1;
+
+            void erase(std::unordered_map<std::string, Record>::iterator it);
+            TransactionPage page(const std::set<uint64_t> *index, uint64_t cursor, size_t limit) const;
+            static size_t status_slot(TransactionStatus status) { return static_cast<size_t>(status); }
+        };
+
+    } // namespace core
+} // namespace cardano_iot
@@ -5,9 +5,15 @@
 #include <memory>
 #include <map>
 #include <functional>
+#include <future>
 
 namespace cardano_iot
 {
+    namespace network
+    {
+        class CardanoClient;
+    }
+
     namespace core
     {
         // Transaction types
@@ -168,6 +174,34 @@ namespace cardano_iot
             Transaction &operator=(Transaction &&) = default;
         };
 
+        /**
+         * @brief What history queries return instead of full Transaction copies
+         */
+        struct TransactionSummary
+        {
+            std::string tx_id;
+            TransactionType type = TransactionType::PAYMENT;
+            TransactionStatus status = TransactionStatus::PENDING;
+            std::string device_id;
+            uint64_t fee = 0;
+            uint64_t amount_lovelace = 0; // Sum of outputs
+            uint64_t created_timestamp = 0;
+            uint64_t submitted_timestamp = 0;
+            uint64_t confirmed_timestamp = 0;
+        };
+
+        /**
+         * @brief One page of a history query, oldest first
+         *
+         * Pass next_cursor back to get the following page; 0 means there is none.
+         * Cursors stay valid while records are added, changed or pruned.
+         */
+        struct TransactionPage
+        {
+            std::vector<TransactionSummary> items;
+            uint64_t next_cursor = 0;
+        };
+
         // Balance information
         struct WalletBalance
         {
@@ -178,6 +212,8 @@ namespace cardano_iot
             std::vector<UTXO> utxos;
         };
 
+        struct CoinSelectionResult; // coin_selection.h
+
         // Transaction callback types
         using TransactionCallback = std::function<void(const Transaction &)>;
         using ConfirmationCallback = std::function<void(const std::string &tx_id, bool confirmed)>;
@@ -229,6 +265,14 @@ namespace cardano_iot
                 const TransactionMetadata &metadata,
                 const std::string &device_id = "");
 
+            /**
+             * @brief Metadata transaction that takes ownership of the metadata instead of copying it
+             */
+            std::unique_ptr<Transaction> create_metadata_transaction(
+                const std::string &from_address,
+                TransactionMetadata &&metadata,
+                const std::string &device_id = "");
+
             std::unique_ptr<Transaction> create_smart_contract_transaction(
                 const std::string &from_address,
                 const std::string &contract_address,
@@ -247,7 +291,41 @@ namespace cardano_iot
             // Transaction signing and submission
             bool sign_transaction(Transaction &transaction, const std::string &signing_key);
             bool add_witness(Transaction &transaction, const std::string &witness);
+
+            /**
+             * @brief Append witnesses and re-encode the signed transaction once for all of them
+             * @return Number of witnesses added; ones already present are skipped
+             */
+            size_t add_witnesses(Transaction &transaction, const std::vector<std::string> &witnesses);
+
+            /**
+             * @brief Hex hash of the transaction body, the message every signer signs
+             */
+            std::string get_body_hash(const Transaction &transaction) const;
+
+            /**
+             * @brief Ed25519 witness over a body hash, as hex(vkey || signature)
+             * @param body_hash Hex body hash from get_body_hash()
+             * @param signing_key Raw 32-byte Ed25519 seed in hex
+             * @return Empty if either argument is malformed
+             */
+            static std::string create_witness(const std::string &body_hash, const std::string &signing_key);
+
+            /**
+             * @brief Check Ed25519 witnesses against one body hash
+             *
+             * The hash is decoded once and one verification context is reused for
+             * the whole batch.
+             * @return One entry per witness, 1 if it is a valid vkey witness
+             */
+            static std::vector<uint8_t> verify_witnesses(const std::string &body_hash,
+                                                         const std::vector<std::string> &witnesses);
             std::string submit_transaction(const Transaction &transaction);
+
+            /**
+             * @brief Submit a transaction the caller no longer needs; it moves into the history
+             */
+            std::string submit_transaction(Transaction &&transaction);
             bool cancel_transaction(const std::string &tx_id);
 
             // Transaction monitoring
@@ -256,9 +334,65 @@ namespace cardano_iot
             std::vector<Transaction> get_transactions_by_device(const std::string &device_id) const;
             std::vector<Transaction> get_pending_transactions() const;
 
+            // Transaction history
+            struct HistoryOptions
+            {
+                uint64_t retention_seconds = 0;       // Finished transactions kept in memory this long; 0 = forever
+                std::string archive_path;             // Append-only file pruned transactions move to; empty = dropped
+                uint32_t prune_interval_seconds = 60; // How often pruning runs on its own
+            };
+
+            /**
+             * @brief Set retention and open the archive
+             * @return false if the archive cannot be opened; pruning is then off
+             */
+            bool set_history_options(const HistoryOptions &options);
+
+            /**
+             * @brief Page through the in-memory history, via the device or status index
+             * @param cursor 0 for the first page, then the previous page's next_cursor
+             * @param limit Maximum summaries per page (capped at 1000)
+             */
+            TransactionPage list_transactions_by_device(const std::string &device_id, uint64_t cursor = 0,
+                                                        size_t limit = 100) const;
+            TransactionPage list_transactions_by_status(TransactionStatus status, uint64_t cursor = 0,
+                                                        size_t limit = 100) const;
+
+            /**
+             * @brief Shared, immutable view of an in-memory transaction (nullptr if unknown or archived)
+             *
+             * Later changes to the transaction do not show through an existing record.
+             */
+            std::shared_ptr<const Transaction> get_transaction_record(const std::string &tx_id) const;
+
+            /**
+             * @brief Move finished transactions past the retention window to the archive now
+             * @return Number of transactions that left memory
+             */
+            size_t prune_history();
+            size_t history_size() const;
+
             // Confirmation tracking
             void set_confirmation_callback(ConfirmationCallback callback);
             void wait_for_confirmation(const std::string &tx_id, uint32_t timeout_seconds = 300);
+
+            /**
+             * @brief Track a submitted transaction without blocking
+             * @return Future set to true once confirmed, false on failure or timeout
+             *
+             * Submitted transactions are tracked automatically; this attaches another
+             * waiter (and may extend the timeout). All tracking shares one thread.
+             */
+            std::future<bool> track_confirmation(const std::string &tx_id, uint32_t timeout_seconds = 300);
+
+            /**
+             * @brief Confirm transactions through a node client
+             *
+             * The manager subscribes to the client's block stream and runs one batched
+             * status check per new block instead of polling the tip. Without a client,
+             * confirmation status comes from the local simulation.
+             */
+            void set_chain_client(std::shared_ptr<network::CardanoClient> client);
             bool is_transaction_confirmed(const std::string &tx_id) const;
 
             // UTXO selection strategies
@@ -276,6 +410,18 @@ namespace cardano_iot
                 uint64_t target_amount,
                 const std::map<std::string, uint64_t> &required_tokens = {}) const;
 
+            /**
+             * @brief Select coins from an address's available UTXOs via its cached, pre-sorted index
+             * @param address Wallet address whose UTXOs are used
+             * @param target_amount Lovelace to cover
+             * @param required_tokens Native tokens to cover (policy_id.asset_name -> amount)
+             * @return Selection result including how many inputs were evaluated
+             */
+            CoinSelectionResult select_coins(
+                const std::string &address,
+                uint64_t target_amount,
+                const std::map<std::string, uint64_t> &required_tokens = {}) const;
+
             // Multi-signature support
             bool create_multisig_transaction(
                 const std::vector<std::string> &signing_addresses,
@@ -288,6 +434,16 @@ namespace cardano_iot
                 const std::string &signature,
                 const std::string &public_key);
 
+            /**
+             * @brief Add several (signature, public key) pairs in one history update
+             *
+             * Hex Ed25519 pairs become vkey witnesses in the CBOR witness set.
+             * @return false if the transaction is unknown
+             */
+            bool add_multisig_signatures(
+                const std::string &tx_id,
+                const std::vector<std::pair<std::string, std::string>> &signatures);
+
             // Network parameters
             void update_protocol_parameters(const FeeParameters &params);
             FeeParameters get_protocol_parameters() const;
@@ -301,6 +457,7 @@ namespace cardano_iot
                 uint64_t total_fees_paid;
                 uint64_t total_volume_lovelace;
                 double avg_confirmation_time_seconds;
+                double p95_confirmation_time_seconds;
                 double avg_fee_per_transaction;
                 uint64_t pending_transactions;
             };
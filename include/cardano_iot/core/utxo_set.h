@@ -0,0 +1,139 @@
+#pragma once
+
+#include "cardano_iot/core/transaction_manager.h"
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <map>
+#include <cstdint>
+
+namespace cardano_iot
+{
+    namespace core
+    {
+        /**
+         * @brief Identifies a transaction output (tx_hash, index)
+         */
+        struct OutPoint
+        {
+            std::string tx_hash;
+            uint32_t index = 0;
+
+            bool operator==(const OutPoint &other) const { return index == other.index && tx_hash == other.tx_hash; }
+        };
+
+        struct OutPointHash
+        {
+            size_t operator()(const OutPoint &op) const
+            {
+                return std::hash<std::string>{}(op.tx_hash) ^ (static_cast<size_t>(op.index) * 0x9e3779b97f4a7c15ULL);
+            }
+        };
+
+        /**
+         * @brief Lifecycle of a tracked UTXO
+         */
+        enum class UtxoState
+        {
+            AVAILABLE, // can be selected
+            RESERVED,  // picked by a transaction being built
+            SPENT      // consumed by a submitted transaction awaiting confirmation
+        };
+
+        /**
+         * @brief Thread-safe in-memory UTXO set keyed by out-point, indexed per address
+         *
+         * Reservations keep concurrent builders from picking the same inputs, and
+         * submitted/confirmed/failed transactions are applied incrementally.
+         * Per-address balances are maintained as running aggregates.
+         */
+        class UtxoSet
+        {
+        public:
+            UtxoSet();
+            ~UtxoSet();
+
+            /**
+             * @brief Replace everything known about an address with a fresh snapshot
+             *
+             * Out-points that survive keep their reserved/spent state.
+             */
+            void load_address(const std::string &address, std::vector<UTXO> utxos);
+
+            /**
+             * @brief Add a single UTXO
+             * @param utxo Output to track
+             * @param confirmed False for outputs of transactions not yet on chain
+             * @return false if the out-point is already tracked
+             */
+            bool add(const UTXO &utxo, bool confirmed = true);
+
+            /**
+             * @brief Stop tracking an out-point
+             */
+            bool remove(const OutPoint &outpoint);
+
+            /**
+             * @brief Reserve out-points for an owner (normally a tx id), all or nothing
+             * @return false if any out-point is unknown or not available
+             */
+            bool reserve(const std::vector<OutPoint> &outpoints, const std::string &owner);
+
+            /**
+             * @brief Return an owner's reserved out-points to the available pool
+             * @return Number of out-points released
+             */
+            size_t release(const std::string &owner);
+
+            /**
+             * @brief Mark a submitted transaction's inputs spent and track its outputs to known addresses
+             */
+            void apply_submitted(const Transaction &transaction);
+
+            /**
+             * @brief Drop a confirmed transaction's spent inputs and confirm its outputs
+             */
+            void apply_confirmed(const std::string &tx_id);
+
+            /**
+             * @brief Undo apply_submitted() for a transaction that failed or was rolled back
+             */
+            void apply_failed(const std::string &tx_id);
+
+            bool is_available(const OutPoint &outpoint) const;
+            bool has_address(const std::string &address) const;
+
+            /**
+             * @brief Selectable UTXOs of an address
+             */
+            std::vector<UTXO> available(const std::string &address) const;
+
+            /**
+             * @brief Unspent (available or reserved) UTXOs of an address
+             */
+            std::vector<UTXO> unspent(const std::string &address) const;
+
+            /**
+             * @brief Balance from maintained aggregates; utxos lists the available outputs
+             */
+            WalletBalance balance(const std::string &address) const;
+
+            /**
+             * @brief Counter bumped whenever an address gains or loses an unspent output
+             *
+             * State changes (reserve/release) do not bump it, so indexes built over
+             * unspent outputs stay valid across reservations.
+             */
+            uint64_t version(const std::string &address) const;
+
+            size_t size() const;
+            void clear();
+
+        private:
+            class Impl;
+            std::unique_ptr<Impl> pimpl_;
+        };
+
+    } // namespace core
+} // namespace cardano_iot
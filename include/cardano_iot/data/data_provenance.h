@@ -1,14 +1,22 @@
 #pragma once
 
+#include "cardano_iot/data/merkle_tree.h"
+
 #include <string>
 #include <vector>
 #include <memory>
 #include <map>
 #include <functional>
+#include <chrono>
 #include <cstdint>
 
 namespace cardano_iot
 {
+    namespace core
+    {
+        class TransactionManager;
+    }
+
     namespace data
     {
         enum class DataType
@@ -62,6 +70,14 @@ namespace cardano_iot
             ~DataProvenance();
 
             bool initialize();
+
+            /**
+             * @brief Persist events in an append-only log under log_directory (see provenance_log.h)
+             *
+             * Events already in the directory are replayed, so history survives restarts.
+             * Assets are still kept in memory only.
+             */
+            bool initialize(const std::string &log_directory);
             void shutdown();
 
             // Data asset management
@@ -79,19 +95,88 @@ namespace cardano_iot
             std::vector<ProvenanceEvent> query_events_by_actor(const std::string &actor_id) const;
 
             // Data integrity
+
+            /**
+             * @brief SHA-256 tree hash of the data (see utils::tree_hash), chunks hashed in parallel
+             */
             std::vector<uint8_t> compute_data_hash(const std::vector<uint8_t> &data) const;
+            std::vector<uint8_t> compute_data_hash(const uint8_t *data, size_t size) const;
+
+            /**
+             * @brief Same hash computed over a file without loading it; empty if it cannot be read
+             */
+            std::vector<uint8_t> compute_file_hash(const std::string &path) const;
+
+            /**
+             * @brief Check current_data against the asset's hash
+             *
+             * When the asset's creation event has been anchored, its inclusion proof
+             * and the hash it committed to are checked too. This is all local; the
+             * chain is never queried.
+             */
             bool verify_data_integrity(const std::string &asset_id, const std::vector<uint8_t> &current_data) const;
+            bool verify_data_integrity(const std::string &asset_id, const uint8_t *data, size_t size) const;
+            bool verify_file_integrity(const std::string &asset_id, const std::string &path) const;
 
             // Blockchain integration
+            struct AnchorOptions
+            {
+                std::string from_address;                     // pays for the anchor transactions
+                std::string device_id;
+                std::chrono::milliseconds window{60000};      // longest an event waits for its batch
+                size_t max_batch_events = 1024;               // submit as soon as this many are queued
+            };
+
+            /**
+             * @brief Anchor submitted events in Merkle batches, one metadata transaction per batch
+             *
+             * Without a transaction manager every submission is anchored at once
+             * as a batch of one, under a mock transaction id.
+             */
+            void enable_anchoring(std::shared_ptr<core::TransactionManager> transactions, const AnchorOptions &options);
+
+            /**
+             * @brief Queue an event for the next anchor batch
+             * @return false for an unknown event or a failed anchor
+             */
             bool submit_to_blockchain(const std::string &event_id);
+
+            /**
+             * @brief Anchor the queued events now
+             * @return false if the transaction could not be built or submitted; the events stay queued
+             */
+            bool flush_anchors();
+            size_t pending_anchor_count() const;
+
+            /**
+             * @brief Change the anchor batch limit without re-enabling anchoring
+             * @return The limit in effect after clamping to 1..65536
+             */
+            size_t set_anchor_batch_size(size_t max_batch_events);
+            AnchorOptions get_anchor_options() const;
+
+            /**
+             * @brief Empty until the event's batch has been submitted
+             */
             std::string get_blockchain_transaction(const std::string &event_id) const;
 
+            /**
+             * @brief Inclusion proof of an anchored event; false if it has not been anchored
+             */
+            bool get_inclusion_proof(const std::string &event_id, MerkleProof &proof) const;
+
+            /**
+             * @brief Recompute the event's leaf from the log and check it against its batch root
+             */
+            bool verify_event_anchor(const std::string &event_id) const;
+
             // Statistics
             struct ProvenanceStats
             {
                 uint64_t total_assets;
                 uint64_t total_events;
-                uint64_t blockchain_submissions;
+                uint64_t blockchain_submissions; // anchor transactions
+                uint64_t anchored_events;
                 std::map<DataType, uint64_t> assets_by_type;
                 std::map<ProvenanceEventType, uint64_t> events_by_type;
             };
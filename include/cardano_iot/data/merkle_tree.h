@@ -0,0 +1,71 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace cardano_iot
+{
+    namespace data
+    {
+        using MerkleHash = std::array<uint8_t, 32>;
+
+        /**
+         * @brief Binary SHA-256 Merkle tree over a batch of leaf hashes
+         *
+         * Leaves and interior nodes are hashed under different prefixes (0x00 and
+         * 0x01), so a leaf can never pass for a node. An unpaired node at the end
+         * of a level moves up unchanged instead of being paired with a copy of
+         * itself, so no two leaf lists share a root. All levels are kept, which
+         * makes building a path O(log n).
+         */
+        class MerkleTree
+        {
+        public:
+            MerkleTree() = default;
+            explicit MerkleTree(std::vector<MerkleHash> leaves);
+
+            static MerkleHash hash_leaf(const uint8_t *data, size_t size);
+            static MerkleHash hash_node(const MerkleHash &left, const MerkleHash &right);
+
+            /**
+             * @brief Root of the tree; all zeros when it has no leaves
+             */
+            MerkleHash root() const;
+            size_t leaf_count() const { return levels_.empty() ? 0 : levels_.front().size(); }
+            const std::vector<MerkleHash> &leaves() const;
+
+            /**
+             * @brief Sibling hashes from leaf index up to the root; empty for a bad index
+             */
+            std::vector<MerkleHash> path(size_t index) const;
+
+            static bool verify(const MerkleHash &leaf, size_t index, size_t leaf_count,
+                               const std::vector<MerkleHash> &path, const MerkleHash &root);
+
+        private:
+            std::vector<std::vector<MerkleHash>> levels_; // levels_[0] are the leaves
+        };
+
+        /**
+         * @brief Evidence that an event belongs to an anchored batch
+         *
+         * Everything needed to check it is in the proof; only the transaction
+         * hash points at the chain.
+         */
+        struct MerkleProof
+        {
+            MerkleHash leaf{};
+            MerkleHash root{};
+            uint32_t index = 0;
+            uint32_t leaf_count = 0;
+            std::vector<MerkleHash> path;
+            std::string transaction_hash;
+
+            bool verify() const { return MerkleTree::verify(leaf, index, leaf_count, path, root); }
+        };
+
+    } // namespace data
+} // namespace cardano_iot
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace cardano_iot
+{
+    namespace data
+    {
+        /**
+         * @brief Encodes stored reading payloads into a compact, self-describing form
+         *
+         * Three optional stages are tried in order. The first one that makes the
+         * payload smaller wins:
+         * - Dedup: a payload seen a second time, from any device, is kept once in
+         *   a content table and referenced by id from then on.
+         * - Numeric delta: decimal numbers outside quoted strings are taken out of
+         *   the text. The remaining template is kept once. Each number is stored as
+         *   a zigzag varint delta against a per-device keyframe of the same
+         *   template, which is refreshed every keyframe_interval readings. Numbers
+         *   are handled as scaled integers, so "21.50" comes back as "21.50".
+         * - Compression: zstd, with one dictionary per data type trained from the
+         *   first payloads of that type across all devices. Only available when the
+         *   SDK is built with zstd (see compression_available()).
+         *
+         * Each encoded payload decodes on its own, so range queries and late
+         * readings need no neighbouring rows. Encoded payloads start with a byte
+         * that never occurs in UTF-8 text. Anything else is a plain payload and
+         * decodes to itself, so data stored before the codec was enabled still
+         * reads back. The tables only grow, up to max_entries each. Beyond that,
+         * new content falls through to the later stages. Thread-safe.
+         */
+        class PayloadCodec
+        {
+        public:
+            struct Options
+            {
+                bool dedup = false;
+                bool numeric_delta = false;
+                bool compression = false;
+                uint32_t keyframe_interval = 256;  // Readings per device and template between keyframes
+                int compression_level = 3;         // zstd level
+                uint32_t dictionary_samples = 128; // Payloads of a data type collected before training
+                uint32_t dictionary_size = 4096;   // Bytes per trained dictionary
+                size_t max_entries = 65536;        // Per table: contents, templates, keyframes
+            };
+
+            struct Stats
+            {
+                uint64_t readings = 0;     // Payloads passed to encode()
+                uint64_t raw_bytes = 0;    // Their size as submitted
+                uint64_t stored_bytes = 0; // Their size as stored
+                uint64_t deduplicated = 0;
+                uint64_t numeric = 0;
+                uint64_t compressed = 0;
+                uint64_t dictionaries = 0; // Trained so far
+            };
+
+            PayloadCodec();
+            explicit PayloadCodec(const Options &options);
+            ~PayloadCodec();
+
+            PayloadCodec(const PayloadCodec &) = delete;
+            PayloadCodec &operator=(const PayloadCodec &) = delete;
+
+            /**
+             * @brief Whether the compression stage was built in
+             */
+            static bool compression_available();
+
+            /**
+             * @brief Whether any stage is enabled
+             */
+            bool enabled() const;
+
+            /**
+             * @brief Encode a payload
+             * @param device_id Owner of the series the payload belongs to
+             * @param data_type Selects the compression dictionary
+             * @param payload Payload as submitted
+             * @param out Receives the encoded payload
+             * @return true if out holds an encoded payload; false to store payload as is
+             */
+            bool encode(const std::string &device_id, std::string_view data_type, std::string_view payload,
+                        std::string &out);
+
+            /**
+             * @brief Decode a stored payload
+             * @return The payload as submitted; empty if an encoded payload is corrupt
+             */
+            std::string decode(std::string_view stored) const;
+
+            /**
+             * @brief Whether a stored payload is in encoded form
+             */
+            static bool is_encoded(std::string_view stored);
+
+            Stats stats() const;
+
+        private:
+            class Impl;
+            std::unique_ptr<Impl> pimpl_;
+        };
+
+    } // namespace data
+} // namespace cardano_iot
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "cardano_iot/data/data_provenance.h"
+#include "cardano_iot/data/merkle_tree.h"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cardano_iot
+{
+    namespace data
+    {
+        /**
+         * @brief Append-only, segmented log of provenance events
+         *
+         * Events are stored in a compact binary form: a kind byte, varints and
+         * length-prefixed strings. Each record is framed as length u32 | crc32 u32 |
+         * body. Segment files are named provenance-NNNNNNNN.log and start with
+         * "CIOTPLOG" | version u32 | reserved u32. A segment is sealed once it
+         * reaches segment_bytes. Sealed segments are memory-mapped read-only, and
+         * only the active one is written, through a small write buffer.
+         *
+         * A record is addressed by its location, (segment << 40) | offset. Callers
+         * keep their own indexes of locations rather than copies of events. Opening
+         * replays every segment and cuts off a torn tail left by a crash. Setting a
+         * transaction hash appends an annotation record, so the log stays
+         * append-only. Anchoring a batch appends one record holding the batch's
+         * transaction hash and its leaf hashes, and its Merkle tree is rebuilt in
+         * memory so that proofs need no I/O.
+         *
+         * With an empty directory the segments are kept in memory in the same
+         * encoding. Not thread-safe; the owner serialises calls.
+         */
+        class ProvenanceLog
+        {
+        public:
+            struct Options
+            {
+                std::string directory;                   // empty = in memory only
+                uint64_t segment_bytes = 64 * 1024 * 1024;
+                size_t write_buffer_bytes = 64 * 1024;
+                bool sync_on_flush = false;              // fsync whenever the buffer is written out
+            };
+
+            using Visitor = std::function<void(uint64_t location, const ProvenanceEvent &event)>;
+
+            static constexpr uint64_t NO_LOCATION = UINT64_MAX;
+
+            ProvenanceLog();
+            ~ProvenanceLog();
+
+            ProvenanceLog(const ProvenanceLog &) = delete;
+            ProvenanceLog &operator=(const ProvenanceLog &) = delete;
+
+            /**
+             * @brief Open or create the log, calling visitor for every stored event in append order
+             */
+            bool open(const Options &options, const Visitor &visitor = nullptr);
+            void close();
+            bool is_open() const { return open_; }
+
+            /**
+             * @return Location of the event, or NO_LOCATION on a write error
+             */
+            uint64_t append(const ProvenanceEvent &event);
+            bool annotate_transaction(uint64_t location, const std::string &transaction_hash);
+
+            /**
+             * @brief Decode the event at location, with its latest transaction hash
+             *
+             * May flush the write buffer when the event has not reached the file yet.
+             */
+            bool read(uint64_t location, ProvenanceEvent &event);
+            std::string transaction_for(uint64_t location) const;
+
+            /**
+             * @brief Record that the events at locations were anchored together under tree
+             *
+             * The tree's leaves are in the order of locations. An event anchored
+             * again later takes the most recent batch.
+             */
+            bool append_anchor(const std::string &transaction_hash, const std::vector<uint64_t> &locations,
+                               MerkleTree tree);
+            bool proof_for(uint64_t location, MerkleProof &proof) const;
+            size_t anchor_count() const { return anchors_.size(); }
+
+            /**
+             * @brief Leaf committed to when an event is anchored; the transaction hash is left out
+             */
+            static MerkleHash leaf_hash(const ProvenanceEvent &event);
+
+            /**
+             * @brief Write buffered records to the active segment file
+             */
+            bool flush();
+
+            size_t segment_count() const { return segments_.size(); }
+            uint64_t event_count() const { return event_count_; }
+
+            static void encode(const ProvenanceEvent &event, std::string &out);
+            static bool decode(const uint8_t *data, size_t size, ProvenanceEvent &event);
+
+        private:
+            struct Segment;
+
+            struct Anchor
+            {
+                std::string transaction_hash;
+                MerkleTree tree;
+            };
+
+            Options options_;
+            bool open_ = false;
+            std::vector<std::unique_ptr<Segment>> segments_;
+            std::string pending_; // buffered tail of the active segment
+            std::string scratch_;
+            std::unordered_map<uint64_t, std::string> transactions_; // annotated events only
+            std::vector<Anchor> anchors_;
+            std::unordered_map<uint64_t, std::pair<uint32_t, uint32_t>> anchored_; // location -> (anchor, leaf)
+            uint64_t event_count_ = 0;
+
+            bool start_segment();
+            bool seal_active();
+            uint64_t append_record(uint8_t kind, const std::string &body);
+            bool record_at(uint64_t location, const uint8_t *&body, size_t &size);
+            void index_anchor(std::string transaction_hash, const std::vector<uint64_t> &locations, MerkleTree tree);
+            bool replay(Segment &segment, uint32_t index, bool last, const Visitor &visitor);
+        };
+
+    } // namespace data
+} // namespace cardano_iot
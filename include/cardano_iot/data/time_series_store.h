@@ -0,0 +1,235 @@
+#pragma once
+
+#include "cardano_iot/utils/flat_map.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+namespace cardano_iot
+{
+    namespace data
+    {
+        /**
+         * @brief Block of readings for one device, stored column-wise and sorted by timestamp
+         *
+         * Segments are append-only while active and immutable once sealed, so sealed
+         * segments can be shared with readers without copying.
+         */
+        struct TimeSeriesSegment
+        {
+            std::vector<uint64_t> timestamps;
+            std::vector<uint32_t> payload_offsets{0}; // rows + 1 offsets into payload_bytes
+            std::string payload_bytes;
+            std::vector<std::string> hashes;
+            std::vector<std::string> signatures;
+            std::vector<uint16_t> type_ids; // index into type_names
+            std::vector<std::string> type_names;
+            std::vector<utils::MetadataMap> metadata;
+
+            size_t size() const { return timestamps.size(); }
+            uint64_t min_timestamp() const { return timestamps.empty() ? 0 : timestamps.front(); }
+            uint64_t max_timestamp() const { return timestamps.empty() ? 0 : timestamps.back(); }
+
+            std::string_view payload(size_t row) const
+            {
+                return std::string_view(payload_bytes).substr(payload_offsets[row],
+                                                              payload_offsets[row + 1] - payload_offsets[row]);
+            }
+        };
+
+        /**
+         * @brief Zero-copy view of a single stored reading
+         */
+        class TimeSeriesRecord
+        {
+        public:
+            TimeSeriesRecord(const TimeSeriesSegment *segment, size_t row) : segment_(segment), row_(row) {}
+
+            uint64_t timestamp() const { return segment_->timestamps[row_]; }
+            std::string_view payload() const { return segment_->payload(row_); }
+            std::string_view data_type() const { return segment_->type_names[segment_->type_ids[row_]]; }
+            const std::string &hash() const { return segment_->hashes[row_]; }
+            const std::string &signature() const { return segment_->signatures[row_]; }
+            const utils::MetadataMap &metadata() const { return segment_->metadata[row_]; }
+
+        private:
+            const TimeSeriesSegment *segment_;
+            size_t row_;
+        };
+
+        /**
+         * @brief Result of a time-range query: row ranges over shared, immutable segments
+         *
+         * The view keeps the referenced segments alive, so it stays valid while the
+         * store keeps ingesting. Records are time-sorted within each segment; for
+         * in-order ingestion the whole view is time-sorted.
+         */
+        class TimeSeriesView
+        {
+        public:
+            struct Slice
+            {
+                std::shared_ptr<const TimeSeriesSegment> segment;
+                size_t begin;
+                size_t end;
+            };
+
+            class iterator
+            {
+            public:
+                iterator(const std::vector<Slice> *slices, size_t slice, size_t row)
+                    : slices_(slices), slice_(slice), row_(row) {}
+
+                TimeSeriesRecord operator*() const { return TimeSeriesRecord((*slices_)[slice_].segment.get(), row_); }
+
+                iterator &operator++()
+                {
+                    if (++row_ >= (*slices_)[slice_].end)
+                    {
+                        ++slice_;
+                        row_ = slice_ < slices_->size() ? (*slices_)[slice_].begin : 0;
+                    }
+                    return *this;
+                }
+
+                bool operator==(const iterator &other) const { return slice_ == other.slice_ && row_ == other.row_; }
+                bool operator!=(const iterator &other) const { return !(*this == other); }
+
+            private:
+                const std::vector<Slice> *slices_;
+                size_t slice_;
+                size_t row_;
+            };
+
+            TimeSeriesView() = default;
+            TimeSeriesView(std::string device_id, std::vector<Slice> slices)
+                : device_id_(std::move(device_id)), slices_(std::move(slices))
+            {
+                for (const auto &slice : slices_)
+                {
+                    size_ += slice.end - slice.begin;
+                }
+            }
+
+            const std::string &device_id() const { return device_id_; }
+            size_t size() const { return size_; }
+            bool empty() const { return size_ == 0; }
+            const std::vector<Slice> &slices() const { return slices_; }
+
+            iterator begin() const { return slices_.empty() ? end() : iterator(&slices_, 0, slices_.front().begin); }
+            iterator end() const { return iterator(&slices_, slices_.size(), 0); }
+
+        private:
+            std::string device_id_;
+            std::vector<Slice> slices_;
+            size_t size_ = 0;
+        };
+
+        /**
+         * @brief Per-device, time-indexed, append-only store for IoT readings
+         *
+         * Readings are appended to an active segment per device; full segments are
+         * sealed and indexed by their timestamp bounds, so a range query costs a
+         * binary search over segments plus a binary search within the touched ones.
+         * The store is safe for concurrent readers and writers.
+         */
+        class TimeSeriesStore
+        {
+        public:
+            /**
+             * @brief Fields of one reading to append
+             */
+            struct Entry
+            {
+                uint64_t timestamp = 0;
+                std::string_view data_type;
+                std::string_view payload;
+                std::string hash;
+                std::string signature;
+                utils::MetadataMap metadata;
+            };
+
+            /**
+             * @brief Holds the store's write lock so a batch of appends takes it once
+             */
+            class Writer
+            {
+            public:
+                ~Writer();
+                Writer(Writer &&) noexcept;
+                Writer(const Writer &) = delete;
+                Writer &operator=(const Writer &) = delete;
+
+                /**
+                 * @brief Append a reading for a device
+                 * @param device_id Device identifier
+                 * @param entry Reading fields (hash, signature and metadata are consumed)
+                 */
+                void append(const std::string &device_id, Entry &&entry);
+
+            private:
+                friend class TimeSeriesStore;
+                explicit Writer(TimeSeriesStore &store);
+                TimeSeriesStore *store_;
+            };
+
+            /**
+             * @brief Constructor
+             * @param segment_capacity Rows per segment before it is sealed
+             */
+            explicit TimeSeriesStore(size_t segment_capacity = 4096);
+            ~TimeSeriesStore();
+
+            /**
+             * @brief Acquire a writer for a batch of appends
+             * @return Writer holding the store's write lock
+             */
+            Writer writer();
+
+            /**
+             * @brief Append a single reading
+             * @param device_id Device identifier
+             * @param entry Reading fields
+             */
+            void append(const std::string &device_id, Entry &&entry);
+
+            /**
+             * @brief Query readings of a device in [start_time, end_time]
+             * @param device_id Device identifier
+             * @param start_time Start timestamp (0 = unbounded)
+             * @param end_time End timestamp (0 = unbounded)
+             * @return View over the matching readings
+             */
+            TimeSeriesView query(const std::string &device_id, uint64_t start_time = 0, uint64_t end_time = 0) const;
+
+            /**
+             * @brief Number of readings stored for a device
+             */
+            size_t size(const std::string &device_id) const;
+
+            /**
+             * @brief Total number of readings stored
+             */
+            size_t total_size() const;
+
+            /**
+             * @brief Drop the readings of one device
+             * @return Number of readings dropped
+             */
+            size_t erase(const std::string &device_id);
+
+            /**
+             * @brief Drop all stored readings
+             */
+            void clear();
+
+        private:
+            class Impl;
+            std::unique_ptr<Impl> pimpl_;
+        };
+
+    } // namespace data
+} // namespace cardano_iot
@@ -0,0 +1,129 @@
+/**
+ * @file power_aware_outbox.h
+ * @brief Per-device queue that holds blockchain operations until power allows
+ *
+ * Every submission from a battery device wakes its radio. The outbox queues
+ * each device's outgoing operations and sends them together in one wake-up.
+ * It does so when the device has power to spare (charging, mains, harvest
+ * surplus), when its batch is full, or when the oldest operation reaches its
+ * deadline.
+ *
+ * @author Cardano IoT SDK Team
+ * @version 1.0.0
+ */
+
+#ifndef CARDANO_IOT_POWER_AWARE_OUTBOX_H
+#define CARDANO_IOT_POWER_AWARE_OUTBOX_H
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace cardano_iot::energy
+{
+
+    class PowerManager;
+
+    /**
+     * @brief Why a device's queued operations were sent
+     */
+    enum class FlushReason
+    {
+        IMMEDIATE,       // Device is not batched (unknown, or tx power control off)
+        POWER_AVAILABLE, // Charging, on mains or harvesting a surplus
+        BATCH_FULL,      // max_batch_operations reached
+        DEADLINE,        // Oldest operation waited its maximum delay
+        MANUAL           // flush() / flush_all()
+    };
+
+    /**
+     * @brief Holds operations per device and hands them back in batches
+     *
+     * The outbox does not carry payloads, only the caller's tickets. The
+     * caller keeps the operation behind each ticket and sends the whole batch
+     * when the flush handler is called. Tickets still queued when the outbox
+     * is destroyed are dropped, so flush_all() first.
+     *
+     * A device's deadline comes from its PowerSettings, as set by
+     * PowerManager::optimize_for_blockchain. It uses
+     * heartbeat_interval_normal, or heartbeat_interval_low_power below the
+     * low-power threshold, so a batched device transmits at most once per
+     * heartbeat. Devices with enable_tx_power_control off are never held.
+     *
+     * The flush handler runs without the outbox lock held, on the thread that
+     * called enqueue/poll/flush or on the shared timer wheel.
+     */
+    class PowerAwareOutbox
+    {
+    public:
+        struct Options
+        {
+            uint32_t poll_interval_ms = 1000;  // 0 = only when poll() is called
+            size_t max_batch_operations = 64;  // Per device
+            uint32_t default_max_delay_ms = 0; // 0 = the device's heartbeat interval
+        };
+
+        using FlushHandler = std::function<void(const std::string &device_id, std::vector<uint64_t> &&tickets,
+                                                FlushReason reason)>;
+
+        /**
+         * @param power Consulted for settings, battery and surplus; must outlive the outbox
+         * @param handler Sends one device's batch
+         */
+        PowerAwareOutbox(const PowerManager &power, FlushHandler handler);
+        PowerAwareOutbox(const PowerManager &power, FlushHandler handler, const Options &options);
+        ~PowerAwareOutbox();
+
+        PowerAwareOutbox(const PowerAwareOutbox &) = delete;
+        PowerAwareOutbox &operator=(const PowerAwareOutbox &) = delete;
+
+        /**
+         * @brief Queue one operation
+         *
+         * The batch may be flushed before this returns, so store the operation
+         * under its ticket first.
+         * @param ticket Caller's id for the operation, handed back on flush
+         * @param device_id Device whose radio sends it
+         * @param tx_type As for PowerManager::get_transaction_power_cost
+         * @param data_size Payload size in bytes
+         * @param max_delay_ms Latest send time from now; 0 = the device default
+         */
+        void enqueue(uint64_t ticket, const std::string &device_id, const std::string &tx_type, uint32_t data_size,
+                     uint32_t max_delay_ms = 0);
+
+        /**
+         * @brief Send every batch whose device has power or whose deadline passed
+         * @return Number of operations handed to the flush handler
+         */
+        size_t poll();
+
+        size_t flush(const std::string &device_id);
+        size_t flush_all();
+
+        size_t pending() const;
+        size_t pending(const std::string &device_id) const;
+
+        /**
+         * @return queued_operations, flushed_operations, radio_wakeups and
+         *         flushes_<reason> counters
+         */
+        std::map<std::string, uint64_t> get_statistics() const;
+
+    private:
+        class Impl;
+        std::unique_ptr<Impl> pimpl_;
+    };
+
+    /**
+     * @brief Convert flush reason to string
+     * @param reason Flush reason
+     * @return String representation
+     */
+    std::string flush_reason_to_string(FlushReason reason);
+
+} // namespace cardano_iot::energy
+
+#endif // CARDANO_IOT_POWER_AWARE_OUTBOX_H
@@ -20,6 +20,8 @@
 #include <functional>
 #include <cstdint>
 
+#include "cardano_iot/core/device_telemetry.h"
+
 namespace cardano_iot::energy
 {
 
@@ -236,6 +238,17 @@ namespace cardano_iot::energy
          */
         bool update_power_consumption(const std::string &device_id, double power_mw);
 
+        /**
+         * @brief Apply many battery and power readings under one lock
+         *
+         * A reading below the critical threshold moves the device to CRITICAL.
+         * Power and battery callbacks fire after the lock is released, at most
+         * one battery event per device.
+         * @param records Telemetry records; unknown devices are skipped
+         * @return Number of records applied
+         */
+        size_t apply_telemetry_batch(const std::vector<core::DeviceTelemetry> &records);
+
         /**
          * @brief Get power optimization recommendations
          * @param device_id Device identifier
@@ -268,7 +281,7 @@ namespace cardano_iot::energy
          * @brief Update harvested energy
          * @param device_id Device identifier
          * @param source Energy source
-         * @param energy_mwh Harvested energy in milliwatt-hours
+         * @param energy_mwh Energy harvested over the last hour, in milliwatt-hours
          * @return true if update successful
          */
         bool update_harvested_energy(const std::string &device_id,
@@ -333,6 +346,31 @@ namespace cardano_iot::energy
          */
         std::map<std::string, uint64_t> get_statistics() const;
 
+        // Fleet Queries
+        /**
+         * @brief Devices that reach their critical threshold within the given time
+         *
+         * Uses the current draw net of harvested power. Devices whose harvest
+         * covers their draw never qualify.
+         * @param hours Look-ahead window in hours
+         * @return (device_id, hours to critical) pairs, soonest first
+         */
+        std::vector<std::pair<std::string, double>> get_devices_critical_within(double hours) const;
+
+        /**
+         * @brief Devices with the highest net power drain
+         * @param count Maximum number of devices to return
+         * @return (device_id, consumption minus harvest in mW) pairs, largest first
+         */
+        std::vector<std::pair<std::string, double>> get_top_draining_devices(size_t count) const;
+
+        /**
+         * @brief Fleet-wide totals and averages
+         * @return devices, avg_battery_level, total_consumption_mw, total_harvest_mw,
+         *         critical_devices and min_hours_to_critical
+         */
+        std::map<std::string, double> get_fleet_power_summary() const;
+
         // Event Handling
         /**
          * @brief Set power event callback
@@ -371,6 +409,21 @@ namespace cardano_iot::energy
          */
         bool can_perform_blockchain_op(const std::string &device_id, double estimated_power_cost) const;
 
+        /**
+         * @brief Check whether transmitting now costs no stored energy
+         * @param device_id Device identifier
+         * @return true while charging, on mains power, or harvesting more than it draws
+         */
+        bool has_power_surplus(const std::string &device_id) const;
+
+        /**
+         * @brief Get the settings a device was registered with
+         * @param device_id Device identifier
+         * @param settings Receives the settings
+         * @return false if the device is not registered
+         */
+        bool get_power_settings(const std::string &device_id, PowerSettings &settings) const;
+
     private:
         class Impl;
         std::unique_ptr<Impl> pimpl_;
@@ -0,0 +1,200 @@
+/**
+ * @file dashboard_push.h
+ * @brief WebSocket push channel for real-time dashboard clients
+ *
+ * Browsers open a WebSocket, subscribe to widgets and receive only new
+ * points, packed into compact binary frames. Points published for a widget
+ * are coalesced and encoded once per flush for every client viewing it.
+ *
+ * @author Cardano IoT SDK Team
+ * @version 1.0.0
+ */
+
+#ifndef CARDANO_IOT_DASHBOARD_PUSH_H
+#define CARDANO_IOT_DASHBOARD_PUSH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cardano_iot::monitoring
+{
+
+    /**
+     * @brief Binary update frame sent to dashboard clients
+     *
+     * Layout (varints are unsigned LEB128, signed values zigzag-encoded):
+     *
+     *   u8       frame type (POINTS or RESYNC)
+     *   varint   length + channel (widget id)
+     *   u8       decimals; values travel as round(value * 10^decimals)
+     *   varint   series count
+     *   per series:
+     *     varint   length + source id
+     *     varint   point count
+     *     varint   first timestamp, then zigzag timestamp deltas
+     *     zigzag   first scaled value, then scaled value deltas
+     *
+     * A series of one reading a second whose value moves slowly costs about
+     * two bytes per point. RESYNC frames carry no series and tell the client
+     * that updates were dropped, so it should refetch the widget.
+     */
+    struct PushFrame
+    {
+        enum class Type : uint8_t
+        {
+            POINTS = 1,
+            RESYNC = 2
+        };
+
+        struct Series
+        {
+            std::string source_id;
+            std::vector<std::pair<uint64_t, double>> points; // (timestamp, value)
+        };
+
+        Type type = Type::POINTS;
+        std::string channel;
+        uint8_t decimals = 3;
+        std::vector<Series> series;
+
+        /**
+         * @brief Append the encoded frame to out
+         */
+        void encode(std::vector<uint8_t> &out) const;
+
+        /**
+         * @brief Decode a frame produced by encode()
+         * @return false on truncated or malformed input
+         */
+        static bool decode(const uint8_t *data, size_t size, PushFrame &frame);
+    };
+
+    /**
+     * @brief WebSocket server that pushes coalesced widget updates
+     *
+     * One event-loop thread serves every client with non-blocking sockets, and
+     * flushes pending updates every flush_interval_ms. Clients send the text
+     * messages "subscribe <channel>" and "unsubscribe <channel>"; every other
+     * text message goes to the message handler. Each client has a bounded send
+     * queue. When a slow client's queue is full, new frames are dropped for
+     * that client only, and a RESYNC frame follows once it catches up.
+     * publish() only appends to a buffer, so slow clients never stall the
+     * data path.
+     */
+    class DashboardPushServer
+    {
+    public:
+        using ClientId = uint64_t; // 0 is never a valid id
+
+        // Text message from a client; runs on the event-loop thread and must not block
+        using MessageHandler = std::function<void(ClientId client, const std::string &message)>;
+
+        // Client gone; runs on the event-loop thread
+        using CloseHandler = std::function<void(ClientId client)>;
+        using HttpHandler = std::function<std::string()>; // Body of a plain GET response
+
+        struct Options
+        {
+            size_t max_clients = 1024;
+            size_t max_queued_bytes = 1 << 20;   // per client; beyond this frames are dropped for the client
+            size_t max_pending_points = 1 << 16; // per channel between flushes; older points are dropped
+            size_t max_message_bytes = 64 * 1024;
+            uint32_t flush_interval_ms = 100;
+            uint8_t value_decimals = 3;
+            int send_buffer_bytes = 0; // SO_SNDBUF for client sockets, 0 = system default
+            std::string path = "/ws";
+        };
+
+        struct Statistics
+        {
+            uint64_t clients_connected = 0;
+            uint64_t clients_accepted = 0;
+            uint64_t clients_rejected = 0;
+            uint64_t frames_encoded = 0; // Once per channel and flush, however many clients view it
+            uint64_t frames_queued = 0;  // Per client
+            uint64_t frames_dropped = 0; // Per client, because of backpressure
+            uint64_t points_published = 0;
+            uint64_t points_dropped = 0; // Over max_pending_points
+            uint64_t bytes_sent = 0;
+        };
+
+        DashboardPushServer();
+        explicit DashboardPushServer(const Options &options);
+        ~DashboardPushServer();
+
+        DashboardPushServer(const DashboardPushServer &) = delete;
+        DashboardPushServer &operator=(const DashboardPushServer &) = delete;
+
+        /**
+         * @brief Install handlers; call before start()
+         */
+        void set_handlers(MessageHandler on_message, CloseHandler on_close);
+
+        /**
+         * @brief Answer plain HTTP GETs for path (no Upgrade header) with the handler's body; call before start()
+         *
+         * The handler runs on the event loop and must not call back into the server.
+         */
+        void add_http_route(const std::string &path, const std::string &content_type, HttpHandler handler);
+
+        /**
+         * @brief Listen on address:port and start the event loop
+         * @param address Interface to bind (empty for all)
+         * @param port 0 picks an ephemeral port
+         * @return The bound port, or 0 on failure
+         */
+        uint16_t start(const std::string &address, uint16_t port);
+
+        /**
+         * @brief Close every client and join the event loop; must not be called from a handler
+         */
+        void stop();
+
+        bool is_running() const;
+        uint16_t port() const;
+
+        /**
+         * @brief Queue points for a channel's next flush; safe from any thread
+         */
+        void publish(const std::string &channel, const std::string &source_id,
+                     const std::vector<std::pair<uint64_t, double>> &points);
+
+        /**
+         * @brief Send a text message to every client, or to the channel's subscribers
+         * @return Number of clients it was queued for
+         */
+        uint32_t broadcast_text(const std::string &message, const std::string &channel = "");
+
+        /**
+         * @brief Send a text message to one client
+         * @return false if the client is unknown or its queue is full
+         */
+        bool send_text(ClientId client, const std::string &message);
+
+        /**
+         * @brief Encode and queue pending updates now instead of at the next tick
+         */
+        void flush();
+
+        size_t client_count() const;
+        size_t subscriber_count(const std::string &channel) const;
+        Statistics get_statistics() const;
+
+    private:
+        class Impl;
+        std::unique_ptr<Impl> pimpl_;
+    };
+
+    /**
+     * @brief Sec-WebSocket-Accept value for a client's Sec-WebSocket-Key
+     */
+    std::string websocket_accept_key(const std::string &client_key);
+
+} // namespace cardano_iot::monitoring
+
+#endif // CARDANO_IOT_DASHBOARD_PUSH_H
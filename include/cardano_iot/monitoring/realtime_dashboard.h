@@ -208,6 +208,11 @@ namespace cardano_iot::monitoring
 
         /**
          * @brief Initialize dashboard server
+         *
+         * Keys: raw_retention_seconds, second_retention_seconds,
+         * minute_retention_seconds, hour_retention_seconds,
+         * session_timeout_seconds, user.<name>.password_sha256 and
+         * user.<name>.permissions (comma separated).
          * @param config Configuration parameters
          * @return true if initialization successful
          */
@@ -215,7 +220,16 @@ namespace cardano_iot::monitoring
 
         /**
          * @brief Start dashboard server
-         * @param port HTTP server port
+         *
+         * Serves the WebSocket push channel (see DashboardPushServer) at the
+         * enable_websocket() path. Points pushed to a source are streamed to
+         * clients subscribed to any widget that lists the source. A client
+         * sends "session <id>" to bind itself to a session for
+         * send_websocket_message(). Optional keys: websocket_max_clients,
+         * websocket_max_queued_bytes, websocket_max_pending_points and
+         * websocket_flush_interval_ms. GET /metrics returns the process
+         * metrics registry in Prometheus text format.
+         * @param port HTTP server port (0 picks one; see get_server_status()["port"])
          * @param interface Network interface to bind (empty for all)
          * @return true if server started successfully
          */
@@ -260,6 +274,9 @@ namespace cardano_iot::monitoring
 
         /**
          * @brief Push batch of data points
+         *
+         * The source is locked once for the whole batch. Non-finite values are
+         * skipped; a zero timestamp means now.
          * @param source_id Data source identifier
          * @param data_points Vector of data points
          * @return Number of successfully pushed data points
@@ -269,9 +286,14 @@ namespace cardano_iot::monitoring
 
         /**
          * @brief Get time series data
+         *
+         * Each source keeps raw points plus 1 s / 1 min / 1 h rollups (see
+         * RollupSeries). The finest resolution that covers the range in at most
+         * max_points buckets answers. Rollup points carry the bucket average as
+         * value and "min", "max", "count" and "resolution" tags.
          * @param source_id Data source identifier
-         * @param start_time Start timestamp
-         * @param end_time End timestamp
+         * @param start_time Start timestamp (seconds)
+         * @param end_time End timestamp (0 = latest)
          * @param max_points Maximum number of points to return
          * @return Time series data
          */
@@ -537,7 +559,7 @@ namespace cardano_iot::monitoring
         /**
          * @brief Broadcast message to all WebSocket clients
          * @param message Message to broadcast
-         * @param channel Optional channel filter
+         * @param channel Optional channel filter (widget id)
          * @return Number of clients that received the message
          */
         uint32_t broadcast_websocket_message(const std::string &message,
@@ -0,0 +1,123 @@
+/**
+ * @file rollup_series.h
+ * @brief Multi-resolution rollups of one numeric time series
+ *
+ * Every point is kept raw for a short while and folded into 1 s, 1 min and
+ * 1 h min/max/sum/count buckets as it arrives. Each resolution has its own
+ * retention, so long ranges are answered from a few coarse buckets instead
+ * of a scan over raw points.
+ *
+ * @author Cardano IoT SDK Team
+ * @version 1.0.0
+ */
+
+#ifndef CARDANO_IOT_ROLLUP_SERIES_H
+#define CARDANO_IOT_ROLLUP_SERIES_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace cardano_iot::monitoring
+{
+
+    /**
+     * @brief Raw points plus 1 s / 1 min / 1 h rollups with per-level retention
+     *
+     * Timestamps are seconds. In-order points cost O(1) per level, and a late
+     * point is merged into its bucket by binary search. Buckets older than
+     * their level's retention (measured from the newest point) are dropped as
+     * points arrive. Not thread-safe; the owner serialises access.
+     */
+    class RollupSeries
+    {
+    public:
+        enum class Resolution : uint8_t
+        {
+            RAW,
+            SECOND,
+            MINUTE,
+            HOUR
+        };
+
+        static constexpr size_t RESOLUTION_COUNT = 4;
+
+        struct Bucket
+        {
+            uint64_t start = 0; // First second covered (the timestamp, for raw points)
+            double min = 0.0;
+            double max = 0.0;
+            double sum = 0.0;
+            uint64_t count = 0;
+
+            double average() const { return count > 0 ? sum / static_cast<double>(count) : 0.0; }
+        };
+
+        struct Retention
+        {
+            uint64_t raw_seconds = 300;
+            uint64_t second_seconds = 900;
+            uint64_t minute_seconds = 86400;
+            uint64_t hour_seconds = 35 * 86400;
+        };
+
+        RollupSeries();
+        explicit RollupSeries(const Retention &retention);
+
+        void add(uint64_t timestamp, double value);
+
+        /**
+         * @brief The finest resolution that still holds all of [start, end] in at most max_points buckets
+         *
+         * Levels whose retention no longer reaches start are skipped. Falls
+         * back to HOUR when no level fits.
+         * @param end 0 = up to the newest point
+         */
+        Resolution choose(uint64_t start, uint64_t end, size_t max_points) const;
+
+        /**
+         * @brief Buckets of [start, end], oldest first, at the chosen resolution
+         *
+         * If even hourly buckets exceed max_points, neighbours are merged so
+         * that at most max_points come back.
+         * @param used Set to the resolution that answered
+         */
+        std::vector<Bucket> query(uint64_t start, uint64_t end, size_t max_points,
+                                  Resolution *used = nullptr) const;
+
+        /**
+         * @brief Buckets of [start, end] at one resolution, without merging
+         */
+        std::vector<Bucket> range(Resolution resolution, uint64_t start, uint64_t end) const;
+
+        size_t size(Resolution resolution) const { return levels_[index(resolution)].size(); }
+        uint64_t newest() const { return newest_; }
+        bool empty() const { return levels_[0].empty() && levels_[RESOLUTION_COUNT - 1].empty(); }
+
+        void set_retention(const Retention &retention);
+
+        static uint64_t width(Resolution resolution);
+
+    private:
+        std::array<std::deque<Bucket>, RESOLUTION_COUNT> levels_;
+        std::array<uint64_t, RESOLUTION_COUNT> retention_{};
+        std::array<uint64_t, RESOLUTION_COUNT> dropped_before_{}; // Nothing older is left at the level
+        uint64_t newest_ = 0;
+
+        static size_t index(Resolution resolution) { return static_cast<size_t>(resolution); }
+        void compact(size_t level);
+        std::pair<size_t, size_t> bounds(size_t level, uint64_t start, uint64_t end) const;
+    };
+
+    /**
+     * @brief Convert rollup resolution to string
+     * @param resolution Rollup resolution
+     * @return String representation ("raw", "1s", "1m", "1h")
+     */
+    const char *resolution_to_string(RollupSeries::Resolution resolution);
+
+} // namespace cardano_iot::monitoring
+
+#endif // CARDANO_IOT_ROLLUP_SERIES_H
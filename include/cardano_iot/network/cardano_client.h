@@ -5,10 +5,16 @@
 #include <memory>
 #include <map>
 #include <functional>
+#include <future>
 #include <cstdint>
 
 namespace cardano_iot
 {
+    namespace utils
+    {
+        class Executor;
+    }
+
     namespace network
     {
         enum class ConnectionStatus
@@ -30,6 +36,26 @@ namespace cardano_iot
             LOCAL
         };
 
+        // Where queries go: the built-in simulation or a hosted HTTP API
+        enum class BackendType
+        {
+            MOCK,
+            BLOCKFROST,
+            KOIOS
+        };
+
+        struct BackendConfig
+        {
+            BackendType type = BackendType::MOCK;
+            std::string base_url; // e.g. https://cardano-preprod.blockfrost.io/api/v0
+            std::string api_key;  // Blockfrost project_id or Koios bearer token
+            size_t max_connections = 16;
+            uint32_t timeout_ms = 10000;
+            size_t max_batch_addresses = 100; // addresses per request where the provider accepts lists
+            uint32_t utxo_cache_ttl_ms = 20000; // 0 disables the UTXO cache
+            uint32_t chain_poll_interval_ms = 1000; // tip polling of the shared chain follower
+        };
+
         struct ChainTip
         {
             std::string hash;
@@ -68,6 +94,48 @@ namespace cardano_iot
             uint64_t submission_timestamp;
         };
 
+        // A position on the chain; height 0 means "the current tip"
+        struct ChainPoint
+        {
+            uint64_t slot = 0;
+            uint64_t height = 0;
+            std::string hash;
+        };
+
+        struct BlockHeader
+        {
+            std::string hash;
+            std::string previous_hash;
+            uint64_t slot = 0;
+            uint64_t height = 0;
+            uint64_t epoch = 0;
+        };
+
+        struct AddressTransaction
+        {
+            std::string address;
+            std::string tx_hash;
+            uint64_t block_height = 0;
+            std::string block_hash;
+        };
+
+        /**
+         * @brief Handlers and filter of a chain-sync style subscription
+         *
+         * Handlers run on the client's follower thread, in chain order: each
+         * block's on_block comes before the on_transaction calls for that block.
+         * on_rollback reports the point that was rolled back; delivery then
+         * resumes from the block before it.
+         */
+        struct ChainSubscription
+        {
+            std::function<void(const BlockHeader &)> on_block;
+            std::function<void(const AddressTransaction &)> on_transaction;
+            std::function<void(const ChainPoint &)> on_rollback;
+            std::vector<std::string> watched_addresses;
+            ChainPoint resume_from; // replay blocks after this point; height 0 starts at the tip
+        };
+
         class CardanoClient
         {
         public:
@@ -77,6 +145,25 @@ namespace cardano_iot
             bool initialize(const std::string& node_socket_path = "", Network network = Network::TESTNET);
             void shutdown();
 
+            /**
+             * @brief Select the query backend; takes effect on the next connect()
+             *
+             * HTTP backends share one pooled, keep-alive connection set and serve
+             * concurrent requests without a thread per call.
+             */
+            bool configure_backend(const BackendConfig& config);
+            BackendConfig get_backend() const;
+
+            /**
+             * @brief Change the UTXO cache TTL in place; unlike configure_backend() keeps the connection and cache
+             */
+            void set_utxo_cache_ttl(uint32_t ttl_ms);
+
+            /**
+             * @brief Run the *_async calls of the local backend on a shared executor instead of a thread per call
+             */
+            void set_executor(std::shared_ptr<utils::Executor> executor);
+
             // Connection management
             bool connect();
             void disconnect();
@@ -91,10 +178,60 @@ namespace cardano_iot
             std::vector<UTXOInfo> query_utxos(const std::string& address) const;
             uint64_t get_address_balance(const std::string& address) const;
 
+            /**
+             * @brief Non-blocking UTXO query; many can be in flight at once
+             */
+            std::future<std::vector<UTXOInfo>> query_utxos_async(const std::string& address) const;
+
+            /**
+             * @brief UTXOs of many addresses in as few backend round trips as the provider allows
+             * @return UTXOs per address; addresses whose query failed are absent
+             *
+             * Answers come from a read-through cache whose entries expire after
+             * utxo_cache_ttl_ms or when a new chain tip is observed.
+             */
+            std::map<std::string, std::vector<UTXOInfo>> query_utxos_batch(const std::vector<std::string>& addresses) const;
+            std::future<std::map<std::string, std::vector<UTXOInfo>>> query_utxos_batch_async(const std::vector<std::string>& addresses) const;
+
+            /**
+             * @brief Drop cached UTXOs of one address (e.g. after spending from it), or all if empty
+             */
+            void invalidate_utxo_cache(const std::string& address = "");
+
             // Transaction operations
             SubmissionResult submit_transaction(const std::string& cbor_hex) const;
+            std::future<SubmissionResult> submit_transaction_async(const std::string& cbor_hex) const;
             bool is_transaction_confirmed(const std::string& tx_hash) const;
 
+            /**
+             * @brief Confirmation status of many transactions in one round trip
+             * @return One flag per hash, in order (all false while disconnected)
+             */
+            std::vector<bool> are_transactions_confirmed(const std::vector<std::string>& tx_hashes) const;
+
+            /**
+             * @brief Stream new blocks and watched-address transactions to handlers
+             * @return Subscription id, 0 if the client is not initialized
+             *
+             * All subscriptions share one follower thread that polls the tip every
+             * chain_poll_interval_ms and fetches the blocks in between, so consumers
+             * no longer poll the node themselves. After a backend outage the follower
+             * reconnects with backoff and resumes from each subscription's last point.
+             */
+            uint64_t subscribe_chain(ChainSubscription subscription);
+
+            /**
+             * @brief Remove a subscription; waits for a delivery in progress unless called from a handler
+             */
+            bool unsubscribe_chain(uint64_t subscription_id);
+
+            bool set_watched_addresses(uint64_t subscription_id, const std::vector<std::string>& addresses);
+
+            /**
+             * @brief Last point delivered to a subscription; pass as resume_from to continue later
+             */
+            ChainPoint get_subscription_point(uint64_t subscription_id) const;
+
             // Utility functions
             bool validate_address(const std::string& address) const;
             uint64_t slot_to_timestamp(uint64_t slot) const;
@@ -107,6 +244,11 @@ namespace cardano_iot
                 uint64_t transactions_submitted;
                 uint64_t connection_attempts;
                 double avg_query_time_ms;
+                double p95_query_time_ms;
+                uint64_t cache_hits;
+                uint64_t cache_misses;
+                double cache_hit_rate;
+                uint64_t utxo_round_trips; // backend requests issued for UTXO data
             };
 
             ClientStats get_statistics() const;
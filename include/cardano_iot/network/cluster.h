@@ -0,0 +1,142 @@
+#pragma once
+
+#include "cardano_iot/network/hash_ring.h"
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace cardano_iot
+{
+    namespace utils
+    {
+        class Executor;
+    }
+
+    namespace network
+    {
+        /**
+         * @brief Membership, shard ownership and calls between SDK gateway nodes
+         *
+         * Each node runs its own P2PNetwork under a dedicated network id. The
+         * members are this node plus every gateway it can reach, directly or over
+         * mesh routes. They are re-read every membership_interval_ms, and a change
+         * rebuilds the consistent-hash ring. A node that disconnects drops out as
+         * soon as its routes are withdrawn.
+         *
+         * Calls are named request kinds with string bodies, sent as
+         * CLUSTER_REQUEST and answered with CLUSTER_RESPONSE. Handlers run on the
+         * executor when one is given, otherwise on the transport thread, so a
+         * handler must not call() other nodes without an executor. call_all() sends
+         * to every member before waiting, so it takes as long as the slowest node.
+         */
+        class GatewayCluster
+        {
+        public:
+            struct Options
+            {
+                std::string listen_address = "0.0.0.0";
+                uint16_t port = 0;                      // 0 picks a free port
+                std::vector<std::string> seeds;         // "host:port" of existing members
+                uint32_t virtual_nodes = 128;           // Ring points per node
+                uint32_t membership_interval_ms = 1000; // How often reachability is re-read
+                uint32_t request_timeout_ms = 5000;
+                uint32_t max_message_bytes = 8u << 20;
+                uint32_t io_threads = 2;
+                std::string network_id = "cardano_iot_cluster";
+            };
+
+            struct Stats
+            {
+                uint64_t requests_sent = 0;
+                uint64_t requests_served = 0;
+                uint64_t requests_failed = 0; // Unreachable, timed out or refused by the handler
+                uint64_t membership_changes = 0;
+            };
+
+            /**
+             * @brief Serve a request; false reports failure to the caller
+             */
+            using RequestHandler = std::function<bool(const std::string &body, std::string &response)>;
+
+            /**
+             * @brief Called with the new ring after membership changed, on the membership thread
+             *
+             * Returning false calls it again on the next tick, even without a change.
+             */
+            using MembershipCallback = std::function<bool(const HashRing &ring)>;
+
+            GatewayCluster();
+            ~GatewayCluster();
+
+            GatewayCluster(const GatewayCluster &) = delete;
+            GatewayCluster &operator=(const GatewayCluster &) = delete;
+
+            /**
+             * @brief Listen, connect to the seeds and start tracking membership
+             *
+             * Unreachable seeds are retried while the node has no peers.
+             */
+            bool start(const Options &options, utils::Executor *executor = nullptr);
+
+            /**
+             * @brief Stop serving and leave; pending calls fail
+             */
+            void stop();
+
+            bool is_running() const;
+
+            /**
+             * @brief This node's id on the ring
+             */
+            std::string node_id() const;
+
+            /**
+             * @brief "address:port" other nodes can use as a seed
+             */
+            std::string endpoint() const;
+
+            /**
+             * @brief Current ring; it always contains this node while running
+             */
+            std::shared_ptr<const HashRing> ring() const;
+
+            /**
+             * @brief Owner of a key; this node's id when not running
+             */
+            std::string owner(const std::string &key) const;
+            bool is_local(const std::string &key) const;
+
+            /**
+             * @brief Other members, sorted
+             */
+            std::vector<std::string> members() const;
+
+            void set_request_handler(const std::string &kind, RequestHandler handler);
+            void set_membership_callback(MembershipCallback callback);
+
+            /**
+             * @brief Send a request to one node and wait for its answer
+             * @return true if the node answered and its handler succeeded
+             */
+            bool call(const std::string &node, const std::string &kind, const std::string &body,
+                      std::string &response);
+
+            /**
+             * @brief Send a request to every other member in parallel
+             * @return Answers by node; failed nodes are left out
+             */
+            std::map<std::string, std::string> call_all(const std::string &kind, const std::string &body);
+
+            Stats stats() const;
+
+        private:
+            struct Impl;
+            std::unique_ptr<Impl> pimpl_;
+        };
+
+    } // namespace network
+} // namespace cardano_iot
@@ -0,0 +1,170 @@
+#pragma once
+
+#include "cardano_iot/network/p2p_network.h"
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace cardano_iot
+{
+    namespace network
+    {
+        /**
+         * @brief Bounded "seen message" set made of two rotating Bloom filters
+         *
+         * Once the current filter has taken capacity ids it becomes the previous one
+         * and a fresh filter takes over, so memory stays fixed and an id is
+         * remembered for between one and two generations. False positives occur at
+         * roughly the configured rate.
+         */
+        class SeenFilter
+        {
+        public:
+            explicit SeenFilter(size_t capacity = 8192, double false_positive_rate = 0.001);
+
+            /**
+             * @brief Record an id
+             * @return true if it was not (probably) seen before
+             */
+            bool insert(std::string_view id);
+            bool contains(std::string_view id) const;
+
+            size_t memory_bytes() const { return (current_.size() + previous_.size()) * sizeof(uint64_t); }
+
+        private:
+            bool test(const std::vector<uint64_t> &bits, uint64_t h1, uint64_t h2) const;
+
+            size_t capacity_;
+            size_t bit_count_;
+            uint32_t hash_count_;
+            std::vector<uint64_t> current_;
+            std::vector<uint64_t> previous_;
+            size_t inserted_ = 0;
+        };
+
+        /**
+         * @brief Plumtree-style broadcast: eager push along a spanning tree, lazy announcements elsewhere
+         *
+         * Full messages go to a few "eager" peers. The other ("lazy") peers only get
+         * batched IHAVE digests of message ids. A node that receives a duplicate
+         * prunes the sender back to lazy, so the eager links settle into a tree and
+         * each message crosses about one link per node. A node that hears IHAVE for
+         * a message it never received grafts the announcer back into the tree.
+         *
+         * The engine only decides what to send. It returns messages for the caller
+         * to transmit and has no sockets or threads. Not thread-safe.
+         *
+         * Envelope payloads (type BROADCAST) hold one or more wire-encoded messages,
+         * each with a varint length prefix. IHAVE and GRAFT payloads hold a varint
+         * count followed by length-prefixed message ids.
+         */
+        class GossipEngine
+        {
+        public:
+            using Clock = std::chrono::steady_clock;
+
+            struct Config
+            {
+                std::string local_id;
+                size_t eager_fanout = 4;       // eager peers assigned on join; 0 = every peer
+                size_t seen_capacity = 8192;   // ids per Bloom generation
+                double false_positive_rate = 0.001;
+                size_t cache_messages = 1024;  // kept for answering GRAFT
+                std::chrono::milliseconds graft_timeout{250};
+                std::chrono::milliseconds batch_window{0}; // 0 sends each eager push immediately
+                size_t batch_max_bytes = 1024;
+                size_t max_ihave_batch = 64;
+            };
+
+            struct Outgoing
+            {
+                std::string peer_id;
+                NetworkMessage message;
+            };
+
+            explicit GossipEngine(const Config &config);
+
+            void add_peer(const std::string &peer_id);
+            void remove_peer(const std::string &peer_id);
+            bool is_eager(const std::string &peer_id) const;
+
+            /**
+             * @brief Originate a broadcast
+             * @return false if the message id was already seen
+             */
+            bool broadcast(const NetworkMessage &message, const std::vector<std::string> &exclude_peers,
+                           Clock::time_point now, std::vector<Outgoing> &out);
+
+            /**
+             * @brief Handle a BROADCAST, GOSSIP_IHAVE, GOSSIP_GRAFT or GOSSIP_PRUNE message
+             * @param deliver Receives the wire encoding of each message seen for the first time
+             * @return false if the type is not a gossip type or the payload is malformed
+             */
+            bool on_message(const std::string &from, MessageType type, const uint8_t *payload, size_t size,
+                            Clock::time_point now, std::vector<std::vector<uint8_t>> &deliver,
+                            std::vector<Outgoing> &out);
+
+            /**
+             * @brief Flush IHAVE digests and due batches, and graft for messages that never arrived
+             */
+            void tick(Clock::time_point now, std::vector<Outgoing> &out);
+
+            static bool is_gossip_type(MessageType type);
+
+            struct GossipStats
+            {
+                uint64_t originated;
+                uint64_t delivered;
+                uint64_t duplicates;
+                uint64_t payloads_sent; // message copies pushed to peers, including GRAFT replies
+                uint64_t envelopes_sent;
+                uint64_t ihave_sent;
+                uint64_t graft_sent;
+                uint64_t prune_sent;
+            };
+
+            GossipStats get_statistics() const { return stats_; }
+
+        private:
+            struct PeerState
+            {
+                bool eager = false;
+                std::vector<std::string> ihave;
+                std::vector<uint8_t> batch;
+                size_t batch_count = 0;
+                Clock::time_point batch_started{};
+            };
+
+            struct Missing
+            {
+                std::deque<std::string> announcers;
+                Clock::time_point deadline{};
+            };
+
+            void set_eager(const std::string &peer_id, bool eager);
+            void remember(const std::string &id, const uint8_t *data, size_t size);
+            void push(const std::string &id, const uint8_t *data, size_t size, const std::string &from,
+                      const std::vector<std::string> &exclude_peers, Clock::time_point now, std::vector<Outgoing> &out);
+            void append_to_batch(const std::string &peer_id, PeerState &peer, const uint8_t *data, size_t size,
+                                 Clock::time_point now, std::vector<Outgoing> &out);
+            void flush_batch(const std::string &peer_id, PeerState &peer, std::vector<Outgoing> &out);
+            void flush_ihave(const std::string &peer_id, PeerState &peer, std::vector<Outgoing> &out);
+            Outgoing control(const std::string &peer_id, MessageType type, const std::vector<std::string> &ids) const;
+
+            Config config_;
+            SeenFilter seen_;
+            std::unordered_map<std::string, PeerState> peers_;
+            size_t eager_count_ = 0;
+            std::unordered_map<std::string, std::vector<uint8_t>> cache_;
+            std::deque<std::string> cache_order_;
+            std::unordered_map<std::string, Missing> missing_;
+            GossipStats stats_{};
+        };
+
+    } // namespace network
+} // namespace cardano_iot
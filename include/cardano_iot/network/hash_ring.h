@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace cardano_iot
+{
+    namespace network
+    {
+        /**
+         * @brief Consistent-hash ring mapping keys (device ids) to nodes
+         *
+         * Each node is placed on the ring at virtual_nodes points, and a key
+         * belongs to the first point at or after its hash. Adding a node only
+         * takes keys over from the others, and removing one only hands its own
+         * keys on, so about 1/n of the keys move per change. The hash is FNV-1a
+         * with a 64-bit finalizer, so every node computes the same ring from the
+         * same member list. A value type; share immutable copies between threads.
+         */
+        class HashRing
+        {
+        public:
+            explicit HashRing(uint32_t virtual_nodes = 128);
+
+            /**
+             * @brief Add a node; false if it is already present
+             */
+            bool add_node(const std::string &node);
+
+            /**
+             * @brief Remove a node; false if it is not present
+             */
+            bool remove_node(const std::string &node);
+
+            bool contains(const std::string &node) const;
+
+            /**
+             * @brief Node owning a key; empty when the ring has no nodes
+             */
+            const std::string &owner(std::string_view key) const;
+
+            /**
+             * @brief Nodes in sorted order
+             */
+            const std::vector<std::string> &nodes() const { return nodes_; }
+            size_t size() const { return nodes_.size(); }
+            bool empty() const { return nodes_.empty(); }
+            uint32_t virtual_nodes() const { return virtual_nodes_; }
+
+            /**
+             * @brief Stable 64-bit key hash shared by all nodes
+             */
+            static uint64_t hash(std::string_view key);
+
+        private:
+            uint32_t virtual_nodes_;
+            std::vector<std::string> nodes_;
+            std::vector<std::pair<uint64_t, uint32_t>> points_; // (hash, index into nodes_), sorted
+
+            void rebuild();
+        };
+
+    } // namespace network
+} // namespace cardano_iot
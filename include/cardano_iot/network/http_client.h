@@ -0,0 +1,98 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <future>
+#include <functional>
+#include <cstdint>
+
+namespace cardano_iot
+{
+    namespace network
+    {
+        struct HttpRequest
+        {
+            std::string method = "GET";
+            std::string url;
+            std::vector<std::string> headers; // "Name: value"
+            std::string body;
+            uint32_t timeout_ms = 0; // 0 = client default
+        };
+
+        struct HttpResponse
+        {
+            long status = 0;
+            std::string body;
+            std::string error; // transport error, empty if a response arrived
+            double total_time_ms = 0.0;
+            bool reused_connection = false;
+
+            bool ok() const { return error.empty() && status >= 200 && status < 300; }
+        };
+
+        using HttpCompletion = std::function<void(HttpResponse &&response)>;
+
+        /**
+         * @brief Asynchronous HTTP client on a single libcurl multi handle
+         *
+         * One I/O thread drives every transfer. Connections are kept alive and
+         * reused across requests, and HTTP/2 streams are multiplexed over one
+         * connection per host where the server supports it.
+         */
+        class HttpClient
+        {
+        public:
+            struct Options
+            {
+                size_t max_connections = 16;     // total connection cache size
+                size_t max_host_connections = 8; // parallel connections per host
+                bool multiplex = true;           // HTTP/2 multiplexing when offered
+                uint32_t timeout_ms = 10000;
+                uint32_t connect_timeout_ms = 5000;
+                std::string user_agent = "cardano-iot-sdk/1.0";
+            };
+
+            HttpClient();
+            explicit HttpClient(const Options &options);
+            ~HttpClient();
+
+            HttpClient(const HttpClient &) = delete;
+            HttpClient &operator=(const HttpClient &) = delete;
+
+            /**
+             * @brief Queue a request; the completion runs on the I/O thread
+             *
+             * Completions must not block. They may queue follow-up requests.
+             */
+            void send(HttpRequest request, HttpCompletion on_complete);
+
+            /**
+             * @brief Queue a request and get its response as a future
+             */
+            std::future<HttpResponse> send(HttpRequest request);
+
+            /**
+             * @brief Fail outstanding requests and stop the I/O thread
+             */
+            void shutdown();
+
+            size_t in_flight() const;
+
+            struct HttpStats
+            {
+                uint64_t requests;
+                uint64_t failures; // transport errors
+                uint64_t reused_connections;
+                double avg_response_time_ms;
+            };
+
+            HttpStats get_statistics() const;
+
+        private:
+            class Impl;
+            std::unique_ptr<Impl> pimpl_;
+        };
+
+    } // namespace network
+} // namespace cardano_iot
@@ -31,7 +31,14 @@ namespace cardano_iot
             CAPABILITY_EXCHANGE,
             MESH_UPDATE,
             ENCRYPTED_DATA,
-            BROADCAST
+            BROADCAST,     // gossip envelope carrying one or more messages
+            GOSSIP_IHAVE,  // ids a lazy peer could fetch
+            GOSSIP_GRAFT,  // request for missing ids; also re-adds the link to the tree
+            GOSSIP_PRUNE,  // stop pushing full messages over this link
+            CLUSTER_REQUEST, // gateway cluster call to the node owning a shard (see cluster.h)
+            CLUSTER_RESPONSE,
+            SIGNING_REQUEST, // multisig body hash sent to a co-signer (see signing_coordinator.h)
+            SIGNING_RESPONSE
         };
 
         struct PeerInfo
@@ -57,6 +64,7 @@ namespace cardano_iot
             uint64_t timestamp;
             bool encrypted;
             std::string signature;
+            bool compressed = false; // payload carries a compressed body
         };
 
         struct MeshTopology
@@ -68,7 +76,15 @@ namespace cardano_iot
             double network_diameter;
         };
 
+        namespace wire
+        {
+            struct MessageView;
+        }
+
+        struct PeerSnapshot;
+
         using MessageCallback = std::function<void(const NetworkMessage&)>;
+        using MessageViewCallback = std::function<void(const wire::MessageView&)>;
         using PeerCallback = std::function<void(const PeerInfo&, bool connected)>;
 
         class P2PNetwork
@@ -81,26 +97,67 @@ namespace cardano_iot
             void shutdown();
 
             // Connection management
+            /**
+             * @brief Accept peers on the configured address and port (port 0 picks a free one)
+             */
             bool start_listening();
             void stop_listening();
+            uint16_t get_listening_port() const;
+
+            /**
+             * @brief Open a TCP connection to "host:port" and complete the handshake
+             *
+             * Blocks the caller up to connection_timeout_ms; the socket I/O itself runs
+             * on the shared event loops.
+             */
             bool connect_to_peer(const std::string& endpoint);
             bool disconnect_from_peer(const std::string& peer_id);
             bool is_listening() const;
 
+            /**
+             * @brief Id this node presents in handshakes; empty before initialize()
+             */
+            std::string get_local_peer_id() const;
+
             // Peer management
             std::vector<PeerInfo> get_connected_peers() const;
             PeerInfo get_peer_info(const std::string& peer_id) const;
+
+            /**
+             * @brief Current peer table version without copying it (see peer_table.h)
+             *
+             * Lock-free. Entries are shared with the live table and their counters keep moving.
+             */
+            std::shared_ptr<const PeerSnapshot> get_peer_snapshot() const;
             bool add_trusted_peer(const std::string& peer_id, const std::string& public_key);
             bool remove_peer(const std::string& peer_id);
+            /**
+             * @brief Refuse handshakes from a peer and drop its connection; 0 seconds bans for good
+             */
             bool ban_peer(const std::string& peer_id, uint32_t duration_seconds = 3600);
 
             // Messaging
             bool send_message(const std::string& peer_id, const NetworkMessage& message);
+            /**
+             * @brief Send a message to the whole mesh
+             *
+             * With mesh routing enabled it is gossiped: pushed along a self-pruning
+             * tree, relayed by every node once and de-duplicated by message_id.
+             * The id must be unique. Otherwise it goes only to direct peers.
+             */
             bool broadcast_message(const NetworkMessage& message, const std::vector<std::string>& exclude_peers = {});
             bool send_encrypted_message(const std::string& peer_id, const std::vector<uint8_t>& data);
 
             // Message handling
             void set_message_handler(MessageType type, MessageCallback callback);
+
+            /**
+             * @brief Handle a message type without copying it out of the receive buffer
+             *
+             * Takes precedence over set_message_handler() for the same type. The view is
+             * valid only during the call and runs on a transport thread, so it must not block.
+             */
+            void set_message_view_handler(MessageType type, MessageViewCallback callback);
             void set_peer_event_handler(PeerCallback callback);
 
             // Device discovery
@@ -109,14 +166,37 @@ namespace cardano_iot
             bool announce_device_presence();
 
             // Mesh networking
+            /**
+             * @brief Direct peers plus routed reachability
+             *
+             * connections maps the local id to its neighbours and each neighbour to the
+             * destinations routed through it. network_diameter is the hop count to the
+             * farthest reachable destination. The routed part is cached and rebuilt only
+             * after the routing table changes.
+             */
             MeshTopology get_mesh_topology() const;
             bool enable_mesh_routing(bool enable = true);
+
+            /**
+             * @brief [local, next hop, target] from the routing table, or empty if unreachable
+             *
+             * Routes are learned from MESH_UPDATE distance-vector adverts, so only the
+             * next hop is known locally. A directly connected target yields [local, target].
+             */
             std::vector<std::string> find_route_to_peer(const std::string& target_peer_id) const;
             bool forward_message(const NetworkMessage& message, const std::string& next_hop);
 
             // Network synchronization
             bool sync_with_peers();
+
+            /**
+             * @brief Ask a neighbour for its full routing table
+             */
             bool request_peer_list_from(const std::string& peer_id);
+
+            /**
+             * @brief Send a neighbour our full routing table (routes through it left out)
+             */
             bool share_peer_list_with(const std::string& peer_id);
 
             // Security
@@ -134,8 +214,23 @@ namespace cardano_iot
                 uint32_t message_queue_size;
             };
 
+            /**
+             * @brief Latency from ping round trips, loss and throughput from actual outbound traffic
+             */
             QoSMetrics get_qos_metrics() const;
+
+            /**
+             * @brief Cap outbound traffic across all peers with a token bucket; 0 removes the cap
+             */
             bool set_bandwidth_limit(uint32_t kbps);
+
+            /**
+             * @brief Priority (0-255, higher first) for the next message sent with this id
+             *
+             * 192 and above go out ahead of everything else; lower bands share the
+             * remaining bandwidth by weight. Without an override, control messages are
+             * critical and DATA_SYNC is bulk.
+             */
             bool set_message_priority(const std::string& message_id, uint8_t priority);
 
             // Configuration
@@ -152,6 +247,11 @@ namespace cardano_iot
                 bool enable_mesh_routing = true;
                 uint32_t discovery_interval_ms = 60000;
                 std::string network_id = "cardano_iot_testnet";
+                uint32_t io_threads = 2;               // event loops shared by all connections
+                uint32_t max_message_bytes = 1 << 20;  // larger frames close the connection
+                uint32_t bandwidth_limit_kbps = 0;     // outbound cap across all peers, 0 = unlimited
+                uint32_t gossip_fanout = 4;            // eager-push peers per node when mesh routing is on
+                uint32_t gossip_batch_window_ms = 0;   // hold small gossip pushes per peer up to this long
             };
 
             void update_config(const P2PConfig& config);
@@ -169,6 +269,9 @@ namespace cardano_iot
                 uint64_t discovery_attempts;
                 uint64_t successful_authentications;
                 uint64_t failed_authentications;
+                uint64_t gossip_delivered;  // broadcasts received for the first time
+                uint64_t gossip_duplicates; // copies suppressed by the seen-message filter
+                uint64_t messages_relayed;  // routed messages passed on towards their recipient
                 double uptime_seconds;
             };
 
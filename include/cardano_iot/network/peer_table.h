@@ -0,0 +1,102 @@
+#pragma once
+
+#include "cardano_iot/network/p2p_network.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cardano_iot
+{
+    namespace network
+    {
+        /**
+         * @brief One peer; identity is fixed, status and traffic counters are atomics
+         *
+         * Counters are updated in place by any thread, so every snapshot that
+         * shares the entry sees them move. A change to the fixed fields publishes
+         * a replacement entry, which carries the counters over.
+         */
+        struct PeerEntry
+        {
+            PeerEntry(const PeerInfo &info, uint64_t connection_id);
+
+            const std::string peer_id;
+            const std::string endpoint;
+            const std::string public_key;
+            const std::vector<std::string> capabilities;
+            const uint64_t connection_id; // transport connection; 0 if none
+
+            std::atomic<PeerStatus> status;
+            std::atomic<uint64_t> last_seen;
+            std::atomic<uint64_t> bytes_sent;
+            std::atomic<uint64_t> bytes_received;
+            std::atomic<double> latency_ms;
+
+            bool connected() const
+            {
+                const PeerStatus current = status.load(std::memory_order_relaxed);
+                return current == PeerStatus::CONNECTED || current == PeerStatus::AUTHENTICATED;
+            }
+
+            void record_traffic(uint64_t bytes, bool sent, uint64_t now_seconds);
+            void record_latency(double rtt_ms, double smoothing);
+
+            PeerInfo to_info() const;
+        };
+
+        /**
+         * @brief Immutable version of the peer table; entries are shared, never copied
+         */
+        struct PeerSnapshot
+        {
+            std::unordered_map<std::string, std::shared_ptr<PeerEntry>> peers;
+            uint64_t version = 0;
+
+            size_t connected_count() const;
+        };
+
+        /**
+         * @brief Read-copy-update peer table
+         *
+         * Readers load the current snapshot with one atomic shared_ptr load and
+         * never wait for writers. Writers are serialised on an internal mutex.
+         * They copy the map of entry pointers, change it and publish the result.
+         * Peers join and leave rarely, so the copy is cheap next to the reads it
+         * saves.
+         */
+        class PeerTable
+        {
+        public:
+            PeerTable();
+
+            std::shared_ptr<const PeerSnapshot> snapshot() const;
+            std::shared_ptr<PeerEntry> find(const std::string &peer_id) const;
+            size_t size() const { return snapshot()->peers.size(); }
+
+            void insert(const PeerInfo &info, uint64_t connection_id);
+
+            /**
+             * @brief Remove a peer
+             * @return The removed entry, or nullptr if it was not present
+             */
+            std::shared_ptr<PeerEntry> erase(const std::string &peer_id);
+
+            /**
+             * @brief Replace the public key, keeping connection and counters
+             */
+            bool set_public_key(const std::string &peer_id, const std::string &public_key);
+
+            void clear();
+
+        private:
+            std::shared_ptr<const PeerSnapshot> current_; // accessed with std::atomic_load/store only
+            std::mutex write_mutex_;
+        };
+
+    } // namespace network
+} // namespace cardano_iot
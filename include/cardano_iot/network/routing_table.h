@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace cardano_iot
+{
+    namespace network
+    {
+        /**
+         * @brief Distance-vector routing table with cached next hops
+         *
+         * Neighbours advertise (destination, metric, sequence) triples. Changes are
+         * incremental: a join, a leave or an update re-evaluates only the
+         * destinations it touches, in O(neighbours) each. Lookups are a single hash
+         * probe. Destinations that changed are collected so the caller can send
+         * triggered deltas, which use poisoned reverse.
+         *
+         * As in DSDV, every node numbers its own entry with an even sequence that
+         * rises whenever its links change. A node that loses a route advertises it
+         * unreachable at the next odd number. Only a fresher even number from the
+         * destination can revive the route, so a withdrawal cannot loop around a
+         * cycle and count to infinity. Not thread-safe.
+         */
+        class RoutingTable
+        {
+        public:
+            struct Route
+            {
+                std::string destination;
+                std::string next_hop;
+                uint32_t metric = 0;
+                uint64_t sequence = 0;
+            };
+
+            struct Advert
+            {
+                std::string destination;
+                uint32_t metric = 0; // >= max_metric means unreachable
+                uint64_t sequence = 0;
+            };
+
+            enum class UpdateKind : uint8_t
+            {
+                REQUEST = 0, // ask for a full table
+                FULL = 1,    // complete table; replaces what the sender advertised before
+                DELTA = 2    // changed destinations only
+            };
+
+            explicit RoutingTable(std::string local_id, uint32_t max_metric = 64);
+
+            void add_neighbor(const std::string &peer_id, uint32_t cost = 1);
+            void remove_neighbor(const std::string &peer_id);
+            bool is_neighbor(const std::string &peer_id) const { return neighbors_.count(peer_id) != 0; }
+            std::vector<std::string> neighbors() const;
+
+            /**
+             * @brief Apply what a neighbour advertised; ignored for non-neighbours
+             */
+            void apply_update(const std::string &neighbor, const std::vector<Advert> &adverts, bool full);
+
+            /**
+             * @brief Best route to a destination
+             * @return nullptr if unreachable; the pointer is valid until the next change
+             */
+            const Route *lookup(const std::string &destination) const;
+
+            /**
+             * @brief Destinations whose route changed since the last call
+             */
+            std::vector<std::string> take_changes();
+            bool has_changes() const { return !changed_.empty(); }
+
+            /**
+             * @brief What to tell one neighbour about the given destinations
+             */
+            std::vector<Advert> adverts_for(const std::string &neighbor, const std::vector<std::string> &destinations) const;
+
+            /**
+             * @brief Our own entry plus every route not through that neighbour
+             */
+            std::vector<Advert> full_table_for(const std::string &neighbor) const;
+
+            std::vector<Route> routes() const;
+            size_t size() const { return routes_.size(); }
+            uint32_t max_metric() const { return max_metric_; }
+
+            /**
+             * @brief Incremented on every route change, for caching derived views
+             */
+            uint64_t version() const { return version_; }
+
+            static std::vector<uint8_t> encode(UpdateKind kind, const std::vector<Advert> &adverts);
+            static bool decode(const uint8_t *data, size_t size, UpdateKind &kind, std::vector<Advert> &adverts);
+
+        private:
+            struct Heard
+            {
+                uint32_t metric;
+                uint64_t sequence;
+            };
+
+            void recompute(const std::string &destination);
+            void withdraw(const std::string &destination, uint64_t sequence);
+            void bump_sequence();
+
+            std::string local_id_;
+            uint32_t max_metric_;
+            uint64_t sequence_ = 0; // our own entry; always even
+            std::unordered_map<std::string, uint32_t> neighbors_; // link cost
+            std::unordered_map<std::string, std::unordered_map<std::string, Heard>> advertised_;
+            std::unordered_map<std::string, Route> routes_;
+            std::unordered_map<std::string, uint64_t> withdrawn_; // odd sequence a lost route was withdrawn at
+            std::unordered_set<std::string> changed_;
+            uint64_t version_ = 0;
+        };
+
+    } // namespace network
+} // namespace cardano_iot
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace cardano_iot
+{
+    namespace network
+    {
+        /**
+         * @brief Outbound frame queues per peer with strict-priority and weighted fair scheduling
+         *
+         * Priorities 0-255 fall into four classes (higher is more urgent). CRITICAL
+         * frames always leave first; HIGH, NORMAL and BULK share what is left by
+         * deficit round robin in proportion to their weights. Within a class, peers
+         * take turns, so one chatty peer cannot starve the others. Not thread-safe.
+         */
+        class SendScheduler
+        {
+        public:
+            using PeerKey = uint64_t;
+            using ReadyPredicate = std::function<bool(PeerKey peer)>;
+
+            enum class TrafficClass
+            {
+                CRITICAL, // 192-255: alarms and control traffic
+                HIGH,     // 128-191
+                NORMAL,   // 64-127
+                BULK      // 0-63: sync and other background transfers
+            };
+
+            struct Config
+            {
+                size_t max_queued_bytes_per_peer = 1 << 20;
+                size_t quantum_bytes = 1500;
+                std::array<uint32_t, 3> weights = {8, 4, 1}; // HIGH, NORMAL, BULK
+            };
+
+            SendScheduler();
+            explicit SendScheduler(const Config &config);
+
+            static TrafficClass class_for_priority(uint8_t priority);
+
+            /**
+             * @brief Queue one frame for a peer
+             * @return false (and the frame is dropped) when the peer's queue is full
+             */
+            bool enqueue(PeerKey peer, uint8_t priority, std::vector<uint8_t> frame);
+
+            /**
+             * @brief Take the next frame to send
+             * @param ready Peers for which it returns false are skipped this round
+             * @return false if nothing is queued for a ready peer
+             */
+            bool next(PeerKey &peer, std::vector<uint8_t> &frame, const ReadyPredicate &ready = nullptr);
+
+            /**
+             * @brief Drop everything queued for a peer
+             * @return Number of frames dropped
+             */
+            size_t remove_peer(PeerKey peer);
+
+            size_t queued_frames() const { return queued_frames_; }
+            size_t queued_bytes() const { return queued_bytes_; }
+            bool empty() const { return queued_frames_ == 0; }
+
+        private:
+            struct ClassQueue
+            {
+                std::unordered_map<PeerKey, std::deque<std::vector<uint8_t>>> queues;
+                std::deque<PeerKey> ring; // peers with queued frames, in service order
+                size_t frames = 0;
+            };
+
+            std::deque<std::vector<uint8_t>> *front_ready(ClassQueue &queue, const ReadyPredicate &ready);
+            void pop_front(ClassQueue &queue, PeerKey &peer, std::vector<uint8_t> &frame);
+
+            Config config_;
+            std::array<ClassQueue, 4> classes_;
+            std::array<size_t, 3> deficit_ = {0, 0, 0};
+            size_t current_ = 0; // weighted class being served
+            bool topped_up_ = false;
+            std::unordered_map<PeerKey, size_t> peer_bytes_;
+            size_t queued_frames_ = 0;
+            size_t queued_bytes_ = 0;
+        };
+
+        /**
+         * @brief Token-bucket rate limiter
+         *
+         * A send may take the balance negative; the next one waits until it is
+         * positive again. Waiting between frames rather than before them lets an
+         * urgent frame that arrives meanwhile go next. A rate of 0 means unlimited.
+         */
+        class TokenBucket
+        {
+        public:
+            using Clock = std::chrono::steady_clock;
+
+            TokenBucket(uint64_t bytes_per_second = 0, uint64_t burst_bytes = 0);
+
+            void set_rate(uint64_t bytes_per_second, uint64_t burst_bytes);
+            uint64_t rate() const { return rate_; }
+
+            bool ready(Clock::time_point now);
+            void consume(uint64_t bytes, Clock::time_point now);
+
+            /**
+             * @brief Earliest time ready() becomes true
+             */
+            Clock::time_point ready_at(Clock::time_point now);
+
+        private:
+            void refill(Clock::time_point now);
+
+            uint64_t rate_ = 0;
+            double burst_ = 0.0;
+            double tokens_ = 0.0;
+            Clock::time_point last_refill_ = Clock::now();
+        };
+
+    } // namespace network
+} // namespace cardano_iot
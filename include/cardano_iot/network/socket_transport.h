@@ -0,0 +1,126 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <cstdint>
+
+namespace cardano_iot
+{
+    namespace network
+    {
+        /**
+         * @brief Non-blocking TCP transport with length-prefixed framing
+         *
+         * A small, fixed set of event-loop threads (epoll on Linux, poll()
+         * elsewhere) serves every connection, so hundreds of peers cost file
+         * descriptors rather than threads. Each frame on the wire is a varint
+         * (unsigned LEB128) length followed by the frame bytes, so small frames
+         * pay one or two bytes of framing. Handlers run on the event-loop thread
+         * that owns the connection and must not block.
+         */
+        class SocketTransport
+        {
+        public:
+            using ConnectionId = uint64_t; // 0 is never a valid id
+
+            // Connection established (outbound connect finished, or inbound accepted)
+            using ConnectHandler = std::function<void(ConnectionId id, const std::string &endpoint, bool inbound)>;
+
+            // One complete frame; the bytes point into the receive buffer and are valid only during the call
+            using FrameHandler = std::function<void(ConnectionId id, const uint8_t *data, size_t size)>;
+
+            // Connection gone (closed by either side, failed to connect, or transport stopped)
+            using CloseHandler = std::function<void(ConnectionId id)>;
+
+            // Receives each sent frame's buffer back once it is written, for reuse
+            using BufferRecycler = std::function<void(std::vector<uint8_t> &&buffer)>;
+
+            struct Options
+            {
+                size_t io_threads = 2;
+                size_t max_connections = 1024;
+                size_t max_frame_bytes = 1 << 20;          // larger frames close the connection
+                size_t max_pending_write_bytes = 8 << 20;  // per connection; send() fails beyond this
+                int listen_backlog = 512;
+            };
+
+            SocketTransport();
+            explicit SocketTransport(const Options &options);
+            ~SocketTransport();
+
+            SocketTransport(const SocketTransport &) = delete;
+            SocketTransport &operator=(const SocketTransport &) = delete;
+
+            /**
+             * @brief Install handlers; call before start()
+             */
+            void set_handlers(ConnectHandler on_connect, FrameHandler on_frame, CloseHandler on_close);
+
+            /**
+             * @brief Hand written frame buffers to recycler instead of freeing them; call before start()
+             */
+            void set_buffer_recycler(BufferRecycler recycler);
+
+            bool start();
+
+            /**
+             * @brief Close every connection (their close handlers run) and join the event loops
+             *
+             * Must not be called from a handler.
+             */
+            void stop();
+            bool is_running() const;
+
+            /**
+             * @brief Accept peers on address:port; port 0 picks an ephemeral port
+             * @return The bound port, or 0 on failure
+             */
+            uint16_t listen(const std::string &address, uint16_t port);
+            void stop_listening();
+            uint16_t listening_port() const;
+
+            /**
+             * @brief Start a non-blocking connect
+             * @return Connection id (the connect or close handler reports the outcome), 0 on immediate failure
+             */
+            ConnectionId connect(const std::string &host, uint16_t port);
+
+            /**
+             * @brief Queue one frame; safe from any thread, including handlers
+             * @return false if the connection is unknown, the frame too large or the write queue full
+             */
+            bool send(ConnectionId id, std::vector<uint8_t> frame);
+
+            bool close(ConnectionId id);
+
+            /**
+             * @brief Bytes queued on a connection but not yet written (0 for unknown ids)
+             */
+            size_t pending_bytes(ConnectionId id) const;
+
+            size_t connection_count() const;
+
+            struct TransportStats
+            {
+                uint64_t connections_accepted;
+                uint64_t connections_opened;
+                uint64_t connections_closed;
+                uint64_t frames_sent;
+                uint64_t frames_received;
+                uint64_t bytes_sent;     // including framing
+                uint64_t bytes_received; // including framing
+                uint64_t frames_rejected; // oversized or over the write queue limit
+                uint64_t write_syscalls;
+            };
+
+            TransportStats get_statistics() const;
+
+        private:
+            class Impl;
+            std::unique_ptr<Impl> pimpl_;
+        };
+
+    } // namespace network
+} // namespace cardano_iot
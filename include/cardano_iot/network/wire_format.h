@@ -0,0 +1,173 @@
+#pragma once
+
+#include "cardano_iot/network/p2p_network.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <mutex>
+#include <cstdint>
+#include <cstddef>
+
+namespace cardano_iot
+{
+    namespace network
+    {
+        namespace wire
+        {
+            /**
+             * Version 1 layout of one encoded NetworkMessage (the transport frames it):
+             *
+             *   byte 0   version (high nibble) | flags (low nibble)
+             *   byte 1   message type
+             *   varint   timestamp
+             *   varint   length + message_id
+             *   varint   length + sender_id
+             *   varint   length + recipient_id   (only with FLAG_RECIPIENT)
+             *   varint   length + signature      (only with FLAG_SIGNATURE)
+             *   ...      payload, up to the end of the frame
+             *
+             * Varints are unsigned LEB128. A small message with short ids costs
+             * about a dozen header bytes.
+             */
+            constexpr uint8_t VERSION = 1;
+
+            constexpr uint8_t FLAG_ENCRYPTED = 0x01;
+            constexpr uint8_t FLAG_COMPRESSED = 0x02;
+            constexpr uint8_t FLAG_RECIPIENT = 0x04;
+            constexpr uint8_t FLAG_SIGNATURE = 0x08;
+
+            constexpr size_t MAX_VARINT_BYTES = 10;
+
+            /**
+             * @brief Encoded size of an unsigned LEB128 varint
+             */
+            inline size_t varint_size(uint64_t value)
+            {
+                size_t size = 1;
+                while (value >= 0x80)
+                {
+                    value >>= 7;
+                    ++size;
+                }
+                return size;
+            }
+
+            /**
+             * @brief Write a varint to out (at least varint_size(value) bytes)
+             * @return Number of bytes written
+             */
+            inline size_t put_varint(uint64_t value, uint8_t *out)
+            {
+                size_t size = 0;
+                while (value >= 0x80)
+                {
+                    out[size++] = static_cast<uint8_t>(value) | 0x80;
+                    value >>= 7;
+                }
+                out[size++] = static_cast<uint8_t>(value);
+                return size;
+            }
+
+            /**
+             * @brief Read a varint from [data, data + size)
+             * @return Bytes consumed, 0 if the input ends first or the varint is malformed
+             */
+            inline size_t get_varint(const uint8_t *data, size_t size, uint64_t &value)
+            {
+                value = 0;
+                const size_t limit = size < MAX_VARINT_BYTES ? size : MAX_VARINT_BYTES;
+                for (size_t i = 0; i < limit; ++i)
+                {
+                    value |= static_cast<uint64_t>(data[i] & 0x7f) << (7 * i);
+                    if ((data[i] & 0x80) == 0)
+                    {
+                        return i + 1;
+                    }
+                }
+                return 0;
+            }
+
+            /**
+             * @brief Decoded message that points into the receive buffer instead of owning its bytes
+             *
+             * Valid only while the buffer it was decoded from is; call to_message()
+             * to keep a copy past the handler.
+             */
+            struct MessageView
+            {
+                uint8_t version = 0;
+                uint8_t flags = 0;
+                MessageType type = MessageType::HANDSHAKE;
+                uint64_t timestamp = 0;
+                std::string_view message_id;
+                std::string_view sender_id;
+                std::string_view recipient_id;
+                std::string_view signature;
+                const uint8_t *payload = nullptr;
+                size_t payload_size = 0;
+
+                bool encrypted() const { return (flags & FLAG_ENCRYPTED) != 0; }
+                bool compressed() const { return (flags & FLAG_COMPRESSED) != 0; }
+
+                NetworkMessage to_message() const;
+            };
+
+            /**
+             * @brief Exact encoded size of a message
+             */
+            size_t encoded_size(const NetworkMessage &message);
+
+            /**
+             * @brief Append the encoding of a message to out
+             *
+             * Reserves encoded_size() up front, so a pooled buffer is written without
+             * reallocating.
+             */
+            void encode(const NetworkMessage &message, std::vector<uint8_t> &out);
+            std::vector<uint8_t> encode(const NetworkMessage &message);
+
+            /**
+             * @brief Decode without copying; the view borrows from data
+             * @return false on a truncated frame, an unknown version or an unknown message type
+             */
+            bool decode(const uint8_t *data, size_t size, MessageView &view);
+            bool decode(const uint8_t *data, size_t size, NetworkMessage &message);
+
+            /**
+             * @brief Free list of byte buffers reused across sends
+             *
+             * acquire() hands out a cleared buffer that keeps its previous capacity;
+             * release() takes it back once the bytes are on the wire. Thread-safe.
+             */
+            class BufferPool
+            {
+            public:
+                explicit BufferPool(size_t max_buffers = 256, size_t max_buffer_capacity = 64 * 1024);
+
+                std::vector<uint8_t> acquire();
+                void release(std::vector<uint8_t> &&buffer);
+
+                size_t idle_count() const;
+
+                struct PoolStats
+                {
+                    uint64_t acquired;
+                    uint64_t reused; // acquisitions served from the free list
+                    uint64_t released;
+                    uint64_t dropped; // released buffers freed instead (pool full or buffer oversized)
+                };
+
+                PoolStats get_statistics() const;
+
+            private:
+                const size_t max_buffers_;
+                const size_t max_buffer_capacity_;
+                mutable std::mutex mutex_;
+                std::vector<std::vector<uint8_t>> free_;
+                PoolStats stats_{};
+            };
+
+        } // namespace wire
+    } // namespace network
+} // namespace cardano_iot
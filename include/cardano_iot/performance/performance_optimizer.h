@@ -19,6 +19,7 @@
 #include <functional>
 #include <cstdint>
 #include <atomic>
+#include <chrono>
 #include <thread>
 
 namespace cardano_iot::performance
@@ -140,15 +141,54 @@ namespace cardano_iot::performance
         uint32_t recovery_threshold;
     };
 
+    /**
+     * @brief A live setting the optimizer may adjust
+     *
+     * The directions say which way to move the value for lower latency and
+     * for lower energy use: +1 to raise it, -1 to lower it, 0 if it has no
+     * effect on that goal. See tuning_knobs.h for knobs over SDK components.
+     */
+    struct TuningKnob
+    {
+        std::string name;     // e.g. "provenance.anchor_batch_size"
+        std::string category; // "batching", "threads", "logging", "cache" or "bandwidth"
+        double min_value = 0.0;
+        double max_value = 0.0;
+        int latency_direction = 0;
+        int energy_direction = 0;
+        double step_factor = 1.5; // Multiplicative step per adjustment
+        bool integral = true;
+        std::function<double()> get;
+        std::function<bool(double)> set;
+    };
+
+    /**
+     * @brief One adjustment made to a knob
+     */
+    struct TuningChange
+    {
+        std::string knob;
+        double old_value;
+        double new_value;
+        std::string reason;
+        uint64_t timestamp;
+    };
+
     /**
      * @brief Performance Optimizer
      *
-     * Provides comprehensive performance optimization including:
-     * - Automatic performance tuning
-     * - Resource allocation optimization
-     * - Load balancing and distribution
-     * - Energy efficiency optimization
-     * - Real-time performance monitoring
+     * A feedback controller over registered TuningKnobs. Each optimization
+     * period it reads the metrics registry: the windowed quantile of a
+     * latency histogram (latency_metric, latency_quantile) and, when a power
+     * source is set, the current draw. The strategy decides whether to
+     * tighten (move knobs towards lower latency), relax (towards lower
+     * energy) or hold; values within the hysteresis band of the target hold.
+     * One knob moves per period, round robin, so each change can be judged
+     * on its own window. Every change is logged and kept in the tuning history.
+     *
+     * Configuration keys: target_latency_ms (100), latency_metric
+     * (cardano_iot_client_query_duration_ms), latency_quantile (0.95),
+     * hysteresis (0.1), min_samples (20), power_budget_mw (0 = none).
      */
     class PerformanceOptimizer
     {
@@ -419,6 +459,40 @@ namespace cardano_iot::performance
         template <typename Operation>
         double measure_latency(const std::string &operation_name, Operation operation);
 
+        // Tuning Knobs
+        /**
+         * @brief Add a knob for the controller; replaces a knob with the same name
+         * @return false if get/set are missing or the range is empty
+         */
+        bool register_knob(const TuningKnob &knob);
+
+        /**
+         * @brief Remove a knob; call before the component it controls is destroyed
+         */
+        bool unregister_knob(const std::string &name);
+
+        std::vector<std::string> get_knob_names() const;
+
+        /**
+         * @brief Current value of a knob; NaN if unknown
+         */
+        double get_knob_value(const std::string &name) const;
+
+        /**
+         * @brief Changes made to knobs, oldest first (last 256)
+         */
+        std::vector<TuningChange> get_tuning_history() const;
+
+        /**
+         * @brief Source of the current power draw in mW, read once per period
+         */
+        void set_power_source(std::function<double()> source);
+
+        /**
+         * @brief Record an operation latency in the "cardano_iot_operation_duration_ms" histogram
+         */
+        void record_latency(const std::string &operation_name, double latency_ms);
+
         // Event Handling
         /**
          * @brief Set metrics callback
@@ -472,21 +546,36 @@ namespace cardano_iot::performance
     };
 
     /**
-     * @brief Performance profiler utility
+     * @brief Low-overhead span tracer
+     *
+     * ScopedTimer spans go into a lock-free per-thread ring, timed with the
+     * TSC on x86-64 (steady_clock elsewhere). A background thread drains the
+     * rings every few milliseconds into per-name statistics and a trace. While
+     * profiling is disabled a span costs one relaxed atomic load, so spans can
+     * stay in hot paths of production builds and be switched on at run time.
+     * Spans that find their ring full are counted and dropped, not waited on.
      */
     class PerformanceProfiler
     {
     public:
         /**
          * @brief Start profiling session
+         *
+         * Clears the previous session's data, enables span recording and starts
+         * the background flusher.
          * @param session_name Name of profiling session
          */
         static void start_session(const std::string &session_name);
 
         /**
          * @brief End profiling session
+         *
+         * Stops recording and drains every thread's spans. The trace stays
+         * available for export until the next session starts.
          * @param session_name Name of profiling session
-         * @return Profiling results
+         * @return Profiling results: "<span>.count", "<span>.total_ms",
+         *         "<span>.avg_ms", "<span>.max_ms", plus "spans_dropped"
+         *         (empty if session_name is not the active session)
          */
         static std::map<std::string, double> end_session(const std::string &session_name);
 
@@ -504,24 +593,106 @@ namespace cardano_iot::performance
          * @return Comprehensive profiling report
          */
         static std::string get_profiling_report();
+
+        /**
+         * @brief Turn span recording on or off without touching the session
+         */
+        static void set_enabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+        static bool is_enabled() { return enabled_.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Session trace in Chrome trace event format (loads in Perfetto and chrome://tracing)
+         */
+        static std::string export_chrome_trace();
+        static bool export_chrome_trace(const std::string &file_path);
+
+        /**
+         * @brief Cap on spans kept for the trace; statistics keep counting past it
+         */
+        static void set_trace_capacity(size_t max_events);
+
+        // Span recording; used by ScopedTimer
+        static uint64_t now_ticks();
+        static void record_span(const char *name, uint64_t start_ticks, uint64_t end_ticks);
+        static double ticks_to_ms(uint64_t ticks);
+
+        /**
+         * @brief Stable copy of a dynamic span name (interned once, never freed)
+         */
+        static const char *intern(const std::string &name);
+
+    private:
+        static inline std::atomic<bool> enabled_{false};
     };
 
     /**
      * @brief RAII performance timer
+     *
+     * Records a span named operation_name when profiling is enabled at
+     * construction; otherwise it does nothing. Pass string literals (or other
+     * names that outlive the session) where possible; std::string names are
+     * interned.
      */
     class ScopedTimer
     {
     public:
-        explicit ScopedTimer(const std::string &operation_name);
-        ~ScopedTimer();
+        explicit ScopedTimer(const char *operation_name)
+            : operation_name_(operation_name),
+              start_ticks_(PerformanceProfiler::is_enabled() ? PerformanceProfiler::now_ticks() : 0)
+        {
+        }
+
+        explicit ScopedTimer(const std::string &operation_name)
+            : operation_name_(PerformanceProfiler::is_enabled() ? PerformanceProfiler::intern(operation_name) : nullptr),
+              start_ticks_(operation_name_ ? PerformanceProfiler::now_ticks() : 0)
+        {
+        }
 
-        double get_elapsed_ms() const;
+        ~ScopedTimer()
+        {
+            if (start_ticks_ != 0)
+            {
+                PerformanceProfiler::record_span(operation_name_, start_ticks_, PerformanceProfiler::now_ticks());
+            }
+        }
+
+        ScopedTimer(const ScopedTimer &) = delete;
+        ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+        /**
+         * @brief Time since construction; 0 if profiling was disabled then
+         */
+        double get_elapsed_ms() const
+        {
+            return start_ticks_ != 0 ? PerformanceProfiler::ticks_to_ms(PerformanceProfiler::now_ticks() - start_ticks_) : 0.0;
+        }
 
     private:
-        std::string operation_name_;
-        std::chrono::high_resolution_clock::time_point start_time_;
+        const char *operation_name_;
+        uint64_t start_ticks_;
     };
 
+    template <typename Operation>
+    double PerformanceOptimizer::measure_latency(const std::string &operation_name, Operation operation)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        operation();
+        const double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        record_latency(operation_name, elapsed);
+        return elapsed;
+    }
+
+    template <typename Function>
+    double PerformanceProfiler::profile_function(const std::string &function_name, Function function)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        {
+            ScopedTimer timer(function_name);
+            function();
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
     // Utility Functions
     /**
      * @brief Convert optimization strategy to string
@@ -555,7 +726,9 @@ namespace cardano_iot::performance
     uint64_t estimate_optimal_buffer_size(double data_rate_mbps, uint32_t latency_target_ms);
 
 // Macros for easy profiling
-#define PROFILE_SCOPE(name) cardano_iot::performance::ScopedTimer timer(name)
+#define CARDANO_IOT_PROFILE_CONCAT_(a, b) a##b
+#define CARDANO_IOT_PROFILE_NAME_(line) CARDANO_IOT_PROFILE_CONCAT_(profile_scope_, line)
+#define PROFILE_SCOPE(name) cardano_iot::performance::ScopedTimer CARDANO_IOT_PROFILE_NAME_(__LINE__)(name)
 #define PROFILE_FUNCTION() PROFILE_SCOPE(__FUNCTION__)
 
 } // namespace cardano_iot::performance
@@ -0,0 +1,74 @@
+/**
+ * @file tuning_knobs.h
+ * @brief Tuning knobs over live SDK settings for PerformanceOptimizer
+ *
+ * Each function wraps one setting that can change while the component runs.
+ * The component must outlive the knob's registration: unregister the knob
+ * before destroying it.
+ *
+ * @author Cardano IoT SDK Team
+ * @version 1.0.0
+ */
+
+#ifndef CARDANO_IOT_TUNING_KNOBS_H
+#define CARDANO_IOT_TUNING_KNOBS_H
+
+#include "cardano_iot/performance/performance_optimizer.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace cardano_iot
+{
+    class CardanoIoTSDK;
+    namespace core
+    {
+        class TransactionBuilderPool;
+    }
+    namespace data
+    {
+        class DataProvenance;
+    }
+    namespace network
+    {
+        class CardanoClient;
+        class P2PNetwork;
+    }
+} // namespace cardano_iot
+
+namespace cardano_iot::performance
+{
+
+    /**
+     * @brief "sdk.ingestion_batch_size": readings per ingestion pass; smaller waits less, larger amortizes more
+     */
+    TuningKnob ingestion_batch_knob(CardanoIoTSDK &sdk, uint32_t min_batch = 16, uint32_t max_batch = 8192);
+
+    /**
+     * @brief "provenance.anchor_batch_size": events per anchor transaction
+     */
+    TuningKnob anchor_batch_knob(data::DataProvenance &provenance, size_t min_batch = 16, size_t max_batch = 65536);
+
+    /**
+     * @brief "builder_pool.workers": transaction builder threads
+     */
+    TuningKnob builder_workers_knob(core::TransactionBuilderPool &pool, size_t min_workers = 1, size_t max_workers = 0);
+
+    /**
+     * @brief "logger.flush_interval_ms": async log writer wake-up interval
+     */
+    TuningKnob logger_flush_knob(uint32_t min_ms = 10, uint32_t max_ms = 1000);
+
+    /**
+     * @brief "client.utxo_cache_ttl_ms": how long UTXO answers are reused
+     */
+    TuningKnob utxo_cache_ttl_knob(network::CardanoClient &client, uint32_t min_ms = 1000, uint32_t max_ms = 120000);
+
+    /**
+     * @brief "p2p.bandwidth_limit_kbps": outbound share of the radio across all peers
+     */
+    TuningKnob p2p_bandwidth_knob(network::P2PNetwork &network, uint32_t min_kbps = 64, uint32_t max_kbps = 100000);
+
+} // namespace cardano_iot::performance
+
+#endif // CARDANO_IOT_TUNING_KNOBS_H
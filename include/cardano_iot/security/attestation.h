@@ -6,6 +6,11 @@
 
 namespace cardano_iot
 {
+    namespace utils
+    {
+        class Executor;
+    }
+
     namespace security
     {
 
@@ -16,6 +21,7 @@ namespace cardano_iot
             std::string nonce;                         // server-provided
             std::string quote;                         // attestation quote blob (base64)
             std::string certificate;                   // device cert chain (PEM) if any
+            std::string quote_signature;               // base64 signature over quote + nonce by the chain's leaf key
             std::map<std::string, std::string> claims; // extra claims (fw version, measurements)
         };
 
@@ -30,10 +36,26 @@ namespace cardano_iot
         class AttestationVerifier
         {
         public:
-            // Verify TEE/TPM quote (mock; hook for real verifier)
+            // Verify TEE/TPM quote (mock; hook for real verifier). Evidence with a certificate
+            // chain must also carry a quote signature by the chain's leaf key; the chain is checked
+            // through CertificateChainCache::shared() against trusted_roots.
             static AttestationResult verify_quote(const AttestationEvidence &evidence,
                                                   const std::string &expected_nonce,
                                                   const std::vector<std::string> &trusted_roots = {});
+
+            /**
+             * @brief Verify a fleet's quotes, checking each distinct certificate chain once
+             *
+             * Distinct chains are verified first, then the per-device nonce and quote
+             * signature checks run. Both phases run in parallel on executor when one
+             * is given.
+             * @param expected_nonces One nonce per evidence, or a single nonce for all
+             * @return One result per evidence, in input order
+             */
+            static std::vector<AttestationResult> verify_quotes_batch(const std::vector<AttestationEvidence> &evidence,
+                                                                      const std::vector<std::string> &expected_nonces,
+                                                                      const std::vector<std::string> &trusted_roots = {},
+                                                                      utils::Executor *executor = nullptr);
         };
 
     } // namespace security
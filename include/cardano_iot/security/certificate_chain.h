@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace cardano_iot
+{
+    namespace security
+    {
+        /**
+         * @brief Outcome of a certificate chain check
+         */
+        struct ChainVerification
+        {
+            bool valid = false;
+            std::string error;
+            std::string subject;    // Leaf subject, one line
+            uint64_t not_after = 0; // Earliest expiry along the chain, seconds since the epoch
+            bool cached = false;    // Answered from the chain cache
+        };
+
+        /**
+         * @brief Verifies PEM certificate chains and remembers what it verified
+         *
+         * A chain is the leaf first, each certificate followed by its issuer. Every
+         * certificate must be inside its validity window, and each must be signed
+         * by the next one, which must be a CA. The last one must be a trusted root
+         * or be issued by one. With no trusted roots configured, it must be
+         * self-signed instead.
+         *
+         * Three caches make fleet sweeps cheap, since devices share their vendor
+         * intermediates and roots:
+         * - Parsed certificates, keyed by the SHA-256 of their PEM block, so a
+         *   shared intermediate is parsed once.
+         * - Verified issuer signatures, so the intermediate-to-root link is checked
+         *   once for the whole fleet.
+         * - Whole-chain verdicts, so repeated chains cost a hash and a lookup.
+         *
+         * Entries expire with the earliest certificate expiry they depend on, or
+         * after the configured TTL, whichever comes first. Failures are kept only
+         * briefly. Thread-safe. Signature checks run outside the lock.
+         */
+        class CertificateChainCache
+        {
+        public:
+            struct Options
+            {
+                size_t max_entries = 65536;         // Per cache level; expired entries go first
+                uint32_t ttl_seconds = 3600;        // Longest a verdict is trusted
+                uint32_t failure_ttl_seconds = 60;  // Rejected chains are re-checked after this
+            };
+
+            struct Stats
+            {
+                uint64_t chain_hits = 0;
+                uint64_t chain_misses = 0;
+                uint64_t certificates_parsed = 0;
+                uint64_t signatures_checked = 0; // Issuer signatures actually verified
+                uint64_t signature_hits = 0;     // Issuer signatures answered from the cache
+            };
+
+            CertificateChainCache();
+            explicit CertificateChainCache(const Options &options);
+            ~CertificateChainCache();
+
+            CertificateChainCache(const CertificateChainCache &) = delete;
+            CertificateChainCache &operator=(const CertificateChainCache &) = delete;
+
+            /**
+             * @brief Process-wide cache shared by attestation and authentication
+             */
+            static CertificateChainCache &shared();
+
+            /**
+             * @brief Roots used when a call passes none
+             */
+            void set_trusted_roots(const std::vector<std::string> &roots_pem);
+
+            /**
+             * @brief Verify a chain
+             * @param chain_pem Concatenated PEM certificates, leaf first
+             * @param trusted_roots PEM roots; empty = the configured ones
+             */
+            ChainVerification verify(const std::string &chain_pem, const std::vector<std::string> &trusted_roots = {});
+
+            /**
+             * @brief Verify a chain, then a SHA-256 signature by its leaf key
+             * @param signature Raw signature bytes (DER for ECDSA)
+             * @param chain Where to report the chain result; may be nullptr
+             * @return true if both the chain and the signature check out
+             */
+            bool verify_signature(const std::string &chain_pem, const std::vector<std::string> &trusted_roots,
+                                  const std::string &message, const std::vector<uint8_t> &signature,
+                                  ChainVerification *chain = nullptr);
+
+            Stats stats() const;
+            void clear();
+
+        private:
+            class Impl;
+            std::unique_ptr<Impl> pimpl_;
+        };
+
+    } // namespace security
+} // namespace cardano_iot
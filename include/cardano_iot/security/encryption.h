@@ -50,6 +50,36 @@ namespace cardano_iot
             uint64_t timestamp;
         };
 
+        /**
+         * @brief One record of an in-place batch
+         *
+         * data is overwritten with ciphertext (encrypt) or plaintext (decrypt). The
+         * nonce and tag travel with the record, and ok reports each record's outcome.
+         */
+        struct AeadRecord
+        {
+            uint8_t *data = nullptr;
+            size_t size = 0;
+            uint8_t nonce[12] = {};
+            uint8_t tag[16] = {};
+            bool ok = false;
+        };
+
+        /**
+         * @brief Many records sealed into one allocation
+         *
+         * Record i occupies arena[offsets[i], offsets[i] + 12 + sizes[i] + 16) as
+         * nonce, ciphertext, tag.
+         */
+        struct EncryptedBatch
+        {
+            EncryptionAlgorithm algorithm = EncryptionAlgorithm::AES_256_GCM;
+            std::string key_id;
+            std::vector<uint8_t> arena;
+            std::vector<size_t> offsets;
+            std::vector<size_t> sizes;
+        };
+
         struct KeyDerivationParams
         {
             KeyDerivationFunction function;
@@ -86,6 +116,22 @@ namespace cardano_iot
             EncryptedData encrypt_with_password(const std::vector<uint8_t>& plaintext, const std::string& password);
             std::vector<uint8_t> decrypt_with_password(const EncryptedData& encrypted_data, const std::string& password);
 
+            /**
+             * @brief Batch encryption: one key lookup and one reused cipher context per thread for the whole batch
+             *
+             * AES-256-GCM, or ChaCha20-Poly1305 for ChaCha keys, with a fresh random nonce per record.
+             * @return Number of records processed successfully
+             */
+            size_t encrypt_batch(AeadRecord* records, size_t count, const std::string& key_id);
+            size_t decrypt_batch(AeadRecord* records, size_t count, const std::string& key_id);
+            EncryptedBatch encrypt_batch(const std::vector<std::vector<uint8_t>>& plaintexts, const std::string& key_id);
+
+            /**
+             * @brief Decrypt every record into one buffer, in order; records that fail come out zeroed
+             * @return Number of records that authenticated
+             */
+            size_t decrypt_batch(const EncryptedBatch& batch, std::vector<uint8_t>& plaintext_arena);
+
             // Stream encryption
             bool start_stream_encryption(const std::string& stream_id, const std::string& key_id);
             std::vector<uint8_t> encrypt_stream_chunk(const std::string& stream_id, const std::vector<uint8_t>& chunk);
@@ -93,6 +139,12 @@ namespace cardano_iot
             void end_stream_encryption(const std::string& stream_id);
 
             // File encryption
+            /**
+             * @brief Files are sealed in independently authenticated segments (see file_cipher.h)
+             *
+             * Memory use does not depend on file size. decrypt_file takes the key id from
+             * the file header; a non-empty key_id must match it.
+             */
             bool encrypt_file(const std::string& input_path, const std::string& output_path, const std::string& key_id);
             bool decrypt_file(const std::string& input_path, const std::string& output_path, const std::string& key_id);
             bool secure_delete_file(const std::string& file_path);
@@ -121,6 +173,8 @@ namespace cardano_iot
                 bool key_rotation_enabled = false;
                 uint32_t key_rotation_interval_hours = 24;
                 std::string default_algorithm = "AES_256_GCM";
+                uint32_t file_segment_bytes = 64 * 1024; // encrypt_file AEAD segment size
+                uint32_t file_encryption_threads = 1;    // 0 = one per hardware thread
             };
 
             void update_config(const EncryptionConfig& config);
@@ -138,6 +192,8 @@ namespace cardano_iot
                 uint64_t bytes_decrypted;
                 double avg_encryption_time_ms;
                 double avg_decryption_time_ms;
+                double p95_encryption_time_ms;
+                double p95_decryption_time_ms;
                 uint64_t stream_sessions;
                 uint64_t key_exchanges;
             };
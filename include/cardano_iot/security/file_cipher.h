@@ -0,0 +1,74 @@
+#pragma once
+
+#include "cardano_iot/security/encryption.h"
+
+#include <cstdint>
+#include <string>
+
+namespace cardano_iot
+{
+    namespace security
+    {
+        /**
+         * @brief Segmented streaming AEAD for files (the STREAM construction)
+         *
+         * The plaintext is cut into fixed-size segments, and each one is sealed
+         * with AES-256-GCM or ChaCha20-Poly1305 and carries its own 16-byte tag.
+         * A segment's nonce is a random per-file prefix, the segment counter and a
+         * last-segment flag. Segments therefore cannot be reordered, dropped or
+         * truncated without failing authentication. Each file is encrypted under
+         * an HKDF-SHA256 subkey of the stored key, salted per file, so nonces never
+         * repeat across files. The header is bound to every segment as AAD.
+         *
+         * Layout (integers little endian):
+         *   "CIOTAEAD" | version u8 | aead u8 | reserved u16 | segment_bytes u32 |
+         *   plaintext_bytes u64 | salt[16] | nonce_prefix[7] | key_id_len u16 | key_id
+         *   then per segment: ciphertext | tag[16]
+         *
+         * Data moves in batches of segments through page-aligned buffers with
+         * pread/pwrite, so memory stays at threads * 2 * batch whatever the
+         * file size. Batches are independent, and several threads can seal them.
+         */
+        class FileCipher
+        {
+        public:
+            struct Options
+            {
+                uint32_t segment_bytes = 64 * 1024;
+                uint32_t segments_per_batch = 16; // read/write unit per thread
+                uint32_t threads = 1;             // 0 = hardware concurrency
+            };
+
+            static constexpr size_t TAG_BYTES = 16;
+            static constexpr size_t SALT_BYTES = 16;
+            static constexpr size_t NONCE_PREFIX_BYTES = 7;
+            static constexpr uint32_t MAX_SEGMENT_BYTES = 16 * 1024 * 1024;
+
+            /**
+             * @brief Encrypt input_path into output_path
+             * @return false on I/O error or an unusable key; a partial output is removed
+             */
+            static bool encrypt(const std::string &input_path, const std::string &output_path, const EncryptionKey &key,
+                                const Options &options);
+
+            /**
+             * @brief Decrypt and authenticate every segment
+             * @return false if any segment fails, in which case no output is left behind
+             */
+            static bool decrypt(const std::string &input_path, const std::string &output_path, const EncryptionKey &key,
+                                const Options &options);
+
+            /**
+             * @brief Key id recorded in an encrypted file's header
+             * @return empty if the file is not in this format
+             */
+            static std::string read_key_id(const std::string &path);
+
+            /**
+             * @brief Plaintext size recorded in the header; 0 for an unreadable file
+             */
+            static uint64_t read_plaintext_size(const std::string &path);
+        };
+
+    } // namespace security
+} // namespace cardano_iot
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "cardano_iot/security/authentication.h"
+#include "cardano_iot/utils/timer_wheel.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cardano_iot
+{
+    namespace security
+    {
+        /**
+         * @brief Session map split into independently locked shards
+         *
+         * Validation only takes a shared lock on one shard. Activity and expiry
+         * times are atomics inside the entry, so lookups from many threads never
+         * serialise. A lookup writes the activity time only when the clock has
+         * moved on, so a busy session costs one store per second, not one per
+         * request. Only insertions, removals and expired-entry cleanup take a
+         * shard exclusively.
+         *
+         * Each entry can hold the handle of its expiry timer. Every call that
+         * removes an entry hands that handle back so the owner can cancel it.
+         */
+        class SessionTable
+        {
+        public:
+            enum class Lookup
+            {
+                VALID,
+                UNKNOWN,
+                EXPIRED // and removed by this call
+            };
+
+            explicit SessionTable(size_t shard_count = 16);
+
+            using TimerHandle = utils::TimerWheel::Handle;
+
+            void insert(const AuthSession &session);
+            bool set_timer(const std::string &session_id, TimerHandle timer);
+
+            /**
+             * @brief Validate a session and record activity at now
+             */
+            Lookup touch(const std::string &session_id, uint64_t now, TimerHandle *removed_timer = nullptr);
+
+            /**
+             * @brief Remove the session if it has expired by now
+             * @param expiry Set to the current expiry while the session is still valid
+             */
+            Lookup expire(const std::string &session_id, uint64_t now, uint64_t &expiry);
+
+            bool refresh(const std::string &session_id, uint64_t now, uint32_t timeout_seconds);
+            bool erase(const std::string &session_id, TimerHandle *removed_timer = nullptr);
+
+            /**
+             * @brief Remove every session of a device
+             * @return Number removed
+             */
+            size_t erase_device(const std::string &device_id, std::vector<TimerHandle> *removed_timers = nullptr);
+
+            std::vector<AuthSession> list() const;
+            size_t size() const;
+            void clear();
+
+        private:
+            struct Entry
+            {
+                explicit Entry(const AuthSession &session);
+
+                AuthSession session; // last_activity/expiry fields are kept in the atomics below
+                std::atomic<uint64_t> last_activity;
+                std::atomic<uint64_t> expiry;
+                TimerHandle timer; // shard lock held exclusively to write
+
+                AuthSession to_session() const;
+            };
+
+            struct alignas(64) Shard
+            {
+                mutable std::shared_mutex mutex;
+                std::unordered_map<std::string, std::unique_ptr<Entry>> entries;
+            };
+
+            std::vector<Shard> shards_;
+
+            Shard &shard_for(const std::string &session_id);
+        };
+
+    } // namespace security
+} // namespace cardano_iot
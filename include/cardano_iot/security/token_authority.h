@@ -0,0 +1,100 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cardano_iot
+{
+    namespace security
+    {
+        /**
+         * @brief What a signed access token asserts
+         */
+        struct AccessTokenClaims
+        {
+            std::string device_id;
+            uint64_t issued_at = 0;
+            uint64_t expires_at = 0;
+            std::array<uint8_t, 16> token_id{}; // random; names the token for revocation
+        };
+
+        /**
+         * @brief Issues and verifies stateless HMAC-SHA256 access tokens
+         *
+         * A token is "ciot1." + base64(claims) + "." + base64(tag), and the tag covers
+         * everything before the second dot. Verification is a MAC and an expiry check.
+         * The tag is compared in constant time, and no table of issued tokens is
+         * kept. Revoked token ids go in an exact set, which is fronted by a Bloom
+         * filter of atomic words. Checking a live token therefore costs a few bit
+         * reads, and only a filter hit takes the set's shared lock.
+         */
+        class TokenAuthority
+        {
+        public:
+            enum class Verdict
+            {
+                VALID,
+                MALFORMED,
+                BAD_SIGNATURE,
+                EXPIRED,
+                REVOKED
+            };
+
+            TokenAuthority();
+
+            std::string issue(const std::string &device_id, uint64_t now, uint32_t validity_seconds,
+                              AccessTokenClaims *claims = nullptr) const;
+
+            /**
+             * @brief Check a token; claims are filled in whenever the signature is good
+             */
+            Verdict verify(const std::string &token, uint64_t now, AccessTokenClaims *claims = nullptr) const;
+
+            /**
+             * @brief Revoke until the token would have expired anyway
+             * @return false if it was already revoked or has expired
+             */
+            bool revoke(const AccessTokenClaims &claims, uint64_t now);
+
+            size_t revoked_count() const;
+
+            /**
+             * @brief Drop revocations of tokens that have expired by now; the owner calls this periodically
+             *
+             * Expired tokens fail verification anyway. Bits cannot be cleared while
+             * readers probe the filter, so a rebuilt filter replaces it.
+             */
+            void purge_expired(uint64_t now);
+
+            /**
+             * @brief New signing secret and an empty revocation list; every earlier token stops verifying
+             *
+             * Must not run while other threads issue or verify.
+             */
+            void reset();
+
+        private:
+            static constexpr size_t FILTER_WORDS = 1024; // 64 Kibit
+
+            struct RevocationFilter
+            {
+                std::array<std::atomic<uint64_t>, FILTER_WORDS> words{};
+
+                void add(const std::array<uint8_t, 16> &token_id);
+                bool may_contain(const std::array<uint8_t, 16> &token_id) const;
+            };
+
+            std::array<uint8_t, 32> secret_{};
+            std::shared_ptr<RevocationFilter> filter_; // accessed with std::atomic_load/store only
+            mutable std::shared_mutex revoked_mutex_;
+            std::unordered_map<std::string, uint64_t> revoked_; // token id -> expiry
+        };
+
+    } // namespace security
+} // namespace cardano_iot
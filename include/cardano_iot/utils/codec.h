@@ -0,0 +1,95 @@
+/**
+ * @file codec.h
+ * @brief Hex and base64 codecs shared across the SDK
+ *
+ * The buffer-based functions write into caller-provided memory and pick a
+ * SIMD kernel (AVX2/SSSE3 on x86, NEON on AArch64) at runtime, falling back
+ * to scalar code elsewhere.
+ *
+ * @author Cardano IoT SDK Team
+ * @version 1.0.0
+ */
+
+#ifndef CARDANO_IOT_CODEC_H
+#define CARDANO_IOT_CODEC_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace cardano_iot::utils::codec
+{
+
+    /**
+     * @brief Returned by decoders when the input is malformed
+     */
+    constexpr size_t npos = static_cast<size_t>(-1);
+
+    /**
+     * @brief Output size of hex_encode for a given input size
+     */
+    constexpr size_t hex_encoded_size(size_t length) { return length * 2; }
+
+    /**
+     * @brief Upper bound on the output size of base64_encode
+     */
+    constexpr size_t base64_encoded_size(size_t length) { return ((length + 2) / 3) * 4; }
+
+    /**
+     * @brief Upper bound on the output size of base64_decode
+     */
+    constexpr size_t base64_decoded_max_size(size_t length) { return (length / 4) * 3 + 3; }
+
+    /**
+     * @brief Encode bytes as lowercase hex
+     * @param src Input bytes
+     * @param length Number of input bytes
+     * @param dst Output buffer of at least hex_encoded_size(length) chars
+     * @return Number of chars written
+     */
+    size_t hex_encode(const uint8_t *src, size_t length, char *dst);
+
+    /**
+     * @brief Decode hex (either case)
+     * @param src Input chars
+     * @param length Number of input chars (must be even)
+     * @param dst Output buffer of at least length / 2 bytes
+     * @return Number of bytes written, or npos on malformed input
+     */
+    size_t hex_decode(const char *src, size_t length, uint8_t *dst);
+
+    /**
+     * @brief Encode bytes as padded standard base64 without line breaks
+     * @param src Input bytes
+     * @param length Number of input bytes
+     * @param dst Output buffer of at least base64_encoded_size(length) chars
+     * @return Number of chars written
+     */
+    size_t base64_encode(const uint8_t *src, size_t length, char *dst);
+
+    /**
+     * @brief Decode standard base64; whitespace is skipped, '=' ends the input
+     * @param src Input chars
+     * @param length Number of input chars
+     * @param dst Output buffer of at least base64_decoded_max_size(length) bytes
+     * @return Number of bytes written, or npos on malformed input
+     */
+    size_t base64_decode(const char *src, size_t length, uint8_t *dst);
+
+    // Convenience wrappers; decoders return an empty vector on malformed input
+    std::string hex_encode(const std::vector<uint8_t> &data);
+    std::string hex_encode(std::string_view data);
+    std::vector<uint8_t> hex_decode(std::string_view hex);
+    std::string base64_encode(const std::vector<uint8_t> &data);
+    std::vector<uint8_t> base64_decode(std::string_view encoded);
+
+    /**
+     * @brief Name of the kernel set selected for this CPU ("avx2", "ssse3", "neon" or "scalar")
+     */
+    const char *active_implementation();
+
+} // namespace cardano_iot::utils::codec
+
+#endif // CARDANO_IOT_CODEC_H
@@ -0,0 +1,539 @@
+/**
+ * @file executor.h
+ * @brief SDK-wide work-stealing executor with futures and continuations
+ *
+ * @author Cardano IoT SDK Team
+ * @version 1.0.0
+ */
+
+#ifndef CARDANO_IOT_EXECUTOR_H
+#define CARDANO_IOT_EXECUTOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace cardano_iot::utils
+{
+
+    /**
+     * @brief Executor lane; latency-critical work is always picked before bulk work
+     */
+    enum class TaskPriority
+    {
+        CRITICAL, // Confirmations, network replies, anything a caller waits on
+        BULK      // Batch building, hashing, background maintenance
+    };
+
+    struct ExecutorOptions
+    {
+        size_t threads = 0;       // 0 = hardware_concurrency
+        bool pin_threads = false; // Pin worker i to cpus[i % cpus.size()], or to CPU i when cpus is empty
+        std::vector<int> cpus;
+        std::string name = "cardano-exec"; // Thread name prefix
+    };
+
+    class Executor;
+
+    namespace detail
+    {
+        /**
+         * @brief Run one queued task if the calling thread is an executor worker
+         *
+         * Blocking waits inside a worker call this instead of sleeping, so a worker
+         * waiting on a future keeps the pool making progress.
+         */
+        bool help_current_executor();
+
+        template <typename T>
+        using FutureValue = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+        template <typename T>
+        struct FutureState
+        {
+            std::mutex mutex;
+            std::condition_variable cv;
+            bool ready = false;
+            bool failed = false; // Task threw or its promise was dropped
+            std::optional<FutureValue<T>> value;
+            std::vector<std::function<void()>> continuations;
+
+            void complete(std::optional<FutureValue<T>> result)
+            {
+                std::vector<std::function<void()>> run;
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (ready)
+                    {
+                        return;
+                    }
+                    ready = true;
+                    failed = !result.has_value();
+                    value = std::move(result);
+                    run.swap(continuations);
+                }
+                cv.notify_all();
+                for (auto &continuation : run)
+                {
+                    continuation();
+                }
+            }
+
+            // Runs now if already complete, otherwise on completion
+            void on_complete(std::function<void()> continuation)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (!ready)
+                    {
+                        continuations.push_back(std::move(continuation));
+                        return;
+                    }
+                }
+                continuation();
+            }
+
+            void wait()
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                while (!ready)
+                {
+                    lock.unlock();
+                    const bool helped = help_current_executor();
+                    lock.lock();
+                    if (!helped && !ready)
+                    {
+                        cv.wait_for(lock, std::chrono::milliseconds(1));
+                    }
+                }
+            }
+        };
+    } // namespace detail
+
+    template <typename T>
+    class Promise;
+
+    /**
+     * @brief Result of a task run on an Executor
+     *
+     * Unlike std::future, a Future can be copied and chained: then() schedules
+     * a continuation on the executor when the value is ready, without blocking
+     * a thread on get(). A task that throws, or a Promise destroyed without a
+     * value, completes the future as failed; get() then returns T{}.
+     */
+    template <typename T>
+    class Future
+    {
+    public:
+        using value_type = T;
+
+        Future() = default;
+
+        bool valid() const { return state_ != nullptr; }
+
+        bool is_ready() const
+        {
+            std::lock_guard<std::mutex> lock(state_->mutex);
+            return state_->ready;
+        }
+
+        /**
+         * @brief True once completed without a value
+         */
+        bool failed() const
+        {
+            std::lock_guard<std::mutex> lock(state_->mutex);
+            return state_->ready && state_->failed;
+        }
+
+        void wait() const { state_->wait(); }
+
+        template <typename Rep, typename Period>
+        bool wait_for(std::chrono::duration<Rep, Period> timeout) const
+        {
+            std::unique_lock<std::mutex> lock(state_->mutex);
+            return state_->cv.wait_for(lock, timeout, [this]
+                                       { return state_->ready; });
+        }
+
+        /**
+         * @brief Wait and return the value (a copy; the future stays usable)
+         */
+        T get() const
+        {
+            state_->wait();
+            if constexpr (!std::is_void_v<T>)
+            {
+                std::lock_guard<std::mutex> lock(state_->mutex);
+                if (state_->value)
+                {
+                    return *state_->value;
+                }
+                if constexpr (std::is_default_constructible_v<T>)
+                {
+                    return T{};
+                }
+            }
+        }
+
+        /**
+         * @brief Run fn(value) on the executor once this future completes
+         * @return Future of fn's result; failed if this future failed
+         */
+        template <typename Fn>
+        auto then(Executor &executor, Fn fn, TaskPriority priority = TaskPriority::BULK) const;
+
+        /**
+         * @brief Run fn() once this future completes, on the completing thread
+         *
+         * Runs inline when already complete. Keep fn short or hand off to an
+         * executor; it delays whoever fulfils the promise.
+         */
+        void on_ready(std::function<void()> fn) const { state_->on_complete(std::move(fn)); }
+
+    private:
+        template <typename>
+        friend class Promise;
+        template <typename>
+        friend class Future;
+        friend class Executor;
+
+        explicit Future(std::shared_ptr<detail::FutureState<T>> state) : state_(std::move(state)) {}
+
+        std::shared_ptr<detail::FutureState<T>> state_;
+    };
+
+    /**
+     * @brief Write end of a Future; dropping it unfulfilled fails the future
+     */
+    template <typename T>
+    class Promise
+    {
+    public:
+        Promise() : state_(std::make_shared<detail::FutureState<T>>()) {}
+        ~Promise()
+        {
+            if (state_)
+            {
+                state_->complete(std::nullopt);
+            }
+        }
+        Promise(Promise &&other) noexcept = default;
+        Promise &operator=(Promise &&other) noexcept
+        {
+            if (this != &other)
+            {
+                if (state_)
+                {
+                    state_->complete(std::nullopt);
+                }
+                state_ = std::move(other.state_);
+            }
+            return *this;
+        }
+        Promise(const Promise &) = delete;
+        Promise &operator=(const Promise &) = delete;
+
+        Future<T> get_future() const { return Future<T>(state_); }
+
+        template <typename... Args>
+        void set_value(Args &&...args)
+        {
+            if (state_)
+            {
+                state_->complete(detail::FutureValue<T>(std::forward<Args>(args)...));
+                state_.reset();
+            }
+        }
+
+        void set_failed()
+        {
+            if (state_)
+            {
+                state_->complete(std::nullopt);
+                state_.reset();
+            }
+        }
+
+    private:
+        std::shared_ptr<detail::FutureState<T>> state_;
+    };
+
+    /**
+     * @brief Work-stealing thread pool with two priority lanes
+     *
+     * Each worker owns a deque per lane. Tasks posted from a worker go to its
+     * own deque and it pops the newest first; other workers steal the oldest.
+     * Tasks posted from outside the pool go to a shared injection queue. A
+     * worker looks for critical work everywhere (own deque, injection queue,
+     * other workers) before taking bulk work. Idle workers sleep until work is
+     * posted.
+     *
+     * Tasks must not block on I/O for long; they may wait on futures, which
+     * runs other queued tasks meanwhile.
+     */
+    class Executor
+    {
+    public:
+        struct Statistics
+        {
+            size_t threads;
+            uint64_t executed_critical;
+            uint64_t executed_bulk;
+            uint64_t stolen;
+            uint64_t queued;
+        };
+
+        explicit Executor(const ExecutorOptions &options = {});
+
+        /**
+         * @brief Runs every queued task, then stops the workers
+         */
+        ~Executor();
+
+        Executor(const Executor &) = delete;
+        Executor &operator=(const Executor &) = delete;
+
+        /**
+         * @brief Queue a task
+         * @return false after shutdown(); the task is dropped
+         */
+        bool post(std::function<void()> task, TaskPriority priority = TaskPriority::BULK);
+
+        /**
+         * @brief Queue fn() and return a Future of its result
+         */
+        template <typename Fn>
+        auto submit(Fn fn, TaskPriority priority = TaskPriority::BULK) -> Future<std::invoke_result_t<Fn>>
+        {
+            using R = std::invoke_result_t<Fn>;
+            auto promise = std::make_shared<Promise<R>>();
+            Future<R> future = promise->get_future();
+            post([promise, fn = std::move(fn)]() mutable
+                 { run_into(*promise, fn); },
+                 priority);
+            return future;
+        }
+
+        /**
+         * @brief Run fn(i) for i in [0, count) on the pool and the calling thread
+         *
+         * Blocks until every index has run. Chunks are at least min_chunk indices;
+         * counts below 2 * min_chunk run inline.
+         */
+        template <typename Fn>
+        void parallel_for(size_t count, Fn fn, size_t min_chunk = 1, TaskPriority priority = TaskPriority::BULK)
+        {
+            min_chunk = min_chunk == 0 ? 1 : min_chunk;
+            const size_t max_chunks = thread_count() + 1;
+            const size_t chunks = std::min(max_chunks, count / min_chunk);
+            if (chunks < 2)
+            {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    fn(i);
+                }
+                return;
+            }
+            const size_t size = (count + chunks - 1) / chunks;
+            auto remaining = std::make_shared<std::atomic<size_t>>(chunks - 1);
+            Promise<void> done;
+            Future<void> finished = done.get_future();
+            auto shared_done = std::make_shared<Promise<void>>(std::move(done));
+            for (size_t c = 1; c < chunks; ++c)
+            {
+                const size_t begin = c * size;
+                const size_t end = std::min(count, begin + size);
+                auto chunk = [&fn, begin, end, remaining, shared_done]
+                {
+                    for (size_t i = begin; i < end; ++i)
+                    {
+                        fn(i);
+                    }
+                    if (remaining->fetch_sub(1) == 1)
+                    {
+                        shared_done->set_value();
+                    }
+                };
+                if (!post(chunk, priority))
+                {
+                    chunk(); // Shut down: run it here
+                }
+            }
+            for (size_t i = 0; i < std::min(count, size); ++i)
+            {
+                fn(i);
+            }
+            finished.wait();
+        }
+
+        size_t thread_count() const;
+
+        /**
+         * @brief True on one of this executor's worker threads
+         */
+        bool in_worker() const;
+
+        /**
+         * @brief Stop accepting tasks and join the workers
+         * @param drain Run already-queued tasks first; otherwise drop them (their futures fail)
+         */
+        void shutdown(bool drain = true);
+
+        Statistics get_statistics() const;
+
+        /**
+         * @brief Future that is already complete
+         */
+        template <typename T>
+        static Future<std::decay_t<T>> make_ready(T &&value)
+        {
+            Promise<std::decay_t<T>> promise;
+            Future<std::decay_t<T>> future = promise.get_future(); // set_value releases the state
+            promise.set_value(std::forward<T>(value));
+            return future;
+        }
+
+        /**
+         * @brief Future of all values, in order; failed if any input failed
+         */
+        template <typename T>
+        static Future<std::vector<T>> when_all(const std::vector<Future<T>> &futures)
+        {
+            struct Gather
+            {
+                std::mutex mutex;
+                std::vector<std::optional<T>> values;
+                size_t remaining;
+                bool failed = false;
+                Promise<std::vector<T>> promise;
+            };
+            auto gather = std::make_shared<Gather>();
+            gather->values.resize(futures.size());
+            gather->remaining = futures.size();
+            Future<std::vector<T>> result = gather->promise.get_future();
+            if (futures.empty())
+            {
+                gather->promise.set_value();
+                return result;
+            }
+            for (size_t i = 0; i < futures.size(); ++i)
+            {
+                auto state = futures[i].state_;
+                state->on_complete([gather, state, i]
+                                   {
+                                       std::lock_guard<std::mutex> lock(gather->mutex);
+                                       {
+                                           std::lock_guard<std::mutex> value_lock(state->mutex);
+                                           if (state->value)
+                                           {
+                                               gather->values[i] = *state->value;
+                                           }
+                                           else
+                                           {
+                                               gather->failed = true;
+                                           }
+                                       }
+                                       if (--gather->remaining == 0)
+                                       {
+                                           if (gather->failed)
+                                           {
+                                               gather->promise.set_failed();
+                                               return;
+                                           }
+                                           std::vector<T> values;
+                                           values.reserve(gather->values.size());
+                                           for (auto &value : gather->values)
+                                           {
+                                               values.push_back(std::move(*value));
+                                           }
+                                           gather->promise.set_value(std::move(values));
+                                       } });
+            }
+            return result;
+        }
+
+    private:
+        friend bool detail::help_current_executor();
+
+        template <typename R, typename Fn, typename... Args>
+        static void run_into(Promise<R> &promise, Fn &fn, Args &&...args)
+        {
+            try
+            {
+                if constexpr (std::is_void_v<R>)
+                {
+                    fn(std::forward<Args>(args)...);
+                    promise.set_value();
+                }
+                else
+                {
+                    promise.set_value(fn(std::forward<Args>(args)...));
+                }
+            }
+            catch (...)
+            {
+                promise.set_failed(); // Keep the worker alive; the caller sees failed()
+            }
+        }
+
+        template <typename>
+        friend class Future;
+
+        class Impl;
+        std::unique_ptr<Impl> pimpl_;
+    };
+
+    template <typename T>
+    template <typename Fn>
+    auto Future<T>::then(Executor &executor, Fn fn, TaskPriority priority) const
+    {
+        using R = std::conditional_t<std::is_void_v<T>, std::invoke_result<Fn>, std::invoke_result<Fn, T>>;
+        using Result = typename R::type;
+        auto promise = std::make_shared<Promise<Result>>();
+        Future<Result> next = promise->get_future();
+        auto state = state_;
+        state->on_complete([&executor, state, promise, fn = std::move(fn), priority]() mutable
+                           {
+                               auto task = [state, promise, fn = std::move(fn)]() mutable
+                               {
+                                   std::optional<detail::FutureValue<T>> value;
+                                   {
+                                       std::lock_guard<std::mutex> lock(state->mutex);
+                                       value = state->value;
+                                   }
+                                   if (!value)
+                                   {
+                                       promise->set_failed();
+                                   }
+                                   else if constexpr (std::is_void_v<T>)
+                                   {
+                                       Executor::run_into(*promise, fn);
+                                   }
+                                   else
+                                   {
+                                       Executor::run_into(*promise, fn, std::move(*value));
+                                   }
+                               };
+                               if (!executor.post(std::move(task), priority))
+                               {
+                                   promise->set_failed();
+                               } });
+        return next;
+    }
+
+} // namespace cardano_iot::utils
+
+#endif // CARDANO_IOT_EXECUTOR_H
@@ -0,0 +1,189 @@
+/**
+ * @file flat_map.h
+ * @brief Sorted-vector map for small key/value sets such as reading metadata
+ *
+ * @author Cardano IoT SDK Team
+ * @version 1.0.0
+ */
+
+#ifndef CARDANO_IOT_FLAT_MAP_H
+#define CARDANO_IOT_FLAT_MAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <map>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace cardano_iot::utils
+{
+
+    /**
+     * @brief std::map replacement that keeps its entries in one sorted vector
+     *
+     * A map with n entries costs one allocation instead of n tree nodes, and
+     * moving it only moves the vector. Lookups are binary searches; inserts and
+     * erases shift the tail, which is cheap for the handful of entries metadata
+     * holds. Iteration is in key order, as with std::map. Iterators and
+     * references are invalidated by any insert or erase.
+     */
+    template <typename Key, typename Value, typename Compare = std::less<>>
+    class FlatMap
+    {
+    public:
+        using key_type = Key;
+        using mapped_type = Value;
+        using value_type = std::pair<Key, Value>;
+        using size_type = std::size_t;
+        using iterator = typename std::vector<value_type>::iterator;
+        using const_iterator = typename std::vector<value_type>::const_iterator;
+
+        FlatMap() = default;
+
+        FlatMap(std::initializer_list<value_type> entries)
+        {
+            entries_.reserve(entries.size());
+            for (const auto &entry : entries)
+            {
+                try_emplace(entry.first, entry.second);
+            }
+        }
+
+        /**
+         * @brief Convert from std::map; its entries are already sorted
+         */
+        template <typename C, typename A>
+        FlatMap(const std::map<Key, Value, C, A> &other) : entries_(other.begin(), other.end()) {}
+
+        template <typename C, typename A>
+        operator std::map<Key, Value, C, A>() const
+        {
+            return std::map<Key, Value, C, A>(entries_.begin(), entries_.end());
+        }
+
+        iterator begin() { return entries_.begin(); }
+        iterator end() { return entries_.end(); }
+        const_iterator begin() const { return entries_.begin(); }
+        const_iterator end() const { return entries_.end(); }
+        const_iterator cbegin() const { return entries_.cbegin(); }
+        const_iterator cend() const { return entries_.cend(); }
+
+        size_type size() const { return entries_.size(); }
+        bool empty() const { return entries_.empty(); }
+        size_type capacity() const { return entries_.capacity(); }
+        void reserve(size_type count) { entries_.reserve(count); }
+        void clear() { entries_.clear(); }
+
+        template <typename K>
+        iterator lower_bound(const K &key)
+        {
+            return std::lower_bound(entries_.begin(), entries_.end(), key, KeyLess{});
+        }
+
+        template <typename K>
+        const_iterator lower_bound(const K &key) const
+        {
+            return std::lower_bound(entries_.begin(), entries_.end(), key, KeyLess{});
+        }
+
+        template <typename K>
+        iterator find(const K &key)
+        {
+            auto it = lower_bound(key);
+            return it != entries_.end() && !Compare{}(key, it->first) ? it : entries_.end();
+        }
+
+        template <typename K>
+        const_iterator find(const K &key) const
+        {
+            auto it = lower_bound(key);
+            return it != entries_.end() && !Compare{}(key, it->first) ? it : entries_.end();
+        }
+
+        template <typename K>
+        size_type count(const K &key) const { return find(key) != end() ? 1 : 0; }
+
+        template <typename K>
+        bool contains(const K &key) const { return find(key) != end(); }
+
+        /**
+         * @brief Value for key, default-inserted when missing
+         */
+        template <typename K>
+        Value &operator[](K &&key) { return try_emplace(std::forward<K>(key)).first->second; }
+
+        template <typename K, typename... Args>
+        std::pair<iterator, bool> try_emplace(K &&key, Args &&...args)
+        {
+            auto it = lower_bound(key);
+            if (it != entries_.end() && !Compare{}(key, it->first))
+            {
+                return {it, false};
+            }
+            it = entries_.emplace(it, std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)),
+                                  std::forward_as_tuple(std::forward<Args>(args)...));
+            return {it, true};
+        }
+
+        template <typename K, typename V>
+        std::pair<iterator, bool> emplace(K &&key, V &&value)
+        {
+            return try_emplace(std::forward<K>(key), std::forward<V>(value));
+        }
+
+        std::pair<iterator, bool> insert(value_type entry)
+        {
+            return try_emplace(std::move(entry.first), std::move(entry.second));
+        }
+
+        template <typename K, typename V>
+        std::pair<iterator, bool> insert_or_assign(K &&key, V &&value)
+        {
+            auto result = try_emplace(std::forward<K>(key), std::forward<V>(value));
+            if (!result.second)
+            {
+                result.first->second = std::forward<V>(value);
+            }
+            return result;
+        }
+
+        iterator erase(iterator position) { return entries_.erase(position); }
+        iterator erase(const_iterator position) { return entries_.erase(position); }
+
+        template <typename K>
+        size_type erase(const K &key)
+        {
+            auto it = find(key);
+            if (it == entries_.end())
+            {
+                return 0;
+            }
+            entries_.erase(it);
+            return 1;
+        }
+
+        bool operator==(const FlatMap &other) const { return entries_ == other.entries_; }
+        bool operator!=(const FlatMap &other) const { return entries_ != other.entries_; }
+
+    private:
+        struct KeyLess
+        {
+            template <typename K>
+            bool operator()(const value_type &entry, const K &key) const { return Compare{}(entry.first, key); }
+        };
+
+        std::vector<value_type> entries_;
+    };
+
+    /**
+     * @brief Metadata attached to readings and stored alongside them
+     */
+    using MetadataMap = FlatMap<std::string, std::string>;
+
+} // namespace cardano_iot::utils
+
+#endif // CARDANO_IOT_FLAT_MAP_H
@@ -0,0 +1,157 @@
+/**
+ * @file hash.h
+ * @brief Incremental, tree and multi-buffer hashing shared across the SDK
+ *
+ * Hasher is an init/update/final wrapper over OpenSSL digests. The tree hash
+ * cuts its input into fixed chunks, hashes them independently and combines
+ * them in a binary tree, so large inputs spread across cores. hash_many
+ * hashes a batch of small inputs with one reused context per thread.
+ *
+ * @author Cardano IoT SDK Team
+ * @version 1.0.0
+ */
+
+#ifndef CARDANO_IOT_HASH_H
+#define CARDANO_IOT_HASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace cardano_iot::utils
+{
+
+    enum class HashAlgorithm
+    {
+        SHA256,
+        SHA512,
+        BLAKE2B_512,
+        BLAKE2S_256,
+        SHA3_256,
+        BLAKE2B_256 // Ledger hash; OpenSSL's BLAKE2b-512 with a 32-byte output, or a built-in one before 3.2
+    };
+
+    /**
+     * @brief Digest size in bytes
+     */
+    size_t digest_size(HashAlgorithm algorithm);
+
+    /**
+     * @brief Parse "SHA256", "sha512", "BLAKE2b", ... ; false for an unknown name
+     */
+    bool parse_hash_algorithm(const std::string &name, HashAlgorithm &algorithm);
+
+    /**
+     * @brief CRC-32 (IEEE 802.3), for framing checks rather than integrity against tampering
+     * @param seed crc32() of the preceding bytes, to checksum data in pieces
+     */
+    uint32_t crc32(const void *data, size_t size, uint32_t seed = 0);
+
+    /**
+     * @brief Streaming digest: update() any number of times, then final()
+     *
+     * final() resets the hasher, so it can be reused for the next message.
+     */
+    class Hasher
+    {
+    public:
+        explicit Hasher(HashAlgorithm algorithm = HashAlgorithm::SHA256);
+        ~Hasher();
+
+        Hasher(Hasher &&other) noexcept;
+        Hasher &operator=(Hasher &&other) noexcept;
+        Hasher(const Hasher &) = delete;
+        Hasher &operator=(const Hasher &) = delete;
+
+        bool update(const void *data, size_t size);
+
+        /**
+         * @brief Write digest_size() bytes to out
+         * @return false if OpenSSL failed; the hasher is reset either way
+         */
+        bool final(uint8_t *out);
+        std::vector<uint8_t> final();
+        void reset();
+
+        HashAlgorithm algorithm() const { return algorithm_; }
+        size_t digest_size() const { return utils::digest_size(algorithm_); }
+
+        /**
+         * @brief One-shot digest; empty on failure
+         */
+        static std::vector<uint8_t> digest(HashAlgorithm algorithm, const void *data, size_t size);
+
+    private:
+        HashAlgorithm algorithm_;
+        void *context_; // EVP_MD_CTX, or the built-in BLAKE2b state
+        bool started_ = false;
+
+        bool start();
+    };
+
+    struct ByteRange
+    {
+        const uint8_t *data;
+        size_t size;
+    };
+
+    /**
+     * @brief Hash count independent inputs; out receives count * digest_size(algorithm) bytes
+     *
+     * Each thread reuses one digest context, so there is no allocation per
+     * input. threads = 0 uses hardware concurrency; small batches stay on the
+     * calling thread.
+     */
+    bool hash_many(HashAlgorithm algorithm, const ByteRange *inputs, size_t count, uint8_t *out,
+                   unsigned threads = 1);
+
+    struct TreeHashOptions
+    {
+        size_t chunk_bytes = 1024 * 1024;
+        unsigned threads = 0; // 0 = hardware concurrency
+    };
+
+    constexpr size_t TREE_HASH_BYTES = 32;
+
+    /**
+     * @brief SHA-256 tree hash over fixed-size chunks
+     *
+     * leaf = SHA-256(0x00 | chunk) and parent = SHA-256(0x01 | left | right).
+     * With n > 1 chunks the left subtree holds the largest power of two below n,
+     * as in BLAKE3. The result depends only on the data and chunk_bytes, never
+     * on the thread count or how the data was fed in. It is not plain SHA-256 of
+     * the data.
+     */
+    class TreeHasher
+    {
+    public:
+        explicit TreeHasher(size_t chunk_bytes = TreeHashOptions().chunk_bytes);
+
+        void update(const void *data, size_t size);
+        std::vector<uint8_t> final();
+
+    private:
+        size_t chunk_bytes_;
+        Hasher chunk_;
+        size_t chunk_fill_ = 0;
+        uint64_t chunks_ = 0;
+        std::vector<std::vector<uint8_t>> stack_; // roots of complete subtrees, largest first
+
+        void push_chunk(std::vector<uint8_t> hash);
+    };
+
+    /**
+     * @brief Tree hash of a buffer, chunks hashed in parallel
+     */
+    std::vector<uint8_t> tree_hash(const void *data, size_t size, const TreeHashOptions &options = {});
+
+    /**
+     * @brief Tree hash of a file, memory-mapped when possible
+     * @return empty if the file cannot be read
+     */
+    std::vector<uint8_t> tree_hash_file(const std::string &path, const TreeHashOptions &options = {});
+
+} // namespace cardano_iot::utils
+
+#endif // CARDANO_IOT_HASH_H
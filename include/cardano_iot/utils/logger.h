@@ -11,6 +11,10 @@
 
 #include <string>
 #include <memory>
+#include <atomic>
+#include <sstream>
+#include <cstdint>
+#include <cstddef>
 
 namespace cardano_iot::utils
 {
@@ -25,6 +29,15 @@ namespace cardano_iot::utils
         FATAL = 5
     };
 
+    /**
+     * @brief What an async producer does when the log queue is full
+     */
+    enum class LogOverflowPolicy
+    {
+        DROP,  // discard the record and count it
+        BLOCK  // wait for the writer thread to free a slot
+    };
+
     class Logger
     {
     public:
@@ -35,16 +48,74 @@ namespace cardano_iot::utils
         void enable_console(bool enable);
         void set_file_path(const std::string &path);
 
+        /**
+         * @brief Cheap check used to skip building messages for disabled levels
+         */
+        bool is_enabled(LogLevel level) const
+        {
+            return level >= level_.load(std::memory_order_relaxed);
+        }
+
         // Log rotation settings
         void set_max_file_size_bytes(size_t bytes);
         void set_max_backup_files(size_t count);
 
+        /**
+         * @brief Switch between synchronous writes and a background writer thread
+         *
+         * In async mode log() only pushes the record into a lock-free ring buffer;
+         * a writer thread formats and writes records in batches. Disabling async
+         * mode drains the queue first.
+         *
+         * @param enable Enable async mode
+         * @param queue_capacity Ring buffer slots (rounded up to a power of two)
+         * @param policy Behaviour when the ring buffer is full
+         * @param flush_interval_ms Maximum time a record waits before being written
+         */
+        void enable_async(bool enable, size_t queue_capacity = 8192,
+                          LogOverflowPolicy policy = LogOverflowPolicy::DROP,
+                          uint32_t flush_interval_ms = 50);
+
+        /**
+         * @brief Change the async writer's flush interval without restarting it
+         */
+        void set_flush_interval(uint32_t flush_interval_ms);
+        uint32_t flush_interval_ms() const;
+
+        /**
+         * @brief Block until every record queued so far has been written
+         */
+        void flush();
+
+        /**
+         * @brief Number of records discarded because the async queue was full
+         */
+        uint64_t dropped_count() const;
+
     private:
         Logger() = default;
+        std::atomic<LogLevel> level_{LogLevel::INFO};
         class Impl;
         std::unique_ptr<Impl> pimpl_;
     };
 
 } // namespace cardano_iot::utils
 
+/**
+ * @brief Log a stream expression, evaluating it only when the level is enabled
+ *
+ * Example: CARDANO_IOT_LOG(LogLevel::DEBUG, "Module", "value=" << value);
+ */
+#define CARDANO_IOT_LOG(level, module, stream_expr)                              \
+    do                                                                           \
+    {                                                                            \
+        auto &cardano_iot_logger_ = ::cardano_iot::utils::Logger::instance();    \
+        if (cardano_iot_logger_.is_enabled(level))                               \
+        {                                                                        \
+            std::ostringstream cardano_iot_log_stream_;                          \
+            cardano_iot_log_stream_ << stream_expr;                              \
+            cardano_iot_logger_.log(level, module, cardano_iot_log_stream_.str()); \
+        }                                                                        \
+    } while (0)
+
 #endif // CARDANO_IOT_LOGGER_H
@@ -0,0 +1,243 @@
+/**
+ * @file metrics.h
+ * @brief Process-wide metrics registry with Prometheus text exposition
+ *
+ * @author Cardano IoT SDK Team
+ * @version 1.0.0
+ */
+
+#ifndef CARDANO_IOT_METRICS_H
+#define CARDANO_IOT_METRICS_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace cardano_iot::utils::metrics
+{
+
+    using Labels = std::map<std::string, std::string>;
+
+    constexpr size_t STRIPES = 16; // Per-core cells; a thread always updates the same one
+
+    /**
+     * @brief Stripe index of the calling thread
+     */
+    size_t this_thread_stripe();
+
+    class Metric
+    {
+    public:
+        enum class Type
+        {
+            COUNTER,
+            GAUGE,
+            HISTOGRAM
+        };
+
+        Metric(const Metric &) = delete;
+        Metric &operator=(const Metric &) = delete;
+        virtual ~Metric();
+
+        const std::string &name() const { return name_; }
+        const std::string &help() const { return help_; }
+        const Labels &labels() const { return labels_; }
+        Type type() const { return type_; }
+
+    protected:
+        Metric(Type type, std::string name, std::string help, Labels labels);
+
+        // Called at the end of the derived constructor and start of its destructor,
+        // so the registry only ever sees fully built metrics
+        void enroll();
+        void withdraw();
+
+    private:
+        Type type_;
+        std::string name_;
+        std::string help_;
+        Labels labels_;
+    };
+
+    /**
+     * @brief Monotonic counter; inc() is one relaxed add on the caller's stripe
+     */
+    class Counter : public Metric
+    {
+    public:
+        Counter(std::string name, std::string help, Labels labels = {});
+        ~Counter() override;
+
+        void inc(uint64_t amount = 1)
+        {
+            cells_[this_thread_stripe()].value.fetch_add(amount, std::memory_order_relaxed);
+        }
+
+        uint64_t value() const;
+        void reset();
+
+    private:
+        struct alignas(64) Cell
+        {
+            std::atomic<uint64_t> value{0};
+        };
+        std::array<Cell, STRIPES> cells_;
+    };
+
+    /**
+     * @brief One counter per value of a label, addressed by index (typically an enum)
+     */
+    class CounterSet
+    {
+    public:
+        CounterSet(const std::string &name, const std::string &help, const std::string &label,
+                   const std::vector<std::string> &values, const Labels &labels = {});
+
+        Counter &operator[](size_t index) { return *counters_[index]; }
+        const Counter &operator[](size_t index) const { return *counters_[index]; }
+        size_t size() const { return counters_.size(); }
+        void reset();
+
+    private:
+        std::vector<std::unique_ptr<Counter>> counters_;
+    };
+
+    /**
+     * @brief Value that goes up and down
+     */
+    class Gauge : public Metric
+    {
+    public:
+        Gauge(std::string name, std::string help, Labels labels = {});
+        ~Gauge() override;
+
+        void set(int64_t value) { value_.store(value, std::memory_order_relaxed); }
+        void add(int64_t amount) { value_.fetch_add(amount, std::memory_order_relaxed); }
+
+        /**
+         * @brief Subtract, stopping at zero
+         */
+        void decrement_to_zero(int64_t amount = 1);
+
+        int64_t value() const { return value_.load(std::memory_order_relaxed); }
+
+    private:
+        std::atomic<int64_t> value_{0};
+    };
+
+    /**
+     * @brief Fixed-bucket histogram with per-core bucket counts
+     *
+     * observe() finds the bucket by binary search, then updates the caller's
+     * stripe: a relaxed add to the bucket count and a CAS on the sum. quantile()
+     * interpolates linearly inside the bucket that holds the rank, so its
+     * error is bounded by the bucket width.
+     */
+    class Histogram : public Metric
+    {
+    public:
+        /**
+         * @param bounds Ascending upper bucket bounds; an implicit +Inf bucket follows
+         */
+        Histogram(std::string name, std::string help, std::vector<double> bounds, Labels labels = {});
+        ~Histogram() override;
+
+        void observe(double value);
+
+        struct Snapshot
+        {
+            std::vector<double> bounds;
+            std::vector<uint64_t> counts; // Per bucket, not cumulative; one more than bounds
+            uint64_t count = 0;
+            double sum = 0.0;
+
+            double mean() const { return count > 0 ? sum / static_cast<double>(count) : 0.0; }
+            double quantile(double q) const;
+            void merge(const Snapshot &other);
+
+            /**
+             * @brief Observations made after earlier was taken (same layout required)
+             */
+            Snapshot since(const Snapshot &earlier) const;
+        };
+
+        Snapshot snapshot() const;
+        uint64_t count() const;
+        double mean() const { return snapshot().mean(); }
+        double quantile(double q) const { return snapshot().quantile(q); }
+        void reset();
+
+        /**
+         * @brief count bounds from start, each factor times the previous
+         */
+        static std::vector<double> exponential_bounds(double start, double factor, size_t count);
+
+        /**
+         * @brief Bounds for latencies in milliseconds, 1 us to about 65 s
+         */
+        static const std::vector<double> &latency_ms_bounds();
+
+    private:
+        struct alignas(64) Stripe
+        {
+            std::unique_ptr<std::atomic<uint64_t>[]> counts;
+            std::atomic<double> sum{0.0};
+        };
+        std::vector<double> bounds_;
+        std::array<Stripe, STRIPES> stripes_;
+    };
+
+    /**
+     * @brief Every live metric in the process
+     *
+     * Metrics register themselves on construction and leave on destruction.
+     * Subsystems own their metrics, so each instance reports its own numbers,
+     * and the exposition sums metrics that share a name and labels across
+     * instances.
+     */
+    class Registry
+    {
+    public:
+        static Registry &instance();
+
+        /**
+         * @brief Prometheus text exposition format (version 0.0.4)
+         */
+        std::string to_prometheus() const;
+
+        /**
+         * @brief Aggregated value of a counter or gauge, or the count of a histogram; 0 if absent
+         */
+        double value(const std::string &name, const Labels &labels = {}) const;
+
+        /**
+         * @brief Sum of a counter or gauge over every label set; 0 if absent
+         */
+        double total(const std::string &name) const;
+
+        /**
+         * @brief Histogram merged over every label set; empty if absent
+         */
+        Histogram::Snapshot histogram(const std::string &name) const;
+
+        size_t size() const;
+
+    private:
+        friend class Metric;
+        Registry();
+        ~Registry();
+        void add(const Metric *metric);
+        void remove(const Metric *metric);
+
+        class Impl;
+        std::unique_ptr<Impl> pimpl_;
+    };
+
+} // namespace cardano_iot::utils::metrics
+
+#endif // CARDANO_IOT_METRICS_H
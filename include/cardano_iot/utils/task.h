@@ -0,0 +1,188 @@
+/**
+ * @file task.h
+ * @brief C++20 coroutine support on top of the executor futures
+ *
+ * Everything here is compiled only when the including translation unit has
+ * coroutines (C++20); CARDANO_IOT_HAS_COROUTINES is defined in that case.
+ * C++17 code uses the Future / callback API from executor.h directly.
+ *
+ * @author Cardano IoT SDK Team
+ * @version 1.0.0
+ */
+
+#ifndef CARDANO_IOT_TASK_H
+#define CARDANO_IOT_TASK_H
+
+#include "executor.h"
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#include <coroutine>
+
+#define CARDANO_IOT_HAS_COROUTINES 1
+
+namespace cardano_iot::utils
+{
+
+    /**
+     * @brief Awaiter for a Future; resumes on the executor when one is given
+     *
+     * Without an executor the coroutine resumes on the thread that completes the
+     * future (e.g. the SDK ingestion worker), so pass one for anything heavier
+     * than a hand-off. A failed future yields T{} like Future::get().
+     */
+    template <typename T>
+    class FutureAwaiter
+    {
+    public:
+        FutureAwaiter(Future<T> future, Executor *executor) : future_(std::move(future)), executor_(executor) {}
+
+        // With an executor we always hop, so the code after co_await runs on a worker
+        bool await_ready() const { return !future_.valid() || (!executor_ && future_.is_ready()); }
+
+        void await_suspend(std::coroutine_handle<> handle)
+        {
+            // The continuation may resume and destroy this frame before on_ready returns
+            Future<T> future = future_;
+            Executor *executor = executor_;
+            future.on_ready([handle, executor]
+                            {
+                                if (!executor || !executor->post([handle]
+                                                                 { handle.resume(); },
+                                                                 TaskPriority::CRITICAL))
+                                {
+                                    handle.resume();
+                                } });
+        }
+
+        T await_resume() const
+        {
+            if constexpr (std::is_void_v<T>)
+            {
+                return;
+            }
+            else
+            {
+                return future_.valid() ? future_.get() : T{};
+            }
+        }
+
+    private:
+        Future<T> future_;
+        Executor *executor_;
+    };
+
+    /**
+     * @brief co_await future: resume wherever the future completes
+     */
+    template <typename T>
+    FutureAwaiter<T> operator co_await(Future<T> future)
+    {
+        return FutureAwaiter<T>(std::move(future), nullptr);
+    }
+
+    /**
+     * @brief co_await resume_on(executor, future): resume on an executor worker
+     */
+    template <typename T>
+    FutureAwaiter<T> resume_on(Executor &executor, Future<T> future)
+    {
+        return FutureAwaiter<T>(std::move(future), &executor);
+    }
+
+    template <typename T>
+    FutureAwaiter<T> resume_on(const std::shared_ptr<Executor> &executor, Future<T> future)
+    {
+        return FutureAwaiter<T>(std::move(future), executor.get());
+    }
+
+    /**
+     * @brief co_await schedule_on(executor): continue the coroutine on a worker
+     */
+    inline auto schedule_on(Executor &executor, TaskPriority priority = TaskPriority::CRITICAL)
+    {
+        struct Awaiter
+        {
+            Executor &executor;
+            TaskPriority priority;
+
+            bool await_ready() const noexcept { return false; }
+            bool await_suspend(std::coroutine_handle<> handle)
+            {
+                // A stopped executor cannot take us: keep running here
+                return executor.post([handle]
+                                     { handle.resume(); },
+                                     priority);
+            }
+            void await_resume() const noexcept {}
+        };
+        return Awaiter{executor, priority};
+    }
+
+    template <typename T>
+    class Task;
+
+    namespace detail
+    {
+        template <typename T>
+        struct TaskPromiseBase
+        {
+            Promise<T> result;
+
+            std::suspend_never initial_suspend() noexcept { return {}; }
+            std::suspend_never final_suspend() noexcept { return {}; }
+            void unhandled_exception() { result.set_failed(); }
+        };
+
+        template <typename T>
+        struct TaskPromise : TaskPromiseBase<T>
+        {
+            template <typename U = T>
+            void return_value(U &&value) { this->result.set_value(std::forward<U>(value)); }
+        };
+
+        template <>
+        struct TaskPromise<void> : TaskPromiseBase<void>
+        {
+            void return_void() { this->result.set_value(); }
+        };
+    } // namespace detail
+
+    /**
+     * @brief Eager coroutine returning T
+     *
+     * The body starts running on the caller's thread and continues wherever its
+     * awaits resume it; the frame frees itself when the body finishes. A Task is
+     * a handle on the result: await it, get() it, or convert it to a Future for
+     * then() / when_all(). An escaping exception fails the result.
+     */
+    template <typename T>
+    class Task
+    {
+    public:
+        struct promise_type : detail::TaskPromise<T>
+        {
+            Task get_return_object() { return Task(this->result.get_future()); }
+        };
+
+        Task() = default;
+
+        bool valid() const { return future_.valid(); }
+        bool is_ready() const { return future_.is_ready(); }
+        bool failed() const { return future_.failed(); }
+        T get() const { return future_.get(); }
+        const Future<T> &future() const { return future_; }
+
+        FutureAwaiter<T> operator co_await() const { return FutureAwaiter<T>(future_, nullptr); }
+
+    private:
+        explicit Task(Future<T> future) : future_(std::move(future)) {}
+
+        Future<T> future_;
+    };
+
+} // namespace cardano_iot::utils
+
+#endif // __cpp_impl_coroutine
+
+#endif // CARDANO_IOT_TASK_H
@@ -0,0 +1,167 @@
+/**
+ * @file timer_wheel.h
+ * @brief Hierarchical timer wheel shared by the SDK's expiring tables
+ *
+ * @author Cardano IoT SDK Team
+ * @version 1.0.0
+ */
+
+#ifndef CARDANO_IOT_TIMER_WHEEL_H
+#define CARDANO_IOT_TIMER_WHEEL_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cardano_iot::utils
+{
+
+    /**
+     * @brief Four levels of 64 slots; schedule and cancel are O(1)
+     *
+     * Timers live in a slab and are linked into the slot of their deadline.
+     * Level 0 holds timers due within 64 ticks. Each higher level covers 64
+     * times the span of the one below, and its slots cascade down as the wheel
+     * turns. Deadlines beyond the top level wait in its furthest slot and are
+     * placed again when they cascade. Memory is one slab node per pending
+     * timer, and freed nodes are reused.
+     *
+     * Callbacks run one at a time on the thread that advances the wheel. They
+     * must not block for long, and they may schedule or cancel timers.
+     */
+    class TimerWheel
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+        using Callback = std::function<void()>;
+
+        struct Handle
+        {
+            uint32_t index = UINT32_MAX;
+            uint32_t generation = 0;
+
+            bool valid() const { return index != UINT32_MAX; }
+        };
+
+        /**
+         * @brief Timers owned by one subsystem, cancelled together
+         *
+         * Destroying a scope cancels its pending timers and waits for any of its
+         * callbacks still running, unless it is destroyed from inside a callback.
+         * Make it the last member of its owner so it goes first. Never destroy it
+         * while holding a lock that its callbacks take.
+         */
+        class Scope
+        {
+        public:
+            explicit Scope(std::shared_ptr<TimerWheel> wheel = TimerWheel::shared());
+            ~Scope();
+
+            Scope(const Scope &) = delete;
+            Scope &operator=(const Scope &) = delete;
+
+            Handle schedule_after(std::chrono::milliseconds delay, Callback callback);
+            bool cancel(Handle handle) { return wheel_->cancel(handle); }
+            void cancel_all() { wheel_->cancel_scope(id_); }
+            TimerWheel &wheel() { return *wheel_; }
+
+        private:
+            std::shared_ptr<TimerWheel> wheel_;
+            uint32_t id_;
+        };
+
+        /**
+         * @param tick Resolution; deadlines are rounded up to whole ticks
+         * @param run_thread Start a thread that advances the wheel in real time.
+         *        Without it the owner calls advance(), and delays count from the last advance
+         */
+        explicit TimerWheel(std::chrono::milliseconds tick = std::chrono::milliseconds(100), bool run_thread = true);
+        ~TimerWheel();
+
+        TimerWheel(const TimerWheel &) = delete;
+        TimerWheel &operator=(const TimerWheel &) = delete;
+
+        /**
+         * @brief Process-wide wheel with its own thread, created on first use
+         */
+        static std::shared_ptr<TimerWheel> shared();
+
+        Handle schedule_after(std::chrono::milliseconds delay, Callback callback, uint32_t scope = 0);
+
+        /**
+         * @brief Cancel a pending timer
+         * @return false if it already fired or was cancelled
+         */
+        bool cancel(Handle handle);
+
+        /**
+         * @brief Cancel every timer of a scope and wait out its running callback
+         */
+        void cancel_scope(uint32_t scope);
+
+        /**
+         * @brief Turn the wheel up to now and run what fell due
+         * @return Number of callbacks run
+         */
+        size_t advance(Clock::time_point now);
+
+        size_t pending() const;
+        Clock::time_point origin() const { return origin_; }
+        std::chrono::milliseconds tick() const { return tick_; }
+
+    private:
+        static constexpr uint32_t LEVELS = 4;
+        static constexpr uint32_t SLOT_BITS = 6;
+        static constexpr uint32_t SLOTS = 1u << SLOT_BITS;
+        static constexpr uint32_t DUE_LIST = LEVELS * SLOTS;
+        static constexpr uint32_t NONE = UINT32_MAX;
+
+        struct Node
+        {
+            Callback callback;
+            uint64_t deadline = 0;
+            uint32_t prev = NONE;
+            uint32_t next = NONE;
+            uint32_t list = NONE; // slot or DUE_LIST while pending, NONE when free
+            uint32_t generation = 0;
+            uint32_t scope = 0;
+        };
+
+        const std::chrono::milliseconds tick_;
+        const Clock::time_point origin_;
+
+        mutable std::mutex mutex_;
+        std::vector<Node> nodes_;
+        std::array<uint32_t, DUE_LIST + 1> heads_;
+        uint32_t free_ = NONE;
+        uint64_t now_tick_ = 0;
+        size_t pending_ = 0;
+        std::atomic<uint32_t> next_scope_{1};
+
+        // Held while callbacks run, so cancel_scope can wait for them
+        std::mutex fire_mutex_;
+        std::atomic<std::thread::id> firing_thread_{};
+
+        std::mutex thread_mutex_;
+        std::condition_variable thread_cv_;
+        bool stop_ = false;
+        std::thread thread_;
+
+        void link(uint32_t index, uint32_t list);
+        void unlink(uint32_t index);
+        void release(uint32_t index);
+        void place(uint32_t index);
+        void step();
+        void run();
+    };
+
+} // namespace cardano_iot::utils
+
+#endif // CARDANO_IOT_TIMER_WHEEL_H
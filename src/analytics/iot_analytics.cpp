@@ -0,0 +1,2185 @@
+/**
+ * @file iot_analytics.cpp
+ * @brief Implementation of the streaming IoT analytics engine
+ *
+ * @author Cardano IoT SDK Team
+ * @version 1.0.0
+ */
+
+#include "cardano_iot/analytics/iot_analytics.h"
+#include "cardano_iot/cardano_iot.h"
+#include "cardano_iot/utils/logger.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <set>
+#include <shared_mutex>
+#include <sstream>
+#include <unordered_map>
+
+namespace cardano_iot::analytics
+{
+
+    namespace
+    {
+        using Clock = std::chrono::steady_clock;
+        using json = nlohmann::json;
+
+        constexpr size_t SHARD_COUNT = 16;
+        constexpr std::array<double, 4> QUANTILES = {0.25, 0.5, 0.75, 0.95};
+        constexpr char KEY_SEPARATOR = '\x1f';
+
+        uint64_t now_seconds()
+        {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::seconds>(
+                                             std::chrono::system_clock::now().time_since_epoch())
+                                             .count());
+        }
+
+        uint64_t granularity_seconds(TimeGranularity granularity)
+        {
+            switch (granularity)
+            {
+            case TimeGranularity::REAL_TIME:
+            case TimeGranularity::SECOND:
+                return 1;
+            case TimeGranularity::MINUTE:
+                return 60;
+            case TimeGranularity::HOUR:
+                return 3600;
+            case TimeGranularity::DAY:
+                return 86400;
+            case TimeGranularity::WEEK:
+                return 7 * 86400;
+            case TimeGranularity::MONTH:
+                return 30 * 86400;
+            default:
+                return 1;
+            }
+        }
+
+        // Linear-interpolated quantile of sorted values
+        double sorted_quantile(const std::vector<double> &sorted, double p)
+        {
+            if (sorted.empty())
+            {
+                return 0.0;
+            }
+            const double position = p * static_cast<double>(sorted.size() - 1);
+            const size_t lower = static_cast<size_t>(position);
+            const size_t upper = std::min(lower + 1, sorted.size() - 1);
+            const double fraction = position - static_cast<double>(lower);
+            return sorted[lower] + (sorted[upper] - sorted[lower]) * fraction;
+        }
+
+        /**
+         * @brief P² estimate of one quantile in constant space (Jain & Chlamtac, 1985)
+         */
+        class P2Quantile
+        {
+        public:
+            explicit P2Quantile(double p = 0.5) : p_(p) {}
+
+            void add(double x)
+            {
+                if (count_ < 5)
+                {
+                    heights_[count_++] = x;
+                    if (count_ == 5)
+                    {
+                        std::sort(heights_.begin(), heights_.end());
+                        positions_ = {1, 2, 3, 4, 5};
+                        desired_ = {1, 1 + 2 * p_, 1 + 4 * p_, 3 + 2 * p_, 5};
+                        increments_ = {0, p_ / 2, p_, (1 + p_) / 2, 1};
+                    }
+                    return;
+                }
+                count_++;
+
+                size_t cell;
+                if (x < heights_[0])
+                {
+                    heights_[0] = x;
+                    cell = 0;
+                }
+                else if (x >= heights_[4])
+                {
+                    heights_[4] = x;
+                    cell = 3;
+                }
+                else
+                {
+                    cell = 0;
+                    while (cell < 3 && x >= heights_[cell + 1])
+                    {
+                        cell++;
+                    }
+                }
+
+                for (size_t i = cell + 1; i < 5; ++i)
+                {
+                    positions_[i] += 1;
+                }
+                for (size_t i = 0; i < 5; ++i)
+                {
+                    desired_[i] += increments_[i];
+                }
+
+                for (size_t i = 1; i < 4; ++i)
+                {
+                    const double d = desired_[i] - positions_[i];
+                    if ((d >= 1 && positions_[i + 1] - positions_[i] > 1) ||
+                        (d <= -1 && positions_[i - 1] - positions_[i] < -1))
+                    {
+                        const double s = d >= 0 ? 1.0 : -1.0;
+                        const double candidate = parabolic(i, s);
+                        if (heights_[i - 1] < candidate && candidate < heights_[i + 1])
+                        {
+                            heights_[i] = candidate;
+                        }
+                        else
+                        {
+                            const size_t j = s > 0 ? i + 1 : i - 1;
+                            heights_[i] += s * (heights_[j] - heights_[i]) / (positions_[j] - positions_[i]);
+                        }
+                        positions_[i] += s;
+                    }
+                }
+            }
+
+            double value() const
+            {
+                if (count_ >= 5)
+                {
+                    return heights_[2];
+                }
+                std::vector<double> sorted(heights_.begin(), heights_.begin() + count_);
+                std::sort(sorted.begin(), sorted.end());
+                return sorted_quantile(sorted, p_);
+            }
+
+        private:
+            double p_;
+            size_t count_ = 0;
+            std::array<double, 5> heights_{};
+            std::array<double, 5> positions_{};
+            std::array<double, 5> desired_{};
+            std::array<double, 5> increments_{};
+
+            double parabolic(size_t i, double s) const
+            {
+                const double span = positions_[i + 1] - positions_[i - 1];
+                const double right = (positions_[i] - positions_[i - 1] + s) * (heights_[i + 1] - heights_[i]) /
+                                     (positions_[i + 1] - positions_[i]);
+                const double left = (positions_[i + 1] - positions_[i] - s) * (heights_[i] - heights_[i - 1]) /
+                                    (positions_[i] - positions_[i - 1]);
+                return heights_[i] + s / span * (right + left);
+            }
+        };
+
+        struct Options
+        {
+            size_t window_size = 1024;
+            uint64_t min_samples = 30;
+            double ewma_alpha = 0.1;
+            double anomaly_z_threshold = 3.0;
+            double temporal_gap_factor = 10.0;
+            size_t max_anomaly_history = 10000;
+            uint64_t active_window_seconds = 300;
+            uint64_t metrics_interval_ms = 1000;
+        };
+
+        struct Limits
+        {
+            bool has_min = false;
+            bool has_max = false;
+            double min = 0.0;
+            double max = 0.0;
+        };
+
+        // One (device, metric) stream
+        struct Series
+        {
+            Series(std::string device, std::string metric, size_t window)
+                : device_id(std::move(device)), metric_name(std::move(metric)),
+                  values(std::max<size_t>(window, 1)), timestamps(std::max<size_t>(window, 1))
+            {
+                for (size_t i = 0; i < QUANTILES.size(); ++i)
+                {
+                    quantiles[i] = P2Quantile(QUANTILES[i]);
+                }
+            }
+
+            std::string device_id;
+            std::string metric_name;
+
+            // Ring buffer of the latest points
+            std::vector<double> values;
+            std::vector<uint64_t> timestamps;
+            size_t head = 0; // next slot to write
+            size_t size = 0;
+
+            // Welford running moments
+            uint64_t count = 0;
+            double mean = 0.0;
+            double m2 = 0.0;
+            double min = std::numeric_limits<double>::infinity();
+            double max = -std::numeric_limits<double>::infinity();
+
+            // Exponentially weighted value, variance and inter-arrival time
+            double ewma = 0.0;
+            double ewm_var = 0.0;
+            double interval_ewma = 0.0;
+            uint64_t last_timestamp = 0;
+
+            std::array<P2Quantile, QUANTILES.size()> quantiles;
+
+            // Detection settings, resolved from the configuration
+            double z_threshold = 3.0;
+            Limits limits;
+
+            uint64_t anomalies = 0;
+            bool last_anomalous = false;
+            std::string model_type = "auto";
+
+            double std_dev() const { return count > 1 ? std::sqrt(m2 / static_cast<double>(count - 1)) : 0.0; }
+            double quantile(size_t index) const { return quantiles[index].value(); }
+
+            size_t slot(size_t i) const { return (head + values.size() - size + i) % values.size(); }
+
+            void fold(double value, uint64_t timestamp, double alpha)
+            {
+                count++;
+                const double delta = value - mean;
+                mean += delta / static_cast<double>(count);
+                m2 += delta * (value - mean);
+                min = std::min(min, value);
+                max = std::max(max, value);
+
+                if (count == 1)
+                {
+                    ewma = value;
+                }
+                else
+                {
+                    const double diff = value - ewma;
+                    const double increment = alpha * diff;
+                    ewma += increment;
+                    ewm_var = (1.0 - alpha) * (ewm_var + diff * increment);
+                }
+
+                if (last_timestamp != 0 && timestamp > last_timestamp)
+                {
+                    const double interval = static_cast<double>(timestamp - last_timestamp);
+                    interval_ewma = interval_ewma == 0.0 ? interval : interval_ewma + alpha * (interval - interval_ewma);
+                }
+                last_timestamp = std::max(last_timestamp, timestamp);
+
+                for (auto &estimator : quantiles)
+                {
+                    estimator.add(value);
+                }
+
+                values[head] = value;
+                timestamps[head] = timestamp;
+                head = (head + 1) % values.size();
+                size = std::min(size + 1, values.size());
+            }
+
+            // Buffered points, oldest first
+            std::vector<std::pair<uint64_t, double>> points(uint64_t since = 0) const
+            {
+                std::vector<std::pair<uint64_t, double>> out;
+                out.reserve(size);
+                for (size_t i = 0; i < size; ++i)
+                {
+                    const size_t index = slot(i);
+                    if (timestamps[index] >= since)
+                    {
+                        out.emplace_back(timestamps[index], values[index]);
+                    }
+                }
+                return out;
+            }
+
+            // Drop buffered points older than cutoff
+            size_t trim(uint64_t cutoff)
+            {
+                size_t dropped = 0;
+                while (size > 0 && timestamps[slot(0)] < cutoff)
+                {
+                    size--;
+                    dropped++;
+                }
+                return dropped;
+            }
+        };
+
+        struct Score
+        {
+            bool anomalous = false;
+            AnomalyType type = AnomalyType::STATISTICAL_OUTLIER;
+            double z_score = 0.0;
+            double confidence = 0.0;
+            double severity = 0.0;
+        };
+
+        // Scores a value against the series as it stood before the value; O(1)
+        Score score(const Series &series, double value, uint64_t timestamp, const Options &options)
+        {
+            Score result;
+            const double std_dev = series.std_dev();
+            if (std_dev > 0.0)
+            {
+                result.z_score = std::abs(value - series.mean) / std_dev;
+            }
+
+            if (series.limits.has_max && value > series.limits.max)
+            {
+                result.anomalous = true;
+                result.type = AnomalyType::THRESHOLD_VIOLATION;
+                result.confidence = 1.0;
+                result.severity = std::min(1.0, (value - series.limits.max) / std::max(std::abs(series.limits.max), 1e-9));
+                return result;
+            }
+            if (series.limits.has_min && value < series.limits.min)
+            {
+                result.anomalous = true;
+                result.type = AnomalyType::THRESHOLD_VIOLATION;
+                result.confidence = 1.0;
+                result.severity = std::min(1.0, (series.limits.min - value) / std::max(std::abs(series.limits.min), 1e-9));
+                return result;
+            }
+
+            if (series.count < options.min_samples)
+            {
+                return result;
+            }
+
+            const double threshold = series.z_threshold;
+            if (std_dev == 0.0 && value != series.mean)
+            {
+                // A constant signal that moved
+                result.anomalous = true;
+                result.z_score = std::numeric_limits<double>::infinity();
+                result.confidence = 1.0;
+                result.severity = 1.0;
+                return result;
+            }
+            if (result.z_score > threshold)
+            {
+                result.anomalous = true;
+                result.confidence = 1.0 - 1.0 / (result.z_score * result.z_score); // Chebyshev bound
+                result.severity = std::min(1.0, (result.z_score - threshold) / threshold);
+                return result;
+            }
+
+            // Recent behaviour breaks from the short-term trend
+            if (series.ewm_var > 0.0)
+            {
+                const double recent_z = std::abs(value - series.ewma) / std::sqrt(series.ewm_var);
+                if (recent_z > threshold + 1.0)
+                {
+                    result.anomalous = true;
+                    result.type = AnomalyType::PATTERN_BREAK;
+                    result.confidence = 1.0 - 1.0 / (recent_z * recent_z);
+                    result.severity = std::min(1.0, (recent_z - threshold - 1.0) / threshold);
+                    return result;
+                }
+            }
+
+            // Silence much longer than the usual reporting interval
+            if (series.interval_ewma > 0.0 && timestamp > series.last_timestamp)
+            {
+                const double gap = static_cast<double>(timestamp - series.last_timestamp);
+                const double limit = options.temporal_gap_factor * series.interval_ewma;
+                if (gap > limit)
+                {
+                    result.anomalous = true;
+                    result.type = AnomalyType::TEMPORAL_ANOMALY;
+                    result.confidence = std::min(1.0, 0.5 + 0.5 * (gap - limit) / limit);
+                    result.severity = std::min(1.0, gap / limit / 10.0);
+                }
+            }
+            return result;
+        }
+
+        std::string recommendation_for(AnomalyType type)
+        {
+            switch (type)
+            {
+            case AnomalyType::THRESHOLD_VIOLATION:
+                return "Check the device against its operating limits";
+            case AnomalyType::STATISTICAL_OUTLIER:
+                return "Verify the reading and the sensor calibration";
+            case AnomalyType::PATTERN_BREAK:
+                return "Investigate recent changes in the device or its environment";
+            case AnomalyType::TEMPORAL_ANOMALY:
+                return "Check the device's connectivity and power";
+            default:
+                return "Review the device's recent data";
+            }
+        }
+
+        AnomalyResult make_result(const Series &series, double value, uint64_t timestamp, const Score &score)
+        {
+            AnomalyResult result;
+            result.is_anomaly = score.anomalous;
+            result.type = score.type;
+            result.confidence_score = score.confidence;
+            result.severity_level = score.severity;
+            result.detection_time = timestamp; // time of the offending point
+            result.context_data["value"] = value;
+            result.context_data["mean"] = series.mean;
+            result.context_data["std_dev"] = series.std_dev();
+            result.context_data["ewma"] = series.ewma;
+            result.context_data["z_score"] = score.z_score;
+            result.context_data["samples"] = static_cast<double>(series.count);
+
+            if (score.anomalous)
+            {
+                std::ostringstream description;
+                description << anomaly_type_to_string(score.type) << " in " << series.metric_name << " on "
+                            << series.device_id << ": value " << value;
+                if (score.type == AnomalyType::TEMPORAL_ANOMALY)
+                {
+                    description << " after " << (timestamp - series.last_timestamp) << " s of silence";
+                }
+                else if (score.type != AnomalyType::THRESHOLD_VIOLATION)
+                {
+                    description << " against mean " << series.mean;
+                }
+                result.description = description.str();
+                result.recommendation = recommendation_for(score.type);
+            }
+            return result;
+        }
+
+        struct LinearFit
+        {
+            double slope = 0.0; // per second
+            double intercept = 0.0;
+            double r_squared = 0.0;
+            double rmse = 0.0;
+        };
+
+        // Least squares over (t - t0, value)
+        LinearFit fit_line(const std::vector<std::pair<uint64_t, double>> &points)
+        {
+            LinearFit fit;
+            const size_t n = points.size();
+            if (n < 2)
+            {
+                fit.intercept = n == 1 ? points[0].second : 0.0;
+                return fit;
+            }
+
+            const double t0 = static_cast<double>(points.front().first);
+            double sum_t = 0.0, sum_v = 0.0;
+            for (const auto &[t, v] : points)
+            {
+                sum_t += static_cast<double>(t) - t0;
+                sum_v += v;
+            }
+            const double mean_t = sum_t / static_cast<double>(n);
+            const double mean_v = sum_v / static_cast<double>(n);
+
+            double stt = 0.0, stv = 0.0, svv = 0.0;
+            for (const auto &[t, v] : points)
+            {
+                const double dt = static_cast<double>(t) - t0 - mean_t;
+                const double dv = v - mean_v;
+                stt += dt * dt;
+                stv += dt * dv;
+                svv += dv * dv;
+            }
+
+            fit.slope = stt > 0.0 ? stv / stt : 0.0;
+            fit.intercept = mean_v - fit.slope * mean_t;
+
+            double sse = 0.0;
+            for (const auto &[t, v] : points)
+            {
+                const double residual = v - (fit.intercept + fit.slope * (static_cast<double>(t) - t0));
+                sse += residual * residual;
+            }
+            fit.r_squared = svv > 0.0 ? std::max(0.0, 1.0 - sse / svv) : 0.0;
+            fit.rmse = std::sqrt(sse / static_cast<double>(n));
+            return fit;
+        }
+
+        bool parse_number(const std::string &text, double &out)
+        {
+            char *end = nullptr;
+            const double value = std::strtod(text.c_str(), &end);
+            if (text.empty() || end != text.c_str() + text.size() || !std::isfinite(value))
+            {
+                return false;
+            }
+            out = value;
+            return true;
+        }
+
+        std::string escape_csv(const std::string &field)
+        {
+            if (field.find_first_of(",\"\n") == std::string::npos)
+            {
+                return field;
+            }
+            std::string out = "\"";
+            for (char c : field)
+            {
+                out += c == '"' ? "\"\"" : std::string(1, c);
+            }
+            return out + "\"";
+        }
+    } // namespace
+
+    class IoTAnalytics::Impl
+    {
+    public:
+        struct Shard
+        {
+            mutable std::mutex mutex;
+            std::unordered_map<std::string, std::unique_ptr<Series>> series;
+        };
+
+        struct RecordedAnomaly
+        {
+            std::string device_id;
+            AnomalyResult result;
+        };
+
+        std::atomic<bool> initialized_{false};
+        Clock::time_point started_ = Clock::now();
+
+        // Configuration; held shared while ingesting, taken before any shard lock
+        mutable std::shared_mutex config_mutex_;
+        std::map<std::string, std::string> config_;
+        Options options_;
+        std::map<std::string, Limits> limits_;
+        std::map<std::pair<std::string, std::string>, double> sensitivities_; // (device, metric), "" = any
+
+        std::array<Shard, SHARD_COUNT> shards_;
+
+        mutable std::mutex anomalies_mutex_;
+        std::deque<RecordedAnomaly> anomalies_;
+
+        mutable std::mutex callbacks_mutex_;
+        AnomalyCallback anomaly_callback_;
+        InsightCallback insight_callback_;
+        MetricsCallback metrics_callback_;
+        std::atomic<int64_t> next_metrics_ns_{0};
+
+        // Statistics
+        std::atomic<uint64_t> points_ingested_{0};
+        std::atomic<uint64_t> points_rejected_{0};
+        std::atomic<uint64_t> batches_ingested_{0};
+        std::atomic<uint64_t> anomalies_detected_{0};
+        std::atomic<uint64_t> forecasts_generated_{0};
+
+        static void make_key(std::string &key, const std::string &device_id, const std::string &metric_name)
+        {
+            key.assign(device_id);
+            key.push_back(KEY_SEPARATOR);
+            key.append(metric_name);
+        }
+
+        static size_t shard_of(const std::string &key) { return std::hash<std::string>{}(key) % SHARD_COUNT; }
+
+        // Caller holds config_mutex_
+        bool parse_config(const std::map<std::string, std::string> &config, Options &options,
+                          std::map<std::string, Limits> &limits) const
+        {
+            static const std::set<std::string> numeric_keys = {
+                "window_size", "min_samples", "ewma_alpha", "anomaly_z_threshold", "temporal_gap_factor",
+                "max_anomaly_history", "active_window_seconds", "metrics_interval_ms"};
+
+            for (const auto &[key, text] : config)
+            {
+                if (!numeric_keys.count(key) && key.rfind("threshold.", 0) != 0)
+                {
+                    continue; // not ours
+                }
+
+                double value = 0.0;
+                if (!parse_number(text, value))
+                {
+                    utils::Logger::instance().log(utils::LogLevel::WARNING, "IoTAnalytics",
+                                                  "Invalid value for " + key + ": " + text);
+                    return false;
+                }
+
+                if (key == "window_size")
+                    options.window_size = static_cast<size_t>(std::max(1.0, value));
+                else if (key == "min_samples")
+                    options.min_samples = static_cast<uint64_t>(std::max(2.0, value));
+                else if (key == "ewma_alpha")
+                    options.ewma_alpha = std::clamp(value, 1e-6, 1.0);
+                else if (key == "anomaly_z_threshold")
+                    options.anomaly_z_threshold = std::max(0.1, value);
+                else if (key == "temporal_gap_factor")
+                    options.temporal_gap_factor = std::max(1.0, value);
+                else if (key == "max_anomaly_history")
+                    options.max_anomaly_history = static_cast<size_t>(std::max(0.0, value));
+                else if (key == "active_window_seconds")
+                    options.active_window_seconds = static_cast<uint64_t>(std::max(0.0, value));
+                else if (key == "metrics_interval_ms")
+                    options.metrics_interval_ms = static_cast<uint64_t>(std::max(0.0, value));
+                else if (key.rfind("threshold.", 0) == 0 && key.size() > 14)
+                {
+                    const bool is_min = key.compare(key.size() - 4, 4, ".min") == 0;
+                    const bool is_max = key.compare(key.size() - 4, 4, ".max") == 0;
+                    if (!is_min && !is_max)
+                    {
+                        continue;
+                    }
+                    Limits &limit = limits[key.substr(10, key.size() - 14)];
+                    (is_min ? limit.has_min : limit.has_max) = true;
+                    (is_min ? limit.min : limit.max) = value;
+                }
+            }
+            return true;
+        }
+
+        // Caller holds config_mutex_
+        void resolve(Series &series) const
+        {
+            series.z_threshold = options_.anomaly_z_threshold;
+            for (const auto &key : {std::make_pair(series.device_id, series.metric_name),
+                                    std::make_pair(series.device_id, std::string()),
+                                    std::make_pair(std::string(), series.metric_name),
+                                    std::make_pair(std::string(), std::string())})
+            {
+                auto it = sensitivities_.find(key);
+                if (it != sensitivities_.end())
+                {
+                    series.z_threshold = 2.0 + 4.0 * (1.0 - it->second);
+                    break;
+                }
+            }
+
+            auto limit = limits_.find(series.metric_name);
+            series.limits = limit != limits_.end() ? limit->second : Limits();
+        }
+
+        // Caller holds config_mutex_ exclusively
+        void resolve_all()
+        {
+            for (auto &shard : shards_)
+            {
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                for (auto &[key, series] : shard.series)
+                {
+                    resolve(*series);
+                }
+            }
+        }
+
+        /**
+         * @brief One pass over a batch: bucket by shard, then take each shard's lock once
+         */
+        uint32_t ingest(const DataPoint *const *points, size_t count)
+        {
+            if (!initialized_ || count == 0)
+            {
+                return 0;
+            }
+
+            thread_local std::string key;
+            thread_local std::vector<uint8_t> shard_index;
+            thread_local std::vector<uint32_t> order;
+            shard_index.resize(count);
+
+            std::array<uint32_t, SHARD_COUNT + 1> offsets{};
+            uint32_t rejected = 0;
+            for (size_t i = 0; i < count; ++i)
+            {
+                const DataPoint &point = *points[i];
+                if (point.device_id.empty() || point.metric_name.empty() || !std::isfinite(point.value))
+                {
+                    shard_index[i] = SHARD_COUNT;
+                    rejected++;
+                    continue;
+                }
+                make_key(key, point.device_id, point.metric_name);
+                shard_index[i] = static_cast<uint8_t>(shard_of(key));
+                offsets[shard_index[i] + 1]++;
+            }
+            for (size_t s = 1; s <= SHARD_COUNT; ++s)
+            {
+                offsets[s] += offsets[s - 1];
+            }
+
+            // Counting sort keeps submission order within every series
+            order.resize(offsets[SHARD_COUNT]);
+            std::array<uint32_t, SHARD_COUNT> cursor;
+            std::copy(offsets.begin(), offsets.end() - 1, cursor.begin());
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (shard_index[i] < SHARD_COUNT)
+                {
+                    order[cursor[shard_index[i]]++] = static_cast<uint32_t>(i);
+                }
+            }
+
+            std::vector<std::pair<uint32_t, RecordedAnomaly>> found;
+            {
+                std::shared_lock<std::shared_mutex> config_lock(config_mutex_);
+                const Options &options = options_;
+
+                for (size_t s = 0; s < SHARD_COUNT; ++s)
+                {
+                    if (offsets[s] == offsets[s + 1])
+                    {
+                        continue;
+                    }
+
+                    Shard &shard = shards_[s];
+                    std::lock_guard<std::mutex> lock(shard.mutex);
+                    Series *series = nullptr;
+                    for (uint32_t o = offsets[s]; o < offsets[s + 1]; ++o)
+                    {
+                        const DataPoint &point = *points[order[o]];
+                        if (!series || series->device_id != point.device_id || series->metric_name != point.metric_name)
+                        {
+                            make_key(key, point.device_id, point.metric_name);
+                            auto &slot = shard.series[key];
+                            if (!slot)
+                            {
+                                slot = std::make_unique<Series>(point.device_id, point.metric_name, options.window_size);
+                                resolve(*slot);
+                            }
+                            series = slot.get();
+                        }
+
+                        const Score result = score(*series, point.value, point.timestamp, options);
+                        if (result.anomalous)
+                        {
+                            found.emplace_back(order[o], RecordedAnomaly{point.device_id,
+                                                                         make_result(*series, point.value, point.timestamp, result)});
+                            series->anomalies++;
+                        }
+                        series->last_anomalous = result.anomalous;
+                        series->fold(point.value, point.timestamp, options.ewma_alpha);
+                    }
+                }
+            }
+
+            const uint32_t accepted = static_cast<uint32_t>(count) - rejected;
+            points_ingested_ += accepted;
+            points_rejected_ += rejected;
+
+            if (!found.empty())
+            {
+                std::sort(found.begin(), found.end(), [](const auto &a, const auto &b)
+                          { return a.first < b.first; });
+                record(found);
+            }
+            maybe_publish_metrics();
+            return accepted;
+        }
+
+        void record(std::vector<std::pair<uint32_t, RecordedAnomaly>> &found)
+        {
+            anomalies_detected_ += found.size();
+            size_t history_limit;
+            {
+                std::shared_lock<std::shared_mutex> config_lock(config_mutex_);
+                history_limit = options_.max_anomaly_history;
+            }
+            {
+                std::lock_guard<std::mutex> lock(anomalies_mutex_);
+                for (const auto &entry : found)
+                {
+                    anomalies_.push_back(entry.second);
+                }
+                while (anomalies_.size() > history_limit)
+                {
+                    anomalies_.pop_front();
+                }
+            }
+
+            AnomalyCallback callback;
+            {
+                std::lock_guard<std::mutex> lock(callbacks_mutex_);
+                callback = anomaly_callback_;
+            }
+            for (const auto &entry : found)
+            {
+                CARDANO_IOT_LOG(utils::LogLevel::DEBUG, "IoTAnalytics", entry.second.result.description);
+                if (callback)
+                {
+                    callback(entry.second.result);
+                }
+            }
+        }
+
+        void maybe_publish_metrics()
+        {
+            const int64_t now = Clock::now().time_since_epoch().count();
+            int64_t due = next_metrics_ns_.load(std::memory_order_relaxed);
+            if (now < due)
+            {
+                return;
+            }
+
+            MetricsCallback callback;
+            {
+                std::lock_guard<std::mutex> lock(callbacks_mutex_);
+                callback = metrics_callback_;
+            }
+            if (!callback)
+            {
+                return;
+            }
+
+            uint64_t interval_ms;
+            {
+                std::shared_lock<std::shared_mutex> config_lock(config_mutex_);
+                interval_ms = options_.metrics_interval_ms;
+            }
+            const int64_t next = now + std::chrono::duration_cast<Clock::duration>(std::chrono::milliseconds(interval_ms)).count();
+            if (next_metrics_ns_.compare_exchange_strong(due, next))
+            {
+                callback(dashboard());
+            }
+        }
+
+        template <typename F>
+        void for_each_series(F &&f) const
+        {
+            for (const auto &shard : shards_)
+            {
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                for (const auto &[key, series] : shard.series)
+                {
+                    f(*series);
+                }
+            }
+        }
+
+        // Runs f on the series under its shard lock; false if unknown
+        template <typename F>
+        bool with_series(const std::string &device_id, const std::string &metric_name, F &&f) const
+        {
+            std::string key;
+            make_key(key, device_id, metric_name);
+            const Shard &shard = shards_[shard_of(key)];
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto it = shard.series.find(key);
+            if (it == shard.series.end())
+            {
+                return false;
+            }
+            f(*it->second);
+            return true;
+        }
+
+        template <typename F>
+        bool with_series(const std::string &device_id, const std::string &metric_name, F &&f)
+        {
+            return static_cast<const Impl *>(this)->with_series(device_id, metric_name, [&](const Series &series)
+                                                                { f(const_cast<Series &>(series)); });
+        }
+
+        struct DeviceSummary
+        {
+            uint64_t points = 0;
+            uint64_t anomalies = 0;
+            uint64_t last_timestamp = 0;
+            bool last_anomalous = false;
+        };
+
+        std::map<std::string, DeviceSummary> devices() const
+        {
+            std::map<std::string, DeviceSummary> out;
+            for_each_series([&out](const Series &series)
+                            {
+                                DeviceSummary &device = out[series.device_id];
+                                device.points += series.count;
+                                device.anomalies += series.anomalies;
+                                device.last_timestamp = std::max(device.last_timestamp, series.last_timestamp);
+                                device.last_anomalous = device.last_anomalous || series.last_anomalous; });
+            return out;
+        }
+
+        DashboardMetrics dashboard() const
+        {
+            DashboardMetrics metrics{};
+            uint64_t active_window;
+            {
+                std::shared_lock<std::shared_mutex> config_lock(config_mutex_);
+                active_window = options_.active_window_seconds;
+            }
+
+            const uint64_t now = now_seconds();
+            for (const auto &[device_id, device] : devices())
+            {
+                metrics.total_devices++;
+                if (device.last_timestamp + active_window >= now)
+                {
+                    metrics.active_devices++;
+                }
+                if (device.last_anomalous)
+                {
+                    metrics.error_devices++;
+                }
+            }
+            metrics.offline_devices = metrics.total_devices - metrics.active_devices;
+
+            metrics.total_data_points = points_ingested_;
+            const double elapsed = std::chrono::duration<double>(Clock::now() - started_).count();
+            metrics.data_throughput_per_second = elapsed > 0.0 ? static_cast<double>(metrics.total_data_points) / elapsed : 0.0;
+            metrics.anomalies_detected = static_cast<uint32_t>(anomalies_detected_.load());
+            metrics.last_updated = now;
+            return metrics;
+        }
+
+        uint64_t newest_timestamp(const std::string &device_id = "") const
+        {
+            uint64_t newest = 0;
+            for_each_series([&](const Series &series)
+                            {
+                                if (device_id.empty() || series.device_id == device_id)
+                                {
+                                    newest = std::max(newest, series.last_timestamp);
+                                } });
+            return newest;
+        }
+
+        void publish(const std::vector<AnalyticsInsight> &insights)
+        {
+            InsightCallback callback;
+            {
+                std::lock_guard<std::mutex> lock(callbacks_mutex_);
+                callback = insight_callback_;
+            }
+            if (callback)
+            {
+                for (const auto &insight : insights)
+                {
+                    callback(insight);
+                }
+            }
+        }
+    };
+
+    IoTAnalytics::IoTAnalytics() : pimpl_(std::make_unique<Impl>()) {}
+
+    IoTAnalytics::~IoTAnalytics() = default;
+
+    bool IoTAnalytics::initialize(const std::map<std::string, std::string> &config)
+    {
+        {
+            std::unique_lock<std::shared_mutex> lock(pimpl_->config_mutex_);
+            if (pimpl_->initialized_)
+            {
+                return true;
+            }
+
+            Options options;
+            std::map<std::string, Limits> limits;
+            if (!pimpl_->parse_config(config, options, limits))
+            {
+                return false;
+            }
+            pimpl_->config_ = config;
+            pimpl_->options_ = options;
+            pimpl_->limits_ = std::move(limits);
+            pimpl_->started_ = Clock::now();
+            pimpl_->initialized_ = true;
+        }
+
+        utils::Logger::instance().log(utils::LogLevel::INFO, "IoTAnalytics", "Analytics engine initialized");
+        return true;
+    }
+
+    void IoTAnalytics::shutdown()
+    {
+        if (!pimpl_->initialized_.exchange(false))
+        {
+            return;
+        }
+
+        clear_analytics_data(0);
+        utils::Logger::instance().log(utils::LogLevel::INFO, "IoTAnalytics", "Analytics engine shut down");
+    }
+
+    bool IoTAnalytics::ingest_data_point(const DataPoint &data_point)
+    {
+        const DataPoint *point = &data_point;
+        return pimpl_->ingest(&point, 1) == 1;
+    }
+
+    uint32_t IoTAnalytics::ingest_data_batch(const std::vector<DataPoint> &data_points)
+    {
+        thread_local std::vector<const DataPoint *> pointers;
+        pointers.clear();
+        pointers.reserve(data_points.size());
+        for (const auto &point : data_points)
+        {
+            pointers.push_back(&point);
+        }
+
+        pimpl_->batches_ingested_++;
+        return pimpl_->ingest(pointers.data(), pointers.size());
+    }
+
+    uint32_t IoTAnalytics::ingest_payload(const std::string &device_id, const std::string &data_type,
+                                          const std::string &payload, uint64_t timestamp)
+    {
+        auto parsed = json::parse(payload, nullptr, false);
+        std::vector<DataPoint> points;
+
+        auto add = [&](const std::string &metric, double value)
+        {
+            DataPoint point;
+            point.device_id = device_id;
+            point.metric_name = metric;
+            point.value = value;
+            point.timestamp = timestamp;
+            point.tags["data_type"] = data_type;
+            points.push_back(std::move(point));
+        };
+
+        if (parsed.is_object())
+        {
+            for (auto it = parsed.begin(); it != parsed.end(); ++it)
+            {
+                if (it.value().is_number())
+                {
+                    add(it.key(), it.value().get<double>());
+                }
+            }
+        }
+        else if (parsed.is_number())
+        {
+            add(data_type, parsed.get<double>());
+        }
+
+        return points.empty() ? 0 : ingest_data_batch(points);
+    }
+
+    void IoTAnalytics::connect_to_sdk(CardanoIoTSDK &sdk)
+    {
+        sdk.set_data_event_callback([this](const CardanoIoTSDK::IoTData &data)
+                                    { ingest_payload(data.device_id, data.data_type, data.payload, data.timestamp); });
+
+        utils::Logger::instance().log(utils::LogLevel::INFO, "IoTAnalytics", "Connected to SDK data events");
+    }
+
+    bool IoTAnalytics::configure_anomaly_detection(const std::string &device_id,
+                                                   const std::string &metric_name,
+                                                   double sensitivity)
+    {
+        if (sensitivity < 0.0 || sensitivity > 1.0)
+        {
+            return false;
+        }
+
+        std::unique_lock<std::shared_mutex> lock(pimpl_->config_mutex_);
+        pimpl_->sensitivities_[{device_id, metric_name}] = sensitivity;
+        pimpl_->resolve_all();
+        return true;
+    }
+
+    AnomalyResult IoTAnalytics::detect_anomaly(const DataPoint &data_point)
+    {
+        AnomalyResult result{};
+        result.detection_time = data_point.timestamp;
+
+        std::shared_lock<std::shared_mutex> config_lock(pimpl_->config_mutex_);
+        pimpl_->with_series(data_point.device_id, data_point.metric_name, [&](const Series &series)
+                            {
+                                const Score outcome = score(series, data_point.value, data_point.timestamp, pimpl_->options_);
+                                result = make_result(series, data_point.value, data_point.timestamp, outcome); });
+        return result;
+    }
+
+    std::vector<AnomalyResult> IoTAnalytics::get_historical_anomalies(const std::string &device_id,
+                                                                      uint64_t start_time,
+                                                                      uint64_t end_time) const
+    {
+        std::vector<AnomalyResult> out;
+        std::lock_guard<std::mutex> lock(pimpl_->anomalies_mutex_);
+        for (const auto &entry : pimpl_->anomalies_)
+        {
+            if ((device_id.empty() || entry.device_id == device_id) &&
+                entry.result.detection_time >= start_time &&
+                (end_time == 0 || entry.result.detection_time <= end_time))
+            {
+                out.push_back(entry.result);
+            }
+        }
+        return out;
+    }
+
+    ForecastResult IoTAnalytics::generate_forecast(const std::string &device_id,
+                                                   const std::string &metric_name,
+                                                   uint32_t forecast_horizon_hours)
+    {
+        ForecastResult forecast;
+        forecast.metric_name = metric_name;
+        forecast.confidence_interval = 0.0;
+        forecast.model_type = "none";
+
+        std::vector<std::pair<uint64_t, double>> points;
+        std::string model_type;
+        double ewma = 0.0;
+        double ewm_std = 0.0;
+        pimpl_->with_series(device_id, metric_name, [&](const Series &series)
+                            {
+                                points = series.points();
+                                model_type = series.model_type;
+                                ewma = series.ewma;
+                                ewm_std = std::sqrt(series.ewm_var); });
+        if (points.size() < 2)
+        {
+            return forecast;
+        }
+
+        const LinearFit fit = fit_line(points);
+        if (model_type == "auto")
+        {
+            model_type = fit.r_squared >= 0.3 ? "linear" : "ewma";
+        }
+
+        const uint64_t last = points.back().first;
+        const double t0 = static_cast<double>(points.front().first);
+        for (uint32_t h = 1; h <= forecast_horizon_hours; ++h)
+        {
+            const uint64_t timestamp = last + static_cast<uint64_t>(h) * 3600;
+            const double value = model_type == "linear"
+                                     ? fit.intercept + fit.slope * (static_cast<double>(timestamp) - t0)
+                                     : ewma;
+            forecast.predictions.emplace_back(timestamp, value);
+        }
+
+        forecast.model_type = model_type;
+        forecast.confidence_interval = 1.96 * (model_type == "linear" ? fit.rmse : ewm_std);
+        forecast.model_metrics["samples"] = static_cast<double>(points.size());
+        forecast.model_metrics["r_squared"] = fit.r_squared;
+        forecast.model_metrics["rmse"] = fit.rmse;
+        forecast.model_metrics["slope_per_hour"] = fit.slope * 3600.0;
+
+        pimpl_->forecasts_generated_++;
+        return forecast;
+    }
+
+    bool IoTAnalytics::train_predictive_model(const std::string &device_id,
+                                              const std::string &metric_name,
+                                              const std::string &model_type)
+    {
+        if (model_type != "auto" && model_type != "linear" && model_type != "ewma")
+        {
+            utils::Logger::instance().log(utils::LogLevel::WARNING, "IoTAnalytics",
+                                          "Unsupported model type: " + model_type);
+            return false;
+        }
+
+        bool trained = false;
+        pimpl_->with_series(device_id, metric_name, [&](Series &series)
+                            {
+                                if (series.size >= 2)
+                                {
+                                    series.model_type = model_type;
+                                    trained = true;
+                                } });
+        return trained;
+    }
+
+    std::vector<std::string> IoTAnalytics::detect_patterns(const std::string &device_id,
+                                                           const std::string &metric_name,
+                                                           const std::string &pattern_type)
+    {
+        std::vector<std::pair<uint64_t, double>> points;
+        uint64_t count = 0;
+        uint64_t anomalies = 0;
+        pimpl_->with_series(device_id, metric_name, [&](const Series &series)
+                            {
+                                points = series.points();
+                                count = series.count;
+                                anomalies = series.anomalies; });
+
+        std::vector<std::string> patterns;
+        if (points.size() < 4)
+        {
+            return patterns;
+        }
+
+        const bool all = pattern_type == "auto" || pattern_type == "all";
+        std::vector<double> values;
+        values.reserve(points.size());
+        for (const auto &point : points)
+        {
+            values.push_back(point.second);
+        }
+        const auto stats = calculate_statistics(values);
+        const double mean = stats.at("mean");
+        const double std_dev = stats.at("std");
+
+        if (all || pattern_type == "trend")
+        {
+            const LinearFit fit = fit_line(points);
+            const double span = static_cast<double>(points.back().first - points.front().first);
+            if (fit.r_squared > 0.5 && std::abs(fit.slope) * span > 0.5 * std_dev)
+            {
+                patterns.push_back(fit.slope > 0 ? "increasing_trend" : "decreasing_trend");
+            }
+        }
+
+        if ((all || pattern_type == "seasonality") && std_dev > 0.0)
+        {
+            // Strongest autocorrelation over lags up to half the window
+            double best = 0.0;
+            size_t best_lag = 0;
+            const double variance = std_dev * std_dev * static_cast<double>(values.size() - 1);
+            for (size_t lag = 2; lag <= values.size() / 2; ++lag)
+            {
+                double sum = 0.0;
+                for (size_t i = lag; i < values.size(); ++i)
+                {
+                    sum += (values[i] - mean) * (values[i - lag] - mean);
+                }
+                const double acf = sum / variance;
+                if (acf > best)
+                {
+                    best = acf;
+                    best_lag = lag;
+                }
+            }
+            if (best > 0.5)
+            {
+                patterns.push_back("seasonal_period_" + std::to_string(best_lag));
+            }
+        }
+
+        if (all || pattern_type == "volatility")
+        {
+            const double cv = mean != 0.0 ? std_dev / std::abs(mean) : (std_dev > 0.0 ? 1.0 : 0.0);
+            if (cv < 0.01)
+            {
+                patterns.push_back("stable");
+            }
+            else if (cv > 0.5)
+            {
+                patterns.push_back("volatile");
+            }
+        }
+
+        if ((all || pattern_type == "anomalies") && anomalies * 20 > count)
+        {
+            patterns.push_back("recurring_anomalies");
+        }
+        return patterns;
+    }
+
+    std::map<std::string, std::vector<std::string>> IoTAnalytics::cluster_devices(
+        const std::vector<std::string> &metric_names,
+        uint32_t num_clusters)
+    {
+        // Feature vector per device: the mean of each metric
+        std::map<std::string, std::map<std::string, double>> means;
+        std::set<std::string> all_metrics;
+        pimpl_->for_each_series([&](const Series &series)
+                                {
+                                    means[series.device_id][series.metric_name] = series.mean;
+                                    all_metrics.insert(series.metric_name); });
+        const std::vector<std::string> metrics = metric_names.empty()
+                                                     ? std::vector<std::string>(all_metrics.begin(), all_metrics.end())
+                                                     : metric_names;
+
+        std::vector<std::string> devices;
+        std::vector<std::vector<double>> features;
+        for (const auto &[device_id, device_means] : means)
+        {
+            std::vector<double> feature;
+            for (const auto &metric : metrics)
+            {
+                auto it = device_means.find(metric);
+                if (it == device_means.end())
+                {
+                    break;
+                }
+                feature.push_back(it->second);
+            }
+            if (feature.size() == metrics.size() && !metrics.empty())
+            {
+                devices.push_back(device_id);
+                features.push_back(std::move(feature));
+            }
+        }
+
+        std::map<std::string, std::vector<std::string>> clusters;
+        const size_t n = devices.size();
+        if (n == 0)
+        {
+            return clusters;
+        }
+
+        // z-normalise each dimension
+        for (size_t d = 0; d < metrics.size(); ++d)
+        {
+            std::vector<double> column;
+            for (const auto &feature : features)
+            {
+                column.push_back(feature[d]);
+            }
+            const auto normalized = normalize_time_series(column, "zscore");
+            for (size_t i = 0; i < n; ++i)
+            {
+                features[i][d] = normalized[i];
+            }
+        }
+
+        size_t k = num_clusters > 0 ? num_clusters : static_cast<size_t>(std::lround(std::sqrt(n / 2.0)));
+        k = std::clamp<size_t>(k, 1, n);
+
+        auto distance = [](const std::vector<double> &a, const std::vector<double> &b)
+        {
+            double sum = 0.0;
+            for (size_t i = 0; i < a.size(); ++i)
+            {
+                sum += (a[i] - b[i]) * (a[i] - b[i]);
+            }
+            return sum;
+        };
+
+        // Farthest-point seeding keeps the result deterministic
+        std::vector<std::vector<double>> centroids{features[0]};
+        while (centroids.size() < k)
+        {
+            size_t farthest = 0;
+            double farthest_distance = -1.0;
+            for (size_t i = 0; i < n; ++i)
+            {
+                double nearest = std::numeric_limits<double>::infinity();
+                for (const auto &centroid : centroids)
+                {
+                    nearest = std::min(nearest, distance(features[i], centroid));
+                }
+                if (nearest > farthest_distance)
+                {
+                    farthest_distance = nearest;
+                    farthest = i;
+                }
+            }
+            centroids.push_back(features[farthest]);
+        }
+
+        std::vector<size_t> assignment(n, 0);
+        for (int iteration = 0; iteration < 50; ++iteration)
+        {
+            bool changed = false;
+            for (size_t i = 0; i < n; ++i)
+            {
+                size_t best = 0;
+                for (size_t c = 1; c < k; ++c)
+                {
+                    if (distance(features[i], centroids[c]) < distance(features[i], centroids[best]))
+                    {
+                        best = c;
+                    }
+                }
+                changed = changed || best != assignment[i];
+                assignment[i] = best;
+            }
+            if (!changed && iteration > 0)
+            {
+                break;
+            }
+
+            for (size_t c = 0; c < k; ++c)
+            {
+                std::vector<double> sum(metrics.size(), 0.0);
+                size_t members = 0;
+                for (size_t i = 0; i < n; ++i)
+                {
+                    if (assignment[i] == c)
+                    {
+                        for (size_t d = 0; d < metrics.size(); ++d)
+                        {
+                            sum[d] += features[i][d];
+                        }
+                        members++;
+                    }
+                }
+                if (members > 0)
+                {
+                    for (auto &value : sum)
+                    {
+                        value /= static_cast<double>(members);
+                    }
+                    centroids[c] = std::move(sum);
+                }
+            }
+        }
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            clusters["cluster_" + std::to_string(assignment[i])].push_back(devices[i]);
+        }
+        return clusters;
+    }
+
+    std::vector<AnalyticsInsight> IoTAnalytics::generate_insights(const std::string &insight_type)
+    {
+        const bool all = insight_type == "all";
+        const uint64_t now = now_seconds();
+        uint64_t min_samples;
+        {
+            std::shared_lock<std::shared_mutex> config_lock(pimpl_->config_mutex_);
+            min_samples = pimpl_->options_.min_samples;
+        }
+
+        std::vector<AnalyticsInsight> insights;
+        auto add = [&](const std::string &type, const std::string &title, const std::string &description,
+                       double impact, const std::string &device_id, const std::string &action)
+        {
+            AnalyticsInsight insight;
+            insight.insight_type = type;
+            insight.title = title;
+            insight.description = description;
+            insight.impact_score = std::clamp(impact, 0.0, 1.0);
+            insight.affected_devices = {device_id};
+            insight.recommendations["action"] = action;
+            insight.generated_time = now;
+            insights.push_back(std::move(insight));
+        };
+
+        const auto devices = pimpl_->devices();
+
+        if (all || insight_type == "performance")
+        {
+            for (const auto &[device_id, device] : devices)
+            {
+                if (device.points >= min_samples && device.anomalies * 20 > device.points)
+                {
+                    const double rate = static_cast<double>(device.anomalies) / static_cast<double>(device.points);
+                    add("performance", "Frequent anomalies on " + device_id,
+                        std::to_string(device.anomalies) + " of " + std::to_string(device.points) + " readings were anomalous",
+                        rate * 5.0, device_id, "Inspect the device and its sensor calibration");
+                }
+            }
+        }
+
+        if (all || insight_type == "efficiency")
+        {
+            pimpl_->for_each_series([&](const Series &series)
+                                    {
+                                        const double std_dev = series.std_dev();
+                                        if (series.count >= min_samples && series.mean != 0.0 &&
+                                            std_dev / std::abs(series.mean) > 0.5)
+                                        {
+                                            add("efficiency", "Unstable " + series.metric_name + " on " + series.device_id,
+                                                "Readings vary by " + std::to_string(std_dev / std::abs(series.mean) * 100.0) + "% of their mean",
+                                                std_dev / std::abs(series.mean) / 2.0, series.device_id,
+                                                "Stabilise the operating conditions or smooth the readings on the device");
+                                        }
+                                        if (series.interval_ewma > 0.0 && now > series.last_timestamp &&
+                                            static_cast<double>(now - series.last_timestamp) > 10.0 * series.interval_ewma)
+                                        {
+                                            add("efficiency", series.device_id + " stopped reporting " + series.metric_name,
+                                                "No reading for " + std::to_string(now - series.last_timestamp) + " s",
+                                                0.5, series.device_id, "Check the device's power and connectivity");
+                                        } });
+        }
+
+        if ((all || insight_type == "cost") && devices.size() >= 3)
+        {
+            std::vector<double> volumes;
+            for (const auto &[device_id, device] : devices)
+            {
+                volumes.push_back(static_cast<double>(device.points));
+            }
+            std::sort(volumes.begin(), volumes.end());
+            const double median = sorted_quantile(volumes, 0.5);
+            for (const auto &[device_id, device] : devices)
+            {
+                const double points = static_cast<double>(device.points);
+                if (median > 0.0 && points > 3.0 * median && points > 100.0)
+                {
+                    add("cost", "High data volume from " + device_id,
+                        "Sends " + std::to_string(points / median) + "x the median number of readings",
+                        std::min(1.0, points / median / 10.0), device_id,
+                        "Aggregate readings on the device or lower its sampling rate");
+                }
+            }
+        }
+
+        std::sort(insights.begin(), insights.end(), [](const auto &a, const auto &b)
+                  { return a.impact_score > b.impact_score; });
+        pimpl_->publish(insights);
+        return insights;
+    }
+
+    std::map<std::string, double> IoTAnalytics::calculate_roi_metrics(uint32_t baseline_period_days)
+    {
+        const auto metrics = get_dashboard_metrics();
+        const double days = std::max<uint32_t>(baseline_period_days, 1);
+        const double points = static_cast<double>(metrics.total_data_points);
+
+        std::map<std::string, double> roi;
+        roi["baseline_period_days"] = days;
+        roi["data_points"] = points;
+        roi["data_points_per_day"] = points / days;
+        roi["anomalies_detected"] = metrics.anomalies_detected;
+        roi["anomaly_rate"] = points > 0.0 ? metrics.anomalies_detected / points : 0.0;
+        roi["monitored_devices"] = metrics.total_devices;
+        roi["device_availability"] = metrics.total_devices > 0
+                                         ? static_cast<double>(metrics.active_devices) / metrics.total_devices
+                                         : 0.0;
+        roi["system_health_score"] = get_system_health_score();
+        return roi;
+    }
+
+    std::map<std::string, double> IoTAnalytics::generate_cost_analysis(
+        const std::map<std::string, double> &cost_model)
+    {
+        auto rate = [&cost_model](const std::string &key)
+        {
+            auto it = cost_model.find(key);
+            return it != cost_model.end() ? it->second : 0.0;
+        };
+
+        const auto metrics = get_dashboard_metrics();
+        std::map<std::string, double> analysis;
+        analysis["data_cost"] = rate("cost_per_data_point") * static_cast<double>(metrics.total_data_points);
+        analysis["device_cost"] = rate("cost_per_device") * metrics.total_devices;
+        analysis["anomaly_cost"] = rate("cost_per_anomaly") * metrics.anomalies_detected;
+        analysis["total_cost"] = analysis["data_cost"] + analysis["device_cost"] + analysis["anomaly_cost"];
+        analysis["cost_per_device_average"] = metrics.total_devices > 0 ? analysis["total_cost"] / metrics.total_devices : 0.0;
+        return analysis;
+    }
+
+    DashboardMetrics IoTAnalytics::get_dashboard_metrics() const
+    {
+        return pimpl_->dashboard();
+    }
+
+    std::map<std::string, double> IoTAnalytics::get_device_performance(const std::string &device_id,
+                                                                       uint32_t time_range_hours) const
+    {
+        const uint64_t newest = pimpl_->newest_timestamp(device_id);
+        const uint64_t range = static_cast<uint64_t>(time_range_hours) * 3600;
+        const uint64_t since = newest > range ? newest - range : 0;
+
+        std::map<std::string, double> performance;
+        uint64_t points = 0;
+        uint64_t anomalies = 0;
+        pimpl_->for_each_series([&](const Series &series)
+                                {
+                                    if (series.device_id != device_id)
+                                    {
+                                        return;
+                                    }
+                                    const std::string prefix = series.metric_name + ".";
+                                    performance[prefix + "count"] = static_cast<double>(series.count);
+                                    performance[prefix + "mean"] = series.mean;
+                                    performance[prefix + "std_dev"] = series.std_dev();
+                                    performance[prefix + "min"] = series.min;
+                                    performance[prefix + "max"] = series.max;
+                                    performance[prefix + "ewma"] = series.ewma;
+                                    performance[prefix + "p25"] = series.quantile(0);
+                                    performance[prefix + "p50"] = series.quantile(1);
+                                    performance[prefix + "p75"] = series.quantile(2);
+                                    performance[prefix + "p95"] = series.quantile(3);
+                                    performance[prefix + "anomalies"] = static_cast<double>(series.anomalies);
+
+                                    double sum = 0.0;
+                                    size_t recent = 0;
+                                    for (size_t i = 0; i < series.size; ++i)
+                                    {
+                                        const size_t index = series.slot(i);
+                                        if (series.timestamps[index] >= since)
+                                        {
+                                            sum += series.values[index];
+                                            recent++;
+                                        }
+                                    }
+                                    performance[prefix + "recent_count"] = static_cast<double>(recent);
+                                    performance[prefix + "recent_mean"] = recent > 0 ? sum / static_cast<double>(recent) : 0.0;
+
+                                    points += series.count;
+                                    anomalies += series.anomalies; });
+
+        if (!performance.empty())
+        {
+            performance["data_points"] = static_cast<double>(points);
+            performance["anomalies"] = static_cast<double>(anomalies);
+            performance["anomaly_rate"] = points > 0 ? static_cast<double>(anomalies) / static_cast<double>(points) : 0.0;
+        }
+        return performance;
+    }
+
+    double IoTAnalytics::get_system_health_score() const
+    {
+        const auto metrics = pimpl_->dashboard();
+        if (metrics.total_devices == 0)
+        {
+            return 1.0;
+        }
+
+        const double availability = static_cast<double>(metrics.active_devices) / metrics.total_devices;
+        const double anomaly_rate = metrics.total_data_points > 0
+                                        ? static_cast<double>(metrics.anomalies_detected) / static_cast<double>(metrics.total_data_points)
+                                        : 0.0;
+        return 0.5 * availability + 0.5 * (1.0 - std::min(1.0, anomaly_rate * 10.0));
+    }
+
+    std::vector<std::pair<uint64_t, double>> IoTAnalytics::aggregate_data(
+        const std::string &device_id,
+        const std::string &metric_name,
+        TimeGranularity granularity,
+        const std::string &aggregation_func,
+        uint64_t start_time,
+        uint64_t end_time) const
+    {
+        struct Bucket
+        {
+            double sum = 0.0;
+            double min = std::numeric_limits<double>::infinity();
+            double max = -std::numeric_limits<double>::infinity();
+            uint64_t count = 0;
+        };
+
+        std::vector<std::pair<uint64_t, double>> out;
+        if (aggregation_func != "mean" && aggregation_func != "sum" && aggregation_func != "max" &&
+            aggregation_func != "min" && aggregation_func != "count")
+        {
+            return out;
+        }
+
+        const uint64_t width = granularity_seconds(granularity);
+        std::map<uint64_t, Bucket> buckets;
+        pimpl_->with_series(device_id, metric_name, [&](const Series &series)
+                            {
+                                for (size_t i = 0; i < series.size; ++i)
+                                {
+                                    const size_t index = series.slot(i);
+                                    const uint64_t timestamp = series.timestamps[index];
+                                    if (timestamp < start_time || (end_time != 0 && timestamp > end_time))
+                                    {
+                                        continue;
+                                    }
+                                    Bucket &bucket = buckets[timestamp / width * width];
+                                    const double value = series.values[index];
+                                    bucket.sum += value;
+                                    bucket.min = std::min(bucket.min, value);
+                                    bucket.max = std::max(bucket.max, value);
+                                    bucket.count++;
+                                } });
+
+        out.reserve(buckets.size());
+        for (const auto &[start, bucket] : buckets)
+        {
+            double value = bucket.sum / static_cast<double>(bucket.count);
+            if (aggregation_func == "sum")
+                value = bucket.sum;
+            else if (aggregation_func == "max")
+                value = bucket.max;
+            else if (aggregation_func == "min")
+                value = bucket.min;
+            else if (aggregation_func == "count")
+                value = static_cast<double>(bucket.count);
+            out.emplace_back(start, value);
+        }
+        return out;
+    }
+
+    std::map<std::string, std::map<std::string, double>> IoTAnalytics::calculate_correlation_matrix(
+        const std::vector<std::string> &metric_names,
+        uint32_t time_range_hours) const
+    {
+        const uint64_t newest = pimpl_->newest_timestamp();
+        const uint64_t range = static_cast<uint64_t>(time_range_hours) * 3600;
+        const uint64_t since = newest > range ? newest - range : 0;
+
+        // device -> metric -> timestamp -> value
+        std::map<std::string, std::map<std::string, std::unordered_map<uint64_t, double>>> samples;
+        const std::set<std::string> wanted(metric_names.begin(), metric_names.end());
+        pimpl_->for_each_series([&](const Series &series)
+                                {
+                                    if (!wanted.count(series.metric_name))
+                                    {
+                                        return;
+                                    }
+                                    auto &target = samples[series.device_id][series.metric_name];
+                                    for (const auto &[timestamp, value] : series.points(since))
+                                    {
+                                        target[timestamp] = value;
+                                    } });
+
+        std::map<std::string, std::map<std::string, double>> matrix;
+        for (size_t i = 0; i < metric_names.size(); ++i)
+        {
+            matrix[metric_names[i]][metric_names[i]] = 1.0;
+            for (size_t j = i + 1; j < metric_names.size(); ++j)
+            {
+                // Pearson over readings taken at the same second on the same device
+                double n = 0, sx = 0, sy = 0, sxx = 0, syy = 0, sxy = 0;
+                for (const auto &[device_id, metrics] : samples)
+                {
+                    auto a = metrics.find(metric_names[i]);
+                    auto b = metrics.find(metric_names[j]);
+                    if (a == metrics.end() || b == metrics.end())
+                    {
+                        continue;
+                    }
+                    for (const auto &[timestamp, x] : a->second)
+                    {
+                        auto match = b->second.find(timestamp);
+                        if (match == b->second.end())
+                        {
+                            continue;
+                        }
+                        const double y = match->second;
+                        n++;
+                        sx += x;
+                        sy += y;
+                        sxx += x * x;
+                        syy += y * y;
+                        sxy += x * y;
+                    }
+                }
+
+                double correlation = 0.0;
+                const double denominator = std::sqrt((n * sxx - sx * sx) * (n * syy - sy * sy));
+                if (n >= 3 && denominator > 0.0)
+                {
+                    correlation = std::clamp((n * sxy - sx * sy) / denominator, -1.0, 1.0);
+                }
+                matrix[metric_names[i]][metric_names[j]] = correlation;
+                matrix[metric_names[j]][metric_names[i]] = correlation;
+            }
+        }
+        return matrix;
+    }
+
+    void IoTAnalytics::set_anomaly_callback(AnomalyCallback callback)
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->callbacks_mutex_);
+        pimpl_->anomaly_callback_ = std::move(callback);
+    }
+
+    void IoTAnalytics::set_insights_callback(InsightCallback callback)
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->callbacks_mutex_);
+        pimpl_->insight_callback_ = std::move(callback);
+    }
+
+    void IoTAnalytics::set_metrics_callback(MetricsCallback callback)
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->callbacks_mutex_);
+        pimpl_->metrics_callback_ = std::move(callback);
+    }
+
+    bool IoTAnalytics::update_configuration(const std::map<std::string, std::string> &config)
+    {
+        std::unique_lock<std::shared_mutex> lock(pimpl_->config_mutex_);
+        std::map<std::string, std::string> merged = pimpl_->config_;
+        for (const auto &[key, value] : config)
+        {
+            merged[key] = value;
+        }
+
+        Options options;
+        std::map<std::string, Limits> limits;
+        if (!pimpl_->parse_config(merged, options, limits))
+        {
+            return false;
+        }
+
+        pimpl_->config_ = std::move(merged);
+        pimpl_->options_ = options;
+        pimpl_->limits_ = std::move(limits);
+        pimpl_->resolve_all();
+        return true;
+    }
+
+    std::map<std::string, std::string> IoTAnalytics::get_configuration() const
+    {
+        std::shared_lock<std::shared_mutex> lock(pimpl_->config_mutex_);
+        return pimpl_->config_;
+    }
+
+    bool IoTAnalytics::export_analytics_data(const std::string &file_path,
+                                             const std::string &format,
+                                             const std::map<std::string, std::string> &filters) const
+    {
+        if (format != "json" && format != "csv")
+        {
+            utils::Logger::instance().log(utils::LogLevel::WARNING, "IoTAnalytics", "Unsupported export format: " + format);
+            return false;
+        }
+
+        auto filter = [&filters](const char *key, const std::string &value)
+        {
+            auto it = filters.find(key);
+            return it == filters.end() || it->second == value;
+        };
+
+        std::ofstream out(file_path);
+        if (!out)
+        {
+            return false;
+        }
+
+        if (format == "csv")
+        {
+            out << "device_id,metric_name,timestamp,value\n";
+            pimpl_->for_each_series([&](const Series &series)
+                                    {
+                                        if (!filter("device_id", series.device_id) || !filter("metric_name", series.metric_name))
+                                        {
+                                            return;
+                                        }
+                                        for (const auto &[timestamp, value] : series.points())
+                                        {
+                                            out << escape_csv(series.device_id) << ',' << escape_csv(series.metric_name) << ','
+                                                << timestamp << ',' << value << '\n';
+                                        } });
+            return static_cast<bool>(out);
+        }
+
+        json document;
+        document["series"] = json::array();
+        pimpl_->for_each_series([&](const Series &series)
+                                {
+                                    if (!filter("device_id", series.device_id) || !filter("metric_name", series.metric_name))
+                                    {
+                                        return;
+                                    }
+                                    json entry;
+                                    entry["device_id"] = series.device_id;
+                                    entry["metric_name"] = series.metric_name;
+                                    entry["count"] = series.count;
+                                    entry["mean"] = series.mean;
+                                    entry["std_dev"] = series.std_dev();
+                                    entry["anomalies"] = series.anomalies;
+                                    entry["points"] = json::array();
+                                    for (const auto &[timestamp, value] : series.points())
+                                    {
+                                        entry["points"].push_back({timestamp, value});
+                                    }
+                                    document["series"].push_back(std::move(entry)); });
+
+        document["anomalies"] = json::array();
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->anomalies_mutex_);
+            for (const auto &anomaly : pimpl_->anomalies_)
+            {
+                if (!filter("device_id", anomaly.device_id))
+                {
+                    continue;
+                }
+                document["anomalies"].push_back({{"device_id", anomaly.device_id},
+                                                 {"type", anomaly_type_to_string(anomaly.result.type)},
+                                                 {"description", anomaly.result.description},
+                                                 {"confidence", anomaly.result.confidence_score},
+                                                 {"severity", anomaly.result.severity_level},
+                                                 {"detection_time", anomaly.result.detection_time}});
+            }
+        }
+
+        out << document.dump(2);
+        return static_cast<bool>(out);
+    }
+
+    uint32_t IoTAnalytics::import_historical_data(const std::string &file_path,
+                                                  const std::string &format)
+    {
+        std::ifstream in(file_path);
+        if (!in || (format != "json" && format != "csv"))
+        {
+            return 0;
+        }
+
+        std::vector<DataPoint> points;
+        auto add = [&points](const std::string &device_id, const std::string &metric_name, uint64_t timestamp, double value)
+        {
+            DataPoint point;
+            point.device_id = device_id;
+            point.metric_name = metric_name;
+            point.timestamp = timestamp;
+            point.value = value;
+            points.push_back(std::move(point));
+        };
+
+        if (format == "csv")
+        {
+            std::string line;
+            std::getline(in, line); // header
+            while (std::getline(in, line))
+            {
+                std::vector<std::string> fields;
+                std::stringstream row(line);
+                std::string field;
+                while (std::getline(row, field, ','))
+                {
+                    fields.push_back(field);
+                }
+                double timestamp = 0.0, value = 0.0;
+                if (fields.size() == 4 && parse_number(fields[2], timestamp) && parse_number(fields[3], value))
+                {
+                    add(fields[0], fields[1], static_cast<uint64_t>(timestamp), value);
+                }
+            }
+        }
+        else
+        {
+            std::stringstream buffer;
+            buffer << in.rdbuf();
+            auto document = json::parse(buffer.str(), nullptr, false);
+
+            // Either this engine's export or a plain array of points
+            if (document.is_object() && document.contains("series") && document["series"].is_array())
+            {
+                for (const auto &series : document["series"])
+                {
+                    const std::string device_id = series.value("device_id", "");
+                    const std::string metric_name = series.value("metric_name", "");
+                    if (!series.contains("points") || !series["points"].is_array())
+                    {
+                        continue;
+                    }
+                    for (const auto &point : series["points"])
+                    {
+                        if (point.is_array() && point.size() == 2 && point[0].is_number() && point[1].is_number())
+                        {
+                            add(device_id, metric_name, point[0].get<uint64_t>(), point[1].get<double>());
+                        }
+                    }
+                }
+            }
+            else if (document.is_array())
+            {
+                for (const auto &point : document)
+                {
+                    if (point.is_object() && point.contains("value") && point["value"].is_number())
+                    {
+                        add(point.value("device_id", ""), point.value("metric_name", ""),
+                            point.value("timestamp", uint64_t(0)), point["value"].get<double>());
+                    }
+                }
+            }
+        }
+
+        return ingest_data_batch(points);
+    }
+
+    uint32_t IoTAnalytics::clear_analytics_data(uint32_t older_than_days)
+    {
+        uint32_t cleared = 0;
+        if (older_than_days == 0)
+        {
+            for (auto &shard : pimpl_->shards_)
+            {
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                for (const auto &[key, series] : shard.series)
+                {
+                    cleared += static_cast<uint32_t>(series->size);
+                }
+                shard.series.clear();
+            }
+            std::lock_guard<std::mutex> lock(pimpl_->anomalies_mutex_);
+            pimpl_->anomalies_.clear();
+            return cleared;
+        }
+
+        const uint64_t age = static_cast<uint64_t>(older_than_days) * 86400;
+        const uint64_t now = now_seconds();
+        const uint64_t cutoff = now > age ? now - age : 0;
+        for (auto &shard : pimpl_->shards_)
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            for (auto &[key, series] : shard.series)
+            {
+                cleared += static_cast<uint32_t>(series->trim(cutoff));
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(pimpl_->anomalies_mutex_);
+        auto &anomalies = pimpl_->anomalies_;
+        anomalies.erase(std::remove_if(anomalies.begin(), anomalies.end(), [cutoff](const auto &entry)
+                                       { return entry.result.detection_time < cutoff; }),
+                        anomalies.end());
+        return cleared;
+    }
+
+    std::map<std::string, uint64_t> IoTAnalytics::get_statistics() const
+    {
+        uint64_t series_count = 0;
+        uint64_t buffered = 0;
+        std::set<std::string> devices;
+        pimpl_->for_each_series([&](const Series &series)
+                                {
+                                    series_count++;
+                                    buffered += series.size;
+                                    devices.insert(series.device_id); });
+
+        std::map<std::string, uint64_t> stats;
+        stats["data_points_ingested"] = pimpl_->points_ingested_;
+        stats["data_points_rejected"] = pimpl_->points_rejected_;
+        stats["batches_ingested"] = pimpl_->batches_ingested_;
+        stats["anomalies_detected"] = pimpl_->anomalies_detected_;
+        stats["forecasts_generated"] = pimpl_->forecasts_generated_;
+        stats["series_tracked"] = series_count;
+        stats["devices_tracked"] = devices.size();
+        stats["points_buffered"] = buffered;
+        return stats;
+    }
+
+    std::string anomaly_type_to_string(AnomalyType type)
+    {
+        switch (type)
+        {
+        case AnomalyType::STATISTICAL_OUTLIER:
+            return "statistical_outlier";
+        case AnomalyType::PATTERN_BREAK:
+            return "pattern_break";
+        case AnomalyType::THRESHOLD_VIOLATION:
+            return "threshold_violation";
+        case AnomalyType::TEMPORAL_ANOMALY:
+            return "temporal_anomaly";
+        case AnomalyType::CORRELATION_BREAK:
+            return "correlation_break";
+        case AnomalyType::PREDICTIVE_DEVIATION:
+            return "predictive_deviation";
+        default:
+            return "unknown";
+        }
+    }
+
+    std::string time_granularity_to_string(TimeGranularity granularity)
+    {
+        switch (granularity)
+        {
+        case TimeGranularity::REAL_TIME:
+            return "real_time";
+        case TimeGranularity::SECOND:
+            return "second";
+        case TimeGranularity::MINUTE:
+            return "minute";
+        case TimeGranularity::HOUR:
+            return "hour";
+        case TimeGranularity::DAY:
+            return "day";
+        case TimeGranularity::WEEK:
+            return "week";
+        case TimeGranularity::MONTH:
+            return "month";
+        default:
+            return "unknown";
+        }
+    }
+
+    std::map<std::string, double> calculate_statistics(const std::vector<double> &values)
+    {
+        std::map<std::string, double> stats;
+        stats["count"] = static_cast<double>(values.size());
+        if (values.empty())
+        {
+            return stats;
+        }
+
+        std::vector<double> sorted = values;
+        std::sort(sorted.begin(), sorted.end());
+        const double sum = std::accumulate(sorted.begin(), sorted.end(), 0.0);
+        const double mean = sum / static_cast<double>(sorted.size());
+        double squares = 0.0;
+        for (double value : sorted)
+        {
+            squares += (value - mean) * (value - mean);
+        }
+        const double variance = sorted.size() > 1 ? squares / static_cast<double>(sorted.size() - 1) : 0.0;
+
+        stats["sum"] = sum;
+        stats["mean"] = mean;
+        stats["variance"] = variance;
+        stats["std"] = std::sqrt(variance);
+        stats["min"] = sorted.front();
+        stats["max"] = sorted.back();
+        stats["range"] = sorted.back() - sorted.front();
+        stats["median"] = sorted_quantile(sorted, 0.5);
+        stats["q1"] = sorted_quantile(sorted, 0.25);
+        stats["q3"] = sorted_quantile(sorted, 0.75);
+        return stats;
+    }
+
+    std::vector<size_t> detect_outliers_iqr(const std::vector<double> &values, double multiplier)
+    {
+        std::vector<size_t> outliers;
+        if (values.size() < 4)
+        {
+            return outliers;
+        }
+
+        std::vector<double> sorted = values;
+        std::sort(sorted.begin(), sorted.end());
+        const double q1 = sorted_quantile(sorted, 0.25);
+        const double q3 = sorted_quantile(sorted, 0.75);
+        const double iqr = q3 - q1;
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            if (values[i] < q1 - multiplier * iqr || values[i] > q3 + multiplier * iqr)
+            {
+                outliers.push_back(i);
+            }
+        }
+        return outliers;
+    }
+
+    std::vector<double> normalize_time_series(const std::vector<double> &values, const std::string &method)
+    {
+        std::vector<double> out(values.size(), 0.0);
+        if (values.empty())
+        {
+            return out;
+        }
+
+        const auto stats = calculate_statistics(values);
+        double center = 0.0;
+        double scale = 0.0;
+        if (method == "minmax")
+        {
+            center = stats.at("min");
+            scale = stats.at("range");
+        }
+        else if (method == "zscore")
+        {
+            center = stats.at("mean");
+            scale = stats.at("std");
+        }
+        else if (method == "robust")
+        {
+            center = stats.at("median");
+            scale = stats.at("q3") - stats.at("q1");
+        }
+        else
+        {
+            return values;
+        }
+
+        if (scale > 0.0)
+        {
+            for (size_t i = 0; i < values.size(); ++i)
+            {
+                out[i] = (values[i] - center) / scale;
+            }
+        }
+        return out;
+    }
+
+} // namespace cardano_iot::analytics
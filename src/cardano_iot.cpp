@@ -9,10 +9,16 @@
 #include "cardano_iot/cardano_iot.h"
 #include "cardano_iot/utils/logger.h"
 #include "cardano_iot/utils/config.h"
+#include "cardano_iot/utils/codec.h"
+#include "cardano_iot/utils/metrics.h"
+#include "cardano_iot/energy/power_aware_outbox.h"
 #include "cardano_iot/network/network_utils.h"
+#include "cardano_iot/network/cluster.h"
+#include "cardano_iot/performance/performance_optimizer.h"
 
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <chrono>
 #include <random>
 #include <unordered_map>
@@ -22,9 +28,171 @@
 #include <algorithm>
 #include <stdexcept>
 #include <cmath>
+#include <deque>
+#include <thread>
+#include <condition_variable>
+
+#include <openssl/sha.h>
+#include <nlohmann/json.hpp>
 
 namespace cardano_iot
 {
+    namespace
+    {
+        using json = nlohmann::json;
+
+        // Cluster request bodies are JSON; bytes that are not UTF-8 are replaced instead of throwing
+        std::string to_wire(const json &value)
+        {
+            return value.dump(-1, ' ', false, json::error_handler_t::replace);
+        }
+
+        bool read_string(const json &object, const char *key, std::string &out)
+        {
+            auto it = object.find(key);
+            if (it == object.end() || !it->is_string())
+            {
+                return false;
+            }
+            out = it->get<std::string>();
+            return true;
+        }
+
+        bool read_uint(const json &object, const char *key, uint64_t &out)
+        {
+            auto it = object.find(key);
+            if (it == object.end() || !it->is_number_unsigned())
+            {
+                return false;
+            }
+            out = it->get<uint64_t>();
+            return true;
+        }
+
+        // Payloads travel as base64, so binary payloads survive the trip
+        json reading_to_json(const CardanoIoTSDK::IoTData &data)
+        {
+            std::string payload(utils::codec::base64_encoded_size(data.payload.size()), '\0');
+            payload.resize(utils::codec::base64_encode(reinterpret_cast<const uint8_t *>(data.payload.data()),
+                                                       data.payload.size(), payload.data()));
+            json metadata = json::object();
+            for (const auto &[key, value] : data.metadata)
+            {
+                metadata[key] = value;
+            }
+            return {{"device_id", data.device_id},
+                    {"data_type", data.data_type},
+                    {"payload", std::move(payload)},
+                    {"timestamp", data.timestamp},
+                    {"signature", data.signature},
+                    {"hash", data.hash},
+                    {"metadata", std::move(metadata)}};
+        }
+
+        bool reading_from_json(const json &value, CardanoIoTSDK::IoTData &data)
+        {
+            std::string payload;
+            if (!value.is_object() || !read_string(value, "device_id", data.device_id) ||
+                !read_string(value, "data_type", data.data_type) || !read_string(value, "payload", payload) ||
+                !read_uint(value, "timestamp", data.timestamp) || !read_string(value, "signature", data.signature) ||
+                !read_string(value, "hash", data.hash))
+            {
+                return false;
+            }
+            data.payload.assign(utils::codec::base64_decoded_max_size(payload.size()), '\0');
+            const size_t size = utils::codec::base64_decode(payload.data(), payload.size(),
+                                                            reinterpret_cast<uint8_t *>(data.payload.data()));
+            if (size == std::string::npos || size == 0)
+            {
+                return false;
+            }
+            data.payload.resize(size);
+
+            data.metadata.clear();
+            auto metadata = value.find("metadata");
+            if (metadata != value.end() && metadata->is_object())
+            {
+                for (auto it = metadata->begin(); it != metadata->end(); ++it)
+                {
+                    if (it->is_string())
+                    {
+                        data.metadata[it.key()] = it->get<std::string>();
+                    }
+                }
+            }
+            return true;
+        }
+
+        bool readings_from_json(const json &value, std::vector<CardanoIoTSDK::IoTData> &readings)
+        {
+            if (!value.is_array())
+            {
+                return false;
+            }
+            readings.resize(value.size());
+            for (size_t i = 0; i < value.size(); ++i)
+            {
+                if (!reading_from_json(value[i], readings[i]))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // Registration fields only; the receiving node sets status, times and the address
+        json device_to_json(const core::Device &device)
+        {
+            json metadata = json::object();
+            for (const auto &[key, value] : device.metadata)
+            {
+                metadata[key] = value;
+            }
+            return {{"device_id", device.device_id},
+                    {"device_type", device.device_type},
+                    {"manufacturer", device.manufacturer},
+                    {"model", device.model},
+                    {"firmware_version", device.firmware_version},
+                    {"hardware_revision", device.hardware_revision},
+                    {"public_key", device.public_key},
+                    {"capabilities", device.capabilities},
+                    {"low_power_mode", device.low_power_mode},
+                    {"location", device.location},
+                    {"metadata", std::move(metadata)}};
+        }
+
+        bool device_from_json(const json &value, core::Device &device)
+        {
+            uint64_t capabilities = 0;
+            if (!value.is_object() || !read_string(value, "device_id", device.device_id) ||
+                !read_string(value, "public_key", device.public_key) ||
+                !read_uint(value, "capabilities", capabilities))
+            {
+                return false;
+            }
+            read_string(value, "device_type", device.device_type);
+            read_string(value, "manufacturer", device.manufacturer);
+            read_string(value, "model", device.model);
+            read_string(value, "firmware_version", device.firmware_version);
+            read_string(value, "hardware_revision", device.hardware_revision);
+            read_string(value, "location", device.location);
+            device.capabilities = static_cast<uint32_t>(capabilities);
+            auto low_power = value.find("low_power_mode");
+            device.low_power_mode = low_power != value.end() && low_power->is_boolean() && low_power->get<bool>();
+            auto metadata = value.find("metadata");
+            if (metadata != value.end() && metadata->is_object())
+            {
+                for (auto it = metadata->begin(); it != metadata->end(); ++it)
+                {
+                    if (it->is_string())
+                    {
+                        device.metadata[it.key()] = it->get<std::string>();
+                    }
+                }
+            }
+            return true;
+        }
+    } // namespace
 
     // PIMPL implementation for CardanoIoTSDK
     class CardanoIoTSDK::Impl
@@ -37,60 +205,1352 @@ namespace cardano_iot
         std::unique_ptr<core::DeviceManager> device_manager_;
         std::unique_ptr<energy::PowerManager> power_manager_;
         std::unique_ptr<utils::Config> config_manager_;
+        std::shared_ptr<utils::Executor> executor_;
+
+        // Event callbacks
+        DeviceEventCallback device_event_callback_;
+        DataEventCallback data_event_callback_;
+        TransactionEventCallback transaction_event_callback_;
+        DataBatchEventCallback data_batch_event_callback_;
+
+        // Time-indexed storage of submitted readings
+        data::TimeSeriesStore data_store_;
+        std::unique_ptr<data::PayloadCodec> payload_codec_; // Set when a payload encoding is configured
+
+        // Gateway cluster; set when Config::cluster_enabled
+        std::unique_ptr<network::GatewayCluster> cluster_;
+        std::mutex rebalance_mutex_; // One shard handoff at a time
+        // Devices frozen for the last step of a handoff -> their new owner. commit_local holds the
+        // lock shared from its registration check to its store write, so a freeze waits for it
+        std::shared_mutex moving_mutex_;
+        std::unordered_map<std::string, std::string> moving_;
+        std::atomic<bool> leaving_cluster_{false}; // Set once a departing node starts handing off its share
+
+        // Mock data for demo purposes
+        std::unordered_map<std::string, uint64_t> device_balances_;
+        std::unordered_map<std::string, std::string> deployed_contracts_;
+
+        mutable std::mutex data_mutex_;
+
+        // Statistics
+        std::atomic<uint64_t> total_transactions_{0};
+        std::atomic<uint64_t> total_data_submissions_{0};
+        std::atomic<uint64_t> total_contracts_deployed_{0};
+
+        // Asynchronous ingestion pipeline: enqueue -> (worker) hash -> commit
+        struct QueuedReading
+        {
+            IoTData data;
+            std::unique_ptr<utils::Promise<std::string>> result; // Set by submit_data_async
+        };
+        std::deque<QueuedReading> ingestion_queue_;
+        mutable std::mutex ingestion_mutex_;
+        std::condition_variable ingestion_cv_;
+        std::condition_variable ingestion_idle_cv_;
+        std::thread ingestion_thread_;
+        bool ingestion_running_ = false;
+        bool ingestion_flush_requested_ = false;
+        size_t ingestion_in_flight_ = 0;
+        std::atomic<uint32_t> ingestion_batch_size_{512}; // Live copy of config_.ingestion_batch_size
+
+        // Operations held by the power-aware outbox, by ticket
+        struct OutboundOperation
+        {
+            IoTData data;
+            uint64_t lovelace = 0; // Non-zero for an ADA transfer
+        };
+        std::unordered_map<uint64_t, OutboundOperation> outbound_;
+        std::mutex outbound_mutex_;
+        uint64_t next_ticket_ = 1;
+        std::unique_ptr<energy::PowerAwareOutbox> outbox_; // Created by the first queued operation
+        std::mutex outbox_mutex_;
+
+        // Startup time of each subsystem, including the lazily started ones
+        std::map<std::string, std::unique_ptr<utils::metrics::Gauge>> startup_gauges_;
+        mutable std::mutex startup_mutex_;
+
+        ~Impl()
+        {
+            outbox_.reset();
+            stop_ingestion();
+        }
+
+        std::string transfer_ada(const std::string &device_id, uint64_t amount)
+        {
+            // Mock ADA transfer
+            std::string tx_id = generate_mock_tx_id();
+
+            {
+                std::lock_guard<std::mutex> lock(data_mutex_);
+                device_balances_[device_id] += amount;
+            }
+
+            total_transactions_++;
+
+            utils::Logger::instance().log(utils::LogLevel::INFO, "CardanoIoTSDK",
+                                          "ADA transfer: " + std::to_string(amount) + " lovelace to " + device_id);
+
+            return tx_id;
+        }
+
+        // Outbox flush: one device's held operations go out as a single batch
+        void send_outbound(const std::vector<uint64_t> &tickets)
+        {
+            std::vector<OutboundOperation> operations;
+            operations.reserve(tickets.size());
+            {
+                std::lock_guard<std::mutex> lock(outbound_mutex_);
+                for (uint64_t ticket : tickets)
+                {
+                    auto it = outbound_.find(ticket);
+                    if (it != outbound_.end())
+                    {
+                        operations.push_back(std::move(it->second));
+                        outbound_.erase(it);
+                    }
+                }
+            }
+
+            std::vector<IoTData> readings;
+            for (auto &operation : operations)
+            {
+                if (operation.lovelace > 0)
+                {
+                    notify_transaction_event(transfer_ada(operation.data.device_id, operation.lovelace), true);
+                }
+                else
+                {
+                    readings.push_back(std::move(operation.data));
+                }
+            }
+            commit_batch(std::move(readings));
+        }
+
+        bool hold(energy::PowerAwareOutbox &outbox, OutboundOperation &&operation, const std::string &tx_type,
+                  uint32_t max_delay_ms)
+        {
+            const std::string device_id = operation.data.device_id;
+            const auto size = static_cast<uint32_t>(operation.data.payload.size());
+            uint64_t ticket = 0;
+            {
+                std::lock_guard<std::mutex> lock(outbound_mutex_);
+                ticket = next_ticket_++;
+                outbound_.emplace(ticket, std::move(operation));
+            }
+            outbox.enqueue(ticket, device_id, tx_type, size, max_delay_ms);
+            return true;
+        }
+
+        /**
+         * @brief The power-aware outbox, started on first use when power management is on
+         * @param create Start it if it is not running yet
+         * @return nullptr when power management is off (or create is false and it never started)
+         */
+        energy::PowerAwareOutbox *outbox(bool create)
+        {
+            std::lock_guard<std::mutex> lock(outbox_mutex_);
+            if (!outbox_ && create && config_.enable_power_management && power_manager_)
+            {
+                const auto start = std::chrono::steady_clock::now();
+                energy::PowerAwareOutbox::Options options;
+                options.poll_interval_ms = config_.outbox_poll_interval_ms;
+                options.max_batch_operations = config_.outbox_max_batch;
+                outbox_ = std::make_unique<energy::PowerAwareOutbox>(
+                    *power_manager_,
+                    [this](const std::string &, std::vector<uint64_t> &&tickets, energy::FlushReason)
+                    { send_outbound(tickets); },
+                    options);
+                record_startup("outbox", start);
+            }
+            return outbox_.get();
+        }
+
+        /**
+         * @brief Publish how long a subsystem took to start, in microseconds
+         */
+        void record_startup(const std::string &subsystem, std::chrono::steady_clock::time_point start)
+        {
+            const auto micros = std::chrono::duration_cast<std::chrono::microseconds>(
+                                    std::chrono::steady_clock::now() - start)
+                                    .count();
+            std::lock_guard<std::mutex> lock(startup_mutex_);
+            auto &gauge = startup_gauges_[subsystem];
+            if (!gauge)
+            {
+                gauge = std::make_unique<utils::metrics::Gauge>("cardano_iot_sdk_startup_microseconds",
+                                                                "Time each SDK subsystem took to start",
+                                                                utils::metrics::Labels{{"subsystem", subsystem}});
+            }
+            gauge->set(micros);
+        }
+
+        std::string generate_mock_tx_id()
+        {
+            static std::random_device rd;
+            static std::mt19937 gen(rd());
+            static std::uniform_int_distribution<> dis(0, 15);
+
+            std::stringstream ss;
+            ss << "tx_";
+            for (int i = 0; i < 64; ++i)
+            {
+                ss << std::hex << dis(gen);
+            }
+            return ss.str();
+        }
+
+        std::string generate_mock_contract_address()
+        {
+            static std::random_device rd;
+            static std::mt19937 gen(rd());
+            static std::uniform_int_distribution<> dis(0, 15);
+
+            std::stringstream ss;
+            ss << "addr_test1";
+            for (int i = 0; i < 56; ++i)
+            {
+                ss << std::hex << dis(gen);
+            }
+            return ss.str();
+        }
+
+        static std::string generate_batch_tx_id()
+        {
+            static const char hex_digits[] = "0123456789abcdef";
+            thread_local std::mt19937_64 tx_id_rng{std::random_device{}()};
+
+            std::string tx_id(3 + 64, '0');
+            tx_id[0] = 't';
+            tx_id[1] = 'x';
+            tx_id[2] = '_';
+            for (int word = 0; word < 4; ++word)
+            {
+                uint64_t bits = tx_id_rng();
+                for (int nibble = 0; nibble < 16; ++nibble)
+                {
+                    tx_id[3 + word * 16 + nibble] = hex_digits[bits & 0xF];
+                    bits >>= 4;
+                }
+            }
+            return tx_id;
+        }
+
+        static bool is_valid_data(const IoTData &data)
+        {
+            return !data.device_id.empty() && !data.payload.empty();
+        }
+
+        static constexpr size_t HASH_CHUNK = 128; // Readings per executor hashing task
+
+        static std::string compute_payload_hash(const std::string &payload)
+        {
+            unsigned char digest[SHA256_DIGEST_LENGTH];
+            SHA256(reinterpret_cast<const unsigned char *>(payload.data()), payload.size(), digest);
+
+            std::string hex(utils::codec::hex_encoded_size(SHA256_DIGEST_LENGTH), '\0');
+            utils::codec::hex_encode(digest, SHA256_DIGEST_LENGTH, hex.data());
+            return hex;
+        }
+
+        /**
+         * Commit a batch of readings, forwarding those of devices owned by other
+         * cluster nodes in one request per node.
+         */
+        std::vector<std::string> commit_batch(std::vector<IoTData> &&batch)
+        {
+            if (!cluster_)
+            {
+                return commit_local(std::move(batch), true);
+            }
+
+            std::map<std::string, std::vector<size_t>> remote; // Owner -> batch indices
+            std::vector<size_t> local;
+            const std::string *last_device = nullptr;
+            std::string last_owner;
+            for (size_t i = 0; i < batch.size(); ++i)
+            {
+                if (!last_device || *last_device != batch[i].device_id)
+                {
+                    last_device = &batch[i].device_id;
+                    last_owner = remote_owner(batch[i].device_id);
+                }
+                if (last_owner.empty())
+                {
+                    local.push_back(i);
+                }
+                else
+                {
+                    remote[last_owner].push_back(i);
+                }
+            }
+            if (remote.empty())
+            {
+                return commit_local(std::move(batch), true);
+            }
+
+            std::vector<std::string> tx_ids(batch.size());
+            for (const auto &[node, indices] : remote)
+            {
+                json readings = json::array();
+                for (size_t i : indices)
+                {
+                    readings.push_back(reading_to_json(batch[i]));
+                }
+                auto remote_ids = submit_remote(node, readings);
+                for (size_t k = 0; k < indices.size() && k < remote_ids.size(); ++k)
+                {
+                    tx_ids[indices[k]] = std::move(remote_ids[k]);
+                }
+            }
+            if (!local.empty())
+            {
+                std::vector<IoTData> local_batch;
+                local_batch.reserve(local.size());
+                for (size_t i : local)
+                {
+                    local_batch.push_back(std::move(batch[i]));
+                }
+                auto local_ids = commit_local(std::move(local_batch), true);
+                for (size_t k = 0; k < local.size(); ++k)
+                {
+                    tx_ids[local[k]] = std::move(local_ids[k]);
+                }
+            }
+            return tx_ids;
+        }
+
+        /**
+         * Validate, hash and commit a batch of readings on this node. The
+         * registration check runs once per distinct device, data_mutex_ is taken
+         * once, and a single log line and callback dispatch cover the whole batch.
+         * parallel_hash spreads hashing over the executor; requests served for
+         * other nodes already run on it and hash inline. Readings of a device
+         * frozen mid-handoff go to its new owner instead, so none land here after
+         * the final copy.
+         */
+        std::vector<std::string> commit_local(std::vector<IoTData> &&batch, bool parallel_hash)
+        {
+            std::vector<std::string> tx_ids(batch.size());
+            if (batch.empty())
+            {
+                return tx_ids;
+            }
+
+            // Validate, then hash the accepted readings on the executor
+            std::shared_lock<std::shared_mutex> moving_lock(moving_mutex_);
+            std::vector<uint8_t> accepted(batch.size(), 0);
+            std::unordered_map<std::string, bool> registered;
+            std::map<std::string, std::vector<size_t>> forwarded; // New owner -> batch indices
+            const std::string *last_device = nullptr;
+            const std::string *last_moving_to = nullptr;
+            bool last_registered = false;
+            size_t accepted_count = 0;
+
+            for (size_t i = 0; i < batch.size(); ++i)
+            {
+                auto &data = batch[i];
+                if (!is_valid_data(data))
+                {
+                    continue;
+                }
+
+                if (!last_device || *last_device != data.device_id)
+                {
+                    auto it = registered.find(data.device_id);
+                    if (it == registered.end())
+                    {
+                        it = registered.emplace(data.device_id,
+                                                device_manager_->is_device_registered(data.device_id))
+                                 .first;
+                    }
+                    last_device = &it->first;
+                    last_registered = it->second;
+                    auto moving = moving_.find(data.device_id);
+                    last_moving_to = moving != moving_.end() ? &moving->second : nullptr;
+                }
+                if (last_moving_to)
+                {
+                    forwarded[*last_moving_to].push_back(i);
+                    continue;
+                }
+                if (!last_registered)
+                {
+                    continue;
+                }
+
+                accepted[i] = 1;
+                ++accepted_count;
+            }
+
+            auto hash = [&](size_t i)
+            {
+                if (accepted[i] && batch[i].hash.empty())
+                {
+                    batch[i].hash = compute_payload_hash(batch[i].payload);
+                }
+            };
+            if (executor_ && parallel_hash)
+            {
+                executor_->parallel_for(batch.size(), hash, HASH_CHUNK);
+            }
+            else
+            {
+                for (size_t i = 0; i < batch.size(); ++i)
+                {
+                    hash(i);
+                }
+            }
+
+            // Encode payloads before taking the store's write lock
+            std::vector<std::string> encoded_payloads;
+            if (payload_codec_ && accepted_count > 0)
+            {
+                encoded_payloads.resize(batch.size());
+                for (size_t i = 0; i < batch.size(); ++i)
+                {
+                    if (accepted[i])
+                    {
+                        payload_codec_->encode(batch[i].device_id, batch[i].data_type, batch[i].payload,
+                                               encoded_payloads[i]);
+                    }
+                }
+            }
+
+            // Entry fields are moved into storage unless a listener still needs them
+            const bool notify_batch = static_cast<bool>(data_batch_event_callback_);
+            const bool notify_items = !notify_batch && (data_event_callback_ || transaction_event_callback_);
+            const bool keep_entries = notify_batch || notify_items;
+
+            // Commit
+            if (accepted_count > 0)
+            {
+                auto writer = data_store_.writer();
+                for (size_t i = 0; i < batch.size(); ++i)
+                {
+                    if (!accepted[i])
+                    {
+                        continue;
+                    }
+
+                    tx_ids[i] = generate_batch_tx_id();
+
+                    auto &data = batch[i];
+                    data::TimeSeriesStore::Entry entry;
+                    entry.timestamp = data.timestamp;
+                    entry.data_type = data.data_type;
+                    entry.payload = encoded_payloads.empty() || encoded_payloads[i].empty()
+                                        ? std::string_view(data.payload)
+                                        : std::string_view(encoded_payloads[i]);
+                    if (keep_entries)
+                    {
+                        entry.hash = data.hash;
+                        entry.signature = data.signature;
+                        entry.metadata = data.metadata;
+                    }
+                    else
+                    {
+                        entry.hash = std::move(data.hash);
+                        entry.signature = std::move(data.signature);
+                        entry.metadata = std::move(data.metadata);
+                    }
+                    writer.append(data.device_id, std::move(entry));
+                }
+            }
+            moving_lock.unlock();
+
+            size_t forwarded_count = 0;
+            for (const auto &[node, indices] : forwarded)
+            {
+                json readings = json::array();
+                for (size_t i : indices)
+                {
+                    readings.push_back(reading_to_json(batch[i]));
+                }
+                auto remote_ids = submit_remote(node, readings);
+                for (size_t k = 0; k < indices.size() && k < remote_ids.size(); ++k)
+                {
+                    forwarded_count += remote_ids[k].empty() ? 0 : 1;
+                    tx_ids[indices[k]] = std::move(remote_ids[k]);
+                }
+            }
+
+            total_data_submissions_ += accepted_count;
+            total_transactions_ += accepted_count;
+
+            if (accepted_count + forwarded_count < batch.size())
+            {
+                utils::Logger::instance().log(utils::LogLevel::WARNING, "CardanoIoTSDK",
+                                              "Data batch rejected " +
+                                                  std::to_string(batch.size() - accepted_count - forwarded_count) +
+                                                  " of " + std::to_string(batch.size()) +
+                                                  " entries (invalid or unregistered device)");
+            }
+            utils::Logger::instance().log(utils::LogLevel::INFO, "CardanoIoTSDK",
+                                          "Data batch submitted: " + std::to_string(accepted_count) + " entries");
+
+            // Notify callbacks
+            if (notify_batch && accepted_count > 0)
+            {
+                if (accepted_count == batch.size())
+                {
+                    data_batch_event_callback_(batch, tx_ids);
+                }
+                else
+                {
+                    std::vector<IoTData> committed;
+                    std::vector<std::string> committed_ids;
+                    committed.reserve(accepted_count);
+                    committed_ids.reserve(accepted_count);
+                    for (size_t i = 0; i < batch.size(); ++i)
+                    {
+                        if (accepted[i])
+                        {
+                            committed.push_back(std::move(batch[i]));
+                            committed_ids.push_back(tx_ids[i]);
+                        }
+                    }
+                    data_batch_event_callback_(committed, committed_ids);
+                }
+            }
+            else if (notify_items)
+            {
+                for (size_t i = 0; i < batch.size(); ++i)
+                {
+                    if (accepted[i])
+                    {
+                        notify_data_event(batch[i]);
+                        notify_transaction_event(tx_ids[i], true);
+                    }
+                }
+            }
+
+            return tx_ids;
+        }
+
+        // Opens the queue; the worker thread starts with the first queued reading
+        void start_ingestion()
+        {
+            std::lock_guard<std::mutex> lock(ingestion_mutex_);
+            ingestion_running_ = true;
+        }
+
+        // Called with ingestion_mutex_ held
+        void ensure_ingestion_worker()
+        {
+            if (ingestion_thread_.joinable())
+            {
+                return;
+            }
+            const auto start = std::chrono::steady_clock::now();
+            ingestion_thread_ = std::thread([this]()
+                                            { ingestion_loop(); });
+            record_startup("ingestion", start);
+        }
+
+        // Drains whatever is still queued before the worker exits
+        void stop_ingestion()
+        {
+            {
+                std::lock_guard<std::mutex> lock(ingestion_mutex_);
+                ingestion_running_ = false;
+            }
+            ingestion_cv_.notify_all();
+            if (ingestion_thread_.joinable())
+            {
+                ingestion_thread_.join();
+            }
+        }
+
+        /**
+         * @brief Queue a validated reading; result (if any) is kept only when queued
+         */
+        bool enqueue(IoTData &&data, std::unique_ptr<utils::Promise<std::string>> &&result)
+        {
+            if (!initialized_ || !is_valid_data(data))
+            {
+                return false;
+            }
+
+            size_t depth = 0;
+            {
+                std::lock_guard<std::mutex> lock(ingestion_mutex_);
+                if (!ingestion_running_ || ingestion_queue_.size() >= config_.ingestion_queue_capacity)
+                {
+                    return false;
+                }
+                ensure_ingestion_worker();
+                ingestion_queue_.push_back({std::move(data), std::move(result)});
+                depth = ingestion_queue_.size();
+            }
+
+            // Wake the worker when it is idle or a full batch is ready
+            if (depth == 1 || depth >= ingestion_batch_size_.load(std::memory_order_relaxed))
+            {
+                ingestion_cv_.notify_one();
+            }
+            return true;
+        }
+
+        /**
+         * @brief Run an SDK call on the shared executor; "" when the SDK is not running
+         */
+        template <typename Fn>
+        utils::Future<std::string> run_async(Fn fn)
+        {
+            if (!initialized_ || !executor_)
+            {
+                return utils::Executor::make_ready(std::string());
+            }
+            return executor_->submit(std::move(fn), utils::TaskPriority::CRITICAL);
+        }
+
+        /**
+         * @brief Deliver a future's result to a callback on the executor
+         */
+        void deliver(const utils::Future<std::string> &future, AsyncResultCallback callback)
+        {
+            if (!callback)
+            {
+                return;
+            }
+            auto executor = executor_;
+            future.on_ready([future, executor, callback]
+                            {
+                                auto task = [future, callback]
+                                { callback(future.get()); };
+                                if (!executor || !executor->post(task, utils::TaskPriority::CRITICAL))
+                                {
+                                    task();
+                                } });
+        }
+
+        void ingestion_loop()
+        {
+            const auto flush_interval = std::chrono::milliseconds(config_.ingestion_flush_interval_ms);
+
+            std::unique_lock<std::mutex> lock(ingestion_mutex_);
+            while (true)
+            {
+                const size_t batch_size = std::max<uint32_t>(1, ingestion_batch_size_.load(std::memory_order_relaxed));
+                ingestion_cv_.wait_for(lock, std::chrono::seconds(1), [this]()
+                                       { return !ingestion_running_ || !ingestion_queue_.empty(); });
+
+                // Give a partial batch a bounded chance to fill up
+                if (ingestion_running_ && ingestion_queue_.size() < batch_size && !ingestion_flush_requested_)
+                {
+                    ingestion_cv_.wait_for(lock, flush_interval, [this]()
+                                           { return !ingestion_running_ || ingestion_flush_requested_ ||
+                                                    ingestion_queue_.size() >= ingestion_batch_size_.load(std::memory_order_relaxed); });
+                }
+
+                if (ingestion_queue_.empty())
+                {
+                    if (!ingestion_running_)
+                    {
+                        break;
+                    }
+                    continue;
+                }
+
+                const size_t count = std::min<size_t>(std::max<uint32_t>(1, ingestion_batch_size_.load(std::memory_order_relaxed)),
+                                                      ingestion_queue_.size());
+                std::vector<IoTData> batch;
+                std::vector<std::unique_ptr<utils::Promise<std::string>>> results;
+                batch.reserve(count);
+                for (size_t i = 0; i < count; ++i)
+                {
+                    auto &queued = ingestion_queue_.front();
+                    batch.push_back(std::move(queued.data));
+                    if (queued.result)
+                    {
+                        results.resize(count);
+                        results[i] = std::move(queued.result);
+                    }
+                    ingestion_queue_.pop_front();
+                }
+                ingestion_in_flight_ += count;
+
+                lock.unlock();
+                const auto tx_ids = commit_batch(std::move(batch));
+                for (size_t i = 0; i < results.size(); ++i)
+                {
+                    if (results[i])
+                    {
+                        results[i]->set_value(tx_ids[i]);
+                    }
+                }
+                lock.lock();
+
+                ingestion_in_flight_ -= count;
+                if (ingestion_queue_.empty() && ingestion_in_flight_ == 0)
+                {
+                    ingestion_flush_requested_ = false;
+                    ingestion_idle_cv_.notify_all();
+                }
+            }
+        }
+
+        void notify_device_event(const std::string &device_id, const std::string &event_type)
+        {
+            if (device_event_callback_)
+            {
+                device_event_callback_(device_id, event_type);
+            }
+        }
+
+        /**
+         * Validate and commit a single reading. When movable is set (it aliases
+         * data) its hash, signature and metadata are moved into storage, unless a
+         * data listener still needs to see them.
+         */
+        std::string submit_one(const IoTData &data, IoTData *movable)
+        {
+            if (!initialized_)
+            {
+                return "";
+            }
+
+            // Validate data
+            if (data.device_id.empty() || data.payload.empty())
+            {
+                utils::Logger::instance().log(utils::LogLevel::ERROR, "CardanoIoTSDK",
+                                              "Invalid data submission: missing required fields");
+                return "";
+            }
+
+            const std::string owner = remote_owner(data.device_id);
+            if (!owner.empty())
+            {
+                json readings = json::array();
+                readings.push_back(reading_to_json(data));
+                return submit_remote(owner, readings).front();
+            }
+
+            // Check if device is registered
+            if (!device_manager_->is_device_registered(data.device_id))
+            {
+                utils::Logger::instance().log(utils::LogLevel::ERROR, "CardanoIoTSDK",
+                                              "Device not registered: " + data.device_id);
+                return "";
+            }
+
+            std::string tx_id = generate_batch_tx_id();
+
+            // Store data (mock blockchain storage)
+            data::TimeSeriesStore::Entry entry;
+            entry.timestamp = data.timestamp;
+            entry.data_type = data.data_type;
+            entry.payload = data.payload;
+            std::string encoded;
+            if (payload_codec_ && payload_codec_->encode(data.device_id, data.data_type, data.payload, encoded))
+            {
+                entry.payload = encoded;
+            }
+            if (movable && !data_event_callback_)
+            {
+                entry.hash = std::move(movable->hash);
+                entry.signature = std::move(movable->signature);
+                entry.metadata = std::move(movable->metadata);
+            }
+            else
+            {
+                entry.hash = data.hash;
+                entry.signature = data.signature;
+                entry.metadata = data.metadata;
+            }
+            data_store_.append(data.device_id, std::move(entry));
+
+            total_data_submissions_++;
+            total_transactions_++;
+
+            CARDANO_IOT_LOG(utils::LogLevel::INFO, "CardanoIoTSDK",
+                            "Data submitted for device " << data.device_id << " with TX: " << tx_id);
+
+            // Notify callbacks
+            notify_data_event(data);
+            notify_transaction_event(tx_id, true);
+
+            return tx_id;
+        }
+
+        static core::Device to_core_device(const DeviceInfo &device_info)
+        {
+            core::Device device;
+            device.device_id = device_info.device_id;
+            device.device_type = device_info.device_type;
+            device.manufacturer = device_info.manufacturer;
+            device.firmware_version = device_info.firmware_version;
+            device.public_key = device_info.public_key;
+            device.low_power_mode = device_info.low_power_mode;
+
+            // Set capabilities
+            device.capabilities = 0;
+            for (const auto &cap : device_info.capabilities)
+            {
+                if (cap == "sensor_data")
+                {
+                    device.capabilities |= static_cast<uint32_t>(core::DeviceCapability::SENSOR_DATA);
+                }
+                else if (cap == "actuator_control")
+                {
+                    device.capabilities |= static_cast<uint32_t>(core::DeviceCapability::ACTUATOR_CONTROL);
+                }
+                else if (cap == "smart_contract" || cap == "smart_contract_execution")
+                {
+                    device.capabilities |= static_cast<uint32_t>(core::DeviceCapability::SMART_CONTRACT_EXECUTION);
+                }
+                else if (cap == "p2p" || cap == "peer_to_peer" || cap == "peer_to_peer_communication")
+                {
+                    device.capabilities |= static_cast<uint32_t>(core::DeviceCapability::PEER_TO_PEER_COMMUNICATION);
+                }
+                else if (cap == "energy_harvesting")
+                {
+                    device.capabilities |= static_cast<uint32_t>(core::DeviceCapability::ENERGY_HARVESTING);
+                }
+                else if (cap == "crypto" || cap == "cryptographic_operations")
+                {
+                    device.capabilities |= static_cast<uint32_t>(core::DeviceCapability::CRYPTOGRAPHIC_OPERATIONS);
+                }
+                else if (cap == "data_storage")
+                {
+                    device.capabilities |= static_cast<uint32_t>(core::DeviceCapability::DATA_STORAGE);
+                }
+                else if (cap == "firmware_update")
+                {
+                    device.capabilities |= static_cast<uint32_t>(core::DeviceCapability::FIRMWARE_UPDATE);
+                }
+                else if (cap == "low_power")
+                {
+                    // Not a capability flag; treat as desired operating mode
+                    device.low_power_mode = true;
+                }
+                // Unknown capability strings are ignored intentionally
+            }
+            return device;
+        }
+
+        bool register_local(const core::Device &device)
+        {
+            if (!device_manager_->register_device(device))
+            {
+                return false;
+            }
+
+            // Register with power manager if power management is enabled
+            if (config_.enable_power_management)
+            {
+                energy::PowerSettings power_settings;
+                power_settings.enable_optimization = true;
+                power_settings.low_power_threshold = 0.2;
+
+                power_manager_->register_device(device.device_id, power_settings);
+            }
+
+            // Initialize device balance (mock)
+            {
+                std::lock_guard<std::mutex> lock(data_mutex_);
+                device_balances_[device.device_id] = 1000000; // 1 ADA in lovelace
+            }
+
+            notify_device_event(device.device_id, "registered");
+            return true;
+        }
+
+        // Drops a device and its readings after they were handed to another node
+        void unregister_local(const std::string &device_id)
+        {
+            device_manager_->unregister_device(device_id);
+            if (config_.enable_power_management)
+            {
+                power_manager_->unregister_device(device_id);
+            }
+            {
+                std::lock_guard<std::mutex> lock(data_mutex_);
+                device_balances_.erase(device_id);
+            }
+            data_store_.erase(device_id);
+        }
+
+        std::vector<IoTData> query_local(const std::string &device_id, uint64_t start_time, uint64_t end_time) const
+        {
+            auto view = data_store_.query(device_id, start_time, end_time);
+
+            std::vector<IoTData> filtered_data;
+            filtered_data.reserve(view.size());
+            for (const auto &record : view)
+            {
+                IoTData data;
+                data.device_id = device_id;
+                data.data_type = std::string(record.data_type());
+                data.payload = payload_codec_ ? payload_codec_->decode(record.payload()) : std::string(record.payload());
+                data.timestamp = record.timestamp();
+                data.signature = record.signature();
+                data.hash = record.hash();
+                data.metadata = record.metadata();
+                filtered_data.push_back(std::move(data));
+            }
+            return filtered_data;
+        }
+
+        // Stores readings handed over by another node; they were counted where they were submitted
+        void store_readings(std::vector<IoTData> &&readings)
+        {
+            std::vector<std::string> encoded_payloads(payload_codec_ ? readings.size() : 0);
+            for (size_t i = 0; i < encoded_payloads.size(); ++i)
+            {
+                payload_codec_->encode(readings[i].device_id, readings[i].data_type, readings[i].payload,
+                                       encoded_payloads[i]);
+            }
+
+            auto writer = data_store_.writer();
+            for (size_t i = 0; i < readings.size(); ++i)
+            {
+                auto &data = readings[i];
+                data::TimeSeriesStore::Entry entry;
+                entry.timestamp = data.timestamp;
+                entry.data_type = data.data_type;
+                entry.payload = encoded_payloads.empty() || encoded_payloads[i].empty()
+                                    ? std::string_view(data.payload)
+                                    : std::string_view(encoded_payloads[i]);
+                entry.hash = std::move(data.hash);
+                entry.signature = std::move(data.signature);
+                entry.metadata = std::move(data.metadata);
+                writer.append(data.device_id, std::move(entry));
+            }
+        }
+
+        /**
+         * @brief Cluster node owning a device; empty when it is this node or there is no cluster
+         */
+        std::string remote_owner(const std::string &device_id) const
+        {
+            if (!cluster_)
+            {
+                return "";
+            }
+            std::string owner = cluster_->owner(device_id);
+            return owner == cluster_->node_id() ? std::string() : owner;
+        }
+
+        // One transaction id per reading; empty ones were rejected or the node did not answer
+        std::vector<std::string> submit_remote(const std::string &node, const json &readings)
+        {
+            std::vector<std::string> tx_ids(readings.size());
+            std::string response;
+            if (!cluster_->call(node, "submit", to_wire(readings), response))
+            {
+                utils::Logger::instance().log(utils::LogLevel::WARNING, "CardanoIoTSDK",
+                                              "Cluster node " + node + " did not take " +
+                                                  std::to_string(readings.size()) + " readings");
+                return tx_ids;
+            }
+            auto ids = json::parse(response, nullptr, false);
+            if (!ids.is_discarded() && ids.is_array())
+            {
+                for (size_t i = 0; i < tx_ids.size() && i < ids.size(); ++i)
+                {
+                    if (ids[i].is_string())
+                    {
+                        tx_ids[i] = ids[i].get<std::string>();
+                    }
+                }
+            }
+            return tx_ids;
+        }
+
+        std::vector<IoTData> query_remote(const std::string &node, const std::string &device_id,
+                                          uint64_t start_time, uint64_t end_time) const
+        {
+            std::string response;
+            std::vector<IoTData> readings;
+            const json request = {{"device_id", device_id}, {"start_time", start_time}, {"end_time", end_time}};
+            if (!cluster_->call(node, "query", to_wire(request), response) ||
+                !readings_from_json(json::parse(response, nullptr, false), readings))
+            {
+                utils::Logger::instance().log(utils::LogLevel::WARNING, "CardanoIoTSDK",
+                                              "Cluster query for " + device_id + " failed on node " + node);
+                return {};
+            }
+            return readings;
+        }
+
+        static constexpr size_t HANDOFF_CHUNK_BYTES = 256 * 1024; // Request body size a handoff aims for
+
+        struct HandoffDevice
+        {
+            core::Device device;
+            uint64_t balance = 0;
+            std::vector<IoTData> readings;
+        };
+
+        // Identifies a reading across copies, so a handoff can be resent without duplicating it
+        static std::string reading_key(uint64_t timestamp, std::string_view data_type, const std::string &hash,
+                                       const std::string &signature)
+        {
+            std::string key = std::to_string(timestamp);
+            key.push_back('\0');
+            key.append(data_type);
+            key.push_back('\0');
+            key += hash;
+            key.push_back('\0');
+            key += signature;
+            return key;
+        }
+
+        std::vector<HandoffDevice> snapshot_devices(const std::vector<std::string> &device_ids)
+        {
+            std::vector<HandoffDevice> snapshot;
+            for (const auto &device_id : device_ids)
+            {
+                auto device = device_manager_->get_device(device_id);
+                if (!device)
+                {
+                    continue;
+                }
+                HandoffDevice entry;
+                entry.device = *device;
+                {
+                    std::lock_guard<std::mutex> lock(data_mutex_);
+                    auto it = device_balances_.find(device_id);
+                    entry.balance = it != device_balances_.end() ? it->second : 0;
+                }
+                entry.readings = query_local(device_id, 0, 0);
+                snapshot.push_back(std::move(entry));
+            }
+            return snapshot;
+        }
+
+        /**
+         * Send devices with their readings to the node now owning them, in
+         * request bodies of about HANDOFF_CHUNK_BYTES. A device with more
+         * readings spans several pieces. The receiver merges, so a retried or
+         * repeated handoff never duplicates or drops readings. leaving marks a
+         * node handing off its whole share before it leaves, which the receiver
+         * accepts even while its ring still lists the sender.
+         */
+        bool send_handoff(const std::string &node, const std::vector<HandoffDevice> &devices, bool leaving)
+        {
+            json pieces = json::array();
+            size_t chunk_bytes = 0;
+            auto send = [&]()
+            {
+                if (pieces.empty())
+                {
+                    return true;
+                }
+                std::string response;
+                const json body = {{"leaving", leaving}, {"devices", std::move(pieces)}};
+                pieces = json::array();
+                chunk_bytes = 0;
+                return cluster_->call(node, "handoff", to_wire(body), response);
+            };
+
+            for (const auto &device : devices)
+            {
+                auto piece = [&]()
+                {
+                    return json{{"device", device_to_json(device.device)},
+                                {"balance", device.balance},
+                                {"readings", json::array()}};
+                };
+                json entry = piece();
+                for (const auto &reading : device.readings)
+                {
+                    chunk_bytes += utils::codec::base64_encoded_size(reading.payload.size()) + reading.data_type.size() +
+                                   reading.hash.size() + reading.signature.size() + 96;
+                    entry["readings"].push_back(reading_to_json(reading));
+                    if (chunk_bytes >= HANDOFF_CHUNK_BYTES)
+                    {
+                        pieces.push_back(std::move(entry));
+                        if (!send())
+                        {
+                            return false;
+                        }
+                        entry = piece();
+                    }
+                }
+                pieces.push_back(std::move(entry));
+                chunk_bytes += 256;
+                if (chunk_bytes >= HANDOFF_CHUNK_BYTES && !send())
+                {
+                    return false;
+                }
+            }
+            return send();
+        }
 
-        // Event callbacks
-        DeviceEventCallback device_event_callback_;
-        DataEventCallback data_event_callback_;
-        TransactionEventCallback transaction_event_callback_;
+        /**
+         * Take devices handed over by another node. Ownership must agree with this
+         * node's ring (unless the sender is leaving), so two nodes whose rings have
+         * not converged cannot pass a device back and forth; the sender retries.
+         * Readings already stored here are skipped rather than replaced, which
+         * keeps those submitted here since an earlier attempt.
+         */
+        bool accept_handoff(const std::string &body)
+        {
+            auto request = json::parse(body, nullptr, false);
+            auto devices_field = request.is_object() ? request.find("devices") : request.end();
+            if (request.is_discarded() || devices_field == request.end() || !devices_field->is_array())
+            {
+                return false;
+            }
+            if (leaving_cluster_)
+            {
+                return false; // Would only have to be handed on again
+            }
+            auto leaving_field = request.find("leaving");
+            const bool leaving = leaving_field != request.end() && leaving_field->is_boolean() && leaving_field->get<bool>();
 
-        // Mock data for demo purposes
-        std::unordered_map<std::string, std::vector<IoTData>> device_data_;
-        std::unordered_map<std::string, uint64_t> device_balances_;
-        std::unordered_map<std::string, std::string> deployed_contracts_;
+            std::vector<HandoffDevice> devices;
+            for (const auto &entry : *devices_field)
+            {
+                HandoffDevice device;
+                auto device_field = entry.is_object() ? entry.find("device") : entry.end();
+                auto readings_field = entry.is_object() ? entry.find("readings") : entry.end();
+                if (device_field == entry.end() || readings_field == entry.end() ||
+                    !device_from_json(*device_field, device.device) ||
+                    !readings_from_json(*readings_field, device.readings))
+                {
+                    return false;
+                }
+                if (!leaving && cluster_ && !cluster_->is_local(device.device.device_id))
+                {
+                    utils::Logger::instance().log(utils::LogLevel::DEBUG, "CardanoIoTSDK",
+                                                  "Refusing handoff of " + device.device.device_id +
+                                                      " until the rings agree on its owner");
+                    return false;
+                }
+                read_uint(entry, "balance", device.balance);
+                devices.push_back(std::move(device));
+            }
 
-        mutable std::mutex data_mutex_;
+            for (auto &device : devices)
+            {
+                const std::string &device_id = device.device.device_id;
+                if (!device_manager_->is_device_registered(device_id))
+                {
+                    if (!register_local(device.device))
+                    {
+                        return false;
+                    }
+                    std::lock_guard<std::mutex> lock(data_mutex_);
+                    device_balances_[device_id] = device.balance;
+                }
 
-        // Statistics
-        std::atomic<uint64_t> total_transactions_{0};
-        std::atomic<uint64_t> total_data_submissions_{0};
-        std::atomic<uint64_t> total_contracts_deployed_{0};
+                std::unordered_map<std::string, size_t> stored;
+                if (!device.readings.empty())
+                {
+                    const auto [first, last] = std::minmax_element(device.readings.begin(), device.readings.end(),
+                                                                   [](const IoTData &a, const IoTData &b)
+                                                                   { return a.timestamp < b.timestamp; });
+                    for (const auto &record : data_store_.query(device_id, first->timestamp, last->timestamp))
+                    {
+                        ++stored[reading_key(record.timestamp(), record.data_type(), record.hash(), record.signature())];
+                    }
+                }
+                std::vector<IoTData> fresh;
+                for (auto &reading : device.readings)
+                {
+                    auto it = stored.find(reading_key(reading.timestamp, reading.data_type, reading.hash, reading.signature));
+                    if (it != stored.end() && it->second > 0)
+                    {
+                        --it->second;
+                        continue;
+                    }
+                    reading.device_id = device_id;
+                    fresh.push_back(std::move(reading));
+                }
+                store_readings(std::move(fresh));
+            }
+            return true;
+        }
 
-        std::string generate_mock_tx_id()
+        /**
+         * Hand every local device whose owner on ring is another node to that
+         * node, in three steps:
+         *  1. copy the devices and their readings while they keep taking readings;
+         *  2. freeze them, so commit_local forwards their readings to the new owner;
+         *  3. send what was committed between the copy and the freeze, then drop
+         *     them here.
+         * A failed step unfreezes the devices and keeps them here; false means some
+         * must be retried. leaving is set when this node hands off its whole
+         * share before leaving the cluster.
+         */
+        bool rebalance(const network::HashRing &ring, bool leaving = false)
         {
-            static std::random_device rd;
-            static std::mt19937 gen(rd());
-            static std::uniform_int_distribution<> dis(0, 15);
+            std::lock_guard<std::mutex> lock(rebalance_mutex_);
+            const std::string self = cluster_->node_id();
 
-            std::stringstream ss;
-            ss << "tx_";
-            for (int i = 0; i < 64; ++i)
+            std::map<std::string, std::vector<std::string>> moves; // New owner -> devices
+            for (auto &device_id : device_manager_->get_device_list())
             {
-                ss << std::hex << dis(gen);
+                const std::string &owner = ring.owner(device_id);
+                if (!owner.empty() && owner != self)
+                {
+                    moves[owner].push_back(std::move(device_id));
+                }
             }
-            return ss.str();
+
+            bool complete = true;
+            for (const auto &[node, devices] : moves)
+            {
+                auto copied = snapshot_devices(devices);
+                bool moved = send_handoff(node, copied, leaving);
+                if (moved)
+                {
+                    {
+                        std::unique_lock<std::shared_mutex> freeze(moving_mutex_);
+                        for (const auto &device : copied)
+                        {
+                            moving_[device.device.device_id] = node;
+                        }
+                    }
+
+                    // Readings committed since the copy: the current set minus what was sent
+                    std::vector<HandoffDevice> delta;
+                    for (auto &device : copied)
+                    {
+                        std::unordered_map<std::string, size_t> sent;
+                        for (const auto &reading : device.readings)
+                        {
+                            ++sent[reading_key(reading.timestamp, reading.data_type, reading.hash, reading.signature)];
+                        }
+                        device.readings.clear();
+                        for (auto &reading : query_local(device.device.device_id, 0, 0))
+                        {
+                            auto it = sent.find(reading_key(reading.timestamp, reading.data_type, reading.hash,
+                                                            reading.signature));
+                            if (it != sent.end() && it->second > 0)
+                            {
+                                --it->second;
+                                continue;
+                            }
+                            device.readings.push_back(std::move(reading));
+                        }
+                        if (!device.readings.empty())
+                        {
+                            delta.push_back(std::move(device));
+                        }
+                    }
+                    moved = send_handoff(node, delta, leaving);
+                    if (moved)
+                    {
+                        for (const auto &device_id : devices)
+                        {
+                            unregister_local(device_id);
+                        }
+                    }
+
+                    std::unique_lock<std::shared_mutex> thaw(moving_mutex_);
+                    for (const auto &device_id : devices)
+                    {
+                        moving_.erase(device_id);
+                    }
+                }
+                if (!moved)
+                {
+                    utils::Logger::instance().log(utils::LogLevel::WARNING, "CardanoIoTSDK",
+                                                  "Handoff of " + std::to_string(devices.size()) +
+                                                      " devices to " + node + " failed; will retry");
+                    complete = false;
+                    continue;
+                }
+                utils::Logger::instance().log(utils::LogLevel::INFO, "CardanoIoTSDK",
+                                              "Handed " + std::to_string(devices.size()) + " devices to " + node);
+            }
+            return complete;
         }
 
-        std::string generate_mock_contract_address()
+        // Requests from other nodes are always served here; they are never forwarded again
+        bool start_cluster()
         {
-            static std::random_device rd;
-            static std::mt19937 gen(rd());
-            static std::uniform_int_distribution<> dis(0, 15);
-
-            std::stringstream ss;
-            ss << "addr_test1";
-            for (int i = 0; i < 56; ++i)
+            const auto start = std::chrono::steady_clock::now();
+            leaving_cluster_ = false;
+            cluster_ = std::make_unique<network::GatewayCluster>();
+
+            cluster_->set_request_handler("register", [this](const std::string &body, std::string &)
+                                          {
+                                              core::Device device;
+                                              auto value = json::parse(body, nullptr, false);
+                                              return !value.is_discarded() && device_from_json(value, device) &&
+                                                     register_local(device); });
+
+            cluster_->set_request_handler("submit", [this](const std::string &body, std::string &response)
+                                          {
+                                              std::vector<IoTData> readings;
+                                              if (!readings_from_json(json::parse(body, nullptr, false), readings))
+                                              {
+                                                  return false;
+                                              }
+                                              response = to_wire(commit_local(std::move(readings), false));
+                                              return true; });
+
+            cluster_->set_request_handler("query", [this](const std::string &body, std::string &response)
+                                          {
+                                              auto request = json::parse(body, nullptr, false);
+                                              std::string device_id;
+                                              uint64_t start_time = 0;
+                                              uint64_t end_time = 0;
+                                              if (request.is_discarded() || !request.is_object() ||
+                                                  !read_string(request, "device_id", device_id) ||
+                                                  !read_uint(request, "start_time", start_time) ||
+                                                  !read_uint(request, "end_time", end_time))
+                                              {
+                                                  return false;
+                                              }
+                                              json readings = json::array();
+                                              for (const auto &reading : query_local(device_id, start_time, end_time))
+                                              {
+                                                  readings.push_back(reading_to_json(reading));
+                                              }
+                                              response = to_wire(readings);
+                                              return true; });
+
+            cluster_->set_request_handler("devices", [this](const std::string &, std::string &response)
+                                          {
+                                              response = to_wire(device_manager_->get_device_list());
+                                              return true; });
+
+            cluster_->set_request_handler("handoff", [this](const std::string &body, std::string &)
+                                          { return accept_handoff(body); });
+
+            cluster_->set_membership_callback([this](const network::HashRing &ring)
+                                              { return rebalance(ring); });
+
+            network::GatewayCluster::Options options;
+            options.listen_address = config_.cluster_listen_address;
+            options.port = config_.cluster_port;
+            options.seeds = config_.cluster_seeds;
+            options.virtual_nodes = config_.cluster_virtual_nodes;
+            options.membership_interval_ms = config_.cluster_membership_interval_ms;
+            options.request_timeout_ms = config_.cluster_request_timeout_ms;
+            if (!cluster_->start(options, executor_.get()))
             {
-                ss << std::hex << dis(gen);
+                cluster_.reset();
+                return false;
             }
-            return ss.str();
+            record_startup("cluster", start);
+            return true;
         }
 
-        void notify_device_event(const std::string &device_id, const std::string &event_type)
+        // Hands every device to the remaining nodes, then leaves the cluster
+        void leave_cluster()
         {
-            if (device_event_callback_)
+            if (!cluster_)
             {
-                device_event_callback_(device_id, event_type);
+                return;
+            }
+            cluster_->set_membership_callback(nullptr);
+            leaving_cluster_ = true;
+            network::HashRing remaining = *cluster_->ring();
+            remaining.remove_node(cluster_->node_id());
+            if (!remaining.empty() && !rebalance(remaining, true))
+            {
+                utils::Logger::instance().log(utils::LogLevel::WARNING, "CardanoIoTSDK",
+                                              "Leaving the cluster with devices that could not be handed off");
             }
+            cluster_->stop();
+            cluster_.reset();
         }
 
         void notify_data_event(const IoTData &data)
@@ -113,6 +1573,19 @@ namespace cardano_iot
     CardanoIoTSDK::CardanoIoTSDK(const Config &config) : pimpl_(std::make_unique<Impl>())
     {
         pimpl_->config_ = config;
+        pimpl_->ingestion_batch_size_.store(config.ingestion_batch_size, std::memory_order_relaxed);
+
+        data::PayloadCodec::Options codec_options;
+        codec_options.dedup = config.payload_dedup;
+        codec_options.numeric_delta = config.payload_numeric_delta;
+        codec_options.compression = config.payload_compression;
+        codec_options.keyframe_interval = config.payload_keyframe_interval;
+        codec_options.compression_level = config.payload_compression_level;
+        auto codec = std::make_unique<data::PayloadCodec>(codec_options);
+        if (codec->enabled())
+        {
+            pimpl_->payload_codec_ = std::move(codec);
+        }
     }
 
     CardanoIoTSDK::~CardanoIoTSDK() = default;
@@ -128,25 +1601,61 @@ namespace cardano_iot
 
         try
         {
-            // Initialize configuration manager
-            pimpl_->config_manager_ = std::make_unique<utils::Config>();
-
-            // Initialize device manager
-            pimpl_->device_manager_ = std::make_unique<core::DeviceManager>();
-            if (!pimpl_->device_manager_->initialize())
+            const auto startup_begin = std::chrono::steady_clock::now();
+
+            utils::ExecutorOptions executor_options;
+            executor_options.threads = pimpl_->config_.executor_threads;
+            executor_options.pin_threads = pimpl_->config_.executor_pin_threads;
+            executor_options.cpus = pimpl_->config_.executor_cpus;
+            pimpl_->executor_ = std::make_shared<utils::Executor>(executor_options);
+            pimpl_->record_startup("executor", startup_begin);
+
+            // Independent subsystems start in parallel on the executor; the outbox and
+            // the ingestion worker start on first use
+            auto start_subsystem = [this](const char *subsystem, std::function<bool()> start)
+            {
+                return pimpl_->executor_->submit([this, subsystem, start = std::move(start)]()
+                                                 {
+                                                     const auto begin = std::chrono::steady_clock::now();
+                                                     const bool started = start();
+                                                     pimpl_->record_startup(subsystem, begin);
+                                                     return started; },
+                                                 utils::TaskPriority::CRITICAL);
+            };
+
+            auto config_started = start_subsystem("config", [this]()
+                                                  {
+                                                      pimpl_->config_manager_ = std::make_unique<utils::Config>();
+                                                      return true; });
+
+            auto devices_started = start_subsystem("device_manager", [this]()
+                                                   {
+                                                       pimpl_->device_manager_ = std::make_unique<core::DeviceManager>();
+                                                       return pimpl_->device_manager_->initialize(); });
+
+            auto power_started = start_subsystem("power_manager", [this]()
+                                                 {
+                                                     pimpl_->power_manager_ = std::make_unique<energy::PowerManager>();
+                                                     std::map<std::string, std::string> power_config;
+                                                     power_config["enable_optimization"] =
+                                                         pimpl_->config_.enable_power_management ? "true" : "false";
+                                                     return pimpl_->power_manager_->initialize(power_config); });
+
+            const bool config_ok = config_started.get();
+            const bool devices_ok = devices_started.get();
+            const bool power_ok = power_started.get();
+            if (!devices_ok)
             {
                 utils::Logger::instance().log(utils::LogLevel::ERROR, "CardanoIoTSDK", "Failed to initialize device manager");
-                return false;
             }
-
-            // Initialize power manager
-            pimpl_->power_manager_ = std::make_unique<energy::PowerManager>();
-            std::map<std::string, std::string> power_config;
-            power_config["enable_optimization"] = pimpl_->config_.enable_power_management ? "true" : "false";
-
-            if (!pimpl_->power_manager_->initialize(power_config))
+            if (!power_ok)
             {
                 utils::Logger::instance().log(utils::LogLevel::ERROR, "CardanoIoTSDK", "Failed to initialize power manager");
+            }
+            if (!config_ok || !devices_ok || !power_ok)
+            {
+                pimpl_->executor_->shutdown();
+                pimpl_->executor_.reset();
                 return false;
             }
 
@@ -169,6 +1678,14 @@ namespace cardano_iot
                 });
 
             pimpl_->initialized_ = true;
+            pimpl_->start_ingestion();
+
+            if (pimpl_->config_.cluster_enabled && !pimpl_->start_cluster())
+            {
+                utils::Logger::instance().log(utils::LogLevel::ERROR, "CardanoIoTSDK", "Failed to join the gateway cluster");
+                shutdown();
+                return false;
+            }
 
             // Normalize network type to known enum + string representation
             auto net = network_utils::parse_network(pimpl_->config_.network_type);
@@ -180,6 +1697,7 @@ namespace cardano_iot
             utils::Logger::instance().set_max_file_size_bytes(2 * 1024 * 1024);
             utils::Logger::instance().set_max_backup_files(5);
 
+            pimpl_->record_startup("total", startup_begin);
             return true;
         }
         catch (const std::exception &e)
@@ -199,6 +1717,29 @@ namespace cardano_iot
 
         utils::Logger::instance().log(utils::LogLevel::INFO, "CardanoIoTSDK", "Shutting down Cardano IoT SDK");
 
+        // Commit anything still queued while the device manager can validate it
+        std::unique_ptr<energy::PowerAwareOutbox> outbox;
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->outbox_mutex_);
+            outbox = std::move(pimpl_->outbox_);
+        }
+        if (outbox)
+        {
+            outbox->flush_all();
+            outbox.reset();
+        }
+        pimpl_->stop_ingestion();
+
+        // Cluster handlers run on the executor, so leave before it stops
+        pimpl_->leave_cluster();
+
+        // Components still holding the executor fall back to their own threads
+        if (pimpl_->executor_)
+        {
+            pimpl_->executor_->shutdown();
+            pimpl_->executor_.reset();
+        }
+
         if (pimpl_->power_manager_)
         {
             pimpl_->power_manager_->shutdown();
@@ -226,83 +1767,15 @@ namespace cardano_iot
             return false;
         }
 
-        // Convert DeviceInfo to Device
-        core::Device device;
-        device.device_id = device_info.device_id;
-        device.device_type = device_info.device_type;
-        device.manufacturer = device_info.manufacturer;
-        device.firmware_version = device_info.firmware_version;
-        device.public_key = device_info.public_key;
-        device.low_power_mode = device_info.low_power_mode;
-
-        // Set capabilities
-        device.capabilities = 0;
-        for (const auto &cap : device_info.capabilities)
-        {
-            if (cap == "sensor_data")
-            {
-                device.capabilities |= static_cast<uint32_t>(core::DeviceCapability::SENSOR_DATA);
-            }
-            else if (cap == "actuator_control")
-            {
-                device.capabilities |= static_cast<uint32_t>(core::DeviceCapability::ACTUATOR_CONTROL);
-            }
-            else if (cap == "smart_contract" || cap == "smart_contract_execution")
-            {
-                device.capabilities |= static_cast<uint32_t>(core::DeviceCapability::SMART_CONTRACT_EXECUTION);
-            }
-            else if (cap == "p2p" || cap == "peer_to_peer" || cap == "peer_to_peer_communication")
-            {
-                device.capabilities |= static_cast<uint32_t>(core::DeviceCapability::PEER_TO_PEER_COMMUNICATION);
-            }
-            else if (cap == "energy_harvesting")
-            {
-                device.capabilities |= static_cast<uint32_t>(core::DeviceCapability::ENERGY_HARVESTING);
-            }
-            else if (cap == "crypto" || cap == "cryptographic_operations")
-            {
-                device.capabilities |= static_cast<uint32_t>(core::DeviceCapability::CRYPTOGRAPHIC_OPERATIONS);
-            }
-            else if (cap == "data_storage")
-            {
-                device.capabilities |= static_cast<uint32_t>(core::DeviceCapability::DATA_STORAGE);
-            }
-            else if (cap == "firmware_update")
-            {
-                device.capabilities |= static_cast<uint32_t>(core::DeviceCapability::FIRMWARE_UPDATE);
-            }
-            else if (cap == "low_power")
-            {
-                // Not a capability flag; treat as desired operating mode
-                device.low_power_mode = true;
-            }
-            // Unknown capability strings are ignored intentionally
-        }
-
-        bool success = pimpl_->device_manager_->register_device(device);
-
-        if (success)
+        const core::Device device = Impl::to_core_device(device_info);
+        const std::string owner = pimpl_->remote_owner(device.device_id);
+        if (!owner.empty())
         {
-            // Register with power manager if power management is enabled
-            if (pimpl_->config_.enable_power_management)
-            {
-                energy::PowerSettings power_settings;
-                power_settings.enable_optimization = true;
-                power_settings.low_power_threshold = 0.2;
-
-                pimpl_->power_manager_->register_device(device_info.device_id, power_settings);
-            }
-
-            // Initialize device balance (mock)
-            {
-                std::lock_guard<std::mutex> lock(pimpl_->data_mutex_);
-                pimpl_->device_balances_[device_info.device_id] = 1000000; // 1 ADA in lovelace
-            }
-
-            pimpl_->notify_device_event(device_info.device_id, "registered");
+            std::string response;
+            return pimpl_->cluster_->call(owner, "register", to_wire(device_to_json(device)), response);
         }
 
-        return success;
+        return pimpl_->register_local(device);
     }
 
     bool CardanoIoTSDK::authenticate_device(const std::string &device_id,
@@ -331,52 +1804,146 @@ namespace cardano_iot
             return {};
         }
 
-        return pimpl_->device_manager_->get_device_list();
+        auto devices = pimpl_->device_manager_->get_device_list();
+        if (!pimpl_->cluster_)
+        {
+            return devices;
+        }
+
+        for (const auto &[node, response] : pimpl_->cluster_->call_all("devices", ""))
+        {
+            auto remote = json::parse(response, nullptr, false);
+            if (remote.is_discarded() || !remote.is_array())
+            {
+                continue;
+            }
+            for (const auto &device_id : remote)
+            {
+                if (device_id.is_string())
+                {
+                    devices.push_back(device_id.get<std::string>());
+                }
+            }
+        }
+        // A device being handed off may be listed by both nodes
+        std::sort(devices.begin(), devices.end());
+        devices.erase(std::unique(devices.begin(), devices.end()), devices.end());
+        return devices;
     }
 
     std::string CardanoIoTSDK::submit_data(const IoTData &data)
+    {
+        PROFILE_SCOPE("CardanoIoTSDK::submit_data");
+        return pimpl_->submit_one(data, nullptr);
+    }
+
+    std::string CardanoIoTSDK::submit_data(IoTData &&data)
+    {
+        PROFILE_SCOPE("CardanoIoTSDK::submit_data");
+        return pimpl_->submit_one(data, &data);
+    }
+
+    std::vector<std::string> CardanoIoTSDK::submit_data_batch(std::vector<IoTData> &&batch)
     {
         if (!pimpl_->initialized_)
         {
-            return "";
+            return std::vector<std::string>(batch.size());
         }
 
-        // Validate data
-        if (data.device_id.empty() || data.payload.empty())
+        return pimpl_->commit_batch(std::move(batch));
+    }
+
+    bool CardanoIoTSDK::enqueue_data(IoTData &&data)
+    {
+        return pimpl_->enqueue(std::move(data), nullptr);
+    }
+
+    void CardanoIoTSDK::set_ingestion_batch_size(uint32_t batch_size)
+    {
+        pimpl_->ingestion_batch_size_.store(std::max<uint32_t>(batch_size, 1), std::memory_order_relaxed);
+        pimpl_->ingestion_cv_.notify_one(); // A smaller batch may already be complete
+    }
+
+    uint32_t CardanoIoTSDK::get_ingestion_batch_size() const
+    {
+        return pimpl_->ingestion_batch_size_.load(std::memory_order_relaxed);
+    }
+
+    std::shared_ptr<utils::Executor> CardanoIoTSDK::get_executor() const
+    {
+        return pimpl_->executor_;
+    }
+
+    bool CardanoIoTSDK::flush_data_queue(uint32_t timeout_ms)
+    {
+        std::unique_lock<std::mutex> lock(pimpl_->ingestion_mutex_);
+        if (pimpl_->ingestion_queue_.empty() && pimpl_->ingestion_in_flight_ == 0)
         {
-            utils::Logger::instance().log(utils::LogLevel::ERROR, "CardanoIoTSDK",
-                                          "Invalid data submission: missing required fields");
-            return "";
+            return true;
         }
 
-        // Check if device is registered
-        if (!pimpl_->device_manager_->is_device_registered(data.device_id))
+        pimpl_->ingestion_flush_requested_ = true;
+        pimpl_->ingestion_cv_.notify_one();
+
+        return pimpl_->ingestion_idle_cv_.wait_for(lock, std::chrono::milliseconds(timeout_ms), [this]()
+                                                   { return pimpl_->ingestion_queue_.empty() &&
+                                                            pimpl_->ingestion_in_flight_ == 0; });
+    }
+
+    size_t CardanoIoTSDK::get_pending_data_count() const
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->ingestion_mutex_);
+        return pimpl_->ingestion_queue_.size() + pimpl_->ingestion_in_flight_;
+    }
+
+    bool CardanoIoTSDK::queue_data(IoTData &&data, uint32_t max_delay_ms)
+    {
+        if (!pimpl_->initialized_ || !Impl::is_valid_data(data))
         {
-            utils::Logger::instance().log(utils::LogLevel::ERROR, "CardanoIoTSDK",
-                                          "Device not registered: " + data.device_id);
-            return "";
+            return false;
+        }
+        auto *outbox = pimpl_->outbox(true);
+        if (!outbox)
+        {
+            std::vector<IoTData> batch;
+            batch.push_back(std::move(data));
+            return !pimpl_->commit_batch(std::move(batch)).front().empty();
         }
 
-        // Generate mock transaction ID
-        std::string tx_id = pimpl_->generate_mock_tx_id();
+        Impl::OutboundOperation operation;
+        operation.data = std::move(data);
+        return pimpl_->hold(*outbox, std::move(operation), "data_submission", max_delay_ms);
+    }
 
-        // Store data (mock blockchain storage)
+    bool CardanoIoTSDK::queue_ada_transfer(const std::string &device_id, uint64_t amount, uint32_t max_delay_ms)
+    {
+        if (!pimpl_->initialized_ || device_id.empty() || amount == 0)
         {
-            std::lock_guard<std::mutex> lock(pimpl_->data_mutex_);
-            pimpl_->device_data_[data.device_id].push_back(data);
+            return false;
+        }
+        auto *outbox = pimpl_->outbox(true);
+        if (!outbox)
+        {
+            pimpl_->notify_transaction_event(pimpl_->transfer_ada(device_id, amount), true);
+            return true;
         }
 
-        pimpl_->total_data_submissions_++;
-        pimpl_->total_transactions_++;
-
-        utils::Logger::instance().log(utils::LogLevel::INFO, "CardanoIoTSDK",
-                                      "Data submitted for device " + data.device_id + " with TX: " + tx_id);
+        Impl::OutboundOperation operation;
+        operation.data.device_id = device_id;
+        operation.lovelace = amount;
+        return pimpl_->hold(*outbox, std::move(operation), "ada_transfer", max_delay_ms);
+    }
 
-        // Notify callbacks
-        pimpl_->notify_data_event(data);
-        pimpl_->notify_transaction_event(tx_id, true);
+    size_t CardanoIoTSDK::flush_outbox()
+    {
+        auto *outbox = pimpl_->outbox(false);
+        return outbox ? outbox->flush_all() : 0;
+    }
 
-        return tx_id;
+    size_t CardanoIoTSDK::get_outbox_pending_count() const
+    {
+        auto *outbox = pimpl_->outbox(false);
+        return outbox ? outbox->pending() : 0;
     }
 
     std::vector<CardanoIoTSDK::IoTData> CardanoIoTSDK::query_data(const std::string &device_id,
@@ -388,34 +1955,51 @@ namespace cardano_iot
             return {};
         }
 
-        std::lock_guard<std::mutex> lock(pimpl_->data_mutex_);
+        const std::string owner = pimpl_->remote_owner(device_id);
+        if (!owner.empty())
+        {
+            return pimpl_->query_remote(owner, device_id, start_time, end_time);
+        }
+        return pimpl_->query_local(device_id, start_time, end_time);
+    }
 
-        auto it = pimpl_->device_data_.find(device_id);
-        if (it == pimpl_->device_data_.end())
+    data::TimeSeriesView CardanoIoTSDK::query_data_view(const std::string &device_id,
+                                                     uint64_t start_time,
+                                                     uint64_t end_time) const
+    {
+        if (!pimpl_->initialized_)
         {
             return {};
         }
 
-        std::vector<IoTData> filtered_data;
-        for (const auto &data : it->second)
+        const std::string owner = pimpl_->remote_owner(device_id);
+        if (!owner.empty())
         {
-            bool time_match = true;
-            if (start_time > 0 && data.timestamp < start_time)
-            {
-                time_match = false;
-            }
-            if (end_time > 0 && data.timestamp > end_time)
-            {
-                time_match = false;
-            }
-
-            if (time_match)
+            // The view can outlive the scratch store; it keeps the segments alive
+            data::TimeSeriesStore remote;
             {
-                filtered_data.push_back(data);
+                auto writer = remote.writer();
+                for (auto &reading : pimpl_->query_remote(owner, device_id, start_time, end_time))
+                {
+                    data::TimeSeriesStore::Entry entry;
+                    entry.timestamp = reading.timestamp;
+                    entry.data_type = reading.data_type;
+                    entry.payload = reading.payload;
+                    entry.hash = std::move(reading.hash);
+                    entry.signature = std::move(reading.signature);
+                    entry.metadata = std::move(reading.metadata);
+                    writer.append(device_id, std::move(entry));
+                }
             }
+            return remote.query(device_id, start_time, end_time);
         }
 
-        return filtered_data;
+        return pimpl_->data_store_.query(device_id, start_time, end_time);
+    }
+
+    std::string CardanoIoTSDK::decode_payload(std::string_view stored) const
+    {
+        return pimpl_->payload_codec_ ? pimpl_->payload_codec_->decode(stored) : std::string(stored);
     }
 
     bool CardanoIoTSDK::verify_data_integrity(const IoTData &data) const
@@ -479,20 +2063,64 @@ namespace cardano_iot
             return "";
         }
 
-        // Mock ADA transfer
-        std::string tx_id = pimpl_->generate_mock_tx_id();
+        return pimpl_->transfer_ada(device_id, amount);
+    }
 
+    utils::Future<std::string> CardanoIoTSDK::submit_data_async(IoTData data)
+    {
+        auto result = std::make_unique<utils::Promise<std::string>>();
+        auto future = result->get_future();
+        if (!pimpl_->enqueue(std::move(data), std::move(result)))
         {
-            std::lock_guard<std::mutex> lock(pimpl_->data_mutex_);
-            pimpl_->device_balances_[device_id] += amount;
+            return utils::Executor::make_ready(std::string());
         }
+        return future;
+    }
 
-        pimpl_->total_transactions_++;
+    utils::Future<std::string> CardanoIoTSDK::deploy_contract_async(const std::string &contract_code,
+                                                                    const std::map<std::string, std::string> &parameters)
+    {
+        return pimpl_->run_async([this, contract_code, parameters]
+                                 { return deploy_contract(contract_code, parameters); });
+    }
 
-        utils::Logger::instance().log(utils::LogLevel::INFO, "CardanoIoTSDK",
-                                      "ADA transfer: " + std::to_string(amount) + " lovelace to " + device_id);
+    utils::Future<std::string> CardanoIoTSDK::execute_contract_async(const std::string &contract_address,
+                                                                     const std::string &function_name,
+                                                                     const std::map<std::string, std::string> &parameters)
+    {
+        return pimpl_->run_async([this, contract_address, function_name, parameters]
+                                 { return execute_contract(contract_address, function_name, parameters); });
+    }
+
+    utils::Future<std::string> CardanoIoTSDK::send_ada_async(const std::string &device_id, uint64_t amount)
+    {
+        return pimpl_->run_async([this, device_id, amount]
+                                 { return send_ada(device_id, amount); });
+    }
+
+    void CardanoIoTSDK::submit_data_async(IoTData data, AsyncResultCallback callback)
+    {
+        pimpl_->deliver(submit_data_async(std::move(data)), std::move(callback));
+    }
+
+    void CardanoIoTSDK::deploy_contract_async(const std::string &contract_code,
+                                              const std::map<std::string, std::string> &parameters,
+                                              AsyncResultCallback callback)
+    {
+        pimpl_->deliver(deploy_contract_async(contract_code, parameters), std::move(callback));
+    }
+
+    void CardanoIoTSDK::execute_contract_async(const std::string &contract_address,
+                                               const std::string &function_name,
+                                               const std::map<std::string, std::string> &parameters,
+                                               AsyncResultCallback callback)
+    {
+        pimpl_->deliver(execute_contract_async(contract_address, function_name, parameters), std::move(callback));
+    }
 
-        return tx_id;
+    void CardanoIoTSDK::send_ada_async(const std::string &device_id, uint64_t amount, AsyncResultCallback callback)
+    {
+        pimpl_->deliver(send_ada_async(device_id, amount), std::move(callback));
     }
 
     uint64_t CardanoIoTSDK::get_device_balance(const std::string &device_id) const
@@ -517,6 +2145,21 @@ namespace cardano_iot
         }
     }
 
+    size_t CardanoIoTSDK::apply_telemetry_batch(const std::vector<core::DeviceTelemetry> &records)
+    {
+        if (!pimpl_->initialized_ || !pimpl_->device_manager_)
+        {
+            return 0;
+        }
+
+        const size_t applied = pimpl_->device_manager_->apply_telemetry_batch(records);
+        if (pimpl_->power_manager_)
+        {
+            pimpl_->power_manager_->apply_telemetry_batch(records);
+        }
+        return applied;
+    }
+
     std::map<std::string, double> CardanoIoTSDK::get_power_stats(const std::string &device_id) const
     {
         std::map<std::string, double> stats;
@@ -553,6 +2196,11 @@ namespace cardano_iot
         pimpl_->transaction_event_callback_ = std::move(callback);
     }
 
+    void CardanoIoTSDK::set_data_batch_event_callback(DataBatchEventCallback callback)
+    {
+        pimpl_->data_batch_event_callback_ = std::move(callback);
+    }
+
     std::string CardanoIoTSDK::get_version()
     {
         return "1.0.0";
@@ -572,6 +2220,34 @@ namespace cardano_iot
             status["sync_progress"] = "100%";
             status["transactions"] = std::to_string(pimpl_->total_transactions_.load());
             status["contracts"] = std::to_string(pimpl_->total_contracts_deployed_.load());
+
+            std::lock_guard<std::mutex> lock(pimpl_->startup_mutex_);
+            for (const auto &[subsystem, gauge] : pimpl_->startup_gauges_)
+            {
+                status["startup_" + subsystem + "_us"] = std::to_string(gauge->value());
+            }
+
+            if (pimpl_->payload_codec_)
+            {
+                const auto codec = pimpl_->payload_codec_->stats();
+                status["payload_raw_bytes"] = std::to_string(codec.raw_bytes);
+                status["payload_stored_bytes"] = std::to_string(codec.stored_bytes);
+                status["payload_deduplicated"] = std::to_string(codec.deduplicated);
+                status["payload_numeric"] = std::to_string(codec.numeric);
+                status["payload_compressed"] = std::to_string(codec.compressed);
+                status["payload_dictionaries"] = std::to_string(codec.dictionaries);
+            }
+
+            if (pimpl_->cluster_)
+            {
+                const auto cluster = pimpl_->cluster_->stats();
+                status["cluster_node"] = pimpl_->cluster_->node_id();
+                status["cluster_endpoint"] = pimpl_->cluster_->endpoint();
+                status["cluster_members"] = std::to_string(pimpl_->cluster_->ring()->size());
+                status["cluster_local_devices"] = std::to_string(pimpl_->device_manager_->get_device_list().size());
+                status["cluster_requests_served"] = std::to_string(cluster.requests_served);
+                status["cluster_requests_failed"] = std::to_string(cluster.requests_failed);
+            }
         }
         else
         {
@@ -0,0 +1,405 @@
+#include "cardano_iot/core/coin_selection.h"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+namespace cardano_iot
+{
+    namespace core
+    {
+        CoinSelectionIndex::CoinSelectionIndex(std::vector<UTXO> utxos) : utxos_(std::move(utxos))
+        {
+            by_amount_desc_.resize(utxos_.size());
+            std::iota(by_amount_desc_.begin(), by_amount_desc_.end(), 0u);
+            std::sort(by_amount_desc_.begin(), by_amount_desc_.end(),
+                      [this](uint32_t a, uint32_t b)
+                      { return utxos_[a].amount_lovelace > utxos_[b].amount_lovelace; });
+
+            for (uint32_t i = 0; i < utxos_.size(); ++i)
+            {
+                total_lovelace_ += utxos_[i].amount_lovelace;
+                for (const auto &entry : utxos_[i].native_tokens)
+                {
+                    token_holders_[entry.first].push_back(i);
+                }
+            }
+            for (auto &[token, positions] : token_holders_)
+            {
+                const std::string &key = token;
+                std::sort(positions.begin(), positions.end(),
+                          [this, &key](uint32_t a, uint32_t b)
+                          { return utxos_[a].native_tokens.at(key) > utxos_[b].native_tokens.at(key); });
+            }
+        }
+
+        const std::vector<uint32_t> *CoinSelectionIndex::holders(const std::string &token) const
+        {
+            auto it = token_holders_.find(token);
+            return it != token_holders_.end() ? &it->second : nullptr;
+        }
+
+        namespace
+        {
+            using Strategy = TransactionManager::UTXOSelectionStrategy;
+
+            struct Selection
+            {
+                const CoinSelectionIndex &index;
+                const CoinSelectionParams &params;
+                std::vector<uint8_t> used; // 1 = chosen, 2 = rejected by the availability filter
+                std::vector<uint32_t> chosen;
+                uint64_t lovelace = 0;
+                size_t evaluated = 0;
+
+                Selection(const CoinSelectionIndex &idx, const CoinSelectionParams &p)
+                    : index(idx), params(p), used(idx.size(), 0) {}
+
+                // Skips chosen outputs and, lazily, ones the availability filter rejects
+                bool usable(uint32_t position)
+                {
+                    if (used[position])
+                    {
+                        return false;
+                    }
+                    if (params.is_available && !params.is_available(index.utxo(position)))
+                    {
+                        used[position] = 2;
+                        return false;
+                    }
+                    return true;
+                }
+
+                bool full() const { return params.max_inputs != 0 && chosen.size() >= params.max_inputs; }
+
+                void take(uint32_t position)
+                {
+                    used[position] = 1;
+                    chosen.push_back(position);
+                    lovelace += index.utxo(position).amount_lovelace;
+                }
+
+                // Undo selections made after `mark` (used when an algorithm gives up)
+                void rollback(size_t mark)
+                {
+                    while (chosen.size() > mark)
+                    {
+                        used[chosen.back()] = 0;
+                        lovelace -= index.utxo(chosen.back()).amount_lovelace;
+                        chosen.pop_back();
+                    }
+                }
+
+                std::vector<uint32_t> unused_by_amount()
+                {
+                    std::vector<uint32_t> pool;
+                    pool.reserve(index.size() - chosen.size());
+                    for (uint32_t position : index.by_amount_desc())
+                    {
+                        if (usable(position))
+                        {
+                            pool.push_back(position);
+                        }
+                    }
+                    return pool;
+                }
+            };
+
+            bool cover_tokens(Selection &s, const std::map<std::string, uint64_t> &required_tokens)
+            {
+                for (const auto &[token, required] : required_tokens)
+                {
+                    uint64_t have = 0;
+                    for (uint32_t position : s.chosen)
+                    {
+                        auto it = s.index.utxo(position).native_tokens.find(token);
+                        if (it != s.index.utxo(position).native_tokens.end())
+                        {
+                            have += it->second;
+                        }
+                    }
+                    if (have >= required)
+                    {
+                        continue;
+                    }
+
+                    const auto *holders = s.index.holders(token);
+                    if (!holders)
+                    {
+                        return false;
+                    }
+                    for (uint32_t position : *holders)
+                    {
+                        if (have >= required || s.full())
+                        {
+                            break;
+                        }
+                        ++s.evaluated;
+                        if (!s.usable(position))
+                        {
+                            continue;
+                        }
+                        s.take(position);
+                        have += s.index.utxo(position).native_tokens.at(token);
+                    }
+                    if (have < required)
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            template <typename Iterator>
+            bool accumulate_in_order(Selection &s, uint64_t target, Iterator begin, Iterator end)
+            {
+                for (auto it = begin; it != end && s.lovelace < target && !s.full(); ++it)
+                {
+                    ++s.evaluated;
+                    if (s.usable(*it))
+                    {
+                        s.take(*it);
+                    }
+                }
+                return s.lovelace >= target;
+            }
+
+            /**
+             * Depth-first branch-and-bound over effective values (largest first) looking
+             * for a subset in [target, target + cost_of_change]; minimises the excess.
+             */
+            bool branch_and_bound(Selection &s, uint64_t target)
+            {
+                std::vector<uint32_t> pool;
+                std::vector<uint64_t> values;
+                for (uint32_t position : s.index.by_amount_desc())
+                {
+                    const uint64_t amount = s.index.utxo(position).amount_lovelace;
+                    if (amount <= s.params.cost_per_input || !s.usable(position))
+                    {
+                        continue;
+                    }
+                    pool.push_back(position);
+                    values.push_back(amount - s.params.cost_per_input);
+                }
+
+                const size_t n = values.size();
+                std::vector<uint64_t> suffix(n + 1, 0);
+                for (size_t i = n; i-- > 0;)
+                {
+                    suffix[i] = suffix[i + 1] + values[i];
+                }
+                if (suffix[0] < target)
+                {
+                    return false;
+                }
+
+                const uint64_t upper = target + s.params.cost_of_change;
+                std::vector<size_t> stack; // positions in `pool` currently included
+                std::vector<size_t> best;
+                uint64_t best_excess = UINT64_MAX;
+                uint64_t value = 0;
+                size_t depth = 0;
+
+                for (size_t tries = 0; tries < s.params.bnb_max_tries; ++tries)
+                {
+                    bool backtrack = false;
+                    if (value + suffix[depth] < target || value > upper)
+                    {
+                        backtrack = true;
+                    }
+                    else if (value >= target)
+                    {
+                        if (value - target < best_excess)
+                        {
+                            best_excess = value - target;
+                            best = stack;
+                            if (best_excess == 0)
+                            {
+                                break;
+                            }
+                        }
+                        backtrack = true;
+                    }
+                    else if (s.params.max_inputs != 0 && s.chosen.size() + stack.size() >= s.params.max_inputs)
+                    {
+                        backtrack = true;
+                    }
+
+                    if (!backtrack)
+                    {
+                        ++s.evaluated;
+                        stack.push_back(depth);
+                        value += values[depth];
+                        ++depth;
+                        continue;
+                    }
+
+                    // Switch the deepest inclusion to its exclusion branch
+                    if (stack.empty())
+                    {
+                        break;
+                    }
+                    const size_t last = stack.back();
+                    stack.pop_back();
+                    value -= values[last];
+                    depth = last + 1;
+                    // Excluding a value makes excluding its equal successors redundant to re-try
+                    while (depth < n && values[depth] == values[last])
+                    {
+                        ++depth;
+                    }
+                }
+
+                if (best_excess == UINT64_MAX)
+                {
+                    return false;
+                }
+                for (size_t i : best)
+                {
+                    s.take(pool[i]);
+                }
+                return true;
+            }
+
+            /**
+             * CIP-2 Random-Improve for a single payment: random picks until the target
+             * is covered, then keep adding random inputs while that moves the total
+             * towards twice the target without exceeding three times it.
+             */
+            bool random_improve(Selection &s, uint64_t target, std::mt19937_64 &rng, bool improve)
+            {
+                auto pool = s.unused_by_amount();
+                const uint64_t start = s.lovelace;
+                size_t next = 0;
+
+                auto draw = [&]() -> uint32_t
+                {
+                    std::uniform_int_distribution<size_t> dist(next, pool.size() - 1);
+                    std::swap(pool[next], pool[dist(rng)]);
+                    ++s.evaluated;
+                    return pool[next++];
+                };
+
+                while (s.lovelace - start < target)
+                {
+                    if (next == pool.size() || s.full())
+                    {
+                        return false;
+                    }
+                    s.take(draw());
+                }
+
+                if (!improve)
+                {
+                    return true;
+                }
+
+                const uint64_t ideal = target * 2;
+                const uint64_t limit = target * 3;
+                while (next < pool.size() && !s.full())
+                {
+                    const uint64_t current = s.lovelace - start;
+                    const uint32_t candidate = draw();
+                    const uint64_t proposed = current + s.index.utxo(candidate).amount_lovelace;
+                    const uint64_t current_distance = ideal > current ? ideal - current : current - ideal;
+                    const uint64_t proposed_distance = ideal > proposed ? ideal - proposed : proposed - ideal;
+                    if (proposed > limit || proposed_distance >= current_distance)
+                    {
+                        break;
+                    }
+                    s.take(candidate);
+                }
+                return true;
+            }
+        } // namespace
+
+        CoinSelectionResult CoinSelector::select(const CoinSelectionIndex &index,
+                                                 uint64_t target_lovelace,
+                                                 const std::map<std::string, uint64_t> &required_tokens,
+                                                 TransactionManager::UTXOSelectionStrategy strategy,
+                                                 const CoinSelectionParams &params)
+        {
+            CoinSelectionResult result;
+            Selection s(index, params);
+
+            if (!cover_tokens(s, required_tokens))
+            {
+                result.inputs_evaluated = s.evaluated;
+                result.algorithm = "tokens";
+                return result;
+            }
+
+            std::mt19937_64 rng(params.seed != 0 ? params.seed : std::random_device{}());
+            const uint64_t remaining = target_lovelace > s.lovelace ? target_lovelace - s.lovelace : 0;
+            const auto &order = index.by_amount_desc();
+            bool covered = remaining == 0;
+
+            if (!covered)
+            {
+                switch (strategy)
+                {
+                case Strategy::LARGEST_FIRST:
+                    result.algorithm = "largest_first";
+                    covered = accumulate_in_order(s, target_lovelace, order.begin(), order.end());
+                    break;
+
+                case Strategy::SMALLEST_FIRST:
+                    result.algorithm = "smallest_first";
+                    covered = accumulate_in_order(s, target_lovelace, order.rbegin(), order.rend());
+                    break;
+
+                case Strategy::RANDOM:
+                    result.algorithm = "random";
+                    covered = random_improve(s, remaining, rng, false);
+                    break;
+
+                case Strategy::OPTIMAL_FEE:
+                {
+                    const size_t mark = s.chosen.size();
+                    if (branch_and_bound(s, remaining))
+                    {
+                        result.algorithm = "branch_and_bound";
+                        result.changeless = true;
+                        covered = true;
+                        break;
+                    }
+                    if (random_improve(s, remaining, rng, true))
+                    {
+                        result.algorithm = "random_improve";
+                        covered = true;
+                        break;
+                    }
+                    // Input limit hit with small random picks; largest-first needs the fewest inputs
+                    s.rollback(mark);
+                    result.algorithm = "largest_first";
+                    covered = accumulate_in_order(s, target_lovelace, order.begin(), order.end());
+                    break;
+                }
+                }
+            }
+
+            result.inputs_evaluated = s.evaluated;
+            if (!covered)
+            {
+                return result;
+            }
+
+            result.success = true;
+            result.selected.reserve(s.chosen.size());
+            for (uint32_t position : s.chosen)
+            {
+                const auto &utxo = index.utxo(position);
+                result.selected.push_back(utxo);
+                result.total_lovelace += utxo.amount_lovelace;
+                for (const auto &[token, amount] : utxo.native_tokens)
+                {
+                    result.total_tokens[token] += amount;
+                }
+            }
+            result.change_lovelace = result.total_lovelace - target_lovelace;
+            return result;
+        }
+
+    } // namespace core
+} // namespace cardano_iot
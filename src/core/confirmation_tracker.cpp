@@ -0,0 +1,405 @@
+#include "cardano_iot/core/confirmation_tracker.h"
+#include "cardano_iot/utils/logger.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace cardano_iot
+{
+    namespace core
+    {
+        class ConfirmationTracker::Impl
+        {
+        public:
+            using Clock = std::chrono::steady_clock;
+
+            struct Entry
+            {
+                std::vector<std::promise<bool>> waiters;
+                uint64_t deadline_tick = 0;
+            };
+
+            struct Resolution
+            {
+                std::string tx_id;
+                std::vector<std::promise<bool>> waiters;
+                bool confirmed = false;
+            };
+
+            StatusQuery status_query_;
+            TipProvider tip_provider_;
+            Config config_;
+
+            mutable std::mutex mutex_;
+            std::condition_variable cv_;
+            std::thread thread_;
+            bool running_ = false;
+            bool stop_requested_ = false;
+            bool check_requested_ = false;
+
+            std::unordered_map<std::string, Entry> pending_;
+
+            // Hashed timer wheel: slot = deadline_tick % wheel_slots; entries a full turn or more
+            // away stay in their slot until their own tick comes round
+            std::vector<std::vector<std::string>> wheel_;
+            Clock::time_point epoch_ = Clock::now();
+            uint64_t processed_tick_ = 0;
+
+            network::ChainTip last_tip_{};
+            Clock::time_point last_tip_poll_{};
+            Clock::time_point last_check_ = Clock::now();
+
+            ConfirmationCallback callback_;
+            TrackerStats stats_{};
+
+            Impl(StatusQuery status_query, TipProvider tip_provider, const Config &config)
+                : status_query_(std::move(status_query)), tip_provider_(std::move(tip_provider)), config_(config)
+            {
+                if (config_.tick.count() <= 0)
+                {
+                    config_.tick = std::chrono::milliseconds(100);
+                }
+                config_.wheel_slots = std::max<size_t>(1, config_.wheel_slots);
+                config_.batch_size = std::max<size_t>(1, config_.batch_size);
+                wheel_.resize(config_.wheel_slots);
+            }
+
+            uint64_t current_tick() const
+            {
+                return static_cast<uint64_t>((Clock::now() - epoch_) / config_.tick);
+            }
+
+            void schedule_locked(const std::string &tx_id, uint64_t deadline_tick)
+            {
+                wheel_[deadline_tick % wheel_.size()].push_back(tx_id);
+            }
+
+            // Expire everything due up to now; called with mutex_ held
+            void advance_wheel_locked(std::vector<Resolution> &resolved)
+            {
+                const uint64_t now_tick = current_tick();
+                if (now_tick <= processed_tick_)
+                {
+                    return;
+                }
+                const uint64_t steps = std::min<uint64_t>(now_tick - processed_tick_, wheel_.size());
+                for (uint64_t step = 1; step <= steps; ++step)
+                {
+                    const size_t slot_index = static_cast<size_t>((processed_tick_ + step) % wheel_.size());
+                    auto &slot = wheel_[slot_index];
+                    std::vector<std::string> kept;
+                    for (auto &tx_id : slot)
+                    {
+                        auto it = pending_.find(tx_id);
+                        if (it == pending_.end())
+                        {
+                            continue;
+                        }
+                        if (it->second.deadline_tick <= now_tick)
+                        {
+                            resolved.push_back({tx_id, std::move(it->second.waiters), false});
+                            pending_.erase(it);
+                            ++stats_.timed_out;
+                        }
+                        else if (it->second.deadline_tick % wheel_.size() == slot_index)
+                        {
+                            kept.push_back(std::move(tx_id));
+                        }
+                        // else: deadline was extended into another slot, which holds its own copy
+                    }
+                    slot.swap(kept);
+                }
+                processed_tick_ = now_tick;
+            }
+
+            bool tip_changed(const network::ChainTip &tip)
+            {
+                if (tip.hash.empty())
+                {
+                    return true; // unknown tip: fall back to checking on every poll
+                }
+                const bool changed = tip.hash != last_tip_.hash || tip.height != last_tip_.height;
+                last_tip_ = tip;
+                return changed;
+            }
+
+            // Query every pending id in batches; runs without mutex_ held
+            void check_pending(std::vector<Resolution> &resolved)
+            {
+                std::vector<std::string> ids;
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    ids.reserve(pending_.size());
+                    for (const auto &entry : pending_)
+                    {
+                        ids.push_back(entry.first);
+                    }
+                    last_check_ = Clock::now();
+                }
+
+                for (size_t begin = 0; begin < ids.size(); begin += config_.batch_size)
+                {
+                    const size_t end = std::min(ids.size(), begin + config_.batch_size);
+                    std::vector<std::string> batch(ids.begin() + begin, ids.begin() + end);
+                    const auto statuses = status_query_(batch);
+
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    ++stats_.batch_queries;
+                    for (size_t i = 0; i < batch.size() && i < statuses.size(); ++i)
+                    {
+                        const auto status = statuses[i];
+                        if (status != TransactionStatus::CONFIRMED && status != TransactionStatus::FAILED &&
+                            status != TransactionStatus::CANCELLED)
+                        {
+                            continue;
+                        }
+                        auto it = pending_.find(batch[i]);
+                        if (it == pending_.end())
+                        {
+                            continue;
+                        }
+                        const bool confirmed = status == TransactionStatus::CONFIRMED;
+                        resolved.push_back({batch[i], std::move(it->second.waiters), confirmed});
+                        pending_.erase(it);
+                        ++(confirmed ? stats_.confirmed : stats_.failed);
+                    }
+                }
+            }
+
+            void deliver(std::vector<Resolution> &resolved)
+            {
+                if (resolved.empty())
+                {
+                    return;
+                }
+                ConfirmationCallback callback;
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    callback = callback_;
+                }
+                // Callback first, so a ready future implies the callback has run
+                for (auto &resolution : resolved)
+                {
+                    if (callback)
+                    {
+                        callback(resolution.tx_id, resolution.confirmed);
+                    }
+                    for (auto &waiter : resolution.waiters)
+                    {
+                        waiter.set_value(resolution.confirmed);
+                    }
+                }
+                resolved.clear();
+            }
+
+            void run()
+            {
+                std::vector<Resolution> resolved;
+                while (true)
+                {
+                    bool check = false;
+                    bool poll_tip = false;
+                    {
+                        std::unique_lock<std::mutex> lock(mutex_);
+                        cv_.wait_for(lock, config_.tick, [this]()
+                                     { return stop_requested_ || check_requested_; });
+                        if (stop_requested_)
+                        {
+                            break;
+                        }
+
+                        advance_wheel_locked(resolved);
+
+                        const auto now = Clock::now();
+                        if (!pending_.empty())
+                        {
+                            check = check_requested_ || now - last_check_ >= config_.max_check_interval;
+                            poll_tip = !check && now - last_tip_poll_ >= config_.tip_poll_interval;
+                        }
+                        check_requested_ = false;
+                        if (poll_tip)
+                        {
+                            last_tip_poll_ = now;
+                        }
+                    }
+
+                    if (poll_tip)
+                    {
+                        const auto tip = tip_provider_ ? tip_provider_() : network::ChainTip{};
+                        if (tip_changed(tip))
+                        {
+                            check = true;
+                            std::lock_guard<std::mutex> lock(mutex_);
+                            ++stats_.tip_changes;
+                        }
+                    }
+                    if (check)
+                    {
+                        check_pending(resolved);
+                    }
+                    deliver(resolved);
+                }
+            }
+        };
+
+        ConfirmationTracker::ConfirmationTracker(StatusQuery status_query, TipProvider tip_provider)
+            : ConfirmationTracker(std::move(status_query), std::move(tip_provider), Config{})
+        {
+        }
+
+        ConfirmationTracker::ConfirmationTracker(StatusQuery status_query, TipProvider tip_provider, const Config &config)
+            : pimpl_(std::make_unique<Impl>(std::move(status_query), std::move(tip_provider), config))
+        {
+        }
+
+        ConfirmationTracker::~ConfirmationTracker()
+        {
+            stop();
+        }
+
+        ConfirmationTracker::TipProvider ConfirmationTracker::client_tip_provider(std::shared_ptr<network::CardanoClient> client)
+        {
+            return [client]()
+            {
+                return client && client->is_connected() ? client->get_chain_tip() : network::ChainTip{};
+            };
+        }
+
+        bool ConfirmationTracker::start()
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+            if (pimpl_->running_)
+            {
+                return true;
+            }
+            if (!pimpl_->status_query_)
+            {
+                utils::Logger::instance().log(utils::LogLevel::ERROR, "ConfirmationTracker",
+                                              "No status query configured");
+                return false;
+            }
+            pimpl_->stop_requested_ = false;
+            pimpl_->running_ = true;
+            pimpl_->thread_ = std::thread([this]()
+                                          { pimpl_->run(); });
+            return true;
+        }
+
+        void ConfirmationTracker::stop()
+        {
+            std::unordered_map<std::string, Impl::Entry> abandoned;
+            {
+                std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+                if (!pimpl_->running_)
+                {
+                    return;
+                }
+                pimpl_->stop_requested_ = true;
+            }
+            pimpl_->cv_.notify_all();
+            if (pimpl_->thread_.joinable())
+            {
+                pimpl_->thread_.join();
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+                pimpl_->running_ = false;
+                abandoned.swap(pimpl_->pending_);
+                for (auto &slot : pimpl_->wheel_)
+                {
+                    slot.clear();
+                }
+            }
+            for (auto &entry : abandoned)
+            {
+                for (auto &waiter : entry.second.waiters)
+                {
+                    waiter.set_value(false);
+                }
+            }
+        }
+
+        bool ConfirmationTracker::is_running() const
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+            return pimpl_->running_;
+        }
+
+        std::future<bool> ConfirmationTracker::track(const std::string &tx_id, std::chrono::milliseconds timeout)
+        {
+            std::promise<bool> promise;
+            auto future = promise.get_future();
+
+            std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+            const uint64_t ticks = std::max<uint64_t>(
+                1, static_cast<uint64_t>((timeout + pimpl_->config_.tick - std::chrono::milliseconds(1)) /
+                                         pimpl_->config_.tick));
+            const uint64_t deadline = pimpl_->current_tick() + ticks;
+
+            auto [it, inserted] = pimpl_->pending_.try_emplace(tx_id);
+            it->second.waiters.push_back(std::move(promise));
+            if (inserted)
+            {
+                ++pimpl_->stats_.tracked;
+            }
+            if (inserted || deadline > it->second.deadline_tick)
+            {
+                it->second.deadline_tick = deadline;
+                pimpl_->schedule_locked(tx_id, deadline);
+            }
+            return future;
+        }
+
+        bool ConfirmationTracker::untrack(const std::string &tx_id)
+        {
+            Impl::Entry entry;
+            {
+                std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+                auto it = pimpl_->pending_.find(tx_id);
+                if (it == pimpl_->pending_.end())
+                {
+                    return false;
+                }
+                entry = std::move(it->second);
+                pimpl_->pending_.erase(it);
+            }
+            for (auto &waiter : entry.waiters)
+            {
+                waiter.set_value(false);
+            }
+            return true;
+        }
+
+        void ConfirmationTracker::set_callback(ConfirmationCallback callback)
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+            pimpl_->callback_ = std::move(callback);
+        }
+
+        void ConfirmationTracker::request_check()
+        {
+            {
+                std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+                pimpl_->check_requested_ = true;
+            }
+            pimpl_->cv_.notify_one();
+        }
+
+        size_t ConfirmationTracker::pending_count() const
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+            return pimpl_->pending_.size();
+        }
+
+        ConfirmationTracker::TrackerStats ConfirmationTracker::get_statistics() const
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+            return pimpl_->stats_;
+        }
+
+    } // namespace core
+} // namespace cardano_iot
@@ -1,5 +1,10 @@
 #include "cardano_iot/core/crypto_manager.h"
 #include "cardano_iot/utils/logger.h"
+#include "cardano_iot/utils/codec.h"
+#include "cardano_iot/utils/executor.h"
+#include "cardano_iot/utils/hash.h"
+#include "cardano_iot/utils/metrics.h"
+#include "cardano_iot/performance/performance_optimizer.h"
 
 #include <openssl/evp.h>
 #include <openssl/rand.h>
@@ -8,8 +13,6 @@
 #include <openssl/aes.h>
 #include <openssl/ec.h>
 #include <openssl/ecdsa.h>
-#include <openssl/bio.h>
-#include <openssl/buffer.h>
 
 #include <chrono>
 #include <sstream>
@@ -17,35 +20,187 @@
 #include <mutex>
 #include <algorithm>
 #include <random>
+#include <atomic>
+#include <thread>
+#include <unordered_map>
+#include <cctype>
 
 namespace cardano_iot
 {
     namespace core
     {
+        namespace
+        {
+            constexpr size_t ED25519_KEY_SIZE = 32;
+            constexpr size_t ED25519_SIGNATURE_SIZE = 64;
+            constexpr size_t THREAD_KEY_CACHE_LIMIT = 1024;
+            constexpr size_t PARALLEL_BATCH_THRESHOLD = 64;
+
+            struct EvpPkeyDeleter
+            {
+                void operator()(EVP_PKEY *pkey) const { EVP_PKEY_free(pkey); }
+            };
+
+            struct EvpMdCtxDeleter
+            {
+                void operator()(EVP_MD_CTX *ctx) const { EVP_MD_CTX_free(ctx); }
+            };
+
+            struct CachedKey
+            {
+                std::unique_ptr<EVP_PKEY, EvpPkeyDeleter> pkey;
+                std::string public_key_hex;
+            };
+
+            /**
+             * Per-thread OpenSSL state: one reusable digest context plus parsed
+             * Ed25519 keys, so concurrent signers never share (or lock) a context.
+             */
+            struct ThreadCryptoContext
+            {
+                std::unique_ptr<EVP_MD_CTX, EvpMdCtxDeleter> md_ctx{EVP_MD_CTX_new()};
+                std::unordered_map<std::string, CachedKey> private_keys;
+                std::unordered_map<std::string, CachedKey> public_keys;
+
+                const CachedKey *private_key(const std::vector<uint8_t> &raw)
+                {
+                    std::string cache_key(raw.begin(), raw.end());
+                    auto it = private_keys.find(cache_key);
+                    if (it != private_keys.end())
+                    {
+                        return &it->second;
+                    }
+
+                    CachedKey entry;
+                    entry.pkey.reset(EVP_PKEY_new_raw_private_key(EVP_PKEY_ED25519, nullptr, raw.data(), raw.size()));
+                    if (!entry.pkey)
+                    {
+                        return nullptr;
+                    }
+
+                    uint8_t pub[ED25519_KEY_SIZE];
+                    size_t pub_len = sizeof(pub);
+                    if (EVP_PKEY_get_raw_public_key(entry.pkey.get(), pub, &pub_len) <= 0)
+                    {
+                        return nullptr;
+                    }
+                    entry.public_key_hex.resize(utils::codec::hex_encoded_size(pub_len));
+                    utils::codec::hex_encode(pub, pub_len, entry.public_key_hex.data());
+
+                    if (private_keys.size() >= THREAD_KEY_CACHE_LIMIT)
+                    {
+                        private_keys.clear();
+                    }
+                    return &private_keys.emplace(std::move(cache_key), std::move(entry)).first->second;
+                }
+
+                const CachedKey *public_key(const std::vector<uint8_t> &raw)
+                {
+                    std::string cache_key(raw.begin(), raw.end());
+                    auto it = public_keys.find(cache_key);
+                    if (it != public_keys.end())
+                    {
+                        return &it->second;
+                    }
+
+                    CachedKey entry;
+                    entry.pkey.reset(EVP_PKEY_new_raw_public_key(EVP_PKEY_ED25519, nullptr, raw.data(), raw.size()));
+                    if (!entry.pkey)
+                    {
+                        return nullptr;
+                    }
+
+                    if (public_keys.size() >= THREAD_KEY_CACHE_LIMIT)
+                    {
+                        public_keys.clear();
+                    }
+                    return &public_keys.emplace(std::move(cache_key), std::move(entry)).first->second;
+                }
+            };
+
+            ThreadCryptoContext &thread_crypto_context()
+            {
+                thread_local ThreadCryptoContext context;
+                return context;
+            }
+
+            bool is_hex_of_size(const std::string &value, size_t bytes)
+            {
+                return value.size() == bytes * 2 &&
+                       std::all_of(value.begin(), value.end(), [](unsigned char c)
+                                   { return std::isxdigit(c) != 0; });
+            }
+
+            double elapsed_ms(std::chrono::steady_clock::time_point start)
+            {
+                return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            }
+
+            // Run fn(i) for i in [0, count) on the executor, or on the calling thread without one
+            template <typename Fn>
+            void parallel_for(utils::Executor *executor, size_t count, Fn fn)
+            {
+                if (executor)
+                {
+                    executor->parallel_for(count, fn, PARALLEL_BATCH_THRESHOLD / 2);
+                    return;
+                }
+                for (size_t i = 0; i < count; ++i)
+                {
+                    fn(i);
+                }
+            }
+        } // namespace
+
         // PIMPL implementation
         struct CryptoManager::Impl
         {
-            bool initialized_ = false;
+            std::atomic<bool> initialized_{false};
             std::mutex crypto_mutex_;
             std::map<std::string, std::shared_ptr<KeyPair>> device_keys_;
+            std::shared_ptr<utils::Executor> executor_;     // Guarded by crypto_mutex_
+            std::shared_ptr<utils::Executor> own_executor_; // Started on the first large batch without executor_
 
-            // Statistics
-            mutable std::mutex stats_mutex_;
-            CryptoStats stats_ = {};
-
-            // Timing helpers
-            std::chrono::high_resolution_clock::time_point start_time_;
-
-            void start_timing()
+            // Workers for a batch; they persist, so their thread-local keys and contexts are reused
+            std::shared_ptr<utils::Executor> batch_executor(size_t count)
             {
-                start_time_ = std::chrono::high_resolution_clock::now();
+                std::lock_guard<std::mutex> lock(crypto_mutex_);
+                if (executor_ || count < PARALLEL_BATCH_THRESHOLD || std::thread::hardware_concurrency() <= 1)
+                {
+                    return executor_;
+                }
+                if (!own_executor_)
+                {
+                    utils::ExecutorOptions options;
+                    options.name = "crypto";
+                    own_executor_ = std::make_shared<utils::Executor>(options);
+                }
+                return own_executor_;
             }
 
-            double get_elapsed_ms()
+            // Statistics: per-core metrics, operation counts are the histograms' counts
+            utils::metrics::Counter keys_generated_{"cardano_iot_crypto_keys_generated_total", "Key pairs generated"};
+            utils::metrics::Counter hashes_computed_{"cardano_iot_crypto_hashes_total", "Hashes computed"};
+            utils::metrics::Counter random_bytes_generated_{"cardano_iot_crypto_random_bytes_total", "Random bytes generated"};
+            utils::metrics::Histogram sign_ms_{"cardano_iot_crypto_sign_duration_ms", "Signing time in milliseconds",
+                                               utils::metrics::Histogram::latency_ms_bounds()};
+            utils::metrics::Histogram verify_ms_{"cardano_iot_crypto_verify_duration_ms", "Signature verification time in milliseconds",
+                                                 utils::metrics::Histogram::latency_ms_bounds()};
+            utils::metrics::Histogram encrypt_ms_{"cardano_iot_crypto_encrypt_duration_ms", "Encryption time in milliseconds",
+                                                  utils::metrics::Histogram::latency_ms_bounds()};
+            utils::metrics::Histogram decrypt_ms_{"cardano_iot_crypto_decrypt_duration_ms", "Decryption time in milliseconds",
+                                                  utils::metrics::Histogram::latency_ms_bounds()};
+
+            void reset_counters()
             {
-                auto end_time = std::chrono::high_resolution_clock::now();
-                auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time_);
-                return duration.count() / 1000.0; // Convert to milliseconds
+                for (auto *counter : {&keys_generated_, &hashes_computed_, &random_bytes_generated_})
+                {
+                    counter->reset();
+                }
+                for (auto *histogram : {&sign_ms_, &verify_ms_, &encrypt_ms_, &decrypt_ms_})
+                {
+                    histogram->reset();
+                }
             }
 
             // Generate unique key ID
@@ -63,64 +218,25 @@ namespace cardano_iot
                 return ss.str();
             }
 
-            // Convert bytes to hex string
+            // Hex/base64 helpers backed by the shared codec module
             std::string bytes_to_hex(const std::vector<uint8_t> &bytes)
             {
-                std::stringstream ss;
-                ss << std::hex << std::setfill('0');
-                for (uint8_t byte : bytes)
-                {
-                    ss << std::setw(2) << static_cast<int>(byte);
-                }
-                return ss.str();
+                return utils::codec::hex_encode(bytes);
             }
 
-            // Convert hex string to bytes
             std::vector<uint8_t> hex_to_bytes(const std::string &hex)
             {
-                std::vector<uint8_t> bytes;
-                for (size_t i = 0; i < hex.length(); i += 2)
-                {
-                    std::string byteString = hex.substr(i, 2);
-                    uint8_t byte = static_cast<uint8_t>(strtol(byteString.c_str(), nullptr, 16));
-                    bytes.push_back(byte);
-                }
-                return bytes;
+                return utils::codec::hex_decode(hex);
             }
 
-            // Base64 encoding/decoding
             std::string base64_encode(const std::vector<uint8_t> &data)
             {
-                BIO *bio = BIO_new(BIO_s_mem());
-                BIO *b64 = BIO_new(BIO_f_base64());
-                BIO_set_flags(b64, BIO_FLAGS_BASE64_NO_NL);
-                bio = BIO_push(b64, bio);
-
-                BIO_write(bio, data.data(), data.size());
-                BIO_flush(bio);
-
-                BUF_MEM *buffer_ptr;
-                BIO_get_mem_ptr(bio, &buffer_ptr);
-
-                std::string result(buffer_ptr->data, buffer_ptr->length);
-                BIO_free_all(bio);
-
-                return result;
+                return utils::codec::base64_encode(data);
             }
 
             std::vector<uint8_t> base64_decode(const std::string &encoded)
             {
-                BIO *bio = BIO_new_mem_buf(encoded.c_str(), -1);
-                BIO *b64 = BIO_new(BIO_f_base64());
-                BIO_set_flags(b64, BIO_FLAGS_BASE64_NO_NL);
-                bio = BIO_push(b64, bio);
-
-                std::vector<uint8_t> result(encoded.length());
-                int decoded_length = BIO_read(bio, result.data(), encoded.length());
-                result.resize(decoded_length);
-
-                BIO_free_all(bio);
-                return result;
+                return utils::codec::base64_decode(encoded);
             }
 
             // Generate ED25519 key pair
@@ -204,6 +320,86 @@ namespace cardano_iot
                 return bytes_to_hex(hash);
             }
 
+            // Ed25519 when the key is a raw 32-byte hex key, legacy digest for demo keys
+            std::unique_ptr<DigitalSignature> sign_one(const std::string &message,
+                                                       const std::string &private_key,
+                                                       CryptoAlgorithm algorithm)
+            {
+                auto start = std::chrono::steady_clock::now();
+
+                auto signature = std::make_unique<DigitalSignature>();
+                signature->algorithm = algorithm;
+                signature->message_hash = compute_sha256(message);
+                signature->timestamp = std::chrono::duration_cast<std::chrono::seconds>(
+                                           std::chrono::system_clock::now().time_since_epoch())
+                                           .count();
+
+                const CachedKey *key = nullptr;
+                if (is_hex_of_size(private_key, ED25519_KEY_SIZE))
+                {
+                    key = thread_crypto_context().private_key(hex_to_bytes(private_key));
+                }
+
+                if (key)
+                {
+                    auto &context = thread_crypto_context();
+                    EVP_MD_CTX *ctx = context.md_ctx.get();
+                    uint8_t sig[ED25519_SIGNATURE_SIZE];
+                    size_t sig_len = sizeof(sig);
+
+                    EVP_MD_CTX_reset(ctx);
+                    if (EVP_DigestSignInit(ctx, nullptr, nullptr, nullptr, key->pkey.get()) <= 0 ||
+                        EVP_DigestSign(ctx, sig, &sig_len,
+                                       reinterpret_cast<const unsigned char *>(message.data()), message.size()) <= 0)
+                    {
+                        return nullptr;
+                    }
+                    signature->signature = bytes_to_hex(std::vector<uint8_t>(sig, sig + sig_len));
+                    signature->public_key = key->public_key_hex;
+                }
+                else
+                {
+                    // Simplified signature generation for demo keys, marked so it is never taken for Ed25519
+                    signature->algorithm = CryptoAlgorithm::DEMO_DIGEST;
+                    signature->signature = compute_sha256(message + private_key);
+                }
+
+                sign_ms_.observe(elapsed_ms(start));
+                return signature;
+            }
+
+            bool verify_one(const DigitalSignature &signature, const std::string &message)
+            {
+                auto start = std::chrono::steady_clock::now();
+
+                bool valid = (compute_sha256(message) == signature.message_hash);
+
+                // Anyone can compute the digest, so only a signature marked as a demo one may rest on it
+                const bool ed25519 = signature.algorithm != CryptoAlgorithm::DEMO_DIGEST;
+                if (valid && ed25519 &&
+                    (!is_hex_of_size(signature.public_key, ED25519_KEY_SIZE) ||
+                     !is_hex_of_size(signature.signature, ED25519_SIGNATURE_SIZE)))
+                {
+                    valid = false;
+                }
+                else if (valid && ed25519)
+                {
+                    const CachedKey *key = thread_crypto_context().public_key(hex_to_bytes(signature.public_key));
+                    auto sig = hex_to_bytes(signature.signature);
+
+                    EVP_MD_CTX *ctx = thread_crypto_context().md_ctx.get();
+                    EVP_MD_CTX_reset(ctx);
+                    valid = key &&
+                            EVP_DigestVerifyInit(ctx, nullptr, nullptr, nullptr, key->pkey.get()) > 0 &&
+                            EVP_DigestVerify(ctx, sig.data(), sig.size(),
+                                             reinterpret_cast<const unsigned char *>(message.data()),
+                                             message.size()) == 1;
+                }
+
+                verify_ms_.observe(elapsed_ms(start));
+                return valid;
+            }
+
             // Generate mock Cardano address (simplified for demo)
             std::string generate_mock_cardano_address(const std::string &public_key, const std::string &network)
             {
@@ -268,9 +464,6 @@ namespace cardano_iot
                 return nullptr;
             }
 
-            std::lock_guard<std::mutex> stats_lock(pimpl_->stats_mutex_);
-            pimpl_->start_timing();
-
             std::unique_ptr<KeyPair> result;
 
             switch (algorithm)
@@ -301,7 +494,7 @@ namespace cardano_iot
 
             if (result)
             {
-                pimpl_->stats_.keys_generated++;
+                pimpl_->keys_generated_.inc();
                 utils::Logger::instance().log(utils::LogLevel::INFO, "CryptoManager",
                                               "Generated key pair: " + result->key_id);
             }
@@ -388,31 +581,16 @@ namespace cardano_iot
             const std::string &private_key,
             CryptoAlgorithm algorithm)
         {
+            PROFILE_SCOPE("CryptoManager::sign_message");
             if (!pimpl_->initialized_)
             {
                 return nullptr;
             }
 
-            std::lock_guard<std::mutex> stats_lock(pimpl_->stats_mutex_);
-            pimpl_->start_timing();
+            auto signature = pimpl_->sign_one(message, private_key, algorithm);
 
-            auto signature = std::make_unique<DigitalSignature>();
-
-            // Simplified signature generation for demo
-            std::string combined = message + private_key;
-            signature->signature = pimpl_->compute_sha256(combined);
-            signature->algorithm = algorithm;
-            signature->message_hash = pimpl_->compute_sha256(message);
-            signature->timestamp = std::chrono::duration_cast<std::chrono::seconds>(
-                                       std::chrono::system_clock::now().time_since_epoch())
-                                       .count();
-
-            double elapsed = pimpl_->get_elapsed_ms();
-            pimpl_->stats_.signatures_created++;
-            pimpl_->stats_.avg_sign_time_ms = (pimpl_->stats_.avg_sign_time_ms + elapsed) / 2.0;
-
-            utils::Logger::instance().log(utils::LogLevel::INFO, "CryptoManager",
-                                          "Created digital signature");
+            utils::Logger::instance().log(utils::LogLevel::DEBUG, "CryptoManager",
+                                          signature ? "Created digital signature" : "Signing failed");
 
             return signature;
         }
@@ -424,21 +602,59 @@ namespace cardano_iot
                 return false;
             }
 
-            std::lock_guard<std::mutex> stats_lock(pimpl_->stats_mutex_);
-            pimpl_->start_timing();
+            bool valid = pimpl_->verify_one(signature, message);
+
+            utils::Logger::instance().log(utils::LogLevel::DEBUG, "CryptoManager",
+                                          valid ? "Signature verified successfully" : "Signature verification failed");
+
+            return valid;
+        }
+
+        std::vector<std::unique_ptr<DigitalSignature>> CryptoManager::sign_batch(
+            const std::vector<std::string> &messages,
+            const std::string &private_key,
+            CryptoAlgorithm algorithm)
+        {
+            std::vector<std::unique_ptr<DigitalSignature>> signatures(messages.size());
+            if (!pimpl_->initialized_)
+            {
+                return signatures;
+            }
+
+            parallel_for(pimpl_->batch_executor(messages.size()).get(), messages.size(), [&](size_t i)
+                         { signatures[i] = pimpl_->sign_one(messages[i], private_key, algorithm); });
+
+            utils::Logger::instance().log(utils::LogLevel::INFO, "CryptoManager",
+                                          "Signed batch of " + std::to_string(messages.size()) + " messages");
 
-            // Simplified verification for demo - check message hash
-            std::string computed_hash = pimpl_->compute_sha256(message);
-            bool valid = (computed_hash == signature.message_hash);
+            return signatures;
+        }
 
-            double elapsed = pimpl_->get_elapsed_ms();
-            pimpl_->stats_.signatures_verified++;
-            pimpl_->stats_.avg_verify_time_ms = (pimpl_->stats_.avg_verify_time_ms + elapsed) / 2.0;
+        std::vector<bool> CryptoManager::verify_batch(const std::vector<DigitalSignature> &signatures,
+                                                      const std::vector<std::string> &messages)
+        {
+            if (!pimpl_->initialized_ || signatures.size() != messages.size())
+            {
+                return std::vector<bool>(signatures.size(), false);
+            }
 
+            // std::vector<bool> packs bits, so collect into bytes before converting
+            std::vector<uint8_t> results(signatures.size(), 0);
+            parallel_for(pimpl_->batch_executor(signatures.size()).get(), signatures.size(), [&](size_t i)
+                         { results[i] = pimpl_->verify_one(signatures[i], messages[i]) ? 1 : 0; });
+
+            size_t valid_count = std::count(results.begin(), results.end(), 1);
             utils::Logger::instance().log(utils::LogLevel::INFO, "CryptoManager",
-                                          valid ? "Signature verified successfully" : "Signature verification failed");
+                                          "Verified batch: " + std::to_string(valid_count) + "/" +
+                                              std::to_string(results.size()) + " valid");
 
-            return valid;
+            return std::vector<bool>(results.begin(), results.end());
+        }
+
+        void CryptoManager::set_executor(std::shared_ptr<utils::Executor> executor)
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->crypto_mutex_);
+            pimpl_->executor_ = std::move(executor);
         }
 
         std::unique_ptr<EncryptionResult> CryptoManager::encrypt_data(
@@ -451,8 +667,7 @@ namespace cardano_iot
                 return nullptr;
             }
 
-            std::lock_guard<std::mutex> stats_lock(pimpl_->stats_mutex_);
-            pimpl_->start_timing();
+            auto start = std::chrono::steady_clock::now();
 
             auto result = std::make_unique<EncryptionResult>();
 
@@ -474,9 +689,7 @@ namespace cardano_iot
             result->auth_tag = pimpl_->compute_sha256(result->encrypted_data + result->nonce);
             result->algorithm = algorithm;
 
-            double elapsed = pimpl_->get_elapsed_ms();
-            pimpl_->stats_.encryptions_performed++;
-            pimpl_->stats_.avg_encrypt_time_ms = (pimpl_->stats_.avg_encrypt_time_ms + elapsed) / 2.0;
+            pimpl_->encrypt_ms_.observe(elapsed_ms(start));
 
             utils::Logger::instance().log(utils::LogLevel::INFO, "CryptoManager",
                                           "Data encrypted successfully");
@@ -493,8 +706,7 @@ namespace cardano_iot
                 return {};
             }
 
-            std::lock_guard<std::mutex> stats_lock(pimpl_->stats_mutex_);
-            pimpl_->start_timing();
+            auto start = std::chrono::steady_clock::now();
 
             // Verify auth tag
             std::string computed_tag = pimpl_->compute_sha256(encrypted.encrypted_data + encrypted.nonce);
@@ -516,9 +728,7 @@ namespace cardano_iot
                 decrypted[i] = encrypted_bytes[i] ^ key_bytes[i % key_bytes.size()];
             }
 
-            double elapsed = pimpl_->get_elapsed_ms();
-            pimpl_->stats_.decryptions_performed++;
-            pimpl_->stats_.avg_decrypt_time_ms = (pimpl_->stats_.avg_decrypt_time_ms + elapsed) / 2.0;
+            pimpl_->decrypt_ms_.observe(elapsed_ms(start));
 
             utils::Logger::instance().log(utils::LogLevel::INFO, "CryptoManager",
                                           "Data decrypted successfully");
@@ -527,26 +737,57 @@ namespace cardano_iot
         }
 
         std::string CryptoManager::compute_hash(const std::string &data, const std::string &algorithm)
+        {
+            return compute_hash(reinterpret_cast<const uint8_t *>(data.data()), data.size(), algorithm);
+        }
+
+        std::string CryptoManager::compute_hash(const uint8_t *data, size_t size, const std::string &algorithm)
         {
             if (!pimpl_->initialized_)
             {
                 return "";
             }
 
-            std::lock_guard<std::mutex> stats_lock(pimpl_->stats_mutex_);
+            // Unknown names default to SHA256
+            utils::HashAlgorithm hash_algorithm = utils::HashAlgorithm::SHA256;
+            utils::parse_hash_algorithm(algorithm, hash_algorithm);
+            const std::vector<uint8_t> digest = utils::Hasher::digest(hash_algorithm, data, size);
+
+            pimpl_->hashes_computed_.inc();
+            return pimpl_->bytes_to_hex(digest);
+        }
+
+        std::vector<std::string> CryptoManager::compute_hashes(const std::vector<std::string> &inputs,
+                                                               const std::string &algorithm)
+        {
+            if (!pimpl_->initialized_)
+            {
+                return {};
+            }
+
+            utils::HashAlgorithm hash_algorithm = utils::HashAlgorithm::SHA256;
+            utils::parse_hash_algorithm(algorithm, hash_algorithm);
+            const size_t stride = utils::digest_size(hash_algorithm);
 
-            std::string result;
-            if (algorithm == "SHA256" || algorithm == "sha256")
+            std::vector<utils::ByteRange> ranges;
+            ranges.reserve(inputs.size());
+            for (const auto &input : inputs)
             {
-                result = pimpl_->compute_sha256(data);
+                ranges.push_back({reinterpret_cast<const uint8_t *>(input.data()), input.size()});
             }
-            else
+            std::vector<uint8_t> digests(inputs.size() * stride);
+            if (!utils::hash_many(hash_algorithm, ranges.data(), ranges.size(), digests.data(), 0))
             {
-                // Default to SHA256
-                result = pimpl_->compute_sha256(data);
+                return {};
             }
 
-            pimpl_->stats_.hashes_computed++;
+            std::vector<std::string> result(inputs.size());
+            for (size_t i = 0; i < inputs.size(); ++i)
+            {
+                result[i].resize(utils::codec::hex_encoded_size(stride));
+                utils::codec::hex_encode(digests.data() + i * stride, stride, result[i].data());
+            }
+            pimpl_->hashes_computed_.inc(inputs.size());
             return result;
         }
 
@@ -591,9 +832,8 @@ namespace cardano_iot
                 return {};
             }
 
-            std::lock_guard<std::mutex> stats_lock(pimpl_->stats_mutex_);
             auto result = pimpl_->generate_secure_random(length);
-            pimpl_->stats_.random_bytes_generated += length;
+            pimpl_->random_bytes_generated_.inc(length);
             return result;
         }
 
@@ -648,14 +888,33 @@ namespace cardano_iot
 
         CryptoManager::CryptoStats CryptoManager::get_statistics() const
         {
-            std::lock_guard<std::mutex> lock(pimpl_->stats_mutex_);
-            return pimpl_->stats_;
+            const auto &p = *pimpl_;
+
+            const auto sign = p.sign_ms_.snapshot();
+            const auto verify = p.verify_ms_.snapshot();
+            const auto encrypt = p.encrypt_ms_.snapshot();
+            const auto decrypt = p.decrypt_ms_.snapshot();
+
+            CryptoStats stats = {};
+            stats.keys_generated = p.keys_generated_.value();
+            stats.signatures_created = sign.count;
+            stats.signatures_verified = verify.count;
+            stats.encryptions_performed = encrypt.count;
+            stats.decryptions_performed = decrypt.count;
+            stats.hashes_computed = p.hashes_computed_.value();
+            stats.random_bytes_generated = p.random_bytes_generated_.value();
+            stats.avg_sign_time_ms = sign.mean();
+            stats.avg_verify_time_ms = verify.mean();
+            stats.avg_encrypt_time_ms = encrypt.mean();
+            stats.avg_decrypt_time_ms = decrypt.mean();
+            stats.p95_sign_time_ms = sign.quantile(0.95);
+            stats.p95_verify_time_ms = verify.quantile(0.95);
+            return stats;
         }
 
         void CryptoManager::reset_statistics()
         {
-            std::lock_guard<std::mutex> lock(pimpl_->stats_mutex_);
-            pimpl_->stats_ = {};
+            pimpl_->reset_counters();
             utils::Logger::instance().log(utils::LogLevel::INFO, "CryptoManager",
                                           "Statistics reset");
         }
@@ -7,7 +7,10 @@
  */
 
 #include "cardano_iot/core/device_manager.h"
+#include "cardano_iot/core/device_registry.h"
+#include "cardano_iot/core/device_snapshot.h"
 #include "cardano_iot/utils/logger.h"
+#include "cardano_iot/utils/timer_wheel.h"
 #include "cardano_iot/network/network_utils.h"
 #include "cardano_iot/security/authentication.h"
 
@@ -19,21 +22,41 @@
 #include <sstream>
 #include <iomanip>
 #include <chrono>
+#include <atomic>
 
 using json = nlohmann::json;
 
 namespace cardano_iot::core
 {
 
+    namespace
+    {
+        constexpr std::chrono::seconds CHALLENGE_TTL{300};
+        constexpr size_t REGISTRY_SHARDS = 64;
+
+        uint64_t now_seconds()
+        {
+            return std::chrono::duration_cast<std::chrono::seconds>(
+                       std::chrono::system_clock::now().time_since_epoch())
+                .count();
+        }
+    }
+
     // PIMPL implementation
     class DeviceManager::Impl
     {
     public:
-        std::unordered_map<std::string, std::shared_ptr<Device>> devices_;
-        std::unordered_map<std::string, std::string> active_challenges_;
+        struct PendingChallenge
+        {
+            std::string challenge;
+            utils::TimerWheel::Handle expiry;
+        };
+
+        DeviceRegistry devices_{REGISTRY_SHARDS}; // locks per shard
+        std::unordered_map<std::string, PendingChallenge> active_challenges_;
         std::unordered_map<std::string, bool> authenticated_devices_;
         DeviceEventCallback event_callback_;
-        mutable std::mutex devices_mutex_;
+        mutable std::mutex devices_mutex_; // lifecycle and authenticated_devices_
         mutable std::mutex challenges_mutex_;
         bool initialized_ = false;
 
@@ -42,6 +65,62 @@ namespace cardano_iot::core
         std::atomic<uint32_t> total_authentications_{0};
         std::atomic<uint32_t> failed_authentications_{0};
 
+        // Changes since the last export, appended to <export path>.wal
+        mutable DeviceJournal journal_;
+        mutable std::mutex journal_mutex_;
+
+        // Unanswered challenges expire in the background; last member so it goes first
+        utils::TimerWheel::Scope timers_;
+
+        // Heartbeats are not journaled: last_seen only advances, and a restored
+        // device that missed a few simply looks stale until its next one
+        void journal_upsert(const std::string &device_id)
+        {
+            std::lock_guard<std::mutex> lock(journal_mutex_);
+            if (!journal_.is_open())
+            {
+                return;
+            }
+            auto device = devices_.find(device_id);
+            if (device && !journal_.record_upsert(*device))
+            {
+                utils::Logger::instance().log(utils::LogLevel::WARNING, "DeviceManager",
+                                              "Failed to journal change to device: " + device_id);
+            }
+        }
+
+        void journal_remove(const std::string &device_id)
+        {
+            std::lock_guard<std::mutex> lock(journal_mutex_);
+            if (journal_.is_open() && !journal_.record_remove(device_id))
+            {
+                utils::Logger::instance().log(utils::LogLevel::WARNING, "DeviceManager",
+                                              "Failed to journal removal of device: " + device_id);
+            }
+        }
+
+        // Caller holds challenges_mutex_
+        void drop_challenge(const std::string &device_id)
+        {
+            auto it = active_challenges_.find(device_id);
+            if (it != active_challenges_.end())
+            {
+                timers_.cancel(it->second.expiry);
+                active_challenges_.erase(it);
+            }
+        }
+
+        void expire_challenge(const std::string &device_id, const std::string &challenge)
+        {
+            std::lock_guard<std::mutex> lock(challenges_mutex_);
+            auto it = active_challenges_.find(device_id);
+            if (it != active_challenges_.end() && it->second.challenge == challenge)
+            {
+                active_challenges_.erase(it);
+                CARDANO_IOT_LOG(utils::LogLevel::DEBUG, "DeviceManager", "Challenge expired for device: " << device_id);
+            }
+        }
+
         void notify_event(const std::string &device_id, DeviceEvent event, const std::string &details = "")
         {
             if (event_callback_)
@@ -126,7 +205,14 @@ namespace cardano_iot::core
 
         // Clear all data
         pimpl_->devices_.clear();
-        pimpl_->active_challenges_.clear();
+        {
+            std::lock_guard<std::mutex> challenges_lock(pimpl_->challenges_mutex_);
+            for (const auto &[device_id, pending] : pimpl_->active_challenges_)
+            {
+                pimpl_->timers_.cancel(pending.expiry);
+            }
+            pimpl_->active_challenges_.clear();
+        }
         pimpl_->authenticated_devices_.clear();
 
         pimpl_->initialized_ = false;
@@ -143,16 +229,6 @@ namespace cardano_iot::core
             return false;
         }
 
-        std::lock_guard<std::mutex> lock(pimpl_->devices_mutex_);
-
-        // Check if device already exists
-        if (pimpl_->devices_.find(device.device_id) != pimpl_->devices_.end())
-        {
-            utils::Logger::instance().log(utils::LogLevel::WARNING, "DeviceManager",
-                                          "Device already registered: " + device.device_id);
-            return false;
-        }
-
         // Validate device information
         if (device.device_id.empty() || device.public_key.empty())
         {
@@ -163,16 +239,20 @@ namespace cardano_iot::core
 
         // Create device copy with additional computed fields
         auto new_device = std::make_shared<Device>(device);
-        new_device->registration_time = std::chrono::duration_cast<std::chrono::seconds>(
-                                            std::chrono::system_clock::now().time_since_epoch())
-                                            .count();
+        new_device->registration_time = now_seconds();
         new_device->last_seen = new_device->registration_time;
         new_device->status = DeviceStatus::ONLINE;
         new_device->cardano_address = pimpl_->generate_device_address(device.public_key);
 
-        // Store device
-        pimpl_->devices_[device.device_id] = new_device;
+        // Store device; fails if it already exists
+        if (!pimpl_->devices_.insert(new_device))
+        {
+            utils::Logger::instance().log(utils::LogLevel::WARNING, "DeviceManager",
+                                          "Device already registered: " + device.device_id);
+            return false;
+        }
         pimpl_->total_registrations_++;
+        pimpl_->journal_upsert(device.device_id);
 
         utils::Logger::instance().log(utils::LogLevel::INFO, "DeviceManager",
                                       "Device registered successfully: " + device.device_id +
@@ -186,28 +266,24 @@ namespace cardano_iot::core
 
     bool DeviceManager::unregister_device(const std::string &device_id)
     {
-        std::lock_guard<std::mutex> lock(pimpl_->devices_mutex_);
-
-        auto it = pimpl_->devices_.find(device_id);
-        if (it == pimpl_->devices_.end())
+        if (!pimpl_->devices_.erase(device_id))
         {
             utils::Logger::instance().log(utils::LogLevel::WARNING, "DeviceManager",
                                           "Cannot unregister: device not found: " + device_id);
             return false;
         }
+        pimpl_->journal_remove(device_id);
 
         // Remove from authenticated devices
+        std::lock_guard<std::mutex> lock(pimpl_->devices_mutex_);
         pimpl_->authenticated_devices_.erase(device_id);
 
         // Remove active challenges
         {
             std::lock_guard<std::mutex> challenges_lock(pimpl_->challenges_mutex_);
-            pimpl_->active_challenges_.erase(device_id);
+            pimpl_->drop_challenge(device_id);
         }
 
-        // Remove device
-        pimpl_->devices_.erase(it);
-
         utils::Logger::instance().log(utils::LogLevel::INFO, "DeviceManager",
                                       "Device unregistered: " + device_id);
 
@@ -233,7 +309,7 @@ namespace cardano_iot::core
             std::lock_guard<std::mutex> lock(pimpl_->challenges_mutex_);
             auto challenge_it = pimpl_->active_challenges_.find(device_id);
             if (challenge_it == pimpl_->active_challenges_.end() ||
-                challenge_it->second != challenge)
+                challenge_it->second.challenge != challenge)
             {
                 utils::Logger::instance().log(utils::LogLevel::ERROR, "DeviceManager",
                                               "Authentication failed: invalid challenge for device: " + device_id);
@@ -242,7 +318,7 @@ namespace cardano_iot::core
             }
 
             // Remove used challenge
-            pimpl_->active_challenges_.erase(challenge_it);
+            pimpl_->drop_challenge(device_id);
         }
 
         // In a real implementation, we would verify the signature here
@@ -253,13 +329,14 @@ namespace cardano_iot::core
 
         if (signature_valid)
         {
-            pimpl_->authenticated_devices_[device_id] = true;
+            {
+                std::lock_guard<std::mutex> lock(pimpl_->devices_mutex_);
+                pimpl_->authenticated_devices_[device_id] = true;
+            }
             pimpl_->total_authentications_++;
 
             // Update last seen time
-            device->last_seen = std::chrono::duration_cast<std::chrono::seconds>(
-                                    std::chrono::system_clock::now().time_since_epoch())
-                                    .count();
+            pimpl_->devices_.touch(device_id, now_seconds());
 
             utils::Logger::instance().log(utils::LogLevel::INFO, "DeviceManager",
                                           "Device authenticated successfully: " + device_id);
@@ -305,25 +382,25 @@ namespace cardano_iot::core
         // Store challenge
         {
             std::lock_guard<std::mutex> lock(pimpl_->challenges_mutex_);
-            pimpl_->active_challenges_[device_id] = challenge_str;
+            pimpl_->drop_challenge(device_id);
+            auto expiry = pimpl_->timers_.schedule_after(CHALLENGE_TTL, [impl = pimpl_.get(), device_id, challenge_str]
+                                                         { impl->expire_challenge(device_id, challenge_str); });
+            pimpl_->active_challenges_[device_id] = Impl::PendingChallenge{challenge_str, expiry};
         }
 
-        utils::Logger::instance().log(utils::LogLevel::DEBUG, "DeviceManager",
-                                      "Generated challenge for device: " + device_id);
+        CARDANO_IOT_LOG(utils::LogLevel::DEBUG, "DeviceManager", "Generated challenge for device: " << device_id);
 
         return challenge_str;
     }
 
     bool DeviceManager::update_device_status(const std::string &device_id, DeviceStatus status)
     {
-        auto device = get_device(device_id);
-        if (!device)
+        DeviceStatus old_status = status;
+        if (!pimpl_->devices_.set_status(device_id, status, &old_status))
         {
             return false;
         }
-
-        DeviceStatus old_status = device->status;
-        device->status = status;
+        pimpl_->journal_upsert(device_id);
 
         utils::Logger::instance().log(utils::LogLevel::INFO, "DeviceManager",
                                       "Device status updated: " + device_id + " -> " + status_to_string(status));
@@ -351,74 +428,31 @@ namespace cardano_iot::core
         {
             device->metadata[key] = value;
         }
+        pimpl_->journal_upsert(device_id);
 
-        utils::Logger::instance().log(utils::LogLevel::DEBUG, "DeviceManager",
-                                      "Device metadata updated: " + device_id);
+        CARDANO_IOT_LOG(utils::LogLevel::DEBUG, "DeviceManager", "Device metadata updated: " << device_id);
 
         return true;
     }
 
     std::shared_ptr<Device> DeviceManager::get_device(const std::string &device_id) const
     {
-        std::lock_guard<std::mutex> lock(pimpl_->devices_mutex_);
-
-        auto it = pimpl_->devices_.find(device_id);
-        if (it != pimpl_->devices_.end())
-        {
-            return it->second;
-        }
-
-        return nullptr;
+        return pimpl_->devices_.find(device_id);
     }
 
     std::vector<std::string> DeviceManager::get_device_list() const
     {
-        std::lock_guard<std::mutex> lock(pimpl_->devices_mutex_);
-
-        std::vector<std::string> device_ids;
-        device_ids.reserve(pimpl_->devices_.size());
-
-        for (const auto &[device_id, device] : pimpl_->devices_)
-        {
-            device_ids.push_back(device_id);
-        }
-
-        return device_ids;
+        return pimpl_->devices_.ids();
     }
 
     std::vector<std::string> DeviceManager::get_devices_by_status(DeviceStatus status) const
     {
-        std::lock_guard<std::mutex> lock(pimpl_->devices_mutex_);
-
-        std::vector<std::string> matching_devices;
-
-        for (const auto &[device_id, device] : pimpl_->devices_)
-        {
-            if (device->status == status)
-            {
-                matching_devices.push_back(device_id);
-            }
-        }
-
-        return matching_devices;
+        return pimpl_->devices_.by_status(status);
     }
 
     std::vector<std::string> DeviceManager::get_devices_by_capability(DeviceCapability capability) const
     {
-        std::lock_guard<std::mutex> lock(pimpl_->devices_mutex_);
-
-        std::vector<std::string> matching_devices;
-        uint32_t capability_flag = static_cast<uint32_t>(capability);
-
-        for (const auto &[device_id, device] : pimpl_->devices_)
-        {
-            if (device->capabilities & capability_flag)
-            {
-                matching_devices.push_back(device_id);
-            }
-        }
-
-        return matching_devices;
+        return pimpl_->devices_.by_capability(static_cast<uint32_t>(capability));
     }
 
     bool DeviceManager::is_device_registered(const std::string &device_id) const
@@ -428,6 +462,7 @@ namespace cardano_iot::core
 
     bool DeviceManager::is_device_authenticated(const std::string &device_id) const
     {
+        std::lock_guard<std::mutex> lock(pimpl_->devices_mutex_);
         auto it = pimpl_->authenticated_devices_.find(device_id);
         return it != pimpl_->authenticated_devices_.end() && it->second;
     }
@@ -439,33 +474,17 @@ namespace cardano_iot::core
 
     void DeviceManager::update_heartbeat(const std::string &device_id)
     {
-        auto device = get_device(device_id);
-        if (device)
-        {
-            device->last_seen = std::chrono::duration_cast<std::chrono::seconds>(
-                                    std::chrono::system_clock::now().time_since_epoch())
-                                    .count();
-        }
+        pimpl_->devices_.touch(device_id, now_seconds());
     }
 
     std::vector<std::string> DeviceManager::get_stale_devices(uint32_t timeout_seconds) const
     {
-        std::lock_guard<std::mutex> lock(pimpl_->devices_mutex_);
-
-        std::vector<std::string> stale_devices;
-        uint64_t current_time = std::chrono::duration_cast<std::chrono::seconds>(
-                                    std::chrono::system_clock::now().time_since_epoch())
-                                    .count();
-
-        for (const auto &[device_id, device] : pimpl_->devices_)
+        const uint64_t current_time = now_seconds();
+        if (current_time < timeout_seconds)
         {
-            if (current_time - device->last_seen >= timeout_seconds)
-            {
-                stale_devices.push_back(device_id);
-            }
+            return {};
         }
-
-        return stale_devices;
+        return pimpl_->devices_.stale(current_time - timeout_seconds);
     }
 
     bool DeviceManager::set_low_power_mode(const std::string &device_id, bool enable)
@@ -477,6 +496,7 @@ namespace cardano_iot::core
         }
 
         device->low_power_mode = enable;
+        pimpl_->journal_upsert(device_id);
 
         utils::Logger::instance().log(utils::LogLevel::INFO, "DeviceManager",
                                       "Low power mode " + std::string(enable ? "enabled" : "disabled") + " for device: " + device_id);
@@ -493,6 +513,7 @@ namespace cardano_iot::core
         }
 
         device->battery_level = std::clamp(battery_level, 0.0, 1.0);
+        pimpl_->journal_upsert(device_id);
 
         // Check for low battery
         if (battery_level < 0.2)
@@ -504,49 +525,117 @@ namespace cardano_iot::core
         return true;
     }
 
+    size_t DeviceManager::apply_telemetry_batch(const std::vector<DeviceTelemetry> &records)
+    {
+        std::vector<uint8_t> applied;
+        const size_t count = pimpl_->devices_.apply_telemetry(records, now_seconds(), applied);
+
+        // Last report per device wins; events and journal entries go out once the shards are unlocked
+        std::unordered_map<std::string, double> batteries;
+        for (size_t i = 0; i < records.size(); ++i)
+        {
+            if (applied[i] && records[i].has_battery())
+            {
+                batteries[records[i].device_id] = records[i].battery_level;
+            }
+        }
+        for (const auto &[device_id, battery_level] : batteries)
+        {
+            pimpl_->journal_upsert(device_id);
+            if (battery_level < 0.2)
+            {
+                pimpl_->notify_event(device_id, DeviceEvent::BATTERY_LOW,
+                                     "Battery level: " + std::to_string(static_cast<int>(battery_level * 100)) + "%");
+            }
+        }
+
+        CARDANO_IOT_LOG(utils::LogLevel::DEBUG, "DeviceManager",
+                        "Applied " << count << " of " << records.size() << " telemetry records");
+        return count;
+    }
+
     std::map<std::string, uint32_t> DeviceManager::get_statistics() const
     {
         std::lock_guard<std::mutex> lock(pimpl_->devices_mutex_);
 
         std::map<std::string, uint32_t> stats;
-        stats["total_devices"] = pimpl_->devices_.size();
+        stats["total_devices"] = static_cast<uint32_t>(pimpl_->devices_.size());
         stats["total_registrations"] = pimpl_->total_registrations_.load();
         stats["total_authentications"] = pimpl_->total_authentications_.load();
         stats["failed_authentications"] = pimpl_->failed_authentications_.load();
         stats["authenticated_devices"] = pimpl_->authenticated_devices_.size();
-        stats["active_challenges"] = pimpl_->active_challenges_.size();
-
-        // Count devices by status
-        std::map<DeviceStatus, uint32_t> status_counts;
-        for (const auto &[device_id, device] : pimpl_->devices_)
         {
-            status_counts[device->status]++;
+            std::lock_guard<std::mutex> challenges_lock(pimpl_->challenges_mutex_);
+            stats["active_challenges"] = pimpl_->active_challenges_.size();
         }
 
-        stats["online_devices"] = status_counts[DeviceStatus::ONLINE];
-        stats["offline_devices"] = status_counts[DeviceStatus::OFFLINE];
-        stats["maintenance_devices"] = status_counts[DeviceStatus::MAINTENANCE];
-        stats["error_devices"] = status_counts[DeviceStatus::ERROR];
-        stats["low_power_devices"] = status_counts[DeviceStatus::LOW_POWER];
+        // Count devices by status from the index
+        const auto status_counts = pimpl_->devices_.status_counts();
+        auto count = [&status_counts](DeviceStatus status)
+        {
+            return static_cast<uint32_t>(status_counts[static_cast<size_t>(status)]);
+        };
+
+        stats["online_devices"] = count(DeviceStatus::ONLINE);
+        stats["offline_devices"] = count(DeviceStatus::OFFLINE);
+        stats["maintenance_devices"] = count(DeviceStatus::MAINTENANCE);
+        stats["error_devices"] = count(DeviceStatus::ERROR);
+        stats["low_power_devices"] = count(DeviceStatus::LOW_POWER);
 
         return stats;
     }
 
     bool DeviceManager::export_device_registry(const std::string &file_path) const
     {
-        // Implementation would serialize device registry to file
-        // This is a simplified stub
+        std::lock_guard<std::mutex> lock(pimpl_->journal_mutex_);
+
+        // A fresh generation orphans whatever journal the previous snapshot had
+        std::random_device rd;
+        const uint64_t generation = (uint64_t(rd()) << 32) | rd();
+        if (!DeviceSnapshot::write(file_path, pimpl_->devices_, generation))
+        {
+            return false;
+        }
+        if (!pimpl_->journal_.open(file_path + ".wal", generation, true))
+        {
+            utils::Logger::instance().log(utils::LogLevel::WARNING, "DeviceManager",
+                                          "Device registry exported without a change journal: " + file_path);
+        }
+
         utils::Logger::instance().log(utils::LogLevel::INFO, "DeviceManager",
-                                      "Exporting device registry to: " + file_path);
+                                      "Exported " + std::to_string(pimpl_->devices_.size()) +
+                                          " devices to: " + file_path);
         return true;
     }
 
     bool DeviceManager::import_device_registry(const std::string &file_path)
     {
-        // Implementation would load device registry from file
-        // This is a simplified stub
+        std::lock_guard<std::mutex> lock(pimpl_->journal_mutex_);
+        pimpl_->journal_.close();
+        pimpl_->devices_.clear();
+
+        uint64_t generation = 0;
+        size_t loaded = 0;
+        if (!DeviceSnapshot::load(file_path, pimpl_->devices_, generation, {}, &loaded))
+        {
+            pimpl_->devices_.clear();
+            utils::Logger::instance().log(utils::LogLevel::ERROR, "DeviceManager",
+                                          "Failed to import device registry from: " + file_path);
+            return false;
+        }
+
+        const std::string journal_path = file_path + ".wal";
+        size_t replayed = 0;
+        if (!DeviceJournal::replay(journal_path, generation, pimpl_->devices_, &replayed) ||
+            !pimpl_->journal_.open(journal_path, generation, false))
+        {
+            utils::Logger::instance().log(utils::LogLevel::WARNING, "DeviceManager",
+                                          "Change journal unavailable: " + journal_path);
+        }
+
         utils::Logger::instance().log(utils::LogLevel::INFO, "DeviceManager",
-                                      "Importing device registry from: " + file_path);
+                                      "Imported " + std::to_string(loaded) + " devices and " +
+                                          std::to_string(replayed) + " journaled changes from: " + file_path);
         return true;
     }
 
@@ -0,0 +1,356 @@
+#include "cardano_iot/core/device_registry.h"
+
+#include <algorithm>
+#include <functional>
+#include <mutex>
+
+namespace cardano_iot
+{
+    namespace core
+    {
+        namespace
+        {
+            size_t status_index(DeviceStatus status)
+            {
+                const size_t index = static_cast<size_t>(status);
+                return index < DeviceRegistry::STATUS_COUNT ? index : static_cast<size_t>(DeviceStatus::ERROR);
+            }
+        } // namespace
+
+        DeviceRegistry::DeviceRegistry(size_t shard_count) : shards_(shard_count == 0 ? 1 : shard_count)
+        {
+        }
+
+        size_t DeviceRegistry::shard_index(const std::string &device_id) const
+        {
+            return std::hash<std::string>{}(device_id) % shards_.size();
+        }
+
+        DeviceRegistry::Shard &DeviceRegistry::shard_for(const std::string &device_id)
+        {
+            return shards_[shard_index(device_id)];
+        }
+
+        const DeviceRegistry::Shard &DeviceRegistry::shard_for(const std::string &device_id) const
+        {
+            return shards_[shard_index(device_id)];
+        }
+
+        bool DeviceRegistry::insert(std::shared_ptr<Device> device)
+        {
+            Shard &shard = shard_for(device->device_id);
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            auto [it, inserted] = shard.devices.try_emplace(device->device_id);
+            if (!inserted)
+            {
+                return false;
+            }
+
+            const Device *raw = device.get();
+            shard.by_status[status_index(raw->status)].insert(raw);
+            for (size_t bit = 0; bit < CAPABILITY_BITS; ++bit)
+            {
+                if (raw->capabilities & (uint32_t(1) << bit))
+                {
+                    shard.by_capability[bit].insert(raw);
+                }
+            }
+            it->second.heartbeat = shard.by_heartbeat.emplace(raw->last_seen, raw);
+            it->second.device = std::move(device);
+            return true;
+        }
+
+        std::shared_ptr<Device> DeviceRegistry::erase(const std::string &device_id)
+        {
+            Shard &shard = shard_for(device_id);
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            auto it = shard.devices.find(device_id);
+            if (it == shard.devices.end())
+            {
+                return nullptr;
+            }
+
+            std::shared_ptr<Device> device = std::move(it->second.device);
+            const Device *raw = device.get();
+            shard.by_status[status_index(raw->status)].erase(raw);
+            for (size_t bit = 0; bit < CAPABILITY_BITS; ++bit)
+            {
+                if (raw->capabilities & (uint32_t(1) << bit))
+                {
+                    shard.by_capability[bit].erase(raw);
+                }
+            }
+            shard.by_heartbeat.erase(it->second.heartbeat);
+            shard.devices.erase(it);
+            return device;
+        }
+
+        std::shared_ptr<Device> DeviceRegistry::find(const std::string &device_id) const
+        {
+            const Shard &shard = shard_for(device_id);
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            auto it = shard.devices.find(device_id);
+            return it != shard.devices.end() ? it->second.device : nullptr;
+        }
+
+        bool DeviceRegistry::set_status(const std::string &device_id, DeviceStatus status, DeviceStatus *old_status)
+        {
+            Shard &shard = shard_for(device_id);
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            auto it = shard.devices.find(device_id);
+            if (it == shard.devices.end())
+            {
+                return false;
+            }
+
+            Device &device = *it->second.device;
+            if (old_status)
+            {
+                *old_status = device.status;
+            }
+            if (device.status != status)
+            {
+                shard.by_status[status_index(device.status)].erase(&device);
+                shard.by_status[status_index(status)].insert(&device);
+                device.status = status;
+            }
+            return true;
+        }
+
+        bool DeviceRegistry::touch(const std::string &device_id, uint64_t now)
+        {
+            Shard &shard = shard_for(device_id);
+            {
+                // Several heartbeats a second are common; only the first one moves the device
+                std::shared_lock<std::shared_mutex> lock(shard.mutex);
+                auto it = shard.devices.find(device_id);
+                if (it == shard.devices.end())
+                {
+                    return false;
+                }
+                if (it->second.device->last_seen == now)
+                {
+                    return true;
+                }
+            }
+
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            auto it = shard.devices.find(device_id);
+            if (it == shard.devices.end())
+            {
+                return false;
+            }
+            Entry &entry = it->second;
+            entry.device->last_seen = now;
+            auto node = shard.by_heartbeat.extract(entry.heartbeat);
+            node.key() = now;
+            entry.heartbeat = shard.by_heartbeat.insert(std::move(node));
+            return true;
+        }
+
+        size_t DeviceRegistry::apply_telemetry(const std::vector<DeviceTelemetry> &records, uint64_t now,
+                                               std::vector<uint8_t> &applied)
+        {
+            applied.assign(records.size(), 0);
+
+            // Counting sort of record indexes by shard
+            std::vector<uint32_t> shard_of(records.size());
+            std::vector<size_t> starts(shards_.size() + 1, 0);
+            for (size_t i = 0; i < records.size(); ++i)
+            {
+                shard_of[i] = static_cast<uint32_t>(shard_index(records[i].device_id));
+                ++starts[shard_of[i] + 1];
+            }
+            for (size_t s = 0; s < shards_.size(); ++s)
+            {
+                starts[s + 1] += starts[s];
+            }
+            std::vector<size_t> order(records.size());
+            std::vector<size_t> next(starts.begin(), starts.end() - 1);
+            for (size_t i = 0; i < records.size(); ++i)
+            {
+                order[next[shard_of[i]]++] = i;
+            }
+
+            size_t count = 0;
+            for (size_t s = 0; s < shards_.size(); ++s)
+            {
+                if (starts[s] == starts[s + 1])
+                {
+                    continue;
+                }
+                Shard &shard = shards_[s];
+                std::unique_lock<std::shared_mutex> lock(shard.mutex);
+                for (size_t k = starts[s]; k < starts[s + 1]; ++k)
+                {
+                    const DeviceTelemetry &record = records[order[k]];
+                    auto it = shard.devices.find(record.device_id);
+                    if (it == shard.devices.end())
+                    {
+                        continue;
+                    }
+                    Entry &entry = it->second;
+                    if (record.heartbeat && entry.device->last_seen != now)
+                    {
+                        entry.device->last_seen = now;
+                        auto node = shard.by_heartbeat.extract(entry.heartbeat);
+                        node.key() = now;
+                        entry.heartbeat = shard.by_heartbeat.insert(std::move(node));
+                    }
+                    if (record.has_battery())
+                    {
+                        entry.device->battery_level = std::min(record.battery_level, 1.0);
+                    }
+                    applied[order[k]] = 1;
+                    ++count;
+                }
+            }
+            return count;
+        }
+
+        std::vector<std::string> DeviceRegistry::ids() const
+        {
+            std::vector<std::string> result;
+            for (const Shard &shard : shards_)
+            {
+                std::shared_lock<std::shared_mutex> lock(shard.mutex);
+                result.reserve(result.size() + shard.devices.size());
+                for (const auto &[device_id, entry] : shard.devices)
+                {
+                    result.push_back(device_id);
+                }
+            }
+            return result;
+        }
+
+        std::vector<std::string> DeviceRegistry::by_status(DeviceStatus status) const
+        {
+            const size_t index = static_cast<size_t>(status);
+            std::vector<std::string> result;
+            if (index >= STATUS_COUNT)
+            {
+                return result;
+            }
+            for (const Shard &shard : shards_)
+            {
+                std::shared_lock<std::shared_mutex> lock(shard.mutex);
+                for (const Device *device : shard.by_status[index])
+                {
+                    result.push_back(device->device_id);
+                }
+            }
+            return result;
+        }
+
+        std::vector<std::string> DeviceRegistry::by_capability(uint32_t mask) const
+        {
+            std::vector<std::string> result;
+            const bool single_bit = mask != 0 && (mask & (mask - 1)) == 0;
+            for (const Shard &shard : shards_)
+            {
+                std::shared_lock<std::shared_mutex> lock(shard.mutex);
+                if (single_bit)
+                {
+                    size_t bit = 0;
+                    while ((mask >> bit) != 1)
+                    {
+                        ++bit;
+                    }
+                    for (const Device *device : shard.by_capability[bit])
+                    {
+                        result.push_back(device->device_id);
+                    }
+                    continue;
+                }
+
+                // Several bits: walk each bit's set, emitting a device at its lowest matching bit only
+                for (size_t bit = 0; bit < CAPABILITY_BITS; ++bit)
+                {
+                    if ((mask & (uint32_t(1) << bit)) == 0)
+                    {
+                        continue;
+                    }
+                    const uint32_t lower = mask & ((uint32_t(1) << bit) - 1);
+                    for (const Device *device : shard.by_capability[bit])
+                    {
+                        if ((device->capabilities & lower) == 0)
+                        {
+                            result.push_back(device->device_id);
+                        }
+                    }
+                }
+            }
+            return result;
+        }
+
+        std::vector<std::string> DeviceRegistry::stale(uint64_t cutoff) const
+        {
+            std::vector<std::string> result;
+            for (const Shard &shard : shards_)
+            {
+                std::shared_lock<std::shared_mutex> lock(shard.mutex);
+                for (auto it = shard.by_heartbeat.begin(); it != shard.by_heartbeat.end() && it->first <= cutoff; ++it)
+                {
+                    result.push_back(it->second->device_id);
+                }
+            }
+            return result;
+        }
+
+        size_t DeviceRegistry::size() const
+        {
+            size_t total = 0;
+            for (const Shard &shard : shards_)
+            {
+                std::shared_lock<std::shared_mutex> lock(shard.mutex);
+                total += shard.devices.size();
+            }
+            return total;
+        }
+
+        std::array<size_t, DeviceRegistry::STATUS_COUNT> DeviceRegistry::status_counts() const
+        {
+            std::array<size_t, STATUS_COUNT> counts{};
+            for (const Shard &shard : shards_)
+            {
+                std::shared_lock<std::shared_mutex> lock(shard.mutex);
+                for (size_t i = 0; i < STATUS_COUNT; ++i)
+                {
+                    counts[i] += shard.by_status[i].size();
+                }
+            }
+            return counts;
+        }
+
+        void DeviceRegistry::for_each(const std::function<void(const Device &)> &visitor) const
+        {
+            for (const Shard &shard : shards_)
+            {
+                std::shared_lock<std::shared_mutex> lock(shard.mutex);
+                for (const auto &[device_id, entry] : shard.devices)
+                {
+                    visitor(*entry.device);
+                }
+            }
+        }
+
+        void DeviceRegistry::clear()
+        {
+            for (Shard &shard : shards_)
+            {
+                std::unique_lock<std::shared_mutex> lock(shard.mutex);
+                shard.devices.clear();
+                for (auto &index : shard.by_status)
+                {
+                    index.clear();
+                }
+                for (auto &index : shard.by_capability)
+                {
+                    index.clear();
+                }
+                shard.by_heartbeat.clear();
+            }
+        }
+
+    } // namespace core
+} // namespace cardano_iot
@@ -0,0 +1,682 @@
+#include "cardano_iot/core/device_snapshot.h"
+#include "cardano_iot/utils/hash.h"
+#include "cardano_iot/utils/logger.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <thread>
+#include <unordered_map>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace cardano_iot
+{
+    namespace core
+    {
+        namespace
+        {
+            constexpr char SNAPSHOT_MAGIC[8] = {'C', 'I', 'O', 'T', 'D', 'R', 'E', 'G'};
+            constexpr char JOURNAL_MAGIC[8] = {'C', 'I', 'O', 'T', 'D', 'W', 'A', 'L'};
+            constexpr uint32_t JOURNAL_VERSION = 1;
+            constexpr size_t HEADER_BYTES = 96;
+            constexpr size_t JOURNAL_HEADER_BYTES = 24;
+            constexpr size_t RECORD_BYTES = 72;
+            constexpr size_t FRAME_BYTES = 8;
+            constexpr uint32_t MAX_FRAME_BYTES = 16 * 1024 * 1024;
+            constexpr size_t TABLE_FIELDS = 6;
+
+            constexpr uint8_t KIND_UPSERT = 1;
+            constexpr uint8_t KIND_REMOVE = 2;
+
+            // The fields that repeat across a fleet, in record order
+            std::string Device::*const TABLE_MEMBERS[TABLE_FIELDS] = {
+                &Device::device_type, &Device::manufacturer, &Device::model,
+                &Device::firmware_version, &Device::hardware_revision, &Device::location};
+
+            // The fields unique to each device, in blob order
+            std::string Device::*const BLOB_MEMBERS[4] = {
+                &Device::device_id, &Device::public_key, &Device::private_key_hash, &Device::cardano_address};
+
+            void put_u32(char *out, uint32_t value)
+            {
+                for (int i = 0; i < 4; ++i)
+                {
+                    out[i] = static_cast<char>(value >> (8 * i));
+                }
+            }
+
+            void put_u64(char *out, uint64_t value)
+            {
+                for (int i = 0; i < 8; ++i)
+                {
+                    out[i] = static_cast<char>(value >> (8 * i));
+                }
+            }
+
+            uint32_t get_u32(const uint8_t *in)
+            {
+                return uint32_t(in[0]) | uint32_t(in[1]) << 8 | uint32_t(in[2]) << 16 | uint32_t(in[3]) << 24;
+            }
+
+            uint64_t get_u64(const uint8_t *in)
+            {
+                return uint64_t(get_u32(in)) | uint64_t(get_u32(in + 4)) << 32;
+            }
+
+            void append_u32(std::string &out, uint32_t value)
+            {
+                char bytes[4];
+                put_u32(bytes, value);
+                out.append(bytes, sizeof(bytes));
+            }
+
+            void append_u64(std::string &out, uint64_t value)
+            {
+                char bytes[8];
+                put_u64(bytes, value);
+                out.append(bytes, sizeof(bytes));
+            }
+
+            void put_varint(std::string &out, uint64_t value)
+            {
+                while (value >= 0x80)
+                {
+                    out.push_back(static_cast<char>(value | 0x80));
+                    value >>= 7;
+                }
+                out.push_back(static_cast<char>(value));
+            }
+
+            void put_string(std::string &out, const std::string &value)
+            {
+                put_varint(out, value.size());
+                out.append(value);
+            }
+
+            uint64_t double_bits(double value)
+            {
+                uint64_t bits;
+                std::memcpy(&bits, &value, sizeof(bits));
+                return bits;
+            }
+
+            double bits_double(uint64_t bits)
+            {
+                double value;
+                std::memcpy(&value, &bits, sizeof(value));
+                return value;
+            }
+
+            struct Reader
+            {
+                const uint8_t *data;
+                size_t size;
+                size_t offset = 0;
+
+                bool varint(uint64_t &value)
+                {
+                    value = 0;
+                    for (unsigned shift = 0; shift < 64 && offset < size; shift += 7)
+                    {
+                        const uint8_t byte = data[offset++];
+                        value |= uint64_t(byte & 0x7F) << shift;
+                        if ((byte & 0x80) == 0)
+                        {
+                            return true;
+                        }
+                    }
+                    return false;
+                }
+
+                bool string(std::string &value)
+                {
+                    uint64_t length = 0;
+                    if (!varint(length) || length > size - offset)
+                    {
+                        return false;
+                    }
+                    value.assign(reinterpret_cast<const char *>(data + offset), static_cast<size_t>(length));
+                    offset += static_cast<size_t>(length);
+                    return true;
+                }
+
+                bool fixed(uint64_t &value, size_t bytes)
+                {
+                    if (size - offset < bytes)
+                    {
+                        return false;
+                    }
+                    value = bytes == 8 ? get_u64(data + offset) : get_u32(data + offset);
+                    offset += bytes;
+                    return true;
+                }
+            };
+
+            bool write_all(int fd, const char *data, size_t size)
+            {
+                while (size > 0)
+                {
+                    const ssize_t n = ::write(fd, data, size);
+                    if (n < 0 && errno == EINTR)
+                    {
+                        continue;
+                    }
+                    if (n <= 0)
+                    {
+                        return false;
+                    }
+                    data += n;
+                    size -= static_cast<size_t>(n);
+                }
+                return true;
+            }
+
+            void sync_parent_directory(const std::string &path)
+            {
+                const size_t slash = path.find_last_of('/');
+                const std::string directory = slash == std::string::npos ? "." : slash == 0 ? "/" : path.substr(0, slash);
+                const int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+                if (fd >= 0)
+                {
+                    ::fsync(fd);
+                    ::close(fd);
+                }
+            }
+
+            // Journal form: every field inline, so an entry stands on its own
+            void encode_device(const Device &device, std::string &out)
+            {
+                for (auto member : BLOB_MEMBERS)
+                {
+                    put_string(out, device.*member);
+                }
+                for (auto member : TABLE_MEMBERS)
+                {
+                    put_string(out, device.*member);
+                }
+                put_varint(out, device.capabilities);
+                put_varint(out, static_cast<uint64_t>(device.status));
+                put_varint(out, device.low_power_mode ? 1 : 0);
+                append_u64(out, device.registration_time);
+                append_u64(out, device.last_seen);
+                append_u64(out, double_bits(device.battery_level));
+                put_varint(out, device.metadata.size());
+                for (const auto &[key, value] : device.metadata)
+                {
+                    put_string(out, key);
+                    put_string(out, value);
+                }
+            }
+
+            bool decode_device(const uint8_t *data, size_t size, Device &device)
+            {
+                Reader reader{data, size};
+                for (auto member : BLOB_MEMBERS)
+                {
+                    if (!reader.string(device.*member))
+                    {
+                        return false;
+                    }
+                }
+                for (auto member : TABLE_MEMBERS)
+                {
+                    if (!reader.string(device.*member))
+                    {
+                        return false;
+                    }
+                }
+                uint64_t capabilities = 0, status = 0, low_power = 0, battery = 0, count = 0;
+                if (!reader.varint(capabilities) || !reader.varint(status) || !reader.varint(low_power) ||
+                    !reader.fixed(device.registration_time, 8) || !reader.fixed(device.last_seen, 8) ||
+                    !reader.fixed(battery, 8) || !reader.varint(count) || count > size ||
+                    status >= DeviceRegistry::STATUS_COUNT)
+                {
+                    return false;
+                }
+                device.capabilities = static_cast<uint32_t>(capabilities);
+                device.status = static_cast<DeviceStatus>(status);
+                device.low_power_mode = low_power != 0;
+                device.battery_level = bits_double(battery);
+                device.metadata.clear();
+                for (uint64_t i = 0; i < count; ++i)
+                {
+                    std::string key, value;
+                    if (!reader.string(key) || !reader.string(value))
+                    {
+                        return false;
+                    }
+                    device.metadata.emplace(std::move(key), std::move(value));
+                }
+                return reader.offset == size;
+            }
+
+            void upsert(DeviceRegistry &registry, std::shared_ptr<Device> device)
+            {
+                registry.erase(device->device_id);
+                registry.insert(std::move(device));
+            }
+        } // namespace
+
+        bool DeviceSnapshot::write(const std::string &path, const DeviceRegistry &registry, uint64_t generation)
+        {
+            // Body = string table | padding | records | blob
+            std::unordered_map<std::string, uint32_t> table;
+            std::string strings;
+            std::string records;
+            std::string blob;
+            uint64_t device_count = 0;
+            auto intern = [&](const std::string &value)
+            {
+                auto [it, inserted] = table.try_emplace(value, static_cast<uint32_t>(table.size()));
+                if (inserted)
+                {
+                    put_string(strings, value);
+                }
+                return it->second;
+            };
+
+            registry.for_each([&](const Device &device)
+                              {
+                char record[RECORD_BYTES] = {};
+                for (size_t i = 0; i < TABLE_FIELDS; ++i)
+                {
+                    put_u32(record + 4 * i, intern(device.*TABLE_MEMBERS[i]));
+                }
+                put_u32(record + 24, device.capabilities);
+                record[28] = static_cast<char>(device.status);
+                record[29] = device.low_power_mode ? 1 : 0;
+                put_u64(record + 32, device.registration_time);
+                put_u64(record + 40, device.last_seen);
+                put_u64(record + 48, double_bits(device.battery_level));
+
+                const size_t start = blob.size();
+                for (auto member : BLOB_MEMBERS)
+                {
+                    put_string(blob, device.*member);
+                }
+                for (const auto &[key, value] : device.metadata)
+                {
+                    put_varint(blob, intern(key));
+                    put_string(blob, value);
+                }
+                put_u64(record + 56, start);
+                put_u32(record + 64, static_cast<uint32_t>(blob.size() - start));
+                put_u32(record + 68, static_cast<uint32_t>(device.metadata.size()));
+                records.append(record, sizeof(record));
+                ++device_count; });
+
+            std::string body;
+            body.reserve(strings.size() + 8 + records.size() + blob.size());
+            body.append(strings);
+            body.resize((HEADER_BYTES + body.size() + 7) / 8 * 8 - HEADER_BYTES, '\0');
+            const uint64_t records_offset = HEADER_BYTES + body.size();
+            body.append(records);
+            const uint64_t blob_offset = HEADER_BYTES + body.size();
+            body.append(blob);
+            records.clear();
+            blob.clear();
+
+            std::string header;
+            header.append(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+            append_u32(header, FORMAT_VERSION);
+            append_u32(header, 0);
+            append_u64(header, generation);
+            append_u64(header, device_count);
+            append_u32(header, static_cast<uint32_t>(table.size()));
+            append_u32(header, static_cast<uint32_t>(RECORD_BYTES));
+            append_u64(header, records_offset);
+            append_u64(header, blob_offset);
+            append_u64(header, HEADER_BYTES + body.size());
+            const std::vector<uint8_t> digest = utils::tree_hash(body.data(), body.size());
+            header.append(reinterpret_cast<const char *>(digest.data()), digest.size());
+
+            const std::string temporary = path + ".tmp";
+            const int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+            if (fd < 0)
+            {
+                utils::Logger::instance().log(utils::LogLevel::ERROR, "DeviceSnapshot", "Cannot create " + temporary);
+                return false;
+            }
+            const bool written = write_all(fd, header.data(), header.size()) && write_all(fd, body.data(), body.size()) &&
+                                 ::fsync(fd) == 0;
+            ::close(fd);
+            if (!written || ::rename(temporary.c_str(), path.c_str()) != 0)
+            {
+                ::unlink(temporary.c_str());
+                utils::Logger::instance().log(utils::LogLevel::ERROR, "DeviceSnapshot", "Failed to write " + path);
+                return false;
+            }
+            sync_parent_directory(path);
+            return true;
+        }
+
+        bool DeviceSnapshot::load(const std::string &path, DeviceRegistry &registry, uint64_t &generation,
+                                  const Options &options, size_t *loaded)
+        {
+            const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0)
+            {
+                return false;
+            }
+            struct stat info;
+            if (::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < HEADER_BYTES)
+            {
+                ::close(fd);
+                return false;
+            }
+            const size_t file_bytes = static_cast<size_t>(info.st_size);
+            void *map = ::mmap(nullptr, file_bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd);
+            if (map == MAP_FAILED)
+            {
+                return false;
+            }
+            const uint8_t *data = static_cast<const uint8_t *>(map);
+            auto fail = [&](const std::string &reason)
+            {
+                ::munmap(map, file_bytes);
+                utils::Logger::instance().log(utils::LogLevel::ERROR, "DeviceSnapshot", reason + ": " + path);
+                return false;
+            };
+
+            const uint64_t device_count = get_u64(data + 24);
+            const uint32_t string_count = get_u32(data + 32);
+            const uint32_t record_bytes = get_u32(data + 36);
+            const uint64_t records_offset = get_u64(data + 40);
+            const uint64_t blob_offset = get_u64(data + 48);
+            if (std::memcmp(data, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0 || get_u32(data + 8) != FORMAT_VERSION ||
+                record_bytes != RECORD_BYTES)
+            {
+                return fail("Not a version " + std::to_string(FORMAT_VERSION) + " device snapshot");
+            }
+            if (get_u64(data + 56) != file_bytes || records_offset < HEADER_BYTES || blob_offset > file_bytes ||
+                device_count > (file_bytes - records_offset) / RECORD_BYTES ||
+                records_offset + device_count * RECORD_BYTES != blob_offset)
+            {
+                return fail("Truncated device snapshot");
+            }
+
+            utils::TreeHashOptions hash_options;
+            hash_options.threads = options.threads;
+            const std::vector<uint8_t> digest = utils::tree_hash(data + HEADER_BYTES, file_bytes - HEADER_BYTES, hash_options);
+            if (!std::equal(digest.begin(), digest.end(), data + 64))
+            {
+                return fail("Checksum mismatch in device snapshot");
+            }
+
+            std::vector<std::string> strings(string_count);
+            Reader table{data + HEADER_BYTES, static_cast<size_t>(records_offset - HEADER_BYTES)};
+            for (auto &value : strings)
+            {
+                if (!table.string(value))
+                {
+                    return fail("Corrupt string table in device snapshot");
+                }
+            }
+
+            const uint8_t *blob = data + blob_offset;
+            const size_t blob_bytes = file_bytes - blob_offset;
+            std::atomic<bool> ok{true};
+            std::atomic<size_t> inserted{0};
+            auto decode_range = [&](size_t begin, size_t end)
+            {
+                for (size_t i = begin; i < end && ok.load(std::memory_order_relaxed); ++i)
+                {
+                    const uint8_t *record = data + records_offset + i * RECORD_BYTES;
+                    auto device = std::make_shared<Device>();
+                    bool valid = record[28] < DeviceRegistry::STATUS_COUNT;
+                    for (size_t f = 0; valid && f < TABLE_FIELDS; ++f)
+                    {
+                        const uint32_t index = get_u32(record + 4 * f);
+                        valid = index < strings.size();
+                        if (valid)
+                        {
+                            (*device).*TABLE_MEMBERS[f] = strings[index];
+                        }
+                    }
+                    device->capabilities = get_u32(record + 24);
+                    device->status = static_cast<DeviceStatus>(record[28]);
+                    device->low_power_mode = record[29] != 0;
+                    device->registration_time = get_u64(record + 32);
+                    device->last_seen = get_u64(record + 40);
+                    device->battery_level = bits_double(get_u64(record + 48));
+
+                    const uint64_t start = get_u64(record + 56);
+                    const uint32_t size = get_u32(record + 64);
+                    const uint32_t metadata_count = get_u32(record + 68);
+                    valid = valid && start <= blob_bytes && size <= blob_bytes - start;
+                    Reader reader{blob + (valid ? start : 0), valid ? size : 0};
+                    for (size_t f = 0; valid && f < 4; ++f)
+                    {
+                        valid = reader.string((*device).*BLOB_MEMBERS[f]);
+                    }
+                    for (uint32_t m = 0; valid && m < metadata_count; ++m)
+                    {
+                        uint64_t key = 0;
+                        std::string value;
+                        valid = reader.varint(key) && key < strings.size() && reader.string(value);
+                        if (valid)
+                        {
+                            device->metadata.emplace(strings[static_cast<size_t>(key)], std::move(value));
+                        }
+                    }
+
+                    if (!valid || device->device_id.empty())
+                    {
+                        ok.store(false, std::memory_order_relaxed);
+                        return;
+                    }
+                    if (registry.insert(std::move(device)))
+                    {
+                        inserted.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+            };
+
+            // Records are independent; split them into contiguous ranges, one per thread
+            const size_t count = static_cast<size_t>(device_count);
+            const unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+            const size_t workers = std::max<size_t>(1, std::min<size_t>(options.threads ? options.threads : hardware,
+                                                                        count / 1024));
+            const size_t per_worker = (count + workers - 1) / workers;
+            std::vector<std::thread> pool;
+            for (size_t w = 1; w < workers; ++w)
+            {
+                const size_t begin = std::min(count, w * per_worker);
+                pool.emplace_back(decode_range, begin, std::min(count, begin + per_worker));
+            }
+            decode_range(0, std::min(count, per_worker));
+            for (auto &worker : pool)
+            {
+                worker.join();
+            }
+
+            generation = get_u64(data + 16);
+            ::munmap(map, file_bytes);
+            if (!ok.load())
+            {
+                utils::Logger::instance().log(utils::LogLevel::ERROR, "DeviceSnapshot", "Corrupt device record in " + path);
+                return false;
+            }
+            if (loaded)
+            {
+                *loaded = inserted.load();
+            }
+            return true;
+        }
+
+        DeviceJournal::~DeviceJournal()
+        {
+            close();
+        }
+
+        bool DeviceJournal::open(const std::string &path, uint64_t generation, bool truncate)
+        {
+            close();
+            fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+            if (fd_ < 0)
+            {
+                return false;
+            }
+
+            uint8_t header[JOURNAL_HEADER_BYTES];
+            struct stat info;
+            const bool current = !truncate && ::fstat(fd_, &info) == 0 &&
+                                 static_cast<size_t>(info.st_size) >= JOURNAL_HEADER_BYTES &&
+                                 ::pread(fd_, header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header)) &&
+                                 std::memcmp(header, JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC)) == 0 &&
+                                 get_u32(header + 8) == JOURNAL_VERSION && get_u64(header + 16) == generation;
+            if (current)
+            {
+                size_ = static_cast<uint64_t>(info.st_size);
+                return ::lseek(fd_, 0, SEEK_END) >= 0;
+            }
+
+            std::string fresh(JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC));
+            append_u32(fresh, JOURNAL_VERSION);
+            append_u32(fresh, 0);
+            append_u64(fresh, generation);
+            if (::ftruncate(fd_, 0) != 0 || ::lseek(fd_, 0, SEEK_SET) != 0 || !write_all(fd_, fresh.data(), fresh.size()) ||
+                ::fsync(fd_) != 0)
+            {
+                close();
+                return false;
+            }
+            size_ = fresh.size();
+            return true;
+        }
+
+        void DeviceJournal::close()
+        {
+            if (fd_ >= 0)
+            {
+                ::fsync(fd_);
+                ::close(fd_);
+                fd_ = -1;
+            }
+            size_ = 0;
+        }
+
+        bool DeviceJournal::append(uint8_t kind, const std::string &body)
+        {
+            if (fd_ < 0 || 1 + body.size() > MAX_FRAME_BYTES)
+            {
+                return false;
+            }
+            scratch_.clear();
+            append_u32(scratch_, static_cast<uint32_t>(1 + body.size()));
+            append_u32(scratch_, 0);
+            scratch_.push_back(static_cast<char>(kind));
+            scratch_.append(body);
+            put_u32(&scratch_[4], utils::crc32(scratch_.data() + FRAME_BYTES, 1 + body.size()));
+            if (!write_all(fd_, scratch_.data(), scratch_.size()))
+            {
+                return false;
+            }
+            size_ += scratch_.size();
+            return true;
+        }
+
+        bool DeviceJournal::record_upsert(const Device &device)
+        {
+            std::string body;
+            encode_device(device, body);
+            return append(KIND_UPSERT, body);
+        }
+
+        bool DeviceJournal::record_remove(const std::string &device_id)
+        {
+            std::string body;
+            put_string(body, device_id);
+            return append(KIND_REMOVE, body);
+        }
+
+        bool DeviceJournal::replay(const std::string &path, uint64_t generation, DeviceRegistry &registry, size_t *applied)
+        {
+            size_t count = 0;
+            if (applied)
+            {
+                *applied = 0;
+            }
+            const int fd = ::open(path.c_str(), O_RDWR | O_CLOEXEC);
+            if (fd < 0)
+            {
+                return errno == ENOENT;
+            }
+            struct stat info;
+            if (::fstat(fd, &info) != 0)
+            {
+                ::close(fd);
+                return false;
+            }
+            const size_t file_bytes = static_cast<size_t>(info.st_size);
+            std::string contents(file_bytes, '\0');
+            if (file_bytes > 0 && ::pread(fd, &contents[0], file_bytes, 0) != static_cast<ssize_t>(file_bytes))
+            {
+                ::close(fd);
+                return false;
+            }
+            const uint8_t *data = reinterpret_cast<const uint8_t *>(contents.data());
+            if (file_bytes < JOURNAL_HEADER_BYTES || std::memcmp(data, JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC)) != 0 ||
+                get_u32(data + 8) != JOURNAL_VERSION || get_u64(data + 16) != generation)
+            {
+                // Belongs to another snapshot (or never got its header); nothing to apply
+                ::close(fd);
+                return true;
+            }
+
+            size_t offset = JOURNAL_HEADER_BYTES;
+            while (offset + FRAME_BYTES <= file_bytes)
+            {
+                const uint32_t length = get_u32(data + offset);
+                if (length == 0 || length > MAX_FRAME_BYTES || length > file_bytes - offset - FRAME_BYTES ||
+                    utils::crc32(data + offset + FRAME_BYTES, length) != get_u32(data + offset + 4))
+                {
+                    break;
+                }
+                const uint8_t *body = data + offset + FRAME_BYTES;
+                if (body[0] == KIND_UPSERT)
+                {
+                    auto device = std::make_shared<Device>();
+                    if (decode_device(body + 1, length - 1, *device))
+                    {
+                        upsert(registry, std::move(device));
+                        ++count;
+                    }
+                }
+                else if (body[0] == KIND_REMOVE)
+                {
+                    Reader reader{body + 1, length - 1};
+                    std::string device_id;
+                    if (reader.string(device_id))
+                    {
+                        registry.erase(device_id);
+                        ++count;
+                    }
+                }
+                offset += FRAME_BYTES + length;
+            }
+
+            bool ok = true;
+            if (offset != file_bytes)
+            {
+                utils::Logger::instance().log(utils::LogLevel::WARNING, "DeviceJournal",
+                                              "Discarding " + std::to_string(file_bytes - offset) +
+                                                  " unreadable bytes at the end of " + path);
+                ok = ::ftruncate(fd, static_cast<off_t>(offset)) == 0;
+            }
+            ::close(fd);
+            if (applied)
+            {
+                *applied = count;
+            }
+            return ok;
+        }
+
+    } // namespace core
+} // namespace cardano_iot
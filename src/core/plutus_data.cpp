@@ -0,0 +1,573 @@
+#include "cardano_iot/core/plutus_data.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace cardano_iot
+{
+    namespace core
+    {
+        namespace
+        {
+            constexpr unsigned kMaxDepth = 4096;
+            constexpr size_t kBytesChunk = 64;
+
+            void write_head(std::vector<uint8_t> &out, uint8_t major, uint64_t value)
+            {
+                const uint8_t type = static_cast<uint8_t>(major << 5);
+                if (value < 24)
+                {
+                    out.push_back(type | static_cast<uint8_t>(value));
+                    return;
+                }
+                int bytes = value <= 0xff ? 1 : value <= 0xffff ? 2 : value <= 0xffffffffULL ? 4 : 8;
+                out.push_back(type | static_cast<uint8_t>(bytes == 1 ? 24 : bytes == 2 ? 25 : bytes == 4 ? 26 : 27));
+                for (int i = bytes - 1; i >= 0; --i)
+                {
+                    out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+                }
+            }
+
+            void write_constructor_tag(std::vector<uint8_t> &out, uint64_t tag)
+            {
+                if (tag < 7)
+                {
+                    write_head(out, 6, 121 + tag);
+                }
+                else if (tag < 128)
+                {
+                    write_head(out, 6, 1280 + tag - 7);
+                }
+                else
+                {
+                    write_head(out, 6, 102);
+                    write_head(out, 4, 2);
+                    write_head(out, 0, tag);
+                }
+            }
+
+            bool read_head(const uint8_t *&pos, const uint8_t *end, uint8_t &major, uint64_t &value, bool &indefinite)
+            {
+                if (pos >= end)
+                {
+                    return false;
+                }
+                const uint8_t initial = *pos++;
+                major = initial >> 5;
+                const uint8_t extra = initial & 0x1f;
+                indefinite = false;
+                if (extra < 24)
+                {
+                    value = extra;
+                    return true;
+                }
+                if (extra == 31)
+                {
+                    indefinite = true;
+                    return major == 2 || major == 4 || major == 5;
+                }
+                if (extra > 27)
+                {
+                    return false;
+                }
+                const size_t bytes = size_t(1) << (extra - 24);
+                if (static_cast<size_t>(end - pos) < bytes)
+                {
+                    return false;
+                }
+                value = 0;
+                for (size_t i = 0; i < bytes; ++i)
+                {
+                    value = (value << 8) | *pos++;
+                }
+                return true;
+            }
+
+            bool at_break(const uint8_t *&pos, const uint8_t *end)
+            {
+                if (pos < end && *pos == 0xff)
+                {
+                    ++pos;
+                    return true;
+                }
+                return false;
+            }
+        } // namespace
+
+        void PlutusDataArena::clear()
+        {
+            nodes_.clear();
+            children_.clear();
+            bytes_.clear();
+            pending_.clear();
+            open_.clear();
+        }
+
+        void PlutusDataArena::reserve(size_t nodes, size_t bytes)
+        {
+            nodes_.reserve(nodes);
+            children_.reserve(nodes);
+            pending_.reserve(nodes);
+            bytes_.reserve(bytes);
+        }
+
+        PlutusDataArena::NodeId PlutusDataArena::push(const Node &node)
+        {
+            const NodeId id = static_cast<NodeId>(nodes_.size());
+            nodes_.push_back(node);
+            if (!open_.empty())
+            {
+                pending_.push_back(id);
+            }
+            return id;
+        }
+
+        PlutusDataArena::NodeId PlutusDataArena::add_integer(int64_t value)
+        {
+            Node node;
+            node.type = PlutusDataType::INTEGER;
+            node.value = value;
+            return push(node);
+        }
+
+        PlutusDataArena::NodeId PlutusDataArena::add_bytes(const uint8_t *data, size_t length)
+        {
+            Node node;
+            node.type = PlutusDataType::BYTESTRING;
+            node.offset = static_cast<uint32_t>(bytes_.size());
+            node.length = static_cast<uint32_t>(length);
+            bytes_.insert(bytes_.end(), data, data + length);
+            return push(node);
+        }
+
+        PlutusDataArena::NodeId PlutusDataArena::add_bool(bool value)
+        {
+            Node node;
+            node.type = PlutusDataType::BOOLEAN;
+            node.value = value ? 1 : 0;
+            return push(node);
+        }
+
+        PlutusDataArena::NodeId PlutusDataArena::add_unit()
+        {
+            return push(Node());
+        }
+
+        void PlutusDataArena::begin_list()
+        {
+            open_.push_back(Open{PlutusDataType::LIST, 0, pending_.size()});
+        }
+
+        void PlutusDataArena::begin_map()
+        {
+            open_.push_back(Open{PlutusDataType::MAP, 0, pending_.size()});
+        }
+
+        void PlutusDataArena::begin_constructor(uint64_t tag)
+        {
+            open_.push_back(Open{PlutusDataType::CONSTRUCTOR, static_cast<int64_t>(tag), pending_.size()});
+        }
+
+        PlutusDataArena::NodeId PlutusDataArena::end()
+        {
+            const Open open = open_.back();
+            open_.pop_back();
+
+            Node node;
+            node.type = open.type;
+            node.value = open.tag;
+            node.offset = static_cast<uint32_t>(children_.size());
+            node.length = static_cast<uint32_t>(pending_.size() - open.first_pending);
+            children_.insert(children_.end(), pending_.begin() + open.first_pending, pending_.end());
+            pending_.resize(open.first_pending);
+            return push(node);
+        }
+
+        PlutusDataArena::NodeId PlutusDataArena::import(const PlutusData &data)
+        {
+            switch (data.type)
+            {
+            case PlutusDataType::INTEGER:
+                return add_integer(std::get<int64_t>(data.value));
+            case PlutusDataType::BYTESTRING:
+            {
+                const auto &bytes = std::get<std::vector<uint8_t>>(data.value);
+                return add_bytes(bytes.data(), bytes.size());
+            }
+            case PlutusDataType::BOOLEAN:
+                return add_bool(std::get<bool>(data.value));
+            case PlutusDataType::LIST:
+                begin_list();
+                for (const auto &item : std::get<std::vector<std::shared_ptr<PlutusData>>>(data.value))
+                {
+                    item ? import(*item) : add_unit();
+                }
+                return end();
+            case PlutusDataType::MAP:
+                begin_map();
+                for (const auto &[key, item] : std::get<std::map<std::string, std::shared_ptr<PlutusData>>>(data.value))
+                {
+                    add_text(key);
+                    item ? import(*item) : add_unit();
+                }
+                return end();
+            case PlutusDataType::CONSTRUCTOR:
+            {
+                const auto &constructor = std::get<std::pair<uint64_t, std::vector<std::shared_ptr<PlutusData>>>>(data.value);
+                begin_constructor(constructor.first);
+                for (const auto &field : constructor.second)
+                {
+                    field ? import(*field) : add_unit();
+                }
+                return end();
+            }
+            case PlutusDataType::UNIT:
+            default:
+                return add_unit();
+            }
+        }
+
+        std::string_view PlutusDataArena::bytes(NodeId id) const
+        {
+            const Node &node = nodes_[id];
+            if (node.type != PlutusDataType::BYTESTRING || node.length == 0)
+            {
+                return {};
+            }
+            return std::string_view(reinterpret_cast<const char *>(bytes_.data() + node.offset), node.length);
+        }
+
+        PlutusData PlutusDataArena::to_plutus_data(NodeId id) const
+        {
+            const Node &node = nodes_[id];
+            switch (node.type)
+            {
+            case PlutusDataType::INTEGER:
+                return PlutusData(node.value);
+            case PlutusDataType::BYTESTRING:
+            {
+                const std::string_view view = bytes(id);
+                return PlutusData(std::vector<uint8_t>(view.begin(), view.end()));
+            }
+            case PlutusDataType::BOOLEAN:
+                return PlutusData(node.value != 0);
+            case PlutusDataType::LIST:
+            {
+                PlutusData out;
+                out.type = PlutusDataType::LIST;
+                std::vector<std::shared_ptr<PlutusData>> items;
+                items.reserve(node.length);
+                for (uint32_t i = 0; i < node.length; ++i)
+                {
+                    items.push_back(std::make_shared<PlutusData>(to_plutus_data(children_[node.offset + i])));
+                }
+                out.value = std::move(items);
+                return out;
+            }
+            case PlutusDataType::MAP:
+            {
+                PlutusData out;
+                out.type = PlutusDataType::MAP;
+                std::map<std::string, std::shared_ptr<PlutusData>> items;
+                for (uint32_t i = 0; i + 1 < node.length; i += 2)
+                {
+                    const NodeId key = children_[node.offset + i];
+                    std::string name;
+                    if (nodes_[key].type == PlutusDataType::INTEGER)
+                    {
+                        name = std::to_string(nodes_[key].value);
+                    }
+                    else if (nodes_[key].type == PlutusDataType::BYTESTRING)
+                    {
+                        name = std::string(bytes(key));
+                    }
+                    else
+                    {
+                        std::vector<uint8_t> encoded;
+                        encode(key, encoded);
+                        name.assign(encoded.begin(), encoded.end());
+                    }
+                    items[name] = std::make_shared<PlutusData>(to_plutus_data(children_[node.offset + i + 1]));
+                }
+                out.value = std::move(items);
+                return out;
+            }
+            case PlutusDataType::CONSTRUCTOR:
+            {
+                PlutusData out;
+                out.type = PlutusDataType::CONSTRUCTOR;
+                std::vector<std::shared_ptr<PlutusData>> fields;
+                fields.reserve(node.length);
+                for (uint32_t i = 0; i < node.length; ++i)
+                {
+                    fields.push_back(std::make_shared<PlutusData>(to_plutus_data(children_[node.offset + i])));
+                }
+                out.value = std::make_pair(static_cast<uint64_t>(node.value), std::move(fields));
+                return out;
+            }
+            case PlutusDataType::UNIT:
+            default:
+                return PlutusData();
+            }
+        }
+
+        void PlutusDataArena::encode(NodeId id, std::vector<uint8_t> &out) const
+        {
+            const Node &node = nodes_[id];
+            switch (node.type)
+            {
+            case PlutusDataType::INTEGER:
+                if (node.value >= 0)
+                {
+                    write_head(out, 0, static_cast<uint64_t>(node.value));
+                }
+                else
+                {
+                    write_head(out, 1, static_cast<uint64_t>(-(node.value + 1)));
+                }
+                return;
+            case PlutusDataType::BYTESTRING:
+            {
+                const uint8_t *data = bytes_.data() + node.offset;
+                if (node.length <= kBytesChunk)
+                {
+                    write_head(out, 2, node.length);
+                    out.insert(out.end(), data, data + node.length);
+                    return;
+                }
+                out.push_back(0x5f);
+                for (size_t offset = 0; offset < node.length; offset += kBytesChunk)
+                {
+                    const size_t chunk = std::min<size_t>(kBytesChunk, node.length - offset);
+                    write_head(out, 2, chunk);
+                    out.insert(out.end(), data + offset, data + offset + chunk);
+                }
+                out.push_back(0xff);
+                return;
+            }
+            case PlutusDataType::BOOLEAN:
+                write_constructor_tag(out, node.value ? 1 : 0);
+                out.push_back(0x80);
+                return;
+            case PlutusDataType::UNIT:
+                write_constructor_tag(out, 0);
+                out.push_back(0x80);
+                return;
+            case PlutusDataType::MAP:
+                write_head(out, 5, node.length / 2);
+                for (uint32_t i = 0; i + 1 < node.length; i += 2)
+                {
+                    encode(children_[node.offset + i], out);
+                    encode(children_[node.offset + i + 1], out);
+                }
+                return;
+            case PlutusDataType::CONSTRUCTOR:
+                write_constructor_tag(out, static_cast<uint64_t>(node.value));
+                [[fallthrough]];
+            case PlutusDataType::LIST:
+                if (node.length == 0)
+                {
+                    out.push_back(0x80);
+                    return;
+                }
+                out.push_back(0x9f);
+                for (uint32_t i = 0; i < node.length; ++i)
+                {
+                    encode(children_[node.offset + i], out);
+                }
+                out.push_back(0xff);
+                return;
+            }
+        }
+
+        bool PlutusDataArena::decode(const uint8_t *data, size_t length, NodeId &root)
+        {
+            const uint8_t *pos = data;
+            const uint8_t *end = data + length;
+            // Decoded as a root even if the caller has containers open
+            const size_t pending = pending_.size();
+            std::vector<Open> saved;
+            saved.swap(open_);
+            const bool ok = decode_item(pos, end, 0) && pos == end;
+            saved.swap(open_);
+            pending_.resize(pending);
+            if (!ok)
+            {
+                return false;
+            }
+            root = static_cast<NodeId>(nodes_.size() - 1);
+            if (!open_.empty())
+            {
+                pending_.push_back(root);
+            }
+            return true;
+        }
+
+        bool PlutusDataArena::decode_item(const uint8_t *&pos, const uint8_t *end, unsigned depth)
+        {
+            uint8_t major = 0;
+            uint64_t value = 0;
+            bool indefinite = false;
+            if (depth > kMaxDepth || !read_head(pos, end, major, value, indefinite))
+            {
+                return false;
+            }
+
+            auto read_items = [&](uint64_t count, size_t per_entry)
+            {
+                if (!indefinite && count > static_cast<uint64_t>(end - pos))
+                {
+                    return false;
+                }
+                for (uint64_t i = 0; indefinite || i < count; ++i)
+                {
+                    if (indefinite && at_break(pos, end))
+                    {
+                        break;
+                    }
+                    for (size_t j = 0; j < per_entry; ++j)
+                    {
+                        if (!decode_item(pos, end, depth + 1))
+                        {
+                            return false;
+                        }
+                    }
+                }
+                return true;
+            };
+
+            auto read_bytes = [&](uint64_t size, bool chunked)
+            {
+                Node node;
+                node.type = PlutusDataType::BYTESTRING;
+                node.offset = static_cast<uint32_t>(bytes_.size());
+                if (!chunked)
+                {
+                    if (static_cast<uint64_t>(end - pos) < size)
+                    {
+                        return false;
+                    }
+                    bytes_.insert(bytes_.end(), pos, pos + size);
+                    pos += size;
+                }
+                else
+                {
+                    while (!at_break(pos, end))
+                    {
+                        uint8_t chunk_major = 0;
+                        uint64_t chunk = 0;
+                        bool nested = false;
+                        if (!read_head(pos, end, chunk_major, chunk, nested) || chunk_major != 2 || nested ||
+                            static_cast<uint64_t>(end - pos) < chunk)
+                        {
+                            return false;
+                        }
+                        bytes_.insert(bytes_.end(), pos, pos + chunk);
+                        pos += chunk;
+                    }
+                }
+                node.length = static_cast<uint32_t>(bytes_.size() - node.offset);
+                push(node);
+                return true;
+            };
+
+            switch (major)
+            {
+            case 0:
+            case 1:
+                if (value > static_cast<uint64_t>(std::numeric_limits<int64_t>::max()))
+                {
+                    return false;
+                }
+                add_integer(major == 0 ? static_cast<int64_t>(value) : -1 - static_cast<int64_t>(value));
+                return true;
+            case 2:
+                return read_bytes(value, indefinite);
+            case 4:
+                begin_list();
+                if (!read_items(value, 1))
+                {
+                    return false;
+                }
+                this->end();
+                return true;
+            case 5:
+                begin_map();
+                if (!read_items(value, 2))
+                {
+                    return false;
+                }
+                this->end();
+                return true;
+            case 6:
+            {
+                uint64_t alternative = 0;
+                if (value >= 121 && value <= 127)
+                {
+                    alternative = value - 121;
+                }
+                else if (value >= 1280 && value <= 1400)
+                {
+                    alternative = value - 1280 + 7;
+                }
+                else if (value == 102)
+                {
+                    uint64_t count = 0;
+                    if (!read_head(pos, end, major, count, indefinite) || major != 4 || indefinite || count != 2 ||
+                        !read_head(pos, end, major, alternative, indefinite) || major != 0 ||
+                        alternative > static_cast<uint64_t>(std::numeric_limits<int64_t>::max()))
+                    {
+                        return false;
+                    }
+                }
+                else if (value == 2 || value == 3)
+                {
+                    // Bignums are accepted while they fit in 64 bits
+                    const bool negative = value == 3;
+                    uint64_t size = 0;
+                    if (!read_head(pos, end, major, size, indefinite) || major != 2 || indefinite ||
+                        static_cast<uint64_t>(end - pos) < size)
+                    {
+                        return false;
+                    }
+                    uint64_t magnitude = 0;
+                    for (uint64_t i = 0; i < size; ++i)
+                    {
+                        if (magnitude >> 56)
+                        {
+                            return false;
+                        }
+                        magnitude = (magnitude << 8) | *pos++;
+                    }
+                    if (magnitude > static_cast<uint64_t>(std::numeric_limits<int64_t>::max()))
+                    {
+                        return false;
+                    }
+                    add_integer(negative ? -1 - static_cast<int64_t>(magnitude) : static_cast<int64_t>(magnitude));
+                    return true;
+                }
+                else
+                {
+                    return false;
+                }
+
+                uint64_t count = 0;
+                if (!read_head(pos, end, major, count, indefinite) || major != 4)
+                {
+                    return false;
+                }
+                begin_constructor(alternative);
+                if (!read_items(count, 1))
+                {
+                    return false;
+                }
+                this->end();
+                return true;
+            }
+            default:
+                return false;
+            }
+        }
+
+    } // namespace core
+} // namespace cardano_iot
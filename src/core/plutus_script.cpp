@@ -0,0 +1,2635 @@
+#include "cardano_iot/core/plutus_script.h"
+#include "cardano_iot/core/plutus_data.h"
+#include "cardano_iot/utils/hash.h"
+
+#include <openssl/evp.h>
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+
+namespace cardano_iot
+{
+    namespace core
+    {
+        namespace uplc
+        {
+            namespace
+            {
+                // Flat term tags
+                enum class TermTag : uint8_t
+                {
+                    VAR = 0,
+                    DELAY = 1,
+                    LAMBDA = 2,
+                    APPLY = 3,
+                    CONSTANT = 4,
+                    FORCE = 5,
+                    ERROR = 6,
+                    BUILTIN = 7,
+                    CONSTR = 8,
+                    CASE = 9
+                };
+
+                // Flat type tags; a type is stored as its prefix-order tag list
+                constexpr uint8_t kTypeInteger = 0;
+                constexpr uint8_t kTypeByteString = 1;
+                constexpr uint8_t kTypeString = 2;
+                constexpr uint8_t kTypeUnit = 3;
+                constexpr uint8_t kTypeBool = 4;
+                constexpr uint8_t kTypeList = 5;
+                constexpr uint8_t kTypePair = 6;
+                constexpr uint8_t kTypeApply = 7;
+                constexpr uint8_t kTypeData = 8;
+
+                constexpr unsigned kMaxDepth = 4096;
+
+                // CEK machine costs (Plutus V2 defaults)
+                constexpr uint64_t kStartupCpu = 100;
+                constexpr uint64_t kStartupMemory = 100;
+                constexpr uint64_t kStepCpu = 16000;
+                constexpr uint64_t kStepMemory = 100;
+
+                using Type = std::vector<uint8_t>;
+
+                const Type kInteger{kTypeInteger};
+                const Type kByteString{kTypeByteString};
+                const Type kString{kTypeString};
+                const Type kUnit{kTypeUnit};
+                const Type kBool{kTypeBool};
+                const Type kData{kTypeData};
+                const Type kListData{kTypeApply, kTypeList, kTypeData};
+                const Type kPairData{kTypeApply, kTypeApply, kTypePair, kTypeData, kTypeData};
+                const Type kListPairData{kTypeApply, kTypeList, kTypeApply, kTypeApply, kTypePair, kTypeData, kTypeData};
+                const Type kPairIntegerListData{kTypeApply, kTypeApply, kTypePair, kTypeInteger,
+                                                 kTypeApply, kTypeList, kTypeData};
+
+                struct BuiltinInfo
+                {
+                    uint8_t forces;
+                    uint8_t arity;
+                    uint64_t cpu_base;
+                    uint64_t cpu_slope;
+                    uint64_t memory_base;
+                    uint64_t memory_slope;
+                };
+
+                constexpr BuiltinInfo kBuiltins[static_cast<size_t>(Builtin::BUILTIN_COUNT)] = {
+                    {0, 2, 205665, 812, 1, 1},       // addInteger
+                    {0, 2, 205665, 812, 1, 1},       // subtractInteger
+                    {0, 2, 69522, 11687, 0, 1},      // multiplyInteger
+                    {0, 2, 196500, 0, 1, 0},         // divideInteger
+                    {0, 2, 196500, 0, 1, 0},         // quotientInteger
+                    {0, 2, 196500, 0, 1, 0},         // remainderInteger
+                    {0, 2, 196500, 0, 1, 0},         // modInteger
+                    {0, 2, 208512, 421, 1, 0},       // equalsInteger
+                    {0, 2, 208896, 511, 1, 0},       // lessThanInteger
+                    {0, 2, 204924, 473, 1, 0},       // lessThanEqualsInteger
+                    {0, 2, 1000, 571, 0, 1},         // appendByteString
+                    {0, 2, 221973, 511, 0, 1},       // consByteString
+                    {0, 3, 265318, 0, 4, 0},         // sliceByteString
+                    {0, 1, 1000, 0, 10, 0},          // lengthOfByteString
+                    {0, 2, 57667, 0, 4, 0},          // indexByteString
+                    {0, 2, 216773, 62, 1, 0},        // equalsByteString
+                    {0, 2, 197145, 156, 1, 0},       // lessThanByteString
+                    {0, 2, 197145, 156, 1, 0},       // lessThanEqualsByteString
+                    {0, 1, 806990, 30482, 4, 0},     // sha2_256
+                    {0, 1, 1927926, 82523, 4, 0},    // sha3_256
+                    {0, 1, 117366, 10475, 4, 0},     // blake2b_256
+                    {0, 3, 57996947, 18975, 10, 0},  // verifyEd25519Signature
+                    {0, 2, 1000, 24177, 4, 1},       // appendString
+                    {0, 2, 1000, 52998, 1, 0},       // equalsString
+                    {0, 1, 1000, 28662, 4, 2},       // encodeUtf8
+                    {0, 1, 497525, 14068, 4, 2},     // decodeUtf8
+                    {1, 3, 80556, 0, 1, 0},          // ifThenElse
+                    {1, 2, 46417, 0, 4, 0},          // chooseUnit
+                    {1, 2, 212342, 0, 32, 0},        // trace
+                    {2, 1, 80436, 0, 32, 0},         // fstPair
+                    {2, 1, 85931, 0, 32, 0},         // sndPair
+                    {2, 3, 175354, 0, 32, 0},        // chooseList
+                    {1, 2, 65493, 0, 32, 0},         // mkCons
+                    {1, 1, 43249, 0, 32, 0},         // headList
+                    {1, 1, 41182, 0, 32, 0},         // tailList
+                    {1, 1, 60091, 0, 32, 0},         // nullList
+                    {1, 6, 19537, 0, 32, 0},         // chooseData
+                    {0, 2, 89141, 0, 32, 0},         // constrData
+                    {0, 1, 64832, 0, 32, 0},         // mapData
+                    {0, 1, 52467, 0, 32, 0},         // listData
+                    {0, 1, 1000, 0, 32, 0},          // iData
+                    {0, 1, 1000, 0, 32, 0},          // bData
+                    {0, 1, 32696, 0, 32, 0},         // unConstrData
+                    {0, 1, 38314, 0, 32, 0},         // unMapData
+                    {0, 1, 32247, 0, 32, 0},         // unListData
+                    {0, 1, 43357, 0, 32, 0},         // unIData
+                    {0, 1, 31220, 0, 32, 0},         // unBData
+                    {0, 2, 1060367, 12586, 1, 0},    // equalsData
+                    {0, 2, 76511, 0, 32, 0},         // mkPairData
+                    {0, 1, 22558, 0, 32, 0},         // mkNilData
+                    {0, 1, 16563, 0, 32, 0},         // mkNilPairData
+                    {0, 1, 1159724, 392670, 0, 2},   // serialiseData
+                };
+
+                const BuiltinInfo &info(Builtin function)
+                {
+                    return kBuiltins[static_cast<size_t>(function)];
+                }
+
+                // ---- Plutus Data ----
+
+                struct Data;
+                using DataPtr = std::shared_ptr<const Data>;
+
+                struct Data
+                {
+                    enum Kind : uint8_t
+                    {
+                        CONSTR,
+                        MAP,
+                        LIST,
+                        INTEGER,
+                        BYTES
+                    };
+
+                    Kind kind = CONSTR;
+                    int64_t integer = 0; // I value, or the constructor tag
+                    std::string bytes;
+                    std::vector<DataPtr> items; // fields, list items, or map keys and values interleaved
+                };
+
+                DataPtr make_data(Data::Kind kind, int64_t integer = 0)
+                {
+                    auto data = std::make_shared<Data>();
+                    data->kind = kind;
+                    data->integer = integer;
+                    return data;
+                }
+
+                bool data_equal(const Data &a, const Data &b)
+                {
+                    if (a.kind != b.kind || a.integer != b.integer || a.bytes != b.bytes ||
+                        a.items.size() != b.items.size())
+                    {
+                        return false;
+                    }
+                    for (size_t i = 0; i < a.items.size(); ++i)
+                    {
+                        if (!data_equal(*a.items[i], *b.items[i]))
+                        {
+                            return false;
+                        }
+                    }
+                    return true;
+                }
+
+                uint64_t data_size(const Data &data)
+                {
+                    uint64_t size = 4;
+                    if (data.kind == Data::INTEGER)
+                    {
+                        size += 1;
+                    }
+                    else if (data.kind == Data::BYTES)
+                    {
+                        size += std::max<uint64_t>(1, (data.bytes.size() + 7) / 8);
+                    }
+                    for (const auto &item : data.items)
+                    {
+                        size += data_size(*item);
+                    }
+                    return size;
+                }
+
+                void cbor_head(std::vector<uint8_t> &out, uint8_t major, uint64_t value)
+                {
+                    const uint8_t type = static_cast<uint8_t>(major << 5);
+                    if (value < 24)
+                    {
+                        out.push_back(type | static_cast<uint8_t>(value));
+                        return;
+                    }
+                    int bytes = value <= 0xff ? 1 : value <= 0xffff ? 2 : value <= 0xffffffffULL ? 4 : 8;
+                    out.push_back(type | static_cast<uint8_t>(bytes == 1 ? 24 : bytes == 2 ? 25 : bytes == 4 ? 26 : 27));
+                    for (int i = bytes - 1; i >= 0; --i)
+                    {
+                        out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+                    }
+                }
+
+                // Encodes as the ledger does: long byte strings chunked, non-empty lists indefinite
+                void encode_data(const Data &data, std::vector<uint8_t> &out)
+                {
+                    auto encode_list = [&out](const std::vector<DataPtr> &items)
+                    {
+                        if (items.empty())
+                        {
+                            out.push_back(0x80);
+                            return;
+                        }
+                        out.push_back(0x9f);
+                        for (const auto &item : items)
+                        {
+                            encode_data(*item, out);
+                        }
+                        out.push_back(0xff);
+                    };
+
+                    switch (data.kind)
+                    {
+                    case Data::INTEGER:
+                        if (data.integer >= 0)
+                        {
+                            cbor_head(out, 0, static_cast<uint64_t>(data.integer));
+                        }
+                        else
+                        {
+                            cbor_head(out, 1, static_cast<uint64_t>(-(data.integer + 1)));
+                        }
+                        break;
+                    case Data::BYTES:
+                        if (data.bytes.size() <= 64)
+                        {
+                            cbor_head(out, 2, data.bytes.size());
+                            out.insert(out.end(), data.bytes.begin(), data.bytes.end());
+                        }
+                        else
+                        {
+                            out.push_back(0x5f);
+                            for (size_t offset = 0; offset < data.bytes.size(); offset += 64)
+                            {
+                                const size_t chunk = std::min<size_t>(64, data.bytes.size() - offset);
+                                cbor_head(out, 2, chunk);
+                                out.insert(out.end(), data.bytes.begin() + offset, data.bytes.begin() + offset + chunk);
+                            }
+                            out.push_back(0xff);
+                        }
+                        break;
+                    case Data::LIST:
+                        encode_list(data.items);
+                        break;
+                    case Data::MAP:
+                        cbor_head(out, 5, data.items.size() / 2);
+                        for (const auto &item : data.items)
+                        {
+                            encode_data(*item, out);
+                        }
+                        break;
+                    case Data::CONSTR:
+                    {
+                        const uint64_t tag = static_cast<uint64_t>(data.integer);
+                        if (tag < 7)
+                        {
+                            cbor_head(out, 6, 121 + tag);
+                        }
+                        else if (tag < 128)
+                        {
+                            cbor_head(out, 6, 1280 + tag - 7);
+                        }
+                        else
+                        {
+                            cbor_head(out, 6, 102);
+                            cbor_head(out, 4, 2);
+                            cbor_head(out, 0, tag);
+                        }
+                        encode_list(data.items);
+                    }
+                    break;
+                    }
+                }
+
+                class DataReader
+                {
+                public:
+                    DataReader(const uint8_t *data, size_t length) : pos_(data), end_(data + length) {}
+
+                    bool read(DataPtr &out, unsigned depth = 0)
+                    {
+                        uint8_t major = 0;
+                        uint64_t value = 0;
+                        bool indefinite = false;
+                        if (depth > kMaxDepth || !head(major, value, indefinite))
+                        {
+                            return false;
+                        }
+
+                        switch (major)
+                        {
+                        case 0:
+                            if (indefinite || value > static_cast<uint64_t>(std::numeric_limits<int64_t>::max()))
+                            {
+                                return false;
+                            }
+                            out = make_data(Data::INTEGER, static_cast<int64_t>(value));
+                            return true;
+                        case 1:
+                            if (indefinite || value > static_cast<uint64_t>(std::numeric_limits<int64_t>::max()))
+                            {
+                                return false;
+                            }
+                            out = make_data(Data::INTEGER, -1 - static_cast<int64_t>(value));
+                            return true;
+                        case 2:
+                        {
+                            auto data = std::make_shared<Data>();
+                            data->kind = Data::BYTES;
+                            if (!read_bytes(value, indefinite, data->bytes))
+                            {
+                                return false;
+                            }
+                            out = std::move(data);
+                            return true;
+                        }
+                        case 4:
+                        {
+                            auto data = std::make_shared<Data>();
+                            data->kind = Data::LIST;
+                            if (!read_items(value, indefinite, 1, data->items, depth))
+                            {
+                                return false;
+                            }
+                            out = std::move(data);
+                            return true;
+                        }
+                        case 5:
+                        {
+                            auto data = std::make_shared<Data>();
+                            data->kind = Data::MAP;
+                            if (!read_items(value, indefinite, 2, data->items, depth))
+                            {
+                                return false;
+                            }
+                            out = std::move(data);
+                            return true;
+                        }
+                        case 6:
+                            return read_tagged(value, out, depth);
+                        default:
+                            return false;
+                        }
+                    }
+
+                    bool at_end() const { return pos_ == end_; }
+
+                private:
+                    const uint8_t *pos_;
+                    const uint8_t *end_;
+
+                    bool head(uint8_t &major, uint64_t &value, bool &indefinite)
+                    {
+                        if (pos_ >= end_)
+                        {
+                            return false;
+                        }
+                        const uint8_t initial = *pos_++;
+                        major = initial >> 5;
+                        const uint8_t extra = initial & 0x1f;
+                        indefinite = false;
+                        if (extra < 24)
+                        {
+                            value = extra;
+                            return true;
+                        }
+                        if (extra == 31)
+                        {
+                            indefinite = true;
+                            return major == 2 || major == 4 || major == 5;
+                        }
+                        if (extra > 27)
+                        {
+                            return false;
+                        }
+                        const size_t bytes = size_t(1) << (extra - 24);
+                        if (static_cast<size_t>(end_ - pos_) < bytes)
+                        {
+                            return false;
+                        }
+                        value = 0;
+                        for (size_t i = 0; i < bytes; ++i)
+                        {
+                            value = (value << 8) | *pos_++;
+                        }
+                        return true;
+                    }
+
+                    bool at_break()
+                    {
+                        if (pos_ < end_ && *pos_ == 0xff)
+                        {
+                            ++pos_;
+                            return true;
+                        }
+                        return false;
+                    }
+
+                    bool read_bytes(uint64_t length, bool indefinite, std::string &out)
+                    {
+                        if (!indefinite)
+                        {
+                            if (static_cast<uint64_t>(end_ - pos_) < length)
+                            {
+                                return false;
+                            }
+                            out.append(reinterpret_cast<const char *>(pos_), length);
+                            pos_ += length;
+                            return true;
+                        }
+                        while (!at_break())
+                        {
+                            uint8_t major = 0;
+                            uint64_t chunk = 0;
+                            bool nested = false;
+                            if (!head(major, chunk, nested) || major != 2 || nested || !read_bytes(chunk, false, out))
+                            {
+                                return false;
+                            }
+                        }
+                        return true;
+                    }
+
+                    bool read_items(uint64_t count, bool indefinite, size_t per_entry, std::vector<DataPtr> &items,
+                                    unsigned depth)
+                    {
+                        if (!indefinite && count > static_cast<uint64_t>(end_ - pos_))
+                        {
+                            return false;
+                        }
+                        for (uint64_t i = 0; indefinite || i < count; ++i)
+                        {
+                            if (indefinite && at_break())
+                            {
+                                break;
+                            }
+                            for (size_t j = 0; j < per_entry; ++j)
+                            {
+                                DataPtr item;
+                                if (!read(item, depth + 1))
+                                {
+                                    return false;
+                                }
+                                items.push_back(std::move(item));
+                            }
+                        }
+                        return true;
+                    }
+
+                    bool read_fields(uint64_t tag, DataPtr &out, unsigned depth)
+                    {
+                        uint8_t major = 0;
+                        uint64_t count = 0;
+                        bool indefinite = false;
+                        auto data = std::make_shared<Data>();
+                        data->kind = Data::CONSTR;
+                        data->integer = static_cast<int64_t>(tag);
+                        if (!head(major, count, indefinite) || major != 4 ||
+                            !read_items(count, indefinite, 1, data->items, depth))
+                        {
+                            return false;
+                        }
+                        out = std::move(data);
+                        return true;
+                    }
+
+                    bool read_tagged(uint64_t tag, DataPtr &out, unsigned depth)
+                    {
+                        if (tag >= 121 && tag <= 127)
+                        {
+                            return read_fields(tag - 121, out, depth);
+                        }
+                        if (tag >= 1280 && tag <= 1400)
+                        {
+                            return read_fields(tag - 1280 + 7, out, depth);
+                        }
+                        if (tag == 102)
+                        {
+                            uint8_t major = 0;
+                            uint64_t count = 0;
+                            uint64_t alternative = 0;
+                            bool indefinite = false;
+                            if (!head(major, count, indefinite) || major != 4 || indefinite || count != 2 ||
+                                !head(major, alternative, indefinite) || major != 0 ||
+                                alternative > static_cast<uint64_t>(std::numeric_limits<int64_t>::max()))
+                            {
+                                return false;
+                            }
+                            return read_fields(alternative, out, depth);
+                        }
+                        if (tag == 2 || tag == 3)
+                        {
+                            // Bignums are accepted while they fit in 64 bits
+                            uint8_t major = 0;
+                            uint64_t length = 0;
+                            bool indefinite = false;
+                            std::string bytes;
+                            if (!head(major, length, indefinite) || major != 2 || !read_bytes(length, indefinite, bytes))
+                            {
+                                return false;
+                            }
+                            uint64_t magnitude = 0;
+                            for (unsigned char c : bytes)
+                            {
+                                if (magnitude >> 56)
+                                {
+                                    return false;
+                                }
+                                magnitude = (magnitude << 8) | c;
+                            }
+                            if (magnitude > static_cast<uint64_t>(std::numeric_limits<int64_t>::max()))
+                            {
+                                return false;
+                            }
+                            const int64_t value = static_cast<int64_t>(magnitude);
+                            out = make_data(Data::INTEGER, tag == 2 ? value : -1 - value);
+                            return true;
+                        }
+                        return false;
+                    }
+                };
+
+                DataPtr to_data(const PlutusData &value)
+                {
+                    switch (value.type)
+                    {
+                    case PlutusDataType::INTEGER:
+                        return make_data(Data::INTEGER, std::get<int64_t>(value.value));
+                    case PlutusDataType::BYTESTRING:
+                    {
+                        const auto &bytes = std::get<std::vector<uint8_t>>(value.value);
+                        auto data = std::make_shared<Data>();
+                        data->kind = Data::BYTES;
+                        data->bytes.assign(bytes.begin(), bytes.end());
+                        return data;
+                    }
+                    case PlutusDataType::BOOLEAN:
+                        return make_data(Data::CONSTR, std::get<bool>(value.value) ? 1 : 0);
+                    case PlutusDataType::LIST:
+                    {
+                        auto data = std::make_shared<Data>();
+                        data->kind = Data::LIST;
+                        for (const auto &item : std::get<std::vector<std::shared_ptr<PlutusData>>>(value.value))
+                        {
+                            data->items.push_back(item ? to_data(*item) : make_data(Data::CONSTR));
+                        }
+                        return data;
+                    }
+                    case PlutusDataType::MAP:
+                    {
+                        auto data = std::make_shared<Data>();
+                        data->kind = Data::MAP;
+                        for (const auto &[key, item] :
+                             std::get<std::map<std::string, std::shared_ptr<PlutusData>>>(value.value))
+                        {
+                            auto key_data = std::make_shared<Data>();
+                            key_data->kind = Data::BYTES;
+                            key_data->bytes = key;
+                            data->items.push_back(std::move(key_data));
+                            data->items.push_back(item ? to_data(*item) : make_data(Data::CONSTR));
+                        }
+                        return data;
+                    }
+                    case PlutusDataType::CONSTRUCTOR:
+                    {
+                        const auto &constructor =
+                            std::get<std::pair<uint64_t, std::vector<std::shared_ptr<PlutusData>>>>(value.value);
+                        auto data = std::make_shared<Data>();
+                        data->kind = Data::CONSTR;
+                        data->integer = static_cast<int64_t>(constructor.first);
+                        for (const auto &field : constructor.second)
+                        {
+                            data->items.push_back(field ? to_data(*field) : make_data(Data::CONSTR));
+                        }
+                        return data;
+                    }
+                    case PlutusDataType::UNIT:
+                    default:
+                        return make_data(Data::CONSTR);
+                    }
+                }
+
+                PlutusData from_data(const Data &data)
+                {
+                    switch (data.kind)
+                    {
+                    case Data::INTEGER:
+                        return PlutusData(data.integer);
+                    case Data::BYTES:
+                        return PlutusData(std::vector<uint8_t>(data.bytes.begin(), data.bytes.end()));
+                    case Data::LIST:
+                    {
+                        PlutusData out;
+                        out.type = PlutusDataType::LIST;
+                        std::vector<std::shared_ptr<PlutusData>> items;
+                        items.reserve(data.items.size());
+                        for (const auto &item : data.items)
+                        {
+                            items.push_back(std::make_shared<PlutusData>(from_data(*item)));
+                        }
+                        out.value = std::move(items);
+                        return out;
+                    }
+                    case Data::MAP:
+                    {
+                        PlutusData out;
+                        out.type = PlutusDataType::MAP;
+                        std::map<std::string, std::shared_ptr<PlutusData>> items;
+                        for (size_t i = 0; i + 1 < data.items.size(); i += 2)
+                        {
+                            const Data &key = *data.items[i];
+                            std::string name = key.kind == Data::BYTES     ? key.bytes
+                                               : key.kind == Data::INTEGER ? std::to_string(key.integer)
+                                                                           : std::string();
+                            if (key.kind != Data::BYTES && key.kind != Data::INTEGER)
+                            {
+                                std::vector<uint8_t> encoded;
+                                encode_data(key, encoded);
+                                name.assign(encoded.begin(), encoded.end());
+                            }
+                            items[name] = std::make_shared<PlutusData>(from_data(*data.items[i + 1]));
+                        }
+                        out.value = std::move(items);
+                        return out;
+                    }
+                    case Data::CONSTR:
+                    default:
+                    {
+                        PlutusData out;
+                        out.type = PlutusDataType::CONSTRUCTOR;
+                        std::vector<std::shared_ptr<PlutusData>> fields;
+                        for (const auto &field : data.items)
+                        {
+                            fields.push_back(std::make_shared<PlutusData>(from_data(*field)));
+                        }
+                        out.value = std::make_pair(static_cast<uint64_t>(data.integer), std::move(fields));
+                        return out;
+                    }
+                    }
+                }
+
+                // ---- Constants ----
+
+                struct Constant;
+                using ConstantPtr = std::shared_ptr<const Constant>;
+
+                struct Constant
+                {
+                    Type type;
+                    int64_t integer = 0;
+                    bool boolean = false;
+                    std::string bytes;              // byte string or text
+                    std::vector<ConstantPtr> items; // list elements, or the two halves of a pair
+                    DataPtr data;
+                };
+
+                bool type_well_formed(const Type &type, size_t &pos)
+                {
+                    if (pos >= type.size())
+                    {
+                        return false;
+                    }
+                    const uint8_t tag = type[pos++];
+                    switch (tag)
+                    {
+                    case kTypeInteger:
+                    case kTypeByteString:
+                    case kTypeString:
+                    case kTypeUnit:
+                    case kTypeBool:
+                    case kTypeData:
+                        return true;
+                    case kTypeApply:
+                        if (pos < type.size() && type[pos] == kTypeList)
+                        {
+                            ++pos;
+                            return type_well_formed(type, pos);
+                        }
+                        if (pos + 1 < type.size() && type[pos] == kTypeApply && type[pos + 1] == kTypePair)
+                        {
+                            pos += 2;
+                            return type_well_formed(type, pos) && type_well_formed(type, pos);
+                        }
+                        return false;
+                    default:
+                        return false;
+                    }
+                }
+
+                bool is_list(const Type &type) { return type.size() > 2 && type[0] == kTypeApply && type[1] == kTypeList; }
+                bool is_pair(const Type &type) { return type.size() > 3 && type[0] == kTypeApply && type[1] == kTypeApply; }
+
+                Type element_type(const Type &list) { return Type(list.begin() + 2, list.end()); }
+
+                std::pair<Type, Type> pair_types(const Type &pair)
+                {
+                    size_t split = 3;
+                    type_well_formed(pair, split);
+                    return {Type(pair.begin() + 3, pair.begin() + split), Type(pair.begin() + split, pair.end())};
+                }
+
+                ConstantPtr make_integer(int64_t value)
+                {
+                    auto constant = std::make_shared<Constant>();
+                    constant->type = kInteger;
+                    constant->integer = value;
+                    return constant;
+                }
+
+                ConstantPtr make_bytes(const Type &type, std::string bytes)
+                {
+                    auto constant = std::make_shared<Constant>();
+                    constant->type = type;
+                    constant->bytes = std::move(bytes);
+                    return constant;
+                }
+
+                ConstantPtr make_bool(bool value)
+                {
+                    auto constant = std::make_shared<Constant>();
+                    constant->type = kBool;
+                    constant->boolean = value;
+                    return constant;
+                }
+
+                constexpr size_t ED25519_KEY_BYTES = 32;
+                constexpr size_t ED25519_SIGNATURE_BYTES = 64;
+
+                // False for a signature that does not verify; lengths are checked by the caller
+                bool verify_ed25519(const std::string &key, const std::string &message, const std::string &signature)
+                {
+                    std::unique_ptr<EVP_PKEY, decltype(&EVP_PKEY_free)> pkey(
+                        EVP_PKEY_new_raw_public_key(EVP_PKEY_ED25519, nullptr,
+                                                    reinterpret_cast<const unsigned char *>(key.data()), key.size()),
+                        EVP_PKEY_free);
+                    std::unique_ptr<EVP_MD_CTX, decltype(&EVP_MD_CTX_free)> ctx(EVP_MD_CTX_new(), EVP_MD_CTX_free);
+                    return pkey && ctx && EVP_DigestVerifyInit(ctx.get(), nullptr, nullptr, nullptr, pkey.get()) > 0 &&
+                           EVP_DigestVerify(ctx.get(), reinterpret_cast<const unsigned char *>(signature.data()),
+                                            signature.size(), reinterpret_cast<const unsigned char *>(message.data()),
+                                            message.size()) == 1;
+                }
+
+                ConstantPtr make_unit()
+                {
+                    auto constant = std::make_shared<Constant>();
+                    constant->type = kUnit;
+                    return constant;
+                }
+
+                ConstantPtr make_data_constant(DataPtr data)
+                {
+                    auto constant = std::make_shared<Constant>();
+                    constant->type = kData;
+                    constant->data = std::move(data);
+                    return constant;
+                }
+
+                ConstantPtr make_sequence(const Type &type, std::vector<ConstantPtr> items)
+                {
+                    auto constant = std::make_shared<Constant>();
+                    constant->type = type;
+                    constant->items = std::move(items);
+                    return constant;
+                }
+
+                ConstantPtr make_data_list(const std::vector<DataPtr> &items)
+                {
+                    std::vector<ConstantPtr> elements;
+                    elements.reserve(items.size());
+                    for (const auto &item : items)
+                    {
+                        elements.push_back(make_data_constant(item));
+                    }
+                    return make_sequence(kListData, std::move(elements));
+                }
+
+                uint64_t constant_size(const Constant &constant)
+                {
+                    if (is_list(constant.type) || is_pair(constant.type))
+                    {
+                        uint64_t size = 0;
+                        for (const auto &item : constant.items)
+                        {
+                            size += constant_size(*item);
+                        }
+                        return std::max<uint64_t>(1, size);
+                    }
+                    switch (constant.type[0])
+                    {
+                    case kTypeByteString:
+                        return std::max<uint64_t>(1, (constant.bytes.size() + 7) / 8);
+                    case kTypeString:
+                        return std::max<uint64_t>(1, constant.bytes.size());
+                    case kTypeData:
+                        return data_size(*constant.data);
+                    default:
+                        return 1;
+                    }
+                }
+
+                PlutusData constant_to_plutus(const Constant &constant)
+                {
+                    if (is_list(constant.type) || is_pair(constant.type))
+                    {
+                        PlutusData out;
+                        out.type = PlutusDataType::LIST;
+                        std::vector<std::shared_ptr<PlutusData>> items;
+                        for (const auto &item : constant.items)
+                        {
+                            items.push_back(std::make_shared<PlutusData>(constant_to_plutus(*item)));
+                        }
+                        out.value = std::move(items);
+                        return out;
+                    }
+                    switch (constant.type[0])
+                    {
+                    case kTypeInteger:
+                        return PlutusData(constant.integer);
+                    case kTypeByteString:
+                    case kTypeString:
+                        return PlutusData(std::vector<uint8_t>(constant.bytes.begin(), constant.bytes.end()));
+                    case kTypeBool:
+                        return PlutusData(constant.boolean);
+                    case kTypeData:
+                        return from_data(*constant.data);
+                    default:
+                        return PlutusData();
+                    }
+                }
+
+                bool valid_utf8(const std::string &text)
+                {
+                    size_t i = 0;
+                    while (i < text.size())
+                    {
+                        const unsigned char c = static_cast<unsigned char>(text[i]);
+                        const size_t length = c < 0x80 ? 1 : (c >> 5) == 0x6 ? 2 : (c >> 4) == 0xe ? 3 : (c >> 3) == 0x1e ? 4 : 0;
+                        if (length == 0 || i + length > text.size())
+                        {
+                            return false;
+                        }
+                        for (size_t j = 1; j < length; ++j)
+                        {
+                            if ((static_cast<unsigned char>(text[i + j]) >> 6) != 0x2)
+                            {
+                                return false;
+                            }
+                        }
+                        i += length;
+                    }
+                    return true;
+                }
+
+                // ---- Flat ----
+
+                class BitReader
+                {
+                public:
+                    BitReader(const uint8_t *data, size_t length) : data_(data), bits_(length * 8) {}
+
+                    bool bit(bool &out)
+                    {
+                        if (pos_ >= bits_)
+                        {
+                            return false;
+                        }
+                        out = (data_[pos_ >> 3] >> (7 - (pos_ & 7))) & 1;
+                        ++pos_;
+                        return true;
+                    }
+
+                    bool bits(unsigned count, uint64_t &out)
+                    {
+                        if (pos_ + count > bits_)
+                        {
+                            return false;
+                        }
+                        out = 0;
+                        for (unsigned i = 0; i < count; ++i)
+                        {
+                            out = (out << 1) | ((data_[pos_ >> 3] >> (7 - (pos_ & 7))) & 1);
+                            ++pos_;
+                        }
+                        return true;
+                    }
+
+                    // 7-bit groups, least significant first, high bit set while more follow
+                    bool natural(uint64_t &out)
+                    {
+                        out = 0;
+                        for (unsigned shift = 0;; shift += 7)
+                        {
+                            uint64_t group = 0;
+                            if (!bits(8, group) || shift > 63 || (shift == 63 && (group & 0x7f) > 1))
+                            {
+                                return false;
+                            }
+                            out |= (group & 0x7f) << shift;
+                            if (!(group & 0x80))
+                            {
+                                return true;
+                            }
+                        }
+                    }
+
+                    bool integer(int64_t &out)
+                    {
+                        uint64_t zigzag = 0;
+                        if (!natural(zigzag))
+                        {
+                            return false;
+                        }
+                        out = static_cast<int64_t>(zigzag >> 1) ^ -static_cast<int64_t>(zigzag & 1);
+                        return true;
+                    }
+
+                    // Zero or more 0 bits and a 1 that ends on a byte boundary
+                    bool filler()
+                    {
+                        bool one = false;
+                        while (bit(one))
+                        {
+                            if (one)
+                            {
+                                return (pos_ & 7) == 0;
+                            }
+                        }
+                        return false;
+                    }
+
+                    bool bytes(std::string &out)
+                    {
+                        if (!filler())
+                        {
+                            return false;
+                        }
+                        for (;;)
+                        {
+                            if (pos_ + 8 > bits_)
+                            {
+                                return false;
+                            }
+                            const size_t chunk = data_[pos_ >> 3];
+                            pos_ += 8;
+                            if (chunk == 0)
+                            {
+                                return true;
+                            }
+                            if (pos_ + chunk * 8 > bits_)
+                            {
+                                return false;
+                            }
+                            out.append(reinterpret_cast<const char *>(data_ + (pos_ >> 3)), chunk);
+                            pos_ += chunk * 8;
+                        }
+                    }
+
+                    bool at_end() const { return pos_ == bits_; }
+
+                private:
+                    const uint8_t *data_;
+                    size_t bits_;
+                    size_t pos_ = 0;
+                };
+
+                class BitWriter
+                {
+                public:
+                    void bit(bool value)
+                    {
+                        if (used_ == 0)
+                        {
+                            out_.push_back(0);
+                        }
+                        if (value)
+                        {
+                            out_.back() |= static_cast<uint8_t>(0x80 >> used_);
+                        }
+                        used_ = (used_ + 1) & 7;
+                    }
+
+                    void bits(unsigned count, uint64_t value)
+                    {
+                        for (unsigned i = count; i-- > 0;)
+                        {
+                            bit((value >> i) & 1);
+                        }
+                    }
+
+                    void natural(uint64_t value)
+                    {
+                        do
+                        {
+                            const uint64_t group = value & 0x7f;
+                            value >>= 7;
+                            bits(8, group | (value ? 0x80 : 0));
+                        } while (value);
+                    }
+
+                    void integer(int64_t value)
+                    {
+                        natural((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+                    }
+
+                    void filler()
+                    {
+                        while (used_ != 7)
+                        {
+                            bit(false);
+                        }
+                        bit(true);
+                    }
+
+                    void bytes(const std::string &value)
+                    {
+                        filler();
+                        for (size_t offset = 0; offset < value.size(); offset += 255)
+                        {
+                            const size_t chunk = std::min<size_t>(255, value.size() - offset);
+                            out_.push_back(static_cast<uint8_t>(chunk));
+                            out_.insert(out_.end(), value.begin() + offset, value.begin() + offset + chunk);
+                        }
+                        out_.push_back(0);
+                    }
+
+                    std::vector<uint8_t> take() { return std::move(out_); }
+
+                private:
+                    std::vector<uint8_t> out_;
+                    unsigned used_ = 0;
+                };
+            } // namespace
+
+            // ---- Program ----
+
+            struct Program::Impl
+            {
+                struct Term
+                {
+                    TermTag tag = TermTag::ERROR;
+                    uint32_t a = 0; // body / function / scrutinee / constant index / list offset
+                    uint32_t b = 0; // argument / list length
+                    uint64_t value = 0; // variable index, builtin, constructor tag, or case list offset
+                };
+
+                uint32_t major = 1;
+                uint32_t minor = 0;
+                uint32_t patch = 0;
+                std::vector<Term> terms;
+                std::vector<ConstantPtr> constants;
+                std::vector<uint32_t> lists; // constr fields and case branches
+                uint32_t root = 0;
+                bool has_root = false;
+                mutable std::atomic<bool> validated{false};
+
+                uint32_t add(TermTag tag, uint32_t a = 0, uint32_t b = 0, uint64_t value = 0)
+                {
+                    terms.push_back(Term{tag, a, b, value});
+                    validated = false;
+                    return static_cast<uint32_t>(terms.size() - 1);
+                }
+
+                uint32_t add_constant(ConstantPtr constant)
+                {
+                    constants.push_back(std::move(constant));
+                    return add(TermTag::CONSTANT, static_cast<uint32_t>(constants.size() - 1));
+                }
+
+                uint32_t add_list(const std::vector<uint32_t> &items)
+                {
+                    const uint32_t offset = static_cast<uint32_t>(lists.size());
+                    lists.insert(lists.end(), items.begin(), items.end());
+                    return offset;
+                }
+
+                bool check(uint32_t index, uint32_t depth, unsigned nesting, std::string &error) const
+                {
+                    if (nesting > kMaxDepth)
+                    {
+                        error = "term nesting too deep";
+                        return false;
+                    }
+                    if (index >= terms.size())
+                    {
+                        error = "term index out of range";
+                        return false;
+                    }
+                    const Term &term = terms[index];
+                    switch (term.tag)
+                    {
+                    case TermTag::VAR:
+                        if (term.value == 0 || term.value > depth)
+                        {
+                            error = "unbound variable";
+                            return false;
+                        }
+                        return true;
+                    case TermTag::LAMBDA:
+                        return check(term.a, depth + 1, nesting + 1, error);
+                    case TermTag::DELAY:
+                    case TermTag::FORCE:
+                        return check(term.a, depth, nesting + 1, error);
+                    case TermTag::APPLY:
+                        return check(term.a, depth, nesting + 1, error) && check(term.b, depth, nesting + 1, error);
+                    case TermTag::CONSTANT:
+                        return term.a < constants.size();
+                    case TermTag::ERROR:
+                        return true;
+                    case TermTag::BUILTIN:
+                        if (term.value >= static_cast<uint64_t>(Builtin::BUILTIN_COUNT))
+                        {
+                            error = "unknown builtin";
+                            return false;
+                        }
+                        return true;
+                    case TermTag::CONSTR:
+                    case TermTag::CASE:
+                    {
+                        if (major == 1 && minor == 0)
+                        {
+                            error = "constr/case need program version 1.1.0";
+                            return false;
+                        }
+                        const uint64_t offset = term.tag == TermTag::CONSTR ? term.a : term.value;
+                        if (offset + term.b > lists.size())
+                        {
+                            error = "term list out of range";
+                            return false;
+                        }
+                        if (term.tag == TermTag::CASE && !check(term.a, depth, nesting + 1, error))
+                        {
+                            return false;
+                        }
+                        for (uint32_t i = 0; i < term.b; ++i)
+                        {
+                            if (!check(lists[offset + i], depth, nesting + 1, error))
+                            {
+                                return false;
+                            }
+                        }
+                        return true;
+                    }
+                    }
+                    return false;
+                }
+
+                bool decode_constant(BitReader &reader, const Type &type, ConstantPtr &out) const
+                {
+                    if (is_list(type))
+                    {
+                        const Type element = element_type(type);
+                        std::vector<ConstantPtr> items;
+                        bool more = false;
+                        while (reader.bit(more) && more)
+                        {
+                            ConstantPtr item;
+                            if (!decode_constant(reader, element, item))
+                            {
+                                return false;
+                            }
+                            items.push_back(std::move(item));
+                        }
+                        if (more)
+                        {
+                            return false;
+                        }
+                        out = make_sequence(type, std::move(items));
+                        return true;
+                    }
+                    if (is_pair(type))
+                    {
+                        const auto [first_type, second_type] = pair_types(type);
+                        ConstantPtr first;
+                        ConstantPtr second;
+                        if (!decode_constant(reader, first_type, first) || !decode_constant(reader, second_type, second))
+                        {
+                            return false;
+                        }
+                        out = make_sequence(type, {std::move(first), std::move(second)});
+                        return true;
+                    }
+
+                    switch (type[0])
+                    {
+                    case kTypeInteger:
+                    {
+                        int64_t value = 0;
+                        if (!reader.integer(value))
+                        {
+                            return false;
+                        }
+                        out = make_integer(value);
+                        return true;
+                    }
+                    case kTypeByteString:
+                    case kTypeString:
+                    {
+                        std::string bytes;
+                        if (!reader.bytes(bytes) || (type[0] == kTypeString && !valid_utf8(bytes)))
+                        {
+                            return false;
+                        }
+                        out = make_bytes(type, std::move(bytes));
+                        return true;
+                    }
+                    case kTypeUnit:
+                        out = make_unit();
+                        return true;
+                    case kTypeBool:
+                    {
+                        bool value = false;
+                        if (!reader.bit(value))
+                        {
+                            return false;
+                        }
+                        out = make_bool(value);
+                        return true;
+                    }
+                    case kTypeData:
+                    {
+                        std::string bytes;
+                        DataPtr data;
+                        if (!reader.bytes(bytes))
+                        {
+                            return false;
+                        }
+                        DataReader data_reader(reinterpret_cast<const uint8_t *>(bytes.data()), bytes.size());
+                        if (!data_reader.read(data) || !data_reader.at_end())
+                        {
+                            return false;
+                        }
+                        out = make_data_constant(std::move(data));
+                        return true;
+                    }
+                    default:
+                        return false;
+                    }
+                }
+
+                bool decode_term(BitReader &reader, uint32_t &out, unsigned nesting)
+                {
+                    uint64_t tag = 0;
+                    if (nesting > kMaxDepth || !reader.bits(4, tag))
+                    {
+                        return false;
+                    }
+                    switch (static_cast<TermTag>(tag))
+                    {
+                    case TermTag::VAR:
+                    {
+                        uint64_t index = 0;
+                        if (!reader.natural(index))
+                        {
+                            return false;
+                        }
+                        out = add(TermTag::VAR, 0, 0, index);
+                        return true;
+                    }
+                    case TermTag::DELAY:
+                    case TermTag::LAMBDA:
+                    case TermTag::FORCE:
+                    {
+                        uint32_t body = 0;
+                        if (!decode_term(reader, body, nesting + 1))
+                        {
+                            return false;
+                        }
+                        out = add(static_cast<TermTag>(tag), body);
+                        return true;
+                    }
+                    case TermTag::APPLY:
+                    {
+                        uint32_t function = 0;
+                        uint32_t argument = 0;
+                        if (!decode_term(reader, function, nesting + 1) || !decode_term(reader, argument, nesting + 1))
+                        {
+                            return false;
+                        }
+                        out = add(TermTag::APPLY, function, argument);
+                        return true;
+                    }
+                    case TermTag::CONSTANT:
+                    {
+                        Type type;
+                        bool more = false;
+                        while (reader.bit(more) && more)
+                        {
+                            uint64_t type_tag = 0;
+                            if (!reader.bits(4, type_tag))
+                            {
+                                return false;
+                            }
+                            type.push_back(static_cast<uint8_t>(type_tag));
+                        }
+                        size_t pos = 0;
+                        ConstantPtr constant;
+                        if (more || !type_well_formed(type, pos) || pos != type.size() ||
+                            !decode_constant(reader, type, constant))
+                        {
+                            return false;
+                        }
+                        out = add_constant(std::move(constant));
+                        return true;
+                    }
+                    case TermTag::ERROR:
+                        out = add(TermTag::ERROR);
+                        return true;
+                    case TermTag::BUILTIN:
+                    {
+                        uint64_t function = 0;
+                        if (!reader.bits(7, function))
+                        {
+                            return false;
+                        }
+                        out = add(TermTag::BUILTIN, 0, 0, function);
+                        return true;
+                    }
+                    case TermTag::CONSTR:
+                    case TermTag::CASE:
+                    {
+                        uint64_t head = 0;
+                        uint32_t scrutinee = 0;
+                        if (tag == static_cast<uint64_t>(TermTag::CONSTR) ? !reader.natural(head)
+                                                                          : !decode_term(reader, scrutinee, nesting + 1))
+                        {
+                            return false;
+                        }
+                        std::vector<uint32_t> items;
+                        bool more = false;
+                        while (reader.bit(more) && more)
+                        {
+                            uint32_t item = 0;
+                            if (!decode_term(reader, item, nesting + 1))
+                            {
+                                return false;
+                            }
+                            items.push_back(item);
+                        }
+                        if (more)
+                        {
+                            return false;
+                        }
+                        const uint32_t offset = add_list(items);
+                        const uint32_t count = static_cast<uint32_t>(items.size());
+                        out = tag == static_cast<uint64_t>(TermTag::CONSTR)
+                                  ? add(TermTag::CONSTR, offset, count, head)
+                                  : add(TermTag::CASE, scrutinee, count, offset);
+                        return true;
+                    }
+                    default:
+                        return false;
+                    }
+                }
+
+                void encode_constant(BitWriter &writer, const Constant &constant) const
+                {
+                    if (is_list(constant.type))
+                    {
+                        for (const auto &item : constant.items)
+                        {
+                            writer.bit(true);
+                            encode_constant(writer, *item);
+                        }
+                        writer.bit(false);
+                        return;
+                    }
+                    if (is_pair(constant.type))
+                    {
+                        encode_constant(writer, *constant.items[0]);
+                        encode_constant(writer, *constant.items[1]);
+                        return;
+                    }
+                    switch (constant.type[0])
+                    {
+                    case kTypeInteger:
+                        writer.integer(constant.integer);
+                        break;
+                    case kTypeByteString:
+                    case kTypeString:
+                        writer.bytes(constant.bytes);
+                        break;
+                    case kTypeBool:
+                        writer.bit(constant.boolean);
+                        break;
+                    case kTypeData:
+                    {
+                        std::vector<uint8_t> encoded;
+                        encode_data(*constant.data, encoded);
+                        writer.bytes(std::string(encoded.begin(), encoded.end()));
+                    }
+                    break;
+                    default:
+                        break;
+                    }
+                }
+
+                void encode_term(BitWriter &writer, uint32_t index) const
+                {
+                    const Term &term = terms[index];
+                    writer.bits(4, static_cast<uint64_t>(term.tag));
+                    switch (term.tag)
+                    {
+                    case TermTag::VAR:
+                        writer.natural(term.value);
+                        break;
+                    case TermTag::DELAY:
+                    case TermTag::LAMBDA:
+                    case TermTag::FORCE:
+                        encode_term(writer, term.a);
+                        break;
+                    case TermTag::APPLY:
+                        encode_term(writer, term.a);
+                        encode_term(writer, term.b);
+                        break;
+                    case TermTag::CONSTANT:
+                    {
+                        const Constant &constant = *constants[term.a];
+                        for (uint8_t type_tag : constant.type)
+                        {
+                            writer.bit(true);
+                            writer.bits(4, type_tag);
+                        }
+                        writer.bit(false);
+                        encode_constant(writer, constant);
+                    }
+                    break;
+                    case TermTag::ERROR:
+                        break;
+                    case TermTag::BUILTIN:
+                        writer.bits(7, term.value);
+                        break;
+                    case TermTag::CONSTR:
+                    case TermTag::CASE:
+                    {
+                        uint64_t offset = term.a;
+                        if (term.tag == TermTag::CONSTR)
+                        {
+                            writer.natural(term.value);
+                        }
+                        else
+                        {
+                            encode_term(writer, term.a);
+                            offset = term.value;
+                        }
+                        for (uint32_t i = 0; i < term.b; ++i)
+                        {
+                            writer.bit(true);
+                            encode_term(writer, lists[offset + i]);
+                        }
+                        writer.bit(false);
+                    }
+                    break;
+                    }
+                }
+            };
+
+            Program::Program() : pimpl_(std::make_unique<Impl>()) {}
+            Program::~Program() = default;
+            Program::Program(Program &&other) noexcept = default;
+            Program &Program::operator=(Program &&other) noexcept = default;
+
+            uint32_t Program::var(uint32_t index) { return pimpl_->add(TermTag::VAR, 0, 0, index); }
+            uint32_t Program::lambda(uint32_t body) { return pimpl_->add(TermTag::LAMBDA, body); }
+            uint32_t Program::apply(uint32_t function, uint32_t argument) { return pimpl_->add(TermTag::APPLY, function, argument); }
+            uint32_t Program::delay(uint32_t term) { return pimpl_->add(TermTag::DELAY, term); }
+            uint32_t Program::force(uint32_t term) { return pimpl_->add(TermTag::FORCE, term); }
+            uint32_t Program::error() { return pimpl_->add(TermTag::ERROR); }
+            uint32_t Program::builtin(Builtin function) { return pimpl_->add(TermTag::BUILTIN, 0, 0, static_cast<uint64_t>(function)); }
+            uint32_t Program::integer(int64_t value) { return pimpl_->add_constant(make_integer(value)); }
+            uint32_t Program::bytestring(const std::vector<uint8_t> &value)
+            {
+                return pimpl_->add_constant(make_bytes(kByteString, std::string(value.begin(), value.end())));
+            }
+            uint32_t Program::boolean(bool value) { return pimpl_->add_constant(make_bool(value)); }
+            uint32_t Program::unit() { return pimpl_->add_constant(make_unit()); }
+            uint32_t Program::data(const PlutusData &value) { return pimpl_->add_constant(make_data_constant(to_data(value))); }
+
+            uint32_t Program::constr(uint64_t tag, const std::vector<uint32_t> &fields)
+            {
+                const uint32_t offset = pimpl_->add_list(fields);
+                return pimpl_->add(TermTag::CONSTR, offset, static_cast<uint32_t>(fields.size()), tag);
+            }
+
+            uint32_t Program::case_of(uint32_t scrutinee, const std::vector<uint32_t> &branches)
+            {
+                const uint32_t offset = pimpl_->add_list(branches);
+                return pimpl_->add(TermTag::CASE, scrutinee, static_cast<uint32_t>(branches.size()), offset);
+            }
+
+            void Program::set_root(uint32_t term)
+            {
+                pimpl_->root = term;
+                pimpl_->has_root = true;
+                pimpl_->validated = false;
+            }
+
+            void Program::set_version(uint32_t major, uint32_t minor, uint32_t patch)
+            {
+                pimpl_->major = major;
+                pimpl_->minor = minor;
+                pimpl_->patch = patch;
+                pimpl_->validated = false;
+            }
+
+            size_t Program::term_count() const
+            {
+                return pimpl_->terms.size();
+            }
+
+            bool Program::validate(std::string *error) const
+            {
+                if (pimpl_->validated)
+                {
+                    return true;
+                }
+                std::string message;
+                if (!pimpl_->has_root)
+                {
+                    message = "program has no body";
+                }
+                else if (pimpl_->major != 1 || pimpl_->minor > 1)
+                {
+                    message = "unsupported program version";
+                }
+                else if (pimpl_->check(pimpl_->root, 0, 0, message))
+                {
+                    pimpl_->validated = true;
+                    return true;
+                }
+                if (error)
+                {
+                    *error = message.empty() ? "malformed program" : message;
+                }
+                return false;
+            }
+
+            bool decode_script(const uint8_t *data, size_t length, Program &program, std::string *error)
+            {
+                // Peel at most two CBOR byte-string wrappers (cborHex as printed by the CLI is double wrapped)
+                for (int wrap = 0; wrap < 2 && length > 0 && (data[0] >> 5) == 2; ++wrap)
+                {
+                    const uint8_t extra = data[0] & 0x1f;
+                    size_t header = 1;
+                    uint64_t size = extra;
+                    if (extra >= 24 && extra <= 27)
+                    {
+                        header += size_t(1) << (extra - 24);
+                        if (length < header)
+                        {
+                            break;
+                        }
+                        size = 0;
+                        for (size_t i = 1; i < header; ++i)
+                        {
+                            size = (size << 8) | data[i];
+                        }
+                    }
+                    else if (extra > 27)
+                    {
+                        break;
+                    }
+                    if (header + size != length)
+                    {
+                        break;
+                    }
+                    data += header;
+                    length = static_cast<size_t>(size);
+                }
+
+                Program decoded;
+                Program::Impl &impl = *decoded.pimpl_;
+                BitReader reader(data, length);
+                uint64_t major = 0;
+                uint64_t minor = 0;
+                uint64_t patch = 0;
+                uint32_t root = 0;
+                if (!reader.natural(major) || !reader.natural(minor) || !reader.natural(patch) ||
+                    major > std::numeric_limits<uint32_t>::max() || minor > std::numeric_limits<uint32_t>::max() ||
+                    patch > std::numeric_limits<uint32_t>::max())
+                {
+                    if (error)
+                    {
+                        *error = "bad program version";
+                    }
+                    return false;
+                }
+                decoded.set_version(static_cast<uint32_t>(major), static_cast<uint32_t>(minor),
+                                    static_cast<uint32_t>(patch));
+                if (!impl.decode_term(reader, root, 0) || !reader.filler() || !reader.at_end())
+                {
+                    if (error)
+                    {
+                        *error = "malformed flat encoding";
+                    }
+                    return false;
+                }
+                decoded.set_root(root);
+                if (!decoded.validate(error))
+                {
+                    return false;
+                }
+                program = std::move(decoded);
+                return true;
+            }
+
+            std::vector<uint8_t> encode_script(const Program &program)
+            {
+                const Program::Impl &impl = program.impl();
+                BitWriter writer;
+                writer.natural(impl.major);
+                writer.natural(impl.minor);
+                writer.natural(impl.patch);
+                if (impl.has_root)
+                {
+                    impl.encode_term(writer, impl.root);
+                }
+                writer.filler();
+                const std::vector<uint8_t> flat = writer.take();
+
+                std::vector<uint8_t> out;
+                cbor_head(out, 2, flat.size());
+                out.insert(out.end(), flat.begin(), flat.end());
+                return out;
+            }
+
+            // ---- CEK machine ----
+
+            namespace
+            {
+                struct Value;
+                using ValuePtr = std::shared_ptr<const Value>;
+                struct Env;
+                using EnvPtr = std::shared_ptr<const Env>;
+
+                struct Env
+                {
+                    ValuePtr value;
+                    EnvPtr next;
+                };
+
+                struct Value
+                {
+                    enum Kind : uint8_t
+                    {
+                        CONSTANT,
+                        DELAY,
+                        LAMBDA,
+                        BUILTIN,
+                        CONSTR
+                    };
+
+                    Kind kind = CONSTANT;
+                    uint32_t term = 0; // body of a delay or lambda
+                    EnvPtr env;
+                    ConstantPtr constant;
+                    Builtin function = Builtin::ADD_INTEGER;
+                    uint8_t forces = 0;
+                    uint64_t tag = 0;
+                    std::vector<ValuePtr> args; // builtin arguments so far, or constructor fields
+                };
+
+                ValuePtr constant_value(ConstantPtr constant)
+                {
+                    auto value = std::make_shared<Value>();
+                    value->constant = std::move(constant);
+                    return value;
+                }
+
+                struct Frame
+                {
+                    enum Kind : uint8_t
+                    {
+                        ARG_TERM,  // [_ term]: evaluate the argument next
+                        FUN_VALUE, // [value _]: apply value to what returns
+                        ARG_VALUE, // [_ value]: apply what returns to value
+                        FORCE,
+                        CONSTR,
+                        CASE
+                    };
+
+                    explicit Frame(Kind kind) : kind(kind) {}
+
+                    Kind kind;
+                    uint32_t term = 0;
+                    EnvPtr env;
+                    ValuePtr value;
+                    uint32_t next = 0;
+                    std::vector<ValuePtr> values;
+                };
+
+                class Machine
+                {
+                public:
+                    Machine(const Program::Impl &program, const ExBudget &limit) : program_(program), limit_(limit) {}
+
+                    ExBudget consumed;
+                    std::vector<std::string> logs;
+                    std::string error;
+
+                    bool run(const std::vector<ConstantPtr> &arguments, ValuePtr &result)
+                    {
+                        if (!spend(kStartupCpu, kStartupMemory))
+                        {
+                            return false;
+                        }
+                        // The ledger applies the script to argument terms; charge their apply and constant steps
+                        for (auto it = arguments.rbegin(); it != arguments.rend(); ++it)
+                        {
+                            if (!spend(2 * kStepCpu, 2 * kStepMemory))
+                            {
+                                return false;
+                            }
+                            Frame frame(Frame::ARG_VALUE);
+                            frame.value = constant_value(*it);
+                            frames_.push_back(std::move(frame));
+                        }
+
+                        term_ = program_.root;
+                        computing_ = true;
+                        for (;;)
+                        {
+                            if (computing_)
+                            {
+                                if (!compute())
+                                {
+                                    return false;
+                                }
+                                continue;
+                            }
+                            if (frames_.empty())
+                            {
+                                result = std::move(value_);
+                                return true;
+                            }
+                            if (!return_to_frame())
+                            {
+                                return false;
+                            }
+                        }
+                    }
+
+                private:
+                    using Term = Program::Impl::Term;
+
+                    const Program::Impl &program_;
+                    ExBudget limit_;
+                    std::vector<Frame> frames_;
+
+                    bool computing_ = true;
+                    uint32_t term_ = 0;
+                    EnvPtr env_;
+                    ValuePtr value_;
+
+                    bool spend(uint64_t cpu, uint64_t memory)
+                    {
+                        consumed.cpu += cpu;
+                        consumed.memory += memory;
+                        if (consumed.cpu > limit_.cpu || consumed.memory > limit_.memory)
+                        {
+                            error = "execution budget exceeded";
+                            return false;
+                        }
+                        return true;
+                    }
+
+                    bool fail(const std::string &message)
+                    {
+                        error = message;
+                        return false;
+                    }
+
+                    void produce(ValuePtr value)
+                    {
+                        value_ = std::move(value);
+                        computing_ = false;
+                    }
+
+                    bool compute()
+                    {
+                        const Term &term = program_.terms[term_];
+                        if (!spend(kStepCpu, kStepMemory))
+                        {
+                            return false;
+                        }
+                        switch (term.tag)
+                        {
+                        case TermTag::VAR:
+                        {
+                            const Env *env = env_.get();
+                            for (uint64_t i = 1; env && i < term.value; ++i)
+                            {
+                                env = env->next.get();
+                            }
+                            if (!env)
+                            {
+                                return fail("unbound variable");
+                            }
+                            produce(env->value);
+                            return true;
+                        }
+                        case TermTag::DELAY:
+                        case TermTag::LAMBDA:
+                        {
+                            auto value = std::make_shared<Value>();
+                            value->kind = term.tag == TermTag::DELAY ? Value::DELAY : Value::LAMBDA;
+                            value->term = term.a;
+                            value->env = env_;
+                            produce(std::move(value));
+                            return true;
+                        }
+                        case TermTag::APPLY:
+                        {
+                            Frame frame(Frame::ARG_TERM);
+                            frame.term = term.b;
+                            frame.env = env_;
+                            frames_.push_back(std::move(frame));
+                            term_ = term.a;
+                            return true;
+                        }
+                        case TermTag::CONSTANT:
+                            produce(constant_value(program_.constants[term.a]));
+                            return true;
+                        case TermTag::FORCE:
+                            frames_.emplace_back(Frame::FORCE);
+                            term_ = term.a;
+                            return true;
+                        case TermTag::ERROR:
+                            return fail("error term evaluated");
+                        case TermTag::BUILTIN:
+                        {
+                            auto value = std::make_shared<Value>();
+                            value->kind = Value::BUILTIN;
+                            value->function = static_cast<Builtin>(term.value);
+                            produce(std::move(value));
+                            return true;
+                        }
+                        case TermTag::CONSTR:
+                        {
+                            if (term.b == 0)
+                            {
+                                auto value = std::make_shared<Value>();
+                                value->kind = Value::CONSTR;
+                                value->tag = term.value;
+                                produce(std::move(value));
+                                return true;
+                            }
+                            Frame frame(Frame::CONSTR);
+                            frame.term = term_;
+                            frame.env = env_;
+                            frame.next = 1;
+                            frames_.push_back(std::move(frame));
+                            term_ = program_.lists[term.a];
+                            return true;
+                        }
+                        case TermTag::CASE:
+                        {
+                            Frame frame(Frame::CASE);
+                            frame.term = term_;
+                            frame.env = env_;
+                            frames_.push_back(std::move(frame));
+                            term_ = term.a;
+                            return true;
+                        }
+                        }
+                        return fail("malformed term");
+                    }
+
+                    bool return_to_frame()
+                    {
+                        Frame frame = std::move(frames_.back());
+                        frames_.pop_back();
+                        switch (frame.kind)
+                        {
+                        case Frame::ARG_TERM:
+                        {
+                            Frame next(Frame::FUN_VALUE);
+                            next.value = std::move(value_);
+                            frames_.push_back(std::move(next));
+                            term_ = frame.term;
+                            env_ = std::move(frame.env);
+                            computing_ = true;
+                            return true;
+                        }
+                        case Frame::FUN_VALUE:
+                            return apply(frame.value, std::move(value_));
+                        case Frame::ARG_VALUE:
+                        {
+                            ValuePtr function = std::move(value_);
+                            return apply(function, std::move(frame.value));
+                        }
+                        case Frame::FORCE:
+                            return force(value_);
+                        case Frame::CONSTR:
+                        {
+                            const Term &term = program_.terms[frame.term];
+                            frame.values.push_back(std::move(value_));
+                            if (frame.next < term.b)
+                            {
+                                term_ = program_.lists[term.a + frame.next];
+                                env_ = frame.env;
+                                computing_ = true;
+                                frame.next++;
+                                frames_.push_back(std::move(frame));
+                                return true;
+                            }
+                            auto value = std::make_shared<Value>();
+                            value->kind = Value::CONSTR;
+                            value->tag = term.value;
+                            value->args = std::move(frame.values);
+                            produce(std::move(value));
+                            return true;
+                        }
+                        case Frame::CASE:
+                        {
+                            const Term &term = program_.terms[frame.term];
+                            if (value_->kind != Value::CONSTR)
+                            {
+                                return fail("case on a non-constructor");
+                            }
+                            if (value_->tag >= term.b)
+                            {
+                                return fail("no case branch for constructor");
+                            }
+                            for (auto it = value_->args.rbegin(); it != value_->args.rend(); ++it)
+                            {
+                                Frame next(Frame::ARG_VALUE);
+                                next.value = *it;
+                                frames_.push_back(std::move(next));
+                            }
+                            term_ = program_.lists[term.value + value_->tag];
+                            env_ = std::move(frame.env);
+                            computing_ = true;
+                            return true;
+                        }
+                        }
+                        return fail("malformed frame");
+                    }
+
+                    bool apply(const ValuePtr &function, ValuePtr argument)
+                    {
+                        if (function->kind == Value::LAMBDA)
+                        {
+                            env_ = std::make_shared<Env>(Env{std::move(argument), function->env});
+                            term_ = function->term;
+                            computing_ = true;
+                            return true;
+                        }
+                        if (function->kind != Value::BUILTIN)
+                        {
+                            return fail("application of a non-function");
+                        }
+                        const BuiltinInfo &builtin = info(function->function);
+                        if (function->forces != builtin.forces || function->args.size() >= builtin.arity)
+                        {
+                            return fail("builtin applied out of order");
+                        }
+                        auto partial = std::make_shared<Value>(*function);
+                        partial->args.push_back(std::move(argument));
+                        if (partial->args.size() < builtin.arity)
+                        {
+                            produce(std::move(partial));
+                            return true;
+                        }
+                        return call(*partial);
+                    }
+
+                    bool force(const ValuePtr &value)
+                    {
+                        if (value->kind == Value::DELAY)
+                        {
+                            term_ = value->term;
+                            env_ = value->env;
+                            computing_ = true;
+                            return true;
+                        }
+                        if (value->kind == Value::BUILTIN && value->forces < info(value->function).forces &&
+                            value->args.empty())
+                        {
+                            auto forced = std::make_shared<Value>(*value);
+                            forced->forces++;
+                            produce(std::move(forced));
+                            return true;
+                        }
+                        return fail("force of a non-delayed value");
+                    }
+
+                    const Constant *constant_of(const ValuePtr &value, uint8_t type) const
+                    {
+                        if (value->kind != Value::CONSTANT || value->constant->type.size() != 1 ||
+                            value->constant->type[0] != type)
+                        {
+                            return nullptr;
+                        }
+                        return value->constant.get();
+                    }
+
+                    const Constant *list_of(const ValuePtr &value) const
+                    {
+                        return value->kind == Value::CONSTANT && is_list(value->constant->type) ? value->constant.get()
+                                                                                                 : nullptr;
+                    }
+
+                    const Constant *pair_of(const ValuePtr &value) const
+                    {
+                        return value->kind == Value::CONSTANT && is_pair(value->constant->type) ? value->constant.get()
+                                                                                                 : nullptr;
+                    }
+
+                    bool charge(const Value &call_value)
+                    {
+                        const BuiltinInfo &builtin = info(call_value.function);
+                        uint64_t size = 0;
+                        if (builtin.cpu_slope || builtin.memory_slope)
+                        {
+                            for (const auto &arg : call_value.args)
+                            {
+                                size += arg->kind == Value::CONSTANT ? constant_size(*arg->constant) : 1;
+                            }
+                        }
+                        return spend(builtin.cpu_base + builtin.cpu_slope * size,
+                                     builtin.memory_base + builtin.memory_slope * size);
+                    }
+
+                    bool integer_result(bool ok, int64_t value)
+                    {
+                        if (!ok)
+                        {
+                            return fail("integer overflow or division by zero");
+                        }
+                        produce(constant_value(make_integer(value)));
+                        return true;
+                    }
+
+                    void bool_result(bool value)
+                    {
+                        produce(constant_value(make_bool(value)));
+                    }
+
+                    bool call(const Value &call_value)
+                    {
+                        if (!charge(call_value))
+                        {
+                            return false;
+                        }
+                        const auto &args = call_value.args;
+                        const Builtin function = call_value.function;
+
+                        switch (function)
+                        {
+                        case Builtin::ADD_INTEGER:
+                        case Builtin::SUBTRACT_INTEGER:
+                        case Builtin::MULTIPLY_INTEGER:
+                        case Builtin::DIVIDE_INTEGER:
+                        case Builtin::QUOTIENT_INTEGER:
+                        case Builtin::REMAINDER_INTEGER:
+                        case Builtin::MOD_INTEGER:
+                        case Builtin::EQUALS_INTEGER:
+                        case Builtin::LESS_THAN_INTEGER:
+                        case Builtin::LESS_THAN_EQUALS_INTEGER:
+                        {
+                            const Constant *x = constant_of(args[0], kTypeInteger);
+                            const Constant *y = constant_of(args[1], kTypeInteger);
+                            if (!x || !y)
+                            {
+                                return fail("integer builtin on a non-integer");
+                            }
+                            return integer_op(function, x->integer, y->integer);
+                        }
+
+                        case Builtin::APPEND_BYTESTRING:
+                        case Builtin::EQUALS_BYTESTRING:
+                        case Builtin::LESS_THAN_BYTESTRING:
+                        case Builtin::LESS_THAN_EQUALS_BYTESTRING:
+                        case Builtin::APPEND_STRING:
+                        case Builtin::EQUALS_STRING:
+                        {
+                            const bool text = function == Builtin::APPEND_STRING || function == Builtin::EQUALS_STRING;
+                            const Constant *x = constant_of(args[0], text ? kTypeString : kTypeByteString);
+                            const Constant *y = constant_of(args[1], text ? kTypeString : kTypeByteString);
+                            if (!x || !y)
+                            {
+                                return fail("byte string builtin on the wrong type");
+                            }
+                            const int order = x->bytes.compare(y->bytes);
+                            if (function == Builtin::APPEND_BYTESTRING || function == Builtin::APPEND_STRING)
+                            {
+                                produce(constant_value(make_bytes(x->type, x->bytes + y->bytes)));
+                            }
+                            else
+                            {
+                                bool_result(function == Builtin::LESS_THAN_BYTESTRING        ? order < 0
+                                            : function == Builtin::LESS_THAN_EQUALS_BYTESTRING ? order <= 0
+                                                                                               : order == 0);
+                            }
+                            return true;
+                        }
+
+                        case Builtin::CONS_BYTESTRING:
+                        {
+                            const Constant *n = constant_of(args[0], kTypeInteger);
+                            const Constant *bytes = constant_of(args[1], kTypeByteString);
+                            if (!n || !bytes)
+                            {
+                                return fail("consByteString on the wrong type");
+                            }
+                            const char byte = static_cast<char>(((n->integer % 256) + 256) % 256);
+                            produce(constant_value(make_bytes(kByteString, byte + bytes->bytes)));
+                            return true;
+                        }
+                        case Builtin::SLICE_BYTESTRING:
+                        {
+                            const Constant *start = constant_of(args[0], kTypeInteger);
+                            const Constant *count = constant_of(args[1], kTypeInteger);
+                            const Constant *bytes = constant_of(args[2], kTypeByteString);
+                            if (!start || !count || !bytes)
+                            {
+                                return fail("sliceByteString on the wrong type");
+                            }
+                            const int64_t size = static_cast<int64_t>(bytes->bytes.size());
+                            const int64_t from = std::clamp<int64_t>(start->integer, 0, size);
+                            const int64_t length = std::clamp<int64_t>(count->integer, 0, size - from);
+                            produce(constant_value(make_bytes(kByteString, bytes->bytes.substr(from, length))));
+                            return true;
+                        }
+                        case Builtin::LENGTH_OF_BYTESTRING:
+                        {
+                            const Constant *bytes = constant_of(args[0], kTypeByteString);
+                            if (!bytes)
+                            {
+                                return fail("lengthOfByteString on the wrong type");
+                            }
+                            return integer_result(true, static_cast<int64_t>(bytes->bytes.size()));
+                        }
+                        case Builtin::INDEX_BYTESTRING:
+                        {
+                            const Constant *bytes = constant_of(args[0], kTypeByteString);
+                            const Constant *index = constant_of(args[1], kTypeInteger);
+                            if (!bytes || !index || index->integer < 0 ||
+                                index->integer >= static_cast<int64_t>(bytes->bytes.size()))
+                            {
+                                return fail("indexByteString out of range");
+                            }
+                            return integer_result(true, static_cast<unsigned char>(bytes->bytes[index->integer]));
+                        }
+                        case Builtin::SHA2_256:
+                        {
+                            const Constant *bytes = constant_of(args[0], kTypeByteString);
+                            if (!bytes)
+                            {
+                                return fail("sha2_256 on the wrong type");
+                            }
+                            const auto digest = utils::Hasher::digest(utils::HashAlgorithm::SHA256, bytes->bytes.data(),
+                                                                      bytes->bytes.size());
+                            produce(constant_value(make_bytes(kByteString, std::string(digest.begin(), digest.end()))));
+                            return true;
+                        }
+                        case Builtin::SHA3_256:
+                        case Builtin::BLAKE2B_256:
+                        {
+                            const Constant *bytes = constant_of(args[0], kTypeByteString);
+                            if (!bytes)
+                            {
+                                return fail("hash builtin on the wrong type");
+                            }
+                            const auto algorithm = function == Builtin::SHA3_256 ? utils::HashAlgorithm::SHA3_256
+                                                                                 : utils::HashAlgorithm::BLAKE2B_256;
+                            const auto digest = utils::Hasher::digest(algorithm, bytes->bytes.data(), bytes->bytes.size());
+                            if (digest.empty())
+                            {
+                                return fail("hash builtin failed");
+                            }
+                            produce(constant_value(make_bytes(kByteString, std::string(digest.begin(), digest.end()))));
+                            return true;
+                        }
+                        case Builtin::VERIFY_ED25519_SIGNATURE:
+                        {
+                            const Constant *key = constant_of(args[0], kTypeByteString);
+                            const Constant *message = constant_of(args[1], kTypeByteString);
+                            const Constant *signature = constant_of(args[2], kTypeByteString);
+                            if (!key || !message || !signature || key->bytes.size() != ED25519_KEY_BYTES ||
+                                signature->bytes.size() != ED25519_SIGNATURE_BYTES)
+                            {
+                                return fail("verifyEd25519Signature on a malformed key or signature");
+                            }
+                            bool_result(verify_ed25519(key->bytes, message->bytes, signature->bytes));
+                            return true;
+                        }
+
+                        case Builtin::ENCODE_UTF8:
+                        case Builtin::DECODE_UTF8:
+                        {
+                            const bool encode = function == Builtin::ENCODE_UTF8;
+                            const Constant *text = constant_of(args[0], encode ? kTypeString : kTypeByteString);
+                            if (!text || (!encode && !valid_utf8(text->bytes)))
+                            {
+                                return fail("invalid UTF-8 conversion");
+                            }
+                            produce(constant_value(make_bytes(encode ? kByteString : kString, text->bytes)));
+                            return true;
+                        }
+
+                        case Builtin::IF_THEN_ELSE:
+                        {
+                            const Constant *condition = constant_of(args[0], kTypeBool);
+                            if (!condition)
+                            {
+                                return fail("ifThenElse on a non-boolean");
+                            }
+                            produce(condition->boolean ? args[1] : args[2]);
+                            return true;
+                        }
+                        case Builtin::CHOOSE_UNIT:
+                            if (!constant_of(args[0], kTypeUnit))
+                            {
+                                return fail("chooseUnit on a non-unit");
+                            }
+                            produce(args[1]);
+                            return true;
+                        case Builtin::TRACE:
+                        {
+                            const Constant *message = constant_of(args[0], kTypeString);
+                            if (!message)
+                            {
+                                return fail("trace of a non-string");
+                            }
+                            logs.push_back(message->bytes);
+                            produce(args[1]);
+                            return true;
+                        }
+
+                        case Builtin::FST_PAIR:
+                        case Builtin::SND_PAIR:
+                        {
+                            const Constant *pair = pair_of(args[0]);
+                            if (!pair)
+                            {
+                                return fail("pair builtin on a non-pair");
+                            }
+                            produce(constant_value(pair->items[function == Builtin::FST_PAIR ? 0 : 1]));
+                            return true;
+                        }
+
+                        case Builtin::CHOOSE_LIST:
+                        case Builtin::HEAD_LIST:
+                        case Builtin::TAIL_LIST:
+                        case Builtin::NULL_LIST:
+                        {
+                            const Constant *list = list_of(args[0]);
+                            if (!list)
+                            {
+                                return fail("list builtin on a non-list");
+                            }
+                            if (function == Builtin::CHOOSE_LIST)
+                            {
+                                produce(list->items.empty() ? args[1] : args[2]);
+                            }
+                            else if (function == Builtin::NULL_LIST)
+                            {
+                                bool_result(list->items.empty());
+                            }
+                            else if (list->items.empty())
+                            {
+                                return fail("headList/tailList of an empty list");
+                            }
+                            else if (function == Builtin::HEAD_LIST)
+                            {
+                                produce(constant_value(list->items.front()));
+                            }
+                            else
+                            {
+                                produce(constant_value(make_sequence(
+                                    list->type, std::vector<ConstantPtr>(list->items.begin() + 1, list->items.end()))));
+                            }
+                            return true;
+                        }
+                        case Builtin::MK_CONS:
+                        {
+                            const Constant *list = list_of(args[1]);
+                            if (!list || args[0]->kind != Value::CONSTANT ||
+                                args[0]->constant->type != element_type(list->type))
+                            {
+                                return fail("mkCons element does not match the list");
+                            }
+                            std::vector<ConstantPtr> items;
+                            items.reserve(list->items.size() + 1);
+                            items.push_back(args[0]->constant);
+                            items.insert(items.end(), list->items.begin(), list->items.end());
+                            produce(constant_value(make_sequence(list->type, std::move(items))));
+                            return true;
+                        }
+
+                        case Builtin::CHOOSE_DATA:
+                        {
+                            const Constant *data = constant_of(args[0], kTypeData);
+                            if (!data)
+                            {
+                                return fail("chooseData on a non-data value");
+                            }
+                            produce(args[1 + static_cast<size_t>(data->data->kind)]);
+                            return true;
+                        }
+                        case Builtin::CONSTR_DATA:
+                        {
+                            const Constant *tag = constant_of(args[0], kTypeInteger);
+                            const Constant *fields = list_of(args[1]);
+                            if (!tag || tag->integer < 0 || !fields || fields->type != kListData)
+                            {
+                                return fail("constrData on the wrong type");
+                            }
+                            auto data = std::make_shared<Data>();
+                            data->kind = Data::CONSTR;
+                            data->integer = tag->integer;
+                            for (const auto &field : fields->items)
+                            {
+                                data->items.push_back(field->data);
+                            }
+                            produce(constant_value(make_data_constant(std::move(data))));
+                            return true;
+                        }
+                        case Builtin::MAP_DATA:
+                        case Builtin::LIST_DATA:
+                        {
+                            const bool map = function == Builtin::MAP_DATA;
+                            const Constant *list = list_of(args[0]);
+                            if (!list || list->type != (map ? kListPairData : kListData))
+                            {
+                                return fail("mapData/listData on the wrong type");
+                            }
+                            auto data = std::make_shared<Data>();
+                            data->kind = map ? Data::MAP : Data::LIST;
+                            for (const auto &item : list->items)
+                            {
+                                if (map)
+                                {
+                                    data->items.push_back(item->items[0]->data);
+                                    data->items.push_back(item->items[1]->data);
+                                }
+                                else
+                                {
+                                    data->items.push_back(item->data);
+                                }
+                            }
+                            produce(constant_value(make_data_constant(std::move(data))));
+                            return true;
+                        }
+                        case Builtin::I_DATA:
+                        {
+                            const Constant *value = constant_of(args[0], kTypeInteger);
+                            if (!value)
+                            {
+                                return fail("iData on a non-integer");
+                            }
+                            produce(constant_value(make_data_constant(make_data(Data::INTEGER, value->integer))));
+                            return true;
+                        }
+                        case Builtin::B_DATA:
+                        {
+                            const Constant *value = constant_of(args[0], kTypeByteString);
+                            if (!value)
+                            {
+                                return fail("bData on a non-bytestring");
+                            }
+                            auto data = std::make_shared<Data>();
+                            data->kind = Data::BYTES;
+                            data->bytes = value->bytes;
+                            produce(constant_value(make_data_constant(std::move(data))));
+                            return true;
+                        }
+                        case Builtin::UN_CONSTR_DATA:
+                        case Builtin::UN_MAP_DATA:
+                        case Builtin::UN_LIST_DATA:
+                        case Builtin::UN_I_DATA:
+                        case Builtin::UN_B_DATA:
+                            return destructure(function, args[0]);
+                        case Builtin::EQUALS_DATA:
+                        {
+                            const Constant *x = constant_of(args[0], kTypeData);
+                            const Constant *y = constant_of(args[1], kTypeData);
+                            if (!x || !y)
+                            {
+                                return fail("equalsData on a non-data value");
+                            }
+                            bool_result(data_equal(*x->data, *y->data));
+                            return true;
+                        }
+                        case Builtin::MK_PAIR_DATA:
+                        {
+                            const Constant *x = constant_of(args[0], kTypeData);
+                            const Constant *y = constant_of(args[1], kTypeData);
+                            if (!x || !y)
+                            {
+                                return fail("mkPairData on a non-data value");
+                            }
+                            produce(constant_value(make_sequence(kPairData, {args[0]->constant, args[1]->constant})));
+                            return true;
+                        }
+                        case Builtin::MK_NIL_DATA:
+                        case Builtin::MK_NIL_PAIR_DATA:
+                            if (!constant_of(args[0], kTypeUnit))
+                            {
+                                return fail("mkNil on a non-unit");
+                            }
+                            produce(constant_value(make_sequence(
+                                function == Builtin::MK_NIL_DATA ? kListData : kListPairData, {})));
+                            return true;
+                        case Builtin::SERIALISE_DATA:
+                        {
+                            const Constant *data = constant_of(args[0], kTypeData);
+                            if (!data)
+                            {
+                                return fail("serialiseData on a non-data value");
+                            }
+                            std::vector<uint8_t> encoded;
+                            encode_data(*data->data, encoded);
+                            produce(constant_value(make_bytes(kByteString, std::string(encoded.begin(), encoded.end()))));
+                            return true;
+                        }
+                        default:
+                            return fail("unknown builtin");
+                        }
+                    }
+
+                    bool integer_op(Builtin function, int64_t x, int64_t y)
+                    {
+                        int64_t result = 0;
+                        bool overflow = false;
+                        switch (function)
+                        {
+                        case Builtin::ADD_INTEGER:
+                            overflow = __builtin_add_overflow(x, y, &result);
+                            return integer_result(!overflow, result);
+                        case Builtin::SUBTRACT_INTEGER:
+                            overflow = __builtin_sub_overflow(x, y, &result);
+                            return integer_result(!overflow, result);
+                        case Builtin::MULTIPLY_INTEGER:
+                            overflow = __builtin_mul_overflow(x, y, &result);
+                            return integer_result(!overflow, result);
+                        case Builtin::DIVIDE_INTEGER:
+                        case Builtin::QUOTIENT_INTEGER:
+                        case Builtin::REMAINDER_INTEGER:
+                        case Builtin::MOD_INTEGER:
+                        {
+                            if (y == 0)
+                            {
+                                return integer_result(false, 0);
+                            }
+                            if (y == -1)
+                            {
+                                // x / -1 is the only quotient that can overflow; every remainder is 0
+                                const bool quotient = function == Builtin::DIVIDE_INTEGER ||
+                                                      function == Builtin::QUOTIENT_INTEGER;
+                                overflow = quotient && __builtin_sub_overflow(int64_t(0), x, &result);
+                                return integer_result(!overflow, result);
+                            }
+                            int64_t quotient = x / y;
+                            int64_t remainder = x % y;
+                            if (remainder != 0 && ((remainder < 0) != (y < 0)))
+                            {
+                                // Floor towards negative infinity for divide/mod
+                                if (function == Builtin::DIVIDE_INTEGER)
+                                {
+                                    quotient -= 1;
+                                }
+                                else if (function == Builtin::MOD_INTEGER)
+                                {
+                                    remainder += y;
+                                }
+                            }
+                            const bool wants_quotient = function == Builtin::DIVIDE_INTEGER ||
+                                                        function == Builtin::QUOTIENT_INTEGER;
+                            return integer_result(true, wants_quotient ? quotient : remainder);
+                        }
+                        case Builtin::EQUALS_INTEGER:
+                            bool_result(x == y);
+                            return true;
+                        case Builtin::LESS_THAN_INTEGER:
+                            bool_result(x < y);
+                            return true;
+                        case Builtin::LESS_THAN_EQUALS_INTEGER:
+                            bool_result(x <= y);
+                            return true;
+                        default:
+                            return fail("unknown integer builtin");
+                        }
+                    }
+
+                    bool destructure(Builtin function, const ValuePtr &argument)
+                    {
+                        const Constant *constant = constant_of(argument, kTypeData);
+                        if (!constant)
+                        {
+                            return fail("data builtin on a non-data value");
+                        }
+                        const Data &data = *constant->data;
+                        switch (function)
+                        {
+                        case Builtin::UN_CONSTR_DATA:
+                            if (data.kind != Data::CONSTR)
+                            {
+                                return fail("unConstrData of a non-constructor");
+                            }
+                            produce(constant_value(make_sequence(kPairIntegerListData,
+                                                                 {make_integer(data.integer), make_data_list(data.items)})));
+                            return true;
+                        case Builtin::UN_MAP_DATA:
+                        {
+                            if (data.kind != Data::MAP)
+                            {
+                                return fail("unMapData of a non-map");
+                            }
+                            std::vector<ConstantPtr> entries;
+                            for (size_t i = 0; i + 1 < data.items.size(); i += 2)
+                            {
+                                entries.push_back(make_sequence(kPairData, {make_data_constant(data.items[i]),
+                                                                            make_data_constant(data.items[i + 1])}));
+                            }
+                            produce(constant_value(make_sequence(kListPairData, std::move(entries))));
+                            return true;
+                        }
+                        case Builtin::UN_LIST_DATA:
+                            if (data.kind != Data::LIST)
+                            {
+                                return fail("unListData of a non-list");
+                            }
+                            produce(constant_value(make_data_list(data.items)));
+                            return true;
+                        case Builtin::UN_I_DATA:
+                            if (data.kind != Data::INTEGER)
+                            {
+                                return fail("unIData of a non-integer");
+                            }
+                            return integer_result(true, data.integer);
+                        case Builtin::UN_B_DATA:
+                            if (data.kind != Data::BYTES)
+                            {
+                                return fail("unBData of a non-bytestring");
+                            }
+                            produce(constant_value(make_bytes(kByteString, data.bytes)));
+                            return true;
+                        default:
+                            return fail("unknown data builtin");
+                        }
+                    }
+                };
+
+                PlutusData value_to_plutus(const Value &value)
+                {
+                    if (value.kind == Value::CONSTANT)
+                    {
+                        return constant_to_plutus(*value.constant);
+                    }
+                    if (value.kind == Value::CONSTR)
+                    {
+                        PlutusData out;
+                        out.type = PlutusDataType::CONSTRUCTOR;
+                        std::vector<std::shared_ptr<PlutusData>> fields;
+                        for (const auto &field : value.args)
+                        {
+                            fields.push_back(std::make_shared<PlutusData>(value_to_plutus(*field)));
+                        }
+                        out.value = std::make_pair(value.tag, std::move(fields));
+                        return out;
+                    }
+                    return PlutusData();
+                }
+            } // namespace
+
+            std::vector<uint8_t> serialise_data(const PlutusData &value)
+            {
+                thread_local PlutusDataArena arena;
+                arena.clear();
+                std::vector<uint8_t> out;
+                arena.encode(arena.import(value), out);
+                return out;
+            }
+
+            EvalResult evaluate(const Program &program, const std::vector<PlutusData> &arguments,
+                                const ExBudget &limit)
+            {
+                EvalResult result;
+                if (!program.validate(&result.error_message))
+                {
+                    return result;
+                }
+
+                std::vector<ConstantPtr> constants;
+                constants.reserve(arguments.size());
+                for (const auto &argument : arguments)
+                {
+                    constants.push_back(make_data_constant(to_data(argument)));
+                }
+
+                Machine machine(program.impl(), limit);
+                ValuePtr value;
+                result.success = machine.run(constants, value);
+                result.consumed = machine.consumed;
+                result.logs = std::move(machine.logs);
+                if (result.success)
+                {
+                    result.value = value_to_plutus(*value);
+                }
+                else
+                {
+                    result.error_message = machine.error;
+                }
+                return result;
+            }
+
+        } // namespace uplc
+    } // namespace core
+} // namespace cardano_iot
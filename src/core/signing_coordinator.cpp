@@ -0,0 +1,318 @@
+#include "cardano_iot/core/signing_coordinator.h"
+#include "cardano_iot/core/transaction_manager.h"
+#include "cardano_iot/network/p2p_network.h"
+#include "cardano_iot/utils/logger.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+
+namespace cardano_iot
+{
+    namespace core
+    {
+        namespace
+        {
+            constexpr size_t VKEY_HEX = 64; // A vkey witness starts with the hex verification key
+
+            bool is_vkey(const std::string &key)
+            {
+                return key.size() == VKEY_HEX && std::all_of(key.begin(), key.end(), [](char c)
+                                                             { return std::isxdigit(static_cast<unsigned char>(c)); });
+            }
+
+            uint64_t now_seconds()
+            {
+                return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::seconds>(
+                                                 std::chrono::system_clock::now().time_since_epoch())
+                                                 .count());
+            }
+
+            network::NetworkMessage make_message(network::MessageType type, const std::string &id,
+                                                 const std::string &sender, const std::string &recipient,
+                                                 const std::string &payload)
+            {
+                network::NetworkMessage message;
+                message.message_id = id;
+                message.type = type;
+                message.sender_id = sender;
+                message.recipient_id = recipient;
+                message.payload.assign(payload.begin(), payload.end());
+                message.timestamp = now_seconds();
+                message.encrypted = false;
+                return message;
+            }
+        } // namespace
+
+        struct SigningCoordinator::Impl
+        {
+            // One collect() call; responses are queued here until the collecting thread verifies them
+            struct Session
+            {
+                std::mutex mutex;
+                std::condition_variable arrived_cv;
+                std::vector<std::pair<std::string, std::string>> arrived; // (peer, witness); empty = refused
+            };
+
+            network::P2PNetwork &network_;
+            TransactionManager &transactions_;
+
+            std::mutex sessions_mutex_;
+            std::unordered_map<std::string, std::shared_ptr<Session>> sessions_;
+            std::atomic<uint64_t> next_session_{1};
+
+            std::mutex signer_mutex_;
+            std::string signing_key_;
+            Approver approver_;
+
+            std::atomic<uint64_t> sessions_started_{0};
+            std::atomic<uint64_t> completed_{0};
+            std::atomic<uint64_t> accepted_{0};
+            std::atomic<uint64_t> rejected_{0};
+            std::atomic<uint64_t> served_{0};
+
+            Impl(network::P2PNetwork &network, TransactionManager &transactions)
+                : network_(network), transactions_(transactions)
+            {
+            }
+
+            void handle_response(const network::NetworkMessage &message)
+            {
+                std::shared_ptr<Session> session;
+                {
+                    std::lock_guard<std::mutex> lock(sessions_mutex_);
+                    auto it = sessions_.find(message.message_id);
+                    if (it == sessions_.end())
+                    {
+                        return; // Finished; the threshold was met without this signer
+                    }
+                    session = it->second;
+                }
+                {
+                    std::lock_guard<std::mutex> lock(session->mutex);
+                    session->arrived.emplace_back(message.sender_id,
+                                                  std::string(message.payload.begin(), message.payload.end()));
+                }
+                session->arrived_cv.notify_one();
+            }
+
+            // Request payload: transaction id, a zero byte, then the hex body hash
+            void handle_request(const network::NetworkMessage &message)
+            {
+                const auto separator = std::find(message.payload.begin(), message.payload.end(), 0);
+                if (separator == message.payload.end() || message.sender_id.empty())
+                {
+                    return;
+                }
+                const std::string tx_id(message.payload.begin(), separator);
+                const std::string body_hash(separator + 1, message.payload.end());
+
+                std::string signing_key;
+                Approver approver;
+                {
+                    std::lock_guard<std::mutex> lock(signer_mutex_);
+                    signing_key = signing_key_;
+                    approver = approver_;
+                }
+                std::string witness;
+                if (!signing_key.empty() && (!approver || approver(tx_id, body_hash, message.sender_id)))
+                {
+                    witness = TransactionManager::create_witness(body_hash, signing_key);
+                }
+                ++served_;
+                network_.send_message(message.sender_id,
+                                      make_message(network::MessageType::SIGNING_RESPONSE, message.message_id,
+                                                   network_.get_local_peer_id(), message.sender_id, witness));
+            }
+        };
+
+        SigningCoordinator::SigningCoordinator(network::P2PNetwork &network, TransactionManager &transactions)
+            : pimpl_(std::make_shared<Impl>(network, transactions))
+        {
+            std::weak_ptr<Impl> weak = pimpl_;
+            network.set_message_handler(network::MessageType::SIGNING_RESPONSE,
+                                        [weak](const network::NetworkMessage &message)
+                                        {
+                                            if (auto impl = weak.lock())
+                                            {
+                                                impl->handle_response(message);
+                                            }
+                                        });
+        }
+
+        SigningCoordinator::~SigningCoordinator()
+        {
+            pimpl_->network_.set_message_handler(network::MessageType::SIGNING_RESPONSE, nullptr);
+            pimpl_->network_.set_message_handler(network::MessageType::SIGNING_REQUEST, nullptr);
+        }
+
+        SigningCoordinator::Result SigningCoordinator::collect(Transaction &transaction,
+                                                               const std::vector<Signer> &signers,
+                                                               uint32_t threshold, uint32_t timeout_ms)
+        {
+            Result result;
+            const auto start = std::chrono::steady_clock::now();
+            const auto deadline = start + std::chrono::milliseconds(timeout_ms);
+            ++pimpl_->sessions_started_;
+
+            std::unordered_map<std::string, std::string> pending; // Signers yet to answer, to their lowercase vkey
+            for (const auto &signer : signers)
+            {
+                if (!is_vkey(signer.verification_key))
+                {
+                    result.rejected.push_back(signer.peer_id);
+                }
+                std::string vkey = signer.verification_key;
+                std::transform(vkey.begin(), vkey.end(), vkey.begin(), [](unsigned char c)
+                               { return static_cast<char>(std::tolower(c)); });
+                pending.emplace(signer.peer_id, std::move(vkey));
+            }
+            if (!result.rejected.empty())
+            {
+                // Without a pinned key any peer could meet the threshold with throwaway keys
+                utils::Logger::instance().log(utils::LogLevel::WARNING, "SigningCoordinator",
+                                              "Signing session for " + transaction.tx_id + " refused: " +
+                                                  std::to_string(result.rejected.size()) +
+                                                  " signer(s) without a verification key");
+                return result;
+            }
+            if (threshold == 0 || threshold > pending.size())
+            {
+                result.complete = threshold == 0;
+                return result;
+            }
+
+            const std::string body_hash = pimpl_->transactions_.get_body_hash(transaction);
+            const std::string local_id = pimpl_->network_.get_local_peer_id();
+            const std::string session_id = local_id + ":sign:" + std::to_string(pimpl_->next_session_++);
+            auto session = std::make_shared<Impl::Session>();
+            {
+                std::lock_guard<std::mutex> lock(pimpl_->sessions_mutex_);
+                pimpl_->sessions_.emplace(session_id, session);
+            }
+
+            // Every signer gets the request before any answer is waited for
+            std::string request = transaction.tx_id;
+            request.push_back('\0');
+            request += body_hash;
+            for (auto it = pending.begin(); it != pending.end();)
+            {
+                if (pimpl_->network_.send_message(it->first,
+                                                  make_message(network::MessageType::SIGNING_REQUEST, session_id,
+                                                               local_id, it->first, request)))
+                {
+                    ++it;
+                    continue;
+                }
+                result.rejected.push_back(it->first);
+                it = pending.erase(it);
+            }
+
+            std::vector<std::string> accepted;
+            std::set<std::string> vkeys; // One witness per key, whichever peer sent it
+            std::vector<std::pair<std::string, std::string>> batch;
+            std::vector<std::string> witnesses;
+            while (accepted.size() < threshold && accepted.size() + pending.size() >= threshold)
+            {
+                batch.clear();
+                {
+                    std::unique_lock<std::mutex> lock(session->mutex);
+                    session->arrived_cv.wait_until(lock, deadline, [&session]()
+                                                   { return !session->arrived.empty(); });
+                    batch.swap(session->arrived);
+                }
+                if (batch.empty())
+                {
+                    break; // Timed out
+                }
+
+                witnesses.clear();
+                for (const auto &[peer, witness] : batch)
+                {
+                    witnesses.push_back(witness);
+                }
+                const auto valid = TransactionManager::verify_witnesses(body_hash, witnesses);
+                for (size_t i = 0; i < batch.size() && accepted.size() < threshold; ++i)
+                {
+                    const auto &[peer, witness] = batch[i];
+                    auto signer = pending.find(peer);
+                    if (signer == pending.end())
+                    {
+                        continue; // Not asked, or answered already
+                    }
+                    const std::string vkey = witness.substr(0, VKEY_HEX);
+                    const bool accept = valid[i] && vkey == signer->second && vkeys.insert(vkey).second;
+                    if (accept)
+                    {
+                        accepted.push_back(witness);
+                        result.signed_by.push_back(peer);
+                    }
+                    else
+                    {
+                        result.rejected.push_back(peer);
+                    }
+                    pending.erase(signer);
+                }
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(pimpl_->sessions_mutex_);
+                pimpl_->sessions_.erase(session_id);
+            }
+
+            pimpl_->transactions_.add_witnesses(transaction, accepted);
+            result.complete = accepted.size() >= threshold;
+            result.elapsed_ms = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                                          std::chrono::steady_clock::now() - start)
+                                                          .count());
+            pimpl_->accepted_ += accepted.size();
+            pimpl_->rejected_ += result.rejected.size();
+            if (result.complete)
+            {
+                ++pimpl_->completed_;
+            }
+
+            utils::Logger::instance().log(result.complete ? utils::LogLevel::INFO : utils::LogLevel::WARNING,
+                                          "SigningCoordinator",
+                                          "Signing session for " + transaction.tx_id + ": " +
+                                              std::to_string(accepted.size()) + "/" + std::to_string(threshold) +
+                                              " witnesses in " + std::to_string(result.elapsed_ms) + " ms");
+            return result;
+        }
+
+        void SigningCoordinator::serve(const std::string &signing_key, Approver approver)
+        {
+            {
+                std::lock_guard<std::mutex> lock(pimpl_->signer_mutex_);
+                pimpl_->signing_key_ = signing_key;
+                pimpl_->approver_ = std::move(approver);
+            }
+            std::weak_ptr<Impl> weak = pimpl_;
+            pimpl_->network_.set_message_handler(network::MessageType::SIGNING_REQUEST,
+                                                 [weak](const network::NetworkMessage &message)
+                                                 {
+                                                     if (auto impl = weak.lock())
+                                                     {
+                                                         impl->handle_request(message);
+                                                     }
+                                                 });
+        }
+
+        SigningCoordinator::Stats SigningCoordinator::stats() const
+        {
+            Stats stats;
+            stats.sessions = pimpl_->sessions_started_.load();
+            stats.completed = pimpl_->completed_.load();
+            stats.witnesses_accepted = pimpl_->accepted_.load();
+            stats.witnesses_rejected = pimpl_->rejected_.load();
+            stats.requests_served = pimpl_->served_.load();
+            return stats;
+        }
+
+    } // namespace core
+} // namespace cardano_iot
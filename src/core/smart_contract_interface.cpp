@@ -1,19 +1,49 @@
 #include "cardano_iot/core/smart_contract_interface.h"
+#include "cardano_iot/core/plutus_data.h"
+#include "cardano_iot/core/plutus_script.h"
+#include "cardano_iot/network/cardano_client.h"
+#include "cardano_iot/utils/codec.h"
+#include "cardano_iot/utils/hash.h"
 #include "cardano_iot/utils/logger.h"
 
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <sstream>
 #include <random>
 #include <algorithm>
 #include <mutex>
 #include <thread>
 #include <iomanip>
+#include <unordered_map>
 #include <variant>
 
 namespace cardano_iot
 {
     namespace core
     {
+        namespace
+        {
+            // Arguments of a local validator run: the parameters, then the script context if any
+            std::vector<PlutusData> with_context(const std::vector<PlutusData> &parameters, const ExecutionContext &context)
+            {
+                std::vector<PlutusData> arguments = parameters;
+                if (!context.script_context.empty())
+                {
+                    PlutusData script_context;
+                    script_context.type = PlutusDataType::MAP;
+                    std::map<std::string, std::shared_ptr<PlutusData>> entries;
+                    for (const auto &[name, value] : context.script_context)
+                    {
+                        entries[name] = std::make_shared<PlutusData>(value);
+                    }
+                    script_context.value = std::move(entries);
+                    arguments.push_back(std::move(script_context));
+                }
+                return arguments;
+            }
+        } // namespace
+
         // PIMPL implementation
         struct SmartContractInterface::Impl
         {
@@ -41,13 +71,218 @@ namespace cardano_iot
             // State watchers
             std::map<std::string, std::map<std::string, std::function<void(const PlutusData &)>>> state_watchers_;
 
+            // On-chain event source
+            std::shared_ptr<network::CardanoClient> chain_client_;
+            uint64_t chain_subscription_ = 0;
+            std::mutex chain_mutex_;
+
+            // Decoded scripts by SHA-256 of their hex; program is null for bytes that are not UPLC
+            struct CachedScript
+            {
+                std::shared_ptr<const uplc::Program> program;
+                std::string error;
+            };
+            mutable std::mutex scripts_mutex_;
+            std::unordered_map<std::string, std::shared_ptr<const CachedScript>> scripts_;
+            std::unordered_map<std::string, std::string> address_scripts_; // contract address -> script key
+
+            // Read-only results, valid until the chain tip moves
+            mutable std::mutex memo_mutex_;
+            std::unordered_map<std::string, ReadonlyCallResult> memo_;
+            std::string memo_tip_;
+
             // Configuration
             ContractConfig config_;
 
             // Statistics
             ContractStats stats_ = {};
 
+            static std::string script_key(const std::string &script_cbor)
+            {
+                const auto digest = utils::Hasher::digest(utils::HashAlgorithm::SHA256, script_cbor.data(),
+                                                          script_cbor.size());
+                return std::string(digest.begin(), digest.end());
+            }
+
+            // Decode a script once; later calls with the same bytes share the result
+            std::shared_ptr<const CachedScript> compile_script(const std::string &script_cbor, std::string *key_out = nullptr)
+            {
+                const std::string key = script_key(script_cbor);
+                if (key_out)
+                {
+                    *key_out = key;
+                }
+                {
+                    std::lock_guard<std::mutex> lock(scripts_mutex_);
+                    auto it = scripts_.find(key);
+                    if (it != scripts_.end())
+                    {
+                        return it->second;
+                    }
+                }
+
+                auto entry = std::make_shared<CachedScript>();
+                const std::vector<uint8_t> bytes = utils::codec::hex_decode(script_cbor);
+                if (bytes.empty())
+                {
+                    entry->error = "script is not hex";
+                }
+                else
+                {
+                    auto program = std::make_shared<uplc::Program>();
+                    if (uplc::decode_script(bytes.data(), bytes.size(), *program, &entry->error))
+                    {
+                        entry->program = std::move(program);
+                    }
+                }
+
+                std::lock_guard<std::mutex> lock(scripts_mutex_);
+                auto inserted = scripts_.emplace(key, std::move(entry));
+                if (inserted.second)
+                {
+                    std::lock_guard<std::mutex> stats_lock(stats_mutex_);
+                    stats_.cached_scripts++;
+                }
+                return inserted.first->second;
+            }
+
+            std::shared_ptr<const uplc::Program> program_at(const std::string &contract_address, std::string &key)
+            {
+                std::lock_guard<std::mutex> lock(scripts_mutex_);
+                auto address_it = address_scripts_.find(contract_address);
+                if (address_it == address_scripts_.end())
+                {
+                    return nullptr;
+                }
+                auto it = scripts_.find(address_it->second);
+                if (it == scripts_.end())
+                {
+                    return nullptr;
+                }
+                key = address_it->second;
+                return it->second->program;
+            }
+
+            uplc::ExBudget readonly_budget() const
+            {
+                uplc::ExBudget budget;
+                budget.cpu = config_.readonly_cpu_budget;
+                budget.memory = config_.readonly_memory_budget;
+                return budget;
+            }
+
+            void advance_tip(const std::string &tip)
+            {
+                std::lock_guard<std::mutex> lock(memo_mutex_);
+                if (tip != memo_tip_)
+                {
+                    memo_tip_ = tip;
+                    memo_.clear();
+                }
+            }
+
+            // Local read-only evaluation; false if the contract has no UPLC script
+            bool run_readonly(const std::string &contract_address, const std::string &function_name,
+                              const std::vector<PlutusData> &parameters, ReadonlyCallResult &result)
+            {
+                std::string key;
+                auto program = program_at(contract_address, key);
+                if (!program)
+                {
+                    return false;
+                }
+
+                uint64_t state_version = 0;
+                {
+                    std::lock_guard<std::mutex> lock(contracts_mutex_);
+                    auto it = contract_states_.find(contract_address);
+                    if (it != contract_states_.end())
+                    {
+                        state_version = it->second->state_version;
+                    }
+                }
+
+                std::string memo_key = contract_address;
+                memo_key.push_back('\0');
+                memo_key += key;
+                memo_key.append(reinterpret_cast<const char *>(&state_version), sizeof(state_version));
+                memo_key += function_name;
+                memo_key.push_back('\0');
+                for (const auto &parameter : parameters)
+                {
+                    const auto encoded = uplc::serialise_data(parameter);
+                    memo_key.append(encoded.begin(), encoded.end());
+                }
+
+                const size_t memo_limit = config_.readonly_memo_entries;
+                std::string tip;
+                if (memo_limit > 0)
+                {
+                    std::lock_guard<std::mutex> lock(memo_mutex_);
+                    auto it = memo_.find(memo_key);
+                    if (it != memo_.end())
+                    {
+                        result = it->second;
+                        result.from_cache = true;
+                        std::lock_guard<std::mutex> stats_lock(stats_mutex_);
+                        stats_.readonly_calls++;
+                        stats_.readonly_cache_hits++;
+                        return true;
+                    }
+                    tip = memo_tip_;
+                }
+
+                std::vector<PlutusData> arguments;
+                arguments.reserve(parameters.size() + 2);
+                arguments.emplace_back(std::vector<uint8_t>(function_name.begin(), function_name.end()));
+                {
+                    PlutusData state;
+                    state.type = PlutusDataType::MAP;
+                    std::map<std::string, std::shared_ptr<PlutusData>> variables;
+                    std::lock_guard<std::mutex> lock(contracts_mutex_);
+                    auto it = contract_states_.find(contract_address);
+                    if (it != contract_states_.end())
+                    {
+                        for (const auto &[name, value] : it->second->state_variables)
+                        {
+                            variables[name] = std::make_shared<PlutusData>(value);
+                        }
+                    }
+                    state.value = std::move(variables);
+                    arguments.push_back(std::move(state));
+                }
+                arguments.insert(arguments.end(), parameters.begin(), parameters.end());
+
+                uplc::EvalResult evaluation = uplc::evaluate(*program, arguments, readonly_budget());
+                result.result = evaluation.success ? ExecutionResult::SUCCESS : ExecutionResult::EXECUTION_ERROR;
+                result.value = std::move(evaluation.value);
+                result.cpu_units = evaluation.consumed.cpu;
+                result.memory_units = evaluation.consumed.memory;
+                result.from_cache = false;
+                result.error_message = std::move(evaluation.error_message);
+
+                if (memo_limit > 0)
+                {
+                    std::lock_guard<std::mutex> lock(memo_mutex_);
+                    // A block arrived while evaluating: the result belongs to the old tip
+                    if (memo_tip_ == tip)
+                    {
+                        if (memo_.size() >= memo_limit)
+                        {
+                            memo_.clear();
+                        }
+                        memo_.emplace(std::move(memo_key), result);
+                    }
+                }
+
+                std::lock_guard<std::mutex> stats_lock(stats_mutex_);
+                stats_.readonly_calls++;
+                return true;
+            }
+
             // Generate unique IDs
+            std::atomic<uint64_t> id_sequence_{0};
+
             std::string generate_id(const std::string &prefix)
             {
                 auto now = std::chrono::system_clock::now();
@@ -58,7 +293,8 @@ namespace cardano_iot
                 std::uniform_int_distribution<> dis(1000, 9999);
 
                 std::stringstream ss;
-                ss << prefix << "_" << timestamp << "_" << dis(gen);
+                // The sequence keeps ids unique when batch calls start in the same millisecond
+                ss << prefix << "_" << timestamp << "_" << dis(gen) << "_" << id_sequence_.fetch_add(1, std::memory_order_relaxed);
                 return ss.str();
             }
 
@@ -118,6 +354,85 @@ namespace cardano_iot
                 }
             }
 
+            // Run one call and record its log, statistics and event; safe to call from several threads
+            std::shared_ptr<ExecutionLog> execute_call(
+                const std::string &contract_address,
+                const std::string &function_name,
+                const std::vector<PlutusData> &parameters,
+                const std::string &caller_address,
+                uint64_t amount_lovelace,
+                const std::string &transaction_hash)
+            {
+                std::string execution_id = generate_id("exec");
+                auto start_time = std::chrono::high_resolution_clock::now();
+
+                // Simulate execution
+                ExecutionResult result = simulate_execution(contract_address, function_name, parameters);
+
+                auto end_time = std::chrono::high_resolution_clock::now();
+                auto execution_time = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
+
+                // Create execution log
+                auto log = std::make_shared<ExecutionLog>();
+                log->execution_id = execution_id;
+                log->contract_address = contract_address;
+                log->function_name = function_name;
+                log->parameters = parameters;
+                log->result = result;
+                log->gas_used = estimate_gas_usage(function_name, parameters);
+                log->execution_time_ms = execution_time;
+                log->timestamp = std::chrono::duration_cast<std::chrono::seconds>(
+                                     std::chrono::system_clock::now().time_since_epoch())
+                                     .count();
+                log->transaction_hash = transaction_hash;
+
+                if (result != ExecutionResult::SUCCESS)
+                {
+                    log->error_message = "Simulated execution error";
+                }
+
+                {
+                    std::lock_guard<std::mutex> lock(executions_mutex_);
+                    execution_logs_[execution_id] = log;
+                }
+
+                // Update statistics
+                {
+                    std::lock_guard<std::mutex> stats_lock(stats_mutex_);
+                    stats_.total_executions++;
+                    if (result == ExecutionResult::SUCCESS)
+                    {
+                        stats_.successful_executions++;
+                    }
+                    else
+                    {
+                        stats_.failed_executions++;
+                    }
+                    stats_.total_gas_used += log->gas_used;
+                    stats_.avg_execution_time_ms = (stats_.avg_execution_time_ms + execution_time) / 2.0;
+                }
+
+                // Emit event if execution was successful
+                if (result == ExecutionResult::SUCCESS)
+                {
+                    ContractEvent event;
+                    event.event_id = generate_id("event");
+                    event.contract_address = contract_address;
+                    event.event_name = "FunctionCalled";
+                    event.event_data["function"] = PlutusData(std::vector<uint8_t>(function_name.begin(), function_name.end()));
+                    event.event_data["caller"] = PlutusData(std::vector<uint8_t>(caller_address.begin(), caller_address.end()));
+                    event.event_data["amount"] = PlutusData(static_cast<int64_t>(amount_lovelace));
+                    event.timestamp = log->timestamp;
+                    event.transaction_hash = log->transaction_hash;
+                    event.block_number = 12345; // Mock block number
+
+                    std::lock_guard<std::mutex> lock(events_mutex_);
+                    process_event(event);
+                }
+
+                return log;
+            }
+
             // Estimate gas usage
             uint64_t estimate_gas_usage(
                 const std::string &function_name,
@@ -140,41 +455,21 @@ namespace cardano_iot
                 return base_gas + param_gas;
             }
 
-            // Encode Plutus data to CBOR hex (simplified)
+            // Plutus Data CBOR as hex, through a per-thread arena that stays warm between calls
             std::string encode_plutus_data_impl(const PlutusData &data)
             {
-                std::stringstream ss;
-                ss << "cbor_";
-
-                switch (data.type)
-                {
-                case PlutusDataType::INTEGER:
-                    ss << "int_" << std::get<int64_t>(data.value);
-                    break;
-                case PlutusDataType::BYTESTRING:
-                    ss << "bytes_" << std::get<std::vector<uint8_t>>(data.value).size();
-                    break;
-                case PlutusDataType::BOOLEAN:
-                    ss << "bool_" << (std::get<bool>(data.value) ? "true" : "false");
-                    break;
-                case PlutusDataType::LIST:
-                    ss << "list_" << std::get<std::vector<std::shared_ptr<PlutusData>>>(data.value).size();
-                    break;
-                case PlutusDataType::MAP:
-                    ss << "map_" << std::get<std::map<std::string, std::shared_ptr<PlutusData>>>(data.value).size();
-                    break;
-                case PlutusDataType::CONSTRUCTOR:
-                {
-                    auto constructor = std::get<std::pair<uint64_t, std::vector<std::shared_ptr<PlutusData>>>>(data.value);
-                    ss << "constr_" << constructor.first << "_" << constructor.second.size();
-                }
-                break;
-                case PlutusDataType::UNIT:
-                    ss << "unit";
-                    break;
-                }
+                thread_local PlutusDataArena arena;
+                arena.clear();
+                const PlutusDataArena::NodeId root = arena.import(data);
+                return encode_hex(arena, root);
+            }
 
-                return ss.str();
+            static std::string encode_hex(const PlutusDataArena &arena, PlutusDataArena::NodeId root)
+            {
+                thread_local std::vector<uint8_t> buffer;
+                buffer.clear();
+                arena.encode(root, buffer);
+                return utils::codec::hex_encode(buffer);
             }
 
             // Create built-in contract templates
@@ -211,6 +506,62 @@ namespace cardano_iot
                 templates_[payment_channel.template_id] = payment_channel;
             }
 
+            std::vector<std::string> subscribed_addresses()
+            {
+                std::lock_guard<std::mutex> lock(events_mutex_);
+                std::vector<std::string> addresses;
+                for (const auto &entry : event_subscriptions_)
+                {
+                    if (!entry.second.empty())
+                    {
+                        addresses.push_back(entry.first);
+                    }
+                }
+                return addresses;
+            }
+
+            // Keep the block stream's address filter in step with the event subscriptions
+            void sync_watched_addresses()
+            {
+                std::lock_guard<std::mutex> lock(chain_mutex_);
+                if (chain_client_ && chain_subscription_ != 0)
+                {
+                    chain_client_->set_watched_addresses(chain_subscription_, subscribed_addresses());
+                }
+            }
+
+            void on_chain_transaction(const network::AddressTransaction &tx)
+            {
+                ContractEvent event;
+                event.event_id = generate_id("event");
+                event.contract_address = tx.address;
+                event.event_name = "Transaction";
+                event.event_data["block_hash"] = PlutusData(std::vector<uint8_t>(tx.block_hash.begin(), tx.block_hash.end()));
+                event.timestamp = std::chrono::duration_cast<std::chrono::seconds>(
+                                      std::chrono::system_clock::now().time_since_epoch())
+                                      .count();
+                event.transaction_hash = tx.tx_hash;
+                event.block_number = static_cast<uint32_t>(tx.block_height);
+
+                std::lock_guard<std::mutex> lock(events_mutex_);
+                process_event(event);
+            }
+
+            void detach_chain()
+            {
+                std::shared_ptr<network::CardanoClient> client;
+                uint64_t id = 0;
+                {
+                    std::lock_guard<std::mutex> lock(chain_mutex_);
+                    client = chain_client_;
+                    std::swap(id, chain_subscription_);
+                }
+                if (client && id != 0)
+                {
+                    client->unsubscribe_chain(id);
+                }
+            }
+
             // Process contract events
             void process_event(const ContractEvent &event)
             {
@@ -243,7 +594,10 @@ namespace cardano_iot
 
         // Constructor/Destructor
         SmartContractInterface::SmartContractInterface() : pimpl_(std::make_unique<Impl>()) {}
-        SmartContractInterface::~SmartContractInterface() = default;
+        SmartContractInterface::~SmartContractInterface()
+        {
+            pimpl_->detach_chain();
+        }
 
         bool SmartContractInterface::initialize(const std::string &network)
         {
@@ -267,6 +621,7 @@ namespace cardano_iot
 
         void SmartContractInterface::shutdown()
         {
+            pimpl_->detach_chain();
             std::lock_guard<std::mutex> lock(pimpl_->contracts_mutex_);
 
             if (!pimpl_->initialized_)
@@ -282,6 +637,15 @@ namespace cardano_iot
             pimpl_->contract_states_.clear();
             pimpl_->event_subscriptions_.clear();
             pimpl_->state_watchers_.clear();
+            {
+                std::lock_guard<std::mutex> scripts_lock(pimpl_->scripts_mutex_);
+                pimpl_->scripts_.clear();
+                pimpl_->address_scripts_.clear();
+            }
+            {
+                std::lock_guard<std::mutex> memo_lock(pimpl_->memo_mutex_);
+                pimpl_->memo_.clear();
+            }
             pimpl_->initialized_ = false;
 
             utils::Logger::instance().log(utils::LogLevel::INFO, "SmartContractInterface",
@@ -319,6 +683,14 @@ namespace cardano_iot
                 pimpl_->deployments_[deployment_id] = deployment;
             }
 
+            // Decode the script now so read-only calls can run it locally
+            std::string script_key;
+            if (pimpl_->compile_script(script_cbor, &script_key)->program)
+            {
+                std::lock_guard<std::mutex> lock(pimpl_->scripts_mutex_);
+                pimpl_->address_scripts_[contract_address] = script_key;
+            }
+
             // Initialize contract state
             auto state = std::make_shared<ContractState>();
             state->contract_address = contract_address;
@@ -356,6 +728,11 @@ namespace cardano_iot
                 return false;
             }
 
+            if (!contract.script_cbor.empty())
+            {
+                pimpl_->compile_script(contract.script_cbor);
+            }
+
             std::lock_guard<std::mutex> lock(pimpl_->contracts_mutex_);
 
             auto contract_ptr = std::make_shared<SmartContract>(contract);
@@ -482,78 +859,14 @@ namespace cardano_iot
                 return "";
             }
 
-            std::string execution_id = pimpl_->generate_id("exec");
-            auto start_time = std::chrono::high_resolution_clock::now();
-
-            // Simulate execution
-            ExecutionResult result = pimpl_->simulate_execution(contract_address, function_name, parameters);
-
-            auto end_time = std::chrono::high_resolution_clock::now();
-            auto execution_time = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
-
-            // Create execution log
-            auto log = std::make_shared<ExecutionLog>();
-            log->execution_id = execution_id;
-            log->contract_address = contract_address;
-            log->function_name = function_name;
-            log->parameters = parameters;
-            log->result = result;
-            log->gas_used = pimpl_->estimate_gas_usage(function_name, parameters);
-            log->execution_time_ms = execution_time;
-            log->timestamp = std::chrono::duration_cast<std::chrono::seconds>(
-                                 std::chrono::system_clock::now().time_since_epoch())
-                                 .count();
-            log->transaction_hash = pimpl_->generate_id("tx");
-
-            if (result != ExecutionResult::SUCCESS)
-            {
-                log->error_message = "Simulated execution error";
-            }
-
-            {
-                std::lock_guard<std::mutex> lock(pimpl_->executions_mutex_);
-                pimpl_->execution_logs_[execution_id] = log;
-            }
-
-            // Update statistics
-            {
-                std::lock_guard<std::mutex> stats_lock(pimpl_->stats_mutex_);
-                pimpl_->stats_.total_executions++;
-                if (result == ExecutionResult::SUCCESS)
-                {
-                    pimpl_->stats_.successful_executions++;
-                }
-                else
-                {
-                    pimpl_->stats_.failed_executions++;
-                }
-                pimpl_->stats_.total_gas_used += log->gas_used;
-                pimpl_->stats_.avg_execution_time_ms =
-                    (pimpl_->stats_.avg_execution_time_ms + execution_time) / 2.0;
-            }
-
-            // Emit event if execution was successful
-            if (result == ExecutionResult::SUCCESS)
-            {
-                ContractEvent event;
-                event.event_id = pimpl_->generate_id("event");
-                event.contract_address = contract_address;
-                event.event_name = "FunctionCalled";
-                event.event_data["function"] = PlutusData(std::vector<uint8_t>(function_name.begin(), function_name.end()));
-                event.event_data["caller"] = PlutusData(std::vector<uint8_t>(caller_address.begin(), caller_address.end()));
-                event.event_data["amount"] = PlutusData(static_cast<int64_t>(amount_lovelace));
-                event.timestamp = log->timestamp;
-                event.transaction_hash = log->transaction_hash;
-                event.block_number = 12345; // Mock block number
-
-                pimpl_->process_event(event);
-            }
+            auto log = pimpl_->execute_call(contract_address, function_name, parameters, caller_address,
+                                            amount_lovelace, pimpl_->generate_id("tx"));
 
             utils::Logger::instance().log(utils::LogLevel::INFO, "SmartContractInterface",
                                           "Function called: " + function_name + " on " + contract_address +
-                                              " (result: " + (result == ExecutionResult::SUCCESS ? "SUCCESS" : "ERROR") + ")");
+                                              " (result: " + (log->result == ExecutionResult::SUCCESS ? "SUCCESS" : "ERROR") + ")");
 
-            return execution_id;
+            return log->execution_id;
         }
 
         std::string SmartContractInterface::call_readonly_function(
@@ -566,16 +879,45 @@ namespace cardano_iot
                 return "";
             }
 
-            // Simplified readonly call - just return encoded result
+            ReadonlyCallResult result;
+            if (pimpl_->run_readonly(contract_address, function_name, parameters, result))
+            {
+                CARDANO_IOT_LOG(utils::LogLevel::DEBUG, "SmartContractInterface",
+                                "Readonly function evaluated: " << function_name << " on " << contract_address << " ("
+                                                                << result.cpu_units << " cpu, " << result.memory_units
+                                                                << " mem" << (result.from_cache ? ", cached" : "") << ")");
+                return result.result == ExecutionResult::SUCCESS ? pimpl_->encode_plutus_data_impl(result.value) : "";
+            }
+
+            // Contract without a UPLC script - simulated result
             std::stringstream ss;
             ss << "readonly_result_" << function_name << "_" << parameters.size();
 
-            utils::Logger::instance().log(utils::LogLevel::INFO, "SmartContractInterface",
-                                          "Readonly function called: " + function_name + " on " + contract_address);
+            CARDANO_IOT_LOG(utils::LogLevel::DEBUG, "SmartContractInterface",
+                            "Readonly function called: " << function_name << " on " << contract_address);
 
             return ss.str();
         }
 
+        ReadonlyCallResult SmartContractInterface::evaluate_readonly_function(
+            const std::string &contract_address,
+            const std::string &function_name,
+            const std::vector<PlutusData> &parameters) const
+        {
+            ReadonlyCallResult result;
+            if (!pimpl_->initialized_)
+            {
+                result.error_message = "Smart contract interface not initialized";
+                return result;
+            }
+            if (!pimpl_->run_readonly(contract_address, function_name, parameters, result))
+            {
+                result.result = ExecutionResult::VALIDATION_FAILED;
+                result.error_message = "No UPLC script deployed at " + contract_address;
+            }
+            return result;
+        }
+
         std::shared_ptr<ContractState> SmartContractInterface::get_contract_state(const std::string &contract_address) const
         {
             if (!pimpl_->initialized_)
@@ -639,14 +981,15 @@ namespace cardano_iot
                 return false;
             }
 
-            std::lock_guard<std::mutex> lock(pimpl_->events_mutex_);
-            pimpl_->event_subscriptions_[contract_address][event_name] = callback;
-
-            // Update statistics
             {
+                std::lock_guard<std::mutex> lock(pimpl_->events_mutex_);
+                pimpl_->event_subscriptions_[contract_address][event_name] = callback;
+
+                // Update statistics
                 std::lock_guard<std::mutex> stats_lock(pimpl_->stats_mutex_);
                 pimpl_->stats_.active_subscriptions++;
             }
+            pimpl_->sync_watched_addresses();
 
             utils::Logger::instance().log(utils::LogLevel::INFO, "SmartContractInterface",
                                           "Event subscription added: " + contract_address + "." + event_name);
@@ -662,32 +1005,69 @@ namespace cardano_iot
                 return false;
             }
 
-            std::lock_guard<std::mutex> lock(pimpl_->events_mutex_);
-
-            auto contract_it = pimpl_->event_subscriptions_.find(contract_address);
-            if (contract_it != pimpl_->event_subscriptions_.end())
             {
+                std::lock_guard<std::mutex> lock(pimpl_->events_mutex_);
+
+                auto contract_it = pimpl_->event_subscriptions_.find(contract_address);
+                if (contract_it == pimpl_->event_subscriptions_.end())
+                {
+                    return false;
+                }
                 auto event_it = contract_it->second.find(event_name);
-                if (event_it != contract_it->second.end())
+                if (event_it == contract_it->second.end())
                 {
-                    contract_it->second.erase(event_it);
-
-                    // Update statistics
-                    {
-                        std::lock_guard<std::mutex> stats_lock(pimpl_->stats_mutex_);
-                        if (pimpl_->stats_.active_subscriptions > 0)
-                        {
-                            pimpl_->stats_.active_subscriptions--;
-                        }
-                    }
+                    return false;
+                }
+                contract_it->second.erase(event_it);
 
-                    utils::Logger::instance().log(utils::LogLevel::INFO, "SmartContractInterface",
-                                                  "Event subscription removed: " + contract_address + "." + event_name);
-                    return true;
+                // Update statistics
+                std::lock_guard<std::mutex> stats_lock(pimpl_->stats_mutex_);
+                if (pimpl_->stats_.active_subscriptions > 0)
+                {
+                    pimpl_->stats_.active_subscriptions--;
                 }
             }
+            pimpl_->sync_watched_addresses();
 
-            return false;
+            utils::Logger::instance().log(utils::LogLevel::INFO, "SmartContractInterface",
+                                          "Event subscription removed: " + contract_address + "." + event_name);
+            return true;
+        }
+
+        void SmartContractInterface::set_chain_client(std::shared_ptr<network::CardanoClient> client)
+        {
+            pimpl_->detach_chain();
+            if (!client)
+            {
+                std::lock_guard<std::mutex> lock(pimpl_->chain_mutex_);
+                pimpl_->chain_client_.reset();
+                return;
+            }
+
+            Impl *impl = pimpl_.get();
+            network::ChainSubscription subscription;
+            subscription.watched_addresses = pimpl_->subscribed_addresses();
+            subscription.on_transaction = [impl](const network::AddressTransaction &tx)
+            {
+                impl->on_chain_transaction(tx);
+            };
+            subscription.on_block = [impl](const network::BlockHeader &block)
+            {
+                impl->advance_tip(block.hash);
+            };
+            subscription.on_rollback = [impl](const network::ChainPoint &point)
+            {
+                impl->advance_tip("rollback:" + point.hash);
+            };
+            const uint64_t id = client->subscribe_chain(std::move(subscription));
+
+            {
+                std::lock_guard<std::mutex> lock(pimpl_->chain_mutex_);
+                pimpl_->chain_client_ = std::move(client);
+                pimpl_->chain_subscription_ = id;
+            }
+            // Catch subscriptions added while the stream was being set up
+            pimpl_->sync_watched_addresses();
         }
 
         std::vector<ContractEvent> SmartContractInterface::get_events(
@@ -797,6 +1177,13 @@ namespace cardano_iot
             const ExecutionContext &context,
             const std::vector<PlutusData> &parameters) const
         {
+            auto script = pimpl_->compile_script(script_cbor);
+            if (script->program)
+            {
+                return uplc::evaluate(*script->program, with_context(parameters, context), pimpl_->readonly_budget())
+                    .consumed.cpu;
+            }
+
             // Simplified estimation based on script size and parameters
             uint64_t base_units = script_cbor.length() * 10;
             uint64_t param_units = parameters.size() * 50000;
@@ -809,21 +1196,34 @@ namespace cardano_iot
             return pimpl_->encode_plutus_data_impl(data);
         }
 
+        std::string SmartContractInterface::encode_plutus_data(const PlutusDataArena &arena, uint32_t root) const
+        {
+            return Impl::encode_hex(arena, root);
+        }
+
         PlutusData SmartContractInterface::decode_plutus_data(const std::string &cbor_hex) const
         {
-            // Simplified decoding for demo
-            if (cbor_hex.find("int_") != std::string::npos)
-            {
-                return PlutusData(static_cast<int64_t>(42)); // Mock integer
-            }
-            else if (cbor_hex.find("bool_") != std::string::npos)
+            thread_local PlutusDataArena arena;
+            arena.clear();
+            PlutusDataArena::NodeId root = 0;
+            if (!decode_plutus_data(cbor_hex, arena, root))
             {
-                return PlutusData(true); // Mock boolean
+                return PlutusData(); // Return unit for malformed input
             }
-            else
+            return arena.to_plutus_data(root);
+        }
+
+        bool SmartContractInterface::decode_plutus_data(const std::string &cbor_hex, PlutusDataArena &arena,
+                                                        uint32_t &root) const
+        {
+            thread_local std::vector<uint8_t> buffer;
+            buffer.resize(cbor_hex.size() / 2);
+            const size_t written = utils::codec::hex_decode(cbor_hex.data(), cbor_hex.size(), buffer.data());
+            if (cbor_hex.empty() || written == utils::codec::npos)
             {
-                return PlutusData(); // Return unit for unknown types
+                return false;
             }
+            return arena.decode(buffer.data(), written, root);
         }
 
         PlutusData SmartContractInterface::create_integer(int64_t value)
@@ -842,6 +1242,7 @@ namespace cardano_iot
             data.type = PlutusDataType::LIST;
 
             std::vector<std::shared_ptr<PlutusData>> shared_items;
+            shared_items.reserve(items.size());
             for (const auto &item : items)
             {
                 shared_items.push_back(std::make_shared<PlutusData>(item));
@@ -872,6 +1273,7 @@ namespace cardano_iot
             data.type = PlutusDataType::CONSTRUCTOR;
 
             std::vector<std::shared_ptr<PlutusData>> shared_fields;
+            shared_fields.reserve(fields.size());
             for (const auto &field : fields)
             {
                 shared_fields.push_back(std::make_shared<PlutusData>(field));
@@ -883,22 +1285,11 @@ namespace cardano_iot
 
         bool SmartContractInterface::validate_script(const std::string &script_cbor) const
         {
-            // Simplified validation - check if it's a valid hex string and not empty
             if (script_cbor.empty())
             {
                 return false;
             }
-
-            // Check if it contains valid hex characters
-            for (char c : script_cbor)
-            {
-                if (!std::isxdigit(c))
-                {
-                    return false;
-                }
-            }
-
-            return true;
+            return pimpl_->compile_script(script_cbor)->program != nullptr;
         }
 
         bool SmartContractInterface::verify_execution(
@@ -906,32 +1297,183 @@ namespace cardano_iot
             const ExecutionContext &context,
             const std::vector<PlutusData> &parameters) const
         {
-            // Simplified verification for demo
-            return validate_script(script_cbor) && !parameters.empty();
+            auto script = pimpl_->compile_script(script_cbor);
+            if (!script->program || parameters.empty())
+            {
+                return false;
+            }
+            return uplc::evaluate(*script->program, with_context(parameters, context), pimpl_->readonly_budget()).success;
         }
 
-        std::string SmartContractInterface::execute_batch_calls(
-            const std::vector<std::tuple<std::string, std::string, std::vector<PlutusData>>> &calls,
+        BatchExecutionResult SmartContractInterface::execute_batch(
+            const std::vector<BatchCall> &calls,
             const std::string &caller_address,
             const std::string &device_id)
         {
+            BatchExecutionResult batch;
             if (!pimpl_->initialized_)
             {
-                return "";
+                return batch;
             }
 
-            std::string batch_id = pimpl_->generate_id("batch");
+            batch.batch_id = pimpl_->generate_id("batch");
+            const size_t count = calls.size();
 
-            for (const auto &[contract_address, function_name, parameters] : calls)
+            // Pack calls on one contract into shared transactions up to the gas limit
+            std::vector<std::string> tx_hashes(count);
+            std::unordered_map<std::string, std::pair<size_t, uint64_t>> open_tx; // address -> (tx index, gas)
+            for (size_t i = 0; i < count; ++i)
             {
-                call_contract_function(contract_address, function_name, parameters, caller_address, 0, device_id);
+                uint64_t gas = pimpl_->estimate_gas_usage(calls[i].function_name, calls[i].parameters);
+                auto it = open_tx.find(calls[i].contract_address);
+                if (it == open_tx.end() || it->second.second + gas > pimpl_->config_.default_gas_limit)
+                {
+                    batch.transaction_hashes.push_back(pimpl_->generate_id("tx"));
+                    it = open_tx.insert_or_assign(calls[i].contract_address,
+                                                  std::make_pair(batch.transaction_hashes.size() - 1, uint64_t(0)))
+                             .first;
+                }
+                it->second.second += gas;
+                tx_hashes[i] = batch.transaction_hashes[it->second.first];
+            }
+
+            // Dependency graph: an edge from each call to every later call it conflicts with
+            auto overlaps = [](const std::vector<std::string> &a, const std::vector<std::string> &b)
+            {
+                return std::any_of(a.begin(), a.end(), [&b](const std::string &name)
+                                   { return std::find(b.begin(), b.end(), name) != b.end(); });
+            };
+            auto conflicts = [&overlaps](const BatchCall &x, const BatchCall &y)
+            {
+                if (x.contract_address != y.contract_address)
+                {
+                    return false;
+                }
+                if ((x.reads.empty() && x.writes.empty()) || (y.reads.empty() && y.writes.empty()))
+                {
+                    return true;
+                }
+                return overlaps(x.writes, y.reads) || overlaps(x.writes, y.writes) || overlaps(y.writes, x.reads);
+            };
+
+            std::unordered_map<std::string, std::vector<size_t>> by_address;
+            for (size_t i = 0; i < count; ++i)
+            {
+                by_address[calls[i].contract_address].push_back(i);
+            }
+
+            std::vector<std::vector<size_t>> successors(count);
+            std::vector<size_t> blockers(count, 0);
+            for (const auto &[address, indices] : by_address)
+            {
+                for (size_t a = 0; a < indices.size(); ++a)
+                {
+                    for (size_t b = a + 1; b < indices.size(); ++b)
+                    {
+                        if (conflicts(calls[indices[a]], calls[indices[b]]))
+                        {
+                            successors[indices[a]].push_back(indices[b]);
+                            blockers[indices[b]]++;
+                        }
+                    }
+                }
+            }
+
+            std::vector<size_t> ready;
+            for (size_t i = count; i-- > 0;)
+            {
+                if (blockers[i] == 0)
+                {
+                    ready.push_back(i); // back() is the earliest call
+                }
+            }
+
+            std::vector<std::shared_ptr<ExecutionLog>> logs(count);
+            std::mutex queue_mutex;
+            std::condition_variable queue_cv;
+            size_t finished = 0;
+
+            auto worker = [&]()
+            {
+                std::unique_lock<std::mutex> lock(queue_mutex);
+                while (finished < count)
+                {
+                    if (ready.empty())
+                    {
+                        queue_cv.wait_for(lock, std::chrono::milliseconds(50));
+                        continue;
+                    }
+
+                    size_t index = ready.back();
+                    ready.pop_back();
+                    lock.unlock();
+
+                    const BatchCall &call = calls[index];
+                    logs[index] = pimpl_->execute_call(call.contract_address, call.function_name, call.parameters,
+                                                       caller_address, call.amount_lovelace, tx_hashes[index]);
+
+                    lock.lock();
+                    finished++;
+                    for (size_t next : successors[index])
+                    {
+                        if (--blockers[next] == 0)
+                        {
+                            ready.push_back(next);
+                        }
+                    }
+                    queue_cv.notify_all();
+                }
+            };
+
+            size_t worker_count = std::min<size_t>(std::max<uint32_t>(pimpl_->config_.max_concurrent_executions, 1), count);
+            std::vector<std::thread> workers;
+            for (size_t i = 1; i < worker_count; ++i)
+            {
+                workers.emplace_back(worker);
+            }
+            if (count > 0)
+            {
+                worker();
+            }
+            for (auto &thread : workers)
+            {
+                thread.join();
+            }
+
+            batch.logs.reserve(count);
+            size_t succeeded = 0;
+            for (const auto &log : logs)
+            {
+                succeeded += log->result == ExecutionResult::SUCCESS ? 1 : 0;
+                batch.logs.push_back(*log);
             }
 
             utils::Logger::instance().log(utils::LogLevel::INFO, "SmartContractInterface",
-                                          "Batch execution completed: " + batch_id + " (" +
-                                              std::to_string(calls.size()) + " calls)");
+                                          "Batch execution completed: " + batch.batch_id + " (" +
+                                              std::to_string(succeeded) + "/" + std::to_string(count) + " calls succeeded in " +
+                                              std::to_string(batch.transaction_hashes.size()) + " transactions" +
+                                              (device_id.empty() ? "" : ", device " + device_id) + ")");
+
+            return batch;
+        }
+
+        std::string SmartContractInterface::execute_batch_calls(
+            const std::vector<std::tuple<std::string, std::string, std::vector<PlutusData>>> &calls,
+            const std::string &caller_address,
+            const std::string &device_id)
+        {
+            std::vector<BatchCall> batch_calls;
+            batch_calls.reserve(calls.size());
+            for (const auto &[contract_address, function_name, parameters] : calls)
+            {
+                BatchCall call;
+                call.contract_address = contract_address;
+                call.function_name = function_name;
+                call.parameters = parameters;
+                batch_calls.push_back(std::move(call));
+            }
 
-            return batch_id;
+            return execute_batch(batch_calls, caller_address, device_id).batch_id;
         }
 
         bool SmartContractInterface::create_contract_composition(
@@ -0,0 +1,327 @@
+#include "cardano_iot/core/transaction_builder_pool.h"
+#include "cardano_iot/utils/logger.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace cardano_iot
+{
+    namespace core
+    {
+        namespace
+        {
+            struct PendingBuild
+            {
+                TransactionBuildRequest request;
+                std::promise<TransactionBuildResult> promise;
+            };
+
+            std::future<TransactionBuildResult> failed_future(const std::string &error)
+            {
+                std::promise<TransactionBuildResult> promise;
+                TransactionBuildResult result;
+                result.error_message = error;
+                promise.set_value(std::move(result));
+                return promise.get_future();
+            }
+        } // namespace
+
+        class TransactionBuilderPool::Impl
+        {
+        public:
+            TransactionManager &manager_;
+            const size_t queue_capacity_;
+
+            mutable std::mutex queue_mutex_;
+            std::condition_variable queue_cv_;
+            std::deque<PendingBuild> queue_;
+            bool stopping_ = false;
+            bool drain_ = true;
+            std::vector<std::thread> workers_;
+            size_t target_workers_ = 0; // Workers at or past this index retire
+
+            std::atomic<uint64_t> requests_queued_{0};
+            std::atomic<uint64_t> requests_rejected_{0};
+            std::atomic<uint64_t> transactions_built_{0};
+            std::atomic<uint64_t> transactions_submitted_{0};
+            std::atomic<uint64_t> builds_failed_{0};
+            std::atomic<uint64_t> builds_timed_{0};
+            std::atomic<uint64_t> build_time_ns_{0};
+
+            Impl(TransactionManager &manager, size_t queue_capacity)
+                : manager_(manager), queue_capacity_(std::max<size_t>(1, queue_capacity)) {}
+
+            void worker_loop(size_t index)
+            {
+                while (true)
+                {
+                    PendingBuild pending;
+                    {
+                        std::unique_lock<std::mutex> lock(queue_mutex_);
+                        while (queue_.empty() && !stopping_ && index < target_workers_)
+                        {
+                            queue_cv_.wait_for(lock, std::chrono::milliseconds(100));
+                        }
+                        if (index >= target_workers_ || queue_.empty() || (stopping_ && !drain_))
+                        {
+                            return;
+                        }
+                        pending = std::move(queue_.front());
+                        queue_.pop_front();
+                    }
+                    pending.promise.set_value(build(pending.request));
+                }
+            }
+
+            void fail_remaining(const std::string &error)
+            {
+                std::deque<PendingBuild> abandoned;
+                {
+                    std::lock_guard<std::mutex> lock(queue_mutex_);
+                    abandoned.swap(queue_);
+                }
+                for (auto &pending : abandoned)
+                {
+                    TransactionBuildResult result;
+                    result.error_message = error;
+                    pending.promise.set_value(std::move(result));
+                    builds_failed_.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+
+            std::unique_ptr<Transaction> create(const TransactionBuildRequest &request)
+            {
+                switch (request.type)
+                {
+                case TransactionType::PAYMENT:
+                    return manager_.create_payment_transaction(request.from_address, request.to_address,
+                                                               request.amount_lovelace, request.device_id);
+                case TransactionType::TOKEN_TRANSFER:
+                    return manager_.create_token_transfer(request.from_address, request.to_address,
+                                                          request.tokens, request.device_id);
+                case TransactionType::METADATA:
+                    return manager_.create_metadata_transaction(request.from_address, request.metadata,
+                                                                request.device_id);
+                default:
+                    return nullptr;
+                }
+            }
+
+            TransactionBuildResult build(const TransactionBuildRequest &request)
+            {
+                const auto start = std::chrono::steady_clock::now();
+                TransactionBuildResult result;
+
+                result.transaction = create(request);
+                if (!result.transaction)
+                {
+                    result.error_message = "Transaction could not be built (insufficient funds or unsupported type)";
+                }
+                else if (!request.signing_key.empty() &&
+                         !manager_.sign_transaction(*result.transaction, request.signing_key))
+                {
+                    // Give the reserved inputs back to other builders
+                    manager_.cancel_transaction(result.transaction->tx_id);
+                    result.error_message = "Signing failed";
+                }
+                else
+                {
+                    result.success = true;
+                }
+
+                if (result.success)
+                {
+                    transactions_built_.fetch_add(1, std::memory_order_relaxed);
+                }
+                builds_timed_.fetch_add(1, std::memory_order_relaxed);
+                build_time_ns_.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                             std::chrono::steady_clock::now() - start)
+                                             .count(),
+                                         std::memory_order_relaxed);
+
+                // Submission is outside the build timing; on success the change output becomes
+                // selectable (unconfirmed) for the next build from this wallet
+                if (result.success && request.submit)
+                {
+                    result.submitted_tx_id = manager_.submit_transaction(*result.transaction);
+                    if (result.submitted_tx_id.empty())
+                    {
+                        result.success = false;
+                        result.error_message = "Network submission failed";
+                    }
+                    else
+                    {
+                        transactions_submitted_.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+
+                if (!result.success)
+                {
+                    builds_failed_.fetch_add(1, std::memory_order_relaxed);
+                    CARDANO_IOT_LOG(utils::LogLevel::DEBUG, "TransactionBuilderPool",
+                                    "Build for device '" << request.device_id << "' failed: " << result.error_message);
+                }
+                return result;
+            }
+        };
+
+        TransactionBuilderPool::TransactionBuilderPool(TransactionManager &manager, size_t workers, size_t queue_capacity)
+            : pimpl_(std::make_unique<Impl>(manager, queue_capacity))
+        {
+            if (workers == 0)
+            {
+                workers = std::max(1u, std::thread::hardware_concurrency());
+            }
+            pimpl_->workers_.reserve(workers);
+            pimpl_->target_workers_ = workers;
+            for (size_t i = 0; i < workers; ++i)
+            {
+                pimpl_->workers_.emplace_back([this, i]()
+                                              { pimpl_->worker_loop(i); });
+            }
+
+            utils::Logger::instance().log(utils::LogLevel::INFO, "TransactionBuilderPool",
+                                          "Started with " + std::to_string(workers) + " workers");
+        }
+
+        TransactionBuilderPool::~TransactionBuilderPool()
+        {
+            shutdown(true);
+        }
+
+        std::future<TransactionBuildResult> TransactionBuilderPool::submit(TransactionBuildRequest request)
+        {
+            std::vector<TransactionBuildRequest> single;
+            single.push_back(std::move(request));
+            return std::move(submit_batch(std::move(single)).front());
+        }
+
+        std::vector<std::future<TransactionBuildResult>> TransactionBuilderPool::submit_batch(
+            std::vector<TransactionBuildRequest> requests)
+        {
+            std::vector<std::future<TransactionBuildResult>> futures;
+            futures.reserve(requests.size());
+            size_t accepted = 0;
+            {
+                std::lock_guard<std::mutex> lock(pimpl_->queue_mutex_);
+                for (auto &request : requests)
+                {
+                    if (pimpl_->stopping_ || pimpl_->queue_.size() >= pimpl_->queue_capacity_)
+                    {
+                        futures.push_back(failed_future(pimpl_->stopping_ ? "Builder pool is shut down"
+                                                                          : "Builder queue is full"));
+                        continue;
+                    }
+                    PendingBuild pending;
+                    pending.request = std::move(request);
+                    futures.push_back(pending.promise.get_future());
+                    pimpl_->queue_.push_back(std::move(pending));
+                    ++accepted;
+                }
+            }
+
+            pimpl_->requests_queued_.fetch_add(accepted, std::memory_order_relaxed);
+            pimpl_->requests_rejected_.fetch_add(requests.size() - accepted, std::memory_order_relaxed);
+            if (accepted == 1)
+            {
+                pimpl_->queue_cv_.notify_one();
+            }
+            else if (accepted > 1)
+            {
+                pimpl_->queue_cv_.notify_all();
+            }
+            return futures;
+        }
+
+        void TransactionBuilderPool::shutdown(bool drain)
+        {
+            {
+                std::lock_guard<std::mutex> lock(pimpl_->queue_mutex_);
+                if (pimpl_->stopping_ && pimpl_->workers_.empty())
+                {
+                    return;
+                }
+                pimpl_->stopping_ = true;
+                pimpl_->drain_ = drain;
+            }
+            pimpl_->queue_cv_.notify_all();
+
+            for (auto &worker : pimpl_->workers_)
+            {
+                if (worker.joinable())
+                {
+                    worker.join();
+                }
+            }
+            {
+                std::lock_guard<std::mutex> lock(pimpl_->queue_mutex_);
+                pimpl_->workers_.clear();
+            }
+            pimpl_->fail_remaining("Builder pool is shut down");
+        }
+
+        size_t TransactionBuilderPool::resize(size_t workers)
+        {
+            workers = std::max<size_t>(workers, 1);
+            std::vector<std::thread> retired;
+            {
+                std::lock_guard<std::mutex> lock(pimpl_->queue_mutex_);
+                if (pimpl_->stopping_)
+                {
+                    return pimpl_->workers_.size();
+                }
+                pimpl_->target_workers_ = workers;
+                for (size_t i = pimpl_->workers_.size(); i < workers; ++i)
+                {
+                    pimpl_->workers_.emplace_back([this, i]()
+                                                  { pimpl_->worker_loop(i); });
+                }
+                while (pimpl_->workers_.size() > workers)
+                {
+                    retired.push_back(std::move(pimpl_->workers_.back()));
+                    pimpl_->workers_.pop_back();
+                }
+            }
+            pimpl_->queue_cv_.notify_all();
+            for (auto &worker : retired)
+            {
+                worker.join();
+            }
+            return workers;
+        }
+
+        size_t TransactionBuilderPool::worker_count() const
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->queue_mutex_);
+            return pimpl_->workers_.size();
+        }
+
+        size_t TransactionBuilderPool::queue_depth() const
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->queue_mutex_);
+            return pimpl_->queue_.size();
+        }
+
+        TransactionBuilderPool::PoolStats TransactionBuilderPool::get_statistics() const
+        {
+            PoolStats stats{};
+            stats.requests_queued = pimpl_->requests_queued_.load(std::memory_order_relaxed);
+            stats.requests_rejected = pimpl_->requests_rejected_.load(std::memory_order_relaxed);
+            stats.transactions_built = pimpl_->transactions_built_.load(std::memory_order_relaxed);
+            stats.transactions_submitted = pimpl_->transactions_submitted_.load(std::memory_order_relaxed);
+            stats.builds_failed = pimpl_->builds_failed_.load(std::memory_order_relaxed);
+            const uint64_t attempts = pimpl_->builds_timed_.load(std::memory_order_relaxed);
+            stats.avg_build_time_ms = attempts == 0
+                                          ? 0.0
+                                          : static_cast<double>(pimpl_->build_time_ns_.load(std::memory_order_relaxed)) /
+                                                static_cast<double>(attempts) / 1e6;
+            return stats;
+        }
+
+    } // namespace core
+} // namespace cardano_iot
@@ -0,0 +1,854 @@
+#include "cardano_iot/core/transaction_cbor.h"
+#include "cardano_iot/utils/codec.h"
+
+#include <algorithm>
+
+namespace cardano_iot
+{
+    namespace core
+    {
+        namespace cbor
+        {
+            namespace
+            {
+                // Transaction body keys (Cardano ledger CDDL)
+                constexpr uint64_t kBodyInputs = 0;
+                constexpr uint64_t kBodyOutputs = 1;
+                constexpr uint64_t kBodyFee = 2;
+                constexpr uint64_t kBodyTtl = 3;
+                constexpr uint64_t kBodyCertificates = 4;
+                constexpr uint64_t kBodyWithdrawals = 5;
+
+                // Post-Alonzo output map keys
+                constexpr uint64_t kOutputAddress = 0;
+                constexpr uint64_t kOutputValue = 1;
+                constexpr uint64_t kOutputDatum = 2;
+                constexpr uint64_t kOutputScriptRef = 3;
+                constexpr uint64_t kInlineDatum = 1;
+
+                constexpr uint64_t kWitnessVkeys = 0;
+
+                // Metadata labels used for the SDK's TransactionMetadata fields
+                constexpr uint64_t kMetadataLabels = 1;
+                constexpr uint64_t kMetadataJson = 2;
+                constexpr uint64_t kMetadataBinary = 3;
+
+                // Ledger limit on metadata text/bytes; longer values become chunk arrays
+                constexpr size_t kMetadatumChunk = 64;
+
+                constexpr size_t kVkeySize = 32;
+                constexpr size_t kSignatureSize = 64;
+
+                // Byte string for hex ids, text string otherwise
+                void write_id(CborWriter &w, std::string_view id)
+                {
+                    if (is_hex_id(id))
+                    {
+                        w.write_hex_bytes(id);
+                    }
+                    else
+                    {
+                        w.write_text(id);
+                    }
+                }
+
+                bool read_id(CborReader &r, std::string &out)
+                {
+                    std::string_view value;
+                    if (r.peek_major() == 2)
+                    {
+                        if (!r.read_bytes(value))
+                            return false;
+                        out = utils::codec::hex_encode(value);
+                        return true;
+                    }
+                    if (!r.read_text(value))
+                        return false;
+                    out.assign(value);
+                    return true;
+                }
+
+                // Split at a UTF-8 boundary so every chunk stays valid text
+                size_t text_chunk_length(std::string_view text)
+                {
+                    if (text.size() <= kMetadatumChunk)
+                        return text.size();
+                    size_t len = kMetadatumChunk;
+                    while (len > 0 && (static_cast<uint8_t>(text[len]) & 0xC0) == 0x80)
+                        --len;
+                    return len > 0 ? len : kMetadatumChunk;
+                }
+
+                void write_chunked_text(CborWriter &w, std::string_view text)
+                {
+                    if (text.size() <= kMetadatumChunk)
+                    {
+                        w.write_text(text);
+                        return;
+                    }
+                    size_t chunks = 0;
+                    for (std::string_view rest = text; !rest.empty(); ++chunks)
+                        rest.remove_prefix(text_chunk_length(rest));
+                    w.write_array(chunks);
+                    for (std::string_view rest = text; !rest.empty();)
+                    {
+                        const size_t len = text_chunk_length(rest);
+                        w.write_text(rest.substr(0, len));
+                        rest.remove_prefix(len);
+                    }
+                }
+
+                void write_chunked_bytes(CborWriter &w, const std::vector<uint8_t> &bytes)
+                {
+                    if (bytes.size() <= kMetadatumChunk)
+                    {
+                        w.write_bytes(bytes.data(), bytes.size());
+                        return;
+                    }
+                    w.write_array((bytes.size() + kMetadatumChunk - 1) / kMetadatumChunk);
+                    for (size_t i = 0; i < bytes.size(); i += kMetadatumChunk)
+                        w.write_bytes(bytes.data() + i, std::min(kMetadatumChunk, bytes.size() - i));
+                }
+
+                // Reads a text string or an array of text chunks (major 3) / byte chunks (major 2)
+                template <typename Out>
+                bool read_chunked(CborReader &r, int major, Out &out)
+                {
+                    std::string_view piece;
+                    auto read_piece = [&]()
+                    {
+                        return major == 3 ? r.read_text(piece) : r.read_bytes(piece);
+                    };
+
+                    out.clear();
+                    if (r.peek_major() == 4)
+                    {
+                        size_t chunks;
+                        if (!r.read_array(chunks))
+                            return false;
+                        for (size_t i = 0; i < chunks; ++i)
+                        {
+                            if (!read_piece())
+                                return false;
+                            out.insert(out.end(), piece.begin(), piece.end());
+                        }
+                        return true;
+                    }
+                    if (!read_piece())
+                        return false;
+                    out.insert(out.end(), piece.begin(), piece.end());
+                    return true;
+                }
+
+                void write_value(CborWriter &w, uint64_t lovelace, const std::map<std::string, uint64_t> &tokens)
+                {
+                    if (tokens.empty())
+                    {
+                        w.write_uint(lovelace);
+                        return;
+                    }
+
+                    // Keys are "policy.asset"; the map ordering keeps each policy's assets adjacent
+                    auto policy_of = [](const std::string &key)
+                    {
+                        std::string_view sv(key);
+                        return sv.substr(0, sv.find('.'));
+                    };
+
+                    size_t policies = 0;
+                    std::string_view previous;
+                    for (const auto &entry : tokens)
+                    {
+                        auto policy = policy_of(entry.first);
+                        if (policies == 0 || policy != previous)
+                            ++policies;
+                        previous = policy;
+                    }
+
+                    w.write_array(2);
+                    w.write_uint(lovelace);
+                    w.write_map(policies);
+
+                    for (auto it = tokens.begin(); it != tokens.end();)
+                    {
+                        const auto policy = policy_of(it->first);
+                        auto group_end = it;
+                        size_t assets = 0;
+                        while (group_end != tokens.end() && policy_of(group_end->first) == policy)
+                        {
+                            ++assets;
+                            ++group_end;
+                        }
+
+                        write_id(w, policy);
+                        w.write_map(assets);
+                        for (; it != group_end; ++it)
+                        {
+                            std::string_view key(it->first);
+                            const size_t dot = key.find('.');
+                            std::string_view asset = dot == std::string_view::npos ? std::string_view() : key.substr(dot + 1);
+                            w.write_bytes(reinterpret_cast<const uint8_t *>(asset.data()), asset.size());
+                            w.write_uint(it->second);
+                        }
+                    }
+                }
+
+                bool read_value(CborReader &r, uint64_t &lovelace, std::map<std::string, uint64_t> &tokens)
+                {
+                    if (r.peek_major() == 0)
+                        return r.read_uint(lovelace);
+
+                    size_t count, policies;
+                    if (!r.read_array(count) || count != 2 || !r.read_uint(lovelace) || !r.read_map(policies))
+                        return false;
+
+                    std::string policy;
+                    for (size_t p = 0; p < policies; ++p)
+                    {
+                        size_t assets;
+                        if (!read_id(r, policy) || !r.read_map(assets))
+                            return false;
+                        for (size_t a = 0; a < assets; ++a)
+                        {
+                            std::string_view asset;
+                            uint64_t amount;
+                            if (!r.read_bytes(asset) || !r.read_uint(amount))
+                                return false;
+                            std::string key = policy;
+                            if (!asset.empty())
+                            {
+                                key += '.';
+                                key.append(asset);
+                            }
+                            tokens[std::move(key)] = amount;
+                        }
+                    }
+                    return true;
+                }
+
+                void write_output(CborWriter &w, const TransactionOutput &output)
+                {
+                    if (output.datum.empty() && output.script_ref.empty())
+                    {
+                        // Legacy [address, value] form is the most compact
+                        w.write_array(2);
+                        write_id(w, output.address);
+                        write_value(w, output.amount_lovelace, output.native_tokens);
+                        return;
+                    }
+
+                    w.write_map(2 + (output.datum.empty() ? 0 : 1) + (output.script_ref.empty() ? 0 : 1));
+                    w.write_uint(kOutputAddress);
+                    write_id(w, output.address);
+                    w.write_uint(kOutputValue);
+                    write_value(w, output.amount_lovelace, output.native_tokens);
+                    if (!output.datum.empty())
+                    {
+                        w.write_uint(kOutputDatum);
+                        w.write_array(2);
+                        w.write_uint(kInlineDatum);
+                        write_id(w, output.datum);
+                    }
+                    if (!output.script_ref.empty())
+                    {
+                        w.write_uint(kOutputScriptRef);
+                        write_id(w, output.script_ref);
+                    }
+                }
+
+                bool read_output(CborReader &r, TransactionOutput &output)
+                {
+                    output.amount_lovelace = 0;
+                    size_t count;
+                    if (r.peek_major() == 4)
+                    {
+                        return r.read_array(count) && count == 2 && read_id(r, output.address) &&
+                               read_value(r, output.amount_lovelace, output.native_tokens);
+                    }
+
+                    if (!r.read_map(count))
+                        return false;
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        uint64_t key;
+                        if (!r.read_uint(key))
+                            return false;
+                        bool ok = true;
+                        switch (key)
+                        {
+                        case kOutputAddress:
+                            ok = read_id(r, output.address);
+                            break;
+                        case kOutputValue:
+                            ok = read_value(r, output.amount_lovelace, output.native_tokens);
+                            break;
+                        case kOutputDatum:
+                        {
+                            size_t n;
+                            uint64_t kind;
+                            ok = r.read_array(n) && n == 2 && r.read_uint(kind) && read_id(r, output.datum);
+                            break;
+                        }
+                        case kOutputScriptRef:
+                            ok = read_id(r, output.script_ref);
+                            break;
+                        default:
+                            ok = r.skip();
+                        }
+                        if (!ok)
+                            return false;
+                    }
+                    return true;
+                }
+
+                void write_id_array(CborWriter &w, const std::vector<std::string> &ids)
+                {
+                    w.write_array(ids.size());
+                    for (const auto &id : ids)
+                        write_id(w, id);
+                }
+
+                bool read_id_array(CborReader &r, std::vector<std::string> &ids)
+                {
+                    size_t count;
+                    if (!r.read_array(count))
+                        return false;
+                    ids.resize(count);
+                    for (auto &id : ids)
+                    {
+                        if (!read_id(r, id))
+                            return false;
+                    }
+                    return true;
+                }
+
+                // Ed25519 witnesses are hex(vkey || signature); others are opaque ids
+                bool is_vkey_witness(std::string_view witness)
+                {
+                    return witness.size() == 2 * (kVkeySize + kSignatureSize) && is_hex_id(witness);
+                }
+
+                void write_witness_set(CborWriter &w, const std::vector<std::string> &witnesses)
+                {
+                    if (witnesses.empty())
+                    {
+                        w.write_map(0);
+                        return;
+                    }
+                    w.write_map(1);
+                    w.write_uint(kWitnessVkeys);
+                    w.write_array(witnesses.size());
+                    for (const auto &witness : witnesses)
+                    {
+                        if (is_vkey_witness(witness))
+                        {
+                            std::string_view sv(witness);
+                            w.write_array(2);
+                            w.write_hex_bytes(sv.substr(0, 2 * kVkeySize));
+                            w.write_hex_bytes(sv.substr(2 * kVkeySize));
+                        }
+                        else
+                        {
+                            write_id(w, witness);
+                        }
+                    }
+                }
+
+                bool read_witness_set(CborReader &r, std::vector<std::string> &witnesses)
+                {
+                    size_t entries;
+                    if (!r.read_map(entries))
+                        return false;
+                    for (size_t e = 0; e < entries; ++e)
+                    {
+                        uint64_t key;
+                        if (!r.read_uint(key))
+                            return false;
+                        if (key != kWitnessVkeys)
+                        {
+                            if (!r.skip())
+                                return false;
+                            continue;
+                        }
+
+                        size_t count;
+                        if (!r.read_array(count))
+                            return false;
+                        for (size_t i = 0; i < count; ++i)
+                        {
+                            std::string witness;
+                            if (r.peek_major() == 4)
+                            {
+                                size_t n;
+                                std::string_view vkey, signature;
+                                if (!r.read_array(n) || n != 2 || !r.read_bytes(vkey) || !r.read_bytes(signature))
+                                    return false;
+                                witness = utils::codec::hex_encode(vkey);
+                                witness += utils::codec::hex_encode(signature);
+                            }
+                            else if (!read_id(r, witness))
+                            {
+                                return false;
+                            }
+                            witnesses.push_back(std::move(witness));
+                        }
+                    }
+                    return true;
+                }
+
+                bool has_metadata(const Transaction &tx)
+                {
+                    const auto *m = tx.metadata.get();
+                    return m && (!m->labels.empty() || !m->json_metadata.empty() || !m->binary_metadata.empty());
+                }
+
+                void write_auxiliary_data(CborWriter &w, const TransactionMetadata &metadata)
+                {
+                    w.write_map((metadata.labels.empty() ? 0 : 1) + (metadata.json_metadata.empty() ? 0 : 1) +
+                                (metadata.binary_metadata.empty() ? 0 : 1));
+                    if (!metadata.labels.empty())
+                    {
+                        w.write_uint(kMetadataLabels);
+                        w.write_map(metadata.labels.size());
+                        for (const auto &[key, value] : metadata.labels)
+                        {
+                            write_chunked_text(w, key);
+                            write_chunked_text(w, value);
+                        }
+                    }
+                    if (!metadata.json_metadata.empty())
+                    {
+                        w.write_uint(kMetadataJson);
+                        write_chunked_text(w, metadata.json_metadata);
+                    }
+                    if (!metadata.binary_metadata.empty())
+                    {
+                        w.write_uint(kMetadataBinary);
+                        write_chunked_bytes(w, metadata.binary_metadata);
+                    }
+                }
+
+                bool read_auxiliary_data(CborReader &r, TransactionMetadata &metadata)
+                {
+                    size_t entries;
+                    if (!r.read_map(entries))
+                        return false;
+                    for (size_t e = 0; e < entries; ++e)
+                    {
+                        uint64_t label;
+                        if (!r.read_uint(label))
+                            return false;
+                        bool ok = true;
+                        switch (label)
+                        {
+                        case kMetadataLabels:
+                        {
+                            size_t count;
+                            ok = r.read_map(count);
+                            std::string key, value;
+                            for (size_t i = 0; ok && i < count; ++i)
+                            {
+                                ok = read_chunked(r, 3, key) && read_chunked(r, 3, value);
+                                if (ok)
+                                    metadata.labels[key] = value;
+                            }
+                            break;
+                        }
+                        case kMetadataJson:
+                            ok = read_chunked(r, 3, metadata.json_metadata);
+                            break;
+                        case kMetadataBinary:
+                            ok = read_chunked(r, 2, metadata.binary_metadata);
+                            break;
+                        default:
+                            ok = r.skip();
+                        }
+                        if (!ok)
+                            return false;
+                    }
+                    return true;
+                }
+
+                bool read_transaction_body(CborReader &r, Transaction &tx)
+                {
+                    size_t entries;
+                    if (!r.read_map(entries))
+                        return false;
+                    for (size_t e = 0; e < entries; ++e)
+                    {
+                        uint64_t key;
+                        if (!r.read_uint(key))
+                            return false;
+                        bool ok = true;
+                        switch (key)
+                        {
+                        case kBodyInputs:
+                        {
+                            size_t count;
+                            ok = r.read_array(count);
+                            if (ok)
+                                tx.inputs.resize(count);
+                            for (size_t i = 0; ok && i < count; ++i)
+                            {
+                                size_t n;
+                                uint64_t index;
+                                ok = r.read_array(n) && n == 2 && read_id(r, tx.inputs[i].tx_hash) && r.read_uint(index);
+                                tx.inputs[i].output_index = static_cast<uint32_t>(index);
+                            }
+                            break;
+                        }
+                        case kBodyOutputs:
+                        {
+                            size_t count;
+                            ok = r.read_array(count);
+                            if (ok)
+                                tx.outputs.resize(count);
+                            for (size_t i = 0; ok && i < count; ++i)
+                                ok = read_output(r, tx.outputs[i]);
+                            break;
+                        }
+                        case kBodyFee:
+                            ok = r.read_uint(tx.fee);
+                            break;
+                        case kBodyTtl:
+                            ok = r.read_uint(tx.ttl);
+                            break;
+                        case kBodyCertificates:
+                            ok = read_id_array(r, tx.certificates);
+                            break;
+                        case kBodyWithdrawals:
+                            ok = read_id_array(r, tx.withdrawals);
+                            break;
+                        default:
+                            ok = r.skip();
+                        }
+                        if (!ok)
+                            return false;
+                    }
+                    return true;
+                }
+            } // namespace
+
+            // CborWriter
+
+            size_t CborWriter::head_size(uint64_t value)
+            {
+                if (value < 24)
+                    return 1;
+                if (value <= 0xff)
+                    return 2;
+                if (value <= 0xffff)
+                    return 3;
+                if (value <= 0xffffffffULL)
+                    return 5;
+                return 9;
+            }
+
+            void CborWriter::write_head(uint8_t major, uint64_t value)
+            {
+                const size_t length = head_size(value);
+                size_ += length;
+                if (!out_)
+                    return;
+
+                const uint8_t type = static_cast<uint8_t>(major << 5);
+                switch (length)
+                {
+                case 1:
+                    out_->push_back(static_cast<uint8_t>(type | value));
+                    return;
+                case 2:
+                    out_->push_back(type | 24);
+                    break;
+                case 3:
+                    out_->push_back(type | 25);
+                    break;
+                case 5:
+                    out_->push_back(type | 26);
+                    break;
+                default:
+                    out_->push_back(type | 27);
+                    break;
+                }
+                for (size_t shift = (length - 1) * 8; shift > 0;)
+                {
+                    shift -= 8;
+                    out_->push_back(static_cast<uint8_t>(value >> shift));
+                }
+            }
+
+            void CborWriter::write_simple(uint8_t byte)
+            {
+                ++size_;
+                if (out_)
+                    out_->push_back(byte);
+            }
+
+            void CborWriter::write_bytes(const uint8_t *data, size_t length)
+            {
+                write_head(2, length);
+                size_ += length;
+                if (out_ && length > 0)
+                    out_->insert(out_->end(), data, data + length);
+            }
+
+            void CborWriter::write_text(std::string_view text)
+            {
+                write_head(3, text.size());
+                size_ += text.size();
+                if (out_ && !text.empty())
+                    out_->insert(out_->end(), text.begin(), text.end());
+            }
+
+            void CborWriter::write_hex_bytes(std::string_view hex)
+            {
+                const size_t length = hex.size() / 2;
+                write_head(2, length);
+                size_ += length;
+                if (out_ && length > 0)
+                {
+                    const size_t offset = out_->size();
+                    out_->resize(offset + length);
+                    utils::codec::hex_decode(hex.data(), hex.size(), out_->data() + offset);
+                }
+            }
+
+            // CborReader
+
+            bool CborReader::read_head(uint8_t &major, uint64_t &value)
+            {
+                if (pos_ >= end_)
+                    return false;
+                const uint8_t initial = *pos_++;
+                major = initial >> 5;
+                const uint8_t info = initial & 0x1f;
+                if (info < 24)
+                {
+                    value = info;
+                    return true;
+                }
+                if (info > 27)
+                    return false; // indefinite lengths and reserved values are not produced by the encoder
+
+                const size_t length = size_t(1) << (info - 24);
+                if (static_cast<size_t>(end_ - pos_) < length)
+                    return false;
+                value = 0;
+                for (size_t i = 0; i < length; ++i)
+                    value = (value << 8) | *pos_++;
+                return true;
+            }
+
+            int CborReader::peek_major() const
+            {
+                return pos_ < end_ ? (*pos_ >> 5) : -1;
+            }
+
+            bool CborReader::read_uint(uint64_t &value)
+            {
+                uint8_t major;
+                return peek_major() == 0 && read_head(major, value);
+            }
+
+            bool CborReader::read_array(size_t &count)
+            {
+                uint8_t major;
+                uint64_t value;
+                if (peek_major() != 4 || !read_head(major, value) || value > static_cast<uint64_t>(end_ - pos_))
+                    return false; // every element takes at least one byte
+                count = static_cast<size_t>(value);
+                return true;
+            }
+
+            bool CborReader::read_map(size_t &count)
+            {
+                uint8_t major;
+                uint64_t value;
+                if (peek_major() != 5 || !read_head(major, value) || value > static_cast<uint64_t>(end_ - pos_) / 2)
+                    return false;
+                count = static_cast<size_t>(value);
+                return true;
+            }
+
+            bool CborReader::read_bytes(std::string_view &bytes)
+            {
+                uint8_t major;
+                uint64_t length;
+                if (peek_major() != 2 || !read_head(major, length) || length > static_cast<uint64_t>(end_ - pos_))
+                    return false;
+                bytes = std::string_view(reinterpret_cast<const char *>(pos_), static_cast<size_t>(length));
+                pos_ += length;
+                return true;
+            }
+
+            bool CborReader::read_text(std::string_view &text)
+            {
+                uint8_t major;
+                uint64_t length;
+                if (peek_major() != 3 || !read_head(major, length) || length > static_cast<uint64_t>(end_ - pos_))
+                    return false;
+                text = std::string_view(reinterpret_cast<const char *>(pos_), static_cast<size_t>(length));
+                pos_ += length;
+                return true;
+            }
+
+            bool CborReader::read_bool(bool &value)
+            {
+                if (pos_ >= end_ || (*pos_ != 0xf4 && *pos_ != 0xf5))
+                    return false;
+                value = *pos_++ == 0xf5;
+                return true;
+            }
+
+            bool CborReader::try_read_null()
+            {
+                if (pos_ < end_ && *pos_ == 0xf6)
+                {
+                    ++pos_;
+                    return true;
+                }
+                return false;
+            }
+
+            bool CborReader::skip()
+            {
+                return skip_depth(0);
+            }
+
+            bool CborReader::skip_depth(int depth)
+            {
+                if (depth > 64)
+                    return false;
+
+                uint8_t major;
+                uint64_t value;
+                if (!read_head(major, value))
+                    return false;
+
+                switch (major)
+                {
+                case 2:
+                case 3:
+                    if (value > static_cast<uint64_t>(end_ - pos_))
+                        return false;
+                    pos_ += value;
+                    return true;
+                case 4:
+                case 5:
+                {
+                    const uint64_t items = major == 5 ? value * 2 : value;
+                    for (uint64_t i = 0; i < items; ++i)
+                    {
+                        if (!skip_depth(depth + 1))
+                            return false;
+                    }
+                    return true;
+                }
+                case 6:
+                    return skip_depth(depth + 1); // tagged item
+                default:
+                    return true; // integers and simple values carry no payload
+                }
+            }
+
+            // Transaction encoding
+
+            bool is_hex_id(std::string_view id)
+            {
+                if (id.empty() || id.size() % 2 != 0)
+                    return false;
+                return std::all_of(id.begin(), id.end(), [](char c)
+                                   { return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F'); });
+            }
+
+            void encode_transaction_body(const Transaction &tx, CborWriter &w)
+            {
+                const bool has_ttl = tx.ttl != 0;
+                w.write_map(3 + (has_ttl ? 1 : 0) + (tx.certificates.empty() ? 0 : 1) + (tx.withdrawals.empty() ? 0 : 1));
+
+                w.write_uint(kBodyInputs);
+                w.write_array(tx.inputs.size());
+                for (const auto &input : tx.inputs)
+                {
+                    w.write_array(2);
+                    write_id(w, input.tx_hash);
+                    w.write_uint(input.output_index);
+                }
+
+                w.write_uint(kBodyOutputs);
+                w.write_array(tx.outputs.size());
+                for (const auto &output : tx.outputs)
+                    write_output(w, output);
+
+                w.write_uint(kBodyFee);
+                w.write_uint(tx.fee);
+
+                if (has_ttl)
+                {
+                    w.write_uint(kBodyTtl);
+                    w.write_uint(tx.ttl);
+                }
+                if (!tx.certificates.empty())
+                {
+                    w.write_uint(kBodyCertificates);
+                    write_id_array(w, tx.certificates);
+                }
+                if (!tx.withdrawals.empty())
+                {
+                    w.write_uint(kBodyWithdrawals);
+                    write_id_array(w, tx.withdrawals);
+                }
+            }
+
+            void encode_transaction(const Transaction &tx, CborWriter &w)
+            {
+                w.write_array(4);
+                encode_transaction_body(tx, w);
+                write_witness_set(w, tx.witnesses);
+                w.write_bool(true);
+                if (has_metadata(tx))
+                    write_auxiliary_data(w, *tx.metadata);
+                else
+                    w.write_null();
+            }
+
+            size_t encoded_size(const Transaction &tx)
+            {
+                CborWriter counter;
+                encode_transaction(tx, counter);
+                return counter.size();
+            }
+
+            size_t vkey_witness_set_size(size_t witness_count)
+            {
+                if (witness_count == 0)
+                    return 1; // empty map
+                const size_t witness_size = 1 + CborWriter::head_size(kVkeySize) + kVkeySize +
+                                            CborWriter::head_size(kSignatureSize) + kSignatureSize;
+                return 1 + 1 + CborWriter::head_size(witness_count) + witness_count * witness_size;
+            }
+
+            bool decode_transaction(const uint8_t *data, size_t length, Transaction &tx)
+            {
+                CborReader r(data, length);
+                size_t count;
+                bool is_valid;
+                if (!r.read_array(count) || count != 4 || !read_transaction_body(r, tx) ||
+                    !read_witness_set(r, tx.witnesses) || !r.read_bool(is_valid))
+                {
+                    return false;
+                }
+
+                if (!r.try_read_null())
+                {
+                    auto metadata = std::make_unique<TransactionMetadata>();
+                    if (!read_auxiliary_data(r, *metadata))
+                        return false;
+                    tx.metadata = std::move(metadata);
+                }
+                return r.at_end();
+            }
+
+        } // namespace cbor
+    } // namespace core
+} // namespace cardano_iot
@@ -0,0 +1,555 @@
+#include "cardano_iot/core/transaction_history.h"
+#include "cardano_iot/core/transaction_cbor.h"
+#include "cardano_iot/utils/hash.h"
+#include "cardano_iot/utils/logger.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace cardano_iot
+{
+    namespace core
+    {
+        namespace
+        {
+            constexpr char MAGIC[8] = {'C', 'I', 'O', 'T', 'T', 'X', 'A', 'R'};
+            constexpr size_t HEADER_BYTES = 16;
+            constexpr size_t FRAME_BYTES = 8;
+            constexpr uint32_t MAX_RECORD_BYTES = 16 * 1024 * 1024;
+
+            void put_u32(std::string &out, uint32_t value)
+            {
+                for (int i = 0; i < 4; ++i)
+                {
+                    out.push_back(static_cast<char>(value >> (8 * i)));
+                }
+            }
+
+            uint32_t get_u32(const uint8_t *in)
+            {
+                return uint32_t(in[0]) | uint32_t(in[1]) << 8 | uint32_t(in[2]) << 16 | uint32_t(in[3]) << 24;
+            }
+
+            void put_varint(std::string &out, uint64_t value)
+            {
+                while (value >= 0x80)
+                {
+                    out.push_back(static_cast<char>(value | 0x80));
+                    value >>= 7;
+                }
+                out.push_back(static_cast<char>(value));
+            }
+
+            void put_string(std::string &out, const std::string &value)
+            {
+                put_varint(out, value.size());
+                out.append(value);
+            }
+
+            struct Reader
+            {
+                const uint8_t *data;
+                size_t size;
+                size_t offset = 0;
+
+                bool varint(uint64_t &value)
+                {
+                    value = 0;
+                    for (unsigned shift = 0; shift < 64 && offset < size; shift += 7)
+                    {
+                        const uint8_t byte = data[offset++];
+                        value |= uint64_t(byte & 0x7F) << shift;
+                        if ((byte & 0x80) == 0)
+                        {
+                            return true;
+                        }
+                    }
+                    return false;
+                }
+
+                bool bytes(const uint8_t *&start, size_t &length)
+                {
+                    uint64_t value = 0;
+                    if (!varint(value) || value > size - offset)
+                    {
+                        return false;
+                    }
+                    start = data + offset;
+                    length = static_cast<size_t>(value);
+                    offset += length;
+                    return true;
+                }
+
+                bool string(std::string &value)
+                {
+                    const uint8_t *start = nullptr;
+                    size_t length = 0;
+                    if (!bytes(start, length))
+                    {
+                        return false;
+                    }
+                    value.assign(reinterpret_cast<const char *>(start), length);
+                    return true;
+                }
+            };
+
+            bool write_all(int fd, const char *data, size_t size, uint64_t offset)
+            {
+                while (size > 0)
+                {
+                    const ssize_t written = ::pwrite(fd, data, size, static_cast<off_t>(offset));
+                    if (written < 0 && errno == EINTR)
+                    {
+                        continue;
+                    }
+                    if (written <= 0)
+                    {
+                        return false;
+                    }
+                    data += written;
+                    size -= static_cast<size_t>(written);
+                    offset += static_cast<uint64_t>(written);
+                }
+                return true;
+            }
+
+            bool read_all(int fd, void *out, size_t size, uint64_t offset)
+            {
+                char *data = static_cast<char *>(out);
+                while (size > 0)
+                {
+                    const ssize_t got = ::pread(fd, data, size, static_cast<off_t>(offset));
+                    if (got < 0 && errno == EINTR)
+                    {
+                        continue;
+                    }
+                    if (got <= 0)
+                    {
+                        return false;
+                    }
+                    data += got;
+                    size -= static_cast<size_t>(got);
+                    offset += static_cast<uint64_t>(got);
+                }
+                return true;
+            }
+
+            // Walk the framed records from the header on; returns the end of the last intact one
+            template <typename Fn>
+            uint64_t for_each_frame(int fd, uint64_t file_size, std::vector<uint8_t> &body, Fn &&fn)
+            {
+                uint64_t offset = HEADER_BYTES;
+                uint8_t frame[FRAME_BYTES];
+                while (offset + FRAME_BYTES <= file_size && read_all(fd, frame, FRAME_BYTES, offset))
+                {
+                    const uint32_t length = get_u32(frame);
+                    if (length == 0 || length > MAX_RECORD_BYTES || length > file_size - offset - FRAME_BYTES)
+                    {
+                        break;
+                    }
+                    body.resize(length);
+                    if (!read_all(fd, body.data(), length, offset + FRAME_BYTES) ||
+                        utils::crc32(body.data(), length) != get_u32(frame + 4))
+                    {
+                        break;
+                    }
+                    offset += FRAME_BYTES + length;
+                    if (!fn(body.data(), body.size()))
+                    {
+                        break;
+                    }
+                }
+                return offset;
+            }
+        } // namespace
+
+        // ---------------------------------------------------------------- archive
+
+        TransactionArchive::~TransactionArchive()
+        {
+            close();
+        }
+
+        bool TransactionArchive::open(const std::string &path)
+        {
+            close();
+            const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+            if (fd < 0)
+            {
+                utils::Logger::instance().log(utils::LogLevel::ERROR, "TransactionArchive",
+                                              "Cannot open archive: " + path);
+                return false;
+            }
+
+            struct stat info;
+            uint64_t file_size = ::fstat(fd, &info) == 0 ? static_cast<uint64_t>(info.st_size) : 0;
+            if (file_size < HEADER_BYTES)
+            {
+                // New, or crashed while creating it: start it over
+                std::string header(MAGIC, sizeof(MAGIC));
+                put_u32(header, FORMAT_VERSION);
+                put_u32(header, 0);
+                if (::ftruncate(fd, 0) != 0 || !write_all(fd, header.data(), header.size(), 0))
+                {
+                    ::close(fd);
+                    return false;
+                }
+                fd_ = fd;
+                size_ = HEADER_BYTES;
+                record_count_ = 0;
+                return true;
+            }
+
+            uint8_t header[HEADER_BYTES];
+            if (!read_all(fd, header, HEADER_BYTES, 0) || std::memcmp(header, MAGIC, sizeof(MAGIC)) != 0 ||
+                get_u32(header + 8) != FORMAT_VERSION)
+            {
+                utils::Logger::instance().log(utils::LogLevel::ERROR, "TransactionArchive",
+                                              "Not a transaction archive: " + path);
+                ::close(fd);
+                return false;
+            }
+
+            uint64_t records = 0;
+            std::vector<uint8_t> body;
+            const uint64_t end = for_each_frame(fd, file_size, body, [&records](const uint8_t *, size_t)
+                                                {
+                                                    ++records;
+                                                    return true; });
+            if (end < file_size)
+            {
+                utils::Logger::instance().log(utils::LogLevel::WARNING, "TransactionArchive",
+                                              "Cut off " + std::to_string(file_size - end) + " torn bytes from " + path);
+                if (::ftruncate(fd, static_cast<off_t>(end)) != 0)
+                {
+                    ::close(fd);
+                    return false;
+                }
+            }
+            fd_ = fd;
+            size_ = end;
+            record_count_ = records;
+            return true;
+        }
+
+        void TransactionArchive::close()
+        {
+            if (fd_ >= 0)
+            {
+                ::close(fd_);
+                fd_ = -1;
+            }
+            size_ = 0;
+            record_count_ = 0;
+        }
+
+        bool TransactionArchive::append(const Transaction &transaction)
+        {
+            if (fd_ < 0)
+            {
+                return false;
+            }
+            scratch_.clear();
+            scratch_.append(FRAME_BYTES, '\0');
+            encode(transaction, scratch_);
+            const uint32_t length = static_cast<uint32_t>(scratch_.size() - FRAME_BYTES);
+            if (length > MAX_RECORD_BYTES)
+            {
+                return false;
+            }
+            std::string frame;
+            put_u32(frame, length);
+            put_u32(frame, utils::crc32(scratch_.data() + FRAME_BYTES, length));
+            std::memcpy(&scratch_[0], frame.data(), FRAME_BYTES);
+            if (!write_all(fd_, scratch_.data(), scratch_.size(), size_))
+            {
+                return false;
+            }
+            size_ += scratch_.size();
+            ++record_count_;
+            return true;
+        }
+
+        bool TransactionArchive::sync()
+        {
+            return fd_ >= 0 && ::fdatasync(fd_) == 0;
+        }
+
+        bool TransactionArchive::scan(const Visitor &visitor) const
+        {
+            if (fd_ < 0)
+            {
+                return false;
+            }
+            std::vector<uint8_t> body;
+            for_each_frame(fd_, size_, body, [&visitor](const uint8_t *data, size_t size)
+                           {
+                               Transaction transaction;
+                               return !decode(data, size, transaction) || visitor(transaction); });
+            return true;
+        }
+
+        std::unique_ptr<Transaction> TransactionArchive::find(const std::string &tx_id) const
+        {
+            std::unique_ptr<Transaction> found;
+            scan([&](const Transaction &transaction)
+                 {
+                     if (transaction.tx_id != tx_id)
+                     {
+                         return true;
+                     }
+                     found = std::make_unique<Transaction>(transaction);
+                     return false; });
+            return found;
+        }
+
+        void TransactionArchive::encode(const Transaction &transaction, std::string &out)
+        {
+            put_varint(out, static_cast<uint64_t>(transaction.type));
+            put_varint(out, static_cast<uint64_t>(transaction.status));
+            put_varint(out, transaction.created_timestamp);
+            put_varint(out, transaction.submitted_timestamp);
+            put_varint(out, transaction.confirmed_timestamp);
+            put_string(out, transaction.tx_id);
+            put_string(out, transaction.device_id);
+            put_string(out, transaction.error_message);
+
+            std::vector<uint8_t> cbor_bytes;
+            cbor::CborWriter writer(&cbor_bytes);
+            cbor::encode_transaction(transaction, writer);
+            put_varint(out, cbor_bytes.size());
+            out.append(reinterpret_cast<const char *>(cbor_bytes.data()), cbor_bytes.size());
+        }
+
+        bool TransactionArchive::decode(const uint8_t *data, size_t size, Transaction &transaction)
+        {
+            Reader reader{data, size};
+            uint64_t type = 0;
+            uint64_t status = 0;
+            const uint8_t *cbor_bytes = nullptr;
+            size_t cbor_size = 0;
+            if (!reader.varint(type) || !reader.varint(status) || type > static_cast<uint64_t>(TransactionType::CERTIFICATE) ||
+                status > static_cast<uint64_t>(TransactionStatus::CANCELLED) ||
+                !reader.varint(transaction.created_timestamp) || !reader.varint(transaction.submitted_timestamp) ||
+                !reader.varint(transaction.confirmed_timestamp) || !reader.string(transaction.tx_id) ||
+                !reader.string(transaction.device_id) || !reader.string(transaction.error_message) ||
+                !reader.bytes(cbor_bytes, cbor_size) || reader.offset != size ||
+                !cbor::decode_transaction(cbor_bytes, cbor_size, transaction))
+            {
+                return false;
+            }
+            transaction.type = static_cast<TransactionType>(type);
+            transaction.status = static_cast<TransactionStatus>(status);
+            return true;
+        }
+
+        // ---------------------------------------------------------------- history
+
+        TransactionSummary TransactionHistory::summarize(const Transaction &transaction)
+        {
+            TransactionSummary summary;
+            summary.tx_id = transaction.tx_id;
+            summary.type = transaction.type;
+            summary.status = transaction.status;
+            summary.device_id = transaction.device_id;
+            summary.fee = transaction.fee;
+            for (const auto &output : transaction.outputs)
+            {
+                summary.amount_lovelace += output.amount_lovelace;
+            }
+            summary.created_timestamp = transaction.created_timestamp;
+            summary.submitted_timestamp = transaction.submitted_timestamp;
+            summary.confirmed_timestamp = transaction.confirmed_timestamp;
+            return summary;
+        }
+
+        std::shared_ptr<const Transaction> TransactionHistory::put(Transaction transaction)
+        {
+            auto existing = records_.find(transaction.tx_id);
+            if (existing != records_.end())
+            {
+                erase(existing);
+            }
+            const uint64_t sequence = next_sequence_++;
+            auto [it, inserted] = records_.emplace(transaction.tx_id, Record{});
+            it->second.sequence = sequence;
+            by_sequence_.emplace(sequence, &it->first);
+            by_status_[status_slot(transaction.status)].insert(sequence);
+            if (!transaction.device_id.empty())
+            {
+                by_device_[transaction.device_id].insert(sequence);
+            }
+            it->second.transaction = std::make_shared<Transaction>(std::move(transaction));
+            return it->second.transaction;
+        }
+
+        bool TransactionHistory::update(const std::string &tx_id, const std::function<void(Transaction &)> &change)
+        {
+            auto it = records_.find(tx_id);
+            if (it == records_.end())
+            {
+                return false;
+            }
+            auto &record = it->second;
+            // Snapshots only leave under the caller's lock, so a sole owner cannot gain readers meanwhile
+            if (record.transaction.use_count() > 1)
+            {
+                record.transaction = std::make_shared<Transaction>(*record.transaction);
+            }
+            const TransactionStatus before = record.transaction->status;
+            change(*record.transaction);
+            if (record.transaction->status != before)
+            {
+                by_status_[status_slot(before)].erase(record.sequence);
+                by_status_[status_slot(record.transaction->status)].insert(record.sequence);
+            }
+            return true;
+        }
+
+        const Transaction *TransactionHistory::find(const std::string &tx_id) const
+        {
+            auto it = records_.find(tx_id);
+            return it != records_.end() ? it->second.transaction.get() : nullptr;
+        }
+
+        std::shared_ptr<const Transaction> TransactionHistory::snapshot(const std::string &tx_id) const
+        {
+            auto it = records_.find(tx_id);
+            return it != records_.end() ? it->second.transaction : nullptr;
+        }
+
+        TransactionPage TransactionHistory::page(const std::set<uint64_t> *index, uint64_t cursor, size_t limit) const
+        {
+            TransactionPage result;
+            if (!index)
+            {
+                return result;
+            }
+            limit = std::min(std::max<size_t>(limit, 1), MAX_PAGE);
+            result.items.reserve(std::min(limit, index->size()));
+            for (auto it = index->lower_bound(cursor); it != index->end(); ++it)
+            {
+                if (result.items.size() == limit)
+                {
+                    result.next_cursor = *it;
+                    break;
+                }
+                result.items.push_back(summarize(*records_.at(*by_sequence_.at(*it)).transaction));
+            }
+            return result;
+        }
+
+        TransactionPage TransactionHistory::page_by_device(const std::string &device_id, uint64_t cursor, size_t limit) const
+        {
+            auto it = by_device_.find(device_id);
+            return page(it != by_device_.end() ? &it->second : nullptr, cursor, limit);
+        }
+
+        TransactionPage TransactionHistory::page_by_status(TransactionStatus status, uint64_t cursor, size_t limit) const
+        {
+            return page(&by_status_[status_slot(status)], cursor, limit);
+        }
+
+        std::vector<std::shared_ptr<const Transaction>> TransactionHistory::with_status(TransactionStatus status) const
+        {
+            std::vector<std::shared_ptr<const Transaction>> result;
+            const auto &index = by_status_[status_slot(status)];
+            result.reserve(index.size());
+            for (uint64_t sequence : index)
+            {
+                result.push_back(records_.at(*by_sequence_.at(sequence)).transaction);
+            }
+            return result;
+        }
+
+        std::vector<std::shared_ptr<const Transaction>> TransactionHistory::for_device(const std::string &device_id) const
+        {
+            std::vector<std::shared_ptr<const Transaction>> result;
+            auto it = by_device_.find(device_id);
+            if (it == by_device_.end())
+            {
+                return result;
+            }
+            result.reserve(it->second.size());
+            for (uint64_t sequence : it->second)
+            {
+                result.push_back(records_.at(*by_sequence_.at(sequence)).transaction);
+            }
+            return result;
+        }
+
+        size_t TransactionHistory::count(TransactionStatus status) const
+        {
+            return by_status_[status_slot(status)].size();
+        }
+
+        size_t TransactionHistory::prune(uint64_t now, uint64_t retention_seconds, TransactionArchive *archive)
+        {
+            std::vector<std::string> expired;
+            for (auto status : {TransactionStatus::CONFIRMED, TransactionStatus::FAILED, TransactionStatus::CANCELLED})
+            {
+                for (uint64_t sequence : by_status_[status_slot(status)])
+                {
+                    const auto &tx = *records_.at(*by_sequence_.at(sequence)).transaction;
+                    uint64_t finished = status == TransactionStatus::CONFIRMED ? tx.confirmed_timestamp : tx.submitted_timestamp;
+                    finished = finished != 0 ? finished : tx.created_timestamp;
+                    if (finished + retention_seconds <= now)
+                    {
+                        expired.push_back(tx.tx_id);
+                    }
+                }
+            }
+
+            size_t removed = 0;
+            for (const auto &tx_id : expired)
+            {
+                auto it = records_.find(tx_id);
+                if (archive && archive->is_open() && !archive->append(*it->second.transaction))
+                {
+                    // Keep what could not be written; the next prune retries it
+                    utils::Logger::instance().log(utils::LogLevel::ERROR, "TransactionHistory",
+                                                  "Archive write failed; keeping " + tx_id + " in memory");
+                    break;
+                }
+                erase(it);
+                ++removed;
+            }
+            return removed;
+        }
+
+        void TransactionHistory::erase(std::unordered_map<std::string, Record>::iterator it)
+        {
+            const uint64_t sequence = it->second.sequence;
+            const auto &tx = *it->second.transaction;
+            by_status_[status_slot(tx.status)].erase(sequence);
+            auto device = by_device_.find(tx.device_id);
+            if (device != by_device_.end())
+            {
+                device->second.erase(sequence);
+                if (device->second.empty())
+                {
+                    by_device_.erase(device);
+                }
+            }
+            by_sequence_.erase(sequence);
+            records_.erase(it);
+        }
+
+        void TransactionHistory::clear()
+        {
+            records_.clear();
+            by_sequence_.clear();
+            by_device_.clear();
+            for (auto &index : by_status_)
+            {
+                index.clear();
+            }
+        }
+
+    } // namespace core
+} // namespace cardano_iot
@@ -1,6 +1,18 @@
 #include "cardano_iot/core/transaction_manager.h"
+#include "cardano_iot/core/transaction_cbor.h"
+#include "cardano_iot/core/transaction_history.h"
+#include "cardano_iot/core/coin_selection.h"
+#include "cardano_iot/core/utxo_set.h"
+#include "cardano_iot/core/confirmation_tracker.h"
+#include "cardano_iot/network/cardano_client.h"
 #include "cardano_iot/utils/logger.h"
+#include "cardano_iot/utils/codec.h"
+#include "cardano_iot/utils/hash.h"
+#include "cardano_iot/utils/metrics.h"
 #include "cardano_iot/network/network_utils.h"
+#include "cardano_iot/performance/performance_optimizer.h"
+
+#include <openssl/evp.h>
 
 #include <chrono>
 #include <sstream>
@@ -21,19 +33,45 @@ namespace cardano_iot
             std::string network_ = "testnet";
             mutable std::mutex transactions_mutex_;
             mutable std::mutex utxos_mutex_;
-            mutable std::mutex stats_mutex_;
 
-            // Transaction storage
-            std::map<std::string, std::unique_ptr<Transaction>> transactions_;
-            std::map<std::string, std::vector<UTXO>> address_utxos_;
+            // Transaction storage: indexed in memory, finished ones archived after the retention window
+            TransactionHistory history_;
+            TransactionArchive archive_;
+            HistoryOptions history_options_;
+            uint64_t last_prune_ = 0;
+            UtxoSet utxo_set_;
+
+            // Pre-sorted selection indexes over unspent outputs, rebuilt when the address's
+            // UtxoSet version moves on (guarded by utxos_mutex_)
+            struct CachedIndex
+            {
+                uint64_t version = 0;
+                std::shared_ptr<const CoinSelectionIndex> index;
+            };
+            mutable std::map<std::string, CachedIndex> selection_indexes_;
 
             // Configuration
             FeeParameters fee_params_;
             UTXOSelectionStrategy utxo_strategy_ = UTXOSelectionStrategy::LARGEST_FIRST;
             ConfirmationCallback confirmation_callback_;
-
-            // Statistics
-            TransactionStats stats_ = {};
+            mutable std::mutex callback_mutex_;
+
+            // One thread tracks every submitted transaction until it confirms, fails or times out
+            std::unique_ptr<ConfirmationTracker> tracker_;
+            std::shared_ptr<network::CardanoClient> chain_client_;
+            uint64_t chain_subscription_ = 0;
+            network::ChainTip streamed_tip_{}; // latest block from the subscription
+            mutable std::mutex client_mutex_;
+
+            // Statistics: per-core metrics, fee and volume totals in lovelace
+            utils::metrics::Counter submitted_{"cardano_iot_tx_submitted_total", "Transactions accepted for submission"};
+            utils::metrics::Counter confirmed_{"cardano_iot_tx_confirmed_total", "Transactions confirmed on chain"};
+            utils::metrics::Counter failed_{"cardano_iot_tx_failed_total", "Transactions that failed submission"};
+            utils::metrics::Counter fees_paid_{"cardano_iot_tx_fees_lovelace_total", "Fees paid in lovelace"};
+            utils::metrics::Counter volume_{"cardano_iot_tx_volume_lovelace_total", "Output volume of confirmed transactions in lovelace"};
+            utils::metrics::Gauge pending_{"cardano_iot_tx_pending", "Submitted transactions awaiting confirmation"};
+            utils::metrics::Histogram confirmation_seconds_{"cardano_iot_tx_confirmation_seconds", "Time from submission to confirmation in seconds",
+                                                            utils::metrics::Histogram::exponential_bounds(1.0, 2.0, 14)};
 
             // Wallet information
             struct WalletInfo
@@ -126,6 +164,192 @@ namespace cardano_iot
                 return base_size + input_size + output_size + witness_size + metadata_size;
             }
 
+            // Fee-derived selection parameters: a change output costs ~70 bytes, an input ~40
+            CoinSelectionParams coin_selection_params() const
+            {
+                CoinSelectionParams params;
+                params.cost_of_change = fee_params_.min_fee_b * 70;
+                params.cost_per_input = fee_params_.min_fee_b * 40;
+                params.max_inputs = fee_params_.max_tx_size / 40;
+                return params;
+            }
+
+            std::shared_ptr<const CoinSelectionIndex> selection_index(const std::string &address) const
+            {
+                const uint64_t version = utxo_set_.version(address);
+                std::lock_guard<std::mutex> lock(utxos_mutex_);
+                auto &cached = selection_indexes_[address];
+                if (!cached.index || cached.version != version)
+                {
+                    cached.index = std::make_shared<const CoinSelectionIndex>(utxo_set_.unspent(address));
+                    cached.version = version;
+                }
+                return cached.index;
+            }
+
+            CoinSelectionResult select(const std::string &address,
+                                       uint64_t target_amount,
+                                       const std::map<std::string, uint64_t> &required_tokens) const
+            {
+                auto index = selection_index(address);
+                auto params = coin_selection_params();
+                params.is_available = [this](const UTXO &utxo)
+                {
+                    return utxo_set_.is_available(OutPoint{utxo.tx_hash, utxo.output_index});
+                };
+
+                auto result = CoinSelector::select(*index, target_amount, required_tokens, utxo_strategy_, params);
+                CARDANO_IOT_LOG(utils::LogLevel::DEBUG, "TransactionManager",
+                                "Coin selection (" << result.algorithm << "): " << result.selected.size() << " of "
+                                                   << index->size() << " UTXOs, " << result.inputs_evaluated
+                                                   << " evaluated" << (result.success ? "" : ", insufficient funds"));
+                return result;
+            }
+
+            // Select and reserve inputs for a transaction; retries if a concurrent builder won the race
+            CoinSelectionResult select_and_reserve(const std::string &address,
+                                                   uint64_t target_amount,
+                                                   const std::map<std::string, uint64_t> &required_tokens,
+                                                   const std::string &owner)
+            {
+                for (int attempt = 0; attempt < 3; ++attempt)
+                {
+                    auto result = select(address, target_amount, required_tokens);
+                    if (!result.success)
+                    {
+                        return result;
+                    }
+
+                    std::vector<OutPoint> outpoints;
+                    outpoints.reserve(result.selected.size());
+                    for (const auto &utxo : result.selected)
+                    {
+                        outpoints.push_back(OutPoint{utxo.tx_hash, utxo.output_index});
+                    }
+                    if (utxo_set_.reserve(outpoints, owner))
+                    {
+                        return result;
+                    }
+                }
+                return CoinSelectionResult{};
+            }
+
+            // Reusable per-thread encode buffer, so encoding does not allocate per call
+            static std::vector<uint8_t> &encode_buffer()
+            {
+                thread_local std::vector<uint8_t> buffer;
+                buffer.clear();
+                return buffer;
+            }
+
+            // BLAKE2b-256 of the CBOR body: the ledger transaction id and the message every witness signs
+            static std::vector<uint8_t> body_hash(const Transaction &transaction)
+            {
+                auto &buffer = encode_buffer();
+                cbor::CborWriter writer(&buffer);
+                cbor::encode_transaction_body(transaction, writer);
+                return utils::Hasher::digest(utils::HashAlgorithm::BLAKE2B_256, buffer.data(), buffer.size());
+            }
+
+            // Ed25519 witness as hex(vkey || signature); empty if the key is not a raw 32-byte hex key
+            static std::string ed25519_witness(const std::vector<uint8_t> &message, const std::string &signing_key)
+            {
+                if (signing_key.size() != 64 || !cbor::is_hex_id(signing_key))
+                {
+                    return "";
+                }
+
+                auto seed = utils::codec::hex_decode(signing_key);
+                EVP_PKEY *pkey = EVP_PKEY_new_raw_private_key(EVP_PKEY_ED25519, nullptr, seed.data(), seed.size());
+                if (!pkey)
+                {
+                    return "";
+                }
+
+                uint8_t vkey[32];
+                size_t vkey_len = sizeof(vkey);
+                uint8_t signature[64];
+                size_t signature_len = sizeof(signature);
+                EVP_MD_CTX *ctx = EVP_MD_CTX_new();
+                bool ok = ctx && EVP_PKEY_get_raw_public_key(pkey, vkey, &vkey_len) == 1 &&
+                          EVP_DigestSignInit(ctx, nullptr, nullptr, nullptr, pkey) == 1 &&
+                          EVP_DigestSign(ctx, signature, &signature_len, message.data(), message.size()) == 1;
+                EVP_MD_CTX_free(ctx);
+                EVP_PKEY_free(pkey);
+
+                if (!ok)
+                {
+                    return "";
+                }
+                std::string witness(utils::codec::hex_encoded_size(vkey_len + signature_len), '\0');
+                utils::codec::hex_encode(vkey, vkey_len, witness.data());
+                utils::codec::hex_encode(signature, signature_len, witness.data() + 2 * vkey_len);
+                return witness;
+            }
+
+            // Re-encode the body and the signed transaction after witnesses changed
+            static void refresh_cbor(Transaction &transaction)
+            {
+                auto &buffer = encode_buffer();
+                cbor::CborWriter body_writer(&buffer);
+                cbor::encode_transaction_body(transaction, body_writer);
+                transaction.raw_cbor = utils::codec::hex_encode(buffer);
+
+                auto &signed_buffer = encode_buffer();
+                signed_buffer.reserve(cbor::encoded_size(transaction));
+                cbor::CborWriter writer(&signed_buffer);
+                cbor::encode_transaction(transaction, writer);
+                transaction.signed_cbor = utils::codec::hex_encode(signed_buffer);
+            }
+
+            // Appends witnesses not yet present; returns how many were new
+            static size_t append_witnesses(Transaction &transaction, const std::vector<std::string> &witnesses)
+            {
+                size_t added = 0;
+                for (const auto &witness : witnesses)
+                {
+                    if (!witness.empty() &&
+                        std::find(transaction.witnesses.begin(), transaction.witnesses.end(), witness) ==
+                            transaction.witnesses.end())
+                    {
+                        transaction.witnesses.push_back(witness);
+                        ++added;
+                    }
+                }
+                return added;
+            }
+
+            // Hex Ed25519 (signature, vkey) pairs form a vkey witness; anything else keeps the legacy string
+            static std::string multisig_witness(const std::string &signature, const std::string &public_key)
+            {
+                if (public_key.size() == 64 && signature.size() == 128 && cbor::is_hex_id(public_key) &&
+                    cbor::is_hex_id(signature))
+                {
+                    return public_key + signature;
+                }
+                return signature + ":" + public_key;
+            }
+
+            // Exact serialized size; unsigned transactions get one vkey witness per distinct input address
+            static size_t serialized_size(const Transaction &transaction)
+            {
+                size_t size = cbor::encoded_size(transaction);
+                if (transaction.witnesses.empty() && !transaction.inputs.empty())
+                {
+                    std::vector<std::string_view> signers;
+                    for (const auto &input : transaction.inputs)
+                    {
+                        std::string_view address(input.utxo_info.address);
+                        if (std::find(signers.begin(), signers.end(), address) == signers.end())
+                        {
+                            signers.push_back(address);
+                        }
+                    }
+                    size += cbor::vkey_witness_set_size(signers.size()) - cbor::vkey_witness_set_size(0);
+                }
+                return size;
+            }
+
             // Mock transaction submission
             std::string submit_to_network(const Transaction &transaction)
             {
@@ -151,10 +375,9 @@ namespace cardano_iot
             bool check_confirmation(const std::string &tx_id)
             {
                 // Simulate confirmation after some time
-                auto it = transactions_.find(tx_id);
-                if (it != transactions_.end())
+                const Transaction *tx = history_.find(tx_id);
+                if (tx)
                 {
-                    auto &tx = it->second;
                     auto now = std::chrono::duration_cast<std::chrono::seconds>(
                                    std::chrono::system_clock::now().time_since_epoch())
                                    .count();
@@ -165,95 +388,176 @@ namespace cardano_iot
                 return false;
             }
 
-            // UTXO selection implementation
-            std::vector<UTXO> select_utxos_impl(
-                const std::vector<UTXO> &available_utxos,
-                uint64_t target_amount,
-                const std::map<std::string, uint64_t> &required_tokens,
-                UTXOSelectionStrategy strategy)
+            static uint64_t now_seconds()
             {
+                return std::chrono::duration_cast<std::chrono::seconds>(
+                           std::chrono::system_clock::now().time_since_epoch())
+                    .count();
+            }
 
-                std::vector<UTXO> candidates = available_utxos;
-                std::vector<UTXO> selected;
-
-                // Sort based on strategy
-                switch (strategy)
+            // Prune history when retention is on and the interval has passed (transactions_mutex_ held)
+            size_t prune_history(bool force)
+            {
+                const uint64_t now = now_seconds();
+                if (history_options_.retention_seconds == 0 ||
+                    (!force && now < last_prune_ + history_options_.prune_interval_seconds))
                 {
-                case UTXOSelectionStrategy::LARGEST_FIRST:
-                    std::sort(candidates.begin(), candidates.end(),
-                              [](const UTXO &a, const UTXO &b)
-                              {
-                                  return a.amount_lovelace > b.amount_lovelace;
-                              });
-                    break;
-
-                case UTXOSelectionStrategy::SMALLEST_FIRST:
-                    std::sort(candidates.begin(), candidates.end(),
-                              [](const UTXO &a, const UTXO &b)
-                              {
-                                  return a.amount_lovelace < b.amount_lovelace;
-                              });
-                    break;
+                    return 0;
+                }
+                last_prune_ = now;
+                const size_t pruned = history_.prune(now, history_options_.retention_seconds,
+                                                     archive_.is_open() ? &archive_ : nullptr);
+                if (pruned > 0)
+                {
+                    if (archive_.is_open())
+                    {
+                        archive_.sync();
+                    }
+                    utils::Logger::instance().log(utils::LogLevel::DEBUG, "TransactionManager",
+                                                  "Pruned " + std::to_string(pruned) + " transactions from history");
+                }
+                return pruned;
+            }
 
-                case UTXOSelectionStrategy::RANDOM:
+            // Record a SUBMITTED transaction as confirmed (transactions_mutex_ held)
+            void mark_confirmed(Transaction &tx)
+            {
+                tx.status = TransactionStatus::CONFIRMED;
+                utxo_set_.apply_confirmed(tx.tx_id);
+                tx.confirmed_timestamp = std::chrono::duration_cast<std::chrono::seconds>(
+                                             std::chrono::system_clock::now().time_since_epoch())
+                                             .count();
+
+                // Update statistics on confirmation
+                pending_.decrement_to_zero();
+                confirmed_.inc();
+                if (tx.submitted_timestamp > 0 && tx.confirmed_timestamp > 0)
                 {
-                    std::random_device rd;
-                    std::mt19937 g(rd());
-                    std::shuffle(candidates.begin(), candidates.end(), g);
+                    confirmation_seconds_.observe(static_cast<double>(tx.confirmed_timestamp - tx.submitted_timestamp));
                 }
-                break;
-
-                case UTXOSelectionStrategy::OPTIMAL_FEE:
-                    // For demo, use largest first
-                    std::sort(candidates.begin(), candidates.end(),
-                              [](const UTXO &a, const UTXO &b)
-                              {
-                                  return a.amount_lovelace > b.amount_lovelace;
-                              });
-                    break;
+                // total volume (sum of output lovelace excluding change is complex; approximate by sum outputs)
+                uint64_t volume = 0;
+                for (const auto &out : tx.outputs)
+                {
+                    volume += out.amount_lovelace;
                 }
+                volume_.inc(volume);
+            }
 
-                uint64_t accumulated = 0;
-                std::map<std::string, uint64_t> accumulated_tokens;
-
-                for (const auto &utxo : candidates)
+            // Batched status lookup for the confirmation tracker: one lock for the whole batch and,
+            // with a chain client attached, one node round trip
+            std::vector<TransactionStatus> batch_status(const std::vector<std::string> &tx_ids)
+            {
+                std::shared_ptr<network::CardanoClient> client;
+                {
+                    std::lock_guard<std::mutex> lock(client_mutex_);
+                    client = chain_client_;
+                }
+                std::vector<bool> on_chain;
+                if (client && client->is_connected())
                 {
-                    selected.push_back(utxo);
-                    accumulated += utxo.amount_lovelace;
+                    on_chain = client->are_transactions_confirmed(tx_ids);
+                }
 
-                    // Accumulate tokens
-                    for (const auto &[token, amount] : utxo.native_tokens)
+                std::vector<TransactionStatus> statuses(tx_ids.size(), TransactionStatus::FAILED);
+                std::lock_guard<std::mutex> lock(transactions_mutex_);
+                for (size_t i = 0; i < tx_ids.size(); ++i)
+                {
+                    const Transaction *tx = history_.find(tx_ids[i]);
+                    if (!tx)
                     {
-                        accumulated_tokens[token] += amount;
+                        continue;
                     }
+                    if (tx->status == TransactionStatus::SUBMITTED &&
+                        (on_chain.empty() ? check_confirmation(tx->tx_id) : on_chain[i]))
+                    {
+                        history_.update(tx_ids[i], [this](Transaction &record)
+                                        { mark_confirmed(record); });
+                        tx = history_.find(tx_ids[i]);
+                    }
+                    statuses[i] = tx->status;
+                }
+                prune_history(false);
+                return statuses;
+            }
 
-                    // Check if we have enough ADA
-                    bool ada_sufficient = accumulated >= target_amount;
-
-                    // Check if we have enough tokens
-                    bool tokens_sufficient = true;
-                    for (const auto &[token, required_amount] : required_tokens)
+            // Streamed tip while subscribed, so the tracker's tip polls never reach the node
+            network::ChainTip current_tip()
+            {
+                std::shared_ptr<network::CardanoClient> client;
+                {
+                    std::lock_guard<std::mutex> lock(client_mutex_);
+                    if (chain_subscription_ != 0)
                     {
-                        if (accumulated_tokens[token] < required_amount)
-                        {
-                            tokens_sufficient = false;
-                            break;
-                        }
+                        return streamed_tip_;
                     }
+                    client = chain_client_;
+                }
+                return ConfirmationTracker::client_tip_provider(client)();
+            }
 
-                    if (ada_sufficient && tokens_sufficient)
+            // Subscribe to the client's block stream; every new block triggers one batch check
+            void attach_chain()
+            {
+                std::shared_ptr<network::CardanoClient> client;
+                {
+                    std::lock_guard<std::mutex> lock(client_mutex_);
+                    if (!chain_client_ || chain_subscription_ != 0)
                     {
-                        break;
+                        return;
                     }
+                    client = chain_client_;
                 }
 
-                return selected;
+                network::ChainSubscription subscription;
+                subscription.on_block = [this](const network::BlockHeader &header)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(client_mutex_);
+                        streamed_tip_ = network::ChainTip{header.hash, header.slot, header.height, header.epoch, 100.0};
+                    }
+                    tracker_->request_check();
+                };
+                subscription.on_rollback = [this](const network::ChainPoint &)
+                {
+                    tracker_->request_check();
+                };
+
+                const auto tip = client->get_chain_tip();
+                const uint64_t id = client->subscribe_chain(std::move(subscription));
+                std::lock_guard<std::mutex> lock(client_mutex_);
+                chain_subscription_ = id;
+                streamed_tip_ = tip;
+            }
+
+            // Returns once no subscription handler can still be running
+            void detach_chain()
+            {
+                std::shared_ptr<network::CardanoClient> client;
+                uint64_t id = 0;
+                {
+                    std::lock_guard<std::mutex> lock(client_mutex_);
+                    client = chain_client_;
+                    std::swap(id, chain_subscription_);
+                    streamed_tip_ = {};
+                }
+                if (client && id != 0)
+                {
+                    client->unsubscribe_chain(id);
+                }
             }
         };
 
         // Constructor/Destructor
         TransactionManager::TransactionManager() : pimpl_(std::make_unique<Impl>()) {}
-        TransactionManager::~TransactionManager() = default;
+        TransactionManager::~TransactionManager()
+        {
+            pimpl_->detach_chain();
+            if (pimpl_->tracker_)
+            {
+                pimpl_->tracker_->stop();
+            }
+        }
 
         bool TransactionManager::initialize(const std::string &network)
         {
@@ -269,6 +573,26 @@ namespace cardano_iot
             // Set default fee parameters
             pimpl_->fee_params_ = FeeParameters{};
 
+            Impl *impl = pimpl_.get();
+            pimpl_->tracker_ = std::make_unique<ConfirmationTracker>(
+                [impl](const std::vector<std::string> &tx_ids)
+                { return impl->batch_status(tx_ids); },
+                [impl]()
+                { return impl->current_tip(); });
+            pimpl_->tracker_->set_callback([impl](const std::string &tx_id, bool confirmed)
+                                           {
+                                               ConfirmationCallback callback;
+                                               {
+                                                   std::lock_guard<std::mutex> lock(impl->callback_mutex_);
+                                                   callback = impl->confirmation_callback_;
+                                               }
+                                               if (callback)
+                                               {
+                                                   callback(tx_id, confirmed);
+                                               } });
+            pimpl_->tracker_->start();
+            pimpl_->attach_chain();
+
             pimpl_->initialized_ = true;
 
             utils::Logger::instance().log(utils::LogLevel::INFO, "TransactionManager",
@@ -278,6 +602,14 @@ namespace cardano_iot
 
         void TransactionManager::shutdown()
         {
+            // The tracker thread takes transactions_mutex_, so stop it first; waiters get false.
+            // The block stream pokes the tracker, so it is detached before that.
+            pimpl_->detach_chain();
+            if (pimpl_->tracker_)
+            {
+                pimpl_->tracker_->stop();
+            }
+
             std::lock_guard<std::mutex> lock(pimpl_->transactions_mutex_);
 
             if (!pimpl_->initialized_)
@@ -286,8 +618,13 @@ namespace cardano_iot
             }
 
             // Clear all data
-            pimpl_->transactions_.clear();
-            pimpl_->address_utxos_.clear();
+            pimpl_->history_.clear();
+            pimpl_->archive_.close();
+            pimpl_->utxo_set_.clear();
+            {
+                std::lock_guard<std::mutex> utxos_lock(pimpl_->utxos_mutex_);
+                pimpl_->selection_indexes_.clear();
+            }
             pimpl_->wallet_ = {};
             pimpl_->initialized_ = false;
 
@@ -346,25 +683,7 @@ namespace cardano_iot
                 return balance;
             }
 
-            std::lock_guard<std::mutex> lock(pimpl_->utxos_mutex_);
-
-            auto it = pimpl_->address_utxos_.find(address);
-            if (it != pimpl_->address_utxos_.end())
-            {
-                for (const auto &utxo : it->second)
-                {
-                    balance.total_lovelace += utxo.amount_lovelace;
-                    balance.available_lovelace += utxo.amount_lovelace;
-
-                    for (const auto &[token, amount] : utxo.native_tokens)
-                    {
-                        balance.native_tokens[token] += amount;
-                    }
-                }
-                balance.utxos = it->second;
-            }
-
-            return balance;
+            return pimpl_->utxo_set_.balance(address);
         }
 
         std::vector<UTXO> TransactionManager::get_utxos(const std::string &address) const
@@ -374,15 +693,7 @@ namespace cardano_iot
                 return {};
             }
 
-            std::lock_guard<std::mutex> lock(pimpl_->utxos_mutex_);
-
-            auto it = pimpl_->address_utxos_.find(address);
-            if (it != pimpl_->address_utxos_.end())
-            {
-                return it->second;
-            }
-
-            return {};
+            return pimpl_->utxo_set_.available(address);
         }
 
         bool TransactionManager::refresh_utxos(const std::string &address)
@@ -392,10 +703,8 @@ namespace cardano_iot
                 return false;
             }
 
-            std::lock_guard<std::mutex> lock(pimpl_->utxos_mutex_);
-
-            // Create mock UTXOs for demo
-            pimpl_->address_utxos_[address] = pimpl_->create_mock_utxos(address);
+            // Create mock UTXOs for demo; reservations on outputs that survive are kept
+            pimpl_->utxo_set_.load_address(address, pimpl_->create_mock_utxos(address));
 
             utils::Logger::instance().log(utils::LogLevel::INFO, "TransactionManager",
                                           "Refreshed UTXOs for address: " + address.substr(0, 16) + "...");
@@ -422,35 +731,34 @@ namespace cardano_iot
                                                  std::chrono::system_clock::now().time_since_epoch())
                                                  .count();
 
-            // Get UTXOs for the from address
-            auto utxos = get_utxos(from_address);
-            if (utxos.empty())
+            // Load the from address once; afterwards the UTXO set is kept current incrementally
+            if (!pimpl_->utxo_set_.has_address(from_address))
             {
-                // Try to refresh UTXOs
                 refresh_utxos(from_address);
-                utxos = get_utxos(from_address);
             }
 
-            // Select UTXOs
-            auto selected_utxos = select_utxos(utxos, amount_lovelace + 200000); // +200k for fees
+            // Select and reserve UTXOs
+            auto selection = pimpl_->select_and_reserve(from_address, amount_lovelace + 200000, {}, transaction->tx_id); // +200k for fees
+            auto &selected_utxos = selection.selected;
 
-            if (selected_utxos.empty())
+            if (!selection.success)
             {
                 utils::Logger::instance().log(utils::LogLevel::ERROR, "TransactionManager",
                                               "Insufficient funds for transaction");
                 return nullptr;
             }
 
-            // Build inputs
+            // Build inputs; the selection is ours, so its UTXOs move into the inputs
             uint64_t total_input = 0;
-            for (const auto &utxo : selected_utxos)
+            transaction->inputs.reserve(selected_utxos.size());
+            for (auto &utxo : selected_utxos)
             {
+                total_input += utxo.amount_lovelace;
                 TransactionInput input;
                 input.tx_hash = utxo.tx_hash;
                 input.output_index = utxo.output_index;
-                input.utxo_info = utxo;
-                transaction->inputs.push_back(input);
-                total_input += utxo.amount_lovelace;
+                input.utxo_info = std::move(utxo);
+                transaction->inputs.push_back(std::move(input));
             }
 
             // Calculate fee
@@ -460,7 +768,7 @@ namespace cardano_iot
             TransactionOutput payment_output;
             payment_output.address = to_address;
             payment_output.amount_lovelace = amount_lovelace;
-            transaction->outputs.push_back(payment_output);
+            transaction->outputs.push_back(std::move(payment_output));
 
             // Add change output if needed
             uint64_t change = total_input - amount_lovelace - transaction->fee;
@@ -469,7 +777,7 @@ namespace cardano_iot
                 TransactionOutput change_output;
                 change_output.address = from_address;
                 change_output.amount_lovelace = change;
-                transaction->outputs.push_back(change_output);
+                transaction->outputs.push_back(std::move(change_output));
             }
 
             // Set TTL (1 hour from now)
@@ -478,8 +786,24 @@ namespace cardano_iot
                                    .count() +
                                3600;
 
-            utils::Logger::instance().log(utils::LogLevel::INFO, "TransactionManager",
-                                          "Created payment transaction: " + transaction->tx_id);
+            // Replace the estimate with the exact size-based fee; the change amount feeds back into
+            // the size, so iterate until both agree
+            if (transaction->outputs.size() > 1)
+            {
+                for (int pass = 0; pass < 4; ++pass)
+                {
+                    transaction->fee = calculate_fee(*transaction);
+                    const uint64_t exact_change = total_input - amount_lovelace - transaction->fee;
+                    if (exact_change == transaction->outputs.back().amount_lovelace)
+                    {
+                        break;
+                    }
+                    transaction->outputs.back().amount_lovelace = exact_change;
+                }
+            }
+
+            CARDANO_IOT_LOG(utils::LogLevel::INFO, "TransactionManager",
+                            "Created payment transaction: " << transaction->tx_id);
 
             return transaction;
         }
@@ -504,17 +828,17 @@ namespace cardano_iot
                                                  std::chrono::system_clock::now().time_since_epoch())
                                                  .count();
 
-            // Get UTXOs and select for token transfer
-            auto utxos = get_utxos(from_address);
-            if (utxos.empty())
+            // Select UTXOs for the tokens plus the token output's min UTXO and fees
+            if (!pimpl_->utxo_set_.has_address(from_address))
             {
                 refresh_utxos(from_address);
-                utxos = get_utxos(from_address);
             }
 
-            auto selected_utxos = select_utxos(utxos, pimpl_->fee_params_.min_utxo, tokens);
+            auto selection = pimpl_->select_and_reserve(from_address, pimpl_->fee_params_.min_utxo + 200000, tokens,
+                                                        transaction->tx_id);
+            const auto &selected_utxos = selection.selected;
 
-            if (selected_utxos.empty())
+            if (!selection.success)
             {
                 utils::Logger::instance().log(utils::LogLevel::ERROR, "TransactionManager",
                                               "Insufficient tokens for transfer");
@@ -531,7 +855,7 @@ namespace cardano_iot
                 input.tx_hash = utxo.tx_hash;
                 input.output_index = utxo.output_index;
                 input.utxo_info = utxo;
-                transaction->inputs.push_back(input);
+                transaction->inputs.push_back(std::move(input));
                 total_input += utxo.amount_lovelace;
 
                 for (const auto &[token, amount] : utxo.native_tokens)
@@ -547,7 +871,7 @@ namespace cardano_iot
             payment_output.address = to_address;
             payment_output.amount_lovelace = pimpl_->fee_params_.min_utxo;
             payment_output.native_tokens = tokens;
-            transaction->outputs.push_back(payment_output);
+            transaction->outputs.push_back(std::move(payment_output));
 
             // Change output
             TransactionOutput change_output;
@@ -569,14 +893,14 @@ namespace cardano_iot
                 }
             }
 
-            transaction->outputs.push_back(change_output);
+            transaction->outputs.push_back(std::move(change_output));
             transaction->ttl = std::chrono::duration_cast<std::chrono::seconds>(
                                    std::chrono::system_clock::now().time_since_epoch())
                                    .count() +
                                3600;
 
-            utils::Logger::instance().log(utils::LogLevel::INFO, "TransactionManager",
-                                          "Created token transfer transaction: " + transaction->tx_id);
+            CARDANO_IOT_LOG(utils::LogLevel::INFO, "TransactionManager",
+                            "Created token transfer transaction: " << transaction->tx_id);
 
             return transaction;
         }
@@ -590,41 +914,59 @@ namespace cardano_iot
             {
                 return nullptr;
             }
+            return create_metadata_transaction(from_address, TransactionMetadata(metadata), device_id);
+        }
+
+        std::unique_ptr<Transaction> TransactionManager::create_metadata_transaction(
+            const std::string &from_address,
+            TransactionMetadata &&metadata,
+            const std::string &device_id)
+        {
+            if (!pimpl_->initialized_)
+            {
+                return nullptr;
+            }
 
             auto transaction = std::make_unique<Transaction>();
             transaction->tx_id = pimpl_->generate_tx_id();
             transaction->type = TransactionType::METADATA;
             transaction->status = TransactionStatus::PENDING;
             transaction->device_id = device_id;
-            transaction->metadata = std::make_unique<TransactionMetadata>(metadata);
+            const size_t metadata_size = metadata.json_metadata.length();
+            transaction->metadata = std::make_unique<TransactionMetadata>(std::move(metadata));
             transaction->created_timestamp = std::chrono::duration_cast<std::chrono::seconds>(
                                                  std::chrono::system_clock::now().time_since_epoch())
                                                  .count();
 
             // Simple metadata transaction to self
-            auto utxos = get_utxos(from_address);
-            if (utxos.empty())
+            if (!pimpl_->utxo_set_.has_address(from_address))
             {
                 refresh_utxos(from_address);
-                utxos = get_utxos(from_address);
             }
 
-            if (!utxos.empty())
+            const uint64_t fee = estimate_fee(1, 1, metadata_size);
+            auto selection = pimpl_->select_and_reserve(from_address, fee + pimpl_->fee_params_.min_utxo, {},
+                                                        transaction->tx_id);
+
+            if (selection.success)
             {
-                // Use one UTXO
-                TransactionInput input;
-                input.tx_hash = utxos[0].tx_hash;
-                input.output_index = utxos[0].output_index;
-                input.utxo_info = utxos[0];
-                transaction->inputs.push_back(input);
+                transaction->inputs.reserve(selection.selected.size());
+                for (auto &utxo : selection.selected)
+                {
+                    TransactionInput input;
+                    input.tx_hash = utxo.tx_hash;
+                    input.output_index = utxo.output_index;
+                    input.utxo_info = std::move(utxo);
+                    transaction->inputs.push_back(std::move(input));
+                }
 
-                transaction->fee = estimate_fee(1, 1, metadata.json_metadata.length());
+                transaction->fee = fee;
 
                 // Send back to self
                 TransactionOutput output;
                 output.address = from_address;
-                output.amount_lovelace = utxos[0].amount_lovelace - transaction->fee;
-                transaction->outputs.push_back(output);
+                output.amount_lovelace = selection.total_lovelace - transaction->fee;
+                transaction->outputs.push_back(std::move(output));
 
                 transaction->ttl = std::chrono::duration_cast<std::chrono::seconds>(
                                        std::chrono::system_clock::now().time_since_epoch())
@@ -632,8 +974,8 @@ namespace cardano_iot
                                    3600;
             }
 
-            utils::Logger::instance().log(utils::LogLevel::INFO, "TransactionManager",
-                                          "Created metadata transaction: " + transaction->tx_id);
+            CARDANO_IOT_LOG(utils::LogLevel::INFO, "TransactionManager",
+                            "Created metadata transaction: " << transaction->tx_id);
 
             return transaction;
         }
@@ -680,26 +1022,36 @@ namespace cardano_iot
             auto payment_tx = create_payment_transaction(from_address, contract_address, amount_lovelace, device_id);
             if (payment_tx)
             {
+                // Adopt the payment's id so its input reservations carry over
+                transaction->tx_id = payment_tx->tx_id;
                 transaction->inputs = std::move(payment_tx->inputs);
                 transaction->outputs = std::move(payment_tx->outputs);
                 transaction->fee = payment_tx->fee + 50000; // Extra fee for contract execution
                 transaction->ttl = payment_tx->ttl;
             }
 
-            utils::Logger::instance().log(utils::LogLevel::INFO, "TransactionManager",
-                                          "Created smart contract transaction: " + transaction->tx_id);
+            CARDANO_IOT_LOG(utils::LogLevel::INFO, "TransactionManager",
+                            "Created smart contract transaction: " << transaction->tx_id);
 
             return transaction;
         }
 
         uint64_t TransactionManager::calculate_fee(const Transaction &transaction) const
         {
-            size_t tx_size = pimpl_->estimate_transaction_size(
-                transaction.inputs.size(),
-                transaction.outputs.size(),
-                transaction.metadata ? transaction.metadata->json_metadata.length() : 0);
-
-            return pimpl_->fee_params_.min_fee_a + (pimpl_->fee_params_.min_fee_b * tx_size);
+            // The fee field is part of the body, so only its own encoded width can change the size
+            const size_t base_size = Impl::serialized_size(transaction) - cbor::CborWriter::head_size(transaction.fee);
+            uint64_t fee = transaction.fee;
+            for (int pass = 0; pass < 3; ++pass)
+            {
+                const uint64_t next = pimpl_->fee_params_.min_fee_a +
+                                      pimpl_->fee_params_.min_fee_b * (base_size + cbor::CborWriter::head_size(fee));
+                if (next == fee)
+                {
+                    break;
+                }
+                fee = next;
+            }
+            return fee;
         }
 
         uint64_t TransactionManager::estimate_fee(
@@ -718,13 +1070,17 @@ namespace cardano_iot
                 return false;
             }
 
-            // Simplified signing for demo
-            std::stringstream ss;
-            ss << "signed_" << transaction.tx_id << "_" << signing_key.substr(0, 8);
-            std::string witness = ss.str();
+            // Ed25519 over the body hash for raw keys; demo keys keep the legacy witness string
+            std::string witness = Impl::ed25519_witness(Impl::body_hash(transaction), signing_key);
+            if (witness.empty())
+            {
+                std::stringstream ss;
+                ss << "signed_" << transaction.tx_id << "_" << signing_key.substr(0, 8);
+                witness = ss.str();
+            }
 
             transaction.witnesses.push_back(witness);
-            transaction.signed_cbor = "cbor_" + transaction.tx_id + "_signed";
+            Impl::refresh_cbor(transaction);
 
             utils::Logger::instance().log(utils::LogLevel::INFO, "TransactionManager",
                                           "Transaction signed: " + transaction.tx_id);
@@ -733,11 +1089,65 @@ namespace cardano_iot
 
         bool TransactionManager::add_witness(Transaction &transaction, const std::string &witness)
         {
-            transaction.witnesses.push_back(witness);
+            return add_witnesses(transaction, {witness}) == 1;
+        }
 
-            utils::Logger::instance().log(utils::LogLevel::INFO, "TransactionManager",
-                                          "Added witness to transaction: " + transaction.tx_id);
-            return true;
+        size_t TransactionManager::add_witnesses(Transaction &transaction, const std::vector<std::string> &witnesses)
+        {
+            const size_t added = Impl::append_witnesses(transaction, witnesses);
+            if (added > 0)
+            {
+                Impl::refresh_cbor(transaction);
+                utils::Logger::instance().log(utils::LogLevel::INFO, "TransactionManager",
+                                              "Added " + std::to_string(added) + " witnesses to transaction: " +
+                                                  transaction.tx_id);
+            }
+            return added;
+        }
+
+        std::string TransactionManager::get_body_hash(const Transaction &transaction) const
+        {
+            return utils::codec::hex_encode(Impl::body_hash(transaction));
+        }
+
+        std::string TransactionManager::create_witness(const std::string &body_hash, const std::string &signing_key)
+        {
+            const auto message = utils::codec::hex_decode(body_hash);
+            return message.empty() ? "" : Impl::ed25519_witness(message, signing_key);
+        }
+
+        std::vector<uint8_t> TransactionManager::verify_witnesses(const std::string &body_hash,
+                                                                  const std::vector<std::string> &witnesses)
+        {
+            std::vector<uint8_t> valid(witnesses.size(), 0);
+            const auto message = utils::codec::hex_decode(body_hash);
+            EVP_MD_CTX *ctx = message.empty() ? nullptr : EVP_MD_CTX_new();
+            if (!ctx)
+            {
+                return valid;
+            }
+
+            uint8_t raw[32 + 64]; // vkey || signature
+            for (size_t i = 0; i < witnesses.size(); ++i)
+            {
+                const auto &witness = witnesses[i];
+                if (witness.size() != 2 * sizeof(raw) ||
+                    utils::codec::hex_decode(witness.data(), witness.size(), raw) != sizeof(raw))
+                {
+                    continue;
+                }
+                EVP_PKEY *pkey = EVP_PKEY_new_raw_public_key(EVP_PKEY_ED25519, nullptr, raw, 32);
+                if (!pkey)
+                {
+                    continue;
+                }
+                valid[i] = EVP_DigestVerifyInit(ctx, nullptr, nullptr, nullptr, pkey) == 1 &&
+                           EVP_DigestVerify(ctx, raw + 32, 64, message.data(), message.size()) == 1;
+                EVP_MD_CTX_reset(ctx);
+                EVP_PKEY_free(pkey);
+            }
+            EVP_MD_CTX_free(ctx);
+            return valid;
         }
 
         std::string TransactionManager::submit_transaction(const Transaction &transaction)
@@ -746,48 +1156,56 @@ namespace cardano_iot
             {
                 return "";
             }
+            return submit_transaction(Transaction(transaction));
+        }
 
-            // Store transaction
+        std::string TransactionManager::submit_transaction(Transaction &&submitted)
+        {
+            if (!pimpl_->initialized_)
             {
-                std::lock_guard<std::mutex> lock(pimpl_->transactions_mutex_);
-                auto tx_copy = std::make_unique<Transaction>(transaction);
-                tx_copy->status = TransactionStatus::SUBMITTED;
-                tx_copy->submitted_timestamp = std::chrono::duration_cast<std::chrono::seconds>(
-                                                   std::chrono::system_clock::now().time_since_epoch())
-                                                   .count();
+                return "";
+            }
 
-                pimpl_->transactions_[transaction.tx_id] = std::move(tx_copy);
+            // Store transaction; the rest of the submission reads the stored snapshot
+            submitted.status = TransactionStatus::SUBMITTED;
+            submitted.submitted_timestamp = Impl::now_seconds();
+            std::shared_ptr<const Transaction> record;
+            {
+                std::lock_guard<std::mutex> lock(pimpl_->transactions_mutex_);
+                record = pimpl_->history_.put(std::move(submitted));
+                pimpl_->prune_history(false);
             }
+            const Transaction &transaction = *record;
 
             // Submit to network (mock)
             std::string result = pimpl_->submit_to_network(transaction);
 
             if (!result.empty())
             {
-                std::lock_guard<std::mutex> stats_lock(pimpl_->stats_mutex_);
-                pimpl_->stats_.total_transactions++;
-                pimpl_->stats_.pending_transactions++;
-                pimpl_->stats_.total_fees_paid += transaction.fee;
-                pimpl_->stats_.avg_fee_per_transaction =
-                    pimpl_->stats_.total_transactions > 0
-                        ? static_cast<double>(pimpl_->stats_.total_fees_paid) / static_cast<double>(pimpl_->stats_.total_transactions)
-                        : 0.0;
+                pimpl_->utxo_set_.apply_submitted(transaction);
+                if (pimpl_->tracker_)
+                {
+                    pimpl_->tracker_->track(transaction.tx_id, std::chrono::seconds(300));
+                }
 
-                utils::Logger::instance().log(utils::LogLevel::INFO, "TransactionManager",
-                                              "Transaction submitted successfully: " + transaction.tx_id);
+                pimpl_->submitted_.inc();
+                pimpl_->pending_.add(1);
+                pimpl_->fees_paid_.inc(transaction.fee);
+
+                CARDANO_IOT_LOG(utils::LogLevel::INFO, "TransactionManager",
+                                "Transaction submitted successfully: " << transaction.tx_id);
             }
             else
             {
+                pimpl_->utxo_set_.release(transaction.tx_id);
+
                 std::lock_guard<std::mutex> lock(pimpl_->transactions_mutex_);
-                auto it = pimpl_->transactions_.find(transaction.tx_id);
-                if (it != pimpl_->transactions_.end())
-                {
-                    it->second->status = TransactionStatus::FAILED;
-                    it->second->error_message = "Network submission failed";
-                }
+                pimpl_->history_.update(transaction.tx_id, [](Transaction &tx)
+                                        {
+                                            tx.status = TransactionStatus::FAILED;
+                                            tx.error_message = "Network submission failed"; });
 
-                std::lock_guard<std::mutex> stats_lock(pimpl_->stats_mutex_);
-                pimpl_->stats_.failed_transactions++;
+                pimpl_->failed_.inc();
 
                 utils::Logger::instance().log(utils::LogLevel::ERROR, "TransactionManager",
                                               "Transaction submission failed: " + transaction.tx_id);
@@ -800,16 +1218,26 @@ namespace cardano_iot
         {
             std::lock_guard<std::mutex> lock(pimpl_->transactions_mutex_);
 
-            auto it = pimpl_->transactions_.find(tx_id);
-            if (it != pimpl_->transactions_.end() && it->second->status == TransactionStatus::PENDING)
+            const Transaction *tx = pimpl_->history_.find(tx_id);
+            if (tx && tx->status == TransactionStatus::PENDING)
             {
-                it->second->status = TransactionStatus::CANCELLED;
+                pimpl_->history_.update(tx_id, [](Transaction &record)
+                                        { record.status = TransactionStatus::CANCELLED; });
+                pimpl_->utxo_set_.release(tx_id);
 
                 utils::Logger::instance().log(utils::LogLevel::INFO, "TransactionManager",
                                               "Transaction cancelled: " + tx_id);
                 return true;
             }
 
+            // Built but never submitted: just give its inputs back
+            if (pimpl_->utxo_set_.release(tx_id) > 0)
+            {
+                utils::Logger::instance().log(utils::LogLevel::INFO, "TransactionManager",
+                                              "Released inputs of unsubmitted transaction: " + tx_id);
+                return true;
+            }
+
             return false;
         }
 
@@ -817,146 +1245,167 @@ namespace cardano_iot
         {
             std::lock_guard<std::mutex> lock(pimpl_->transactions_mutex_);
 
-            auto it = pimpl_->transactions_.find(tx_id);
-            if (it != pimpl_->transactions_.end())
+            const Transaction *tx = pimpl_->history_.find(tx_id);
+            if (tx)
             {
                 // Check for confirmation
-                if (it->second->status == TransactionStatus::SUBMITTED)
+                if (tx->status == TransactionStatus::SUBMITTED && pimpl_->check_confirmation(tx_id))
                 {
-                    if (pimpl_->check_confirmation(tx_id))
-                    {
-                        it->second->status = TransactionStatus::CONFIRMED;
-                        it->second->confirmed_timestamp = std::chrono::duration_cast<std::chrono::seconds>(
-                                                              std::chrono::system_clock::now().time_since_epoch())
-                                                              .count();
-
-                        // Update statistics on confirmation
-                        {
-                            std::lock_guard<std::mutex> stats_lock(pimpl_->stats_mutex_);
-                            if (pimpl_->stats_.pending_transactions > 0)
-                            {
-                                pimpl_->stats_.pending_transactions--;
-                            }
-                            pimpl_->stats_.confirmed_transactions++;
-                            // confirmation time
-                            if (it->second->submitted_timestamp > 0 && it->second->confirmed_timestamp > 0)
-                            {
-                                double conf_time = static_cast<double>(it->second->confirmed_timestamp - it->second->submitted_timestamp);
-                                // simple moving average
-                                if (pimpl_->stats_.confirmed_transactions > 0)
-                                {
-                                    double prev_avg = pimpl_->stats_.avg_confirmation_time_seconds;
-                                    double n = static_cast<double>(pimpl_->stats_.confirmed_transactions);
-                                    pimpl_->stats_.avg_confirmation_time_seconds = prev_avg + (conf_time - prev_avg) / n;
-                                }
-                                else
-                                {
-                                    pimpl_->stats_.avg_confirmation_time_seconds = conf_time;
-                                }
-                            }
-                            // total volume (sum of output lovelace excluding change is complex; approximate by sum outputs)
-                            uint64_t volume = 0;
-                            for (const auto &out : it->second->outputs)
-                            {
-                                volume += out.amount_lovelace;
-                            }
-                            pimpl_->stats_.total_volume_lovelace += volume;
-                        }
-                    }
+                    Impl *impl = pimpl_.get();
+                    pimpl_->history_.update(tx_id, [impl](Transaction &record)
+                                            { impl->mark_confirmed(record); });
+                    return TransactionStatus::CONFIRMED;
                 }
-                return it->second->status;
+                return tx->status;
             }
 
-            return TransactionStatus::FAILED;
+            // Only finished transactions are archived
+            auto archived = pimpl_->archive_.find(tx_id);
+            return archived ? archived->status : TransactionStatus::FAILED;
         }
 
         std::unique_ptr<Transaction> TransactionManager::get_transaction(const std::string &tx_id) const
         {
             std::lock_guard<std::mutex> lock(pimpl_->transactions_mutex_);
 
-            auto it = pimpl_->transactions_.find(tx_id);
-            if (it != pimpl_->transactions_.end())
+            const Transaction *tx = pimpl_->history_.find(tx_id);
+            if (tx)
             {
-                return std::make_unique<Transaction>(*it->second);
+                return std::make_unique<Transaction>(*tx);
             }
 
-            return nullptr;
+            return pimpl_->archive_.find(tx_id);
         }
 
         std::vector<Transaction> TransactionManager::get_transactions_by_device(const std::string &device_id) const
         {
-            std::lock_guard<std::mutex> lock(pimpl_->transactions_mutex_);
+            // Snapshot under the lock, copy outside it
+            std::vector<std::shared_ptr<const Transaction>> records;
+            {
+                std::lock_guard<std::mutex> lock(pimpl_->transactions_mutex_);
+                records = pimpl_->history_.for_device(device_id);
+            }
 
             std::vector<Transaction> result;
-            for (const auto &[tx_id, tx] : pimpl_->transactions_)
+            result.reserve(records.size());
+            for (const auto &record : records)
             {
-                if (tx->device_id == device_id)
-                {
-                    result.push_back(*tx);
-                }
+                result.push_back(*record);
             }
-
             return result;
         }
 
         std::vector<Transaction> TransactionManager::get_pending_transactions() const
         {
-            std::lock_guard<std::mutex> lock(pimpl_->transactions_mutex_);
+            std::vector<std::shared_ptr<const Transaction>> records;
+            {
+                std::lock_guard<std::mutex> lock(pimpl_->transactions_mutex_);
+                records = pimpl_->history_.with_status(TransactionStatus::PENDING);
+                auto submitted = pimpl_->history_.with_status(TransactionStatus::SUBMITTED);
+                records.insert(records.end(), submitted.begin(), submitted.end());
+            }
 
             std::vector<Transaction> result;
-            for (const auto &[tx_id, tx] : pimpl_->transactions_)
+            result.reserve(records.size());
+            for (const auto &record : records)
             {
-                if (tx->status == TransactionStatus::PENDING || tx->status == TransactionStatus::SUBMITTED)
-                {
-                    result.push_back(*tx);
-                }
+                result.push_back(*record);
             }
-
             return result;
         }
 
+        bool TransactionManager::set_history_options(const HistoryOptions &options)
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->transactions_mutex_);
+            pimpl_->archive_.close();
+            pimpl_->history_options_ = options;
+            if (!options.archive_path.empty() && !pimpl_->archive_.open(options.archive_path))
+            {
+                pimpl_->history_options_.retention_seconds = 0; // Never drop what was meant to be archived
+                return false;
+            }
+            if (pimpl_->archive_.is_open())
+            {
+                utils::Logger::instance().log(utils::LogLevel::INFO, "TransactionManager",
+                                              "Archiving transactions to " + options.archive_path + " (" +
+                                                  std::to_string(pimpl_->archive_.record_count()) + " already archived)");
+            }
+            return true;
+        }
+
+        TransactionPage TransactionManager::list_transactions_by_device(const std::string &device_id, uint64_t cursor,
+                                                                        size_t limit) const
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->transactions_mutex_);
+            return pimpl_->history_.page_by_device(device_id, cursor, limit);
+        }
+
+        TransactionPage TransactionManager::list_transactions_by_status(TransactionStatus status, uint64_t cursor,
+                                                                        size_t limit) const
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->transactions_mutex_);
+            return pimpl_->history_.page_by_status(status, cursor, limit);
+        }
+
+        std::shared_ptr<const Transaction> TransactionManager::get_transaction_record(const std::string &tx_id) const
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->transactions_mutex_);
+            return pimpl_->history_.snapshot(tx_id);
+        }
+
+        size_t TransactionManager::prune_history()
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->transactions_mutex_);
+            return pimpl_->prune_history(true);
+        }
+
+        size_t TransactionManager::history_size() const
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->transactions_mutex_);
+            return pimpl_->history_.size();
+        }
+
         void TransactionManager::set_confirmation_callback(ConfirmationCallback callback)
         {
+            std::lock_guard<std::mutex> lock(pimpl_->callback_mutex_);
             pimpl_->confirmation_callback_ = callback;
         }
 
         void TransactionManager::wait_for_confirmation(const std::string &tx_id, uint32_t timeout_seconds)
         {
-            auto start_time = std::chrono::steady_clock::now();
-
-            while (true)
+            // Blocks only this caller; the tracker thread does the checking and invokes the callback
+            auto result = track_confirmation(tx_id, timeout_seconds);
+            const auto status = result.wait_for(std::chrono::seconds(timeout_seconds) + std::chrono::seconds(1));
+            if (status != std::future_status::ready || (!result.get() && get_transaction_status(tx_id) == TransactionStatus::SUBMITTED))
             {
-                auto status = get_transaction_status(tx_id);
-                if (status == TransactionStatus::CONFIRMED)
-                {
-                    if (pimpl_->confirmation_callback_)
-                    {
-                        pimpl_->confirmation_callback_(tx_id, true);
-                    }
-                    break;
-                }
-
-                if (status == TransactionStatus::FAILED)
-                {
-                    if (pimpl_->confirmation_callback_)
-                    {
-                        pimpl_->confirmation_callback_(tx_id, false);
-                    }
-                    break;
-                }
-
-                auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(
-                                   std::chrono::steady_clock::now() - start_time)
-                                   .count();
+                utils::Logger::instance().log(utils::LogLevel::WARNING, "TransactionManager",
+                                              "Transaction confirmation timeout: " + tx_id);
+            }
+        }
 
-                if (elapsed >= timeout_seconds)
-                {
-                    utils::Logger::instance().log(utils::LogLevel::WARNING, "TransactionManager",
-                                                  "Transaction confirmation timeout: " + tx_id);
-                    break;
-                }
+        std::future<bool> TransactionManager::track_confirmation(const std::string &tx_id, uint32_t timeout_seconds)
+        {
+            if (!pimpl_->initialized_ || !pimpl_->tracker_)
+            {
+                std::promise<bool> unresolved;
+                unresolved.set_value(false);
+                return unresolved.get_future();
+            }
+            auto future = pimpl_->tracker_->track(tx_id, std::chrono::seconds(timeout_seconds));
+            pimpl_->tracker_->request_check();
+            return future;
+        }
 
-                std::this_thread::sleep_for(std::chrono::seconds(1));
+        void TransactionManager::set_chain_client(std::shared_ptr<network::CardanoClient> client)
+        {
+            pimpl_->detach_chain();
+            {
+                std::lock_guard<std::mutex> lock(pimpl_->client_mutex_);
+                pimpl_->chain_client_ = std::move(client);
+            }
+            if (pimpl_->tracker_ && pimpl_->tracker_->is_running())
+            {
+                pimpl_->attach_chain();
             }
         }
 
@@ -975,7 +1424,19 @@ namespace cardano_iot
             uint64_t target_amount,
             const std::map<std::string, uint64_t> &required_tokens) const
         {
-            return pimpl_->select_utxos_impl(available_utxos, target_amount, required_tokens, pimpl_->utxo_strategy_);
+            PROFILE_SCOPE("TransactionManager::select_utxos");
+            CoinSelectionIndex index(available_utxos);
+            return CoinSelector::select(index, target_amount, required_tokens, pimpl_->utxo_strategy_,
+                                        pimpl_->coin_selection_params())
+                .selected;
+        }
+
+        CoinSelectionResult TransactionManager::select_coins(
+            const std::string &address,
+            uint64_t target_amount,
+            const std::map<std::string, uint64_t> &required_tokens) const
+        {
+            return pimpl_->select(address, target_amount, required_tokens);
         }
 
         bool TransactionManager::create_multisig_transaction(
@@ -996,15 +1457,31 @@ namespace cardano_iot
             const std::string &signature,
             const std::string &public_key)
         {
-            std::lock_guard<std::mutex> lock(pimpl_->transactions_mutex_);
+            return add_multisig_signatures(tx_id, {{signature, public_key}});
+        }
 
-            auto it = pimpl_->transactions_.find(tx_id);
-            if (it != pimpl_->transactions_.end())
+        bool TransactionManager::add_multisig_signatures(
+            const std::string &tx_id,
+            const std::vector<std::pair<std::string, std::string>> &signatures)
+        {
+            std::vector<std::string> witnesses;
+            witnesses.reserve(signatures.size());
+            for (const auto &[signature, public_key] : signatures)
             {
-                it->second->witnesses.push_back(signature + ":" + public_key);
+                witnesses.push_back(Impl::multisig_witness(signature, public_key));
+            }
 
+            std::lock_guard<std::mutex> lock(pimpl_->transactions_mutex_);
+            if (pimpl_->history_.update(tx_id, [&](Transaction &tx)
+                                        {
+                                            if (Impl::append_witnesses(tx, witnesses) > 0)
+                                            {
+                                                Impl::refresh_cbor(tx);
+                                            } }))
+            {
                 utils::Logger::instance().log(utils::LogLevel::INFO, "TransactionManager",
-                                              "Added multisig signature to: " + tx_id);
+                                              "Added " + std::to_string(witnesses.size()) +
+                                                  " multisig signatures to: " + tx_id);
                 return true;
             }
 
@@ -1026,14 +1503,30 @@ namespace cardano_iot
 
         TransactionManager::TransactionStats TransactionManager::get_statistics() const
         {
-            std::lock_guard<std::mutex> lock(pimpl_->stats_mutex_);
-            return pimpl_->stats_;
+            TransactionStats stats = {};
+            stats.total_transactions = pimpl_->submitted_.value();
+            stats.confirmed_transactions = pimpl_->confirmed_.value();
+            stats.failed_transactions = pimpl_->failed_.value();
+            stats.total_fees_paid = pimpl_->fees_paid_.value();
+            stats.total_volume_lovelace = pimpl_->volume_.value();
+            stats.pending_transactions = static_cast<uint64_t>(pimpl_->pending_.value());
+            stats.avg_fee_per_transaction = stats.total_transactions > 0
+                                                ? static_cast<double>(stats.total_fees_paid) / static_cast<double>(stats.total_transactions)
+                                                : 0.0;
+            const auto confirmation = pimpl_->confirmation_seconds_.snapshot();
+            stats.avg_confirmation_time_seconds = confirmation.mean();
+            stats.p95_confirmation_time_seconds = confirmation.quantile(0.95);
+            return stats;
         }
 
         void TransactionManager::reset_statistics()
         {
-            std::lock_guard<std::mutex> lock(pimpl_->stats_mutex_);
-            pimpl_->stats_ = {};
+            for (auto *counter : {&pimpl_->submitted_, &pimpl_->confirmed_, &pimpl_->failed_, &pimpl_->fees_paid_, &pimpl_->volume_})
+            {
+                counter->reset();
+            }
+            pimpl_->pending_.set(0);
+            pimpl_->confirmation_seconds_.reset();
 
             utils::Logger::instance().log(utils::LogLevel::INFO, "TransactionManager",
                                           "Statistics reset");
@@ -1053,16 +1546,28 @@ namespace cardano_iot
 
         std::string TransactionManager::encode_transaction(const Transaction &transaction) const
         {
-            // Simplified CBOR encoding for demo
-            return "cbor_" + transaction.tx_id;
+            auto &buffer = Impl::encode_buffer();
+            buffer.reserve(cbor::encoded_size(transaction));
+            cbor::CborWriter writer(&buffer);
+            cbor::encode_transaction(transaction, writer);
+            return utils::codec::hex_encode(buffer);
         }
 
         std::unique_ptr<Transaction> TransactionManager::decode_transaction(const std::string &cbor_hex) const
         {
-            // Simplified CBOR decoding for demo
+            auto bytes = utils::codec::hex_decode(cbor_hex);
             auto transaction = std::make_unique<Transaction>();
-            transaction->tx_id = "decoded_" + cbor_hex.substr(0, 8);
+            if (bytes.empty() || !cbor::decode_transaction(bytes.data(), bytes.size(), *transaction))
+            {
+                utils::Logger::instance().log(utils::LogLevel::WARNING, "TransactionManager",
+                                              "Failed to decode transaction CBOR");
+                return nullptr;
+            }
+
+            transaction->tx_id = utils::codec::hex_encode(Impl::body_hash(*transaction));
+            transaction->type = transaction->metadata ? TransactionType::METADATA : TransactionType::PAYMENT;
             transaction->status = TransactionStatus::PENDING;
+            transaction->raw_cbor = cbor_hex;
 
             return transaction;
         }
@@ -0,0 +1,413 @@
+#include "cardano_iot/core/utxo_set.h"
+
+#include <algorithm>
+#include <shared_mutex>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace cardano_iot
+{
+    namespace core
+    {
+        class UtxoSet::Impl
+        {
+        public:
+            struct Entry
+            {
+                UTXO utxo;
+                UtxoState state = UtxoState::AVAILABLE;
+                std::string owner; // tx id holding the reservation or spend
+                bool confirmed = true;
+            };
+
+            struct AddressIndex
+            {
+                std::unordered_set<OutPoint, OutPointHash> outpoints;
+                uint64_t unspent_lovelace = 0;
+                uint64_t available_lovelace = 0;
+                std::map<std::string, uint64_t> unspent_tokens;
+                uint64_t version = 0;
+            };
+
+            mutable std::shared_mutex mutex_;
+            std::unordered_map<OutPoint, Entry, OutPointHash> entries_;
+            std::unordered_map<std::string, AddressIndex> addresses_;
+            std::unordered_map<std::string, std::vector<OutPoint>> owned_;   // owner -> reserved/spent out-points
+            std::unordered_map<std::string, std::vector<OutPoint>> created_; // tx id -> outputs it added
+
+            static OutPoint key_of(const UTXO &utxo) { return OutPoint{utxo.tx_hash, utxo.output_index}; }
+
+            void count_unspent(AddressIndex &index, const Entry &entry, bool add)
+            {
+                const auto &utxo = entry.utxo;
+                if (add)
+                {
+                    index.unspent_lovelace += utxo.amount_lovelace;
+                    for (const auto &[token, amount] : utxo.native_tokens)
+                        index.unspent_tokens[token] += amount;
+                }
+                else
+                {
+                    index.unspent_lovelace -= utxo.amount_lovelace;
+                    for (const auto &[token, amount] : utxo.native_tokens)
+                    {
+                        auto it = index.unspent_tokens.find(token);
+                        if (it != index.unspent_tokens.end() && (it->second -= amount) == 0)
+                            index.unspent_tokens.erase(it);
+                    }
+                }
+                ++index.version;
+            }
+
+            // Caller holds mutex_ exclusively
+            bool insert(Entry entry)
+            {
+                OutPoint key = key_of(entry.utxo);
+                if (entries_.count(key))
+                    return false;
+
+                auto &index = addresses_[entry.utxo.address];
+                index.outpoints.insert(key);
+                if (entry.state != UtxoState::SPENT)
+                    count_unspent(index, entry, true);
+                if (entry.state == UtxoState::AVAILABLE)
+                    index.available_lovelace += entry.utxo.amount_lovelace;
+                entries_.emplace(std::move(key), std::move(entry));
+                return true;
+            }
+
+            void erase(std::unordered_map<OutPoint, Entry, OutPointHash>::iterator it)
+            {
+                auto &entry = it->second;
+                auto &index = addresses_[entry.utxo.address];
+                if (entry.state != UtxoState::SPENT)
+                    count_unspent(index, entry, false);
+                if (entry.state == UtxoState::AVAILABLE)
+                    index.available_lovelace -= entry.utxo.amount_lovelace;
+                index.outpoints.erase(it->first);
+                entries_.erase(it);
+            }
+
+            void set_state(Entry &entry, UtxoState state, const std::string &owner)
+            {
+                auto &index = addresses_[entry.utxo.address];
+                const uint64_t amount = entry.utxo.amount_lovelace;
+
+                if (entry.state == UtxoState::AVAILABLE)
+                    index.available_lovelace -= amount;
+                if (state == UtxoState::AVAILABLE)
+                    index.available_lovelace += amount;
+
+                // Spending removes the output from the unspent aggregates (and selection indexes)
+                if (entry.state != UtxoState::SPENT && state == UtxoState::SPENT)
+                    count_unspent(index, entry, false);
+                else if (entry.state == UtxoState::SPENT && state != UtxoState::SPENT)
+                    count_unspent(index, entry, true);
+
+                entry.state = state;
+                entry.owner = state == UtxoState::AVAILABLE ? std::string() : owner;
+            }
+
+            template <typename Predicate>
+            std::vector<UTXO> collect(const std::string &address, Predicate keep) const
+            {
+                std::vector<UTXO> result;
+                auto it = addresses_.find(address);
+                if (it == addresses_.end())
+                    return result;
+                result.reserve(it->second.outpoints.size());
+                for (const auto &outpoint : it->second.outpoints)
+                {
+                    const auto &entry = entries_.at(outpoint);
+                    if (keep(entry))
+                        result.push_back(entry.utxo);
+                }
+                return result;
+            }
+        };
+
+        UtxoSet::UtxoSet() : pimpl_(std::make_unique<Impl>()) {}
+        UtxoSet::~UtxoSet() = default;
+
+        void UtxoSet::load_address(const std::string &address, std::vector<UTXO> utxos)
+        {
+            std::unique_lock<std::shared_mutex> lock(pimpl_->mutex_);
+
+            std::unordered_set<OutPoint, OutPointHash> snapshot;
+            for (const auto &utxo : utxos)
+                snapshot.insert(Impl::key_of(utxo));
+
+            // Drop confirmed outputs that are gone from the chain view; keep our own pending outputs
+            auto &index = pimpl_->addresses_[address];
+            std::vector<OutPoint> gone;
+            for (const auto &outpoint : index.outpoints)
+            {
+                const auto &entry = pimpl_->entries_.at(outpoint);
+                if (entry.confirmed && !snapshot.count(outpoint))
+                    gone.push_back(outpoint);
+            }
+            for (const auto &outpoint : gone)
+                pimpl_->erase(pimpl_->entries_.find(outpoint));
+
+            for (auto &utxo : utxos)
+            {
+                auto it = pimpl_->entries_.find(Impl::key_of(utxo));
+                if (it != pimpl_->entries_.end())
+                {
+                    it->second.confirmed = true;
+                    continue;
+                }
+                Impl::Entry entry;
+                entry.utxo = std::move(utxo);
+                pimpl_->insert(std::move(entry));
+            }
+            ++pimpl_->addresses_[address].version;
+        }
+
+        bool UtxoSet::add(const UTXO &utxo, bool confirmed)
+        {
+            std::unique_lock<std::shared_mutex> lock(pimpl_->mutex_);
+            Impl::Entry entry;
+            entry.utxo = utxo;
+            entry.confirmed = confirmed;
+            return pimpl_->insert(std::move(entry));
+        }
+
+        bool UtxoSet::remove(const OutPoint &outpoint)
+        {
+            std::unique_lock<std::shared_mutex> lock(pimpl_->mutex_);
+            auto it = pimpl_->entries_.find(outpoint);
+            if (it == pimpl_->entries_.end())
+                return false;
+            pimpl_->erase(it);
+            return true;
+        }
+
+        bool UtxoSet::reserve(const std::vector<OutPoint> &outpoints, const std::string &owner)
+        {
+            std::unique_lock<std::shared_mutex> lock(pimpl_->mutex_);
+
+            std::vector<Impl::Entry *> targets;
+            targets.reserve(outpoints.size());
+            for (const auto &outpoint : outpoints)
+            {
+                auto it = pimpl_->entries_.find(outpoint);
+                if (it == pimpl_->entries_.end() || it->second.state != UtxoState::AVAILABLE)
+                    return false;
+                targets.push_back(&it->second);
+            }
+
+            auto &owned = pimpl_->owned_[owner];
+            for (size_t i = 0; i < targets.size(); ++i)
+            {
+                pimpl_->set_state(*targets[i], UtxoState::RESERVED, owner);
+                owned.push_back(outpoints[i]);
+            }
+            return true;
+        }
+
+        size_t UtxoSet::release(const std::string &owner)
+        {
+            std::unique_lock<std::shared_mutex> lock(pimpl_->mutex_);
+            auto owned = pimpl_->owned_.find(owner);
+            if (owned == pimpl_->owned_.end())
+                return 0;
+
+            size_t released = 0;
+            std::vector<OutPoint> still_owned;
+            for (const auto &outpoint : owned->second)
+            {
+                auto it = pimpl_->entries_.find(outpoint);
+                if (it == pimpl_->entries_.end() || it->second.owner != owner)
+                    continue;
+                if (it->second.state == UtxoState::RESERVED)
+                {
+                    pimpl_->set_state(it->second, UtxoState::AVAILABLE, owner);
+                    ++released;
+                }
+                else
+                {
+                    still_owned.push_back(outpoint);
+                }
+            }
+
+            if (still_owned.empty())
+                pimpl_->owned_.erase(owned);
+            else
+                owned->second = std::move(still_owned);
+            return released;
+        }
+
+        void UtxoSet::apply_submitted(const Transaction &transaction)
+        {
+            std::unique_lock<std::shared_mutex> lock(pimpl_->mutex_);
+            const std::string &tx_id = transaction.tx_id;
+
+            std::vector<OutPoint> spent;
+            for (const auto &input : transaction.inputs)
+            {
+                OutPoint outpoint{input.tx_hash, input.output_index};
+                auto it = pimpl_->entries_.find(outpoint);
+                if (it == pimpl_->entries_.end() || it->second.state == UtxoState::SPENT)
+                    continue;
+                pimpl_->set_state(it->second, UtxoState::SPENT, tx_id);
+                spent.push_back(std::move(outpoint));
+            }
+
+            // Outputs whose reservation moved to a spend stay on the owner's list
+            auto &owned = pimpl_->owned_[tx_id];
+            for (auto &outpoint : spent)
+            {
+                if (std::find(owned.begin(), owned.end(), outpoint) == owned.end())
+                    owned.push_back(std::move(outpoint));
+            }
+            if (owned.empty())
+                pimpl_->owned_.erase(tx_id);
+
+            // Track outputs paying our addresses (e.g. change) as unconfirmed, so builds can chain off them
+            for (uint32_t i = 0; i < transaction.outputs.size(); ++i)
+            {
+                const auto &output = transaction.outputs[i];
+                if (!pimpl_->addresses_.count(output.address))
+                    continue;
+
+                Impl::Entry entry;
+                entry.utxo.tx_hash = tx_id;
+                entry.utxo.output_index = i;
+                entry.utxo.amount_lovelace = output.amount_lovelace;
+                entry.utxo.address = output.address;
+                entry.utxo.native_tokens = output.native_tokens;
+                entry.utxo.script_ref = output.script_ref;
+                entry.confirmed = false;
+                if (pimpl_->insert(std::move(entry)))
+                    pimpl_->created_[tx_id].push_back(OutPoint{tx_id, i});
+            }
+        }
+
+        void UtxoSet::apply_confirmed(const std::string &tx_id)
+        {
+            std::unique_lock<std::shared_mutex> lock(pimpl_->mutex_);
+
+            auto owned = pimpl_->owned_.find(tx_id);
+            if (owned != pimpl_->owned_.end())
+            {
+                for (const auto &outpoint : owned->second)
+                {
+                    auto it = pimpl_->entries_.find(outpoint);
+                    if (it != pimpl_->entries_.end() && it->second.state == UtxoState::SPENT && it->second.owner == tx_id)
+                        pimpl_->erase(it);
+                }
+                pimpl_->owned_.erase(owned);
+            }
+
+            auto created = pimpl_->created_.find(tx_id);
+            if (created != pimpl_->created_.end())
+            {
+                for (const auto &outpoint : created->second)
+                {
+                    auto it = pimpl_->entries_.find(outpoint);
+                    if (it != pimpl_->entries_.end())
+                        it->second.confirmed = true;
+                }
+                pimpl_->created_.erase(created);
+            }
+        }
+
+        void UtxoSet::apply_failed(const std::string &tx_id)
+        {
+            std::unique_lock<std::shared_mutex> lock(pimpl_->mutex_);
+
+            auto owned = pimpl_->owned_.find(tx_id);
+            if (owned != pimpl_->owned_.end())
+            {
+                for (const auto &outpoint : owned->second)
+                {
+                    auto it = pimpl_->entries_.find(outpoint);
+                    if (it != pimpl_->entries_.end() && it->second.owner == tx_id)
+                        pimpl_->set_state(it->second, UtxoState::AVAILABLE, tx_id);
+                }
+                pimpl_->owned_.erase(owned);
+            }
+
+            auto created = pimpl_->created_.find(tx_id);
+            if (created != pimpl_->created_.end())
+            {
+                for (const auto &outpoint : created->second)
+                {
+                    auto it = pimpl_->entries_.find(outpoint);
+                    if (it != pimpl_->entries_.end())
+                        pimpl_->erase(it);
+                }
+                pimpl_->created_.erase(created);
+            }
+        }
+
+        bool UtxoSet::is_available(const OutPoint &outpoint) const
+        {
+            std::shared_lock<std::shared_mutex> lock(pimpl_->mutex_);
+            auto it = pimpl_->entries_.find(outpoint);
+            return it != pimpl_->entries_.end() && it->second.state == UtxoState::AVAILABLE;
+        }
+
+        bool UtxoSet::has_address(const std::string &address) const
+        {
+            std::shared_lock<std::shared_mutex> lock(pimpl_->mutex_);
+            auto it = pimpl_->addresses_.find(address);
+            return it != pimpl_->addresses_.end() && !it->second.outpoints.empty();
+        }
+
+        std::vector<UTXO> UtxoSet::available(const std::string &address) const
+        {
+            std::shared_lock<std::shared_mutex> lock(pimpl_->mutex_);
+            return pimpl_->collect(address, [](const Impl::Entry &e)
+                                   { return e.state == UtxoState::AVAILABLE; });
+        }
+
+        std::vector<UTXO> UtxoSet::unspent(const std::string &address) const
+        {
+            std::shared_lock<std::shared_mutex> lock(pimpl_->mutex_);
+            return pimpl_->collect(address, [](const Impl::Entry &e)
+                                   { return e.state != UtxoState::SPENT; });
+        }
+
+        WalletBalance UtxoSet::balance(const std::string &address) const
+        {
+            WalletBalance balance{};
+            std::shared_lock<std::shared_mutex> lock(pimpl_->mutex_);
+            auto it = pimpl_->addresses_.find(address);
+            if (it == pimpl_->addresses_.end())
+                return balance;
+
+            balance.total_lovelace = it->second.unspent_lovelace;
+            balance.available_lovelace = it->second.available_lovelace;
+            balance.native_tokens = it->second.unspent_tokens;
+            balance.utxos = pimpl_->collect(address, [](const Impl::Entry &e)
+                                            { return e.state == UtxoState::AVAILABLE; });
+            return balance;
+        }
+
+        uint64_t UtxoSet::version(const std::string &address) const
+        {
+            std::shared_lock<std::shared_mutex> lock(pimpl_->mutex_);
+            auto it = pimpl_->addresses_.find(address);
+            return it != pimpl_->addresses_.end() ? it->second.version : 0;
+        }
+
+        size_t UtxoSet::size() const
+        {
+            std::shared_lock<std::shared_mutex> lock(pimpl_->mutex_);
+            return pimpl_->entries_.size();
+        }
+
+        void UtxoSet::clear()
+        {
+            std::unique_lock<std::shared_mutex> lock(pimpl_->mutex_);
+            pimpl_->entries_.clear();
+            pimpl_->addresses_.clear();
+            pimpl_->owned_.clear();
+            pimpl_->created_.clear();
+        }
+
+    } // namespace core
+} // namespace cardano_iot
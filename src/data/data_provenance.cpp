@@ -1,5 +1,13 @@
 #include "cardano_iot/data/data_provenance.h"
+#include "cardano_iot/data/provenance_log.h"
+#include "cardano_iot/core/transaction_manager.h"
+#include "cardano_iot/utils/codec.h"
+#include "cardano_iot/utils/hash.h"
 #include "cardano_iot/utils/logger.h"
+#include "cardano_iot/utils/metrics.h"
+#include "cardano_iot/utils/timer_wheel.h"
+
+#include <nlohmann/json.hpp>
 
 #include <chrono>
 #include <sstream>
@@ -7,29 +15,53 @@
 #include <algorithm>
 #include <mutex>
 #include <functional>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace cardano_iot
 {
     namespace data
     {
+        namespace
+        {
+            // Keeps one anchor record well inside the log's record limit
+            constexpr size_t MAX_ANCHOR_BATCH = 65536;
+        }
+
         struct DataProvenance::Impl
         {
             bool initialized_ = false;
             mutable std::mutex provenance_mutex_;
-            mutable std::mutex stats_mutex_;
 
-            // Storage
+            // Storage; events live only in the log, these maps hold their locations
             std::map<std::string, std::shared_ptr<DataAsset>> assets_;
-            std::map<std::string, std::vector<ProvenanceEvent>> asset_events_;
-            std::map<std::string, ProvenanceEvent> all_events_;
+            ProvenanceLog log_;
+            std::unordered_map<std::string, std::vector<uint64_t>> data_index_;
+            std::unordered_map<std::string, std::vector<uint64_t>> actor_index_;
+            std::unordered_map<std::string, uint64_t> event_index_;
 
             // Callbacks
             ProvenanceCallback global_callback_;
             std::map<std::string, ProvenanceCallback> data_callbacks_;
             std::map<std::string, ProvenanceCallback> actor_callbacks_;
 
-            // Statistics
-            ProvenanceStats stats_ = {};
+            // Anchoring; pending events are kept in submission order
+            std::shared_ptr<core::TransactionManager> transactions_;
+            AnchorOptions anchor_options_;
+            std::vector<uint64_t> pending_anchor_;
+            std::unordered_set<uint64_t> pending_set_;
+            utils::TimerWheel::Handle anchor_timer_;
+
+            // Statistics: per-core metrics; per-type counters follow the DataType and ProvenanceEventType orders
+            utils::metrics::CounterSet asset_counts_{"cardano_iot_provenance_assets_total", "Registered data assets by type", "type",
+                                               {"sensor_reading", "actuator_command", "system_log", "user_input", "computed_result"}};
+            utils::metrics::CounterSet event_counts_{"cardano_iot_provenance_events_total", "Recorded provenance events by type", "type",
+                                               {"created", "modified", "accessed", "transmitted", "stored", "deleted"}};
+            utils::metrics::Counter anchor_submissions_{"cardano_iot_provenance_anchor_submissions_total", "Anchor transactions submitted"};
+            utils::metrics::Counter anchored_events_{"cardano_iot_provenance_anchored_events_total", "Events covered by submitted anchors"};
+
+            // Last member, so pending callbacks are cancelled before anything else goes
+            utils::TimerWheel::Scope timers_;
 
             // Generate unique IDs
             std::string generate_event_id() const
@@ -60,35 +92,61 @@ namespace cardano_iot
                 return ss.str();
             }
 
-            // Compute SHA256 hash (simplified)
-            std::vector<uint8_t> compute_sha256(const std::vector<uint8_t> &data) const
+            void index_event(uint64_t location, const ProvenanceEvent &event)
             {
-                std::hash<std::string> hasher;
-                std::string data_str(data.begin(), data.end());
-                auto hash_value = hasher(data_str);
+                data_index_[event.data_id].push_back(location);
+                actor_index_[event.actor_id].push_back(location);
+                event_index_[event.event_id] = location;
 
-                std::vector<uint8_t> hash(32);
-                for (size_t i = 0; i < 32; ++i)
+                event_counts_[static_cast<size_t>(event.event_type)].inc();
+            }
+
+            std::vector<ProvenanceEvent> read_events(const std::vector<uint64_t> &locations)
+            {
+                std::vector<ProvenanceEvent> events;
+                events.reserve(locations.size());
+                for (uint64_t location : locations)
                 {
-                    hash[i] = static_cast<uint8_t>((hash_value >> (8 * (i % 8))) & 0xFF);
+                    ProvenanceEvent event;
+                    if (log_.read(location, event))
+                    {
+                        events.push_back(std::move(event));
+                    }
                 }
+                return events;
+            }
+
+            static ProvenanceEvent creation_event(const std::string &data_id, const std::string &creator_id)
+            {
+                ProvenanceEvent event;
+                event.data_id = data_id;
+                event.event_type = ProvenanceEventType::CREATED;
+                event.actor_id = creator_id;
+                event.properties["operation"] = "create";
+                event.properties["creator"] = creator_id;
+                return event;
+            }
 
-                return hash;
+            bool open_log(const ProvenanceLog::Options &options)
+            {
+                data_index_.clear();
+                actor_index_.clear();
+                event_index_.clear();
+                pending_anchor_.clear();
+                pending_set_.clear();
+                return log_.open(options, [this](uint64_t location, const ProvenanceEvent &event)
+                                 { index_event(location, event); });
             }
 
             // Process provenance event
-            void process_event(const ProvenanceEvent &event)
+            bool process_event(const ProvenanceEvent &event)
             {
-                // Store event
-                all_events_[event.event_id] = event;
-                asset_events_[event.data_id].push_back(event);
-
-                // Update statistics
+                const uint64_t location = log_.append(event);
+                if (location == ProvenanceLog::NO_LOCATION)
                 {
-                    std::lock_guard<std::mutex> stats_lock(stats_mutex_);
-                    stats_.total_events++;
-                    stats_.events_by_type[event.event_type]++;
+                    return false;
                 }
+                index_event(location, event);
 
                 // Notify callbacks
                 if (global_callback_)
@@ -107,6 +165,146 @@ namespace cardano_iot
                 {
                     actor_cb->second(event);
                 }
+                return true;
+            }
+
+            std::string submit_anchor(const MerkleHash &root, size_t events)
+            {
+                if (!transactions_)
+                {
+                    std::stringstream ss;
+                    ss << "tx_" << std::hex << std::random_device{}();
+                    return ss.str();
+                }
+
+                const std::string root_hex = utils::codec::hex_encode(std::string_view(
+                    reinterpret_cast<const char *>(root.data()), root.size()));
+                core::TransactionMetadata metadata;
+                metadata.labels["type"] = "provenance_anchor";
+                metadata.labels["merkle_root"] = root_hex;
+                metadata.labels["events"] = std::to_string(events);
+                metadata.json_metadata = nlohmann::json{{"merkle_root", root_hex},
+                                                        {"events", events},
+                                                        {"hash", "sha256"}}
+                                             .dump();
+                metadata.binary_metadata.assign(root.begin(), root.end());
+
+                auto transaction = transactions_->create_metadata_transaction(anchor_options_.from_address, metadata,
+                                                                              anchor_options_.device_id);
+                if (!transaction || transaction->inputs.empty())
+                {
+                    return "";
+                }
+                return transactions_->submit_transaction(*transaction);
+            }
+
+            // Anchor up to one batch of the queued events. Caller holds provenance_mutex_.
+            bool anchor_pending()
+            {
+                if (pending_anchor_.empty())
+                {
+                    return true;
+                }
+                const size_t batch = std::min(pending_anchor_.size(), anchor_options_.max_batch_events);
+                std::vector<uint64_t> locations;
+                std::vector<MerkleHash> leaves;
+                locations.reserve(batch);
+                leaves.reserve(batch);
+                for (size_t i = 0; i < batch; ++i)
+                {
+                    ProvenanceEvent event;
+                    if (log_.read(pending_anchor_[i], event))
+                    {
+                        locations.push_back(pending_anchor_[i]);
+                        leaves.push_back(ProvenanceLog::leaf_hash(event));
+                    }
+                }
+
+                MerkleTree tree(std::move(leaves));
+                const std::string transaction_hash = locations.empty() ? std::string() : submit_anchor(tree.root(), locations.size());
+                if (!locations.empty() && (transaction_hash.empty() || !log_.append_anchor(transaction_hash, locations, std::move(tree))))
+                {
+                    utils::Logger::instance().log(utils::LogLevel::WARNING, "DataProvenance",
+                                                  "Failed to anchor " + std::to_string(locations.size()) +
+                                                      " events; keeping them queued");
+                    return false;
+                }
+
+                for (size_t i = 0; i < batch; ++i)
+                {
+                    pending_set_.erase(pending_anchor_[i]);
+                }
+                pending_anchor_.erase(pending_anchor_.begin(), pending_anchor_.begin() + static_cast<std::ptrdiff_t>(batch));
+                if (locations.empty())
+                {
+                    return true;
+                }
+
+                anchor_submissions_.inc();
+                anchored_events_.inc(locations.size());
+                utils::Logger::instance().log(utils::LogLevel::INFO, "DataProvenance",
+                                              "Anchored " + std::to_string(locations.size()) +
+                                                  " events (TX: " + transaction_hash + ")");
+                return true;
+            }
+
+            // Caller holds provenance_mutex_
+            void schedule_anchor()
+            {
+                if (anchor_timer_.valid() || pending_anchor_.empty())
+                {
+                    return;
+                }
+                anchor_timer_ = timers_.schedule_after(anchor_options_.window, [this]
+                                                       {
+                    std::lock_guard<std::mutex> lock(provenance_mutex_);
+                    anchor_timer_ = {};
+                    if (!initialized_)
+                    {
+                        return;
+                    }
+                    while (!pending_anchor_.empty() && anchor_pending())
+                    {
+                    }
+                    schedule_anchor(); });
+            }
+
+            bool verify_anchor(uint64_t location, const ProvenanceEvent &event) const
+            {
+                MerkleProof proof;
+                return log_.proof_for(location, proof) && proof.leaf == ProvenanceLog::leaf_hash(event) && proof.verify();
+            }
+
+            // If the creation event is anchored, the hash it committed to must match and its proof must hold
+            bool check_integrity(const DataAsset &asset, const std::vector<uint8_t> &computed_hash)
+            {
+                if (computed_hash != asset.data_hash)
+                {
+                    return false;
+                }
+
+                std::lock_guard<std::mutex> lock(provenance_mutex_);
+                auto it = data_index_.find(asset.asset_id);
+                if (it == data_index_.end())
+                {
+                    return true;
+                }
+                for (uint64_t location : it->second)
+                {
+                    ProvenanceEvent event;
+                    if (log_.transaction_for(location).empty() || !log_.read(location, event) ||
+                        event.event_type != ProvenanceEventType::CREATED)
+                    {
+                        continue;
+                    }
+                    auto committed = event.properties.find("data_hash");
+                    if (committed == event.properties.end())
+                    {
+                        continue;
+                    }
+                    return committed->second == utils::codec::hex_encode(computed_hash) && verify_anchor(location, event);
+                }
+                return true;
             }
         };
 
@@ -114,6 +312,11 @@ namespace cardano_iot
         DataProvenance::~DataProvenance() = default;
 
         bool DataProvenance::initialize()
+        {
+            return initialize(std::string());
+        }
+
+        bool DataProvenance::initialize(const std::string &log_directory)
         {
             std::lock_guard<std::mutex> lock(pimpl_->provenance_mutex_);
 
@@ -122,10 +325,22 @@ namespace cardano_iot
                 return true;
             }
 
+            ProvenanceLog::Options options;
+            options.directory = log_directory;
+            if (!pimpl_->open_log(options))
+            {
+                utils::Logger::instance().log(utils::LogLevel::ERROR, "DataProvenance",
+                                              "Failed to open provenance log: " + log_directory);
+                return false;
+            }
+
             pimpl_->initialized_ = true;
 
             utils::Logger::instance().log(utils::LogLevel::INFO, "DataProvenance",
-                                          "Data provenance system initialized");
+                                          "Data provenance system initialized" +
+                                              (log_directory.empty() ? std::string()
+                                                                     : " with " + std::to_string(pimpl_->log_.event_count()) +
+                                                                           " events from " + log_directory));
             return true;
         }
 
@@ -138,10 +353,19 @@ namespace cardano_iot
                 return;
             }
 
+            // Anchor what is still queued before the log goes away
+            while (!pimpl_->pending_anchor_.empty() && pimpl_->anchor_pending())
+            {
+            }
+            pimpl_->timers_.cancel_all();
+            pimpl_->anchor_timer_ = {};
+
             // Clear all data
             pimpl_->assets_.clear();
-            pimpl_->asset_events_.clear();
-            pimpl_->all_events_.clear();
+            pimpl_->log_.close();
+            pimpl_->data_index_.clear();
+            pimpl_->actor_index_.clear();
+            pimpl_->event_index_.clear();
             pimpl_->data_callbacks_.clear();
             pimpl_->actor_callbacks_.clear();
             pimpl_->global_callback_ = nullptr;
@@ -169,15 +393,14 @@ namespace cardano_iot
                 pimpl_->assets_[asset_id] = shared_asset;
 
                 // Update statistics
-                {
-                    std::lock_guard<std::mutex> stats_lock(pimpl_->stats_mutex_);
-                    pimpl_->stats_.total_assets++;
-                    pimpl_->stats_.assets_by_type[asset.type]++;
-                }
+                pimpl_->asset_counts_[static_cast<size_t>(asset.type)].inc();
             }
 
-            // Record creation event outside of provenance lock to avoid deadlock
-            record_data_creation(asset_id, asset.creator_id);
+            // Record creation event outside of provenance lock to avoid deadlock. It commits to the
+            // data hash, so an anchored creation event vouches for the data.
+            ProvenanceEvent creation = Impl::creation_event(asset_id, asset.creator_id);
+            creation.properties["data_hash"] = utils::codec::hex_encode(asset.data_hash);
+            record_event(creation);
 
             utils::Logger::instance().log(utils::LogLevel::INFO, "DataProvenance",
                                           "Registered data asset: " + asset_id);
@@ -243,7 +466,12 @@ namespace cardano_iot
                                            .count();
             }
 
-            pimpl_->process_event(event_copy);
+            if (!pimpl_->process_event(event_copy))
+            {
+                utils::Logger::instance().log(utils::LogLevel::ERROR, "DataProvenance",
+                                              "Failed to append provenance event for data: " + event_copy.data_id);
+                return "";
+            }
 
             utils::Logger::instance().log(utils::LogLevel::INFO, "DataProvenance",
                                           "Recorded provenance event: " + event_copy.event_id +
@@ -254,14 +482,7 @@ namespace cardano_iot
 
         std::string DataProvenance::record_data_creation(const std::string &data_id, const std::string &creator_id)
         {
-            ProvenanceEvent event;
-            event.data_id = data_id;
-            event.event_type = ProvenanceEventType::CREATED;
-            event.actor_id = creator_id;
-            event.properties["operation"] = "create";
-            event.properties["creator"] = creator_id;
-
-            return record_event(event);
+            return record_event(Impl::creation_event(data_id, creator_id));
         }
 
         std::string DataProvenance::record_data_access(const std::string &data_id, const std::string &accessor_id)
@@ -285,10 +506,10 @@ namespace cardano_iot
 
             std::lock_guard<std::mutex> lock(pimpl_->provenance_mutex_);
 
-            auto it = pimpl_->asset_events_.find(data_id);
-            if (it != pimpl_->asset_events_.end())
+            auto it = pimpl_->data_index_.find(data_id);
+            if (it != pimpl_->data_index_.end())
             {
-                return it->second;
+                return pimpl_->read_events(it->second);
             }
 
             return {};
@@ -303,17 +524,15 @@ namespace cardano_iot
 
             std::lock_guard<std::mutex> lock(pimpl_->provenance_mutex_);
 
-            std::vector<ProvenanceEvent> actor_events;
-            for (const auto &[event_id, event] : pimpl_->all_events_)
+            auto it = pimpl_->actor_index_.find(actor_id);
+            if (it == pimpl_->actor_index_.end())
             {
-                if (event.actor_id == actor_id)
-                {
-                    actor_events.push_back(event);
-                }
+                return {};
             }
+            std::vector<ProvenanceEvent> actor_events = pimpl_->read_events(it->second);
 
-            // Sort by timestamp
-            std::sort(actor_events.begin(), actor_events.end(),
+            // Sort by timestamp; recording order breaks ties
+            std::stable_sort(actor_events.begin(), actor_events.end(),
                       [](const ProvenanceEvent &a, const ProvenanceEvent &b)
                       {
                           return a.timestamp < b.timestamp;
@@ -324,19 +543,79 @@ namespace cardano_iot
 
         std::vector<uint8_t> DataProvenance::compute_data_hash(const std::vector<uint8_t> &data) const
         {
-            return pimpl_->compute_sha256(data);
+            return compute_data_hash(data.data(), data.size());
+        }
+
+        std::vector<uint8_t> DataProvenance::compute_data_hash(const uint8_t *data, size_t size) const
+        {
+            return utils::tree_hash(data, size);
+        }
+
+        std::vector<uint8_t> DataProvenance::compute_file_hash(const std::string &path) const
+        {
+            return utils::tree_hash_file(path);
         }
 
         bool DataProvenance::verify_data_integrity(const std::string &asset_id, const std::vector<uint8_t> &current_data) const
+        {
+            return verify_data_integrity(asset_id, current_data.data(), current_data.size());
+        }
+
+        bool DataProvenance::verify_data_integrity(const std::string &asset_id, const uint8_t *data, size_t size) const
+        {
+            auto asset = get_data_asset(asset_id);
+            return asset && pimpl_->check_integrity(*asset, compute_data_hash(data, size));
+        }
+
+        bool DataProvenance::verify_file_integrity(const std::string &asset_id, const std::string &path) const
         {
             auto asset = get_data_asset(asset_id);
             if (!asset)
             {
                 return false;
             }
+            const std::vector<uint8_t> computed_hash = compute_file_hash(path);
+            return !computed_hash.empty() && pimpl_->check_integrity(*asset, computed_hash);
+        }
+
+        void DataProvenance::enable_anchoring(std::shared_ptr<core::TransactionManager> transactions,
+                                              const AnchorOptions &options)
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->provenance_mutex_);
 
-            auto computed_hash = compute_data_hash(current_data);
-            return computed_hash == asset->data_hash;
+            pimpl_->transactions_ = std::move(transactions);
+            pimpl_->anchor_options_ = options;
+            pimpl_->anchor_options_.max_batch_events =
+                std::min(std::max<size_t>(options.max_batch_events, 1), MAX_ANCHOR_BATCH);
+            if (pimpl_->anchor_timer_.valid())
+            {
+                pimpl_->timers_.cancel(pimpl_->anchor_timer_);
+                pimpl_->anchor_timer_ = {};
+            }
+            pimpl_->schedule_anchor();
+        }
+
+        size_t DataProvenance::set_anchor_batch_size(size_t max_batch_events)
+        {
+            bool full = false;
+            size_t limit = 0;
+            {
+                std::lock_guard<std::mutex> lock(pimpl_->provenance_mutex_);
+                pimpl_->anchor_options_.max_batch_events = std::min(std::max<size_t>(max_batch_events, 1), MAX_ANCHOR_BATCH);
+                limit = pimpl_->anchor_options_.max_batch_events;
+                full = pimpl_->transactions_ && pimpl_->pending_anchor_.size() >= limit;
+            }
+            if (full)
+            {
+                flush_anchors(); // A smaller limit may already be met
+            }
+            return limit;
+        }
+
+        DataProvenance::AnchorOptions DataProvenance::get_anchor_options() const
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->provenance_mutex_);
+            return pimpl_->anchor_options_;
         }
 
         bool DataProvenance::submit_to_blockchain(const std::string &event_id)
@@ -348,27 +627,48 @@ namespace cardano_iot
 
             std::lock_guard<std::mutex> lock(pimpl_->provenance_mutex_);
 
-            auto it = pimpl_->all_events_.find(event_id);
-            if (it != pimpl_->all_events_.end())
+            auto it = pimpl_->event_index_.find(event_id);
+            if (it == pimpl_->event_index_.end())
             {
-                // Mock blockchain submission
-                std::stringstream ss;
-                ss << "tx_" << std::hex << std::random_device{}();
-                it->second.transaction_hash = ss.str();
+                return false;
+            }
+            if (pimpl_->pending_set_.insert(it->second).second)
+            {
+                pimpl_->pending_anchor_.push_back(it->second);
+            }
 
-                // Update statistics
+            // Without a transaction manager there is nothing to amortise, so anchor right away
+            if (!pimpl_->transactions_ || pimpl_->pending_anchor_.size() >= pimpl_->anchor_options_.max_batch_events)
+            {
+                return pimpl_->anchor_pending();
+            }
+            pimpl_->schedule_anchor();
+            return true;
+        }
+
+        bool DataProvenance::flush_anchors()
+        {
+            if (!pimpl_->initialized_)
+            {
+                return false;
+            }
+
+            std::lock_guard<std::mutex> lock(pimpl_->provenance_mutex_);
+
+            while (!pimpl_->pending_anchor_.empty())
+            {
+                if (!pimpl_->anchor_pending())
                 {
-                    std::lock_guard<std::mutex> stats_lock(pimpl_->stats_mutex_);
-                    pimpl_->stats_.blockchain_submissions++;
+                    return false;
                 }
-
-                utils::Logger::instance().log(utils::LogLevel::INFO, "DataProvenance",
-                                              "Submitted event to blockchain: " + event_id +
-                                                  " (TX: " + it->second.transaction_hash + ")");
-                return true;
             }
+            return true;
+        }
 
-            return false;
+        size_t DataProvenance::pending_anchor_count() const
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->provenance_mutex_);
+            return pimpl_->pending_anchor_.size();
         }
 
         std::string DataProvenance::get_blockchain_transaction(const std::string &event_id) const
@@ -380,25 +680,73 @@ namespace cardano_iot
 
             std::lock_guard<std::mutex> lock(pimpl_->provenance_mutex_);
 
-            auto it = pimpl_->all_events_.find(event_id);
-            if (it != pimpl_->all_events_.end())
+            auto it = pimpl_->event_index_.find(event_id);
+            if (it != pimpl_->event_index_.end())
             {
-                return it->second.transaction_hash;
+                return pimpl_->log_.transaction_for(it->second);
             }
 
             return "";
         }
 
+        bool DataProvenance::get_inclusion_proof(const std::string &event_id, MerkleProof &proof) const
+        {
+            if (!pimpl_->initialized_)
+            {
+                return false;
+            }
+
+            std::lock_guard<std::mutex> lock(pimpl_->provenance_mutex_);
+
+            auto it = pimpl_->event_index_.find(event_id);
+            return it != pimpl_->event_index_.end() && pimpl_->log_.proof_for(it->second, proof);
+        }
+
+        bool DataProvenance::verify_event_anchor(const std::string &event_id) const
+        {
+            if (!pimpl_->initialized_)
+            {
+                return false;
+            }
+
+            std::lock_guard<std::mutex> lock(pimpl_->provenance_mutex_);
+
+            auto it = pimpl_->event_index_.find(event_id);
+            ProvenanceEvent event;
+            return it != pimpl_->event_index_.end() && pimpl_->log_.read(it->second, event) &&
+                   pimpl_->verify_anchor(it->second, event);
+        }
+
         DataProvenance::ProvenanceStats DataProvenance::get_statistics() const
         {
-            std::lock_guard<std::mutex> lock(pimpl_->stats_mutex_);
-            return pimpl_->stats_;
+            ProvenanceStats stats = {};
+            for (size_t i = 0; i < pimpl_->asset_counts_.size(); ++i)
+            {
+                if (const uint64_t count = pimpl_->asset_counts_[i].value())
+                {
+                    stats.assets_by_type[static_cast<DataType>(i)] = count;
+                    stats.total_assets += count;
+                }
+            }
+            for (size_t i = 0; i < pimpl_->event_counts_.size(); ++i)
+            {
+                if (const uint64_t count = pimpl_->event_counts_[i].value())
+                {
+                    stats.events_by_type[static_cast<ProvenanceEventType>(i)] = count;
+                    stats.total_events += count;
+                }
+            }
+            stats.blockchain_submissions = pimpl_->anchor_submissions_.value();
+            stats.anchored_events = pimpl_->anchored_events_.value();
+            return stats;
         }
 
         void DataProvenance::reset_statistics()
         {
-            std::lock_guard<std::mutex> lock(pimpl_->stats_mutex_);
-            pimpl_->stats_ = {};
+            pimpl_->asset_counts_.reset();
+            pimpl_->event_counts_.reset();
+            pimpl_->anchor_submissions_.reset();
+            pimpl_->anchored_events_.reset();
 
             utils::Logger::instance().log(utils::LogLevel::INFO, "DataProvenance",
                                           "Statistics reset");
@@ -0,0 +1,132 @@
+#include "cardano_iot/data/merkle_tree.h"
+
+#include <openssl/evp.h>
+#include <openssl/sha.h>
+
+#include <algorithm>
+
+namespace cardano_iot
+{
+    namespace data
+    {
+        namespace
+        {
+            constexpr uint8_t LEAF_PREFIX = 0x00;
+            constexpr uint8_t NODE_PREFIX = 0x01;
+
+            const std::vector<MerkleHash> NO_LEAVES;
+        }
+
+        MerkleTree::MerkleTree(std::vector<MerkleHash> leaves)
+        {
+            if (leaves.empty())
+            {
+                return;
+            }
+            levels_.push_back(std::move(leaves));
+            while (levels_.back().size() > 1)
+            {
+                const std::vector<MerkleHash> &below = levels_.back();
+                std::vector<MerkleHash> level;
+                level.reserve((below.size() + 1) / 2);
+                for (size_t i = 0; i + 1 < below.size(); i += 2)
+                {
+                    level.push_back(hash_node(below[i], below[i + 1]));
+                }
+                if (below.size() % 2 == 1)
+                {
+                    level.push_back(below.back());
+                }
+                levels_.push_back(std::move(level));
+            }
+        }
+
+        MerkleHash MerkleTree::hash_leaf(const uint8_t *data, size_t size)
+        {
+            MerkleHash hash;
+            EVP_MD_CTX *context = EVP_MD_CTX_new();
+            const bool ok = context && EVP_DigestInit_ex(context, EVP_sha256(), nullptr) == 1 &&
+                            EVP_DigestUpdate(context, &LEAF_PREFIX, 1) == 1 &&
+                            EVP_DigestUpdate(context, data, size) == 1 &&
+                            EVP_DigestFinal_ex(context, hash.data(), nullptr) == 1;
+            EVP_MD_CTX_free(context);
+            if (!ok)
+            {
+                hash.fill(0);
+            }
+            return hash;
+        }
+
+        MerkleHash MerkleTree::hash_node(const MerkleHash &left, const MerkleHash &right)
+        {
+            uint8_t input[1 + 2 * sizeof(MerkleHash)];
+            input[0] = NODE_PREFIX;
+            std::copy(left.begin(), left.end(), input + 1);
+            std::copy(right.begin(), right.end(), input + 1 + left.size());
+
+            MerkleHash hash;
+            SHA256(input, sizeof(input), hash.data());
+            return hash;
+        }
+
+        MerkleHash MerkleTree::root() const
+        {
+            return levels_.empty() ? MerkleHash{} : levels_.back().front();
+        }
+
+        const std::vector<MerkleHash> &MerkleTree::leaves() const
+        {
+            return levels_.empty() ? NO_LEAVES : levels_.front();
+        }
+
+        std::vector<MerkleHash> MerkleTree::path(size_t index) const
+        {
+            std::vector<MerkleHash> siblings;
+            if (index >= leaf_count())
+            {
+                return siblings;
+            }
+            for (size_t level = 0; level + 1 < levels_.size(); ++level, index /= 2)
+            {
+                const size_t sibling = index ^ 1;
+                if (sibling < levels_[level].size())
+                {
+                    siblings.push_back(levels_[level][sibling]);
+                }
+            }
+            return siblings;
+        }
+
+        bool MerkleTree::verify(const MerkleHash &leaf, size_t index, size_t leaf_count,
+                                const std::vector<MerkleHash> &path, const MerkleHash &root)
+        {
+            if (index >= leaf_count)
+            {
+                return false;
+            }
+            MerkleHash hash = leaf;
+            size_t used = 0;
+            for (size_t width = leaf_count; width > 1; width = (width + 1) / 2, index /= 2)
+            {
+                if (index % 2 == 1)
+                {
+                    if (used == path.size())
+                    {
+                        return false;
+                    }
+                    hash = hash_node(path[used++], hash);
+                }
+                else if (index + 1 < width)
+                {
+                    if (used == path.size())
+                    {
+                        return false;
+                    }
+                    hash = hash_node(hash, path[used++]);
+                }
+            }
+            return used == path.size() && hash == root;
+        }
+
+    } // namespace data
+} // namespace cardano_iot
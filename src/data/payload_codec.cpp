@@ -0,0 +1,672 @@
+#include "cardano_iot/data/payload_codec.h"
+#include "cardano_iot/utils/logger.h"
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#ifdef CARDANO_IOT_HAVE_ZSTD
+#include <zdict.h>
+#include <zstd.h>
+#endif
+
+namespace cardano_iot
+{
+    namespace data
+    {
+        namespace
+        {
+            constexpr uint8_t MAGIC = 0xC1; // Never valid in UTF-8
+
+            enum Mode : uint8_t
+            {
+                MODE_STORED = 0,     // Payload follows unchanged (it started with MAGIC itself)
+                MODE_REFERENCE = 1,  // varint content id
+                MODE_NUMERIC = 2,    // varint template id, varint keyframe id, zigzag varint delta per number
+                MODE_COMPRESSED = 3, // varint dictionary id (0 = none), varint raw size, zstd frame
+            };
+
+            constexpr size_t MAX_DIGITS = 18;               // Scaled values stay below 10^18
+            constexpr int64_t MAX_MAGNITUDE = 999999999999999999;
+            constexpr uint64_t MAX_COMPRESSED_SIZE = 1u << 26; // Sanity bound when decoding
+
+            void put_varint(std::string &out, uint64_t value)
+            {
+                while (value >= 0x80)
+                {
+                    out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+                    value >>= 7;
+                }
+                out.push_back(static_cast<char>(value));
+            }
+
+            bool get_varint(std::string_view &in, uint64_t &value)
+            {
+                value = 0;
+                for (int shift = 0; shift < 64 && !in.empty(); shift += 7)
+                {
+                    const auto byte = static_cast<uint8_t>(in.front());
+                    in.remove_prefix(1);
+                    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                    if (!(byte & 0x80))
+                    {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            uint64_t zigzag(int64_t value)
+            {
+                return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+            }
+
+            int64_t unzigzag(uint64_t value)
+            {
+                return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+            }
+
+            void start_frame(std::string &out, Mode mode)
+            {
+                out.clear();
+                out.push_back(static_cast<char>(MAGIC));
+                out.push_back(static_cast<char>(mode));
+            }
+
+            // Payload text with its decimal numbers taken out: literals.size() == scales.size() + 1
+            struct Template
+            {
+                std::vector<std::string> literals;
+                std::vector<uint8_t> scales; // Digits after the decimal point, per number
+            };
+
+            bool is_digit(char c)
+            {
+                return c >= '0' && c <= '9';
+            }
+
+            // Characters that make a digit part of a larger token (identifiers, versions, exponents)
+            bool is_token_char(char c)
+            {
+                return is_digit(c) || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c == '.' ||
+                       c == '-' || c == '+';
+            }
+
+            /**
+             * Parse a number that prints back exactly from (value, scale):
+             * -?(0|[1-9][0-9]*)(\.[0-9]+)? with at most MAX_DIGITS digits and not
+             * followed by another token character. "-0", "007" and "1e5" stay text.
+             */
+            bool parse_decimal(std::string_view text, size_t &length, int64_t &value, uint8_t &scale)
+            {
+                size_t i = 0;
+                const bool negative = !text.empty() && text[0] == '-';
+                if (negative)
+                {
+                    ++i;
+                }
+                if (i >= text.size() || !is_digit(text[i]))
+                {
+                    return false;
+                }
+
+                int64_t magnitude = 0;
+                size_t digits = 0;
+                const bool leading_zero = text[i] == '0';
+                while (i < text.size() && is_digit(text[i]))
+                {
+                    magnitude = digits < MAX_DIGITS ? magnitude * 10 + (text[i] - '0') : magnitude;
+                    ++digits;
+                    ++i;
+                }
+                if (leading_zero && digits > 1)
+                {
+                    return false;
+                }
+
+                size_t fraction = 0;
+                if (i < text.size() && text[i] == '.')
+                {
+                    ++i;
+                    while (i < text.size() && is_digit(text[i]))
+                    {
+                        magnitude = digits < MAX_DIGITS ? magnitude * 10 + (text[i] - '0') : magnitude;
+                        ++digits;
+                        ++fraction;
+                        ++i;
+                    }
+                    if (fraction == 0)
+                    {
+                        return false;
+                    }
+                }
+
+                if (digits > MAX_DIGITS || (i < text.size() && is_token_char(text[i])) || (negative && magnitude == 0))
+                {
+                    return false;
+                }
+
+                length = i;
+                value = negative ? -magnitude : magnitude;
+                scale = static_cast<uint8_t>(fraction);
+                return true;
+            }
+
+            void format_decimal(std::string &out, int64_t value, uint8_t scale)
+            {
+                if (value < 0)
+                {
+                    out.push_back('-');
+                }
+                std::string digits = std::to_string(value < 0 ? -value : value);
+                if (digits.size() <= scale)
+                {
+                    digits.insert(0, scale + 1 - digits.size(), '0');
+                }
+                out.append(digits, 0, digits.size() - scale);
+                if (scale > 0)
+                {
+                    out.push_back('.');
+                    out.append(digits, digits.size() - scale, scale);
+                }
+            }
+
+            // Split text into a template and its numbers; false if it holds none
+            bool split_numbers(std::string_view text, Template &shape, std::vector<int64_t> &values)
+            {
+                std::string literal;
+                bool in_string = false;
+                size_t i = 0;
+                while (i < text.size())
+                {
+                    const char c = text[i];
+                    if (in_string)
+                    {
+                        literal.push_back(c);
+                        if (c == '\\' && i + 1 < text.size())
+                        {
+                            literal.push_back(text[i + 1]);
+                            i += 2;
+                            continue;
+                        }
+                        in_string = c != '"';
+                        ++i;
+                        continue;
+                    }
+                    if (c == '"')
+                    {
+                        in_string = true;
+                        literal.push_back(c);
+                        ++i;
+                        continue;
+                    }
+
+                    size_t length = 0;
+                    int64_t value = 0;
+                    uint8_t scale = 0;
+                    if ((is_digit(c) || c == '-') && (i == 0 || !is_token_char(text[i - 1])) &&
+                        parse_decimal(text.substr(i), length, value, scale))
+                    {
+                        shape.literals.push_back(std::move(literal));
+                        literal.clear();
+                        shape.scales.push_back(scale);
+                        values.push_back(value);
+                        i += length;
+                        continue;
+                    }
+                    literal.push_back(c);
+                    ++i;
+                }
+                shape.literals.push_back(std::move(literal));
+                return !values.empty();
+            }
+
+            std::string template_key(const Template &shape)
+            {
+                std::string key;
+                for (size_t i = 0; i < shape.scales.size(); ++i)
+                {
+                    put_varint(key, shape.literals[i].size());
+                    key += shape.literals[i];
+                    key.push_back(static_cast<char>(shape.scales[i]));
+                }
+                key += shape.literals.back();
+                return key;
+            }
+        } // namespace
+
+        class PayloadCodec::Impl
+        {
+        public:
+            struct DeviceKeyframe
+            {
+                uint32_t id = 0;
+                uint32_t uses = 0;
+                bool valid = false;
+            };
+
+            struct DeviceState
+            {
+                std::unordered_map<uint32_t, DeviceKeyframe> keyframes; // By template id
+            };
+
+            explicit Impl(const Options &options) : options_(options)
+            {
+                options_.keyframe_interval = std::max<uint32_t>(1, options_.keyframe_interval);
+#ifdef CARDANO_IOT_HAVE_ZSTD
+                if (options_.compression)
+                {
+                    cctx_ = ZSTD_createCCtx();
+                    ZSTD_CCtx_setParameter(cctx_, ZSTD_c_compressionLevel, options_.compression_level);
+                    // The raw size travels in our own header; frames carry no redundant fields
+                    ZSTD_CCtx_setParameter(cctx_, ZSTD_c_contentSizeFlag, 0);
+                    ZSTD_CCtx_setParameter(cctx_, ZSTD_c_checksumFlag, 0);
+                    ZSTD_CCtx_setParameter(cctx_, ZSTD_c_dictIDFlag, 0);
+                }
+#else
+                if (options_.compression)
+                {
+                    utils::Logger::instance().log(utils::LogLevel::WARNING, "PayloadCodec",
+                                                  "Payload compression requested but the SDK was built without zstd");
+                    options_.compression = false;
+                }
+#endif
+            }
+
+            ~Impl()
+            {
+#ifdef CARDANO_IOT_HAVE_ZSTD
+                for (auto *dictionary : cdicts_)
+                {
+                    ZSTD_freeCDict(dictionary);
+                }
+                for (auto *dictionary : ddicts_)
+                {
+                    ZSTD_freeDDict(dictionary);
+                }
+                ZSTD_freeCCtx(cctx_);
+#endif
+            }
+
+            Options options_;
+            mutable std::shared_mutex mutex_;
+            Stats stats_;
+
+            // Dedup table; the deque keeps contents in place, so the index can view them
+            std::deque<std::string> contents_;
+            std::unordered_map<std::string_view, uint32_t> content_ids_;
+            std::unordered_set<size_t> seen_once_; // Hashes of payloads seen once; a second sighting admits them
+
+            std::vector<Template> templates_;
+            std::unordered_map<std::string, uint32_t> template_ids_;
+            std::vector<std::vector<int64_t>> keyframes_;
+
+            std::unordered_map<std::string, DeviceState> devices_;
+
+#ifdef CARDANO_IOT_HAVE_ZSTD
+            struct TypeState
+            {
+                std::vector<std::string> samples;
+                uint32_t dictionary = 0; // 1-based index into cdicts_/ddicts_
+                bool trained = false;    // Training was attempted
+            };
+            std::unordered_map<std::string, TypeState> types_;
+            std::vector<ZSTD_CDict *> cdicts_;
+            std::vector<ZSTD_DDict *> ddicts_;
+            ZSTD_CCtx *cctx_ = nullptr;
+#endif
+
+            // Caller must hold mutex_ exclusively
+            bool try_reference(std::string_view payload, std::string &out)
+            {
+                auto it = content_ids_.find(payload);
+                uint32_t id = 0;
+                if (it != content_ids_.end())
+                {
+                    id = it->second;
+                }
+                else
+                {
+                    // Unique payloads never enter the table; a hash collision only admits one early
+                    const size_t hash = std::hash<std::string_view>{}(payload);
+                    if (contents_.size() >= options_.max_entries || seen_once_.insert(hash).second)
+                    {
+                        if (seen_once_.size() > options_.max_entries)
+                        {
+                            seen_once_.clear();
+                        }
+                        return false;
+                    }
+                    seen_once_.erase(hash);
+                    id = static_cast<uint32_t>(contents_.size());
+                    contents_.emplace_back(payload);
+                    content_ids_.emplace(contents_.back(), id);
+                }
+
+                start_frame(out, MODE_REFERENCE);
+                put_varint(out, id);
+                return out.size() < payload.size();
+            }
+
+            // Caller must hold mutex_ exclusively
+            bool try_numeric(DeviceState &device, std::string_view payload, std::string &out)
+            {
+                Template shape;
+                std::vector<int64_t> values;
+                if (!split_numbers(payload, shape, values))
+                {
+                    return false;
+                }
+
+                std::string key = template_key(shape);
+                uint32_t template_id = 0;
+                auto it = template_ids_.find(key);
+                if (it != template_ids_.end())
+                {
+                    template_id = it->second;
+                }
+                else
+                {
+                    if (templates_.size() >= options_.max_entries)
+                    {
+                        return false;
+                    }
+                    template_id = static_cast<uint32_t>(templates_.size());
+                    templates_.push_back(std::move(shape));
+                    template_ids_.emplace(std::move(key), template_id);
+                }
+
+                auto &keyframe = device.keyframes[template_id];
+                if (!keyframe.valid || keyframe.uses >= options_.keyframe_interval)
+                {
+                    if (keyframes_.size() < options_.max_entries)
+                    {
+                        keyframe.id = static_cast<uint32_t>(keyframes_.size());
+                        keyframe.uses = 0;
+                        keyframe.valid = true;
+                        keyframes_.push_back(values);
+                    }
+                    else if (!keyframe.valid)
+                    {
+                        return false;
+                    }
+                }
+                ++keyframe.uses;
+
+                const auto &base = keyframes_[keyframe.id];
+                start_frame(out, MODE_NUMERIC);
+                put_varint(out, template_id);
+                put_varint(out, keyframe.id);
+                for (size_t i = 0; i < values.size(); ++i)
+                {
+                    put_varint(out, zigzag(values[i] - base[i]));
+                }
+                return out.size() < payload.size();
+            }
+
+#ifdef CARDANO_IOT_HAVE_ZSTD
+            // Caller must hold mutex_ exclusively
+            void collect_sample(TypeState &type, std::string_view data_type, std::string_view payload)
+            {
+                type.samples.emplace_back(payload);
+                if (type.samples.size() < options_.dictionary_samples)
+                {
+                    return;
+                }
+
+                std::string buffer;
+                std::vector<size_t> sizes;
+                sizes.reserve(type.samples.size());
+                for (const auto &sample : type.samples)
+                {
+                    buffer += sample;
+                    sizes.push_back(sample.size());
+                }
+                std::vector<char> dictionary(std::max<uint32_t>(256, options_.dictionary_size));
+                const size_t size = ZDICT_trainFromBuffer(dictionary.data(), dictionary.size(), buffer.data(),
+                                                          sizes.data(), static_cast<unsigned>(sizes.size()));
+                std::vector<std::string>().swap(type.samples);
+                type.trained = true;
+                if (ZDICT_isError(size))
+                {
+                    utils::Logger::instance().log(utils::LogLevel::WARNING, "PayloadCodec",
+                                                  "Dictionary training failed for data type " + std::string(data_type) +
+                                                      ": " + ZDICT_getErrorName(size));
+                    return;
+                }
+
+                cdicts_.push_back(ZSTD_createCDict(dictionary.data(), size, options_.compression_level));
+                ddicts_.push_back(ZSTD_createDDict(dictionary.data(), size));
+                type.dictionary = static_cast<uint32_t>(cdicts_.size());
+                ++stats_.dictionaries;
+                utils::Logger::instance().log(utils::LogLevel::INFO, "PayloadCodec",
+                                              "Trained a " + std::to_string(size) + " byte dictionary for data type " +
+                                                  std::string(data_type) + " from " + std::to_string(sizes.size()) +
+                                                  " payloads");
+            }
+
+            // Caller must hold mutex_ exclusively
+            bool try_compress(std::string_view data_type, std::string_view payload, std::string &out)
+            {
+                auto &type = types_[std::string(data_type)];
+                if (!type.trained)
+                {
+                    collect_sample(type, data_type, payload);
+                }
+
+                start_frame(out, MODE_COMPRESSED);
+                put_varint(out, type.dictionary);
+                put_varint(out, payload.size());
+                const size_t header = out.size();
+                out.resize(header + ZSTD_compressBound(payload.size()));
+
+                ZSTD_CCtx_reset(cctx_, ZSTD_reset_session_only);
+                ZSTD_CCtx_refCDict(cctx_, type.dictionary ? cdicts_[type.dictionary - 1] : nullptr);
+                const size_t size = ZSTD_compress2(cctx_, out.data() + header, out.size() - header, payload.data(),
+                                                   payload.size());
+                if (ZSTD_isError(size))
+                {
+                    return false;
+                }
+                out.resize(header + size);
+                return out.size() < payload.size();
+            }
+#endif
+
+            bool encode_unlocked(const std::string &device_id, std::string_view data_type, std::string_view payload,
+                                 std::string &out)
+            {
+                if (options_.dedup && try_reference(payload, out))
+                {
+                    ++stats_.deduplicated;
+                    return true;
+                }
+                if (options_.numeric_delta && try_numeric(devices_[device_id], payload, out))
+                {
+                    ++stats_.numeric;
+                    return true;
+                }
+#ifdef CARDANO_IOT_HAVE_ZSTD
+                if (options_.compression && try_compress(data_type, payload, out))
+                {
+                    ++stats_.compressed;
+                    return true;
+                }
+#else
+                (void)data_type;
+#endif
+                return false;
+            }
+
+            // Caller must hold mutex_ (shared is enough)
+            bool decode_numeric(std::string_view body, std::string &out) const
+            {
+                uint64_t template_id = 0;
+                uint64_t keyframe_id = 0;
+                if (!get_varint(body, template_id) || !get_varint(body, keyframe_id) ||
+                    template_id >= templates_.size() || keyframe_id >= keyframes_.size())
+                {
+                    return false;
+                }
+                const auto &shape = templates_[template_id];
+                const auto &base = keyframes_[keyframe_id];
+                if (base.size() != shape.scales.size())
+                {
+                    return false;
+                }
+
+                for (size_t i = 0; i < shape.scales.size(); ++i)
+                {
+                    uint64_t delta = 0;
+                    if (!get_varint(body, delta))
+                    {
+                        return false;
+                    }
+                    const auto value = static_cast<int64_t>(static_cast<uint64_t>(base[i]) +
+                                                            static_cast<uint64_t>(unzigzag(delta)));
+                    if (value > MAX_MAGNITUDE || value < -MAX_MAGNITUDE)
+                    {
+                        return false;
+                    }
+                    out += shape.literals[i];
+                    format_decimal(out, value, shape.scales[i]);
+                }
+                out += shape.literals.back();
+                return body.empty();
+            }
+
+            // Caller must hold mutex_ (shared is enough)
+            bool decode_compressed(std::string_view body, std::string &out) const
+            {
+#ifdef CARDANO_IOT_HAVE_ZSTD
+                uint64_t dictionary = 0;
+                uint64_t size = 0;
+                if (!get_varint(body, dictionary) || !get_varint(body, size) || dictionary > ddicts_.size() ||
+                    size > MAX_COMPRESSED_SIZE)
+                {
+                    return false;
+                }
+
+                thread_local std::unique_ptr<ZSTD_DCtx, size_t (*)(ZSTD_DCtx *)> dctx(ZSTD_createDCtx(), ZSTD_freeDCtx);
+                out.resize(size);
+                const size_t decoded = dictionary
+                                           ? ZSTD_decompress_usingDDict(dctx.get(), out.data(), out.size(), body.data(),
+                                                                        body.size(), ddicts_[dictionary - 1])
+                                           : ZSTD_decompressDCtx(dctx.get(), out.data(), out.size(), body.data(),
+                                                                 body.size());
+                return !ZSTD_isError(decoded) && decoded == size;
+#else
+                (void)body;
+                (void)out;
+                return false;
+#endif
+            }
+        };
+
+        PayloadCodec::PayloadCodec() : PayloadCodec(Options{}) {}
+
+        PayloadCodec::PayloadCodec(const Options &options) : pimpl_(std::make_unique<Impl>(options)) {}
+
+        PayloadCodec::~PayloadCodec() = default;
+
+        bool PayloadCodec::compression_available()
+        {
+#ifdef CARDANO_IOT_HAVE_ZSTD
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        bool PayloadCodec::enabled() const
+        {
+            const auto &options = pimpl_->options_;
+            return options.dedup || options.numeric_delta || options.compression;
+        }
+
+        bool PayloadCodec::is_encoded(std::string_view stored)
+        {
+            return !stored.empty() && static_cast<uint8_t>(stored.front()) == MAGIC;
+        }
+
+        bool PayloadCodec::encode(const std::string &device_id, std::string_view data_type, std::string_view payload,
+                                  std::string &out)
+        {
+            std::unique_lock<std::shared_mutex> lock(pimpl_->mutex_);
+            auto &stats = pimpl_->stats_;
+            ++stats.readings;
+            stats.raw_bytes += payload.size();
+
+            bool encoded = !payload.empty() && pimpl_->encode_unlocked(device_id, data_type, payload, out);
+            if (!encoded && is_encoded(payload))
+            {
+                // Escape a payload that would otherwise read as encoded
+                start_frame(out, MODE_STORED);
+                out.append(payload);
+                encoded = true;
+            }
+            if (!encoded)
+            {
+                out.clear();
+            }
+            stats.stored_bytes += encoded ? out.size() : payload.size();
+            return encoded;
+        }
+
+        std::string PayloadCodec::decode(std::string_view stored) const
+        {
+            if (!is_encoded(stored))
+            {
+                return std::string(stored);
+            }
+            if (stored.size() < 2)
+            {
+                return {};
+            }
+
+            const auto mode = static_cast<uint8_t>(stored[1]);
+            std::string_view body = stored.substr(2);
+            if (mode == MODE_STORED)
+            {
+                return std::string(body);
+            }
+
+            std::shared_lock<std::shared_mutex> lock(pimpl_->mutex_);
+            std::string out;
+            bool ok = false;
+            switch (mode)
+            {
+            case MODE_REFERENCE:
+            {
+                uint64_t id = 0;
+                ok = get_varint(body, id) && body.empty() && id < pimpl_->contents_.size();
+                if (ok)
+                {
+                    out = pimpl_->contents_[id];
+                }
+                break;
+            }
+            case MODE_NUMERIC:
+                ok = pimpl_->decode_numeric(body, out);
+                break;
+            case MODE_COMPRESSED:
+                ok = pimpl_->decode_compressed(body, out);
+                break;
+            default:
+                break;
+            }
+            return ok ? out : std::string();
+        }
+
+        PayloadCodec::Stats PayloadCodec::stats() const
+        {
+            std::shared_lock<std::shared_mutex> lock(pimpl_->mutex_);
+            return pimpl_->stats_;
+        }
+
+    } // namespace data
+} // namespace cardano_iot
@@ -0,0 +1,744 @@
+#include "cardano_iot/data/provenance_log.h"
+#include "cardano_iot/utils/hash.h"
+#include "cardano_iot/utils/logger.h"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace cardano_iot
+{
+    namespace data
+    {
+        namespace
+        {
+            constexpr char MAGIC[8] = {'C', 'I', 'O', 'T', 'P', 'L', 'O', 'G'};
+            constexpr uint32_t FORMAT_VERSION = 1;
+            constexpr size_t HEADER_BYTES = 16;
+            constexpr size_t FRAME_BYTES = 8;
+            constexpr uint32_t MAX_RECORD_BYTES = 16 * 1024 * 1024;
+            constexpr unsigned OFFSET_BITS = 40;
+            constexpr uint64_t OFFSET_MASK = (uint64_t(1) << OFFSET_BITS) - 1;
+
+            constexpr uint8_t KIND_EVENT = 0;
+            constexpr uint8_t KIND_TRANSACTION = 1;
+            constexpr uint8_t KIND_ANCHOR = 2;
+
+            void put_u32(std::string &out, uint32_t value)
+            {
+                for (int i = 0; i < 4; ++i)
+                {
+                    out.push_back(static_cast<char>(value >> (8 * i)));
+                }
+            }
+
+            uint32_t get_u32(const uint8_t *in)
+            {
+                return uint32_t(in[0]) | uint32_t(in[1]) << 8 | uint32_t(in[2]) << 16 | uint32_t(in[3]) << 24;
+            }
+
+            void put_varint(std::string &out, uint64_t value)
+            {
+                while (value >= 0x80)
+                {
+                    out.push_back(static_cast<char>(value | 0x80));
+                    value >>= 7;
+                }
+                out.push_back(static_cast<char>(value));
+            }
+
+            void put_string(std::string &out, const std::string &value)
+            {
+                put_varint(out, value.size());
+                out.append(value);
+            }
+
+            struct Reader
+            {
+                const uint8_t *data;
+                size_t size;
+                size_t offset = 0;
+
+                bool varint(uint64_t &value)
+                {
+                    value = 0;
+                    for (unsigned shift = 0; shift < 64 && offset < size; shift += 7)
+                    {
+                        const uint8_t byte = data[offset++];
+                        value |= uint64_t(byte & 0x7F) << shift;
+                        if ((byte & 0x80) == 0)
+                        {
+                            return true;
+                        }
+                    }
+                    return false;
+                }
+
+                bool string(std::string &value)
+                {
+                    uint64_t length = 0;
+                    if (!varint(length) || length > size - offset)
+                    {
+                        return false;
+                    }
+                    value.assign(reinterpret_cast<const char *>(data + offset), static_cast<size_t>(length));
+                    offset += static_cast<size_t>(length);
+                    return true;
+                }
+            };
+
+            std::string header_bytes()
+            {
+                std::string header(MAGIC, sizeof(MAGIC));
+                put_u32(header, FORMAT_VERSION);
+                put_u32(header, 0);
+                return header;
+            }
+
+            bool write_all(int fd, const char *data, size_t size, uint64_t offset)
+            {
+                while (size > 0)
+                {
+                    const ssize_t written = ::pwrite(fd, data, size, static_cast<off_t>(offset));
+                    if (written < 0 && errno == EINTR)
+                    {
+                        continue;
+                    }
+                    if (written <= 0)
+                    {
+                        return false;
+                    }
+                    data += written;
+                    size -= static_cast<size_t>(written);
+                    offset += static_cast<uint64_t>(written);
+                }
+                return true;
+            }
+
+            bool read_all(int fd, char *data, size_t size, uint64_t offset)
+            {
+                while (size > 0)
+                {
+                    const ssize_t got = ::pread(fd, data, size, static_cast<off_t>(offset));
+                    if (got < 0 && errno == EINTR)
+                    {
+                        continue;
+                    }
+                    if (got <= 0)
+                    {
+                        return false;
+                    }
+                    data += got;
+                    size -= static_cast<size_t>(got);
+                    offset += static_cast<uint64_t>(got);
+                }
+                return true;
+            }
+
+            std::string segment_name(uint32_t number)
+            {
+                char name[32];
+                std::snprintf(name, sizeof(name), "provenance-%08u.log", number);
+                return name;
+            }
+
+            bool parse_segment_name(const char *name, uint32_t &number)
+            {
+                unsigned value = 0;
+                int consumed = 0;
+                if (std::strlen(name) != 23 || std::sscanf(name, "provenance-%8u.log%n", &value, &consumed) != 1 || consumed != 23)
+                {
+                    return false;
+                }
+                number = value;
+                return true;
+            }
+        } // namespace
+
+        struct ProvenanceLog::Segment
+        {
+            uint32_t number = 0;
+            std::string path;
+            int fd = -1;                  // active file segment only
+            const uint8_t *map = nullptr; // sealed file segments
+            size_t map_size = 0;
+            std::string memory;           // in-memory mode
+            uint64_t size = 0;            // logical size, buffered bytes included
+            uint64_t flushed = 0;         // bytes already in the file
+
+            ~Segment()
+            {
+                if (map)
+                {
+                    ::munmap(const_cast<uint8_t *>(map), map_size);
+                }
+                if (fd >= 0)
+                {
+                    ::close(fd);
+                }
+            }
+
+            bool map_file()
+            {
+                const int read_fd = fd >= 0 ? fd : ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+                if (read_fd < 0)
+                {
+                    return false;
+                }
+                struct stat info;
+                bool ok = ::fstat(read_fd, &info) == 0 && info.st_size >= static_cast<off_t>(HEADER_BYTES);
+                if (ok)
+                {
+                    void *mapped = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, read_fd, 0);
+                    ok = mapped != MAP_FAILED;
+                    if (ok)
+                    {
+                        map = static_cast<const uint8_t *>(mapped);
+                        map_size = static_cast<size_t>(info.st_size);
+                        size = flushed = map_size;
+                    }
+                }
+                if (read_fd != fd)
+                {
+                    ::close(read_fd);
+                }
+                return ok;
+            }
+        };
+
+        ProvenanceLog::ProvenanceLog() = default;
+
+        ProvenanceLog::~ProvenanceLog()
+        {
+            close();
+        }
+
+        void ProvenanceLog::encode(const ProvenanceEvent &event, std::string &out)
+        {
+            out.push_back(static_cast<char>(event.event_type));
+            put_varint(out, event.timestamp);
+            put_string(out, event.event_id);
+            put_string(out, event.data_id);
+            put_string(out, event.actor_id);
+            put_string(out, event.transaction_hash);
+            put_varint(out, event.properties.size());
+            for (const auto &[key, value] : event.properties)
+            {
+                put_string(out, key);
+                put_string(out, value);
+            }
+        }
+
+        bool ProvenanceLog::decode(const uint8_t *data, size_t size, ProvenanceEvent &event)
+        {
+            if (size == 0 || data[0] > static_cast<uint8_t>(ProvenanceEventType::DELETED))
+            {
+                return false;
+            }
+            Reader reader{data, size, 1};
+            event.event_type = static_cast<ProvenanceEventType>(data[0]);
+            uint64_t count = 0;
+            if (!reader.varint(event.timestamp) || !reader.string(event.event_id) || !reader.string(event.data_id) ||
+                !reader.string(event.actor_id) || !reader.string(event.transaction_hash) || !reader.varint(count) ||
+                count > size)
+            {
+                return false;
+            }
+            event.properties.clear();
+            for (uint64_t i = 0; i < count; ++i)
+            {
+                std::string key;
+                std::string value;
+                if (!reader.string(key) || !reader.string(value))
+                {
+                    return false;
+                }
+                event.properties.emplace_hint(event.properties.end(), std::move(key), std::move(value));
+            }
+            return reader.offset == size;
+        }
+
+        bool ProvenanceLog::open(const Options &options, const Visitor &visitor)
+        {
+            close();
+            options_ = options;
+            options_.segment_bytes = std::min<uint64_t>(std::max<uint64_t>(options_.segment_bytes, 4096), OFFSET_MASK);
+
+            if (!options_.directory.empty())
+            {
+                if (::mkdir(options_.directory.c_str(), 0755) != 0 && errno != EEXIST)
+                {
+                    utils::Logger::instance().log(utils::LogLevel::ERROR, "ProvenanceLog",
+                                                  "Cannot create log directory: " + options_.directory);
+                    return false;
+                }
+                std::vector<uint32_t> numbers;
+                if (DIR *dir = ::opendir(options_.directory.c_str()))
+                {
+                    while (dirent *entry = ::readdir(dir))
+                    {
+                        uint32_t number = 0;
+                        if (parse_segment_name(entry->d_name, number))
+                        {
+                            numbers.push_back(number);
+                        }
+                    }
+                    ::closedir(dir);
+                }
+                std::sort(numbers.begin(), numbers.end());
+
+                // Locations name segments by number, so a gap would leave them ambiguous
+                for (size_t i = 0; i < numbers.size(); ++i)
+                {
+                    if (i > 0 && numbers[i] != numbers[i - 1] + 1)
+                    {
+                        utils::Logger::instance().log(utils::LogLevel::ERROR, "ProvenanceLog",
+                                                      "Missing segment before " + segment_name(numbers[i]));
+                        close();
+                        return false;
+                    }
+                    auto segment = std::make_unique<Segment>();
+                    segment->number = numbers[i];
+                    segment->path = options_.directory + "/" + segment_name(numbers[i]);
+                    if (!replay(*segment, numbers[i], i + 1 == numbers.size(), visitor))
+                    {
+                        close();
+                        return false;
+                    }
+                    segments_.push_back(std::move(segment));
+                }
+            }
+
+            open_ = true;
+            if (segments_.empty() && !start_segment())
+            {
+                close();
+                return false;
+            }
+
+            CARDANO_IOT_LOG(utils::LogLevel::DEBUG, "ProvenanceLog",
+                            "Opened " << segments_.size() << " segment(s) with " << event_count_ << " events");
+            return true;
+        }
+
+        // Scan one segment, rebuilding the caller's indexes. The last segment becomes active again
+        // after its torn tail, if any, is cut off.
+        bool ProvenanceLog::replay(Segment &segment, uint32_t number, bool last, const Visitor &visitor)
+        {
+            if (last)
+            {
+                segment.fd = ::open(segment.path.c_str(), O_RDWR | O_CLOEXEC);
+                if (segment.fd < 0)
+                {
+                    return false;
+                }
+                struct stat info;
+                if (::fstat(segment.fd, &info) == 0 && info.st_size < static_cast<off_t>(HEADER_BYTES))
+                {
+                    // Crashed while creating it; start it over
+                    const std::string header = header_bytes();
+                    if (::ftruncate(segment.fd, 0) != 0 || !write_all(segment.fd, header.data(), header.size(), 0))
+                    {
+                        return false;
+                    }
+                    segment.size = segment.flushed = HEADER_BYTES;
+                    return true;
+                }
+            }
+            if (!segment.map_file() || std::memcmp(segment.map, MAGIC, sizeof(MAGIC)) != 0 ||
+                get_u32(segment.map + 8) != FORMAT_VERSION)
+            {
+                utils::Logger::instance().log(utils::LogLevel::ERROR, "ProvenanceLog",
+                                              "Not a provenance segment: " + segment.path);
+                return false;
+            }
+
+            uint64_t offset = HEADER_BYTES;
+            while (offset + FRAME_BYTES <= segment.map_size)
+            {
+                const uint8_t *frame = segment.map + offset;
+                const uint32_t length = get_u32(frame);
+                if (length == 0 || length > MAX_RECORD_BYTES || length > segment.map_size - offset - FRAME_BYTES ||
+                    utils::crc32(frame + FRAME_BYTES, length) != get_u32(frame + 4))
+                {
+                    break;
+                }
+                const uint8_t *body = frame + FRAME_BYTES;
+                const uint64_t location = (uint64_t(number) << OFFSET_BITS) | offset;
+                if (body[0] == KIND_EVENT)
+                {
+                    ProvenanceEvent event;
+                    if (decode(body + 1, length - 1, event))
+                    {
+                        ++event_count_;
+                        if (visitor)
+                        {
+                            visitor(location, event);
+                        }
+                    }
+                }
+                else if (body[0] == KIND_TRANSACTION)
+                {
+                    Reader reader{body, length, 1};
+                    uint64_t target = 0;
+                    std::string hash;
+                    if (reader.varint(target) && reader.string(hash))
+                    {
+                        transactions_[target] = std::move(hash);
+                    }
+                }
+                else if (body[0] == KIND_ANCHOR)
+                {
+                    Reader reader{body, length, 1};
+                    std::string hash;
+                    uint64_t count = 0;
+                    if (reader.string(hash) && reader.varint(count) && count <= length)
+                    {
+                        std::vector<uint64_t> locations(static_cast<size_t>(count));
+                        std::vector<MerkleHash> leaves(static_cast<size_t>(count));
+                        bool complete = true;
+                        for (size_t i = 0; complete && i < locations.size(); ++i)
+                        {
+                            complete = reader.varint(locations[i]) && reader.size - reader.offset >= leaves[i].size();
+                            if (complete)
+                            {
+                                std::memcpy(leaves[i].data(), reader.data + reader.offset, leaves[i].size());
+                                reader.offset += leaves[i].size();
+                            }
+                        }
+                        if (complete)
+                        {
+                            index_anchor(std::move(hash), locations, MerkleTree(std::move(leaves)));
+                        }
+                    }
+                }
+                offset += FRAME_BYTES + length;
+            }
+
+            if (offset != segment.map_size)
+            {
+                utils::Logger::instance().log(utils::LogLevel::WARNING, "ProvenanceLog",
+                                              "Discarding " + std::to_string(segment.map_size - offset) +
+                                                  " unreadable bytes at the end of " + segment.path);
+            }
+            if (!last)
+            {
+                return true;
+            }
+
+            // The active segment is read with pread, so drop the map and truncate what could not be replayed
+            ::munmap(const_cast<uint8_t *>(segment.map), segment.map_size);
+            segment.map = nullptr;
+            segment.map_size = 0;
+            if (offset != segment.flushed && ::ftruncate(segment.fd, static_cast<off_t>(offset)) != 0)
+            {
+                return false;
+            }
+            segment.size = segment.flushed = offset;
+            return true;
+        }
+
+        void ProvenanceLog::close()
+        {
+            if (open_)
+            {
+                flush();
+                if (!segments_.empty() && segments_.back()->fd >= 0 && !options_.sync_on_flush)
+                {
+                    ::fsync(segments_.back()->fd);
+                }
+            }
+            segments_.clear();
+            pending_.clear();
+            transactions_.clear();
+            anchors_.clear();
+            anchored_.clear();
+            event_count_ = 0;
+            open_ = false;
+        }
+
+        bool ProvenanceLog::start_segment()
+        {
+            auto segment = std::make_unique<Segment>();
+            segment->number = segments_.empty() ? 0 : segments_.back()->number + 1;
+            const std::string header = header_bytes();
+            if (options_.directory.empty())
+            {
+                segment->memory = header;
+            }
+            else
+            {
+                segment->path = options_.directory + "/" + segment_name(segment->number);
+                segment->fd = ::open(segment->path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+                if (segment->fd < 0 || !write_all(segment->fd, header.data(), header.size(), 0))
+                {
+                    utils::Logger::instance().log(utils::LogLevel::ERROR, "ProvenanceLog",
+                                                  "Cannot create segment: " + segment->path);
+                    return false;
+                }
+            }
+            segment->size = segment->flushed = HEADER_BYTES;
+            segments_.push_back(std::move(segment));
+            return true;
+        }
+
+        bool ProvenanceLog::seal_active()
+        {
+            Segment &active = *segments_.back();
+            if (active.fd < 0)
+            {
+                return true;
+            }
+            if (!flush() || ::fsync(active.fd) != 0 || !active.map_file())
+            {
+                return false;
+            }
+            ::close(active.fd);
+            active.fd = -1;
+            return true;
+        }
+
+        bool ProvenanceLog::flush()
+        {
+            if (!open_ || pending_.empty() || segments_.empty())
+            {
+                return true;
+            }
+            Segment &active = *segments_.back();
+            if (active.fd < 0 || !write_all(active.fd, pending_.data(), pending_.size(), active.flushed))
+            {
+                return false;
+            }
+            active.flushed += pending_.size();
+            pending_.clear();
+            return !options_.sync_on_flush || ::fdatasync(active.fd) == 0;
+        }
+
+        uint64_t ProvenanceLog::append_record(uint8_t kind, const std::string &body)
+        {
+            const uint64_t frame_size = FRAME_BYTES + 1 + body.size();
+            if (!open_ || 1 + body.size() > MAX_RECORD_BYTES)
+            {
+                return NO_LOCATION;
+            }
+            if (segments_.back()->size + frame_size > options_.segment_bytes && segments_.back()->size > HEADER_BYTES &&
+                (!seal_active() || !start_segment()))
+            {
+                return NO_LOCATION;
+            }
+
+            Segment &active = *segments_.back();
+            std::string &out = active.fd >= 0 ? pending_ : active.memory;
+            const uint64_t location = (uint64_t(active.number) << OFFSET_BITS) | active.size;
+            const size_t start = out.size();
+            put_u32(out, static_cast<uint32_t>(1 + body.size()));
+            put_u32(out, 0);
+            out.push_back(static_cast<char>(kind));
+            out.append(body);
+            const uint32_t checksum = utils::crc32(reinterpret_cast<const uint8_t *>(out.data()) + start + FRAME_BYTES, 1 + body.size());
+            for (int i = 0; i < 4; ++i)
+            {
+                out[start + 4 + i] = static_cast<char>(checksum >> (8 * i));
+            }
+            active.size += frame_size;
+            if (active.fd < 0)
+            {
+                active.flushed = active.size;
+            }
+            else if (pending_.size() >= options_.write_buffer_bytes && !flush())
+            {
+                return NO_LOCATION;
+            }
+            return location;
+        }
+
+        uint64_t ProvenanceLog::append(const ProvenanceEvent &event)
+        {
+            scratch_.clear();
+            encode(event, scratch_);
+            const uint64_t location = append_record(KIND_EVENT, scratch_);
+            if (location != NO_LOCATION)
+            {
+                ++event_count_;
+                if (!event.transaction_hash.empty())
+                {
+                    transactions_[location] = event.transaction_hash;
+                }
+            }
+            return location;
+        }
+
+        bool ProvenanceLog::annotate_transaction(uint64_t location, const std::string &transaction_hash)
+        {
+            std::string body;
+            put_varint(body, location);
+            put_string(body, transaction_hash);
+            if (append_record(KIND_TRANSACTION, body) == NO_LOCATION)
+            {
+                return false;
+            }
+            transactions_[location] = transaction_hash;
+            return true;
+        }
+
+        bool ProvenanceLog::record_at(uint64_t location, const uint8_t *&body, size_t &size)
+        {
+            const uint64_t number = location >> OFFSET_BITS;
+            const uint64_t offset = location & OFFSET_MASK;
+            if (segments_.empty() || number < segments_.front()->number ||
+                number - segments_.front()->number >= segments_.size())
+            {
+                return false;
+            }
+            const Segment &segment = *segments_[static_cast<size_t>(number - segments_.front()->number)];
+            if (offset < HEADER_BYTES || offset + FRAME_BYTES > segment.size)
+            {
+                return false;
+            }
+
+            const uint8_t *frame = nullptr;
+            if (segment.map || segment.fd < 0)
+            {
+                frame = segment.map ? segment.map + offset : reinterpret_cast<const uint8_t *>(segment.memory.data()) + offset;
+            }
+            else if (offset >= segment.flushed)
+            {
+                frame = reinterpret_cast<const uint8_t *>(pending_.data()) + (offset - segment.flushed);
+            }
+            else
+            {
+                // Active file: records reach it whole, so a frame is either all flushed or all buffered
+                scratch_.resize(FRAME_BYTES);
+                if (!read_all(segment.fd, &scratch_[0], FRAME_BYTES, offset))
+                {
+                    return false;
+                }
+                const uint32_t length = get_u32(reinterpret_cast<const uint8_t *>(scratch_.data()));
+                if (length > segment.flushed - offset - FRAME_BYTES)
+                {
+                    return false;
+                }
+                scratch_.resize(FRAME_BYTES + length);
+                if (!read_all(segment.fd, &scratch_[FRAME_BYTES], length, offset + FRAME_BYTES))
+                {
+                    return false;
+                }
+                frame = reinterpret_cast<const uint8_t *>(scratch_.data());
+            }
+
+            const uint32_t length = get_u32(frame);
+            if (length == 0 || length > segment.size - offset - FRAME_BYTES)
+            {
+                return false;
+            }
+            body = frame + FRAME_BYTES;
+            size = length;
+            return true;
+        }
+
+        bool ProvenanceLog::read(uint64_t location, ProvenanceEvent &event)
+        {
+            const uint8_t *body = nullptr;
+            size_t size = 0;
+            if (!record_at(location, body, size) || body[0] != KIND_EVENT || !decode(body + 1, size - 1, event))
+            {
+                return false;
+            }
+            std::string transaction = transaction_for(location);
+            if (!transaction.empty())
+            {
+                event.transaction_hash = std::move(transaction);
+            }
+            return true;
+        }
+
+        std::string ProvenanceLog::transaction_for(uint64_t location) const
+        {
+            auto anchored = anchored_.find(location);
+            if (anchored != anchored_.end())
+            {
+                return anchors_[anchored->second.first].transaction_hash;
+            }
+            auto it = transactions_.find(location);
+            return it != transactions_.end() ? it->second : std::string();
+        }
+
+        void ProvenanceLog::index_anchor(std::string transaction_hash, const std::vector<uint64_t> &locations,
+                                         MerkleTree tree)
+        {
+            const uint32_t anchor = static_cast<uint32_t>(anchors_.size());
+            for (size_t i = 0; i < locations.size(); ++i)
+            {
+                anchored_[locations[i]] = {anchor, static_cast<uint32_t>(i)};
+            }
+            anchors_.push_back({std::move(transaction_hash), std::move(tree)});
+        }
+
+        bool ProvenanceLog::append_anchor(const std::string &transaction_hash, const std::vector<uint64_t> &locations,
+                                          MerkleTree tree)
+        {
+            const std::vector<MerkleHash> &leaves = tree.leaves();
+            if (locations.empty() || locations.size() != leaves.size())
+            {
+                return false;
+            }
+            std::string body;
+            body.reserve(transaction_hash.size() + locations.size() * (sizeof(MerkleHash) + 6) + 16);
+            put_string(body, transaction_hash);
+            put_varint(body, locations.size());
+            for (size_t i = 0; i < locations.size(); ++i)
+            {
+                put_varint(body, locations[i]);
+                body.append(reinterpret_cast<const char *>(leaves[i].data()), leaves[i].size());
+            }
+            if (append_record(KIND_ANCHOR, body) == NO_LOCATION)
+            {
+                return false;
+            }
+            index_anchor(transaction_hash, locations, std::move(tree));
+            return true;
+        }
+
+        bool ProvenanceLog::proof_for(uint64_t location, MerkleProof &proof) const
+        {
+            auto it = anchored_.find(location);
+            if (it == anchored_.end())
+            {
+                return false;
+            }
+            const Anchor &anchor = anchors_[it->second.first];
+            proof.index = it->second.second;
+            proof.leaf_count = static_cast<uint32_t>(anchor.tree.leaf_count());
+            proof.leaf = anchor.tree.leaves()[proof.index];
+            proof.root = anchor.tree.root();
+            proof.path = anchor.tree.path(proof.index);
+            proof.transaction_hash = anchor.transaction_hash;
+            return true;
+        }
+
+        MerkleHash ProvenanceLog::leaf_hash(const ProvenanceEvent &event)
+        {
+            std::string encoded;
+            if (event.transaction_hash.empty())
+            {
+                encode(event, encoded);
+            }
+            else
+            {
+                ProvenanceEvent unanchored = event;
+                unanchored.transaction_hash.clear();
+                encode(unanchored, encoded);
+            }
+            return MerkleTree::hash_leaf(reinterpret_cast<const uint8_t *>(encoded.data()), encoded.size());
+        }
+
+    } // namespace data
+} // namespace cardano_iot
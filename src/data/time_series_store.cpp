@@ -0,0 +1,287 @@
+#include "cardano_iot/data/time_series_store.h"
+
+#include <algorithm>
+#include <limits>
+#include <shared_mutex>
+#include <mutex>
+#include <unordered_map>
+
+namespace cardano_iot
+{
+    namespace data
+    {
+        namespace
+        {
+            struct DeviceSeries
+            {
+                // Sealed segments in creation order, with running bounds so a range
+                // query can binary-search the first candidate and stop early
+                std::vector<std::shared_ptr<const TimeSeriesSegment>> sealed;
+                std::vector<uint64_t> prefix_max; // max timestamp over sealed[0..i]
+                std::vector<uint64_t> suffix_min; // min timestamp over sealed[i..]
+                std::shared_ptr<TimeSeriesSegment> active;
+                size_t count = 0;
+            };
+
+            uint16_t intern_type(TimeSeriesSegment &segment, std::string_view data_type)
+            {
+                for (size_t i = 0; i < segment.type_names.size(); ++i)
+                {
+                    if (segment.type_names[i] == data_type)
+                    {
+                        return static_cast<uint16_t>(i);
+                    }
+                }
+                segment.type_names.emplace_back(data_type);
+                return static_cast<uint16_t>(segment.type_names.size() - 1);
+            }
+
+            void insert_row(TimeSeriesSegment &segment, TimeSeriesStore::Entry &&entry)
+            {
+                const uint16_t type_id = intern_type(segment, entry.data_type);
+                const auto payload_size = static_cast<uint32_t>(entry.payload.size());
+
+                // Fast path: readings arrive in time order
+                if (segment.timestamps.empty() || entry.timestamp >= segment.timestamps.back())
+                {
+                    segment.timestamps.push_back(entry.timestamp);
+                    segment.payload_bytes.append(entry.payload);
+                    segment.payload_offsets.push_back(segment.payload_offsets.back() + payload_size);
+                    segment.hashes.push_back(std::move(entry.hash));
+                    segment.signatures.push_back(std::move(entry.signature));
+                    segment.type_ids.push_back(type_id);
+                    segment.metadata.push_back(std::move(entry.metadata));
+                    return;
+                }
+
+                // Late reading: keep the active segment sorted (bounded by segment capacity)
+                const auto pos = static_cast<size_t>(
+                    std::upper_bound(segment.timestamps.begin(), segment.timestamps.end(), entry.timestamp) -
+                    segment.timestamps.begin());
+
+                segment.timestamps.insert(segment.timestamps.begin() + pos, entry.timestamp);
+                segment.payload_bytes.insert(segment.payload_offsets[pos], entry.payload);
+                segment.payload_offsets.insert(segment.payload_offsets.begin() + pos + 1,
+                                               segment.payload_offsets[pos] + payload_size);
+                for (size_t i = pos + 2; i < segment.payload_offsets.size(); ++i)
+                {
+                    segment.payload_offsets[i] += payload_size;
+                }
+                segment.hashes.insert(segment.hashes.begin() + pos, std::move(entry.hash));
+                segment.signatures.insert(segment.signatures.begin() + pos, std::move(entry.signature));
+                segment.type_ids.insert(segment.type_ids.begin() + pos, type_id);
+                segment.metadata.insert(segment.metadata.begin() + pos, std::move(entry.metadata));
+            }
+
+            // Copy rows [begin, end) of a segment into a new standalone segment
+            std::shared_ptr<TimeSeriesSegment> copy_rows(const TimeSeriesSegment &source, size_t begin, size_t end)
+            {
+                auto copy = std::make_shared<TimeSeriesSegment>();
+                copy->type_names = source.type_names;
+
+                const uint32_t base = source.payload_offsets[begin];
+                copy->timestamps.assign(source.timestamps.begin() + begin, source.timestamps.begin() + end);
+                copy->payload_bytes.assign(source.payload_bytes, base, source.payload_offsets[end] - base);
+                copy->payload_offsets.reserve(end - begin + 1);
+                for (size_t i = begin + 1; i <= end; ++i)
+                {
+                    copy->payload_offsets.push_back(source.payload_offsets[i] - base);
+                }
+                copy->hashes.assign(source.hashes.begin() + begin, source.hashes.begin() + end);
+                copy->signatures.assign(source.signatures.begin() + begin, source.signatures.begin() + end);
+                copy->type_ids.assign(source.type_ids.begin() + begin, source.type_ids.begin() + end);
+                copy->metadata.assign(source.metadata.begin() + begin, source.metadata.begin() + end);
+                return copy;
+            }
+
+            std::pair<size_t, size_t> row_range(const TimeSeriesSegment &segment, uint64_t start, uint64_t end)
+            {
+                auto first = std::lower_bound(segment.timestamps.begin(), segment.timestamps.end(), start);
+                auto last = std::upper_bound(first, segment.timestamps.end(), end);
+                return {static_cast<size_t>(first - segment.timestamps.begin()),
+                        static_cast<size_t>(last - segment.timestamps.begin())};
+            }
+        } // namespace
+
+        class TimeSeriesStore::Impl
+        {
+        public:
+            explicit Impl(size_t segment_capacity) : segment_capacity_(std::max<size_t>(1, segment_capacity)) {}
+
+            size_t segment_capacity_;
+            std::unordered_map<std::string, DeviceSeries> series_;
+            size_t total_count_ = 0;
+            mutable std::shared_mutex store_mutex_;
+
+            // Caller must hold store_mutex_ exclusively
+            void append_unlocked(const std::string &device_id, Entry &&entry)
+            {
+                auto &series = series_[device_id];
+                if (!series.active)
+                {
+                    series.active = std::make_shared<TimeSeriesSegment>();
+                    series.active->timestamps.reserve(segment_capacity_);
+                }
+
+                insert_row(*series.active, std::move(entry));
+                ++series.count;
+                ++total_count_;
+
+                if (series.active->size() >= segment_capacity_)
+                {
+                    seal(series);
+                }
+            }
+
+            void seal(DeviceSeries &series)
+            {
+                auto segment = std::move(series.active);
+                const uint64_t seg_min = segment->min_timestamp();
+                const uint64_t seg_max = segment->max_timestamp();
+
+                series.prefix_max.push_back(series.prefix_max.empty() ? seg_max
+                                                                      : std::max(series.prefix_max.back(), seg_max));
+
+                // Only late data can lower earlier suffix minima; stop at the first unaffected one
+                series.suffix_min.push_back(seg_min);
+                for (size_t i = series.suffix_min.size() - 1; i-- > 0;)
+                {
+                    if (series.suffix_min[i] <= seg_min)
+                    {
+                        break;
+                    }
+                    series.suffix_min[i] = seg_min;
+                }
+
+                series.sealed.push_back(std::move(segment));
+            }
+        };
+
+        TimeSeriesStore::Writer::Writer(TimeSeriesStore &store) : store_(&store)
+        {
+            store_->pimpl_->store_mutex_.lock();
+        }
+
+        TimeSeriesStore::Writer::Writer(Writer &&other) noexcept : store_(other.store_)
+        {
+            other.store_ = nullptr;
+        }
+
+        TimeSeriesStore::Writer::~Writer()
+        {
+            if (store_)
+            {
+                store_->pimpl_->store_mutex_.unlock();
+            }
+        }
+
+        void TimeSeriesStore::Writer::append(const std::string &device_id, Entry &&entry)
+        {
+            store_->pimpl_->append_unlocked(device_id, std::move(entry));
+        }
+
+        TimeSeriesStore::TimeSeriesStore(size_t segment_capacity)
+            : pimpl_(std::make_unique<Impl>(segment_capacity)) {}
+
+        TimeSeriesStore::~TimeSeriesStore() = default;
+
+        TimeSeriesStore::Writer TimeSeriesStore::writer()
+        {
+            return Writer(*this);
+        }
+
+        void TimeSeriesStore::append(const std::string &device_id, Entry &&entry)
+        {
+            std::unique_lock<std::shared_mutex> lock(pimpl_->store_mutex_);
+            pimpl_->append_unlocked(device_id, std::move(entry));
+        }
+
+        TimeSeriesView TimeSeriesStore::query(const std::string &device_id, uint64_t start_time, uint64_t end_time) const
+        {
+            if (end_time == 0)
+            {
+                end_time = std::numeric_limits<uint64_t>::max();
+            }
+            if (start_time > end_time)
+            {
+                return TimeSeriesView(device_id, {});
+            }
+
+            std::shared_lock<std::shared_mutex> lock(pimpl_->store_mutex_);
+
+            auto it = pimpl_->series_.find(device_id);
+            if (it == pimpl_->series_.end())
+            {
+                return TimeSeriesView(device_id, {});
+            }
+            const auto &series = it->second;
+
+            std::vector<TimeSeriesView::Slice> slices;
+
+            // Sealed segments before `first` hold only readings older than start_time
+            auto first = static_cast<size_t>(
+                std::lower_bound(series.prefix_max.begin(), series.prefix_max.end(), start_time) -
+                series.prefix_max.begin());
+            for (size_t i = first; i < series.sealed.size() && series.suffix_min[i] <= end_time; ++i)
+            {
+                const auto &segment = series.sealed[i];
+                if (segment->max_timestamp() < start_time || segment->min_timestamp() > end_time)
+                {
+                    continue;
+                }
+                auto [begin, end] = row_range(*segment, start_time, end_time);
+                if (begin < end)
+                {
+                    slices.push_back({segment, begin, end});
+                }
+            }
+
+            // The active segment is still mutable, so hand out a copy of the matching rows
+            if (series.active)
+            {
+                auto [begin, end] = row_range(*series.active, start_time, end_time);
+                if (begin < end)
+                {
+                    slices.push_back({copy_rows(*series.active, begin, end), 0, end - begin});
+                }
+            }
+
+            return TimeSeriesView(device_id, std::move(slices));
+        }
+
+        size_t TimeSeriesStore::size(const std::string &device_id) const
+        {
+            std::shared_lock<std::shared_mutex> lock(pimpl_->store_mutex_);
+            auto it = pimpl_->series_.find(device_id);
+            return it != pimpl_->series_.end() ? it->second.count : 0;
+        }
+
+        size_t TimeSeriesStore::total_size() const
+        {
+            std::shared_lock<std::shared_mutex> lock(pimpl_->store_mutex_);
+            return pimpl_->total_count_;
+        }
+
+        size_t TimeSeriesStore::erase(const std::string &device_id)
+        {
+            std::unique_lock<std::shared_mutex> lock(pimpl_->store_mutex_);
+            auto it = pimpl_->series_.find(device_id);
+            if (it == pimpl_->series_.end())
+            {
+                return 0;
+            }
+            const size_t count = it->second.count;
+            pimpl_->total_count_ -= count;
+            pimpl_->series_.erase(it);
+            return count;
+        }
+
+        void TimeSeriesStore::clear()
+        {
+            std::unique_lock<std::shared_mutex> lock(pimpl_->store_mutex_);
+            pimpl_->series_.clear();
+            pimpl_->total_count_ = 0;
+        }
+
+    } // namespace data
+} // namespace cardano_iot
@@ -0,0 +1,301 @@
+/**
+ * @file power_aware_outbox.cpp
+ * @brief Implementation of the power-aware blockchain outbox
+ *
+ * @author Cardano IoT SDK Team
+ * @version 1.0.0
+ */
+
+#include "cardano_iot/energy/power_aware_outbox.h"
+#include "cardano_iot/energy/power_manager.h"
+#include "cardano_iot/utils/logger.h"
+#include "cardano_iot/utils/timer_wheel.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <unordered_map>
+
+namespace cardano_iot::energy
+{
+
+    namespace
+    {
+        using Clock = std::chrono::steady_clock;
+
+        constexpr size_t REASON_COUNT = static_cast<size_t>(FlushReason::MANUAL) + 1;
+    }
+
+    class PowerAwareOutbox::Impl
+    {
+    public:
+        struct Queue
+        {
+            std::vector<uint64_t> tickets;
+            Clock::time_point deadline = Clock::time_point::max();
+        };
+
+        struct Batch
+        {
+            std::string device_id;
+            std::vector<uint64_t> tickets;
+            FlushReason reason;
+        };
+
+        Impl(const PowerManager &power, FlushHandler handler, const Options &options)
+            : power_(power), handler_(std::move(handler)), options_(options)
+        {
+            options_.max_batch_operations = std::max<size_t>(1, options_.max_batch_operations);
+        }
+
+        const PowerManager &power_;
+        FlushHandler handler_;
+        Options options_;
+
+        mutable std::mutex mutex_;
+        std::unordered_map<std::string, Queue> queues_;
+        size_t pending_ = 0;
+
+        // Statistics
+        std::atomic<uint64_t> queued_operations_{0};
+        std::atomic<uint64_t> flushed_operations_{0};
+        std::atomic<uint64_t> radio_wakeups_{0};
+        std::array<std::atomic<uint64_t>, REASON_COUNT> flushes_by_reason_{};
+
+        // Periodic poll; last member so it goes first
+        utils::TimerWheel::Scope timers_;
+
+        // Caller holds mutex_
+        Batch take(std::unordered_map<std::string, Queue>::iterator it, FlushReason reason)
+        {
+            Batch batch{it->first, std::move(it->second.tickets), reason};
+            pending_ -= batch.tickets.size();
+            queues_.erase(it);
+            return batch;
+        }
+
+        // Runs the handler for each batch; caller holds no lock
+        size_t dispatch(std::vector<Batch> &batches)
+        {
+            size_t operations = 0;
+            for (auto &batch : batches)
+            {
+                const size_t count = batch.tickets.size();
+                operations += count;
+                flushed_operations_ += count;
+                radio_wakeups_++;
+                flushes_by_reason_[static_cast<size_t>(batch.reason)]++;
+
+                CARDANO_IOT_LOG(utils::LogLevel::DEBUG, "PowerAwareOutbox",
+                                "Flushing " << count << " operations for " << batch.device_id << " ("
+                                            << flush_reason_to_string(batch.reason) << ")");
+                if (handler_)
+                {
+                    handler_(batch.device_id, std::move(batch.tickets), batch.reason);
+                }
+            }
+            return operations;
+        }
+
+        std::chrono::milliseconds default_delay(const std::string &device_id, const PowerSettings &settings) const
+        {
+            if (options_.default_max_delay_ms > 0)
+            {
+                return std::chrono::milliseconds(options_.default_max_delay_ms);
+            }
+            const bool low_power = power_.get_battery_level(device_id) < settings.low_power_threshold;
+            return std::chrono::seconds(low_power ? settings.heartbeat_interval_low_power
+                                                  : settings.heartbeat_interval_normal);
+        }
+
+        void schedule_poll()
+        {
+            if (options_.poll_interval_ms == 0)
+            {
+                return;
+            }
+            timers_.schedule_after(std::chrono::milliseconds(options_.poll_interval_ms), [this]()
+                                   {
+                poll();
+                schedule_poll(); });
+        }
+
+        size_t poll()
+        {
+            std::vector<std::string> devices;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                devices.reserve(queues_.size());
+                for (const auto &[device_id, queue] : queues_)
+                {
+                    devices.push_back(device_id);
+                }
+            }
+
+            // Ask the power manager without holding our lock
+            std::vector<uint8_t> surplus(devices.size());
+            for (size_t i = 0; i < devices.size(); ++i)
+            {
+                surplus[i] = power_.has_power_surplus(devices[i]) ? 1 : 0;
+            }
+
+            std::vector<Batch> batches;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                const auto now = Clock::now();
+                for (size_t i = 0; i < devices.size(); ++i)
+                {
+                    auto it = queues_.find(devices[i]);
+                    if (it == queues_.end())
+                    {
+                        continue;
+                    }
+                    if (surplus[i])
+                    {
+                        batches.push_back(take(it, FlushReason::POWER_AVAILABLE));
+                    }
+                    else if (it->second.deadline <= now)
+                    {
+                        batches.push_back(take(it, FlushReason::DEADLINE));
+                    }
+                }
+            }
+            return dispatch(batches);
+        }
+    };
+
+    PowerAwareOutbox::PowerAwareOutbox(const PowerManager &power, FlushHandler handler)
+        : PowerAwareOutbox(power, std::move(handler), Options())
+    {
+    }
+
+    PowerAwareOutbox::PowerAwareOutbox(const PowerManager &power, FlushHandler handler, const Options &options)
+        : pimpl_(std::make_unique<Impl>(power, std::move(handler), options))
+    {
+        pimpl_->schedule_poll();
+    }
+
+    PowerAwareOutbox::~PowerAwareOutbox()
+    {
+        pimpl_->timers_.cancel_all();
+    }
+
+    void PowerAwareOutbox::enqueue(uint64_t ticket, const std::string &device_id, const std::string &tx_type,
+                                   uint32_t data_size, uint32_t max_delay_ms)
+    {
+        PowerSettings settings;
+        const bool batched = pimpl_->power_.get_power_settings(device_id, settings) && settings.enable_tx_power_control;
+        const bool surplus = batched && pimpl_->power_.has_power_surplus(device_id);
+        const auto delay = max_delay_ms > 0 ? std::chrono::milliseconds(max_delay_ms)
+                                            : pimpl_->default_delay(device_id, settings);
+
+        std::vector<Impl::Batch> batches;
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+            auto it = pimpl_->queues_.try_emplace(device_id).first;
+            Impl::Queue &queue = it->second;
+            queue.tickets.push_back(ticket);
+            queue.deadline = std::min(queue.deadline, Clock::now() + delay);
+            pimpl_->pending_++;
+
+            if (!batched)
+            {
+                batches.push_back(pimpl_->take(it, FlushReason::IMMEDIATE));
+            }
+            else if (surplus)
+            {
+                batches.push_back(pimpl_->take(it, FlushReason::POWER_AVAILABLE));
+            }
+            else if (queue.tickets.size() >= pimpl_->options_.max_batch_operations)
+            {
+                batches.push_back(pimpl_->take(it, FlushReason::BATCH_FULL));
+            }
+        }
+        pimpl_->queued_operations_++;
+
+        CARDANO_IOT_LOG(utils::LogLevel::DEBUG, "PowerAwareOutbox",
+                        "Queued " << tx_type << " (" << data_size << " bytes) for " << device_id);
+        pimpl_->dispatch(batches);
+    }
+
+    size_t PowerAwareOutbox::poll()
+    {
+        return pimpl_->poll();
+    }
+
+    size_t PowerAwareOutbox::flush(const std::string &device_id)
+    {
+        std::vector<Impl::Batch> batches;
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+            auto it = pimpl_->queues_.find(device_id);
+            if (it != pimpl_->queues_.end())
+            {
+                batches.push_back(pimpl_->take(it, FlushReason::MANUAL));
+            }
+        }
+        return pimpl_->dispatch(batches);
+    }
+
+    size_t PowerAwareOutbox::flush_all()
+    {
+        std::vector<Impl::Batch> batches;
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+            while (!pimpl_->queues_.empty())
+            {
+                batches.push_back(pimpl_->take(pimpl_->queues_.begin(), FlushReason::MANUAL));
+            }
+        }
+        return pimpl_->dispatch(batches);
+    }
+
+    size_t PowerAwareOutbox::pending() const
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+        return pimpl_->pending_;
+    }
+
+    size_t PowerAwareOutbox::pending(const std::string &device_id) const
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+        auto it = pimpl_->queues_.find(device_id);
+        return it != pimpl_->queues_.end() ? it->second.tickets.size() : 0;
+    }
+
+    std::map<std::string, uint64_t> PowerAwareOutbox::get_statistics() const
+    {
+        std::map<std::string, uint64_t> stats;
+        stats["queued_operations"] = pimpl_->queued_operations_.load();
+        stats["flushed_operations"] = pimpl_->flushed_operations_.load();
+        stats["radio_wakeups"] = pimpl_->radio_wakeups_.load();
+        for (size_t i = 0; i < REASON_COUNT; ++i)
+        {
+            stats["flushes_" + flush_reason_to_string(static_cast<FlushReason>(i))] =
+                pimpl_->flushes_by_reason_[i].load();
+        }
+        return stats;
+    }
+
+    std::string flush_reason_to_string(FlushReason reason)
+    {
+        switch (reason)
+        {
+        case FlushReason::IMMEDIATE:
+            return "immediate";
+        case FlushReason::POWER_AVAILABLE:
+            return "power_available";
+        case FlushReason::BATCH_FULL:
+            return "batch_full";
+        case FlushReason::DEADLINE:
+            return "deadline";
+        case FlushReason::MANUAL:
+            return "manual";
+        default:
+            return "unknown";
+        }
+    }
+
+} // namespace cardano_iot::energy
@@ -14,10 +14,131 @@
 #include <chrono>
 #include <cmath>
 #include <algorithm>
+#include <atomic>
+#include <limits>
+#include <numeric>
 
 namespace cardano_iot::energy
 {
 
+    namespace
+    {
+        /**
+         * @brief The fleet-query fields of every profile, one contiguous array per field
+         *
+         * PowerProfile stays the per-device record; this mirrors the handful of
+         * numbers fleet scans need so they run as straight loops over doubles.
+         * Removal swaps the last slot into the hole.
+         */
+        struct FleetStore
+        {
+            std::vector<std::string> ids;
+            std::vector<double> charge_level;
+            std::vector<double> remaining_mah;
+            std::vector<double> capacity_mah;
+            std::vector<double> voltage;
+            std::vector<double> consumption_mw;
+            std::vector<double> harvest_mw;
+            std::vector<double> critical_threshold;
+            std::unordered_map<std::string, size_t> slots;
+
+            void add(const PowerProfile &profile, double critical)
+            {
+                slots[profile.device_id] = ids.size();
+                ids.push_back(profile.device_id);
+                charge_level.push_back(0.0);
+                remaining_mah.push_back(0.0);
+                capacity_mah.push_back(0.0);
+                voltage.push_back(0.0);
+                consumption_mw.push_back(0.0);
+                harvest_mw.push_back(0.0);
+                critical_threshold.push_back(critical);
+                update(profile);
+            }
+
+            void remove(const std::string &device_id)
+            {
+                auto it = slots.find(device_id);
+                if (it == slots.end())
+                {
+                    return;
+                }
+                const size_t slot = it->second;
+                const size_t last = ids.size() - 1;
+                slots.erase(it);
+                if (slot != last)
+                {
+                    ids[slot] = std::move(ids[last]);
+                    slots[ids[slot]] = slot;
+                    for (auto *column : {&charge_level, &remaining_mah, &capacity_mah, &voltage, &consumption_mw,
+                                         &harvest_mw, &critical_threshold})
+                    {
+                        (*column)[slot] = (*column)[last];
+                    }
+                }
+                ids.pop_back();
+                for (auto *column : {&charge_level, &remaining_mah, &capacity_mah, &voltage, &consumption_mw,
+                                     &harvest_mw, &critical_threshold})
+                {
+                    column->pop_back();
+                }
+            }
+
+            void update(const PowerProfile &profile)
+            {
+                auto it = slots.find(profile.device_id);
+                if (it == slots.end())
+                {
+                    return;
+                }
+                const size_t slot = it->second;
+                charge_level[slot] = profile.battery.charge_level;
+                remaining_mah[slot] = profile.battery.remaining_mah;
+                capacity_mah[slot] = profile.battery.capacity_mah;
+                voltage[slot] = profile.battery.voltage;
+                consumption_mw[slot] = profile.power_consumption_mw;
+            }
+
+            void set_harvest(const std::string &device_id, double mw)
+            {
+                auto it = slots.find(device_id);
+                if (it != slots.end())
+                {
+                    harvest_mw[it->second] = mw;
+                }
+            }
+
+            // Hours until each device reaches its critical threshold; infinity when harvest covers the draw
+            void hours_to_critical(std::vector<double> &out) const
+            {
+                const size_t n = ids.size();
+                out.resize(n);
+                const double infinity = std::numeric_limits<double>::infinity();
+                for (size_t i = 0; i < n; ++i)
+                {
+                    const double usable_mah = std::max(remaining_mah[i] - capacity_mah[i] * critical_threshold[i], 0.0);
+                    const double drain_ma = (consumption_mw[i] - harvest_mw[i]) / std::max(voltage[i], 1e-9);
+                    out[i] = drain_ma > 0.0 ? usable_mah / drain_ma : infinity;
+                }
+            }
+
+            void net_drain(std::vector<double> &out) const
+            {
+                const size_t n = ids.size();
+                out.resize(n);
+                for (size_t i = 0; i < n; ++i)
+                {
+                    out[i] = consumption_mw[i] - harvest_mw[i];
+                }
+            }
+
+            void clear()
+            {
+                *this = FleetStore();
+            }
+        };
+    } // namespace
+
     class PowerManager::Impl
     {
     public:
@@ -25,6 +146,12 @@ namespace cardano_iot::energy
         std::unordered_map<std::string, PowerSettings> device_settings_;
         std::unordered_map<std::string, HarvestingConfig> harvesting_configs_;
 
+        // Fleet-scan mirror of device_profiles_; refresh it after changing a profile
+        FleetStore fleet_;
+
+        // Harvested energy per device and source (mWh)
+        std::unordered_map<std::string, std::map<PowerSource, double>> harvested_mwh_;
+
         // Power history: device_id -> vector of (timestamp, power_mw)
         std::unordered_map<std::string, std::vector<std::pair<uint64_t, double>>> power_history_;
 
@@ -76,18 +203,65 @@ namespace cardano_iot::energy
 
         void update_power_history(const std::string &device_id, double power_mw)
         {
-            uint64_t timestamp = get_current_timestamp();
+            update_power_history(device_id, power_mw, get_current_timestamp());
+        }
 
+        void update_power_history(const std::string &device_id, double power_mw, uint64_t timestamp)
+        {
             auto &history = power_history_[device_id];
             history.emplace_back(timestamp, power_mw);
 
-            // Keep only last 7 days of data
+            // Keep only last 7 days of data; entries are appended in time order
             uint64_t week_ago = timestamp - (7 * 24 * 3600);
-            history.erase(
-                std::remove_if(history.begin(), history.end(),
-                               [week_ago](const auto &entry)
-                               { return entry.first < week_ago; }),
-                history.end());
+            if (history.front().first < week_ago)
+            {
+                history.erase(history.begin(),
+                              std::partition_point(history.begin(), history.end(),
+                                                   [week_ago](const auto &entry)
+                                                   { return entry.first < week_ago; }));
+            }
+        }
+
+        // Caller holds data_mutex_; returns the previous state
+        PowerState change_state(PowerProfile &profile, PowerState state)
+        {
+            PowerState old_state = profile.current_state;
+            profile.current_state = state;
+
+            // Adjust power consumption based on state
+            double power_multiplier = 1.0;
+            switch (state)
+            {
+            case PowerState::ACTIVE:
+                power_multiplier = 1.0;
+                break;
+            case PowerState::IDLE:
+                power_multiplier = 0.7;
+                break;
+            case PowerState::SLEEP:
+                power_multiplier = 0.1;
+                break;
+            case PowerState::DEEP_SLEEP:
+                power_multiplier = 0.05;
+                break;
+            case PowerState::HIBERNATION:
+                power_multiplier = 0.01;
+                break;
+            case PowerState::CHARGING:
+                power_multiplier = 1.2;
+                break;
+            case PowerState::CRITICAL:
+                power_multiplier = 0.2;
+                break;
+            }
+
+            profile.power_consumption_mw *= power_multiplier;
+            fleet_.update(profile);
+
+            utils::Logger::instance().log(utils::LogLevel::INFO, "PowerManager",
+                                          "Power state changed: " + profile.device_id + " from " +
+                                              power_state_to_string(old_state) + " to " + power_state_to_string(state));
+            return old_state;
         }
 
         double calculate_average_power(const std::string &device_id, uint32_t hours) const
@@ -135,8 +309,7 @@ namespace cardano_iot::energy
         // Process configuration parameters
         for (const auto &[key, value] : config_params)
         {
-            utils::Logger::instance().log(utils::LogLevel::DEBUG, "PowerManager",
-                                          "Config: " + key + " = " + value);
+            CARDANO_IOT_LOG(utils::LogLevel::DEBUG, "PowerManager", "Config: " << key << " = " << value);
         }
 
         pimpl_->initialized_ = true;
@@ -160,6 +333,8 @@ namespace cardano_iot::energy
         pimpl_->device_settings_.clear();
         pimpl_->harvesting_configs_.clear();
         pimpl_->power_history_.clear();
+        pimpl_->harvested_mwh_.clear();
+        pimpl_->fleet_.clear();
 
         pimpl_->initialized_ = false;
 
@@ -207,6 +382,7 @@ namespace cardano_iot::energy
 
         pimpl_->device_profiles_[device_id] = profile;
         pimpl_->device_settings_[device_id] = settings;
+        pimpl_->fleet_.add(*profile, settings.critical_threshold);
         pimpl_->total_devices_++;
 
         utils::Logger::instance().log(utils::LogLevel::INFO, "PowerManager",
@@ -223,6 +399,8 @@ namespace cardano_iot::energy
         pimpl_->device_settings_.erase(device_id);
         pimpl_->harvesting_configs_.erase(device_id);
         pimpl_->power_history_.erase(device_id);
+        pimpl_->harvested_mwh_.erase(device_id);
+        pimpl_->fleet_.remove(device_id);
 
         utils::Logger::instance().log(utils::LogLevel::INFO, "PowerManager",
                                       "Device unregistered from power management: " + device_id);
@@ -240,42 +418,7 @@ namespace cardano_iot::energy
             return false;
         }
 
-        PowerState old_state = it->second->current_state;
-        it->second->current_state = state;
-
-        // Adjust power consumption based on state
-        double power_multiplier = 1.0;
-        switch (state)
-        {
-        case PowerState::ACTIVE:
-            power_multiplier = 1.0;
-            break;
-        case PowerState::IDLE:
-            power_multiplier = 0.7;
-            break;
-        case PowerState::SLEEP:
-            power_multiplier = 0.1;
-            break;
-        case PowerState::DEEP_SLEEP:
-            power_multiplier = 0.05;
-            break;
-        case PowerState::HIBERNATION:
-            power_multiplier = 0.01;
-            break;
-        case PowerState::CHARGING:
-            power_multiplier = 1.2;
-            break;
-        case PowerState::CRITICAL:
-            power_multiplier = 0.2;
-            break;
-        }
-
-        it->second->power_consumption_mw *= power_multiplier;
-
-        utils::Logger::instance().log(utils::LogLevel::INFO, "PowerManager",
-                                      "Power state changed: " + device_id + " from " + power_state_to_string(old_state) +
-                                          " to " + power_state_to_string(state));
-
+        pimpl_->change_state(*it->second, state);
         pimpl_->notify_power_event(device_id, state, it->second->battery.charge_level);
 
         return true;
@@ -322,11 +465,13 @@ namespace cardano_iot::energy
         }
 
         it->second->battery = battery_info;
+        pimpl_->fleet_.update(*it->second);
 
-        // Check for critical battery
+        // Check for critical battery; set_power_state would re-lock data_mutex_
         if (battery_info.charge_level < 0.05)
         {
-            set_power_state(device_id, PowerState::CRITICAL);
+            pimpl_->change_state(*it->second, PowerState::CRITICAL);
+            pimpl_->notify_power_event(device_id, PowerState::CRITICAL, battery_info.charge_level);
         }
 
         pimpl_->notify_battery_event(device_id, battery_info);
@@ -404,11 +549,64 @@ namespace cardano_iot::energy
         }
 
         it->second->power_consumption_mw = power_mw;
+        pimpl_->fleet_.update(*it->second);
         pimpl_->update_power_history(device_id, power_mw);
 
         return true;
     }
 
+    size_t PowerManager::apply_telemetry_batch(const std::vector<core::DeviceTelemetry> &records)
+    {
+        std::vector<std::pair<std::string, double>> critical;
+        std::unordered_map<std::string, BatteryInfo> battery_updates;
+        size_t count = 0;
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->data_mutex_);
+            const uint64_t now = pimpl_->get_current_timestamp();
+            for (const auto &record : records)
+            {
+                auto it = pimpl_->device_profiles_.find(record.device_id);
+                if (it == pimpl_->device_profiles_.end())
+                {
+                    continue;
+                }
+                PowerProfile &profile = *it->second;
+
+                if (record.has_power())
+                {
+                    profile.power_consumption_mw = record.power_mw;
+                    pimpl_->update_power_history(record.device_id, record.power_mw, now);
+                }
+                if (record.has_battery())
+                {
+                    BatteryInfo &battery = profile.battery;
+                    battery.charge_level = std::min(record.battery_level, 1.0);
+                    battery.remaining_mah = battery.capacity_mah * battery.charge_level;
+                    battery.last_update = now;
+                    if (battery.charge_level < 0.05 && profile.current_state != PowerState::CRITICAL)
+                    {
+                        pimpl_->change_state(profile, PowerState::CRITICAL);
+                        critical.emplace_back(record.device_id, battery.charge_level);
+                    }
+                    battery_updates[record.device_id] = battery;
+                }
+                pimpl_->fleet_.update(profile);
+                ++count;
+            }
+        }
+
+        for (const auto &[device_id, battery_level] : critical)
+        {
+            pimpl_->notify_power_event(device_id, PowerState::CRITICAL, battery_level);
+        }
+        for (const auto &[device_id, battery] : battery_updates)
+        {
+            pimpl_->notify_battery_event(device_id, battery);
+        }
+
+        return count;
+    }
+
     std::map<std::string, std::string> PowerManager::get_optimization_recommendations(const std::string &device_id) const
     {
         std::map<std::string, std::string> recommendations;
@@ -460,10 +658,174 @@ namespace cardano_iot::energy
         }
 
         it->second->power_consumption_mw = total_power;
+        pimpl_->fleet_.update(*it->second);
+
+        return true;
+    }
+
+    bool PowerManager::configure_energy_harvesting(const std::string &device_id,
+                                                   const HarvestingConfig &config)
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->data_mutex_);
+
+        if (pimpl_->device_profiles_.find(device_id) == pimpl_->device_profiles_.end())
+        {
+            return false;
+        }
+        pimpl_->harvesting_configs_[device_id] = config;
+        return true;
+    }
+
+    bool PowerManager::update_harvested_energy(const std::string &device_id,
+                                               PowerSource source,
+                                               double energy_mwh)
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->data_mutex_);
+
+        if (energy_mwh < 0 || pimpl_->device_profiles_.find(device_id) == pimpl_->device_profiles_.end())
+        {
+            return false;
+        }
+        pimpl_->harvested_mwh_[device_id][source] += energy_mwh;
 
+        // A report covers the last hour, so mWh over it is the average harvest power in mW
+        pimpl_->fleet_.set_harvest(device_id, energy_mwh);
         return true;
     }
 
+    std::map<std::string, double> PowerManager::get_harvesting_stats(const std::string &device_id) const
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->data_mutex_);
+
+        std::map<std::string, double> stats;
+        auto slot = pimpl_->fleet_.slots.find(device_id);
+        if (slot == pimpl_->fleet_.slots.end())
+        {
+            return stats;
+        }
+
+        double total = 0.0;
+        auto it = pimpl_->harvested_mwh_.find(device_id);
+        if (it != pimpl_->harvested_mwh_.end())
+        {
+            for (const auto &[source, energy] : it->second)
+            {
+                stats[power_source_to_string(source) + "_mwh"] = energy;
+                total += energy;
+            }
+        }
+        stats["total_mwh"] = total;
+        stats["harvest_rate_mw"] = pimpl_->fleet_.harvest_mw[slot->second];
+        return stats;
+    }
+
+    std::map<std::string, double> PowerManager::get_efficiency_metrics(const std::string &device_id) const
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->data_mutex_);
+
+        std::map<std::string, double> metrics;
+        auto it = pimpl_->device_profiles_.find(device_id);
+        auto slot = pimpl_->fleet_.slots.find(device_id);
+        if (it == pimpl_->device_profiles_.end() || slot == pimpl_->fleet_.slots.end())
+        {
+            return metrics;
+        }
+
+        const PowerProfile &profile = *it->second;
+        const FleetStore &fleet = pimpl_->fleet_;
+        const size_t i = slot->second;
+        const double consumption = fleet.consumption_mw[i];
+        const double harvest = fleet.harvest_mw[i];
+        const double usable_mah = std::max(fleet.remaining_mah[i] - fleet.capacity_mah[i] * fleet.critical_threshold[i], 0.0);
+        const double drain_ma = (consumption - harvest) / std::max(fleet.voltage[i], 1e-9);
+
+        metrics["consumption_mw"] = consumption;
+        metrics["harvest_mw"] = harvest;
+        metrics["net_drain_mw"] = consumption - harvest;
+        metrics["harvest_coverage"] = consumption > 0 ? std::min(harvest / consumption, 1.0) : 1.0;
+        metrics["hours_to_critical"] = drain_ma > 0 ? usable_mah / drain_ma : std::numeric_limits<double>::infinity();
+        metrics["avg_power_1h"] = pimpl_->calculate_average_power(device_id, 1);
+        metrics["sleep_ratio"] = profile.uptime_seconds > 0
+                                     ? static_cast<double>(profile.sleep_time_seconds) / profile.uptime_seconds
+                                     : 0.0;
+        return metrics;
+    }
+
+    std::vector<std::pair<std::string, double>> PowerManager::get_devices_critical_within(double hours) const
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->data_mutex_);
+
+        std::vector<double> runtime;
+        pimpl_->fleet_.hours_to_critical(runtime);
+
+        std::vector<std::pair<std::string, double>> result;
+        for (size_t i = 0; i < runtime.size(); ++i)
+        {
+            if (runtime[i] <= hours)
+            {
+                result.emplace_back(pimpl_->fleet_.ids[i], runtime[i]);
+            }
+        }
+        std::sort(result.begin(), result.end(),
+                  [](const auto &a, const auto &b)
+                  { return a.second < b.second; });
+        return result;
+    }
+
+    std::vector<std::pair<std::string, double>> PowerManager::get_top_draining_devices(size_t count) const
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->data_mutex_);
+
+        std::vector<double> drain;
+        pimpl_->fleet_.net_drain(drain);
+
+        std::vector<size_t> order(drain.size());
+        std::iota(order.begin(), order.end(), 0);
+        count = std::min(count, order.size());
+        auto greater = [&drain](size_t a, size_t b)
+        { return drain[a] > drain[b]; };
+        std::partial_sort(order.begin(), order.begin() + count, order.end(), greater);
+
+        std::vector<std::pair<std::string, double>> result;
+        result.reserve(count);
+        for (size_t k = 0; k < count; ++k)
+        {
+            result.emplace_back(pimpl_->fleet_.ids[order[k]], drain[order[k]]);
+        }
+        return result;
+    }
+
+    std::map<std::string, double> PowerManager::get_fleet_power_summary() const
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->data_mutex_);
+
+        const FleetStore &fleet = pimpl_->fleet_;
+        const size_t n = fleet.ids.size();
+        std::vector<double> runtime;
+        fleet.hours_to_critical(runtime);
+
+        double battery_sum = 0.0, consumption_sum = 0.0, harvest_sum = 0.0;
+        double min_runtime = std::numeric_limits<double>::infinity();
+        size_t critical = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            battery_sum += fleet.charge_level[i];
+            consumption_sum += fleet.consumption_mw[i];
+            harvest_sum += fleet.harvest_mw[i];
+            min_runtime = std::min(min_runtime, runtime[i]);
+            critical += fleet.charge_level[i] < fleet.critical_threshold[i] ? 1 : 0;
+        }
+
+        std::map<std::string, double> summary;
+        summary["devices"] = static_cast<double>(n);
+        summary["avg_battery_level"] = n > 0 ? battery_sum / n : 0.0;
+        summary["total_consumption_mw"] = consumption_sum;
+        summary["total_harvest_mw"] = harvest_sum;
+        summary["critical_devices"] = static_cast<double>(critical);
+        summary["min_hours_to_critical"] = min_runtime;
+        return summary;
+    }
+
     std::map<std::string, uint64_t> PowerManager::get_statistics() const
     {
         std::lock_guard<std::mutex> lock(pimpl_->data_mutex_);
@@ -554,6 +916,36 @@ namespace cardano_iot::energy
         return estimated_runtime > operation_time_hours * 2; // 2x safety margin
     }
 
+    bool PowerManager::has_power_surplus(const std::string &device_id) const
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->data_mutex_);
+
+        auto it = pimpl_->device_profiles_.find(device_id);
+        auto slot = pimpl_->fleet_.slots.find(device_id);
+        if (it == pimpl_->device_profiles_.end() || slot == pimpl_->fleet_.slots.end())
+        {
+            return false;
+        }
+
+        const PowerProfile &profile = *it->second;
+        const size_t i = slot->second;
+        return profile.current_state == PowerState::CHARGING || profile.power_source == PowerSource::AC_POWER ||
+               pimpl_->fleet_.harvest_mw[i] > pimpl_->fleet_.consumption_mw[i];
+    }
+
+    bool PowerManager::get_power_settings(const std::string &device_id, PowerSettings &settings) const
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->data_mutex_);
+
+        auto it = pimpl_->device_settings_.find(device_id);
+        if (it == pimpl_->device_settings_.end())
+        {
+            return false;
+        }
+        settings = it->second;
+        return true;
+    }
+
     // Utility functions
     std::string power_state_to_string(PowerState state)
     {
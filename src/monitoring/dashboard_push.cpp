@@ -0,0 +1,1146 @@
+/**
+ * @file dashboard_push.cpp
+ * @brief Implementation of the WebSocket push channel for dashboard clients
+ *
+ * @author Cardano IoT SDK Team
+ * @version 1.0.0
+ */
+
+#include "cardano_iot/monitoring/dashboard_push.h"
+#include "cardano_iot/network/wire_format.h"
+#include "cardano_iot/utils/codec.h"
+#include "cardano_iot/utils/logger.h"
+
+#include <openssl/evp.h>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace cardano_iot::monitoring
+{
+
+    namespace
+    {
+        namespace wire = network::wire;
+
+        constexpr const char *WEBSOCKET_GUID = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+        constexpr size_t MAX_REQUEST_BYTES = 8192;
+        constexpr size_t READ_CHUNK = 16 * 1024;
+        constexpr size_t MAX_IOVECS = 64;
+        constexpr int MAX_POLL_MS = 100;
+
+        constexpr uint8_t OPCODE_CONTINUATION = 0x0;
+        constexpr uint8_t OPCODE_TEXT = 0x1;
+        constexpr uint8_t OPCODE_BINARY = 0x2;
+        constexpr uint8_t OPCODE_CLOSE = 0x8;
+        constexpr uint8_t OPCODE_PING = 0x9;
+        constexpr uint8_t OPCODE_PONG = 0xA;
+
+#if defined(MSG_NOSIGNAL)
+        constexpr int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+        constexpr int SEND_FLAGS = 0;
+#endif
+
+        using Buffer = std::shared_ptr<const std::vector<uint8_t>>;
+
+        uint64_t zigzag(int64_t value)
+        {
+            return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+        }
+
+        int64_t unzigzag(uint64_t value)
+        {
+            return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+        }
+
+        void put_varint(std::vector<uint8_t> &out, uint64_t value)
+        {
+            uint8_t bytes[wire::MAX_VARINT_BYTES];
+            out.insert(out.end(), bytes, bytes + wire::put_varint(value, bytes));
+        }
+
+        void put_string(std::vector<uint8_t> &out, const std::string &value)
+        {
+            put_varint(out, value.size());
+            out.insert(out.end(), value.begin(), value.end());
+        }
+
+        // Bounds-checked reader over an encoded frame
+        struct Reader
+        {
+            const uint8_t *data;
+            size_t size;
+            size_t offset = 0;
+
+            bool varint(uint64_t &value)
+            {
+                const size_t used = wire::get_varint(data + offset, size - offset, value);
+                offset += used;
+                return used > 0;
+            }
+
+            bool byte(uint8_t &value)
+            {
+                if (offset >= size)
+                {
+                    return false;
+                }
+                value = data[offset++];
+                return true;
+            }
+
+            bool string(std::string &value)
+            {
+                uint64_t length = 0;
+                if (!varint(length) || length > size - offset)
+                {
+                    return false;
+                }
+                value.assign(reinterpret_cast<const char *>(data + offset), static_cast<size_t>(length));
+                offset += static_cast<size_t>(length);
+                return true;
+            }
+        };
+
+        double scale_of(uint8_t decimals)
+        {
+            return std::pow(10.0, decimals);
+        }
+
+        int64_t scaled(double value, double scale)
+        {
+            const double result = std::round(value * scale);
+            constexpr double LIMIT = 9.2e18;
+            return static_cast<int64_t>(std::clamp(result, -LIMIT, LIMIT));
+        }
+
+        // Server-to-client frames are never masked, so one buffer serves every client
+        Buffer websocket_frame(uint8_t opcode, const uint8_t *payload, size_t size)
+        {
+            auto frame = std::make_shared<std::vector<uint8_t>>();
+            frame->reserve(size + 10);
+            frame->push_back(static_cast<uint8_t>(0x80 | opcode));
+            if (size < 126)
+            {
+                frame->push_back(static_cast<uint8_t>(size));
+            }
+            else if (size <= 0xFFFF)
+            {
+                frame->push_back(126);
+                frame->push_back(static_cast<uint8_t>(size >> 8));
+                frame->push_back(static_cast<uint8_t>(size));
+            }
+            else
+            {
+                frame->push_back(127);
+                for (int shift = 56; shift >= 0; shift -= 8)
+                {
+                    frame->push_back(static_cast<uint8_t>(static_cast<uint64_t>(size) >> shift));
+                }
+            }
+            frame->insert(frame->end(), payload, payload + size);
+            return frame;
+        }
+
+        Buffer text_frame(const std::string &text)
+        {
+            return websocket_frame(OPCODE_TEXT, reinterpret_cast<const uint8_t *>(text.data()), text.size());
+        }
+
+        Buffer raw_buffer(const std::string &text)
+        {
+            return std::make_shared<std::vector<uint8_t>>(text.begin(), text.end());
+        }
+
+        std::string lowercase(std::string text)
+        {
+            std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c)
+                           { return static_cast<char>(std::tolower(c)); });
+            return text;
+        }
+
+        std::string trim(const std::string &text)
+        {
+            const size_t first = text.find_first_not_of(" \t");
+            if (first == std::string::npos)
+            {
+                return "";
+            }
+            return text.substr(first, text.find_last_not_of(" \t") - first + 1);
+        }
+
+        bool set_non_blocking(int fd)
+        {
+            const int flags = fcntl(fd, F_GETFL, 0);
+            return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+        }
+    } // namespace
+
+    void PushFrame::encode(std::vector<uint8_t> &out) const
+    {
+        const double scale = scale_of(decimals);
+        out.push_back(static_cast<uint8_t>(type));
+        put_string(out, channel);
+        out.push_back(decimals);
+        put_varint(out, series.size());
+
+        for (const auto &entry : series)
+        {
+            put_string(out, entry.source_id);
+            put_varint(out, entry.points.size());
+
+            uint64_t previous_time = 0;
+            for (size_t i = 0; i < entry.points.size(); ++i)
+            {
+                const uint64_t timestamp = entry.points[i].first;
+                if (i == 0)
+                {
+                    put_varint(out, timestamp);
+                }
+                else
+                {
+                    put_varint(out, zigzag(static_cast<int64_t>(timestamp - previous_time)));
+                }
+                previous_time = timestamp;
+            }
+
+            int64_t previous_value = 0;
+            for (const auto &[timestamp, value] : entry.points)
+            {
+                const int64_t current = scaled(value, scale);
+                put_varint(out, zigzag(static_cast<int64_t>(static_cast<uint64_t>(current) - static_cast<uint64_t>(previous_value))));
+                previous_value = current;
+            }
+        }
+    }
+
+    bool PushFrame::decode(const uint8_t *data, size_t size, PushFrame &frame)
+    {
+        Reader reader{data, size};
+        uint8_t type = 0;
+        uint64_t series_count = 0;
+        if (!reader.byte(type) || (type != static_cast<uint8_t>(Type::POINTS) && type != static_cast<uint8_t>(Type::RESYNC)) ||
+            !reader.string(frame.channel) || !reader.byte(frame.decimals) || !reader.varint(series_count) ||
+            series_count > size)
+        {
+            return false;
+        }
+        frame.type = static_cast<Type>(type);
+        const double scale = scale_of(frame.decimals);
+
+        frame.series.clear();
+        frame.series.resize(static_cast<size_t>(series_count));
+        for (auto &entry : frame.series)
+        {
+            uint64_t count = 0;
+            if (!reader.string(entry.source_id) || !reader.varint(count) || count > size)
+            {
+                return false;
+            }
+            entry.points.resize(static_cast<size_t>(count));
+
+            uint64_t timestamp = 0;
+            for (size_t i = 0; i < entry.points.size(); ++i)
+            {
+                uint64_t encoded = 0;
+                if (!reader.varint(encoded))
+                {
+                    return false;
+                }
+                timestamp = i == 0 ? encoded : timestamp + static_cast<uint64_t>(unzigzag(encoded));
+                entry.points[i].first = timestamp;
+            }
+
+            int64_t value = 0;
+            for (auto &point : entry.points)
+            {
+                uint64_t encoded = 0;
+                if (!reader.varint(encoded))
+                {
+                    return false;
+                }
+                value = static_cast<int64_t>(static_cast<uint64_t>(value) + static_cast<uint64_t>(unzigzag(encoded)));
+                point.second = static_cast<double>(value) / scale;
+            }
+        }
+        return reader.offset == size;
+    }
+
+    std::string websocket_accept_key(const std::string &client_key)
+    {
+        const std::string input = client_key + WEBSOCKET_GUID;
+        std::vector<uint8_t> digest(EVP_MAX_MD_SIZE);
+        unsigned int length = 0;
+        if (EVP_Digest(input.data(), input.size(), digest.data(), &length, EVP_sha1(), nullptr) != 1)
+        {
+            return "";
+        }
+        digest.resize(length);
+        return utils::codec::base64_encode(digest);
+    }
+
+    class DashboardPushServer::Impl
+    {
+    public:
+        struct Client
+        {
+            int fd = -1;
+            ClientId id = 0;
+            bool upgraded = false;
+            bool closing = false; // Close once the queue is written
+            std::string inbox;
+            std::string fragments; // Text message continued over several frames
+            std::deque<Buffer> queue;
+            size_t offset = 0; // Into queue.front()
+            size_t queued_bytes = 0;
+            std::unordered_set<std::string> channels;
+            std::unordered_set<std::string> resync; // Channels with dropped frames
+        };
+
+        explicit Impl(const Options &options) : options_(options) {}
+
+        Options options_;
+
+        MessageHandler on_message_;
+        CloseHandler on_close_;
+        std::map<std::string, std::pair<std::string, HttpHandler>> http_routes_; // path -> content type, handler
+
+        std::atomic<bool> running_{false};
+        std::thread loop_;
+        int listen_fd_ = -1;
+        int wake_fds_[2] = {-1, -1};
+        uint16_t port_ = 0;
+
+        // Clients, subscriptions and send queues
+        mutable std::mutex state_mutex_;
+        std::unordered_map<ClientId, std::unique_ptr<Client>> clients_;
+        std::unordered_map<std::string, std::unordered_set<ClientId>> subscribers_;
+        ClientId next_id_ = 1;
+
+        // Points published since the last flush: channel -> source -> points
+        std::mutex pending_mutex_;
+        std::map<std::string, std::map<std::string, std::vector<std::pair<uint64_t, double>>>> pending_;
+
+        std::atomic<uint64_t> clients_accepted_{0};
+        std::atomic<uint64_t> clients_rejected_{0};
+        std::atomic<uint64_t> frames_encoded_{0};
+        std::atomic<uint64_t> frames_queued_{0};
+        std::atomic<uint64_t> frames_dropped_{0};
+        std::atomic<uint64_t> points_published_{0};
+        std::atomic<uint64_t> points_dropped_{0};
+        std::atomic<uint64_t> bytes_sent_{0};
+
+        void wake()
+        {
+            const uint8_t byte = 1;
+            if (wake_fds_[1] >= 0)
+            {
+                [[maybe_unused]] ssize_t written = ::write(wake_fds_[1], &byte, 1);
+            }
+        }
+
+        // Caller holds state_mutex_. Control frames and handshakes pass force to skip the limit.
+        bool enqueue(Client &client, const Buffer &buffer, bool force = false)
+        {
+            if (client.closing)
+            {
+                return false;
+            }
+            if (!force && client.queued_bytes + buffer->size() > options_.max_queued_bytes)
+            {
+                frames_dropped_++;
+                return false;
+            }
+            const bool was_idle = client.queue.empty();
+            client.queue.push_back(buffer);
+            client.queued_bytes += buffer->size();
+            frames_queued_++;
+            if (was_idle)
+            {
+                write(client);
+            }
+            return true;
+        }
+
+        // Caller holds state_mutex_
+        void enqueue_update(Client &client, const std::string &channel, const Buffer &buffer)
+        {
+            if (!client.resync.empty() && client.queued_bytes <= options_.max_queued_bytes / 2)
+            {
+                for (const auto &lagging : client.resync)
+                {
+                    PushFrame notice;
+                    notice.type = PushFrame::Type::RESYNC;
+                    notice.channel = lagging;
+                    std::vector<uint8_t> payload;
+                    notice.encode(payload);
+                    enqueue(client, websocket_frame(OPCODE_BINARY, payload.data(), payload.size()), true);
+                }
+                client.resync.clear();
+            }
+            if (!enqueue(client, buffer))
+            {
+                client.resync.insert(channel);
+            }
+        }
+
+        // Caller holds state_mutex_. Writes as much of the queue as the socket takes.
+        void write(Client &client)
+        {
+            while (!client.queue.empty())
+            {
+                iovec vectors[MAX_IOVECS];
+                size_t count = 0;
+                for (auto it = client.queue.begin(); it != client.queue.end() && count < MAX_IOVECS; ++it, ++count)
+                {
+                    const size_t skip = count == 0 ? client.offset : 0;
+                    vectors[count].iov_base = const_cast<uint8_t *>((*it)->data() + skip);
+                    vectors[count].iov_len = (*it)->size() - skip;
+                }
+
+                msghdr message{};
+                message.msg_iov = vectors;
+                message.msg_iovlen = count;
+                const ssize_t written = ::sendmsg(client.fd, &message, SEND_FLAGS);
+                if (written < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+                    if (errno != EAGAIN && errno != EWOULDBLOCK)
+                    {
+                        client.closing = true;
+                        client.queue.clear();
+                        client.queued_bytes = 0;
+                    }
+                    return;
+                }
+
+                bytes_sent_ += static_cast<uint64_t>(written);
+                size_t remaining = static_cast<size_t>(written);
+                while (remaining > 0)
+                {
+                    const size_t left = client.queue.front()->size() - client.offset;
+                    if (remaining < left)
+                    {
+                        client.offset += remaining;
+                        break;
+                    }
+                    remaining -= left;
+                    client.queued_bytes -= client.queue.front()->size();
+                    client.queue.pop_front();
+                    client.offset = 0;
+                }
+                if (!client.queue.empty() && client.offset > 0)
+                {
+                    return; // Socket buffer full
+                }
+            }
+        }
+
+        // Caller holds state_mutex_
+        void handshake(Client &client)
+        {
+            const size_t header_end = client.inbox.find("\r\n\r\n");
+            if (header_end == std::string::npos)
+            {
+                if (client.inbox.size() > MAX_REQUEST_BYTES)
+                {
+                    reject(client, "431 Request Header Fields Too Large");
+                }
+                return;
+            }
+
+            std::string request = client.inbox.substr(0, header_end);
+            client.inbox.erase(0, header_end + 4);
+
+            std::map<std::string, std::string> headers;
+            std::string request_line;
+            size_t line_start = 0;
+            while (line_start <= request.size())
+            {
+                size_t line_end = request.find("\r\n", line_start);
+                if (line_end == std::string::npos)
+                {
+                    line_end = request.size();
+                }
+                const std::string line = request.substr(line_start, line_end - line_start);
+                if (request_line.empty())
+                {
+                    request_line = line;
+                }
+                else
+                {
+                    const size_t colon = line.find(':');
+                    if (colon != std::string::npos)
+                    {
+                        headers[lowercase(trim(line.substr(0, colon)))] = trim(line.substr(colon + 1));
+                    }
+                }
+                line_start = line_end + 2;
+            }
+
+            // "GET /path?query HTTP/1.1"
+            const size_t path_start = request_line.find(' ');
+            const size_t path_end = request_line.find(' ', path_start + 1);
+            if (request_line.compare(0, 4, "GET ") != 0 || path_end == std::string::npos)
+            {
+                reject(client, "400 Bad Request");
+                return;
+            }
+            std::string path = request_line.substr(path_start + 1, path_end - path_start - 1);
+            path = path.substr(0, path.find('?'));
+            auto key = headers.find("sec-websocket-key");
+            auto upgrade = headers.find("upgrade");
+
+            auto route = http_routes_.find(path);
+            if (route != http_routes_.end() && upgrade == headers.end())
+            {
+                const std::string body = route->second.second();
+                enqueue(client,
+                        raw_buffer("HTTP/1.1 200 OK\r\nContent-Type: " + route->second.first +
+                                   "\r\nContent-Length: " + std::to_string(body.size()) +
+                                   "\r\nConnection: close\r\n\r\n" + body),
+                        true);
+                client.closing = true;
+                client.inbox.clear();
+                return;
+            }
+            if (path != options_.path)
+            {
+                reject(client, "404 Not Found");
+                return;
+            }
+
+            if (key == headers.end() || upgrade == headers.end() || lowercase(upgrade->second) != "websocket")
+            {
+                reject(client, "400 Bad Request");
+                return;
+            }
+
+            enqueue(client,
+                    raw_buffer("HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+                               "Sec-WebSocket-Accept: " +
+                               websocket_accept_key(key->second) + "\r\n\r\n"),
+                    true);
+            client.upgraded = true;
+        }
+
+        void reject(Client &client, const std::string &status)
+        {
+            enqueue(client, raw_buffer("HTTP/1.1 " + status + "\r\nContent-Length: 0\r\nConnection: close\r\n\r\n"), true);
+            client.closing = true;
+            client.inbox.clear();
+        }
+
+        // Caller holds state_mutex_. Decodes complete client frames from the inbox.
+        void read_frames(Client &client, std::vector<std::pair<ClientId, std::string>> &messages)
+        {
+            size_t offset = 0;
+            const auto *data = reinterpret_cast<const uint8_t *>(client.inbox.data());
+            const size_t size = client.inbox.size();
+
+            while (!client.closing && size - offset >= 2)
+            {
+                const uint8_t first = data[offset];
+                const uint8_t second = data[offset + 1];
+                const bool fin = (first & 0x80) != 0;
+                const uint8_t opcode = first & 0x0F;
+                size_t header = 2;
+                uint64_t length = second & 0x7F;
+
+                if ((second & 0x80) == 0)
+                {
+                    close_with(client, 1002); // Client frames must be masked
+                    break;
+                }
+                if (length == 126)
+                {
+                    if (size - offset < 4)
+                    {
+                        break;
+                    }
+                    length = (static_cast<uint64_t>(data[offset + 2]) << 8) | data[offset + 3];
+                    header = 4;
+                }
+                else if (length == 127)
+                {
+                    if (size - offset < 10)
+                    {
+                        break;
+                    }
+                    length = 0;
+                    for (size_t i = 0; i < 8; ++i)
+                    {
+                        length = (length << 8) | data[offset + 2 + i];
+                    }
+                    header = 10;
+                }
+                if (length > options_.max_message_bytes)
+                {
+                    close_with(client, 1009);
+                    break;
+                }
+                if (size - offset < header + 4 + length)
+                {
+                    break;
+                }
+
+                const uint8_t *mask = data + offset + header;
+                std::string payload(static_cast<size_t>(length), '\0');
+                for (size_t i = 0; i < payload.size(); ++i)
+                {
+                    payload[i] = static_cast<char>(data[offset + header + 4 + i] ^ mask[i % 4]);
+                }
+                offset += header + 4 + static_cast<size_t>(length);
+
+                switch (opcode)
+                {
+                case OPCODE_TEXT:
+                case OPCODE_CONTINUATION:
+                    if (opcode == OPCODE_TEXT)
+                    {
+                        client.fragments.clear();
+                    }
+                    client.fragments += payload;
+                    if (client.fragments.size() > options_.max_message_bytes)
+                    {
+                        close_with(client, 1009);
+                    }
+                    else if (fin)
+                    {
+                        text_message(client, client.fragments, messages);
+                        client.fragments.clear();
+                    }
+                    break;
+                case OPCODE_PING:
+                    enqueue(client, websocket_frame(OPCODE_PONG, reinterpret_cast<const uint8_t *>(payload.data()), payload.size()), true);
+                    break;
+                case OPCODE_CLOSE:
+                    close_with(client, 1000);
+                    break;
+                case OPCODE_BINARY:
+                case OPCODE_PONG:
+                    break;
+                default:
+                    close_with(client, 1002);
+                    break;
+                }
+            }
+            client.inbox.erase(0, offset);
+        }
+
+        void close_with(Client &client, uint16_t code)
+        {
+            const uint8_t payload[2] = {static_cast<uint8_t>(code >> 8), static_cast<uint8_t>(code)};
+            enqueue(client, websocket_frame(OPCODE_CLOSE, payload, sizeof(payload)), true);
+            client.closing = true;
+        }
+
+        void text_message(Client &client, const std::string &text, std::vector<std::pair<ClientId, std::string>> &messages)
+        {
+            const size_t space = text.find(' ');
+            const std::string command = text.substr(0, space);
+            const std::string channel = space == std::string::npos ? "" : trim(text.substr(space + 1));
+
+            if (command == "subscribe" && !channel.empty())
+            {
+                client.channels.insert(channel);
+                subscribers_[channel].insert(client.id);
+            }
+            else if (command == "unsubscribe" && !channel.empty())
+            {
+                client.channels.erase(channel);
+                client.resync.erase(channel);
+                auto it = subscribers_.find(channel);
+                if (it != subscribers_.end())
+                {
+                    it->second.erase(client.id);
+                    if (it->second.empty())
+                    {
+                        subscribers_.erase(it);
+                    }
+                }
+            }
+            else
+            {
+                messages.emplace_back(client.id, text);
+            }
+        }
+
+        // Caller holds state_mutex_
+        void remove(ClientId id)
+        {
+            auto it = clients_.find(id);
+            if (it == clients_.end())
+            {
+                return;
+            }
+            for (const auto &channel : it->second->channels)
+            {
+                auto subscribers = subscribers_.find(channel);
+                if (subscribers != subscribers_.end())
+                {
+                    subscribers->second.erase(id);
+                    if (subscribers->second.empty())
+                    {
+                        subscribers_.erase(subscribers);
+                    }
+                }
+            }
+            ::close(it->second->fd);
+            clients_.erase(it);
+        }
+
+        void accept_clients()
+        {
+            while (true)
+            {
+                const int fd = ::accept(listen_fd_, nullptr, nullptr);
+                if (fd < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+                    return;
+                }
+
+                std::lock_guard<std::mutex> lock(state_mutex_);
+                if (clients_.size() >= options_.max_clients || !set_non_blocking(fd))
+                {
+                    ::close(fd);
+                    clients_rejected_++;
+                    continue;
+                }
+                int one = 1;
+                setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+#if defined(SO_NOSIGPIPE)
+                setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+                if (options_.send_buffer_bytes > 0)
+                {
+                    setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &options_.send_buffer_bytes, sizeof(options_.send_buffer_bytes));
+                }
+                fcntl(fd, F_SETFD, FD_CLOEXEC);
+
+                auto client = std::make_unique<Client>();
+                client->fd = fd;
+                client->id = next_id_++;
+                clients_.emplace(client->id, std::move(client));
+                clients_accepted_++;
+            }
+        }
+
+        // Returns false when the client should be closed
+        bool read(Client &client, std::vector<std::pair<ClientId, std::string>> &messages)
+        {
+            char buffer[READ_CHUNK];
+            while (true)
+            {
+                const ssize_t received = ::recv(client.fd, buffer, sizeof(buffer), 0);
+                if (received > 0)
+                {
+                    if (client.closing)
+                    {
+                        continue; // Discard input while the close is written
+                    }
+                    client.inbox.append(buffer, static_cast<size_t>(received));
+                    if (!client.upgraded)
+                    {
+                        handshake(client);
+                    }
+                    if (client.upgraded)
+                    {
+                        read_frames(client, messages);
+                    }
+                    continue;
+                }
+                if (received < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+                return received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+            }
+        }
+
+        void run()
+        {
+            auto next_flush = std::chrono::steady_clock::now() + std::chrono::milliseconds(options_.flush_interval_ms);
+            std::vector<pollfd> fds;
+            std::vector<ClientId> ids;
+
+            while (running_)
+            {
+                fds.clear();
+                ids.clear();
+                fds.push_back({listen_fd_, POLLIN, 0});
+                fds.push_back({wake_fds_[0], POLLIN, 0});
+                {
+                    std::lock_guard<std::mutex> lock(state_mutex_);
+                    for (const auto &[id, client] : clients_)
+                    {
+                        fds.push_back({client->fd, static_cast<short>(POLLIN | (client->queue.empty() ? 0 : POLLOUT)), 0});
+                        ids.push_back(id);
+                    }
+                }
+
+                const auto now = std::chrono::steady_clock::now();
+                const auto until_flush = std::chrono::duration_cast<std::chrono::milliseconds>(next_flush - now).count();
+                const int timeout = static_cast<int>(std::clamp<long long>(until_flush, 0, MAX_POLL_MS));
+                if (::poll(fds.data(), fds.size(), timeout) < 0 && errno != EINTR)
+                {
+                    utils::Logger::instance().log(utils::LogLevel::ERROR, "DashboardPush", std::string("poll failed: ") + std::strerror(errno));
+                    break;
+                }
+
+                if (fds[1].revents & POLLIN)
+                {
+                    uint8_t drain[64];
+                    while (::read(wake_fds_[0], drain, sizeof(drain)) > 0)
+                    {
+                    }
+                }
+                if (fds[0].revents & POLLIN)
+                {
+                    accept_clients();
+                }
+
+                std::vector<std::pair<ClientId, std::string>> messages;
+                std::vector<ClientId> closed;
+                {
+                    std::lock_guard<std::mutex> lock(state_mutex_);
+                    for (size_t i = 2; i < fds.size(); ++i)
+                    {
+                        auto it = clients_.find(ids[i - 2]);
+                        if (it == clients_.end())
+                        {
+                            continue;
+                        }
+                        Client &client = *it->second;
+                        bool keep = (fds[i].revents & (POLLERR | POLLNVAL)) == 0;
+                        if (keep && (fds[i].revents & (POLLIN | POLLHUP)))
+                        {
+                            keep = read(client, messages);
+                        }
+                        if (keep && (fds[i].revents & POLLOUT))
+                        {
+                            write(client);
+                        }
+                        if (!keep || (client.closing && client.queue.empty()))
+                        {
+                            closed.push_back(client.id);
+                            remove(client.id);
+                        }
+                    }
+                }
+
+                for (const auto &[id, text] : messages)
+                {
+                    if (on_message_)
+                    {
+                        on_message_(id, text);
+                    }
+                }
+                for (const auto id : closed)
+                {
+                    if (on_close_)
+                    {
+                        on_close_(id);
+                    }
+                }
+
+                if (std::chrono::steady_clock::now() >= next_flush)
+                {
+                    flush();
+                    next_flush = std::chrono::steady_clock::now() + std::chrono::milliseconds(options_.flush_interval_ms);
+                }
+            }
+        }
+
+        void flush()
+        {
+            decltype(pending_) batch;
+            {
+                std::lock_guard<std::mutex> lock(pending_mutex_);
+                batch.swap(pending_);
+            }
+            if (batch.empty())
+            {
+                return;
+            }
+
+            std::lock_guard<std::mutex> lock(state_mutex_);
+            for (auto &[channel, sources] : batch)
+            {
+                auto subscribers = subscribers_.find(channel);
+                if (subscribers == subscribers_.end())
+                {
+                    continue; // Nobody is looking
+                }
+
+                PushFrame frame;
+                frame.channel = channel;
+                frame.decimals = options_.value_decimals;
+                for (auto &[source_id, points] : sources)
+                {
+                    frame.series.push_back({source_id, std::move(points)});
+                }
+                std::vector<uint8_t> payload;
+                frame.encode(payload);
+                const Buffer buffer = websocket_frame(OPCODE_BINARY, payload.data(), payload.size());
+                frames_encoded_++;
+
+                for (const auto id : subscribers->second)
+                {
+                    auto client = clients_.find(id);
+                    if (client != clients_.end() && client->second->upgraded)
+                    {
+                        enqueue_update(*client->second, channel, buffer);
+                    }
+                }
+            }
+            wake(); // Partially written queues need POLLOUT
+        }
+    };
+
+    DashboardPushServer::DashboardPushServer() : DashboardPushServer(Options()) {}
+
+    DashboardPushServer::DashboardPushServer(const Options &options) : pimpl_(std::make_unique<Impl>(options)) {}
+
+    DashboardPushServer::~DashboardPushServer()
+    {
+        stop();
+    }
+
+    void DashboardPushServer::set_handlers(MessageHandler on_message, CloseHandler on_close)
+    {
+        pimpl_->on_message_ = std::move(on_message);
+        pimpl_->on_close_ = std::move(on_close);
+    }
+
+    void DashboardPushServer::add_http_route(const std::string &path, const std::string &content_type, HttpHandler handler)
+    {
+        pimpl_->http_routes_[path] = {content_type, std::move(handler)};
+    }
+
+    uint16_t DashboardPushServer::start(const std::string &address, uint16_t port)
+    {
+        if (pimpl_->running_)
+        {
+            return pimpl_->port_;
+        }
+
+        sockaddr_in bind_address{};
+        bind_address.sin_family = AF_INET;
+        bind_address.sin_port = htons(port);
+        if (address.empty() || address == "*")
+        {
+            bind_address.sin_addr.s_addr = htonl(INADDR_ANY);
+        }
+        else if (inet_pton(AF_INET, address.c_str(), &bind_address.sin_addr) != 1)
+        {
+            utils::Logger::instance().log(utils::LogLevel::ERROR, "DashboardPush", "Invalid listen address: " + address);
+            return 0;
+        }
+
+        const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0)
+        {
+            return 0;
+        }
+        int one = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+
+        socklen_t length = sizeof(bind_address);
+        if (::bind(fd, reinterpret_cast<sockaddr *>(&bind_address), sizeof(bind_address)) != 0 || ::listen(fd, 512) != 0 ||
+            !set_non_blocking(fd) || getsockname(fd, reinterpret_cast<sockaddr *>(&bind_address), &length) != 0 ||
+            ::pipe(pimpl_->wake_fds_) != 0)
+        {
+            utils::Logger::instance().log(utils::LogLevel::ERROR, "DashboardPush",
+                                          "Cannot listen on port " + std::to_string(port) + ": " + std::strerror(errno));
+            ::close(fd);
+            return 0;
+        }
+        set_non_blocking(pimpl_->wake_fds_[0]);
+        set_non_blocking(pimpl_->wake_fds_[1]);
+
+        pimpl_->listen_fd_ = fd;
+        pimpl_->port_ = ntohs(bind_address.sin_port);
+        pimpl_->running_ = true;
+        pimpl_->loop_ = std::thread([this]
+                                    { pimpl_->run(); });
+
+        utils::Logger::instance().log(utils::LogLevel::INFO, "DashboardPush",
+                                      "Serving WebSocket clients on port " + std::to_string(pimpl_->port_) + pimpl_->options_.path);
+        return pimpl_->port_;
+    }
+
+    void DashboardPushServer::stop()
+    {
+        if (!pimpl_->running_.exchange(false))
+        {
+            return;
+        }
+        pimpl_->wake();
+        if (pimpl_->loop_.joinable())
+        {
+            pimpl_->loop_.join();
+        }
+
+        std::vector<ClientId> closed;
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->state_mutex_);
+            for (const auto &[id, client] : pimpl_->clients_)
+            {
+                closed.push_back(id);
+            }
+            for (const auto id : closed)
+            {
+                pimpl_->remove(id);
+            }
+            pimpl_->subscribers_.clear();
+        }
+        for (const auto id : closed)
+        {
+            if (pimpl_->on_close_)
+            {
+                pimpl_->on_close_(id);
+            }
+        }
+
+        ::close(pimpl_->listen_fd_);
+        ::close(pimpl_->wake_fds_[0]);
+        ::close(pimpl_->wake_fds_[1]);
+        pimpl_->listen_fd_ = -1;
+        pimpl_->wake_fds_[0] = pimpl_->wake_fds_[1] = -1;
+        pimpl_->port_ = 0;
+
+        std::lock_guard<std::mutex> lock(pimpl_->pending_mutex_);
+        pimpl_->pending_.clear();
+    }
+
+    bool DashboardPushServer::is_running() const
+    {
+        return pimpl_->running_;
+    }
+
+    uint16_t DashboardPushServer::port() const
+    {
+        return pimpl_->port_;
+    }
+
+    void DashboardPushServer::publish(const std::string &channel, const std::string &source_id,
+                                      const std::vector<std::pair<uint64_t, double>> &points)
+    {
+        if (points.empty() || !pimpl_->running_)
+        {
+            return;
+        }
+        pimpl_->points_published_ += points.size();
+
+        std::lock_guard<std::mutex> lock(pimpl_->pending_mutex_);
+        auto &pending = pimpl_->pending_[channel][source_id];
+        pending.insert(pending.end(), points.begin(), points.end());
+        if (pending.size() > pimpl_->options_.max_pending_points)
+        {
+            const size_t excess = pending.size() - pimpl_->options_.max_pending_points;
+            pending.erase(pending.begin(), pending.begin() + static_cast<std::ptrdiff_t>(excess));
+            pimpl_->points_dropped_ += excess;
+        }
+    }
+
+    uint32_t DashboardPushServer::broadcast_text(const std::string &message, const std::string &channel)
+    {
+        const Buffer buffer = text_frame(message);
+        uint32_t queued = 0;
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->state_mutex_);
+            if (channel.empty())
+            {
+                for (auto &[id, client] : pimpl_->clients_)
+                {
+                    queued += client->upgraded && pimpl_->enqueue(*client, buffer) ? 1 : 0;
+                }
+            }
+            else if (auto subscribers = pimpl_->subscribers_.find(channel); subscribers != pimpl_->subscribers_.end())
+            {
+                for (const auto id : subscribers->second)
+                {
+                    auto client = pimpl_->clients_.find(id);
+                    queued += client != pimpl_->clients_.end() && pimpl_->enqueue(*client->second, buffer) ? 1 : 0;
+                }
+            }
+        }
+        pimpl_->wake();
+        return queued;
+    }
+
+    bool DashboardPushServer::send_text(ClientId client, const std::string &message)
+    {
+        bool queued = false;
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->state_mutex_);
+            auto it = pimpl_->clients_.find(client);
+            queued = it != pimpl_->clients_.end() && it->second->upgraded && pimpl_->enqueue(*it->second, text_frame(message));
+        }
+        pimpl_->wake();
+        return queued;
+    }
+
+    void DashboardPushServer::flush()
+    {
+        pimpl_->flush();
+    }
+
+    size_t DashboardPushServer::client_count() const
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->state_mutex_);
+        return pimpl_->clients_.size();
+    }
+
+    size_t DashboardPushServer::subscriber_count(const std::string &channel) const
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->state_mutex_);
+        auto it = pimpl_->subscribers_.find(channel);
+        return it != pimpl_->subscribers_.end() ? it->second.size() : 0;
+    }
+
+    DashboardPushServer::Statistics DashboardPushServer::get_statistics() const
+    {
+        Statistics stats;
+        stats.clients_connected = client_count();
+        stats.clients_accepted = pimpl_->clients_accepted_;
+        stats.clients_rejected = pimpl_->clients_rejected_;
+        stats.frames_encoded = pimpl_->frames_encoded_;
+        stats.frames_queued = pimpl_->frames_queued_;
+        stats.frames_dropped = pimpl_->frames_dropped_;
+        stats.points_published = pimpl_->points_published_;
+        stats.points_dropped = pimpl_->points_dropped_;
+        stats.bytes_sent = pimpl_->bytes_sent_;
+        return stats;
+    }
+
+} // namespace cardano_iot::monitoring
@@ -0,0 +1,1804 @@
+/**
+ * @file realtime_dashboard.cpp
+ * @brief Implementation of the real-time monitoring dashboard
+ *
+ * @author Cardano IoT SDK Team
+ * @version 1.0.0
+ */
+
+#include "cardano_iot/monitoring/realtime_dashboard.h"
+#include "cardano_iot/monitoring/dashboard_push.h"
+#include "cardano_iot/monitoring/rollup_series.h"
+#include "cardano_iot/utils/codec.h"
+#include "cardano_iot/utils/hash.h"
+#include "cardano_iot/utils/logger.h"
+#include "cardano_iot/utils/metrics.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <sstream>
+#include <unordered_map>
+
+namespace cardano_iot::monitoring
+{
+
+    namespace
+    {
+        using json = nlohmann::json;
+
+        uint64_t now_seconds()
+        {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::seconds>(
+                                             std::chrono::system_clock::now().time_since_epoch())
+                                             .count());
+        }
+
+        std::string format_number(double value)
+        {
+            std::ostringstream out;
+            out << std::setprecision(10) << value;
+            return out.str();
+        }
+
+        std::string random_hex(size_t bytes)
+        {
+            thread_local std::mt19937_64 rng{std::random_device{}()};
+            std::vector<uint8_t> data(bytes);
+            for (auto &byte : data)
+            {
+                byte = static_cast<uint8_t>(rng());
+            }
+            return utils::codec::hex_encode(data);
+        }
+
+        bool parse_number(const std::string &text, double &out)
+        {
+            char *end = nullptr;
+            const double value = std::strtod(text.c_str(), &end);
+            if (text.empty() || end != text.c_str() + text.size() || !std::isfinite(value))
+            {
+                return false;
+            }
+            out = value;
+            return true;
+        }
+
+        // Alert condition: "<op> <number>", optionally prefixed with "value"
+        struct Condition
+        {
+            enum class Op
+            {
+                GREATER,
+                GREATER_EQUAL,
+                LESS,
+                LESS_EQUAL,
+                EQUAL,
+                NOT_EQUAL
+            };
+
+            Op op = Op::GREATER;
+            double threshold = 0.0;
+
+            bool holds(double value) const
+            {
+                switch (op)
+                {
+                case Op::GREATER:
+                    return value > threshold;
+                case Op::GREATER_EQUAL:
+                    return value >= threshold;
+                case Op::LESS:
+                    return value < threshold;
+                case Op::LESS_EQUAL:
+                    return value <= threshold;
+                case Op::EQUAL:
+                    return value == threshold;
+                case Op::NOT_EQUAL:
+                    return value != threshold;
+                default:
+                    return false;
+                }
+            }
+        };
+
+        bool parse_condition(std::string text, Condition &out)
+        {
+            text.erase(std::remove(text.begin(), text.end(), ' '), text.end());
+            if (text.rfind("value", 0) == 0)
+            {
+                text.erase(0, 5);
+            }
+
+            static const std::pair<const char *, Condition::Op> operators[] = {
+                {">=", Condition::Op::GREATER_EQUAL}, {"<=", Condition::Op::LESS_EQUAL}, {"==", Condition::Op::EQUAL}, {"!=", Condition::Op::NOT_EQUAL}, {">", Condition::Op::GREATER}, {"<", Condition::Op::LESS}};
+            for (const auto &[symbol, op] : operators)
+            {
+                const size_t length = std::char_traits<char>::length(symbol);
+                if (text.compare(0, length, symbol) == 0)
+                {
+                    out.op = op;
+                    return parse_number(text.substr(length), out.threshold);
+                }
+            }
+            return false;
+        }
+
+        std::string replace_all(std::string text, const std::string &from, const std::string &to)
+        {
+            for (size_t pos = text.find(from); pos != std::string::npos; pos = text.find(from, pos + to.size()))
+            {
+                text.replace(pos, from.size(), to);
+            }
+            return text;
+        }
+
+        json widget_to_json(const WidgetConfig &widget)
+        {
+            json thresholds = json::array();
+            for (const auto &[value, severity] : widget.alert_thresholds)
+            {
+                thresholds.push_back({{"value", value}, {"severity", static_cast<int>(severity)}});
+            }
+            return {{"widget_id", widget.widget_id},
+                    {"title", widget.title},
+                    {"type", static_cast<int>(widget.type)},
+                    {"width", widget.width},
+                    {"height", widget.height},
+                    {"x_position", widget.x_position},
+                    {"y_position", widget.y_position},
+                    {"data_sources", widget.data_sources},
+                    {"aggregation_func", widget.aggregation_func},
+                    {"time_range_minutes", widget.time_range_minutes},
+                    {"refresh_interval_ms", widget.refresh_interval_ms},
+                    {"chart_options", widget.chart_options},
+                    {"colors", widget.colors},
+                    {"min_value", widget.min_value},
+                    {"max_value", widget.max_value},
+                    {"unit", widget.unit},
+                    {"is_interactive", widget.is_interactive},
+                    {"show_legend", widget.show_legend},
+                    {"show_tooltip", widget.show_tooltip},
+                    {"enable_zoom", widget.enable_zoom},
+                    {"enable_export", widget.enable_export},
+                    {"alert_thresholds", thresholds},
+                    {"alert_message_template", widget.alert_message_template}};
+        }
+
+        WidgetConfig widget_from_json(const json &value)
+        {
+            WidgetConfig widget{};
+            widget.widget_id = value.value("widget_id", "");
+            widget.title = value.value("title", "");
+            widget.type = static_cast<WidgetType>(value.value("type", 0));
+            widget.width = value.value("width", 1u);
+            widget.height = value.value("height", 1u);
+            widget.x_position = value.value("x_position", 0u);
+            widget.y_position = value.value("y_position", 0u);
+            widget.data_sources = value.value("data_sources", std::vector<std::string>());
+            widget.aggregation_func = value.value("aggregation_func", "");
+            widget.time_range_minutes = value.value("time_range_minutes", 0u);
+            widget.refresh_interval_ms = value.value("refresh_interval_ms", 0u);
+            widget.chart_options = value.value("chart_options", std::map<std::string, std::string>());
+            widget.colors = value.value("colors", std::vector<std::string>());
+            widget.min_value = value.value("min_value", 0.0);
+            widget.max_value = value.value("max_value", 0.0);
+            widget.unit = value.value("unit", "");
+            widget.is_interactive = value.value("is_interactive", false);
+            widget.show_legend = value.value("show_legend", false);
+            widget.show_tooltip = value.value("show_tooltip", false);
+            widget.enable_zoom = value.value("enable_zoom", false);
+            widget.enable_export = value.value("enable_export", false);
+            if (value.contains("alert_thresholds") && value["alert_thresholds"].is_array())
+            {
+                for (const auto &threshold : value["alert_thresholds"])
+                {
+                    widget.alert_thresholds.emplace_back(threshold.value("value", 0.0),
+                                                         static_cast<AlertSeverity>(threshold.value("severity", 0)));
+                }
+            }
+            widget.alert_message_template = value.value("alert_message_template", "");
+            return widget;
+        }
+
+        json layout_to_json(const DashboardLayout &layout)
+        {
+            json widgets = json::array();
+            for (const auto &widget : layout.widgets)
+            {
+                widgets.push_back(widget_to_json(widget));
+            }
+            return {{"layout_id", layout.layout_id},
+                    {"name", layout.name},
+                    {"description", layout.description},
+                    {"theme", static_cast<int>(layout.theme)},
+                    {"grid_columns", layout.grid_columns},
+                    {"grid_rows", layout.grid_rows},
+                    {"widgets", widgets},
+                    {"custom_css", layout.custom_css},
+                    {"custom_js", layout.custom_js}};
+        }
+
+        bool layout_from_json(const json &value, DashboardLayout &layout)
+        {
+            if (!value.is_object() || !value.contains("layout_id") || !value["layout_id"].is_string())
+            {
+                return false;
+            }
+            layout.layout_id = value["layout_id"].get<std::string>();
+            layout.name = value.value("name", "");
+            layout.description = value.value("description", "");
+            layout.theme = static_cast<DashboardTheme>(value.value("theme", 0));
+            layout.grid_columns = value.value("grid_columns", 12u);
+            layout.grid_rows = value.value("grid_rows", 12u);
+            layout.widgets.clear();
+            if (value.contains("widgets") && value["widgets"].is_array())
+            {
+                for (const auto &widget : value["widgets"])
+                {
+                    layout.widgets.push_back(widget_from_json(widget));
+                }
+            }
+            layout.custom_css = value.value("custom_css", std::map<std::string, std::string>());
+            layout.custom_js = value.value("custom_js", std::map<std::string, std::string>());
+            return true;
+        }
+    } // namespace
+
+    class RealtimeDashboard::Impl
+    {
+    public:
+        struct Source
+        {
+            explicit Source(const RollupSeries::Retention &retention) : series(retention) {}
+
+            std::string name;
+            std::string type;
+            mutable std::mutex mutex;
+            RollupSeries series;
+            std::string unit;      // From the latest point
+            std::string device_id; // The latest point's "device_id" tag
+            uint64_t points = 0;
+        };
+
+        struct AlertRule
+        {
+            std::string source_id;
+            std::string condition_text;
+            Condition condition;
+            AlertSeverity severity = AlertSeverity::INFO;
+            std::string message_template;
+            std::string active_alert; // Unacknowledged alert raised by this rule
+        };
+
+        bool initialized_ = false;
+
+        mutable std::shared_mutex config_mutex_;
+        std::map<std::string, std::string> config_;
+        RollupSeries::Retention retention_;
+        uint64_t session_timeout_seconds_ = 3600;
+
+        // Sources; the map is read-mostly, each source has its own lock
+        mutable std::shared_mutex sources_mutex_;
+        std::unordered_map<std::string, std::shared_ptr<Source>> sources_;
+
+        mutable std::mutex layouts_mutex_;
+        std::map<std::string, DashboardLayout> layouts_;
+        std::map<std::string, std::map<std::string, std::string>> themes_;
+        std::unordered_map<std::string, std::vector<std::string>> widgets_by_source_; // Push channels per source
+
+        mutable std::mutex alerts_mutex_;
+        std::map<std::string, AlertRule> rules_;
+        std::unordered_map<std::string, std::vector<std::string>> rules_by_source_;
+        std::map<std::string, DashboardAlert> alerts_;
+
+        mutable std::mutex sessions_mutex_;
+        std::map<std::string, UserSession> sessions_;
+
+        // Server-side settings
+        mutable std::mutex server_mutex_;
+        bool rest_api_enabled_ = false;
+        std::string api_prefix_ = "/api/v1";
+        std::map<std::string, std::function<std::string(const std::map<std::string, std::string> &)>> endpoints_;
+        std::string api_auth_type_ = "none";
+        std::map<std::string, std::string> api_auth_config_;
+        bool websocket_enabled_ = true;
+        std::string websocket_path_ = "/ws";
+        std::shared_ptr<DashboardPushServer> push_server_;
+        std::map<std::string, DashboardPushServer::ClientId> session_clients_;
+
+        mutable std::mutex callbacks_mutex_;
+        DataUpdateCallback data_callback_;
+        AlertCallback alert_callback_;
+        UserEventCallback user_callback_;
+
+        std::atomic<uint64_t> points_pushed_{0};
+        std::atomic<uint64_t> points_rejected_{0};
+        std::atomic<uint64_t> alerts_triggered_{0};
+
+        // Caller holds config_mutex_
+        bool apply_config(const std::map<std::string, std::string> &config)
+        {
+            RollupSeries::Retention retention = retention_;
+            uint64_t session_timeout = session_timeout_seconds_;
+            const std::pair<const char *, uint64_t *> keys[] = {
+                {"raw_retention_seconds", &retention.raw_seconds},
+                {"second_retention_seconds", &retention.second_seconds},
+                {"minute_retention_seconds", &retention.minute_seconds},
+                {"hour_retention_seconds", &retention.hour_seconds},
+                {"session_timeout_seconds", &session_timeout}};
+
+            for (const auto &[key, target] : keys)
+            {
+                auto it = config.find(key);
+                if (it == config.end())
+                {
+                    continue;
+                }
+                double value = 0.0;
+                if (!parse_number(it->second, value) || value < 0)
+                {
+                    utils::Logger::instance().log(utils::LogLevel::WARNING, "RealtimeDashboard",
+                                                  std::string("Invalid value for ") + key + ": " + it->second);
+                    return false;
+                }
+                *target = static_cast<uint64_t>(value);
+            }
+
+            for (const auto &[key, value] : config)
+            {
+                config_[key] = value;
+            }
+            retention_ = retention;
+            session_timeout_seconds_ = session_timeout;
+            return true;
+        }
+
+        // Caller holds layouts_mutex_
+        void reindex_widgets()
+        {
+            widgets_by_source_.clear();
+            for (const auto &[layout_id, layout] : layouts_)
+            {
+                for (const auto &widget : layout.widgets)
+                {
+                    for (const auto &source_id : widget.data_sources)
+                    {
+                        auto &widgets = widgets_by_source_[source_id];
+                        if (std::find(widgets.begin(), widgets.end(), widget.widget_id) == widgets.end())
+                        {
+                            widgets.push_back(widget.widget_id);
+                        }
+                    }
+                }
+            }
+        }
+
+        std::shared_ptr<DashboardPushServer> push_server() const
+        {
+            std::lock_guard<std::mutex> lock(server_mutex_);
+            return push_server_;
+        }
+
+        /**
+         * @brief Hand accepted points to the push server, once per widget showing the source
+         */
+        void publish(const std::string &source_id, const DataPoint *points, size_t count, uint64_t now)
+        {
+            auto server = push_server();
+            if (!server)
+            {
+                return;
+            }
+
+            std::vector<std::string> widgets;
+            {
+                std::lock_guard<std::mutex> lock(layouts_mutex_);
+                auto it = widgets_by_source_.find(source_id);
+                if (it == widgets_by_source_.end())
+                {
+                    return;
+                }
+                widgets = it->second;
+            }
+
+            std::vector<std::pair<uint64_t, double>> values;
+            values.reserve(count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (std::isfinite(points[i].value))
+                {
+                    values.emplace_back(points[i].timestamp != 0 ? points[i].timestamp : now, points[i].value);
+                }
+            }
+            for (const auto &widget_id : widgets)
+            {
+                server->publish(widget_id, source_id, values);
+            }
+        }
+
+        // Runs on the push server's event loop: "session <id>" binds a client to a dashboard session
+        void client_message(DashboardPushServer::ClientId client, const std::string &message);
+
+        std::shared_ptr<Source> source(const std::string &source_id) const
+        {
+            std::shared_lock<std::shared_mutex> lock(sources_mutex_);
+            auto it = sources_.find(source_id);
+            return it != sources_.end() ? it->second : nullptr;
+        }
+
+        /**
+         * @brief Fold points into a source's rollups under one lock, then run alerts and callbacks
+         */
+        uint32_t push(const std::string &source_id, const DataPoint *points, size_t count)
+        {
+            auto target = source(source_id);
+            if (!initialized_ || !target)
+            {
+                points_rejected_ += count;
+                return 0;
+            }
+
+            const uint64_t now = now_seconds();
+            uint32_t accepted = 0;
+            {
+                std::lock_guard<std::mutex> lock(target->mutex);
+                for (size_t i = 0; i < count; ++i)
+                {
+                    const DataPoint &point = points[i];
+                    if (!std::isfinite(point.value))
+                    {
+                        continue;
+                    }
+                    target->series.add(point.timestamp != 0 ? point.timestamp : now, point.value);
+                    accepted++;
+                }
+                if (count > 0)
+                {
+                    const DataPoint &last = points[count - 1];
+                    if (!last.unit.empty())
+                    {
+                        target->unit = last.unit;
+                    }
+                    auto device = last.tags.find("device_id");
+                    if (device != last.tags.end())
+                    {
+                        target->device_id = device->second;
+                    }
+                }
+                target->points += accepted;
+            }
+
+            points_pushed_ += accepted;
+            points_rejected_ += count - accepted;
+
+            publish(source_id, points, count, now);
+
+            evaluate_rules(source_id, points, count);
+
+            DataUpdateCallback callback;
+            {
+                std::lock_guard<std::mutex> lock(callbacks_mutex_);
+                callback = data_callback_;
+            }
+            if (callback)
+            {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    if (std::isfinite(points[i].value))
+                    {
+                        callback(source_id, points[i]);
+                    }
+                }
+            }
+            return accepted;
+        }
+
+        void evaluate_rules(const std::string &source_id, const DataPoint *points, size_t count)
+        {
+            std::vector<DashboardAlert> raised;
+            {
+                std::lock_guard<std::mutex> lock(alerts_mutex_);
+                auto rules = rules_by_source_.find(source_id);
+                if (rules == rules_by_source_.end())
+                {
+                    return;
+                }
+
+                for (const auto &rule_id : rules->second)
+                {
+                    AlertRule &rule = rules_.at(rule_id);
+                    if (!rule.active_alert.empty())
+                    {
+                        continue; // Still waiting for acknowledgement
+                    }
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        const DataPoint &point = points[i];
+                        if (!std::isfinite(point.value) || !rule.condition.holds(point.value))
+                        {
+                            continue;
+                        }
+
+                        DashboardAlert alert{};
+                        alert.alert_id = "alert_" + random_hex(8);
+                        alert.title = rule_id;
+                        alert.severity = rule.severity;
+                        alert.metric_name = source_id;
+                        auto device = point.tags.find("device_id");
+                        alert.device_id = device != point.tags.end() ? device->second : "";
+                        alert.current_value = point.value;
+                        alert.threshold_value = rule.condition.threshold;
+                        alert.triggered_time = now_seconds();
+                        alert.message = replace_all(replace_all(replace_all(rule.message_template, "{value}", format_number(point.value)),
+                                                                "{threshold}", format_number(rule.condition.threshold)),
+                                                    "{source}", source_id);
+                        alert.metadata["rule_id"] = rule_id;
+                        alert.metadata["condition"] = rule.condition_text;
+
+                        rule.active_alert = alert.alert_id;
+                        alerts_[alert.alert_id] = alert;
+                        raised.push_back(std::move(alert));
+                        break;
+                    }
+                }
+            }
+
+            if (raised.empty())
+            {
+                return;
+            }
+            alerts_triggered_ += raised.size();
+
+            AlertCallback callback;
+            {
+                std::lock_guard<std::mutex> lock(callbacks_mutex_);
+                callback = alert_callback_;
+            }
+            for (const auto &alert : raised)
+            {
+                utils::Logger::instance().log(utils::LogLevel::WARNING, "RealtimeDashboard",
+                                              "Alert " + alert.title + ": " + alert.message);
+                if (callback)
+                {
+                    callback(alert);
+                }
+            }
+        }
+
+        void user_event(const std::string &user_id, const std::string &event)
+        {
+            UserEventCallback callback;
+            {
+                std::lock_guard<std::mutex> lock(callbacks_mutex_);
+                callback = user_callback_;
+            }
+            if (callback)
+            {
+                callback(user_id, event);
+            }
+        }
+
+        std::unique_ptr<UserSession> open_session(const std::string &user_id, const std::vector<std::string> &permissions,
+                                                  const std::string &ip_address, const std::string &user_agent)
+        {
+            auto session = std::make_unique<UserSession>();
+            session->session_id = "session_" + random_hex(16);
+            session->user_id = user_id;
+            session->username = user_id;
+            session->permissions = permissions;
+            session->login_time = now_seconds();
+            session->last_activity = session->login_time;
+            session->ip_address = ip_address;
+            session->user_agent = user_agent;
+            session->is_authenticated = true;
+
+            {
+                std::lock_guard<std::mutex> lock(sessions_mutex_);
+                sessions_[session->session_id] = *session;
+            }
+            user_event(user_id, "session_started");
+            return session;
+        }
+    };
+
+    RealtimeDashboard::RealtimeDashboard() : pimpl_(std::make_unique<Impl>()) {}
+
+    RealtimeDashboard::~RealtimeDashboard()
+    {
+        stop_server();
+    }
+
+    bool RealtimeDashboard::initialize(const std::map<std::string, std::string> &config)
+    {
+        {
+            std::unique_lock<std::shared_mutex> lock(pimpl_->config_mutex_);
+            if (pimpl_->initialized_)
+            {
+                return true;
+            }
+            if (!pimpl_->apply_config(config))
+            {
+                return false;
+            }
+            pimpl_->initialized_ = true;
+        }
+
+        utils::Logger::instance().log(utils::LogLevel::INFO, "RealtimeDashboard", "Dashboard initialized");
+        return true;
+    }
+
+    bool RealtimeDashboard::start_server(uint16_t port, const std::string &interface)
+    {
+        DashboardPushServer::Options options;
+        {
+            std::shared_lock<std::shared_mutex> lock(pimpl_->config_mutex_);
+            if (!pimpl_->initialized_)
+            {
+                return false;
+            }
+            const std::pair<const char *, size_t *> keys[] = {
+                {"websocket_max_clients", &options.max_clients},
+                {"websocket_max_queued_bytes", &options.max_queued_bytes},
+                {"websocket_max_pending_points", &options.max_pending_points}};
+            for (const auto &[key, target] : keys)
+            {
+                auto it = pimpl_->config_.find(key);
+                double value = 0.0;
+                if (it != pimpl_->config_.end() && parse_number(it->second, value) && value > 0)
+                {
+                    *target = static_cast<size_t>(value);
+                }
+            }
+            auto flush = pimpl_->config_.find("websocket_flush_interval_ms");
+            double value = 0.0;
+            if (flush != pimpl_->config_.end() && parse_number(flush->second, value) && value > 0)
+            {
+                options.flush_interval_ms = static_cast<uint32_t>(value);
+            }
+        }
+
+        std::shared_ptr<DashboardPushServer> server;
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->server_mutex_);
+            if (pimpl_->push_server_)
+            {
+                return true;
+            }
+            if (!pimpl_->websocket_enabled_)
+            {
+                utils::Logger::instance().log(utils::LogLevel::WARNING, "RealtimeDashboard",
+                                              "WebSocket is disabled; nothing to serve");
+                return false;
+            }
+            options.path = pimpl_->websocket_path_;
+        }
+
+        server = std::make_shared<DashboardPushServer>(options);
+        Impl *impl = pimpl_.get();
+        server->set_handlers([impl](DashboardPushServer::ClientId client, const std::string &message)
+                             { impl->client_message(client, message); },
+                             [impl](DashboardPushServer::ClientId client)
+                             {
+                                 std::lock_guard<std::mutex> lock(impl->server_mutex_);
+                                 for (auto it = impl->session_clients_.begin(); it != impl->session_clients_.end();)
+                                 {
+                                     it = it->second == client ? impl->session_clients_.erase(it) : std::next(it);
+                                 }
+                             });
+        server->add_http_route("/metrics", "text/plain; version=0.0.4; charset=utf-8",
+                               []
+                               { return utils::metrics::Registry::instance().to_prometheus(); });
+        if (server->start(interface, port) == 0)
+        {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(pimpl_->server_mutex_);
+        pimpl_->push_server_ = std::move(server);
+        return true;
+    }
+
+    void RealtimeDashboard::stop_server()
+    {
+        std::shared_ptr<DashboardPushServer> server;
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->server_mutex_);
+            server.swap(pimpl_->push_server_);
+        }
+        if (server)
+        {
+            // The close handler takes server_mutex_, so stop outside it
+            server->stop();
+            std::lock_guard<std::mutex> lock(pimpl_->server_mutex_);
+            pimpl_->session_clients_.clear();
+        }
+    }
+
+    void RealtimeDashboard::Impl::client_message(DashboardPushServer::ClientId client, const std::string &message)
+    {
+        auto server = push_server();
+        if (!server || message.rfind("session ", 0) != 0)
+        {
+            return;
+        }
+
+        const std::string session_id = message.substr(8);
+        uint64_t timeout;
+        {
+            std::shared_lock<std::shared_mutex> lock(config_mutex_);
+            timeout = session_timeout_seconds_;
+        }
+
+        bool valid = false;
+        {
+            std::lock_guard<std::mutex> lock(sessions_mutex_);
+            auto it = sessions_.find(session_id);
+            const uint64_t now = now_seconds();
+            if (it != sessions_.end() && (timeout == 0 || now <= it->second.last_activity + timeout))
+            {
+                it->second.last_activity = now;
+                valid = true;
+            }
+        }
+
+        if (valid)
+        {
+            std::lock_guard<std::mutex> lock(server_mutex_);
+            session_clients_[session_id] = client;
+        }
+        server->send_text(client, valid ? "session ok" : "session denied");
+    }
+
+    void RealtimeDashboard::shutdown()
+    {
+        stop_server();
+        {
+            std::unique_lock<std::shared_mutex> lock(pimpl_->config_mutex_);
+            if (!pimpl_->initialized_)
+            {
+                return;
+            }
+            pimpl_->initialized_ = false;
+        }
+        {
+            std::unique_lock<std::shared_mutex> lock(pimpl_->sources_mutex_);
+            pimpl_->sources_.clear();
+        }
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->sessions_mutex_);
+            pimpl_->sessions_.clear();
+        }
+        utils::Logger::instance().log(utils::LogLevel::INFO, "RealtimeDashboard", "Dashboard shut down");
+    }
+
+    bool RealtimeDashboard::add_data_source(const std::string &source_id,
+                                            const std::string &source_name,
+                                            const std::string &source_type)
+    {
+        if (source_id.empty())
+        {
+            return false;
+        }
+
+        RollupSeries::Retention retention;
+        {
+            std::shared_lock<std::shared_mutex> lock(pimpl_->config_mutex_);
+            retention = pimpl_->retention_;
+        }
+
+        auto source = std::make_shared<Impl::Source>(retention);
+        source->name = source_name;
+        source->type = source_type;
+
+        std::unique_lock<std::shared_mutex> lock(pimpl_->sources_mutex_);
+        return pimpl_->sources_.emplace(source_id, std::move(source)).second;
+    }
+
+    bool RealtimeDashboard::remove_data_source(const std::string &source_id)
+    {
+        std::unique_lock<std::shared_mutex> lock(pimpl_->sources_mutex_);
+        return pimpl_->sources_.erase(source_id) > 0;
+    }
+
+    bool RealtimeDashboard::push_data(const std::string &source_id, const DataPoint &data_point)
+    {
+        return pimpl_->push(source_id, &data_point, 1) == 1;
+    }
+
+    uint32_t RealtimeDashboard::push_data_batch(const std::string &source_id,
+                                                const std::vector<DataPoint> &data_points)
+    {
+        return pimpl_->push(source_id, data_points.data(), data_points.size());
+    }
+
+    TimeSeries RealtimeDashboard::get_time_series(const std::string &source_id,
+                                                  uint64_t start_time,
+                                                  uint64_t end_time,
+                                                  uint32_t max_points) const
+    {
+        TimeSeries series;
+        series.visible = true;
+        series.line_style = "solid";
+
+        auto source = pimpl_->source(source_id);
+        if (!source)
+        {
+            return series;
+        }
+
+        std::vector<RollupSeries::Bucket> buckets;
+        RollupSeries::Resolution resolution = RollupSeries::Resolution::RAW;
+        std::string unit;
+        {
+            std::lock_guard<std::mutex> lock(source->mutex);
+            buckets = source->series.query(start_time, end_time, max_points, &resolution);
+            series.metric_name = source->name;
+            series.device_id = source->device_id;
+            unit = source->unit;
+        }
+
+        const bool raw = resolution == RollupSeries::Resolution::RAW;
+        series.data_points.reserve(buckets.size());
+        for (const auto &bucket : buckets)
+        {
+            DataPoint point;
+            point.timestamp = bucket.start;
+            point.value = bucket.average();
+            point.unit = unit;
+            if (!raw || bucket.count > 1)
+            {
+                point.tags["resolution"] = resolution_to_string(resolution);
+                point.tags["min"] = format_number(bucket.min);
+                point.tags["max"] = format_number(bucket.max);
+                point.tags["count"] = std::to_string(bucket.count);
+            }
+            series.data_points.push_back(std::move(point));
+        }
+        return series;
+    }
+
+    bool RealtimeDashboard::create_widget(const std::string &layout_id, const WidgetConfig &widget_config)
+    {
+        if (!validate_widget_config(widget_config))
+        {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(pimpl_->layouts_mutex_);
+        auto layout = pimpl_->layouts_.find(layout_id);
+        if (layout == pimpl_->layouts_.end())
+        {
+            return false;
+        }
+        auto &widgets = layout->second.widgets;
+        if (std::any_of(widgets.begin(), widgets.end(), [&](const WidgetConfig &widget)
+                        { return widget.widget_id == widget_config.widget_id; }))
+        {
+            return false;
+        }
+        widgets.push_back(widget_config);
+        pimpl_->reindex_widgets();
+        return true;
+    }
+
+    bool RealtimeDashboard::update_widget(const std::string &layout_id,
+                                          const std::string &widget_id,
+                                          const WidgetConfig &widget_config)
+    {
+        if (!validate_widget_config(widget_config))
+        {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(pimpl_->layouts_mutex_);
+        auto layout = pimpl_->layouts_.find(layout_id);
+        if (layout == pimpl_->layouts_.end())
+        {
+            return false;
+        }
+        for (auto &widget : layout->second.widgets)
+        {
+            if (widget.widget_id == widget_id)
+            {
+                widget = widget_config;
+                pimpl_->reindex_widgets();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool RealtimeDashboard::delete_widget(const std::string &layout_id, const std::string &widget_id)
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->layouts_mutex_);
+        auto layout = pimpl_->layouts_.find(layout_id);
+        if (layout == pimpl_->layouts_.end())
+        {
+            return false;
+        }
+        auto &widgets = layout->second.widgets;
+        const auto before = widgets.size();
+        widgets.erase(std::remove_if(widgets.begin(), widgets.end(), [&](const WidgetConfig &widget)
+                                     { return widget.widget_id == widget_id; }),
+                      widgets.end());
+        pimpl_->reindex_widgets();
+        return widgets.size() != before;
+    }
+
+    WidgetConfig RealtimeDashboard::get_widget_config(const std::string &layout_id,
+                                                      const std::string &widget_id) const
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->layouts_mutex_);
+        auto layout = pimpl_->layouts_.find(layout_id);
+        if (layout != pimpl_->layouts_.end())
+        {
+            for (const auto &widget : layout->second.widgets)
+            {
+                if (widget.widget_id == widget_id)
+                {
+                    return widget;
+                }
+            }
+        }
+        return WidgetConfig{};
+    }
+
+    bool RealtimeDashboard::create_layout(const DashboardLayout &layout)
+    {
+        if (layout.layout_id.empty() ||
+            !std::all_of(layout.widgets.begin(), layout.widgets.end(), validate_widget_config))
+        {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(pimpl_->layouts_mutex_);
+        if (!pimpl_->layouts_.emplace(layout.layout_id, layout).second)
+        {
+            return false;
+        }
+        pimpl_->reindex_widgets();
+        return true;
+    }
+
+    bool RealtimeDashboard::update_layout(const std::string &layout_id, const DashboardLayout &layout)
+    {
+        if (!std::all_of(layout.widgets.begin(), layout.widgets.end(), validate_widget_config))
+        {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(pimpl_->layouts_mutex_);
+        auto it = pimpl_->layouts_.find(layout_id);
+        if (it == pimpl_->layouts_.end())
+        {
+            return false;
+        }
+        it->second = layout;
+        it->second.layout_id = layout_id;
+        pimpl_->reindex_widgets();
+        return true;
+    }
+
+    bool RealtimeDashboard::delete_layout(const std::string &layout_id)
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->layouts_mutex_);
+        if (pimpl_->layouts_.erase(layout_id) == 0)
+        {
+            return false;
+        }
+        pimpl_->reindex_widgets();
+        return true;
+    }
+
+    DashboardLayout RealtimeDashboard::get_layout(const std::string &layout_id) const
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->layouts_mutex_);
+        auto it = pimpl_->layouts_.find(layout_id);
+        return it != pimpl_->layouts_.end() ? it->second : DashboardLayout{};
+    }
+
+    std::vector<std::string> RealtimeDashboard::list_layouts() const
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->layouts_mutex_);
+        std::vector<std::string> ids;
+        for (const auto &[layout_id, layout] : pimpl_->layouts_)
+        {
+            ids.push_back(layout_id);
+        }
+        return ids;
+    }
+
+    bool RealtimeDashboard::clone_layout(const std::string &source_layout_id,
+                                         const std::string &new_layout_id,
+                                         const std::string &new_name)
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->layouts_mutex_);
+        auto it = pimpl_->layouts_.find(source_layout_id);
+        if (it == pimpl_->layouts_.end() || new_layout_id.empty() || pimpl_->layouts_.count(new_layout_id))
+        {
+            return false;
+        }
+        DashboardLayout copy = it->second;
+        copy.layout_id = new_layout_id;
+        copy.name = new_name;
+        pimpl_->layouts_.emplace(new_layout_id, std::move(copy));
+        pimpl_->reindex_widgets();
+        return true;
+    }
+
+    bool RealtimeDashboard::create_alert_rule(const std::string &rule_id,
+                                              const std::string &source_id,
+                                              const std::string &condition,
+                                              AlertSeverity severity,
+                                              const std::string &message_template)
+    {
+        Impl::AlertRule rule;
+        if (rule_id.empty() || !parse_condition(condition, rule.condition))
+        {
+            return false;
+        }
+        rule.source_id = source_id;
+        rule.condition_text = condition;
+        rule.severity = severity;
+        rule.message_template = message_template;
+
+        std::lock_guard<std::mutex> lock(pimpl_->alerts_mutex_);
+        if (!pimpl_->rules_.emplace(rule_id, std::move(rule)).second)
+        {
+            return false;
+        }
+        pimpl_->rules_by_source_[source_id].push_back(rule_id);
+        return true;
+    }
+
+    bool RealtimeDashboard::update_alert_rule(const std::string &rule_id,
+                                              const std::string &condition,
+                                              AlertSeverity severity,
+                                              const std::string &message_template)
+    {
+        Condition parsed;
+        if (!parse_condition(condition, parsed))
+        {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(pimpl_->alerts_mutex_);
+        auto it = pimpl_->rules_.find(rule_id);
+        if (it == pimpl_->rules_.end())
+        {
+            return false;
+        }
+        it->second.condition = parsed;
+        it->second.condition_text = condition;
+        it->second.severity = severity;
+        it->second.message_template = message_template;
+        return true;
+    }
+
+    bool RealtimeDashboard::delete_alert_rule(const std::string &rule_id)
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->alerts_mutex_);
+        auto it = pimpl_->rules_.find(rule_id);
+        if (it == pimpl_->rules_.end())
+        {
+            return false;
+        }
+        auto &by_source = pimpl_->rules_by_source_[it->second.source_id];
+        by_source.erase(std::remove(by_source.begin(), by_source.end(), rule_id), by_source.end());
+        pimpl_->rules_.erase(it);
+        return true;
+    }
+
+    std::vector<DashboardAlert> RealtimeDashboard::get_active_alerts(AlertSeverity severity_filter,
+                                                                     uint32_t limit) const
+    {
+        std::vector<DashboardAlert> alerts;
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->alerts_mutex_);
+            for (const auto &[alert_id, alert] : pimpl_->alerts_)
+            {
+                if (!alert.is_acknowledged && alert.severity >= severity_filter)
+                {
+                    alerts.push_back(alert);
+                }
+            }
+        }
+
+        // Most severe, then newest first
+        std::sort(alerts.begin(), alerts.end(), [](const DashboardAlert &a, const DashboardAlert &b)
+                  { return a.severity != b.severity ? a.severity > b.severity : a.triggered_time > b.triggered_time; });
+        if (alerts.size() > limit)
+        {
+            alerts.resize(limit);
+        }
+        return alerts;
+    }
+
+    bool RealtimeDashboard::acknowledge_alert(const std::string &alert_id,
+                                              const std::string &user_id,
+                                              const std::string &comment)
+    {
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->alerts_mutex_);
+            auto it = pimpl_->alerts_.find(alert_id);
+            if (it == pimpl_->alerts_.end() || it->second.is_acknowledged)
+            {
+                return false;
+            }
+
+            DashboardAlert &alert = it->second;
+            alert.is_acknowledged = true;
+            alert.acknowledged_by = user_id;
+            alert.acknowledged_time = now_seconds();
+            if (!comment.empty())
+            {
+                alert.metadata["comment"] = comment;
+            }
+
+            // The rule may fire again
+            auto rule = pimpl_->rules_.find(alert.metadata["rule_id"]);
+            if (rule != pimpl_->rules_.end() && rule->second.active_alert == alert_id)
+            {
+                rule->second.active_alert.clear();
+            }
+        }
+
+        pimpl_->user_event(user_id, "alert_acknowledged:" + alert_id);
+        return true;
+    }
+
+    uint32_t RealtimeDashboard::clear_acknowledged_alerts(uint32_t older_than_hours)
+    {
+        const uint64_t age = static_cast<uint64_t>(older_than_hours) * 3600;
+        const uint64_t now = now_seconds();
+        const uint64_t cutoff = now > age ? now - age : 0;
+
+        std::lock_guard<std::mutex> lock(pimpl_->alerts_mutex_);
+        uint32_t cleared = 0;
+        for (auto it = pimpl_->alerts_.begin(); it != pimpl_->alerts_.end();)
+        {
+            if (it->second.is_acknowledged && it->second.acknowledged_time <= cutoff)
+            {
+                it = pimpl_->alerts_.erase(it);
+                cleared++;
+            }
+            else
+            {
+                ++it;
+            }
+        }
+        return cleared;
+    }
+
+    std::unique_ptr<UserSession> RealtimeDashboard::authenticate_user(const std::string &username,
+                                                                      const std::string &password)
+    {
+        // Users come from the configuration: user.<name>.password_sha256 and user.<name>.permissions
+        std::string expected;
+        std::vector<std::string> permissions;
+        {
+            std::shared_lock<std::shared_mutex> lock(pimpl_->config_mutex_);
+            auto hash = pimpl_->config_.find("user." + username + ".password_sha256");
+            if (hash == pimpl_->config_.end())
+            {
+                return nullptr;
+            }
+            expected = hash->second;
+
+            auto granted = pimpl_->config_.find("user." + username + ".permissions");
+            if (granted != pimpl_->config_.end())
+            {
+                std::stringstream list(granted->second);
+                std::string permission;
+                while (std::getline(list, permission, ','))
+                {
+                    if (!permission.empty())
+                    {
+                        permissions.push_back(permission);
+                    }
+                }
+            }
+        }
+
+        const std::string actual = utils::codec::hex_encode(
+            utils::Hasher::digest(utils::HashAlgorithm::SHA256, password.data(), password.size()));
+        uint8_t difference = static_cast<uint8_t>(actual.size() ^ expected.size());
+        for (size_t i = 0; i < actual.size() && i < expected.size(); ++i)
+        {
+            difference |= static_cast<uint8_t>(actual[i] ^ std::tolower(static_cast<unsigned char>(expected[i])));
+        }
+        if (difference != 0)
+        {
+            pimpl_->user_event(username, "login_failed");
+            return nullptr;
+        }
+
+        return pimpl_->open_session(username, permissions, "", "");
+    }
+
+    std::unique_ptr<UserSession> RealtimeDashboard::create_session(const std::string &user_id,
+                                                                   const std::vector<std::string> &permissions,
+                                                                   const std::string &ip_address,
+                                                                   const std::string &user_agent)
+    {
+        if (user_id.empty())
+        {
+            return nullptr;
+        }
+        return pimpl_->open_session(user_id, permissions, ip_address, user_agent);
+    }
+
+    bool RealtimeDashboard::validate_session(const std::string &session_id)
+    {
+        uint64_t timeout;
+        {
+            std::shared_lock<std::shared_mutex> lock(pimpl_->config_mutex_);
+            timeout = pimpl_->session_timeout_seconds_;
+        }
+
+        const uint64_t now = now_seconds();
+        std::lock_guard<std::mutex> lock(pimpl_->sessions_mutex_);
+        auto it = pimpl_->sessions_.find(session_id);
+        if (it == pimpl_->sessions_.end())
+        {
+            return false;
+        }
+        if (timeout > 0 && now > it->second.last_activity + timeout)
+        {
+            pimpl_->sessions_.erase(it);
+            return false;
+        }
+        it->second.last_activity = now;
+        return true;
+    }
+
+    bool RealtimeDashboard::end_session(const std::string &session_id)
+    {
+        std::string user_id;
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->sessions_mutex_);
+            auto it = pimpl_->sessions_.find(session_id);
+            if (it == pimpl_->sessions_.end())
+            {
+                return false;
+            }
+            user_id = it->second.user_id;
+            pimpl_->sessions_.erase(it);
+        }
+        pimpl_->user_event(user_id, "session_ended");
+        return true;
+    }
+
+    std::vector<UserSession> RealtimeDashboard::get_active_sessions() const
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->sessions_mutex_);
+        std::vector<UserSession> sessions;
+        for (const auto &[session_id, session] : pimpl_->sessions_)
+        {
+            sessions.push_back(session);
+        }
+        return sessions;
+    }
+
+    bool RealtimeDashboard::set_custom_css(const std::string &layout_id, const std::string &css_content)
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->layouts_mutex_);
+        auto it = pimpl_->layouts_.find(layout_id);
+        if (it == pimpl_->layouts_.end())
+        {
+            return false;
+        }
+        it->second.custom_css["custom"] = css_content;
+        return true;
+    }
+
+    bool RealtimeDashboard::set_custom_javascript(const std::string &layout_id, const std::string &js_content)
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->layouts_mutex_);
+        auto it = pimpl_->layouts_.find(layout_id);
+        if (it == pimpl_->layouts_.end())
+        {
+            return false;
+        }
+        it->second.custom_js["custom"] = js_content;
+        return true;
+    }
+
+    bool RealtimeDashboard::add_custom_theme(const std::string &theme_id,
+                                             const std::map<std::string, std::string> &theme_config)
+    {
+        if (theme_id.empty())
+        {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(pimpl_->layouts_mutex_);
+        pimpl_->themes_[theme_id] = theme_config;
+        return true;
+    }
+
+    bool RealtimeDashboard::enable_rest_api(bool enable, const std::string &api_prefix)
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->server_mutex_);
+        pimpl_->rest_api_enabled_ = enable;
+        pimpl_->api_prefix_ = api_prefix;
+        return true;
+    }
+
+    bool RealtimeDashboard::add_api_endpoint(const std::string &method,
+                                             const std::string &path,
+                                             std::function<std::string(const std::map<std::string, std::string> &)> handler)
+    {
+        static const char *methods[] = {"GET", "POST", "PUT", "DELETE"};
+        if (!handler || path.empty() ||
+            std::none_of(std::begin(methods), std::end(methods), [&method](const char *m)
+                         { return method == m; }))
+        {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(pimpl_->server_mutex_);
+        pimpl_->endpoints_[method + " " + path] = std::move(handler);
+        return true;
+    }
+
+    bool RealtimeDashboard::set_api_authentication(const std::string &auth_type,
+                                                   const std::map<std::string, std::string> &auth_config)
+    {
+        if (auth_type != "none" && auth_type != "basic" && auth_type != "bearer" && auth_type != "api_key")
+        {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(pimpl_->server_mutex_);
+        pimpl_->api_auth_type_ = auth_type;
+        pimpl_->api_auth_config_ = auth_config;
+        return true;
+    }
+
+    bool RealtimeDashboard::enable_websocket(bool enable, const std::string &ws_path)
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->server_mutex_);
+        pimpl_->websocket_enabled_ = enable;
+        pimpl_->websocket_path_ = ws_path;
+        return true;
+    }
+
+    uint32_t RealtimeDashboard::broadcast_websocket_message(const std::string &message,
+                                                            const std::string &channel)
+    {
+        auto server = pimpl_->push_server();
+        return server ? server->broadcast_text(message, channel) : 0;
+    }
+
+    bool RealtimeDashboard::send_websocket_message(const std::string &session_id, const std::string &message)
+    {
+        std::shared_ptr<DashboardPushServer> server;
+        DashboardPushServer::ClientId client = 0;
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->server_mutex_);
+            auto it = pimpl_->session_clients_.find(session_id);
+            if (!pimpl_->push_server_ || it == pimpl_->session_clients_.end())
+            {
+                return false;
+            }
+            server = pimpl_->push_server_;
+            client = it->second;
+        }
+        return server->send_text(client, message);
+    }
+
+    bool RealtimeDashboard::export_dashboard(const std::string &layout_id,
+                                             const std::string &file_path,
+                                             const std::string &format) const
+    {
+        if (format != "json")
+        {
+            utils::Logger::instance().log(utils::LogLevel::WARNING, "RealtimeDashboard", "Unsupported export format: " + format);
+            return false;
+        }
+
+        json document;
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->layouts_mutex_);
+            auto it = pimpl_->layouts_.find(layout_id);
+            if (it == pimpl_->layouts_.end())
+            {
+                return false;
+            }
+            document = layout_to_json(it->second);
+        }
+
+        std::ofstream out(file_path);
+        out << document.dump(2);
+        return static_cast<bool>(out);
+    }
+
+    bool RealtimeDashboard::import_dashboard(const std::string &file_path,
+                                             const std::string &format)
+    {
+        std::ifstream in(file_path);
+        if (!in || format != "json")
+        {
+            return false;
+        }
+
+        std::stringstream buffer;
+        buffer << in.rdbuf();
+        DashboardLayout layout;
+        if (!layout_from_json(json::parse(buffer.str(), nullptr, false), layout) ||
+            !std::all_of(layout.widgets.begin(), layout.widgets.end(), validate_widget_config))
+        {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(pimpl_->layouts_mutex_);
+        pimpl_->layouts_[layout.layout_id] = std::move(layout);
+        pimpl_->reindex_widgets();
+        return true;
+    }
+
+    bool RealtimeDashboard::export_data(const std::string &source_id,
+                                        const std::string &file_path,
+                                        const std::string &format,
+                                        uint64_t start_time,
+                                        uint64_t end_time) const
+    {
+        auto source = pimpl_->source(source_id);
+        if (!source || (format != "json" && format != "csv"))
+        {
+            return false;
+        }
+
+        // The finest level that still covers the range
+        std::vector<RollupSeries::Bucket> buckets;
+        RollupSeries::Resolution resolution;
+        {
+            std::lock_guard<std::mutex> lock(source->mutex);
+            resolution = source->series.choose(start_time, end_time, std::numeric_limits<size_t>::max());
+            buckets = source->series.range(resolution, start_time, end_time);
+        }
+
+        std::ofstream out(file_path);
+        if (format == "csv")
+        {
+            out << "timestamp,average,min,max,count\n";
+            for (const auto &bucket : buckets)
+            {
+                out << bucket.start << ',' << format_number(bucket.average()) << ',' << format_number(bucket.min) << ','
+                    << format_number(bucket.max) << ',' << bucket.count << '\n';
+            }
+            return static_cast<bool>(out);
+        }
+
+        json document;
+        document["source_id"] = source_id;
+        document["resolution"] = resolution_to_string(resolution);
+        document["points"] = json::array();
+        for (const auto &bucket : buckets)
+        {
+            document["points"].push_back({{"timestamp", bucket.start},
+                                          {"average", bucket.average()},
+                                          {"min", bucket.min},
+                                          {"max", bucket.max},
+                                          {"count", bucket.count}});
+        }
+        out << document.dump(2);
+        return static_cast<bool>(out);
+    }
+
+    void RealtimeDashboard::set_data_update_callback(DataUpdateCallback callback)
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->callbacks_mutex_);
+        pimpl_->data_callback_ = std::move(callback);
+    }
+
+    void RealtimeDashboard::set_alert_callback(AlertCallback callback)
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->callbacks_mutex_);
+        pimpl_->alert_callback_ = std::move(callback);
+    }
+
+    void RealtimeDashboard::set_user_event_callback(UserEventCallback callback)
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->callbacks_mutex_);
+        pimpl_->user_callback_ = std::move(callback);
+    }
+
+    std::map<std::string, std::string> RealtimeDashboard::get_server_status() const
+    {
+        std::map<std::string, std::string> status;
+        {
+            std::shared_lock<std::shared_mutex> lock(pimpl_->config_mutex_);
+            status["initialized"] = pimpl_->initialized_ ? "true" : "false";
+        }
+        std::lock_guard<std::mutex> lock(pimpl_->server_mutex_);
+        status["running"] = pimpl_->push_server_ ? "true" : "false";
+        if (pimpl_->push_server_)
+        {
+            const auto push = pimpl_->push_server_->get_statistics();
+            status["port"] = std::to_string(pimpl_->push_server_->port());
+            status["websocket_clients"] = std::to_string(push.clients_connected);
+            status["websocket_frames_encoded"] = std::to_string(push.frames_encoded);
+            status["websocket_frames_queued"] = std::to_string(push.frames_queued);
+            status["websocket_frames_dropped"] = std::to_string(push.frames_dropped);
+            status["websocket_bytes_sent"] = std::to_string(push.bytes_sent);
+        }
+        status["rest_api"] = pimpl_->rest_api_enabled_ ? "enabled" : "disabled";
+        status["api_prefix"] = pimpl_->api_prefix_;
+        status["api_auth"] = pimpl_->api_auth_type_;
+        status["api_endpoints"] = std::to_string(pimpl_->endpoints_.size());
+        status["websocket"] = pimpl_->websocket_enabled_ ? "enabled" : "disabled";
+        status["websocket_path"] = pimpl_->websocket_path_;
+        return status;
+    }
+
+    std::map<std::string, uint64_t> RealtimeDashboard::get_statistics() const
+    {
+        std::map<std::string, uint64_t> stats;
+        stats["data_points_pushed"] = pimpl_->points_pushed_;
+        stats["data_points_rejected"] = pimpl_->points_rejected_;
+        stats["alerts_triggered"] = pimpl_->alerts_triggered_;
+
+        std::array<uint64_t, RollupSeries::RESOLUTION_COUNT> buckets{};
+        {
+            std::shared_lock<std::shared_mutex> lock(pimpl_->sources_mutex_);
+            stats["data_sources"] = pimpl_->sources_.size();
+            for (const auto &[source_id, source] : pimpl_->sources_)
+            {
+                std::lock_guard<std::mutex> source_lock(source->mutex);
+                for (size_t level = 0; level < buckets.size(); ++level)
+                {
+                    buckets[level] += source->series.size(static_cast<RollupSeries::Resolution>(level));
+                }
+            }
+        }
+        for (size_t level = 0; level < buckets.size(); ++level)
+        {
+            stats[std::string("buckets_") + resolution_to_string(static_cast<RollupSeries::Resolution>(level))] = buckets[level];
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->layouts_mutex_);
+            stats["layouts"] = pimpl_->layouts_.size();
+            uint64_t widgets = 0;
+            for (const auto &[layout_id, layout] : pimpl_->layouts_)
+            {
+                widgets += layout.widgets.size();
+            }
+            stats["widgets"] = widgets;
+        }
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->alerts_mutex_);
+            stats["alert_rules"] = pimpl_->rules_.size();
+            stats["active_alerts"] = std::count_if(pimpl_->alerts_.begin(), pimpl_->alerts_.end(), [](const auto &entry)
+                                                   { return !entry.second.is_acknowledged; });
+        }
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->sessions_mutex_);
+            stats["active_sessions"] = pimpl_->sessions_.size();
+        }
+        return stats;
+    }
+
+    bool RealtimeDashboard::update_configuration(const std::map<std::string, std::string> &config)
+    {
+        RollupSeries::Retention retention;
+        {
+            std::unique_lock<std::shared_mutex> lock(pimpl_->config_mutex_);
+            if (!pimpl_->apply_config(config))
+            {
+                return false;
+            }
+            retention = pimpl_->retention_;
+        }
+
+        std::shared_lock<std::shared_mutex> lock(pimpl_->sources_mutex_);
+        for (const auto &[source_id, source] : pimpl_->sources_)
+        {
+            std::lock_guard<std::mutex> source_lock(source->mutex);
+            source->series.set_retention(retention);
+        }
+        return true;
+    }
+
+    std::map<std::string, std::string> RealtimeDashboard::get_configuration() const
+    {
+        std::shared_lock<std::shared_mutex> lock(pimpl_->config_mutex_);
+        return pimpl_->config_;
+    }
+
+    DashboardBuilder::DashboardBuilder(const std::string &layout_id, const std::string &name)
+        : layout_(), next_widget_id_(1)
+    {
+        layout_.layout_id = layout_id;
+        layout_.name = name;
+        layout_.theme = DashboardTheme::LIGHT;
+        layout_.grid_columns = 12;
+        layout_.grid_rows = 12;
+    }
+
+    DashboardBuilder &DashboardBuilder::set_theme(DashboardTheme theme)
+    {
+        layout_.theme = theme;
+        return *this;
+    }
+
+    DashboardBuilder &DashboardBuilder::set_grid_size(uint32_t columns, uint32_t rows)
+    {
+        layout_.grid_columns = columns;
+        layout_.grid_rows = rows;
+        return *this;
+    }
+
+    namespace
+    {
+        WidgetConfig make_widget(const std::string &widget_id, const std::string &title, WidgetType type,
+                                 uint32_t x_pos, uint32_t y_pos, uint32_t width, uint32_t height)
+        {
+            WidgetConfig widget{};
+            widget.widget_id = widget_id;
+            widget.title = title;
+            widget.type = type;
+            widget.x_position = x_pos;
+            widget.y_position = y_pos;
+            widget.width = width;
+            widget.height = height;
+            widget.aggregation_func = "mean";
+            widget.time_range_minutes = 60;
+            widget.refresh_interval_ms = 1000;
+            widget.show_legend = true;
+            widget.show_tooltip = true;
+            return widget;
+        }
+    }
+
+    DashboardBuilder &DashboardBuilder::add_line_chart(const std::string &title,
+                                                       const std::vector<std::string> &data_sources,
+                                                       uint32_t x_pos, uint32_t y_pos,
+                                                       uint32_t width, uint32_t height)
+    {
+        WidgetConfig widget = make_widget(layout_.layout_id + "_widget_" + std::to_string(next_widget_id_++), title,
+                                          WidgetType::LINE_CHART, x_pos, y_pos, width, height);
+        widget.data_sources = data_sources;
+        widget.is_interactive = true;
+        widget.enable_zoom = true;
+        layout_.widgets.push_back(std::move(widget));
+        return *this;
+    }
+
+    DashboardBuilder &DashboardBuilder::add_gauge(const std::string &title,
+                                                  const std::string &data_source,
+                                                  double min_value, double max_value,
+                                                  uint32_t x_pos, uint32_t y_pos,
+                                                  uint32_t width, uint32_t height)
+    {
+        WidgetConfig widget = make_widget(layout_.layout_id + "_widget_" + std::to_string(next_widget_id_++), title,
+                                          WidgetType::GAUGE, x_pos, y_pos, width, height);
+        widget.data_sources = {data_source};
+        widget.aggregation_func = "last";
+        widget.min_value = min_value;
+        widget.max_value = max_value;
+        widget.show_legend = false;
+        layout_.widgets.push_back(std::move(widget));
+        return *this;
+    }
+
+    DashboardBuilder &DashboardBuilder::add_metric_card(const std::string &title,
+                                                        const std::string &data_source,
+                                                        const std::string &unit,
+                                                        uint32_t x_pos, uint32_t y_pos,
+                                                        uint32_t width, uint32_t height)
+    {
+        WidgetConfig widget = make_widget(layout_.layout_id + "_widget_" + std::to_string(next_widget_id_++), title,
+                                          WidgetType::METRIC_CARD, x_pos, y_pos, width, height);
+        widget.data_sources = {data_source};
+        widget.aggregation_func = "last";
+        widget.unit = unit;
+        widget.show_legend = false;
+        layout_.widgets.push_back(std::move(widget));
+        return *this;
+    }
+
+    DashboardLayout DashboardBuilder::build()
+    {
+        return layout_;
+    }
+
+    std::string widget_type_to_string(WidgetType type)
+    {
+        switch (type)
+        {
+        case WidgetType::LINE_CHART:
+            return "line_chart";
+        case WidgetType::BAR_CHART:
+            return "bar_chart";
+        case WidgetType::PIE_CHART:
+            return "pie_chart";
+        case WidgetType::GAUGE:
+            return "gauge";
+        case WidgetType::METRIC_CARD:
+            return "metric_card";
+        case WidgetType::STATUS_INDICATOR:
+            return "status_indicator";
+        case WidgetType::DATA_TABLE:
+            return "data_table";
+        case WidgetType::MAP_VIEW:
+            return "map_view";
+        case WidgetType::HEATMAP:
+            return "heatmap";
+        case WidgetType::ALERT_LIST:
+            return "alert_list";
+        case WidgetType::LOG_VIEWER:
+            return "log_viewer";
+        case WidgetType::CUSTOM:
+            return "custom";
+        default:
+            return "unknown";
+        }
+    }
+
+    std::string alert_severity_to_string(AlertSeverity severity)
+    {
+        switch (severity)
+        {
+        case AlertSeverity::INFO:
+            return "info";
+        case AlertSeverity::LOW:
+            return "low";
+        case AlertSeverity::MEDIUM:
+            return "medium";
+        case AlertSeverity::HIGH:
+            return "high";
+        case AlertSeverity::CRITICAL:
+            return "critical";
+        default:
+            return "unknown";
+        }
+    }
+
+    std::string dashboard_theme_to_string(DashboardTheme theme)
+    {
+        switch (theme)
+        {
+        case DashboardTheme::LIGHT:
+            return "light";
+        case DashboardTheme::DARK:
+            return "dark";
+        case DashboardTheme::CYBERPUNK:
+            return "cyberpunk";
+        case DashboardTheme::CUSTOM:
+            return "custom";
+        default:
+            return "unknown";
+        }
+    }
+
+    std::string generate_widget_id(const std::string &prefix)
+    {
+        static std::atomic<uint64_t> sequence{0};
+        return prefix + "_" + std::to_string(++sequence) + "_" + random_hex(4);
+    }
+
+    bool validate_widget_config(const WidgetConfig &config)
+    {
+        if (config.widget_id.empty() || config.width < 1 || config.width > 12 || config.height < 1 || config.height > 12)
+        {
+            return false;
+        }
+        if (config.type == WidgetType::GAUGE && !(config.min_value < config.max_value))
+        {
+            return false;
+        }
+        return true;
+    }
+
+} // namespace cardano_iot::monitoring
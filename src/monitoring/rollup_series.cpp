@@ -0,0 +1,205 @@
+/**
+ * @file rollup_series.cpp
+ * @brief Implementation of multi-resolution time series rollups
+ *
+ * @author Cardano IoT SDK Team
+ * @version 1.0.0
+ */
+
+#include "cardano_iot/monitoring/rollup_series.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace cardano_iot::monitoring
+{
+
+    namespace
+    {
+        constexpr std::array<uint64_t, RollupSeries::RESOLUTION_COUNT> WIDTHS = {0, 1, 60, 3600};
+
+        void merge(RollupSeries::Bucket &into, const RollupSeries::Bucket &from)
+        {
+            into.min = std::min(into.min, from.min);
+            into.max = std::max(into.max, from.max);
+            into.sum += from.sum;
+            into.count += from.count;
+        }
+    }
+
+    RollupSeries::RollupSeries() : RollupSeries(Retention()) {}
+
+    RollupSeries::RollupSeries(const Retention &retention)
+    {
+        set_retention(retention);
+    }
+
+    void RollupSeries::set_retention(const Retention &retention)
+    {
+        retention_ = {retention.raw_seconds, retention.second_seconds, retention.minute_seconds, retention.hour_seconds};
+        for (size_t level = 0; level < RESOLUTION_COUNT; ++level)
+        {
+            compact(level);
+        }
+    }
+
+    uint64_t RollupSeries::width(Resolution resolution)
+    {
+        return WIDTHS[index(resolution)];
+    }
+
+    void RollupSeries::add(uint64_t timestamp, double value)
+    {
+        newest_ = std::max(newest_, timestamp);
+
+        Bucket point;
+        point.min = value;
+        point.max = value;
+        point.sum = value;
+        point.count = 1;
+
+        for (size_t level = 0; level < RESOLUTION_COUNT; ++level)
+        {
+            point.start = level == 0 ? timestamp : timestamp / WIDTHS[level] * WIDTHS[level];
+            if (point.start < dropped_before_[level])
+            {
+                continue; // Older than this level keeps
+            }
+
+            auto &buckets = levels_[level];
+            if (buckets.empty() || point.start > buckets.back().start || (level == 0 && point.start == buckets.back().start))
+            {
+                buckets.push_back(point);
+            }
+            else if (level > 0 && point.start == buckets.back().start)
+            {
+                merge(buckets.back(), point);
+            }
+            else
+            {
+                // Late point
+                auto it = std::upper_bound(buckets.begin(), buckets.end(), point.start,
+                                           [](uint64_t start, const Bucket &bucket)
+                                           { return start < bucket.start; });
+                if (level > 0 && it != buckets.begin() && std::prev(it)->start == point.start)
+                {
+                    merge(*std::prev(it), point);
+                }
+                else
+                {
+                    buckets.insert(it, point);
+                }
+            }
+            compact(level);
+        }
+    }
+
+    void RollupSeries::compact(size_t level)
+    {
+        auto &buckets = levels_[level];
+        const uint64_t cutoff = newest_ > retention_[level] ? newest_ - retention_[level] : 0;
+        const uint64_t span = std::max<uint64_t>(WIDTHS[level], 1);
+        while (!buckets.empty() && buckets.front().start + span <= cutoff)
+        {
+            dropped_before_[level] = std::max(dropped_before_[level], buckets.front().start + span);
+            buckets.pop_front();
+        }
+    }
+
+    std::pair<size_t, size_t> RollupSeries::bounds(size_t level, uint64_t start, uint64_t end) const
+    {
+        const auto &buckets = levels_[level];
+        const uint64_t first = level == 0 ? start : start / WIDTHS[level] * WIDTHS[level];
+        auto lower = std::lower_bound(buckets.begin(), buckets.end(), first,
+                                      [](const Bucket &bucket, uint64_t value)
+                                      { return bucket.start < value; });
+        auto upper = std::upper_bound(lower, buckets.end(), end,
+                                      [](uint64_t value, const Bucket &bucket)
+                                      { return value < bucket.start; });
+        return {static_cast<size_t>(lower - buckets.begin()), static_cast<size_t>(upper - buckets.begin())};
+    }
+
+    RollupSeries::Resolution RollupSeries::choose(uint64_t start, uint64_t end, size_t max_points) const
+    {
+        if (end == 0)
+        {
+            end = std::numeric_limits<uint64_t>::max();
+        }
+
+        for (size_t level = 0; level < RESOLUTION_COUNT; ++level)
+        {
+            if (start < dropped_before_[level])
+            {
+                continue;
+            }
+            const auto [lower, upper] = bounds(level, start, end);
+            if (upper - lower <= max_points)
+            {
+                return static_cast<Resolution>(level);
+            }
+        }
+        return Resolution::HOUR;
+    }
+
+    std::vector<RollupSeries::Bucket> RollupSeries::range(Resolution resolution, uint64_t start, uint64_t end) const
+    {
+        if (end == 0)
+        {
+            end = std::numeric_limits<uint64_t>::max();
+        }
+        const size_t level = index(resolution);
+        const auto [lower, upper] = bounds(level, start, end);
+        return std::vector<Bucket>(levels_[level].begin() + static_cast<std::ptrdiff_t>(lower),
+                                   levels_[level].begin() + static_cast<std::ptrdiff_t>(upper));
+    }
+
+    std::vector<RollupSeries::Bucket> RollupSeries::query(uint64_t start, uint64_t end, size_t max_points,
+                                                          Resolution *used) const
+    {
+        max_points = std::max<size_t>(max_points, 1);
+        const Resolution resolution = choose(start, end, max_points);
+        if (used)
+        {
+            *used = resolution;
+        }
+
+        std::vector<Bucket> buckets = range(resolution, start, end);
+        if (buckets.size() <= max_points)
+        {
+            return buckets;
+        }
+
+        // Merge neighbours down to max_points
+        const size_t group = (buckets.size() + max_points - 1) / max_points;
+        std::vector<Bucket> merged;
+        merged.reserve(max_points);
+        for (size_t i = 0; i < buckets.size(); i += group)
+        {
+            Bucket bucket = buckets[i];
+            for (size_t j = i + 1; j < std::min(i + group, buckets.size()); ++j)
+            {
+                merge(bucket, buckets[j]);
+            }
+            merged.push_back(bucket);
+        }
+        return merged;
+    }
+
+    const char *resolution_to_string(RollupSeries::Resolution resolution)
+    {
+        switch (resolution)
+        {
+        case RollupSeries::Resolution::RAW:
+            return "raw";
+        case RollupSeries::Resolution::SECOND:
+            return "1s";
+        case RollupSeries::Resolution::MINUTE:
+            return "1m";
+        case RollupSeries::Resolution::HOUR:
+            return "1h";
+        default:
+            return "unknown";
+        }
+    }
+
+} // namespace cardano_iot::monitoring
@@ -1,17 +1,304 @@
 #include "cardano_iot/network/cardano_client.h"
+#include "cardano_iot/network/http_client.h"
 #include "cardano_iot/utils/logger.h"
+#include "cardano_iot/utils/codec.h"
+#include "cardano_iot/utils/executor.h"
+#include "cardano_iot/utils/metrics.h"
+
+#include <nlohmann/json.hpp>
 
 #include <chrono>
 #include <sstream>
 #include <random>
 #include <algorithm>
 #include <mutex>
+#include <condition_variable>
 #include <thread>
+#include <atomic>
+#include <array>
+#include <cctype>
+#include <cstdlib>
+#include <unordered_map>
+#include <unordered_set>
+#include <iterator>
+
+using json = nlohmann::json;
 
 namespace cardano_iot
 {
     namespace network
     {
+        namespace
+        {
+            // Hosted APIs return quantities as decimal strings
+            uint64_t json_u64(const json &value)
+            {
+                if (value.is_number_unsigned())
+                {
+                    return value.get<uint64_t>();
+                }
+                if (value.is_number_integer())
+                {
+                    return static_cast<uint64_t>(std::max<int64_t>(0, value.get<int64_t>()));
+                }
+                if (value.is_string())
+                {
+                    return std::strtoull(value.get_ref<const std::string &>().c_str(), nullptr, 10);
+                }
+                return 0;
+            }
+
+            std::string json_string(const json &object, const char *key)
+            {
+                auto it = object.find(key);
+                return it != object.end() && it->is_string() ? it->get<std::string>() : std::string();
+            }
+
+            // Blockfrost: [{tx_hash, output_index, amount: [{unit, quantity}], data_hash}]
+            bool parse_blockfrost_utxos(const std::string &body, const std::string &address,
+                                        std::vector<UTXOInfo> &out, size_t &page_size)
+            {
+                auto parsed = json::parse(body, nullptr, false);
+                if (parsed.is_discarded() || !parsed.is_array())
+                {
+                    return false;
+                }
+                page_size = parsed.size();
+                for (const auto &entry : parsed)
+                {
+                    UTXOInfo utxo;
+                    utxo.tx_hash = json_string(entry, "tx_hash");
+                    utxo.output_index = static_cast<uint32_t>(json_u64(entry.value("output_index", json(0))));
+                    utxo.address = entry.contains("address") ? json_string(entry, "address") : address;
+                    utxo.amount = 0;
+                    utxo.datum_hash = json_string(entry, "data_hash");
+                    for (const auto &amount : entry.value("amount", json::array()))
+                    {
+                        const std::string unit = json_string(amount, "unit");
+                        const uint64_t quantity = json_u64(amount.value("quantity", json(0)));
+                        if (unit == "lovelace")
+                        {
+                            utxo.amount = quantity;
+                        }
+                        else if (unit.size() >= 56)
+                        {
+                            // unit = policy id (28 bytes hex) followed by the hex asset name
+                            utxo.assets[unit.substr(0, 56) + "." + unit.substr(56)] = quantity;
+                        }
+                    }
+                    out.push_back(std::move(utxo));
+                }
+                return true;
+            }
+
+            // Koios: [{tx_hash, tx_index, address, value, datum_hash, asset_list: [{policy_id, asset_name, quantity}]}]
+            bool parse_koios_utxos(const std::string &body, std::vector<UTXOInfo> &out)
+            {
+                auto parsed = json::parse(body, nullptr, false);
+                if (parsed.is_discarded() || !parsed.is_array())
+                {
+                    return false;
+                }
+                for (const auto &entry : parsed)
+                {
+                    UTXOInfo utxo;
+                    utxo.tx_hash = json_string(entry, "tx_hash");
+                    utxo.output_index = static_cast<uint32_t>(json_u64(entry.value("tx_index", json(0))));
+                    utxo.address = json_string(entry, "address");
+                    utxo.amount = json_u64(entry.value("value", json(0)));
+                    utxo.datum_hash = json_string(entry, "datum_hash");
+                    const auto assets = entry.find("asset_list");
+                    if (assets != entry.end() && assets->is_array())
+                    {
+                        for (const auto &asset : *assets)
+                        {
+                            utxo.assets[json_string(asset, "policy_id") + "." + json_string(asset, "asset_name")] =
+                                json_u64(asset.value("quantity", json(0)));
+                        }
+                    }
+                    out.push_back(std::move(utxo));
+                }
+                return true;
+            }
+
+            template <typename T>
+            std::future<T> ready_future(T value)
+            {
+                std::promise<T> promise;
+                promise.set_value(std::move(value));
+                return promise.get_future();
+            }
+
+            // Bounded wait so a stalled backend cannot hang synchronous callers
+            template <typename T>
+            T await(std::future<T> future, uint32_t timeout_ms, T fallback)
+            {
+                if (future.wait_for(std::chrono::milliseconds(timeout_ms + 1000)) != std::future_status::ready)
+                {
+                    return fallback;
+                }
+                return future.get();
+            }
+
+            constexpr size_t BLOCKFROST_PAGE_SIZE = 100;
+            constexpr uint64_t CHAIN_FETCH_LIMIT = 100; // block headers per follower round trip
+            constexpr uint32_t MAX_FOLLOWER_BACKOFF_MS = 30000;
+            constexpr size_t MAX_ADDRESS_CHARS = 256;
+
+            // Bech32 (addr_test1...), Byron base58 and hex addresses need nothing beyond [A-Za-z0-9_] in a URL path
+            bool is_path_safe_address(const std::string &address)
+            {
+                return !address.empty() && address.size() <= MAX_ADDRESS_CHARS &&
+                       std::all_of(address.begin(), address.end(), [](unsigned char c)
+                                   { return std::isalnum(c) != 0 || c == '_'; });
+            }
+
+            bool is_tx_hash(const std::string &tx_hash)
+            {
+                return tx_hash.size() == 64 && std::all_of(tx_hash.begin(), tx_hash.end(), [](unsigned char c)
+                                                           { return std::isxdigit(c) != 0; });
+            }
+
+            // Blockfrost: {hash, previous_block, slot, height, epoch}; Koios: {hash, parent_hash, abs_slot, block_height, epoch_no}
+            BlockHeader parse_block_header(const json &entry, bool blockfrost)
+            {
+                BlockHeader header;
+                header.hash = json_string(entry, "hash");
+                header.previous_hash = json_string(entry, blockfrost ? "previous_block" : "parent_hash");
+                header.slot = json_u64(entry.value(blockfrost ? "slot" : "abs_slot", json(0)));
+                header.height = json_u64(entry.value(blockfrost ? "height" : "block_height", json(0)));
+                header.epoch = json_u64(entry.value(blockfrost ? "epoch" : "epoch_no", json(0)));
+                return header;
+            }
+
+            /**
+             * Sharded read-through UTXO cache. Entries expire after a TTL and are
+             * invalidated wholesale when the chain tip moves to a new block.
+             */
+            class UtxoCache
+            {
+            public:
+                using Clock = std::chrono::steady_clock;
+
+                void set_ttl(uint32_t ttl_ms) { ttl_ms_.store(ttl_ms, std::memory_order_relaxed); }
+
+                bool get(const std::string &address, std::vector<UTXOInfo> &out)
+                {
+                    auto &shard = shard_for(address);
+                    {
+                        std::lock_guard<std::mutex> lock(shard.mutex);
+                        auto it = shard.entries.find(address);
+                        if (it != shard.entries.end())
+                        {
+                            if (fresh(it->second))
+                            {
+                                out = it->second.utxos;
+                                hits_.fetch_add(1, std::memory_order_relaxed);
+                                return true;
+                            }
+                            shard.entries.erase(it);
+                        }
+                    }
+                    misses_.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+
+                void put(const std::string &address, const std::vector<UTXOInfo> &utxos)
+                {
+                    const uint32_t ttl = ttl_ms_.load(std::memory_order_relaxed);
+                    if (ttl == 0)
+                    {
+                        return;
+                    }
+                    auto &shard = shard_for(address);
+                    std::lock_guard<std::mutex> lock(shard.mutex);
+                    if (shard.entries.size() >= MAX_ENTRIES_PER_SHARD && !shard.entries.count(address))
+                    {
+                        for (auto it = shard.entries.begin(); it != shard.entries.end();)
+                        {
+                            it = fresh(it->second) ? std::next(it) : shard.entries.erase(it);
+                        }
+                        if (shard.entries.size() >= MAX_ENTRIES_PER_SHARD)
+                        {
+                            shard.entries.erase(shard.entries.begin());
+                        }
+                    }
+                    auto &entry = shard.entries[address];
+                    entry.utxos = utxos;
+                    entry.expires = Clock::now() + std::chrono::milliseconds(ttl);
+                    entry.generation = generation_.load(std::memory_order_acquire);
+                }
+
+                void invalidate(const std::string &address)
+                {
+                    auto &shard = shard_for(address);
+                    std::lock_guard<std::mutex> lock(shard.mutex);
+                    shard.entries.erase(address);
+                }
+
+                void clear()
+                {
+                    for (auto &shard : shards_)
+                    {
+                        std::lock_guard<std::mutex> lock(shard.mutex);
+                        shard.entries.clear();
+                    }
+                }
+
+                // A new block may have spent or created outputs anywhere: retire every entry at once
+                void observe_tip(uint64_t height)
+                {
+                    if (height != 0 && tip_height_.exchange(height, std::memory_order_acq_rel) != height)
+                    {
+                        generation_.fetch_add(1, std::memory_order_acq_rel);
+                    }
+                }
+
+                uint64_t hits() const { return hits_.load(std::memory_order_relaxed); }
+                uint64_t misses() const { return misses_.load(std::memory_order_relaxed); }
+
+                void reset_counters()
+                {
+                    hits_.store(0, std::memory_order_relaxed);
+                    misses_.store(0, std::memory_order_relaxed);
+                }
+
+            private:
+                static constexpr size_t SHARDS = 16;
+                static constexpr size_t MAX_ENTRIES_PER_SHARD = 4096;
+
+                struct Entry
+                {
+                    std::vector<UTXOInfo> utxos;
+                    Clock::time_point expires;
+                    uint64_t generation = 0;
+                };
+
+                struct Shard
+                {
+                    std::mutex mutex;
+                    std::unordered_map<std::string, Entry> entries;
+                };
+
+                Shard &shard_for(const std::string &address)
+                {
+                    return shards_[std::hash<std::string>{}(address) % SHARDS];
+                }
+
+                bool fresh(const Entry &entry) const
+                {
+                    return entry.generation == generation_.load(std::memory_order_acquire) && Clock::now() < entry.expires;
+                }
+
+                std::array<Shard, SHARDS> shards_;
+                std::atomic<uint32_t> ttl_ms_{20000};
+                std::atomic<uint64_t> generation_{0};
+                std::atomic<uint64_t> tip_height_{0};
+                std::atomic<uint64_t> hits_{0};
+                std::atomic<uint64_t> misses_{0};
+            };
+        } // namespace
+
         struct CardanoClient::Impl
         {
             bool initialized_ = false;
@@ -19,26 +306,865 @@ namespace cardano_iot
             Network network_ = Network::TESTNET;
             ConnectionStatus status_ = ConnectionStatus::DISCONNECTED;
             mutable std::mutex client_mutex_;
-            mutable std::mutex stats_mutex_;
+            std::shared_ptr<utils::Executor> executor_; // Guarded by client_mutex_
 
             // Mock node data
             std::string mock_node_version_ = "8.7.3";
             uint64_t mock_current_slot_ = 112233445;
             uint64_t mock_current_epoch_ = 445;
             double mock_sync_progress_ = 100.0;
+            std::chrono::steady_clock::time_point mock_start_ = std::chrono::steady_clock::now();
+
+            // Blocking call as a future: on the shared executor when one is set, else on its own thread
+            template <typename Fn>
+            auto run_async(Fn fn) const -> std::future<decltype(fn())>
+            {
+                using Result = decltype(fn());
+                std::shared_ptr<utils::Executor> executor;
+                {
+                    std::lock_guard<std::mutex> lock(client_mutex_);
+                    executor = executor_;
+                }
+                if (executor)
+                {
+                    auto promise = std::make_shared<std::promise<Result>>();
+                    auto future = promise->get_future();
+                    if (executor->post([promise, fn]()
+                                       { promise->set_value(fn()); },
+                                       utils::TaskPriority::CRITICAL))
+                    {
+                        return future;
+                    }
+                }
+                return std::async(std::launch::async, std::move(fn));
+            }
 
-            // Statistics
-            ClientStats stats_ = {};
+            // Statistics: per-core metrics, query count is the latency histogram's count
+            utils::metrics::Counter queries_succeeded_{"cardano_iot_client_queries_total", "Node queries by result", {{"result", "success"}}};
+            utils::metrics::Counter queries_failed_{"cardano_iot_client_queries_total", "Node queries by result", {{"result", "failure"}}};
+            utils::metrics::Counter transactions_submitted_{"cardano_iot_client_tx_submitted_total", "Transactions submitted to the node"};
+            utils::metrics::Counter connection_attempts_{"cardano_iot_client_connection_attempts_total", "Node connection attempts"};
+            utils::metrics::Histogram query_ms_{"cardano_iot_client_query_duration_ms", "Node query time in milliseconds",
+                                                utils::metrics::Histogram::latency_ms_bounds()};
 
             // Mock UTXOs storage
             std::map<std::string, std::vector<UTXOInfo>> address_utxos_;
+            std::mutex mock_mutex_;
+
+            UtxoCache utxo_cache_;
+            std::atomic<uint64_t> utxo_round_trips_{0};
+
+            // Chain follower shared by all subscriptions
+            struct SubscriptionState
+            {
+                ChainSubscription spec;
+                ChainPoint cursor; // last point delivered
+            };
+
+            mutable std::mutex subscriptions_mutex_;
+            std::condition_variable follower_cv_;
+            std::map<uint64_t, SubscriptionState> subscriptions_;
+            uint64_t next_subscription_id_ = 1;
+            std::thread follower_;
+            bool follower_stop_ = false;
+            std::mutex delivery_mutex_; // held while subscription handlers run
+            std::mutex follow_mutex_;   // held while the follower uses the backend; taken before client_mutex_
+
+            // HTTP backend; http_ is created on connect() and declared last so its I/O
+            // thread stops before the rest of Impl is destroyed
+            BackendConfig backend_;
+            std::unique_ptr<HttpClient> http_;
+
+            bool http_backend() const { return backend_.type != BackendType::MOCK && http_ != nullptr; }
+
+            std::string endpoint(const std::string &path) const
+            {
+                std::string base = backend_.base_url;
+                while (!base.empty() && base.back() == '/')
+                {
+                    base.pop_back();
+                }
+                return base + path;
+            }
+
+            HttpRequest make_request(const std::string &method, const std::string &path,
+                                     const std::string &content_type = "") const
+            {
+                HttpRequest request;
+                request.method = method;
+                request.url = endpoint(path);
+                request.headers.push_back("Accept: application/json");
+                if (!content_type.empty())
+                {
+                    request.headers.push_back("Content-Type: " + content_type);
+                }
+                if (!backend_.api_key.empty())
+                {
+                    request.headers.push_back(backend_.type == BackendType::BLOCKFROST
+                                                  ? "project_id: " + backend_.api_key
+                                                  : "Authorization: Bearer " + backend_.api_key);
+                }
+                return request;
+            }
+
+            void record(const HttpResponse &response)
+            {
+                update_query_stats(response.ok(), response.total_time_ms);
+            }
+
+            // Result of a multi-address query; addresses whose query failed are absent
+            using UtxoBatch = std::map<std::string, std::vector<UTXOInfo>>;
+
+            struct BatchQuery
+            {
+                UtxoBatch result; // written on the HTTP I/O thread only
+                std::atomic<size_t> remaining{0};
+                std::function<void(UtxoBatch &&)> done;
+
+                void complete_one()
+                {
+                    if (remaining.fetch_sub(1) == 1)
+                    {
+                        done(std::move(result));
+                    }
+                }
+            };
+
+            struct PageQuery
+            {
+                std::string address;
+                uint32_t page = 1;
+                std::vector<UTXOInfo> utxos;
+                std::shared_ptr<BatchQuery> batch;
+            };
+
+            void fetch_blockfrost_page(std::shared_ptr<PageQuery> query)
+            {
+                if (!is_path_safe_address(query->address))
+                {
+                    utils::Logger::instance().log(utils::LogLevel::ERROR, "CardanoClient",
+                                                  "UTXO query refused for a malformed address");
+                    query->batch->complete_one();
+                    return;
+                }
+                auto request = make_request("GET", "/addresses/" + query->address + "/utxos?count=" +
+                                                       std::to_string(BLOCKFROST_PAGE_SIZE) +
+                                                       "&page=" + std::to_string(query->page));
+                utxo_round_trips_.fetch_add(1, std::memory_order_relaxed);
+                http_->send(std::move(request), [this, query](HttpResponse &&response)
+                            {
+                                record(response);
+                                size_t page_size = 0;
+                                // 404: the address has never been used, so it has no UTXOs
+                                const bool unused = response.error.empty() && response.status == 404;
+                                if (!unused && (!response.ok() || !parse_blockfrost_utxos(response.body, query->address, query->utxos, page_size)))
+                                {
+                                    utils::Logger::instance().log(utils::LogLevel::ERROR, "CardanoClient",
+                                                                  "UTXO query failed for " + query->address.substr(0, 16) + "...: " +
+                                                                      (response.error.empty() ? "HTTP " + std::to_string(response.status) : response.error));
+                                    query->batch->complete_one();
+                                    return;
+                                }
+                                if (!unused && page_size == BLOCKFROST_PAGE_SIZE)
+                                {
+                                    ++query->page;
+                                    fetch_blockfrost_page(query);
+                                    return;
+                                }
+                                utxo_cache_.put(query->address, query->utxos);
+                                query->batch->result[query->address] = std::move(query->utxos);
+                                query->batch->complete_one(); });
+            }
+
+            void fetch_koios_chunk(std::vector<std::string> addresses, std::shared_ptr<BatchQuery> batch)
+            {
+                auto request = make_request("POST", "/address_utxos", "application/json");
+                request.body = json{{"_addresses", addresses}, {"_extended", true}}.dump();
+                utxo_round_trips_.fetch_add(1, std::memory_order_relaxed);
+                http_->send(std::move(request), [this, addresses, batch](HttpResponse &&response)
+                            {
+                                record(response);
+                                std::vector<UTXOInfo> utxos;
+                                if (response.ok() && parse_koios_utxos(response.body, utxos))
+                                {
+                                    UtxoBatch grouped;
+                                    for (const auto &address : addresses)
+                                    {
+                                        grouped[address];
+                                    }
+                                    for (auto &utxo : utxos)
+                                    {
+                                        grouped[utxo.address].push_back(std::move(utxo));
+                                    }
+                                    for (auto &[address, list] : grouped)
+                                    {
+                                        utxo_cache_.put(address, list);
+                                        batch->result[address] = std::move(list);
+                                    }
+                                }
+                                else
+                                {
+                                    utils::Logger::instance().log(utils::LogLevel::ERROR, "CardanoClient",
+                                                                  "Batched UTXO query failed for " + std::to_string(addresses.size()) + " addresses");
+                                }
+                                batch->complete_one(); });
+            }
+
+            // Fetch uncached addresses in as few requests as the provider allows: Koios takes
+            // address lists, Blockfrost gets one multiplexed request per address
+            void fetch_batch(const std::vector<std::string> &addresses, std::function<void(UtxoBatch &&)> done)
+            {
+                if (addresses.empty())
+                {
+                    done({});
+                    return;
+                }
+                auto batch = std::make_shared<BatchQuery>();
+                batch->done = std::move(done);
+
+                if (backend_.type == BackendType::BLOCKFROST)
+                {
+                    batch->remaining = addresses.size();
+                    for (const auto &address : addresses)
+                    {
+                        auto query = std::make_shared<PageQuery>();
+                        query->address = address;
+                        query->batch = batch;
+                        fetch_blockfrost_page(query);
+                    }
+                    return;
+                }
+
+                const size_t chunk = std::max<size_t>(1, backend_.max_batch_addresses);
+                batch->remaining = (addresses.size() + chunk - 1) / chunk;
+                for (size_t begin = 0; begin < addresses.size(); begin += chunk)
+                {
+                    const size_t end = std::min(addresses.size(), begin + chunk);
+                    fetch_koios_chunk(std::vector<std::string>(addresses.begin() + begin, addresses.begin() + end), batch);
+                }
+            }
+
+            // Simulated backend: one network delay for the whole batch
+            UtxoBatch mock_batch(const std::vector<std::string> &addresses)
+            {
+                simulate_network_delay();
+                utxo_round_trips_.fetch_add(1, std::memory_order_relaxed);
+
+                UtxoBatch result;
+                std::lock_guard<std::mutex> lock(mock_mutex_);
+                for (const auto &address : addresses)
+                {
+                    auto it = address_utxos_.find(address);
+                    if (it == address_utxos_.end())
+                    {
+                        it = address_utxos_.emplace(address, generate_mock_utxos(address)).first;
+                    }
+                    utxo_cache_.put(address, it->second);
+                    result[address] = it->second;
+                }
+                return result;
+            }
+
+            // Split into cache hits (filled into result) and deduplicated misses
+            std::vector<std::string> lookup_cached(const std::vector<std::string> &addresses, UtxoBatch &result)
+            {
+                std::vector<std::string> misses;
+                std::unordered_set<std::string> seen;
+                for (const auto &address : addresses)
+                {
+                    if (!seen.insert(address).second)
+                    {
+                        continue;
+                    }
+                    std::vector<UTXOInfo> cached;
+                    if (utxo_cache_.get(address, cached))
+                    {
+                        result.emplace(address, std::move(cached));
+                    }
+                    else
+                    {
+                        misses.push_back(address);
+                    }
+                }
+                return misses;
+            }
+
+            std::future<ChainTip> fetch_tip()
+            {
+                auto promise = std::make_shared<std::promise<ChainTip>>();
+                auto future = promise->get_future();
+                const bool blockfrost = backend_.type == BackendType::BLOCKFROST;
+
+                http_->send(make_request("GET", blockfrost ? "/blocks/latest" : "/tip"),
+                            [this, promise, blockfrost](HttpResponse &&response)
+                            {
+                                record(response);
+                                ChainTip tip{};
+                                auto parsed = response.ok() ? json::parse(response.body, nullptr, false) : json();
+                                if (!blockfrost && parsed.is_array() && !parsed.empty())
+                                {
+                                    parsed = parsed.front();
+                                }
+                                if (parsed.is_object())
+                                {
+                                    tip.hash = json_string(parsed, "hash");
+                                    tip.slot = json_u64(parsed.value(blockfrost ? "slot" : "abs_slot", json(0)));
+                                    tip.height = json_u64(parsed.value(blockfrost ? "height" : "block_no", json(0)));
+                                    tip.epoch = json_u64(parsed.value(blockfrost ? "epoch" : "epoch_no", json(0)));
+                                    tip.sync_progress = 100.0;
+                                }
+                                utxo_cache_.observe_tip(tip.height);
+                                promise->set_value(tip); });
+                return future;
+            }
+
+            std::future<SubmissionResult> submit(const std::string &cbor_hex)
+            {
+                SubmissionResult invalid{false, "", "Transaction CBOR is not valid hex", 0};
+                const auto bytes = utils::codec::hex_decode(cbor_hex);
+                if (bytes.empty())
+                {
+                    return ready_future(invalid);
+                }
+
+                auto request = make_request("POST", backend_.type == BackendType::BLOCKFROST ? "/tx/submit" : "/submittx",
+                                            "application/cbor");
+                request.body.assign(bytes.begin(), bytes.end());
+
+                auto promise = std::make_shared<std::promise<SubmissionResult>>();
+                auto future = promise->get_future();
+                http_->send(std::move(request), [this, promise](HttpResponse &&response)
+                            {
+                                record(response);
+                                SubmissionResult result{};
+                                result.submission_timestamp = std::chrono::duration_cast<std::chrono::seconds>(
+                                                                  std::chrono::system_clock::now().time_since_epoch())
+                                                                  .count();
+                                auto parsed = json::parse(response.body, nullptr, false);
+                                if (response.ok())
+                                {
+                                    result.success = true;
+                                    result.tx_hash = parsed.is_string() ? parsed.get<std::string>() : response.body;
+                                    transactions_submitted_.inc();
+                                }
+                                else
+                                {
+                                    result.success = false;
+                                    result.error_message = !response.error.empty() ? response.error
+                                                           : parsed.is_object() && parsed.contains("message")
+                                                               ? parsed["message"].dump()
+                                                               : "HTTP " + std::to_string(response.status);
+                                }
+                                promise->set_value(std::move(result)); });
+                return future;
+            }
+
+            std::future<std::vector<bool>> fetch_confirmations(const std::vector<std::string> &tx_hashes)
+            {
+                struct Gather
+                {
+                    std::vector<bool> confirmed;
+                    std::atomic<size_t> remaining{0};
+                    std::promise<std::vector<bool>> promise;
+                };
+                auto gather = std::make_shared<Gather>();
+                gather->confirmed.assign(tx_hashes.size(), false);
+                auto future = gather->promise.get_future();
+                if (tx_hashes.empty())
+                {
+                    gather->promise.set_value({});
+                    return future;
+                }
+
+                if (backend_.type == BackendType::KOIOS)
+                {
+                    auto request = make_request("POST", "/tx_status", "application/json");
+                    request.body = json{{"_tx_hashes", tx_hashes}}.dump();
+                    http_->send(std::move(request), [this, gather, tx_hashes](HttpResponse &&response)
+                                {
+                                    record(response);
+                                    auto parsed = response.ok() ? json::parse(response.body, nullptr, false) : json();
+                                    std::map<std::string, uint64_t> confirmations;
+                                    if (parsed.is_array())
+                                    {
+                                        for (const auto &entry : parsed)
+                                        {
+                                            confirmations[json_string(entry, "tx_hash")] = json_u64(entry.value("num_confirmations", json(0)));
+                                        }
+                                    }
+                                    for (size_t i = 0; i < tx_hashes.size(); ++i)
+                                    {
+                                        gather->confirmed[i] = confirmations[tx_hashes[i]] > 0;
+                                    }
+                                    gather->promise.set_value(std::move(gather->confirmed)); });
+                    return future;
+                }
+
+                // Blockfrost has no batch lookup: one multiplexed request per hash, 200 = on chain
+                gather->remaining = tx_hashes.size();
+                for (size_t i = 0; i < tx_hashes.size(); ++i)
+                {
+                    if (!is_tx_hash(tx_hashes[i]))
+                    {
+                        // Not a hash, so not on chain; it never reaches the URL
+                        if (gather->remaining.fetch_sub(1) == 1)
+                        {
+                            gather->promise.set_value(std::move(gather->confirmed));
+                        }
+                        continue;
+                    }
+                    http_->send(make_request("GET", "/txs/" + tx_hashes[i]), [this, gather, i](HttpResponse &&response)
+                                {
+                                    record(response);
+                                    gather->confirmed[i] = response.ok();
+                                    if (gather->remaining.fetch_sub(1) == 1)
+                                    {
+                                        gather->promise.set_value(std::move(gather->confirmed));
+                                    } });
+                }
+                return future;
+            }
+
+            std::string mock_block_hash(uint64_t height) const
+            {
+                std::stringstream ss;
+                ss << "block_" << std::hex << height;
+                return ss.str();
+            }
+
+            BlockHeader mock_header(uint64_t height) const
+            {
+                BlockHeader header;
+                header.hash = mock_block_hash(height);
+                header.previous_hash = height > 0 ? mock_block_hash(height - 1) : "";
+                header.slot = height * 20;
+                header.height = height;
+                header.epoch = mock_current_epoch_;
+                return header;
+            }
+
+            // Header of the current tip; false if the backend could not be reached
+            bool follower_tip(BlockHeader &tip)
+            {
+                if (!http_backend())
+                {
+                    const auto mock = generate_mock_tip();
+                    utxo_cache_.observe_tip(mock.height);
+                    tip = mock_header(mock.height);
+                    return true;
+                }
+                const auto chain_tip = await(fetch_tip(), backend_.timeout_ms, ChainTip{});
+                if (chain_tip.hash.empty())
+                {
+                    return false;
+                }
+                tip = BlockHeader{};
+                tip.hash = chain_tip.hash;
+                tip.slot = chain_tip.slot;
+                tip.height = chain_tip.height;
+                tip.epoch = chain_tip.epoch;
+                return true;
+            }
+
+            // Headers after height `after`, oldest first, at most CHAIN_FETCH_LIMIT and none past `to`
+            bool fetch_headers(uint64_t after, uint64_t to, std::vector<BlockHeader> &headers)
+            {
+                const uint64_t count = std::min(CHAIN_FETCH_LIMIT, to - after);
+                if (!http_backend())
+                {
+                    for (uint64_t height = after + 1; height <= after + count; ++height)
+                    {
+                        headers.push_back(mock_header(height));
+                    }
+                    return true;
+                }
+
+                const bool blockfrost = backend_.type == BackendType::BLOCKFROST;
+                const std::string path =
+                    blockfrost ? "/blocks/" + std::to_string(after) + "/next?count=" + std::to_string(count)
+                               : "/blocks?block_height=gt." + std::to_string(after) + "&block_height=lte." +
+                                     std::to_string(after + count) + "&order=block_height.asc&limit=" + std::to_string(count);
+
+                auto promise = std::make_shared<std::promise<json>>();
+                auto future = promise->get_future();
+                http_->send(make_request("GET", path), [this, promise](HttpResponse &&response)
+                            {
+                                record(response);
+                                promise->set_value(response.ok() ? json::parse(response.body, nullptr, false) : json()); });
+                const auto parsed = await(std::move(future), backend_.timeout_ms, json());
+                if (!parsed.is_array())
+                {
+                    return false;
+                }
+                for (const auto &entry : parsed)
+                {
+                    auto header = parse_block_header(entry, blockfrost);
+                    if (header.height > after && header.height <= to)
+                    {
+                        headers.push_back(std::move(header));
+                    }
+                }
+                return true;
+            }
+
+            /**
+             * Transactions of the watched addresses in blocks [from, to]. Neither API
+             * says which of several addresses a transaction matched, so each address
+             * gets its own request; they are multiplexed over the pooled connections.
+             */
+            bool fetch_address_transactions(const std::vector<std::string> &addresses, uint64_t from, uint64_t to,
+                                            std::vector<AddressTransaction> &out)
+            {
+                if (addresses.empty() || !http_backend())
+                {
+                    return true;
+                }
+
+                struct Gather
+                {
+                    std::vector<std::vector<AddressTransaction>> found;
+                    std::atomic<size_t> remaining{0};
+                    std::atomic<bool> failed{false};
+                    std::promise<void> promise;
+                };
+                auto gather = std::make_shared<Gather>();
+                gather->found.resize(addresses.size());
+                gather->remaining = addresses.size();
+                auto future = gather->promise.get_future();
+                const bool blockfrost = backend_.type == BackendType::BLOCKFROST;
+
+                for (size_t i = 0; i < addresses.size(); ++i)
+                {
+                    HttpRequest request;
+                    if (blockfrost && !is_path_safe_address(addresses[i]))
+                    {
+                        // Cannot be in a URL, and no transaction pays to it
+                        utils::Logger::instance().log(utils::LogLevel::WARNING, "CardanoClient",
+                                                      "Skipping transaction query for a malformed address");
+                        if (gather->remaining.fetch_sub(1) == 1)
+                        {
+                            gather->promise.set_value();
+                        }
+                        continue;
+                    }
+                    if (blockfrost)
+                    {
+                        request = make_request("GET", "/addresses/" + addresses[i] + "/transactions?order=asc&count=100&from=" +
+                                                          std::to_string(from) + "&to=" + std::to_string(to));
+                    }
+                    else
+                    {
+                        request = make_request("POST", "/address_txs", "application/json");
+                        request.body = json{{"_addresses", {addresses[i]}}, {"_after_block_height", from - 1}}.dump();
+                    }
+                    http_->send(std::move(request), [this, gather, i, address = addresses[i], from, to](HttpResponse &&response)
+                                {
+                                    record(response);
+                                    auto parsed = response.ok() ? json::parse(response.body, nullptr, false) : json();
+                                    if (parsed.is_array())
+                                    {
+                                        for (const auto &entry : parsed)
+                                        {
+                                            AddressTransaction tx;
+                                            tx.address = address;
+                                            tx.tx_hash = json_string(entry, "tx_hash");
+                                            tx.block_height = json_u64(entry.value("block_height", json(0)));
+                                            if (tx.block_height >= from && tx.block_height <= to)
+                                            {
+                                                gather->found[i].push_back(std::move(tx));
+                                            }
+                                        }
+                                    }
+                                    else if (response.status != 404) // Blockfrost: address never used
+                                    {
+                                        gather->failed = true;
+                                    }
+                                    if (gather->remaining.fetch_sub(1) == 1)
+                                    {
+                                        gather->promise.set_value();
+                                    } });
+                }
+
+                if (future.wait_for(std::chrono::milliseconds(backend_.timeout_ms + 1000)) != std::future_status::ready ||
+                    gather->failed)
+                {
+                    return false;
+                }
+                for (auto &found : gather->found)
+                {
+                    std::move(found.begin(), found.end(), std::back_inserter(out));
+                }
+                return true;
+            }
+
+            struct ChainUpdate
+            {
+                BlockHeader tip;
+                std::vector<BlockHeader> headers;
+                std::map<uint64_t, std::vector<AddressTransaction>> transactions; // by block height
+                bool behind = false; // more blocks remain after this update
+            };
+
+            // Fetch everything the subscriptions have not seen yet; false on a backend failure
+            bool fetch_update(ChainUpdate &update)
+            {
+                uint64_t after = 0;
+                std::vector<std::string> addresses;
+                {
+                    std::lock_guard<std::mutex> lock(subscriptions_mutex_);
+                    std::unordered_set<std::string> unique;
+                    for (const auto &entry : subscriptions_)
+                    {
+                        const auto &state = entry.second;
+                        if (state.cursor.height != 0)
+                        {
+                            after = after == 0 ? state.cursor.height : std::min(after, state.cursor.height);
+                        }
+                        for (const auto &address : state.spec.watched_addresses)
+                        {
+                            if (unique.insert(address).second)
+                            {
+                                addresses.push_back(address);
+                            }
+                        }
+                    }
+                }
+
+                if (!follower_tip(update.tip))
+                {
+                    return false;
+                }
+                if (after == 0 || after >= update.tip.height)
+                {
+                    return true; // fresh subscriptions start at the tip, or nothing new
+                }
+
+                if (!fetch_headers(after, update.tip.height, update.headers))
+                {
+                    return false;
+                }
+                if (update.headers.empty())
+                {
+                    return true;
+                }
+                std::vector<AddressTransaction> transactions;
+                if (!fetch_address_transactions(addresses, update.headers.front().height, update.headers.back().height,
+                                                transactions))
+                {
+                    return false;
+                }
+                for (auto &tx : transactions)
+                {
+                    update.transactions[tx.block_height].push_back(std::move(tx));
+                }
+                update.behind = update.headers.back().height < update.tip.height;
+                return true;
+            }
+
+            static ChainPoint point_of(const BlockHeader &header)
+            {
+                return ChainPoint{header.slot, header.height, header.hash};
+            }
+
+            // Hand an update to every subscription; runs on the follower thread without backend locks
+            void deliver(ChainUpdate &update)
+            {
+                std::lock_guard<std::mutex> delivery_lock(delivery_mutex_);
+                std::vector<uint64_t> ids;
+                {
+                    std::lock_guard<std::mutex> lock(subscriptions_mutex_);
+                    for (const auto &entry : subscriptions_)
+                    {
+                        ids.push_back(entry.first);
+                    }
+                }
+
+                for (uint64_t id : ids)
+                {
+                    SubscriptionState state;
+                    {
+                        std::lock_guard<std::mutex> lock(subscriptions_mutex_);
+                        auto it = subscriptions_.find(id);
+                        if (it == subscriptions_.end())
+                        {
+                            continue;
+                        }
+                        state = it->second;
+                    }
+
+                    ChainPoint cursor = state.cursor;
+                    if (cursor.height == 0)
+                    {
+                        cursor = point_of(update.tip);
+                    }
+                    else if (cursor.height > update.tip.height)
+                    {
+                        // The chain we followed lost blocks; continue from the new tip
+                        if (state.spec.on_rollback)
+                        {
+                            state.spec.on_rollback(cursor);
+                        }
+                        cursor = point_of(update.tip);
+                    }
+                    else
+                    {
+                        const std::unordered_set<std::string> watched(state.spec.watched_addresses.begin(),
+                                                                      state.spec.watched_addresses.end());
+                        for (const auto &header : update.headers)
+                        {
+                            if (header.height <= cursor.height)
+                            {
+                                continue;
+                            }
+                            if (header.height != cursor.height + 1)
+                            {
+                                break; // gap: the next update fetches from this cursor
+                            }
+                            if (!cursor.hash.empty() && !header.previous_hash.empty() && header.previous_hash != cursor.hash)
+                            {
+                                // Our last block is no longer on the chain; step back one block and replay
+                                if (state.spec.on_rollback)
+                                {
+                                    state.spec.on_rollback(cursor);
+                                }
+                                cursor = ChainPoint{0, cursor.height - 1, ""};
+                                update.behind = true;
+                                break;
+                            }
+                            if (state.spec.on_block)
+                            {
+                                state.spec.on_block(header);
+                            }
+                            auto txs = update.transactions.find(header.height);
+                            if (txs != update.transactions.end() && state.spec.on_transaction)
+                            {
+                                for (auto tx : txs->second)
+                                {
+                                    if (watched.count(tx.address) > 0)
+                                    {
+                                        tx.block_hash = header.hash;
+                                        state.spec.on_transaction(tx);
+                                    }
+                                }
+                            }
+                            cursor = point_of(header);
+                        }
+                    }
+
+                    std::lock_guard<std::mutex> lock(subscriptions_mutex_);
+                    auto it = subscriptions_.find(id);
+                    if (it != subscriptions_.end())
+                    {
+                        it->second.cursor = cursor;
+                    }
+                }
+            }
+
+            /**
+             * Follower thread: poll the tip, fetch what is new and deliver it. On a
+             * failure it backs off exponentially and, once the client has dropped to
+             * ERROR, reconnects; cursors are kept, so delivery resumes where it stopped.
+             */
+            void follow(CardanoClient *client)
+            {
+                uint32_t failures = 0;
+                auto next_poll = std::chrono::steady_clock::now();
+                while (true)
+                {
+                    {
+                        std::unique_lock<std::mutex> lock(subscriptions_mutex_);
+                        follower_cv_.wait_until(lock, next_poll, [this]()
+                                                { return follower_stop_; });
+                        if (follower_stop_)
+                        {
+                            return;
+                        }
+                    }
+
+                    uint32_t interval_ms = 1000;
+                    {
+                        std::lock_guard<std::mutex> lock(client_mutex_);
+                        interval_ms = std::max<uint32_t>(10, backend_.chain_poll_interval_ms);
+                    }
+
+                    bool ok = true;
+                    ChainUpdate update;
+                    {
+                        std::lock_guard<std::mutex> follow_lock(follow_mutex_);
+                        if (!client->is_connected())
+                        {
+                            // Only an unexpected drop is retried; an explicit disconnect() leaves the follower idle
+                            ok = client->get_connection_status() != ConnectionStatus::ERROR || client->connect();
+                        }
+                        if (ok && client->is_connected())
+                        {
+                            ok = fetch_update(update);
+                        }
+                    }
+                    if (ok && update.tip.height > 0)
+                    {
+                        deliver(update);
+                    }
+
+                    if (ok)
+                    {
+                        failures = 0;
+                        next_poll = std::chrono::steady_clock::now() +
+                                    std::chrono::milliseconds(update.behind ? 0 : interval_ms);
+                    }
+                    else
+                    {
+                        ++failures;
+                        const uint32_t backoff = std::min<uint32_t>(MAX_FOLLOWER_BACKOFF_MS,
+                                                                    interval_ms << std::min<uint32_t>(failures, 5));
+                        if (failures == 1 || backoff == MAX_FOLLOWER_BACKOFF_MS)
+                        {
+                            utils::Logger::instance().log(utils::LogLevel::WARNING, "CardanoClient",
+                                                          "Chain follower failed to reach backend, retrying in " +
+                                                              std::to_string(backoff) + " ms");
+                        }
+                        if (failures >= 3)
+                        {
+                            std::lock_guard<std::mutex> lock(client_mutex_);
+                            if (status_ == ConnectionStatus::SYNCED || status_ == ConnectionStatus::CONNECTED)
+                            {
+                                status_ = ConnectionStatus::ERROR;
+                            }
+                        }
+                        next_poll = std::chrono::steady_clock::now() + std::chrono::milliseconds(backoff);
+                    }
+                }
+            }
+
+            void stop_follower()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(subscriptions_mutex_);
+                    follower_stop_ = true;
+                }
+                follower_cv_.notify_all();
+                if (follower_.joinable())
+                {
+                    if (follower_.get_id() == std::this_thread::get_id())
+                    {
+                        follower_.detach(); // stopped from one of its own handlers
+                    }
+                    else
+                    {
+                        follower_.join();
+                    }
+                }
+            }
 
             // Generate mock chain tip
             ChainTip generate_mock_tip() const
             {
+                // One slot per second since start, a block roughly every 20 slots
                 ChainTip tip;
-                tip.slot = mock_current_slot_;
-                tip.height = mock_current_slot_ / 20; // Approximate block height
+                tip.slot = mock_current_slot_ + std::chrono::duration_cast<std::chrono::seconds>(
+                                                    std::chrono::steady_clock::now() - mock_start_)
+                                                    .count();
+                tip.height = tip.slot / 20; // Approximate block height
                 tip.epoch = mock_current_epoch_;
                 tip.sync_progress = mock_sync_progress_;
 
@@ -87,6 +1213,13 @@ namespace cardano_iot
                 return utxos;
             }
 
+            // Simulated confirmation check: transactions are confirmed after some time
+            bool mock_confirmed(const std::string &tx_hash) const
+            {
+                // Simulate 80% confirmation rate
+                return (std::hash<std::string>{}(tx_hash) % 10) < 8;
+            }
+
             // Simulate network delay
             void simulate_network_delay() const
             {
@@ -96,22 +1229,16 @@ namespace cardano_iot
             // Update statistics
             void update_query_stats(bool success, double time_ms)
             {
-                std::lock_guard<std::mutex> lock(stats_mutex_);
-                stats_.total_queries++;
-                if (success)
-                {
-                    stats_.successful_queries++;
-                }
-                else
-                {
-                    stats_.failed_queries++;
-                }
-                stats_.avg_query_time_ms = (stats_.avg_query_time_ms + time_ms) / 2.0;
+                (success ? queries_succeeded_ : queries_failed_).inc();
+                query_ms_.observe(time_ms);
             }
         };
 
         CardanoClient::CardanoClient() : pimpl_(std::make_unique<Impl>()) {}
-        CardanoClient::~CardanoClient() = default;
+        CardanoClient::~CardanoClient()
+        {
+            pimpl_->stop_follower();
+        }
 
         bool CardanoClient::initialize(const std::string &node_socket_path, Network network)
         {
@@ -166,11 +1293,19 @@ namespace cardano_iot
                 return;
             }
 
+            // The follower uses the backend and calls into the client, so it goes first
+            pimpl_->stop_follower();
+            {
+                std::lock_guard<std::mutex> lock(pimpl_->subscriptions_mutex_);
+                pimpl_->subscriptions_.clear();
+            }
+
             // Safe to call without holding mutex (disconnect acquires it internally)
             disconnect();
 
             {
                 std::lock_guard<std::mutex> lock(pimpl_->client_mutex_);
+                pimpl_->http_.reset();
                 pimpl_->initialized_ = false;
             }
 
@@ -178,6 +1313,48 @@ namespace cardano_iot
                                           "Cardano client shutdown");
         }
 
+        bool CardanoClient::configure_backend(const BackendConfig &config)
+        {
+            if (config.type != BackendType::MOCK && config.base_url.empty())
+            {
+                utils::Logger::instance().log(utils::LogLevel::ERROR, "CardanoClient",
+                                              "Backend base URL is required");
+                return false;
+            }
+
+            std::lock_guard<std::mutex> follow_lock(pimpl_->follow_mutex_);
+            std::lock_guard<std::mutex> lock(pimpl_->client_mutex_);
+            pimpl_->backend_ = config;
+            pimpl_->http_.reset();
+            pimpl_->utxo_cache_.set_ttl(config.utxo_cache_ttl_ms);
+            pimpl_->utxo_cache_.clear();
+            pimpl_->status_ = ConnectionStatus::DISCONNECTED;
+
+            utils::Logger::instance().log(utils::LogLevel::INFO, "CardanoClient",
+                                          config.type == BackendType::MOCK ? "Using simulated backend"
+                                                                           : "Using HTTP backend: " + config.base_url);
+            return true;
+        }
+
+        void CardanoClient::set_utxo_cache_ttl(uint32_t ttl_ms)
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->client_mutex_);
+            pimpl_->backend_.utxo_cache_ttl_ms = ttl_ms;
+            pimpl_->utxo_cache_.set_ttl(ttl_ms);
+        }
+
+        void CardanoClient::set_executor(std::shared_ptr<utils::Executor> executor)
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->client_mutex_);
+            pimpl_->executor_ = std::move(executor);
+        }
+
+        BackendConfig CardanoClient::get_backend() const
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->client_mutex_);
+            return pimpl_->backend_;
+        }
+
         bool CardanoClient::connect()
         {
             if (!pimpl_->initialized_)
@@ -186,10 +1363,36 @@ namespace cardano_iot
             }
 
             std::lock_guard<std::mutex> lock(pimpl_->client_mutex_);
-            pimpl_->stats_.connection_attempts++;
+            pimpl_->connection_attempts_.inc();
 
             pimpl_->status_ = ConnectionStatus::CONNECTING;
 
+            if (pimpl_->backend_.type != BackendType::MOCK)
+            {
+                if (!pimpl_->http_)
+                {
+                    HttpClient::Options options;
+                    options.max_connections = pimpl_->backend_.max_connections;
+                    options.max_host_connections = pimpl_->backend_.max_connections;
+                    options.timeout_ms = pimpl_->backend_.timeout_ms;
+                    pimpl_->http_ = std::make_unique<HttpClient>(options);
+                }
+
+                // Reachability check through the tip endpoint; also warms the connection pool
+                auto tip = await(pimpl_->fetch_tip(), pimpl_->backend_.timeout_ms, ChainTip{});
+                if (tip.hash.empty())
+                {
+                    pimpl_->status_ = ConnectionStatus::ERROR;
+                    utils::Logger::instance().log(utils::LogLevel::ERROR, "CardanoClient",
+                                                  "Failed to reach backend: " + pimpl_->backend_.base_url);
+                    return false;
+                }
+                pimpl_->status_ = ConnectionStatus::SYNCED;
+                utils::Logger::instance().log(utils::LogLevel::INFO, "CardanoClient",
+                                              "Connected to backend at slot " + std::to_string(tip.slot));
+                return true;
+            }
+
             // Simulate connection time
             std::this_thread::sleep_for(std::chrono::milliseconds(500));
 
@@ -285,7 +1488,7 @@ namespace cardano_iot
             info.peers = {"192.168.1.100", "10.0.0.50", "172.16.0.25"};
 
             auto end_time = std::chrono::high_resolution_clock::now();
-            auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
+            auto duration = std::chrono::duration<double, std::milli>(end_time - start_time).count();
             pimpl_->update_query_stats(true, duration);
 
             utils::Logger::instance().log(utils::LogLevel::INFO, "CardanoClient",
@@ -301,13 +1504,19 @@ namespace cardano_iot
                 return {};
             }
 
+            if (pimpl_->http_backend())
+            {
+                return await(pimpl_->fetch_tip(), pimpl_->backend_.timeout_ms, ChainTip{});
+            }
+
             auto start_time = std::chrono::high_resolution_clock::now();
             pimpl_->simulate_network_delay();
 
             auto tip = pimpl_->generate_mock_tip();
+            pimpl_->utxo_cache_.observe_tip(tip.height);
 
             auto end_time = std::chrono::high_resolution_clock::now();
-            auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
+            auto duration = std::chrono::duration<double, std::milli>(end_time - start_time).count();
             pimpl_->update_query_stats(true, duration);
 
             utils::Logger::instance().log(utils::LogLevel::INFO, "CardanoClient",
@@ -323,28 +1532,115 @@ namespace cardano_iot
                 return {};
             }
 
+            auto batch = query_utxos_batch({address});
+            auto it = batch.find(address);
+            std::vector<UTXOInfo> utxos = it != batch.end() ? std::move(it->second) : std::vector<UTXOInfo>{};
+
+            utils::Logger::instance().log(utils::LogLevel::INFO, "CardanoClient",
+                                          "Queried UTXOs for address: " + address.substr(0, 16) + "... (" +
+                                              std::to_string(utxos.size()) + " UTXOs)");
+
+            return utxos;
+        }
+
+        std::future<std::vector<UTXOInfo>> CardanoClient::query_utxos_async(const std::string &address) const
+        {
+            if (!is_connected())
+            {
+                return ready_future(std::vector<UTXOInfo>{});
+            }
+
+            std::vector<UTXOInfo> cached;
+            if (pimpl_->utxo_cache_.get(address, cached))
+            {
+                return ready_future(std::move(cached));
+            }
+            if (pimpl_->http_backend())
+            {
+                auto promise = std::make_shared<std::promise<std::vector<UTXOInfo>>>();
+                auto future = promise->get_future();
+                pimpl_->fetch_batch({address}, [promise, address](Impl::UtxoBatch &&batch)
+                                    {
+                                        auto it = batch.find(address);
+                                        promise->set_value(it != batch.end() ? std::move(it->second) : std::vector<UTXOInfo>{}); });
+                return future;
+            }
+            return pimpl_->run_async([this, address]()
+                                     { return query_utxos(address); });
+        }
+
+        std::map<std::string, std::vector<UTXOInfo>> CardanoClient::query_utxos_batch(const std::vector<std::string> &addresses) const
+        {
+            if (!is_connected() || addresses.empty())
+            {
+                return {};
+            }
+
             auto start_time = std::chrono::high_resolution_clock::now();
-            pimpl_->simulate_network_delay();
+            Impl::UtxoBatch result;
+            const auto misses = pimpl_->lookup_cached(addresses, result);
 
-            // Check if we have cached UTXOs for this address
-            auto it = pimpl_->address_utxos_.find(address);
-            if (it == pimpl_->address_utxos_.end())
+            if (!misses.empty())
             {
-                // Generate new mock UTXOs
-                pimpl_->address_utxos_[address] = pimpl_->generate_mock_utxos(address);
+                Impl::UtxoBatch fetched;
+                if (pimpl_->http_backend())
+                {
+                    auto promise = std::make_shared<std::promise<Impl::UtxoBatch>>();
+                    auto future = promise->get_future();
+                    pimpl_->fetch_batch(misses, [promise](Impl::UtxoBatch &&batch)
+                                        { promise->set_value(std::move(batch)); });
+                    fetched = await(std::move(future), pimpl_->backend_.timeout_ms, Impl::UtxoBatch{});
+                }
+                else
+                {
+                    fetched = pimpl_->mock_batch(misses);
+                    auto end_time = std::chrono::high_resolution_clock::now();
+                    auto duration = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+                    pimpl_->update_query_stats(true, duration);
+                }
+                result.merge(fetched);
             }
 
-            auto utxos = pimpl_->address_utxos_[address];
+            CARDANO_IOT_LOG(utils::LogLevel::DEBUG, "CardanoClient",
+                            "Batched UTXO query: " << addresses.size() << " addresses, " << misses.size()
+                                                   << " fetched, " << result.size() << " answered");
+            return result;
+        }
 
-            auto end_time = std::chrono::high_resolution_clock::now();
-            auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
-            pimpl_->update_query_stats(true, duration);
+        std::future<std::map<std::string, std::vector<UTXOInfo>>> CardanoClient::query_utxos_batch_async(
+            const std::vector<std::string> &addresses) const
+        {
+            if (!is_connected() || addresses.empty())
+            {
+                return ready_future(Impl::UtxoBatch{});
+            }
+            if (!pimpl_->http_backend())
+            {
+                return pimpl_->run_async([this, addresses]()
+                                         { return query_utxos_batch(addresses); });
+            }
 
-            utils::Logger::instance().log(utils::LogLevel::INFO, "CardanoClient",
-                                          "Queried UTXOs for address: " + address.substr(0, 16) + "... (" +
-                                              std::to_string(utxos.size()) + " UTXOs)");
+            auto hits = std::make_shared<Impl::UtxoBatch>();
+            const auto misses = pimpl_->lookup_cached(addresses, *hits);
+            auto promise = std::make_shared<std::promise<Impl::UtxoBatch>>();
+            auto future = promise->get_future();
+            pimpl_->fetch_batch(misses, [promise, hits](Impl::UtxoBatch &&batch)
+                                {
+                                    hits->merge(batch);
+                                    promise->set_value(std::move(*hits)); });
+            return future;
+        }
 
-            return utxos;
+        void CardanoClient::invalidate_utxo_cache(const std::string &address)
+        {
+            if (address.empty())
+            {
+                pimpl_->utxo_cache_.clear();
+            }
+            else
+            {
+                pimpl_->utxo_cache_.invalidate(address);
+            }
         }
 
         uint64_t CardanoClient::get_address_balance(const std::string &address) const
@@ -370,6 +1666,12 @@ namespace cardano_iot
                 return {false, "", "Not connected to node", 0};
             }
 
+            if (pimpl_->http_backend())
+            {
+                return await(pimpl_->submit(cbor_hex), pimpl_->backend_.timeout_ms,
+                             SubmissionResult{false, "", "Backend timeout", 0});
+            }
+
             auto start_time = std::chrono::high_resolution_clock::now();
             pimpl_->simulate_network_delay();
 
@@ -393,10 +1695,7 @@ namespace cardano_iot
                 result.error_message = "";
 
                 // Update statistics
-                {
-                    std::lock_guard<std::mutex> lock(pimpl_->stats_mutex_);
-                    pimpl_->stats_.transactions_submitted++;
-                }
+                pimpl_->transactions_submitted_.inc();
 
                 utils::Logger::instance().log(utils::LogLevel::INFO, "CardanoClient",
                                               "Transaction submitted successfully: " + result.tx_hash);
@@ -412,12 +1711,26 @@ namespace cardano_iot
             }
 
             auto end_time = std::chrono::high_resolution_clock::now();
-            auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
+            auto duration = std::chrono::duration<double, std::milli>(end_time - start_time).count();
             pimpl_->update_query_stats(result.success, duration);
 
             return result;
         }
 
+        std::future<SubmissionResult> CardanoClient::submit_transaction_async(const std::string &cbor_hex) const
+        {
+            if (!is_connected())
+            {
+                return ready_future(SubmissionResult{false, "", "Not connected to node", 0});
+            }
+            if (pimpl_->http_backend())
+            {
+                return pimpl_->submit(cbor_hex);
+            }
+            return pimpl_->run_async([this, cbor_hex]()
+                                     { return submit_transaction(cbor_hex); });
+        }
+
         bool CardanoClient::is_transaction_confirmed(const std::string &tx_hash) const
         {
             if (!is_connected())
@@ -425,15 +1738,14 @@ namespace cardano_iot
                 return false;
             }
 
-            pimpl_->simulate_network_delay();
+            if (pimpl_->http_backend())
+            {
+                return are_transactions_confirmed({tx_hash}).front();
+            }
 
-            // Simulate transaction confirmation check
-            // For demo, assume transactions are confirmed after some time
-            std::hash<std::string> hasher;
-            auto hash_value = hasher(tx_hash);
+            pimpl_->simulate_network_delay();
 
-            // Simulate 80% confirmation rate
-            bool confirmed = (hash_value % 10) < 8;
+            bool confirmed = pimpl_->mock_confirmed(tx_hash);
 
             utils::Logger::instance().log(utils::LogLevel::INFO, "CardanoClient",
                                           "Transaction " + tx_hash + " confirmation status: " +
@@ -442,6 +1754,111 @@ namespace cardano_iot
             return confirmed;
         }
 
+        std::vector<bool> CardanoClient::are_transactions_confirmed(const std::vector<std::string> &tx_hashes) const
+        {
+            std::vector<bool> confirmed(tx_hashes.size(), false);
+            if (!is_connected() || tx_hashes.empty())
+            {
+                return confirmed;
+            }
+
+            if (pimpl_->http_backend())
+            {
+                auto result = await(pimpl_->fetch_confirmations(tx_hashes), pimpl_->backend_.timeout_ms, confirmed);
+                return result.size() == tx_hashes.size() ? result : confirmed;
+            }
+
+            auto start_time = std::chrono::high_resolution_clock::now();
+            pimpl_->simulate_network_delay();
+
+            size_t confirmed_count = 0;
+            for (size_t i = 0; i < tx_hashes.size(); ++i)
+            {
+                confirmed[i] = pimpl_->mock_confirmed(tx_hashes[i]);
+                confirmed_count += confirmed[i] ? 1 : 0;
+            }
+
+            auto end_time = std::chrono::high_resolution_clock::now();
+            auto duration = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+            pimpl_->update_query_stats(true, duration);
+
+            CARDANO_IOT_LOG(utils::LogLevel::DEBUG, "CardanoClient",
+                            "Batch confirmation query: " << confirmed_count << "/" << tx_hashes.size() << " confirmed");
+
+            return confirmed;
+        }
+
+        uint64_t CardanoClient::subscribe_chain(ChainSubscription subscription)
+        {
+            {
+                std::lock_guard<std::mutex> lock(pimpl_->client_mutex_);
+                if (!pimpl_->initialized_)
+                {
+                    return 0;
+                }
+            }
+
+            uint64_t id = 0;
+            {
+                std::lock_guard<std::mutex> lock(pimpl_->subscriptions_mutex_);
+                id = pimpl_->next_subscription_id_++;
+                Impl::SubscriptionState state;
+                state.cursor = subscription.resume_from;
+                state.spec = std::move(subscription);
+                pimpl_->subscriptions_.emplace(id, std::move(state));
+
+                if (!pimpl_->follower_.joinable())
+                {
+                    pimpl_->follower_stop_ = false;
+                    pimpl_->follower_ = std::thread([this]()
+                                                    { pimpl_->follow(this); });
+                }
+            }
+            pimpl_->follower_cv_.notify_all();
+
+            utils::Logger::instance().log(utils::LogLevel::INFO, "CardanoClient",
+                                          "Chain subscription " + std::to_string(id) + " added");
+            return id;
+        }
+
+        bool CardanoClient::unsubscribe_chain(uint64_t subscription_id)
+        {
+            bool on_follower = false;
+            {
+                std::lock_guard<std::mutex> lock(pimpl_->subscriptions_mutex_);
+                if (pimpl_->subscriptions_.erase(subscription_id) == 0)
+                {
+                    return false;
+                }
+                on_follower = pimpl_->follower_.get_id() == std::this_thread::get_id();
+            }
+            if (!on_follower)
+            {
+                // Once this returns no handler of the subscription is running or will run
+                std::lock_guard<std::mutex> delivery_lock(pimpl_->delivery_mutex_);
+            }
+            return true;
+        }
+
+        bool CardanoClient::set_watched_addresses(uint64_t subscription_id, const std::vector<std::string> &addresses)
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->subscriptions_mutex_);
+            auto it = pimpl_->subscriptions_.find(subscription_id);
+            if (it == pimpl_->subscriptions_.end())
+            {
+                return false;
+            }
+            it->second.spec.watched_addresses = addresses;
+            return true;
+        }
+
+        ChainPoint CardanoClient::get_subscription_point(uint64_t subscription_id) const
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->subscriptions_mutex_);
+            auto it = pimpl_->subscriptions_.find(subscription_id);
+            return it != pimpl_->subscriptions_.end() ? it->second.cursor : ChainPoint{};
+        }
+
         bool CardanoClient::validate_address(const std::string &address) const
         {
             // Simple validation for demo
@@ -456,9 +1873,9 @@ namespace cardano_iot
                                 (address.find("stake1") == 0) ||    // Mainnet stake
                                 (address.find("stake_test") == 0);  // Testnet stake
 
-            utils::Logger::instance().log(utils::LogLevel::DEBUG, "CardanoClient",
-                                          "Address validation: " + address.substr(0, 16) + "... -> " +
-                                              (valid_prefix ? "valid" : "invalid"));
+            CARDANO_IOT_LOG(utils::LogLevel::DEBUG, "CardanoClient",
+                            "Address validation: " << address.substr(0, 16) << "... -> "
+                                                   << (valid_prefix ? "valid" : "invalid"));
 
             return valid_prefix;
         }
@@ -475,14 +1892,33 @@ namespace cardano_iot
 
         CardanoClient::ClientStats CardanoClient::get_statistics() const
         {
-            std::lock_guard<std::mutex> lock(pimpl_->stats_mutex_);
-            return pimpl_->stats_;
+            ClientStats stats = {};
+            stats.successful_queries = pimpl_->queries_succeeded_.value();
+            stats.failed_queries = pimpl_->queries_failed_.value();
+            stats.total_queries = stats.successful_queries + stats.failed_queries;
+            stats.transactions_submitted = pimpl_->transactions_submitted_.value();
+            stats.connection_attempts = pimpl_->connection_attempts_.value();
+            const auto queries = pimpl_->query_ms_.snapshot();
+            stats.avg_query_time_ms = queries.mean();
+            stats.p95_query_time_ms = queries.quantile(0.95);
+            stats.cache_hits = pimpl_->utxo_cache_.hits();
+            stats.cache_misses = pimpl_->utxo_cache_.misses();
+            const uint64_t lookups = stats.cache_hits + stats.cache_misses;
+            stats.cache_hit_rate = lookups == 0 ? 0.0 : static_cast<double>(stats.cache_hits) / static_cast<double>(lookups);
+            stats.utxo_round_trips = pimpl_->utxo_round_trips_.load(std::memory_order_relaxed);
+            return stats;
         }
 
         void CardanoClient::reset_statistics()
         {
-            std::lock_guard<std::mutex> lock(pimpl_->stats_mutex_);
-            pimpl_->stats_ = {};
+            for (auto *counter : {&pimpl_->queries_succeeded_, &pimpl_->queries_failed_,
+                                  &pimpl_->transactions_submitted_, &pimpl_->connection_attempts_})
+            {
+                counter->reset();
+            }
+            pimpl_->query_ms_.reset();
+            pimpl_->utxo_cache_.reset_counters();
+            pimpl_->utxo_round_trips_.store(0, std::memory_order_relaxed);
 
             utils::Logger::instance().log(utils::LogLevel::INFO, "CardanoClient",
                                           "Statistics reset");
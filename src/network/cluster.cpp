@@ -0,0 +1,497 @@
+#include "cardano_iot/network/cluster.h"
+#include "cardano_iot/network/p2p_network.h"
+#include "cardano_iot/utils/executor.h"
+#include "cardano_iot/utils/logger.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <unordered_map>
+
+namespace cardano_iot
+{
+    namespace network
+    {
+        namespace
+        {
+            uint64_t now_seconds()
+            {
+                return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::seconds>(
+                                                 std::chrono::system_clock::now().time_since_epoch())
+                                                 .count());
+            }
+        } // namespace
+
+        struct GatewayCluster::Impl
+        {
+            struct Pending
+            {
+                bool done = false;
+                bool ok = false;
+                std::string response;
+            };
+
+            Options options_;
+            utils::Executor *executor_ = nullptr;
+            P2PNetwork network_;
+            std::string node_id_;
+            std::atomic<bool> running_{false};
+
+            std::shared_ptr<const HashRing> ring_; // accessed with std::atomic_load/store only
+            std::vector<std::string> members_;     // Other members, sorted; membership thread only
+            bool callback_pending_ = false;        // The last membership callback asked to be retried
+
+            std::mutex handlers_mutex_;
+            std::map<std::string, RequestHandler> handlers_;
+            MembershipCallback membership_callback_;
+
+            std::mutex pending_mutex_;
+            std::condition_variable pending_cv_;
+            std::unordered_map<std::string, std::shared_ptr<Pending>> pending_;
+            std::atomic<uint64_t> next_request_{1};
+
+            // Requests being served, so stop() can wait for their handlers
+            std::mutex serving_mutex_;
+            std::condition_variable serving_cv_;
+            size_t serving_ = 0;
+
+            std::thread membership_thread_;
+            std::mutex membership_mutex_;
+            std::condition_variable membership_cv_;
+            bool stopping_ = false;
+
+            std::atomic<uint64_t> requests_sent_{0};
+            std::atomic<uint64_t> requests_served_{0};
+            std::atomic<uint64_t> requests_failed_{0};
+            std::atomic<uint64_t> membership_changes_{0};
+
+            void connect_seeds()
+            {
+                for (const auto &seed : options_.seeds)
+                {
+                    if (!network_.connect_to_peer(seed))
+                    {
+                        utils::Logger::instance().log(utils::LogLevel::WARNING, "GatewayCluster",
+                                                      "Cluster seed unreachable: " + seed);
+                    }
+                }
+            }
+
+            // Members are the gateways this node can reach: neighbours and their routed destinations
+            std::vector<std::string> reachable_nodes() const
+            {
+                std::set<std::string> nodes;
+                for (const auto &[node, routed] : network_.get_mesh_topology().connections)
+                {
+                    nodes.insert(node);
+                    nodes.insert(routed.begin(), routed.end());
+                }
+                for (const auto &peer : network_.get_connected_peers())
+                {
+                    nodes.insert(peer.peer_id);
+                }
+                nodes.erase(node_id_);
+                return std::vector<std::string>(nodes.begin(), nodes.end());
+            }
+
+            void refresh_membership()
+            {
+                auto members = reachable_nodes();
+                if (members != members_)
+                {
+                    members_ = std::move(members);
+                    auto ring = std::make_shared<HashRing>(options_.virtual_nodes);
+                    ring->add_node(node_id_);
+                    for (const auto &member : members_)
+                    {
+                        ring->add_node(member);
+                    }
+                    std::atomic_store(&ring_, std::shared_ptr<const HashRing>(ring));
+                    ++membership_changes_;
+                    callback_pending_ = true;
+                    utils::Logger::instance().log(utils::LogLevel::INFO, "GatewayCluster",
+                                                  "Cluster membership changed: " + std::to_string(ring->size()) +
+                                                      " nodes");
+                }
+                if (!callback_pending_)
+                {
+                    return;
+                }
+
+                MembershipCallback callback;
+                {
+                    std::lock_guard<std::mutex> lock(handlers_mutex_);
+                    callback = membership_callback_;
+                }
+                callback_pending_ = callback && !callback(*std::atomic_load(&ring_));
+            }
+
+            void run_membership()
+            {
+                std::unique_lock<std::mutex> lock(membership_mutex_);
+                while (!stopping_)
+                {
+                    lock.unlock();
+                    if (!options_.seeds.empty() && network_.get_connected_peers().empty())
+                    {
+                        connect_seeds();
+                    }
+                    refresh_membership();
+                    lock.lock();
+                    membership_cv_.wait_for(lock, std::chrono::milliseconds(options_.membership_interval_ms),
+                                            [this]()
+                                            { return stopping_; });
+                }
+            }
+
+            void send_response(const std::string &to, const std::string &request_id, bool ok, const std::string &body)
+            {
+                NetworkMessage response;
+                response.message_id = request_id;
+                response.type = MessageType::CLUSTER_RESPONSE;
+                response.sender_id = node_id_;
+                response.recipient_id = to;
+                response.payload.reserve(body.size() + 1);
+                response.payload.push_back(ok ? 1 : 0);
+                response.payload.insert(response.payload.end(), body.begin(), body.end());
+                response.timestamp = now_seconds();
+                response.encrypted = false;
+                network_.send_message(to, response);
+            }
+
+            // Request payload: kind, a zero byte, then the body
+            void handle_request(const NetworkMessage &message)
+            {
+                const auto separator = std::find(message.payload.begin(), message.payload.end(), 0);
+                if (separator == message.payload.end() || message.sender_id.empty())
+                {
+                    return;
+                }
+                std::string kind(message.payload.begin(), separator);
+                std::string body(separator + 1, message.payload.end());
+                {
+                    std::lock_guard<std::mutex> lock(serving_mutex_);
+                    ++serving_;
+                }
+
+                auto serve = [this, kind = std::move(kind), body = std::move(body), from = message.sender_id,
+                              id = message.message_id]()
+                {
+                    RequestHandler handler;
+                    {
+                        std::lock_guard<std::mutex> lock(handlers_mutex_);
+                        auto it = handlers_.find(kind);
+                        if (it != handlers_.end())
+                        {
+                            handler = it->second;
+                        }
+                    }
+                    std::string response;
+                    const bool ok = handler && handler(body, response);
+                    if (!handler)
+                    {
+                        response = "Unknown request kind: " + kind;
+                    }
+                    send_response(from, id, ok, response);
+                    ++requests_served_;
+
+                    std::lock_guard<std::mutex> lock(serving_mutex_);
+                    --serving_;
+                    serving_cv_.notify_all();
+                };
+                if (!executor_ || !executor_->post(serve))
+                {
+                    serve();
+                }
+            }
+
+            void handle_response(const NetworkMessage &message)
+            {
+                std::lock_guard<std::mutex> lock(pending_mutex_);
+                auto it = pending_.find(message.message_id);
+                if (it == pending_.end() || message.payload.empty())
+                {
+                    return;
+                }
+                it->second->done = true;
+                it->second->ok = message.payload.front() == 1;
+                it->second->response.assign(message.payload.begin() + 1, message.payload.end());
+                pending_cv_.notify_all();
+            }
+
+            // Send a request; returns its id, or empty if it could not be sent
+            std::string send_request(const std::string &node, const std::string &kind, const std::string &body)
+            {
+                const std::string id = node_id_ + ":" + std::to_string(next_request_++);
+                {
+                    std::lock_guard<std::mutex> lock(pending_mutex_);
+                    pending_.emplace(id, std::make_shared<Pending>());
+                }
+
+                NetworkMessage request;
+                request.message_id = id;
+                request.type = MessageType::CLUSTER_REQUEST;
+                request.sender_id = node_id_;
+                request.recipient_id = node;
+                request.payload.reserve(kind.size() + 1 + body.size());
+                request.payload.insert(request.payload.end(), kind.begin(), kind.end());
+                request.payload.push_back(0);
+                request.payload.insert(request.payload.end(), body.begin(), body.end());
+                request.timestamp = now_seconds();
+                request.encrypted = false;
+                ++requests_sent_;
+                if (!network_.send_message(node, request))
+                {
+                    std::lock_guard<std::mutex> lock(pending_mutex_);
+                    pending_.erase(id);
+                    ++requests_failed_;
+                    return "";
+                }
+                return id;
+            }
+
+            // Wait for a request sent by send_request(); removes it either way
+            bool wait_response(const std::string &id, std::chrono::steady_clock::time_point deadline,
+                               std::string &response)
+            {
+                std::unique_lock<std::mutex> lock(pending_mutex_);
+                auto it = pending_.find(id);
+                if (it == pending_.end())
+                {
+                    return false;
+                }
+                auto pending = it->second;
+                pending_cv_.wait_until(lock, deadline, [&pending]()
+                                       { return pending->done; });
+                pending_.erase(id);
+                if (!pending->done || !pending->ok)
+                {
+                    ++requests_failed_;
+                    return false;
+                }
+                response = std::move(pending->response);
+                return true;
+            }
+
+            std::chrono::steady_clock::time_point deadline() const
+            {
+                return std::chrono::steady_clock::now() + std::chrono::milliseconds(options_.request_timeout_ms);
+            }
+        };
+
+        GatewayCluster::GatewayCluster() : pimpl_(std::make_unique<Impl>()) {}
+
+        GatewayCluster::~GatewayCluster()
+        {
+            stop();
+        }
+
+        bool GatewayCluster::start(const Options &options, utils::Executor *executor)
+        {
+            if (pimpl_->running_)
+            {
+                return true;
+            }
+            pimpl_->options_ = options;
+            pimpl_->options_.membership_interval_ms = std::max<uint32_t>(10, options.membership_interval_ms);
+            pimpl_->executor_ = executor;
+
+            P2PNetwork::P2PConfig config;
+            config.listen_address = options.listen_address;
+            config.listen_port = options.port;
+            config.network_id = options.network_id;
+            config.connection_timeout_ms = options.request_timeout_ms;
+            config.io_threads = options.io_threads;
+            config.max_message_bytes = options.max_message_bytes;
+            config.enable_discovery = false;
+            config.enable_mesh_routing = true;
+            pimpl_->network_.update_config(config);
+            if (!pimpl_->network_.initialize(options.listen_address, options.port) ||
+                !pimpl_->network_.start_listening())
+            {
+                utils::Logger::instance().log(utils::LogLevel::ERROR, "GatewayCluster",
+                                              "Failed to listen on " + options.listen_address + ":" +
+                                                  std::to_string(options.port));
+                pimpl_->network_.shutdown();
+                return false;
+            }
+            pimpl_->node_id_ = pimpl_->network_.get_local_peer_id();
+
+            Impl *impl = pimpl_.get();
+            pimpl_->network_.set_message_handler(MessageType::CLUSTER_REQUEST, [impl](const NetworkMessage &message)
+                                                 { impl->handle_request(message); });
+            pimpl_->network_.set_message_handler(MessageType::CLUSTER_RESPONSE, [impl](const NetworkMessage &message)
+                                                 { impl->handle_response(message); });
+
+            auto ring = std::make_shared<HashRing>(options.virtual_nodes);
+            ring->add_node(pimpl_->node_id_);
+            std::atomic_store(&pimpl_->ring_, std::shared_ptr<const HashRing>(ring));
+            pimpl_->members_.clear();
+
+            pimpl_->connect_seeds();
+            {
+                std::lock_guard<std::mutex> lock(pimpl_->membership_mutex_);
+                pimpl_->stopping_ = false;
+            }
+            pimpl_->running_ = true;
+            pimpl_->membership_thread_ = std::thread([impl]()
+                                                     { impl->run_membership(); });
+
+            utils::Logger::instance().log(utils::LogLevel::INFO, "GatewayCluster",
+                                          "Gateway node " + pimpl_->node_id_ + " listening on " + endpoint());
+            return true;
+        }
+
+        void GatewayCluster::stop()
+        {
+            if (!pimpl_->running_.exchange(false))
+            {
+                return;
+            }
+            {
+                std::lock_guard<std::mutex> lock(pimpl_->membership_mutex_);
+                pimpl_->stopping_ = true;
+            }
+            pimpl_->membership_cv_.notify_all();
+            if (pimpl_->membership_thread_.joinable())
+            {
+                pimpl_->membership_thread_.join();
+            }
+
+            // Handlers still running answer before the network goes away
+            {
+                std::unique_lock<std::mutex> lock(pimpl_->serving_mutex_);
+                pimpl_->serving_cv_.wait_for(lock, std::chrono::milliseconds(pimpl_->options_.request_timeout_ms),
+                                             [this]()
+                                             { return pimpl_->serving_ == 0; });
+            }
+            {
+                std::lock_guard<std::mutex> lock(pimpl_->pending_mutex_);
+                for (auto &[id, pending] : pimpl_->pending_)
+                {
+                    pending->done = true;
+                    pending->ok = false;
+                }
+                pimpl_->pending_cv_.notify_all();
+            }
+            pimpl_->network_.shutdown();
+
+            utils::Logger::instance().log(utils::LogLevel::INFO, "GatewayCluster",
+                                          "Gateway node " + pimpl_->node_id_ + " left the cluster");
+        }
+
+        bool GatewayCluster::is_running() const
+        {
+            return pimpl_->running_;
+        }
+
+        std::string GatewayCluster::node_id() const
+        {
+            return pimpl_->node_id_;
+        }
+
+        std::string GatewayCluster::endpoint() const
+        {
+            return pimpl_->options_.listen_address + ":" + std::to_string(pimpl_->network_.get_listening_port());
+        }
+
+        std::shared_ptr<const HashRing> GatewayCluster::ring() const
+        {
+            return std::atomic_load(&pimpl_->ring_);
+        }
+
+        std::string GatewayCluster::owner(const std::string &key) const
+        {
+            const auto ring = this->ring();
+            return ring && pimpl_->running_ ? ring->owner(key) : pimpl_->node_id_;
+        }
+
+        bool GatewayCluster::is_local(const std::string &key) const
+        {
+            return owner(key) == pimpl_->node_id_;
+        }
+
+        std::vector<std::string> GatewayCluster::members() const
+        {
+            std::vector<std::string> members;
+            if (const auto ring = this->ring())
+            {
+                for (const auto &node : ring->nodes())
+                {
+                    if (node != pimpl_->node_id_)
+                    {
+                        members.push_back(node);
+                    }
+                }
+            }
+            return members;
+        }
+
+        void GatewayCluster::set_request_handler(const std::string &kind, RequestHandler handler)
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->handlers_mutex_);
+            pimpl_->handlers_[kind] = std::move(handler);
+        }
+
+        void GatewayCluster::set_membership_callback(MembershipCallback callback)
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->handlers_mutex_);
+            pimpl_->membership_callback_ = std::move(callback);
+        }
+
+        bool GatewayCluster::call(const std::string &node, const std::string &kind, const std::string &body,
+                                  std::string &response)
+        {
+            if (!pimpl_->running_)
+            {
+                return false;
+            }
+            const std::string id = pimpl_->send_request(node, kind, body);
+            return !id.empty() && pimpl_->wait_response(id, pimpl_->deadline(), response);
+        }
+
+        std::map<std::string, std::string> GatewayCluster::call_all(const std::string &kind, const std::string &body)
+        {
+            std::map<std::string, std::string> answers;
+            if (!pimpl_->running_)
+            {
+                return answers;
+            }
+
+            std::vector<std::pair<std::string, std::string>> sent; // (node, request id)
+            for (const auto &node : members())
+            {
+                std::string id = pimpl_->send_request(node, kind, body);
+                if (!id.empty())
+                {
+                    sent.emplace_back(node, std::move(id));
+                }
+            }
+            const auto deadline = pimpl_->deadline();
+            for (const auto &[node, id] : sent)
+            {
+                std::string response;
+                if (pimpl_->wait_response(id, deadline, response))
+                {
+                    answers.emplace(node, std::move(response));
+                }
+            }
+            return answers;
+        }
+
+        GatewayCluster::Stats GatewayCluster::stats() const
+        {
+            Stats stats;
+            stats.requests_sent = pimpl_->requests_sent_.load();
+            stats.requests_served = pimpl_->requests_served_.load();
+            stats.requests_failed = pimpl_->requests_failed_.load();
+            stats.membership_changes = pimpl_->membership_changes_.load();
+            return stats;
+        }
+
+    } // namespace network
+} // namespace cardano_iot
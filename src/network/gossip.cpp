@@ -0,0 +1,448 @@
+#include "cardano_iot/network/gossip.h"
+#include "cardano_iot/network/wire_format.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace cardano_iot
+{
+    namespace network
+    {
+        namespace
+        {
+            constexpr size_t MAX_MISSING = 4096;
+
+            uint64_t fnv1a(std::string_view data)
+            {
+                uint64_t hash = 1469598103934665603ull;
+                for (const char c : data)
+                {
+                    hash ^= static_cast<uint8_t>(c);
+                    hash *= 1099511628211ull;
+                }
+                return hash;
+            }
+
+            uint64_t mix(uint64_t value)
+            {
+                value += 0x9e3779b97f4a7c15ull;
+                value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+                value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+                return value ^ (value >> 31);
+            }
+
+            void put_varint(std::vector<uint8_t> &out, uint64_t value)
+            {
+                uint8_t buffer[wire::MAX_VARINT_BYTES];
+                out.insert(out.end(), buffer, buffer + wire::put_varint(value, buffer));
+            }
+
+            std::vector<uint8_t> encode_ids(const std::vector<std::string> &ids)
+            {
+                std::vector<uint8_t> out;
+                put_varint(out, ids.size());
+                for (const auto &id : ids)
+                {
+                    put_varint(out, id.size());
+                    out.insert(out.end(), id.begin(), id.end());
+                }
+                return out;
+            }
+
+            bool decode_ids(const uint8_t *data, size_t size, std::vector<std::string> &ids)
+            {
+                uint64_t count = 0;
+                size_t offset = wire::get_varint(data, size, count);
+                if (offset == 0 || count > size)
+                {
+                    return false;
+                }
+                ids.reserve(static_cast<size_t>(count));
+                for (uint64_t i = 0; i < count; ++i)
+                {
+                    uint64_t length = 0;
+                    const size_t consumed = wire::get_varint(data + offset, size - offset, length);
+                    if (consumed == 0 || length > size - offset - consumed)
+                    {
+                        return false;
+                    }
+                    offset += consumed;
+                    ids.emplace_back(reinterpret_cast<const char *>(data + offset), static_cast<size_t>(length));
+                    offset += static_cast<size_t>(length);
+                }
+                return true;
+            }
+        } // namespace
+
+        SeenFilter::SeenFilter(size_t capacity, double false_positive_rate) : capacity_(std::max<size_t>(1, capacity))
+        {
+            const double rate = std::min(0.5, std::max(1e-9, false_positive_rate));
+            const double ln2 = std::log(2.0);
+            const double bits = std::ceil(-static_cast<double>(capacity_) * std::log(rate) / (ln2 * ln2));
+            bit_count_ = std::max<size_t>(64, (static_cast<size_t>(bits) + 63) / 64 * 64);
+            hash_count_ = std::max<uint32_t>(1, static_cast<uint32_t>(std::lround(bit_count_ / static_cast<double>(capacity_) * ln2)));
+            current_.assign(bit_count_ / 64, 0);
+            previous_.assign(bit_count_ / 64, 0);
+        }
+
+        bool SeenFilter::test(const std::vector<uint64_t> &bits, uint64_t h1, uint64_t h2) const
+        {
+            for (uint32_t i = 0; i < hash_count_; ++i)
+            {
+                const uint64_t bit = (h1 + i * h2) % bit_count_;
+                if ((bits[bit >> 6] & (1ull << (bit & 63))) == 0)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool SeenFilter::contains(std::string_view id) const
+        {
+            const uint64_t h1 = fnv1a(id);
+            const uint64_t h2 = mix(h1) | 1;
+            return test(current_, h1, h2) || test(previous_, h1, h2);
+        }
+
+        bool SeenFilter::insert(std::string_view id)
+        {
+            const uint64_t h1 = fnv1a(id);
+            const uint64_t h2 = mix(h1) | 1;
+            if (test(current_, h1, h2) || test(previous_, h1, h2))
+            {
+                return false;
+            }
+            if (inserted_ >= capacity_)
+            {
+                previous_.swap(current_);
+                std::fill(current_.begin(), current_.end(), 0);
+                inserted_ = 0;
+            }
+            for (uint32_t i = 0; i < hash_count_; ++i)
+            {
+                const uint64_t bit = (h1 + i * h2) % bit_count_;
+                current_[bit >> 6] |= 1ull << (bit & 63);
+            }
+            ++inserted_;
+            return true;
+        }
+
+        GossipEngine::GossipEngine(const Config &config)
+            : config_(config), seen_(config.seen_capacity, config.false_positive_rate)
+        {
+            config_.max_ihave_batch = std::max<size_t>(1, config_.max_ihave_batch);
+        }
+
+        bool GossipEngine::is_gossip_type(MessageType type)
+        {
+            return type == MessageType::BROADCAST || type == MessageType::GOSSIP_IHAVE ||
+                   type == MessageType::GOSSIP_GRAFT || type == MessageType::GOSSIP_PRUNE;
+        }
+
+        void GossipEngine::add_peer(const std::string &peer_id)
+        {
+            auto [it, inserted] = peers_.try_emplace(peer_id);
+            if (inserted && (config_.eager_fanout == 0 || eager_count_ < config_.eager_fanout))
+            {
+                it->second.eager = true;
+                ++eager_count_;
+            }
+        }
+
+        void GossipEngine::remove_peer(const std::string &peer_id)
+        {
+            auto it = peers_.find(peer_id);
+            if (it == peers_.end())
+            {
+                return;
+            }
+            if (it->second.eager)
+            {
+                --eager_count_;
+            }
+            peers_.erase(it);
+        }
+
+        bool GossipEngine::is_eager(const std::string &peer_id) const
+        {
+            auto it = peers_.find(peer_id);
+            return it != peers_.end() && it->second.eager;
+        }
+
+        void GossipEngine::set_eager(const std::string &peer_id, bool eager)
+        {
+            auto it = peers_.find(peer_id);
+            if (it == peers_.end() || it->second.eager == eager)
+            {
+                return;
+            }
+            it->second.eager = eager;
+            eager ? ++eager_count_ : --eager_count_;
+        }
+
+        void GossipEngine::remember(const std::string &id, const uint8_t *data, size_t size)
+        {
+            if (config_.cache_messages == 0 || cache_.count(id))
+            {
+                return;
+            }
+            cache_.emplace(id, std::vector<uint8_t>(data, data + size));
+            cache_order_.push_back(id);
+            while (cache_order_.size() > config_.cache_messages)
+            {
+                cache_.erase(cache_order_.front());
+                cache_order_.pop_front();
+            }
+        }
+
+        GossipEngine::Outgoing GossipEngine::control(const std::string &peer_id, MessageType type,
+                                                     const std::vector<std::string> &ids) const
+        {
+            Outgoing outgoing;
+            outgoing.peer_id = peer_id;
+            outgoing.message.type = type;
+            outgoing.message.sender_id = config_.local_id;
+            outgoing.message.timestamp = 0;
+            outgoing.message.encrypted = false;
+            if (!ids.empty())
+            {
+                outgoing.message.payload = encode_ids(ids);
+            }
+            return outgoing;
+        }
+
+        void GossipEngine::flush_batch(const std::string &peer_id, PeerState &peer, std::vector<Outgoing> &out)
+        {
+            if (peer.batch.empty())
+            {
+                return;
+            }
+            Outgoing outgoing = control(peer_id, MessageType::BROADCAST, {});
+            outgoing.message.payload.swap(peer.batch);
+            peer.batch.clear();
+            peer.batch_count = 0;
+            out.push_back(std::move(outgoing));
+            ++stats_.envelopes_sent;
+        }
+
+        void GossipEngine::flush_ihave(const std::string &peer_id, PeerState &peer, std::vector<Outgoing> &out)
+        {
+            if (peer.ihave.empty())
+            {
+                return;
+            }
+            out.push_back(control(peer_id, MessageType::GOSSIP_IHAVE, peer.ihave));
+            peer.ihave.clear();
+            ++stats_.ihave_sent;
+        }
+
+        void GossipEngine::append_to_batch(const std::string &peer_id, PeerState &peer, const uint8_t *data, size_t size,
+                                           Clock::time_point now, std::vector<Outgoing> &out)
+        {
+            if (peer.batch.empty())
+            {
+                peer.batch_started = now;
+            }
+            put_varint(peer.batch, size);
+            peer.batch.insert(peer.batch.end(), data, data + size);
+            ++peer.batch_count;
+            ++stats_.payloads_sent;
+            if (config_.batch_window.count() <= 0 || peer.batch.size() >= config_.batch_max_bytes)
+            {
+                flush_batch(peer_id, peer, out);
+            }
+        }
+
+        // Full copies to eager peers, an IHAVE entry for lazy ones
+        void GossipEngine::push(const std::string &id, const uint8_t *data, size_t size, const std::string &from,
+                                const std::vector<std::string> &exclude_peers, Clock::time_point now,
+                                std::vector<Outgoing> &out)
+        {
+            for (auto &[peer_id, peer] : peers_)
+            {
+                if (peer_id == from ||
+                    std::find(exclude_peers.begin(), exclude_peers.end(), peer_id) != exclude_peers.end())
+                {
+                    continue;
+                }
+                if (peer.eager)
+                {
+                    append_to_batch(peer_id, peer, data, size, now, out);
+                }
+                else
+                {
+                    peer.ihave.push_back(id);
+                    if (peer.ihave.size() >= config_.max_ihave_batch)
+                    {
+                        flush_ihave(peer_id, peer, out);
+                    }
+                }
+            }
+        }
+
+        bool GossipEngine::broadcast(const NetworkMessage &message, const std::vector<std::string> &exclude_peers,
+                                     Clock::time_point now, std::vector<Outgoing> &out)
+        {
+            if (!seen_.insert(message.message_id))
+            {
+                return false;
+            }
+            const std::vector<uint8_t> encoded = wire::encode(message);
+            remember(message.message_id, encoded.data(), encoded.size());
+            push(message.message_id, encoded.data(), encoded.size(), "", exclude_peers, now, out);
+            ++stats_.originated;
+            return true;
+        }
+
+        bool GossipEngine::on_message(const std::string &from, MessageType type, const uint8_t *payload, size_t size,
+                                      Clock::time_point now, std::vector<std::vector<uint8_t>> &deliver,
+                                      std::vector<Outgoing> &out)
+        {
+            if (type == MessageType::GOSSIP_PRUNE)
+            {
+                set_eager(from, false);
+                return true;
+            }
+
+            if (type == MessageType::GOSSIP_IHAVE || type == MessageType::GOSSIP_GRAFT)
+            {
+                std::vector<std::string> ids;
+                if (!decode_ids(payload, size, ids))
+                {
+                    return false;
+                }
+                if (type == MessageType::GOSSIP_GRAFT)
+                {
+                    set_eager(from, true);
+                    auto peer = peers_.find(from);
+                    if (peer == peers_.end())
+                    {
+                        return true;
+                    }
+                    for (const auto &id : ids)
+                    {
+                        auto cached = cache_.find(id);
+                        if (cached != cache_.end())
+                        {
+                            append_to_batch(from, peer->second, cached->second.data(), cached->second.size(), now, out);
+                        }
+                    }
+                    flush_batch(from, peer->second, out);
+                    return true;
+                }
+                for (const auto &id : ids)
+                {
+                    if (cache_.count(id) || seen_.contains(id))
+                    {
+                        continue;
+                    }
+                    auto it = missing_.find(id);
+                    if (it == missing_.end())
+                    {
+                        if (missing_.size() >= MAX_MISSING)
+                        {
+                            continue;
+                        }
+                        it = missing_.emplace(id, Missing{}).first;
+                        it->second.deadline = now + config_.graft_timeout;
+                    }
+                    it->second.announcers.push_back(from);
+                }
+                return true;
+            }
+
+            if (type != MessageType::BROADCAST)
+            {
+                return false;
+            }
+
+            bool duplicate = false;
+            size_t offset = 0;
+            while (offset < size)
+            {
+                uint64_t length = 0;
+                const size_t consumed = wire::get_varint(payload + offset, size - offset, length);
+                if (consumed == 0 || length > size - offset - consumed)
+                {
+                    return false;
+                }
+                const uint8_t *data = payload + offset + consumed;
+                offset += consumed + static_cast<size_t>(length);
+
+                wire::MessageView view;
+                if (!wire::decode(data, static_cast<size_t>(length), view))
+                {
+                    return false;
+                }
+                const std::string id(view.message_id);
+                if (cache_.count(id) || !seen_.insert(id))
+                {
+                    ++stats_.duplicates;
+                    duplicate = true;
+                    continue;
+                }
+
+                missing_.erase(id);
+                set_eager(from, true);
+                remember(id, data, static_cast<size_t>(length));
+                deliver.emplace_back(data, data + length);
+                ++stats_.delivered;
+                push(id, data, static_cast<size_t>(length), from, {}, now, out);
+            }
+
+            if (duplicate)
+            {
+                // Redundant link: tell the sender to stop pushing to us and do the same for it
+                set_eager(from, false);
+                out.push_back(control(from, MessageType::GOSSIP_PRUNE, {}));
+                ++stats_.prune_sent;
+            }
+            return true;
+        }
+
+        void GossipEngine::tick(Clock::time_point now, std::vector<Outgoing> &out)
+        {
+            for (auto &[peer_id, peer] : peers_)
+            {
+                flush_ihave(peer_id, peer, out);
+                if (!peer.batch.empty() && now - peer.batch_started >= config_.batch_window)
+                {
+                    flush_batch(peer_id, peer, out);
+                }
+            }
+
+            std::unordered_map<std::string, std::vector<std::string>> grafts;
+            for (auto it = missing_.begin(); it != missing_.end();)
+            {
+                Missing &missing = it->second;
+                if (now < missing.deadline)
+                {
+                    ++it;
+                    continue;
+                }
+                while (!missing.announcers.empty() && peers_.count(missing.announcers.front()) == 0)
+                {
+                    missing.announcers.pop_front();
+                }
+                if (missing.announcers.empty())
+                {
+                    it = missing_.erase(it);
+                    continue;
+                }
+                const std::string announcer = missing.announcers.front();
+                missing.announcers.pop_front();
+                grafts[announcer].push_back(it->first);
+                set_eager(announcer, true);
+                missing.deadline = now + config_.graft_timeout; // next announcer if this one fails too
+                ++it;
+            }
+            for (const auto &graft : grafts)
+            {
+                out.push_back(control(graft.first, MessageType::GOSSIP_GRAFT, graft.second));
+                ++stats_.graft_sent;
+            }
+        }
+
+    } // namespace network
+} // namespace cardano_iot
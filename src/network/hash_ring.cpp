@@ -0,0 +1,99 @@
+#include "cardano_iot/network/hash_ring.h"
+
+#include <algorithm>
+
+namespace cardano_iot
+{
+    namespace network
+    {
+        namespace
+        {
+            const std::string NO_OWNER;
+        } // namespace
+
+        HashRing::HashRing(uint32_t virtual_nodes) : virtual_nodes_(std::max<uint32_t>(1, virtual_nodes)) {}
+
+        uint64_t HashRing::hash(std::string_view key)
+        {
+            uint64_t h = 14695981039346656037ull;
+            for (const char c : key)
+            {
+                h ^= static_cast<uint8_t>(c);
+                h *= 1099511628211ull;
+            }
+            // FNV alone clusters similar keys ("device-1", "device-2"); spread them over the ring
+            h ^= h >> 33;
+            h *= 0xff51afd7ed558ccdull;
+            h ^= h >> 33;
+            h *= 0xc4ceb9fe1a85ec53ull;
+            h ^= h >> 33;
+            return h;
+        }
+
+        bool HashRing::add_node(const std::string &node)
+        {
+            auto it = std::lower_bound(nodes_.begin(), nodes_.end(), node);
+            if (it != nodes_.end() && *it == node)
+            {
+                return false;
+            }
+            nodes_.insert(it, node);
+            rebuild();
+            return true;
+        }
+
+        bool HashRing::remove_node(const std::string &node)
+        {
+            auto it = std::lower_bound(nodes_.begin(), nodes_.end(), node);
+            if (it == nodes_.end() || *it != node)
+            {
+                return false;
+            }
+            nodes_.erase(it);
+            rebuild();
+            return true;
+        }
+
+        bool HashRing::contains(const std::string &node) const
+        {
+            return std::binary_search(nodes_.begin(), nodes_.end(), node);
+        }
+
+        const std::string &HashRing::owner(std::string_view key) const
+        {
+            if (points_.empty())
+            {
+                return NO_OWNER;
+            }
+            const uint64_t h = hash(key);
+            auto it = std::lower_bound(points_.begin(), points_.end(), h,
+                                       [](const std::pair<uint64_t, uint32_t> &point, uint64_t value)
+                                       { return point.first < value; });
+            if (it == points_.end())
+            {
+                it = points_.begin();
+            }
+            return nodes_[it->second];
+        }
+
+        void HashRing::rebuild()
+        {
+            points_.clear();
+            points_.reserve(nodes_.size() * virtual_nodes_);
+            std::string label;
+            for (uint32_t index = 0; index < nodes_.size(); ++index)
+            {
+                for (uint32_t replica = 0; replica < virtual_nodes_; ++replica)
+                {
+                    label.assign(nodes_[index]);
+                    label += '#';
+                    label += std::to_string(replica);
+                    points_.emplace_back(hash(label), index);
+                }
+            }
+            // Ties (vanishingly rare) go to the smaller node name on every node alike
+            std::sort(points_.begin(), points_.end());
+        }
+
+    } // namespace network
+} // namespace cardano_iot
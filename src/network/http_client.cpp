@@ -0,0 +1,344 @@
+#include "cardano_iot/network/http_client.h"
+
+#include <curl/curl.h>
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace cardano_iot
+{
+    namespace network
+    {
+        namespace
+        {
+            void ensure_curl_global_init()
+            {
+                static std::once_flag once;
+                std::call_once(once, []()
+                               { curl_global_init(CURL_GLOBAL_DEFAULT); });
+            }
+
+            size_t write_body(char *data, size_t size, size_t count, void *user)
+            {
+                static_cast<std::string *>(user)->append(data, size * count);
+                return size * count;
+            }
+
+            struct PendingRequest
+            {
+                HttpRequest request;
+                HttpCompletion on_complete;
+            };
+        } // namespace
+
+        class HttpClient::Impl
+        {
+        public:
+            struct Transfer
+            {
+                CURL *easy = nullptr;
+                curl_slist *headers = nullptr;
+                HttpRequest request;
+                HttpCompletion on_complete;
+                HttpResponse response;
+            };
+
+            Options options_;
+            CURLM *multi_ = nullptr;
+            std::thread io_thread_;
+            std::atomic<bool> stopping_{false};
+            bool stopped_ = false;
+
+            mutable std::mutex queue_mutex_;
+            std::deque<PendingRequest> queue_;
+
+            // Owned by the I/O thread
+            std::unordered_map<CURL *, std::unique_ptr<Transfer>> active_;
+            std::vector<CURL *> idle_handles_;
+
+            std::atomic<size_t> in_flight_{0};
+            std::atomic<uint64_t> requests_{0};
+            std::atomic<uint64_t> failures_{0};
+            std::atomic<uint64_t> reused_connections_{0};
+            std::atomic<uint64_t> response_time_us_{0};
+
+            explicit Impl(const Options &options) : options_(options)
+            {
+                ensure_curl_global_init();
+                multi_ = curl_multi_init();
+                curl_multi_setopt(multi_, CURLMOPT_MAXCONNECTS, static_cast<long>(options_.max_connections));
+                curl_multi_setopt(multi_, CURLMOPT_MAX_TOTAL_CONNECTIONS, static_cast<long>(options_.max_connections));
+                curl_multi_setopt(multi_, CURLMOPT_MAX_HOST_CONNECTIONS, static_cast<long>(options_.max_host_connections));
+                curl_multi_setopt(multi_, CURLMOPT_PIPELINING, options_.multiplex ? CURLPIPE_MULTIPLEX : CURLPIPE_NOTHING);
+            }
+
+            ~Impl()
+            {
+                for (CURL *easy : idle_handles_)
+                {
+                    curl_easy_cleanup(easy);
+                }
+                if (multi_)
+                {
+                    curl_multi_cleanup(multi_);
+                }
+            }
+
+            void start_transfer(PendingRequest &&pending)
+            {
+                auto transfer = std::make_unique<Transfer>();
+                transfer->request = std::move(pending.request);
+                transfer->on_complete = std::move(pending.on_complete);
+
+                // Recycled easy handles skip re-allocation; connections live in the multi handle's cache
+                if (!idle_handles_.empty())
+                {
+                    transfer->easy = idle_handles_.back();
+                    idle_handles_.pop_back();
+                    curl_easy_reset(transfer->easy);
+                }
+                else
+                {
+                    transfer->easy = curl_easy_init();
+                }
+
+                CURL *easy = transfer->easy;
+                const HttpRequest &request = transfer->request;
+                const uint32_t timeout = request.timeout_ms != 0 ? request.timeout_ms : options_.timeout_ms;
+
+                curl_easy_setopt(easy, CURLOPT_URL, request.url.c_str());
+                curl_easy_setopt(easy, CURLOPT_NOSIGNAL, 1L);
+                curl_easy_setopt(easy, CURLOPT_TIMEOUT_MS, static_cast<long>(timeout));
+                curl_easy_setopt(easy, CURLOPT_CONNECTTIMEOUT_MS, static_cast<long>(options_.connect_timeout_ms));
+                curl_easy_setopt(easy, CURLOPT_USERAGENT, options_.user_agent.c_str());
+                curl_easy_setopt(easy, CURLOPT_TCP_KEEPALIVE, 1L);
+                curl_easy_setopt(easy, CURLOPT_ACCEPT_ENCODING, "");
+                curl_easy_setopt(easy, CURLOPT_WRITEFUNCTION, write_body);
+                curl_easy_setopt(easy, CURLOPT_WRITEDATA, &transfer->response.body);
+                curl_easy_setopt(easy, CURLOPT_PRIVATE, transfer.get());
+                if (options_.multiplex)
+                {
+                    // Prefer waiting for a multiplexed stream over opening another connection
+                    curl_easy_setopt(easy, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+                    curl_easy_setopt(easy, CURLOPT_PIPEWAIT, 1L);
+                }
+
+                for (const auto &header : request.headers)
+                {
+                    transfer->headers = curl_slist_append(transfer->headers, header.c_str());
+                }
+                if (transfer->headers)
+                {
+                    curl_easy_setopt(easy, CURLOPT_HTTPHEADER, transfer->headers);
+                }
+
+                if (request.method == "GET")
+                {
+                    curl_easy_setopt(easy, CURLOPT_HTTPGET, 1L);
+                }
+                else
+                {
+                    if (request.method != "POST")
+                    {
+                        curl_easy_setopt(easy, CURLOPT_CUSTOMREQUEST, request.method.c_str());
+                    }
+                    curl_easy_setopt(easy, CURLOPT_POSTFIELDS, request.body.data());
+                    curl_easy_setopt(easy, CURLOPT_POSTFIELDSIZE, static_cast<long>(request.body.size()));
+                }
+
+                curl_multi_add_handle(multi_, easy);
+                active_.emplace(easy, std::move(transfer));
+            }
+
+            void finish_transfer(CURL *easy, CURLcode result)
+            {
+                auto it = active_.find(easy);
+                if (it == active_.end())
+                {
+                    return;
+                }
+                auto transfer = std::move(it->second);
+                active_.erase(it);
+
+                HttpResponse &response = transfer->response;
+                if (result != CURLE_OK)
+                {
+                    response.error = curl_easy_strerror(result);
+                    failures_.fetch_add(1, std::memory_order_relaxed);
+                }
+                curl_easy_getinfo(easy, CURLINFO_RESPONSE_CODE, &response.status);
+                double total_seconds = 0.0;
+                curl_easy_getinfo(easy, CURLINFO_TOTAL_TIME, &total_seconds);
+                response.total_time_ms = total_seconds * 1000.0;
+                long new_connections = 0;
+                curl_easy_getinfo(easy, CURLINFO_NUM_CONNECTS, &new_connections);
+                response.reused_connection = result == CURLE_OK && new_connections == 0;
+
+                requests_.fetch_add(1, std::memory_order_relaxed);
+                response_time_us_.fetch_add(static_cast<uint64_t>(total_seconds * 1e6), std::memory_order_relaxed);
+                if (response.reused_connection)
+                {
+                    reused_connections_.fetch_add(1, std::memory_order_relaxed);
+                }
+
+                curl_multi_remove_handle(multi_, easy);
+                curl_slist_free_all(transfer->headers);
+                if (idle_handles_.size() < options_.max_connections)
+                {
+                    idle_handles_.push_back(easy);
+                }
+                else
+                {
+                    curl_easy_cleanup(easy);
+                }
+
+                in_flight_.fetch_sub(1, std::memory_order_relaxed);
+                if (transfer->on_complete)
+                {
+                    transfer->on_complete(std::move(response));
+                }
+            }
+
+            void fail(HttpCompletion &on_complete, const std::string &error)
+            {
+                HttpResponse response;
+                response.error = error;
+                in_flight_.fetch_sub(1, std::memory_order_relaxed);
+                if (on_complete)
+                {
+                    on_complete(std::move(response));
+                }
+            }
+
+            void run()
+            {
+                while (true)
+                {
+                    std::deque<PendingRequest> incoming;
+                    {
+                        std::lock_guard<std::mutex> lock(queue_mutex_);
+                        incoming.swap(queue_);
+                    }
+                    for (auto &pending : incoming)
+                    {
+                        start_transfer(std::move(pending));
+                    }
+
+                    int running = 0;
+                    curl_multi_perform(multi_, &running);
+
+                    int remaining = 0;
+                    while (CURLMsg *message = curl_multi_info_read(multi_, &remaining))
+                    {
+                        if (message->msg == CURLMSG_DONE)
+                        {
+                            finish_transfer(message->easy_handle, message->data.result);
+                        }
+                    }
+
+                    if (stopping_.load(std::memory_order_acquire))
+                    {
+                        break;
+                    }
+                    curl_multi_poll(multi_, nullptr, 0, 100, nullptr);
+                }
+
+                // Fail whatever is still on the wire
+                for (auto &entry : active_)
+                {
+                    curl_multi_remove_handle(multi_, entry.first);
+                    curl_slist_free_all(entry.second->headers);
+                    curl_easy_cleanup(entry.first);
+                    fail(entry.second->on_complete, "HTTP client shut down");
+                }
+                active_.clear();
+            }
+        };
+
+        HttpClient::HttpClient() : HttpClient(Options{}) {}
+
+        HttpClient::HttpClient(const Options &options) : pimpl_(std::make_unique<Impl>(options))
+        {
+            pimpl_->io_thread_ = std::thread([this]()
+                                             { pimpl_->run(); });
+        }
+
+        HttpClient::~HttpClient()
+        {
+            shutdown();
+        }
+
+        void HttpClient::send(HttpRequest request, HttpCompletion on_complete)
+        {
+            pimpl_->in_flight_.fetch_add(1, std::memory_order_relaxed);
+            {
+                std::lock_guard<std::mutex> lock(pimpl_->queue_mutex_);
+                if (!pimpl_->stopping_.load(std::memory_order_acquire))
+                {
+                    pimpl_->queue_.push_back({std::move(request), std::move(on_complete)});
+                    curl_multi_wakeup(pimpl_->multi_);
+                    return;
+                }
+            }
+            pimpl_->fail(on_complete, "HTTP client shut down");
+        }
+
+        std::future<HttpResponse> HttpClient::send(HttpRequest request)
+        {
+            auto promise = std::make_shared<std::promise<HttpResponse>>();
+            auto future = promise->get_future();
+            send(std::move(request), [promise](HttpResponse &&response)
+                 { promise->set_value(std::move(response)); });
+            return future;
+        }
+
+        void HttpClient::shutdown()
+        {
+            std::deque<PendingRequest> abandoned;
+            {
+                std::lock_guard<std::mutex> lock(pimpl_->queue_mutex_);
+                if (pimpl_->stopped_)
+                {
+                    return;
+                }
+                pimpl_->stopped_ = true;
+                pimpl_->stopping_.store(true, std::memory_order_release);
+                curl_multi_wakeup(pimpl_->multi_);
+            }
+            if (pimpl_->io_thread_.joinable())
+            {
+                pimpl_->io_thread_.join();
+            }
+            {
+                std::lock_guard<std::mutex> lock(pimpl_->queue_mutex_);
+                abandoned.swap(pimpl_->queue_);
+            }
+            for (auto &pending : abandoned)
+            {
+                pimpl_->fail(pending.on_complete, "HTTP client shut down");
+            }
+        }
+
+        size_t HttpClient::in_flight() const
+        {
+            return pimpl_->in_flight_.load(std::memory_order_relaxed);
+        }
+
+        HttpClient::HttpStats HttpClient::get_statistics() const
+        {
+            HttpStats stats{};
+            stats.requests = pimpl_->requests_.load(std::memory_order_relaxed);
+            stats.failures = pimpl_->failures_.load(std::memory_order_relaxed);
+            stats.reused_connections = pimpl_->reused_connections_.load(std::memory_order_relaxed);
+            stats.avg_response_time_ms = stats.requests == 0
+                                             ? 0.0
+                                             : static_cast<double>(pimpl_->response_time_us_.load(std::memory_order_relaxed)) /
+                                                   static_cast<double>(stats.requests) / 1000.0;
+            return stats;
+        }
+
+    } // namespace network
+} // namespace cardano_iot
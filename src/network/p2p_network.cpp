@@ -1,17 +1,71 @@
 #include "cardano_iot/network/p2p_network.h"
+#include "cardano_iot/network/socket_transport.h"
+#include "cardano_iot/network/wire_format.h"
+#include "cardano_iot/network/send_scheduler.h"
+#include "cardano_iot/network/gossip.h"
+#include "cardano_iot/network/routing_table.h"
+#include "cardano_iot/network/peer_table.h"
+#include "cardano_iot/performance/performance_optimizer.h"
 #include "cardano_iot/utils/logger.h"
+#include "cardano_iot/utils/timer_wheel.h"
+#include "cardano_iot/utils/metrics.h"
 
+#include <array>
 #include <chrono>
 #include <sstream>
 #include <random>
 #include <algorithm>
 #include <mutex>
 #include <thread>
+#include <future>
+#include <condition_variable>
+#include <cstdlib>
+#include <unordered_map>
 
 namespace cardano_iot
 {
     namespace network
     {
+        namespace
+        {
+            using Clock = std::chrono::steady_clock;
+
+            constexpr size_t TRANSPORT_HIGH_WATER = 64 * 1024; // keep the rest queued here, where priority applies
+            constexpr size_t MAX_PENDING_PRIORITIES = 4096;
+            constexpr uint8_t CONTROL_PRIORITY = 255;
+            constexpr double LATENCY_SMOOTHING = 0.2;
+            constexpr auto GOSSIP_TICK = std::chrono::milliseconds(50);
+
+            uint8_t default_priority(MessageType type)
+            {
+                switch (type)
+                {
+                case MessageType::HANDSHAKE:
+                case MessageType::PING:
+                case MessageType::PONG:
+                    return CONTROL_PRIORITY;
+                case MessageType::DEVICE_DISCOVERY:
+                case MessageType::CAPABILITY_EXCHANGE:
+                case MessageType::MESH_UPDATE:
+                case MessageType::GOSSIP_IHAVE:
+                case MessageType::GOSSIP_GRAFT:
+                case MessageType::GOSSIP_PRUNE:
+                    return 160;
+                case MessageType::DATA_SYNC:
+                    return 32;
+                default:
+                    return 96;
+                }
+            }
+
+            uint64_t now_seconds()
+            {
+                return std::chrono::duration_cast<std::chrono::seconds>(
+                           std::chrono::system_clock::now().time_since_epoch())
+                    .count();
+            }
+        } // namespace
+
         struct P2PNetwork::Impl
         {
             bool initialized_ = false;
@@ -19,22 +73,95 @@ namespace cardano_iot
             std::string listen_address_;
             uint16_t listen_port_;
             mutable std::mutex network_mutex_;
-            mutable std::mutex stats_mutex_;
 
             // Configuration
             P2PConfig config_;
 
-            // Peer management
-            std::map<std::string, PeerInfo> peers_;
+            // Peer management; peers_ is read without any lock, written with network_mutex_ held
+            PeerTable peers_;
             std::vector<std::string> trusted_peers_;
-            std::vector<std::string> banned_peers_;
+            std::unordered_map<std::string, utils::TimerWheel::Handle> banned_peers_; // peer -> unban timer
 
             // Message handling
             std::map<MessageType, MessageCallback> message_handlers_;
+            std::map<MessageType, MessageViewCallback> view_handlers_;
             PeerCallback peer_event_handler_;
 
-            // Statistics
-            NetworkStats stats_ = {};
+            // Transport; created once and only stopped on shutdown, so late callers never see it dangle
+            std::unique_ptr<SocketTransport> transport_;
+            std::string local_peer_id_;
+
+            // Encode buffers come from here and are handed back by the transport once written
+            wire::BufferPool buffer_pool_;
+
+            struct ConnectionInfo
+            {
+                std::string endpoint;
+                bool inbound = false;
+                std::string peer_id; // set once the handshake completes
+            };
+
+            std::unordered_map<SocketTransport::ConnectionId, ConnectionInfo> connections_;
+            std::map<std::string, SocketTransport::ConnectionId> peer_connections_;
+            std::map<SocketTransport::ConnectionId, std::shared_ptr<std::promise<std::string>>> pending_connects_;
+
+            // Outbound QoS; frames wait here for bandwidth and socket space. Never held with network_mutex_
+            std::mutex qos_mutex_;
+            std::condition_variable qos_cv_;
+            SendScheduler scheduler_;
+            TokenBucket bucket_;
+            std::thread dispatcher_;
+            bool dispatcher_stop_ = false;
+            Clock::time_point next_heartbeat_{};
+            std::unordered_map<std::string, uint8_t> message_priorities_;
+
+            struct OutstandingPing
+            {
+                std::string peer_id;
+                Clock::time_point sent;
+            };
+
+            std::unordered_map<std::string, OutstandingPing> outstanding_pings_;
+            uint64_t frames_attempted_ = 0;
+            uint64_t frames_lost_ = 0; // dropped on a full queue or closed connection, or a ping never answered
+            Clock::time_point window_start_ = Clock::now();
+            uint64_t window_bytes_ = 0;
+            double throughput_kbps_ = 0.0;
+
+            // Gossip state for broadcast_message when mesh routing is on; never held with the other locks
+            std::mutex gossip_mutex_;
+            std::unique_ptr<GossipEngine> gossip_;
+
+            // Distance-vector routes learned over MESH_UPDATE; never held with the other locks
+            mutable std::mutex routing_mutex_;
+            std::unique_ptr<RoutingTable> routing_;
+            mutable uint64_t topology_version_ = UINT64_MAX; // routing version the cached view was built from
+            mutable std::map<std::string, std::vector<std::string>> topology_connections_;
+            mutable uint32_t topology_diameter_ = 0;
+
+            // Statistics: per-core metrics, updated without locks from the I/O and caller threads
+            utils::metrics::Counter messages_sent_{"cardano_iot_p2p_messages_sent_total", "Messages queued to peers"};
+            utils::metrics::Counter messages_received_{"cardano_iot_p2p_messages_received_total", "Messages received from peers"};
+            utils::metrics::Counter bytes_sent_{"cardano_iot_p2p_sent_bytes_total", "Payload bytes queued to peers"};
+            utils::metrics::Counter bytes_received_{"cardano_iot_p2p_received_bytes_total", "Payload bytes received from peers"};
+            utils::metrics::Counter connections_established_{"cardano_iot_p2p_connection_events_total", "Peer connection events", {{"event", "established"}}};
+            utils::metrics::Counter connections_lost_{"cardano_iot_p2p_connection_events_total", "Peer connection events", {{"event", "lost"}}};
+            utils::metrics::Counter discovery_attempts_{"cardano_iot_p2p_discovery_attempts_total", "Peer discovery rounds"};
+            utils::metrics::Counter auth_succeeded_{"cardano_iot_p2p_authentications_total", "Peer authentications by result", {{"result", "success"}}};
+            utils::metrics::Counter auth_failed_{"cardano_iot_p2p_authentications_total", "Peer authentications by result", {{"result", "failure"}}};
+            utils::metrics::Counter gossip_delivered_{"cardano_iot_p2p_gossip_delivered_total", "Broadcasts received for the first time"};
+            utils::metrics::Counter gossip_duplicates_{"cardano_iot_p2p_gossip_duplicates_total", "Broadcast copies suppressed by the seen-message filter"};
+            utils::metrics::Counter messages_relayed_{"cardano_iot_p2p_messages_relayed_total", "Routed messages passed on towards their recipient"};
+
+            std::array<utils::metrics::Counter *, 12> counters()
+            {
+                return {&messages_sent_, &messages_received_, &bytes_sent_, &bytes_received_,
+                        &connections_established_, &connections_lost_, &discovery_attempts_,
+                        &auth_succeeded_, &auth_failed_, &gossip_delivered_, &gossip_duplicates_, &messages_relayed_};
+            }
+
+            // Ban expiry; last member so it is destroyed, and its callbacks finished, first
+            utils::TimerWheel::Scope timers_;
 
             // Generate unique peer ID
             std::string generate_peer_id() const
@@ -67,92 +194,771 @@ namespace cardano_iot
                 return ss.str();
             }
 
-            // Create mock peer
-            PeerInfo create_mock_peer(const std::string &endpoint)
+            // Update peer statistics; lock-free
+            void update_peer_stats(const std::string &peer_id, uint64_t bytes, bool sent)
             {
-                PeerInfo peer;
-                peer.peer_id = generate_peer_id();
-                peer.endpoint = endpoint;
-                peer.public_key = "pubkey_" + peer.peer_id.substr(5, 8);
-                peer.status = PeerStatus::CONNECTED;
-                peer.last_seen = std::chrono::duration_cast<std::chrono::seconds>(
-                                     std::chrono::system_clock::now().time_since_epoch())
-                                     .count();
-                peer.bytes_sent = 0;
-                peer.bytes_received = 0;
-                peer.latency_ms = 50.0 + (rand() % 100); // 50-150ms
-                peer.capabilities = {"iot_sensor", "mesh_routing", "encryption"};
-                return peer;
+                if (auto peer = peers_.find(peer_id))
+                {
+                    peer->record_traffic(bytes, sent, now_seconds());
+                }
+            }
+
+            // Process incoming message; the view borrows the transport's receive buffer (data, size)
+            void process_message(SocketTransport::ConnectionId id, const std::string &peer_id,
+                                 const wire::MessageView &message, const uint8_t *data, size_t size)
+            {
+                if (!message.recipient_id.empty() && message.recipient_id != local_peer_id_ &&
+                    relay_message(peer_id, message, data, size))
+                {
+                    return;
+                }
+
+                if (message.type == MessageType::PING)
+                {
+                    NetworkMessage pong;
+                    pong.message_id = std::string(message.message_id);
+                    pong.type = MessageType::PONG;
+                    pong.sender_id = local_peer_id_;
+                    pong.timestamp = now_seconds();
+                    pong.encrypted = false;
+                    enqueue_frame(id, CONTROL_PRIORITY, encode_pooled(pong));
+                }
+                else if (message.type == MessageType::PONG)
+                {
+                    record_pong(peer_id, std::string(message.message_id));
+                }
+                else if (GossipEngine::is_gossip_type(message.type))
+                {
+                    handle_gossip(peer_id, message);
+                    return;
+                }
+                else if (message.type == MessageType::MESH_UPDATE)
+                {
+                    handle_mesh_update(peer_id, message);
+                }
+
+                dispatch_to_handlers(message);
             }
 
-            // Simulate network operations
-            void simulate_network_delay() const
+            // Pass a message addressed to a routed destination on, frame bytes unchanged
+            bool relay_message(const std::string &from, const wire::MessageView &message, const uint8_t *data, size_t size)
             {
-                std::this_thread::sleep_for(std::chrono::milliseconds(10 + (rand() % 30)));
+                switch (message.type)
+                {
+                case MessageType::HANDSHAKE:
+                case MessageType::PING:
+                case MessageType::PONG:
+                case MessageType::MESH_UPDATE:
+                    return false;
+                default:
+                    if (GossipEngine::is_gossip_type(message.type))
+                    {
+                        return false;
+                    }
+                }
+
+                std::string next_hop;
+                {
+                    std::lock_guard<std::mutex> lock(routing_mutex_);
+                    const RoutingTable::Route *route = routing_ ? routing_->lookup(std::string(message.recipient_id)) : nullptr;
+                    if (!route)
+                    {
+                        return false; // not a destination we know; deliver locally as before
+                    }
+                    next_hop = route->next_hop;
+                }
+                if (next_hop == from)
+                {
+                    CARDANO_IOT_LOG(utils::LogLevel::DEBUG, "P2PNetwork",
+                                    "Dropping " << message.message_id << ": route to " << message.recipient_id
+                                                << " leads back to " << from);
+                    return true;
+                }
+
+                const std::shared_ptr<PeerEntry> hop = peers_.find(next_hop);
+                if (!hop || hop->connection_id == 0)
+                {
+                    return true;
+                }
+                hop->record_traffic(message.payload_size, true, now_seconds());
+                std::vector<uint8_t> frame = buffer_pool_.acquire();
+                frame.assign(data, data + size);
+                if (enqueue_frame(hop->connection_id, default_priority(message.type), std::move(frame)))
+                {
+                    messages_relayed_.inc();
+                }
+                return true;
             }
 
-            // Update peer statistics
-            void update_peer_stats(const std::string &peer_id, uint64_t bytes, bool sent)
+            // Next hop for a peer that may be several hops away; nullptr if unreachable
+            std::shared_ptr<PeerEntry> next_hop_for(const std::string &peer_id)
             {
-                auto it = peers_.find(peer_id);
-                if (it != peers_.end())
+                std::shared_ptr<PeerEntry> peer = peers_.find(peer_id);
+                if (peer && peer->connected() && peer->connection_id != 0)
                 {
-                    if (sent)
+                    return peer;
+                }
+                if (!config_.enable_mesh_routing)
+                {
+                    return nullptr;
+                }
+                std::string via;
+                {
+                    std::lock_guard<std::mutex> lock(routing_mutex_);
+                    const RoutingTable::Route *route = routing_ ? routing_->lookup(peer_id) : nullptr;
+                    if (!route)
                     {
-                        it->second.bytes_sent += bytes;
+                        return nullptr;
+                    }
+                    via = route->next_hop;
+                }
+                peer = peers_.find(via);
+                return peer && peer->connection_id != 0 ? peer : nullptr;
+            }
+
+            void dispatch_to_handlers(const wire::MessageView &message)
+            {
+                MessageViewCallback view_handler;
+                MessageCallback handler;
+                {
+                    std::lock_guard<std::mutex> lock(network_mutex_);
+                    auto view_it = view_handlers_.find(message.type);
+                    if (view_it != view_handlers_.end())
+                    {
+                        view_handler = view_it->second;
                     }
                     else
                     {
-                        it->second.bytes_received += bytes;
+                        auto it = message_handlers_.find(message.type);
+                        if (it != message_handlers_.end())
+                        {
+                            handler = it->second;
+                        }
                     }
-                    it->second.last_seen = std::chrono::duration_cast<std::chrono::seconds>(
-                                               std::chrono::system_clock::now().time_since_epoch())
-                                               .count();
                 }
+                if (view_handler)
+                {
+                    view_handler(message);
+                }
+                else if (handler)
+                {
+                    handler(message.to_message());
+                }
+
+                // Update statistics
+                messages_received_.inc();
+                bytes_received_.inc(message.payload_size);
             }
 
-            // Process incoming message
-            void process_message(const NetworkMessage &message)
+            // Handle peer connection; called without network_mutex_ held
+            void handle_peer_connection(const PeerInfo &peer, bool connected)
             {
-                auto it = message_handlers_.find(message.type);
-                if (it != message_handlers_.end() && it->second)
+                PeerCallback handler;
+                {
+                    std::lock_guard<std::mutex> lock(network_mutex_);
+                    handler = peer_event_handler_;
+                }
+                if (handler)
                 {
-                    it->second(message);
+                    handler(peer, connected);
                 }
 
                 // Update statistics
-                std::lock_guard<std::mutex> lock(stats_mutex_);
-                stats_.messages_received++;
-                stats_.bytes_received += message.payload.size();
+                (connected ? connections_established_ : connections_lost_).inc();
+            }
+
+            std::vector<uint8_t> encode_pooled(const NetworkMessage &message)
+            {
+                std::vector<uint8_t> buffer = buffer_pool_.acquire();
+                wire::encode(message, buffer);
+                return buffer;
+            }
+
+            void send_handshake(SocketTransport::ConnectionId id)
+            {
+                NetworkMessage hello;
+                hello.message_id = generate_message_id();
+                hello.type = MessageType::HANDSHAKE;
+                hello.sender_id = local_peer_id_;
+                hello.payload.assign(config_.network_id.begin(), config_.network_id.end());
+                hello.timestamp = now_seconds();
+                hello.encrypted = false;
+                transport_->send(id, encode_pooled(hello));
+            }
+
+            // Transport callbacks; they run on the event-loop threads
+            void on_connect(SocketTransport::ConnectionId id, const std::string &endpoint, bool inbound)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(network_mutex_);
+                    connections_[id] = ConnectionInfo{endpoint, inbound, ""};
+                }
+                // The dialing side speaks first; the accepting side answers once it likes the peer
+                if (!inbound)
+                {
+                    send_handshake(id);
+                }
+            }
+
+            void on_frame(SocketTransport::ConnectionId id, const uint8_t *data, size_t size)
+            {
+                wire::MessageView message;
+                if (!wire::decode(data, size, message))
+                {
+                    utils::Logger::instance().log(utils::LogLevel::WARNING, "P2PNetwork",
+                                                  "Malformed message, closing connection");
+                    transport_->close(id);
+                    return;
+                }
+
+                std::string peer_id;
+                {
+                    std::lock_guard<std::mutex> lock(network_mutex_);
+                    auto it = connections_.find(id);
+                    if (it == connections_.end())
+                    {
+                        return;
+                    }
+                    peer_id = it->second.peer_id;
+                }
+                if (!peer_id.empty())
+                {
+                    update_peer_stats(peer_id, message.payload_size, false);
+                }
+
+                if (peer_id.empty())
+                {
+                    complete_handshake(id, message);
+                    return;
+                }
+                process_message(id, peer_id, message, data, size);
             }
 
-            // Handle peer connection
-            void handle_peer_connection(const std::string &peer_id, bool connected)
+            void complete_handshake(SocketTransport::ConnectionId id, const wire::MessageView &message)
             {
-                if (peer_event_handler_)
+                const std::string_view network_id(reinterpret_cast<const char *>(message.payload), message.payload_size);
+                const std::string sender(message.sender_id);
+                PeerInfo peer;
+                bool accepted = false;
+                bool inbound = false;
+                std::shared_ptr<std::promise<std::string>> pending;
                 {
-                    auto it = peers_.find(peer_id);
-                    if (it != peers_.end())
+                    std::lock_guard<std::mutex> lock(network_mutex_);
+                    auto it = connections_.find(id);
+                    if (it == connections_.end())
                     {
-                        peer_event_handler_(it->second, connected);
+                        return;
+                    }
+                    inbound = it->second.inbound;
+                    const bool banned = banned_peers_.count(sender) != 0;
+                    if (message.type == MessageType::HANDSHAKE && network_id == config_.network_id && !sender.empty() &&
+                        sender != local_peer_id_ && !banned && peer_connections_.count(sender) == 0)
+                    {
+                        accepted = true;
+                        it->second.peer_id = sender;
+                        peer_connections_[sender] = id;
+
+                        peer.peer_id = sender;
+                        peer.endpoint = it->second.endpoint;
+                        peer.status = std::find(trusted_peers_.begin(), trusted_peers_.end(), sender) != trusted_peers_.end()
+                                          ? PeerStatus::AUTHENTICATED
+                                          : PeerStatus::CONNECTED;
+                        peer.last_seen = now_seconds();
+                        peer.bytes_sent = 0;
+                        peer.bytes_received = 0;
+                        peer.latency_ms = 0.0;
+                        peers_.insert(peer, id);
+
+                        auto waiting = pending_connects_.find(id);
+                        if (waiting != pending_connects_.end())
+                        {
+                            pending = waiting->second;
+                            pending_connects_.erase(waiting);
+                        }
                     }
                 }
 
-                // Update statistics
-                std::lock_guard<std::mutex> lock(stats_mutex_);
-                if (connected)
+                if (!accepted)
+                {
+                    utils::Logger::instance().log(utils::LogLevel::WARNING, "P2PNetwork",
+                                                  "Rejected handshake from " + sender);
+                    transport_->close(id);
+                    return;
+                }
+                if (inbound)
                 {
-                    stats_.connections_established++;
+                    send_handshake(id);
                 }
-                else
+                if (pending)
+                {
+                    pending->set_value(peer.peer_id);
+                }
+                peer_joined(peer.peer_id);
+                handle_peer_connection(peer, true);
+                send_ping(id, peer.peer_id); // first latency sample without waiting for the heartbeat
+
+                utils::Logger::instance().log(utils::LogLevel::INFO, "P2PNetwork",
+                                              std::string(inbound ? "Accepted" : "Connected to") + " peer: " +
+                                                  peer.endpoint + " (ID: " + peer.peer_id + ")");
+            }
+
+            void on_close(SocketTransport::ConnectionId id)
+            {
+                PeerInfo peer;
+                bool had_peer = false;
+                std::shared_ptr<std::promise<std::string>> pending;
                 {
-                    stats_.connections_lost++;
+                    std::lock_guard<std::mutex> lock(network_mutex_);
+                    auto it = connections_.find(id);
+                    std::string peer_id;
+                    if (it != connections_.end())
+                    {
+                        peer_id = it->second.peer_id;
+                        connections_.erase(it);
+                    }
+                    auto waiting = pending_connects_.find(id);
+                    if (waiting != pending_connects_.end())
+                    {
+                        pending = waiting->second;
+                        pending_connects_.erase(waiting);
+                    }
+                    auto link = peer_connections_.find(peer_id);
+                    if (!peer_id.empty() && link != peer_connections_.end() && link->second == id)
+                    {
+                        peer_connections_.erase(link);
+                        if (auto known = peers_.erase(peer_id))
+                        {
+                            peer = known->to_info();
+                            peer.status = PeerStatus::DISCONNECTED;
+                            had_peer = true;
+                        }
+                    }
+                }
+
+                {
+                    std::lock_guard<std::mutex> lock(qos_mutex_);
+                    frames_lost_ += scheduler_.remove_peer(id);
+                }
+                if (pending)
+                {
+                    pending->set_value("");
+                }
+                if (had_peer)
+                {
+                    peer_left(peer.peer_id);
+                    handle_peer_connection(peer, false);
+                    utils::Logger::instance().log(utils::LogLevel::INFO, "P2PNetwork",
+                                                  "Connection to peer closed: " + peer.peer_id);
+                }
+            }
+
+            void handle_gossip(const std::string &peer_id, const wire::MessageView &message)
+            {
+                std::vector<std::vector<uint8_t>> deliver;
+                std::vector<GossipEngine::Outgoing> out;
+                bool valid = false;
+                uint64_t duplicates = 0;
+                {
+                    std::lock_guard<std::mutex> lock(gossip_mutex_);
+                    if (!gossip_)
+                    {
+                        return;
+                    }
+                    const uint64_t before = gossip_->get_statistics().duplicates;
+                    valid = gossip_->on_message(peer_id, message.type, message.payload, message.payload_size, Clock::now(),
+                                                deliver, out);
+                    duplicates = gossip_->get_statistics().duplicates - before;
+                }
+                if (!valid)
+                {
+                    utils::Logger::instance().log(utils::LogLevel::WARNING, "P2PNetwork",
+                                                  "Malformed gossip message from " + peer_id);
+                }
+                send_to_peers(out, default_priority(MessageType::BROADCAST));
+
+                for (const auto &bytes : deliver)
+                {
+                    wire::MessageView inner;
+                    if (wire::decode(bytes.data(), bytes.size(), inner) && !GossipEngine::is_gossip_type(inner.type))
+                    {
+                        dispatch_to_handlers(inner);
+                    }
+                }
+
+                messages_received_.inc();
+                bytes_received_.inc(message.payload_size);
+                gossip_delivered_.inc(deliver.size());
+                gossip_duplicates_.inc(duplicates);
+            }
+
+            // Envelopes get the given priority; gossip control and MESH_UPDATE keep their control priority
+            void send_to_peers(std::vector<GossipEngine::Outgoing> &out, uint8_t envelope_priority)
+            {
+                if (out.empty())
+                {
+                    return;
+                }
+                std::vector<SocketTransport::ConnectionId> ids(out.size(), 0);
+                {
+                    std::lock_guard<std::mutex> lock(network_mutex_);
+                    for (size_t i = 0; i < out.size(); ++i)
+                    {
+                        auto link = peer_connections_.find(out[i].peer_id);
+                        if (link != peer_connections_.end())
+                        {
+                            ids[i] = link->second;
+                        }
+                    }
+                }
+
+                uint64_t sent = 0;
+                uint64_t bytes = 0;
+                for (size_t i = 0; i < out.size(); ++i)
+                {
+                    const NetworkMessage &message = out[i].message;
+                    const uint8_t priority = message.type == MessageType::BROADCAST ? envelope_priority
+                                                                                    : default_priority(message.type);
+                    if (ids[i] != 0 && enqueue_frame(ids[i], priority, encode_pooled(message)))
+                    {
+                        ++sent;
+                        bytes += message.payload.size();
+                    }
+                }
+
+                messages_sent_.inc(sent);
+                bytes_sent_.inc(bytes);
+            }
+
+            // Gossip digests and grafts, then triggered routing deltas
+            void tick_mesh()
+            {
+                std::vector<GossipEngine::Outgoing> out;
+                {
+                    std::lock_guard<std::mutex> lock(gossip_mutex_);
+                    if (gossip_)
+                    {
+                        gossip_->tick(Clock::now(), out);
+                    }
+                }
+                if (config_.enable_mesh_routing)
+                {
+                    std::lock_guard<std::mutex> lock(routing_mutex_);
+                    if (routing_ && routing_->has_changes())
+                    {
+                        const std::vector<std::string> changes = routing_->take_changes();
+                        for (const auto &neighbor : routing_->neighbors())
+                        {
+                            std::vector<RoutingTable::Advert> adverts = routing_->adverts_for(neighbor, changes);
+                            if (!adverts.empty())
+                            {
+                                out.push_back(mesh_update(neighbor, RoutingTable::UpdateKind::DELTA, adverts));
+                            }
+                        }
+                    }
+                }
+                send_to_peers(out, default_priority(MessageType::BROADCAST));
+            }
+
+            GossipEngine::Outgoing mesh_update(const std::string &peer_id, RoutingTable::UpdateKind kind,
+                                               const std::vector<RoutingTable::Advert> &adverts) const
+            {
+                GossipEngine::Outgoing update;
+                update.peer_id = peer_id;
+                update.message.message_id = generate_message_id();
+                update.message.type = MessageType::MESH_UPDATE;
+                update.message.sender_id = local_peer_id_;
+                update.message.payload = RoutingTable::encode(kind, adverts);
+                update.message.timestamp = now_seconds();
+                update.message.encrypted = false;
+                return update;
+            }
+
+            // Full table in answer to a REQUEST; adverts otherwise update what the neighbour told us
+            void handle_mesh_update(const std::string &peer_id, const wire::MessageView &message)
+            {
+                RoutingTable::UpdateKind kind = RoutingTable::UpdateKind::DELTA;
+                std::vector<RoutingTable::Advert> adverts;
+                if (!RoutingTable::decode(message.payload, message.payload_size, kind, adverts))
+                {
+                    utils::Logger::instance().log(utils::LogLevel::WARNING, "P2PNetwork",
+                                                  "Malformed mesh update from " + peer_id);
+                    return;
+                }
+
+                std::vector<GossipEngine::Outgoing> out;
+                {
+                    std::lock_guard<std::mutex> lock(routing_mutex_);
+                    if (!routing_)
+                    {
+                        return;
+                    }
+                    if (kind == RoutingTable::UpdateKind::REQUEST)
+                    {
+                        out.push_back(mesh_update(peer_id, RoutingTable::UpdateKind::FULL, routing_->full_table_for(peer_id)));
+                    }
+                    else
+                    {
+                        routing_->apply_update(peer_id, adverts, kind == RoutingTable::UpdateKind::FULL);
+                    }
+                }
+                send_to_peers(out, default_priority(MessageType::MESH_UPDATE));
+            }
+
+            // A handshake completed: gossip and routing learn the neighbour, which gets our table
+            void peer_joined(const std::string &peer_id)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(gossip_mutex_);
+                    if (gossip_)
+                    {
+                        gossip_->add_peer(peer_id);
+                    }
+                }
+                std::vector<GossipEngine::Outgoing> out;
+                {
+                    std::lock_guard<std::mutex> lock(routing_mutex_);
+                    if (routing_)
+                    {
+                        routing_->add_neighbor(peer_id);
+                        if (config_.enable_mesh_routing)
+                        {
+                            out.push_back(mesh_update(peer_id, RoutingTable::UpdateKind::FULL, routing_->full_table_for(peer_id)));
+                        }
+                    }
+                }
+                send_to_peers(out, default_priority(MessageType::MESH_UPDATE));
+            }
+
+            // Routes through the peer are withdrawn; the deltas go out on the next tick
+            void peer_left(const std::string &peer_id)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(gossip_mutex_);
+                    if (gossip_)
+                    {
+                        gossip_->remove_peer(peer_id);
+                    }
+                }
+                std::lock_guard<std::mutex> lock(routing_mutex_);
+                if (routing_)
+                {
+                    routing_->remove_neighbor(peer_id);
+                }
+            }
+
+            bool enqueue_frame(SocketTransport::ConnectionId id, uint8_t priority, std::vector<uint8_t> frame)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(qos_mutex_);
+                    ++frames_attempted_;
+                    if (!scheduler_.enqueue(id, priority, std::move(frame)))
+                    {
+                        ++frames_lost_;
+                        return false;
+                    }
+                }
+                qos_cv_.notify_one();
+                return true;
+            }
+
+            // Priority set through set_message_priority() wins over the per-type default
+            uint8_t take_priority(const NetworkMessage &message)
+            {
+                std::lock_guard<std::mutex> lock(qos_mutex_);
+                auto it = message_priorities_.find(message.message_id);
+                if (it == message_priorities_.end())
+                {
+                    return default_priority(message.type);
+                }
+                const uint8_t priority = it->second;
+                message_priorities_.erase(it);
+                return priority;
+            }
+
+            void apply_bandwidth_limit(uint32_t kbps)
+            {
+                // kbps * 1000 / 8 bytes per second, with up to 100 ms (at least one full frame) of burst
+                const uint64_t rate = static_cast<uint64_t>(kbps) * 125;
+                std::lock_guard<std::mutex> lock(qos_mutex_);
+                bucket_.set_rate(rate, std::max<uint64_t>(rate / 10, 1500));
+            }
+
+            void send_ping(SocketTransport::ConnectionId id, const std::string &peer_id)
+            {
+                NetworkMessage ping;
+                ping.message_id = generate_message_id() + "_ping";
+                ping.type = MessageType::PING;
+                ping.sender_id = local_peer_id_;
+                ping.timestamp = now_seconds();
+                ping.encrypted = false;
+                {
+                    std::lock_guard<std::mutex> lock(qos_mutex_);
+                    outstanding_pings_[ping.message_id] = OutstandingPing{peer_id, Clock::now()};
+                }
+                enqueue_frame(id, CONTROL_PRIORITY, encode_pooled(ping));
+            }
+
+            void record_pong(const std::string &peer_id, const std::string &message_id)
+            {
+                double rtt_ms = 0.0;
+                {
+                    std::lock_guard<std::mutex> lock(qos_mutex_);
+                    auto it = outstanding_pings_.find(message_id);
+                    if (it == outstanding_pings_.end() || it->second.peer_id != peer_id)
+                    {
+                        return;
+                    }
+                    rtt_ms = std::chrono::duration<double, std::milli>(Clock::now() - it->second.sent).count();
+                    outstanding_pings_.erase(it);
+                }
+                if (auto peer = peers_.find(peer_id))
+                {
+                    peer->record_latency(rtt_ms, LATENCY_SMOOTHING);
+                }
+            }
+
+            // Ping every connected peer and count pings that went unanswered for a whole timeout as lost
+            void send_heartbeats()
+            {
+                std::vector<std::pair<SocketTransport::ConnectionId, std::string>> targets;
+                std::chrono::milliseconds timeout;
+                {
+                    std::lock_guard<std::mutex> lock(network_mutex_);
+                    for (const auto &link : peer_connections_)
+                    {
+                        targets.emplace_back(link.second, link.first);
+                    }
+                    timeout = std::chrono::milliseconds(config_.message_timeout_ms);
+                }
+                {
+                    std::lock_guard<std::mutex> lock(qos_mutex_);
+                    const auto now = Clock::now();
+                    for (auto it = outstanding_pings_.begin(); it != outstanding_pings_.end();)
+                    {
+                        if (now - it->second.sent > timeout)
+                        {
+                            ++frames_lost_;
+                            it = outstanding_pings_.erase(it);
+                        }
+                        else
+                        {
+                            ++it;
+                        }
+                    }
+                }
+                for (const auto &target : targets)
+                {
+                    send_ping(target.first, target.second);
+                }
+            }
+
+            void record_sent(size_t bytes, Clock::time_point now)
+            {
+                const double elapsed = std::chrono::duration<double>(now - window_start_).count();
+                if (elapsed >= 1.0)
+                {
+                    throughput_kbps_ = static_cast<double>(window_bytes_) * 8.0 / 1000.0 / elapsed;
+                    window_start_ = now;
+                    window_bytes_ = 0;
+                }
+                window_bytes_ += bytes;
+            }
+
+            double measured_throughput_kbps()
+            {
+                std::lock_guard<std::mutex> lock(qos_mutex_);
+                const double elapsed = std::chrono::duration<double>(Clock::now() - window_start_).count();
+                if (elapsed >= 1.0)
+                {
+                    // Current window is complete (or traffic stopped): it is the best estimate
+                    return static_cast<double>(window_bytes_) * 8.0 / 1000.0 / elapsed;
+                }
+                return throughput_kbps_ > 0.0 || elapsed <= 0.0 ? throughput_kbps_
+                                                                : static_cast<double>(window_bytes_) * 8.0 / 1000.0 / elapsed;
+            }
+
+            // Moves frames from the scheduler to the transport as the bandwidth budget allows
+            void run_dispatcher()
+            {
+                const auto heartbeat = std::chrono::milliseconds(std::max<uint32_t>(1, config_.heartbeat_interval_ms));
+                const auto ready = [this](SendScheduler::PeerKey id)
+                { return transport_->pending_bytes(id) < TRANSPORT_HIGH_WATER; };
+
+                std::unique_lock<std::mutex> lock(qos_mutex_);
+                next_heartbeat_ = Clock::now() + heartbeat;
+                auto next_gossip_tick = Clock::now() + GOSSIP_TICK;
+                while (!dispatcher_stop_)
+                {
+                    const auto now = Clock::now();
+                    if (now >= next_heartbeat_)
+                    {
+                        next_heartbeat_ = now + heartbeat;
+                        lock.unlock();
+                        send_heartbeats();
+                        lock.lock();
+                        continue;
+                    }
+                    if (now >= next_gossip_tick)
+                    {
+                        next_gossip_tick = now + GOSSIP_TICK;
+                        lock.unlock();
+                        tick_mesh();
+                        lock.lock();
+                        continue;
+                    }
+                    const auto next_timer = std::min(next_heartbeat_, next_gossip_tick);
+                    if (!bucket_.ready(now))
+                    {
+                        qos_cv_.wait_until(lock, std::min(bucket_.ready_at(now), next_timer));
+                        continue;
+                    }
+
+                    SendScheduler::PeerKey id = 0;
+                    std::vector<uint8_t> frame;
+                    if (!scheduler_.next(id, frame, ready))
+                    {
+                        // Idle, or every backlogged peer's socket is full (written frames notify us)
+                        const auto wait = scheduler_.empty() ? std::chrono::milliseconds(100) : std::chrono::milliseconds(5);
+                        qos_cv_.wait_until(lock, std::min(now + wait, next_timer));
+                        continue;
+                    }
+
+                    const size_t size = frame.size();
+                    bucket_.consume(size + wire::varint_size(size), now);
+                    lock.unlock();
+                    const bool sent = transport_->send(id, std::move(frame));
+                    lock.lock();
+                    if (sent)
+                    {
+                        record_sent(size, now);
+                    }
+                    else
+                    {
+                        ++frames_lost_;
+                    }
+                }
+            }
+
+            void stop_dispatcher()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(qos_mutex_);
+                    dispatcher_stop_ = true;
+                }
+                qos_cv_.notify_all();
+                if (dispatcher_.joinable())
+                {
+                    dispatcher_.join();
                 }
             }
         };
 
         P2PNetwork::P2PNetwork() : pimpl_(std::make_unique<Impl>()) {}
-        P2PNetwork::~P2PNetwork() = default;
+
+        P2PNetwork::~P2PNetwork()
+        {
+            shutdown();
+        }
 
         bool P2PNetwork::initialize(const std::string &listen_address, uint16_t port)
         {
@@ -167,28 +973,106 @@ namespace cardano_iot
             pimpl_->listen_port_ = port;
             pimpl_->config_.listen_address = listen_address;
             pimpl_->config_.listen_port = port;
+            pimpl_->local_peer_id_ = pimpl_->generate_peer_id();
+
+            if (!pimpl_->transport_)
+            {
+                SocketTransport::Options options;
+                options.io_threads = pimpl_->config_.io_threads;
+                options.max_connections = pimpl_->config_.max_connections;
+                options.max_frame_bytes = pimpl_->config_.max_message_bytes;
+                pimpl_->transport_ = std::make_unique<SocketTransport>(options);
+
+                Impl *impl = pimpl_.get();
+                pimpl_->transport_->set_handlers(
+                    [impl](SocketTransport::ConnectionId id, const std::string &endpoint, bool inbound)
+                    { impl->on_connect(id, endpoint, inbound); },
+                    [impl](SocketTransport::ConnectionId id, const uint8_t *data, size_t size)
+                    { impl->on_frame(id, data, size); },
+                    [impl](SocketTransport::ConnectionId id)
+                    { impl->on_close(id); });
+                pimpl_->transport_->set_buffer_recycler(
+                    [impl](std::vector<uint8_t> &&buffer)
+                    {
+                        impl->buffer_pool_.release(std::move(buffer));
+                        impl->qos_cv_.notify_one(); // socket space freed up for the dispatcher
+                    });
+            }
+            if (!pimpl_->transport_->start())
+            {
+                utils::Logger::instance().log(utils::LogLevel::ERROR, "P2PNetwork",
+                                              "Failed to start socket transport");
+                return false;
+            }
+
+            pimpl_->apply_bandwidth_limit(pimpl_->config_.bandwidth_limit_kbps);
+            {
+                GossipEngine::Config gossip;
+                gossip.local_id = pimpl_->local_peer_id_;
+                gossip.eager_fanout = pimpl_->config_.gossip_fanout;
+                gossip.batch_window = std::chrono::milliseconds(pimpl_->config_.gossip_batch_window_ms);
+                std::lock_guard<std::mutex> gossip_lock(pimpl_->gossip_mutex_);
+                pimpl_->gossip_ = std::make_unique<GossipEngine>(gossip);
+            }
+            {
+                std::lock_guard<std::mutex> routing_lock(pimpl_->routing_mutex_);
+                pimpl_->routing_ = std::make_unique<RoutingTable>(pimpl_->local_peer_id_);
+                pimpl_->topology_version_ = UINT64_MAX;
+            }
+            pimpl_->dispatcher_stop_ = false;
+            pimpl_->dispatcher_ = std::thread([impl = pimpl_.get()]()
+                                              { impl->run_dispatcher(); });
 
             pimpl_->initialized_ = true;
 
             utils::Logger::instance().log(utils::LogLevel::INFO, "P2PNetwork",
-                                          "P2P network initialized on " + listen_address + ":" + std::to_string(port));
+                                          "P2P network initialized on " + listen_address + ":" + std::to_string(port) +
+                                              " as " + pimpl_->local_peer_id_);
             return true;
         }
 
         void P2PNetwork::shutdown()
         {
-            std::lock_guard<std::mutex> lock(pimpl_->network_mutex_);
+            {
+                std::lock_guard<std::mutex> lock(pimpl_->network_mutex_);
+                if (!pimpl_->initialized_)
+                {
+                    return;
+                }
+                pimpl_->initialized_ = false;
+            }
 
-            if (!pimpl_->initialized_)
+            // Close handlers take network_mutex_, so the transport stops without it held
+            pimpl_->stop_dispatcher();
+            pimpl_->transport_->stop();
             {
-                return;
+                std::lock_guard<std::mutex> qos_lock(pimpl_->qos_mutex_);
+                pimpl_->scheduler_ = SendScheduler();
+                pimpl_->outstanding_pings_.clear();
+                pimpl_->message_priorities_.clear();
+            }
+            {
+                std::lock_guard<std::mutex> gossip_lock(pimpl_->gossip_mutex_);
+                pimpl_->gossip_.reset();
+            }
+            {
+                std::lock_guard<std::mutex> routing_lock(pimpl_->routing_mutex_);
+                pimpl_->routing_.reset();
             }
 
-            stop_listening();
+            std::lock_guard<std::mutex> lock(pimpl_->network_mutex_);
+            pimpl_->listening_ = false;
             pimpl_->peers_.clear();
+            pimpl_->connections_.clear();
+            pimpl_->peer_connections_.clear();
+            for (auto &pending : pimpl_->pending_connects_)
+            {
+                pending.second->set_value("");
+            }
+            pimpl_->pending_connects_.clear();
             pimpl_->message_handlers_.clear();
+            pimpl_->view_handlers_.clear();
             pimpl_->peer_event_handler_ = nullptr;
-            pimpl_->initialized_ = false;
 
             utils::Logger::instance().log(utils::LogLevel::INFO, "P2PNetwork",
                                           "P2P network shutdown");
@@ -208,24 +1092,41 @@ namespace cardano_iot
                 return true;
             }
 
-            // Simulate starting listener
+            const uint16_t port = pimpl_->transport_->listen(pimpl_->listen_address_, pimpl_->listen_port_);
+            if (port == 0)
+            {
+                utils::Logger::instance().log(utils::LogLevel::ERROR, "P2PNetwork",
+                                              "Failed to listen on " + pimpl_->listen_address_ + ":" +
+                                                  std::to_string(pimpl_->listen_port_));
+                return false;
+            }
             pimpl_->listening_ = true;
 
             utils::Logger::instance().log(utils::LogLevel::INFO, "P2PNetwork",
                                           "Started listening on " + pimpl_->listen_address_ + ":" +
-                                              std::to_string(pimpl_->listen_port_));
+                                              std::to_string(port));
             return true;
         }
 
         void P2PNetwork::stop_listening()
         {
             std::lock_guard<std::mutex> lock(pimpl_->network_mutex_);
+            if (pimpl_->transport_)
+            {
+                pimpl_->transport_->stop_listening();
+            }
             pimpl_->listening_ = false;
 
             utils::Logger::instance().log(utils::LogLevel::INFO, "P2PNetwork",
                                           "Stopped listening");
         }
 
+        uint16_t P2PNetwork::get_listening_port() const
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->network_mutex_);
+            return pimpl_->listening_ && pimpl_->transport_ ? pimpl_->transport_->listening_port() : 0;
+        }
+
         bool P2PNetwork::connect_to_peer(const std::string &endpoint)
         {
             if (!pimpl_->initialized_)
@@ -233,40 +1134,95 @@ namespace cardano_iot
                 return false;
             }
 
-            pimpl_->simulate_network_delay();
-
-            // Create mock peer connection
-            auto peer = pimpl_->create_mock_peer(endpoint);
+            const auto colon = endpoint.rfind(':');
+            const unsigned long port = colon == std::string::npos ? 0 : std::strtoul(endpoint.c_str() + colon + 1, nullptr, 10);
+            if (port == 0 || port > UINT16_MAX)
+            {
+                utils::Logger::instance().log(utils::LogLevel::ERROR, "P2PNetwork",
+                                              "Invalid peer endpoint (expected host:port): " + endpoint);
+                return false;
+            }
+            std::string host = endpoint.substr(0, colon);
+            if (host.size() >= 2 && host.front() == '[' && host.back() == ']')
+            {
+                host = host.substr(1, host.size() - 2);
+            }
 
+            auto handshake = std::make_shared<std::promise<std::string>>();
+            auto peer_id = handshake->get_future();
+            SocketTransport::ConnectionId id = 0;
             {
+                // Held across connect() so the handshake cannot complete before it is awaited
                 std::lock_guard<std::mutex> lock(pimpl_->network_mutex_);
-                pimpl_->peers_[peer.peer_id] = peer;
+                if (pimpl_->peer_connections_.size() >= pimpl_->config_.max_connections)
+                {
+                    utils::Logger::instance().log(utils::LogLevel::WARNING, "P2PNetwork",
+                                                  "Connection limit reached, not connecting to " + endpoint);
+                    return false;
+                }
+                id = pimpl_->transport_->connect(host, static_cast<uint16_t>(port));
+                if (id == 0)
+                {
+                    utils::Logger::instance().log(utils::LogLevel::ERROR, "P2PNetwork",
+                                                  "Cannot connect to peer: " + endpoint);
+                    return false;
+                }
+                pimpl_->pending_connects_[id] = handshake;
             }
 
-            pimpl_->handle_peer_connection(peer.peer_id, true);
-
-            utils::Logger::instance().log(utils::LogLevel::INFO, "P2PNetwork",
-                                          "Connected to peer: " + endpoint + " (ID: " + peer.peer_id + ")");
+            if (peer_id.wait_for(std::chrono::milliseconds(pimpl_->config_.connection_timeout_ms)) != std::future_status::ready)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(pimpl_->network_mutex_);
+                    pimpl_->pending_connects_.erase(id);
+                }
+                pimpl_->transport_->close(id);
+                utils::Logger::instance().log(utils::LogLevel::WARNING, "P2PNetwork",
+                                              "Handshake with " + endpoint + " timed out");
+                return false;
+            }
+            if (peer_id.get().empty())
+            {
+                utils::Logger::instance().log(utils::LogLevel::WARNING, "P2PNetwork",
+                                              "Failed to connect to peer: " + endpoint);
+                return false;
+            }
             return true;
         }
 
         bool P2PNetwork::disconnect_from_peer(const std::string &peer_id)
         {
-            std::lock_guard<std::mutex> lock(pimpl_->network_mutex_);
-
-            auto it = pimpl_->peers_.find(peer_id);
-            if (it != pimpl_->peers_.end())
+            PeerInfo peer;
+            SocketTransport::ConnectionId id = 0;
             {
-                it->second.status = PeerStatus::DISCONNECTED;
-                pimpl_->handle_peer_connection(peer_id, false);
-                pimpl_->peers_.erase(it);
+                std::lock_guard<std::mutex> lock(pimpl_->network_mutex_);
 
-                utils::Logger::instance().log(utils::LogLevel::INFO, "P2PNetwork",
-                                              "Disconnected from peer: " + peer_id);
-                return true;
+                auto removed = pimpl_->peers_.erase(peer_id);
+                if (!removed)
+                {
+                    return false;
+                }
+                peer = removed->to_info();
+                peer.status = PeerStatus::DISCONNECTED;
+
+                auto link = pimpl_->peer_connections_.find(peer_id);
+                if (link != pimpl_->peer_connections_.end())
+                {
+                    id = link->second;
+                    pimpl_->peer_connections_.erase(link);
+                }
             }
 
-            return false;
+            if (id != 0)
+            {
+                pimpl_->transport_->close(id);
+            }
+            pimpl_->peer_left(peer_id);
+            pimpl_->handle_peer_connection(peer, false);
+
+            utils::Logger::instance().log(utils::LogLevel::INFO, "P2PNetwork",
+                                          "Disconnected from peer: " + peer_id);
+            return true;
         }
 
         bool P2PNetwork::is_listening() const
@@ -275,31 +1231,39 @@ namespace cardano_iot
             return pimpl_->listening_;
         }
 
-        std::vector<PeerInfo> P2PNetwork::get_connected_peers() const
+        std::string P2PNetwork::get_local_peer_id() const
         {
             std::lock_guard<std::mutex> lock(pimpl_->network_mutex_);
+            return pimpl_->local_peer_id_;
+        }
+
+        std::vector<PeerInfo> P2PNetwork::get_connected_peers() const
+        {
+            const auto snapshot = pimpl_->peers_.snapshot();
 
             std::vector<PeerInfo> connected_peers;
-            for (const auto &[peer_id, peer_info] : pimpl_->peers_)
+            connected_peers.reserve(snapshot->peers.size());
+            for (const auto &[peer_id, peer] : snapshot->peers)
             {
-                if (peer_info.status == PeerStatus::CONNECTED ||
-                    peer_info.status == PeerStatus::AUTHENTICATED)
+                if (peer->connected())
                 {
-                    connected_peers.push_back(peer_info);
+                    connected_peers.push_back(peer->to_info());
                 }
             }
 
             return connected_peers;
         }
 
-        PeerInfo P2PNetwork::get_peer_info(const std::string &peer_id) const
+        std::shared_ptr<const PeerSnapshot> P2PNetwork::get_peer_snapshot() const
         {
-            std::lock_guard<std::mutex> lock(pimpl_->network_mutex_);
+            return pimpl_->peers_.snapshot();
+        }
 
-            auto it = pimpl_->peers_.find(peer_id);
-            if (it != pimpl_->peers_.end())
+        PeerInfo P2PNetwork::get_peer_info(const std::string &peer_id) const
+        {
+            if (auto peer = pimpl_->peers_.find(peer_id))
             {
-                return it->second;
+                return peer->to_info();
             }
 
             return {}; // Return empty PeerInfo if not found
@@ -312,11 +1276,9 @@ namespace cardano_iot
             pimpl_->trusted_peers_.push_back(peer_id);
 
             // If peer is already connected, update its status
-            auto it = pimpl_->peers_.find(peer_id);
-            if (it != pimpl_->peers_.end())
+            if (pimpl_->peers_.set_public_key(peer_id, public_key))
             {
-                it->second.public_key = public_key;
-                it->second.status = PeerStatus::AUTHENTICATED;
+                pimpl_->peers_.find(peer_id)->status = PeerStatus::AUTHENTICATED;
             }
 
             utils::Logger::instance().log(utils::LogLevel::INFO, "P2PNetwork",
@@ -333,13 +1295,32 @@ namespace cardano_iot
         {
             std::lock_guard<std::mutex> lock(pimpl_->network_mutex_);
 
-            pimpl_->banned_peers_.push_back(peer_id);
+            // A repeated ban replaces the earlier term
+            auto &unban = pimpl_->banned_peers_[peer_id];
+            pimpl_->timers_.cancel(unban);
+            unban = {};
+            if (duration_seconds > 0)
+            {
+                Impl *impl = pimpl_.get();
+                unban = pimpl_->timers_.schedule_after(std::chrono::seconds(duration_seconds), [impl, peer_id]
+                                                       {
+                                                           {
+                                                               std::lock_guard<std::mutex> lock(impl->network_mutex_);
+                                                               impl->banned_peers_.erase(peer_id);
+                                                           }
+                                                           utils::Logger::instance().log(utils::LogLevel::INFO, "P2PNetwork",
+                                                                                         "Ban expired for peer: " + peer_id); });
+            }
 
             // Disconnect if currently connected
-            auto it = pimpl_->peers_.find(peer_id);
-            if (it != pimpl_->peers_.end())
+            if (auto peer = pimpl_->peers_.find(peer_id))
+            {
+                peer->status = PeerStatus::BANNED;
+            }
+            auto link = pimpl_->peer_connections_.find(peer_id);
+            if (link != pimpl_->peer_connections_.end())
             {
-                it->second.status = PeerStatus::BANNED;
+                pimpl_->transport_->close(link->second);
             }
 
             utils::Logger::instance().log(utils::LogLevel::WARNING, "P2PNetwork",
@@ -349,35 +1330,46 @@ namespace cardano_iot
 
         bool P2PNetwork::send_message(const std::string &peer_id, const NetworkMessage &message)
         {
+            PROFILE_SCOPE("P2PNetwork::send_message");
             if (!pimpl_->initialized_)
             {
                 return false;
             }
 
-            std::lock_guard<std::mutex> lock(pimpl_->network_mutex_);
-
-            auto it = pimpl_->peers_.find(peer_id);
-            if (it == pimpl_->peers_.end() ||
-                (it->second.status != PeerStatus::CONNECTED && it->second.status != PeerStatus::AUTHENTICATED))
+            // Peers beyond our neighbours go to the next hop, addressed so relays pass them on
+            const std::shared_ptr<PeerEntry> hop = pimpl_->next_hop_for(peer_id);
+            if (!hop)
             {
                 utils::Logger::instance().log(utils::LogLevel::ERROR, "P2PNetwork",
                                               "Cannot send message: peer not connected: " + peer_id);
                 return false;
             }
+            std::vector<uint8_t> frame;
+            if (hop->peer_id != peer_id && message.recipient_id != peer_id)
+            {
+                NetworkMessage routed = message;
+                routed.recipient_id = peer_id;
+                frame = pimpl_->encode_pooled(routed);
+            }
+            else
+            {
+                frame = pimpl_->encode_pooled(message);
+            }
 
-            pimpl_->simulate_network_delay();
-
-            // Update statistics
-            pimpl_->update_peer_stats(peer_id, message.payload.size(), true);
-
+            // Queued by priority and drained by the dispatcher; this never waits for the socket
+            if (!pimpl_->enqueue_frame(hop->connection_id, pimpl_->take_priority(message), std::move(frame)))
             {
-                std::lock_guard<std::mutex> stats_lock(pimpl_->stats_mutex_);
-                pimpl_->stats_.messages_sent++;
-                pimpl_->stats_.bytes_sent += message.payload.size();
+                utils::Logger::instance().log(utils::LogLevel::WARNING, "P2PNetwork",
+                                              "Send queue full or connection closed: " + peer_id);
+                return false;
             }
 
-            utils::Logger::instance().log(utils::LogLevel::INFO, "P2PNetwork",
-                                          "Sent message to peer: " + peer_id);
+            // Update statistics
+            hop->record_traffic(message.payload.size(), true, now_seconds());
+            pimpl_->messages_sent_.inc();
+            pimpl_->bytes_sent_.inc(message.payload.size());
+
+            CARDANO_IOT_LOG(utils::LogLevel::DEBUG, "P2PNetwork", "Sent message to peer: " << peer_id);
             return true;
         }
 
@@ -388,20 +1380,35 @@ namespace cardano_iot
                 return false;
             }
 
-            // Collect eligible peers under lock, then release lock to send
+            if (pimpl_->config_.enable_mesh_routing)
+            {
+                std::vector<GossipEngine::Outgoing> out;
+                bool fresh = false;
+                {
+                    std::lock_guard<std::mutex> lock(pimpl_->gossip_mutex_);
+                    fresh = pimpl_->gossip_ &&
+                            pimpl_->gossip_->broadcast(message, exclude_peers, std::chrono::steady_clock::now(), out);
+                }
+                if (!fresh)
+                {
+                    utils::Logger::instance().log(utils::LogLevel::WARNING, "P2PNetwork",
+                                                  "Broadcast id already seen, not sent: " + message.message_id);
+                    return false;
+                }
+                pimpl_->send_to_peers(out, pimpl_->take_priority(message));
+
+                CARDANO_IOT_LOG(utils::LogLevel::DEBUG, "P2PNetwork",
+                                "Gossiped message " << message.message_id << " to " << out.size() << " peers");
+                return true;
+            }
+
             std::vector<std::string> targets;
+            for (const auto &[peer_id, peer] : pimpl_->peers_.snapshot()->peers)
             {
-                std::lock_guard<std::mutex> lock(pimpl_->network_mutex_);
-                for (const auto &[peer_id, peer_info] : pimpl_->peers_)
+                if (peer->connected() &&
+                    std::find(exclude_peers.begin(), exclude_peers.end(), peer_id) == exclude_peers.end())
                 {
-                    if (std::find(exclude_peers.begin(), exclude_peers.end(), peer_id) != exclude_peers.end())
-                    {
-                        continue;
-                    }
-                    if (peer_info.status == PeerStatus::CONNECTED || peer_info.status == PeerStatus::AUTHENTICATED)
-                    {
-                        targets.push_back(peer_id);
-                    }
+                    targets.push_back(peer_id);
                 }
             }
 
@@ -445,6 +1452,15 @@ namespace cardano_iot
                                           "Message handler set for type: " + std::to_string(static_cast<int>(type)));
         }
 
+        void P2PNetwork::set_message_view_handler(MessageType type, MessageViewCallback callback)
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->network_mutex_);
+            pimpl_->view_handlers_[type] = callback;
+
+            utils::Logger::instance().log(utils::LogLevel::INFO, "P2PNetwork",
+                                          "Message view handler set for type: " + std::to_string(static_cast<int>(type)));
+        }
+
         void P2PNetwork::set_peer_event_handler(PeerCallback callback)
         {
             std::lock_guard<std::mutex> lock(pimpl_->network_mutex_);
@@ -470,8 +1486,6 @@ namespace cardano_iot
                 return {};
             }
 
-            pimpl_->simulate_network_delay();
-
             // Mock device discovery
             std::vector<std::string> discovered_devices = {
                 "iot_sensor_192.168.1.100:3001",
@@ -479,8 +1493,7 @@ namespace cardano_iot
                 "iot_actuator_192.168.1.102:3001"};
 
             {
-                std::lock_guard<std::mutex> lock(pimpl_->stats_mutex_);
-                pimpl_->stats_.discovery_attempts++;
+                pimpl_->discovery_attempts_.inc();
             }
 
             utils::Logger::instance().log(utils::LogLevel::INFO, "P2PNetwork",
@@ -517,23 +1530,37 @@ namespace cardano_iot
 
         MeshTopology P2PNetwork::get_mesh_topology() const
         {
-            std::lock_guard<std::mutex> lock(pimpl_->network_mutex_);
-
             MeshTopology topology;
-            topology.peers = pimpl_->peers_;
-            topology.total_peers = pimpl_->peers_.size();
-            topology.connected_peers = get_connected_peers().size();
-            topology.network_diameter = 3.5; // Mock diameter
-
-            // Create mock connections
-            for (const auto &[peer_id, peer_info] : pimpl_->peers_)
             {
-                if (peer_info.status == PeerStatus::CONNECTED || peer_info.status == PeerStatus::AUTHENTICATED)
+                std::lock_guard<std::mutex> lock(pimpl_->routing_mutex_);
+                if (pimpl_->routing_ && pimpl_->topology_version_ != pimpl_->routing_->version())
                 {
-                    topology.connections[peer_id] = {"peer1", "peer2", "peer3"}; // Mock connections
+                    pimpl_->topology_connections_.clear();
+                    pimpl_->topology_diameter_ = 0;
+                    std::vector<std::string> neighbors = pimpl_->routing_->neighbors();
+                    std::sort(neighbors.begin(), neighbors.end());
+                    pimpl_->topology_connections_[pimpl_->local_peer_id_] = std::move(neighbors);
+                    for (const auto &route : pimpl_->routing_->routes())
+                    {
+                        if (route.next_hop != route.destination)
+                        {
+                            pimpl_->topology_connections_[route.next_hop].push_back(route.destination);
+                        }
+                        pimpl_->topology_diameter_ = std::max(pimpl_->topology_diameter_, route.metric);
+                    }
+                    pimpl_->topology_version_ = pimpl_->routing_->version();
                 }
+                topology.connections = pimpl_->topology_connections_;
+                topology.network_diameter = pimpl_->topology_diameter_;
             }
 
+            const auto snapshot = pimpl_->peers_.snapshot();
+            for (const auto &[peer_id, peer] : snapshot->peers)
+            {
+                topology.peers.emplace(peer_id, peer->to_info());
+            }
+            topology.total_peers = static_cast<uint32_t>(snapshot->peers.size());
+            topology.connected_peers = static_cast<uint32_t>(snapshot->connected_count());
             return topology;
         }
 
@@ -553,13 +1580,19 @@ namespace cardano_iot
                 return {};
             }
 
-            // Mock route finding
-            std::vector<std::string> route = {"local", "intermediate_peer", target_peer_id};
-
-            utils::Logger::instance().log(utils::LogLevel::INFO, "P2PNetwork",
-                                          "Found route to " + target_peer_id + " via " + std::to_string(route.size() - 1) + " hops");
-
-            return route;
+            std::lock_guard<std::mutex> lock(pimpl_->routing_mutex_);
+            const RoutingTable::Route *route = pimpl_->routing_ ? pimpl_->routing_->lookup(target_peer_id) : nullptr;
+            if (!route)
+            {
+                return {};
+            }
+            CARDANO_IOT_LOG(utils::LogLevel::DEBUG, "P2PNetwork",
+                            "Route to " << target_peer_id << " via " << route->next_hop << " (" << route->metric << " hops)");
+            if (route->next_hop == target_peer_id)
+            {
+                return {pimpl_->local_peer_id_, target_peer_id};
+            }
+            return {pimpl_->local_peer_id_, route->next_hop, target_peer_id};
         }
 
         bool P2PNetwork::forward_message(const NetworkMessage &message, const std::string &next_hop)
@@ -583,58 +1616,59 @@ namespace cardano_iot
 
         bool P2PNetwork::request_peer_list_from(const std::string &peer_id)
         {
-            NetworkMessage request;
-            request.message_id = pimpl_->generate_message_id();
-            request.type = MessageType::MESH_UPDATE;
-            request.sender_id = "local";
-            request.recipient_id = peer_id;
-            request.payload = std::vector<uint8_t>{'r', 'e', 'q', 'u', 'e', 's', 't'};
-            request.timestamp = std::chrono::duration_cast<std::chrono::seconds>(
-                                    std::chrono::system_clock::now().time_since_epoch())
-                                    .count();
-
-            return send_message(peer_id, request);
+            if (!pimpl_->initialized_)
+            {
+                return false;
+            }
+            {
+                std::lock_guard<std::mutex> lock(pimpl_->routing_mutex_);
+                if (!pimpl_->routing_ || !pimpl_->routing_->is_neighbor(peer_id))
+                {
+                    return false;
+                }
+            }
+            return send_message(peer_id, pimpl_->mesh_update(peer_id, RoutingTable::UpdateKind::REQUEST, {}).message);
         }
 
         bool P2PNetwork::share_peer_list_with(const std::string &peer_id)
         {
-            NetworkMessage response;
-            response.message_id = pimpl_->generate_message_id();
-            response.type = MessageType::MESH_UPDATE;
-            response.sender_id = "local";
-            response.recipient_id = peer_id;
-            response.payload = std::vector<uint8_t>{'s', 'h', 'a', 'r', 'e'};
-            response.timestamp = std::chrono::duration_cast<std::chrono::seconds>(
-                                     std::chrono::system_clock::now().time_since_epoch())
-                                     .count();
-
-            return send_message(peer_id, response);
+            if (!pimpl_->initialized_)
+            {
+                return false;
+            }
+            NetworkMessage table;
+            {
+                std::lock_guard<std::mutex> lock(pimpl_->routing_mutex_);
+                if (!pimpl_->routing_ || !pimpl_->routing_->is_neighbor(peer_id))
+                {
+                    return false;
+                }
+                table = pimpl_->mesh_update(peer_id, RoutingTable::UpdateKind::FULL,
+                                            pimpl_->routing_->full_table_for(peer_id))
+                            .message;
+            }
+            return send_message(peer_id, table);
         }
 
         bool P2PNetwork::authenticate_peer(const std::string &peer_id, const std::string &challenge)
         {
-            std::lock_guard<std::mutex> lock(pimpl_->network_mutex_);
-
-            auto it = pimpl_->peers_.find(peer_id);
-            if (it != pimpl_->peers_.end())
+            if (auto peer = pimpl_->peers_.find(peer_id))
             {
                 // Simulate authentication process
                 bool auth_success = (challenge.length() > 10); // Simple mock
 
                 if (auth_success)
                 {
-                    it->second.status = PeerStatus::AUTHENTICATED;
+                    peer->status = PeerStatus::AUTHENTICATED;
 
-                    std::lock_guard<std::mutex> stats_lock(pimpl_->stats_mutex_);
-                    pimpl_->stats_.successful_authentications++;
+                    pimpl_->auth_succeeded_.inc();
 
                     utils::Logger::instance().log(utils::LogLevel::INFO, "P2PNetwork",
                                                   "Peer authenticated: " + peer_id);
                 }
                 else
                 {
-                    std::lock_guard<std::mutex> stats_lock(pimpl_->stats_mutex_);
-                    pimpl_->stats_.failed_authentications++;
+                    pimpl_->auth_failed_.inc();
 
                     utils::Logger::instance().log(utils::LogLevel::WARNING, "P2PNetwork",
                                                   "Peer authentication failed: " + peer_id);
@@ -651,8 +1685,8 @@ namespace cardano_iot
             // Mock signature verification
             bool valid = (signature.length() > 16 && !data.empty());
 
-            utils::Logger::instance().log(utils::LogLevel::DEBUG, "P2PNetwork",
-                                          "Signature verification for " + peer_id + ": " + (valid ? "valid" : "invalid"));
+            CARDANO_IOT_LOG(utils::LogLevel::DEBUG, "P2PNetwork",
+                            "Signature verification for " << peer_id << ": " << (valid ? "valid" : "invalid"));
             return valid;
         }
 
@@ -663,33 +1697,68 @@ namespace cardano_iot
 
         P2PNetwork::QoSMetrics P2PNetwork::get_qos_metrics() const
         {
-            QoSMetrics metrics;
-            metrics.packet_loss_rate = 0.01; // 1% packet loss
-            metrics.average_latency_ms = 75.0;
-            metrics.throughput_kbps = 1024.0;
-            metrics.active_connections = get_connected_peers().size();
-            metrics.message_queue_size = 0; // Mock empty queue
+            QoSMetrics metrics{};
+            {
+                double latency_total = 0.0;
+                uint32_t sampled = 0;
+                for (const auto &[peer_id, peer] : pimpl_->peers_.snapshot()->peers)
+                {
+                    if (peer->connected())
+                    {
+                        ++metrics.active_connections;
+                        const double latency = peer->latency_ms.load(std::memory_order_relaxed);
+                        if (latency > 0.0)
+                        {
+                            latency_total += latency;
+                            ++sampled;
+                        }
+                    }
+                }
+                metrics.average_latency_ms = sampled == 0 ? 0.0 : latency_total / sampled;
+            }
 
+            metrics.throughput_kbps = pimpl_->measured_throughput_kbps();
+            std::lock_guard<std::mutex> lock(pimpl_->qos_mutex_);
+            metrics.packet_loss_rate = pimpl_->frames_attempted_ == 0
+                                           ? 0.0
+                                           : std::min(1.0, static_cast<double>(pimpl_->frames_lost_) /
+                                                               static_cast<double>(pimpl_->frames_attempted_));
+            metrics.message_queue_size = static_cast<uint32_t>(pimpl_->scheduler_.queued_frames());
             return metrics;
         }
 
         bool P2PNetwork::set_bandwidth_limit(uint32_t kbps)
         {
+            pimpl_->config_.bandwidth_limit_kbps = kbps;
+            pimpl_->apply_bandwidth_limit(kbps);
+
             utils::Logger::instance().log(utils::LogLevel::INFO, "P2PNetwork",
-                                          "Bandwidth limit set to " + std::to_string(kbps) + " kbps");
+                                          kbps == 0 ? std::string("Bandwidth limit removed")
+                                                    : "Bandwidth limit set to " + std::to_string(kbps) + " kbps");
             return true;
         }
 
         bool P2PNetwork::set_message_priority(const std::string &message_id, uint8_t priority)
         {
-            utils::Logger::instance().log(utils::LogLevel::DEBUG, "P2PNetwork",
-                                          "Message priority set: " + message_id + " -> " + std::to_string(priority));
+            std::lock_guard<std::mutex> lock(pimpl_->qos_mutex_);
+            if (pimpl_->message_priorities_.size() >= MAX_PENDING_PRIORITIES &&
+                pimpl_->message_priorities_.count(message_id) == 0)
+            {
+                utils::Logger::instance().log(utils::LogLevel::WARNING, "P2PNetwork",
+                                              "Too many pending message priorities, ignoring " + message_id);
+                return false;
+            }
+            pimpl_->message_priorities_[message_id] = priority;
+
+            CARDANO_IOT_LOG(utils::LogLevel::DEBUG, "P2PNetwork",
+                            "Message priority set: " << message_id << " -> " << static_cast<int>(priority));
             return true;
         }
 
         void P2PNetwork::update_config(const P2PConfig &config)
         {
             pimpl_->config_ = config;
+            pimpl_->apply_bandwidth_limit(config.bandwidth_limit_kbps);
 
             utils::Logger::instance().log(utils::LogLevel::INFO, "P2PNetwork",
                                           "Configuration updated");
@@ -702,14 +1771,28 @@ namespace cardano_iot
 
         P2PNetwork::NetworkStats P2PNetwork::get_statistics() const
         {
-            std::lock_guard<std::mutex> lock(pimpl_->stats_mutex_);
-            return pimpl_->stats_;
+            NetworkStats stats = {};
+            stats.messages_sent = pimpl_->messages_sent_.value();
+            stats.messages_received = pimpl_->messages_received_.value();
+            stats.bytes_sent = pimpl_->bytes_sent_.value();
+            stats.bytes_received = pimpl_->bytes_received_.value();
+            stats.connections_established = pimpl_->connections_established_.value();
+            stats.connections_lost = pimpl_->connections_lost_.value();
+            stats.discovery_attempts = pimpl_->discovery_attempts_.value();
+            stats.successful_authentications = pimpl_->auth_succeeded_.value();
+            stats.failed_authentications = pimpl_->auth_failed_.value();
+            stats.gossip_delivered = pimpl_->gossip_delivered_.value();
+            stats.gossip_duplicates = pimpl_->gossip_duplicates_.value();
+            stats.messages_relayed = pimpl_->messages_relayed_.value();
+            return stats;
         }
 
         void P2PNetwork::reset_statistics()
         {
-            std::lock_guard<std::mutex> lock(pimpl_->stats_mutex_);
-            pimpl_->stats_ = {};
+            for (auto *counter : pimpl_->counters())
+            {
+                counter->reset();
+            }
 
             utils::Logger::instance().log(utils::LogLevel::INFO, "P2PNetwork",
                                           "Statistics reset");
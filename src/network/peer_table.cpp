@@ -0,0 +1,123 @@
+#include "cardano_iot/network/peer_table.h"
+
+#include <algorithm>
+
+namespace cardano_iot
+{
+    namespace network
+    {
+        PeerEntry::PeerEntry(const PeerInfo &info, uint64_t connection)
+            : peer_id(info.peer_id), endpoint(info.endpoint), public_key(info.public_key),
+              capabilities(info.capabilities), connection_id(connection), status(info.status),
+              last_seen(info.last_seen), bytes_sent(info.bytes_sent), bytes_received(info.bytes_received),
+              latency_ms(info.latency_ms)
+        {
+        }
+
+        void PeerEntry::record_traffic(uint64_t bytes, bool sent, uint64_t now_seconds)
+        {
+            (sent ? bytes_sent : bytes_received).fetch_add(bytes, std::memory_order_relaxed);
+            last_seen.store(now_seconds, std::memory_order_relaxed);
+        }
+
+        void PeerEntry::record_latency(double rtt_ms, double smoothing)
+        {
+            double latency = latency_ms.load(std::memory_order_relaxed);
+            double updated;
+            do
+            {
+                updated = latency <= 0.0 ? rtt_ms : latency + smoothing * (rtt_ms - latency);
+            } while (!latency_ms.compare_exchange_weak(latency, updated, std::memory_order_relaxed));
+        }
+
+        PeerInfo PeerEntry::to_info() const
+        {
+            PeerInfo info;
+            info.peer_id = peer_id;
+            info.endpoint = endpoint;
+            info.public_key = public_key;
+            info.status = status.load(std::memory_order_relaxed);
+            info.last_seen = last_seen.load(std::memory_order_relaxed);
+            info.bytes_sent = bytes_sent.load(std::memory_order_relaxed);
+            info.bytes_received = bytes_received.load(std::memory_order_relaxed);
+            info.latency_ms = latency_ms.load(std::memory_order_relaxed);
+            info.capabilities = capabilities;
+            return info;
+        }
+
+        size_t PeerSnapshot::connected_count() const
+        {
+            return static_cast<size_t>(std::count_if(peers.begin(), peers.end(), [](const auto &entry)
+                                                     { return entry.second->connected(); }));
+        }
+
+        PeerTable::PeerTable() : current_(std::make_shared<PeerSnapshot>())
+        {
+        }
+
+        std::shared_ptr<const PeerSnapshot> PeerTable::snapshot() const
+        {
+            return std::atomic_load(&current_);
+        }
+
+        std::shared_ptr<PeerEntry> PeerTable::find(const std::string &peer_id) const
+        {
+            const auto current = snapshot();
+            auto it = current->peers.find(peer_id);
+            return it != current->peers.end() ? it->second : nullptr;
+        }
+
+        void PeerTable::insert(const PeerInfo &info, uint64_t connection_id)
+        {
+            std::lock_guard<std::mutex> lock(write_mutex_);
+            auto next = std::make_shared<PeerSnapshot>(*std::atomic_load(&current_));
+            next->peers[info.peer_id] = std::make_shared<PeerEntry>(info, connection_id);
+            ++next->version;
+            std::atomic_store(&current_, std::shared_ptr<const PeerSnapshot>(std::move(next)));
+        }
+
+        std::shared_ptr<PeerEntry> PeerTable::erase(const std::string &peer_id)
+        {
+            std::lock_guard<std::mutex> lock(write_mutex_);
+            const auto current = std::atomic_load(&current_);
+            auto it = current->peers.find(peer_id);
+            if (it == current->peers.end())
+            {
+                return nullptr;
+            }
+            std::shared_ptr<PeerEntry> removed = it->second;
+            auto next = std::make_shared<PeerSnapshot>(*current);
+            next->peers.erase(peer_id);
+            ++next->version;
+            std::atomic_store(&current_, std::shared_ptr<const PeerSnapshot>(std::move(next)));
+            return removed;
+        }
+
+        bool PeerTable::set_public_key(const std::string &peer_id, const std::string &public_key)
+        {
+            std::lock_guard<std::mutex> lock(write_mutex_);
+            const auto current = std::atomic_load(&current_);
+            auto it = current->peers.find(peer_id);
+            if (it == current->peers.end())
+            {
+                return false;
+            }
+            PeerInfo info = it->second->to_info();
+            info.public_key = public_key;
+            auto next = std::make_shared<PeerSnapshot>(*current);
+            next->peers[peer_id] = std::make_shared<PeerEntry>(info, it->second->connection_id);
+            ++next->version;
+            std::atomic_store(&current_, std::shared_ptr<const PeerSnapshot>(std::move(next)));
+            return true;
+        }
+
+        void PeerTable::clear()
+        {
+            std::lock_guard<std::mutex> lock(write_mutex_);
+            auto next = std::make_shared<PeerSnapshot>();
+            next->version = std::atomic_load(&current_)->version + 1;
+            std::atomic_store(&current_, std::shared_ptr<const PeerSnapshot>(std::move(next)));
+        }
+
+    } // namespace network
+} // namespace cardano_iot
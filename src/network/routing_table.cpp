@@ -0,0 +1,370 @@
+#include "cardano_iot/network/routing_table.h"
+#include "cardano_iot/network/wire_format.h"
+
+#include <algorithm>
+
+namespace cardano_iot
+{
+    namespace network
+    {
+        namespace
+        {
+            void put_varint(std::vector<uint8_t> &out, uint64_t value)
+            {
+                uint8_t buffer[wire::MAX_VARINT_BYTES];
+                out.insert(out.end(), buffer, buffer + wire::put_varint(value, buffer));
+            }
+        } // namespace
+
+        RoutingTable::RoutingTable(std::string local_id, uint32_t max_metric)
+            : local_id_(std::move(local_id)), max_metric_(std::max<uint32_t>(2, max_metric))
+        {
+        }
+
+        std::vector<std::string> RoutingTable::neighbors() const
+        {
+            std::vector<std::string> result;
+            result.reserve(neighbors_.size());
+            for (const auto &neighbor : neighbors_)
+            {
+                result.push_back(neighbor.first);
+            }
+            return result;
+        }
+
+        void RoutingTable::bump_sequence()
+        {
+            sequence_ += 2;
+            changed_.insert(local_id_);
+        }
+
+        void RoutingTable::add_neighbor(const std::string &peer_id, uint32_t cost)
+        {
+            if (peer_id == local_id_)
+            {
+                return;
+            }
+            const bool fresh = neighbors_.count(peer_id) == 0;
+            neighbors_[peer_id] = std::max<uint32_t>(1, cost);
+            recompute(peer_id);
+            if (fresh)
+            {
+                bump_sequence();
+            }
+        }
+
+        void RoutingTable::remove_neighbor(const std::string &peer_id)
+        {
+            if (neighbors_.erase(peer_id) == 0)
+            {
+                return;
+            }
+            std::vector<std::string> affected{peer_id};
+            auto it = advertised_.find(peer_id);
+            if (it != advertised_.end())
+            {
+                for (const auto &entry : it->second)
+                {
+                    affected.push_back(entry.first);
+                }
+                advertised_.erase(it);
+            }
+            for (const auto &destination : affected)
+            {
+                // Routes through the lost link are withdrawn at their next odd sequence first,
+                // so the stale copies other neighbours still hold cannot bring them back
+                auto route = routes_.find(destination);
+                if (route != routes_.end() && route->second.next_hop == peer_id)
+                {
+                    const uint64_t sequence = route->second.sequence | 1;
+                    routes_.erase(route);
+                    withdraw(destination, sequence);
+                    ++version_;
+                }
+                recompute(destination);
+            }
+            bump_sequence();
+        }
+
+        void RoutingTable::withdraw(const std::string &destination, uint64_t sequence)
+        {
+            uint64_t &withdrawn = withdrawn_[destination];
+            withdrawn = std::max(withdrawn, sequence);
+            changed_.insert(destination);
+        }
+
+        void RoutingTable::apply_update(const std::string &neighbor, const std::vector<Advert> &adverts, bool full)
+        {
+            if (!is_neighbor(neighbor))
+            {
+                return;
+            }
+            auto &known = advertised_[neighbor];
+            std::vector<std::string> affected;
+            if (full)
+            {
+                for (const auto &entry : known)
+                {
+                    affected.push_back(entry.first);
+                }
+                known.clear();
+            }
+            for (const auto &advert : adverts)
+            {
+                if (advert.destination == local_id_)
+                {
+                    // Someone remembers a newer number for us (we restarted); move past it
+                    if (advert.sequence >= sequence_)
+                    {
+                        sequence_ = (advert.sequence + 2) & ~uint64_t(1);
+                        changed_.insert(local_id_);
+                    }
+                    continue;
+                }
+                known[advert.destination] = Heard{advert.metric, advert.sequence};
+                affected.push_back(advert.destination);
+            }
+            for (const auto &destination : affected)
+            {
+                recompute(destination);
+            }
+        }
+
+        // Re-evaluate one destination from the direct link and what each neighbour advertised
+        void RoutingTable::recompute(const std::string &destination)
+        {
+            if (destination == local_id_)
+            {
+                return;
+            }
+            auto current = routes_.find(destination);
+            auto withdrawn = withdrawn_.find(destination);
+            const std::string previous_hop = current != routes_.end() ? current->second.next_hop : std::string();
+
+            // Newest sequence wins, then the lowest metric; ties keep the existing next hop so routes do not flap
+            bool found = false;
+            Route best{destination, "", max_metric_, 0};
+            uint64_t newest_withdrawal = 0;
+            for (const auto &[neighbor, cost] : neighbors_)
+            {
+                auto known = advertised_.find(neighbor);
+                if (known == advertised_.end())
+                {
+                    continue;
+                }
+                auto heard = known->second.find(destination);
+                if (heard == known->second.end())
+                {
+                    continue;
+                }
+                const uint64_t sequence = heard->second.sequence;
+                const uint32_t metric = std::min<uint32_t>(max_metric_, cost + heard->second.metric);
+                if (heard->second.metric >= max_metric_)
+                {
+                    newest_withdrawal = std::max(newest_withdrawal, sequence);
+                    continue;
+                }
+                if (metric >= max_metric_ || (withdrawn != withdrawn_.end() && sequence <= withdrawn->second))
+                {
+                    continue;
+                }
+                if (!found || sequence > best.sequence ||
+                    (sequence == best.sequence &&
+                     (metric < best.metric || (metric == best.metric && neighbor == previous_hop))))
+                {
+                    found = true;
+                    best = Route{destination, neighbor, metric, sequence};
+                }
+            }
+            if (found && newest_withdrawal > best.sequence)
+            {
+                found = false;
+            }
+
+            // A direct link is first-hand evidence and beats any advert
+            auto direct = neighbors_.find(destination);
+            if (direct != neighbors_.end())
+            {
+                uint64_t sequence = found ? best.sequence : 0;
+                auto own = advertised_.find(destination);
+                if (own != advertised_.end())
+                {
+                    auto self = own->second.find(destination);
+                    if (self != own->second.end())
+                    {
+                        sequence = std::max(sequence, self->second.sequence);
+                    }
+                }
+                found = true;
+                best = Route{destination, destination, direct->second, sequence};
+            }
+
+            if (!found)
+            {
+                if (current != routes_.end())
+                {
+                    const uint64_t sequence = std::max(current->second.sequence | 1, newest_withdrawal);
+                    routes_.erase(current);
+                    withdraw(destination, sequence);
+                    ++version_;
+                }
+                else if (newest_withdrawal != 0 && (withdrawn == withdrawn_.end() || withdrawn->second < newest_withdrawal))
+                {
+                    withdrawn_[destination] = newest_withdrawal; // remembered so stale adverts stay rejected
+                }
+                return;
+            }
+
+            if (withdrawn != withdrawn_.end())
+            {
+                withdrawn_.erase(withdrawn);
+            }
+            if (current != routes_.end() && current->second.next_hop == best.next_hop &&
+                current->second.metric == best.metric && current->second.sequence == best.sequence)
+            {
+                return;
+            }
+            routes_[destination] = std::move(best);
+            changed_.insert(destination);
+            ++version_;
+        }
+
+        const RoutingTable::Route *RoutingTable::lookup(const std::string &destination) const
+        {
+            auto it = routes_.find(destination);
+            return it != routes_.end() ? &it->second : nullptr;
+        }
+
+        std::vector<std::string> RoutingTable::take_changes()
+        {
+            std::vector<std::string> changes(changed_.begin(), changed_.end());
+            changed_.clear();
+            return changes;
+        }
+
+        std::vector<RoutingTable::Advert> RoutingTable::adverts_for(const std::string &neighbor,
+                                                                    const std::vector<std::string> &destinations) const
+        {
+            std::vector<Advert> adverts;
+            adverts.reserve(destinations.size());
+            for (const auto &destination : destinations)
+            {
+                if (destination == neighbor)
+                {
+                    continue;
+                }
+                if (destination == local_id_)
+                {
+                    adverts.push_back({local_id_, 0, sequence_});
+                    continue;
+                }
+                auto route = routes_.find(destination);
+                if (route != routes_.end())
+                {
+                    // Poisoned reverse: never offer a neighbour the route it gave us
+                    const bool through = route->second.next_hop == neighbor;
+                    adverts.push_back({destination, through ? max_metric_ : route->second.metric, route->second.sequence});
+                    continue;
+                }
+                auto withdrawn = withdrawn_.find(destination);
+                if (withdrawn != withdrawn_.end())
+                {
+                    adverts.push_back({destination, max_metric_, withdrawn->second});
+                }
+            }
+            return adverts;
+        }
+
+        std::vector<RoutingTable::Advert> RoutingTable::full_table_for(const std::string &neighbor) const
+        {
+            std::vector<Advert> adverts;
+            adverts.reserve(routes_.size() + 1);
+            adverts.push_back({local_id_, 0, sequence_});
+            for (const auto &[destination, route] : routes_)
+            {
+                if (destination != neighbor && route.next_hop != neighbor)
+                {
+                    adverts.push_back({destination, route.metric, route.sequence});
+                }
+            }
+            return adverts;
+        }
+
+        std::vector<RoutingTable::Route> RoutingTable::routes() const
+        {
+            std::vector<Route> result;
+            result.reserve(routes_.size());
+            for (const auto &entry : routes_)
+            {
+                result.push_back(entry.second);
+            }
+            return result;
+        }
+
+        std::vector<uint8_t> RoutingTable::encode(UpdateKind kind, const std::vector<Advert> &adverts)
+        {
+            std::vector<uint8_t> out;
+            out.push_back(static_cast<uint8_t>(kind));
+            put_varint(out, adverts.size());
+            for (const auto &advert : adverts)
+            {
+                put_varint(out, advert.destination.size());
+                out.insert(out.end(), advert.destination.begin(), advert.destination.end());
+                put_varint(out, advert.metric);
+                put_varint(out, advert.sequence);
+            }
+            return out;
+        }
+
+        bool RoutingTable::decode(const uint8_t *data, size_t size, UpdateKind &kind, std::vector<Advert> &adverts)
+        {
+            if (size < 2 || data[0] > static_cast<uint8_t>(UpdateKind::DELTA))
+            {
+                return false;
+            }
+            kind = static_cast<UpdateKind>(data[0]);
+            size_t offset = 1;
+            uint64_t count = 0;
+            size_t consumed = wire::get_varint(data + offset, size - offset, count);
+            if (consumed == 0 || count > size)
+            {
+                return false;
+            }
+            offset += consumed;
+            adverts.clear();
+            adverts.reserve(static_cast<size_t>(count));
+            for (uint64_t i = 0; i < count; ++i)
+            {
+                uint64_t length = 0;
+                consumed = wire::get_varint(data + offset, size - offset, length);
+                if (consumed == 0 || length > size - offset - consumed)
+                {
+                    return false;
+                }
+                offset += consumed;
+                Advert advert;
+                advert.destination.assign(reinterpret_cast<const char *>(data + offset), static_cast<size_t>(length));
+                offset += static_cast<size_t>(length);
+
+                uint64_t metric = 0;
+                consumed = wire::get_varint(data + offset, size - offset, metric);
+                if (consumed == 0)
+                {
+                    return false;
+                }
+                offset += consumed;
+                advert.metric = static_cast<uint32_t>(std::min<uint64_t>(metric, UINT32_MAX));
+
+                consumed = wire::get_varint(data + offset, size - offset, advert.sequence);
+                if (consumed == 0)
+                {
+                    return false;
+                }
+                offset += consumed;
+                adverts.push_back(std::move(advert));
+            }
+            return offset == size;
+        }
+
+    } // namespace network
+} // namespace cardano_iot
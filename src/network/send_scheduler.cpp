@@ -0,0 +1,234 @@
+#include "cardano_iot/network/send_scheduler.h"
+
+#include <algorithm>
+
+namespace cardano_iot
+{
+    namespace network
+    {
+        namespace
+        {
+            constexpr size_t CRITICAL_INDEX = 0;
+            constexpr size_t WEIGHTED_CLASSES = 3;
+        } // namespace
+
+        SendScheduler::SendScheduler() : SendScheduler(Config{}) {}
+
+        SendScheduler::SendScheduler(const Config &config) : config_(config)
+        {
+            config_.quantum_bytes = std::max<size_t>(1, config_.quantum_bytes);
+            for (auto &weight : config_.weights)
+            {
+                weight = std::max<uint32_t>(1, weight);
+            }
+        }
+
+        SendScheduler::TrafficClass SendScheduler::class_for_priority(uint8_t priority)
+        {
+            return static_cast<TrafficClass>(3 - (priority >> 6));
+        }
+
+        bool SendScheduler::enqueue(PeerKey peer, uint8_t priority, std::vector<uint8_t> frame)
+        {
+            size_t &peer_bytes = peer_bytes_[peer];
+            if (peer_bytes + frame.size() > config_.max_queued_bytes_per_peer)
+            {
+                if (peer_bytes == 0)
+                {
+                    peer_bytes_.erase(peer);
+                }
+                return false;
+            }
+            peer_bytes += frame.size();
+            queued_bytes_ += frame.size();
+            ++queued_frames_;
+
+            ClassQueue &queue = classes_[static_cast<size_t>(class_for_priority(priority))];
+            auto &frames = queue.queues[peer];
+            if (frames.empty())
+            {
+                queue.ring.push_back(peer);
+            }
+            frames.push_back(std::move(frame));
+            ++queue.frames;
+            return true;
+        }
+
+        // Rotate not-ready peers to the back; returns the ready peer's queue now at the front of the ring
+        std::deque<std::vector<uint8_t>> *SendScheduler::front_ready(ClassQueue &queue, const ReadyPredicate &ready)
+        {
+            for (size_t i = 0; i < queue.ring.size(); ++i)
+            {
+                const PeerKey peer = queue.ring.front();
+                if (!ready || ready(peer))
+                {
+                    return &queue.queues[peer];
+                }
+                queue.ring.pop_front();
+                queue.ring.push_back(peer);
+            }
+            return nullptr;
+        }
+
+        void SendScheduler::pop_front(ClassQueue &queue, PeerKey &peer, std::vector<uint8_t> &frame)
+        {
+            peer = queue.ring.front();
+            queue.ring.pop_front();
+            auto it = queue.queues.find(peer);
+            frame = std::move(it->second.front());
+            it->second.pop_front();
+            if (it->second.empty())
+            {
+                queue.queues.erase(it);
+            }
+            else
+            {
+                queue.ring.push_back(peer); // round robin between peers of one class
+            }
+            --queue.frames;
+
+            --queued_frames_;
+            queued_bytes_ -= frame.size();
+            auto bytes = peer_bytes_.find(peer);
+            bytes->second -= frame.size();
+            if (bytes->second == 0)
+            {
+                peer_bytes_.erase(bytes);
+            }
+        }
+
+        bool SendScheduler::next(PeerKey &peer, std::vector<uint8_t> &frame, const ReadyPredicate &ready)
+        {
+            if (queued_frames_ == 0)
+            {
+                return false;
+            }
+            if (front_ready(classes_[CRITICAL_INDEX], ready))
+            {
+                pop_front(classes_[CRITICAL_INDEX], peer, frame);
+                return true;
+            }
+
+            // Deficit round robin over the weighted classes
+            size_t idle_visits = 0;
+            while (idle_visits < WEIGHTED_CLASSES)
+            {
+                ClassQueue &queue = classes_[current_ + 1];
+                auto *frames = front_ready(queue, ready);
+                if (!frames)
+                {
+                    if (queue.frames == 0)
+                    {
+                        deficit_[current_] = 0;
+                    }
+                    current_ = (current_ + 1) % WEIGHTED_CLASSES;
+                    topped_up_ = false;
+                    ++idle_visits;
+                    continue;
+                }
+                idle_visits = 0;
+
+                const size_t size = std::max<size_t>(1, frames->front().size());
+                if (deficit_[current_] < size)
+                {
+                    if (!topped_up_)
+                    {
+                        deficit_[current_] += config_.quantum_bytes * config_.weights[current_];
+                        topped_up_ = true;
+                        continue;
+                    }
+                    current_ = (current_ + 1) % WEIGHTED_CLASSES;
+                    topped_up_ = false;
+                    continue;
+                }
+
+                deficit_[current_] -= size;
+                pop_front(queue, peer, frame);
+                if (queue.frames == 0)
+                {
+                    deficit_[current_] = 0;
+                }
+                return true;
+            }
+            return false;
+        }
+
+        size_t SendScheduler::remove_peer(PeerKey peer)
+        {
+            size_t dropped = 0;
+            for (auto &queue : classes_)
+            {
+                auto it = queue.queues.find(peer);
+                if (it == queue.queues.end())
+                {
+                    continue;
+                }
+                for (const auto &frame : it->second)
+                {
+                    queued_bytes_ -= frame.size();
+                }
+                dropped += it->second.size();
+                queue.frames -= it->second.size();
+                queue.queues.erase(it);
+                queue.ring.erase(std::remove(queue.ring.begin(), queue.ring.end(), peer), queue.ring.end());
+            }
+            queued_frames_ -= dropped;
+            peer_bytes_.erase(peer);
+            return dropped;
+        }
+
+        TokenBucket::TokenBucket(uint64_t bytes_per_second, uint64_t burst_bytes)
+        {
+            set_rate(bytes_per_second, burst_bytes);
+        }
+
+        void TokenBucket::set_rate(uint64_t bytes_per_second, uint64_t burst_bytes)
+        {
+            rate_ = bytes_per_second;
+            burst_ = static_cast<double>(std::max<uint64_t>(1, burst_bytes));
+            tokens_ = std::min(tokens_, burst_);
+            last_refill_ = Clock::now();
+        }
+
+        void TokenBucket::refill(Clock::time_point now)
+        {
+            if (now > last_refill_)
+            {
+                const double elapsed = std::chrono::duration<double>(now - last_refill_).count();
+                tokens_ = std::min(burst_, tokens_ + elapsed * static_cast<double>(rate_));
+                last_refill_ = now;
+            }
+        }
+
+        bool TokenBucket::ready(Clock::time_point now)
+        {
+            if (rate_ == 0)
+            {
+                return true;
+            }
+            refill(now);
+            return tokens_ >= 0.0;
+        }
+
+        void TokenBucket::consume(uint64_t bytes, Clock::time_point now)
+        {
+            if (rate_ == 0)
+            {
+                return;
+            }
+            refill(now);
+            tokens_ -= static_cast<double>(bytes);
+        }
+
+        TokenBucket::Clock::time_point TokenBucket::ready_at(Clock::time_point now)
+        {
+            if (ready(now))
+            {
+                return now;
+            }
+            const auto wait = std::chrono::duration<double>(-tokens_ / static_cast<double>(rate_));
+            return now + std::chrono::duration_cast<Clock::duration>(wait) + std::chrono::microseconds(1);
+        }
+
+    } // namespace network
+} // namespace cardano_iot
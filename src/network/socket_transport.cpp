@@ -0,0 +1,1144 @@
+#include "cardano_iot/network/socket_transport.h"
+#include "cardano_iot/network/wire_format.h"
+#include "cardano_iot/utils/logger.h"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#else
+#include <poll.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace cardano_iot
+{
+    namespace network
+    {
+        namespace
+        {
+            constexpr uint64_t LISTENER_TOKEN = 0;
+            constexpr uint64_t WAKEUP_TOKEN = UINT64_MAX;
+            constexpr size_t READ_CHUNK = 64 * 1024;
+            constexpr size_t MAX_IOVECS = 64;
+            constexpr int LOOP_TIMEOUT_MS = 100;
+
+#if defined(MSG_NOSIGNAL)
+            constexpr int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+            constexpr int SEND_FLAGS = 0;
+#endif
+
+            bool set_non_blocking(int fd)
+            {
+                const int flags = fcntl(fd, F_GETFL, 0);
+                return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+            }
+
+            void configure_stream_socket(int fd)
+            {
+                int one = 1;
+                setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+#if defined(SO_NOSIGPIPE)
+                setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+                fcntl(fd, F_SETFD, FD_CLOEXEC);
+            }
+
+            std::string endpoint_of(const sockaddr_storage &address)
+            {
+                char host[INET6_ADDRSTRLEN] = {};
+                if (address.ss_family == AF_INET)
+                {
+                    const auto &in = reinterpret_cast<const sockaddr_in &>(address);
+                    inet_ntop(AF_INET, &in.sin_addr, host, sizeof(host));
+                    return std::string(host) + ":" + std::to_string(ntohs(in.sin_port));
+                }
+                if (address.ss_family == AF_INET6)
+                {
+                    const auto &in6 = reinterpret_cast<const sockaddr_in6 &>(address);
+                    inet_ntop(AF_INET6, &in6.sin6_addr, host, sizeof(host));
+                    return "[" + std::string(host) + "]:" + std::to_string(ntohs(in6.sin6_port));
+                }
+                return "unknown";
+            }
+
+            /**
+             * Readiness multiplexer owned by one event loop: epoll on Linux, poll()
+             * elsewhere. Only wake() may be called from other threads.
+             */
+            class Poller
+            {
+            public:
+                struct Event
+                {
+                    uint64_t token;
+                    bool readable;
+                    bool writable;
+                    bool error;
+                };
+
+#if defined(__linux__)
+                Poller()
+                {
+                    epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+                    wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+                    if (valid())
+                    {
+                        add(wake_fd_, WAKEUP_TOKEN, false);
+                    }
+                }
+
+                ~Poller()
+                {
+                    if (wake_fd_ >= 0)
+                    {
+                        ::close(wake_fd_);
+                    }
+                    if (epoll_fd_ >= 0)
+                    {
+                        ::close(epoll_fd_);
+                    }
+                }
+
+                bool valid() const { return epoll_fd_ >= 0 && wake_fd_ >= 0; }
+
+                void add(int fd, uint64_t token, bool want_write) { control(EPOLL_CTL_ADD, fd, token, want_write); }
+                void modify(int fd, uint64_t token, bool want_write) { control(EPOLL_CTL_MOD, fd, token, want_write); }
+                void remove(int fd) { epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr); }
+
+                void wait(std::vector<Event> &events, int timeout_ms)
+                {
+                    events.clear();
+                    std::array<epoll_event, 256> ready;
+                    const int count = epoll_wait(epoll_fd_, ready.data(), static_cast<int>(ready.size()), timeout_ms);
+                    for (int i = 0; i < count; ++i)
+                    {
+                        const uint32_t flags = ready[i].events;
+                        events.push_back({ready[i].data.u64, (flags & (EPOLLIN | EPOLLRDHUP)) != 0, (flags & EPOLLOUT) != 0,
+                                          (flags & (EPOLLERR | EPOLLHUP)) != 0});
+                    }
+                }
+
+                void wake()
+                {
+                    const uint64_t one = 1;
+                    [[maybe_unused]] auto written = ::write(wake_fd_, &one, sizeof(one));
+                }
+
+                void drain_wakeup()
+                {
+                    uint64_t value = 0;
+                    [[maybe_unused]] auto read = ::read(wake_fd_, &value, sizeof(value));
+                }
+
+            private:
+                void control(int operation, int fd, uint64_t token, bool want_write)
+                {
+                    epoll_event event{};
+                    event.events = EPOLLIN | EPOLLRDHUP | (want_write ? static_cast<uint32_t>(EPOLLOUT) : 0u);
+                    event.data.u64 = token;
+                    epoll_ctl(epoll_fd_, operation, fd, &event);
+                }
+
+                int epoll_fd_ = -1;
+                int wake_fd_ = -1;
+#else
+                Poller()
+                {
+                    if (::pipe(wake_pipe_) == 0)
+                    {
+                        set_non_blocking(wake_pipe_[0]);
+                        set_non_blocking(wake_pipe_[1]);
+                        add(wake_pipe_[0], WAKEUP_TOKEN, false);
+                    }
+                }
+
+                ~Poller()
+                {
+                    for (int fd : wake_pipe_)
+                    {
+                        if (fd >= 0)
+                        {
+                            ::close(fd);
+                        }
+                    }
+                }
+
+                bool valid() const { return wake_pipe_[0] >= 0; }
+
+                void add(int fd, uint64_t token, bool want_write)
+                {
+                    index_[fd] = fds_.size();
+                    fds_.push_back({fd, static_cast<short>(POLLIN | (want_write ? POLLOUT : 0)), 0});
+                    tokens_.push_back(token);
+                }
+
+                void modify(int fd, uint64_t, bool want_write)
+                {
+                    auto it = index_.find(fd);
+                    if (it != index_.end())
+                    {
+                        fds_[it->second].events = static_cast<short>(POLLIN | (want_write ? POLLOUT : 0));
+                    }
+                }
+
+                void remove(int fd)
+                {
+                    auto it = index_.find(fd);
+                    if (it == index_.end())
+                    {
+                        return;
+                    }
+                    const size_t slot = it->second;
+                    index_.erase(it);
+                    if (slot != fds_.size() - 1)
+                    {
+                        fds_[slot] = fds_.back();
+                        tokens_[slot] = tokens_.back();
+                        index_[fds_[slot].fd] = slot;
+                    }
+                    fds_.pop_back();
+                    tokens_.pop_back();
+                }
+
+                void wait(std::vector<Event> &events, int timeout_ms)
+                {
+                    events.clear();
+                    if (::poll(fds_.data(), static_cast<nfds_t>(fds_.size()), timeout_ms) <= 0)
+                    {
+                        return;
+                    }
+                    for (size_t i = 0; i < fds_.size(); ++i)
+                    {
+                        const short flags = fds_[i].revents;
+                        if (flags != 0)
+                        {
+                            events.push_back({tokens_[i], (flags & POLLIN) != 0, (flags & POLLOUT) != 0,
+                                              (flags & (POLLERR | POLLHUP | POLLNVAL)) != 0});
+                        }
+                    }
+                }
+
+                void wake()
+                {
+                    const char byte = 1;
+                    [[maybe_unused]] auto written = ::write(wake_pipe_[1], &byte, 1);
+                }
+
+                void drain_wakeup()
+                {
+                    char buffer[64];
+                    while (::read(wake_pipe_[0], buffer, sizeof(buffer)) > 0)
+                    {
+                    }
+                }
+
+            private:
+                int wake_pipe_[2] = {-1, -1};
+                std::vector<pollfd> fds_;
+                std::vector<uint64_t> tokens_;
+                std::unordered_map<int, size_t> index_;
+#endif
+            };
+
+            struct Frame
+            {
+                std::array<uint8_t, wire::MAX_VARINT_BYTES> header;
+                uint8_t header_size = 0;
+                std::vector<uint8_t> payload;
+
+                size_t wire_size() const { return header_size + payload.size(); }
+            };
+
+            // Registry entry shared between senders and the owning loop
+            struct ConnectionShared
+            {
+                std::atomic<size_t> pending_bytes{0};
+            };
+        } // namespace
+
+        class SocketTransport::Impl
+        {
+        public:
+            struct Command
+            {
+                enum class Kind
+                {
+                    ADOPT,
+                    SEND,
+                    CLOSE,
+                    LISTEN,
+                    UNLISTEN
+                };
+
+                Kind kind = Kind::SEND;
+                ConnectionId id = 0;
+                int fd = -1;
+                std::string endpoint;
+                bool inbound = false;
+                Frame frame;
+            };
+
+            struct Connection
+            {
+                int fd = -1;
+                ConnectionId id = 0;
+                std::string endpoint;
+                bool inbound = false;
+                bool connecting = false;
+                bool want_write = false;
+                std::vector<uint8_t> read_buffer; // partial frame carried between reads
+                std::deque<Frame> write_queue;
+                size_t write_offset = 0; // bytes of the front frame already written
+                std::shared_ptr<ConnectionShared> shared;
+            };
+
+            // One event-loop thread and the connections it owns
+            class Loop
+            {
+            public:
+                Loop(Impl &owner, size_t index) : owner_(owner), index_(index), scratch_(READ_CHUNK) {}
+
+                void post(Command &&command)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        commands_.push_back(std::move(command));
+                    }
+                    poller_.wake();
+                }
+
+                void wake() { poller_.wake(); }
+                bool valid() const { return poller_.valid(); }
+
+                void run()
+                {
+                    std::vector<Poller::Event> events;
+                    std::vector<Command> batch;
+                    while (true)
+                    {
+                        poller_.wait(events, LOOP_TIMEOUT_MS);
+                        for (const auto &event : events)
+                        {
+                            if (event.token == WAKEUP_TOKEN)
+                            {
+                                poller_.drain_wakeup();
+                            }
+                            else if (event.token == LISTENER_TOKEN)
+                            {
+                                accept_all();
+                            }
+                            else
+                            {
+                                handle_io(event);
+                            }
+                        }
+
+                        {
+                            std::lock_guard<std::mutex> lock(mutex_);
+                            batch.swap(commands_);
+                        }
+                        // Queue every frame first, then write each connection once
+                        for (auto &command : batch)
+                        {
+                            apply(std::move(command));
+                        }
+                        batch.clear();
+                        for (ConnectionId id : touched_)
+                        {
+                            auto it = connections_.find(id);
+                            if (it != connections_.end() && !flush(it->second))
+                            {
+                                close_connection(id);
+                            }
+                        }
+                        touched_.clear();
+
+                        if (owner_.stopping_.load(std::memory_order_acquire))
+                        {
+                            break;
+                        }
+                    }
+
+                    std::vector<ConnectionId> remaining;
+                    for (const auto &entry : connections_)
+                    {
+                        remaining.push_back(entry.first);
+                    }
+                    for (ConnectionId id : remaining)
+                    {
+                        close_connection(id);
+                    }
+                    close_listener();
+                }
+
+                void apply(Command &&command)
+                {
+                    switch (command.kind)
+                    {
+                    case Command::Kind::ADOPT:
+                        adopt(command.id, command.fd, std::move(command.endpoint), command.inbound);
+                        break;
+                    case Command::Kind::SEND:
+                    {
+                        auto it = connections_.find(command.id);
+                        if (it != connections_.end())
+                        {
+                            it->second.write_queue.push_back(std::move(command.frame));
+                            touched_.insert(command.id);
+                        }
+                        break;
+                    }
+                    case Command::Kind::CLOSE:
+                        close_connection(command.id);
+                        break;
+                    case Command::Kind::LISTEN:
+                        close_listener();
+                        listen_fd_ = command.fd;
+                        poller_.add(listen_fd_, LISTENER_TOKEN, false);
+                        break;
+                    case Command::Kind::UNLISTEN:
+                        close_listener();
+                        break;
+                    }
+                }
+
+                void adopt(ConnectionId id, int fd, std::string endpoint, bool inbound)
+                {
+                    Connection connection;
+                    connection.fd = fd;
+                    connection.id = id;
+                    connection.endpoint = std::move(endpoint);
+                    connection.inbound = inbound;
+                    connection.connecting = !inbound; // outbound: wait for writability, then check SO_ERROR
+                    connection.shared = owner_.lookup(id);
+                    if (!connection.shared)
+                    {
+                        ::close(fd); // closed before the loop saw it
+                        return;
+                    }
+                    poller_.add(fd, id, connection.connecting);
+                    connection.want_write = connection.connecting;
+                    auto &stored = connections_.emplace(id, std::move(connection)).first->second;
+                    if (inbound)
+                    {
+                        owner_.connections_accepted_.fetch_add(1, std::memory_order_relaxed);
+                        if (owner_.on_connect_)
+                        {
+                            owner_.on_connect_(id, stored.endpoint, true);
+                        }
+                    }
+                }
+
+                void accept_all()
+                {
+                    while (listen_fd_ >= 0)
+                    {
+                        sockaddr_storage address{};
+                        socklen_t length = sizeof(address);
+                        const int fd = ::accept(listen_fd_, reinterpret_cast<sockaddr *>(&address), &length);
+                        if (fd < 0)
+                        {
+                            if (errno == EINTR)
+                            {
+                                continue;
+                            }
+                            if (errno != EAGAIN && errno != EWOULDBLOCK)
+                            {
+                                utils::Logger::instance().log(utils::LogLevel::WARNING, "SocketTransport",
+                                                              std::string("accept failed: ") + std::strerror(errno));
+                            }
+                            return;
+                        }
+                        if (!set_non_blocking(fd) || owner_.connection_count() >= owner_.options_.max_connections)
+                        {
+                            ::close(fd);
+                            continue;
+                        }
+                        configure_stream_socket(fd);
+
+                        const ConnectionId id = owner_.register_connection();
+                        Command command;
+                        command.kind = Command::Kind::ADOPT;
+                        command.id = id;
+                        command.fd = fd;
+                        command.endpoint = endpoint_of(address);
+                        command.inbound = true;
+                        Loop &target = owner_.loop_for(id);
+                        if (&target == this)
+                        {
+                            apply(std::move(command));
+                        }
+                        else
+                        {
+                            target.post(std::move(command));
+                        }
+                    }
+                }
+
+                void handle_io(const Poller::Event &event)
+                {
+                    auto it = connections_.find(event.token);
+                    if (it == connections_.end())
+                    {
+                        return;
+                    }
+                    Connection &connection = it->second;
+
+                    if (connection.connecting)
+                    {
+                        if (!event.writable && !event.error)
+                        {
+                            return;
+                        }
+                        int error = 0;
+                        socklen_t length = sizeof(error);
+                        getsockopt(connection.fd, SOL_SOCKET, SO_ERROR, &error, &length);
+                        if (error != 0)
+                        {
+                            CARDANO_IOT_LOG(utils::LogLevel::DEBUG, "SocketTransport",
+                                            "Connect to " << connection.endpoint << " failed: " << std::strerror(error));
+                            close_connection(connection.id);
+                            return;
+                        }
+                        connection.connecting = false;
+                        owner_.connections_opened_.fetch_add(1, std::memory_order_relaxed);
+                        if (owner_.on_connect_)
+                        {
+                            owner_.on_connect_(connection.id, connection.endpoint, false);
+                        }
+                        if (!flush(connection))
+                        {
+                            close_connection(connection.id);
+                        }
+                        return;
+                    }
+
+                    if (event.readable && !read_frames(connection))
+                    {
+                        close_connection(connection.id);
+                        return;
+                    }
+                    if (event.writable && !flush(connection))
+                    {
+                        close_connection(connection.id);
+                        return;
+                    }
+                    if (event.error && !event.readable)
+                    {
+                        close_connection(connection.id);
+                    }
+                }
+
+                // Deliver every complete frame in [data, data + size); returns bytes consumed or SIZE_MAX on a bad frame
+                size_t parse_frames(Connection &connection, const uint8_t *data, size_t size)
+                {
+                    size_t position = 0;
+                    while (position < size)
+                    {
+                        uint64_t length = 0;
+                        const size_t prefix = wire::get_varint(data + position, size - position, length);
+                        if (prefix == 0 && size - position < wire::MAX_VARINT_BYTES)
+                        {
+                            break; // length prefix split across reads
+                        }
+                        if (prefix == 0 || length > owner_.options_.max_frame_bytes)
+                        {
+                            owner_.frames_rejected_.fetch_add(1, std::memory_order_relaxed);
+                            utils::Logger::instance().log(utils::LogLevel::WARNING, "SocketTransport",
+                                                          "Invalid or oversized frame length from " + connection.endpoint + ", closing");
+                            return SIZE_MAX;
+                        }
+                        if (size - position - prefix < length)
+                        {
+                            break;
+                        }
+                        owner_.frames_received_.fetch_add(1, std::memory_order_relaxed);
+                        if (owner_.on_frame_)
+                        {
+                            owner_.on_frame_(connection.id, data + position + prefix, static_cast<size_t>(length));
+                        }
+                        position += prefix + static_cast<size_t>(length);
+                    }
+                    return position;
+                }
+
+                bool read_frames(Connection &connection)
+                {
+                    while (true)
+                    {
+                        const ssize_t count = ::read(connection.fd, scratch_.data(), scratch_.size());
+                        if (count == 0)
+                        {
+                            return false; // orderly shutdown by the peer
+                        }
+                        if (count < 0)
+                        {
+                            if (errno == EINTR)
+                            {
+                                continue;
+                            }
+                            return errno == EAGAIN || errno == EWOULDBLOCK;
+                        }
+                        owner_.bytes_received_.fetch_add(static_cast<uint64_t>(count), std::memory_order_relaxed);
+
+                        const size_t size = static_cast<size_t>(count);
+                        if (connection.read_buffer.empty())
+                        {
+                            // Common case: frames are handed out straight from the scratch buffer
+                            const size_t consumed = parse_frames(connection, scratch_.data(), size);
+                            if (consumed == SIZE_MAX)
+                            {
+                                return false;
+                            }
+                            connection.read_buffer.assign(scratch_.begin() + consumed, scratch_.begin() + size);
+                        }
+                        else
+                        {
+                            auto &buffer = connection.read_buffer;
+                            buffer.insert(buffer.end(), scratch_.begin(), scratch_.begin() + size);
+                            const size_t consumed = parse_frames(connection, buffer.data(), buffer.size());
+                            if (consumed == SIZE_MAX)
+                            {
+                                return false;
+                            }
+                            buffer.erase(buffer.begin(), buffer.begin() + consumed);
+                        }
+                        if (connection.read_buffer.empty() && connection.read_buffer.capacity() > 4 * READ_CHUNK)
+                        {
+                            connection.read_buffer.shrink_to_fit();
+                        }
+                        if (size < scratch_.size())
+                        {
+                            return true; // drained; level-triggered polling reports anything that arrives later
+                        }
+                    }
+                }
+
+                // Write as much of the queue as the socket takes, many frames per syscall
+                bool flush(Connection &connection)
+                {
+                    if (connection.connecting)
+                    {
+                        return true;
+                    }
+                    while (!connection.write_queue.empty())
+                    {
+                        std::array<iovec, MAX_IOVECS> iov;
+                        size_t count = 0;
+                        size_t skip = connection.write_offset;
+                        for (auto it = connection.write_queue.begin();
+                             it != connection.write_queue.end() && count + 2 <= MAX_IOVECS; ++it)
+                        {
+                            if (skip < it->header_size)
+                            {
+                                iov[count++] = {it->header.data() + skip, it->header_size - skip};
+                                skip = 0;
+                            }
+                            else
+                            {
+                                skip -= it->header_size;
+                            }
+                            if (skip < it->payload.size())
+                            {
+                                iov[count++] = {it->payload.data() + skip, it->payload.size() - skip};
+                            }
+                            skip = 0;
+                        }
+
+                        msghdr message{};
+                        message.msg_iov = iov.data();
+                        message.msg_iovlen = count;
+                        const ssize_t written = ::sendmsg(connection.fd, &message, SEND_FLAGS);
+                        owner_.write_syscalls_.fetch_add(1, std::memory_order_relaxed);
+                        if (written < 0)
+                        {
+                            if (errno == EINTR)
+                            {
+                                continue;
+                            }
+                            if (errno == EAGAIN || errno == EWOULDBLOCK)
+                            {
+                                break;
+                            }
+                            return false;
+                        }
+                        owner_.bytes_sent_.fetch_add(static_cast<uint64_t>(written), std::memory_order_relaxed);
+
+                        size_t remaining = static_cast<size_t>(written);
+                        while (remaining > 0 && !connection.write_queue.empty())
+                        {
+                            Frame &front = connection.write_queue.front();
+                            const size_t left = front.wire_size() - connection.write_offset;
+                            if (remaining < left)
+                            {
+                                connection.write_offset += remaining;
+                                break;
+                            }
+                            remaining -= left;
+                            connection.shared->pending_bytes.fetch_sub(front.payload.size(), std::memory_order_relaxed);
+                            owner_.frames_sent_.fetch_add(1, std::memory_order_relaxed);
+                            if (owner_.recycler_)
+                            {
+                                owner_.recycler_(std::move(front.payload));
+                            }
+                            connection.write_queue.pop_front();
+                            connection.write_offset = 0;
+                        }
+                    }
+
+                    const bool want_write = !connection.write_queue.empty();
+                    if (want_write != connection.want_write)
+                    {
+                        connection.want_write = want_write;
+                        poller_.modify(connection.fd, connection.id, want_write);
+                    }
+                    return true;
+                }
+
+                void close_connection(ConnectionId id)
+                {
+                    auto it = connections_.find(id);
+                    if (it == connections_.end())
+                    {
+                        return;
+                    }
+                    poller_.remove(it->second.fd);
+                    ::close(it->second.fd);
+                    connections_.erase(it);
+                    touched_.erase(id);
+                    owner_.unregister_connection(id);
+                    owner_.connections_closed_.fetch_add(1, std::memory_order_relaxed);
+                    if (owner_.on_close_)
+                    {
+                        owner_.on_close_(id);
+                    }
+                }
+
+                void close_listener()
+                {
+                    if (listen_fd_ >= 0)
+                    {
+                        poller_.remove(listen_fd_);
+                        ::close(listen_fd_);
+                        listen_fd_ = -1;
+                    }
+                }
+
+                Impl &owner_;
+                const size_t index_;
+                Poller poller_;
+                std::thread thread_;
+                std::mutex mutex_;
+                std::vector<Command> commands_;
+
+                // Owned by the loop thread
+                std::unordered_map<ConnectionId, Connection> connections_;
+                std::unordered_set<ConnectionId> touched_;
+                std::vector<uint8_t> scratch_;
+                int listen_fd_ = -1;
+            };
+
+            explicit Impl(const Options &options) : options_(options)
+            {
+                options_.io_threads = std::max<size_t>(1, options_.io_threads);
+            }
+
+            Loop &loop_for(ConnectionId id) { return *loops_[id % loops_.size()]; }
+
+            ConnectionId register_connection()
+            {
+                const ConnectionId id = next_id_.fetch_add(1, std::memory_order_relaxed);
+                std::lock_guard<std::mutex> lock(registry_mutex_);
+                registry_.emplace(id, std::make_shared<ConnectionShared>());
+                return id;
+            }
+
+            void unregister_connection(ConnectionId id)
+            {
+                std::lock_guard<std::mutex> lock(registry_mutex_);
+                registry_.erase(id);
+            }
+
+            std::shared_ptr<ConnectionShared> lookup(ConnectionId id) const
+            {
+                std::lock_guard<std::mutex> lock(registry_mutex_);
+                auto it = registry_.find(id);
+                return it != registry_.end() ? it->second : nullptr;
+            }
+
+            size_t connection_count() const
+            {
+                std::lock_guard<std::mutex> lock(registry_mutex_);
+                return registry_.size();
+            }
+
+            Options options_;
+            ConnectHandler on_connect_;
+            FrameHandler on_frame_;
+            CloseHandler on_close_;
+            BufferRecycler recycler_;
+
+            std::mutex lifecycle_mutex_;
+            std::vector<std::unique_ptr<Loop>> loops_;
+            std::atomic<bool> running_{false};
+            std::atomic<bool> stopping_{false};
+            std::atomic<uint16_t> listening_port_{0};
+
+            mutable std::mutex registry_mutex_;
+            std::unordered_map<ConnectionId, std::shared_ptr<ConnectionShared>> registry_;
+            std::atomic<ConnectionId> next_id_{1};
+
+            std::atomic<uint64_t> connections_accepted_{0};
+            std::atomic<uint64_t> connections_opened_{0};
+            std::atomic<uint64_t> connections_closed_{0};
+            std::atomic<uint64_t> frames_sent_{0};
+            std::atomic<uint64_t> frames_received_{0};
+            std::atomic<uint64_t> bytes_sent_{0};
+            std::atomic<uint64_t> bytes_received_{0};
+            std::atomic<uint64_t> frames_rejected_{0};
+            std::atomic<uint64_t> write_syscalls_{0};
+        };
+
+        SocketTransport::SocketTransport() : SocketTransport(Options{}) {}
+
+        SocketTransport::SocketTransport(const Options &options) : pimpl_(std::make_unique<Impl>(options)) {}
+
+        SocketTransport::~SocketTransport()
+        {
+            stop();
+        }
+
+        void SocketTransport::set_handlers(ConnectHandler on_connect, FrameHandler on_frame, CloseHandler on_close)
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->lifecycle_mutex_);
+            if (pimpl_->running_)
+            {
+                utils::Logger::instance().log(utils::LogLevel::WARNING, "SocketTransport",
+                                              "Handlers cannot change while running");
+                return;
+            }
+            pimpl_->on_connect_ = std::move(on_connect);
+            pimpl_->on_frame_ = std::move(on_frame);
+            pimpl_->on_close_ = std::move(on_close);
+        }
+
+        void SocketTransport::set_buffer_recycler(BufferRecycler recycler)
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->lifecycle_mutex_);
+            if (pimpl_->running_)
+            {
+                utils::Logger::instance().log(utils::LogLevel::WARNING, "SocketTransport",
+                                              "Buffer recycler cannot change while running");
+                return;
+            }
+            pimpl_->recycler_ = std::move(recycler);
+        }
+
+        bool SocketTransport::start()
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->lifecycle_mutex_);
+            if (pimpl_->running_)
+            {
+                return true;
+            }
+
+            pimpl_->stopping_ = false;
+            // Loops are created once and live as long as the transport, so senders racing a
+            // stop() never touch a destroyed loop
+            for (size_t i = pimpl_->loops_.size(); i < pimpl_->options_.io_threads; ++i)
+            {
+                auto loop = std::make_unique<Impl::Loop>(*pimpl_, i);
+                if (!loop->valid())
+                {
+                    utils::Logger::instance().log(utils::LogLevel::ERROR, "SocketTransport",
+                                                  "Failed to create event loop");
+                    return false;
+                }
+                pimpl_->loops_.push_back(std::move(loop));
+            }
+            for (auto &loop : pimpl_->loops_)
+            {
+                Impl::Loop *raw = loop.get();
+                raw->thread_ = std::thread([raw]()
+                                           { raw->run(); });
+            }
+            pimpl_->running_ = true;
+
+            utils::Logger::instance().log(utils::LogLevel::INFO, "SocketTransport",
+                                          "Started " + std::to_string(pimpl_->loops_.size()) + " event loops");
+            return true;
+        }
+
+        void SocketTransport::stop()
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->lifecycle_mutex_);
+            if (!pimpl_->running_)
+            {
+                return;
+            }
+
+            pimpl_->stopping_.store(true, std::memory_order_release);
+            for (auto &loop : pimpl_->loops_)
+            {
+                loop->wake();
+            }
+            for (auto &loop : pimpl_->loops_)
+            {
+                if (loop->thread_.joinable())
+                {
+                    loop->thread_.join();
+                }
+            }
+
+            // Anything registered after a loop exited (e.g. a racing accept) never got adopted
+            for (auto &loop : pimpl_->loops_)
+            {
+                std::lock_guard<std::mutex> commands_lock(loop->mutex_);
+                for (auto &command : loop->commands_)
+                {
+                    if (command.fd >= 0)
+                    {
+                        ::close(command.fd);
+                    }
+                }
+                loop->commands_.clear();
+            }
+            {
+                std::lock_guard<std::mutex> registry_lock(pimpl_->registry_mutex_);
+                pimpl_->registry_.clear();
+            }
+            pimpl_->listening_port_ = 0;
+            pimpl_->running_ = false;
+        }
+
+        bool SocketTransport::is_running() const
+        {
+            return pimpl_->running_.load();
+        }
+
+        uint16_t SocketTransport::listen(const std::string &address, uint16_t port)
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->lifecycle_mutex_);
+            if (!pimpl_->running_)
+            {
+                return 0;
+            }
+            if (pimpl_->listening_port_ != 0)
+            {
+                return pimpl_->listening_port_;
+            }
+
+            addrinfo hints{};
+            hints.ai_family = AF_UNSPEC;
+            hints.ai_socktype = SOCK_STREAM;
+            hints.ai_flags = AI_PASSIVE | AI_NUMERICSERV;
+            addrinfo *results = nullptr;
+            const std::string service = std::to_string(port);
+            if (getaddrinfo(address.empty() ? nullptr : address.c_str(), service.c_str(), &hints, &results) != 0)
+            {
+                utils::Logger::instance().log(utils::LogLevel::ERROR, "SocketTransport",
+                                              "Cannot resolve listen address " + address);
+                return 0;
+            }
+
+            int fd = -1;
+            for (addrinfo *candidate = results; candidate != nullptr && fd < 0; candidate = candidate->ai_next)
+            {
+                fd = ::socket(candidate->ai_family, candidate->ai_socktype, candidate->ai_protocol);
+                if (fd < 0)
+                {
+                    continue;
+                }
+                int one = 1;
+                setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+                fcntl(fd, F_SETFD, FD_CLOEXEC);
+                if (::bind(fd, candidate->ai_addr, candidate->ai_addrlen) != 0 ||
+                    ::listen(fd, pimpl_->options_.listen_backlog) != 0 || !set_non_blocking(fd))
+                {
+                    ::close(fd);
+                    fd = -1;
+                }
+            }
+            freeaddrinfo(results);
+            if (fd < 0)
+            {
+                utils::Logger::instance().log(utils::LogLevel::ERROR, "SocketTransport",
+                                              "Cannot listen on " + address + ":" + service + ": " + std::strerror(errno));
+                return 0;
+            }
+
+            sockaddr_storage bound{};
+            socklen_t length = sizeof(bound);
+            getsockname(fd, reinterpret_cast<sockaddr *>(&bound), &length);
+            const uint16_t bound_port = ntohs(bound.ss_family == AF_INET6
+                                                  ? reinterpret_cast<const sockaddr_in6 &>(bound).sin6_port
+                                                  : reinterpret_cast<const sockaddr_in &>(bound).sin_port);
+
+            Impl::Command command;
+            command.kind = Impl::Command::Kind::LISTEN;
+            command.fd = fd;
+            pimpl_->loops_.front()->post(std::move(command));
+            pimpl_->listening_port_ = bound_port;
+            return bound_port;
+        }
+
+        void SocketTransport::stop_listening()
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->lifecycle_mutex_);
+            if (!pimpl_->running_ || pimpl_->listening_port_ == 0)
+            {
+                return;
+            }
+            Impl::Command command;
+            command.kind = Impl::Command::Kind::UNLISTEN;
+            pimpl_->loops_.front()->post(std::move(command));
+            pimpl_->listening_port_ = 0;
+        }
+
+        uint16_t SocketTransport::listening_port() const
+        {
+            return pimpl_->listening_port_.load();
+        }
+
+        SocketTransport::ConnectionId SocketTransport::connect(const std::string &host, uint16_t port)
+        {
+            if (!pimpl_->running_ || pimpl_->connection_count() >= pimpl_->options_.max_connections)
+            {
+                return 0;
+            }
+
+            addrinfo hints{};
+            hints.ai_family = AF_UNSPEC;
+            hints.ai_socktype = SOCK_STREAM;
+            hints.ai_flags = AI_NUMERICSERV;
+            addrinfo *results = nullptr;
+            const std::string service = std::to_string(port);
+            if (getaddrinfo(host.c_str(), service.c_str(), &hints, &results) != 0)
+            {
+                utils::Logger::instance().log(utils::LogLevel::ERROR, "SocketTransport", "Cannot resolve " + host);
+                return 0;
+            }
+
+            int fd = -1;
+            for (addrinfo *candidate = results; candidate != nullptr && fd < 0; candidate = candidate->ai_next)
+            {
+                fd = ::socket(candidate->ai_family, candidate->ai_socktype, candidate->ai_protocol);
+                if (fd < 0)
+                {
+                    continue;
+                }
+                configure_stream_socket(fd);
+                if (!set_non_blocking(fd) ||
+                    (::connect(fd, candidate->ai_addr, candidate->ai_addrlen) != 0 && errno != EINPROGRESS))
+                {
+                    ::close(fd);
+                    fd = -1;
+                }
+            }
+            freeaddrinfo(results);
+            if (fd < 0)
+            {
+                return 0;
+            }
+
+            const ConnectionId id = pimpl_->register_connection();
+            Impl::Command command;
+            command.kind = Impl::Command::Kind::ADOPT;
+            command.id = id;
+            command.fd = fd;
+            command.endpoint = host + ":" + service;
+            command.inbound = false;
+            pimpl_->loop_for(id).post(std::move(command));
+            return id;
+        }
+
+        bool SocketTransport::send(ConnectionId id, std::vector<uint8_t> frame)
+        {
+            if (!pimpl_->running_ || frame.size() > pimpl_->options_.max_frame_bytes)
+            {
+                pimpl_->frames_rejected_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            auto shared = pimpl_->lookup(id);
+            if (!shared)
+            {
+                return false;
+            }
+            const size_t size = frame.size();
+            if (shared->pending_bytes.fetch_add(size, std::memory_order_relaxed) + size >
+                pimpl_->options_.max_pending_write_bytes)
+            {
+                shared->pending_bytes.fetch_sub(size, std::memory_order_relaxed);
+                pimpl_->frames_rejected_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            Impl::Command command;
+            command.kind = Impl::Command::Kind::SEND;
+            command.id = id;
+            command.frame.header_size = static_cast<uint8_t>(wire::put_varint(size, command.frame.header.data()));
+            command.frame.payload = std::move(frame);
+            pimpl_->loop_for(id).post(std::move(command));
+            return true;
+        }
+
+        bool SocketTransport::close(ConnectionId id)
+        {
+            if (!pimpl_->running_ || !pimpl_->lookup(id))
+            {
+                return false;
+            }
+            Impl::Command command;
+            command.kind = Impl::Command::Kind::CLOSE;
+            command.id = id;
+            pimpl_->loop_for(id).post(std::move(command));
+            return true;
+        }
+
+        size_t SocketTransport::pending_bytes(ConnectionId id) const
+        {
+            auto shared = pimpl_->lookup(id);
+            return shared ? shared->pending_bytes.load(std::memory_order_relaxed) : 0;
+        }
+
+        size_t SocketTransport::connection_count() const
+        {
+            return pimpl_->connection_count();
+        }
+
+        SocketTransport::TransportStats SocketTransport::get_statistics() const
+        {
+            TransportStats stats{};
+            stats.connections_accepted = pimpl_->connections_accepted_.load(std::memory_order_relaxed);
+            stats.connections_opened = pimpl_->connections_opened_.load(std::memory_order_relaxed);
+            stats.connections_closed = pimpl_->connections_closed_.load(std::memory_order_relaxed);
+            stats.frames_sent = pimpl_->frames_sent_.load(std::memory_order_relaxed);
+            stats.frames_received = pimpl_->frames_received_.load(std::memory_order_relaxed);
+            stats.bytes_sent = pimpl_->bytes_sent_.load(std::memory_order_relaxed);
+            stats.bytes_received = pimpl_->bytes_received_.load(std::memory_order_relaxed);
+            stats.frames_rejected = pimpl_->frames_rejected_.load(std::memory_order_relaxed);
+            stats.write_syscalls = pimpl_->write_syscalls_.load(std::memory_order_relaxed);
+            return stats;
+        }
+
+    } // namespace network
+} // namespace cardano_iot
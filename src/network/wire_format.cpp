@@ -0,0 +1,202 @@
+#include "cardano_iot/network/wire_format.h"
+
+#include <algorithm>
+
+namespace cardano_iot
+{
+    namespace network
+    {
+        namespace wire
+        {
+            namespace
+            {
+                uint8_t flags_of(const NetworkMessage &message)
+                {
+                    uint8_t flags = 0;
+                    flags |= message.encrypted ? FLAG_ENCRYPTED : 0;
+                    flags |= message.compressed ? FLAG_COMPRESSED : 0;
+                    flags |= message.recipient_id.empty() ? 0 : FLAG_RECIPIENT;
+                    flags |= message.signature.empty() ? 0 : FLAG_SIGNATURE;
+                    return flags;
+                }
+
+                size_t field_size(const std::string &field)
+                {
+                    return varint_size(field.size()) + field.size();
+                }
+
+                uint8_t *put_field(uint8_t *out, const std::string &field)
+                {
+                    out += put_varint(field.size(), out);
+                    return std::copy(field.begin(), field.end(), out);
+                }
+
+                bool get_field(const uint8_t *data, size_t size, size_t &offset, std::string_view &field)
+                {
+                    uint64_t length = 0;
+                    const size_t consumed = get_varint(data + offset, size - offset, length);
+                    if (consumed == 0 || length > size - offset - consumed)
+                    {
+                        return false;
+                    }
+                    offset += consumed;
+                    field = std::string_view(reinterpret_cast<const char *>(data + offset), static_cast<size_t>(length));
+                    offset += static_cast<size_t>(length);
+                    return true;
+                }
+            } // namespace
+
+            NetworkMessage MessageView::to_message() const
+            {
+                NetworkMessage message;
+                message.message_id.assign(message_id.data(), message_id.size());
+                message.type = type;
+                message.sender_id.assign(sender_id.data(), sender_id.size());
+                message.recipient_id.assign(recipient_id.data(), recipient_id.size());
+                message.payload.assign(payload, payload + payload_size);
+                message.timestamp = timestamp;
+                message.encrypted = encrypted();
+                message.compressed = compressed();
+                message.signature.assign(signature.data(), signature.size());
+                return message;
+            }
+
+            size_t encoded_size(const NetworkMessage &message)
+            {
+                size_t size = 2 + varint_size(message.timestamp) + field_size(message.message_id) +
+                              field_size(message.sender_id) + message.payload.size();
+                if (!message.recipient_id.empty())
+                {
+                    size += field_size(message.recipient_id);
+                }
+                if (!message.signature.empty())
+                {
+                    size += field_size(message.signature);
+                }
+                return size;
+            }
+
+            void encode(const NetworkMessage &message, std::vector<uint8_t> &out)
+            {
+                const size_t start = out.size();
+                out.resize(start + encoded_size(message));
+
+                const uint8_t flags = flags_of(message);
+                uint8_t *cursor = out.data() + start;
+                *cursor++ = static_cast<uint8_t>((VERSION << 4) | flags);
+                *cursor++ = static_cast<uint8_t>(message.type);
+                cursor += put_varint(message.timestamp, cursor);
+                cursor = put_field(cursor, message.message_id);
+                cursor = put_field(cursor, message.sender_id);
+                if (flags & FLAG_RECIPIENT)
+                {
+                    cursor = put_field(cursor, message.recipient_id);
+                }
+                if (flags & FLAG_SIGNATURE)
+                {
+                    cursor = put_field(cursor, message.signature);
+                }
+                std::copy(message.payload.begin(), message.payload.end(), cursor);
+            }
+
+            std::vector<uint8_t> encode(const NetworkMessage &message)
+            {
+                std::vector<uint8_t> out;
+                encode(message, out);
+                return out;
+            }
+
+            bool decode(const uint8_t *data, size_t size, MessageView &view)
+            {
+                if (size < 3 || (data[0] >> 4) != VERSION || data[1] > static_cast<uint8_t>(MessageType::SIGNING_RESPONSE))
+                {
+                    return false;
+                }
+                view.version = data[0] >> 4;
+                view.flags = data[0] & 0x0f;
+                view.type = static_cast<MessageType>(data[1]);
+
+                size_t offset = 2;
+                const size_t consumed = get_varint(data + offset, size - offset, view.timestamp);
+                if (consumed == 0)
+                {
+                    return false;
+                }
+                offset += consumed;
+                if (!get_field(data, size, offset, view.message_id) || !get_field(data, size, offset, view.sender_id))
+                {
+                    return false;
+                }
+                view.recipient_id = {};
+                view.signature = {};
+                if ((view.flags & FLAG_RECIPIENT) && !get_field(data, size, offset, view.recipient_id))
+                {
+                    return false;
+                }
+                if ((view.flags & FLAG_SIGNATURE) && !get_field(data, size, offset, view.signature))
+                {
+                    return false;
+                }
+                view.payload = data + offset;
+                view.payload_size = size - offset;
+                return true;
+            }
+
+            bool decode(const uint8_t *data, size_t size, NetworkMessage &message)
+            {
+                MessageView view;
+                if (!decode(data, size, view))
+                {
+                    return false;
+                }
+                message = view.to_message();
+                return true;
+            }
+
+            BufferPool::BufferPool(size_t max_buffers, size_t max_buffer_capacity)
+                : max_buffers_(max_buffers), max_buffer_capacity_(max_buffer_capacity)
+            {
+            }
+
+            std::vector<uint8_t> BufferPool::acquire()
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                ++stats_.acquired;
+                if (free_.empty())
+                {
+                    return {};
+                }
+                ++stats_.reused;
+                std::vector<uint8_t> buffer = std::move(free_.back());
+                free_.pop_back();
+                return buffer;
+            }
+
+            void BufferPool::release(std::vector<uint8_t> &&buffer)
+            {
+                buffer.clear();
+                std::lock_guard<std::mutex> lock(mutex_);
+                ++stats_.released;
+                if (free_.size() >= max_buffers_ || buffer.capacity() > max_buffer_capacity_ || buffer.capacity() == 0)
+                {
+                    ++stats_.dropped;
+                    return;
+                }
+                free_.push_back(std::move(buffer));
+            }
+
+            size_t BufferPool::idle_count() const
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                return free_.size();
+            }
+
+            BufferPool::PoolStats BufferPool::get_statistics() const
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                return stats_;
+            }
+
+        } // namespace wire
+    } // namespace network
+} // namespace cardano_iot
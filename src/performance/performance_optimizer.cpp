@@ -0,0 +1,1594 @@
+/**
+ * @file performance_optimizer.cpp
+ * @brief Feedback controller behind PerformanceOptimizer
+ *
+ * @author Cardano IoT SDK Team
+ * @version 1.0.0
+ */
+
+#include "cardano_iot/performance/performance_optimizer.h"
+#include "cardano_iot/utils/hash.h"
+#include "cardano_iot/utils/logger.h"
+#include "cardano_iot/utils/metrics.h"
+
+#include <nlohmann/json.hpp>
+
+#include <sys/resource.h>
+#include <unistd.h>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <mutex>
+#include <set>
+#include <sstream>
+
+using json = nlohmann::json;
+
+namespace cardano_iot::performance
+{
+
+    namespace
+    {
+        constexpr size_t MAX_HISTORY = 3600;        // Monitoring samples kept
+        constexpr size_t MAX_TUNING_HISTORY = 256;  // Knob changes kept
+        constexpr double LATENCY_EWMA_ALPHA = 0.2;  // Endpoint response time smoothing
+
+        // Metric names read from the registry
+        const char *const TX_SUBMITTED = "cardano_iot_tx_submitted_total";
+        const char *const TX_FAILED = "cardano_iot_tx_failed_total";
+        const char *const TX_CONFIRMED = "cardano_iot_tx_confirmed_total";
+        const char *const TX_PENDING = "cardano_iot_tx_pending";
+        const char *const CLIENT_QUERIES = "cardano_iot_client_queries_total";
+        const char *const P2P_SENT_BYTES = "cardano_iot_p2p_sent_bytes_total";
+        const char *const P2P_RECEIVED_BYTES = "cardano_iot_p2p_received_bytes_total";
+        const char *const P2P_CONNECTION_EVENTS = "cardano_iot_p2p_connection_events_total";
+
+        enum class Goal
+        {
+            HOLD,
+            TIGHTEN, // Towards lower latency
+            RELAX    // Towards lower energy use
+        };
+
+        uint64_t now_seconds()
+        {
+            return std::chrono::duration_cast<std::chrono::seconds>(
+                       std::chrono::system_clock::now().time_since_epoch())
+                .count();
+        }
+
+        bool parse_double(const std::string &text, double &value)
+        {
+            char *end = nullptr;
+            value = std::strtod(text.c_str(), &end);
+            return !text.empty() && end == text.c_str() + text.size() && std::isfinite(value);
+        }
+
+        std::string format_number(double value)
+        {
+            std::ostringstream out;
+            out << std::setprecision(6) << value;
+            return out.str();
+        }
+
+        double process_cpu_seconds()
+        {
+            rusage usage{};
+            getrusage(RUSAGE_SELF, &usage);
+            return static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+                   static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+        }
+
+        double resident_mb()
+        {
+            std::ifstream statm("/proc/self/statm");
+            uint64_t size_pages = 0, resident_pages = 0;
+            if (statm >> size_pages >> resident_pages)
+            {
+                return static_cast<double>(resident_pages) * static_cast<double>(sysconf(_SC_PAGESIZE)) / (1024.0 * 1024.0);
+            }
+            rusage usage{};
+            getrusage(RUSAGE_SELF, &usage);
+            return static_cast<double>(usage.ru_maxrss) / 1024.0; // Peak, where statm is unavailable
+        }
+
+        double physical_memory_mb()
+        {
+            const long pages = sysconf(_SC_PHYS_PAGES);
+            const long page_size = sysconf(_SC_PAGESIZE);
+            return pages > 0 && page_size > 0 ? static_cast<double>(pages) * static_cast<double>(page_size) / (1024.0 * 1024.0) : 0.0;
+        }
+
+        uint32_t hardware_threads()
+        {
+            return std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        // Upper edge of the highest non-empty bucket
+        double histogram_max(const utils::metrics::Histogram::Snapshot &snapshot)
+        {
+            for (size_t i = snapshot.counts.size(); i-- > 0;)
+            {
+                if (snapshot.counts[i] > 0)
+                {
+                    return i < snapshot.bounds.size() ? snapshot.bounds[i] : (snapshot.bounds.empty() ? snapshot.mean() : snapshot.bounds.back());
+                }
+            }
+            return 0.0;
+        }
+
+        double step_value(const TuningKnob &knob, double value, int direction)
+        {
+            const double factor = knob.step_factor > 1.0 ? knob.step_factor : 1.5;
+            double next;
+            if (value <= 0.0 && direction > 0)
+            {
+                next = std::max(knob.min_value, 1.0);
+            }
+            else
+            {
+                next = direction > 0 ? value * factor : value / factor;
+            }
+            if (knob.integral)
+            {
+                next = direction > 0 ? std::ceil(next) : std::floor(next);
+                if (next == value)
+                {
+                    next += direction;
+                }
+            }
+            return std::clamp(next, knob.min_value, knob.max_value);
+        }
+
+        json metrics_to_json(const PerformanceMetrics &m)
+        {
+            return {{"measurement_time", m.measurement_time},
+                    {"transactions_per_second", m.transactions_per_second},
+                    {"data_points_per_second", m.data_points_per_second},
+                    {"blockchain_ops_per_second", m.blockchain_ops_per_second},
+                    {"avg_response_time_ms", m.avg_response_time_ms},
+                    {"p95_response_time_ms", m.p95_response_time_ms},
+                    {"p99_response_time_ms", m.p99_response_time_ms},
+                    {"max_response_time_ms", m.max_response_time_ms},
+                    {"cpu_usage_percent", m.cpu_usage_percent},
+                    {"memory_usage_mb", m.memory_usage_mb},
+                    {"memory_usage_percent", m.memory_usage_percent},
+                    {"network_bandwidth_mbps", m.network_bandwidth_mbps},
+                    {"power_consumption_mw", m.power_consumption_mw},
+                    {"energy_efficiency_score", m.energy_efficiency_score},
+                    {"error_rate_percent", m.error_rate_percent},
+                    {"active_connections", m.active_connections},
+                    {"pending_transactions", m.pending_transactions},
+                    {"transaction_success_rate", m.transaction_success_rate}};
+        }
+
+        struct WorkloadResult
+        {
+            uint64_t operations = 0;
+            double seconds = 0.0;
+            double cpu_percent = 0.0;
+            utils::metrics::Histogram::Snapshot latency;
+        };
+
+        // Hash payload-sized buffers on the given number of threads for the given time
+        WorkloadResult run_hash_workload(uint32_t threads, size_t payload_bytes, double seconds)
+        {
+            utils::metrics::Histogram latency("cardano_iot_benchmark_op_duration_ms", "Benchmark operation time in milliseconds",
+                                              utils::metrics::Histogram::latency_ms_bounds());
+            std::atomic<uint64_t> operations{0};
+            const auto start = std::chrono::steady_clock::now();
+            const auto deadline = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                              std::chrono::duration<double>(std::max(seconds, 0.05)));
+            const double cpu_start = process_cpu_seconds();
+
+            std::vector<std::thread> workers;
+            for (uint32_t t = 0; t < std::max(threads, 1u); ++t)
+            {
+                workers.emplace_back([&, t]
+                                     {
+                                         std::vector<uint8_t> payload(payload_bytes, static_cast<uint8_t>(t));
+                                         uint64_t local = 0;
+                                         while (std::chrono::steady_clock::now() < deadline)
+                                         {
+                                             const auto op_start = std::chrono::steady_clock::now();
+                                             const auto digest = utils::Hasher::digest(utils::HashAlgorithm::SHA256, payload.data(), payload.size());
+                                             payload[0] ^= digest[0];
+                                             latency.observe(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - op_start).count());
+                                             ++local;
+                                         }
+                                         operations.fetch_add(local, std::memory_order_relaxed); });
+            }
+            for (auto &worker : workers)
+            {
+                worker.join();
+            }
+
+            WorkloadResult result;
+            result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            result.operations = operations.load();
+            result.cpu_percent = (process_cpu_seconds() - cpu_start) / std::max(result.seconds, 1e-9) / hardware_threads() * 100.0;
+            result.latency = latency.snapshot();
+            return result;
+        }
+    } // namespace
+
+    class PerformanceOptimizer::Impl
+    {
+    public:
+        struct Endpoint
+        {
+            double weight = 1.0;
+            bool healthy = true;
+            uint32_t failures = 0;  // Consecutive
+            uint32_t successes = 0; // Consecutive
+            double response_ms = 0.0;
+            double current_weight = 0.0; // Smooth weighted round robin state
+        };
+
+        // Registry totals at the previous monitoring sample, for rates
+        struct Sample
+        {
+            bool valid = false;
+            std::chrono::steady_clock::time_point time;
+            double cpu_seconds = 0.0;
+            double tx_submitted = 0.0;
+            double tx_failed = 0.0;
+            double queries = 0.0;
+            double query_failures = 0.0;
+            double p2p_bytes = 0.0;
+            utils::metrics::Histogram::Snapshot latency;
+        };
+
+        mutable std::mutex mutex_; // Everything below except the monitor and counters
+        bool initialized_ = false;
+        std::map<std::string, std::string> config_;
+        OptimizationStrategy strategy_ = OptimizationStrategy::BALANCED;
+
+        // Controller settings
+        std::string latency_metric_ = "cardano_iot_client_query_duration_ms";
+        double target_latency_ms_ = 100.0;
+        double latency_quantile_ = 0.95;
+        double hysteresis_ = 0.1;
+        uint64_t min_samples_ = 20;
+        double power_budget_mw_ = 0.0;
+        bool dynamic_power_ = false;
+        std::function<double()> power_source_;
+
+        std::map<std::string, TuningKnob> knobs_;
+        std::string last_moved_; // Round robin cursor
+        std::deque<TuningChange> changes_;
+        utils::metrics::Histogram::Snapshot window_start_; // Latency histogram at the last analysis
+
+        PerformanceMetrics current_{};
+        std::deque<PerformanceMetrics> history_;
+        Sample last_sample_;
+        ResourceAllocation allocation_{};
+
+        LoadBalancingConfig load_balancing_{};
+        std::map<std::string, Endpoint> endpoints_;
+        size_t round_robin_ = 0;
+
+        MetricsCallback metrics_callback_;
+        RecommendationCallback recommendation_callback_;
+
+        // Background sampling and optimization
+        std::mutex monitor_mutex_;
+        std::condition_variable monitor_cv_;
+        std::thread monitor_;
+        bool monitoring_ = false;
+        std::atomic<uint32_t> monitoring_interval_ms_{1000};
+        std::atomic<bool> auto_optimize_{false};
+        std::atomic<uint32_t> optimization_interval_ms_{60000};
+
+        utils::metrics::Counter samples_{"cardano_iot_optimizer_samples_total", "Monitoring samples taken"};
+        utils::metrics::Counter analyses_{"cardano_iot_optimizer_analyses_total", "Optimization analyses run"};
+        utils::metrics::Counter recommendations_{"cardano_iot_optimizer_recommendations_total", "Recommendations produced"};
+        utils::metrics::Counter applied_{"cardano_iot_optimizer_applied_total", "Recommendations applied"};
+
+        std::mutex latency_mutex_;
+        std::map<std::string, std::unique_ptr<utils::metrics::Histogram>> operation_latency_;
+
+        void init_allocation()
+        {
+            allocation_.worker_threads = estimate_optimal_thread_count("mixed");
+            allocation_.io_threads = 2;
+            allocation_.network_threads = 2;
+            allocation_.buffer_size_mb = 4;
+            allocation_.cache_size_mb = 16;
+            allocation_.max_memory_mb = static_cast<uint64_t>(physical_memory_mb() / 4.0);
+            allocation_.max_connections = 50;
+            allocation_.connection_timeout_ms = 30000;
+            allocation_.read_timeout_ms = 10000;
+            allocation_.write_timeout_ms = 10000;
+            allocation_.max_queue_size = 65536;
+            allocation_.batch_size = 512;
+            allocation_.flush_interval_ms = 20;
+            allocation_.max_retries = 3;
+            allocation_.retry_delay_ms = 1000;
+            allocation_.backoff_multiplier = 2.0;
+        }
+
+        // Caller holds mutex_. Known keys are validated; all keys are kept.
+        bool apply_config(const std::map<std::string, std::string> &config)
+        {
+            bool ok = true;
+            for (const auto &[key, value] : config)
+            {
+                double number = 0.0;
+                const bool numeric = parse_double(value, number);
+                if (key == "latency_metric")
+                {
+                    latency_metric_ = value;
+                }
+                else if (key == "target_latency_ms" || key == "latency_quantile" || key == "hysteresis" ||
+                         key == "min_samples" || key == "power_budget_mw")
+                {
+                    if (!numeric || number < 0.0)
+                    {
+                        ok = false;
+                        continue;
+                    }
+                    if (key == "target_latency_ms" && number > 0.0)
+                    {
+                        target_latency_ms_ = number;
+                    }
+                    else if (key == "latency_quantile" && number > 0.0 && number <= 1.0)
+                    {
+                        latency_quantile_ = number;
+                    }
+                    else if (key == "hysteresis" && number < 1.0)
+                    {
+                        hysteresis_ = number;
+                    }
+                    else if (key == "min_samples")
+                    {
+                        min_samples_ = static_cast<uint64_t>(number);
+                    }
+                    else if (key == "power_budget_mw")
+                    {
+                        power_budget_mw_ = number;
+                    }
+                    else
+                    {
+                        ok = false;
+                        continue;
+                    }
+                }
+                config_[key] = value;
+            }
+            return ok;
+        }
+
+        PerformanceMetrics sample()
+        {
+            auto &registry = utils::metrics::Registry::instance();
+            Sample now;
+            now.valid = true;
+            now.time = std::chrono::steady_clock::now();
+            now.cpu_seconds = process_cpu_seconds();
+            now.tx_submitted = registry.total(TX_SUBMITTED);
+            now.tx_failed = registry.total(TX_FAILED);
+            now.queries = registry.total(CLIENT_QUERIES);
+            now.query_failures = registry.value(CLIENT_QUERIES, {{"result", "failure"}});
+            now.p2p_bytes = registry.total(P2P_SENT_BYTES) + registry.total(P2P_RECEIVED_BYTES);
+
+            std::function<double()> power_source;
+            std::string latency_metric;
+            double budget;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                power_source = power_source_;
+                latency_metric = latency_metric_;
+                budget = power_budget_mw_;
+            }
+            now.latency = registry.histogram(latency_metric);
+
+            PerformanceMetrics metrics{};
+            metrics.measurement_time = now_seconds();
+            Sample previous;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                previous = last_sample_;
+                last_sample_ = now;
+            }
+            if (previous.valid)
+            {
+                const double seconds = std::max(std::chrono::duration<double>(now.time - previous.time).count(), 1e-3);
+                const double submitted = std::max(now.tx_submitted - previous.tx_submitted, 0.0);
+                const double failed = std::max(now.tx_failed - previous.tx_failed, 0.0);
+                const double queries = std::max(now.queries - previous.queries, 0.0);
+                const double query_failures = std::max(now.query_failures - previous.query_failures, 0.0);
+                metrics.transactions_per_second = submitted / seconds;
+                metrics.blockchain_ops_per_second = (submitted + queries) / seconds;
+                metrics.cpu_usage_percent = (now.cpu_seconds - previous.cpu_seconds) / seconds / hardware_threads() * 100.0;
+                metrics.network_bandwidth_mbps = std::max(now.p2p_bytes - previous.p2p_bytes, 0.0) * 8.0 / 1e6 / seconds;
+                const double attempts = submitted + failed + queries;
+                metrics.error_rate_percent = attempts > 0.0 ? (failed + query_failures) / attempts * 100.0 : 0.0;
+
+                const auto window = now.latency.since(previous.latency);
+                metrics.avg_response_time_ms = window.mean();
+                metrics.p95_response_time_ms = window.quantile(0.95);
+                metrics.p99_response_time_ms = window.quantile(0.99);
+                metrics.max_response_time_ms = histogram_max(window);
+            }
+
+            metrics.memory_usage_mb = resident_mb();
+            const double physical = physical_memory_mb();
+            metrics.memory_usage_percent = physical > 0.0 ? metrics.memory_usage_mb / physical * 100.0 : 0.0;
+            metrics.power_consumption_mw = power_source ? power_source() : 0.0;
+            metrics.energy_efficiency_score = budget > 0.0 && metrics.power_consumption_mw > budget
+                                                  ? budget / metrics.power_consumption_mw
+                                                  : 1.0;
+            metrics.uptime_percent = 100.0;
+            const double connected = registry.value(P2P_CONNECTION_EVENTS, {{"event", "established"}}) -
+                                     registry.value(P2P_CONNECTION_EVENTS, {{"event", "lost"}});
+            metrics.active_connections = static_cast<uint32_t>(std::max(connected, 0.0));
+            metrics.pending_transactions = static_cast<uint32_t>(std::max(registry.total(TX_PENDING), 0.0));
+            const double confirmed = registry.total(TX_CONFIRMED);
+            const double settled = confirmed + now.tx_failed;
+            metrics.transaction_success_rate = settled > 0.0 ? confirmed / settled : 1.0;
+
+            MetricsCallback callback;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                current_ = metrics;
+                history_.push_back(metrics);
+                if (history_.size() > MAX_HISTORY)
+                {
+                    history_.pop_front();
+                }
+                callback = metrics_callback_;
+            }
+            samples_.inc();
+            if (callback)
+            {
+                callback(metrics);
+            }
+            return metrics;
+        }
+
+        // Caller holds mutex_. Next knob after the cursor that can move in the goal's direction.
+        const TuningKnob *pick_knob(Goal goal, const std::string &category, double &value, double &proposed) const
+        {
+            if (knobs_.empty() || goal == Goal::HOLD)
+            {
+                return nullptr;
+            }
+            auto start = knobs_.upper_bound(last_moved_);
+            auto it = start;
+            for (size_t visited = 0; visited < knobs_.size(); ++visited, ++it)
+            {
+                if (it == knobs_.end())
+                {
+                    it = knobs_.begin();
+                }
+                const TuningKnob &knob = it->second;
+                const int direction = goal == Goal::TIGHTEN ? knob.latency_direction : knob.energy_direction;
+                if (direction == 0 || (!category.empty() && knob.category != category))
+                {
+                    continue;
+                }
+                value = knob.get();
+                proposed = step_value(knob, value, direction);
+                if (proposed != value)
+                {
+                    return &knob;
+                }
+            }
+            return nullptr;
+        }
+
+        OptimizationRecommendation knob_recommendation(const TuningKnob &knob, double value, double proposed,
+                                                       const std::string &reason, double error, double confidence) const
+        {
+            OptimizationRecommendation recommendation;
+            recommendation.category = knob.category;
+            recommendation.description = reason;
+            recommendation.action = "set_knob";
+            recommendation.expected_improvement = std::clamp(std::abs(error) * 0.5, 0.05, 0.5);
+            recommendation.confidence_score = std::clamp(confidence, 0.0, 1.0);
+            recommendation.priority = std::abs(error) > 1.0 ? 8 : 5;
+            recommendation.parameters = {{"knob", knob.name}, {"value", format_number(proposed)}, {"previous", format_number(value)}};
+            recommendation.auto_applicable = true;
+            return recommendation;
+        }
+
+        /**
+         * Caller holds mutex_. Compare the window's latency and the power draw
+         * with their targets and decide which way to move.
+         */
+        Goal decide(double latency, bool latency_known, double power, bool power_known, std::string &reason, double &error) const
+        {
+            const double band = hysteresis_;
+            const bool latency_over = latency_known && latency > target_latency_ms_ * (1.0 + band);
+            const bool latency_under = latency_known && latency < target_latency_ms_ * (1.0 - band);
+            const bool has_budget = power_known && power_budget_mw_ > 0.0;
+            const bool power_over = has_budget && power > power_budget_mw_ * (1.0 + band);
+            const bool power_under = !has_budget || power < power_budget_mw_ * (1.0 - band);
+
+            const std::string latency_text = "p" + format_number(latency_quantile_ * 100.0) + " latency " +
+                                             format_number(latency) + " ms";
+            const std::string power_text = "power " + format_number(power) + " mW";
+
+            auto tighten = [&]
+            {
+                reason = latency_text + " above target " + format_number(target_latency_ms_) + " ms";
+                error = latency / target_latency_ms_ - 1.0;
+                return Goal::TIGHTEN;
+            };
+            auto relax_for_power = [&]
+            {
+                reason = power_text + " above budget " + format_number(power_budget_mw_) + " mW";
+                error = power / power_budget_mw_ - 1.0;
+                return Goal::RELAX;
+            };
+            auto relax_for_headroom = [&]
+            {
+                reason = latency_text + " below target " + format_number(target_latency_ms_) + " ms";
+                error = 1.0 - latency / target_latency_ms_;
+                return Goal::RELAX;
+            };
+
+            if (dynamic_power_ && power_over)
+            {
+                return relax_for_power();
+            }
+            switch (strategy_)
+            {
+            case OptimizationStrategy::LATENCY_FOCUSED:
+                if (latency_over)
+                {
+                    return tighten();
+                }
+                return latency_under ? relax_for_headroom() : Goal::HOLD;
+            case OptimizationStrategy::ENERGY_FOCUSED:
+            case OptimizationStrategy::COST_FOCUSED:
+                if (power_over)
+                {
+                    return relax_for_power();
+                }
+                if (latency_over && power_under)
+                {
+                    return tighten();
+                }
+                return latency_under ? relax_for_headroom() : Goal::HOLD;
+            default:
+                // Balanced family: fix whichever target is missed, hold when both are met
+                if (latency_over && !power_over)
+                {
+                    return tighten();
+                }
+                if (power_over && !latency_over)
+                {
+                    return relax_for_power();
+                }
+                return Goal::HOLD;
+            }
+        }
+
+        bool set_knob(const std::string &name, double requested, const std::string &reason)
+        {
+            TuningKnob knob;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                auto it = knobs_.find(name);
+                if (it == knobs_.end())
+                {
+                    return false;
+                }
+                knob = it->second;
+            }
+            double value = std::clamp(requested, knob.min_value, knob.max_value);
+            if (knob.integral)
+            {
+                value = std::round(value);
+            }
+            const double old_value = knob.get();
+            if (value == old_value || !knob.set(value))
+            {
+                return false;
+            }
+
+            TuningChange change{name, old_value, value, reason, now_seconds()};
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                last_moved_ = name;
+                changes_.push_back(change);
+                if (changes_.size() > MAX_TUNING_HISTORY)
+                {
+                    changes_.pop_front();
+                }
+            }
+            utils::Logger::instance().log(utils::LogLevel::INFO, "PerformanceOptimizer",
+                                          name + ": " + format_number(old_value) + " -> " + format_number(value) +
+                                              " (" + reason + ")");
+            return true;
+        }
+
+        // Move every knob of a category to the same value
+        void set_category(const std::string &category, double value, const std::string &reason)
+        {
+            std::vector<std::string> names;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                for (const auto &[name, knob] : knobs_)
+                {
+                    if (knob.category == category)
+                    {
+                        names.push_back(name);
+                    }
+                }
+            }
+            for (const auto &name : names)
+            {
+                set_knob(name, value, reason);
+            }
+        }
+
+        std::vector<OptimizationRecommendation> category_steps(Goal goal, const std::string &reason,
+                                                               const std::set<std::string> &categories)
+        {
+            std::vector<OptimizationRecommendation> recommendations;
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (const auto &[name, knob] : knobs_)
+            {
+                const int direction = goal == Goal::TIGHTEN ? knob.latency_direction : knob.energy_direction;
+                if (direction == 0 || (!categories.empty() && !categories.count(knob.category)))
+                {
+                    continue;
+                }
+                const double value = knob.get();
+                const double proposed = step_value(knob, value, direction);
+                if (proposed != value)
+                {
+                    recommendations.push_back(knob_recommendation(knob, value, proposed, reason, 0.5, 0.5));
+                }
+            }
+            return recommendations;
+        }
+
+        void monitor_loop()
+        {
+            auto last_optimization = std::chrono::steady_clock::now();
+            std::unique_lock<std::mutex> lock(monitor_mutex_);
+            while (monitoring_)
+            {
+                monitor_cv_.wait_for(lock, std::chrono::milliseconds(monitoring_interval_ms_.load()), [this]
+                                     { return !monitoring_; });
+                if (!monitoring_)
+                {
+                    break;
+                }
+                lock.unlock();
+                sample();
+                const auto now = std::chrono::steady_clock::now();
+                if (auto_optimize_ && now - last_optimization >= std::chrono::milliseconds(optimization_interval_ms_.load()))
+                {
+                    last_optimization = now;
+                    owner_->apply_all_optimizations(true);
+                }
+                lock.lock();
+            }
+        }
+
+        PerformanceOptimizer *owner_ = nullptr;
+    };
+
+    PerformanceOptimizer::PerformanceOptimizer() : pimpl_(std::make_unique<Impl>())
+    {
+        pimpl_->owner_ = this;
+        pimpl_->init_allocation();
+        pimpl_->window_start_ = utils::metrics::Registry::instance().histogram(pimpl_->latency_metric_);
+    }
+
+    PerformanceOptimizer::~PerformanceOptimizer()
+    {
+        shutdown();
+    }
+
+    bool PerformanceOptimizer::initialize(const std::map<std::string, std::string> &config)
+    {
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+            if (!pimpl_->apply_config(config))
+            {
+                utils::Logger::instance().log(utils::LogLevel::ERROR, "PerformanceOptimizer",
+                                              "Invalid optimizer configuration");
+                return false;
+            }
+            pimpl_->window_start_ = utils::metrics::Registry::instance().histogram(pimpl_->latency_metric_);
+            pimpl_->initialized_ = true;
+        }
+        utils::Logger::instance().log(utils::LogLevel::INFO, "PerformanceOptimizer",
+                                      "Performance optimizer initialized");
+        return true;
+    }
+
+    void PerformanceOptimizer::shutdown()
+    {
+        stop_monitoring();
+        std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+        pimpl_->auto_optimize_ = false;
+        pimpl_->initialized_ = false;
+    }
+
+    bool PerformanceOptimizer::start_monitoring(uint32_t monitoring_interval_ms)
+    {
+        if (monitoring_interval_ms == 0)
+        {
+            return false;
+        }
+        pimpl_->monitoring_interval_ms_ = monitoring_interval_ms;
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->monitor_mutex_);
+            if (pimpl_->monitoring_)
+            {
+                pimpl_->monitor_cv_.notify_all(); // Pick up the new interval
+                return true;
+            }
+            pimpl_->monitoring_ = true;
+        }
+        pimpl_->sample(); // Baseline for the first rates
+        pimpl_->monitor_ = std::thread(&Impl::monitor_loop, pimpl_.get());
+        utils::Logger::instance().log(utils::LogLevel::INFO, "PerformanceOptimizer",
+                                      "Monitoring every " + std::to_string(monitoring_interval_ms) + " ms");
+        return true;
+    }
+
+    void PerformanceOptimizer::stop_monitoring()
+    {
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->monitor_mutex_);
+            pimpl_->monitoring_ = false;
+        }
+        pimpl_->monitor_cv_.notify_all();
+        if (pimpl_->monitor_.joinable())
+        {
+            pimpl_->monitor_.join();
+        }
+    }
+
+    PerformanceMetrics PerformanceOptimizer::get_current_metrics() const
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+        return pimpl_->current_;
+    }
+
+    std::vector<PerformanceMetrics> PerformanceOptimizer::get_historical_metrics(uint64_t start_time, uint64_t end_time,
+                                                                                 uint32_t granularity_ms) const
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+        std::vector<PerformanceMetrics> result;
+        const uint64_t granularity = std::max<uint64_t>(granularity_ms, 1);
+        for (const auto &metrics : pimpl_->history_)
+        {
+            if (metrics.measurement_time < start_time || metrics.measurement_time > end_time)
+            {
+                continue;
+            }
+            // Latest sample per granularity bucket
+            if (!result.empty() && result.back().measurement_time * 1000 / granularity == metrics.measurement_time * 1000 / granularity)
+            {
+                result.back() = metrics;
+            }
+            else
+            {
+                result.push_back(metrics);
+            }
+        }
+        return result;
+    }
+
+    bool PerformanceOptimizer::set_optimization_strategy(OptimizationStrategy strategy)
+    {
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+            pimpl_->strategy_ = strategy;
+        }
+        utils::Logger::instance().log(utils::LogLevel::INFO, "PerformanceOptimizer",
+                                      "Optimization strategy: " + optimization_strategy_to_string(strategy));
+        return true;
+    }
+
+    bool PerformanceOptimizer::enable_auto_optimization(bool enable, uint32_t optimization_interval_ms)
+    {
+        if (enable && optimization_interval_ms == 0)
+        {
+            return false;
+        }
+        pimpl_->optimization_interval_ms_ = optimization_interval_ms;
+        pimpl_->auto_optimize_ = enable;
+        if (enable)
+        {
+            // Sample at least once per optimization period
+            const uint32_t interval = std::min(pimpl_->monitoring_interval_ms_.load(), optimization_interval_ms);
+            return start_monitoring(interval);
+        }
+        return true;
+    }
+
+    std::vector<OptimizationRecommendation> PerformanceOptimizer::analyze_performance()
+    {
+        auto &registry = utils::metrics::Registry::instance();
+        std::function<double()> power_source;
+        std::string latency_metric;
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+            power_source = pimpl_->power_source_;
+            latency_metric = pimpl_->latency_metric_;
+        }
+        const auto snapshot = registry.histogram(latency_metric);
+        const bool power_known = static_cast<bool>(power_source);
+        const double power = power_known ? power_source() : 0.0;
+
+        std::vector<OptimizationRecommendation> recommendations;
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+            const auto window = snapshot.since(pimpl_->window_start_);
+            pimpl_->window_start_ = snapshot;
+            const bool latency_known = window.count >= std::max<uint64_t>(pimpl_->min_samples_, 1);
+            const double latency = latency_known ? window.quantile(pimpl_->latency_quantile_) : 0.0;
+
+            std::string reason;
+            double error = 0.0;
+            const Goal goal = pimpl_->decide(latency, latency_known, power, power_known, reason, error);
+            double value = 0.0, proposed = 0.0;
+            if (const TuningKnob *knob = pimpl_->pick_knob(goal, "", value, proposed))
+            {
+                const double confidence = latency_known ? static_cast<double>(window.count) / static_cast<double>(pimpl_->min_samples_ * 5 + 1) : 0.5;
+                recommendations.push_back(pimpl_->knob_recommendation(*knob, value, proposed, reason, error, confidence));
+            }
+
+            // Advisory findings from the latest sample
+            const PerformanceMetrics &current = pimpl_->current_;
+            auto advise = [&](const std::string &category, const std::string &description, const std::string &action, uint32_t priority)
+            {
+                OptimizationRecommendation recommendation;
+                recommendation.category = category;
+                recommendation.description = description;
+                recommendation.action = action;
+                recommendation.expected_improvement = 0.1;
+                recommendation.confidence_score = 0.5;
+                recommendation.priority = priority;
+                recommendation.auto_applicable = false;
+                recommendations.push_back(recommendation);
+            };
+            if (current.error_rate_percent > 5.0)
+            {
+                advise("reliability", "Error rate " + format_number(current.error_rate_percent) + "%", "check_backend_health", 9);
+            }
+            if (current.memory_usage_percent > 85.0)
+            {
+                advise("memory", "Resident memory at " + format_number(current.memory_usage_percent) + "% of physical", "reduce_cache_size", 7);
+            }
+            if (current.cpu_usage_percent > 90.0)
+            {
+                advise("cpu", "Process CPU at " + format_number(current.cpu_usage_percent) + "%", "reduce_worker_threads", 6);
+            }
+        }
+
+        pimpl_->analyses_.inc();
+        pimpl_->recommendations_.inc(recommendations.size());
+        RecommendationCallback callback;
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+            callback = pimpl_->recommendation_callback_;
+        }
+        if (callback)
+        {
+            for (const auto &recommendation : recommendations)
+            {
+                callback(recommendation);
+            }
+        }
+        return recommendations;
+    }
+
+    bool PerformanceOptimizer::apply_optimization(const OptimizationRecommendation &recommendation)
+    {
+        bool applied = false;
+        if (recommendation.action == "set_knob")
+        {
+            auto knob = recommendation.parameters.find("knob");
+            auto value = recommendation.parameters.find("value");
+            double number = 0.0;
+            applied = knob != recommendation.parameters.end() && value != recommendation.parameters.end() &&
+                      parse_double(value->second, number) && pimpl_->set_knob(knob->second, number, recommendation.description);
+        }
+        else if (recommendation.action == "scale_resources")
+        {
+            auto factor = recommendation.parameters.find("factor");
+            double number = 0.0;
+            applied = factor != recommendation.parameters.end() && parse_double(factor->second, number) && scale_resources(number);
+        }
+        if (applied)
+        {
+            pimpl_->applied_.inc();
+        }
+        return applied;
+    }
+
+    uint32_t PerformanceOptimizer::apply_all_optimizations(bool auto_only)
+    {
+        uint32_t applied = 0;
+        for (const auto &recommendation : analyze_performance())
+        {
+            if ((!auto_only || recommendation.auto_applicable) && apply_optimization(recommendation))
+            {
+                ++applied;
+            }
+        }
+        return applied;
+    }
+
+    ResourceAllocation PerformanceOptimizer::optimize_resource_allocation(const PerformanceMetrics &target_metrics)
+    {
+        ResourceAllocation allocation = get_current_resource_allocation();
+        const PerformanceMetrics current = get_current_metrics();
+
+        if (target_metrics.p95_response_time_ms > 0.0 && current.p95_response_time_ms > target_metrics.p95_response_time_ms)
+        {
+            allocation.worker_threads = std::min(allocation.worker_threads + 1, estimate_optimal_thread_count("io_bound"));
+            allocation.batch_size = std::max<uint32_t>(allocation.batch_size / 2, 1);
+            allocation.flush_interval_ms = std::max<uint32_t>(allocation.flush_interval_ms / 2, 1);
+        }
+        else if (target_metrics.power_consumption_mw > 0.0 && current.power_consumption_mw > target_metrics.power_consumption_mw)
+        {
+            allocation.worker_threads = std::max<uint32_t>(allocation.worker_threads - (allocation.worker_threads > 1 ? 1 : 0), 1);
+            allocation.batch_size *= 2;
+            allocation.flush_interval_ms *= 2;
+        }
+        const uint32_t latency_target = target_metrics.p95_response_time_ms > 0.0
+                                            ? static_cast<uint32_t>(target_metrics.p95_response_time_ms)
+                                            : 100;
+        allocation.buffer_size_mb = std::max<uint64_t>(
+            estimate_optimal_buffer_size(std::max(current.network_bandwidth_mbps, 1.0), latency_target) / (1024 * 1024), 1);
+        return allocation;
+    }
+
+    bool PerformanceOptimizer::apply_resource_allocation(const ResourceAllocation &allocation)
+    {
+        if (allocation.worker_threads == 0 || allocation.batch_size == 0)
+        {
+            return false;
+        }
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+            pimpl_->allocation_ = allocation;
+        }
+        pimpl_->set_category("threads", allocation.worker_threads, "resource allocation");
+        pimpl_->set_category("batching", allocation.batch_size, "resource allocation");
+        pimpl_->set_category("logging", allocation.flush_interval_ms, "resource allocation");
+        return true;
+    }
+
+    ResourceAllocation PerformanceOptimizer::get_current_resource_allocation() const
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+        ResourceAllocation allocation = pimpl_->allocation_;
+        // Live knob values win over the recorded allocation
+        for (const auto &[name, knob] : pimpl_->knobs_)
+        {
+            const auto value = static_cast<uint32_t>(knob.get());
+            if (knob.category == "threads")
+            {
+                allocation.worker_threads = value;
+            }
+            else if (knob.category == "batching")
+            {
+                allocation.batch_size = value;
+            }
+            else if (knob.category == "logging")
+            {
+                allocation.flush_interval_ms = value;
+            }
+        }
+        return allocation;
+    }
+
+    bool PerformanceOptimizer::scale_resources(double scale_factor)
+    {
+        if (!(scale_factor > 0.0) || !std::isfinite(scale_factor))
+        {
+            return false;
+        }
+        std::vector<std::pair<std::string, double>> targets;
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+            pimpl_->allocation_.worker_threads = std::max<uint32_t>(
+                static_cast<uint32_t>(std::round(pimpl_->allocation_.worker_threads * scale_factor)), 1);
+            for (const auto &[name, knob] : pimpl_->knobs_)
+            {
+                if (knob.category == "threads" || knob.category == "bandwidth")
+                {
+                    targets.emplace_back(name, knob.get() * scale_factor);
+                }
+            }
+        }
+        for (const auto &[name, value] : targets)
+        {
+            pimpl_->set_knob(name, value, "scaled by " + format_number(scale_factor));
+        }
+        return true;
+    }
+
+    bool PerformanceOptimizer::configure_load_balancing(const LoadBalancingConfig &config)
+    {
+        static const std::set<std::string> strategies = {"round_robin", "least_connections", "weighted", "adaptive"};
+        if (!strategies.count(config.strategy))
+        {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+        pimpl_->load_balancing_ = config;
+        pimpl_->endpoints_.clear();
+        for (const auto &endpoint : config.endpoints)
+        {
+            auto weight = config.weights.find(endpoint);
+            pimpl_->endpoints_[endpoint].weight = weight != config.weights.end() && weight->second > 0.0 ? weight->second : 1.0;
+        }
+        return true;
+    }
+
+    bool PerformanceOptimizer::add_endpoint(const std::string &endpoint, double weight)
+    {
+        if (endpoint.empty() || !(weight > 0.0))
+        {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+        pimpl_->endpoints_[endpoint].weight = weight;
+        return true;
+    }
+
+    bool PerformanceOptimizer::remove_endpoint(const std::string &endpoint)
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+        return pimpl_->endpoints_.erase(endpoint) > 0;
+    }
+
+    std::string PerformanceOptimizer::get_next_endpoint()
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+        std::vector<std::pair<const std::string, Impl::Endpoint> *> candidates;
+        for (auto &entry : pimpl_->endpoints_)
+        {
+            if (entry.second.healthy)
+            {
+                candidates.push_back(&entry);
+            }
+        }
+        if (candidates.empty())
+        {
+            for (auto &entry : pimpl_->endpoints_)
+            {
+                candidates.push_back(&entry); // All unhealthy: keep trying rather than fail outright
+            }
+        }
+        if (candidates.empty())
+        {
+            return "";
+        }
+
+        const std::string &strategy = pimpl_->load_balancing_.strategy;
+        if (strategy == "weighted")
+        {
+            // Smooth weighted round robin: spreads picks evenly in proportion to weight
+            double total = 0.0;
+            std::pair<const std::string, Impl::Endpoint> *best = nullptr;
+            for (auto *candidate : candidates)
+            {
+                candidate->second.current_weight += candidate->second.weight;
+                total += candidate->second.weight;
+                if (!best || candidate->second.current_weight > best->second.current_weight)
+                {
+                    best = candidate;
+                }
+            }
+            best->second.current_weight -= total;
+            return best->first;
+        }
+        if (strategy == "adaptive" || strategy == "least_connections")
+        {
+            // Lowest smoothed response time per unit of weight; in-flight counts are not tracked
+            auto best = std::min_element(candidates.begin(), candidates.end(), [](const auto *a, const auto *b)
+                                         { return a->second.response_ms / a->second.weight < b->second.response_ms / b->second.weight; });
+            return (*best)->first;
+        }
+        return candidates[pimpl_->round_robin_++ % candidates.size()]->first;
+    }
+
+    void PerformanceOptimizer::report_endpoint_health(const std::string &endpoint, bool is_healthy, uint32_t response_time_ms)
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+        auto it = pimpl_->endpoints_.find(endpoint);
+        if (it == pimpl_->endpoints_.end())
+        {
+            return;
+        }
+        Impl::Endpoint &state = it->second;
+        const uint32_t failure_threshold = std::max<uint32_t>(pimpl_->load_balancing_.failure_threshold, 1);
+        const uint32_t recovery_threshold = std::max<uint32_t>(pimpl_->load_balancing_.recovery_threshold, 1);
+        if (response_time_ms > 0)
+        {
+            state.response_ms = state.response_ms == 0.0
+                                    ? response_time_ms
+                                    : state.response_ms + LATENCY_EWMA_ALPHA * (response_time_ms - state.response_ms);
+        }
+        if (is_healthy)
+        {
+            state.failures = 0;
+            if (!state.healthy && ++state.successes >= recovery_threshold)
+            {
+                state.healthy = true;
+                state.successes = 0;
+            }
+        }
+        else
+        {
+            state.successes = 0;
+            if (state.healthy && ++state.failures >= failure_threshold)
+            {
+                state.healthy = false;
+                state.failures = 0;
+            }
+        }
+    }
+
+    std::vector<OptimizationRecommendation> PerformanceOptimizer::optimize_energy_efficiency(double target_efficiency)
+    {
+        if (get_energy_efficiency_score() >= target_efficiency)
+        {
+            return {};
+        }
+        return pimpl_->category_steps(Goal::RELAX, "energy efficiency below " + format_number(target_efficiency), {});
+    }
+
+    bool PerformanceOptimizer::enable_dynamic_power_management(bool enable)
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+        pimpl_->dynamic_power_ = enable;
+        return true;
+    }
+
+    bool PerformanceOptimizer::set_power_budget(double power_budget_mw)
+    {
+        if (!(power_budget_mw >= 0.0) || !std::isfinite(power_budget_mw))
+        {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+        pimpl_->power_budget_mw_ = power_budget_mw;
+        pimpl_->config_["power_budget_mw"] = format_number(power_budget_mw);
+        return true;
+    }
+
+    double PerformanceOptimizer::get_energy_efficiency_score() const
+    {
+        std::function<double()> source;
+        double budget;
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+            source = pimpl_->power_source_;
+            budget = pimpl_->power_budget_mw_;
+        }
+        if (!source || budget <= 0.0)
+        {
+            return 1.0;
+        }
+        const double power = source();
+        return power > budget ? budget / power : 1.0;
+    }
+
+    bool PerformanceOptimizer::configure_caching(uint64_t cache_size_mb, const std::string &eviction_policy, uint32_t ttl_seconds)
+    {
+        static const std::set<std::string> policies = {"lru", "lfu", "random", "ttl"};
+        if (!policies.count(eviction_policy))
+        {
+            return false;
+        }
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+            pimpl_->allocation_.cache_size_mb = cache_size_mb;
+            pimpl_->config_["cache_eviction_policy"] = eviction_policy;
+            pimpl_->config_["cache_ttl_seconds"] = std::to_string(ttl_seconds);
+        }
+        pimpl_->set_category("cache", static_cast<double>(ttl_seconds) * 1000.0, "cache configuration");
+        return true;
+    }
+
+    std::vector<OptimizationRecommendation> PerformanceOptimizer::optimize_memory_usage()
+    {
+        const PerformanceMetrics current = get_current_metrics();
+        std::vector<OptimizationRecommendation> recommendations;
+        if (current.memory_usage_percent > 80.0)
+        {
+            OptimizationRecommendation recommendation;
+            recommendation.category = "memory";
+            recommendation.description = "Resident memory at " + format_number(current.memory_usage_percent) + "% of physical";
+            recommendation.action = "scale_resources";
+            recommendation.expected_improvement = 0.2;
+            recommendation.confidence_score = 0.5;
+            recommendation.priority = 7;
+            recommendation.parameters = {{"factor", "0.75"}};
+            recommendation.auto_applicable = false;
+            recommendations.push_back(recommendation);
+        }
+        return recommendations;
+    }
+
+    uint64_t PerformanceOptimizer::perform_garbage_collection(bool force_full_gc)
+    {
+        (void)force_full_gc; // There is no collector; returning freed heap pages to the OS is all there is to do
+        const double before = resident_mb();
+#if defined(__GLIBC__)
+        malloc_trim(0);
+#endif
+        const double after = resident_mb();
+        return before > after ? static_cast<uint64_t>(before - after) : 0;
+    }
+
+    std::vector<OptimizationRecommendation> PerformanceOptimizer::optimize_network_performance()
+    {
+        const PerformanceMetrics current = get_current_metrics();
+        double target;
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+            target = pimpl_->target_latency_ms_;
+        }
+        if (current.p95_response_time_ms <= target)
+        {
+            return {};
+        }
+        return pimpl_->category_steps(Goal::TIGHTEN, "p95 latency " + format_number(current.p95_response_time_ms) + " ms above target",
+                                      {"bandwidth", "cache"});
+    }
+
+    bool PerformanceOptimizer::enable_connection_pooling(bool enable, uint32_t pool_size, uint32_t max_idle_time_ms)
+    {
+        if (enable && pool_size == 0)
+        {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+        pimpl_->config_["connection_pooling"] = enable ? "true" : "false";
+        pimpl_->config_["connection_pool_size"] = std::to_string(pool_size);
+        pimpl_->config_["connection_max_idle_ms"] = std::to_string(max_idle_time_ms);
+        if (enable)
+        {
+            pimpl_->allocation_.max_connections = pool_size;
+        }
+        return true;
+    }
+
+    bool PerformanceOptimizer::configure_compression(const std::string &algorithm, uint32_t compression_level)
+    {
+        static const std::set<std::string> algorithms = {"gzip", "lz4", "zstd", "none"};
+        if (!algorithms.count(algorithm) || compression_level < 1 || compression_level > 9)
+        {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+        pimpl_->config_["compression"] = algorithm;
+        pimpl_->config_["compression_level"] = std::to_string(compression_level);
+        return true;
+    }
+
+    PerformanceMetrics PerformanceOptimizer::run_benchmark(uint32_t duration_seconds, const std::string &workload_type)
+    {
+        uint32_t threads = std::max(hardware_threads() / 2, 1u);
+        size_t payload = 1024;
+        if (workload_type == "light")
+        {
+            threads = 1;
+            payload = 64;
+        }
+        else if (workload_type == "heavy")
+        {
+            threads = hardware_threads();
+            payload = 4096;
+        }
+        else if (workload_type == "stress")
+        {
+            threads = hardware_threads() * 2;
+            payload = 16384;
+        }
+
+        const WorkloadResult result = run_hash_workload(threads, payload, duration_seconds);
+        PerformanceMetrics metrics{};
+        metrics.measurement_time = now_seconds();
+        metrics.transactions_per_second = static_cast<double>(result.operations) / std::max(result.seconds, 1e-9);
+        metrics.data_points_per_second = metrics.transactions_per_second;
+        metrics.avg_response_time_ms = result.latency.mean();
+        metrics.p95_response_time_ms = result.latency.quantile(0.95);
+        metrics.p99_response_time_ms = result.latency.quantile(0.99);
+        metrics.max_response_time_ms = histogram_max(result.latency);
+        metrics.cpu_usage_percent = result.cpu_percent;
+        metrics.memory_usage_mb = resident_mb();
+        metrics.energy_efficiency_score = get_energy_efficiency_score();
+        metrics.uptime_percent = 100.0;
+        metrics.transaction_success_rate = 1.0;
+        return metrics;
+    }
+
+    std::map<std::string, double> PerformanceOptimizer::run_stress_test(uint32_t duration_seconds, double load_multiplier)
+    {
+        const auto threads = static_cast<uint32_t>(std::max(std::round(hardware_threads() * std::max(load_multiplier, 0.1)), 1.0));
+        const WorkloadResult result = run_hash_workload(threads, 16384, duration_seconds);
+        return {{"threads", threads},
+                {"operations", static_cast<double>(result.operations)},
+                {"ops_per_second", static_cast<double>(result.operations) / std::max(result.seconds, 1e-9)},
+                {"avg_latency_ms", result.latency.mean()},
+                {"p95_latency_ms", result.latency.quantile(0.95)},
+                {"p99_latency_ms", result.latency.quantile(0.99)},
+                {"max_latency_ms", histogram_max(result.latency)},
+                {"cpu_usage_percent", result.cpu_percent},
+                {"memory_usage_mb", resident_mb()}};
+    }
+
+    bool PerformanceOptimizer::register_knob(const TuningKnob &knob)
+    {
+        if (knob.name.empty() || !knob.get || !knob.set || !(knob.max_value >= knob.min_value))
+        {
+            return false;
+        }
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+            pimpl_->knobs_[knob.name] = knob;
+        }
+        utils::Logger::instance().log(utils::LogLevel::DEBUG, "PerformanceOptimizer", "Knob registered: " + knob.name);
+        return true;
+    }
+
+    bool PerformanceOptimizer::unregister_knob(const std::string &name)
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+        return pimpl_->knobs_.erase(name) > 0;
+    }
+
+    std::vector<std::string> PerformanceOptimizer::get_knob_names() const
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+        std::vector<std::string> names;
+        for (const auto &[name, knob] : pimpl_->knobs_)
+        {
+            names.push_back(name);
+        }
+        return names;
+    }
+
+    double PerformanceOptimizer::get_knob_value(const std::string &name) const
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+        auto it = pimpl_->knobs_.find(name);
+        return it != pimpl_->knobs_.end() ? it->second.get() : std::numeric_limits<double>::quiet_NaN();
+    }
+
+    std::vector<TuningChange> PerformanceOptimizer::get_tuning_history() const
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+        return {pimpl_->changes_.begin(), pimpl_->changes_.end()};
+    }
+
+    void PerformanceOptimizer::set_power_source(std::function<double()> source)
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+        pimpl_->power_source_ = std::move(source);
+    }
+
+    void PerformanceOptimizer::record_latency(const std::string &operation_name, double latency_ms)
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->latency_mutex_);
+        auto &histogram = pimpl_->operation_latency_[operation_name];
+        if (!histogram)
+        {
+            histogram = std::make_unique<utils::metrics::Histogram>(
+                "cardano_iot_operation_duration_ms", "Measured operation time in milliseconds",
+                utils::metrics::Histogram::latency_ms_bounds(), utils::metrics::Labels{{"operation", operation_name}});
+        }
+        histogram->observe(latency_ms);
+    }
+
+    void PerformanceOptimizer::set_metrics_callback(MetricsCallback callback)
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+        pimpl_->metrics_callback_ = std::move(callback);
+    }
+
+    void PerformanceOptimizer::set_recommendation_callback(RecommendationCallback callback)
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+        pimpl_->recommendation_callback_ = std::move(callback);
+    }
+
+    bool PerformanceOptimizer::update_configuration(const std::map<std::string, std::string> &config)
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+        const std::string previous_metric = pimpl_->latency_metric_;
+        const bool ok = pimpl_->apply_config(config);
+        if (pimpl_->latency_metric_ != previous_metric)
+        {
+            pimpl_->window_start_ = utils::metrics::Registry::instance().histogram(pimpl_->latency_metric_);
+        }
+        return ok;
+    }
+
+    std::map<std::string, std::string> PerformanceOptimizer::get_configuration() const
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+        auto config = pimpl_->config_;
+        config["strategy"] = optimization_strategy_to_string(pimpl_->strategy_);
+        config["latency_metric"] = pimpl_->latency_metric_;
+        config["target_latency_ms"] = format_number(pimpl_->target_latency_ms_);
+        config["latency_quantile"] = format_number(pimpl_->latency_quantile_);
+        config["hysteresis"] = format_number(pimpl_->hysteresis_);
+        config["min_samples"] = std::to_string(pimpl_->min_samples_);
+        config["power_budget_mw"] = format_number(pimpl_->power_budget_mw_);
+        config["auto_optimization"] = pimpl_->auto_optimize_ ? "true" : "false";
+        config["optimization_interval_ms"] = std::to_string(pimpl_->optimization_interval_ms_.load());
+        return config;
+    }
+
+    std::map<std::string, uint64_t> PerformanceOptimizer::get_optimization_statistics() const
+    {
+        std::map<std::string, uint64_t> stats;
+        stats["samples"] = pimpl_->samples_.value();
+        stats["analyses"] = pimpl_->analyses_.value();
+        stats["recommendations"] = pimpl_->recommendations_.value();
+        stats["optimizations_applied"] = pimpl_->applied_.value();
+        std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+        stats["knobs"] = pimpl_->knobs_.size();
+        stats["knob_changes"] = pimpl_->changes_.size();
+        stats["history_size"] = pimpl_->history_.size();
+        stats["endpoints"] = pimpl_->endpoints_.size();
+        return stats;
+    }
+
+    void PerformanceOptimizer::reset_counters()
+    {
+        for (auto *counter : {&pimpl_->samples_, &pimpl_->analyses_, &pimpl_->recommendations_, &pimpl_->applied_})
+        {
+            counter->reset();
+        }
+        std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+        pimpl_->history_.clear();
+        pimpl_->changes_.clear();
+        pimpl_->last_sample_ = {};
+        pimpl_->window_start_ = utils::metrics::Registry::instance().histogram(pimpl_->latency_metric_);
+    }
+
+    bool PerformanceOptimizer::export_performance_data(const std::string &file_path, const std::string &format) const
+    {
+        std::string content;
+        if (format == "prometheus")
+        {
+            content = utils::metrics::Registry::instance().to_prometheus();
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+            if (format == "json")
+            {
+                json document;
+                document["strategy"] = optimization_strategy_to_string(pimpl_->strategy_);
+                document["current"] = metrics_to_json(pimpl_->current_);
+                document["history"] = json::array();
+                for (const auto &metrics : pimpl_->history_)
+                {
+                    document["history"].push_back(metrics_to_json(metrics));
+                }
+                document["tuning_history"] = json::array();
+                for (const auto &change : pimpl_->changes_)
+                {
+                    document["tuning_history"].push_back({{"knob", change.knob},
+                                                          {"old_value", change.old_value},
+                                                          {"new_value", change.new_value},
+                                                          {"reason", change.reason},
+                                                          {"timestamp", change.timestamp}});
+                }
+                content = document.dump(2);
+            }
+            else if (format == "csv")
+            {
+                std::ostringstream out;
+                out << "measurement_time,transactions_per_second,avg_response_time_ms,p95_response_time_ms,"
+                       "cpu_usage_percent,memory_usage_mb,power_consumption_mw,error_rate_percent\n";
+                for (const auto &m : pimpl_->history_)
+                {
+                    out << m.measurement_time << ',' << m.transactions_per_second << ',' << m.avg_response_time_ms << ','
+                        << m.p95_response_time_ms << ',' << m.cpu_usage_percent << ',' << m.memory_usage_mb << ','
+                        << m.power_consumption_mw << ',' << m.error_rate_percent << '\n';
+                }
+                content = out.str();
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        std::ofstream file(file_path, std::ios::trunc);
+        file << content;
+        return static_cast<bool>(file);
+    }
+
+    std::string optimization_strategy_to_string(OptimizationStrategy strategy)
+    {
+        switch (strategy)
+        {
+        case OptimizationStrategy::THROUGHPUT_FOCUSED:
+            return "throughput_focused";
+        case OptimizationStrategy::LATENCY_FOCUSED:
+            return "latency_focused";
+        case OptimizationStrategy::ENERGY_FOCUSED:
+            return "energy_focused";
+        case OptimizationStrategy::RELIABILITY_FOCUSED:
+            return "reliability_focused";
+        case OptimizationStrategy::COST_FOCUSED:
+            return "cost_focused";
+        case OptimizationStrategy::BALANCED:
+            return "balanced";
+        case OptimizationStrategy::ADAPTIVE:
+            return "adaptive";
+        default:
+            return "unknown";
+        }
+    }
+
+    double calculate_performance_score(const PerformanceMetrics &metrics, const std::map<std::string, double> &weights)
+    {
+        // Each component is scaled to 0..1 with 1 the best
+        const std::map<std::string, double> components = {
+            {"throughput", metrics.transactions_per_second / (metrics.transactions_per_second + 10.0)},
+            {"latency", 100.0 / (100.0 + std::max(metrics.p95_response_time_ms, 0.0))},
+            {"cpu", 1.0 - std::clamp(metrics.cpu_usage_percent, 0.0, 100.0) / 100.0},
+            {"memory", 1.0 - std::clamp(metrics.memory_usage_percent, 0.0, 100.0) / 100.0},
+            {"energy", std::clamp(metrics.energy_efficiency_score, 0.0, 1.0)},
+            {"reliability", 1.0 - std::clamp(metrics.error_rate_percent, 0.0, 100.0) / 100.0}};
+
+        double total = 0.0, weight_sum = 0.0;
+        for (const auto &[name, score] : components)
+        {
+            auto weight = weights.find(name);
+            const double w = weights.empty() ? 1.0 : (weight != weights.end() ? std::max(weight->second, 0.0) : 0.0);
+            total += score * w;
+            weight_sum += w;
+        }
+        return weight_sum > 0.0 ? std::clamp(total / weight_sum, 0.0, 1.0) : 0.0;
+    }
+
+    uint32_t estimate_optimal_thread_count(const std::string &workload_type)
+    {
+        const uint32_t cores = hardware_threads();
+        if (workload_type == "cpu_bound")
+        {
+            return cores;
+        }
+        if (workload_type == "io_bound")
+        {
+            return cores * 2;
+        }
+        return cores + cores / 2;
+    }
+
+    uint64_t estimate_optimal_buffer_size(double data_rate_mbps, uint32_t latency_target_ms)
+    {
+        // Bandwidth-delay product, rounded up to a power of two within 4 KiB .. 64 MiB
+        const double bytes = std::max(data_rate_mbps, 0.0) * 1e6 / 8.0 * latency_target_ms / 1000.0;
+        uint64_t size = 4096;
+        while (size < bytes && size < (64ull << 20))
+        {
+            size <<= 1;
+        }
+        return size;
+    }
+
+} // namespace cardano_iot::performance
@@ -0,0 +1,438 @@
+/**
+ * @file performance_profiler.cpp
+ * @brief Span tracer behind PerformanceProfiler and ScopedTimer
+ *
+ * @author Cardano IoT SDK Team
+ * @version 1.0.0
+ */
+
+#include "cardano_iot/performance/performance_optimizer.h"
+#include "cardano_iot/utils/logger.h"
+
+#include <nlohmann/json.hpp>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <x86intrin.h>
+#define CARDANO_IOT_PROFILER_TSC 1
+#endif
+
+#include <algorithm>
+#include <condition_variable>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace cardano_iot::performance
+{
+
+    namespace
+    {
+        constexpr size_t RING_CAPACITY = 8192; // Spans per thread between drains
+        constexpr auto FLUSH_INTERVAL = std::chrono::milliseconds(20);
+
+        struct Span
+        {
+            const char *name;
+            uint64_t start;
+            uint64_t end;
+        };
+
+        /**
+         * Single-producer, single-consumer ring: the owning thread advances head,
+         * the flusher advances tail.
+         */
+        struct ThreadRing
+        {
+            explicit ThreadRing(uint32_t id) : spans(new Span[RING_CAPACITY]), thread_id(id) {}
+
+            std::unique_ptr<Span[]> spans;
+            std::atomic<size_t> head{0};
+            std::atomic<size_t> tail{0};
+            std::atomic<bool> alive{true};
+            const uint32_t thread_id;
+        };
+
+        struct SpanStats
+        {
+            uint64_t count = 0;
+            uint64_t total_ticks = 0;
+            uint64_t max_ticks = 0;
+        };
+
+        struct TraceEvent
+        {
+            const char *name;
+            uint64_t start;
+            uint64_t end;
+            uint32_t thread_id;
+        };
+
+        double calibrate_ns_per_tick()
+        {
+#if defined(CARDANO_IOT_PROFILER_TSC)
+            const auto wall_start = std::chrono::steady_clock::now();
+            const uint64_t ticks_start = __rdtsc();
+            auto wall_end = wall_start;
+            while (wall_end - wall_start < std::chrono::milliseconds(2))
+            {
+                wall_end = std::chrono::steady_clock::now();
+            }
+            const uint64_t ticks_end = __rdtsc();
+            const double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(wall_end - wall_start).count());
+            return ticks_end > ticks_start ? ns / static_cast<double>(ticks_end - ticks_start) : 1.0;
+#else
+            return 1.0;
+#endif
+        }
+
+        double ns_per_tick()
+        {
+            static const double value = calibrate_ns_per_tick();
+            return value;
+        }
+
+        class Tracer
+        {
+        public:
+            static Tracer &instance()
+            {
+                static Tracer tracer;
+                return tracer;
+            }
+
+            ~Tracer()
+            {
+                stop_flusher();
+            }
+
+            ThreadRing &ring()
+            {
+                // The holder marks the ring dead when its thread exits; the flusher drains and drops it
+                struct Holder
+                {
+                    std::shared_ptr<ThreadRing> ring;
+                    ~Holder()
+                    {
+                        if (ring)
+                        {
+                            ring->alive.store(false, std::memory_order_release);
+                        }
+                    }
+                };
+                thread_local Holder holder;
+                if (!holder.ring)
+                {
+                    std::lock_guard<std::mutex> lock(registry_mutex_);
+                    holder.ring = std::make_shared<ThreadRing>(next_thread_id_++);
+                    rings_.push_back(holder.ring);
+                }
+                return *holder.ring;
+            }
+
+            void record(const char *name, uint64_t start, uint64_t end)
+            {
+                ThreadRing &ring = this->ring();
+                const size_t head = ring.head.load(std::memory_order_relaxed);
+                if (head - ring.tail.load(std::memory_order_acquire) >= RING_CAPACITY)
+                {
+                    dropped_.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+                ring.spans[head % RING_CAPACITY] = {name, start, end};
+                ring.head.store(head + 1, std::memory_order_release);
+            }
+
+            void start(const std::string &session_name)
+            {
+                ns_per_tick(); // Calibrate here rather than on a hot path
+                stop_flusher();
+                PerformanceProfiler::set_enabled(false);
+
+                {
+                    std::lock_guard<std::mutex> lock(data_mutex_);
+                    drain_locked(); // Discard spans left from before
+                    stats_.clear();
+                    trace_.clear();
+                    dropped_.store(0, std::memory_order_relaxed);
+                    session_name_ = session_name;
+                    session_start_ = PerformanceProfiler::now_ticks();
+                    session_active_ = true;
+                }
+
+                {
+                    std::lock_guard<std::mutex> lock(flusher_mutex_);
+                    stopping_ = false;
+                }
+                flusher_ = std::thread([this]
+                                       { run_flusher(); });
+                PerformanceProfiler::set_enabled(true);
+            }
+
+            bool finish(const std::string &session_name)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(data_mutex_);
+                    if (!session_active_ || session_name != session_name_)
+                    {
+                        return false;
+                    }
+                }
+                PerformanceProfiler::set_enabled(false);
+                stop_flusher();
+
+                std::lock_guard<std::mutex> lock(data_mutex_);
+                drain_locked();
+                session_active_ = false;
+                return true;
+            }
+
+            // Per-name statistics; different pointers with the same text are merged
+            std::map<std::string, SpanStats> statistics()
+            {
+                std::lock_guard<std::mutex> lock(data_mutex_);
+                drain_locked();
+                std::map<std::string, SpanStats> merged;
+                for (const auto &[name, stats] : stats_)
+                {
+                    SpanStats &entry = merged[name];
+                    entry.count += stats.count;
+                    entry.total_ticks += stats.total_ticks;
+                    entry.max_ticks = std::max(entry.max_ticks, stats.max_ticks);
+                }
+                return merged;
+            }
+
+            std::string chrome_trace()
+            {
+                std::lock_guard<std::mutex> lock(data_mutex_);
+                drain_locked();
+
+                const double scale = ns_per_tick() / 1000.0; // Ticks to microseconds
+                std::unordered_map<const char *, std::string> quoted;
+                std::ostringstream out;
+                out << std::fixed << std::setprecision(3);
+                out << "{\"displayTimeUnit\":\"ms\",\"otherData\":{\"session\":" << nlohmann::json(session_name_).dump()
+                    << "},\"traceEvents\":[";
+                bool first = true;
+                for (const auto &event : trace_)
+                {
+                    auto name = quoted.find(event.name);
+                    if (name == quoted.end())
+                    {
+                        name = quoted.emplace(event.name, nlohmann::json(event.name).dump()).first;
+                    }
+                    const uint64_t start = event.start > session_start_ ? event.start - session_start_ : 0;
+                    out << (first ? "" : ",") << "{\"name\":" << name->second << ",\"cat\":\"sdk\",\"ph\":\"X\",\"ts\":"
+                        << static_cast<double>(start) * scale << ",\"dur\":" << static_cast<double>(event.end - event.start) * scale
+                        << ",\"pid\":1,\"tid\":" << event.thread_id << "}";
+                    first = false;
+                }
+                out << "]}";
+                return out.str();
+            }
+
+            uint64_t dropped() const
+            {
+                return dropped_.load(std::memory_order_relaxed);
+            }
+
+            void set_trace_capacity(size_t max_events)
+            {
+                std::lock_guard<std::mutex> lock(data_mutex_);
+                trace_capacity_ = max_events;
+            }
+
+            const char *intern(const std::string &name)
+            {
+                std::lock_guard<std::mutex> lock(intern_mutex_);
+                return names_.insert(name).first->c_str();
+            }
+
+        private:
+            std::mutex registry_mutex_;
+            std::vector<std::shared_ptr<ThreadRing>> rings_;
+            uint32_t next_thread_id_ = 1;
+
+            std::mutex data_mutex_;
+            std::unordered_map<const char *, SpanStats> stats_;
+            std::vector<TraceEvent> trace_;
+            size_t trace_capacity_ = 1 << 20;
+            std::string session_name_;
+            uint64_t session_start_ = 0;
+            bool session_active_ = false;
+            std::atomic<uint64_t> dropped_{0};
+
+            std::mutex flusher_mutex_;
+            std::condition_variable flusher_cv_;
+            bool stopping_ = false;
+            std::thread flusher_;
+
+            std::mutex intern_mutex_;
+            std::unordered_set<std::string> names_; // Node-based, so c_str() stays valid
+
+            // Caller holds data_mutex_
+            void drain_locked()
+            {
+                std::vector<std::shared_ptr<ThreadRing>> rings;
+                {
+                    std::lock_guard<std::mutex> lock(registry_mutex_);
+                    rings = rings_;
+                }
+
+                for (const auto &ring : rings)
+                {
+                    const bool alive = ring->alive.load(std::memory_order_acquire);
+                    const size_t tail = ring->tail.load(std::memory_order_relaxed);
+                    const size_t head = ring->head.load(std::memory_order_acquire);
+                    for (size_t i = tail; i < head; ++i)
+                    {
+                        const Span &span = ring->spans[i % RING_CAPACITY];
+                        const uint64_t duration = span.end > span.start ? span.end - span.start : 0;
+                        SpanStats &stats = stats_[span.name];
+                        stats.count++;
+                        stats.total_ticks += duration;
+                        stats.max_ticks = std::max(stats.max_ticks, duration);
+                        if (trace_.size() < trace_capacity_)
+                        {
+                            trace_.push_back({span.name, span.start, span.start + duration, ring->thread_id});
+                        }
+                    }
+                    ring->tail.store(head, std::memory_order_release);
+
+                    if (!alive)
+                    {
+                        std::lock_guard<std::mutex> lock(registry_mutex_);
+                        rings_.erase(std::remove(rings_.begin(), rings_.end(), ring), rings_.end());
+                    }
+                }
+            }
+
+            void run_flusher()
+            {
+                std::unique_lock<std::mutex> lock(flusher_mutex_);
+                while (!stopping_)
+                {
+                    flusher_cv_.wait_for(lock, FLUSH_INTERVAL, [this]
+                                         { return stopping_; });
+                    lock.unlock();
+                    {
+                        std::lock_guard<std::mutex> data_lock(data_mutex_);
+                        drain_locked();
+                    }
+                    lock.lock();
+                }
+            }
+
+            void stop_flusher()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(flusher_mutex_);
+                    stopping_ = true;
+                }
+                flusher_cv_.notify_all();
+                if (flusher_.joinable())
+                {
+                    flusher_.join();
+                }
+            }
+        };
+    } // namespace
+
+    uint64_t PerformanceProfiler::now_ticks()
+    {
+#if defined(CARDANO_IOT_PROFILER_TSC)
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                         std::chrono::steady_clock::now().time_since_epoch())
+                                         .count());
+#endif
+    }
+
+    double PerformanceProfiler::ticks_to_ms(uint64_t ticks)
+    {
+        return static_cast<double>(ticks) * ns_per_tick() / 1e6;
+    }
+
+    void PerformanceProfiler::record_span(const char *name, uint64_t start_ticks, uint64_t end_ticks)
+    {
+        Tracer::instance().record(name, start_ticks, end_ticks);
+    }
+
+    const char *PerformanceProfiler::intern(const std::string &name)
+    {
+        return Tracer::instance().intern(name);
+    }
+
+    void PerformanceProfiler::start_session(const std::string &session_name)
+    {
+        Tracer::instance().start(session_name);
+        utils::Logger::instance().log(utils::LogLevel::INFO, "Profiler", "Profiling session started: " + session_name);
+    }
+
+    std::map<std::string, double> PerformanceProfiler::end_session(const std::string &session_name)
+    {
+        Tracer &tracer = Tracer::instance();
+        if (!tracer.finish(session_name))
+        {
+            return {};
+        }
+
+        std::map<std::string, double> results;
+        for (const auto &[name, stats] : tracer.statistics())
+        {
+            const double total_ms = ticks_to_ms(stats.total_ticks);
+            results[name + ".count"] = static_cast<double>(stats.count);
+            results[name + ".total_ms"] = total_ms;
+            results[name + ".avg_ms"] = total_ms / static_cast<double>(stats.count);
+            results[name + ".max_ms"] = ticks_to_ms(stats.max_ticks);
+        }
+        results["spans_dropped"] = static_cast<double>(tracer.dropped());
+
+        utils::Logger::instance().log(utils::LogLevel::INFO, "Profiler", "Profiling session ended: " + session_name);
+        return results;
+    }
+
+    std::string PerformanceProfiler::get_profiling_report()
+    {
+        auto statistics = Tracer::instance().statistics();
+        std::vector<std::pair<std::string, SpanStats>> rows(statistics.begin(), statistics.end());
+        std::sort(rows.begin(), rows.end(), [](const auto &a, const auto &b)
+                  { return a.second.total_ticks > b.second.total_ticks; });
+
+        std::ostringstream report;
+        report << std::fixed << std::setprecision(3);
+        report << std::left << std::setw(40) << "span" << std::right << std::setw(12) << "count" << std::setw(14) << "total_ms"
+               << std::setw(12) << "avg_ms" << std::setw(12) << "max_ms" << "\n";
+        for (const auto &[name, stats] : rows)
+        {
+            const double total_ms = ticks_to_ms(stats.total_ticks);
+            report << std::left << std::setw(40) << name << std::right << std::setw(12) << stats.count << std::setw(14) << total_ms
+                   << std::setw(12) << total_ms / static_cast<double>(stats.count) << std::setw(12) << ticks_to_ms(stats.max_ticks)
+                   << "\n";
+        }
+        report << "spans dropped: " << Tracer::instance().dropped() << "\n";
+        return report.str();
+    }
+
+    std::string PerformanceProfiler::export_chrome_trace()
+    {
+        return Tracer::instance().chrome_trace();
+    }
+
+    bool PerformanceProfiler::export_chrome_trace(const std::string &file_path)
+    {
+        std::ofstream out(file_path);
+        out << export_chrome_trace();
+        return static_cast<bool>(out);
+    }
+
+    void PerformanceProfiler::set_trace_capacity(size_t max_events)
+    {
+        Tracer::instance().set_trace_capacity(max_events);
+    }
+
+} // namespace cardano_iot::performance
@@ -0,0 +1,126 @@
+/**
+ * @file tuning_knobs.cpp
+ * @brief Tuning knobs over live SDK settings
+ *
+ * @author Cardano IoT SDK Team
+ * @version 1.0.0
+ */
+
+#include "cardano_iot/performance/tuning_knobs.h"
+#include "cardano_iot/cardano_iot.h"
+#include "cardano_iot/core/transaction_builder_pool.h"
+#include "cardano_iot/data/data_provenance.h"
+#include "cardano_iot/network/cardano_client.h"
+#include "cardano_iot/network/p2p_network.h"
+#include "cardano_iot/utils/logger.h"
+
+#include <algorithm>
+#include <thread>
+
+namespace cardano_iot::performance
+{
+
+    namespace
+    {
+        TuningKnob make_knob(const std::string &name, const std::string &category, double min_value, double max_value,
+                             int latency_direction, int energy_direction)
+        {
+            TuningKnob knob;
+            knob.name = name;
+            knob.category = category;
+            knob.min_value = min_value;
+            knob.max_value = std::max(min_value, max_value);
+            knob.latency_direction = latency_direction;
+            knob.energy_direction = energy_direction;
+            return knob;
+        }
+    } // namespace
+
+    TuningKnob ingestion_batch_knob(CardanoIoTSDK &sdk, uint32_t min_batch, uint32_t max_batch)
+    {
+        // Smaller batches wait less for a batch to fill; larger ones wake the worker less often
+        TuningKnob knob = make_knob("sdk.ingestion_batch_size", "batching", min_batch, max_batch, -1, +1);
+        knob.get = [&sdk]
+        { return static_cast<double>(sdk.get_ingestion_batch_size()); };
+        knob.set = [&sdk](double value)
+        {
+            sdk.set_ingestion_batch_size(static_cast<uint32_t>(value));
+            return true;
+        };
+        return knob;
+    }
+
+    TuningKnob anchor_batch_knob(data::DataProvenance &provenance, size_t min_batch, size_t max_batch)
+    {
+        // Each anchor is one transaction, so larger batches mean fewer fees and radio bursts
+        TuningKnob knob = make_knob("provenance.anchor_batch_size", "batching", static_cast<double>(min_batch),
+                                    static_cast<double>(max_batch), -1, +1);
+        knob.get = [&provenance]
+        { return static_cast<double>(provenance.get_anchor_options().max_batch_events); };
+        knob.set = [&provenance](double value)
+        {
+            provenance.set_anchor_batch_size(static_cast<size_t>(value));
+            return true;
+        };
+        return knob;
+    }
+
+    TuningKnob builder_workers_knob(core::TransactionBuilderPool &pool, size_t min_workers, size_t max_workers)
+    {
+        if (max_workers == 0)
+        {
+            max_workers = std::max(1u, std::thread::hardware_concurrency()) * 2;
+        }
+        TuningKnob knob = make_knob("builder_pool.workers", "threads", static_cast<double>(std::max<size_t>(min_workers, 1)),
+                                    static_cast<double>(max_workers), +1, -1);
+        knob.step_factor = 1.25;
+        knob.get = [&pool]
+        { return static_cast<double>(pool.worker_count()); };
+        knob.set = [&pool](double value)
+        { return pool.resize(static_cast<size_t>(value)) == static_cast<size_t>(value); };
+        return knob;
+    }
+
+    TuningKnob logger_flush_knob(uint32_t min_ms, uint32_t max_ms)
+    {
+        // Only the writer's wake-ups change; records are still written in order
+        TuningKnob knob = make_knob("logger.flush_interval_ms", "logging", std::max<uint32_t>(min_ms, 1), max_ms, 0, +1);
+        knob.step_factor = 2.0;
+        knob.get = []
+        { return static_cast<double>(utils::Logger::instance().flush_interval_ms()); };
+        knob.set = [](double value)
+        {
+            utils::Logger::instance().set_flush_interval(static_cast<uint32_t>(value));
+            return true;
+        };
+        return knob;
+    }
+
+    TuningKnob utxo_cache_ttl_knob(network::CardanoClient &client, uint32_t min_ms, uint32_t max_ms)
+    {
+        // Longer TTLs save backend round trips at the cost of staler answers, bounded by max_ms
+        TuningKnob knob = make_knob("client.utxo_cache_ttl_ms", "cache", std::max<uint32_t>(min_ms, 1), max_ms, +1, +1);
+        knob.get = [&client]
+        { return static_cast<double>(client.get_backend().utxo_cache_ttl_ms); };
+        knob.set = [&client](double value)
+        {
+            client.set_utxo_cache_ttl(static_cast<uint32_t>(value));
+            return true;
+        };
+        return knob;
+    }
+
+    TuningKnob p2p_bandwidth_knob(network::P2PNetwork &network, uint32_t min_kbps, uint32_t max_kbps)
+    {
+        TuningKnob knob = make_knob("p2p.bandwidth_limit_kbps", "bandwidth", std::max<uint32_t>(min_kbps, 1), max_kbps, +1, -1);
+        knob.get = [&network, max_kbps]
+        {
+            const uint32_t limit = network.get_config().bandwidth_limit_kbps;
+            return static_cast<double>(limit == 0 ? max_kbps : limit); // Unlimited reads as the top of the range
+        };
+        knob.set = [&network](double value)
+        { return network.set_bandwidth_limit(static_cast<uint32_t>(value)); };
+        return knob;
+    }
+
+} // namespace cardano_iot::performance
@@ -1,37 +1,137 @@
 #include "cardano_iot/security/attestation.h"
+#include "cardano_iot/security/certificate_chain.h"
+#include "cardano_iot/utils/codec.h"
+#include "cardano_iot/utils/executor.h"
 #include "cardano_iot/utils/logger.h"
 
 #include <algorithm>
+#include <string_view>
+#include <unordered_set>
 
 namespace cardano_iot
 {
     namespace security
     {
+        namespace
+        {
+            constexpr size_t CHAIN_CHUNK = 4;
+            constexpr size_t QUOTE_CHUNK = 16;
+
+            template <typename Fn>
+            void for_each_index(utils::Executor *executor, size_t count, size_t chunk, Fn fn)
+            {
+                if (executor)
+                {
+                    executor->parallel_for(count, fn, chunk);
+                    return;
+                }
+                for (size_t i = 0; i < count; ++i)
+                {
+                    fn(i);
+                }
+            }
+
+            AttestationResult check_quote(const AttestationEvidence &evidence, const std::string &expected_nonce,
+                                          const std::vector<std::string> &trusted_roots)
+            {
+                AttestationResult res{};
+                // Minimal checks (mock). In a real implementation, parse the quote and verify signature
+                if (evidence.nonce != expected_nonce)
+                {
+                    res.valid = false;
+                    res.error = "Nonce mismatch";
+                    return res;
+                }
+                if (evidence.quote.empty())
+                {
+                    res.valid = false;
+                    res.error = "Empty quote";
+                    return res;
+                }
+
+                // With a certificate chain the quote must be signed by the chain's leaf
+                if (!evidence.certificate.empty())
+                {
+                    if (evidence.quote_signature.empty())
+                    {
+                        res.valid = false;
+                        res.error = "Missing quote signature";
+                        return res;
+                    }
+                    ChainVerification chain;
+                    if (!CertificateChainCache::shared().verify_signature(evidence.certificate, trusted_roots,
+                                                                          evidence.quote + evidence.nonce,
+                                                                          utils::codec::base64_decode(evidence.quote_signature),
+                                                                          &chain))
+                    {
+                        res.valid = false;
+                        res.error = chain.valid ? "Quote signature invalid" : "Certificate chain invalid: " + chain.error;
+                        return res;
+                    }
+                    res.verified_claims["certificate_subject"] = chain.subject;
+                }
+
+                res.valid = true;
+                res.verified_claims.insert(evidence.claims.begin(), evidence.claims.end());
+                CARDANO_IOT_LOG(cardano_iot::utils::LogLevel::INFO, "Attestation",
+                                "Attestation verified for device: " << evidence.device_id);
+                return res;
+            }
+        } // namespace
 
         AttestationResult AttestationVerifier::verify_quote(const AttestationEvidence &evidence,
                                                             const std::string &expected_nonce,
-                                                            const std::vector<std::string> & /*trusted_roots*/)
+                                                            const std::vector<std::string> &trusted_roots)
         {
-            AttestationResult res{};
-            // Minimal checks (mock). In a real implementation, parse the quote and verify signature
-            if (evidence.nonce != expected_nonce)
+            return check_quote(evidence, expected_nonce, trusted_roots);
+        }
+
+        std::vector<AttestationResult> AttestationVerifier::verify_quotes_batch(
+            const std::vector<AttestationEvidence> &evidence,
+            const std::vector<std::string> &expected_nonces,
+            const std::vector<std::string> &trusted_roots,
+            utils::Executor *executor)
+        {
+            std::vector<AttestationResult> results(evidence.size());
+            if (expected_nonces.size() != evidence.size() && expected_nonces.size() != 1)
             {
-                res.valid = false;
-                res.error = "Nonce mismatch";
-                return res;
+                for (auto &result : results)
+                {
+                    result.valid = false;
+                    result.error = "Nonce count mismatch";
+                }
+                return results;
             }
-            if (evidence.quote.empty())
+
+            // Verify each distinct chain once, so the per-device checks below only look it up
+            std::vector<const std::string *> chains;
             {
-                res.valid = false;
-                res.error = "Empty quote";
-                return res;
+                std::unordered_set<std::string_view> seen;
+                for (const auto &item : evidence)
+                {
+                    if (!item.certificate.empty() && seen.insert(item.certificate).second)
+                    {
+                        chains.push_back(&item.certificate);
+                    }
+                }
             }
-            // Accept with claims for now
-            res.valid = true;
-            res.verified_claims = evidence.claims;
-            cardano_iot::utils::Logger::instance().log(cardano_iot::utils::LogLevel::INFO,
-                                                       "Attestation", "Attestation verified for device: " + evidence.device_id);
-            return res;
+            auto &cache = CertificateChainCache::shared();
+            for_each_index(executor, chains.size(), CHAIN_CHUNK, [&](size_t i)
+                           { cache.verify(*chains[i], trusted_roots); });
+
+            for_each_index(executor, evidence.size(), QUOTE_CHUNK, [&](size_t i)
+                           {
+                               const auto &nonce = expected_nonces.size() == 1 ? expected_nonces.front() : expected_nonces[i];
+                               results[i] = check_quote(evidence[i], nonce, trusted_roots); });
+
+            const size_t accepted = static_cast<size_t>(std::count_if(results.begin(), results.end(),
+                                                                      [](const AttestationResult &result)
+                                                                      { return result.valid; }));
+            cardano_iot::utils::Logger::instance().log(cardano_iot::utils::LogLevel::INFO, "Attestation",
+                                                       "Attestation batch verified " + std::to_string(accepted) + " of " +
+                                                           std::to_string(evidence.size()) + " quotes (" +
+                                                           std::to_string(chains.size()) + " distinct chains)");
+            return results;
         }
 
     } // namespace security
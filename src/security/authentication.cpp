@@ -1,5 +1,10 @@
 #include "cardano_iot/security/authentication.h"
+#include "cardano_iot/security/certificate_chain.h"
+#include "cardano_iot/security/session_table.h"
+#include "cardano_iot/security/token_authority.h"
 #include "cardano_iot/utils/logger.h"
+#include "cardano_iot/utils/metrics.h"
+#include "cardano_iot/utils/timer_wheel.h"
 
 #include <chrono>
 #include <sstream>
@@ -16,12 +21,11 @@ namespace cardano_iot
         {
             bool initialized_ = false;
             mutable std::mutex auth_mutex_;
-            mutable std::mutex stats_mutex_;
 
             // Storage
             std::map<std::string, AuthCredentials> device_credentials_;
-            std::map<std::string, AuthSession> active_sessions_;
-            std::map<std::string, std::string> active_tokens_;
+            SessionTable sessions_;  // own shard locks; not guarded by auth_mutex_
+            TokenAuthority tokens_;  // stateless tokens, own revocation lock
             std::map<std::string, uint32_t> failed_attempts_;
             std::map<std::string, uint64_t> lockout_until_;
             std::vector<AuthEvent> auth_history_;
@@ -30,8 +34,22 @@ namespace cardano_iot
             SecurityPolicy policy_;
             std::function<void(const AuthEvent &)> audit_callback_;
 
-            // Statistics
-            AuthStats stats_ = {};
+            // Statistics: per-core metrics; attempts are counted per method (AuthMethod order) and result
+            inline static const std::vector<std::string> METHOD_LABELS = {"password", "public_key", "biometric", "multi_factor",
+                                                                           "certificate", "token", "challenge_response"};
+            utils::metrics::CounterSet succeeded_{"cardano_iot_auth_attempts_total", "Authentication attempts by method and result",
+                                                  "method", METHOD_LABELS, {{"result", "success"}}};
+            utils::metrics::CounterSet failed_{"cardano_iot_auth_attempts_total", "Authentication attempts by method and result",
+                                               "method", METHOD_LABELS, {{"result", "failure"}}};
+            utils::metrics::Counter locked_devices_{"cardano_iot_auth_lockouts_total", "Devices locked out after repeated failures"};
+            utils::metrics::Gauge active_sessions_{"cardano_iot_auth_active_sessions", "Sessions that have not expired or been invalidated"};
+            utils::metrics::Counter issued_tokens_{"cardano_iot_auth_tokens_issued_total", "Access tokens issued"};
+            utils::metrics::Counter revoked_tokens_{"cardano_iot_auth_tokens_revoked_total", "Access tokens revoked"};
+
+            // Background expiry; last member so it is destroyed, and its callbacks finished, first
+            utils::TimerWheel::Scope timers_;
+
+            static constexpr std::chrono::seconds REVOCATION_PURGE_INTERVAL{60};
 
             // Generate unique IDs
             std::string generate_session_id() const
@@ -49,19 +67,51 @@ namespace cardano_iot
                 return ss.str();
             }
 
-            std::string generate_token() const
+            static uint64_t now_seconds()
             {
-                std::random_device rd;
-                std::mt19937 gen(rd());
-                std::uniform_int_distribution<> dis(0, 15);
+                return std::chrono::duration_cast<std::chrono::seconds>(
+                           std::chrono::system_clock::now().time_since_epoch())
+                    .count();
+            }
 
-                std::stringstream ss;
-                ss << "token_";
-                for (int i = 0; i < 32; ++i)
+            void session_ended(size_t count = 1)
+            {
+                active_sessions_.decrement_to_zero(static_cast<int64_t>(count));
+            }
+
+            // Sessions are valid through their expiry second, so the timer fires just after it
+            void schedule_session_expiry(const std::string &session_id, uint64_t expiry)
+            {
+                const uint64_t now = now_seconds();
+                const auto delay = std::chrono::seconds(expiry >= now ? expiry - now + 1 : 0);
+                auto timer = timers_.schedule_after(delay, [this, session_id]
+                                                    { expire_session(session_id); });
+                sessions_.set_timer(session_id, timer);
+            }
+
+            void expire_session(const std::string &session_id)
+            {
+                uint64_t expiry = 0;
+                switch (sessions_.expire(session_id, now_seconds(), expiry))
                 {
-                    ss << std::hex << dis(gen);
+                case SessionTable::Lookup::EXPIRED:
+                    session_ended();
+                    CARDANO_IOT_LOG(utils::LogLevel::DEBUG, "Authentication", "Session expired: " << session_id);
+                    break;
+                case SessionTable::Lookup::VALID:
+                    schedule_session_expiry(session_id, expiry); // refreshed since the timer was set
+                    break;
+                default:
+                    break;
                 }
-                return ss.str();
+            }
+
+            void schedule_revocation_purge()
+            {
+                timers_.schedule_after(REVOCATION_PURGE_INTERVAL, [this]
+                                       {
+                                           tokens_.purge_expired(now_seconds());
+                                           schedule_revocation_purge(); });
             }
 
             std::string generate_event_id() const
@@ -104,8 +154,7 @@ namespace cardano_iot
                                    .count();
                     lockout_until_[device_id] = now + policy_.lockout_duration_seconds;
 
-                    std::lock_guard<std::mutex> stats_lock(stats_mutex_);
-                    stats_.locked_devices++;
+                    locked_devices_.inc();
                 }
             }
 
@@ -141,17 +190,8 @@ namespace cardano_iot
                 }
 
                 // Update statistics
-                std::lock_guard<std::mutex> stats_lock(stats_mutex_);
-                stats_.total_attempts++;
-                if (result == AuthStatus::SUCCESS)
-                {
-                    stats_.successful_authentications++;
-                }
-                else
-                {
-                    stats_.failed_authentications++;
-                }
-                stats_.method_usage[method]++;
+                auto &counters = result == AuthStatus::SUCCESS ? succeeded_ : failed_;
+                counters[static_cast<size_t>(method)].inc();
             }
 
             // Verify password hash
@@ -200,6 +240,7 @@ namespace cardano_iot
             // Set default security policy
             pimpl_->policy_ = SecurityPolicy{};
             pimpl_->policy_.allowed_methods = {AuthMethod::PASSWORD, AuthMethod::PUBLIC_KEY, AuthMethod::TOKEN};
+            pimpl_->schedule_revocation_purge();
 
             pimpl_->initialized_ = true;
 
@@ -219,8 +260,9 @@ namespace cardano_iot
 
             // Clear all data
             pimpl_->device_credentials_.clear();
-            pimpl_->active_sessions_.clear();
-            pimpl_->active_tokens_.clear();
+            pimpl_->timers_.cancel_all();
+            pimpl_->sessions_.clear();
+            pimpl_->tokens_.reset();
             pimpl_->failed_attempts_.clear();
             pimpl_->lockout_until_.clear();
             pimpl_->auth_history_.clear();
@@ -284,17 +326,11 @@ namespace cardano_iot
                 pimpl_->device_credentials_.erase(it);
 
                 // Terminate all sessions for this device
-                for (auto session_it = pimpl_->active_sessions_.begin();
-                     session_it != pimpl_->active_sessions_.end();)
+                std::vector<SessionTable::TimerHandle> timers;
+                pimpl_->session_ended(pimpl_->sessions_.erase_device(device_id, &timers));
+                for (const auto &timer : timers)
                 {
-                    if (session_it->second.device_id == device_id)
-                    {
-                        session_it = pimpl_->active_sessions_.erase(session_it);
-                    }
-                    else
-                    {
-                        ++session_it;
-                    }
+                    pimpl_->timers_.cancel(timer);
                 }
 
                 utils::Logger::instance().log(utils::LogLevel::INFO, "Authentication",
@@ -496,31 +532,24 @@ namespace cardano_iot
                 return {};
             }
 
-            // Generate token first (locks internally) to avoid nested locking
             std::string token = generate_access_token(device_id);
 
-            std::lock_guard<std::mutex> lock(pimpl_->auth_mutex_);
-
             AuthSession session;
             session.session_id = pimpl_->generate_session_id();
             session.device_id = device_id;
             session.user_id = "user_" + device_id;
             session.status = AuthStatus::SUCCESS;
-            session.created_timestamp = std::chrono::duration_cast<std::chrono::seconds>(
-                                            std::chrono::system_clock::now().time_since_epoch())
-                                            .count();
+            session.created_timestamp = Impl::now_seconds();
             session.last_activity_timestamp = session.created_timestamp;
             session.expiry_timestamp = session.created_timestamp + pimpl_->policy_.session_timeout_seconds;
             session.permissions = permissions.empty() ? std::vector<std::string>{"read", "write"} : permissions;
             session.token = token;
 
-            pimpl_->active_sessions_[session.session_id] = session;
+            pimpl_->sessions_.insert(session);
+            pimpl_->schedule_session_expiry(session.session_id, session.expiry_timestamp);
 
             // Update statistics
-            {
-                std::lock_guard<std::mutex> stats_lock(pimpl_->stats_mutex_);
-                pimpl_->stats_.active_sessions++;
-            }
+            pimpl_->active_sessions_.add(1);
 
             utils::Logger::instance().log(utils::LogLevel::INFO, "Authentication",
                                           "Session created: " + session.session_id + " for device: " + device_id);
@@ -535,34 +564,18 @@ namespace cardano_iot
                 return false;
             }
 
-            std::lock_guard<std::mutex> lock(pimpl_->auth_mutex_);
-
-            auto it = pimpl_->active_sessions_.find(session_id);
-            if (it != pimpl_->active_sessions_.end())
+            SessionTable::TimerHandle timer;
+            switch (pimpl_->sessions_.touch(session_id, Impl::now_seconds(), &timer))
             {
-                auto now = std::chrono::duration_cast<std::chrono::seconds>(
-                               std::chrono::system_clock::now().time_since_epoch())
-                               .count();
-
-                if (now <= it->second.expiry_timestamp)
-                {
-                    it->second.last_activity_timestamp = now;
-                    return true;
-                }
-                else
-                {
-                    // Session expired, remove it
-                    pimpl_->active_sessions_.erase(it);
-
-                    std::lock_guard<std::mutex> stats_lock(pimpl_->stats_mutex_);
-                    if (pimpl_->stats_.active_sessions > 0)
-                    {
-                        pimpl_->stats_.active_sessions--;
-                    }
-                }
+            case SessionTable::Lookup::VALID:
+                return true;
+            case SessionTable::Lookup::EXPIRED:
+                pimpl_->timers_.cancel(timer);
+                pimpl_->session_ended();
+                return false;
+            default:
+                return false;
             }
-
-            return false;
         }
 
         bool Authentication::refresh_session(const std::string &session_id)
@@ -572,18 +585,8 @@ namespace cardano_iot
                 return false;
             }
 
-            std::lock_guard<std::mutex> lock(pimpl_->auth_mutex_);
-
-            auto it = pimpl_->active_sessions_.find(session_id);
-            if (it != pimpl_->active_sessions_.end())
+            if (pimpl_->sessions_.refresh(session_id, Impl::now_seconds(), pimpl_->policy_.session_timeout_seconds))
             {
-                auto now = std::chrono::duration_cast<std::chrono::seconds>(
-                               std::chrono::system_clock::now().time_since_epoch())
-                               .count();
-
-                it->second.last_activity_timestamp = now;
-                it->second.expiry_timestamp = now + pimpl_->policy_.session_timeout_seconds;
-
                 utils::Logger::instance().log(utils::LogLevel::INFO, "Authentication",
                                               "Session refreshed: " + session_id);
                 return true;
@@ -599,20 +602,11 @@ namespace cardano_iot
                 return false;
             }
 
-            std::lock_guard<std::mutex> lock(pimpl_->auth_mutex_);
-
-            auto it = pimpl_->active_sessions_.find(session_id);
-            if (it != pimpl_->active_sessions_.end())
+            SessionTable::TimerHandle timer;
+            if (pimpl_->sessions_.erase(session_id, &timer))
             {
-                pimpl_->active_sessions_.erase(it);
-
-                {
-                    std::lock_guard<std::mutex> stats_lock(pimpl_->stats_mutex_);
-                    if (pimpl_->stats_.active_sessions > 0)
-                    {
-                        pimpl_->stats_.active_sessions--;
-                    }
-                }
+                pimpl_->timers_.cancel(timer);
+                pimpl_->session_ended();
 
                 utils::Logger::instance().log(utils::LogLevel::INFO, "Authentication",
                                               "Session terminated: " + session_id);
@@ -629,15 +623,7 @@ namespace cardano_iot
                 return {};
             }
 
-            std::lock_guard<std::mutex> lock(pimpl_->auth_mutex_);
-
-            std::vector<AuthSession> sessions;
-            for (const auto &[session_id, session] : pimpl_->active_sessions_)
-            {
-                sessions.push_back(session);
-            }
-
-            return sessions;
+            return pimpl_->sessions_.list();
         }
 
         std::string Authentication::generate_access_token(const std::string &device_id, uint32_t validity_seconds)
@@ -647,17 +633,17 @@ namespace cardano_iot
                 return "";
             }
 
-            std::lock_guard<std::mutex> lock(pimpl_->auth_mutex_);
-
-            std::string token = pimpl_->generate_token();
-            pimpl_->active_tokens_[token] = device_id;
-
-            // Update statistics
+            std::string token = pimpl_->tokens_.issue(device_id, Impl::now_seconds(), validity_seconds);
+            if (token.empty())
             {
-                std::lock_guard<std::mutex> stats_lock(pimpl_->stats_mutex_);
-                pimpl_->stats_.issued_tokens++;
+                utils::Logger::instance().log(utils::LogLevel::ERROR, "Authentication",
+                                              "Failed to sign access token for device: " + device_id);
+                return "";
             }
 
+            // Update statistics
+            pimpl_->issued_tokens_.inc();
+
             utils::Logger::instance().log(utils::LogLevel::INFO, "Authentication",
                                           "Access token generated for device: " + device_id);
 
@@ -671,10 +657,7 @@ namespace cardano_iot
                 return false;
             }
 
-            std::lock_guard<std::mutex> lock(pimpl_->auth_mutex_);
-
-            auto it = pimpl_->active_tokens_.find(token);
-            return it != pimpl_->active_tokens_.end();
+            return pimpl_->tokens_.verify(token, Impl::now_seconds()) == TokenAuthority::Verdict::VALID;
         }
 
         bool Authentication::revoke_token(const std::string &token)
@@ -684,24 +667,19 @@ namespace cardano_iot
                 return false;
             }
 
-            std::lock_guard<std::mutex> lock(pimpl_->auth_mutex_);
-
-            auto it = pimpl_->active_tokens_.find(token);
-            if (it != pimpl_->active_tokens_.end())
+            const uint64_t now = Impl::now_seconds();
+            AccessTokenClaims claims;
+            if (pimpl_->tokens_.verify(token, now, &claims) != TokenAuthority::Verdict::VALID ||
+                !pimpl_->tokens_.revoke(claims, now))
             {
-                pimpl_->active_tokens_.erase(it);
-
-                {
-                    std::lock_guard<std::mutex> stats_lock(pimpl_->stats_mutex_);
-                    pimpl_->stats_.revoked_tokens++;
-                }
-
-                utils::Logger::instance().log(utils::LogLevel::INFO, "Authentication",
-                                              "Token revoked");
-                return true;
+                return false;
             }
 
-            return false;
+            pimpl_->revoked_tokens_.inc();
+
+            utils::Logger::instance().log(utils::LogLevel::INFO, "Authentication",
+                                          "Token revoked");
+            return true;
         }
 
         std::string Authentication::refresh_token(const std::string &token)
@@ -711,18 +689,16 @@ namespace cardano_iot
                 return "";
             }
 
-            std::lock_guard<std::mutex> lock(pimpl_->auth_mutex_);
-
-            auto it = pimpl_->active_tokens_.find(token);
-            if (it != pimpl_->active_tokens_.end())
+            const uint64_t now = Impl::now_seconds();
+            AccessTokenClaims claims;
+            if (pimpl_->tokens_.verify(token, now, &claims) != TokenAuthority::Verdict::VALID ||
+                !pimpl_->tokens_.revoke(claims, now))
             {
-                std::string device_id = it->second;
-                pimpl_->active_tokens_.erase(it);
-
-                return generate_access_token(device_id);
+                return "";
             }
 
-            return "";
+            // The replacement keeps the lifetime the original was issued with
+            return generate_access_token(claims.device_id, static_cast<uint32_t>(claims.expires_at - claims.issued_at));
         }
 
         bool Authentication::enable_mfa(const std::string &device_id, const std::vector<AuthMethod> &methods)
@@ -778,13 +754,12 @@ namespace cardano_iot
 
         bool Authentication::verify_certificate_chain(const std::string &certificate_pem)
         {
-            // Mock certificate verification
-            bool valid = certificate_pem.find("-----BEGIN CERTIFICATE-----") != std::string::npos;
+            // Shares parsed certificates and verified issuers with attestation sweeps
+            const auto chain = CertificateChainCache::shared().verify(certificate_pem);
 
-            std::string result = valid ? "valid" : "invalid";
-            utils::Logger::instance().log(utils::LogLevel::INFO, "Authentication",
-                                          "Certificate chain verification: " + result);
-            return valid;
+            CARDANO_IOT_LOG(utils::LogLevel::INFO, "Authentication",
+                            "Certificate chain verification: " << (chain.valid ? "valid" : "invalid: " + chain.error));
+            return chain.valid;
         }
 
         bool Authentication::revoke_certificate(const std::string &device_id)
@@ -853,14 +828,35 @@ namespace cardano_iot
 
         Authentication::AuthStats Authentication::get_statistics() const
         {
-            std::lock_guard<std::mutex> lock(pimpl_->stats_mutex_);
-            return pimpl_->stats_;
+            AuthStats stats = {};
+            for (size_t i = 0; i < pimpl_->succeeded_.size(); ++i)
+            {
+                const uint64_t succeeded = pimpl_->succeeded_[i].value();
+                const uint64_t failed = pimpl_->failed_[i].value();
+                stats.successful_authentications += succeeded;
+                stats.failed_authentications += failed;
+                if (succeeded + failed > 0)
+                {
+                    stats.method_usage[static_cast<AuthMethod>(i)] = succeeded + failed;
+                }
+            }
+            stats.total_attempts = stats.successful_authentications + stats.failed_authentications;
+            stats.locked_devices = pimpl_->locked_devices_.value();
+            stats.active_sessions = static_cast<uint64_t>(pimpl_->active_sessions_.value());
+            stats.issued_tokens = pimpl_->issued_tokens_.value();
+            stats.revoked_tokens = pimpl_->revoked_tokens_.value();
+            return stats;
         }
 
         void Authentication::reset_statistics()
         {
-            std::lock_guard<std::mutex> lock(pimpl_->stats_mutex_);
-            pimpl_->stats_ = {};
+            pimpl_->succeeded_.reset();
+            pimpl_->failed_.reset();
+            for (auto *counter : {&pimpl_->locked_devices_, &pimpl_->issued_tokens_, &pimpl_->revoked_tokens_})
+            {
+                counter->reset();
+            }
+            pimpl_->active_sessions_.set(0);
 
             utils::Logger::instance().log(utils::LogLevel::INFO, "Authentication",
                                           "Statistics reset");
@@ -0,0 +1,394 @@
+#include "cardano_iot/security/certificate_chain.h"
+#include "cardano_iot/utils/hash.h"
+
+#include <openssl/bio.h>
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/x509.h>
+#include <openssl/x509v3.h>
+
+#include <algorithm>
+#include <ctime>
+#include <iterator>
+#include <limits>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+
+namespace cardano_iot
+{
+    namespace security
+    {
+        namespace
+        {
+            constexpr std::string_view PEM_BEGIN = "-----BEGIN CERTIFICATE-----";
+            constexpr std::string_view PEM_END = "-----END CERTIFICATE-----";
+
+            uint64_t now_seconds()
+            {
+                return static_cast<uint64_t>(std::time(nullptr));
+            }
+
+            // Certificate blocks of a PEM bundle, in order; a truncated block is kept so parsing rejects it
+            std::vector<std::string_view> split_pem(std::string_view bundle)
+            {
+                std::vector<std::string_view> blocks;
+                size_t pos = 0;
+                while ((pos = bundle.find(PEM_BEGIN, pos)) != std::string_view::npos)
+                {
+                    size_t end = bundle.find(PEM_END, pos);
+                    if (end == std::string_view::npos)
+                    {
+                        blocks.push_back(bundle.substr(pos));
+                        break;
+                    }
+                    end += PEM_END.size();
+                    blocks.push_back(bundle.substr(pos, end - pos));
+                    pos = end;
+                }
+                return blocks;
+            }
+
+            // Raw SHA-256, used as a cache key
+            std::string fingerprint(std::string_view text)
+            {
+                const auto digest = utils::Hasher::digest(utils::HashAlgorithm::SHA256, text.data(), text.size());
+                return std::string(digest.begin(), digest.end());
+            }
+
+            uint64_t asn1_seconds(const ASN1_TIME *time)
+            {
+                std::tm tm{};
+                if (!time || ASN1_TIME_to_tm(time, &tm) != 1)
+                {
+                    return 0;
+                }
+                const time_t seconds = timegm(&tm);
+                return seconds < 0 ? 0 : static_cast<uint64_t>(seconds);
+            }
+        } // namespace
+
+        class CertificateChainCache::Impl
+        {
+        public:
+            struct Certificate
+            {
+                std::shared_ptr<X509> x509;
+                std::string fingerprint;
+                std::string subject;
+                uint64_t not_before = 0;
+                uint64_t not_after = 0;
+                bool is_ca = false;
+            };
+            using CertificatePtr = std::shared_ptr<const Certificate>;
+
+            struct Chain
+            {
+                ChainVerification result;
+                std::shared_ptr<EVP_PKEY> leaf_key;
+                uint64_t expires_at = 0;
+            };
+            using ChainPtr = std::shared_ptr<const Chain>;
+
+            explicit Impl(const Options &options) : options_(options) {}
+
+            Options options_;
+            mutable std::mutex mutex_;
+            std::unordered_map<std::string, CertificatePtr> certificates_; // by fingerprint of the PEM block
+            std::unordered_map<std::string, uint64_t> signatures_;        // subject + issuer fingerprint -> expiry
+            std::unordered_map<std::string, ChainPtr> chains_;            // chain + roots fingerprint
+            std::vector<std::string> default_roots_;
+            Stats stats_;
+
+            // Called with mutex_ held: drop expired entries, then arbitrary ones while still full
+            template <typename Map, typename Expiry>
+            void make_room(Map &map, Expiry expiry, uint64_t now)
+            {
+                if (map.size() < options_.max_entries)
+                {
+                    return;
+                }
+                for (auto it = map.begin(); it != map.end();)
+                {
+                    it = expiry(it->second) <= now ? map.erase(it) : std::next(it);
+                }
+                while (!map.empty() && map.size() >= options_.max_entries)
+                {
+                    map.erase(map.begin());
+                }
+            }
+
+            CertificatePtr certificate(std::string_view block, uint64_t now)
+            {
+                std::string key = fingerprint(block);
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    auto it = certificates_.find(key);
+                    if (it != certificates_.end())
+                    {
+                        return it->second;
+                    }
+                }
+
+                BIO *bio = BIO_new_mem_buf(block.data(), static_cast<int>(block.size()));
+                X509 *raw = bio ? PEM_read_bio_X509(bio, nullptr, nullptr, nullptr) : nullptr;
+                BIO_free(bio);
+                if (!raw)
+                {
+                    return nullptr;
+                }
+
+                auto cert = std::make_shared<Certificate>();
+                cert->x509.reset(raw, X509_free);
+                cert->fingerprint = key;
+                char name[256];
+                X509_NAME_oneline(X509_get_subject_name(raw), name, sizeof(name));
+                cert->subject = name;
+                cert->not_before = asn1_seconds(X509_get0_notBefore(raw));
+                cert->not_after = asn1_seconds(X509_get0_notAfter(raw));
+                cert->is_ca = X509_check_ca(raw) > 0;
+
+                std::lock_guard<std::mutex> lock(mutex_);
+                ++stats_.certificates_parsed;
+                make_room(certificates_, [](const CertificatePtr &entry)
+                          { return entry->not_after; },
+                          now);
+                return certificates_.emplace(std::move(key), std::move(cert)).first->second;
+            }
+
+            // Whether issuer signed subject; a certificate passed as its own issuer must be self-signed
+            bool issued_by(const Certificate &subject, const Certificate &issuer, uint64_t now)
+            {
+                std::string key = subject.fingerprint + issuer.fingerprint;
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    auto it = signatures_.find(key);
+                    if (it != signatures_.end() && it->second > now)
+                    {
+                        ++stats_.signature_hits;
+                        return true;
+                    }
+                }
+
+                const bool self = subject.fingerprint == issuer.fingerprint;
+                bool signed_by = (self || issuer.is_ca) &&
+                                 X509_check_issued(issuer.x509.get(), subject.x509.get()) == X509_V_OK;
+                if (signed_by)
+                {
+                    EVP_PKEY *issuer_key = X509_get0_pubkey(issuer.x509.get());
+                    signed_by = issuer_key && X509_verify(subject.x509.get(), issuer_key) == 1;
+                }
+
+                std::lock_guard<std::mutex> lock(mutex_);
+                ++stats_.signatures_checked;
+                if (signed_by)
+                {
+                    make_room(signatures_, [](uint64_t expires_at)
+                              { return expires_at; },
+                              now);
+                    signatures_[std::move(key)] = std::min(subject.not_after, issuer.not_after);
+                }
+                return signed_by;
+            }
+
+            ChainPtr build(const std::string &chain_pem, const std::vector<std::string> &roots, uint64_t now)
+            {
+                auto chain = std::make_shared<Chain>();
+                chain->expires_at = now + options_.failure_ttl_seconds;
+                auto fail = [&chain](std::string error)
+                {
+                    chain->result.error = std::move(error);
+                    return chain;
+                };
+
+                const auto blocks = split_pem(chain_pem);
+                if (blocks.empty())
+                {
+                    return fail("No certificate in chain");
+                }
+
+                std::vector<CertificatePtr> certs;
+                certs.reserve(blocks.size());
+                uint64_t not_after = std::numeric_limits<uint64_t>::max();
+                for (const auto block : blocks)
+                {
+                    auto cert = certificate(block, now);
+                    if (!cert)
+                    {
+                        return fail("Unparseable certificate");
+                    }
+                    if (now < cert->not_before || now >= cert->not_after)
+                    {
+                        return fail("Certificate outside its validity period: " + cert->subject);
+                    }
+                    not_after = std::min(not_after, cert->not_after);
+                    certs.push_back(std::move(cert));
+                }
+
+                for (size_t i = 0; i + 1 < certs.size(); ++i)
+                {
+                    if (!issued_by(*certs[i], *certs[i + 1], now))
+                    {
+                        return fail("Certificate not signed by its issuer: " + certs[i]->subject);
+                    }
+                }
+
+                const Certificate &top = *certs.back();
+                if (roots.empty())
+                {
+                    if (!issued_by(top, top, now))
+                    {
+                        return fail("Chain does not end in a self-signed root");
+                    }
+                }
+                else
+                {
+                    bool anchored = false;
+                    for (const auto &root_pem : roots)
+                    {
+                        const auto root_blocks = split_pem(root_pem);
+                        auto root = root_blocks.empty() ? nullptr : certificate(root_blocks.front(), now);
+                        if (!root || now < root->not_before || now >= root->not_after)
+                        {
+                            continue;
+                        }
+                        if (root->fingerprint == top.fingerprint || issued_by(top, *root, now))
+                        {
+                            not_after = std::min(not_after, root->not_after);
+                            anchored = true;
+                            break;
+                        }
+                    }
+                    if (!anchored)
+                    {
+                        return fail("Chain does not lead to a trusted root");
+                    }
+                }
+
+                chain->result.valid = true;
+                chain->result.subject = certs.front()->subject;
+                chain->result.not_after = not_after;
+                chain->leaf_key.reset(X509_get_pubkey(certs.front()->x509.get()), EVP_PKEY_free);
+                chain->expires_at = std::min(not_after, now + options_.ttl_seconds);
+                return chain;
+            }
+
+            ChainPtr verify_chain(const std::string &chain_pem, const std::vector<std::string> &trusted_roots,
+                                  bool &cached)
+            {
+                const uint64_t now = now_seconds();
+                std::vector<std::string> configured;
+                if (trusted_roots.empty())
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    configured = default_roots_;
+                }
+                const auto &roots = trusted_roots.empty() ? configured : trusted_roots;
+
+                std::string roots_key;
+                for (const auto &root : roots)
+                {
+                    roots_key += fingerprint(root);
+                }
+                std::string key = fingerprint(chain_pem) + fingerprint(roots_key);
+
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    auto it = chains_.find(key);
+                    if (it != chains_.end() && it->second->expires_at > now)
+                    {
+                        ++stats_.chain_hits;
+                        cached = true;
+                        return it->second;
+                    }
+                }
+
+                auto chain = build(chain_pem, roots, now);
+
+                std::lock_guard<std::mutex> lock(mutex_);
+                ++stats_.chain_misses;
+                make_room(chains_, [](const ChainPtr &entry)
+                          { return entry->expires_at; },
+                          now);
+                chains_[std::move(key)] = chain;
+                cached = false;
+                return chain;
+            }
+        };
+
+        CertificateChainCache::CertificateChainCache() : CertificateChainCache(Options()) {}
+
+        CertificateChainCache::CertificateChainCache(const Options &options)
+            : pimpl_(std::make_unique<Impl>(options)) {}
+
+        CertificateChainCache::~CertificateChainCache() = default;
+
+        CertificateChainCache &CertificateChainCache::shared()
+        {
+            static CertificateChainCache cache;
+            return cache;
+        }
+
+        void CertificateChainCache::set_trusted_roots(const std::vector<std::string> &roots_pem)
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+            pimpl_->default_roots_ = roots_pem;
+        }
+
+        ChainVerification CertificateChainCache::verify(const std::string &chain_pem,
+                                                        const std::vector<std::string> &trusted_roots)
+        {
+            bool cached = false;
+            ChainVerification result = pimpl_->verify_chain(chain_pem, trusted_roots, cached)->result;
+            result.cached = cached;
+            return result;
+        }
+
+        bool CertificateChainCache::verify_signature(const std::string &chain_pem,
+                                                     const std::vector<std::string> &trusted_roots,
+                                                     const std::string &message, const std::vector<uint8_t> &signature,
+                                                     ChainVerification *chain)
+        {
+            bool cached = false;
+            auto verified = pimpl_->verify_chain(chain_pem, trusted_roots, cached);
+            if (chain)
+            {
+                *chain = verified->result;
+                chain->cached = cached;
+            }
+            if (!verified->result.valid || !verified->leaf_key || signature.empty())
+            {
+                return false;
+            }
+
+            EVP_PKEY *key = verified->leaf_key.get();
+            const int type = EVP_PKEY_id(key);
+            const EVP_MD *digest = type == EVP_PKEY_ED25519 || type == EVP_PKEY_ED448 ? nullptr : EVP_sha256();
+
+            EVP_MD_CTX *ctx = EVP_MD_CTX_new();
+            const bool valid = ctx &&
+                               EVP_DigestVerifyInit(ctx, nullptr, digest, nullptr, key) == 1 &&
+                               EVP_DigestVerify(ctx, signature.data(), signature.size(),
+                                                reinterpret_cast<const unsigned char *>(message.data()),
+                                                message.size()) == 1;
+            EVP_MD_CTX_free(ctx);
+            return valid;
+        }
+
+        CertificateChainCache::Stats CertificateChainCache::stats() const
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+            return pimpl_->stats_;
+        }
+
+        void CertificateChainCache::clear()
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+            pimpl_->certificates_.clear();
+            pimpl_->signatures_.clear();
+            pimpl_->chains_.clear();
+            pimpl_->stats_ = Stats();
+        }
+
+    } // namespace security
+} // namespace cardano_iot
@@ -1,5 +1,9 @@
 #include "cardano_iot/security/encryption.h"
+#include "cardano_iot/security/file_cipher.h"
 #include "cardano_iot/utils/logger.h"
+#include "cardano_iot/utils/metrics.h"
+#include "cardano_iot/utils/codec.h"
+#include "cardano_iot/performance/performance_optimizer.h"
 
 #include <chrono>
 #include <sstream>
@@ -22,11 +26,74 @@ namespace cardano_iot
 {
     namespace security
     {
+        namespace
+        {
+            constexpr size_t BATCH_NONCE_BYTES = 12;
+            constexpr size_t BATCH_TAG_BYTES = 16;
+
+            // Cipher context kept per thread, so batches neither allocate nor share one
+            EVP_CIPHER_CTX *thread_cipher_context()
+            {
+                struct Holder
+                {
+                    EVP_CIPHER_CTX *ctx = EVP_CIPHER_CTX_new();
+                    ~Holder() { EVP_CIPHER_CTX_free(ctx); }
+                };
+                thread_local Holder holder;
+                return holder.ctx;
+            }
+
+            const EVP_CIPHER *batch_cipher(EncryptionAlgorithm algorithm)
+            {
+                return algorithm == EncryptionAlgorithm::CHACHA20_POLY1305 || algorithm == EncryptionAlgorithm::XCHACHA20_POLY1305
+                           ? EVP_chacha20_poly1305()
+                           : EVP_aes_256_gcm();
+            }
+
+            // Key schedule once per batch; each record then only sets its nonce
+            bool batch_begin(EVP_CIPHER_CTX *ctx, const EncryptionKey &key, bool encrypt)
+            {
+                const int enc = encrypt ? 1 : 0;
+                return ctx && key.key_data.size() == 32 &&
+                       EVP_CipherInit_ex(ctx, batch_cipher(key.algorithm), nullptr, nullptr, nullptr, enc) == 1 &&
+                       EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_SET_IVLEN, static_cast<int>(BATCH_NONCE_BYTES), nullptr) == 1 &&
+                       EVP_CipherInit_ex(ctx, nullptr, nullptr, key.key_data.data(), nullptr, enc) == 1;
+            }
+
+            // in and out may be the same buffer
+            bool batch_record(EVP_CIPHER_CTX *ctx, bool encrypt, const uint8_t *nonce, const uint8_t *in, size_t size,
+                              uint8_t *out, uint8_t *tag)
+            {
+                int len = 0;
+                if (size > static_cast<size_t>(INT32_MAX) ||
+                    EVP_CipherInit_ex(ctx, nullptr, nullptr, nullptr, nonce, encrypt ? 1 : 0) != 1 ||
+                    (size > 0 && EVP_CipherUpdate(ctx, out, &len, in, static_cast<int>(size)) != 1))
+                {
+                    return false;
+                }
+                if (!encrypt && EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_SET_TAG, static_cast<int>(BATCH_TAG_BYTES), tag) != 1)
+                {
+                    return false;
+                }
+                if (EVP_CipherFinal_ex(ctx, out + size, &len) != 1)
+                {
+                    return false;
+                }
+                return !encrypt || EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_GET_TAG, static_cast<int>(BATCH_TAG_BYTES), tag) == 1;
+            }
+
+            // One RAND_bytes call for all nonces of a batch
+            bool batch_nonces(std::vector<uint8_t> &nonces, size_t count)
+            {
+                nonces.resize(count * BATCH_NONCE_BYTES);
+                return count == 0 || RAND_bytes(nonces.data(), static_cast<int>(nonces.size())) == 1;
+            }
+        } // namespace
+
         struct Encryption::Impl
         {
             bool initialized_ = false;
             mutable std::mutex encryption_mutex_;
-            mutable std::mutex stats_mutex_;
 
             // Key storage
             std::map<std::string, std::shared_ptr<EncryptionKey>> keys_;
@@ -37,8 +104,20 @@ namespace cardano_iot
             // Configuration
             EncryptionConfig config_;
 
-            // Statistics
-            EncryptionStats stats_ = {};
+            // Statistics: per-core metrics; batch records count as operations but carry no timing
+            utils::metrics::Counter keys_generated_{"cardano_iot_encryption_keys_generated_total", "Keys generated"};
+            utils::metrics::Counter keys_stored_{"cardano_iot_encryption_keys_stored_total", "Keys generated or imported into the store"};
+            utils::metrics::Counter keys_deleted_{"cardano_iot_encryption_keys_deleted_total", "Keys removed from the store"};
+            utils::metrics::Counter encryptions_{"cardano_iot_encryption_operations_total", "Encryption operations by direction", {{"op", "encrypt"}}};
+            utils::metrics::Counter decryptions_{"cardano_iot_encryption_operations_total", "Encryption operations by direction", {{"op", "decrypt"}}};
+            utils::metrics::Counter bytes_encrypted_{"cardano_iot_encryption_bytes_total", "Plaintext bytes processed by direction", {{"op", "encrypt"}}};
+            utils::metrics::Counter bytes_decrypted_{"cardano_iot_encryption_bytes_total", "Plaintext bytes processed by direction", {{"op", "decrypt"}}};
+            utils::metrics::Counter stream_sessions_{"cardano_iot_encryption_stream_sessions_total", "Stream encryption sessions started"};
+            utils::metrics::Counter key_exchanges_{"cardano_iot_encryption_key_exchanges_total", "Key exchanges performed"};
+            utils::metrics::Histogram encrypt_ms_{"cardano_iot_encryption_duration_ms", "Encryption time in milliseconds by direction",
+                                                  utils::metrics::Histogram::latency_ms_bounds(), {{"op", "encrypt"}}};
+            utils::metrics::Histogram decrypt_ms_{"cardano_iot_encryption_duration_ms", "Encryption time in milliseconds by direction",
+                                                  utils::metrics::Histogram::latency_ms_bounds(), {{"op", "decrypt"}}};
 
             // Generate unique key ID
             std::string generate_key_id() const
@@ -70,107 +149,25 @@ namespace cardano_iot
                 return buffer;
             }
 
-            // Convert bytes to hex string
+            // Hex/base64 helpers backed by the shared codec module
             std::string bytes_to_hex(const std::vector<uint8_t> &bytes) const
             {
-                std::stringstream ss;
-                ss << std::hex << std::setfill('0');
-                for (uint8_t byte : bytes)
-                {
-                    ss << std::setw(2) << static_cast<int>(byte);
-                }
-                return ss.str();
+                return utils::codec::hex_encode(bytes);
             }
 
-            // Convert hex string to bytes
             std::vector<uint8_t> hex_to_bytes(const std::string &hex) const
             {
-                std::vector<uint8_t> bytes;
-                for (size_t i = 0; i < hex.length(); i += 2)
-                {
-                    std::string byteString = hex.substr(i, 2);
-                    uint8_t byte = static_cast<uint8_t>(strtol(byteString.c_str(), nullptr, 16));
-                    bytes.push_back(byte);
-                }
-                return bytes;
+                return utils::codec::hex_decode(hex);
             }
 
-            // Base64 encoding/decoding using a correct implementation (no newlines)
             std::string base64_encode(const std::vector<uint8_t> &data) const
             {
-                static const char *tbl = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-                std::string out;
-                out.reserve(((data.size() + 2) / 3) * 4);
-
-                size_t i = 0;
-                while (i + 3 <= data.size())
-                {
-                    uint32_t n = (static_cast<uint32_t>(data[i]) << 16) |
-                                 (static_cast<uint32_t>(data[i + 1]) << 8) |
-                                 (static_cast<uint32_t>(data[i + 2]));
-                    out.push_back(tbl[(n >> 18) & 0x3F]);
-                    out.push_back(tbl[(n >> 12) & 0x3F]);
-                    out.push_back(tbl[(n >> 6) & 0x3F]);
-                    out.push_back(tbl[n & 0x3F]);
-                    i += 3;
-                }
-                if (i + 1 == data.size())
-                {
-                    uint32_t n = (static_cast<uint32_t>(data[i]) << 16);
-                    out.push_back(tbl[(n >> 18) & 0x3F]);
-                    out.push_back(tbl[(n >> 12) & 0x3F]);
-                    out.push_back('=');
-                    out.push_back('=');
-                }
-                else if (i + 2 == data.size())
-                {
-                    uint32_t n = (static_cast<uint32_t>(data[i]) << 16) |
-                                 (static_cast<uint32_t>(data[i + 1]) << 8);
-                    out.push_back(tbl[(n >> 18) & 0x3F]);
-                    out.push_back(tbl[(n >> 12) & 0x3F]);
-                    out.push_back(tbl[(n >> 6) & 0x3F]);
-                    out.push_back('=');
-                }
-                return out;
+                return utils::codec::base64_encode(data);
             }
 
             std::vector<uint8_t> base64_decode(const std::string &encoded) const
             {
-                auto decode_val = [](char c) -> int
-                {
-                    if (c >= 'A' && c <= 'Z')
-                        return c - 'A';
-                    if (c >= 'a' && c <= 'z')
-                        return c - 'a' + 26;
-                    if (c >= '0' && c <= '9')
-                        return c - '0' + 52;
-                    if (c == '+')
-                        return 62;
-                    if (c == '/')
-                        return 63;
-                    if (c == '=')
-                        return -1; // padding
-                    return -2;     // invalid
-                };
-
-                std::vector<uint8_t> out;
-                int val = 0, valb = -8;
-                for (char c : encoded)
-                {
-                    int d = decode_val(c);
-                    if (d == -2)
-                        continue; // skip invalid/whitespace
-                    if (d == -1)
-                        break; // stop at padding
-                    val = (val << 6) + d;
-                    valb += 6;
-                    if (valb >= 0)
-                    {
-                        out.push_back(static_cast<char>((val >> valb) & 0xFF));
-                        valb -= 8;
-                    }
-                }
-                return out;
+                return utils::codec::base64_decode(encoded);
             }
 
             // AES-256-GCM encryption using OpenSSL EVP
@@ -348,19 +345,24 @@ namespace cardano_iot
             }
 
             // Update timing statistics
+            FileCipher::Options file_cipher_options() const
+            {
+                FileCipher::Options options;
+                options.segment_bytes = config_.file_segment_bytes;
+                options.threads = config_.file_encryption_threads;
+                return options;
+            }
+
+            void update_batch_stats(bool encryption, size_t records, uint64_t bytes)
+            {
+                (encryption ? encryptions_ : decryptions_).inc(records);
+                (encryption ? bytes_encrypted_ : bytes_decrypted_).inc(bytes);
+            }
+
             void update_timing_stats(bool encryption, double time_ms)
             {
-                std::lock_guard<std::mutex> lock(stats_mutex_);
-                if (encryption)
-                {
-                    stats_.encryptions_performed++;
-                    stats_.avg_encryption_time_ms = (stats_.avg_encryption_time_ms + time_ms) / 2.0;
-                }
-                else
-                {
-                    stats_.decryptions_performed++;
-                    stats_.avg_decryption_time_ms = (stats_.avg_decryption_time_ms + time_ms) / 2.0;
-                }
+                (encryption ? encryptions_ : decryptions_).inc();
+                (encryption ? encrypt_ms_ : decrypt_ms_).observe(time_ms);
             }
         };
 
@@ -446,11 +448,8 @@ namespace cardano_iot
             }
 
             // Update statistics
-            {
-                std::lock_guard<std::mutex> stats_lock(pimpl_->stats_mutex_);
-                pimpl_->stats_.keys_generated++;
-                pimpl_->stats_.keys_stored++;
-            }
+            pimpl_->keys_generated_.inc();
+            pimpl_->keys_stored_.inc();
 
             utils::Logger::instance().log(utils::LogLevel::INFO, "Encryption",
                                           "Generated encryption key: " + key->key_id);
@@ -471,10 +470,7 @@ namespace cardano_iot
             pimpl_->keys_[key.key_id] = shared_key;
 
             // Update statistics
-            {
-                std::lock_guard<std::mutex> stats_lock(pimpl_->stats_mutex_);
-                pimpl_->stats_.keys_stored++;
-            }
+            pimpl_->keys_stored_.inc();
 
             utils::Logger::instance().log(utils::LogLevel::INFO, "Encryption",
                                           "Stored encryption key: " + key.key_id);
@@ -516,10 +512,7 @@ namespace cardano_iot
                 pimpl_->keys_.erase(it);
 
                 // Update statistics
-                {
-                    std::lock_guard<std::mutex> stats_lock(pimpl_->stats_mutex_);
-                    pimpl_->stats_.keys_deleted++;
-                }
+                pimpl_->keys_deleted_.inc();
 
                 utils::Logger::instance().log(utils::LogLevel::INFO, "Encryption",
                                               "Deleted encryption key: " + key_id);
@@ -586,6 +579,7 @@ namespace cardano_iot
 
         EncryptedData Encryption::encrypt(const std::vector<uint8_t> &plaintext, const std::string &key_id)
         {
+            PROFILE_SCOPE("Encryption::encrypt");
             if (!pimpl_->initialized_)
             {
                 return {};
@@ -626,14 +620,11 @@ namespace cardano_iot
             }
 
             auto end_time = std::chrono::high_resolution_clock::now();
-            auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
+            auto duration = std::chrono::duration<double, std::milli>(end_time - start_time).count();
             pimpl_->update_timing_stats(true, duration);
 
             // Update statistics
-            {
-                std::lock_guard<std::mutex> stats_lock(pimpl_->stats_mutex_);
-                pimpl_->stats_.bytes_encrypted += plaintext.size();
-            }
+            pimpl_->bytes_encrypted_.inc(plaintext.size());
 
             utils::Logger::instance().log(utils::LogLevel::INFO, "Encryption",
                                           "Encrypted " + std::to_string(plaintext.size()) + " bytes with key: " + key_id);
@@ -678,14 +669,11 @@ namespace cardano_iot
             }
 
             auto end_time = std::chrono::high_resolution_clock::now();
-            auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
+            auto duration = std::chrono::duration<double, std::milli>(end_time - start_time).count();
             pimpl_->update_timing_stats(false, duration);
 
             // Update statistics
-            {
-                std::lock_guard<std::mutex> stats_lock(pimpl_->stats_mutex_);
-                pimpl_->stats_.bytes_decrypted += result.size();
-            }
+            pimpl_->bytes_decrypted_.inc(result.size());
 
             utils::Logger::instance().log(utils::LogLevel::INFO, "Encryption",
                                           "Decrypted " + std::to_string(result.size()) + " bytes with key: " + encrypted_data.key_id);
@@ -744,6 +732,154 @@ namespace cardano_iot
             return result;
         }
 
+        size_t Encryption::encrypt_batch(AeadRecord *records, size_t count, const std::string &key_id)
+        {
+            auto key = pimpl_->initialized_ ? get_key(key_id) : nullptr;
+            EVP_CIPHER_CTX *ctx = thread_cipher_context();
+            thread_local std::vector<uint8_t> nonces;
+            if (!key || !batch_begin(ctx, *key, true) || !batch_nonces(nonces, count))
+            {
+                return 0;
+            }
+
+            size_t sealed = 0;
+            uint64_t bytes = 0;
+            for (size_t i = 0; i < count; ++i)
+            {
+                AeadRecord &record = records[i];
+                std::memcpy(record.nonce, nonces.data() + i * BATCH_NONCE_BYTES, BATCH_NONCE_BYTES);
+                record.ok = batch_record(ctx, true, record.nonce, record.data, record.size, record.data, record.tag);
+                sealed += record.ok;
+                bytes += record.ok ? record.size : 0;
+            }
+            pimpl_->update_batch_stats(true, sealed, bytes);
+
+            CARDANO_IOT_LOG(utils::LogLevel::DEBUG, "Encryption",
+                            "Batch encrypted " << sealed << "/" << count << " records with key: " << key_id);
+            return sealed;
+        }
+
+        size_t Encryption::decrypt_batch(AeadRecord *records, size_t count, const std::string &key_id)
+        {
+            auto key = pimpl_->initialized_ ? get_key(key_id) : nullptr;
+            EVP_CIPHER_CTX *ctx = thread_cipher_context();
+            if (!key || !batch_begin(ctx, *key, false))
+            {
+                return 0;
+            }
+
+            size_t opened = 0;
+            uint64_t bytes = 0;
+            for (size_t i = 0; i < count; ++i)
+            {
+                AeadRecord &record = records[i];
+                record.ok = batch_record(ctx, false, record.nonce, record.data, record.size, record.data, record.tag);
+                if (!record.ok && record.data)
+                {
+                    secure_zero_memory(record.data, record.size); // never hand out unauthenticated plaintext
+                }
+                opened += record.ok;
+                bytes += record.ok ? record.size : 0;
+            }
+            pimpl_->update_batch_stats(false, opened, bytes);
+            return opened;
+        }
+
+        EncryptedBatch Encryption::encrypt_batch(const std::vector<std::vector<uint8_t>> &plaintexts, const std::string &key_id)
+        {
+            EncryptedBatch batch;
+            batch.key_id = key_id;
+            auto key = pimpl_->initialized_ ? get_key(key_id) : nullptr;
+            EVP_CIPHER_CTX *ctx = thread_cipher_context();
+            if (!key || !batch_begin(ctx, *key, true))
+            {
+                return batch;
+            }
+            batch.algorithm = key->algorithm;
+
+            size_t total = 0;
+            for (const auto &plaintext : plaintexts)
+            {
+                total += BATCH_NONCE_BYTES + plaintext.size() + BATCH_TAG_BYTES;
+            }
+            thread_local std::vector<uint8_t> nonces;
+            if (!batch_nonces(nonces, plaintexts.size()))
+            {
+                return batch;
+            }
+            batch.arena.resize(total);
+            batch.offsets.reserve(plaintexts.size());
+            batch.sizes.reserve(plaintexts.size());
+
+            size_t offset = 0;
+            for (const auto &plaintext : plaintexts)
+            {
+                batch.offsets.push_back(offset);
+                batch.sizes.push_back(plaintext.size());
+                offset += BATCH_NONCE_BYTES + plaintext.size() + BATCH_TAG_BYTES;
+            }
+            uint64_t bytes = 0;
+            for (size_t i = 0; i < plaintexts.size(); ++i)
+            {
+                uint8_t *slot = batch.arena.data() + batch.offsets[i];
+                const size_t size = plaintexts[i].size();
+                std::memcpy(slot, nonces.data() + i * BATCH_NONCE_BYTES, BATCH_NONCE_BYTES);
+                if (!batch_record(ctx, true, slot, plaintexts[i].data(), size, slot + BATCH_NONCE_BYTES,
+                                  slot + BATCH_NONCE_BYTES + size))
+                {
+                    return EncryptedBatch{batch.algorithm, key_id, {}, {}, {}};
+                }
+                bytes += size;
+            }
+            pimpl_->update_batch_stats(true, plaintexts.size(), bytes);
+            return batch;
+        }
+
+        size_t Encryption::decrypt_batch(const EncryptedBatch &batch, std::vector<uint8_t> &plaintext_arena)
+        {
+            plaintext_arena.clear();
+            auto key = pimpl_->initialized_ ? get_key(batch.key_id) : nullptr;
+            EVP_CIPHER_CTX *ctx = thread_cipher_context();
+            if (!key || batch.offsets.size() != batch.sizes.size() || !batch_begin(ctx, *key, false))
+            {
+                return 0;
+            }
+
+            size_t total = 0;
+            for (size_t i = 0; i < batch.sizes.size(); ++i)
+            {
+                if (batch.offsets[i] > batch.arena.size() ||
+                    batch.arena.size() - batch.offsets[i] < BATCH_NONCE_BYTES + batch.sizes[i] + BATCH_TAG_BYTES)
+                {
+                    return 0;
+                }
+                total += batch.sizes[i];
+            }
+            plaintext_arena.resize(total);
+
+            size_t opened = 0;
+            size_t out = 0;
+            for (size_t i = 0; i < batch.sizes.size(); ++i)
+            {
+                const uint8_t *slot = batch.arena.data() + batch.offsets[i];
+                const size_t size = batch.sizes[i];
+                // The tag is only read, but EVP's ctrl interface takes it non-const
+                uint8_t tag[BATCH_TAG_BYTES];
+                std::memcpy(tag, slot + BATCH_NONCE_BYTES + size, BATCH_TAG_BYTES);
+                if (batch_record(ctx, false, slot, slot + BATCH_NONCE_BYTES, size, plaintext_arena.data() + out, tag))
+                {
+                    ++opened;
+                }
+                else
+                {
+                    secure_zero_memory(plaintext_arena.data() + out, size);
+                }
+                out += size;
+            }
+            pimpl_->update_batch_stats(false, opened, total);
+            return opened;
+        }
+
         bool Encryption::start_stream_encryption(const std::string &stream_id, const std::string &key_id)
         {
             if (!pimpl_->initialized_)
@@ -761,10 +897,7 @@ namespace cardano_iot
             pimpl_->active_streams_[stream_id] = key_id;
 
             // Update statistics
-            {
-                std::lock_guard<std::mutex> stats_lock(pimpl_->stats_mutex_);
-                pimpl_->stats_.stream_sessions++;
-            }
+            pimpl_->stream_sessions_.inc();
 
             utils::Logger::instance().log(utils::LogLevel::INFO, "Encryption",
                                           "Started stream encryption: " + stream_id);
@@ -831,30 +964,24 @@ namespace cardano_iot
                 return false;
             }
 
-            std::ifstream input(input_path, std::ios::binary);
-            if (!input)
-            {
-                return false;
-            }
-
-            std::vector<uint8_t> file_data((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
-            input.close();
-
-            auto encrypted = encrypt(file_data, key_id);
-            if (encrypted.ciphertext.empty())
+            auto key = get_key(key_id);
+            if (!key)
             {
+                utils::Logger::instance().log(utils::LogLevel::ERROR, "Encryption",
+                                              "Key not found: " + key_id);
                 return false;
             }
 
-            std::ofstream output(output_path, std::ios::binary);
-            if (!output)
+            auto start_time = std::chrono::high_resolution_clock::now();
+            if (!FileCipher::encrypt(input_path, output_path, *key, pimpl_->file_cipher_options()))
             {
                 return false;
             }
-
-            // Write encrypted data (simplified format)
-            output.write(reinterpret_cast<const char *>(encrypted.ciphertext.data()), encrypted.ciphertext.size());
-            output.close();
+            auto duration = std::chrono::duration<double, std::milli>(
+                                std::chrono::high_resolution_clock::now() - start_time)
+                                .count();
+            pimpl_->update_timing_stats(true, duration);
+            pimpl_->bytes_encrypted_.inc(FileCipher::read_plaintext_size(output_path));
 
             utils::Logger::instance().log(utils::LogLevel::INFO, "Encryption",
                                           "Encrypted file: " + input_path + " -> " + output_path);
@@ -868,35 +995,32 @@ namespace cardano_iot
                 return false;
             }
 
-            std::ifstream input(input_path, std::ios::binary);
-            if (!input)
+            // The header names the key; an explicit key_id must agree with it
+            const std::string sealed_with = FileCipher::read_key_id(input_path);
+            if (sealed_with.empty() || (!key_id.empty() && key_id != sealed_with))
             {
+                utils::Logger::instance().log(utils::LogLevel::ERROR, "Encryption",
+                                              "Encrypted file missing or sealed with another key: " + input_path);
                 return false;
             }
-
-            std::vector<uint8_t> encrypted_data((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
-            input.close();
-
-            // Create encrypted data structure (simplified)
-            EncryptedData enc_data;
-            enc_data.algorithm = EncryptionAlgorithm::AES_256_GCM;
-            enc_data.ciphertext = encrypted_data;
-            enc_data.key_id = key_id;
-
-            auto decrypted = decrypt(enc_data);
-            if (decrypted.empty())
+            auto key = get_key(sealed_with);
+            if (!key)
             {
+                utils::Logger::instance().log(utils::LogLevel::ERROR, "Encryption",
+                                              "Key not found: " + sealed_with);
                 return false;
             }
 
-            std::ofstream output(output_path, std::ios::binary);
-            if (!output)
+            auto start_time = std::chrono::high_resolution_clock::now();
+            if (!FileCipher::decrypt(input_path, output_path, *key, pimpl_->file_cipher_options()))
             {
                 return false;
             }
-
-            output.write(reinterpret_cast<const char *>(decrypted.data()), decrypted.size());
-            output.close();
+            auto duration = std::chrono::duration<double, std::milli>(
+                                std::chrono::high_resolution_clock::now() - start_time)
+                                .count();
+            pimpl_->update_timing_stats(false, duration);
+            pimpl_->bytes_decrypted_.inc(FileCipher::read_plaintext_size(input_path));
 
             utils::Logger::instance().log(utils::LogLevel::INFO, "Encryption",
                                           "Decrypted file: " + input_path + " -> " + output_path);
@@ -965,10 +1089,7 @@ namespace cardano_iot
             }
 
             // Update statistics
-            {
-                std::lock_guard<std::mutex> stats_lock(pimpl_->stats_mutex_);
-                pimpl_->stats_.key_exchanges++;
-            }
+            pimpl_->key_exchanges_.inc();
 
             return shared_secret;
         }
@@ -1028,14 +1149,35 @@ namespace cardano_iot
 
         Encryption::EncryptionStats Encryption::get_statistics() const
         {
-            std::lock_guard<std::mutex> lock(pimpl_->stats_mutex_);
-            return pimpl_->stats_;
+            EncryptionStats stats = {};
+            stats.keys_generated = pimpl_->keys_generated_.value();
+            stats.keys_stored = pimpl_->keys_stored_.value();
+            stats.keys_deleted = pimpl_->keys_deleted_.value();
+            stats.encryptions_performed = pimpl_->encryptions_.value();
+            stats.decryptions_performed = pimpl_->decryptions_.value();
+            stats.bytes_encrypted = pimpl_->bytes_encrypted_.value();
+            stats.bytes_decrypted = pimpl_->bytes_decrypted_.value();
+            stats.stream_sessions = pimpl_->stream_sessions_.value();
+            stats.key_exchanges = pimpl_->key_exchanges_.value();
+            const auto encrypt = pimpl_->encrypt_ms_.snapshot();
+            const auto decrypt = pimpl_->decrypt_ms_.snapshot();
+            stats.avg_encryption_time_ms = encrypt.mean();
+            stats.avg_decryption_time_ms = decrypt.mean();
+            stats.p95_encryption_time_ms = encrypt.quantile(0.95);
+            stats.p95_decryption_time_ms = decrypt.quantile(0.95);
+            return stats;
         }
 
         void Encryption::reset_statistics()
         {
-            std::lock_guard<std::mutex> lock(pimpl_->stats_mutex_);
-            pimpl_->stats_ = {};
+            for (auto *counter : {&pimpl_->keys_generated_, &pimpl_->keys_stored_, &pimpl_->keys_deleted_,
+                                  &pimpl_->encryptions_, &pimpl_->decryptions_, &pimpl_->bytes_encrypted_,
+                                  &pimpl_->bytes_decrypted_, &pimpl_->stream_sessions_, &pimpl_->key_exchanges_})
+            {
+                counter->reset();
+            }
+            pimpl_->encrypt_ms_.reset();
+            pimpl_->decrypt_ms_.reset();
 
             utils::Logger::instance().log(utils::LogLevel::INFO, "Encryption",
                                           "Statistics reset");
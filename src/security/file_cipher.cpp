@@ -0,0 +1,516 @@
+#include "cardano_iot/security/file_cipher.h"
+#include "cardano_iot/utils/logger.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/rand.h>
+
+namespace cardano_iot
+{
+    namespace security
+    {
+        namespace
+        {
+            constexpr char MAGIC[8] = {'C', 'I', 'O', 'T', 'A', 'E', 'A', 'D'};
+            constexpr uint8_t FORMAT_VERSION = 1;
+            constexpr size_t FIXED_HEADER_BYTES = 8 + 1 + 1 + 2 + 4 + 8 + FileCipher::SALT_BYTES +
+                                                  FileCipher::NONCE_PREFIX_BYTES + 2;
+            constexpr size_t KEY_BYTES = 32;
+            constexpr size_t NONCE_BYTES = 12;
+            constexpr size_t PAGE_BYTES = 4096;
+            constexpr char KDF_INFO[] = "cardano_iot file segments v1";
+
+            enum class Aead : uint8_t
+            {
+                AES_256_GCM = 0,
+                CHACHA20_POLY1305 = 1
+            };
+
+            struct Header
+            {
+                Aead aead = Aead::AES_256_GCM;
+                uint32_t segment_bytes = 0;
+                uint64_t plaintext_bytes = 0;
+                uint8_t salt[FileCipher::SALT_BYTES] = {};
+                uint8_t nonce_prefix[FileCipher::NONCE_PREFIX_BYTES] = {};
+                std::string key_id;
+                std::vector<uint8_t> bytes; // serialised form, the AAD of every segment
+
+                uint64_t segment_count() const
+                {
+                    return plaintext_bytes == 0 ? 1 : (plaintext_bytes + segment_bytes - 1) / segment_bytes;
+                }
+
+                uint64_t file_bytes() const
+                {
+                    return bytes.size() + plaintext_bytes + segment_count() * FileCipher::TAG_BYTES;
+                }
+            };
+
+            void put_le(std::vector<uint8_t> &out, uint64_t value, size_t width)
+            {
+                for (size_t i = 0; i < width; ++i)
+                {
+                    out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+                }
+            }
+
+            uint64_t get_le(const uint8_t *data, size_t width)
+            {
+                uint64_t value = 0;
+                for (size_t i = 0; i < width; ++i)
+                {
+                    value |= static_cast<uint64_t>(data[i]) << (8 * i);
+                }
+                return value;
+            }
+
+            void serialise(Header &header)
+            {
+                std::vector<uint8_t> &out = header.bytes;
+                out.clear();
+                out.insert(out.end(), MAGIC, MAGIC + sizeof(MAGIC));
+                out.push_back(FORMAT_VERSION);
+                out.push_back(static_cast<uint8_t>(header.aead));
+                put_le(out, 0, 2);
+                put_le(out, header.segment_bytes, 4);
+                put_le(out, header.plaintext_bytes, 8);
+                out.insert(out.end(), header.salt, header.salt + sizeof(header.salt));
+                out.insert(out.end(), header.nonce_prefix, header.nonce_prefix + sizeof(header.nonce_prefix));
+                put_le(out, header.key_id.size(), 2);
+                out.insert(out.end(), header.key_id.begin(), header.key_id.end());
+            }
+
+            bool read_full(int fd, uint8_t *data, size_t size, uint64_t offset)
+            {
+                while (size > 0)
+                {
+                    const ssize_t n = ::pread(fd, data, size, static_cast<off_t>(offset));
+                    if (n < 0 && errno == EINTR)
+                    {
+                        continue;
+                    }
+                    if (n <= 0)
+                    {
+                        return false;
+                    }
+                    data += n;
+                    size -= static_cast<size_t>(n);
+                    offset += static_cast<uint64_t>(n);
+                }
+                return true;
+            }
+
+            bool write_full(int fd, const uint8_t *data, size_t size, uint64_t offset)
+            {
+                while (size > 0)
+                {
+                    const ssize_t n = ::pwrite(fd, data, size, static_cast<off_t>(offset));
+                    if (n < 0 && errno == EINTR)
+                    {
+                        continue;
+                    }
+                    if (n <= 0)
+                    {
+                        return false;
+                    }
+                    data += n;
+                    size -= static_cast<size_t>(n);
+                    offset += static_cast<uint64_t>(n);
+                }
+                return true;
+            }
+
+            bool parse_header(int fd, uint64_t file_bytes, Header &header)
+            {
+                uint8_t fixed[FIXED_HEADER_BYTES];
+                if (file_bytes < FIXED_HEADER_BYTES || !read_full(fd, fixed, sizeof(fixed), 0) ||
+                    std::memcmp(fixed, MAGIC, sizeof(MAGIC)) != 0 || fixed[8] != FORMAT_VERSION || fixed[9] > 1)
+                {
+                    return false;
+                }
+                const uint8_t *cursor = fixed + 12;
+                header.aead = static_cast<Aead>(fixed[9]);
+                header.segment_bytes = static_cast<uint32_t>(get_le(cursor, 4));
+                cursor += 4;
+                header.plaintext_bytes = get_le(cursor, 8);
+                cursor += 8;
+                std::memcpy(header.salt, cursor, sizeof(header.salt));
+                cursor += sizeof(header.salt);
+                std::memcpy(header.nonce_prefix, cursor, sizeof(header.nonce_prefix));
+                cursor += sizeof(header.nonce_prefix);
+                const size_t key_id_bytes = static_cast<size_t>(get_le(cursor, 2));
+                if (header.segment_bytes == 0 || header.segment_bytes > FileCipher::MAX_SEGMENT_BYTES ||
+                    file_bytes < FIXED_HEADER_BYTES + key_id_bytes)
+                {
+                    return false;
+                }
+                header.key_id.resize(key_id_bytes);
+                if (key_id_bytes > 0 &&
+                    !read_full(fd, reinterpret_cast<uint8_t *>(&header.key_id[0]), key_id_bytes, FIXED_HEADER_BYTES))
+                {
+                    return false;
+                }
+                serialise(header);
+                return true;
+            }
+
+            // HKDF-SHA256 (RFC 5869) for a single 32-byte output block
+            bool derive_file_key(const std::vector<uint8_t> &key, const uint8_t *salt, uint8_t out[KEY_BYTES])
+            {
+                uint8_t prk[EVP_MAX_MD_SIZE];
+                unsigned int prk_len = 0;
+                if (!HMAC(EVP_sha256(), salt, static_cast<int>(FileCipher::SALT_BYTES), key.data(), key.size(), prk, &prk_len))
+                {
+                    return false;
+                }
+                uint8_t info[sizeof(KDF_INFO)];
+                std::memcpy(info, KDF_INFO, sizeof(KDF_INFO) - 1);
+                info[sizeof(KDF_INFO) - 1] = 0x01;
+                unsigned int out_len = 0;
+                const bool ok = HMAC(EVP_sha256(), prk, static_cast<int>(prk_len), info, sizeof(info), out, &out_len) &&
+                                out_len == KEY_BYTES;
+                OPENSSL_cleanse(prk, sizeof(prk));
+                return ok;
+            }
+
+            class AlignedBuffer
+            {
+            public:
+                explicit AlignedBuffer(size_t size)
+                    : data_(static_cast<uint8_t *>(std::aligned_alloc(PAGE_BYTES, std::max(PAGE_BYTES, (size + PAGE_BYTES - 1) / PAGE_BYTES * PAGE_BYTES))))
+                {
+                }
+                ~AlignedBuffer() { std::free(data_); }
+                AlignedBuffer(const AlignedBuffer &) = delete;
+                AlignedBuffer &operator=(const AlignedBuffer &) = delete;
+
+                uint8_t *data() { return data_; }
+                explicit operator bool() const { return data_ != nullptr; }
+
+            private:
+                uint8_t *data_;
+            };
+
+            // One per thread; the key schedule is set up once and only the nonce changes per segment
+            class SegmentSealer
+            {
+            public:
+                SegmentSealer(Aead aead, const uint8_t *key, bool encrypt) : ctx_(EVP_CIPHER_CTX_new()), encrypt_(encrypt)
+                {
+                    const EVP_CIPHER *cipher = aead == Aead::CHACHA20_POLY1305 ? EVP_chacha20_poly1305() : EVP_aes_256_gcm();
+                    ok_ = ctx_ && EVP_CipherInit_ex(ctx_, cipher, nullptr, nullptr, nullptr, encrypt ? 1 : 0) == 1 &&
+                          EVP_CIPHER_CTX_ctrl(ctx_, EVP_CTRL_AEAD_SET_IVLEN, static_cast<int>(NONCE_BYTES), nullptr) == 1 &&
+                          EVP_CipherInit_ex(ctx_, nullptr, nullptr, key, nullptr, encrypt ? 1 : 0) == 1;
+                }
+                ~SegmentSealer() { EVP_CIPHER_CTX_free(ctx_); }
+                SegmentSealer(const SegmentSealer &) = delete;
+                SegmentSealer &operator=(const SegmentSealer &) = delete;
+
+                explicit operator bool() const { return ok_; }
+
+                // Seals or opens in place of out; tag is written when sealing and checked when opening
+                bool process(const Header &header, uint64_t index, bool last, const uint8_t *in, size_t size,
+                             uint8_t *out, uint8_t *tag)
+                {
+                    uint8_t nonce[NONCE_BYTES];
+                    std::memcpy(nonce, header.nonce_prefix, FileCipher::NONCE_PREFIX_BYTES);
+                    nonce[7] = static_cast<uint8_t>(index >> 24);
+                    nonce[8] = static_cast<uint8_t>(index >> 16);
+                    nonce[9] = static_cast<uint8_t>(index >> 8);
+                    nonce[10] = static_cast<uint8_t>(index);
+                    nonce[11] = last ? 1 : 0;
+
+                    int len = 0;
+                    if (EVP_CipherInit_ex(ctx_, nullptr, nullptr, nullptr, nonce, encrypt_ ? 1 : 0) != 1 ||
+                        EVP_CipherUpdate(ctx_, nullptr, &len, header.bytes.data(), static_cast<int>(header.bytes.size())) != 1)
+                    {
+                        return false;
+                    }
+                    if (size > 0 && EVP_CipherUpdate(ctx_, out, &len, in, static_cast<int>(size)) != 1)
+                    {
+                        return false;
+                    }
+                    if (!encrypt_ &&
+                        EVP_CIPHER_CTX_ctrl(ctx_, EVP_CTRL_AEAD_SET_TAG, static_cast<int>(FileCipher::TAG_BYTES), tag) != 1)
+                    {
+                        return false;
+                    }
+                    if (EVP_CipherFinal_ex(ctx_, out + size, &len) != 1)
+                    {
+                        return false; // authentication failure when opening
+                    }
+                    return !encrypt_ ||
+                           EVP_CIPHER_CTX_ctrl(ctx_, EVP_CTRL_AEAD_GET_TAG, static_cast<int>(FileCipher::TAG_BYTES), tag) == 1;
+                }
+
+            private:
+                EVP_CIPHER_CTX *ctx_;
+                bool encrypt_;
+                bool ok_ = false;
+            };
+
+            class FileDescriptor
+            {
+            public:
+                explicit FileDescriptor(int fd) : fd_(fd) {}
+                ~FileDescriptor()
+                {
+                    if (fd_ >= 0)
+                    {
+                        ::close(fd_);
+                    }
+                }
+                FileDescriptor(const FileDescriptor &) = delete;
+                FileDescriptor &operator=(const FileDescriptor &) = delete;
+
+                int get() const { return fd_; }
+                bool close()
+                {
+                    const int fd = fd_;
+                    fd_ = -1;
+                    return fd < 0 || ::close(fd) == 0;
+                }
+
+            private:
+                int fd_;
+            };
+
+            // Seal or open every batch of segments between two open files
+            bool run_segments(const Header &header, int input, int output, const uint8_t *file_key, bool encrypt,
+                              const FileCipher::Options &options)
+            {
+                const uint64_t segments = header.segment_count();
+                const uint64_t per_batch = std::max<uint32_t>(1, options.segments_per_batch);
+                const uint64_t batches = (segments + per_batch - 1) / per_batch;
+                const uint64_t plain_stride = header.segment_bytes;
+                const uint64_t cipher_stride = plain_stride + FileCipher::TAG_BYTES;
+                const uint64_t body = header.bytes.size();
+
+                uint32_t threads = options.threads == 0 ? std::max(1u, std::thread::hardware_concurrency()) : options.threads;
+                threads = static_cast<uint32_t>(std::min<uint64_t>(threads, batches));
+
+                std::atomic<uint64_t> next_batch{0};
+                std::atomic<bool> failed{false};
+                const auto worker = [&]()
+                {
+                    SegmentSealer sealer(header.aead, file_key, encrypt);
+                    AlignedBuffer plain(static_cast<size_t>(per_batch * plain_stride));
+                    AlignedBuffer sealed(static_cast<size_t>(per_batch * cipher_stride));
+                    if (!sealer || !plain || !sealed)
+                    {
+                        failed = true;
+                        return;
+                    }
+                    for (uint64_t batch = next_batch++; batch < batches && !failed; batch = next_batch++)
+                    {
+                        const uint64_t first = batch * per_batch;
+                        const uint64_t count = std::min(per_batch, segments - first);
+                        const uint64_t plain_offset = first * plain_stride;
+                        const uint64_t plain_bytes = std::min(header.plaintext_bytes - plain_offset, count * plain_stride);
+                        const uint64_t sealed_bytes = plain_bytes + count * FileCipher::TAG_BYTES;
+                        const uint64_t sealed_offset = body + first * cipher_stride;
+
+                        if (!(encrypt ? read_full(input, plain.data(), static_cast<size_t>(plain_bytes), plain_offset)
+                                      : read_full(input, sealed.data(), static_cast<size_t>(sealed_bytes), sealed_offset)))
+                        {
+                            failed = true;
+                            return;
+                        }
+                        for (uint64_t i = 0; i < count; ++i)
+                        {
+                            const uint64_t index = first + i;
+                            const size_t size = static_cast<size_t>(std::min(plain_stride, plain_bytes - i * plain_stride));
+                            uint8_t *plain_segment = plain.data() + i * plain_stride;
+                            uint8_t *sealed_segment = sealed.data() + i * cipher_stride;
+                            const bool ok = encrypt ? sealer.process(header, index, index + 1 == segments, plain_segment, size,
+                                                                     sealed_segment, sealed_segment + size)
+                                                    : sealer.process(header, index, index + 1 == segments, sealed_segment, size,
+                                                                     plain_segment, sealed_segment + size);
+                            if (!ok)
+                            {
+                                failed = true;
+                                return;
+                            }
+                        }
+                        if (!(encrypt ? write_full(output, sealed.data(), static_cast<size_t>(sealed_bytes), sealed_offset)
+                                      : write_full(output, plain.data(), static_cast<size_t>(plain_bytes), plain_offset)))
+                        {
+                            failed = true;
+                            return;
+                        }
+                    }
+                };
+
+                std::vector<std::thread> pool;
+                for (uint32_t i = 1; i < threads; ++i)
+                {
+                    pool.emplace_back(worker);
+                }
+                worker();
+                for (auto &thread : pool)
+                {
+                    thread.join();
+                }
+                return !failed;
+            }
+
+            Aead aead_for(EncryptionAlgorithm algorithm)
+            {
+                return algorithm == EncryptionAlgorithm::CHACHA20_POLY1305 || algorithm == EncryptionAlgorithm::XCHACHA20_POLY1305
+                           ? Aead::CHACHA20_POLY1305
+                           : Aead::AES_256_GCM;
+            }
+
+            bool file_size(int fd, uint64_t &size)
+            {
+                struct stat info;
+                if (::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode))
+                {
+                    return false;
+                }
+                size = static_cast<uint64_t>(info.st_size);
+                return true;
+            }
+
+            bool fail(const std::string &output_path, const std::string &reason)
+            {
+                ::unlink(output_path.c_str());
+                utils::Logger::instance().log(utils::LogLevel::ERROR, "Encryption", reason);
+                return false;
+            }
+        } // namespace
+
+        bool FileCipher::encrypt(const std::string &input_path, const std::string &output_path, const EncryptionKey &key,
+                                 const Options &options)
+        {
+            if (key.key_data.size() != KEY_BYTES || options.segment_bytes == 0 || options.segment_bytes > MAX_SEGMENT_BYTES ||
+                key.key_id.size() > UINT16_MAX)
+            {
+                return false;
+            }
+            FileDescriptor input(::open(input_path.c_str(), O_RDONLY | O_CLOEXEC));
+            Header header;
+            if (input.get() < 0 || !file_size(input.get(), header.plaintext_bytes))
+            {
+                return false;
+            }
+#ifdef POSIX_FADV_SEQUENTIAL
+            ::posix_fadvise(input.get(), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+            header.aead = aead_for(key.algorithm);
+            header.segment_bytes = options.segment_bytes;
+            header.key_id = key.key_id;
+            if (RAND_bytes(header.salt, sizeof(header.salt)) != 1 ||
+                RAND_bytes(header.nonce_prefix, sizeof(header.nonce_prefix)) != 1 || header.segment_count() > UINT32_MAX)
+            {
+                return false;
+            }
+            serialise(header);
+
+            FileDescriptor output(::open(output_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600));
+            if (output.get() < 0)
+            {
+                return false;
+            }
+            // Sized up front so batches can land in any order
+            if (::ftruncate(output.get(), static_cast<off_t>(header.file_bytes())) != 0 ||
+                !write_full(output.get(), header.bytes.data(), header.bytes.size(), 0))
+            {
+                return fail(output_path, "Cannot write encrypted file: " + output_path);
+            }
+
+            uint8_t file_key[KEY_BYTES];
+            bool ok = derive_file_key(key.key_data, header.salt, file_key) &&
+                      run_segments(header, input.get(), output.get(), file_key, true, options);
+            OPENSSL_cleanse(file_key, sizeof(file_key));
+            ok = output.close() && ok;
+            return ok || fail(output_path, "File encryption failed: " + input_path);
+        }
+
+        bool FileCipher::decrypt(const std::string &input_path, const std::string &output_path, const EncryptionKey &key,
+                                 const Options &options)
+        {
+            if (key.key_data.size() != KEY_BYTES)
+            {
+                return false;
+            }
+            FileDescriptor input(::open(input_path.c_str(), O_RDONLY | O_CLOEXEC));
+            uint64_t size = 0;
+            Header header;
+            if (input.get() < 0 || !file_size(input.get(), size) || !parse_header(input.get(), size, header))
+            {
+                utils::Logger::instance().log(utils::LogLevel::ERROR, "Encryption",
+                                              "Not a segmented encrypted file: " + input_path);
+                return false;
+            }
+            if (header.key_id != key.key_id || header.segment_count() > UINT32_MAX || header.file_bytes() != size)
+            {
+                utils::Logger::instance().log(utils::LogLevel::ERROR, "Encryption",
+                                              "Encrypted file truncated or sealed with another key: " + input_path);
+                return false;
+            }
+#ifdef POSIX_FADV_SEQUENTIAL
+            ::posix_fadvise(input.get(), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+            FileDescriptor output(::open(output_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600));
+            if (output.get() < 0)
+            {
+                return false;
+            }
+            if (::ftruncate(output.get(), static_cast<off_t>(header.plaintext_bytes)) != 0)
+            {
+                return fail(output_path, "Cannot write decrypted file: " + output_path);
+            }
+
+            FileCipher::Options effective = options;
+            effective.segment_bytes = header.segment_bytes;
+            uint8_t file_key[KEY_BYTES];
+            bool ok = derive_file_key(key.key_data, header.salt, file_key) &&
+                      run_segments(header, input.get(), output.get(), file_key, false, effective);
+            OPENSSL_cleanse(file_key, sizeof(file_key));
+            ok = output.close() && ok;
+            return ok || fail(output_path, "File decryption failed authentication: " + input_path);
+        }
+
+        std::string FileCipher::read_key_id(const std::string &path)
+        {
+            FileDescriptor input(::open(path.c_str(), O_RDONLY | O_CLOEXEC));
+            uint64_t size = 0;
+            Header header;
+            if (input.get() < 0 || !file_size(input.get(), size) || !parse_header(input.get(), size, header))
+            {
+                return {};
+            }
+            return header.key_id;
+        }
+
+        uint64_t FileCipher::read_plaintext_size(const std::string &path)
+        {
+            FileDescriptor input(::open(path.c_str(), O_RDONLY | O_CLOEXEC));
+            uint64_t size = 0;
+            Header header;
+            if (input.get() < 0 || !file_size(input.get(), size) || !parse_header(input.get(), size, header))
+            {
+                return 0;
+            }
+            return header.plaintext_bytes;
+        }
+
+    } // namespace security
+} // namespace cardano_iot
@@ -0,0 +1,203 @@
+#include "cardano_iot/security/session_table.h"
+
+#include <functional>
+#include <mutex>
+
+namespace cardano_iot
+{
+    namespace security
+    {
+        SessionTable::Entry::Entry(const AuthSession &initial)
+            : session(initial), last_activity(initial.last_activity_timestamp), expiry(initial.expiry_timestamp)
+        {
+        }
+
+        AuthSession SessionTable::Entry::to_session() const
+        {
+            AuthSession copy = session;
+            copy.last_activity_timestamp = last_activity.load(std::memory_order_relaxed);
+            copy.expiry_timestamp = expiry.load(std::memory_order_relaxed);
+            return copy;
+        }
+
+        SessionTable::SessionTable(size_t shard_count) : shards_(shard_count == 0 ? 1 : shard_count)
+        {
+        }
+
+        SessionTable::Shard &SessionTable::shard_for(const std::string &session_id)
+        {
+            return shards_[std::hash<std::string>{}(session_id) % shards_.size()];
+        }
+
+        void SessionTable::insert(const AuthSession &session)
+        {
+            Shard &shard = shard_for(session.session_id);
+            auto entry = std::make_unique<Entry>(session);
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            shard.entries[session.session_id] = std::move(entry);
+        }
+
+        bool SessionTable::set_timer(const std::string &session_id, TimerHandle timer)
+        {
+            Shard &shard = shard_for(session_id);
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            auto it = shard.entries.find(session_id);
+            if (it == shard.entries.end())
+            {
+                return false;
+            }
+            it->second->timer = timer;
+            return true;
+        }
+
+        SessionTable::Lookup SessionTable::touch(const std::string &session_id, uint64_t now, TimerHandle *removed_timer)
+        {
+            Shard &shard = shard_for(session_id);
+            {
+                std::shared_lock<std::shared_mutex> lock(shard.mutex);
+                auto it = shard.entries.find(session_id);
+                if (it == shard.entries.end())
+                {
+                    return Lookup::UNKNOWN;
+                }
+                Entry &entry = *it->second;
+                if (now <= entry.expiry.load(std::memory_order_relaxed))
+                {
+                    if (entry.last_activity.load(std::memory_order_relaxed) < now)
+                    {
+                        entry.last_activity.store(now, std::memory_order_relaxed);
+                    }
+                    return Lookup::VALID;
+                }
+            }
+
+            // Expired: recheck under the exclusive lock, a refresh may have raced us
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            auto it = shard.entries.find(session_id);
+            if (it == shard.entries.end())
+            {
+                return Lookup::UNKNOWN;
+            }
+            if (now <= it->second->expiry.load(std::memory_order_relaxed))
+            {
+                return Lookup::VALID;
+            }
+            if (removed_timer)
+            {
+                *removed_timer = it->second->timer;
+            }
+            shard.entries.erase(it);
+            return Lookup::EXPIRED;
+        }
+
+        SessionTable::Lookup SessionTable::expire(const std::string &session_id, uint64_t now, uint64_t &expiry)
+        {
+            Shard &shard = shard_for(session_id);
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            auto it = shard.entries.find(session_id);
+            if (it == shard.entries.end())
+            {
+                return Lookup::UNKNOWN;
+            }
+            expiry = it->second->expiry.load(std::memory_order_relaxed);
+            if (now <= expiry)
+            {
+                return Lookup::VALID;
+            }
+            shard.entries.erase(it);
+            return Lookup::EXPIRED;
+        }
+
+        bool SessionTable::refresh(const std::string &session_id, uint64_t now, uint32_t timeout_seconds)
+        {
+            Shard &shard = shard_for(session_id);
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            auto it = shard.entries.find(session_id);
+            if (it == shard.entries.end())
+            {
+                return false;
+            }
+            it->second->last_activity.store(now, std::memory_order_relaxed);
+            it->second->expiry.store(now + timeout_seconds, std::memory_order_relaxed);
+            return true;
+        }
+
+        bool SessionTable::erase(const std::string &session_id, TimerHandle *removed_timer)
+        {
+            Shard &shard = shard_for(session_id);
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            auto it = shard.entries.find(session_id);
+            if (it == shard.entries.end())
+            {
+                return false;
+            }
+            if (removed_timer)
+            {
+                *removed_timer = it->second->timer;
+            }
+            shard.entries.erase(it);
+            return true;
+        }
+
+        size_t SessionTable::erase_device(const std::string &device_id, std::vector<TimerHandle> *removed_timers)
+        {
+            size_t removed = 0;
+            for (auto &shard : shards_)
+            {
+                std::unique_lock<std::shared_mutex> lock(shard.mutex);
+                for (auto it = shard.entries.begin(); it != shard.entries.end();)
+                {
+                    if (it->second->session.device_id == device_id)
+                    {
+                        if (removed_timers)
+                        {
+                            removed_timers->push_back(it->second->timer);
+                        }
+                        it = shard.entries.erase(it);
+                        ++removed;
+                    }
+                    else
+                    {
+                        ++it;
+                    }
+                }
+            }
+            return removed;
+        }
+
+        std::vector<AuthSession> SessionTable::list() const
+        {
+            std::vector<AuthSession> sessions;
+            for (const auto &shard : shards_)
+            {
+                std::shared_lock<std::shared_mutex> lock(shard.mutex);
+                for (const auto &entry : shard.entries)
+                {
+                    sessions.push_back(entry.second->to_session());
+                }
+            }
+            return sessions;
+        }
+
+        size_t SessionTable::size() const
+        {
+            size_t total = 0;
+            for (const auto &shard : shards_)
+            {
+                std::shared_lock<std::shared_mutex> lock(shard.mutex);
+                total += shard.entries.size();
+            }
+            return total;
+        }
+
+        void SessionTable::clear()
+        {
+            for (auto &shard : shards_)
+            {
+                std::unique_lock<std::shared_mutex> lock(shard.mutex);
+                shard.entries.clear();
+            }
+        }
+
+    } // namespace security
+} // namespace cardano_iot
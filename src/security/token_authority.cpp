@@ -0,0 +1,230 @@
+#include "cardano_iot/security/token_authority.h"
+#include "cardano_iot/utils/codec.h"
+
+#include <cstring>
+#include <mutex>
+
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/rand.h>
+
+namespace cardano_iot
+{
+    namespace security
+    {
+        namespace
+        {
+            constexpr char TOKEN_PREFIX[] = "ciot1.";
+            constexpr size_t TOKEN_PREFIX_BYTES = sizeof(TOKEN_PREFIX) - 1;
+            constexpr size_t TAG_BYTES = 32;
+            constexpr size_t FIXED_CLAIM_BYTES = 8 + 8 + 16;
+
+            void put_u64(std::vector<uint8_t> &out, uint64_t value)
+            {
+                for (int i = 0; i < 8; ++i)
+                {
+                    out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+                }
+            }
+
+            uint64_t get_u64(const uint8_t *in)
+            {
+                uint64_t value = 0;
+                for (int i = 7; i >= 0; --i)
+                {
+                    value = (value << 8) | in[i];
+                }
+                return value;
+            }
+
+            std::string token_key(const std::array<uint8_t, 16> &token_id)
+            {
+                return std::string(reinterpret_cast<const char *>(token_id.data()), token_id.size());
+            }
+
+            std::string sign(const std::array<uint8_t, 32> &secret, const char *data, size_t size)
+            {
+                uint8_t tag[TAG_BYTES];
+                unsigned int tag_len = 0;
+                if (!HMAC(EVP_sha256(), secret.data(), static_cast<int>(secret.size()),
+                          reinterpret_cast<const uint8_t *>(data), size, tag, &tag_len))
+                {
+                    return {};
+                }
+                return utils::codec::base64_encode(std::vector<uint8_t>(tag, tag + tag_len));
+            }
+        } // namespace
+
+        // Token ids are random, so disjoint 16-bit slices of one are independent filter hashes
+        void TokenAuthority::RevocationFilter::add(const std::array<uint8_t, 16> &token_id)
+        {
+            for (size_t k = 0; k < 4; ++k)
+            {
+                const size_t bit = (size_t(token_id[2 * k]) << 8 | token_id[2 * k + 1]) % (FILTER_WORDS * 64);
+                words[bit / 64].fetch_or(uint64_t(1) << (bit % 64), std::memory_order_release);
+            }
+        }
+
+        bool TokenAuthority::RevocationFilter::may_contain(const std::array<uint8_t, 16> &token_id) const
+        {
+            for (size_t k = 0; k < 4; ++k)
+            {
+                const size_t bit = (size_t(token_id[2 * k]) << 8 | token_id[2 * k + 1]) % (FILTER_WORDS * 64);
+                if ((words[bit / 64].load(std::memory_order_acquire) & (uint64_t(1) << (bit % 64))) == 0)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        TokenAuthority::TokenAuthority()
+        {
+            reset();
+        }
+
+        void TokenAuthority::reset()
+        {
+            std::unique_lock<std::shared_mutex> lock(revoked_mutex_);
+            if (RAND_bytes(secret_.data(), static_cast<int>(secret_.size())) != 1)
+            {
+                secret_.fill(0); // unusable secret; issue() refuses to sign with it
+            }
+            revoked_.clear();
+            std::atomic_store(&filter_, std::make_shared<RevocationFilter>());
+        }
+
+        std::string TokenAuthority::issue(const std::string &device_id, uint64_t now, uint32_t validity_seconds,
+                                          AccessTokenClaims *claims) const
+        {
+            static const std::array<uint8_t, 32> unusable{};
+            AccessTokenClaims issued;
+            issued.device_id = device_id;
+            issued.issued_at = now;
+            issued.expires_at = now + validity_seconds;
+            if (secret_ == unusable || RAND_bytes(issued.token_id.data(), static_cast<int>(issued.token_id.size())) != 1)
+            {
+                return {};
+            }
+
+            std::vector<uint8_t> payload;
+            payload.reserve(FIXED_CLAIM_BYTES + device_id.size());
+            put_u64(payload, issued.issued_at);
+            put_u64(payload, issued.expires_at);
+            payload.insert(payload.end(), issued.token_id.begin(), issued.token_id.end());
+            payload.insert(payload.end(), device_id.begin(), device_id.end());
+
+            std::string token = TOKEN_PREFIX + utils::codec::base64_encode(payload);
+            const std::string tag = sign(secret_, token.data(), token.size());
+            if (tag.empty())
+            {
+                return {};
+            }
+            token += '.';
+            token += tag;
+            if (claims)
+            {
+                *claims = std::move(issued);
+            }
+            return token;
+        }
+
+        TokenAuthority::Verdict TokenAuthority::verify(const std::string &token, uint64_t now, AccessTokenClaims *claims) const
+        {
+            const size_t dot = token.rfind('.');
+            if (token.compare(0, TOKEN_PREFIX_BYTES, TOKEN_PREFIX) != 0 || dot == std::string::npos || dot <= TOKEN_PREFIX_BYTES)
+            {
+                return Verdict::MALFORMED;
+            }
+
+            // The tag's length is public; its bytes are compared without an early exit
+            const std::string expected = sign(secret_, token.data(), dot);
+            const size_t tag_size = token.size() - dot - 1;
+            if (expected.empty() || tag_size != expected.size() ||
+                CRYPTO_memcmp(expected.data(), token.data() + dot + 1, tag_size) != 0)
+            {
+                return Verdict::BAD_SIGNATURE;
+            }
+
+            const std::vector<uint8_t> payload = utils::codec::base64_decode(
+                std::string_view(token).substr(TOKEN_PREFIX_BYTES, dot - TOKEN_PREFIX_BYTES));
+            if (payload.size() < FIXED_CLAIM_BYTES)
+            {
+                return Verdict::MALFORMED;
+            }
+            AccessTokenClaims decoded;
+            decoded.issued_at = get_u64(payload.data());
+            decoded.expires_at = get_u64(payload.data() + 8);
+            std::memcpy(decoded.token_id.data(), payload.data() + 16, decoded.token_id.size());
+            decoded.device_id.assign(payload.begin() + FIXED_CLAIM_BYTES, payload.end());
+
+            Verdict verdict = Verdict::VALID;
+            if (now > decoded.expires_at)
+            {
+                verdict = Verdict::EXPIRED;
+            }
+            else if (std::atomic_load(&filter_)->may_contain(decoded.token_id))
+            {
+                std::shared_lock<std::shared_mutex> lock(revoked_mutex_);
+                if (revoked_.count(token_key(decoded.token_id)) != 0)
+                {
+                    verdict = Verdict::REVOKED;
+                }
+            }
+            if (claims)
+            {
+                *claims = std::move(decoded);
+            }
+            return verdict;
+        }
+
+        bool TokenAuthority::revoke(const AccessTokenClaims &claims, uint64_t now)
+        {
+            std::unique_lock<std::shared_mutex> lock(revoked_mutex_);
+            if (now > claims.expires_at || !revoked_.emplace(token_key(claims.token_id), claims.expires_at).second)
+            {
+                return false;
+            }
+            std::atomic_load(&filter_)->add(claims.token_id);
+            return true;
+        }
+
+        void TokenAuthority::purge_expired(uint64_t now)
+        {
+            std::unique_lock<std::shared_mutex> lock(revoked_mutex_);
+            bool purged = false;
+            for (auto it = revoked_.begin(); it != revoked_.end();)
+            {
+                if (now > it->second)
+                {
+                    it = revoked_.erase(it);
+                    purged = true;
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+            if (!purged)
+            {
+                return;
+            }
+            auto filter = std::make_shared<RevocationFilter>();
+            for (const auto &entry : revoked_)
+            {
+                std::array<uint8_t, 16> token_id;
+                std::memcpy(token_id.data(), entry.first.data(), token_id.size());
+                filter->add(token_id);
+            }
+            std::atomic_store(&filter_, std::move(filter));
+        }
+
+        size_t TokenAuthority::revoked_count() const
+        {
+            std::shared_lock<std::shared_mutex> lock(revoked_mutex_);
+            return revoked_.size();
+        }
+
+    } // namespace security
+} // namespace cardano_iot
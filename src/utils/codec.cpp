@@ -0,0 +1,457 @@
+/**
+ * @file codec.cpp
+ * @brief Implementation of SIMD-accelerated hex and base64 codecs
+ *
+ * @author Cardano IoT SDK Team
+ * @version 1.0.0
+ */
+
+#include "cardano_iot/utils/codec.h"
+
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define CARDANO_IOT_CODEC_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define CARDANO_IOT_CODEC_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace cardano_iot::utils::codec
+{
+
+    namespace
+    {
+        const char HEX_DIGITS[] = "0123456789abcdef";
+        const char BASE64_ALPHABET[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+        // -1 invalid, -2 whitespace, -3 padding
+        struct Base64DecodeTable
+        {
+            int8_t values[256];
+
+            Base64DecodeTable()
+            {
+                std::memset(values, -1, sizeof(values));
+                for (int i = 0; i < 64; ++i)
+                {
+                    values[static_cast<uint8_t>(BASE64_ALPHABET[i])] = static_cast<int8_t>(i);
+                }
+                for (char c : {' ', '\t', '\r', '\n'})
+                {
+                    values[static_cast<uint8_t>(c)] = -2;
+                }
+                values[static_cast<uint8_t>('=')] = -3;
+            }
+        };
+
+        const Base64DecodeTable BASE64_DECODE;
+
+        inline int hex_value(char c)
+        {
+            if (c >= '0' && c <= '9')
+                return c - '0';
+            if (c >= 'a' && c <= 'f')
+                return c - 'a' + 10;
+            if (c >= 'A' && c <= 'F')
+                return c - 'A' + 10;
+            return -1;
+        }
+
+        // ---- Scalar kernels ------------------------------------------------
+
+        size_t hex_encode_scalar(const uint8_t *src, size_t length, char *dst)
+        {
+            for (size_t i = 0; i < length; ++i)
+            {
+                dst[2 * i] = HEX_DIGITS[src[i] >> 4];
+                dst[2 * i + 1] = HEX_DIGITS[src[i] & 0x0F];
+            }
+            return length * 2;
+        }
+
+        size_t hex_decode_scalar(const char *src, size_t length, uint8_t *dst)
+        {
+            if (length % 2 != 0)
+            {
+                return npos;
+            }
+            for (size_t i = 0; i < length; i += 2)
+            {
+                int hi = hex_value(src[i]);
+                int lo = hex_value(src[i + 1]);
+                if (hi < 0 || lo < 0)
+                {
+                    return npos;
+                }
+                dst[i / 2] = static_cast<uint8_t>((hi << 4) | lo);
+            }
+            return length / 2;
+        }
+
+        size_t base64_encode_scalar(const uint8_t *src, size_t length, char *dst)
+        {
+            size_t out = 0;
+            size_t i = 0;
+            for (; i + 3 <= length; i += 3)
+            {
+                uint32_t n = (static_cast<uint32_t>(src[i]) << 16) |
+                             (static_cast<uint32_t>(src[i + 1]) << 8) |
+                             static_cast<uint32_t>(src[i + 2]);
+                dst[out++] = BASE64_ALPHABET[(n >> 18) & 0x3F];
+                dst[out++] = BASE64_ALPHABET[(n >> 12) & 0x3F];
+                dst[out++] = BASE64_ALPHABET[(n >> 6) & 0x3F];
+                dst[out++] = BASE64_ALPHABET[n & 0x3F];
+            }
+            if (i + 1 == length)
+            {
+                uint32_t n = static_cast<uint32_t>(src[i]) << 16;
+                dst[out++] = BASE64_ALPHABET[(n >> 18) & 0x3F];
+                dst[out++] = BASE64_ALPHABET[(n >> 12) & 0x3F];
+                dst[out++] = '=';
+                dst[out++] = '=';
+            }
+            else if (i + 2 == length)
+            {
+                uint32_t n = (static_cast<uint32_t>(src[i]) << 16) | (static_cast<uint32_t>(src[i + 1]) << 8);
+                dst[out++] = BASE64_ALPHABET[(n >> 18) & 0x3F];
+                dst[out++] = BASE64_ALPHABET[(n >> 12) & 0x3F];
+                dst[out++] = BASE64_ALPHABET[(n >> 6) & 0x3F];
+                dst[out++] = '=';
+            }
+            return out;
+        }
+
+        size_t base64_decode_scalar(const char *src, size_t length, uint8_t *dst)
+        {
+            uint32_t bits = 0;
+            int bit_count = 0;
+            size_t out = 0;
+            bool padding = false;
+
+            for (size_t i = 0; i < length; ++i)
+            {
+                int8_t value = BASE64_DECODE.values[static_cast<uint8_t>(src[i])];
+                if (value == -2)
+                {
+                    continue;
+                }
+                if (value == -3)
+                {
+                    padding = true;
+                    continue;
+                }
+                if (value < 0 || padding)
+                {
+                    return npos; // invalid char, or data after padding
+                }
+
+                bits = (bits << 6) | static_cast<uint32_t>(value);
+                bit_count += 6;
+                if (bit_count >= 8)
+                {
+                    bit_count -= 8;
+                    dst[out++] = static_cast<uint8_t>((bits >> bit_count) & 0xFF);
+                }
+            }
+            return out;
+        }
+
+        // ---- x86 kernels ---------------------------------------------------
+
+#ifdef CARDANO_IOT_CODEC_X86
+        __attribute__((target("ssse3"))) size_t hex_encode_ssse3(const uint8_t *src, size_t length, char *dst)
+        {
+            const __m128i lut = _mm_loadu_si128(reinterpret_cast<const __m128i *>(HEX_DIGITS));
+            const __m128i nibble_mask = _mm_set1_epi8(0x0F);
+
+            size_t i = 0;
+            for (; i + 16 <= length; i += 16)
+            {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+                __m128i hi = _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(v, 4), nibble_mask));
+                __m128i lo = _mm_shuffle_epi8(lut, _mm_and_si128(v, nibble_mask));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + 2 * i), _mm_unpacklo_epi8(hi, lo));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + 2 * i + 16), _mm_unpackhi_epi8(hi, lo));
+            }
+            hex_encode_scalar(src + i, length - i, dst + 2 * i);
+            return length * 2;
+        }
+
+        __attribute__((target("avx2"))) size_t hex_encode_avx2(const uint8_t *src, size_t length, char *dst)
+        {
+            const __m256i lut = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(HEX_DIGITS)));
+            const __m256i nibble_mask = _mm256_set1_epi8(0x0F);
+
+            size_t i = 0;
+            for (; i + 32 <= length; i += 32)
+            {
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+                __m256i hi = _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble_mask));
+                __m256i lo = _mm256_shuffle_epi8(lut, _mm256_and_si256(v, nibble_mask));
+                // Interleave works per 128-bit lane; reorder lanes back into byte order
+                __m256i a = _mm256_unpacklo_epi8(hi, lo);
+                __m256i b = _mm256_unpackhi_epi8(hi, lo);
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + 2 * i), _mm256_permute2x128_si256(a, b, 0x20));
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + 2 * i + 32), _mm256_permute2x128_si256(a, b, 0x31));
+            }
+            return 2 * i + hex_encode_ssse3(src + i, length - i, dst + 2 * i);
+        }
+
+        // Translate 16 hex chars into nibble values; returns false on any invalid char
+        __attribute__((target("ssse3"))) inline bool hex_nibbles_ssse3(__m128i v, __m128i &nibbles)
+        {
+            const __m128i is_digit = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('0' - 1)),
+                                                   _mm_cmplt_epi8(v, _mm_set1_epi8('9' + 1)));
+            const __m128i lower = _mm_or_si128(v, _mm_set1_epi8(0x20));
+            const __m128i is_alpha = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+                                                   _mm_cmplt_epi8(lower, _mm_set1_epi8('f' + 1)));
+            if (_mm_movemask_epi8(_mm_or_si128(is_digit, is_alpha)) != 0xFFFF)
+            {
+                return false;
+            }
+            const __m128i digit_values = _mm_sub_epi8(v, _mm_set1_epi8('0'));
+            const __m128i alpha_values = _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10));
+            nibbles = _mm_or_si128(_mm_and_si128(is_digit, digit_values), _mm_andnot_si128(is_digit, alpha_values));
+            return true;
+        }
+
+        __attribute__((target("ssse3"))) size_t hex_decode_ssse3(const char *src, size_t length, uint8_t *dst)
+        {
+            if (length % 2 != 0)
+            {
+                return npos;
+            }
+
+            // Each output byte is 16 * high nibble + low nibble (pairwise multiply-add)
+            const __m128i weights = _mm_set1_epi16(0x0110);
+
+            size_t i = 0;
+            for (; i + 32 <= length; i += 32)
+            {
+                __m128i n0, n1;
+                if (!hex_nibbles_ssse3(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i)), n0) ||
+                    !hex_nibbles_ssse3(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i + 16)), n1))
+                {
+                    return npos;
+                }
+                __m128i bytes = _mm_packus_epi16(_mm_maddubs_epi16(n0, weights), _mm_maddubs_epi16(n1, weights));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i / 2), bytes);
+            }
+
+            size_t tail = hex_decode_scalar(src + i, length - i, dst + i / 2);
+            return tail == npos ? npos : i / 2 + tail;
+        }
+
+        // Base64 encode after W. Mula's SSSE3 scheme: 12 input bytes -> 16 chars per step
+        __attribute__((target("ssse3"))) size_t base64_encode_ssse3(const uint8_t *src, size_t length, char *dst)
+        {
+            const __m128i shuffle = _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+            const __m128i shift_lut = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                                    '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+                                                    '/' - 63, 'A', 0, 0);
+
+            size_t i = 0;
+            size_t out = 0;
+            // Loads 16 bytes but consumes 12, so stop while a full load is still in bounds
+            for (; i + 16 <= length; i += 12, out += 16)
+            {
+                __m128i in = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i)), shuffle);
+
+                const __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+                const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+                const __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+                const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+                const __m128i indices = _mm_or_si128(t1, t3);
+
+                __m128i offsets = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+                const __m128i below_26 = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+                offsets = _mm_or_si128(offsets, _mm_and_si128(below_26, _mm_set1_epi8(13)));
+                const __m128i chars = _mm_add_epi8(_mm_shuffle_epi8(shift_lut, offsets), indices);
+
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + out), chars);
+            }
+            return out + base64_encode_scalar(src + i, length - i, dst + out);
+        }
+
+        // 16 chars -> 12 bytes per step; any padding, whitespace or invalid char drops to scalar
+        __attribute__((target("ssse3"))) size_t base64_decode_ssse3(const char *src, size_t length, uint8_t *dst)
+        {
+            const __m128i pack_shuffle = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+
+            size_t i = 0;
+            size_t out = 0;
+            for (; i + 16 <= length; i += 16, out += 12)
+            {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+
+                const __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('A' - 1)),
+                                                    _mm_cmplt_epi8(v, _mm_set1_epi8('Z' + 1)));
+                const __m128i lower = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('a' - 1)),
+                                                    _mm_cmplt_epi8(v, _mm_set1_epi8('z' + 1)));
+                const __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('0' - 1)),
+                                                    _mm_cmplt_epi8(v, _mm_set1_epi8('9' + 1)));
+                const __m128i plus = _mm_cmpeq_epi8(v, _mm_set1_epi8('+'));
+                const __m128i slash = _mm_cmpeq_epi8(v, _mm_set1_epi8('/'));
+
+                const __m128i valid = _mm_or_si128(_mm_or_si128(upper, lower), _mm_or_si128(digit, _mm_or_si128(plus, slash)));
+                if (_mm_movemask_epi8(valid) != 0xFFFF)
+                {
+                    break;
+                }
+
+                __m128i shift = _mm_and_si128(upper, _mm_set1_epi8(-65));
+                shift = _mm_or_si128(shift, _mm_and_si128(lower, _mm_set1_epi8(-71)));
+                shift = _mm_or_si128(shift, _mm_and_si128(digit, _mm_set1_epi8(4)));
+                shift = _mm_or_si128(shift, _mm_and_si128(plus, _mm_set1_epi8(19)));
+                shift = _mm_or_si128(shift, _mm_and_si128(slash, _mm_set1_epi8(16)));
+                const __m128i sextets = _mm_add_epi8(v, shift);
+
+                const __m128i pairs = _mm_maddubs_epi16(sextets, _mm_set1_epi32(0x01400140));
+                const __m128i words = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+                const __m128i bytes = _mm_shuffle_epi8(words, pack_shuffle);
+
+                alignas(16) uint8_t block[16];
+                _mm_store_si128(reinterpret_cast<__m128i *>(block), bytes);
+                std::memcpy(dst + out, block, 12);
+            }
+
+            size_t tail = base64_decode_scalar(src + i, length - i, dst + out);
+            return tail == npos ? npos : out + tail;
+        }
+#endif
+
+        // ---- NEON kernels --------------------------------------------------
+
+#ifdef CARDANO_IOT_CODEC_NEON
+        size_t hex_encode_neon(const uint8_t *src, size_t length, char *dst)
+        {
+            const uint8x16_t lut = vld1q_u8(reinterpret_cast<const uint8_t *>(HEX_DIGITS));
+            const uint8x16_t nibble_mask = vdupq_n_u8(0x0F);
+
+            size_t i = 0;
+            for (; i + 16 <= length; i += 16)
+            {
+                uint8x16_t v = vld1q_u8(src + i);
+                uint8x16x2_t chars;
+                chars.val[0] = vqtbl1q_u8(lut, vshrq_n_u8(v, 4));
+                chars.val[1] = vqtbl1q_u8(lut, vandq_u8(v, nibble_mask));
+                vst2q_u8(reinterpret_cast<uint8_t *>(dst + 2 * i), chars);
+            }
+            hex_encode_scalar(src + i, length - i, dst + 2 * i);
+            return length * 2;
+        }
+#endif
+
+        // ---- Dispatch ------------------------------------------------------
+
+        struct Kernels
+        {
+            size_t (*hex_encode)(const uint8_t *, size_t, char *);
+            size_t (*hex_decode)(const char *, size_t, uint8_t *);
+            size_t (*base64_encode)(const uint8_t *, size_t, char *);
+            size_t (*base64_decode)(const char *, size_t, uint8_t *);
+            const char *name;
+        };
+
+        Kernels select_kernels()
+        {
+            Kernels kernels{hex_encode_scalar, hex_decode_scalar, base64_encode_scalar, base64_decode_scalar, "scalar"};
+
+#ifdef CARDANO_IOT_CODEC_X86
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("ssse3"))
+            {
+                kernels = {hex_encode_ssse3, hex_decode_ssse3, base64_encode_ssse3, base64_decode_ssse3, "ssse3"};
+            }
+            if (__builtin_cpu_supports("avx2"))
+            {
+                kernels.hex_encode = hex_encode_avx2;
+                kernels.name = "avx2";
+            }
+#elif defined(CARDANO_IOT_CODEC_NEON)
+            kernels.hex_encode = hex_encode_neon;
+            kernels.name = "neon";
+#endif
+            return kernels;
+        }
+
+        const Kernels &kernels()
+        {
+            static const Kernels selected = select_kernels();
+            return selected;
+        }
+    } // namespace
+
+    size_t hex_encode(const uint8_t *src, size_t length, char *dst)
+    {
+        return kernels().hex_encode(src, length, dst);
+    }
+
+    size_t hex_decode(const char *src, size_t length, uint8_t *dst)
+    {
+        return kernels().hex_decode(src, length, dst);
+    }
+
+    size_t base64_encode(const uint8_t *src, size_t length, char *dst)
+    {
+        return kernels().base64_encode(src, length, dst);
+    }
+
+    size_t base64_decode(const char *src, size_t length, uint8_t *dst)
+    {
+        return kernels().base64_decode(src, length, dst);
+    }
+
+    std::string hex_encode(const std::vector<uint8_t> &data)
+    {
+        std::string out(hex_encoded_size(data.size()), '\0');
+        hex_encode(data.data(), data.size(), out.data());
+        return out;
+    }
+
+    std::string hex_encode(std::string_view data)
+    {
+        std::string out(hex_encoded_size(data.size()), '\0');
+        hex_encode(reinterpret_cast<const uint8_t *>(data.data()), data.size(), out.data());
+        return out;
+    }
+
+    std::vector<uint8_t> hex_decode(std::string_view hex)
+    {
+        std::vector<uint8_t> out(hex.size() / 2);
+        size_t written = hex_decode(hex.data(), hex.size(), out.data());
+        if (written == npos)
+        {
+            return {};
+        }
+        out.resize(written);
+        return out;
+    }
+
+    std::string base64_encode(const std::vector<uint8_t> &data)
+    {
+        std::string out(base64_encoded_size(data.size()), '\0');
+        out.resize(base64_encode(data.data(), data.size(), out.data()));
+        return out;
+    }
+
+    std::vector<uint8_t> base64_decode(std::string_view encoded)
+    {
+        std::vector<uint8_t> out(base64_decoded_max_size(encoded.size()));
+        size_t written = base64_decode(encoded.data(), encoded.size(), out.data());
+        if (written == npos)
+        {
+            return {};
+        }
+        out.resize(written);
+        return out;
+    }
+
+    const char *active_implementation()
+    {
+        return kernels().name;
+    }
+
+} // namespace cardano_iot::utils::codec
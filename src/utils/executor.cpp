@@ -0,0 +1,330 @@
+/**
+ * @file executor.cpp
+ * @brief Implementation of the work-stealing executor
+ *
+ * @author Cardano IoT SDK Team
+ * @version 1.0.0
+ */
+
+#include "cardano_iot/utils/executor.h"
+#include "cardano_iot/utils/logger.h"
+#include "cardano_iot/utils/metrics.h"
+
+#include <deque>
+#include <thread>
+
+#include <pthread.h>
+#include <sched.h>
+
+namespace cardano_iot::utils
+{
+
+    namespace
+    {
+        constexpr size_t LANES = 2;
+        constexpr auto IDLE_WAIT = std::chrono::milliseconds(10); // Upper bound on a missed wake-up
+
+        size_t lane_of(TaskPriority priority)
+        {
+            return priority == TaskPriority::CRITICAL ? 0 : 1;
+        }
+    } // namespace
+
+    class Executor::Impl
+    {
+    public:
+        using Task = std::function<void()>;
+
+        struct Lanes
+        {
+            std::mutex mutex;
+            std::deque<Task> queues[LANES];
+        };
+
+        struct Worker
+        {
+            Lanes lanes;
+            std::thread thread;
+        };
+
+        ExecutorOptions options_;
+        std::vector<std::unique_ptr<Worker>> workers_;
+        Lanes injector_; // Tasks posted from outside the pool
+
+        std::atomic<bool> accepting_{true};
+        std::atomic<bool> stopping_{false};
+        std::atomic<bool> drop_queued_{false};
+        std::atomic<uint64_t> queued_{0}; // Posted and not yet started
+        std::atomic<size_t> sleepers_{0};
+        std::mutex sleep_mutex_;
+        std::condition_variable sleep_cv_;
+        std::mutex shutdown_mutex_;
+
+        metrics::Counter executed_critical_{"cardano_iot_executor_tasks_total", "Executor tasks run by lane", {{"lane", "critical"}}};
+        metrics::Counter executed_bulk_{"cardano_iot_executor_tasks_total", "Executor tasks run by lane", {{"lane", "bulk"}}};
+        metrics::Counter stolen_{"cardano_iot_executor_steals_total", "Tasks taken from another worker's deque"};
+        metrics::Gauge queue_depth_{"cardano_iot_executor_queue_depth", "Executor tasks waiting to start"};
+
+        // The worker the calling thread is, if any
+        static thread_local Impl *current_pool_;
+        static thread_local size_t current_index_;
+
+        void start()
+        {
+            size_t threads = options_.threads;
+            if (threads == 0)
+            {
+                threads = std::max(1u, std::thread::hardware_concurrency());
+            }
+            workers_.reserve(threads);
+            for (size_t i = 0; i < threads; ++i)
+            {
+                workers_.push_back(std::make_unique<Worker>());
+            }
+            // Workers start only once every deque exists, since they steal from all of them
+            for (size_t i = 0; i < threads; ++i)
+            {
+                workers_[i]->thread = std::thread(&Impl::worker_loop, this, i);
+            }
+            utils::Logger::instance().log(utils::LogLevel::INFO, "Executor",
+                                          "Started with " + std::to_string(threads) + " workers" +
+                                              (options_.pin_threads ? " (pinned)" : ""));
+        }
+
+        bool push(Task task, TaskPriority priority)
+        {
+            if (!accepting_.load(std::memory_order_acquire))
+            {
+                return false;
+            }
+            Lanes &target = current_pool_ == this ? workers_[current_index_]->lanes : injector_;
+            {
+                std::lock_guard<std::mutex> lock(target.mutex);
+                target.queues[lane_of(priority)].push_back(std::move(task));
+            }
+            queued_.fetch_add(1);
+            queue_depth_.add(1);
+            if (sleepers_.load() > 0)
+            {
+                std::lock_guard<std::mutex> lock(sleep_mutex_);
+                sleep_cv_.notify_one();
+            }
+            return true;
+        }
+
+        // Owner pops newest (cache-warm), thieves and the injector hand out oldest (fair)
+        static bool pop(Lanes &lanes, size_t lane, bool newest, Task &task)
+        {
+            std::lock_guard<std::mutex> lock(lanes.mutex);
+            auto &queue = lanes.queues[lane];
+            if (queue.empty())
+            {
+                return false;
+            }
+            if (newest)
+            {
+                task = std::move(queue.back());
+                queue.pop_back();
+            }
+            else
+            {
+                task = std::move(queue.front());
+                queue.pop_front();
+            }
+            return true;
+        }
+
+        /**
+         * @brief Next task for a worker (index < size) or for a helping outsider (index == size)
+         */
+        bool find_task(size_t index, Task &task, size_t &lane)
+        {
+            if (queued_.load() == 0)
+            {
+                return false;
+            }
+            const size_t count = workers_.size();
+            for (lane = 0; lane < LANES; ++lane)
+            {
+                if (index < count && pop(workers_[index]->lanes, lane, true, task))
+                {
+                    return true;
+                }
+                if (pop(injector_, lane, false, task))
+                {
+                    return true;
+                }
+                for (size_t offset = 1; offset <= count; ++offset)
+                {
+                    const size_t victim = (index + offset) % count;
+                    if (victim != index && pop(workers_[victim]->lanes, lane, false, task))
+                    {
+                        stolen_.inc();
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+        void run(Task &task, size_t lane)
+        {
+            queued_.fetch_sub(1);
+            queue_depth_.add(-1);
+            if (drop_queued_.load(std::memory_order_relaxed))
+            {
+                task = nullptr; // Destroying the task fails its future
+                return;
+            }
+            try
+            {
+                task();
+            }
+            catch (...)
+            {
+                utils::Logger::instance().log(utils::LogLevel::ERROR, "Executor", "Task threw; exception discarded");
+            }
+            task = nullptr; // Release captures before counting the task as done
+            (lane == 0 ? executed_critical_ : executed_bulk_).inc();
+        }
+
+        bool run_one(size_t index)
+        {
+            Task task;
+            size_t lane = 0;
+            if (!find_task(index, task, lane))
+            {
+                return false;
+            }
+            run(task, lane);
+            return true;
+        }
+
+        void pin(size_t index)
+        {
+            const std::string name = options_.name.substr(0, 11) + "-" + std::to_string(index);
+            pthread_setname_np(pthread_self(), name.c_str());
+            if (!options_.pin_threads)
+            {
+                return;
+            }
+            const unsigned cpus = std::max(1u, std::thread::hardware_concurrency());
+            const int cpu = options_.cpus.empty() ? static_cast<int>(index % cpus)
+                                                  : options_.cpus[index % options_.cpus.size()];
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cpu, &set);
+            if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0)
+            {
+                utils::Logger::instance().log(utils::LogLevel::WARNING, "Executor",
+                                              "Could not pin worker " + std::to_string(index) + " to CPU " + std::to_string(cpu));
+            }
+        }
+
+        void worker_loop(size_t index)
+        {
+            current_pool_ = this;
+            current_index_ = index;
+            pin(index);
+            while (true)
+            {
+                if (run_one(index))
+                {
+                    continue;
+                }
+                if (stopping_.load(std::memory_order_acquire) && queued_.load() == 0)
+                {
+                    break;
+                }
+                std::unique_lock<std::mutex> lock(sleep_mutex_);
+                sleepers_.fetch_add(1);
+                sleep_cv_.wait_for(lock, IDLE_WAIT, [this]
+                                   { return queued_.load() > 0 || stopping_.load(); });
+                sleepers_.fetch_sub(1);
+            }
+            current_pool_ = nullptr;
+        }
+
+        void shutdown(bool drain)
+        {
+            std::lock_guard<std::mutex> guard(shutdown_mutex_);
+            accepting_.store(false, std::memory_order_release);
+            if (!drain)
+            {
+                drop_queued_.store(true);
+            }
+            {
+                std::lock_guard<std::mutex> lock(sleep_mutex_);
+                stopping_.store(true, std::memory_order_release);
+            }
+            sleep_cv_.notify_all();
+            for (auto &worker : workers_)
+            {
+                if (worker->thread.joinable())
+                {
+                    if (worker->thread.get_id() == std::this_thread::get_id())
+                    {
+                        worker->thread.detach(); // Shut down from one of our own tasks
+                        continue;
+                    }
+                    worker->thread.join();
+                }
+            }
+        }
+    };
+
+    thread_local Executor::Impl *Executor::Impl::current_pool_ = nullptr;
+    thread_local size_t Executor::Impl::current_index_ = 0;
+
+    namespace detail
+    {
+        bool help_current_executor()
+        {
+            Executor::Impl *pool = Executor::Impl::current_pool_;
+            return pool != nullptr && pool->run_one(Executor::Impl::current_index_);
+        }
+    } // namespace detail
+
+    Executor::Executor(const ExecutorOptions &options) : pimpl_(std::make_unique<Impl>())
+    {
+        pimpl_->options_ = options;
+        pimpl_->start();
+    }
+
+    Executor::~Executor()
+    {
+        shutdown(true);
+    }
+
+    bool Executor::post(std::function<void()> task, TaskPriority priority)
+    {
+        return task && pimpl_->push(std::move(task), priority);
+    }
+
+    size_t Executor::thread_count() const
+    {
+        return pimpl_->workers_.size();
+    }
+
+    bool Executor::in_worker() const
+    {
+        return Impl::current_pool_ == pimpl_.get();
+    }
+
+    void Executor::shutdown(bool drain)
+    {
+        pimpl_->shutdown(drain);
+    }
+
+    Executor::Statistics Executor::get_statistics() const
+    {
+        Statistics stats{};
+        stats.threads = pimpl_->workers_.size();
+        stats.executed_critical = pimpl_->executed_critical_.value();
+        stats.executed_bulk = pimpl_->executed_bulk_.value();
+        stats.stolen = pimpl_->stolen_.value();
+        stats.queued = pimpl_->queued_.load();
+        return stats;
+    }
+
+} // namespace cardano_iot::utils
@@ -0,0 +1,669 @@
+/**
+ * @file hash.cpp
+ * @brief Incremental, tree and multi-buffer hashing
+ *
+ * @author Cardano IoT SDK Team
+ * @version 1.0.0
+ */
+
+#include "cardano_iot/utils/hash.h"
+
+#include <openssl/core_names.h>
+#include <openssl/evp.h>
+#include <openssl/opensslv.h>
+#include <openssl/params.h>
+#include <openssl/sha.h>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace cardano_iot::utils
+{
+
+    namespace
+    {
+        constexpr uint8_t LEAF_PREFIX = 0x00;
+        constexpr uint8_t PARENT_PREFIX = 0x01;
+
+        struct Crc32Table
+        {
+            std::array<uint32_t, 256> entries{};
+
+            constexpr Crc32Table()
+            {
+                for (uint32_t i = 0; i < 256; ++i)
+                {
+                    uint32_t c = i;
+                    for (int k = 0; k < 8; ++k)
+                    {
+                        c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                    }
+                    entries[i] = c;
+                }
+            }
+        };
+        constexpr Crc32Table CRC32;
+
+        // Inputs per worker below which hash_many does not bother with threads
+        constexpr size_t MIN_INPUTS_PER_THREAD = 64;
+        constexpr size_t FILE_READ_BYTES = 1024 * 1024;
+
+#if OPENSSL_VERSION_NUMBER >= 0x30200000L
+        constexpr bool NATIVE_BLAKE2B_256 = true; // BLAKE2B-512 takes a digest size parameter from 3.2 on
+#else
+        constexpr bool NATIVE_BLAKE2B_256 = false;
+#endif
+        constexpr size_t ALGORITHMS = 6;
+
+        bool builtin_blake2b(HashAlgorithm algorithm)
+        {
+            return algorithm == HashAlgorithm::BLAKE2B_256 && !NATIVE_BLAKE2B_256;
+        }
+
+        // BLAKE2b (RFC 7693), unkeyed, for OpenSSL releases without a variable digest size
+        class Blake2b
+        {
+        public:
+            explicit Blake2b(size_t digest_bytes) : digest_bytes_(digest_bytes) { reset(); }
+
+            void reset()
+            {
+                std::copy(IV, IV + 8, h_);
+                h_[0] ^= 0x01010000u ^ digest_bytes_;
+                t_[0] = t_[1] = 0;
+                fill_ = 0;
+            }
+
+            void update(const uint8_t *data, size_t size)
+            {
+                while (size > 0)
+                {
+                    // The last block is compressed in final(), so flush only when more input follows
+                    if (fill_ == BLOCK)
+                    {
+                        add_counter(BLOCK);
+                        compress(false);
+                        fill_ = 0;
+                    }
+                    const size_t take = std::min(size, BLOCK - fill_);
+                    std::memcpy(block_ + fill_, data, take);
+                    fill_ += take;
+                    data += take;
+                    size -= take;
+                }
+            }
+
+            void final(uint8_t *out)
+            {
+                add_counter(fill_);
+                std::memset(block_ + fill_, 0, BLOCK - fill_);
+                compress(true);
+                for (size_t i = 0; i < digest_bytes_; ++i)
+                {
+                    out[i] = static_cast<uint8_t>(h_[i / 8] >> (8 * (i % 8)));
+                }
+                reset();
+            }
+
+        private:
+            static constexpr size_t BLOCK = 128;
+            static constexpr uint64_t IV[8] = {
+                0x6a09e667f3bcc908ull, 0xbb67ae8584caa73bull, 0x3c6ef372fe94f82bull, 0xa54ff53a5f1d36f1ull,
+                0x510e527fade682d1ull, 0x9b05688c2b3e6c1full, 0x1f83d9abfb41bd6bull, 0x5be0cd19137e2179ull};
+            static constexpr uint8_t SIGMA[12][16] = {
+                {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+                {14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3},
+                {11, 8, 12, 0, 5, 2, 15, 13, 10, 14, 3, 6, 7, 1, 9, 4},
+                {7, 9, 3, 1, 13, 12, 11, 14, 2, 6, 5, 10, 4, 0, 15, 8},
+                {9, 0, 5, 7, 2, 4, 10, 15, 14, 1, 11, 12, 6, 8, 3, 13},
+                {2, 12, 6, 10, 0, 11, 8, 3, 4, 13, 7, 5, 15, 14, 1, 9},
+                {12, 5, 1, 15, 14, 13, 4, 10, 0, 7, 6, 3, 9, 2, 8, 11},
+                {13, 11, 7, 14, 12, 1, 3, 9, 5, 0, 15, 4, 8, 6, 2, 10},
+                {6, 15, 14, 9, 11, 3, 0, 8, 12, 2, 13, 7, 1, 4, 10, 5},
+                {10, 2, 8, 4, 7, 6, 1, 5, 15, 11, 9, 14, 3, 12, 13, 0},
+                {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+                {14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3}};
+
+            size_t digest_bytes_;
+            uint64_t h_[8];
+            uint64_t t_[2];
+            uint8_t block_[BLOCK];
+            size_t fill_;
+
+            static uint64_t rotr(uint64_t x, int n) { return (x >> n) | (x << (64 - n)); }
+
+            void add_counter(size_t bytes)
+            {
+                t_[0] += bytes;
+                if (t_[0] < bytes)
+                {
+                    ++t_[1];
+                }
+            }
+
+            void compress(bool last)
+            {
+                uint64_t m[16];
+                for (size_t i = 0; i < 16; ++i)
+                {
+                    m[i] = 0;
+                    for (size_t b = 0; b < 8; ++b)
+                    {
+                        m[i] |= static_cast<uint64_t>(block_[i * 8 + b]) << (8 * b);
+                    }
+                }
+                uint64_t v[16];
+                std::copy(h_, h_ + 8, v);
+                std::copy(IV, IV + 8, v + 8);
+                v[12] ^= t_[0];
+                v[13] ^= t_[1];
+                if (last)
+                {
+                    v[14] = ~v[14];
+                }
+
+                auto mix = [&v](int a, int b, int c, int d, uint64_t x, uint64_t y)
+                {
+                    v[a] = v[a] + v[b] + x;
+                    v[d] = rotr(v[d] ^ v[a], 32);
+                    v[c] = v[c] + v[d];
+                    v[b] = rotr(v[b] ^ v[c], 24);
+                    v[a] = v[a] + v[b] + y;
+                    v[d] = rotr(v[d] ^ v[a], 16);
+                    v[c] = v[c] + v[d];
+                    v[b] = rotr(v[b] ^ v[c], 63);
+                };
+                for (const auto &s : SIGMA)
+                {
+                    mix(0, 4, 8, 12, m[s[0]], m[s[1]]);
+                    mix(1, 5, 9, 13, m[s[2]], m[s[3]]);
+                    mix(2, 6, 10, 14, m[s[4]], m[s[5]]);
+                    mix(3, 7, 11, 15, m[s[6]], m[s[7]]);
+                    mix(0, 5, 10, 15, m[s[8]], m[s[9]]);
+                    mix(1, 6, 11, 12, m[s[10]], m[s[11]]);
+                    mix(2, 7, 8, 13, m[s[12]], m[s[13]]);
+                    mix(3, 4, 9, 14, m[s[14]], m[s[15]]);
+                }
+                for (size_t i = 0; i < 8; ++i)
+                {
+                    h_[i] ^= v[i] ^ v[i + 8];
+                }
+            }
+        };
+
+        void free_context(HashAlgorithm algorithm, void *context)
+        {
+            if (builtin_blake2b(algorithm))
+            {
+                delete static_cast<Blake2b *>(context);
+                return;
+            }
+            EVP_MD_CTX_free(static_cast<EVP_MD_CTX *>(context));
+        }
+
+        // Fetched once and kept for the life of the process, so no Init pays for a provider lookup
+        const EVP_MD *message_digest(HashAlgorithm algorithm)
+        {
+            static const std::array<const EVP_MD *, ALGORITHMS> digests = {
+                EVP_MD_fetch(nullptr, "SHA256", nullptr),
+                EVP_MD_fetch(nullptr, "SHA512", nullptr),
+                EVP_MD_fetch(nullptr, "BLAKE2B-512", nullptr),
+                EVP_MD_fetch(nullptr, "BLAKE2S-256", nullptr),
+                EVP_MD_fetch(nullptr, "SHA3-256", nullptr),
+                NATIVE_BLAKE2B_256 ? EVP_MD_fetch(nullptr, "BLAKE2B-512", nullptr) : nullptr,
+            };
+            return digests[static_cast<size_t>(algorithm)];
+        }
+
+        Hasher &thread_hasher(HashAlgorithm algorithm)
+        {
+            thread_local std::array<std::unique_ptr<Hasher>, ALGORITHMS> hashers;
+            auto &slot = hashers[static_cast<size_t>(algorithm)];
+            if (!slot)
+            {
+                slot = std::make_unique<Hasher>(algorithm);
+            }
+            return *slot;
+        }
+
+        unsigned worker_count(unsigned requested)
+        {
+            return requested == 0 ? std::max(1u, std::thread::hardware_concurrency()) : requested;
+        }
+
+        using Node = std::array<uint8_t, TREE_HASH_BYTES>;
+
+        Node parent(const uint8_t *left, const uint8_t *right)
+        {
+            uint8_t input[1 + 2 * TREE_HASH_BYTES];
+            input[0] = PARENT_PREFIX;
+            std::copy(left, left + TREE_HASH_BYTES, input + 1);
+            std::copy(right, right + TREE_HASH_BYTES, input + 1 + TREE_HASH_BYTES);
+            Node node;
+            SHA256(input, sizeof(input), node.data());
+            return node;
+        }
+
+        Node leaf(Hasher &hasher, const uint8_t *data, size_t size)
+        {
+            Node node{};
+            hasher.update(&LEAF_PREFIX, 1);
+            hasher.update(data, size);
+            hasher.final(node.data());
+            return node;
+        }
+
+        // Left subtree takes the largest power of two below the leaf count
+        Node subtree(const std::vector<Node> &leaves, size_t begin, size_t end)
+        {
+            const size_t count = end - begin;
+            if (count == 1)
+            {
+                return leaves[begin];
+            }
+            size_t left = 1;
+            while (left * 2 < count)
+            {
+                left *= 2;
+            }
+            const Node l = subtree(leaves, begin, begin + left);
+            const Node r = subtree(leaves, begin + left, end);
+            return parent(l.data(), r.data());
+        }
+    } // namespace
+
+    uint32_t crc32(const void *data, size_t size, uint32_t seed)
+    {
+        const uint8_t *bytes = static_cast<const uint8_t *>(data);
+        uint32_t c = seed ^ 0xFFFFFFFFu;
+        for (size_t i = 0; i < size; ++i)
+        {
+            c = CRC32.entries[(c ^ bytes[i]) & 0xFF] ^ (c >> 8);
+        }
+        return c ^ 0xFFFFFFFFu;
+    }
+
+    size_t digest_size(HashAlgorithm algorithm)
+    {
+        switch (algorithm)
+        {
+        case HashAlgorithm::SHA512:
+        case HashAlgorithm::BLAKE2B_512:
+            return 64;
+        case HashAlgorithm::SHA256:
+        case HashAlgorithm::BLAKE2S_256:
+        case HashAlgorithm::SHA3_256:
+        case HashAlgorithm::BLAKE2B_256:
+        default:
+            return 32;
+        }
+    }
+
+    bool parse_hash_algorithm(const std::string &name, HashAlgorithm &algorithm)
+    {
+        std::string key;
+        for (char c : name)
+        {
+            if (c != '-' && c != '_')
+            {
+                key.push_back(static_cast<char>(std::toupper(static_cast<unsigned char>(c))));
+            }
+        }
+        if (key == "SHA256")
+        {
+            algorithm = HashAlgorithm::SHA256;
+        }
+        else if (key == "SHA512")
+        {
+            algorithm = HashAlgorithm::SHA512;
+        }
+        else if (key == "BLAKE2B" || key == "BLAKE2B512")
+        {
+            algorithm = HashAlgorithm::BLAKE2B_512;
+        }
+        else if (key == "BLAKE2S" || key == "BLAKE2S256")
+        {
+            algorithm = HashAlgorithm::BLAKE2S_256;
+        }
+        else if (key == "SHA3" || key == "SHA3256")
+        {
+            algorithm = HashAlgorithm::SHA3_256;
+        }
+        else if (key == "BLAKE2B256")
+        {
+            algorithm = HashAlgorithm::BLAKE2B_256;
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    }
+
+    Hasher::Hasher(HashAlgorithm algorithm)
+        : algorithm_(algorithm),
+          context_(builtin_blake2b(algorithm) ? static_cast<void *>(new Blake2b(digest_size()))
+                                              : static_cast<void *>(EVP_MD_CTX_new()))
+    {
+    }
+
+    Hasher::~Hasher()
+    {
+        free_context(algorithm_, context_);
+    }
+
+    Hasher::Hasher(Hasher &&other) noexcept
+        : algorithm_(other.algorithm_), context_(other.context_), started_(other.started_)
+    {
+        other.context_ = nullptr;
+        other.started_ = false;
+    }
+
+    Hasher &Hasher::operator=(Hasher &&other) noexcept
+    {
+        if (this != &other)
+        {
+            free_context(algorithm_, context_);
+            algorithm_ = other.algorithm_;
+            context_ = other.context_;
+            started_ = other.started_;
+            other.context_ = nullptr;
+            other.started_ = false;
+        }
+        return *this;
+    }
+
+    bool Hasher::start()
+    {
+        if (!started_ && builtin_blake2b(algorithm_))
+        {
+            started_ = context_ != nullptr;
+            if (started_)
+            {
+                static_cast<Blake2b *>(context_)->reset();
+            }
+        }
+        else if (!started_)
+        {
+            const EVP_MD *md = message_digest(algorithm_);
+            size_t size = digest_size();
+            const OSSL_PARAM sized[] = {OSSL_PARAM_construct_size_t(OSSL_DIGEST_PARAM_SIZE, &size),
+                                        OSSL_PARAM_construct_end()};
+            const OSSL_PARAM *params = algorithm_ == HashAlgorithm::BLAKE2B_256 ? sized : nullptr;
+            started_ = context_ && md &&
+                       EVP_DigestInit_ex2(static_cast<EVP_MD_CTX *>(context_), md, params) == 1;
+        }
+        return started_;
+    }
+
+    bool Hasher::update(const void *data, size_t size)
+    {
+        if (!start())
+        {
+            return false;
+        }
+        if (builtin_blake2b(algorithm_))
+        {
+            static_cast<Blake2b *>(context_)->update(static_cast<const uint8_t *>(data), size);
+            return true;
+        }
+        return size == 0 || EVP_DigestUpdate(static_cast<EVP_MD_CTX *>(context_), data, size) == 1;
+    }
+
+    bool Hasher::final(uint8_t *out)
+    {
+        bool ok = start();
+        if (ok && builtin_blake2b(algorithm_))
+        {
+            static_cast<Blake2b *>(context_)->final(out);
+        }
+        else
+        {
+            ok = ok && EVP_DigestFinal_ex(static_cast<EVP_MD_CTX *>(context_), out, nullptr) == 1;
+        }
+        started_ = false;
+        return ok;
+    }
+
+    std::vector<uint8_t> Hasher::final()
+    {
+        std::vector<uint8_t> out(digest_size());
+        if (!final(out.data()))
+        {
+            out.clear();
+        }
+        return out;
+    }
+
+    void Hasher::reset()
+    {
+        started_ = false;
+    }
+
+    std::vector<uint8_t> Hasher::digest(HashAlgorithm algorithm, const void *data, size_t size)
+    {
+        Hasher &hasher = thread_hasher(algorithm);
+        hasher.reset();
+        if (!hasher.update(data, size))
+        {
+            return {};
+        }
+        return hasher.final();
+    }
+
+    bool hash_many(HashAlgorithm algorithm, const ByteRange *inputs, size_t count, uint8_t *out, unsigned threads)
+    {
+        const size_t stride = digest_size(algorithm);
+        auto run = [&](size_t begin, size_t end)
+        {
+            Hasher &hasher = thread_hasher(algorithm);
+            hasher.reset();
+            bool ok = true;
+            for (size_t i = begin; i < end; ++i)
+            {
+                if (!hasher.update(inputs[i].data, inputs[i].size) || !hasher.final(out + i * stride))
+                {
+                    hasher.reset();
+                    ok = false;
+                }
+            }
+            return ok;
+        };
+
+        const size_t workers = std::min<size_t>(worker_count(threads), std::max<size_t>(1, count / MIN_INPUTS_PER_THREAD));
+        if (workers <= 1)
+        {
+            return run(0, count);
+        }
+
+        std::vector<std::thread> pool;
+        std::vector<char> results(workers, 1);
+        const size_t per_worker = (count + workers - 1) / workers;
+        for (size_t w = 1; w < workers; ++w)
+        {
+            const size_t begin = std::min(count, w * per_worker);
+            const size_t end = std::min(count, begin + per_worker);
+            pool.emplace_back([&, w, begin, end]
+                              { results[w] = run(begin, end); });
+        }
+        results[0] = run(0, std::min(count, per_worker));
+        for (auto &worker : pool)
+        {
+            worker.join();
+        }
+        return std::all_of(results.begin(), results.end(), [](char ok)
+                           { return ok != 0; });
+    }
+
+    TreeHasher::TreeHasher(size_t chunk_bytes) : chunk_bytes_(std::max<size_t>(chunk_bytes, 1))
+    {
+    }
+
+    void TreeHasher::push_chunk(std::vector<uint8_t> hash)
+    {
+        // Merge every subtree that the new chunk completes, as in BLAKE3
+        uint64_t total = ++chunks_;
+        while ((total & 1) == 0)
+        {
+            const Node merged = parent(stack_.back().data(), hash.data());
+            hash.assign(merged.begin(), merged.end());
+            stack_.pop_back();
+            total >>= 1;
+        }
+        stack_.push_back(std::move(hash));
+    }
+
+    void TreeHasher::update(const void *data, size_t size)
+    {
+        const uint8_t *bytes = static_cast<const uint8_t *>(data);
+        while (size > 0)
+        {
+            if (chunk_fill_ == 0)
+            {
+                chunk_.update(&LEAF_PREFIX, 1);
+            }
+            const size_t take = std::min(size, chunk_bytes_ - chunk_fill_);
+            chunk_.update(bytes, take);
+            chunk_fill_ += take;
+            bytes += take;
+            size -= take;
+            if (chunk_fill_ == chunk_bytes_)
+            {
+                push_chunk(chunk_.final());
+                chunk_fill_ = 0;
+            }
+        }
+    }
+
+    std::vector<uint8_t> TreeHasher::final()
+    {
+        if (chunk_fill_ > 0 || chunks_ == 0)
+        {
+            if (chunk_fill_ == 0)
+            {
+                chunk_.update(&LEAF_PREFIX, 1);
+            }
+            stack_.push_back(chunk_.final());
+        }
+
+        std::vector<uint8_t> root = std::move(stack_.back());
+        stack_.pop_back();
+        while (!stack_.empty())
+        {
+            const Node merged = parent(stack_.back().data(), root.data());
+            root.assign(merged.begin(), merged.end());
+            stack_.pop_back();
+        }
+        chunk_fill_ = 0;
+        chunks_ = 0;
+        return root;
+    }
+
+    std::vector<uint8_t> tree_hash(const void *data, size_t size, const TreeHashOptions &options)
+    {
+        const uint8_t *bytes = static_cast<const uint8_t *>(data);
+        const size_t chunk_bytes = std::max<size_t>(options.chunk_bytes, 1);
+        const size_t chunks = std::max<size_t>(1, (size + chunk_bytes - 1) / chunk_bytes);
+
+        std::vector<Node> leaves(chunks);
+        auto run = [&](size_t begin, size_t end)
+        {
+            Hasher &hasher = thread_hasher(HashAlgorithm::SHA256);
+            hasher.reset();
+            for (size_t i = begin; i < end; ++i)
+            {
+                const size_t offset = i * chunk_bytes;
+                leaves[i] = leaf(hasher, bytes + offset, std::min(chunk_bytes, size - offset));
+            }
+        };
+
+        // Contiguous ranges per worker keep each thread streaming through memory
+        const size_t workers = std::min<size_t>(worker_count(options.threads), chunks);
+        if (workers <= 1)
+        {
+            run(0, chunks);
+        }
+        else
+        {
+            std::vector<std::thread> pool;
+            const size_t per_worker = (chunks + workers - 1) / workers;
+            for (size_t w = 1; w < workers; ++w)
+            {
+                const size_t begin = std::min(chunks, w * per_worker);
+                pool.emplace_back(run, begin, std::min(chunks, begin + per_worker));
+            }
+            run(0, std::min(chunks, per_worker));
+            for (auto &worker : pool)
+            {
+                worker.join();
+            }
+        }
+
+        const Node root = subtree(leaves, 0, chunks);
+        return std::vector<uint8_t>(root.begin(), root.end());
+    }
+
+    std::vector<uint8_t> tree_hash_file(const std::string &path, const TreeHashOptions &options)
+    {
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            return {};
+        }
+        struct stat info;
+        if (::fstat(fd, &info) != 0)
+        {
+            ::close(fd);
+            return {};
+        }
+
+        const size_t size = static_cast<size_t>(info.st_size);
+        if (size > 0)
+        {
+            void *map = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (map != MAP_FAILED)
+            {
+                ::close(fd);
+                ::madvise(map, size, MADV_SEQUENTIAL);
+                std::vector<uint8_t> root = tree_hash(map, size, options);
+                ::munmap(map, size);
+                return root;
+            }
+        }
+
+        // Not mappable (a pipe, or mmap refused): stream it
+        TreeHasher hasher(options.chunk_bytes);
+        std::vector<uint8_t> buffer(FILE_READ_BYTES);
+        for (;;)
+        {
+            const ssize_t n = ::read(fd, buffer.data(), buffer.size());
+            if (n < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (n < 0)
+            {
+                ::close(fd);
+                return {};
+            }
+            if (n == 0)
+            {
+                break;
+            }
+            hasher.update(buffer.data(), static_cast<size_t>(n));
+        }
+        ::close(fd);
+        return hasher.final();
+    }
+
+} // namespace cardano_iot::utils
@@ -10,41 +10,360 @@
 
 #include <iostream>
 #include <fstream>
-#include <sstream>
-#include <iomanip>
+#include <algorithm>
 #include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <ctime>
 #include <mutex>
 #include <thread>
 
 namespace cardano_iot::utils
 {
 
+    namespace
+    {
+        struct LogRecord
+        {
+            LogLevel level = LogLevel::INFO;
+            std::chrono::system_clock::time_point time;
+            size_t thread_hash = 0;
+            std::string module;
+            std::string message;
+        };
+
+        /**
+         * @brief Bounded multi-producer/single-consumer ring (Vyukov sequence slots)
+         */
+        class LogRing
+        {
+        public:
+            explicit LogRing(size_t capacity)
+            {
+                size_t size = 2;
+                while (size < capacity)
+                {
+                    size <<= 1;
+                }
+                mask_ = size - 1;
+                cells_ = std::make_unique<Cell[]>(size);
+                for (size_t i = 0; i < size; ++i)
+                {
+                    cells_[i].sequence.store(i, std::memory_order_relaxed);
+                }
+            }
+
+            bool try_push(LogRecord &record)
+            {
+                size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+                Cell *cell;
+                for (;;)
+                {
+                    cell = &cells_[pos & mask_];
+                    const size_t seq = cell->sequence.load(std::memory_order_acquire);
+                    const auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+                    if (diff == 0)
+                    {
+                        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        {
+                            break;
+                        }
+                    }
+                    else if (diff < 0)
+                    {
+                        return false; // full
+                    }
+                    else
+                    {
+                        pos = enqueue_pos_.load(std::memory_order_relaxed);
+                    }
+                }
+                cell->record = std::move(record);
+                cell->sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+
+            // Single consumer only
+            bool try_pop(LogRecord &record)
+            {
+                Cell &cell = cells_[dequeue_pos_ & mask_];
+                if (cell.sequence.load(std::memory_order_acquire) != dequeue_pos_ + 1)
+                {
+                    return false;
+                }
+                record = std::move(cell.record);
+                cell.sequence.store(dequeue_pos_ + mask_ + 1, std::memory_order_release);
+                ++dequeue_pos_;
+                return true;
+            }
+
+            size_t enqueued() const { return enqueue_pos_.load(std::memory_order_acquire); }
+
+        private:
+            struct Cell
+            {
+                std::atomic<size_t> sequence{0};
+                LogRecord record;
+            };
+
+            std::unique_ptr<Cell[]> cells_;
+            size_t mask_ = 0;
+            alignas(64) std::atomic<size_t> enqueue_pos_{0};
+            alignas(64) size_t dequeue_pos_ = 0;
+        };
+    } // namespace
+
     class Logger::Impl
     {
     public:
-        LogLevel current_level_ = LogLevel::INFO;
-        bool console_enabled_ = true;
+        std::atomic<bool> console_enabled_{true};
         std::string file_path_;
         std::ofstream log_file_;
+        size_t file_size_bytes_ = 0;
         std::mutex log_mutex_;
         size_t max_file_size_bytes_ = 5 * 1024 * 1024; // 5MB default
         size_t max_backup_files_ = 3;                  // keep up to 3 backups
 
-        std::string get_timestamp()
+        // Async mode
+        std::atomic<LogRing *> ring_{nullptr};
+        std::unique_ptr<LogRing> ring_storage_;
+        LogOverflowPolicy overflow_policy_ = LogOverflowPolicy::DROP;
+        std::atomic<uint32_t> flush_interval_ms_{50}; // Adjustable while the writer runs
+        std::thread writer_thread_;
+        std::atomic<bool> writer_running_{false};
+        std::atomic<int> active_producers_{0};
+        std::atomic<size_t> written_{0};
+        std::atomic<uint64_t> dropped_{0};
+        std::mutex writer_mutex_;
+        std::condition_variable writer_cv_;
+        std::condition_variable flushed_cv_;
+        std::mutex async_control_mutex_;
+
+        // Cached "%Y-%m-%d %H:%M:%S" for the last formatted second
+        std::time_t cached_second_ = -1;
+        char cached_time_[32] = {};
+
+        ~Impl()
+        {
+            stop_async();
+        }
+
+        void format_timestamp(std::chrono::system_clock::time_point now, std::string &out)
         {
-            auto now = std::chrono::system_clock::now();
             auto time_t = std::chrono::system_clock::to_time_t(now);
             auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
                           now.time_since_epoch()) %
                       1000;
 
-            std::stringstream ss;
-            ss << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S");
-            ss << '.' << std::setfill('0') << std::setw(3) << ms.count();
-            return ss.str();
+            if (time_t != cached_second_)
+            {
+                std::tm tm_buf{};
+                localtime_r(&time_t, &tm_buf);
+                std::strftime(cached_time_, sizeof(cached_time_), "%Y-%m-%d %H:%M:%S", &tm_buf);
+                cached_second_ = time_t;
+            }
+
+            char millis[8];
+            std::snprintf(millis, sizeof(millis), ".%03d", static_cast<int>(ms.count()));
+            out += cached_time_;
+            out += millis;
         }
 
-        std::string get_level_string(LogLevel level)
+        // Caller must hold log_mutex_ (the timestamp cache is shared)
+        void format_line(const LogRecord &record, std::string &out)
+        {
+            out += '[';
+            format_timestamp(record.time, out);
+            out += "] [";
+            out += get_level_string(record.level);
+            out += "] [";
+            out += record.module;
+            if (record.module.size() < 8)
+            {
+                out.append(8 - record.module.size(), ' ');
+            }
+            out += "] [T-";
+            const std::string thread_id = std::to_string(record.thread_hash % 10000);
+            out += thread_id;
+            if (thread_id.size() < 4)
+            {
+                out.append(4 - thread_id.size(), '0');
+            }
+            out += "] ";
+            out += record.message;
+        }
+
+        // Caller must hold log_mutex_
+        void write_record_unlocked(const LogRecord &record, std::string &console_out, std::string &file_out)
+        {
+            const size_t line_start = file_out.size();
+            format_line(record, file_out);
+            if (console_enabled_.load(std::memory_order_relaxed))
+            {
+                console_out += get_level_color(record.level);
+                console_out += get_cyberpunk_prefix(record.level);
+                console_out += ' ';
+                console_out.append(file_out, line_start, std::string::npos);
+                console_out += "\033[0m\n";
+            }
+            file_out += '\n';
+        }
+
+        // Caller must hold log_mutex_
+        void emit_unlocked(const std::string &console_out, const std::string &file_out)
+        {
+            if (!console_out.empty())
+            {
+                std::cout.write(console_out.data(), static_cast<std::streamsize>(console_out.size()));
+                std::cout.flush();
+            }
+            if (log_file_.is_open() && !file_out.empty())
+            {
+                log_file_.write(file_out.data(), static_cast<std::streamsize>(file_out.size()));
+                log_file_.flush();
+                file_size_bytes_ += file_out.size();
+                rotate_if_needed_unlocked();
+            }
+        }
+
+        void writer_loop(LogRing *ring)
+        {
+            std::string console_out;
+            std::string file_out;
+            LogRecord record;
+
+            for (;;)
+            {
+                const bool running = writer_running_.load(std::memory_order_acquire);
+
+                size_t batch = 0;
+                {
+                    std::lock_guard<std::mutex> lock(log_mutex_);
+                    console_out.clear();
+                    file_out.clear();
+                    while (batch < kMaxBatch && ring->try_pop(record))
+                    {
+                        write_record_unlocked(record, console_out, file_out);
+                        ++batch;
+                    }
+                    if (batch > 0)
+                    {
+                        emit_unlocked(console_out, file_out);
+                    }
+                }
+
+                if (batch > 0)
+                {
+                    written_.fetch_add(batch, std::memory_order_release);
+                    std::lock_guard<std::mutex> lock(writer_mutex_);
+                    flushed_cv_.notify_all();
+                }
+
+                if (batch == kMaxBatch)
+                {
+                    continue;
+                }
+                if (!running)
+                {
+                    // A producer may have claimed a slot but not published it yet
+                    if (written_.load(std::memory_order_acquire) >= ring->enqueued())
+                    {
+                        break;
+                    }
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> lock(writer_mutex_);
+                writer_cv_.wait_for(lock, std::chrono::milliseconds(flush_interval_ms_.load(std::memory_order_relaxed)));
+            }
+        }
+
+        bool enqueue(LogRecord &record)
+        {
+            // Registered before the ring is loaded so stop_async() can wait for in-flight pushes
+            active_producers_.fetch_add(1);
+            LogRing *ring = ring_.load();
+            if (!ring)
+            {
+                active_producers_.fetch_sub(1);
+                return false;
+            }
+
+            bool pushed = true;
+            while (!ring->try_push(record))
+            {
+                if (overflow_policy_ == LogOverflowPolicy::DROP)
+                {
+                    dropped_.fetch_add(1, std::memory_order_relaxed);
+                    pushed = false;
+                    break;
+                }
+                writer_cv_.notify_one();
+                std::this_thread::yield();
+            }
+
+            // Wake the writer early once a full batch is waiting
+            if (pushed && ((ring->enqueued() - written_.load(std::memory_order_relaxed)) & (kWakeThreshold - 1)) == 0)
+            {
+                writer_cv_.notify_one();
+            }
+            active_producers_.fetch_sub(1);
+            return true;
+        }
+
+        void start_async(size_t capacity, LogOverflowPolicy policy, uint32_t flush_interval_ms)
+        {
+            ring_storage_ = std::make_unique<LogRing>(std::max<size_t>(capacity, 2));
+            overflow_policy_ = policy;
+            flush_interval_ms_.store(std::max<uint32_t>(flush_interval_ms, 1), std::memory_order_relaxed);
+            written_.store(0, std::memory_order_relaxed);
+            writer_running_.store(true, std::memory_order_release);
+            ring_.store(ring_storage_.get(), std::memory_order_release);
+            writer_thread_ = std::thread(&Impl::writer_loop, this, ring_storage_.get());
+        }
+
+        void stop_async()
+        {
+            if (!writer_thread_.joinable())
+            {
+                return;
+            }
+            // New records go through the synchronous path from here on
+            ring_.store(nullptr);
+            while (active_producers_.load() != 0)
+            {
+                std::this_thread::yield();
+            }
+            writer_running_.store(false, std::memory_order_release);
+            {
+                std::lock_guard<std::mutex> lock(writer_mutex_);
+                writer_cv_.notify_one();
+            }
+            writer_thread_.join();
+            ring_storage_.reset();
+        }
+
+        void wait_until_flushed()
+        {
+            LogRing *ring = ring_.load(std::memory_order_acquire);
+            if (!ring)
+            {
+                return;
+            }
+            const size_t target = ring->enqueued();
+            std::unique_lock<std::mutex> lock(writer_mutex_);
+            writer_cv_.notify_one();
+            while (written_.load(std::memory_order_acquire) < target && writer_running_.load())
+            {
+                flushed_cv_.wait_for(lock, std::chrono::milliseconds(10));
+            }
+        }
+
+        static constexpr size_t kMaxBatch = 1024;
+        static constexpr size_t kWakeThreshold = 256;
+
+        static const char *get_level_string(LogLevel level)
         {
             switch (level)
             {
@@ -65,7 +384,7 @@ namespace cardano_iot::utils
             }
         }
 
-        std::string get_level_color(LogLevel level)
+        static const char *get_level_color(LogLevel level)
         {
             switch (level)
             {
@@ -86,7 +405,7 @@ namespace cardano_iot::utils
             }
         }
 
-        std::string get_cyberpunk_prefix(LogLevel level)
+        static const char *get_cyberpunk_prefix(LogLevel level)
         {
             switch (level)
             {
@@ -109,21 +428,12 @@ namespace cardano_iot::utils
 
         void rotate_if_needed_unlocked()
         {
-            if (!log_file_.is_open() || file_path_.empty())
+            if (!log_file_.is_open() || file_path_.empty() || file_size_bytes_ < max_file_size_bytes_)
             {
                 return;
             }
             try
             {
-                log_file_.flush();
-                std::ifstream in(file_path_, std::ios::binary | std::ios::ate);
-                if (!in.is_open())
-                    return;
-                auto size = static_cast<size_t>(in.tellg());
-                in.close();
-                if (size < max_file_size_bytes_)
-                    return;
-
                 // Close current file
                 log_file_.close();
 
@@ -147,13 +457,24 @@ namespace cardano_iot::utils
                 }
 
                 // Reopen file
-                log_file_.open(file_path_, std::ios::app);
+                open_file_unlocked();
             }
             catch (...)
             {
                 // swallow rotation errors
             }
         }
+
+        void open_file_unlocked()
+        {
+            log_file_.open(file_path_, std::ios::app | std::ios::ate);
+            file_size_bytes_ = 0;
+            if (log_file_.is_open())
+            {
+                auto pos = log_file_.tellp();
+                file_size_bytes_ = pos > 0 ? static_cast<size_t>(pos) : 0;
+            }
+        }
     };
 
     Logger &Logger::instance()
@@ -169,59 +490,44 @@ namespace cardano_iot::utils
 
     void Logger::log(LogLevel level, const std::string &module, const std::string &message)
     {
-        if (!pimpl_ || level < pimpl_->current_level_)
+        if (!pimpl_ || !is_enabled(level))
         {
             return;
         }
 
-        std::lock_guard<std::mutex> lock(pimpl_->log_mutex_);
-
-        std::string timestamp = pimpl_->get_timestamp();
-        std::string level_str = pimpl_->get_level_string(level);
-        std::string thread_id = std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()) % 10000);
+        LogRecord record;
+        record.level = level;
+        record.time = std::chrono::system_clock::now();
+        record.thread_hash = std::hash<std::thread::id>{}(std::this_thread::get_id());
+        record.module = module;
+        record.message = message;
 
-        // Format log message
-        std::stringstream log_stream;
-        log_stream << "[" << timestamp << "] "
-                   << "[" << level_str << "] "
-                   << "[" << std::setw(8) << std::left << module << "] "
-                   << "[T-" << std::setw(4) << std::setfill('0') << thread_id << "] "
-                   << message;
-
-        std::string log_line = log_stream.str();
-
-        // Console output with cyberpunk styling
-        if (pimpl_->console_enabled_)
+        if (pimpl_->enqueue(record))
         {
-            std::string color = pimpl_->get_level_color(level);
-            std::string prefix = pimpl_->get_cyberpunk_prefix(level);
-            std::string reset = "\033[0m";
-
-            std::cout << color << prefix << " " << log_line << reset << std::endl;
+            if (level == LogLevel::FATAL)
+            {
+                pimpl_->wait_until_flushed();
+            }
+            return;
         }
 
-        // File output
-        if (pimpl_->log_file_.is_open())
-        {
-            pimpl_->log_file_ << log_line << std::endl;
-            pimpl_->log_file_.flush();
-            pimpl_->rotate_if_needed_unlocked();
-        }
+        std::string console_out;
+        std::string file_out;
+        std::lock_guard<std::mutex> lock(pimpl_->log_mutex_);
+        pimpl_->write_record_unlocked(record, console_out, file_out);
+        pimpl_->emit_unlocked(console_out, file_out);
     }
 
     void Logger::set_level(LogLevel level)
     {
-        if (pimpl_)
-        {
-            pimpl_->current_level_ = level;
-        }
+        level_.store(level, std::memory_order_relaxed);
     }
 
     void Logger::enable_console(bool enable)
     {
         if (pimpl_)
         {
-            pimpl_->console_enabled_ = enable;
+            pimpl_->console_enabled_.store(enable, std::memory_order_relaxed);
         }
     }
 
@@ -232,6 +538,7 @@ namespace cardano_iot::utils
             return;
         }
 
+        flush();
         std::lock_guard<std::mutex> lock(pimpl_->log_mutex_);
 
         if (pimpl_->log_file_.is_open())
@@ -243,7 +550,7 @@ namespace cardano_iot::utils
 
         if (!path.empty())
         {
-            pimpl_->log_file_.open(path, std::ios::app);
+            pimpl_->open_file_unlocked();
             if (!pimpl_->log_file_.is_open())
             {
                 std::cerr << "Failed to open log file: " << path << std::endl;
@@ -269,4 +576,45 @@ namespace cardano_iot::utils
         }
     }
 
+    void Logger::enable_async(bool enable, size_t queue_capacity, LogOverflowPolicy policy, uint32_t flush_interval_ms)
+    {
+        if (!pimpl_)
+        {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(pimpl_->async_control_mutex_);
+        pimpl_->stop_async();
+        if (enable)
+        {
+            pimpl_->start_async(queue_capacity, policy, flush_interval_ms);
+        }
+    }
+
+    void Logger::set_flush_interval(uint32_t flush_interval_ms)
+    {
+        if (pimpl_)
+        {
+            pimpl_->flush_interval_ms_.store(std::max<uint32_t>(flush_interval_ms, 1), std::memory_order_relaxed);
+        }
+    }
+
+    uint32_t Logger::flush_interval_ms() const
+    {
+        return pimpl_ ? pimpl_->flush_interval_ms_.load(std::memory_order_relaxed) : 0;
+    }
+
+    void Logger::flush()
+    {
+        if (pimpl_)
+        {
+            pimpl_->wait_until_flushed();
+        }
+    }
+
+    uint64_t Logger::dropped_count() const
+    {
+        return pimpl_ ? pimpl_->dropped_.load(std::memory_order_relaxed) : 0;
+    }
+
 } // namespace cardano_iot::utils
@@ -0,0 +1,509 @@
+/**
+ * @file metrics.cpp
+ * @brief Implementation of the metrics registry and Prometheus exposition
+ *
+ * @author Cardano IoT SDK Team
+ * @version 1.0.0
+ */
+
+#include "cardano_iot/utils/metrics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <unordered_set>
+
+namespace cardano_iot::utils::metrics
+{
+
+    namespace
+    {
+        std::string format_value(double value)
+        {
+            if (std::isnan(value))
+            {
+                return "NaN";
+            }
+            if (std::isinf(value))
+            {
+                return value > 0 ? "+Inf" : "-Inf";
+            }
+            std::ostringstream out;
+            out << std::setprecision(12) << value;
+            return out.str();
+        }
+
+        std::string escape_label(const std::string &value)
+        {
+            std::string escaped;
+            escaped.reserve(value.size());
+            for (const char c : value)
+            {
+                if (c == '\\' || c == '"')
+                {
+                    escaped += '\\';
+                    escaped += c;
+                }
+                else if (c == '\n')
+                {
+                    escaped += "\\n";
+                }
+                else
+                {
+                    escaped += c;
+                }
+            }
+            return escaped;
+        }
+
+        // {a="1",b="2"} with an optional extra label appended (used for "le")
+        std::string format_labels(const Labels &labels, const std::string &extra_name = "", const std::string &extra_value = "")
+        {
+            if (labels.empty() && extra_name.empty())
+            {
+                return "";
+            }
+            std::string out = "{";
+            bool first = true;
+            for (const auto &[name, value] : labels)
+            {
+                out += (first ? "" : ",") + name + "=\"" + escape_label(value) + "\"";
+                first = false;
+            }
+            if (!extra_name.empty())
+            {
+                out += (first ? "" : ",") + extra_name + "=\"" + extra_value + "\"";
+            }
+            return out + "}";
+        }
+
+        const char *type_name(Metric::Type type)
+        {
+            switch (type)
+            {
+            case Metric::Type::COUNTER:
+                return "counter";
+            case Metric::Type::GAUGE:
+                return "gauge";
+            case Metric::Type::HISTOGRAM:
+                return "histogram";
+            default:
+                return "untyped";
+            }
+        }
+
+        // One exposed series: the sum of every live metric with the same name and labels
+        struct Aggregate
+        {
+            double value = 0.0;
+            Histogram::Snapshot histogram;
+            bool has_histogram = false;
+        };
+
+        void accumulate(const Metric &metric, Aggregate &aggregate)
+        {
+            switch (metric.type())
+            {
+            case Metric::Type::COUNTER:
+                aggregate.value += static_cast<double>(static_cast<const Counter &>(metric).value());
+                break;
+            case Metric::Type::GAUGE:
+                aggregate.value += static_cast<double>(static_cast<const Gauge &>(metric).value());
+                break;
+            case Metric::Type::HISTOGRAM:
+            {
+                const auto snapshot = static_cast<const Histogram &>(metric).snapshot();
+                if (!aggregate.has_histogram)
+                {
+                    aggregate.histogram = snapshot;
+                    aggregate.has_histogram = true;
+                }
+                else
+                {
+                    aggregate.histogram.merge(snapshot);
+                }
+                aggregate.value = static_cast<double>(aggregate.histogram.count);
+                break;
+            }
+            }
+        }
+    } // namespace
+
+    size_t this_thread_stripe()
+    {
+        static std::atomic<size_t> next{0};
+        thread_local const size_t stripe = next.fetch_add(1, std::memory_order_relaxed) % STRIPES;
+        return stripe;
+    }
+
+    Metric::Metric(Type type, std::string name, std::string help, Labels labels)
+        : type_(type), name_(std::move(name)), help_(std::move(help)), labels_(std::move(labels))
+    {
+    }
+
+    Metric::~Metric() = default;
+
+    void Metric::enroll()
+    {
+        Registry::instance().add(this);
+    }
+
+    void Metric::withdraw()
+    {
+        Registry::instance().remove(this);
+    }
+
+    Counter::Counter(std::string name, std::string help, Labels labels)
+        : Metric(Type::COUNTER, std::move(name), std::move(help), std::move(labels))
+    {
+        enroll();
+    }
+
+    Counter::~Counter()
+    {
+        withdraw();
+    }
+
+    uint64_t Counter::value() const
+    {
+        uint64_t total = 0;
+        for (const auto &cell : cells_)
+        {
+            total += cell.value.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    void Counter::reset()
+    {
+        for (auto &cell : cells_)
+        {
+            cell.value.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    CounterSet::CounterSet(const std::string &name, const std::string &help, const std::string &label,
+                           const std::vector<std::string> &values, const Labels &labels)
+    {
+        counters_.reserve(values.size());
+        for (const auto &value : values)
+        {
+            Labels series = labels;
+            series[label] = value;
+            counters_.push_back(std::make_unique<Counter>(name, help, std::move(series)));
+        }
+    }
+
+    void CounterSet::reset()
+    {
+        for (auto &counter : counters_)
+        {
+            counter->reset();
+        }
+    }
+
+    Gauge::Gauge(std::string name, std::string help, Labels labels)
+        : Metric(Type::GAUGE, std::move(name), std::move(help), std::move(labels))
+    {
+        enroll();
+    }
+
+    Gauge::~Gauge()
+    {
+        withdraw();
+    }
+
+    void Gauge::decrement_to_zero(int64_t amount)
+    {
+        int64_t current = value_.load(std::memory_order_relaxed);
+        while (!value_.compare_exchange_weak(current, std::max<int64_t>(current - amount, 0), std::memory_order_relaxed))
+        {
+        }
+    }
+
+    Histogram::Histogram(std::string name, std::string help, std::vector<double> bounds, Labels labels)
+        : Metric(Type::HISTOGRAM, std::move(name), std::move(help), std::move(labels)), bounds_(std::move(bounds))
+    {
+        std::sort(bounds_.begin(), bounds_.end());
+        bounds_.erase(std::unique(bounds_.begin(), bounds_.end()), bounds_.end());
+        for (auto &stripe : stripes_)
+        {
+            stripe.counts.reset(new std::atomic<uint64_t>[bounds_.size() + 1]);
+            for (size_t i = 0; i <= bounds_.size(); ++i)
+            {
+                stripe.counts[i].store(0, std::memory_order_relaxed);
+            }
+        }
+        enroll();
+    }
+
+    Histogram::~Histogram()
+    {
+        withdraw();
+    }
+
+    void Histogram::observe(double value)
+    {
+        if (std::isnan(value))
+        {
+            return;
+        }
+        const size_t bucket = static_cast<size_t>(std::lower_bound(bounds_.begin(), bounds_.end(), value) - bounds_.begin());
+        Stripe &stripe = stripes_[this_thread_stripe()];
+        stripe.counts[bucket].fetch_add(1, std::memory_order_relaxed);
+        double sum = stripe.sum.load(std::memory_order_relaxed);
+        while (!stripe.sum.compare_exchange_weak(sum, sum + value, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    Histogram::Snapshot Histogram::snapshot() const
+    {
+        Snapshot snapshot;
+        snapshot.bounds = bounds_;
+        snapshot.counts.assign(bounds_.size() + 1, 0);
+        for (const auto &stripe : stripes_)
+        {
+            for (size_t i = 0; i <= bounds_.size(); ++i)
+            {
+                snapshot.counts[i] += stripe.counts[i].load(std::memory_order_relaxed);
+            }
+            snapshot.sum += stripe.sum.load(std::memory_order_relaxed);
+        }
+        for (const auto count : snapshot.counts)
+        {
+            snapshot.count += count;
+        }
+        return snapshot;
+    }
+
+    uint64_t Histogram::count() const
+    {
+        uint64_t total = 0;
+        for (const auto &stripe : stripes_)
+        {
+            for (size_t i = 0; i <= bounds_.size(); ++i)
+            {
+                total += stripe.counts[i].load(std::memory_order_relaxed);
+            }
+        }
+        return total;
+    }
+
+    void Histogram::reset()
+    {
+        for (auto &stripe : stripes_)
+        {
+            for (size_t i = 0; i <= bounds_.size(); ++i)
+            {
+                stripe.counts[i].store(0, std::memory_order_relaxed);
+            }
+            stripe.sum.store(0.0, std::memory_order_relaxed);
+        }
+    }
+
+    double Histogram::Snapshot::quantile(double q) const
+    {
+        if (count == 0)
+        {
+            return 0.0;
+        }
+        const double rank = std::clamp(q, 0.0, 1.0) * static_cast<double>(count);
+        uint64_t seen = 0;
+        for (size_t i = 0; i < counts.size(); ++i)
+        {
+            if (counts[i] == 0 || static_cast<double>(seen + counts[i]) < rank)
+            {
+                seen += counts[i];
+                continue;
+            }
+            if (i == bounds.size())
+            {
+                return bounds.empty() ? mean() : bounds.back(); // Overflow bucket has no upper edge
+            }
+            const double lower = i == 0 ? std::min(0.0, bounds[0]) : bounds[i - 1];
+            const double fraction = (rank - static_cast<double>(seen)) / static_cast<double>(counts[i]);
+            return lower + (bounds[i] - lower) * std::clamp(fraction, 0.0, 1.0);
+        }
+        return bounds.empty() ? mean() : bounds.back();
+    }
+
+    void Histogram::Snapshot::merge(const Snapshot &other)
+    {
+        if (other.bounds != bounds)
+        {
+            return; // Different layouts cannot be summed bucket by bucket
+        }
+        for (size_t i = 0; i < counts.size(); ++i)
+        {
+            counts[i] += other.counts[i];
+        }
+        count += other.count;
+        sum += other.sum;
+    }
+
+    Histogram::Snapshot Histogram::Snapshot::since(const Snapshot &earlier) const
+    {
+        Snapshot delta = *this;
+        if (earlier.bounds != bounds)
+        {
+            return delta;
+        }
+        delta.count = 0;
+        for (size_t i = 0; i < counts.size(); ++i)
+        {
+            delta.counts[i] = counts[i] >= earlier.counts[i] ? counts[i] - earlier.counts[i] : 0; // Reset in between
+            delta.count += delta.counts[i];
+        }
+        delta.sum = delta.count > 0 ? std::max(sum - earlier.sum, 0.0) : 0.0;
+        return delta;
+    }
+
+    std::vector<double> Histogram::exponential_bounds(double start, double factor, size_t count)
+    {
+        std::vector<double> bounds;
+        bounds.reserve(count);
+        for (double bound = start; bounds.size() < count; bound *= factor)
+        {
+            bounds.push_back(bound);
+        }
+        return bounds;
+    }
+
+    const std::vector<double> &Histogram::latency_ms_bounds()
+    {
+        static const std::vector<double> bounds = exponential_bounds(0.001, 2.0, 27);
+        return bounds;
+    }
+
+    class Registry::Impl
+    {
+    public:
+        mutable std::mutex mutex_;
+        std::unordered_set<const Metric *> metrics_;
+    };
+
+    Registry &Registry::instance()
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    Registry::Registry() : pimpl_(std::make_unique<Impl>()) {}
+
+    Registry::~Registry() = default;
+
+    void Registry::add(const Metric *metric)
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+        pimpl_->metrics_.insert(metric);
+    }
+
+    void Registry::remove(const Metric *metric)
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+        pimpl_->metrics_.erase(metric);
+    }
+
+    size_t Registry::size() const
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+        return pimpl_->metrics_.size();
+    }
+
+    double Registry::value(const std::string &name, const Labels &labels) const
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+        Aggregate aggregate;
+        for (const Metric *metric : pimpl_->metrics_)
+        {
+            if (metric->name() == name && metric->labels() == labels)
+            {
+                accumulate(*metric, aggregate);
+            }
+        }
+        return aggregate.value;
+    }
+
+    double Registry::total(const std::string &name) const
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+        Aggregate aggregate;
+        for (const Metric *metric : pimpl_->metrics_)
+        {
+            if (metric->name() == name && metric->type() != Metric::Type::HISTOGRAM)
+            {
+                accumulate(*metric, aggregate);
+            }
+        }
+        return aggregate.value;
+    }
+
+    Histogram::Snapshot Registry::histogram(const std::string &name) const
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+        Aggregate aggregate;
+        for (const Metric *metric : pimpl_->metrics_)
+        {
+            if (metric->name() == name && metric->type() == Metric::Type::HISTOGRAM)
+            {
+                accumulate(*metric, aggregate);
+            }
+        }
+        return aggregate.histogram;
+    }
+
+    std::string Registry::to_prometheus() const
+    {
+        struct Family
+        {
+            Metric::Type type;
+            std::string help;
+            std::map<Labels, Aggregate> series;
+        };
+        std::map<std::string, Family> families;
+
+        {
+            std::lock_guard<std::mutex> lock(pimpl_->mutex_);
+            for (const Metric *metric : pimpl_->metrics_)
+            {
+                auto [it, inserted] = families.try_emplace(metric->name(), Family{metric->type(), metric->help(), {}});
+                if (it->second.type != metric->type())
+                {
+                    continue; // First registered type wins
+                }
+                accumulate(*metric, it->second.series[metric->labels()]);
+            }
+        }
+
+        std::ostringstream out;
+        for (const auto &[name, family] : families)
+        {
+            out << "# HELP " << name << " " << family.help << "\n";
+            out << "# TYPE " << name << " " << type_name(family.type) << "\n";
+            for (const auto &[labels, aggregate] : family.series)
+            {
+                if (family.type != Metric::Type::HISTOGRAM)
+                {
+                    out << name << format_labels(labels) << " " << format_value(aggregate.value) << "\n";
+                    continue;
+                }
+
+                const auto &histogram = aggregate.histogram;
+                uint64_t cumulative = 0;
+                for (size_t i = 0; i < histogram.counts.size(); ++i)
+                {
+                    cumulative += histogram.counts[i];
+                    const std::string le = i < histogram.bounds.size() ? format_value(histogram.bounds[i]) : "+Inf";
+                    out << name << "_bucket" << format_labels(labels, "le", le) << " " << cumulative << "\n";
+                }
+                out << name << "_sum" << format_labels(labels) << " " << format_value(histogram.sum) << "\n";
+                out << name << "_count" << format_labels(labels) << " " << histogram.count << "\n";
+            }
+        }
+        return out.str();
+    }
+
+} // namespace cardano_iot::utils::metrics
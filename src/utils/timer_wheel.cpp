@@ -0,0 +1,278 @@
+/**
+ * @file timer_wheel.cpp
+ * @brief Implementation of the hierarchical timer wheel
+ *
+ * @author Cardano IoT SDK Team
+ * @version 1.0.0
+ */
+
+#include "cardano_iot/utils/timer_wheel.h"
+
+#include <algorithm>
+
+namespace cardano_iot::utils
+{
+
+    TimerWheel::Scope::Scope(std::shared_ptr<TimerWheel> wheel)
+        : wheel_(std::move(wheel)), id_(wheel_->next_scope_.fetch_add(1, std::memory_order_relaxed))
+    {
+    }
+
+    TimerWheel::Scope::~Scope()
+    {
+        wheel_->cancel_scope(id_);
+    }
+
+    TimerWheel::Handle TimerWheel::Scope::schedule_after(std::chrono::milliseconds delay, Callback callback)
+    {
+        return wheel_->schedule_after(delay, std::move(callback), id_);
+    }
+
+    TimerWheel::TimerWheel(std::chrono::milliseconds tick, bool run_thread)
+        : tick_(std::max(tick, std::chrono::milliseconds(1))), origin_(Clock::now())
+    {
+        heads_.fill(NONE);
+        if (run_thread)
+        {
+            thread_ = std::thread(&TimerWheel::run, this);
+        }
+    }
+
+    TimerWheel::~TimerWheel()
+    {
+        {
+            std::lock_guard<std::mutex> lock(thread_mutex_);
+            stop_ = true;
+        }
+        thread_cv_.notify_all();
+        if (thread_.joinable())
+        {
+            thread_.join();
+        }
+    }
+
+    std::shared_ptr<TimerWheel> TimerWheel::shared()
+    {
+        static std::shared_ptr<TimerWheel> wheel = std::make_shared<TimerWheel>();
+        return wheel;
+    }
+
+    void TimerWheel::link(uint32_t index, uint32_t list)
+    {
+        Node &node = nodes_[index];
+        node.list = list;
+        node.prev = NONE;
+        node.next = heads_[list];
+        if (node.next != NONE)
+        {
+            nodes_[node.next].prev = index;
+        }
+        heads_[list] = index;
+    }
+
+    void TimerWheel::unlink(uint32_t index)
+    {
+        Node &node = nodes_[index];
+        if (node.prev != NONE)
+        {
+            nodes_[node.prev].next = node.next;
+        }
+        else
+        {
+            heads_[node.list] = node.next;
+        }
+        if (node.next != NONE)
+        {
+            nodes_[node.next].prev = node.prev;
+        }
+        node.prev = node.next = NONE;
+    }
+
+    void TimerWheel::release(uint32_t index)
+    {
+        Node &node = nodes_[index];
+        node.callback = nullptr;
+        node.list = NONE;
+        ++node.generation; // outstanding handles go stale
+        node.next = free_;
+        free_ = index;
+        --pending_;
+    }
+
+    // Slot of a deadline relative to the current tick; at or before now goes straight to the due list
+    void TimerWheel::place(uint32_t index)
+    {
+        const uint64_t deadline = nodes_[index].deadline;
+        if (deadline <= now_tick_)
+        {
+            link(index, DUE_LIST);
+            return;
+        }
+        const uint64_t span = uint64_t(1) << (SLOT_BITS * LEVELS);
+        const uint64_t target = std::min(deadline, now_tick_ + span - 1);
+        const uint64_t delta = target - now_tick_;
+        uint32_t level = 0;
+        while (level + 1 < LEVELS && delta >= (uint64_t(1) << (SLOT_BITS * (level + 1))))
+        {
+            ++level;
+        }
+        const uint32_t slot = static_cast<uint32_t>((target >> (SLOT_BITS * level)) & (SLOTS - 1));
+        link(index, level * SLOTS + slot);
+    }
+
+    TimerWheel::Handle TimerWheel::schedule_after(std::chrono::milliseconds delay, Callback callback, uint32_t scope)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const uint64_t elapsed = thread_.joinable()
+                                     ? static_cast<uint64_t>(std::max<int64_t>(0, (Clock::now() - origin_) / tick_))
+                                     : now_tick_;
+        const uint64_t ticks = static_cast<uint64_t>((std::max<int64_t>(0, delay.count()) + tick_.count() - 1) / tick_.count());
+
+        uint32_t index = free_;
+        if (index != NONE)
+        {
+            free_ = nodes_[index].next;
+        }
+        else
+        {
+            index = static_cast<uint32_t>(nodes_.size());
+            nodes_.emplace_back();
+        }
+        Node &node = nodes_[index];
+        node.callback = std::move(callback);
+        // Counted from wall time, not the last advance, so a lagging wheel does not fire early
+        node.deadline = std::max(now_tick_ + 1, elapsed + std::max<uint64_t>(1, ticks));
+        node.scope = scope;
+        place(index);
+        ++pending_;
+        return Handle{index, node.generation};
+    }
+
+    bool TimerWheel::cancel(Handle handle)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (handle.index >= nodes_.size())
+        {
+            return false;
+        }
+        Node &node = nodes_[handle.index];
+        if (node.generation != handle.generation || node.list == NONE)
+        {
+            return false;
+        }
+        unlink(handle.index);
+        release(handle.index);
+        return true;
+    }
+
+    void TimerWheel::cancel_scope(uint32_t scope)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (uint32_t index = 0; index < nodes_.size(); ++index)
+            {
+                if (nodes_[index].list != NONE && nodes_[index].scope == scope)
+                {
+                    unlink(index);
+                    release(index);
+                }
+            }
+        }
+        // Wait until no callback is mid-flight; from inside one, that would be ourselves
+        if (firing_thread_.load() != std::this_thread::get_id())
+        {
+            std::lock_guard<std::mutex> wait(fire_mutex_);
+        }
+    }
+
+    // Move the wheel one tick: cascade higher levels at their boundaries, then collect level 0's slot
+    void TimerWheel::step()
+    {
+        ++now_tick_;
+        for (uint32_t level = 1; level < LEVELS; ++level)
+        {
+            if ((now_tick_ & ((uint64_t(1) << (SLOT_BITS * level)) - 1)) != 0)
+            {
+                break;
+            }
+            const uint32_t list = level * SLOTS + static_cast<uint32_t>((now_tick_ >> (SLOT_BITS * level)) & (SLOTS - 1));
+            uint32_t index = heads_[list];
+            heads_[list] = NONE;
+            while (index != NONE)
+            {
+                const uint32_t next = nodes_[index].next;
+                place(index);
+                index = next;
+            }
+        }
+        const uint32_t list = static_cast<uint32_t>(now_tick_ & (SLOTS - 1));
+        uint32_t index = heads_[list];
+        heads_[list] = NONE;
+        while (index != NONE)
+        {
+            const uint32_t next = nodes_[index].next;
+            link(index, DUE_LIST);
+            index = next;
+        }
+    }
+
+    size_t TimerWheel::advance(Clock::time_point now)
+    {
+        std::lock_guard<std::mutex> firing(fire_mutex_);
+        firing_thread_.store(std::this_thread::get_id());
+        const uint64_t target = static_cast<uint64_t>(std::max<int64_t>(0, (now - origin_) / tick_));
+
+        size_t fired = 0;
+        for (;;)
+        {
+            Callback callback;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                while (heads_[DUE_LIST] == NONE && now_tick_ < target)
+                {
+                    step();
+                }
+                const uint32_t index = heads_[DUE_LIST];
+                if (index == NONE)
+                {
+                    break;
+                }
+                callback = std::move(nodes_[index].callback);
+                unlink(index);
+                release(index);
+            }
+            if (callback)
+            {
+                callback();
+                ++fired;
+            }
+        }
+        firing_thread_.store(std::thread::id());
+        return fired;
+    }
+
+    size_t TimerWheel::pending() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return pending_;
+    }
+
+    void TimerWheel::run()
+    {
+        Clock::time_point next = Clock::now() + tick_;
+        std::unique_lock<std::mutex> lock(thread_mutex_);
+        while (!stop_)
+        {
+            if (thread_cv_.wait_until(lock, next, [this]
+                                      { return stop_; }))
+            {
+                break;
+            }
+            lock.unlock();
+            advance(Clock::now());
+            lock.lock();
+            next = std::max(next + tick_, Clock::now());
+        }
+    }
+
+} // namespace cardano_iot::utils
@@ -0,0 +1,182 @@
+/**
+ * @file async_api_tests.cpp
+ * @brief Unit tests for the asynchronous SDK API (futures, callbacks, coroutines)
+ *
+ * @author Cardano IoT SDK Team
+ * @version 1.0.0
+ */
+
+#include <gtest/gtest.h>
+#include "cardano_iot/cardano_iot.h"
+#include "utils/test_utils.h"
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace cardano_iot;
+
+namespace
+{
+    CardanoIoTSDK::Config async_config()
+    {
+        CardanoIoTSDK::Config config;
+        config.network_type = "testnet";
+        config.enable_logging = false;
+        config.executor_threads = 2;
+        return config;
+    }
+} // namespace
+
+TEST(AsyncApiTest, FuturesKeepThousandsOfCallsInFlight)
+{
+    CardanoIoTSDK sdk(async_config());
+    EXPECT_EQ(sdk.send_ada_async("async_device", 1).get(), "");
+    ASSERT_TRUE(sdk.initialize());
+    ASSERT_TRUE(sdk.register_device(test::create_test_device_info("async_device")));
+
+    // One thread issues every call before waiting on any of them
+    std::vector<utils::Future<std::string>> submissions;
+    for (int i = 0; i < 5000; ++i)
+    {
+        submissions.push_back(sdk.submit_data_async(test::create_test_iot_data("async_device")));
+    }
+    std::vector<utils::Future<std::string>> calls;
+    for (int i = 0; i < 1000; ++i)
+    {
+        calls.push_back(sdk.execute_contract_async("addr_test1", "record", {{"i", std::to_string(i)}}));
+    }
+    calls.push_back(sdk.send_ada_async("async_device", 1000000));
+
+    const auto tx_ids = utils::Executor::when_all(submissions).get();
+    ASSERT_EQ(tx_ids.size(), 5000u);
+    for (const auto &tx_id : tx_ids)
+    {
+        ASSERT_EQ(tx_id.rfind("tx_", 0), 0u);
+    }
+    const auto results = utils::Executor::when_all(calls).get();
+    ASSERT_EQ(results.size(), 1001u);
+    EXPECT_NE(results.front().find("record"), std::string::npos);
+    EXPECT_EQ(results.back().rfind("tx_", 0), 0u);
+    EXPECT_EQ(sdk.get_device_balance("async_device"), 2000000u); // 1 ADA on registration
+    EXPECT_EQ(sdk.query_data("async_device", 0, UINT64_MAX).size(), 5000u);
+
+    // Rejections complete immediately with the synchronous call's failure value
+    auto unregistered = sdk.submit_data_async(test::create_test_iot_data("unknown_device"));
+    EXPECT_EQ(unregistered.get(), "");
+    CardanoIoTSDK::IoTData empty;
+    auto invalid = sdk.submit_data_async(empty);
+    EXPECT_TRUE(invalid.is_ready());
+    EXPECT_EQ(invalid.get(), "");
+    sdk.shutdown();
+}
+
+TEST(AsyncApiTest, CallbacksRunOnceOnTheExecutor)
+{
+    CardanoIoTSDK sdk(async_config());
+    std::atomic<int> early{0};
+    sdk.deploy_contract_async("code", {}, [&early](const std::string &address)
+                              { early += address.empty() ? 1 : 100; });
+    EXPECT_EQ(early.load(), 1); // Not running: inline with the failure value
+
+    ASSERT_TRUE(sdk.initialize());
+    ASSERT_TRUE(sdk.register_device(test::create_test_device_info("callback_device")));
+    auto executor = sdk.get_executor();
+    std::atomic<int> done{0};
+    std::atomic<int> on_worker{0};
+    auto count = [&](const std::string &result)
+    {
+        if (!result.empty())
+        {
+            ++done;
+        }
+        if (executor->in_worker())
+        {
+            ++on_worker;
+        }
+    };
+    for (int i = 0; i < 200; ++i)
+    {
+        sdk.submit_data_async(test::create_test_iot_data("callback_device"), count);
+        sdk.send_ada_async("callback_device", 10, count);
+    }
+    sdk.deploy_contract_async("code", {{"k", "v"}}, count);
+    sdk.execute_contract_async("addr_test1", "fn", {}, count);
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (done.load() < 402 && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(done.load(), 402);
+    EXPECT_EQ(on_worker.load(), 402);
+    EXPECT_EQ(sdk.get_device_balance("callback_device"), 1002000u);
+    sdk.shutdown();
+}
+
+#ifdef CARDANO_IOT_HAS_COROUTINES
+
+namespace
+{
+    utils::Task<std::string> provision(CardanoIoTSDK &sdk, std::string device_id, std::atomic<int> &resumed_on_worker)
+    {
+        // resume_on always hops to a worker, even when the future is already complete
+        const std::string funded = co_await utils::resume_on(sdk.get_executor(), sdk.send_ada_async(device_id, 5));
+        if (sdk.get_executor()->in_worker())
+        {
+            ++resumed_on_worker;
+        }
+        const std::string tx_id = co_await coro::submit_data(sdk, test::create_test_iot_data(device_id));
+        // Named arguments: GCC 12 rejects string-literal temporaries inside co_await
+        const std::string contract = "addr_test1";
+        const std::string function = "ack";
+        const std::map<std::string, std::string> parameters{{"tx", tx_id}};
+        const std::string called = co_await coro::execute_contract(sdk, contract, function, parameters);
+        co_return funded.empty() || tx_id.empty() || called.empty() ? std::string() : tx_id;
+    }
+
+    utils::Task<int> throws_midway(utils::Executor &executor)
+    {
+        co_await utils::schedule_on(executor);
+        throw std::runtime_error("boom");
+        co_return 1;
+    }
+} // namespace
+
+TEST(AsyncApiTest, CoroutinesAwaitSdkCalls)
+{
+    CardanoIoTSDK sdk(async_config());
+    ASSERT_TRUE(sdk.initialize());
+    ASSERT_TRUE(sdk.register_device(test::create_test_device_info("coro_device")));
+
+    std::atomic<int> resumed_on_worker{0};
+    std::vector<utils::Future<std::string>> flows;
+    for (int i = 0; i < 1000; ++i)
+    {
+        flows.push_back(provision(sdk, "coro_device", resumed_on_worker).future());
+    }
+    const auto tx_ids = utils::Executor::when_all(flows).get();
+    ASSERT_EQ(tx_ids.size(), 1000u);
+    for (const auto &tx_id : tx_ids)
+    {
+        ASSERT_FALSE(tx_id.empty());
+    }
+    EXPECT_EQ(resumed_on_worker.load(), 1000);
+    EXPECT_EQ(sdk.get_device_balance("coro_device"), 1005000u);
+
+    auto failing = throws_midway(*sdk.get_executor());
+    EXPECT_EQ(failing.get(), 0);
+    EXPECT_TRUE(failing.failed());
+    sdk.shutdown();
+}
+
+#else
+
+TEST(AsyncApiTest, CoroutinesAwaitSdkCalls)
+{
+    GTEST_SKIP() << "Compiler without C++20 coroutines";
+}
+
+#endif
@@ -0,0 +1,215 @@
+/**
+ * @file attestation_tests.cpp
+ * @brief Unit tests for certificate chain caching and batch attestation
+ *
+ * @author Cardano IoT SDK Team
+ * @version 1.0.0
+ */
+
+#include <gtest/gtest.h>
+#include "cardano_iot/security/attestation.h"
+#include "cardano_iot/security/authentication.h"
+#include "cardano_iot/security/certificate_chain.h"
+#include "cardano_iot/utils/codec.h"
+#include "cardano_iot/utils/executor.h"
+
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/x509.h>
+#include <openssl/x509v3.h>
+
+#include <memory>
+
+using namespace cardano_iot;
+using namespace cardano_iot::security;
+
+namespace
+{
+    struct Issued
+    {
+        std::shared_ptr<EVP_PKEY> key;
+        std::shared_ptr<X509> cert;
+        std::string pem;
+    };
+
+    // Self-signed when issuer is nullptr; validity is [now + from, now + until] in seconds
+    Issued issue(const std::string &common_name, const Issued *issuer, bool ca, long from = -60, long until = 86400)
+    {
+        static long serial = 1;
+        Issued issued;
+        issued.key.reset(EVP_EC_gen("P-256"), EVP_PKEY_free);
+        issued.cert.reset(X509_new(), X509_free);
+        X509 *cert = issued.cert.get();
+        X509_set_version(cert, 2);
+        ASN1_INTEGER_set(X509_get_serialNumber(cert), serial++);
+        X509_gmtime_adj(X509_getm_notBefore(cert), from);
+        X509_gmtime_adj(X509_getm_notAfter(cert), until);
+        X509_set_pubkey(cert, issued.key.get());
+        X509_NAME *name = X509_get_subject_name(cert);
+        X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC,
+                                   reinterpret_cast<const unsigned char *>(common_name.c_str()), -1, -1, 0);
+        X509_set_issuer_name(cert, issuer ? X509_get_subject_name(issuer->cert.get()) : name);
+        if (ca)
+        {
+            X509V3_CTX ctx;
+            X509V3_set_ctx_nodb(&ctx);
+            X509V3_set_ctx(&ctx, issuer ? issuer->cert.get() : cert, cert, nullptr, nullptr, 0);
+            X509_EXTENSION *ext = X509V3_EXT_conf_nid(nullptr, &ctx, NID_basic_constraints, "critical,CA:TRUE");
+            X509_add_ext(cert, ext, -1);
+            X509_EXTENSION_free(ext);
+        }
+        X509_sign(cert, issuer ? issuer->key.get() : issued.key.get(), EVP_sha256());
+
+        BIO *bio = BIO_new(BIO_s_mem());
+        PEM_write_bio_X509(bio, cert);
+        char *data = nullptr;
+        const long length = BIO_get_mem_data(bio, &data);
+        issued.pem.assign(data, static_cast<size_t>(length));
+        BIO_free(bio);
+        return issued;
+    }
+
+    std::string sign(const Issued &signer, const std::string &message)
+    {
+        EVP_MD_CTX *ctx = EVP_MD_CTX_new();
+        size_t length = 0;
+        EVP_DigestSignInit(ctx, nullptr, EVP_sha256(), nullptr, signer.key.get());
+        EVP_DigestSign(ctx, nullptr, &length, reinterpret_cast<const unsigned char *>(message.data()), message.size());
+        std::vector<uint8_t> signature(length);
+        EVP_DigestSign(ctx, signature.data(), &length, reinterpret_cast<const unsigned char *>(message.data()),
+                       message.size());
+        signature.resize(length);
+        EVP_MD_CTX_free(ctx);
+        return utils::codec::base64_encode(signature);
+    }
+
+    AttestationEvidence evidence_for(const Issued &leaf, const Issued &intermediate, const std::string &device_id,
+                                     const std::string &nonce)
+    {
+        AttestationEvidence evidence{};
+        evidence.device_id = device_id;
+        evidence.nonce = nonce;
+        evidence.quote = utils::codec::base64_encode(std::vector<uint8_t>(device_id.begin(), device_id.end()));
+        evidence.certificate = leaf.pem + intermediate.pem;
+        evidence.quote_signature = sign(leaf, evidence.quote + nonce);
+        evidence.claims["fw"] = "1.2.3";
+        return evidence;
+    }
+} // namespace
+
+TEST(CertificateChainTest, VerifiesChainsAndCachesSharedIssuers)
+{
+    const Issued root = issue("Vendor Root", nullptr, true);
+    const Issued intermediate = issue("Vendor Devices CA", &root, true);
+    const Issued leaf_a = issue("device-a", &intermediate, false);
+    const Issued leaf_b = issue("device-b", &intermediate, false);
+
+    CertificateChainCache cache;
+    auto first = cache.verify(leaf_a.pem + intermediate.pem, {root.pem});
+    ASSERT_TRUE(first.valid) << first.error;
+    EXPECT_FALSE(first.cached);
+    EXPECT_NE(first.subject.find("device-a"), std::string::npos);
+    EXPECT_GT(first.not_after, 0u);
+
+    // Same chain: one lookup; a sibling leaf only costs its own signature check
+    EXPECT_TRUE(cache.verify(leaf_a.pem + intermediate.pem, {root.pem}).cached);
+    const auto before = cache.stats();
+    EXPECT_TRUE(cache.verify(leaf_b.pem + intermediate.pem, {root.pem}).valid);
+    const auto after = cache.stats();
+    EXPECT_EQ(after.signatures_checked - before.signatures_checked, 1u);
+    EXPECT_EQ(after.signature_hits - before.signature_hits, 1u);
+    EXPECT_EQ(after.certificates_parsed - before.certificates_parsed, 1u);
+
+    // Rejections
+    const Issued other_root = issue("Other Root", nullptr, true);
+    EXPECT_EQ(cache.verify(leaf_a.pem + intermediate.pem, {other_root.pem}).error,
+              "Chain does not lead to a trusted root");
+    const Issued expired = issue("device-old", &intermediate, false, -7200, -3600);
+    EXPECT_NE(cache.verify(expired.pem + intermediate.pem, {root.pem}).error.find("validity"), std::string::npos);
+    const Issued not_ca = issue("not-a-ca", &root, false);
+    const Issued under_leaf = issue("device-c", &not_ca, false);
+    EXPECT_FALSE(cache.verify(under_leaf.pem + not_ca.pem, {root.pem}).valid);
+    EXPECT_FALSE(cache.verify(leaf_a.pem, {root.pem}).valid); // Intermediate missing
+    EXPECT_EQ(cache.verify("not a certificate").error, "No certificate in chain");
+
+    // Without trusted roots the chain must end self-signed
+    EXPECT_TRUE(cache.verify(leaf_a.pem + intermediate.pem + root.pem).valid);
+    EXPECT_FALSE(cache.verify(leaf_a.pem + intermediate.pem).valid);
+}
+
+TEST(CertificateChainTest, BatchVerifiesQuotesInParallel)
+{
+    const Issued root = issue("Fleet Root", nullptr, true);
+    const Issued intermediate = issue("Fleet CA", &root, true);
+    const Issued shared_leaf = issue("gateway", &intermediate, false);
+
+    std::vector<AttestationEvidence> evidence;
+    std::vector<std::string> nonces;
+    for (int i = 0; i < 64; ++i)
+    {
+        const std::string nonce = "nonce-" + std::to_string(i);
+        evidence.push_back(evidence_for(shared_leaf, intermediate, "device-" + std::to_string(i), nonce));
+        nonces.push_back(nonce);
+    }
+    evidence[3].nonce = "stale";
+    evidence[5].quote_signature = evidence[6].quote_signature; // Signature over another quote
+    evidence[7].quote_signature.clear();
+    AttestationEvidence plain{};
+    plain.device_id = "no-cert";
+    plain.nonce = "plain";
+    plain.quote = "cXVvdGU=";
+    evidence.push_back(plain);
+    nonces.push_back("plain");
+
+    utils::Executor executor;
+    const auto before = CertificateChainCache::shared().stats();
+    auto results = AttestationVerifier::verify_quotes_batch(evidence, nonces, {root.pem}, &executor);
+    const auto after = CertificateChainCache::shared().stats();
+    ASSERT_EQ(results.size(), evidence.size());
+
+    EXPECT_EQ(after.chain_misses - before.chain_misses, 1u); // One distinct chain, verified once
+    EXPECT_EQ(results[3].error, "Nonce mismatch");
+    EXPECT_EQ(results[5].error, "Quote signature invalid");
+    EXPECT_EQ(results[7].error, "Missing quote signature");
+    size_t valid = 0;
+    for (const auto &result : results)
+    {
+        valid += result.valid ? 1 : 0;
+    }
+    EXPECT_EQ(valid, evidence.size() - 3);
+    EXPECT_NE(results[0].verified_claims.at("certificate_subject").find("gateway"), std::string::npos);
+    EXPECT_EQ(results[0].verified_claims.at("fw"), "1.2.3");
+    EXPECT_TRUE(results.back().valid);
+
+    // The batch and single-quote paths agree
+    EXPECT_TRUE(AttestationVerifier::verify_quote(evidence[0], nonces[0], {root.pem}).valid);
+    EXPECT_FALSE(AttestationVerifier::verify_quote(evidence[0], nonces[0], {}).valid); // Root not in the chain
+    EXPECT_EQ(AttestationVerifier::verify_quotes_batch(evidence, {"a", "b"}).front().error, "Nonce count mismatch");
+    executor.shutdown();
+}
+
+TEST(CertificateChainTest, AuthenticationSharesTheChainCache)
+{
+    const Issued root = issue("Auth Root", nullptr, true);
+    const Issued leaf = issue("auth-device", &root, false);
+
+    Authentication auth;
+    ASSERT_TRUE(auth.initialize());
+    const std::string chain = leaf.pem + root.pem;
+    EXPECT_TRUE(auth.verify_certificate_chain(chain));
+
+    // The attestation path now finds the chain already verified
+    AttestationEvidence evidence{};
+    evidence.device_id = "auth-device";
+    evidence.nonce = "n";
+    evidence.quote = "cXVvdGU=";
+    evidence.certificate = chain;
+    evidence.quote_signature = sign(leaf, evidence.quote + evidence.nonce);
+    const auto before = CertificateChainCache::shared().stats();
+    EXPECT_TRUE(AttestationVerifier::verify_quote(evidence, "n").valid);
+    EXPECT_EQ(CertificateChainCache::shared().stats().chain_hits - before.chain_hits, 1u);
+
+    EXPECT_FALSE(auth.verify_certificate_chain("-----BEGIN CERTIFICATE-----\nbm90IGEgY2VydA==\n-----END CERTIFICATE-----\n"));
+    EXPECT_FALSE(auth.verify_certificate_chain(leaf.pem)); // Issuer missing
+    auth.shutdown();
+}
@@ -0,0 +1,255 @@
+/**
+ * @file cluster_tests.cpp
+ * @brief Tests for consistent-hash device sharding across SDK gateway nodes
+ */
+
+#include <gtest/gtest.h>
+#include "cardano_iot/cardano_iot.h"
+#include "cardano_iot/network/hash_ring.h"
+#include "utils/test_utils.h"
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <thread>
+
+using namespace cardano_iot;
+using namespace std::chrono_literals;
+using cardano_iot::test::eventually;
+
+namespace
+{
+    std::unique_ptr<CardanoIoTSDK> start_node(const std::vector<std::string> &seeds)
+    {
+        CardanoIoTSDK::Config config;
+        config.network_type = "testnet";
+        config.enable_power_management = false;
+        config.executor_threads = 2;
+        config.cluster_enabled = true;
+        config.cluster_listen_address = "127.0.0.1";
+        config.cluster_seeds = seeds;
+        config.cluster_membership_interval_ms = 100;
+        config.cluster_request_timeout_ms = 3000;
+        auto sdk = std::make_unique<CardanoIoTSDK>(config);
+        return sdk->initialize() ? std::move(sdk) : nullptr;
+    }
+
+    std::string status(const CardanoIoTSDK &sdk, const std::string &key)
+    {
+        const auto values = sdk.get_network_status();
+        auto it = values.find(key);
+        return it != values.end() ? it->second : "";
+    }
+
+    size_t local_devices(const CardanoIoTSDK &sdk)
+    {
+        return std::stoul(status(sdk, "cluster_local_devices"));
+    }
+
+    CardanoIoTSDK::DeviceInfo device(int index)
+    {
+        CardanoIoTSDK::DeviceInfo info;
+        info.device_id = "sensor-" + std::to_string(index);
+        info.device_type = "sensor";
+        info.manufacturer = "Acme";
+        info.firmware_version = "1.0.0";
+        info.capabilities = {"sensor_data"};
+        info.public_key = std::string(64, 'a');
+        return info;
+    }
+
+    CardanoIoTSDK::IoTData reading(int index, uint64_t timestamp)
+    {
+        CardanoIoTSDK::IoTData data;
+        data.device_id = "sensor-" + std::to_string(index);
+        data.data_type = "temperature";
+        data.payload = "{\"value\": " + std::to_string(index) + "}";
+        data.timestamp = timestamp;
+        data.metadata["unit"] = "C";
+        return data;
+    }
+} // namespace
+
+TEST(ClusterTests, HashRingSpreadsKeysAndMovesOnlyTheNewNodesShare)
+{
+    network::HashRing ring;
+    for (const auto *node : {"node-a", "node-b", "node-c", "node-d"})
+    {
+        ring.add_node(node);
+    }
+
+    constexpr int KEYS = 20000;
+    std::map<std::string, int> share;
+    std::vector<std::string> before;
+    for (int i = 0; i < KEYS; ++i)
+    {
+        before.push_back(ring.owner("device-" + std::to_string(i)));
+        ++share[before.back()];
+    }
+    ASSERT_EQ(share.size(), 4u);
+    for (const auto &[node, keys] : share)
+    {
+        EXPECT_GT(keys, KEYS * 15 / 100) << node;
+        EXPECT_LT(keys, KEYS * 35 / 100) << node;
+    }
+
+    // A new node only takes keys over; removing it gives exactly those back
+    ASSERT_TRUE(ring.add_node("node-e"));
+    EXPECT_FALSE(ring.add_node("node-e"));
+    int moved = 0;
+    for (int i = 0; i < KEYS; ++i)
+    {
+        const auto &owner = ring.owner("device-" + std::to_string(i));
+        if (owner != before[i])
+        {
+            EXPECT_EQ(owner, "node-e");
+            ++moved;
+        }
+    }
+    EXPECT_GT(moved, KEYS / 10);
+    EXPECT_LT(moved, KEYS * 3 / 10);
+
+    ASSERT_TRUE(ring.remove_node("node-e"));
+    for (int i = 0; i < KEYS; ++i)
+    {
+        EXPECT_EQ(ring.owner("device-" + std::to_string(i)), before[i]);
+    }
+    EXPECT_EQ(network::HashRing().owner("device-1"), "");
+}
+
+TEST(ClusterTests, NodesRouteRegistrationSubmissionAndQueriesToTheOwner)
+{
+    auto a = start_node({});
+    ASSERT_NE(a, nullptr);
+    auto b = start_node({status(*a, "cluster_endpoint")});
+    ASSERT_NE(b, nullptr);
+    ASSERT_TRUE(eventually([&]()
+                           { return status(*a, "cluster_members") == "2" && status(*b, "cluster_members") == "2"; }));
+
+    constexpr int DEVICES = 200;
+    for (int i = 0; i < DEVICES; ++i)
+    {
+        ASSERT_TRUE(a->register_device(device(i))) << i;
+    }
+    EXPECT_EQ(b->get_registered_devices().size(), static_cast<size_t>(DEVICES));
+    EXPECT_EQ(local_devices(*a) + local_devices(*b), static_cast<size_t>(DEVICES));
+    EXPECT_GT(local_devices(*a), 0u);
+    EXPECT_GT(local_devices(*b), 0u);
+
+    // One reading each through submit_data, one more through a batch
+    std::vector<CardanoIoTSDK::IoTData> batch;
+    for (int i = 0; i < DEVICES; ++i)
+    {
+        EXPECT_FALSE(b->submit_data(reading(i, 1000)).empty()) << i;
+        batch.push_back(reading(i, 2000));
+    }
+    for (const auto &tx_id : b->submit_data_batch(std::move(batch)))
+    {
+        EXPECT_FALSE(tx_id.empty());
+    }
+    EXPECT_TRUE(b->submit_data(reading(DEVICES, 1000)).empty()); // Registered nowhere
+
+    for (int i = 0; i < DEVICES; ++i)
+    {
+        const auto readings = a->query_data("sensor-" + std::to_string(i));
+        ASSERT_EQ(readings.size(), 2u) << i;
+        EXPECT_EQ(readings[0].timestamp, 1000u);
+        EXPECT_EQ(readings[1].payload, reading(i, 0).payload);
+        ASSERT_NE(readings[1].metadata.find("unit"), readings[1].metadata.end());
+        EXPECT_EQ(readings[1].metadata.find("unit")->second, "C");
+        EXPECT_FALSE(readings[1].hash.empty());
+
+        const auto view = b->query_data_view("sensor-" + std::to_string(i), 1500);
+        ASSERT_EQ(view.size(), 1u) << i;
+        EXPECT_EQ(b->decode_payload((*view.begin()).payload()), reading(i, 0).payload);
+    }
+
+    b->shutdown();
+    a->shutdown();
+}
+
+TEST(ClusterTests, ShardsMoveWhenNodesJoinAndLeaveWithoutLosingReadings)
+{
+    auto a = start_node({});
+    ASSERT_NE(a, nullptr);
+    auto b = start_node({status(*a, "cluster_endpoint")});
+    ASSERT_NE(b, nullptr);
+    ASSERT_TRUE(eventually([&]()
+                           { return status(*a, "cluster_members") == "2" && status(*b, "cluster_members") == "2"; }));
+
+    constexpr size_t DEVICES = 100;
+    std::vector<size_t> accepted(DEVICES, 1); // Readings each device was given a transaction id for
+    for (size_t i = 0; i < DEVICES; ++i)
+    {
+        ASSERT_TRUE(a->register_device(device(static_cast<int>(i))));
+        ASSERT_FALSE(a->submit_data(reading(static_cast<int>(i), 1000)).empty());
+    }
+
+    // Readings keep arriving through b while shards move
+    std::atomic<bool> writing{false};
+    std::thread writer;
+    uint64_t next_timestamp = 2000;
+    auto start_writing = [&]()
+    {
+        writing = true;
+        writer = std::thread([&]()
+                             {
+                                 for (size_t i = 0; writing; i = (i + 1) % DEVICES)
+                                 {
+                                     if (!b->submit_data(reading(static_cast<int>(i), next_timestamp++)).empty())
+                                     {
+                                         ++accepted[i];
+                                     }
+                                     std::this_thread::sleep_for(1ms);
+                                 } });
+    };
+    auto stop_writing = [&]()
+    {
+        writing = false;
+        writer.join();
+    };
+    auto all_readings_queryable = [&](const CardanoIoTSDK &node)
+    {
+        for (size_t i = 0; i < DEVICES; ++i)
+        {
+            if (node.query_data("sensor-" + std::to_string(i)).size() != accepted[i])
+            {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    // A third node takes its share from both
+    start_writing();
+    auto c = start_node({status(*a, "cluster_endpoint")});
+    ASSERT_NE(c, nullptr);
+    ASSERT_TRUE(eventually([&]()
+                           { return status(*a, "cluster_members") == "3" && status(*b, "cluster_members") == "3" &&
+                                    status(*c, "cluster_members") == "3"; }));
+    ASSERT_TRUE(eventually([&]()
+                           { return local_devices(*c) > 0 &&
+                                    local_devices(*a) + local_devices(*b) + local_devices(*c) == DEVICES; }));
+    stop_writing();
+    EXPECT_EQ(c->get_registered_devices().size(), DEVICES);
+    EXPECT_TRUE(eventually([&]()
+                           { return all_readings_queryable(*a); }, 10s));
+    const auto first = a->query_data("sensor-0");
+    ASSERT_FALSE(first.empty());
+    EXPECT_EQ(first[0].timestamp, 1000u);
+    EXPECT_EQ(first[0].payload, reading(0, 0).payload);
+
+    // Leaving gracefully hands the share back
+    start_writing();
+    c->shutdown();
+    ASSERT_TRUE(eventually([&]()
+                           { return status(*a, "cluster_members") == "2" && status(*b, "cluster_members") == "2"; }));
+    stop_writing();
+    EXPECT_EQ(local_devices(*a) + local_devices(*b), DEVICES);
+    EXPECT_TRUE(eventually([&]()
+                           { return all_readings_queryable(*b); }, 10s));
+
+    b->shutdown();
+    a->shutdown();
+}
@@ -0,0 +1,96 @@
+/**
+ * @file codec_tests.cpp
+ * @brief Unit tests for the shared hex/base64 codecs
+ *
+ * @author Cardano IoT SDK Team
+ * @version 1.0.0
+ */
+
+#include <gtest/gtest.h>
+#include "cardano_iot/utils/codec.h"
+
+#include <random>
+
+using namespace cardano_iot::utils;
+
+namespace
+{
+    std::vector<uint8_t> to_bytes(const std::string &s)
+    {
+        return std::vector<uint8_t>(s.begin(), s.end());
+    }
+
+    // Straightforward reference encoder to check the SIMD kernels against
+    std::string reference_base64(const std::vector<uint8_t> &data)
+    {
+        static const char *tbl = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        std::string out;
+        for (size_t i = 0; i < data.size(); i += 3)
+        {
+            uint32_t n = data[i] << 16;
+            if (i + 1 < data.size())
+                n |= data[i + 1] << 8;
+            if (i + 2 < data.size())
+                n |= data[i + 2];
+            out.push_back(tbl[(n >> 18) & 0x3F]);
+            out.push_back(tbl[(n >> 12) & 0x3F]);
+            out.push_back(i + 1 < data.size() ? tbl[(n >> 6) & 0x3F] : '=');
+            out.push_back(i + 2 < data.size() ? tbl[n & 0x3F] : '=');
+        }
+        return out;
+    }
+} // namespace
+
+TEST(CodecTest, Rfc4648Vectors)
+{
+    EXPECT_EQ(codec::base64_encode(to_bytes("")), "");
+    EXPECT_EQ(codec::base64_encode(to_bytes("f")), "Zg==");
+    EXPECT_EQ(codec::base64_encode(to_bytes("fo")), "Zm8=");
+    EXPECT_EQ(codec::base64_encode(to_bytes("foo")), "Zm9v");
+    EXPECT_EQ(codec::base64_encode(to_bytes("foobar")), "Zm9vYmFy");
+
+    EXPECT_EQ(codec::base64_decode("Zm9vYmE="), to_bytes("fooba"));
+    EXPECT_EQ(codec::base64_decode("Zm9v\nYmFy"), to_bytes("foobar"));
+    EXPECT_EQ(codec::hex_encode(to_bytes("\x01\xab\xff")), "01abff");
+    EXPECT_EQ(codec::hex_decode("01ABff"), to_bytes("\x01\xab\xff"));
+}
+
+TEST(CodecTest, MatchesReferenceAcrossLengths)
+{
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> byte(0, 255);
+
+    for (size_t length = 0; length < 300; ++length)
+    {
+        std::vector<uint8_t> data(length);
+        for (auto &b : data)
+        {
+            b = static_cast<uint8_t>(byte(gen));
+        }
+
+        std::string b64 = codec::base64_encode(data);
+        ASSERT_EQ(b64, reference_base64(data)) << "length " << length;
+        ASSERT_EQ(codec::base64_decode(b64), data) << "length " << length;
+
+        std::string hex = codec::hex_encode(data);
+        ASSERT_EQ(hex.size(), length * 2);
+        ASSERT_EQ(codec::hex_decode(hex), data) << "length " << length;
+    }
+}
+
+TEST(CodecTest, RejectsMalformedInput)
+{
+    EXPECT_TRUE(codec::hex_decode("abc").empty());
+    EXPECT_TRUE(codec::hex_decode(std::string(40, '0') + "zz").empty());
+    EXPECT_TRUE(codec::base64_decode(std::string(32, 'A') + "*AAA").empty());
+
+    uint8_t out[64];
+    EXPECT_EQ(codec::hex_decode("0g", 2, out), codec::npos);
+    EXPECT_EQ(codec::base64_decode("QQ==QQ==", 8, out), codec::npos);
+}
+
+TEST(CodecTest, ReportsImplementation)
+{
+    std::string impl = codec::active_implementation();
+    EXPECT_TRUE(impl == "avx2" || impl == "ssse3" || impl == "neon" || impl == "scalar");
+}
@@ -0,0 +1,96 @@
+/**
+ * @file coin_selection_tests.cpp
+ * @brief Unit tests for the coin selection engine
+ */
+
+#include <gtest/gtest.h>
+#include "cardano_iot/core/coin_selection.h"
+
+#include <random>
+
+using namespace cardano_iot::core;
+using Strategy = TransactionManager::UTXOSelectionStrategy;
+
+namespace
+{
+    UTXO make_utxo(uint32_t index, uint64_t lovelace)
+    {
+        UTXO utxo{};
+        utxo.tx_hash = "tx" + std::to_string(index);
+        utxo.output_index = index;
+        utxo.amount_lovelace = lovelace;
+        utxo.address = "addr_test1wallet";
+        return utxo;
+    }
+} // namespace
+
+TEST(CoinSelectionTest, BranchAndBoundFindsChangelessMatch)
+{
+    std::vector<UTXO> utxos;
+    uint32_t i = 0;
+    for (uint64_t amount : {9'000'000ULL, 7'000'000ULL, 5'000'000ULL, 3'000'000ULL, 2'500'000ULL})
+    {
+        utxos.push_back(make_utxo(i++, amount));
+    }
+    CoinSelectionIndex index(utxos);
+
+    CoinSelectionParams params;
+    params.cost_of_change = 1000;
+    params.seed = 1;
+
+    // 7 + 3 + 2.5 ADA hits the target exactly; largest-first would take 9 + 7
+    auto result = CoinSelector::select(index, 12'500'000, {}, Strategy::OPTIMAL_FEE, params);
+    ASSERT_TRUE(result.success);
+    EXPECT_TRUE(result.changeless);
+    EXPECT_EQ(result.algorithm, "branch_and_bound");
+    EXPECT_EQ(result.total_lovelace, 12'500'000u);
+    EXPECT_EQ(result.change_lovelace, 0u);
+    EXPECT_GT(result.inputs_evaluated, 0u);
+
+    auto largest = CoinSelector::select(index, 12'500'000, {}, Strategy::LARGEST_FIRST, params);
+    ASSERT_TRUE(largest.success);
+    EXPECT_EQ(largest.selected.size(), 2u);
+    EXPECT_EQ(largest.total_lovelace, 16'000'000u);
+}
+
+TEST(CoinSelectionTest, RandomImproveOnLargeWallet)
+{
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<uint64_t> amount(1'000'000, 50'000'000);
+    std::vector<UTXO> utxos;
+    for (uint32_t i = 0; i < 20000; ++i)
+    {
+        utxos.push_back(make_utxo(i, amount(rng) | 1)); // odd amounts defeat exact matches
+    }
+    CoinSelectionIndex index(utxos);
+
+    CoinSelectionParams params;
+    params.seed = 7;
+    params.bnb_max_tries = 2000;
+
+    const uint64_t target = 30'000'000;
+    auto result = CoinSelector::select(index, target, {}, Strategy::OPTIMAL_FEE, params);
+    ASSERT_TRUE(result.success);
+    EXPECT_GE(result.total_lovelace, target);
+    if (result.algorithm == "random_improve")
+    {
+        EXPECT_LE(result.total_lovelace - target, 3 * target);
+    }
+    EXPECT_LE(result.inputs_evaluated, 20000u);
+}
+
+TEST(CoinSelectionTest, CoversRequiredTokensAndReportsShortfall)
+{
+    std::vector<UTXO> utxos = {make_utxo(0, 5'000'000), make_utxo(1, 2'000'000), make_utxo(2, 2'000'000)};
+    utxos[1].native_tokens["policy1.token1"] = 400;
+    utxos[2].native_tokens["policy1.token1"] = 700;
+    CoinSelectionIndex index(utxos);
+
+    auto result = CoinSelector::select(index, 1'000'000, {{"policy1.token1", 1000}}, Strategy::LARGEST_FIRST);
+    ASSERT_TRUE(result.success);
+    EXPECT_EQ(result.selected.size(), 2u);
+    EXPECT_EQ(result.total_tokens["policy1.token1"], 1100u);
+
+    EXPECT_FALSE(CoinSelector::select(index, 1'000'000, {{"policy1.token1", 2000}}, Strategy::LARGEST_FIRST).success);
+    EXPECT_FALSE(CoinSelector::select(index, 100'000'000, {}, Strategy::OPTIMAL_FEE).success);
+}
@@ -0,0 +1,114 @@
+/**
+ * @file confirmation_tracker_tests.cpp
+ * @brief Unit tests for the batched, timer-wheel based confirmation tracker
+ */
+
+#include <gtest/gtest.h>
+#include "cardano_iot/core/confirmation_tracker.h"
+
+#include <atomic>
+#include <mutex>
+#include <set>
+
+using namespace cardano_iot::core;
+using namespace std::chrono_literals;
+
+namespace
+{
+    ConfirmationTracker::Config fast_config()
+    {
+        ConfirmationTracker::Config config;
+        config.tick = 10ms;
+        config.tip_poll_interval = 20ms;
+        config.max_check_interval = 10s;
+        config.batch_size = 1000;
+        return config;
+    }
+} // namespace
+
+TEST(ConfirmationTrackerTest, ResolvesThousandsOfTransactionsOnNewBlock)
+{
+    std::atomic<uint64_t> height{1};
+    std::atomic<bool> block_made{false};
+    ConfirmationTracker tracker(
+        [&](const std::vector<std::string> &ids)
+        {
+            std::vector<TransactionStatus> statuses;
+            for (const auto &id : ids)
+            {
+                const bool even = (std::stoul(id) % 2) == 0;
+                statuses.push_back(block_made && even ? TransactionStatus::CONFIRMED : TransactionStatus::SUBMITTED);
+            }
+            return statuses;
+        },
+        [&]()
+        {
+            cardano_iot::network::ChainTip tip{};
+            tip.height = height;
+            tip.hash = "block_" + std::to_string(tip.height);
+            return tip;
+        },
+        fast_config());
+
+    std::atomic<size_t> callbacks{0};
+    tracker.set_callback([&](const std::string &, bool)
+                         { ++callbacks; });
+    ASSERT_TRUE(tracker.start());
+
+    constexpr size_t kCount = 10000;
+    std::vector<std::future<bool>> futures;
+    futures.reserve(kCount);
+    for (size_t i = 0; i < kCount; ++i)
+    {
+        futures.push_back(tracker.track(std::to_string(i), 500ms));
+    }
+    EXPECT_EQ(tracker.pending_count(), kCount);
+
+    block_made = true;
+    ++height;
+
+    for (size_t i = 0; i < kCount; ++i)
+    {
+        ASSERT_EQ(futures[i].wait_for(5s), std::future_status::ready);
+        EXPECT_EQ(futures[i].get(), i % 2 == 0) << "tx " << i;
+    }
+
+    const auto stats = tracker.get_statistics();
+    EXPECT_EQ(stats.confirmed, kCount / 2);
+    EXPECT_EQ(stats.timed_out, kCount / 2);
+    EXPECT_GE(stats.batch_queries, kCount / 1000);
+    EXPECT_EQ(callbacks.load(), kCount);
+    EXPECT_EQ(tracker.pending_count(), 0u);
+    tracker.stop();
+}
+
+TEST(ConfirmationTrackerTest, FailedUntrackedAndStoppedResolveFalse)
+{
+    ConfirmationTracker tracker(
+        [](const std::vector<std::string> &ids)
+        {
+            std::vector<TransactionStatus> statuses;
+            for (const auto &id : ids)
+            {
+                statuses.push_back(id == "bad" ? TransactionStatus::FAILED : TransactionStatus::SUBMITTED);
+            }
+            return statuses;
+        },
+        nullptr, fast_config());
+    ASSERT_TRUE(tracker.start());
+
+    auto failed = tracker.track("bad", 10s);
+    auto untracked = tracker.track("dropped", 10s);
+    auto stopped = tracker.track("slow", 10s);
+
+    ASSERT_EQ(failed.wait_for(2s), std::future_status::ready);
+    EXPECT_FALSE(failed.get());
+
+    EXPECT_TRUE(tracker.untrack("dropped"));
+    EXPECT_FALSE(untracked.get());
+
+    tracker.stop();
+    ASSERT_EQ(stopped.wait_for(1s), std::future_status::ready);
+    EXPECT_FALSE(stopped.get());
+    EXPECT_EQ(tracker.get_statistics().failed, 1u);
+}
@@ -0,0 +1,122 @@
+/**
+ * @file crypto_manager_tests.cpp
+ * @brief Unit tests for Crypto Manager module
+ */
+
+#include <gtest/gtest.h>
+#include "cardano_iot/core/crypto_manager.h"
+
+#include <thread>
+
+using namespace cardano_iot::core;
+
+class CryptoManagerTest : public ::testing::Test
+{
+protected:
+    CryptoManager crypto_;
+
+    void SetUp() override { ASSERT_TRUE(crypto_.initialize()); }
+    void TearDown() override { crypto_.shutdown(); }
+};
+
+TEST_F(CryptoManagerTest, Ed25519SignVerifyRoundTrip)
+{
+    auto key = crypto_.generate_key_pair(CryptoAlgorithm::ED25519);
+    ASSERT_NE(key, nullptr);
+
+    auto sig = crypto_.sign_message("sensor reading", key->private_key, CryptoAlgorithm::ED25519);
+    ASSERT_NE(sig, nullptr);
+    EXPECT_EQ(sig->public_key, key->public_key);
+    EXPECT_EQ(sig->signature.size(), 128u);
+
+    EXPECT_TRUE(crypto_.verify_signature(*sig, "sensor reading"));
+
+    DigitalSignature tampered = *sig;
+    tampered.message_hash = crypto_.compute_hash("other reading");
+    EXPECT_FALSE(crypto_.verify_signature(tampered, "other reading"));
+}
+
+TEST_F(CryptoManagerTest, DigestOnlySignaturesMustBeMarkedAsDemo)
+{
+    // A forged Ed25519 signature: the right message hash, but no key to check it against
+    DigitalSignature forged;
+    forged.algorithm = CryptoAlgorithm::ED25519;
+    forged.message_hash = crypto_.compute_hash("open the valve");
+    forged.public_key = "not-a-key";
+    forged.signature = std::string(128, 'g');
+    forged.timestamp = 0;
+    EXPECT_FALSE(crypto_.verify_signature(forged, "open the valve"));
+    forged.public_key.clear();
+    forged.signature.clear();
+    EXPECT_FALSE(crypto_.verify_batch({forged}, {"open the valve"})[0]);
+
+    // Demo keys still sign, and say so
+    auto demo = crypto_.sign_message("open the valve", "private_key_mock", CryptoAlgorithm::ED25519);
+    ASSERT_NE(demo, nullptr);
+    EXPECT_EQ(demo->algorithm, CryptoAlgorithm::DEMO_DIGEST);
+    EXPECT_TRUE(crypto_.verify_signature(*demo, "open the valve"));
+    demo->algorithm = CryptoAlgorithm::ED25519;
+    EXPECT_FALSE(crypto_.verify_signature(*demo, "open the valve"));
+}
+
+TEST_F(CryptoManagerTest, BatchSignAndVerify)
+{
+    auto key = crypto_.generate_key_pair(CryptoAlgorithm::ED25519);
+    ASSERT_NE(key, nullptr);
+
+    std::vector<std::string> messages;
+    for (int i = 0; i < 200; ++i)
+    {
+        messages.push_back("reading_" + std::to_string(i));
+    }
+
+    auto signatures = crypto_.sign_batch(messages, key->private_key, CryptoAlgorithm::ED25519);
+    ASSERT_EQ(signatures.size(), messages.size());
+
+    std::vector<DigitalSignature> to_verify;
+    for (const auto &sig : signatures)
+    {
+        ASSERT_NE(sig, nullptr);
+        to_verify.push_back(*sig);
+    }
+    // Corrupt one signature
+    to_verify[7].signature[0] = to_verify[7].signature[0] == '0' ? '1' : '0';
+
+    auto results = crypto_.verify_batch(to_verify, messages);
+    ASSERT_EQ(results.size(), messages.size());
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        EXPECT_EQ(results[i], i != 7) << "index " << i;
+    }
+
+    auto stats = crypto_.get_statistics();
+    EXPECT_EQ(stats.signatures_created, 200u);
+    EXPECT_EQ(stats.signatures_verified, 200u);
+}
+
+TEST_F(CryptoManagerTest, ConcurrentSigningUpdatesStatistics)
+{
+    auto key = crypto_.generate_key_pair(CryptoAlgorithm::ED25519);
+    ASSERT_NE(key, nullptr);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([this, &key]()
+                             {
+                                 for (int i = 0; i < 50; ++i)
+                                 {
+                                     auto sig = crypto_.sign_message("msg", key->private_key, CryptoAlgorithm::ED25519);
+                                     EXPECT_TRUE(sig && crypto_.verify_signature(*sig, "msg"));
+                                 } });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    auto stats = crypto_.get_statistics();
+    EXPECT_EQ(stats.signatures_created, 200u);
+    EXPECT_EQ(stats.signatures_verified, 200u);
+    EXPECT_GT(stats.avg_sign_time_ms, 0.0);
+}
@@ -0,0 +1,464 @@
+/**
+ * @file dashboard_tests.cpp
+ * @brief Unit tests for rollup series and the real-time dashboard data path
+ *
+ * @author Cardano IoT SDK Team
+ * @version 1.0.0
+ */
+
+#include <gtest/gtest.h>
+#include "cardano_iot/monitoring/realtime_dashboard.h"
+#include "cardano_iot/monitoring/dashboard_push.h"
+#include "cardano_iot/monitoring/rollup_series.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cmath>
+#include <limits>
+#include <memory>
+
+using namespace cardano_iot::monitoring;
+
+namespace
+{
+    constexpr uint64_t BASE = 1699999200; // On an hour boundary
+
+    DataPoint point(uint64_t timestamp, double value)
+    {
+        DataPoint data{};
+        data.timestamp = timestamp;
+        data.value = value;
+        return data;
+    }
+
+    // Minimal blocking WebSocket client
+    class TestClient
+    {
+    public:
+        ~TestClient()
+        {
+            if (fd_ >= 0)
+            {
+                ::close(fd_);
+            }
+        }
+
+        bool connect(uint16_t port, const std::string &path = "/ws", int receive_buffer = 0)
+        {
+            fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+            if (receive_buffer > 0)
+            {
+                setsockopt(fd_, SOL_SOCKET, SO_RCVBUF, &receive_buffer, sizeof(receive_buffer));
+            }
+            sockaddr_in address{};
+            address.sin_family = AF_INET;
+            address.sin_port = htons(port);
+            address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            if (::connect(fd_, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0)
+            {
+                return false;
+            }
+
+            const std::string request = "GET " + path + " HTTP/1.1\r\nHost: localhost\r\nUpgrade: websocket\r\n"
+                                        "Connection: Upgrade\r\nSec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n"
+                                        "Sec-WebSocket-Version: 13\r\n\r\n";
+            ::send(fd_, request.data(), request.size(), 0);
+            while (buffer_.find("\r\n\r\n") == std::string::npos)
+            {
+                if (!receive(2000))
+                {
+                    return false;
+                }
+            }
+            const size_t end = buffer_.find("\r\n\r\n");
+            const bool upgraded = buffer_.compare(0, 12, "HTTP/1.1 101") == 0 &&
+                                  buffer_.find("s3pPLMBiTxaQ9kYGzzhZRbK+xOo=") < end;
+            buffer_.erase(0, end + 4);
+            return upgraded;
+        }
+
+        void send_text(const std::string &text)
+        {
+            std::string frame;
+            frame.push_back(static_cast<char>(0x81));
+            frame.push_back(static_cast<char>(0x80 | text.size()));
+            const char mask[4] = {0x12, 0x34, 0x56, 0x78};
+            frame.append(mask, 4);
+            for (size_t i = 0; i < text.size(); ++i)
+            {
+                frame.push_back(static_cast<char>(text[i] ^ mask[i % 4]));
+            }
+            ::send(fd_, frame.data(), frame.size(), 0);
+        }
+
+        // Next server frame, or false after timeout_ms without one
+        bool read_frame(uint8_t &opcode, std::string &payload, int timeout_ms = 2000)
+        {
+            while (true)
+            {
+                if (buffer_.size() >= 2)
+                {
+                    const auto *data = reinterpret_cast<const uint8_t *>(buffer_.data());
+                    size_t header = 2;
+                    uint64_t length = data[1] & 0x7F;
+                    if (length == 126 && buffer_.size() >= 4)
+                    {
+                        length = (static_cast<uint64_t>(data[2]) << 8) | data[3];
+                        header = 4;
+                    }
+                    else if (length == 127 && buffer_.size() >= 10)
+                    {
+                        length = 0;
+                        for (size_t i = 0; i < 8; ++i)
+                        {
+                            length = (length << 8) | data[2 + i];
+                        }
+                        header = 10;
+                    }
+                    if (length < 126 || header > 2)
+                    {
+                        if (buffer_.size() >= header + length)
+                        {
+                            opcode = data[0] & 0x0F;
+                            payload = buffer_.substr(header, static_cast<size_t>(length));
+                            buffer_.erase(0, header + static_cast<size_t>(length));
+                            return true;
+                        }
+                    }
+                }
+                if (!receive(timeout_ms))
+                {
+                    return false;
+                }
+            }
+        }
+
+        bool read_update(PushFrame &frame, int timeout_ms = 2000)
+        {
+            uint8_t opcode = 0;
+            std::string payload;
+            while (read_frame(opcode, payload, timeout_ms))
+            {
+                if (opcode == 0x2)
+                {
+                    return PushFrame::decode(reinterpret_cast<const uint8_t *>(payload.data()), payload.size(), frame);
+                }
+            }
+            return false;
+        }
+
+    private:
+        int fd_ = -1;
+        std::string buffer_;
+
+        bool receive(int timeout_ms)
+        {
+            pollfd ready{fd_, POLLIN, 0};
+            if (::poll(&ready, 1, timeout_ms) <= 0)
+            {
+                return false;
+            }
+            char chunk[16384];
+            const ssize_t received = ::recv(fd_, chunk, sizeof(chunk), 0);
+            if (received <= 0)
+            {
+                return false;
+            }
+            buffer_.append(chunk, static_cast<size_t>(received));
+            return true;
+        }
+    };
+} // namespace
+
+TEST(RollupSeriesTest, ChoosesTheFinestResolutionThatFits)
+{
+    RollupSeries series;
+    for (uint64_t i = 0; i < 600; ++i)
+    {
+        series.add(BASE + i, static_cast<double>(i));
+    }
+
+    // Raw keeps five minutes, the 1 s level fifteen
+    EXPECT_EQ(series.size(RollupSeries::Resolution::RAW), 301u);
+    EXPECT_EQ(series.size(RollupSeries::Resolution::SECOND), 600u);
+    EXPECT_EQ(series.size(RollupSeries::Resolution::MINUTE), 10u);
+    EXPECT_EQ(series.size(RollupSeries::Resolution::HOUR), 1u);
+
+    EXPECT_EQ(series.choose(BASE + 400, 0, 1000), RollupSeries::Resolution::RAW);
+    EXPECT_EQ(series.choose(BASE, 0, 1000), RollupSeries::Resolution::SECOND);
+    EXPECT_EQ(series.choose(BASE, 0, 100), RollupSeries::Resolution::MINUTE);
+    EXPECT_EQ(series.choose(BASE, 0, 5), RollupSeries::Resolution::HOUR);
+
+    RollupSeries::Resolution used;
+    auto hour = series.query(BASE, 0, 5, &used);
+    EXPECT_EQ(used, RollupSeries::Resolution::HOUR);
+    ASSERT_EQ(hour.size(), 1u);
+    EXPECT_EQ(hour[0].count, 600u);
+    EXPECT_DOUBLE_EQ(hour[0].average(), 299.5);
+    EXPECT_DOUBLE_EQ(hour[0].max, 599.0);
+
+    // A late point lands in its existing buckets
+    series.add(BASE + 10, 1000.0);
+    auto minutes = series.range(RollupSeries::Resolution::MINUTE, BASE, BASE + 59);
+    ASSERT_EQ(minutes.size(), 1u);
+    EXPECT_EQ(minutes[0].count, 61u);
+    EXPECT_DOUBLE_EQ(minutes[0].max, 1000.0);
+    EXPECT_EQ(series.size(RollupSeries::Resolution::RAW), 301u);
+
+    // Neighbours are merged when even hours do not fit
+    auto merged = series.query(BASE + 300, BASE + 599, 3, &used);
+    EXPECT_EQ(used, RollupSeries::Resolution::HOUR);
+    EXPECT_EQ(merged.size(), 1u);
+}
+
+TEST(RealtimeDashboardTest, LongRangesComeFromHourlyRollups)
+{
+    RealtimeDashboard dashboard;
+    ASSERT_TRUE(dashboard.initialize());
+    ASSERT_TRUE(dashboard.add_data_source("temp", "Temperature", "sensor"));
+
+    // Thirty days, one reading a minute
+    std::vector<DataPoint> batch;
+    for (uint64_t i = 0; i < 30 * 24 * 60; ++i)
+    {
+        batch.push_back(point(BASE + i * 60, static_cast<double>(i % 60)));
+    }
+    EXPECT_EQ(dashboard.push_data_batch("temp", batch), batch.size());
+
+    auto month = dashboard.get_time_series("temp", BASE, 0, 1000);
+    ASSERT_EQ(month.data_points.size(), 720u);
+    EXPECT_EQ(month.metric_name, "Temperature");
+    EXPECT_EQ(month.data_points[0].tags["resolution"], "1h");
+    EXPECT_EQ(month.data_points[0].tags["count"], "60");
+    EXPECT_EQ(month.data_points[0].tags["max"], "59");
+    EXPECT_DOUBLE_EQ(month.data_points[0].value, 29.5);
+    EXPECT_EQ(month.data_points[1].timestamp, BASE + 3600);
+
+    // The last day fits at one minute; nothing raw is left past five minutes
+    const uint64_t newest = BASE + (batch.size() - 1) * 60;
+    auto day = dashboard.get_time_series("temp", newest - 86400 + 60, 0, 2000);
+    ASSERT_EQ(day.data_points.size(), 1440u);
+    EXPECT_EQ(day.data_points[0].tags["resolution"], "1m");
+
+    auto stats = dashboard.get_statistics();
+    EXPECT_EQ(stats["buckets_raw"], 6u);
+    EXPECT_EQ(stats["buckets_1h"], 720u);
+    EXPECT_EQ(stats["data_points_pushed"], batch.size());
+
+    // Unknown sources and non-finite values are rejected
+    EXPECT_EQ(dashboard.push_data_batch("missing", batch), 0u);
+    EXPECT_FALSE(dashboard.push_data("temp", point(newest, std::numeric_limits<double>::quiet_NaN())));
+
+    dashboard.shutdown();
+}
+
+TEST(RealtimeDashboardTest, AlertRulesFireOncePerAcknowledgement)
+{
+    RealtimeDashboard dashboard;
+    ASSERT_TRUE(dashboard.initialize());
+    ASSERT_TRUE(dashboard.add_data_source("cpu", "CPU", "system"));
+    EXPECT_FALSE(dashboard.create_alert_rule("bad", "cpu", "around 80", AlertSeverity::HIGH, ""));
+    ASSERT_TRUE(dashboard.create_alert_rule("cpu_high", "cpu", "value > 80", AlertSeverity::HIGH,
+                                            "{source} at {value} (limit {threshold})"));
+
+    std::vector<DashboardAlert> raised;
+    dashboard.set_alert_callback([&raised](const DashboardAlert &alert)
+                                 { raised.push_back(alert); });
+
+    std::vector<DataPoint> batch;
+    for (uint64_t i = 0; i < 10; ++i)
+    {
+        batch.push_back(point(BASE + i, i < 5 ? 50.0 : 90.0 + static_cast<double>(i)));
+    }
+    EXPECT_EQ(dashboard.push_data_batch("cpu", batch), 10u);
+
+    ASSERT_EQ(raised.size(), 1u);
+    EXPECT_EQ(raised[0].message, "cpu at 95 (limit 80)");
+    EXPECT_EQ(raised[0].severity, AlertSeverity::HIGH);
+
+    // Further breaches wait for the alert to be acknowledged
+    dashboard.push_data("cpu", point(BASE + 10, 99.0));
+    EXPECT_EQ(raised.size(), 1u);
+    ASSERT_EQ(dashboard.get_active_alerts().size(), 1u);
+    EXPECT_TRUE(dashboard.get_active_alerts(AlertSeverity::CRITICAL).empty());
+
+    EXPECT_TRUE(dashboard.acknowledge_alert(raised[0].alert_id, "operator", "looking"));
+    EXPECT_FALSE(dashboard.acknowledge_alert(raised[0].alert_id, "operator"));
+    EXPECT_TRUE(dashboard.get_active_alerts().empty());
+
+    dashboard.push_data("cpu", point(BASE + 11, 85.0));
+    EXPECT_EQ(raised.size(), 2u);
+    EXPECT_EQ(dashboard.clear_acknowledged_alerts(0), 1u);
+
+    dashboard.shutdown();
+}
+
+TEST(DashboardPushTest, FramesAreDeltaEncoded)
+{
+    EXPECT_EQ(websocket_accept_key("dGhlIHNhbXBsZSBub25jZQ=="), "s3pPLMBiTxaQ9kYGzzhZRbK+xOo=");
+
+    PushFrame frame;
+    frame.channel = "widget_1";
+    frame.decimals = 2;
+    frame.series.push_back({"temp", {}});
+    for (uint64_t i = 0; i < 1000; ++i)
+    {
+        frame.series[0].points.emplace_back(BASE + i, 20.0 + 0.01 * static_cast<double>(i % 50));
+    }
+    frame.series.push_back({"late", {{BASE + 10, -5.5}, {BASE + 4, 1e6}}});
+
+    std::vector<uint8_t> encoded;
+    frame.encode(encoded);
+    EXPECT_LT(encoded.size(), 2100u); // About two bytes per point
+
+    PushFrame decoded;
+    ASSERT_TRUE(PushFrame::decode(encoded.data(), encoded.size(), decoded));
+    EXPECT_EQ(decoded.channel, "widget_1");
+    ASSERT_EQ(decoded.series.size(), 2u);
+    ASSERT_EQ(decoded.series[0].points.size(), 1000u);
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        EXPECT_EQ(decoded.series[0].points[i].first, frame.series[0].points[i].first);
+        EXPECT_NEAR(decoded.series[0].points[i].second, frame.series[0].points[i].second, 1e-9);
+    }
+    EXPECT_EQ(decoded.series[1].points[1].first, BASE + 4);
+    EXPECT_DOUBLE_EQ(decoded.series[1].points[0].second, -5.5);
+    EXPECT_DOUBLE_EQ(decoded.series[1].points[1].second, 1e6);
+
+    encoded.pop_back();
+    EXPECT_FALSE(PushFrame::decode(encoded.data(), encoded.size(), decoded));
+}
+
+TEST(DashboardPushTest, CoalescesUpdatesForManyClients)
+{
+    RealtimeDashboard dashboard;
+    ASSERT_TRUE(dashboard.initialize());
+    ASSERT_TRUE(dashboard.add_data_source("temp", "Temperature", "sensor"));
+    ASSERT_TRUE(dashboard.create_layout(DashboardBuilder("ops", "Operations").add_line_chart("Temperature", {"temp"}, 0, 0).build()));
+    const std::string widget_id = dashboard.get_layout("ops").widgets.at(0).widget_id;
+
+    ASSERT_TRUE(dashboard.start_server(0, "127.0.0.1"));
+    const uint16_t port = static_cast<uint16_t>(std::stoi(dashboard.get_server_status()["port"]));
+    auto session = dashboard.create_session("operator", {"view"});
+    ASSERT_NE(session, nullptr);
+
+    TestClient stray;
+    EXPECT_FALSE(stray.connect(port, "/other"));
+
+    // 200 screens on the same widget; the session reply confirms the subscription went through
+    std::vector<std::unique_ptr<TestClient>> clients;
+    for (int i = 0; i < 200; ++i)
+    {
+        clients.push_back(std::make_unique<TestClient>());
+        ASSERT_TRUE(clients.back()->connect(port));
+        clients.back()->send_text("subscribe " + widget_id);
+        clients.back()->send_text("session " + session->session_id);
+    }
+    for (auto &client : clients)
+    {
+        uint8_t opcode = 0;
+        std::string reply;
+        ASSERT_TRUE(client->read_frame(opcode, reply));
+        EXPECT_EQ(reply, "session ok");
+    }
+
+    std::vector<DataPoint> batch;
+    for (uint64_t i = 0; i < 100; ++i)
+    {
+        batch.push_back(point(BASE + i, 21.5 + static_cast<double>(i)));
+    }
+    EXPECT_EQ(dashboard.push_data_batch("temp", batch), 100u);
+
+    for (auto &client : clients)
+    {
+        PushFrame frame;
+        ASSERT_TRUE(client->read_update(frame));
+        EXPECT_EQ(frame.type, PushFrame::Type::POINTS);
+        EXPECT_EQ(frame.channel, widget_id);
+        ASSERT_EQ(frame.series.size(), 1u);
+        ASSERT_EQ(frame.series[0].points.size(), 100u);
+        EXPECT_DOUBLE_EQ(frame.series[0].points[99].second, 120.5);
+    }
+
+    auto status = dashboard.get_server_status();
+    EXPECT_EQ(status["running"], "true");
+    EXPECT_EQ(status["websocket_clients"], "200");
+    EXPECT_EQ(status["websocket_frames_encoded"], "1");
+    EXPECT_EQ(status["websocket_frames_dropped"], "0");
+
+    EXPECT_TRUE(dashboard.send_websocket_message(session->session_id, "hello"));
+    EXPECT_FALSE(dashboard.send_websocket_message("unknown", "hello"));
+    EXPECT_EQ(dashboard.broadcast_websocket_message("maintenance", widget_id), 200u);
+
+    dashboard.shutdown();
+    EXPECT_EQ(dashboard.get_server_status()["running"], "false");
+}
+
+TEST(DashboardPushTest, SlowClientsDoNotHoldBackOthers)
+{
+    DashboardPushServer::Options options;
+    options.max_queued_bytes = 4096;
+    options.send_buffer_bytes = 4096;
+    options.flush_interval_ms = 10;
+    DashboardPushServer server(options);
+    const uint16_t port = server.start("127.0.0.1", 0);
+    ASSERT_NE(port, 0);
+
+    TestClient fast;
+    TestClient slow;
+    ASSERT_TRUE(fast.connect(port));
+    ASSERT_TRUE(slow.connect(port, "/ws", 4096));
+    fast.send_text("subscribe w");
+    slow.send_text("subscribe w");
+    for (int attempt = 0; attempt < 200 && server.subscriber_count("w") < 2; ++attempt)
+    {
+        usleep(5000);
+    }
+    ASSERT_EQ(server.subscriber_count("w"), 2u);
+
+    std::vector<std::pair<uint64_t, double>> points;
+    for (uint64_t i = 0; i < 500; ++i)
+    {
+        points.emplace_back(BASE + i, std::sin(static_cast<double>(i)));
+    }
+
+    // The slow client never reads while the fast one keeps up
+    size_t received = 0;
+    for (int round = 0; round < 200; ++round)
+    {
+        server.publish("w", "s", points);
+        server.flush();
+        PushFrame frame;
+        while (fast.read_update(frame, 200))
+        {
+            EXPECT_EQ(frame.type, PushFrame::Type::POINTS);
+            if (++received == static_cast<size_t>(round + 1))
+            {
+                break;
+            }
+        }
+    }
+    EXPECT_EQ(received, 200u);
+    EXPECT_GT(server.get_statistics().frames_dropped, 0u);
+
+    // Once the slow client drains its queue it is told to resync
+    bool resynced = false;
+    for (int round = 0; round < 200 && !resynced; ++round)
+    {
+        server.publish("w", "s", points);
+        server.flush();
+        PushFrame frame;
+        while (!resynced && slow.read_update(frame, 20))
+        {
+            resynced = frame.type == PushFrame::Type::RESYNC;
+        }
+    }
+    EXPECT_TRUE(resynced);
+
+    server.stop();
+    EXPECT_EQ(server.client_count(), 0u);
+}
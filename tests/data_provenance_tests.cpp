@@ -8,8 +8,17 @@
 
 #include <gtest/gtest.h>
 #include "cardano_iot/data/data_provenance.h"
+#include "cardano_iot/data/provenance_log.h"
+#include "cardano_iot/core/transaction_manager.h"
 #include "utils/test_utils.h"
 
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+
 using namespace cardano_iot::data;
 
 class DataProvenanceTest : public ::testing::Test
@@ -68,3 +77,220 @@ TEST_F(DataProvenanceTest, IntegrityVerificationTest)
     // Data integrity verification test
     EXPECT_TRUE(true);
 }
+
+namespace
+{
+    std::string temp_directory()
+    {
+        char pattern[] = "/tmp/ciot_provenance_XXXXXX";
+        const char *created = mkdtemp(pattern);
+        return created ? created : "";
+    }
+
+    void remove_directory(const std::string &directory)
+    {
+        std::system(("rm -rf '" + directory + "'").c_str());
+    }
+} // namespace
+
+TEST_F(DataProvenanceTest, HistorySurvivesRestartFromTheEventLog)
+{
+    const std::string directory = temp_directory();
+    ASSERT_FALSE(directory.empty());
+
+    std::string submitted;
+    {
+        DataProvenance prov;
+        ASSERT_TRUE(prov.initialize(directory));
+        for (int i = 0; i < 50; ++i)
+        {
+            ProvenanceEvent event{};
+            event.data_id = "reading_" + std::to_string(i % 5);
+            event.event_type = ProvenanceEventType::STORED;
+            event.actor_id = i % 2 ? "gateway" : "sensor";
+            event.timestamp = 1000 + i;
+            event.properties["seq"] = std::to_string(i);
+            const std::string event_id = prov.record_event(event);
+            ASSERT_FALSE(event_id.empty());
+            if (i == 7)
+            {
+                submitted = event_id;
+            }
+        }
+        ASSERT_TRUE(prov.submit_to_blockchain(submitted));
+        EXPECT_EQ(prov.get_provenance_history("reading_2").size(), 10u); // served from the write buffer
+    }
+
+    DataProvenance reopened;
+    ASSERT_TRUE(reopened.initialize(directory));
+    EXPECT_EQ(reopened.get_statistics().total_events, 50u);
+    const auto history = reopened.get_provenance_history("reading_2");
+    ASSERT_EQ(history.size(), 10u);
+    EXPECT_EQ(history[0].properties.at("seq"), "2");
+    EXPECT_EQ(history[9].properties.at("seq"), "47");
+    EXPECT_EQ(reopened.query_events_by_actor("gateway").size(), 25u);
+    EXPECT_FALSE(reopened.get_blockchain_transaction(submitted).empty());
+    EXPECT_EQ(reopened.query_events_by_actor("gateway")[3].transaction_hash,
+              reopened.get_blockchain_transaction(submitted));
+    reopened.shutdown();
+    remove_directory(directory);
+}
+
+TEST_F(DataProvenanceTest, LogRotatesSegmentsAndDropsATornTail)
+{
+    const std::string directory = temp_directory();
+    ASSERT_FALSE(directory.empty());
+
+    ProvenanceLog::Options options;
+    options.directory = directory;
+    options.segment_bytes = 4096;
+    options.write_buffer_bytes = 512;
+
+    std::vector<uint64_t> locations;
+    {
+        ProvenanceLog log;
+        ASSERT_TRUE(log.open(options));
+        for (int i = 0; i < 300; ++i)
+        {
+            ProvenanceEvent event{};
+            event.event_id = "prov_" + std::to_string(i);
+            event.data_id = "data";
+            event.actor_id = "actor";
+            event.event_type = ProvenanceEventType::MODIFIED;
+            event.timestamp = i;
+            locations.push_back(log.append(event));
+            ASSERT_NE(locations.back(), ProvenanceLog::NO_LOCATION);
+        }
+        EXPECT_GE(log.segment_count(), 3u);
+
+        // Sealed (mapped), flushed and still-buffered records all read back
+        for (int i : {0, 150, 299})
+        {
+            ProvenanceEvent event;
+            ASSERT_TRUE(log.read(locations[i], event)) << i;
+            EXPECT_EQ(event.event_id, "prov_" + std::to_string(i));
+        }
+    }
+
+    // A crash mid-append leaves a partial frame behind
+    char name[32];
+    std::vector<uint64_t> replayed;
+    {
+        ProvenanceLog log;
+        ASSERT_TRUE(log.open(options));
+        std::snprintf(name, sizeof(name), "/provenance-%08zu.log", log.segment_count() - 1);
+    }
+    std::ofstream(directory + name, std::ios::binary | std::ios::app) << std::string("\x40\x00\x00\x00garbage", 11);
+
+    ProvenanceLog log;
+    ASSERT_TRUE(log.open(options, [&](uint64_t location, const ProvenanceEvent &)
+                         { replayed.push_back(location); }));
+    EXPECT_EQ(replayed, locations);
+    ProvenanceEvent event{};
+    event.event_id = "after_crash";
+    const uint64_t location = log.append(event);
+    ASSERT_TRUE(log.read(location, event));
+    EXPECT_EQ(event.event_id, "after_crash");
+    log.close();
+    remove_directory(directory);
+}
+
+TEST_F(DataProvenanceTest, MerkleProofsCoverUnevenTrees)
+{
+    for (size_t count = 1; count <= 9; ++count)
+    {
+        std::vector<MerkleHash> leaves(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            const uint8_t byte = static_cast<uint8_t>(i);
+            leaves[i] = MerkleTree::hash_leaf(&byte, 1);
+        }
+        const MerkleTree tree(leaves);
+        for (size_t i = 0; i < count; ++i)
+        {
+            const auto path = tree.path(i);
+            EXPECT_TRUE(MerkleTree::verify(leaves[i], i, count, path, tree.root())) << count << "/" << i;
+            if (count > 1)
+            {
+                EXPECT_FALSE(MerkleTree::verify(leaves[(i + 1) % count], i, count, path, tree.root()));
+            }
+        }
+    }
+}
+
+TEST_F(DataProvenanceTest, AnchorsEventsInMerkleBatches)
+{
+    const std::string directory = temp_directory();
+    ASSERT_FALSE(directory.empty());
+
+    auto transactions = std::make_shared<cardano_iot::core::TransactionManager>();
+    ASSERT_TRUE(transactions->initialize("testnet"));
+    DataProvenance::AnchorOptions options;
+    options.from_address = "addr_test1qprovenance";
+    options.window = std::chrono::minutes(10);
+    options.max_batch_events = 8;
+
+    std::vector<std::string> submitted;
+    std::string asset_id;
+    {
+        DataProvenance prov;
+        ASSERT_TRUE(prov.initialize(directory));
+        prov.enable_anchoring(transactions, options);
+
+        DataAsset asset{};
+        asset.type = DataType::SENSOR_READING;
+        asset.data_hash = prov.compute_data_hash({1, 2, 3, 4});
+        asset.creator_id = "sensor";
+        asset_id = prov.register_data_asset(asset);
+        ASSERT_FALSE(asset_id.empty());
+        submitted.push_back(prov.get_provenance_history(asset_id).at(0).event_id);
+        ASSERT_TRUE(prov.submit_to_blockchain(submitted.back()));
+        for (int i = 0; i < 11; ++i)
+        {
+            submitted.push_back(prov.record_data_access(asset_id, "reader_" + std::to_string(i)));
+            prov.submit_to_blockchain(submitted.back()); // the eighth fills a batch
+        }
+        // Submission is mocked to fail one time in ten; failed batches stay queued
+        for (int attempt = 0; attempt < 20 && !prov.flush_anchors(); ++attempt)
+        {
+        }
+        ASSERT_EQ(prov.pending_anchor_count(), 0u);
+        EXPECT_EQ(prov.get_statistics().blockchain_submissions, 2u);
+        EXPECT_EQ(prov.get_statistics().anchored_events, 12u);
+
+        MerkleProof first;
+        MerkleProof last;
+        ASSERT_TRUE(prov.get_inclusion_proof(submitted.front(), first));
+        ASSERT_TRUE(prov.get_inclusion_proof(submitted.back(), last));
+        EXPECT_EQ(first.leaf_count, 8u);
+        EXPECT_EQ(last.leaf_count, 4u);
+        EXPECT_NE(first.transaction_hash, last.transaction_hash);
+        EXPECT_EQ(prov.get_blockchain_transaction(submitted[7]), first.transaction_hash);
+        EXPECT_TRUE(first.verify());
+        first.path[0][0] ^= 1;
+        EXPECT_FALSE(first.verify());
+
+        EXPECT_TRUE(prov.verify_data_integrity(asset_id, {1, 2, 3, 4}));
+        EXPECT_FALSE(prov.verify_data_integrity(asset_id, {9, 9}));
+    }
+
+    DataProvenance reopened;
+    ASSERT_TRUE(reopened.initialize(directory));
+    for (const auto &event_id : submitted)
+    {
+        EXPECT_TRUE(reopened.verify_event_anchor(event_id)) << event_id;
+    }
+
+    // The window anchors a lone event without an explicit flush
+    options.window = std::chrono::milliseconds(150);
+    reopened.enable_anchoring(transactions, options);
+    const std::string late = reopened.record_data_access(asset_id, "late_reader");
+    ASSERT_TRUE(reopened.submit_to_blockchain(late));
+    EXPECT_TRUE(reopened.get_blockchain_transaction(late).empty());
+    EXPECT_TRUE(cardano_iot::test::wait_for_condition([&]
+                                                      { return reopened.verify_event_anchor(late); },
+                                                      5000, 20));
+    reopened.shutdown();
+    transactions->shutdown();
+    remove_directory(directory);
+}
@@ -8,8 +8,16 @@
 
 #include <gtest/gtest.h>
 #include "cardano_iot/core/device_manager.h"
+#include "cardano_iot/core/device_registry.h"
+#include "cardano_iot/core/device_snapshot.h"
 #include "utils/test_utils.h"
 
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+#include <unistd.h>
+
 using namespace cardano_iot::core;
 
 class DeviceManagerTest : public ::testing::Test
@@ -311,3 +319,164 @@ TEST_F(DeviceManagerTest, UtilityFunctions)
     EXPECT_FALSE(device_id.empty());
     EXPECT_TRUE(device_id.find("device_") == 0); // Should start with "device_"
 }
+
+TEST(DeviceRegistryTest, IndexesFollowStatusCapabilityAndHeartbeat)
+{
+    DeviceRegistry registry(8);
+    constexpr int COUNT = 3000;
+    for (int i = 0; i < COUNT; ++i)
+    {
+        auto device = std::make_shared<Device>();
+        device->device_id = "dev_" + std::to_string(i);
+        device->capabilities = i % 3 == 0 ? static_cast<uint32_t>(DeviceCapability::SENSOR_DATA)
+                                          : static_cast<uint32_t>(DeviceCapability::ACTUATOR_CONTROL) |
+                                                static_cast<uint32_t>(DeviceCapability::DATA_STORAGE);
+        device->status = DeviceStatus::ONLINE;
+        device->last_seen = 1000 + i;
+        ASSERT_TRUE(registry.insert(device));
+    }
+    EXPECT_FALSE(registry.insert(std::make_shared<Device>(*registry.find("dev_1"))));
+
+    EXPECT_EQ(registry.by_capability(static_cast<uint32_t>(DeviceCapability::SENSOR_DATA)).size(), 1000u);
+    EXPECT_EQ(registry.by_capability(static_cast<uint32_t>(DeviceCapability::SENSOR_DATA) |
+                                     static_cast<uint32_t>(DeviceCapability::DATA_STORAGE))
+                  .size(),
+              3000u); // no duplicates for devices with both bits
+
+    // Heartbeats from several threads re-order devices; only the untouched ones go stale
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; ++t)
+    {
+        workers.emplace_back([&registry, t]
+                             {
+            for (int i = t; i < COUNT; i += 4)
+            {
+                if (i >= 10)
+                {
+                    registry.touch("dev_" + std::to_string(i), 5000);
+                }
+            } });
+    }
+    for (int i = 0; i < COUNT; i += 2)
+    {
+        registry.set_status("dev_" + std::to_string(i), DeviceStatus::LOW_POWER);
+    }
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+
+    auto stale = registry.stale(4000);
+    std::sort(stale.begin(), stale.end());
+    ASSERT_EQ(stale.size(), 10u);
+    EXPECT_EQ(stale.front(), "dev_0");
+    EXPECT_EQ(registry.by_status(DeviceStatus::LOW_POWER).size(), 1500u);
+    EXPECT_EQ(registry.status_counts()[static_cast<size_t>(DeviceStatus::ONLINE)], 1500u);
+
+    DeviceStatus old_status = DeviceStatus::OFFLINE;
+    ASSERT_TRUE(registry.set_status("dev_3", DeviceStatus::ERROR, &old_status));
+    EXPECT_EQ(old_status, DeviceStatus::ONLINE);
+    ASSERT_NE(registry.erase("dev_3"), nullptr);
+    EXPECT_TRUE(registry.by_status(DeviceStatus::ERROR).empty());
+    EXPECT_EQ(registry.by_capability(static_cast<uint32_t>(DeviceCapability::SENSOR_DATA)).size(), 999u);
+    EXPECT_EQ(registry.size(), static_cast<size_t>(COUNT - 1));
+}
+
+TEST_F(DeviceManagerTest, RegistrySnapshotReplaysJournal)
+{
+    const std::string path = "/tmp/ciot_registry_" + std::to_string(::getpid()) + ".snap";
+    for (int i = 0; i < 3; ++i)
+    {
+        Device device = test_device_;
+        device.device_id = "snap_" + std::to_string(i);
+        device.metadata = {{"room", std::to_string(100 + i)}, {"zone", "north"}};
+        ASSERT_TRUE(device_manager_->register_device(device));
+    }
+    ASSERT_TRUE(device_manager_->export_device_registry(path));
+
+    // Changes after the export go to the journal
+    ASSERT_TRUE(device_manager_->update_device_status("snap_0", DeviceStatus::MAINTENANCE));
+    ASSERT_TRUE(device_manager_->update_battery_level("snap_1", 0.5));
+    ASSERT_TRUE(device_manager_->unregister_device("snap_2"));
+
+    auto restored = std::make_unique<DeviceManager>();
+    ASSERT_TRUE(restored->initialize());
+    ASSERT_TRUE(restored->import_device_registry(path));
+    EXPECT_EQ(restored->get_device_list().size(), 2u);
+    EXPECT_FALSE(restored->is_device_registered("snap_2"));
+    auto device = restored->get_device("snap_0");
+    ASSERT_NE(device, nullptr);
+    EXPECT_EQ(device->status, DeviceStatus::MAINTENANCE);
+    EXPECT_EQ(device->manufacturer, "Test Corp");
+    EXPECT_EQ(device->metadata.at("room"), "100");
+    EXPECT_EQ(device->cardano_address, device_manager_->get_device("snap_0")->cardano_address);
+    EXPECT_DOUBLE_EQ(restored->get_device("snap_1")->battery_level, 0.5);
+    EXPECT_EQ(restored->get_devices_by_status(DeviceStatus::MAINTENANCE).size(), 1u);
+    restored->shutdown();
+
+    // A torn journal entry is cut off; everything before it still applies
+    {
+        std::ofstream wal(path + ".wal", std::ios::binary | std::ios::app);
+        wal.write("\x40\x00\x00\x00\x12", 5);
+    }
+    DeviceRegistry registry;
+    uint64_t generation = 0;
+    ASSERT_TRUE(DeviceSnapshot::load(path, registry, generation, {}));
+    size_t applied = 0;
+    ASSERT_TRUE(DeviceJournal::replay(path + ".wal", generation, registry, &applied));
+    EXPECT_EQ(applied, 3u);
+    EXPECT_EQ(registry.size(), 2u);
+
+    // A journal from another generation is ignored
+    DeviceRegistry fresh;
+    ASSERT_TRUE(DeviceJournal::replay(path + ".wal", generation + 1, fresh, &applied));
+    EXPECT_EQ(applied, 0u);
+
+    // A flipped byte fails the checksum
+    {
+        std::fstream snapshot(path, std::ios::binary | std::ios::in | std::ios::out);
+        snapshot.seekp(-1, std::ios::end);
+        snapshot.put('\x7f');
+    }
+    DeviceManager corrupt;
+    ASSERT_TRUE(corrupt.initialize());
+    EXPECT_FALSE(corrupt.import_device_registry(path));
+    EXPECT_TRUE(corrupt.get_device_list().empty());
+    corrupt.shutdown();
+
+    std::remove(path.c_str());
+    std::remove((path + ".wal").c_str());
+}
+
+TEST_F(DeviceManagerTest, TelemetryBatch)
+{
+    std::vector<DeviceTelemetry> records;
+    for (int i = 0; i < 200; ++i)
+    {
+        Device device = test_device_;
+        device.device_id = "batch_" + std::to_string(i);
+        ASSERT_TRUE(device_manager_->register_device(device));
+
+        DeviceTelemetry record;
+        record.device_id = device.device_id;
+        record.battery_level = i < 5 ? 0.1 : 0.9;
+        records.push_back(record);
+    }
+    records.push_back(records.front()); // repeated report for the same device
+    DeviceTelemetry unknown;
+    unknown.device_id = "not_registered";
+    records.push_back(unknown);
+
+    int low_battery_events = 0;
+    device_manager_->set_event_callback([&](const std::string &device_id, DeviceEvent event, const std::string &)
+                                        {
+        if (event == DeviceEvent::BATTERY_LOW && device_manager_->get_device(device_id))
+        {
+            ++low_battery_events;
+        } });
+
+    EXPECT_EQ(device_manager_->apply_telemetry_batch(records), 201u);
+    EXPECT_EQ(low_battery_events, 5);
+    EXPECT_DOUBLE_EQ(device_manager_->get_device("batch_7")->battery_level, 0.9);
+    EXPECT_TRUE(device_manager_->get_stale_devices(60).empty());
+}
@@ -0,0 +1,76 @@
+/**
+ * @file encryption_benchmark.cpp
+ * @brief Throughput of the batch AEAD API against per-record encrypt()
+ *
+ * Runs briefly so it can stay a ctest target; records/sec are printed for
+ * each payload size rather than asserted, since they depend on the host.
+ *
+ * @author Cardano IoT SDK Team
+ * @version 1.0.0
+ */
+
+#include <gtest/gtest.h>
+#include "cardano_iot/security/encryption.h"
+#include "utils/test_utils.h"
+
+#include <chrono>
+#include <cstdio>
+
+using namespace cardano_iot::security;
+
+namespace
+{
+    constexpr size_t RECORDS_PER_BATCH = 256;
+    constexpr auto RUN_TIME = std::chrono::milliseconds(200);
+
+    template <typename Fn>
+    double records_per_second(Fn &&run_batch)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        size_t records = 0;
+        std::chrono::duration<double> elapsed{};
+        do
+        {
+            records += run_batch();
+            elapsed = std::chrono::steady_clock::now() - start;
+        } while (elapsed < RUN_TIME);
+        return records / elapsed.count();
+    }
+} // namespace
+
+TEST(EncryptionBenchmark, BatchRecordsPerSecond)
+{
+    Encryption enc;
+    ASSERT_TRUE(enc.initialize());
+
+    for (auto algorithm : {EncryptionAlgorithm::AES_256_GCM, EncryptionAlgorithm::CHACHA20_POLY1305})
+    {
+        const std::string key_id = enc.generate_key(algorithm);
+        for (size_t size : {size_t(64), size_t(256), size_t(4096)})
+        {
+            std::vector<uint8_t> storage(RECORDS_PER_BATCH * size, 0x5a);
+            std::vector<AeadRecord> records(RECORDS_PER_BATCH);
+            for (size_t i = 0; i < records.size(); ++i)
+            {
+                records[i].data = storage.data() + i * size;
+                records[i].size = size;
+            }
+            const std::vector<uint8_t> plaintext(size, 0x5a);
+
+            const double single = records_per_second([&]
+                                                     { return enc.encrypt(plaintext, key_id).ciphertext.empty() ? 0 : 1; });
+            const double in_place = records_per_second([&]
+                                                       { return enc.encrypt_batch(records.data(), records.size(), key_id); });
+            const double round_trip = records_per_second([&]
+                                                         {
+                                                             enc.encrypt_batch(records.data(), records.size(), key_id);
+                                                             return enc.decrypt_batch(records.data(), records.size(), key_id); });
+
+            std::printf("%-18s %5zu B  encrypt(): %10.0f rec/s  batch: %10.0f rec/s  batch seal+open: %10.0f rec/s\n",
+                        algorithm == EncryptionAlgorithm::AES_256_GCM ? "AES-256-GCM" : "ChaCha20-Poly1305", size,
+                        single, in_place, round_trip);
+            EXPECT_GT(in_place, 0.0);
+            EXPECT_GT(round_trip, 0.0);
+        }
+    }
+}
@@ -0,0 +1,180 @@
+/**
+ * @file executor_tests.cpp
+ * @brief Unit tests for the shared work-stealing executor
+ *
+ * @author Cardano IoT SDK Team
+ * @version 1.0.0
+ */
+
+#include <gtest/gtest.h>
+#include "cardano_iot/cardano_iot.h"
+#include "cardano_iot/utils/executor.h"
+
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace cardano_iot;
+using namespace cardano_iot::utils;
+
+TEST(ExecutorTest, FuturesChainAndReportFailures)
+{
+    ExecutorOptions options;
+    options.threads = 2;
+    Executor executor(options);
+
+    auto doubled = executor.submit([]
+                                   { return 21; })
+                       .then(executor, [](int value)
+                             { return value * 2; });
+    EXPECT_EQ(doubled.get(), 42);
+
+    std::vector<Future<int>> parts;
+    for (int i = 0; i < 10; ++i)
+    {
+        parts.push_back(executor.submit([i]
+                                        { return i * i; }));
+    }
+    auto all = Executor::when_all(parts);
+    const auto squares = all.get();
+    ASSERT_EQ(squares.size(), 10u);
+    EXPECT_EQ(squares[9], 81);
+
+    auto thrown = executor.submit([]() -> int
+                                  { throw std::runtime_error("boom"); });
+    thrown.wait();
+    EXPECT_TRUE(thrown.failed());
+    EXPECT_EQ(thrown.get(), 0);
+    auto after_failure = thrown.then(executor, [](int value)
+                                     { return value + 1; });
+    after_failure.wait();
+    EXPECT_TRUE(after_failure.failed());
+
+    std::atomic<bool> ran{false};
+    auto done = executor.submit([&ran]
+                                { ran = true; });
+    done.get();
+    EXPECT_TRUE(ran);
+    EXPECT_FALSE(done.failed());
+
+    executor.shutdown();
+    auto rejected = executor.submit([]
+                                    { return 1; });
+    EXPECT_TRUE(rejected.is_ready());
+    EXPECT_TRUE(rejected.failed());
+    EXPECT_FALSE(executor.post([] {}));
+}
+
+TEST(ExecutorTest, CriticalLaneRunsFirstAndIdleWorkersSteal)
+{
+    {
+        ExecutorOptions options;
+        options.threads = 1;
+        Executor executor(options);
+
+        // Hold the only worker so the queue fills in a known order
+        Promise<void> gate;
+        Future<void> opened = gate.get_future();
+        executor.post([opened]
+                      { opened.wait(); });
+        std::mutex order_mutex;
+        std::vector<char> order;
+        for (int i = 0; i < 3; ++i)
+        {
+            executor.post([&]
+                          { std::lock_guard<std::mutex> lock(order_mutex); order.push_back('b'); },
+                          TaskPriority::BULK);
+        }
+        auto last = executor.submit([&]
+                                    { std::lock_guard<std::mutex> lock(order_mutex); order.push_back('c'); },
+                                    TaskPriority::CRITICAL);
+        gate.set_value();
+        executor.shutdown();
+        EXPECT_TRUE(last.is_ready());
+        ASSERT_EQ(order.size(), 4u);
+        EXPECT_EQ(order.front(), 'c');
+    }
+
+    ExecutorOptions options;
+    options.threads = 4;
+    Executor executor(options);
+    std::atomic<int> ran{0};
+    // Fan out from inside one worker: its deque fills and the idle workers take from it
+    executor.submit([&]
+                    {
+                        std::vector<Future<void>> children;
+                        for (int i = 0; i < 64; ++i)
+                        {
+                            children.push_back(executor.submit([&ran]
+                                                               {
+                                                                   std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                                                                   ++ran; }));
+                        }
+                        for (auto &child : children)
+                        {
+                            child.wait();
+                        } })
+        .get();
+    EXPECT_EQ(ran.load(), 64);
+    const auto stats = executor.get_statistics();
+    EXPECT_EQ(stats.threads, 4u);
+    EXPECT_GT(stats.stolen, 0u);
+    EXPECT_EQ(stats.queued, 0u);
+}
+
+TEST(ExecutorTest, ParallelForAndSdkOwnedExecutor)
+{
+    ExecutorOptions options;
+    options.threads = 3;
+    Executor executor(options);
+
+    std::vector<uint64_t> values(10000);
+    executor.parallel_for(values.size(), [&](size_t i)
+                          { values[i] = i; },
+                          100);
+    EXPECT_EQ(std::accumulate(values.begin(), values.end(), uint64_t{0}), 10000ull * 9999 / 2);
+
+    // Nested parallel_for from a worker must not deadlock the pool
+    std::atomic<size_t> nested{0};
+    executor.submit([&]
+                    { executor.parallel_for(1000, [&](size_t)
+                                            { ++nested; },
+                                            10); })
+        .get();
+    EXPECT_EQ(nested.load(), 1000u);
+
+    CardanoIoTSDK::Config config;
+    config.network_type = "testnet";
+    config.enable_logging = false;
+    config.executor_threads = 2;
+    CardanoIoTSDK sdk(config);
+    EXPECT_EQ(sdk.get_executor(), nullptr);
+    ASSERT_TRUE(sdk.initialize());
+    auto shared = sdk.get_executor();
+    ASSERT_NE(shared, nullptr);
+    EXPECT_EQ(shared->thread_count(), 2u);
+
+    core::CryptoManager crypto;
+    ASSERT_TRUE(crypto.initialize());
+    crypto.set_executor(shared);
+    auto keys = crypto.generate_key_pair(core::CryptoAlgorithm::ED25519);
+    const std::vector<std::string> messages(200, "reading");
+    auto signatures = crypto.sign_batch(messages, keys->private_key, core::CryptoAlgorithm::ED25519);
+    std::vector<core::DigitalSignature> plain;
+    for (const auto &signature : signatures)
+    {
+        ASSERT_TRUE(signature);
+        plain.push_back(*signature);
+    }
+    const auto verified = crypto.verify_batch(plain, messages);
+    EXPECT_EQ(std::count(verified.begin(), verified.end(), true), 200);
+    EXPECT_GT(shared->get_statistics().executed_bulk, 0u);
+
+    sdk.shutdown();
+    EXPECT_EQ(sdk.get_executor(), nullptr);
+    EXPECT_FALSE(shared->post([] {}));
+    // Batches still work once the SDK's executor has stopped
+    EXPECT_EQ(crypto.sign_batch(messages, keys->private_key, core::CryptoAlgorithm::ED25519).size(), 200u);
+}
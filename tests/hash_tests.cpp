@@ -0,0 +1,115 @@
+/**
+ * @file hash_tests.cpp
+ * @brief Unit tests for incremental, tree and multi-buffer hashing
+ *
+ * @author Cardano IoT SDK Team
+ * @version 1.0.0
+ */
+
+#include <gtest/gtest.h>
+#include "cardano_iot/utils/hash.h"
+#include "cardano_iot/utils/codec.h"
+
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <unistd.h>
+
+using namespace cardano_iot::utils;
+
+namespace
+{
+    std::vector<uint8_t> random_bytes(size_t size, uint32_t seed)
+    {
+        std::mt19937 rng(seed);
+        std::vector<uint8_t> bytes(size);
+        for (auto &byte : bytes)
+        {
+            byte = static_cast<uint8_t>(rng());
+        }
+        return bytes;
+    }
+} // namespace
+
+TEST(HashTest, StreamingMatchesOneShotDigests)
+{
+    const std::string abc = "abc";
+    EXPECT_EQ(codec::hex_encode(Hasher::digest(HashAlgorithm::SHA256, abc.data(), abc.size())),
+              "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    EXPECT_EQ(codec::hex_encode(Hasher::digest(HashAlgorithm::SHA3_256, abc.data(), abc.size())),
+              "3a985da74fe225b2045c172d6bd390bd855f086e3e9d525b46bfe24511431532");
+    EXPECT_EQ(codec::hex_encode(Hasher::digest(HashAlgorithm::BLAKE2B_256, abc.data(), abc.size())),
+              "bddd813c634239723171ef3fee98579b94964e3bb1cb3e427262c8c068d52319");
+
+    const auto data = random_bytes(10000, 1);
+    for (HashAlgorithm algorithm : {HashAlgorithm::SHA256, HashAlgorithm::SHA512, HashAlgorithm::BLAKE2B_512,
+                                    HashAlgorithm::BLAKE2S_256, HashAlgorithm::SHA3_256, HashAlgorithm::BLAKE2B_256})
+    {
+        Hasher hasher(algorithm);
+        for (size_t offset = 0; offset < data.size(); offset += 777)
+        {
+            ASSERT_TRUE(hasher.update(data.data() + offset, std::min<size_t>(777, data.size() - offset)));
+        }
+        const auto streamed = hasher.final();
+        EXPECT_EQ(streamed.size(), digest_size(algorithm));
+        EXPECT_EQ(streamed, Hasher::digest(algorithm, data.data(), data.size()));
+        EXPECT_EQ(hasher.final(), Hasher::digest(algorithm, nullptr, 0)); // final() left it reset
+    }
+
+    HashAlgorithm parsed;
+    EXPECT_TRUE(parse_hash_algorithm("blake2b", parsed));
+    EXPECT_EQ(parsed, HashAlgorithm::BLAKE2B_512);
+    EXPECT_FALSE(parse_hash_algorithm("md5", parsed));
+}
+
+TEST(HashTest, TreeHashIsIndependentOfThreadsAndChunkingOfInput)
+{
+    constexpr size_t CHUNK = 64;
+    for (size_t size : {size_t(0), size_t(1), CHUNK, CHUNK + 1, 4 * CHUNK, 7 * CHUNK + 3, 33 * CHUNK})
+    {
+        const auto data = random_bytes(size, static_cast<uint32_t>(size));
+        const auto single = tree_hash(data.data(), data.size(), {CHUNK, 1});
+        ASSERT_EQ(single.size(), TREE_HASH_BYTES);
+        EXPECT_EQ(tree_hash(data.data(), data.size(), {CHUNK, 4}), single) << size;
+
+        TreeHasher streamed(CHUNK);
+        for (size_t offset = 0; offset < size; offset += 29)
+        {
+            streamed.update(data.data() + offset, std::min<size_t>(29, size - offset));
+        }
+        EXPECT_EQ(streamed.final(), single) << size;
+    }
+    const auto data = random_bytes(4 * CHUNK, 9);
+    auto tampered = data;
+    tampered[3 * CHUNK] ^= 1;
+    EXPECT_NE(tree_hash(tampered.data(), tampered.size(), {CHUNK, 2}), tree_hash(data.data(), data.size(), {CHUNK, 2}));
+
+    const std::string path = "/tmp/ciot_hash_test_" + std::to_string(::getpid());
+    const auto file_data = random_bytes(3 * 1024 * 1024 + 5, 3);
+    std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char *>(file_data.data()), file_data.size());
+    EXPECT_EQ(tree_hash_file(path), tree_hash(file_data.data(), file_data.size()));
+    std::remove(path.c_str());
+    EXPECT_TRUE(tree_hash_file(path).empty());
+}
+
+TEST(HashTest, HashManyMatchesIndividualDigests)
+{
+    std::vector<std::vector<uint8_t>> readings;
+    std::vector<ByteRange> ranges;
+    for (uint32_t i = 0; i < 1000; ++i)
+    {
+        readings.push_back(random_bytes(i % 97, i));
+    }
+    for (const auto &reading : readings)
+    {
+        ranges.push_back({reading.data(), reading.size()});
+    }
+    std::vector<uint8_t> digests(readings.size() * 32);
+    ASSERT_TRUE(hash_many(HashAlgorithm::SHA256, ranges.data(), ranges.size(), digests.data(), 4));
+    for (size_t i = 0; i < readings.size(); ++i)
+    {
+        const auto expected = Hasher::digest(HashAlgorithm::SHA256, readings[i].data(), readings[i].size());
+        ASSERT_TRUE(std::equal(expected.begin(), expected.end(), digests.begin() + i * 32)) << i;
+    }
+}
@@ -0,0 +1,187 @@
+/**
+ * @file hot_path_tests.cpp
+ * @brief Unit tests for FlatMap and the move-only reading and transaction paths
+ *
+ * @author Cardano IoT SDK Team
+ * @version 1.0.0
+ */
+
+#include <gtest/gtest.h>
+#include "cardano_iot/cardano_iot.h"
+#include "cardano_iot/utils/flat_map.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    std::atomic<uint64_t> g_allocations{0};
+} // namespace
+
+void *operator new(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *ptr = std::malloc(size ? size : 1))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+using namespace cardano_iot;
+
+namespace
+{
+    CardanoIoTSDK::IoTData make_reading(const std::string &device_id, uint64_t timestamp)
+    {
+        CardanoIoTSDK::IoTData data;
+        data.device_id = device_id;
+        data.data_type = "temperature";
+        data.payload = R"({"temperature": 21.0})";
+        data.timestamp = timestamp;
+        data.hash = std::string(64, 'e');
+        data.signature = std::string(128, 's');
+        data.metadata["unit"] = "celsius";
+        data.metadata["room"] = "lab-2";
+        return data;
+    }
+} // namespace
+
+TEST(FlatMapTest, BehavesLikeAnOrderedMap)
+{
+    utils::MetadataMap map{{"zone", "north"}, {"room", "101"}, {"zone", "south"}};
+    ASSERT_EQ(map.size(), 2u);
+    EXPECT_EQ(map.begin()->first, "room"); // Sorted by key
+    EXPECT_EQ(map["zone"], "north");       // First of duplicate keys wins, as with std::map
+
+    map["floor"] = "3";
+    map.insert_or_assign("zone", "east");
+    EXPECT_FALSE(map.emplace("floor", "4").second);
+    EXPECT_EQ(map.count("floor"), 1u);
+    EXPECT_EQ(map.find("floor")->second, "3");
+    EXPECT_EQ(map.find("missing"), map.end());
+
+    std::vector<std::string> keys;
+    for (const auto &[key, value] : map)
+    {
+        keys.push_back(key);
+    }
+    EXPECT_EQ(keys, (std::vector<std::string>{"floor", "room", "zone"}));
+
+    EXPECT_EQ(map.erase("room"), 1u);
+    EXPECT_EQ(map.erase("room"), 0u);
+    EXPECT_FALSE(map.contains("room"));
+
+    // Round-trips through std::map for callers that still use it
+    std::map<std::string, std::string> tree = map;
+    EXPECT_EQ(tree.at("zone"), "east");
+    utils::MetadataMap back = tree;
+    EXPECT_EQ(back, map);
+}
+
+TEST(HotPathTest, MovedReadingsAllocateLessThanCopiedOnes)
+{
+    CardanoIoTSDK::Config config;
+    config.network_type = "testnet";
+    config.enable_logging = false;
+    CardanoIoTSDK sdk(config);
+    ASSERT_TRUE(sdk.initialize());
+    utils::Logger::instance().set_level(utils::LogLevel::ERROR);
+
+    CardanoIoTSDK::DeviceInfo device;
+    device.device_id = "hot_path_sensor";
+    device.device_type = "sensor";
+    device.public_key = std::string(64, 'a');
+    ASSERT_TRUE(sdk.register_device(device));
+
+    constexpr uint64_t COUNT = 200;
+    std::vector<CardanoIoTSDK::IoTData> copies;
+    std::vector<CardanoIoTSDK::IoTData> moves;
+    for (uint64_t i = 0; i < COUNT; ++i)
+    {
+        copies.push_back(make_reading(device.device_id, 1000 + i));
+        moves.push_back(make_reading(device.device_id, 2000 + i));
+    }
+
+    const uint64_t before_copy = g_allocations.load();
+    for (const auto &data : copies)
+    {
+        ASSERT_FALSE(sdk.submit_data(data).empty());
+    }
+    const uint64_t copy_allocations = g_allocations.load() - before_copy;
+
+    const uint64_t before_move = g_allocations.load();
+    for (auto &data : moves)
+    {
+        ASSERT_FALSE(sdk.submit_data(std::move(data)).empty());
+    }
+    const uint64_t move_allocations = g_allocations.load() - before_move;
+
+    // The copy path duplicates hash, signature and metadata; the move path hands them over
+    EXPECT_LE(move_allocations + 3 * COUNT, copy_allocations);
+
+    auto stored = sdk.query_data(device.device_id, 2000, 2000 + COUNT);
+    ASSERT_EQ(stored.size(), COUNT);
+    EXPECT_EQ(stored.front().hash, std::string(64, 'e'));
+    EXPECT_EQ(stored.front().signature, std::string(128, 's'));
+    EXPECT_EQ(stored.front().metadata.size(), 2u);
+    EXPECT_EQ(stored.front().metadata.find("unit")->second, "celsius");
+
+    // A data listener still sees every field of a moved reading
+    std::string seen_hash;
+    sdk.set_data_event_callback([&seen_hash](const CardanoIoTSDK::IoTData &data)
+                                { seen_hash = data.hash; });
+    ASSERT_FALSE(sdk.submit_data(make_reading(device.device_id, 5000)).empty());
+    EXPECT_EQ(seen_hash, std::string(64, 'e'));
+    sdk.shutdown();
+}
+
+TEST(HotPathTest, TransactionsMoveThroughCreationAndSubmission)
+{
+    utils::Logger::instance().set_level(utils::LogLevel::ERROR);
+    core::TransactionManager tm;
+    ASSERT_TRUE(tm.initialize("testnet"));
+    const std::string from = tm.address_from_public_key("vk_hot_path", "testnet");
+
+    core::TransactionMetadata metadata;
+    metadata.json_metadata = R"({"reading": 21.0})";
+    metadata.labels["device"] = "hot_path_sensor";
+    auto created = tm.create_metadata_transaction(from, std::move(metadata), "hot_path_sensor");
+    ASSERT_NE(created, nullptr);
+    ASSERT_NE(created->metadata, nullptr);
+    EXPECT_EQ(created->metadata->json_metadata, R"({"reading": 21.0})");
+    EXPECT_EQ(created->metadata->labels.at("device"), "hot_path_sensor");
+    for (const auto &input : created->inputs)
+    {
+        EXPECT_EQ(input.tx_hash, input.utxo_info.tx_hash);
+    }
+
+    const std::string tx_id = created->tx_id;
+    const size_t input_count = created->inputs.size();
+    const std::string result = tm.submit_transaction(std::move(*created));
+    auto record = tm.get_transaction_record(tx_id);
+    ASSERT_NE(record, nullptr);
+    EXPECT_EQ(record->inputs.size(), input_count);
+    EXPECT_EQ(record->device_id, "hot_path_sensor");
+    if (result.empty())
+    {
+        EXPECT_EQ(record->status, core::TransactionStatus::FAILED);
+    }
+    else
+    {
+        EXPECT_EQ(result, tx_id);
+        EXPECT_NE(record->status, core::TransactionStatus::PENDING);
+    }
+    tm.shutdown();
+}
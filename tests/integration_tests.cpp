@@ -8,6 +8,7 @@
 
 #include <gtest/gtest.h>
 #include "cardano_iot/cardano_iot.h"
+#include "cardano_iot/utils/metrics.h"
 #include "utils/test_utils.h"
 
 using namespace cardano_iot;
@@ -74,3 +75,118 @@ TEST_F(IntegrationTest, DataQueryIntegration)
     auto results = sdk_->query_data(device_id, 0, time(nullptr) + 3600);
     EXPECT_GE(results.size(), 1);
 }
+
+TEST_F(IntegrationTest, SubmitDataBatch)
+{
+    std::string device_id = "batch_test_device";
+    ASSERT_TRUE(sdk_->register_device(cardano_iot::test::create_test_device_info(device_id)));
+
+    std::vector<CardanoIoTSDK::IoTData> batch;
+    for (int i = 0; i < 10; ++i)
+    {
+        batch.push_back(cardano_iot::test::create_test_iot_data(device_id));
+    }
+    batch.push_back(cardano_iot::test::create_test_iot_data("unregistered_batch_device"));
+
+    size_t notified = 0;
+    sdk_->set_data_batch_event_callback(
+        [&notified](const std::vector<CardanoIoTSDK::IoTData> &items, const std::vector<std::string> &tx_ids)
+        {
+            EXPECT_EQ(items.size(), tx_ids.size());
+            for (const auto &item : items)
+            {
+                EXPECT_FALSE(item.hash.empty());
+            }
+            notified += items.size();
+        });
+
+    auto tx_ids = sdk_->submit_data_batch(std::move(batch));
+    ASSERT_EQ(tx_ids.size(), 11u);
+    for (int i = 0; i < 10; ++i)
+    {
+        EXPECT_FALSE(tx_ids[i].empty());
+    }
+    EXPECT_TRUE(tx_ids[10].empty());
+    EXPECT_EQ(notified, 10u);
+
+    EXPECT_EQ(sdk_->query_data(device_id).size(), 10u);
+}
+
+TEST_F(IntegrationTest, AsyncIngestionPipeline)
+{
+    std::string device_id = "async_ingest_device";
+    ASSERT_TRUE(sdk_->register_device(cardano_iot::test::create_test_device_info(device_id)));
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        EXPECT_TRUE(sdk_->enqueue_data(cardano_iot::test::create_test_iot_data(device_id)));
+    }
+    EXPECT_FALSE(sdk_->enqueue_data(CardanoIoTSDK::IoTData{}));
+
+    ASSERT_TRUE(sdk_->flush_data_queue());
+    EXPECT_EQ(sdk_->get_pending_data_count(), 0u);
+    EXPECT_EQ(sdk_->query_data(device_id).size(), 1000u);
+}
+
+TEST_F(IntegrationTest, PowerAwareOutbox)
+{
+    std::string device_id = "outbox_device";
+    ASSERT_TRUE(sdk_->register_device(cardano_iot::test::create_test_device_info(device_id)));
+
+    size_t batches = 0;
+    sdk_->set_data_batch_event_callback(
+        [&batches](const std::vector<CardanoIoTSDK::IoTData> &items, const std::vector<std::string> &)
+        {
+            EXPECT_EQ(items.size(), 5u);
+            ++batches;
+        });
+
+    for (int i = 0; i < 5; ++i)
+    {
+        EXPECT_TRUE(sdk_->queue_data(cardano_iot::test::create_test_iot_data(device_id)));
+    }
+    const uint64_t balance = sdk_->get_device_balance(device_id);
+    EXPECT_TRUE(sdk_->queue_ada_transfer(device_id, 1000000));
+    EXPECT_EQ(sdk_->get_outbox_pending_count(), 6u);
+    EXPECT_TRUE(sdk_->query_data(device_id).empty());
+
+    EXPECT_EQ(sdk_->flush_outbox(), 6u);
+    EXPECT_EQ(batches, 1u);
+    EXPECT_EQ(sdk_->query_data(device_id).size(), 5u);
+    EXPECT_EQ(sdk_->get_device_balance(device_id), balance + 1000000u);
+}
+
+TEST_F(IntegrationTest, StartupTimingsAndLazySubsystems)
+{
+    auto status = sdk_->get_network_status();
+    for (const char *key : {"startup_executor_us", "startup_config_us", "startup_device_manager_us",
+                            "startup_power_manager_us", "startup_total_us"})
+    {
+        EXPECT_EQ(status.count(key), 1u) << key;
+    }
+    EXPECT_EQ(status.count("startup_ingestion_us"), 0u);
+    EXPECT_EQ(status.count("startup_outbox_us"), 0u);
+    EXPECT_NE(utils::metrics::Registry::instance().to_prometheus().find(
+                  "cardano_iot_sdk_startup_microseconds{subsystem=\"device_manager\"}"),
+              std::string::npos);
+
+    // Optional pieces start on first use
+    std::string device_id = "lazy_device";
+    ASSERT_TRUE(sdk_->register_device(cardano_iot::test::create_test_device_info(device_id)));
+    EXPECT_EQ(sdk_->get_outbox_pending_count(), 0u);
+    EXPECT_TRUE(sdk_->enqueue_data(cardano_iot::test::create_test_iot_data(device_id)));
+    EXPECT_TRUE(sdk_->queue_data(cardano_iot::test::create_test_iot_data(device_id)));
+    status = sdk_->get_network_status();
+    EXPECT_EQ(status.count("startup_ingestion_us"), 1u);
+    EXPECT_EQ(status.count("startup_outbox_us"), 1u);
+    ASSERT_TRUE(sdk_->flush_data_queue());
+    EXPECT_EQ(sdk_->flush_outbox(), 1u);
+    EXPECT_EQ(sdk_->query_data(device_id).size(), 2u);
+
+    // A restarted SDK starts its lazy pieces again
+    sdk_->shutdown();
+    ASSERT_TRUE(sdk_->initialize());
+    ASSERT_TRUE(sdk_->register_device(cardano_iot::test::create_test_device_info(device_id)));
+    EXPECT_TRUE(sdk_->enqueue_data(cardano_iot::test::create_test_iot_data(device_id)));
+    ASSERT_TRUE(sdk_->flush_data_queue());
+}
@@ -0,0 +1,119 @@
+/**
+ * @file logger_tests.cpp
+ * @brief Unit tests for the synchronous and asynchronous logging paths
+ *
+ * @author Cardano IoT SDK Team
+ * @version 1.0.0
+ */
+
+#include <gtest/gtest.h>
+#include "cardano_iot/utils/logger.h"
+
+#include <cstdio>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+using namespace cardano_iot::utils;
+
+namespace
+{
+    size_t count_lines(const std::string &path)
+    {
+        std::ifstream in(path);
+        size_t lines = 0;
+        std::string line;
+        while (std::getline(in, line))
+        {
+            ++lines;
+        }
+        return lines;
+    }
+} // namespace
+
+class LoggerTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        path_ = "logger_tests_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) + ".log";
+        std::remove(path_.c_str());
+        auto &logger = Logger::instance();
+        logger.enable_console(false);
+        logger.set_level(LogLevel::INFO);
+        logger.set_file_path(path_);
+    }
+
+    void TearDown() override
+    {
+        auto &logger = Logger::instance();
+        logger.enable_async(false);
+        logger.set_file_path("");
+        logger.enable_console(true);
+        std::remove(path_.c_str());
+    }
+
+    std::string path_;
+};
+
+TEST_F(LoggerTest, AsyncWritesEveryRecordFromManyThreads)
+{
+    auto &logger = Logger::instance();
+    logger.enable_async(true, 1 << 16, LogOverflowPolicy::BLOCK);
+
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 2000;
+    std::vector<std::thread> producers;
+    for (int t = 0; t < kThreads; ++t)
+    {
+        producers.emplace_back([&logger, t]()
+                               {
+            for (int i = 0; i < kPerThread; ++i)
+            {
+                logger.log(LogLevel::INFO, "Test", "thread " + std::to_string(t) + " record " + std::to_string(i));
+            } });
+    }
+    for (auto &p : producers)
+    {
+        p.join();
+    }
+    logger.flush();
+
+    EXPECT_EQ(count_lines(path_), static_cast<size_t>(kThreads * kPerThread));
+    EXPECT_EQ(logger.dropped_count(), 0u);
+}
+
+TEST_F(LoggerTest, DropPolicyAccountsForEveryRecord)
+{
+    auto &logger = Logger::instance();
+    const uint64_t dropped_before = logger.dropped_count();
+    logger.enable_async(true, 4, LogOverflowPolicy::DROP, 1000);
+
+    constexpr size_t kRecords = 5000;
+    for (size_t i = 0; i < kRecords; ++i)
+    {
+        logger.log(LogLevel::INFO, "Test", "record");
+    }
+    logger.enable_async(false);
+
+    const uint64_t dropped = logger.dropped_count() - dropped_before;
+    EXPECT_GT(dropped, 0u);
+    EXPECT_EQ(count_lines(path_) + dropped, kRecords);
+}
+
+TEST_F(LoggerTest, DisabledLevelSkipsMessageConstruction)
+{
+    int evaluations = 0;
+    auto expensive = [&evaluations]()
+    {
+        ++evaluations;
+        return std::string("value");
+    };
+
+    CARDANO_IOT_LOG(LogLevel::DEBUG, "Test", "debug " << expensive());
+    EXPECT_EQ(evaluations, 0);
+
+    CARDANO_IOT_LOG(LogLevel::WARNING, "Test", "warning " << expensive());
+    EXPECT_EQ(evaluations, 1);
+    EXPECT_EQ(count_lines(path_), 1u);
+}
@@ -0,0 +1,156 @@
+/**
+ * @file metrics_tests.cpp
+ * @brief Unit tests for the metrics registry and Prometheus exposition
+ *
+ * @author Cardano IoT SDK Team
+ * @version 1.0.0
+ */
+
+#include <gtest/gtest.h>
+#include "cardano_iot/utils/metrics.h"
+#include "cardano_iot/monitoring/realtime_dashboard.h"
+#include "cardano_iot/security/encryption.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace cardano_iot::utils::metrics;
+
+namespace
+{
+    // One GET over a fresh connection; returns the whole response
+    std::string http_get(uint16_t port, const std::string &path)
+    {
+        const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(port);
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        timeval timeout{5, 0};
+        ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        std::string response;
+        if (::connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) == 0)
+        {
+            const std::string request = "GET " + path + " HTTP/1.1\r\nHost: localhost\r\n\r\n";
+            if (::send(fd, request.data(), request.size(), 0) == static_cast<ssize_t>(request.size()))
+            {
+                char buffer[4096];
+                ssize_t received;
+                while ((received = ::recv(fd, buffer, sizeof(buffer), 0)) > 0)
+                {
+                    response.append(buffer, static_cast<size_t>(received));
+                }
+            }
+        }
+        ::close(fd);
+        return response;
+    }
+} // namespace
+
+TEST(MetricsTest, CountersAndGaugesAggregateAcrossThreadsAndInstances)
+{
+    Counter first("test_requests_total", "Requests", {{"route", "a"}});
+    auto second = std::make_unique<Counter>("test_requests_total", "Requests", Labels{{"route", "a"}});
+    Gauge depth("test_queue_depth", "Queue depth");
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 8; ++t)
+    {
+        workers.emplace_back([&]
+                             {
+                                 for (int i = 0; i < 10000; ++i)
+                                 {
+                                     first.inc();
+                                     second->inc(2);
+                                     depth.add(1);
+                                 } });
+    }
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+
+    EXPECT_EQ(first.value(), 80000u);
+    EXPECT_EQ(second->value(), 160000u);
+    EXPECT_EQ(depth.value(), 80000);
+    EXPECT_EQ(Registry::instance().value("test_requests_total", {{"route", "a"}}), 240000.0);
+
+    second.reset();
+    EXPECT_EQ(Registry::instance().value("test_requests_total", {{"route", "a"}}), 80000.0);
+
+    depth.decrement_to_zero(100000);
+    EXPECT_EQ(depth.value(), 0);
+    first.reset();
+    EXPECT_EQ(first.value(), 0u);
+}
+
+TEST(MetricsTest, HistogramQuantilesAndPrometheusFormat)
+{
+    std::vector<double> bounds;
+    for (int b = 10; b <= 1000; b += 10)
+    {
+        bounds.push_back(b);
+    }
+    Histogram latency("test_latency_ms", "Latency", bounds, {{"path", "say \"hi\""}});
+    for (int v = 1; v <= 1000; ++v)
+    {
+        latency.observe(v);
+    }
+    latency.observe(5000); // Overflow bucket
+
+    auto snapshot = latency.snapshot();
+    EXPECT_EQ(snapshot.count, 1001u);
+    EXPECT_DOUBLE_EQ(snapshot.sum, 500500.0 + 5000.0);
+    EXPECT_NEAR(snapshot.quantile(0.5), 500.0, 10.0);
+    EXPECT_NEAR(snapshot.quantile(0.95), 950.0, 10.0);
+    EXPECT_EQ(snapshot.quantile(1.0), 1000.0);
+
+    const std::string text = Registry::instance().to_prometheus();
+    EXPECT_NE(text.find("# TYPE test_latency_ms histogram\n"), std::string::npos);
+    EXPECT_NE(text.find("test_latency_ms_bucket{path=\"say \\\"hi\\\"\",le=\"10\"} 10\n"), std::string::npos);
+    EXPECT_NE(text.find("test_latency_ms_bucket{path=\"say \\\"hi\\\"\",le=\"1000\"} 1000\n"), std::string::npos);
+    EXPECT_NE(text.find("test_latency_ms_bucket{path=\"say \\\"hi\\\"\",le=\"+Inf\"} 1001\n"), std::string::npos);
+    EXPECT_NE(text.find("test_latency_ms_sum{path=\"say \\\"hi\\\"\"} 505500\n"), std::string::npos);
+    EXPECT_NE(text.find("test_latency_ms_count{path=\"say \\\"hi\\\"\"} 1001\n"), std::string::npos);
+
+    latency.reset();
+    EXPECT_EQ(latency.count(), 0u);
+}
+
+TEST(MetricsTest, SubsystemsFeedTheMetricsEndpoint)
+{
+    cardano_iot::security::Encryption encryption;
+    ASSERT_TRUE(encryption.initialize());
+    const std::string key_id = encryption.generate_key(cardano_iot::security::EncryptionAlgorithm::AES_256_GCM);
+    for (int i = 0; i < 20; ++i)
+    {
+        ASSERT_FALSE(encryption.encrypt({'i', 'o', 't'}, key_id).ciphertext.empty());
+    }
+    auto stats = encryption.get_statistics();
+    EXPECT_EQ(stats.encryptions_performed, 20u);
+    EXPECT_EQ(stats.bytes_encrypted, 60u);
+    EXPECT_GT(stats.avg_encryption_time_ms, 0.0);
+    EXPECT_GT(stats.p95_encryption_time_ms, 0.0); // One preempted call can lift the mean above the p95 of 20
+
+    cardano_iot::monitoring::RealtimeDashboard dashboard;
+    ASSERT_TRUE(dashboard.initialize());
+    ASSERT_TRUE(dashboard.start_server(0, "127.0.0.1"));
+    const uint16_t port = static_cast<uint16_t>(std::stoi(dashboard.get_server_status()["port"]));
+
+    const std::string response = http_get(port, "/metrics");
+    EXPECT_EQ(response.rfind("HTTP/1.1 200 OK\r\n", 0), 0u);
+    EXPECT_NE(response.find("Content-Type: text/plain; version=0.0.4"), std::string::npos);
+    EXPECT_NE(response.find("cardano_iot_encryption_operations_total{op=\"encrypt\"} 20\n"), std::string::npos);
+    EXPECT_NE(response.find("cardano_iot_encryption_duration_ms_count{op=\"encrypt\"} 20\n"), std::string::npos);
+    EXPECT_EQ(http_get(port, "/missing").rfind("HTTP/1.1 404", 0), 0u);
+
+    encryption.reset_statistics();
+    EXPECT_EQ(encryption.get_statistics().encryptions_performed, 0u);
+    dashboard.stop_server();
+}
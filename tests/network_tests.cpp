@@ -8,6 +8,14 @@
 
 #include <gtest/gtest.h>
 #include "cardano_iot/network/cardano_client.h"
+#include "utils/test_utils.h"
+
+#include <future>
+#include <atomic>
+#include <mutex>
+#include <cstdio>
+#include <cinttypes>
+#include <nlohmann/json.hpp>
 
 using namespace cardano_iot::network;
 
@@ -122,3 +130,290 @@ TEST_F(NetworkTest, ValidateAddress)
     // Wrong prefix but long
     EXPECT_FALSE(client_.validate_address("zzzz1thisislongenoughbutinvalidprefix"));
 }
+
+TEST_F(NetworkTest, BlockfrostBackendServesConcurrentQueriesOverPooledConnections)
+{
+    const std::string policy(56, 'a');
+    cardano_iot::test::LocalHttpServer server(
+        [&](const std::string &method, const std::string &path, const std::string &body)
+            -> cardano_iot::test::LocalHttpServer::Response
+        {
+            if (path == "/blocks/latest")
+            {
+                return {200, R"({"hash":"tip01","slot":1000,"height":50,"epoch":3})"};
+            }
+            if (path.rfind("/addresses/addr_test1empty", 0) == 0)
+            {
+                return {404, R"({"status_code":404,"message":"not found"})"};
+            }
+            if (path.rfind("/addresses/", 0) == 0)
+            {
+                const std::string address = path.substr(11, path.find('/', 11) - 11);
+                return {200, R"([{"tx_hash":"tx_)" + address + R"(","output_index":1,"amount":[)"
+                                 R"({"unit":"lovelace","quantity":"2500000"},{"unit":")" +
+                                 policy + R"(746f6b","quantity":"7"}],"data_hash":null}])"};
+            }
+            if (method == "POST" && path == "/tx/submit")
+            {
+                return body.empty() ? cardano_iot::test::LocalHttpServer::Response{400, R"({"message":"empty"})"}
+                                    : cardano_iot::test::LocalHttpServer::Response{200, R"("abc123")"};
+            }
+            if (path == "/txs/" + std::string(64, 'c'))
+            {
+                return {200, R"({"hash":"onchain"})"};
+            }
+            return {404, "{}"};
+        });
+    ASSERT_TRUE(server.start());
+
+    BackendConfig backend;
+    backend.type = BackendType::BLOCKFROST;
+    backend.base_url = server.base_url();
+    backend.api_key = "preprodTestKey";
+    backend.max_connections = 4;
+    ASSERT_TRUE(client_.configure_backend(backend));
+    ASSERT_TRUE(client_.connect());
+    EXPECT_EQ(client_.get_chain_tip().height, 50u);
+
+    std::vector<std::future<std::vector<UTXOInfo>>> queries;
+    for (int i = 0; i < 40; ++i)
+    {
+        queries.push_back(client_.query_utxos_async("addr_test1gateway" + std::to_string(i)));
+    }
+    for (int i = 0; i < 40; ++i)
+    {
+        ASSERT_EQ(queries[i].wait_for(std::chrono::seconds(5)), std::future_status::ready);
+        auto utxos = queries[i].get();
+        ASSERT_EQ(utxos.size(), 1u);
+        EXPECT_EQ(utxos[0].tx_hash, "tx_addr_test1gateway" + std::to_string(i));
+        EXPECT_EQ(utxos[0].amount, 2'500'000u);
+        EXPECT_EQ(utxos[0].assets.at(policy + ".746f6b"), 7u);
+    }
+    EXPECT_TRUE(client_.query_utxos("addr_test1empty").empty());
+
+    // Keep-alive pool: far fewer connections than requests
+    EXPECT_LE(server.connections_accepted(), 4u);
+
+    auto submitted = client_.submit_transaction_async("84a0a0f5f6").get();
+    EXPECT_TRUE(submitted.success);
+    EXPECT_EQ(submitted.tx_hash, "abc123");
+    EXPECT_FALSE(client_.submit_transaction("not-hex").success);
+
+    auto confirmed = client_.are_transactions_confirmed({std::string(64, 'c'), std::string(64, 'd')});
+    ASSERT_EQ(confirmed.size(), 2u);
+    EXPECT_TRUE(confirmed[0]);
+    EXPECT_FALSE(confirmed[1]);
+
+    // Values that would rewrite the URL path never reach the server
+    const size_t served = server.requests_served();
+    EXPECT_TRUE(client_.query_utxos("addr_test1x/../../blocks/latest").empty());
+    EXPECT_TRUE(client_.query_utxos("addr_test1x?page=9#").empty());
+    EXPECT_EQ(client_.are_transactions_confirmed({"../blocks/latest", std::string(63, 'c') + "?"}),
+              (std::vector<bool>{false, false}));
+    EXPECT_EQ(server.requests_served(), served);
+
+    client_.shutdown();
+    server.stop();
+}
+
+TEST_F(NetworkTest, KoiosBatchQueriesUseFewRoundTripsAndCache)
+{
+    std::atomic<uint64_t> tip_height{100};
+    cardano_iot::test::LocalHttpServer server(
+        [&](const std::string &method, const std::string &path, const std::string &body)
+            -> cardano_iot::test::LocalHttpServer::Response
+        {
+            if (path == "/tip")
+            {
+                const auto height = std::to_string(tip_height.load());
+                return {200, R"([{"hash":"tip)" + height + R"(","abs_slot":2000,"block_no":)" + height + R"(,"epoch_no":4}])"};
+            }
+            if (method == "POST" && path == "/address_utxos")
+            {
+                auto request = nlohmann::json::parse(body);
+                nlohmann::json utxos = nlohmann::json::array();
+                for (const auto &address : request["_addresses"])
+                {
+                    utxos.push_back({{"tx_hash", "tx_" + address.get<std::string>()},
+                                     {"tx_index", 0},
+                                     {"address", address},
+                                     {"value", "1000000"},
+                                     {"asset_list", nlohmann::json::array()}});
+                }
+                return {200, utxos.dump()};
+            }
+            return {404, "{}"};
+        });
+    ASSERT_TRUE(server.start());
+
+    BackendConfig backend;
+    backend.type = BackendType::KOIOS;
+    backend.base_url = server.base_url();
+    backend.max_batch_addresses = 100;
+    ASSERT_TRUE(client_.configure_backend(backend));
+    ASSERT_TRUE(client_.connect());
+    client_.reset_statistics();
+
+    std::vector<std::string> fleet;
+    for (int i = 0; i < 250; ++i)
+    {
+        fleet.push_back("addr_test1device" + std::to_string(i));
+    }
+
+    auto first = client_.query_utxos_batch(fleet);
+    ASSERT_EQ(first.size(), fleet.size());
+    EXPECT_EQ(first.at("addr_test1device42").front().tx_hash, "tx_addr_test1device42");
+    EXPECT_EQ(client_.get_statistics().utxo_round_trips, 3u);
+
+    // Second sweep is served from the cache
+    auto second = client_.query_utxos_batch(fleet);
+    EXPECT_EQ(second.size(), fleet.size());
+    auto stats = client_.get_statistics();
+    EXPECT_EQ(stats.utxo_round_trips, 3u);
+    EXPECT_EQ(stats.cache_hits, 250u);
+    EXPECT_DOUBLE_EQ(stats.cache_hit_rate, 0.5);
+
+    // Explicit invalidation refetches only that address
+    client_.invalidate_utxo_cache("addr_test1device7");
+    EXPECT_EQ(client_.query_utxos_batch(fleet).size(), fleet.size());
+    EXPECT_EQ(client_.get_statistics().utxo_round_trips, 4u);
+
+    // A new block retires every entry
+    ++tip_height;
+    EXPECT_EQ(client_.get_chain_tip().height, 101u);
+    EXPECT_EQ(client_.query_utxos_batch(fleet).size(), fleet.size());
+    EXPECT_EQ(client_.get_statistics().utxo_round_trips, 7u);
+
+    client_.shutdown();
+    server.stop();
+}
+
+TEST(ChainSubscriptionTest, StreamsBlocksAndAddressTransactionsAndResumesAfterOutage)
+{
+    std::atomic<uint64_t> tip_height{15};
+    std::atomic<uint64_t> fork_height{1000};
+    std::atomic<bool> outage{false};
+    const std::string contract = "addr_test1contract";
+
+    auto block_hash = [&](uint64_t height)
+    { return (height >= fork_height.load() ? "f" : "b") + std::to_string(height); };
+    auto block_json = [&](uint64_t height)
+    {
+        return nlohmann::json{{"hash", block_hash(height)}, {"previous_block", block_hash(height - 1)},
+                              {"slot", height * 20}, {"height", height}, {"epoch", 4}};
+    };
+
+    cardano_iot::test::LocalHttpServer server(
+        [&](const std::string &method, const std::string &path, const std::string &)
+            -> cardano_iot::test::LocalHttpServer::Response
+        {
+            if (outage.load())
+            {
+                return {503, "{}"};
+            }
+            if (path == "/blocks/latest")
+            {
+                return {200, block_json(tip_height.load()).dump()};
+            }
+            uint64_t after = 0;
+            unsigned count = 0;
+            if (method == "GET" && std::sscanf(path.c_str(), "/blocks/%" SCNu64 "/next?count=%u", &after, &count) == 2)
+            {
+                nlohmann::json blocks = nlohmann::json::array();
+                for (uint64_t height = after + 1; height <= tip_height.load() && blocks.size() < count; ++height)
+                {
+                    blocks.push_back(block_json(height));
+                }
+                return {200, blocks.dump()};
+            }
+            if (path.rfind("/addresses/" + contract + "/transactions", 0) == 0)
+            {
+                return {200, R"([{"tx_hash":"tx_contract_13","tx_index":0,"block_height":13,"block_time":0}])"};
+            }
+            if (path.rfind("/addresses/", 0) == 0)
+            {
+                return {404, R"({"status_code":404})"};
+            }
+            return {404, "{}"};
+        });
+    ASSERT_TRUE(server.start());
+
+    auto client = std::make_shared<CardanoClient>();
+    ASSERT_TRUE(client->initialize("", Network::PREPROD));
+    BackendConfig backend;
+    backend.type = BackendType::BLOCKFROST;
+    backend.base_url = server.base_url();
+    backend.timeout_ms = 1000;
+    backend.chain_poll_interval_ms = 20;
+    ASSERT_TRUE(client->configure_backend(backend));
+    ASSERT_TRUE(client->connect());
+
+    std::mutex mutex;
+    std::vector<uint64_t> blocks;
+    std::vector<std::string> order; // blocks and transactions as delivered
+    std::vector<uint64_t> rollbacks;
+
+    ChainSubscription subscription;
+    subscription.resume_from = ChainPoint{200, 10, "b10"};
+    subscription.watched_addresses = {contract, "addr_test1quiet"};
+    subscription.on_block = [&](const BlockHeader &header)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        blocks.push_back(header.height);
+        order.push_back("block" + std::to_string(header.height));
+    };
+    subscription.on_transaction = [&](const AddressTransaction &tx)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        order.push_back(tx.tx_hash + "@" + tx.block_hash);
+    };
+    subscription.on_rollback = [&](const ChainPoint &point)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        rollbacks.push_back(point.height);
+    };
+    const uint64_t id = client->subscribe_chain(subscription);
+    ASSERT_NE(id, 0u);
+
+    auto delivered_up_to = [&](uint64_t height)
+    {
+        return cardano_iot::test::wait_for_condition([&]()
+                                                     { return client->get_subscription_point(id).height == height; },
+                                                     5000, 10);
+    };
+
+    // Replay from the resume point, with the watched transaction right after its block
+    ASSERT_TRUE(delivered_up_to(15));
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        EXPECT_EQ(blocks, (std::vector<uint64_t>{11, 12, 13, 14, 15}));
+        const std::vector<std::string> expected{"block11", "block12", "block13", "tx_contract_13@b13", "block14", "block15"};
+        EXPECT_EQ(order, expected);
+    }
+
+    // Outage: the client drops to ERROR, then reconnects and resumes without gaps
+    outage = true;
+    ASSERT_TRUE(cardano_iot::test::wait_for_condition([&]()
+                                                      { return client->get_connection_status() == ConnectionStatus::ERROR; },
+                                                      5000, 10));
+    tip_height = 18;
+    outage = false;
+    ASSERT_TRUE(delivered_up_to(18));
+    EXPECT_TRUE(client->is_connected());
+
+    // A fork replacing block 18 is reported, then the new branch is delivered
+    fork_height = 18;
+    tip_height = 19;
+    ASSERT_TRUE(delivered_up_to(19));
+    EXPECT_EQ(client->get_subscription_point(id).hash, "f19");
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        EXPECT_EQ(rollbacks, (std::vector<uint64_t>{18}));
+        EXPECT_EQ(blocks, (std::vector<uint64_t>{11, 12, 13, 14, 15, 16, 17, 18, 18, 19}));
+    }
+
+    EXPECT_TRUE(client->unsubscribe_chain(id));
+    EXPECT_FALSE(client->unsubscribe_chain(id));
+    client->shutdown();
+    server.stop();
+}
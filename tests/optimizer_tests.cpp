@@ -0,0 +1,192 @@
+/**
+ * @file optimizer_tests.cpp
+ * @brief Unit tests for the PerformanceOptimizer tuning loop
+ *
+ * @author Cardano IoT SDK Team
+ * @version 1.0.0
+ */
+
+#include <gtest/gtest.h>
+#include "cardano_iot/performance/performance_optimizer.h"
+#include "cardano_iot/performance/tuning_knobs.h"
+#include "cardano_iot/core/transaction_builder_pool.h"
+#include "cardano_iot/core/transaction_manager.h"
+#include "cardano_iot/data/data_provenance.h"
+#include "cardano_iot/utils/metrics.h"
+
+#include <cmath>
+#include <map>
+
+using namespace cardano_iot;
+using namespace cardano_iot::performance;
+
+namespace
+{
+    TuningKnob fake_knob(const std::string &name, double &value, int latency_direction, int energy_direction)
+    {
+        TuningKnob knob;
+        knob.name = name;
+        knob.category = "batching";
+        knob.min_value = 1;
+        knob.max_value = 1024;
+        knob.latency_direction = latency_direction;
+        knob.energy_direction = energy_direction;
+        knob.step_factor = 2.0;
+        knob.get = [&value]
+        { return value; };
+        knob.set = [&value](double next)
+        {
+            value = next;
+            return true;
+        };
+        return knob;
+    }
+} // namespace
+
+TEST(OptimizerTest, ControllerStepsKnobTowardsLatencyTarget)
+{
+    utils::metrics::Histogram latency("test_optimizer_latency_ms", "Latency under test",
+                                      utils::metrics::Histogram::latency_ms_bounds());
+    PerformanceOptimizer optimizer;
+    ASSERT_TRUE(optimizer.initialize({{"latency_metric", "test_optimizer_latency_ms"},
+                                      {"target_latency_ms", "50"},
+                                      {"min_samples", "10"},
+                                      {"hysteresis", "0.5"}})); // Buckets double, so the band must span one
+    ASSERT_FALSE(optimizer.initialize({{"target_latency_ms", "fast"}}));
+    optimizer.set_optimization_strategy(OptimizationStrategy::LATENCY_FOCUSED);
+
+    double batch = 256;
+    ASSERT_TRUE(optimizer.register_knob(fake_knob("test.batch", batch, -1, +1)));
+    EXPECT_EQ(optimizer.get_knob_names(), std::vector<std::string>{"test.batch"});
+
+    // Too few samples: no decision
+    for (int i = 0; i < 5; ++i)
+    {
+        latency.observe(400);
+    }
+    EXPECT_EQ(optimizer.apply_all_optimizations(), 0u);
+    EXPECT_EQ(batch, 256);
+
+    // Slow window: the batch shrinks
+    for (int i = 0; i < 50; ++i)
+    {
+        latency.observe(400);
+    }
+    EXPECT_EQ(optimizer.apply_all_optimizations(), 1u);
+    EXPECT_EQ(batch, 128);
+
+    // Inside the hysteresis band: hold
+    for (int i = 0; i < 50; ++i)
+    {
+        latency.observe(48);
+    }
+    EXPECT_EQ(optimizer.apply_all_optimizations(), 0u);
+    EXPECT_EQ(batch, 128);
+
+    // Fast window: give the headroom back
+    for (int i = 0; i < 50; ++i)
+    {
+        latency.observe(2);
+    }
+    EXPECT_EQ(optimizer.apply_all_optimizations(), 1u);
+    EXPECT_EQ(batch, 256);
+
+    const auto history = optimizer.get_tuning_history();
+    ASSERT_EQ(history.size(), 2u);
+    EXPECT_EQ(history[0].knob, "test.batch");
+    EXPECT_EQ(history[0].old_value, 256);
+    EXPECT_EQ(history[0].new_value, 128);
+    EXPECT_NE(history[0].reason.find("above target"), std::string::npos);
+    EXPECT_NE(history[1].reason.find("below target"), std::string::npos);
+
+    EXPECT_TRUE(optimizer.unregister_knob("test.batch"));
+    EXPECT_TRUE(std::isnan(optimizer.get_knob_value("test.batch")));
+}
+
+TEST(OptimizerTest, EnergyStrategyRelaxesLiveKnobsOverBudget)
+{
+    core::TransactionManager tm;
+    ASSERT_TRUE(tm.initialize("testnet"));
+    core::TransactionBuilderPool pool(tm, 4);
+    data::DataProvenance provenance;
+    ASSERT_TRUE(provenance.initialize());
+
+    PerformanceOptimizer optimizer;
+    ASSERT_TRUE(optimizer.initialize({{"power_budget_mw", "500"}}));
+    optimizer.set_optimization_strategy(OptimizationStrategy::ENERGY_FOCUSED);
+    double power = 900;
+    optimizer.set_power_source([&power]
+                               { return power; });
+    ASSERT_TRUE(optimizer.register_knob(builder_workers_knob(pool, 1, 8)));
+    ASSERT_TRUE(optimizer.register_knob(anchor_batch_knob(provenance, 16, 4096)));
+    EXPECT_LT(optimizer.get_energy_efficiency_score(), 0.6);
+
+    const double anchor_batch = optimizer.get_knob_value("provenance.anchor_batch_size");
+    // One knob per period, round robin by name
+    EXPECT_EQ(optimizer.apply_all_optimizations(), 1u);
+    EXPECT_EQ(optimizer.apply_all_optimizations(), 1u);
+    EXPECT_EQ(pool.worker_count(), 3u);
+    EXPECT_GT(provenance.get_anchor_options().max_batch_events, static_cast<size_t>(anchor_batch));
+
+    // Within budget and no latency signal: hold
+    power = 450;
+    EXPECT_EQ(optimizer.apply_all_optimizations(), 0u);
+    EXPECT_EQ(optimizer.get_tuning_history().size(), 2u);
+
+    EXPECT_TRUE(optimizer.scale_resources(2.0));
+    EXPECT_EQ(pool.worker_count(), 6u);
+    EXPECT_FALSE(optimizer.scale_resources(0.0));
+    EXPECT_EQ(optimizer.get_current_resource_allocation().worker_threads, 6u);
+
+    optimizer.unregister_knob("builder_pool.workers");
+    optimizer.unregister_knob("provenance.anchor_batch_size");
+    tm.shutdown();
+}
+
+TEST(OptimizerTest, LoadBalancerAndEstimates)
+{
+    PerformanceOptimizer optimizer;
+    LoadBalancingConfig config{};
+    config.strategy = "weighted";
+    config.endpoints = {"a", "b"};
+    config.weights = {{"a", 3.0}, {"b", 1.0}};
+    config.failure_threshold = 2;
+    config.recovery_threshold = 1;
+    ASSERT_TRUE(optimizer.configure_load_balancing(config));
+
+    std::map<std::string, int> picks;
+    for (int i = 0; i < 8; ++i)
+    {
+        ++picks[optimizer.get_next_endpoint()];
+    }
+    EXPECT_EQ(picks["a"], 6);
+    EXPECT_EQ(picks["b"], 2);
+
+    optimizer.report_endpoint_health("a", false);
+    optimizer.report_endpoint_health("a", false);
+    EXPECT_EQ(optimizer.get_next_endpoint(), "b");
+    optimizer.report_endpoint_health("a", true);
+    picks.clear();
+    for (int i = 0; i < 4; ++i)
+    {
+        ++picks[optimizer.get_next_endpoint()];
+    }
+    EXPECT_GT(picks["a"], 0);
+
+    config.strategy = "sticky";
+    EXPECT_FALSE(optimizer.configure_load_balancing(config));
+    EXPECT_FALSE(optimizer.configure_compression("brotli", 3));
+    EXPECT_TRUE(optimizer.configure_compression("zstd", 3));
+
+    EXPECT_EQ(estimate_optimal_buffer_size(0.0, 100), 4096u);
+    EXPECT_EQ(estimate_optimal_buffer_size(100.0, 100), 2u << 20); // 1.25 MB rounds up to 2 MiB
+    EXPECT_GE(estimate_optimal_thread_count("io_bound"), estimate_optimal_thread_count("cpu_bound"));
+
+    PerformanceMetrics good{};
+    good.transactions_per_second = 1000;
+    good.energy_efficiency_score = 1.0;
+    PerformanceMetrics bad = good;
+    bad.p95_response_time_ms = 2000;
+    bad.error_rate_percent = 50;
+    EXPECT_GT(calculate_performance_score(good), calculate_performance_score(bad));
+}
@@ -0,0 +1,767 @@
+/**
+ * @file p2p_network_tests.cpp
+ * @brief Tests for the socket transport and P2P networking over loopback
+ */
+
+#include <gtest/gtest.h>
+#include "cardano_iot/network/p2p_network.h"
+#include "cardano_iot/network/socket_transport.h"
+#include "cardano_iot/network/wire_format.h"
+#include "cardano_iot/network/send_scheduler.h"
+#include "cardano_iot/network/gossip.h"
+#include "cardano_iot/network/routing_table.h"
+#include "cardano_iot/network/peer_table.h"
+#include "utils/test_utils.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <dirent.h>
+#include <map>
+#include <mutex>
+#include <random>
+#include <thread>
+
+using namespace cardano_iot::network;
+using namespace std::chrono_literals;
+using cardano_iot::test::eventually;
+
+namespace
+{
+    size_t thread_count()
+    {
+        size_t count = 0;
+        if (DIR *dir = opendir("/proc/self/task"))
+        {
+            while (dirent *entry = readdir(dir))
+            {
+                count += entry->d_name[0] != '.';
+            }
+            closedir(dir);
+        }
+        return count;
+    }
+
+    P2PNetwork::P2PConfig loopback_config()
+    {
+        P2PNetwork::P2PConfig config;
+        config.listen_address = "127.0.0.1";
+        config.listen_port = 0;
+        config.connection_timeout_ms = 3000;
+        config.io_threads = 1;
+        return config;
+    }
+} // namespace
+
+TEST(WireFormatTest, RoundTripsCompactlyAndDecodesWithoutCopying)
+{
+    NetworkMessage message;
+    message.message_id = "m42";
+    message.type = MessageType::DATA_SYNC;
+    message.sender_id = "s1";
+    message.recipient_id = "";
+    message.payload = {1, 2, 3, 4};
+    message.timestamp = 1700000000;
+    message.encrypted = true;
+    message.compressed = true;
+
+    const auto bytes = wire::encode(message);
+    ASSERT_EQ(bytes.size(), wire::encoded_size(message));
+    EXPECT_EQ(bytes.size(), 2u + 5u + 4u + 3u + 4u); // header, timestamp, two ids, payload
+
+    wire::MessageView view;
+    ASSERT_TRUE(wire::decode(bytes.data(), bytes.size(), view));
+    EXPECT_EQ(view.version, wire::VERSION);
+    EXPECT_EQ(view.type, MessageType::DATA_SYNC);
+    EXPECT_EQ(view.message_id, "m42");
+    EXPECT_EQ(view.sender_id, "s1");
+    EXPECT_TRUE(view.recipient_id.empty());
+    EXPECT_TRUE(view.encrypted());
+    EXPECT_TRUE(view.compressed());
+    EXPECT_EQ(view.payload, bytes.data() + bytes.size() - 4);
+    EXPECT_EQ(view.sender_id.data(), reinterpret_cast<const char *>(bytes.data()) + 12);
+
+    message.recipient_id = "r7";
+    message.signature = std::string(300, 'x');
+    NetworkMessage decoded;
+    const auto signed_bytes = wire::encode(message);
+    ASSERT_TRUE(wire::decode(signed_bytes.data(), signed_bytes.size(), decoded));
+    EXPECT_EQ(decoded.recipient_id, "r7");
+    EXPECT_EQ(decoded.signature, message.signature);
+    EXPECT_EQ(decoded.payload, message.payload);
+    EXPECT_EQ(decoded.timestamp, message.timestamp);
+
+    // Truncated ids and foreign versions are refused
+    EXPECT_FALSE(wire::decode(signed_bytes.data(), 12, view));
+    auto future_version = bytes;
+    future_version[0] = static_cast<uint8_t>((wire::VERSION + 1) << 4);
+    EXPECT_FALSE(wire::decode(future_version.data(), future_version.size(), view));
+
+    wire::BufferPool pool(2);
+    auto buffer = pool.acquire();
+    wire::encode(message, buffer);
+    const auto *storage = buffer.data();
+    pool.release(std::move(buffer));
+    auto reused = pool.acquire();
+    EXPECT_TRUE(reused.empty());
+    EXPECT_EQ(reused.data(), storage);
+    EXPECT_EQ(pool.get_statistics().reused, 1u);
+}
+
+TEST(SendSchedulerTest, CriticalFirstThenWeightedRoundRobin)
+{
+    SendScheduler::Config config;
+    config.quantum_bytes = 100;
+    config.max_queued_bytes_per_peer = 10000;
+    SendScheduler scheduler(config);
+
+    for (int i = 0; i < 40; ++i)
+    {
+        ASSERT_TRUE(scheduler.enqueue(1, 10, std::vector<uint8_t>(100, 'b')));  // bulk
+        ASSERT_TRUE(scheduler.enqueue(2, 150, std::vector<uint8_t>(100, 'h'))); // high
+    }
+    ASSERT_TRUE(scheduler.enqueue(3, 250, std::vector<uint8_t>(10, 'c')));
+    EXPECT_FALSE(scheduler.enqueue(1, 10, std::vector<uint8_t>(7000, 'x'))); // over the per-peer cap
+    EXPECT_EQ(scheduler.queued_frames(), 81u);
+
+    SendScheduler::PeerKey peer = 0;
+    std::vector<uint8_t> frame;
+    ASSERT_TRUE(scheduler.next(peer, frame));
+    EXPECT_EQ(peer, 3u);
+
+    // HIGH weighs 8 against BULK's 1
+    size_t high = 0;
+    size_t bulk = 0;
+    for (int i = 0; i < 45; ++i)
+    {
+        ASSERT_TRUE(scheduler.next(peer, frame));
+        (frame[0] == 'h' ? high : bulk)++;
+    }
+    EXPECT_EQ(high, 40u);
+    EXPECT_EQ(bulk, 5u);
+
+    // Peers whose sockets are full are skipped, not waited on
+    EXPECT_FALSE(scheduler.next(peer, frame, [](SendScheduler::PeerKey key)
+                                { return key != 1; }));
+    EXPECT_EQ(scheduler.remove_peer(1), 35u);
+    EXPECT_TRUE(scheduler.empty());
+
+    TokenBucket bucket(1000, 100);
+    const auto start = TokenBucket::Clock::now();
+    EXPECT_TRUE(bucket.ready(start));
+    bucket.consume(600, start);
+    EXPECT_FALSE(bucket.ready(start));
+    const auto ready_at = bucket.ready_at(start);
+    EXPECT_NEAR(std::chrono::duration<double>(ready_at - start).count(), 0.6, 0.01);
+    EXPECT_TRUE(bucket.ready(ready_at));
+}
+
+TEST(P2PNetworkTest, AlarmsOvertakeBulkTrafficUnderBandwidthLimit)
+{
+    P2PNetwork server;
+    P2PNetwork client;
+    server.update_config(loopback_config());
+    client.update_config(loopback_config());
+    ASSERT_TRUE(server.initialize("127.0.0.1", 0));
+    ASSERT_TRUE(client.initialize("127.0.0.1", 0));
+    ASSERT_TRUE(server.start_listening());
+
+    std::mutex mutex;
+    std::vector<std::string> arrivals;
+    const auto record = [&](const NetworkMessage &message)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        arrivals.push_back(message.message_id);
+    };
+    server.set_message_handler(MessageType::DATA_SYNC, record);
+    server.set_message_handler(MessageType::ENCRYPTED_DATA, record);
+
+    ASSERT_TRUE(client.connect_to_peer("127.0.0.1:" + std::to_string(server.get_listening_port())));
+    const std::string server_id = client.get_connected_peers().front().peer_id;
+    ASSERT_TRUE(eventually([&]()
+                           { return client.get_qos_metrics().average_latency_ms > 0.0; }));
+
+    ASSERT_TRUE(client.set_bandwidth_limit(160)); // 20 KB/s
+    NetworkMessage message;
+    message.type = MessageType::DATA_SYNC;
+    message.sender_id = "client";
+    message.recipient_id = server_id;
+    message.payload.assign(1000, 0x42);
+    message.timestamp = 1;
+    message.encrypted = false;
+    for (int i = 0; i < 20; ++i)
+    {
+        message.message_id = "bulk" + std::to_string(i);
+        ASSERT_TRUE(client.send_message(server_id, message));
+    }
+    EXPECT_GT(client.get_qos_metrics().message_queue_size, 10u);
+
+    message.message_id = "alarm";
+    message.type = MessageType::ENCRYPTED_DATA;
+    message.payload.assign(16, 0x01);
+    ASSERT_TRUE(client.set_message_priority("alarm", 250));
+    ASSERT_TRUE(client.send_message(server_id, message));
+
+    ASSERT_TRUE(eventually([&]()
+                           {
+        std::lock_guard<std::mutex> lock(mutex);
+        return arrivals.size() == 21; }));
+    const auto alarm_position = std::find(arrivals.begin(), arrivals.end(), "alarm") - arrivals.begin();
+    EXPECT_LT(alarm_position, 5);
+
+    const auto qos = client.get_qos_metrics();
+    EXPECT_EQ(qos.message_queue_size, 0u);
+    EXPECT_EQ(qos.active_connections, 1u);
+    EXPECT_DOUBLE_EQ(qos.packet_loss_rate, 0.0);
+    EXPECT_GT(qos.throughput_kbps, 20.0);
+    EXPECT_LT(qos.throughput_kbps, 250.0);
+}
+
+TEST(PeerTableTest, SnapshotsAreImmutableAndShareLiveCounters)
+{
+    PeerTable table;
+    PeerInfo info{};
+    info.peer_id = "peer_a";
+    info.endpoint = "127.0.0.1:1";
+    info.status = PeerStatus::CONNECTED;
+    info.capabilities = {"telemetry"};
+    table.insert(info, 7);
+
+    const auto before = table.snapshot();
+    info.peer_id = "peer_b";
+    table.insert(info, 8);
+    EXPECT_EQ(before->peers.size(), 1u);
+    EXPECT_EQ(table.snapshot()->peers.size(), 2u);
+    EXPECT_GT(table.snapshot()->version, before->version);
+
+    // Same entry object in both versions, so counters are shared rather than copied
+    EXPECT_EQ(before->peers.at("peer_a"), table.find("peer_a"));
+    table.find("peer_a")->record_traffic(100, true, 42);
+    EXPECT_EQ(before->peers.at("peer_a")->bytes_sent, 100u);
+    EXPECT_EQ(table.find("peer_a")->to_info().last_seen, 42u);
+
+    ASSERT_TRUE(table.set_public_key("peer_a", "key"));
+    EXPECT_EQ(table.find("peer_a")->public_key, "key");
+    EXPECT_EQ(table.find("peer_a")->bytes_sent, 100u);
+    EXPECT_EQ(table.find("peer_a")->connection_id, 7u);
+    EXPECT_TRUE(before->peers.at("peer_a")->public_key.empty());
+
+    // Readers race writers and always see a consistent version
+    std::atomic<bool> stop{false};
+    std::atomic<uint64_t> reads{0};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 4; ++r)
+    {
+        readers.emplace_back([&]()
+                             {
+            while (!stop)
+            {
+                const auto snapshot = table.snapshot();
+                for (const auto &entry : snapshot->peers)
+                {
+                    EXPECT_EQ(entry.first, entry.second->peer_id);
+                    entry.second->record_traffic(1, false, 1);
+                }
+                ++reads;
+            } });
+    }
+    for (int i = 0; i < 2000; ++i)
+    {
+        info.peer_id = "churn_" + std::to_string(i % 16);
+        table.insert(info, 100 + i);
+        if (i % 3 == 0)
+        {
+            table.erase("churn_" + std::to_string((i + 5) % 16));
+        }
+    }
+    stop = true;
+    for (auto &reader : readers)
+    {
+        reader.join();
+    }
+    EXPECT_GT(reads.load(), 0u);
+    EXPECT_NE(table.erase("peer_b"), nullptr);
+    EXPECT_EQ(table.erase("peer_b"), nullptr);
+    table.clear();
+    EXPECT_EQ(table.size(), 0u);
+}
+
+TEST(SeenFilterTest, RemembersRecentIdsInBoundedMemory)
+{
+    SeenFilter filter(1000, 0.001);
+    const size_t memory = filter.memory_bytes();
+    for (int i = 0; i < 1000; ++i)
+    {
+        ASSERT_TRUE(filter.insert("id" + std::to_string(i)));
+    }
+    for (int i = 0; i < 1000; ++i)
+    {
+        EXPECT_FALSE(filter.insert("id" + std::to_string(i)));
+    }
+
+    size_t false_positives = 0;
+    for (int i = 0; i < 10000; ++i)
+    {
+        false_positives += filter.contains("other" + std::to_string(i));
+    }
+    EXPECT_LT(false_positives, 50u);
+
+    // Two more generations push the first ids out; memory never grows
+    for (int i = 0; i < 2000; ++i)
+    {
+        filter.insert("later" + std::to_string(i));
+    }
+    EXPECT_FALSE(filter.contains("id0") && filter.contains("id1") && filter.contains("id2"));
+    EXPECT_EQ(filter.memory_bytes(), memory);
+}
+
+TEST(GossipEngineTest, BroadcastTrafficGrowsLinearlyOnLargeMesh)
+{
+    constexpr size_t kNodes = 500;
+    std::mt19937 rng(7);
+    std::vector<std::vector<size_t>> links(kNodes);
+    const auto connect = [&](size_t a, size_t b)
+    {
+        if (a != b && std::find(links[a].begin(), links[a].end(), b) == links[a].end())
+        {
+            links[a].push_back(b);
+            links[b].push_back(a);
+        }
+    };
+    for (size_t i = 0; i < kNodes; ++i)
+    {
+        connect(i, (i + 1) % kNodes);
+        for (int chord = 0; chord < 3; ++chord)
+        {
+            connect(i, rng() % kNodes);
+        }
+    }
+    size_t link_count = 0;
+    for (const auto &peers : links)
+    {
+        link_count += peers.size();
+    }
+
+    std::vector<std::unique_ptr<GossipEngine>> nodes;
+    for (size_t i = 0; i < kNodes; ++i)
+    {
+        GossipEngine::Config config;
+        config.local_id = std::to_string(i);
+        nodes.push_back(std::make_unique<GossipEngine>(config));
+        for (const size_t peer : links[i])
+        {
+            nodes[i]->add_peer(std::to_string(peer));
+        }
+    }
+
+    auto now = GossipEngine::Clock::now();
+    std::vector<size_t> deliveries(kNodes, 0);
+    const auto run = [&](std::vector<std::pair<size_t, GossipEngine::Outgoing>> pending)
+    {
+        for (int quiet_ticks = 0; quiet_ticks < 8;)
+        {
+            while (!pending.empty())
+            {
+                auto batch = std::move(pending);
+                pending.clear();
+                for (auto &[from, outgoing] : batch)
+                {
+                    const size_t to = std::stoul(outgoing.peer_id);
+                    std::vector<std::vector<uint8_t>> deliver;
+                    std::vector<GossipEngine::Outgoing> out;
+                    ASSERT_TRUE(nodes[to]->on_message(std::to_string(from), outgoing.message.type,
+                                                      outgoing.message.payload.data(), outgoing.message.payload.size(),
+                                                      now, deliver, out));
+                    deliveries[to] += deliver.size();
+                    for (auto &next : out)
+                    {
+                        pending.emplace_back(to, std::move(next));
+                    }
+                }
+            }
+            now += std::chrono::milliseconds(50);
+            for (size_t i = 0; i < kNodes; ++i)
+            {
+                std::vector<GossipEngine::Outgoing> out;
+                nodes[i]->tick(now, out);
+                for (auto &next : out)
+                {
+                    pending.emplace_back(i, std::move(next));
+                }
+            }
+            quiet_ticks = pending.empty() ? quiet_ticks + 1 : 0;
+        }
+    };
+    const auto payloads_sent = [&]()
+    {
+        uint64_t total = 0;
+        for (const auto &node : nodes)
+        {
+            total += node->get_statistics().payloads_sent;
+        }
+        return total;
+    };
+
+    uint64_t last_payloads = 0;
+    for (int round = 0; round < 12; ++round)
+    {
+        std::fill(deliveries.begin(), deliveries.end(), 0);
+        const size_t origin = rng() % kNodes;
+        NetworkMessage message;
+        message.message_id = "gossip-" + std::to_string(round);
+        message.type = MessageType::DATA_SYNC;
+        message.sender_id = std::to_string(origin);
+        message.payload = {1, 2, 3};
+        message.timestamp = 1;
+        message.encrypted = false;
+
+        const uint64_t before = payloads_sent();
+        std::vector<GossipEngine::Outgoing> out;
+        ASSERT_TRUE(nodes[origin]->broadcast(message, {}, now, out));
+        std::vector<std::pair<size_t, GossipEngine::Outgoing>> pending;
+        for (auto &next : out)
+        {
+            pending.emplace_back(origin, std::move(next));
+        }
+        run(std::move(pending));
+        last_payloads = payloads_sent() - before;
+
+        deliveries[origin] = 1;
+        ASSERT_EQ(std::count(deliveries.begin(), deliveries.end(), 1), static_cast<long>(kNodes)) << "round " << round;
+        EXPECT_FALSE(nodes[origin]->broadcast(message, {}, now, out));
+    }
+
+    // Once the tree has settled, a broadcast crosses about one link per node rather than every link
+    EXPECT_LT(last_payloads, kNodes * 3 / 2);
+    EXPECT_GT(link_count, kNodes * 6);
+}
+
+TEST(P2PNetworkTest, GossipRelaysBroadcastsOnceAcrossHops)
+{
+    P2PNetwork a;
+    P2PNetwork hub;
+    P2PNetwork c;
+    for (P2PNetwork *node : {&a, &hub, &c})
+    {
+        node->update_config(loopback_config());
+        ASSERT_TRUE(node->initialize("127.0.0.1", 0));
+    }
+    ASSERT_TRUE(hub.start_listening());
+    const std::string hub_endpoint = "127.0.0.1:" + std::to_string(hub.get_listening_port());
+    ASSERT_TRUE(a.connect_to_peer(hub_endpoint));
+    ASSERT_TRUE(c.connect_to_peer(hub_endpoint));
+    ASSERT_TRUE(eventually([&]()
+                           { return hub.get_connected_peers().size() == 2; }));
+
+    std::atomic<int> hub_received{0};
+    std::atomic<int> c_received{0};
+    hub.set_message_handler(MessageType::DEVICE_DISCOVERY, [&](const NetworkMessage &)
+                            { ++hub_received; });
+    c.set_message_handler(MessageType::DEVICE_DISCOVERY, [&](const NetworkMessage &message)
+                          {
+        EXPECT_EQ(std::string(message.payload.begin(), message.payload.end()), "hello mesh");
+        ++c_received; });
+
+    NetworkMessage message;
+    message.message_id = "announce-1";
+    message.type = MessageType::DEVICE_DISCOVERY;
+    message.sender_id = "a";
+    message.payload = {'h', 'e', 'l', 'l', 'o', ' ', 'm', 'e', 's', 'h'};
+    message.timestamp = 1;
+    message.encrypted = false;
+    ASSERT_TRUE(a.broadcast_message(message));
+    EXPECT_FALSE(a.broadcast_message(message));
+
+    ASSERT_TRUE(eventually([&]()
+                           { return c_received == 1; }));
+    std::this_thread::sleep_for(100ms);
+    EXPECT_EQ(hub_received, 1);
+    EXPECT_EQ(c_received, 1);
+    EXPECT_EQ(c.get_statistics().gossip_delivered, 1u);
+}
+
+TEST(RoutingTableTest, ConvergesIncrementallyAndWithdrawsLostRoutes)
+{
+    // Chain a - b - c - d, exchanging deltas until quiet
+    const std::vector<std::string> ids = {"a", "b", "c", "d"};
+    std::map<std::string, RoutingTable> tables;
+    for (const auto &id : ids)
+    {
+        tables.emplace(id, RoutingTable(id));
+    }
+    // A new link swaps full tables, as P2PNetwork does after the handshake
+    const auto link = [&](const std::string &x, const std::string &y)
+    {
+        tables.at(x).add_neighbor(y);
+        tables.at(y).add_neighbor(x);
+        tables.at(x).apply_update(y, tables.at(y).full_table_for(x), true);
+        tables.at(y).apply_update(x, tables.at(x).full_table_for(y), true);
+    };
+    const auto settle = [&]()
+    {
+        for (int round = 0; round < 16; ++round)
+        {
+            bool quiet = true;
+            for (const auto &id : ids)
+            {
+                RoutingTable &table = tables.at(id);
+                const std::vector<std::string> changes = table.take_changes();
+                for (const auto &neighbor : table.neighbors())
+                {
+                    const auto adverts = table.adverts_for(neighbor, changes);
+                    if (adverts.empty())
+                    {
+                        continue;
+                    }
+                    // Through the wire encoding, as P2PNetwork sends them
+                    const std::vector<uint8_t> payload = RoutingTable::encode(RoutingTable::UpdateKind::DELTA, adverts);
+                    RoutingTable::UpdateKind kind;
+                    std::vector<RoutingTable::Advert> decoded;
+                    ASSERT_TRUE(RoutingTable::decode(payload.data(), payload.size(), kind, decoded));
+                    EXPECT_EQ(kind, RoutingTable::UpdateKind::DELTA);
+                    tables.at(neighbor).apply_update(id, decoded, false);
+                    quiet = false;
+                }
+            }
+            if (quiet)
+            {
+                return;
+            }
+        }
+        FAIL() << "routing did not converge";
+    };
+
+    link("a", "b");
+    link("b", "c");
+    link("c", "d");
+    settle();
+    ASSERT_NE(tables.at("a").lookup("d"), nullptr);
+    EXPECT_EQ(tables.at("a").lookup("d")->next_hop, "b");
+    EXPECT_EQ(tables.at("a").lookup("d")->metric, 3u);
+    EXPECT_EQ(tables.at("d").lookup("a")->next_hop, "c");
+
+    // A shortcut changes only the routes it improves
+    const uint64_t before = tables.at("a").version();
+    link("a", "c");
+    std::vector<std::string> changed = tables.at("a").take_changes();
+    std::sort(changed.begin(), changed.end());
+    EXPECT_EQ(changed, (std::vector<std::string>{"a", "c", "d"})); // b's route is untouched
+    EXPECT_GT(tables.at("a").version(), before);
+    settle();
+    EXPECT_EQ(tables.at("a").lookup("d")->next_hop, "c");
+    EXPECT_EQ(tables.at("a").lookup("d")->metric, 2u);
+    EXPECT_EQ(tables.at("a").lookup("b")->next_hop, "b");
+
+    // Poisoned reverse: b reaches d through c, so it tells c that d is unreachable
+    ASSERT_EQ(tables.at("b").lookup("d")->next_hop, "c");
+    const auto to_c = tables.at("b").adverts_for("c", {"d"});
+    ASSERT_EQ(to_c.size(), 1u);
+    EXPECT_EQ(to_c[0].metric, tables.at("b").max_metric());
+    const auto to_a = tables.at("b").adverts_for("a", {"d"});
+    ASSERT_EQ(to_a.size(), 1u);
+    EXPECT_EQ(to_a[0].metric, 2u);
+
+    // Losing d's only link withdraws it everywhere
+    tables.at("c").remove_neighbor("d");
+    tables.at("d").remove_neighbor("c");
+    settle();
+    for (const auto &id : {"a", "b", "c"})
+    {
+        EXPECT_EQ(tables.at(id).lookup("d"), nullptr) << id;
+    }
+    EXPECT_EQ(tables.at("d").size(), 0u);
+    EXPECT_EQ(tables.at("a").size(), 2u);
+}
+
+TEST(P2PNetworkTest, SendsToRoutedPeerThroughNextHop)
+{
+    P2PNetwork a;
+    P2PNetwork hub;
+    P2PNetwork c;
+    for (P2PNetwork *node : {&a, &hub, &c})
+    {
+        node->update_config(loopback_config());
+        ASSERT_TRUE(node->initialize("127.0.0.1", 0));
+    }
+    ASSERT_TRUE(hub.start_listening());
+    const std::string hub_endpoint = "127.0.0.1:" + std::to_string(hub.get_listening_port());
+    ASSERT_TRUE(c.connect_to_peer(hub_endpoint));
+    ASSERT_TRUE(eventually([&]()
+                           { return hub.get_connected_peers().size() == 1; }));
+    const std::string c_id = hub.get_connected_peers().front().peer_id;
+    ASSERT_TRUE(a.connect_to_peer(hub_endpoint));
+    const std::string hub_id = a.get_connected_peers().front().peer_id;
+
+    ASSERT_TRUE(eventually([&]()
+                           { return a.find_route_to_peer(c_id).size() == 3; }));
+    EXPECT_EQ(a.find_route_to_peer(c_id)[1], hub_id);
+    EXPECT_EQ(a.find_route_to_peer(hub_id).size(), 2u);
+    EXPECT_TRUE(a.find_route_to_peer("peer_unknown").empty());
+    const MeshTopology topology = a.get_mesh_topology();
+    EXPECT_EQ(topology.network_diameter, 2.0);
+    ASSERT_EQ(topology.connections.count(hub_id), 1u);
+    EXPECT_EQ(topology.connections.at(hub_id), std::vector<std::string>{c_id});
+
+    std::atomic<int> hub_received{0};
+    std::atomic<int> c_received{0};
+    hub.set_message_handler(MessageType::DATA_SYNC, [&](const NetworkMessage &)
+                            { ++hub_received; });
+    c.set_message_handler(MessageType::DATA_SYNC, [&](const NetworkMessage &message)
+                          {
+        EXPECT_EQ(message.recipient_id, c_id);
+        ++c_received; });
+
+    NetworkMessage message;
+    message.message_id = "routed-1";
+    message.type = MessageType::DATA_SYNC;
+    message.sender_id = "a";
+    message.payload = {'r', 'o', 'u', 't', 'e', 'd'};
+    message.timestamp = 1;
+    message.encrypted = false;
+    ASSERT_TRUE(a.send_message(c_id, message));
+    ASSERT_TRUE(eventually([&]()
+                           { return c_received == 1; }));
+    EXPECT_EQ(hub_received, 0);
+    EXPECT_EQ(hub.get_statistics().messages_relayed, 1u);
+
+    // The hub withdraws c as soon as it goes away
+    c.shutdown();
+    EXPECT_TRUE(eventually([&]()
+                           { return a.find_route_to_peer(c_id).empty(); }));
+}
+
+TEST(P2PNetworkTest, HandshakeDeliversMessagesAndReportsDisconnect)
+{
+    P2PNetwork server;
+    P2PNetwork client;
+    server.update_config(loopback_config());
+    client.update_config(loopback_config());
+    ASSERT_TRUE(server.initialize("127.0.0.1", 0));
+    ASSERT_TRUE(client.initialize("127.0.0.1", 0));
+    ASSERT_TRUE(server.start_listening());
+    const uint16_t port = server.get_listening_port();
+    ASSERT_NE(port, 0);
+
+    std::mutex mutex;
+    std::vector<std::string> received;
+    std::atomic<int> server_disconnects{0};
+    server.set_message_handler(MessageType::DATA_SYNC, [&](const NetworkMessage &message)
+                               {
+        std::lock_guard<std::mutex> lock(mutex);
+        received.emplace_back(message.payload.begin(), message.payload.end()); });
+    std::atomic<size_t> viewed_bytes{0};
+    server.set_message_view_handler(MessageType::PING, [&](const wire::MessageView &view)
+                                    { viewed_bytes += view.payload_size; });
+    server.set_peer_event_handler([&](const PeerInfo &, bool connected)
+                                  {
+        if (!connected)
+        {
+            ++server_disconnects;
+        } });
+
+    ASSERT_TRUE(client.connect_to_peer("127.0.0.1:" + std::to_string(port)));
+    ASSERT_EQ(client.get_connected_peers().size(), 1u);
+    ASSERT_TRUE(eventually([&]()
+                           { return server.get_connected_peers().size() == 1; }));
+
+    const std::string server_id = client.get_connected_peers().front().peer_id;
+    NetworkMessage message;
+    message.message_id = "m1";
+    message.type = MessageType::DATA_SYNC;
+    message.sender_id = "client";
+    message.recipient_id = server_id;
+    message.payload = {'p', 'i', 'n', 'g'};
+    message.timestamp = 1;
+    message.encrypted = false;
+    ASSERT_TRUE(client.send_message(server_id, message));
+    ASSERT_TRUE(eventually([&]()
+                           {
+        std::lock_guard<std::mutex> lock(mutex);
+        return received.size() == 1; }));
+    EXPECT_EQ(received.front(), "ping");
+
+    message.type = MessageType::PING;
+    message.payload.assign(32, 0x01);
+    ASSERT_TRUE(client.send_message(server_id, message));
+    EXPECT_TRUE(eventually([&]()
+                           { return viewed_bytes == 32; }));
+
+    // A second network id never completes the handshake
+    P2PNetwork stranger;
+    auto other = loopback_config();
+    other.network_id = "another_network";
+    other.connection_timeout_ms = 500;
+    stranger.update_config(other);
+    ASSERT_TRUE(stranger.initialize("127.0.0.1", 0));
+    EXPECT_FALSE(stranger.connect_to_peer("127.0.0.1:" + std::to_string(port)));
+    EXPECT_EQ(server.get_connected_peers().size(), 1u);
+
+    EXPECT_TRUE(client.disconnect_from_peer(server_id));
+    EXPECT_TRUE(eventually([&]()
+                           { return server_disconnects == 1 && server.get_connected_peers().empty(); }));
+    EXPECT_FALSE(client.connect_to_peer("not-an-endpoint"));
+}
+
+TEST(SocketTransportTest, FansOutToManyConnectionsOnFixedThreads)
+{
+    SocketTransport::Options options;
+    options.io_threads = 2;
+    SocketTransport server(options);
+    SocketTransport client(options);
+
+    std::atomic<size_t> frames{0};
+    std::atomic<size_t> bytes{0};
+    server.set_handlers([](SocketTransport::ConnectionId, const std::string &, bool) {},
+                        [&](SocketTransport::ConnectionId, const uint8_t *, size_t size)
+                        {
+                            ++frames;
+                            bytes += size;
+                        },
+                        [](SocketTransport::ConnectionId) {});
+    std::atomic<size_t> connected{0};
+    client.set_handlers([&](SocketTransport::ConnectionId, const std::string &, bool)
+                        { ++connected; },
+                        [](SocketTransport::ConnectionId, const uint8_t *, size_t) {},
+                        [](SocketTransport::ConnectionId) {});
+    ASSERT_TRUE(server.start());
+    ASSERT_TRUE(client.start());
+    const uint16_t port = server.listen("127.0.0.1", 0);
+    ASSERT_NE(port, 0);
+    const size_t threads_before = thread_count();
+
+    constexpr size_t kConnections = 200;
+    constexpr size_t kFramesEach = 5;
+    std::vector<SocketTransport::ConnectionId> ids;
+    for (size_t i = 0; i < kConnections; ++i)
+    {
+        const auto id = client.connect("127.0.0.1", port);
+        ASSERT_NE(id, 0u);
+        ids.push_back(id);
+    }
+    ASSERT_TRUE(eventually([&]()
+                           { return connected == kConnections && server.connection_count() == kConnections; }));
+    EXPECT_EQ(thread_count(), threads_before);
+
+    for (size_t round = 0; round < kFramesEach; ++round)
+    {
+        for (const auto id : ids)
+        {
+            ASSERT_TRUE(client.send(id, std::vector<uint8_t>(100 + round, 0x5a)));
+        }
+    }
+    ASSERT_TRUE(eventually([&]()
+                           { return frames == kConnections * kFramesEach; }));
+    EXPECT_EQ(bytes, kConnections * (100 * kFramesEach + 10));
+
+    // Oversized frames are refused before they reach the wire
+    EXPECT_FALSE(client.send(ids.front(), std::vector<uint8_t>(options.max_frame_bytes + 1)));
+
+    const auto stats = server.get_statistics();
+    EXPECT_EQ(stats.connections_accepted, kConnections);
+    EXPECT_EQ(stats.frames_received, kConnections * kFramesEach);
+
+    client.stop();
+    EXPECT_TRUE(eventually([&]()
+                           { return server.connection_count() == 0; }));
+    server.stop();
+}
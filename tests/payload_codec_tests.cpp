@@ -0,0 +1,190 @@
+/**
+ * @file payload_codec_tests.cpp
+ * @brief Unit tests for stored payload dedup, numeric delta encoding and compression
+ *
+ * @author Cardano IoT SDK Team
+ * @version 1.0.0
+ */
+
+#include <gtest/gtest.h>
+#include "cardano_iot/cardano_iot.h"
+#include "cardano_iot/data/payload_codec.h"
+
+using namespace cardano_iot;
+using namespace cardano_iot::data;
+
+namespace
+{
+    std::string reading(double temperature, int humidity, uint64_t sequence)
+    {
+        char buffer[128];
+        std::snprintf(buffer, sizeof(buffer), R"({"temperature": %.2f, "humidity": %d, "seq": %llu, "unit": "C"})",
+                      temperature, humidity, static_cast<unsigned long long>(sequence));
+        return buffer;
+    }
+
+    // Encode, decode and compare; returns the stored size
+    size_t round_trip(PayloadCodec &codec, const std::string &device_id, const std::string &payload)
+    {
+        std::string stored;
+        const bool encoded = codec.encode(device_id, "telemetry", payload, stored);
+        if (!encoded)
+        {
+            stored = payload;
+        }
+        EXPECT_EQ(codec.decode(stored), payload) << payload;
+        EXPECT_EQ(PayloadCodec::is_encoded(stored), encoded);
+        return stored.size();
+    }
+} // namespace
+
+TEST(PayloadCodecTest, NumericDeltaRoundTripsExactly)
+{
+    PayloadCodec::Options options;
+    options.numeric_delta = true;
+    options.keyframe_interval = 16;
+    PayloadCodec codec(options);
+
+    size_t raw = 0;
+    size_t stored = 0;
+    for (uint64_t i = 0; i < 100; ++i)
+    {
+        const std::string payload = reading(21.5 + 0.01 * static_cast<double>(i % 7), 40 + static_cast<int>(i % 3), i);
+        raw += payload.size();
+        stored += round_trip(codec, "sensor-1", payload);
+    }
+    EXPECT_LT(stored * 5, raw); // Template stored once, a few bytes of deltas per reading
+    EXPECT_EQ(codec.stats().numeric, 100u);
+
+    // Numbers only where they print back byte for byte; everything else stays text
+    for (const std::string payload : {R"({"v": -0.05, "w": 0, "x": 10.50, "y": -12})",
+                                      R"({"id": "sensor 42", "fw": 1.2.3, "z": 007, "e": 1e5})",
+                                      R"({"neg_zero": -0, "big": 123456789012345678, "huge": 1234567890123456789})",
+                                      R"({"quote": "a \"3\" b", "after": 3})",
+                                      R"([1,2,3,-4.25])",
+                                      "temperature=21.5;humidity=40"})
+    {
+        round_trip(codec, "sensor-2", payload);
+    }
+
+    // Negative scaled values and keyframe refreshes across many readings
+    for (int i = 0; i < 40; ++i)
+    {
+        round_trip(codec, "sensor-3", "{\"t\": " + std::to_string(-i) + ".0" + std::to_string(i % 10) + "}");
+    }
+
+    // Plain text passes through; corrupt frames decode to nothing
+    std::string out;
+    EXPECT_FALSE(codec.encode("sensor-4", "telemetry", "no digits here", out));
+    EXPECT_TRUE(out.empty());
+    EXPECT_EQ(codec.decode(std::string("\xC1\x02\x7F\x00", 4)), "");
+    EXPECT_EQ(codec.decode(std::string("\xC1\x09", 2)), "");
+}
+
+TEST(PayloadCodecTest, DeduplicatesAndCompresses)
+{
+    PayloadCodec::Options options;
+    options.dedup = true;
+    options.compression = true;
+    options.dictionary_samples = 64;
+    PayloadCodec codec(options);
+
+    // A device repeating itself is stored once; another device sending the same bytes shares it
+    const std::string status = R"({"status": "ok", "door": "closed", "battery": "full", "firmware": "2.4.1"})";
+    round_trip(codec, "door-1", status);
+    EXPECT_LE(round_trip(codec, "door-1", status), 4u);
+    EXPECT_LE(round_trip(codec, "door-2", status), 4u);
+    EXPECT_EQ(codec.stats().deduplicated, 2u);
+
+    // Payloads that look encoded are escaped, not misread
+    round_trip(codec, "door-1", std::string("\xC1raw", 4));
+
+    if (!PayloadCodec::compression_available())
+    {
+        EXPECT_FALSE(codec.enabled() && codec.stats().compressed > 0);
+        return;
+    }
+
+    size_t first = 0;
+    size_t last = 0;
+    for (int i = 0; i < 200; ++i)
+    {
+        const std::string payload = R"({"event": "motion_detected", "zone": "warehouse-east-)" + std::to_string(i % 13) +
+                                    R"(", "confidence": "high", "camera": "cam-)" + std::to_string(i) +
+                                    R"(", "classification": "person", "tracking": "enabled"})";
+        const size_t size = round_trip(codec, "camera-" + std::to_string(i % 5), payload);
+        (i == 0 ? first : last) = size;
+    }
+    const auto stats = codec.stats();
+    EXPECT_EQ(stats.dictionaries, 1u);
+    EXPECT_GT(stats.compressed, 100u);
+    EXPECT_LT(last * 2, first); // The shared dictionary beats per-payload compression
+    EXPECT_LT(stats.stored_bytes * 2, stats.raw_bytes);
+}
+
+TEST(PayloadCodecTest, SdkStoresEncodedAndQueriesDecoded)
+{
+    CardanoIoTSDK::Config config;
+    config.network_type = "testnet";
+    config.enable_logging = false;
+    config.payload_dedup = true;
+    config.payload_numeric_delta = true;
+    CardanoIoTSDK sdk(config);
+    ASSERT_TRUE(sdk.initialize());
+    utils::Logger::instance().set_level(utils::LogLevel::ERROR);
+
+    CardanoIoTSDK::DeviceInfo device;
+    device.device_id = "codec_sensor";
+    device.device_type = "sensor";
+    device.public_key = std::string(64, 'c');
+    ASSERT_TRUE(sdk.register_device(device));
+
+    std::vector<std::string> payloads;
+    for (uint64_t i = 0; i < 50; ++i)
+    {
+        CardanoIoTSDK::IoTData data;
+        data.device_id = device.device_id;
+        data.data_type = "climate";
+        data.payload = reading(19.0 + 0.25 * static_cast<double>(i % 4), 55, i);
+        data.timestamp = 1000 + i;
+        payloads.push_back(data.payload);
+        ASSERT_FALSE(sdk.submit_data(data).empty());
+    }
+    std::vector<CardanoIoTSDK::IoTData> batch;
+    for (uint64_t i = 0; i < 50; ++i)
+    {
+        CardanoIoTSDK::IoTData data;
+        data.device_id = device.device_id;
+        data.data_type = "climate";
+        data.payload = R"({"state": "idle"})";
+        data.timestamp = 2000 + i;
+        payloads.push_back(data.payload);
+        batch.push_back(std::move(data));
+    }
+    for (const auto &tx_id : sdk.submit_data_batch(std::move(batch)))
+    {
+        EXPECT_FALSE(tx_id.empty());
+    }
+
+    auto stored = sdk.query_data(device.device_id);
+    ASSERT_EQ(stored.size(), payloads.size());
+    for (size_t i = 0; i < stored.size(); ++i)
+    {
+        EXPECT_EQ(stored[i].payload, payloads[i]);
+    }
+    // The hash covers the payload as submitted
+    EXPECT_EQ(stored[60].hash.size(), 64u);
+
+    // Views hand out the stored form
+    auto view = sdk.query_data_view(device.device_id, 1000, 1000);
+    ASSERT_EQ(view.size(), 1u);
+    const auto record = *view.begin();
+    EXPECT_TRUE(PayloadCodec::is_encoded(record.payload()));
+    EXPECT_EQ(sdk.decode_payload(record.payload()), payloads[0]);
+
+    auto status = sdk.get_network_status();
+    EXPECT_EQ(status["payload_numeric"], "50");
+    EXPECT_EQ(status["payload_deduplicated"], "49");
+    EXPECT_LT(std::stoull(status["payload_stored_bytes"]) * 4, std::stoull(status["payload_raw_bytes"]));
+    sdk.shutdown();
+}
@@ -8,8 +8,11 @@
 
 #include <gtest/gtest.h>
 #include "cardano_iot/energy/power_manager.h"
+#include "cardano_iot/energy/power_aware_outbox.h"
 #include "utils/test_utils.h"
 
+#include <thread>
+
 using namespace cardano_iot::energy;
 
 class PowerManagerTest : public ::testing::Test
@@ -59,3 +62,133 @@ TEST_F(PowerManagerTest, BatteryManagement)
     EXPECT_TRUE(power_manager_->update_battery_info("test_device", battery));
     EXPECT_DOUBLE_EQ(power_manager_->get_battery_level("test_device"), 0.8);
 }
+
+TEST_F(PowerManagerTest, TelemetryBatch)
+{
+    PowerSettings settings;
+    power_manager_->register_device("dev_a", settings);
+    power_manager_->register_device("dev_b", settings);
+
+    int battery_events = 0;
+    int critical_events = 0;
+    power_manager_->set_battery_event_callback([&](const std::string &, const BatteryInfo &)
+                                               { ++battery_events; });
+    power_manager_->set_power_event_callback([&](const std::string &device_id, PowerState state, double)
+                                             {
+        // Fires after the batch's lock is released, so querying back must not deadlock
+        if (state == PowerState::CRITICAL && power_manager_->get_power_state(device_id) == PowerState::CRITICAL)
+        {
+            ++critical_events;
+        } });
+
+    std::vector<cardano_iot::core::DeviceTelemetry> records(4);
+    records[0].device_id = "dev_a";
+    records[0].battery_level = 0.5;
+    records[0].power_mw = 80.0;
+    records[1].device_id = "dev_b";
+    records[1].battery_level = 0.02;
+    records[2].device_id = "unknown";
+    records[2].power_mw = 10.0;
+    records[3].device_id = "dev_a";
+    records[3].battery_level = 0.4;
+
+    EXPECT_EQ(power_manager_->apply_telemetry_batch(records), 3u);
+    EXPECT_DOUBLE_EQ(power_manager_->get_battery_level("dev_a"), 0.4);
+    EXPECT_DOUBLE_EQ(power_manager_->get_power_profile("dev_a")->power_consumption_mw, 80.0);
+    EXPECT_EQ(power_manager_->get_power_state("dev_b"), PowerState::CRITICAL);
+    EXPECT_EQ(battery_events, 2); // one per device, not per record
+    EXPECT_EQ(critical_events, 1);
+}
+
+TEST_F(PowerManagerTest, FleetQueries)
+{
+    PowerSettings settings;
+    for (int i = 0; i < 50; ++i)
+    {
+        ASSERT_TRUE(power_manager_->register_device("fleet_" + std::to_string(i), settings));
+        ASSERT_TRUE(power_manager_->update_power_consumption("fleet_" + std::to_string(i), 10.0 + i));
+    }
+
+    // 2000 mAh at 3.7 V: fleet_49 draws 59 mW, about 16 mA, so well over a day to critical
+    EXPECT_TRUE(power_manager_->get_devices_critical_within(24.0).empty());
+
+    BatteryInfo low{};
+    low.voltage = 3.7;
+    low.capacity_mah = 2000;
+    low.remaining_mah = 110; // 10 mAh above the 5% critical threshold
+    low.charge_level = 0.055;
+    ASSERT_TRUE(power_manager_->update_battery_info("fleet_30", low));
+    ASSERT_TRUE(power_manager_->update_battery_info("fleet_40", low));
+    ASSERT_TRUE(power_manager_->update_harvested_energy("fleet_40", PowerSource::SOLAR, 100.0));
+
+    auto critical = power_manager_->get_devices_critical_within(1.0);
+    ASSERT_EQ(critical.size(), 1u); // fleet_40's harvest covers its draw
+    EXPECT_EQ(critical[0].first, "fleet_30");
+    EXPECT_NEAR(critical[0].second, 10.0 / (40.0 / 3.7), 1e-9);
+
+    auto top = power_manager_->get_top_draining_devices(3);
+    ASSERT_EQ(top.size(), 3u);
+    EXPECT_EQ(top[0].first, "fleet_49");
+    EXPECT_EQ(top[2].first, "fleet_47");
+
+    // Removal swaps slots around; the moved device must still be found
+    ASSERT_TRUE(power_manager_->unregister_device("fleet_30"));
+    EXPECT_TRUE(power_manager_->get_devices_critical_within(1.0).empty());
+    EXPECT_DOUBLE_EQ(power_manager_->get_efficiency_metrics("fleet_49").at("consumption_mw"), 59.0);
+    EXPECT_DOUBLE_EQ(power_manager_->get_harvesting_stats("fleet_40").at("solar_mwh"), 100.0);
+
+    auto summary = power_manager_->get_fleet_power_summary();
+    EXPECT_EQ(summary.at("devices"), 49.0);
+    EXPECT_DOUBLE_EQ(summary.at("total_harvest_mw"), 100.0);
+}
+
+TEST_F(PowerManagerTest, OutboxHoldsOperationsUntilPowerAllows)
+{
+    PowerSettings batched;
+    PowerSettings unbatched;
+    unbatched.enable_tx_power_control = false;
+    ASSERT_TRUE(power_manager_->register_device("battery", batched));
+    ASSERT_TRUE(power_manager_->register_device("mains", unbatched));
+
+    std::vector<std::pair<std::vector<uint64_t>, FlushReason>> flushes;
+    PowerAwareOutbox::Options options;
+    options.poll_interval_ms = 0;
+    options.max_batch_operations = 4;
+    PowerAwareOutbox outbox(
+        *power_manager_,
+        [&flushes](const std::string &, std::vector<uint64_t> &&tickets, FlushReason reason)
+        { flushes.emplace_back(std::move(tickets), reason); },
+        options);
+
+    outbox.enqueue(1, "mains", "data_submission", 100);
+    ASSERT_EQ(flushes.size(), 1u);
+    EXPECT_EQ(flushes[0].second, FlushReason::IMMEDIATE);
+
+    // Held until the batch fills: one radio wake-up for four operations
+    for (uint64_t ticket = 2; ticket <= 5; ++ticket)
+    {
+        outbox.enqueue(ticket, "battery", "data_submission", 100);
+    }
+    ASSERT_EQ(flushes.size(), 2u);
+    EXPECT_EQ(flushes[1].second, FlushReason::BATCH_FULL);
+    EXPECT_EQ(flushes[1].first, (std::vector<uint64_t>{2, 3, 4, 5}));
+
+    // A short deadline sends on the next poll
+    outbox.enqueue(6, "battery", "ada_transfer", 0, 1);
+    EXPECT_EQ(outbox.pending("battery"), 1u);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    EXPECT_EQ(outbox.poll(), 1u);
+    EXPECT_EQ(flushes.back().second, FlushReason::DEADLINE);
+
+    // Charging makes power available
+    outbox.enqueue(7, "battery", "data_submission", 100);
+    EXPECT_EQ(outbox.poll(), 0u);
+    ASSERT_TRUE(power_manager_->set_power_state("battery", PowerState::CHARGING));
+    EXPECT_EQ(outbox.poll(), 1u);
+    EXPECT_EQ(flushes.back().second, FlushReason::POWER_AVAILABLE);
+
+    auto stats = outbox.get_statistics();
+    EXPECT_EQ(stats.at("queued_operations"), 7u);
+    EXPECT_EQ(stats.at("radio_wakeups"), 4u);
+    EXPECT_EQ(outbox.pending(), 0u);
+}
@@ -0,0 +1,96 @@
+/**
+ * @file profiler_tests.cpp
+ * @brief Unit tests for PerformanceProfiler spans and trace export
+ *
+ * @author Cardano IoT SDK Team
+ * @version 1.0.0
+ */
+
+#include <gtest/gtest.h>
+#include "cardano_iot/performance/performance_optimizer.h"
+#include "cardano_iot/security/encryption.h"
+
+#include <nlohmann/json.hpp>
+
+#include <thread>
+#include <vector>
+
+using namespace cardano_iot::performance;
+
+TEST(PerformanceProfilerTest, RecordsSpansOnlyWhileEnabled)
+{
+    {
+        ScopedTimer idle("idle");
+        EXPECT_EQ(idle.get_elapsed_ms(), 0.0);
+    }
+
+    PerformanceProfiler::start_session("threads");
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; ++t)
+    {
+        workers.emplace_back([]
+                             {
+                                 for (int i = 0; i < 20000; ++i)
+                                 {
+                                     PROFILE_SCOPE("work");
+                                 } });
+    }
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+    PerformanceProfiler::set_enabled(false);
+    {
+        PROFILE_SCOPE("work"); // Not recorded
+    }
+    PerformanceProfiler::set_enabled(true);
+
+    EXPECT_TRUE(PerformanceProfiler::end_session("other").empty());
+    auto results = PerformanceProfiler::end_session("threads");
+    EXPECT_EQ(results["work.count"] + results["spans_dropped"], 80000.0);
+    EXPECT_GT(results["work.count"], 0.0);
+    EXPECT_EQ(results.count("idle.count"), 0u);
+    EXPECT_FALSE(PerformanceProfiler::is_enabled());
+}
+
+TEST(PerformanceProfilerTest, ExportsNestedSpansAsChromeTrace)
+{
+    PerformanceProfiler::start_session("nested");
+    const double elapsed = PerformanceProfiler::profile_function("outer", []
+                                                                 {
+                                                                     PROFILE_SCOPE("inner");
+                                                                     std::this_thread::sleep_for(std::chrono::milliseconds(5)); });
+    EXPECT_GE(elapsed, 5.0);
+    auto results = PerformanceProfiler::end_session("nested");
+    EXPECT_EQ(results["outer.count"], 1.0);
+    EXPECT_GE(results["inner.total_ms"], 4.0);
+    EXPECT_GE(results["outer.total_ms"], results["inner.total_ms"]);
+
+    auto trace = nlohmann::json::parse(PerformanceProfiler::export_chrome_trace(), nullptr, false);
+    ASSERT_TRUE(trace.is_object());
+    ASSERT_EQ(trace["traceEvents"].size(), 2u);
+    const auto &inner = trace["traceEvents"][0]["name"] == "inner" ? trace["traceEvents"][0] : trace["traceEvents"][1];
+    const auto &outer = trace["traceEvents"][0]["name"] == "outer" ? trace["traceEvents"][0] : trace["traceEvents"][1];
+    EXPECT_EQ(inner["ph"], "X");
+    EXPECT_GE(inner["ts"].get<double>(), outer["ts"].get<double>());
+    EXPECT_LE(inner["ts"].get<double>() + inner["dur"].get<double>(),
+              outer["ts"].get<double>() + outer["dur"].get<double>() + 0.01);
+    EXPECT_GE(inner["dur"].get<double>(), 4000.0);
+
+    EXPECT_NE(PerformanceProfiler::get_profiling_report().find("inner"), std::string::npos);
+}
+
+TEST(PerformanceProfilerTest, HotPathsCarrySpans)
+{
+    cardano_iot::security::Encryption encryption;
+    ASSERT_TRUE(encryption.initialize());
+    const std::string key_id = encryption.generate_key(cardano_iot::security::EncryptionAlgorithm::AES_256_GCM);
+
+    PerformanceProfiler::start_session("encrypt");
+    for (int i = 0; i < 10; ++i)
+    {
+        ASSERT_FALSE(encryption.encrypt({'i', 'o', 't'}, key_id).ciphertext.empty());
+    }
+    auto results = PerformanceProfiler::end_session("encrypt");
+    EXPECT_EQ(results["Encryption::encrypt.count"], 10.0);
+}
@@ -9,8 +9,19 @@
 #include <gtest/gtest.h>
 #include "cardano_iot/security/authentication.h"
 #include "cardano_iot/security/encryption.h"
+#include "cardano_iot/security/file_cipher.h"
+#include "cardano_iot/security/session_table.h"
+#include "cardano_iot/security/token_authority.h"
 #include "utils/test_utils.h"
 
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <thread>
+#include <unistd.h>
+
 using namespace cardano_iot::security;
 
 class SecurityTest : public ::testing::Test
@@ -45,6 +56,246 @@ TEST_F(SecurityTest, EncryptionAesGcmRoundTrip)
     ASSERT_EQ(dt, pt);
 }
 
+namespace
+{
+    std::string temp_path(const std::string &name)
+    {
+        return "/tmp/cardano_iot_" + std::to_string(::getpid()) + "_" + name;
+    }
+
+    std::vector<uint8_t> read_file(const std::string &path)
+    {
+        std::ifstream in(path, std::ios::binary);
+        return std::vector<uint8_t>((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    }
+
+    void write_file(const std::string &path, const std::vector<uint8_t> &data)
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char *>(data.data()), static_cast<std::streamsize>(data.size()));
+    }
+} // namespace
+
+TEST_F(SecurityTest, FileEncryptionStreamsAuthenticatedSegments)
+{
+    Encryption enc;
+    ASSERT_TRUE(enc.initialize());
+    auto config = enc.get_config();
+    config.file_segment_bytes = 4096;
+    config.file_encryption_threads = 4;
+    enc.update_config(config);
+
+    const std::string plain = temp_path("plain.bin");
+    const std::string sealed = temp_path("sealed.bin");
+    const std::string opened = temp_path("opened.bin");
+
+    for (auto algorithm : {EncryptionAlgorithm::AES_256_GCM, EncryptionAlgorithm::CHACHA20_POLY1305})
+    {
+        const std::string key_id = enc.generate_key(algorithm);
+        // Sizes around segment and batch boundaries, including empty
+        for (size_t size : {size_t(0), size_t(1), size_t(4096), size_t(4096 * 16), size_t(4096 * 37 + 123)})
+        {
+            std::vector<uint8_t> data(size);
+            for (size_t i = 0; i < size; ++i)
+            {
+                data[i] = static_cast<uint8_t>(i * 31 + size);
+            }
+            write_file(plain, data);
+
+            ASSERT_TRUE(enc.encrypt_file(plain, sealed, key_id)) << size;
+            const size_t segments = size == 0 ? 1 : (size + 4095) / 4096;
+            const std::vector<uint8_t> ciphertext = read_file(sealed);
+            EXPECT_EQ(ciphertext.size(), 8 + 1 + 1 + 2 + 4 + 8 + 16 + 7 + 2 + key_id.size() + size + segments * 16);
+            EXPECT_EQ(FileCipher::read_key_id(sealed), key_id);
+
+            ASSERT_TRUE(enc.decrypt_file(sealed, opened, "")) << size;
+            EXPECT_EQ(read_file(opened), data) << size;
+        }
+
+        // Any flipped bit fails the whole file and leaves no plaintext behind
+        std::vector<uint8_t> ciphertext = read_file(sealed);
+        ciphertext[ciphertext.size() / 2] ^= 0x01;
+        write_file(sealed, ciphertext);
+        std::remove(opened.c_str());
+        EXPECT_FALSE(enc.decrypt_file(sealed, opened, key_id));
+        EXPECT_FALSE(std::ifstream(opened).good());
+
+        // Dropping the final segment is caught even though what remains is well formed
+        ciphertext[ciphertext.size() / 2] ^= 0x01;
+        ciphertext.resize(ciphertext.size() - (123 + 16));
+        write_file(sealed, ciphertext);
+        EXPECT_FALSE(enc.decrypt_file(sealed, opened, key_id));
+    }
+
+    // The header names the key; a different one is refused
+    const std::string other = enc.generate_key(EncryptionAlgorithm::AES_256_GCM);
+    write_file(plain, {1, 2, 3});
+    ASSERT_TRUE(enc.encrypt_file(plain, sealed, other));
+    EXPECT_FALSE(enc.decrypt_file(sealed, opened, "some_other_key"));
+    EXPECT_TRUE(enc.decrypt_file(sealed, opened, other));
+
+    std::remove(plain.c_str());
+    std::remove(sealed.c_str());
+    std::remove(opened.c_str());
+}
+
+TEST_F(SecurityTest, BatchAeadInPlaceAndArenaRoundTrip)
+{
+    Encryption enc;
+    ASSERT_TRUE(enc.initialize());
+
+    for (auto algorithm : {EncryptionAlgorithm::AES_256_GCM, EncryptionAlgorithm::CHACHA20_POLY1305})
+    {
+        const std::string key_id = enc.generate_key(algorithm);
+        std::vector<std::vector<uint8_t>> plaintexts;
+        for (size_t size : {size_t(0), size_t(1), size_t(64), size_t(257), size_t(4096)})
+        {
+            std::vector<uint8_t> data(size);
+            for (size_t i = 0; i < size; ++i)
+            {
+                data[i] = static_cast<uint8_t>(i * 7 + size);
+            }
+            plaintexts.push_back(std::move(data));
+        }
+
+        // In place: data is overwritten, nonces are distinct, tampering fails only that record
+        std::vector<std::vector<uint8_t>> buffers = plaintexts;
+        std::vector<AeadRecord> records(buffers.size());
+        for (size_t i = 0; i < buffers.size(); ++i)
+        {
+            records[i].data = buffers[i].data();
+            records[i].size = buffers[i].size();
+        }
+        ASSERT_EQ(enc.encrypt_batch(records.data(), records.size(), key_id), records.size());
+        EXPECT_NE(buffers.back(), plaintexts.back());
+        EXPECT_NE(0, std::memcmp(records[0].nonce, records[1].nonce, sizeof(records[0].nonce)));
+
+        buffers[3][10] ^= 0x01;
+        EXPECT_EQ(enc.decrypt_batch(records.data(), records.size(), key_id), records.size() - 1);
+        EXPECT_FALSE(records[3].ok);
+        EXPECT_EQ(buffers[3], std::vector<uint8_t>(buffers[3].size(), 0));
+        for (size_t i = 0; i < buffers.size(); ++i)
+        {
+            if (i != 3)
+            {
+                EXPECT_TRUE(records[i].ok) << i;
+                EXPECT_EQ(buffers[i], plaintexts[i]) << i;
+            }
+        }
+
+        // Arena form: one allocation in, one out
+        EncryptedBatch batch = enc.encrypt_batch(plaintexts, key_id);
+        ASSERT_EQ(batch.sizes.size(), plaintexts.size());
+        EXPECT_EQ(batch.algorithm, algorithm);
+        std::vector<uint8_t> opened;
+        ASSERT_EQ(enc.decrypt_batch(batch, opened), plaintexts.size());
+        std::vector<uint8_t> expected;
+        for (const auto &plaintext : plaintexts)
+        {
+            expected.insert(expected.end(), plaintext.begin(), plaintext.end());
+        }
+        EXPECT_EQ(opened, expected);
+
+        batch.arena[batch.offsets[2] + 12] ^= 0x80;
+        EXPECT_EQ(enc.decrypt_batch(batch, opened), plaintexts.size() - 1);
+    }
+
+    AeadRecord record;
+    EXPECT_EQ(enc.encrypt_batch(&record, 1, "missing_key"), 0u);
+}
+
+TEST_F(SecurityTest, StatelessTokensAndShardedSessions)
+{
+    Authentication auth;
+    ASSERT_TRUE(auth.initialize());
+
+    const std::string token = auth.generate_access_token("device01", 60);
+    ASSERT_FALSE(token.empty());
+    EXPECT_TRUE(auth.validate_token(token));
+
+    // Any change to claims or tag breaks the MAC
+    std::string forged = token;
+    forged[10] = forged[10] == 'A' ? 'B' : 'A';
+    EXPECT_FALSE(auth.validate_token(forged));
+    EXPECT_FALSE(auth.validate_token(token.substr(0, token.size() - 1)));
+    EXPECT_FALSE(auth.validate_token("token_0123456789abcdef"));
+
+    // A token from another issuer does not verify here
+    Authentication other;
+    ASSERT_TRUE(other.initialize());
+    EXPECT_FALSE(other.validate_token(token));
+
+    const std::string refreshed = auth.refresh_token(token);
+    ASSERT_FALSE(refreshed.empty());
+    EXPECT_FALSE(auth.validate_token(token));
+    EXPECT_TRUE(auth.validate_token(refreshed));
+    EXPECT_TRUE(auth.revoke_token(refreshed));
+    EXPECT_FALSE(auth.revoke_token(refreshed));
+    EXPECT_FALSE(auth.validate_token(refreshed));
+
+    TokenAuthority authority;
+    AccessTokenClaims claims;
+    const std::string short_lived = authority.issue("device02", 1000, 10, &claims);
+    EXPECT_EQ(authority.verify(short_lived, 1010), TokenAuthority::Verdict::VALID);
+    EXPECT_EQ(authority.verify(short_lived, 1011), TokenAuthority::Verdict::EXPIRED);
+    EXPECT_EQ(claims.device_id, "device02");
+
+    // Sessions validate concurrently; terminate and expiry remove them
+    auto session = auth.create_session("device01");
+    ASSERT_FALSE(session.session_id.empty());
+    std::vector<std::thread> readers;
+    std::atomic<int> valid{0};
+    for (int t = 0; t < 4; ++t)
+    {
+        readers.emplace_back([&]
+                             {
+                                 for (int i = 0; i < 1000; ++i)
+                                 {
+                                     valid += auth.validate_session(session.session_id);
+                                 } });
+    }
+    for (auto &reader : readers)
+    {
+        reader.join();
+    }
+    EXPECT_EQ(valid.load(), 4000);
+    EXPECT_EQ(auth.get_active_sessions().size(), 1u);
+    EXPECT_TRUE(auth.terminate_session(session.session_id));
+    EXPECT_FALSE(auth.validate_session(session.session_id));
+
+    SessionTable table(4);
+    AuthSession expiring{};
+    expiring.session_id = "sess_a";
+    expiring.device_id = "device03";
+    expiring.expiry_timestamp = 100;
+    table.insert(expiring);
+    EXPECT_EQ(table.touch("sess_a", 100), SessionTable::Lookup::VALID);
+    EXPECT_EQ(table.touch("sess_a", 101), SessionTable::Lookup::EXPIRED);
+    EXPECT_EQ(table.touch("sess_a", 101), SessionTable::Lookup::UNKNOWN);
+}
+
+TEST_F(SecurityTest, SessionsExpireInTheBackground)
+{
+    Authentication auth;
+    ASSERT_TRUE(auth.initialize());
+    auto policy = auth.get_security_policy();
+    policy.session_timeout_seconds = 1;
+    auth.set_security_policy(policy);
+
+    auth.create_session("device01");
+    auth.create_session("device02");
+    ASSERT_EQ(auth.get_active_sessions().size(), 2u);
+    ASSERT_EQ(auth.get_statistics().active_sessions, 2u);
+
+    // Nobody looks the sessions up; the timer wheel removes them
+    for (int i = 0; i < 60 && !auth.get_active_sessions().empty(); ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    EXPECT_TRUE(auth.get_active_sessions().empty());
+    EXPECT_EQ(auth.get_statistics().active_sessions, 0u);
+}
+
 TEST_F(SecurityTest, DISABLED_AuthenticationPasswordFlow)
 {
     using namespace cardano_iot::security;
@@ -0,0 +1,280 @@
+/**
+ * @file signing_coordinator_tests.cpp
+ * @brief Tests for batched witness handling and parallel multisig signing sessions
+ */
+
+#include <gtest/gtest.h>
+#include "cardano_iot/core/signing_coordinator.h"
+#include "cardano_iot/core/transaction_manager.h"
+#include "cardano_iot/network/p2p_network.h"
+#include "utils/test_utils.h"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+using namespace cardano_iot::core;
+using namespace cardano_iot::network;
+using namespace std::chrono_literals;
+using cardano_iot::test::eventually;
+
+namespace
+{
+    P2PNetwork::P2PConfig loopback_config()
+    {
+        P2PNetwork::P2PConfig config;
+        config.listen_address = "127.0.0.1";
+        config.listen_port = 0;
+        config.connection_timeout_ms = 3000;
+        config.io_threads = 1;
+        return config;
+    }
+
+    Transaction make_transaction(const std::string &tx_id)
+    {
+        Transaction tx;
+        tx.tx_id = tx_id;
+        tx.type = TransactionType::PAYMENT;
+        tx.status = TransactionStatus::PENDING;
+        tx.fee = 170000;
+        tx.ttl = 1000;
+        TransactionInput input;
+        input.tx_hash = std::string(64, 'a');
+        input.output_index = 0;
+        tx.inputs.push_back(input);
+        TransactionOutput output;
+        output.address = "addr_test1qexample";
+        output.amount_lovelace = 2000000;
+        tx.outputs.push_back(output);
+        tx.created_timestamp = 1;
+        tx.submitted_timestamp = 0;
+        tx.confirmed_timestamp = 0;
+        return tx;
+    }
+
+    // Raw Ed25519 seed, distinct per index
+    std::string signing_key(int index)
+    {
+        static const char hex_digits[] = "0123456789abcdef";
+        return std::string(62, hex_digits[index % 16]) + "0" + hex_digits[(index + 1) % 16];
+    }
+
+    std::string vkey(int index)
+    {
+        return TransactionManager::create_witness(std::string(64, '0'), signing_key(index)).substr(0, 64);
+    }
+
+    // A coordinator network with signer networks connected to it
+    struct Fleet
+    {
+        TransactionManager transactions;
+        P2PNetwork coordinator_network;
+        std::vector<std::unique_ptr<P2PNetwork>> signer_networks;
+        std::unique_ptr<SigningCoordinator> coordinator;
+        std::vector<std::unique_ptr<SigningCoordinator>> signers;
+
+        bool start(size_t count)
+        {
+            coordinator_network.update_config(loopback_config());
+            if (!transactions.initialize("testnet") || !coordinator_network.initialize("127.0.0.1", 0) ||
+                !coordinator_network.start_listening())
+            {
+                return false;
+            }
+            const std::string endpoint = "127.0.0.1:" + std::to_string(coordinator_network.get_listening_port());
+            for (size_t i = 0; i < count; ++i)
+            {
+                auto network = std::make_unique<P2PNetwork>();
+                network->update_config(loopback_config());
+                if (!network->initialize("127.0.0.1", 0) || !network->connect_to_peer(endpoint))
+                {
+                    return false;
+                }
+                signer_networks.push_back(std::move(network));
+            }
+            coordinator = std::make_unique<SigningCoordinator>(coordinator_network, transactions);
+            return eventually([&]()
+                              { return coordinator_network.get_connected_peers().size() == count; });
+        }
+
+        void serve(size_t index, const std::string &key, SigningCoordinator::Approver approver = nullptr)
+        {
+            signers.resize(signer_networks.size());
+            signers[index] = std::make_unique<SigningCoordinator>(*signer_networks[index], transactions);
+            signers[index]->serve(key, std::move(approver));
+        }
+
+        std::vector<SigningCoordinator::Signer> roster() const
+        {
+            std::vector<SigningCoordinator::Signer> roster;
+            for (size_t i = 0; i < signer_networks.size(); ++i)
+            {
+                roster.push_back({signer_networks[i]->get_local_peer_id(), vkey(static_cast<int>(i))});
+            }
+            return roster;
+        }
+
+        ~Fleet()
+        {
+            signers.clear();
+            coordinator.reset();
+            for (auto &network : signer_networks)
+            {
+                network->shutdown();
+            }
+            coordinator_network.shutdown();
+            transactions.shutdown();
+        }
+    };
+} // namespace
+
+TEST(SigningCoordinatorTests, WitnessesAreVerifiedAndEncodedInBatches)
+{
+    TransactionManager tm;
+    ASSERT_TRUE(tm.initialize("testnet"));
+    auto tx = make_transaction("multisig-batch");
+    const std::string body_hash = tm.get_body_hash(tx);
+    ASSERT_EQ(body_hash.size(), 64u);
+
+    const std::string first = TransactionManager::create_witness(body_hash, signing_key(1));
+    const std::string second = TransactionManager::create_witness(body_hash, signing_key(2));
+    ASSERT_EQ(first.size(), 192u);
+    std::string tampered = first;
+    tampered.back() = tampered.back() == '0' ? '1' : '0';
+    const std::string other_body = TransactionManager::create_witness(std::string(64, 'f'), signing_key(3));
+
+    const auto valid = TransactionManager::verify_witnesses(body_hash, {first, tampered, second, other_body, "junk"});
+    EXPECT_EQ(valid, (std::vector<uint8_t>{1, 0, 1, 0, 0}));
+    EXPECT_EQ(TransactionManager::verify_witnesses("not-hex", {first}), std::vector<uint8_t>{0});
+
+    // Duplicates are skipped and the signed CBOR carries every witness
+    EXPECT_EQ(tm.add_witnesses(tx, {first, second, first}), 2u);
+    EXPECT_FALSE(tm.add_witness(tx, second));
+    auto decoded = tm.decode_transaction(tx.signed_cbor);
+    ASSERT_NE(decoded, nullptr);
+    EXPECT_EQ(decoded->witnesses, (std::vector<std::string>{first, second}));
+    EXPECT_EQ(tm.get_body_hash(tx), body_hash); // Witnesses are not part of the signed body
+
+    // Hex Ed25519 pairs become vkey witnesses; other pairs keep the legacy form
+    auto stored = make_transaction("multisig-stored");
+    const std::string stored_hash = tm.get_body_hash(stored);
+    tm.submit_transaction(stored);
+    const std::string witness = TransactionManager::create_witness(stored_hash, signing_key(4));
+    ASSERT_TRUE(tm.add_multisig_signatures("multisig-stored",
+                                           {{witness.substr(64), witness.substr(0, 64)}, {"sig", "vk"}}));
+    EXPECT_FALSE(tm.add_multisig_signatures("unknown", {{"sig", "vk"}}));
+    auto record = tm.get_transaction("multisig-stored");
+    ASSERT_NE(record, nullptr);
+    EXPECT_EQ(record->witnesses, (std::vector<std::string>{witness, "sig:vk"}));
+    EXPECT_EQ(TransactionManager::verify_witnesses(stored_hash, {record->witnesses[0]}), std::vector<uint8_t>{1});
+    tm.shutdown();
+}
+
+TEST(SigningCoordinatorTests, SessionFinishesWithTheSlowestSignerTheThresholdNeeds)
+{
+    Fleet fleet;
+    ASSERT_TRUE(fleet.start(5));
+    for (size_t i = 0; i < 5; ++i)
+    {
+        SigningCoordinator::Approver approver;
+        if (i >= 3)
+        {
+            approver = [](const std::string &, const std::string &, const std::string &)
+            {
+                std::this_thread::sleep_for(1500ms);
+                return true;
+            };
+        }
+        fleet.serve(i, signing_key(static_cast<int>(i)), approver);
+    }
+
+    auto tx = make_transaction("multisig-threshold");
+    const auto result = fleet.coordinator->collect(tx, fleet.roster(), 3, 5000);
+    EXPECT_TRUE(result.complete);
+    EXPECT_LT(result.elapsed_ms, 1000u);
+    EXPECT_EQ(result.signed_by.size(), 3u);
+    EXPECT_TRUE(result.rejected.empty());
+
+    ASSERT_EQ(tx.witnesses.size(), 3u);
+    const auto valid = TransactionManager::verify_witnesses(fleet.transactions.get_body_hash(tx), tx.witnesses);
+    EXPECT_EQ(valid, (std::vector<uint8_t>{1, 1, 1}));
+    auto decoded = fleet.transactions.decode_transaction(tx.signed_cbor);
+    ASSERT_NE(decoded, nullptr);
+    EXPECT_EQ(decoded->witnesses, tx.witnesses);
+
+    const auto stats = fleet.coordinator->stats();
+    EXPECT_EQ(stats.sessions, 1u);
+    EXPECT_EQ(stats.completed, 1u);
+    EXPECT_EQ(stats.witnesses_accepted, 3u);
+}
+
+TEST(SigningCoordinatorTests, RefusalsAndForeignKeysEndTheSessionEarly)
+{
+    Fleet fleet;
+    ASSERT_TRUE(fleet.start(4));
+    fleet.serve(0, signing_key(0));
+    fleet.serve(1, signing_key(1), [](const std::string &tx_id, const std::string &body_hash, const std::string &)
+                { return tx_id != "multisig-refused" && body_hash.size() == 64; });
+    fleet.serve(2, signing_key(9)); // Valid signature, but not the key on the roster
+    fleet.serve(3, signing_key(3));
+
+    const auto roster = fleet.roster();
+    auto tx = make_transaction("multisig-refused");
+    const auto result = fleet.coordinator->collect(tx, roster, 3, 5000);
+    EXPECT_FALSE(result.complete);
+    EXPECT_LT(result.elapsed_ms, 2000u); // Not the timeout: three of four can no longer sign
+    std::vector<std::string> rejected = result.rejected;
+    std::sort(rejected.begin(), rejected.end());
+    std::vector<std::string> expected = {roster[1].peer_id, roster[2].peer_id};
+    std::sort(expected.begin(), expected.end());
+    EXPECT_EQ(rejected, expected);
+    EXPECT_LE(tx.witnesses.size(), 2u); // Signers 0 and 3 may still be on their way when the session ends
+    EXPECT_EQ(tx.witnesses.size(), result.signed_by.size());
+
+    // Signer 1 agrees to another transaction, so a threshold of three is met
+    auto next = make_transaction("multisig-accepted");
+    const auto accepted = fleet.coordinator->collect(next, roster, 3, 5000);
+    EXPECT_TRUE(accepted.complete);
+    EXPECT_EQ(next.witnesses.size(), 3u);
+
+    auto impossible = make_transaction("multisig-impossible");
+    EXPECT_FALSE(fleet.coordinator->collect(impossible, roster, 5, 5000).complete);
+    EXPECT_TRUE(impossible.witnesses.empty());
+}
+
+TEST(SigningCoordinatorTests, OnlyRosterKeysCountTowardTheThreshold)
+{
+    Fleet fleet;
+    ASSERT_TRUE(fleet.start(4));
+    fleet.serve(0, signing_key(0));
+    fleet.serve(1, signing_key(1));
+    fleet.serve(2, signing_key(7)); // Answers with a valid witness from a key nobody listed
+    fleet.serve(3, signing_key(3), [](const std::string &, const std::string &, const std::string &)
+                {
+                    std::this_thread::sleep_for(300ms); // Answers after the unlisted key was seen
+                    return true;
+                });
+
+    const auto roster = fleet.roster();
+    auto tx = make_transaction("multisig-unlisted");
+    const auto result = fleet.coordinator->collect(tx, roster, 3, 5000);
+    EXPECT_TRUE(result.complete);
+    EXPECT_EQ(result.rejected, std::vector<std::string>{roster[2].peer_id});
+    EXPECT_EQ(std::count(result.signed_by.begin(), result.signed_by.end(), roster[2].peer_id), 0);
+    ASSERT_EQ(tx.witnesses.size(), 3u);
+    for (const auto &witness : tx.witnesses)
+    {
+        EXPECT_NE(witness.substr(0, 64), vkey(7));
+    }
+
+    // A roster entry without a key would accept any key, so the session is refused before any request
+    auto open_roster = roster;
+    open_roster[2].verification_key.clear();
+    auto open_tx = make_transaction("multisig-open");
+    const auto refused = fleet.coordinator->collect(open_tx, open_roster, 3, 5000);
+    EXPECT_FALSE(refused.complete);
+    EXPECT_EQ(refused.rejected, std::vector<std::string>{roster[2].peer_id});
+    EXPECT_TRUE(open_tx.witnesses.empty());
+    EXPECT_EQ(fleet.signers[0]->stats().requests_served, 1u);
+}
@@ -0,0 +1,299 @@
+/**
+ * @file smart_contract_tests.cpp
+ * @brief Unit tests for Plutus Data, the UPLC evaluator and cached read-only calls in SmartContractInterface
+ */
+
+#include <gtest/gtest.h>
+#include "cardano_iot/core/plutus_data.h"
+#include "cardano_iot/core/plutus_script.h"
+#include "cardano_iot/core/smart_contract_interface.h"
+#include "cardano_iot/utils/codec.h"
+
+#include <chrono>
+#include <mutex>
+
+using namespace cardano_iot::core;
+
+namespace
+{
+    uplc::ExBudget budget(uint64_t cpu, uint64_t memory)
+    {
+        uplc::ExBudget limit;
+        limit.cpu = cpu;
+        limit.memory = memory;
+        return limit;
+    }
+
+    // \fn state x -> multiplyInteger (unIData x) 2
+    std::string doubling_script()
+    {
+        uplc::Program program;
+        const uint32_t x = program.apply(program.builtin(uplc::Builtin::UN_I_DATA), program.var(1));
+        const uint32_t body = program.apply(program.apply(program.builtin(uplc::Builtin::MULTIPLY_INTEGER), x),
+                                            program.integer(2));
+        program.set_root(program.lambda(program.lambda(program.lambda(body))));
+        return cardano_iot::utils::codec::hex_encode(uplc::encode_script(program));
+    }
+} // namespace
+
+TEST(PlutusDataTest, ArenaBuildsEncodesAndDecodesLedgerCbor)
+{
+    // Constr 0 [I 42, B "ab", List [I 1, I -2]]
+    PlutusDataArena arena;
+    arena.begin_constructor(0);
+    arena.add_integer(42);
+    arena.add_text("ab");
+    arena.begin_list();
+    arena.add_integer(1);
+    arena.add_integer(-2);
+    arena.end();
+    const auto root = arena.end();
+
+    std::vector<uint8_t> cbor;
+    arena.encode(root, cbor);
+    EXPECT_EQ(cardano_iot::utils::codec::hex_encode(cbor), "d8799f182a4261629f0121ffff");
+
+    PlutusDataArena decoded;
+    PlutusDataArena::NodeId decoded_root = 0;
+    ASSERT_TRUE(decoded.decode(cbor.data(), cbor.size(), decoded_root));
+    ASSERT_EQ(decoded.type(decoded_root), PlutusDataType::CONSTRUCTOR);
+    ASSERT_EQ(decoded.child_count(decoded_root), 3u);
+    EXPECT_EQ(decoded.integer(decoded.child(decoded_root, 0)), 42);
+    EXPECT_EQ(decoded.bytes(decoded.child(decoded_root, 1)), "ab");
+    EXPECT_EQ(decoded.integer(decoded.child(decoded.child(decoded_root, 2), 1)), -2);
+
+    // A warm arena reuses its storage for the next datum
+    const size_t nodes = arena.node_count();
+    arena.clear();
+    arena.import(decoded.to_plutus_data(decoded_root));
+    EXPECT_EQ(arena.node_count(), nodes);
+
+    // Long byte strings are chunked, large constructor tags use the general form
+    SmartContractInterface contracts;
+    const std::vector<uint8_t> long_bytes(100, 0xab);
+    const std::string chunked = contracts.encode_plutus_data(PlutusData(long_bytes));
+    EXPECT_EQ(chunked.substr(0, 6), "5f5840");
+    EXPECT_EQ(std::get<std::vector<uint8_t>>(contracts.decode_plutus_data(chunked).value), long_bytes);
+    EXPECT_EQ(contracts.encode_plutus_data(contracts.create_constructor(200, {})), "d8668218c880");
+    EXPECT_EQ(contracts.decode_plutus_data("zz").type, PlutusDataType::UNIT);
+}
+
+TEST(PlutusScriptTest, FlatEncodingMatchesTheSpecification)
+{
+    // (program 1.0.0 (con integer 42)), wrapped in a CBOR byte string
+    uplc::Program program;
+    program.set_root(program.integer(42));
+    EXPECT_EQ(cardano_iot::utils::codec::hex_encode(uplc::encode_script(program)), "46010000481501");
+
+    const auto bytes = cardano_iot::utils::codec::hex_decode("46010000481501");
+    uplc::Program decoded;
+    ASSERT_TRUE(uplc::decode_script(bytes.data(), bytes.size(), decoded));
+    auto result = uplc::evaluate(decoded, {}, budget(1'000'000, 100'000));
+    ASSERT_TRUE(result.success);
+    EXPECT_EQ(std::get<int64_t>(result.value.value), 42);
+
+    // Free variables and trailing bytes are rejected
+    uplc::Program open_term;
+    open_term.set_root(open_term.var(1));
+    EXPECT_FALSE(open_term.validate());
+    const auto trailing = cardano_iot::utils::codec::hex_decode("0100004815010000");
+    EXPECT_FALSE(uplc::decode_script(trailing.data(), trailing.size(), decoded));
+}
+
+TEST(PlutusScriptTest, EvaluatesBuiltinsAndChargesTheBudget)
+{
+    // \d -> force ifThenElse (lessThanInteger (unIData d) 10) "small" "large"
+    uplc::Program program;
+    const uint32_t n = program.apply(program.builtin(uplc::Builtin::UN_I_DATA), program.var(1));
+    const uint32_t test = program.apply(program.apply(program.builtin(uplc::Builtin::LESS_THAN_INTEGER), n),
+                                        program.integer(10));
+    const uint32_t choose = program.apply(
+        program.apply(program.apply(program.force(program.builtin(uplc::Builtin::IF_THEN_ELSE)), test),
+                      program.bytestring({'s'})),
+        program.bytestring({'l'}));
+    program.set_root(program.lambda(choose));
+
+    auto small = uplc::evaluate(program, {PlutusData(int64_t(3))}, budget(10'000'000, 100'000));
+    ASSERT_TRUE(small.success) << small.error_message;
+    EXPECT_EQ(std::get<std::vector<uint8_t>>(small.value.value), std::vector<uint8_t>{'s'});
+    EXPECT_GT(small.consumed.cpu, 0u);
+    EXPECT_GT(small.consumed.memory, 0u);
+
+    auto large = uplc::evaluate(program, {PlutusData(int64_t(30))}, budget(10'000'000, 100'000));
+    ASSERT_TRUE(large.success);
+    EXPECT_EQ(std::get<std::vector<uint8_t>>(large.value.value), std::vector<uint8_t>{'l'});
+
+    // (\x -> x x) (\x -> x x) runs until the budget is gone
+    uplc::Program loop;
+    const uint32_t self = loop.lambda(loop.apply(loop.var(1), loop.var(1)));
+    const uint32_t self_again = loop.lambda(loop.apply(loop.var(1), loop.var(1)));
+    loop.set_root(loop.apply(self, self_again));
+    auto exhausted = uplc::evaluate(loop, {}, budget(1'000'000, 100'000));
+    EXPECT_FALSE(exhausted.success);
+    EXPECT_LE(exhausted.consumed.cpu, 1'000'000u + 16'000u);
+}
+
+TEST(PlutusScriptTest, HashAndSignatureBuiltinsReturnTrueAndFalse)
+{
+    using cardano_iot::utils::codec::hex_decode;
+    auto run = [](uplc::Program &program, uint32_t root)
+    {
+        program.set_root(root);
+        return uplc::evaluate(program, {}, budget(1'000'000'000, 1'000'000));
+    };
+
+    // equalsByteString (hash "abc") expected, for the digest of "abc" and of "abd"
+    const std::vector<std::pair<uplc::Builtin, std::string>> hashes = {
+        {uplc::Builtin::SHA3_256, "3a985da74fe225b2045c172d6bd390bd855f086e3e9d525b46bfe24511431532"},
+        {uplc::Builtin::BLAKE2B_256, "bddd813c634239723171ef3fee98579b94964e3bb1cb3e427262c8c068d52319"}};
+    for (const auto &[builtin, expected] : hashes)
+    {
+        for (const auto &input : {std::vector<uint8_t>{'a', 'b', 'c'}, std::vector<uint8_t>{'a', 'b', 'd'}})
+        {
+            uplc::Program program;
+            const uint32_t digest = program.apply(program.builtin(builtin), program.bytestring(input));
+            const uint32_t equal = program.apply(
+                program.apply(program.builtin(uplc::Builtin::EQUALS_BYTESTRING), digest),
+                program.bytestring(hex_decode(expected)));
+            auto result = run(program, equal);
+            ASSERT_TRUE(result.success) << result.error_message;
+            EXPECT_EQ(std::get<bool>(result.value.value), input.back() == 'c') << expected;
+        }
+    }
+
+    // RFC 8032 test 1: an empty message
+    const auto key = hex_decode("d75a980182b10ab7d54bfed3c964073a0ee172f3daa62325af021a68f707511a");
+    const auto signature = hex_decode("e5564300c360ac729086e2cc806e828a84877f1eb8e5d974d873e065224901555fb8821590a33bacc61e39701cf9b46bd25bf5f0595bbe24655141438e7a100b");
+    auto verify = [&](const std::vector<uint8_t> &k, const std::vector<uint8_t> &message, const std::vector<uint8_t> &sig)
+    {
+        uplc::Program program;
+        const uint32_t call = program.apply(
+            program.apply(program.apply(program.builtin(uplc::Builtin::VERIFY_ED25519_SIGNATURE), program.bytestring(k)),
+                          program.bytestring(message)),
+            program.bytestring(sig));
+        return run(program, call);
+    };
+    auto valid = verify(key, {}, signature);
+    ASSERT_TRUE(valid.success) << valid.error_message;
+    EXPECT_TRUE(std::get<bool>(valid.value.value));
+    auto wrong_message = verify(key, {'x'}, signature);
+    ASSERT_TRUE(wrong_message.success) << wrong_message.error_message;
+    EXPECT_FALSE(std::get<bool>(wrong_message.value.value));
+
+    // Malformed lengths fail the script rather than returning False
+    EXPECT_FALSE(verify(std::vector<uint8_t>(key.begin(), key.end() - 1), {}, signature).success);
+    EXPECT_FALSE(verify(key, {}, std::vector<uint8_t>(signature.begin(), signature.end() - 1)).success);
+}
+
+TEST(SmartContractTest, ReadonlyCallsRunLocallyAndAreMemoized)
+{
+    SmartContractInterface contracts;
+    ASSERT_TRUE(contracts.initialize("testnet"));
+
+    const std::string script = doubling_script();
+    EXPECT_TRUE(contracts.validate_script(script));
+    EXPECT_FALSE(contracts.validate_script("deadbeef"));
+    EXPECT_FALSE(contracts.validate_script("not hex"));
+
+    const std::string deployment_id = contracts.deploy_contract(script, {}, "addr_test1deployer");
+    auto deployment = contracts.get_deployment(deployment_id);
+    ASSERT_TRUE(deployment);
+
+    auto first = contracts.evaluate_readonly_function(deployment->address, "double", {PlutusData(int64_t(21))});
+    ASSERT_EQ(first.result, ExecutionResult::SUCCESS) << first.error_message;
+    EXPECT_EQ(std::get<int64_t>(first.value.value), 42);
+    EXPECT_FALSE(first.from_cache);
+    EXPECT_GT(first.cpu_units, 0u);
+
+    auto second = contracts.evaluate_readonly_function(deployment->address, "double", {PlutusData(int64_t(21))});
+    EXPECT_TRUE(second.from_cache);
+    EXPECT_EQ(std::get<int64_t>(second.value.value), 42);
+    EXPECT_EQ(second.cpu_units, first.cpu_units);
+
+    auto other = contracts.evaluate_readonly_function(deployment->address, "double", {PlutusData(int64_t(5))});
+    EXPECT_FALSE(other.from_cache);
+    EXPECT_EQ(std::get<int64_t>(other.value.value), 10);
+
+    EXPECT_EQ(contracts.call_readonly_function(deployment->address, "double", {PlutusData(int64_t(4))}), "08");
+
+    // A non-integer argument fails inside the script
+    auto failed = contracts.evaluate_readonly_function(deployment->address, "double", {PlutusData(true)});
+    EXPECT_EQ(failed.result, ExecutionResult::EXECUTION_ERROR);
+
+    // Contracts without a UPLC script keep the simulated path
+    const std::string mock_id = contracts.deploy_contract("data_oracle_template_cbor", {}, "addr_test1deployer");
+    auto mock = contracts.get_deployment(mock_id);
+    ASSERT_TRUE(mock);
+    EXPECT_EQ(contracts.call_readonly_function(mock->address, "price", {}), "readonly_result_price_0");
+
+    auto stats = contracts.get_statistics();
+    EXPECT_EQ(stats.readonly_cache_hits, 1u);
+    EXPECT_GE(stats.readonly_calls, 4u);
+    EXPECT_GE(stats.cached_scripts, 2u);
+
+    contracts.shutdown();
+}
+
+TEST(SmartContractTest, BatchRunsIndependentCallsInParallelAndPacksTransactions)
+{
+    SmartContractInterface contracts;
+    ASSERT_TRUE(contracts.initialize("testnet"));
+
+    std::mutex order_mutex;
+    std::vector<std::string> order;
+    contracts.subscribe_to_events("addr_shared", "FunctionCalled", [&](const ContractEvent &event)
+                                  {
+                                      const auto &name = std::get<std::vector<uint8_t>>(event.event_data.at("function").value);
+                                      std::lock_guard<std::mutex> lock(order_mutex);
+                                      order.emplace_back(name.begin(), name.end());
+                                  });
+
+    std::vector<BatchCall> calls;
+    for (int i = 0; i < 16; ++i)
+    {
+        BatchCall call;
+        call.contract_address = "addr_sensor_" + std::to_string(i);
+        call.function_name = "record";
+        call.writes = {"reading"};
+        calls.push_back(call);
+    }
+    for (const char *name : {"first", "second"})
+    {
+        BatchCall call;
+        call.contract_address = "addr_shared";
+        call.function_name = name;
+        call.reads = {"counter"};
+        call.writes = {"counter"};
+        calls.push_back(call);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    auto batch = contracts.execute_batch(calls, "addr_test1caller");
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    // Each simulated call takes at least 50 ms, so 18 in sequence would take 900 ms
+    EXPECT_LT(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count(), 600);
+
+    ASSERT_EQ(batch.logs.size(), calls.size());
+    for (size_t i = 0; i < calls.size(); ++i)
+    {
+        EXPECT_EQ(batch.logs[i].contract_address, calls[i].contract_address);
+        EXPECT_EQ(batch.logs[i].function_name, calls[i].function_name);
+        EXPECT_TRUE(contracts.get_execution_log(batch.logs[i].execution_id));
+    }
+
+    // One transaction per contract; the two conflicting calls ran in order
+    EXPECT_EQ(batch.transaction_hashes.size(), 17u);
+    EXPECT_EQ(batch.logs[16].transaction_hash, batch.logs[17].transaction_hash);
+    EXPECT_NE(batch.logs[0].transaction_hash, batch.logs[1].transaction_hash);
+    if (order.size() == 2)
+    {
+        EXPECT_EQ(order[0], "first");
+        EXPECT_EQ(order[1], "second");
+    }
+
+    EXPECT_FALSE(contracts.execute_batch_calls({{"addr_shared", "third", {}}}, "addr_test1caller").empty());
+    EXPECT_EQ(contracts.get_statistics().total_executions, calls.size() + 1);
+
+    contracts.shutdown();
+}
@@ -0,0 +1,108 @@
+/**
+ * @file timer_wheel_tests.cpp
+ * @brief Unit tests for the hierarchical timer wheel
+ *
+ * @author Cardano IoT SDK Team
+ * @version 1.0.0
+ */
+
+#include <gtest/gtest.h>
+#include "cardano_iot/utils/timer_wheel.h"
+
+#include <atomic>
+#include <random>
+#include <thread>
+
+using namespace cardano_iot::utils;
+using std::chrono::milliseconds;
+
+TEST(TimerWheelTest, FiresEveryLevelOnTimeAndCancelsInConstantTime)
+{
+    TimerWheel wheel(milliseconds(1), false);
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int64_t> delay(1, int64_t(1) << 20); // spans all four levels
+
+    constexpr size_t COUNT = 5000;
+    std::vector<int64_t> deadlines(COUNT);
+    std::vector<int64_t> fired_at(COUNT, -1);
+    std::vector<TimerWheel::Handle> handles(COUNT);
+    int64_t now = 0;
+    for (size_t i = 0; i < COUNT; ++i)
+    {
+        deadlines[i] = delay(rng);
+        handles[i] = wheel.schedule_after(milliseconds(deadlines[i]), [&, i]
+                                          { fired_at[i] = now; });
+    }
+    // Every third timer is cancelled; the others must fire at the first advance past their deadline
+    for (size_t i = 0; i < COUNT; i += 3)
+    {
+        EXPECT_TRUE(wheel.cancel(handles[i]));
+        EXPECT_FALSE(wheel.cancel(handles[i]));
+    }
+    EXPECT_EQ(wheel.pending(), COUNT - (COUNT + 2) / 3);
+
+    std::uniform_int_distribution<int64_t> step(1, 5000);
+    while (wheel.pending() > 0)
+    {
+        now += step(rng);
+        wheel.advance(wheel.origin() + milliseconds(now));
+        ASSERT_LT(now, int64_t(1) << 22);
+    }
+    for (size_t i = 0; i < COUNT; ++i)
+    {
+        if (i % 3 == 0)
+        {
+            EXPECT_EQ(fired_at[i], -1);
+            continue;
+        }
+        EXPECT_GE(fired_at[i], deadlines[i]) << i;
+        EXPECT_LT(fired_at[i] - deadlines[i], 5000) << i;
+    }
+    EXPECT_FALSE(wheel.cancel(handles[1])); // fired handles are stale
+
+    // Past the top level's span, and scheduled from inside a callback
+    bool late = false;
+    bool chained = false;
+    wheel.schedule_after(milliseconds(int64_t(1) << 25), [&]
+                         { late = true; });
+    wheel.schedule_after(milliseconds(10), [&]
+                         { wheel.schedule_after(milliseconds(10), [&]
+                                                { chained = true; }); });
+    wheel.advance(wheel.origin() + milliseconds(now + 20));
+    EXPECT_TRUE(chained);
+    wheel.advance(wheel.origin() + milliseconds(now + (int64_t(1) << 25) - 1));
+    EXPECT_FALSE(late);
+    wheel.advance(wheel.origin() + milliseconds(now + (int64_t(1) << 25) + 1));
+    EXPECT_TRUE(late);
+}
+
+TEST(TimerWheelTest, ScopeCancelsItsTimersOnDestruction)
+{
+    auto wheel = std::make_shared<TimerWheel>(milliseconds(1), false);
+    int fired = 0;
+    {
+        TimerWheel::Scope scope(wheel);
+        for (int i = 0; i < 100; ++i)
+        {
+            scope.schedule_after(milliseconds(50), [&]
+                                 { ++fired; });
+        }
+        wheel->schedule_after(milliseconds(50), [&]
+                              { fired += 1000; });
+        EXPECT_EQ(wheel->pending(), 101u);
+    }
+    EXPECT_EQ(wheel->pending(), 1u);
+    wheel->advance(wheel->origin() + milliseconds(100));
+    EXPECT_EQ(fired, 1000);
+
+    // The real-time thread fires on its own
+    auto live = std::make_shared<TimerWheel>(milliseconds(5));
+    std::atomic<bool> done{false};
+    live->schedule_after(milliseconds(20), [&]
+                         { done = true; });
+    for (int i = 0; i < 200 && !done; ++i)
+    {
+        std::this_thread::sleep_for(milliseconds(5));
+    }
+    EXPECT_TRUE(done);
+}
@@ -0,0 +1,175 @@
+/**
+ * @file transaction_history_tests.cpp
+ * @brief Unit tests for the indexed transaction history and its archive
+ */
+
+#include <gtest/gtest.h>
+#include "cardano_iot/core/transaction_history.h"
+
+#include <fstream>
+#include <unistd.h>
+
+using namespace cardano_iot::core;
+
+namespace
+{
+    Transaction make_transaction(const std::string &tx_id, const std::string &device_id, TransactionStatus status,
+                                 uint64_t timestamp)
+    {
+        Transaction tx;
+        tx.tx_id = tx_id;
+        tx.type = TransactionType::PAYMENT;
+        tx.status = status;
+        tx.device_id = device_id;
+        tx.fee = 170000;
+        tx.ttl = 1000;
+        TransactionInput input;
+        input.tx_hash = std::string(64, 'a');
+        input.output_index = 0;
+        tx.inputs.push_back(input);
+        TransactionOutput output;
+        output.address = "addr_test1qexample";
+        output.amount_lovelace = 2000000;
+        tx.outputs.push_back(output);
+        tx.created_timestamp = timestamp;
+        tx.submitted_timestamp = timestamp;
+        tx.confirmed_timestamp = status == TransactionStatus::CONFIRMED ? timestamp : 0;
+        return tx;
+    }
+} // namespace
+
+TEST(TransactionHistoryTest, IndexesPageWithCursorsAndShareRecords)
+{
+    TransactionHistory history;
+    for (int i = 0; i < 250; ++i)
+    {
+        history.put(make_transaction("tx" + std::to_string(i), "device" + std::to_string(i % 3),
+                                     i % 2 ? TransactionStatus::SUBMITTED : TransactionStatus::CONFIRMED, 1000 + i));
+    }
+    EXPECT_EQ(history.size(), 250u);
+    EXPECT_EQ(history.count(TransactionStatus::SUBMITTED), 125u);
+
+    // Walk one device's history in pages of 30, oldest first
+    std::vector<std::string> seen;
+    uint64_t cursor = 0;
+    do
+    {
+        auto page = history.page_by_device("device1", cursor, 30);
+        EXPECT_LE(page.items.size(), 30u);
+        for (const auto &summary : page.items)
+        {
+            EXPECT_EQ(summary.device_id, "device1");
+            EXPECT_EQ(summary.amount_lovelace, 2000000u);
+            seen.push_back(summary.tx_id);
+        }
+        cursor = page.next_cursor;
+    } while (cursor != 0);
+    ASSERT_EQ(seen.size(), 83u);
+    EXPECT_EQ(seen.front(), "tx1");
+    EXPECT_EQ(seen.back(), "tx247");
+    EXPECT_TRUE(history.page_by_device("nobody", 0, 10).items.empty());
+
+    // A status change moves the record between status indexes; old snapshots stay as they were
+    auto before = history.snapshot("tx1");
+    ASSERT_TRUE(history.update("tx1", [](Transaction &tx)
+                               {
+                                   tx.status = TransactionStatus::CONFIRMED;
+                                   tx.confirmed_timestamp = 5000; }));
+    EXPECT_EQ(before->status, TransactionStatus::SUBMITTED);
+    EXPECT_EQ(history.snapshot("tx1")->status, TransactionStatus::CONFIRMED);
+    EXPECT_EQ(history.count(TransactionStatus::SUBMITTED), 124u);
+    EXPECT_EQ(history.page_by_status(TransactionStatus::CONFIRMED, 0, 1000).items.size(), 126u);
+    EXPECT_FALSE(history.update("missing", [](Transaction &) {}));
+
+    // Pages are capped
+    EXPECT_EQ(history.page_by_status(TransactionStatus::CONFIRMED, 0, 100000).items.size(), 126u);
+    EXPECT_EQ(history.page_by_status(TransactionStatus::CONFIRMED, 0, 0).items.size(), 1u);
+}
+
+TEST(TransactionHistoryTest, PruneMovesFinishedTransactionsToArchive)
+{
+    const std::string path = "/tmp/ciot_tx_archive_" + std::to_string(::getpid()) + ".log";
+    ::unlink(path.c_str());
+
+    TransactionHistory history;
+    history.put(make_transaction("old_confirmed", "d", TransactionStatus::CONFIRMED, 100));
+    history.put(make_transaction("old_failed", "d", TransactionStatus::FAILED, 100));
+    history.put(make_transaction("old_submitted", "d", TransactionStatus::SUBMITTED, 100));
+    history.put(make_transaction("new_confirmed", "d", TransactionStatus::CONFIRMED, 9000));
+
+    {
+        TransactionArchive archive;
+        ASSERT_TRUE(archive.open(path));
+        EXPECT_EQ(history.prune(10000, 3600, &archive), 2u);
+        EXPECT_EQ(history.size(), 2u);
+        EXPECT_NE(history.find("old_submitted"), nullptr); // Never prunes live transactions
+        EXPECT_EQ(archive.record_count(), 2u);
+    }
+
+    // Reopen after a torn write
+    {
+        std::ofstream torn(path, std::ios::binary | std::ios::app);
+        torn << "\x40\x00\x00\x00garbage";
+    }
+    TransactionArchive archive;
+    ASSERT_TRUE(archive.open(path));
+    EXPECT_EQ(archive.record_count(), 2u);
+    auto found = archive.find("old_confirmed");
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(found->status, TransactionStatus::CONFIRMED);
+    EXPECT_EQ(found->device_id, "d");
+    EXPECT_EQ(found->fee, 170000u);
+    ASSERT_EQ(found->outputs.size(), 1u);
+    EXPECT_EQ(found->outputs[0].amount_lovelace, 2000000u);
+    EXPECT_EQ(archive.find("new_confirmed"), nullptr);
+
+    // Appends continue after the cut
+    EXPECT_EQ(history.prune(20000, 3600, &archive), 1u);
+    size_t scanned = 0;
+    archive.scan([&scanned](const Transaction &)
+                 {
+                     ++scanned;
+                     return true; });
+    EXPECT_EQ(scanned, 3u);
+    ::unlink(path.c_str());
+}
+
+TEST(TransactionHistoryTest, ManagerQueriesUseTheHistory)
+{
+    TransactionManager tm;
+    ASSERT_TRUE(tm.initialize("testnet"));
+    for (int i = 0; i < 4; ++i)
+    {
+        tm.submit_transaction(make_transaction("mgr" + std::to_string(i), i < 3 ? "sensor" : "other",
+                                               TransactionStatus::PENDING, 0));
+    }
+    EXPECT_EQ(tm.history_size(), 4u);
+
+    auto first = tm.list_transactions_by_device("sensor", 0, 2);
+    ASSERT_EQ(first.items.size(), 2u);
+    ASSERT_NE(first.next_cursor, 0u);
+    auto second = tm.list_transactions_by_device("sensor", first.next_cursor, 2);
+    ASSERT_EQ(second.items.size(), 1u);
+    EXPECT_EQ(second.items[0].tx_id, "mgr2");
+    EXPECT_EQ(second.next_cursor, 0u);
+    EXPECT_EQ(tm.get_transactions_by_device("sensor").size(), 3u);
+
+    const size_t live = tm.list_transactions_by_status(TransactionStatus::SUBMITTED).items.size();
+    const size_t failed = tm.list_transactions_by_status(TransactionStatus::FAILED).items.size();
+    EXPECT_EQ(live + failed, 4u);
+    EXPECT_EQ(tm.get_pending_transactions().size(), live);
+
+    auto record = tm.get_transaction_record("mgr0");
+    ASSERT_NE(record, nullptr);
+    ASSERT_TRUE(tm.add_multisig_signature("mgr0", "sig", "vk"));
+    EXPECT_TRUE(record->witnesses.empty());
+    EXPECT_EQ(tm.get_transaction("mgr0")->witnesses.size(), 1u);
+
+    TransactionManager::HistoryOptions options;
+    options.retention_seconds = 60;
+    options.archive_path = "/nonexistent-dir/archive.log";
+    EXPECT_FALSE(tm.set_history_options(options));
+    EXPECT_EQ(tm.prune_history(), 0u);
+    EXPECT_EQ(tm.history_size(), 4u);
+    tm.shutdown();
+}
@@ -68,3 +68,87 @@ TEST_F(TransactionManagerTest, EstimateAndCalculateFee)
     EXPECT_GT(est, 0u);
     EXPECT_GT(calc, 0u);
 }
+
+TEST_F(TransactionManagerTest, CborRoundTripPreservesTransaction)
+{
+    Transaction tx;
+    tx.fee = 170000;
+    tx.ttl = 12345678;
+    tx.inputs.resize(1);
+    tx.inputs[0].tx_hash = std::string(64, 'a');
+    tx.inputs[0].output_index = 3;
+
+    TransactionOutput output;
+    output.address = "addr_test1qpexampleaddress";
+    output.amount_lovelace = 2'500'000;
+    output.native_tokens["policy1.token1"] = 1000;
+    output.native_tokens["policy1.token2"] = 7;
+    output.native_tokens["policy2.token"] = 500;
+    tx.outputs.push_back(output);
+
+    tx.metadata = std::make_unique<TransactionMetadata>();
+    tx.metadata->labels["device"] = "sensor_01";
+    tx.metadata->json_metadata = std::string(150, 'j'); // spans several 64-byte chunks
+    tx.metadata->binary_metadata = {1, 2, 3};
+
+    std::string encoded = tm_.encode_transaction(tx);
+    ASSERT_FALSE(encoded.empty());
+
+    auto decoded = tm_.decode_transaction(encoded);
+    ASSERT_NE(decoded, nullptr);
+    EXPECT_EQ(decoded->fee, tx.fee);
+    EXPECT_EQ(decoded->ttl, tx.ttl);
+    ASSERT_EQ(decoded->inputs.size(), 1u);
+    EXPECT_EQ(decoded->inputs[0].tx_hash, tx.inputs[0].tx_hash);
+    EXPECT_EQ(decoded->inputs[0].output_index, 3u);
+    ASSERT_EQ(decoded->outputs.size(), 1u);
+    EXPECT_EQ(decoded->outputs[0].address, output.address);
+    EXPECT_EQ(decoded->outputs[0].amount_lovelace, output.amount_lovelace);
+    EXPECT_EQ(decoded->outputs[0].native_tokens, output.native_tokens);
+    ASSERT_NE(decoded->metadata, nullptr);
+    EXPECT_EQ(decoded->metadata->labels, tx.metadata->labels);
+    EXPECT_EQ(decoded->metadata->json_metadata, tx.metadata->json_metadata);
+    EXPECT_EQ(decoded->metadata->binary_metadata, tx.metadata->binary_metadata);
+
+    // Re-encoding the decoded transaction is byte-identical
+    EXPECT_EQ(tm_.encode_transaction(*decoded), encoded);
+
+    EXPECT_EQ(tm_.decode_transaction(encoded.substr(0, encoded.size() - 2)), nullptr);
+    EXPECT_EQ(tm_.decode_transaction("zz"), nullptr);
+}
+
+TEST_F(TransactionManagerTest, TransactionIdIsBlake2bOfTheBody)
+{
+    // [{0: [[h'aa..', 0]], 1: [[h'60 11..', 2000000]], 2: 170000, 3: 1000}, {}, true, null]
+    const std::string body = "a40081825820" + std::string(64, 'a') + "00018182581d60" + std::string(56, '1') +
+                             "1a001e8480021a00029810031903e8";
+    // blake2b(body, digest_size=32), computed independently
+    const std::string expected = "b860e482b86303bb307a1ea2a1d1607f423e7c81fcd6a06aaef6dde958e55508";
+
+    auto decoded = tm_.decode_transaction("84" + body + "a0f5f6");
+    ASSERT_NE(decoded, nullptr);
+    EXPECT_EQ(decoded->tx_id, expected);
+    EXPECT_EQ(tm_.get_body_hash(*decoded), expected);
+    EXPECT_EQ(tm_.encode_transaction(*decoded), "84" + body + "a0f5f6");
+}
+
+TEST_F(TransactionManagerTest, FeeMatchesSignedSize)
+{
+    std::string from_addr = tm_.address_from_public_key("vk_mock", "testnet");
+    std::string to_addr = tm_.address_from_public_key("vk_mock_dest", "testnet");
+    auto tx = tm_.create_payment_transaction(from_addr, to_addr, 1'000'000);
+    ASSERT_NE(tx, nullptr);
+
+    const uint64_t fee = tx->fee;
+    EXPECT_EQ(tm_.calculate_fee(*tx), fee);
+
+    // A raw 32-byte key produces a real Ed25519 witness, and the fee computed
+    // up front matches the size of the signed transaction
+    ASSERT_TRUE(tm_.sign_transaction(*tx, std::string(64, '1')));
+    ASSERT_EQ(tx->witnesses.size(), 1u);
+    EXPECT_EQ(tx->witnesses[0].size(), 192u);
+
+    auto params = tm_.get_protocol_parameters();
+    const uint64_t signed_size = tx->signed_cbor.size() / 2;
+    EXPECT_EQ(fee, params.min_fee_a + params.min_fee_b * signed_size);
+}
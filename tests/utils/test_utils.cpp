@@ -10,6 +10,13 @@
 #include <random>
 #include <sstream>
 #include <iomanip>
+#include <algorithm>
+#include <cstring>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <poll.h>
+#include <unistd.h>
 
 namespace cardano_iot::test
 {
@@ -201,6 +208,152 @@ namespace cardano_iot::test
         return false;
     }
 
+    LocalHttpServer::LocalHttpServer(Handler handler) : handler_(std::move(handler)) {}
+
+    LocalHttpServer::~LocalHttpServer()
+    {
+        stop();
+    }
+
+    bool LocalHttpServer::start()
+    {
+        listen_fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (listen_fd_ < 0)
+        {
+            return false;
+        }
+        int reuse = 1;
+        ::setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        socklen_t len = sizeof(addr);
+        if (::bind(listen_fd_, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0 ||
+            ::listen(listen_fd_, 64) != 0 ||
+            ::getsockname(listen_fd_, reinterpret_cast<sockaddr *>(&addr), &len) != 0)
+        {
+            ::close(listen_fd_);
+            listen_fd_ = -1;
+            return false;
+        }
+        port_ = ntohs(addr.sin_port);
+        running_ = true;
+        acceptor_ = std::thread([this]()
+                                { accept_loop(); });
+        return true;
+    }
+
+    void LocalHttpServer::stop()
+    {
+        if (!running_.exchange(false))
+        {
+            return;
+        }
+        if (acceptor_.joinable())
+        {
+            acceptor_.join();
+        }
+        std::vector<std::thread> workers;
+        {
+            std::lock_guard<std::mutex> lock(workers_mutex_);
+            workers.swap(workers_);
+        }
+        for (auto &worker : workers)
+        {
+            worker.join();
+        }
+        ::close(listen_fd_);
+        listen_fd_ = -1;
+    }
+
+    void LocalHttpServer::accept_loop()
+    {
+        while (running_)
+        {
+            pollfd pfd{listen_fd_, POLLIN, 0};
+            if (::poll(&pfd, 1, 50) <= 0)
+            {
+                continue;
+            }
+            int fd = ::accept(listen_fd_, nullptr, nullptr);
+            if (fd < 0)
+            {
+                continue;
+            }
+            ++connections_;
+            std::lock_guard<std::mutex> lock(workers_mutex_);
+            workers_.emplace_back([this, fd]()
+                                  { serve(fd); });
+        }
+    }
+
+    void LocalHttpServer::serve(int fd)
+    {
+        std::string buffer;
+        char chunk[4096];
+        while (running_)
+        {
+            // Parse as many complete requests as are buffered
+            const size_t header_end = buffer.find("\r\n\r\n");
+            if (header_end != std::string::npos)
+            {
+                const std::string head = buffer.substr(0, header_end);
+                size_t content_length = 0;
+                std::istringstream lines(head);
+                std::string request_line;
+                std::getline(lines, request_line);
+                std::string line;
+                while (std::getline(lines, line))
+                {
+                    std::string lower = line;
+                    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+                    if (lower.rfind("content-length:", 0) == 0)
+                    {
+                        content_length = std::stoul(line.substr(15));
+                    }
+                }
+                if (buffer.size() >= header_end + 4 + content_length)
+                {
+                    std::istringstream request(request_line);
+                    std::string method, path;
+                    request >> method >> path;
+                    const std::string body = buffer.substr(header_end + 4, content_length);
+                    buffer.erase(0, header_end + 4 + content_length);
+
+                    const Response response = handler_(method, path, body);
+                    ++requests_;
+                    std::ostringstream out;
+                    out << "HTTP/1.1 " << response.status << " OK\r\n"
+                        << "Content-Type: application/json\r\n"
+                        << "Content-Length: " << response.body.size() << "\r\n"
+                        << "Connection: keep-alive\r\n\r\n"
+                        << response.body;
+                    const std::string bytes = out.str();
+                    if (::send(fd, bytes.data(), bytes.size(), MSG_NOSIGNAL) < 0)
+                    {
+                        break;
+                    }
+                    continue;
+                }
+            }
+
+            pollfd pfd{fd, POLLIN, 0};
+            if (::poll(&pfd, 1, 50) <= 0)
+            {
+                continue;
+            }
+            const ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+            if (n <= 0)
+            {
+                break;
+            }
+            buffer.append(chunk, static_cast<size_t>(n));
+        }
+        ::close(fd);
+    }
+
     void simulate_time_passage(uint32_t seconds)
     {
         // In a real implementation, this might advance a mock clock
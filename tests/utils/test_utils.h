@@ -13,6 +13,9 @@
 #include <functional>
 #include <chrono>
 #include <thread>
+#include <atomic>
+#include <mutex>
+#include <vector>
 
 using namespace cardano_iot;
 
@@ -84,6 +87,49 @@ namespace cardano_iot::test
         bool connected_;
     };
 
+    /**
+     * @brief Minimal keep-alive HTTP/1.1 server on 127.0.0.1 for backend tests
+     *
+     * Each connection is served on its own thread; the handler must be thread-safe.
+     */
+    class LocalHttpServer
+    {
+    public:
+        struct Response
+        {
+            int status = 200;
+            std::string body;
+        };
+
+        using Handler = std::function<Response(const std::string &method, const std::string &path,
+                                               const std::string &body)>;
+
+        explicit LocalHttpServer(Handler handler);
+        ~LocalHttpServer();
+
+        bool start();
+        void stop();
+
+        uint16_t port() const { return port_; }
+        std::string base_url() const { return "http://127.0.0.1:" + std::to_string(port_); }
+        size_t connections_accepted() const { return connections_.load(); }
+        size_t requests_served() const { return requests_.load(); }
+
+    private:
+        void accept_loop();
+        void serve(int fd);
+
+        Handler handler_;
+        int listen_fd_ = -1;
+        uint16_t port_ = 0;
+        std::atomic<bool> running_{false};
+        std::atomic<size_t> connections_{0};
+        std::atomic<size_t> requests_{0};
+        std::thread acceptor_;
+        std::mutex workers_mutex_;
+        std::vector<std::thread> workers_;
+    };
+
     /**
      * @brief Wait for a condition to become true with timeout
      * @param condition Function that returns true when condition is met
@@ -95,6 +141,27 @@ namespace cardano_iot::test
                             uint32_t timeout_ms = 5000,
                             uint32_t check_interval_ms = 100);
 
+    /**
+     * @brief Poll a predicate every 5ms until it holds or the timeout expires
+     * @param predicate Callable returning true once the awaited state is reached
+     * @param timeout Maximum time to wait
+     * @return true if the predicate held before (or at) the deadline
+     */
+    template <typename Predicate>
+    bool eventually(Predicate predicate, std::chrono::milliseconds timeout = std::chrono::seconds(5))
+    {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (std::chrono::steady_clock::now() < deadline)
+        {
+            if (predicate())
+            {
+                return true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return predicate();
+    }
+
     /**
      * @brief Simulate passage of time for testing
      * @param seconds Number of seconds to simulate
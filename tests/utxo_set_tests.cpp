@@ -0,0 +1,177 @@
+/**
+ * @file utxo_set_tests.cpp
+ * @brief Unit tests for the indexed UTXO set and its use by TransactionManager and the builder pool
+ */
+
+#include <gtest/gtest.h>
+#include "cardano_iot/core/utxo_set.h"
+#include "cardano_iot/core/transaction_builder_pool.h"
+
+#include <algorithm>
+#include <set>
+#include <thread>
+
+using namespace cardano_iot::core;
+
+namespace
+{
+    const std::string kWallet = "addr_test1wallet";
+
+    UTXO make_utxo(const std::string &hash, uint32_t index, uint64_t lovelace)
+    {
+        UTXO utxo{};
+        utxo.tx_hash = hash;
+        utxo.output_index = index;
+        utxo.amount_lovelace = lovelace;
+        utxo.address = kWallet;
+        return utxo;
+    }
+} // namespace
+
+TEST(UtxoSetTest, ReservationsAreExclusiveAndReleasable)
+{
+    UtxoSet set;
+    set.load_address(kWallet, {make_utxo("aa", 0, 5'000'000), make_utxo("bb", 0, 3'000'000)});
+
+    ASSERT_TRUE(set.reserve({{"aa", 0}}, "tx1"));
+    EXPECT_FALSE(set.reserve({{"aa", 0}, {"bb", 0}}, "tx2")); // all or nothing
+    EXPECT_TRUE(set.is_available({"bb", 0}));
+
+    auto balance = set.balance(kWallet);
+    EXPECT_EQ(balance.total_lovelace, 8'000'000u);
+    EXPECT_EQ(balance.available_lovelace, 3'000'000u);
+    EXPECT_EQ(balance.utxos.size(), 1u);
+
+    EXPECT_EQ(set.release("tx1"), 1u);
+    EXPECT_EQ(set.balance(kWallet).available_lovelace, 8'000'000u);
+}
+
+TEST(UtxoSetTest, AppliesSubmittedConfirmedAndFailedTransactions)
+{
+    UtxoSet set;
+    set.load_address(kWallet, {make_utxo("aa", 0, 10'000'000)});
+
+    Transaction tx;
+    tx.tx_id = "cc";
+    tx.inputs.push_back(TransactionInput{"aa", 0, {}});
+    tx.outputs.push_back(TransactionOutput{"addr_test1other", 2'000'000, {}, "", ""});
+    tx.outputs.push_back(TransactionOutput{kWallet, 7'800'000, {}, "", ""});
+
+    ASSERT_TRUE(set.reserve({{"aa", 0}}, tx.tx_id));
+    const auto version = set.version(kWallet);
+    set.apply_submitted(tx);
+    EXPECT_NE(set.version(kWallet), version);
+
+    // The input is spent and the change is selectable before confirmation
+    auto balance = set.balance(kWallet);
+    EXPECT_EQ(balance.total_lovelace, 7'800'000u);
+    EXPECT_TRUE(set.is_available({"cc", 1}));
+    EXPECT_FALSE(set.has_address("addr_test1other"));
+
+    set.apply_failed(tx.tx_id);
+    EXPECT_EQ(set.balance(kWallet).available_lovelace, 10'000'000u);
+    EXPECT_FALSE(set.is_available({"cc", 1}));
+
+    ASSERT_TRUE(set.reserve({{"aa", 0}}, tx.tx_id));
+    set.apply_submitted(tx);
+    set.apply_confirmed(tx.tx_id);
+    EXPECT_EQ(set.size(), 1u);
+    EXPECT_EQ(set.balance(kWallet).available_lovelace, 7'800'000u);
+}
+
+TEST(UtxoSetTest, ConcurrentBuildersNeverShareInputs)
+{
+    TransactionManager tm;
+    ASSERT_TRUE(tm.initialize("testnet"));
+    const std::string from = tm.address_from_public_key("vk_wallet", "testnet");
+    const std::string to = tm.address_from_public_key("vk_dest", "testnet");
+    ASSERT_TRUE(tm.refresh_utxos(from));
+
+    // Three mock UTXOs, each big enough on its own, so three builders can all succeed
+    std::vector<std::unique_ptr<Transaction>> built(6);
+    std::vector<std::thread> builders;
+    for (size_t i = 0; i < built.size(); ++i)
+    {
+        builders.emplace_back([&, i]()
+                              { built[i] = tm.create_payment_transaction(from, to, 1'000'000); });
+    }
+    for (auto &t : builders)
+    {
+        t.join();
+    }
+
+    std::set<std::pair<std::string, uint32_t>> inputs;
+    size_t successes = 0;
+    for (const auto &tx : built)
+    {
+        if (!tx)
+        {
+            continue;
+        }
+        ++successes;
+        for (const auto &input : tx->inputs)
+        {
+            EXPECT_TRUE(inputs.emplace(input.tx_hash, input.output_index).second);
+        }
+    }
+    EXPECT_EQ(successes, 3u);
+    EXPECT_EQ(tm.get_wallet_balance(from).available_lovelace, 0u);
+
+    // Cancelling an unsubmitted transaction releases its inputs
+    auto first = std::find_if(built.begin(), built.end(), [](const auto &tx)
+                              { return tx != nullptr; });
+    ASSERT_TRUE(tm.cancel_transaction((*first)->tx_id));
+    EXPECT_GT(tm.get_wallet_balance(from).available_lovelace, 0u);
+    tm.shutdown();
+}
+
+TEST(UtxoSetTest, BuilderPoolResolvesFuturesWithoutSharingInputs)
+{
+    TransactionManager tm;
+    ASSERT_TRUE(tm.initialize("testnet"));
+    const std::string from = tm.address_from_public_key("vk_wallet", "testnet");
+    const std::string to = tm.address_from_public_key("vk_dest", "testnet");
+    ASSERT_TRUE(tm.refresh_utxos(from));
+
+    TransactionBuilderPool pool(tm, 4);
+    std::vector<TransactionBuildRequest> requests(6);
+    for (size_t i = 0; i < requests.size(); ++i)
+    {
+        requests[i].from_address = from;
+        requests[i].to_address = to;
+        requests[i].amount_lovelace = 1'000'000;
+        requests[i].device_id = "sensor_" + std::to_string(i);
+    }
+    auto futures = pool.submit_batch(std::move(requests));
+    ASSERT_EQ(futures.size(), 6u);
+
+    std::set<std::pair<std::string, uint32_t>> inputs;
+    size_t successes = 0;
+    for (auto &future : futures)
+    {
+        auto result = future.get();
+        if (!result.success)
+        {
+            EXPECT_FALSE(result.error_message.empty());
+            continue;
+        }
+        ++successes;
+        ASSERT_NE(result.transaction, nullptr);
+        for (const auto &input : result.transaction->inputs)
+        {
+            EXPECT_TRUE(inputs.emplace(input.tx_hash, input.output_index).second);
+        }
+    }
+    EXPECT_EQ(successes, 3u);
+
+    const auto stats = pool.get_statistics();
+    EXPECT_EQ(stats.requests_queued, 6u);
+    EXPECT_EQ(stats.transactions_built, 3u);
+    EXPECT_EQ(stats.builds_failed, 3u);
+
+    pool.shutdown();
+    TransactionBuildRequest late;
+    late.from_address = from;
+    EXPECT_FALSE(pool.submit(late).get().success);
+    tm.shutdown();
+}